@@ -20,7 +20,7 @@ public:
 
   AlignmentCorrelationsStore(void);
 
-  virtual ~AlignmentCorrelationsStore(void) {}
+  virtual ~AlignmentCorrelationsStore(void);
 
   /// Write correlations directly to the covariance matrix starting at the
   /// given position. Indices are assumed to start from 0.
@@ -64,6 +64,12 @@ private:
       Alignable* ap1, Alignable* ap2, AlgebraicMatrix& entry, const AlgebraicSymMatrix& cov, int row, int col);
 
   Correlations theCorrelations;
+
+  /// Tables of the alignables last read and written, which are most often those of the next call
+  mutable Alignable* theReadAlignable = nullptr;
+  mutable CorrelationsTable* theReadTable = nullptr;
+  Alignable* theWrittenAlignable = nullptr;
+  CorrelationsTable* theWrittenTable = nullptr;
 };
 
 #endif
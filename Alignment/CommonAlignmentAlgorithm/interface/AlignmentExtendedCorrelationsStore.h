@@ -24,7 +24,7 @@ public:
 
   AlignmentExtendedCorrelationsStore(const edm::ParameterSet& config);
 
-  ~AlignmentExtendedCorrelationsStore(void) override {}
+  ~AlignmentExtendedCorrelationsStore(void) override;
 
   /// Write correlations directly to the covariance matrix starting at the
   /// given position. Indices are assumed to start from 0.
@@ -91,6 +91,12 @@ private:
 
   ExtendedCorrelations theCorrelations;
 
+  /// Tables of the alignables last read and written, which are most often those of the next call
+  mutable Alignable* theReadAlignable = nullptr;
+  mutable ExtendedCorrelationsTable* theReadTable = nullptr;
+  Alignable* theWrittenAlignable = nullptr;
+  ExtendedCorrelationsTable* theWrittenTable = nullptr;
+
   int theMaxUpdates;
   double theCut;
   double theWeight;
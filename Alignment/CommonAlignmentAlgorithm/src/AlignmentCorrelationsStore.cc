@@ -9,32 +9,28 @@ AlignmentCorrelationsStore::AlignmentCorrelationsStore(void) {
                             << "\nCreated.";
 }
 
+AlignmentCorrelationsStore::~AlignmentCorrelationsStore(void) {
+  for (auto& correlations : theCorrelations)
+    delete correlations.second;
+}
+
 void AlignmentCorrelationsStore::correlations(
     Alignable* ap1, Alignable* ap2, AlgebraicSymMatrix& cov, int row, int col) const {
-  static Alignable* previousAlignable = nullptr;
-  static CorrelationsTable* previousCorrelations;
-
-  // Needed by 'resetCorrelations()' to reset the static pointer:
-  if (ap1 == nullptr) {
-    previousAlignable = nullptr;
-    return;
-  }
-
   bool transpose = (ap2 > ap1);
   if (transpose)
     std::swap(ap1, ap2);
 
-  if (ap1 == previousAlignable) {
-    CorrelationsTable::const_iterator itC2 = previousCorrelations->find(ap2);
-    if (itC2 != previousCorrelations->end()) {
+  if (ap1 == theReadAlignable) {
+    CorrelationsTable::const_iterator itC2 = theReadTable->find(ap2);
+    if (itC2 != theReadTable->end()) {
       transpose ? fillCovarianceT(ap1, ap2, (*itC2).second, cov, row, col)
                 : fillCovariance(ap1, ap2, (*itC2).second, cov, row, col);
     }
   } else {
     Correlations::const_iterator itC1 = theCorrelations.find(ap1);
     if (itC1 != theCorrelations.end()) {
-      previousAlignable = ap1;
-      previousCorrelations = (*itC1).second;
+      theReadAlignable = ap1;
+      theReadTable = (*itC1).second;
 
       CorrelationsTable::const_iterator itC2 = (*itC1).second->find(ap2);
       if (itC2 != (*itC1).second->end()) {
@@ -50,34 +46,25 @@ void AlignmentCorrelationsStore::correlations(
 
 void AlignmentCorrelationsStore::setCorrelations(
     Alignable* ap1, Alignable* ap2, const AlgebraicSymMatrix& cov, int row, int col) {
-  static Alignable* previousAlignable = nullptr;
-  static CorrelationsTable* previousCorrelations;
-
-  // Needed by 'resetCorrelations()' to reset the static pointer:
-  if (ap1 == nullptr) {
-    previousAlignable = nullptr;
-    return;
-  }
-
   bool transpose = (ap2 > ap1);
   if (transpose)
     std::swap(ap1, ap2);
 
-  if (ap1 == previousAlignable) {
-    fillCorrelationsTable(ap1, ap2, previousCorrelations, cov, row, col, transpose);
+  if (ap1 == theWrittenAlignable) {
+    fillCorrelationsTable(ap1, ap2, theWrittenTable, cov, row, col, transpose);
   } else {
     Correlations::iterator itC = theCorrelations.find(ap1);
     if (itC != theCorrelations.end()) {
       fillCorrelationsTable(ap1, ap2, itC->second, cov, row, col, transpose);
-      previousAlignable = ap1;
-      previousCorrelations = itC->second;
+      theWrittenAlignable = ap1;
+      theWrittenTable = itC->second;
     } else {
       CorrelationsTable* newTable = new CorrelationsTable;
       fillCorrelationsTable(ap1, ap2, newTable, cov, row, col, transpose);
 
       theCorrelations[ap1] = newTable;
-      previousAlignable = ap1;
-      previousCorrelations = newTable;
+      theWrittenAlignable = ap1;
+      theWrittenTable = newTable;
     }
   }
 }
@@ -117,10 +104,11 @@ void AlignmentCorrelationsStore::resetCorrelations(void) {
     delete (*itC).second;
   theCorrelations.erase(theCorrelations.begin(), theCorrelations.end());
 
-  // Reset the static pointers to the 'previous alignables'
-  AlgebraicSymMatrix dummy;
-  correlations(nullptr, nullptr, dummy, 0, 0);
-  setCorrelations(nullptr, nullptr, dummy, 0, 0);
+  // Reset the tables of the 'previous alignables'
+  theReadAlignable = nullptr;
+  theReadTable = nullptr;
+  theWrittenAlignable = nullptr;
+  theWrittenTable = nullptr;
 }
 
 unsigned int AlignmentCorrelationsStore::size(void) const {
@@ -0,0 +1,66 @@
+#ifndef CUDADataFormats_EcalDigi_interface_EcalDigiCUDA_h
+#define CUDADataFormats_EcalDigi_interface_EcalDigiCUDA_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * The EcalDigiSoA of an event on the device. It is filled by an unpacker
+ * on the device, or copied from the host: only the header and the first
+ * nDigis() entries of each array are copied, in either direction.
+ */
+class EcalDigiCUDA {
+public:
+  EcalDigiCUDA() = default;
+  explicit EcalDigiCUDA(cudaStream_t stream) : digis_d{cms::cuda::make_device_unique<EcalDigiSoA>(stream)} {}
+  EcalDigiCUDA(EcalDigiSoA const &digis, cudaStream_t stream)
+      : digis_d{cms::cuda::make_device_unique<EcalDigiSoA>(stream)}, nDigis_{digis.nDigis} {
+    auto *d = digis_d.get();
+    auto copy = [&](auto *dst, auto const *src, size_t size) {
+      cudaCheck(cudaMemcpyAsync(dst, src, size, cudaMemcpyHostToDevice, stream));
+    };
+    copy(&d->nDigis, &digis.nDigis, sizeof(uint32_t));
+    copy(&d->nBarrelDigis, &digis.nBarrelDigis, sizeof(uint32_t));
+    copy(d->id, digis.id, nDigis_ * sizeof(uint32_t));
+    copy(d->channel, digis.channel, nDigis_ * sizeof(uint32_t));
+    copy(d->samples, digis.samples, nDigis_ * sizeof(digis.samples[0]));
+  }
+  ~EcalDigiCUDA() = default;
+
+  EcalDigiCUDA(const EcalDigiCUDA &) = delete;
+  EcalDigiCUDA &operator=(const EcalDigiCUDA &) = delete;
+  EcalDigiCUDA(EcalDigiCUDA &&) = default;
+  EcalDigiCUDA &operator=(EcalDigiCUDA &&) = default;
+
+  EcalDigiSoA *get() { return digis_d.get(); }
+  EcalDigiSoA const *get() const { return digis_d.get(); }
+
+  // known on the host, for the size of the grids; an unpacker on the device sets it to an upper bound
+  uint32_t nDigis() const { return nDigis_; }
+  void setNDigis(uint32_t nDigis) { nDigis_ = nDigis; }
+
+  cms::cuda::host::unique_ptr<EcalDigiSoA> toHostAsync(cudaStream_t stream) const {
+    auto digis = cms::cuda::make_host_unique<EcalDigiSoA>(stream);
+    auto *h = digis.get();
+    auto const *d = digis_d.get();
+    auto copy = [&](auto *dst, auto const *src, size_t size) {
+      cudaCheck(cudaMemcpyAsync(dst, src, size, cudaMemcpyDeviceToHost, stream));
+    };
+    copy(&h->nDigis, &d->nDigis, sizeof(uint32_t));
+    copy(&h->nBarrelDigis, &d->nBarrelDigis, sizeof(uint32_t));
+    copy(h->id, d->id, nDigis_ * sizeof(uint32_t));
+    copy(h->channel, d->channel, nDigis_ * sizeof(uint32_t));
+    copy(h->samples, d->samples, nDigis_ * sizeof(d->samples[0]));
+    return digis;
+  }
+
+private:
+  cms::cuda::device::unique_ptr<EcalDigiSoA> digis_d;
+  uint32_t nDigis_ = 0;
+};
+
+#endif
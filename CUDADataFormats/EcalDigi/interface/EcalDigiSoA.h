@@ -0,0 +1,41 @@
+#ifndef CUDADataFormats_EcalDigi_interface_EcalDigiSoA_h
+#define CUDADataFormats_EcalDigi_interface_EcalDigiSoA_h
+
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define ECALDIGI_HOST_DEVICE __host__ __device__
+#else
+#define ECALDIGI_HOST_DEVICE
+#endif
+
+/**
+ * The digis of the ECAL barrel and endcap crystals of an event, as a
+ * structure of arrays with room for every crystal: the barrel digis come
+ * first, then the endcap ones. The same layout is copied to the device or
+ * used on the host.
+ *
+ * The samples are the raw EcalMGPASample words, the ADC count in the low
+ * 12 bits and the gain id in the next 2. The channel is the dense index
+ * of the crystal, EBDetId::hashedIndex() in the barrel, nBarrelChannels +
+ * EEDetId::hashedIndex() in the endcap.
+ */
+class EcalDigiSoA {
+public:
+  // EBDetId::kSizeForDenseIndexing, EEDetId::kSizeForDenseIndexing
+  static constexpr uint32_t nBarrelChannels = 61200;
+  static constexpr uint32_t nEndcapChannels = 14648;
+  static constexpr uint32_t maxDigis = nBarrelChannels + nEndcapChannels;
+  static constexpr uint32_t nSamples = 10;
+
+  ECALDIGI_HOST_DEVICE bool isBarrel(uint32_t i) const { return i < nBarrelDigis; }
+
+  uint32_t nDigis;
+  uint32_t nBarrelDigis;
+
+  uint32_t id[maxDigis];  // DetId::rawId()
+  uint32_t channel[maxDigis];
+  uint16_t samples[maxDigis][nSamples];
+};
+
+#endif
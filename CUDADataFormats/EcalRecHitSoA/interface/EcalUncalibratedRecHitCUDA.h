@@ -0,0 +1,58 @@
+#ifndef CUDADataFormats_EcalRecHitSoA_interface_EcalUncalibratedRecHitCUDA_h
+#define CUDADataFormats_EcalRecHitSoA_interface_EcalUncalibratedRecHitCUDA_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitSoA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * The EcalUncalibratedRecHitSoA of an event on the device. The number of
+ * rechits is that of the digis they come from, known on the host as an
+ * upper bound: toHostAsync() copies the header and that many entries.
+ */
+class EcalUncalibratedRecHitCUDA {
+public:
+  EcalUncalibratedRecHitCUDA() = default;
+  EcalUncalibratedRecHitCUDA(uint32_t maxRecHits, cudaStream_t stream)
+      : recHits_d{cms::cuda::make_device_unique<EcalUncalibratedRecHitSoA>(stream)}, maxRecHits_{maxRecHits} {}
+  ~EcalUncalibratedRecHitCUDA() = default;
+
+  EcalUncalibratedRecHitCUDA(const EcalUncalibratedRecHitCUDA &) = delete;
+  EcalUncalibratedRecHitCUDA &operator=(const EcalUncalibratedRecHitCUDA &) = delete;
+  EcalUncalibratedRecHitCUDA(EcalUncalibratedRecHitCUDA &&) = default;
+  EcalUncalibratedRecHitCUDA &operator=(EcalUncalibratedRecHitCUDA &&) = default;
+
+  EcalUncalibratedRecHitSoA *get() { return recHits_d.get(); }
+  EcalUncalibratedRecHitSoA const *get() const { return recHits_d.get(); }
+
+  uint32_t maxRecHits() const { return maxRecHits_; }
+
+  cms::cuda::host::unique_ptr<EcalUncalibratedRecHitSoA> toHostAsync(cudaStream_t stream) const {
+    auto recHits = cms::cuda::make_host_unique<EcalUncalibratedRecHitSoA>(stream);
+    auto *h = recHits.get();
+    auto const *d = recHits_d.get();
+    auto copy = [&](auto *dst, auto const *src, size_t size) {
+      cudaCheck(cudaMemcpyAsync(dst, src, size, cudaMemcpyDeviceToHost, stream));
+    };
+    copy(&h->nRecHits, &d->nRecHits, sizeof(uint32_t));
+    copy(&h->nBarrelRecHits, &d->nBarrelRecHits, sizeof(uint32_t));
+    copy(h->id, d->id, maxRecHits_ * sizeof(uint32_t));
+    copy(h->amplitude, d->amplitude, maxRecHits_ * sizeof(float));
+    copy(h->amplitudeError, d->amplitudeError, maxRecHits_ * sizeof(float));
+    copy(h->pedestal, d->pedestal, maxRecHits_ * sizeof(float));
+    copy(h->chi2, d->chi2, maxRecHits_ * sizeof(float));
+    copy(h->jitter, d->jitter, maxRecHits_ * sizeof(float));
+    copy(h->outOfTimeAmplitudes, d->outOfTimeAmplitudes, maxRecHits_ * sizeof(d->outOfTimeAmplitudes[0]));
+    copy(h->flags, d->flags, maxRecHits_ * sizeof(uint32_t));
+    return recHits;
+  }
+
+private:
+  cms::cuda::device::unique_ptr<EcalUncalibratedRecHitSoA> recHits_d;
+  uint32_t maxRecHits_ = 0;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CUDADataFormats_EcalRecHitSoA_interface_EcalUncalibratedRecHitSoA_h
+#define CUDADataFormats_EcalRecHitSoA_interface_EcalUncalibratedRecHitSoA_h
+
+#include <cstdint>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+
+/**
+ * The uncalibrated rechits of the digis of an EcalDigiSoA, one per digi
+ * in the same order, as a structure of arrays filled on the device or on
+ * the host.
+ *
+ * The amplitude (ADC counts of gain 12), its error, the pedestal, the
+ * chi2, the out-of-time amplitudes of the readout samples 0 to 9 and the
+ * flags are those of EcalUncalibratedRecHit; the jitter is not computed
+ * and left at 0.
+ */
+class EcalUncalibratedRecHitSoA {
+public:
+  static constexpr uint32_t maxRecHits = EcalDigiSoA::maxDigis;
+  static constexpr uint32_t nSamples = EcalDigiSoA::nSamples;
+
+  uint32_t nRecHits;
+  uint32_t nBarrelRecHits;
+
+  uint32_t id[maxRecHits];
+  float amplitude[maxRecHits];
+  float amplitudeError[maxRecHits];
+  float pedestal[maxRecHits];
+  float chi2[maxRecHits];
+  float jitter[maxRecHits];
+  float outOfTimeAmplitudes[maxRecHits][nSamples];
+  uint32_t flags[maxRecHits];
+};
+
+#endif
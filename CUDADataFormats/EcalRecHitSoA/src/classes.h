@@ -0,0 +1,4 @@
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitCUDA.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitSoA.h"
@@ -0,0 +1,40 @@
+#ifndef CUDADataFormats_ParticleFlow_interface_PFClusterCUDA_h
+#define CUDADataFormats_ParticleFlow_interface_PFClusterCUDA_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * The PFClusterSoA of an event on the device. The number of clusters is
+ * known only on the device: toHostAsync() copies the whole SoA back.
+ */
+class PFClusterCUDA {
+public:
+  PFClusterCUDA() = default;
+  explicit PFClusterCUDA(cudaStream_t stream) : clusters_d{cms::cuda::make_device_unique<PFClusterSoA>(stream)} {}
+  ~PFClusterCUDA() = default;
+
+  PFClusterCUDA(const PFClusterCUDA &) = delete;
+  PFClusterCUDA &operator=(const PFClusterCUDA &) = delete;
+  PFClusterCUDA(PFClusterCUDA &&) = default;
+  PFClusterCUDA &operator=(PFClusterCUDA &&) = default;
+
+  PFClusterSoA *get() { return clusters_d.get(); }
+  PFClusterSoA const *get() const { return clusters_d.get(); }
+
+  cms::cuda::host::unique_ptr<PFClusterSoA> toHostAsync(cudaStream_t stream) const {
+    auto clusters = cms::cuda::make_host_unique<PFClusterSoA>(stream);
+    cudaCheck(
+        cudaMemcpyAsync(clusters.get(), clusters_d.get(), sizeof(PFClusterSoA), cudaMemcpyDeviceToHost, stream));
+    return clusters;
+  }
+
+private:
+  cms::cuda::device::unique_ptr<PFClusterSoA> clusters_d;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef CUDADataFormats_ParticleFlow_interface_PFClusterSoA_h
+#define CUDADataFormats_ParticleFlow_interface_PFClusterSoA_h
+
+#include <cstdint>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitSoA.h"
+
+#if defined(__CUDACC__)
+#define PFCLUSTER_HOST_DEVICE __host__ __device__
+#else
+#define PFCLUSTER_HOST_DEVICE
+#endif
+
+/**
+ * The particle flow clusters of the rechits of a PFRecHitSoA, as a
+ * structure of arrays of fixed capacity, filled on the device or on the
+ * host.
+ *
+ * Each cluster grows from a seed rechit, seedHit, within the topological
+ * cluster topoId, identified by the index of one of its rechits. The
+ * energy (GeV), position (cm), depth, time (ns) and layer are those of
+ * Basic2DGenericPFlowPositionCalc on the rechit fractions.
+ *
+ * The clusters are ordered by topological cluster, and within one by
+ * seed. Their rechit fractions are stored together, grouped by cluster
+ * and ordered by rechit, but on the device the groups of the different
+ * topological clusters are in no given order: fracCluster and fracHit
+ * are the indices of the cluster and of the rechit.
+ *
+ * The clusters of the topological clusters that do not fit in the
+ * capacities are not stored, nor their fractions: nFound counts them.
+ */
+class PFClusterSoA {
+public:
+  static constexpr uint32_t maxClusters = 8 * 1024;
+  static constexpr uint32_t maxFractions = 256 * 1024;
+  static constexpr uint32_t maxRecHits = PFRecHitSoA::maxRecHits;
+
+  PFCLUSTER_HOST_DEVICE uint32_t nClusters() const { return nStored; }
+  PFCLUSTER_HOST_DEVICE uint32_t nFractions() const { return nFractionsStored; }
+  PFCLUSTER_HOST_DEVICE bool overflow() const { return nFound > nStored; }
+
+  // all the clusters found, also those not stored
+  uint32_t nFound;
+  uint32_t nStored;
+  uint32_t nFractionsStored;
+
+  uint32_t seedHit[maxClusters];
+  uint32_t topoId[maxClusters];
+  float energy[maxClusters];
+  float x[maxClusters];
+  float y[maxClusters];
+  float z[maxClusters];
+  float depth[maxClusters];
+  float time[maxClusters];
+  int8_t layer[maxClusters];
+
+  uint32_t fracCluster[maxFractions];
+  uint32_t fracHit[maxFractions];
+  float fraction[maxFractions];
+
+  // the topological cluster of each rechit of the PFRecHitSoA, -1 for those in none with stored clusters
+  int32_t hitTopoId[maxRecHits];
+  bool isSeed[maxRecHits];
+};
+
+#endif
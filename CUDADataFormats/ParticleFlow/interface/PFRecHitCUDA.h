@@ -0,0 +1,52 @@
+#ifndef CUDADataFormats_ParticleFlow_interface_PFRecHitCUDA_h
+#define CUDADataFormats_ParticleFlow_interface_PFRecHitCUDA_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitSoA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+/**
+ * The PFRecHitSoA of an event on the device, copied from the host: only
+ * the header and the first nRecHits() entries of each array are copied.
+ */
+class PFRecHitCUDA {
+public:
+  PFRecHitCUDA() = default;
+  PFRecHitCUDA(PFRecHitSoA const &hits, cudaStream_t stream)
+      : recHits_d{cms::cuda::make_device_unique<PFRecHitSoA>(stream)}, nRecHits_{hits.nRecHits()} {
+    auto *d = recHits_d.get();
+    auto copy = [&](auto *dst, auto const *src, size_t size) {
+      cudaCheck(cudaMemcpyAsync(dst, src, size, cudaMemcpyHostToDevice, stream));
+    };
+    copy(&d->nFound, &hits.nFound, sizeof(uint32_t));
+    copy(d->energy, hits.energy, nRecHits_ * sizeof(float));
+    copy(d->time, hits.time, nRecHits_ * sizeof(float));
+    copy(d->x, hits.x, nRecHits_ * sizeof(float));
+    copy(d->y, hits.y, nRecHits_ * sizeof(float));
+    copy(d->z, hits.z, nRecHits_ * sizeof(float));
+    copy(d->layer, hits.layer, nRecHits_ * sizeof(int8_t));
+    copy(d->depth, hits.depth, nRecHits_ * sizeof(int8_t));
+    copy(d->nNeighbours4, hits.nNeighbours4, nRecHits_ * sizeof(uint8_t));
+    copy(d->nNeighbours8, hits.nNeighbours8, nRecHits_ * sizeof(uint8_t));
+    copy(d->neighbours, hits.neighbours, nRecHits_ * sizeof(hits.neighbours[0]));
+  }
+  ~PFRecHitCUDA() = default;
+
+  PFRecHitCUDA(const PFRecHitCUDA &) = delete;
+  PFRecHitCUDA &operator=(const PFRecHitCUDA &) = delete;
+  PFRecHitCUDA(PFRecHitCUDA &&) = default;
+  PFRecHitCUDA &operator=(PFRecHitCUDA &&) = default;
+
+  PFRecHitSoA const *get() const { return recHits_d.get(); }
+
+  // known on the host, for the size of the grids
+  uint32_t nRecHits() const { return nRecHits_; }
+
+private:
+  cms::cuda::device::unique_ptr<PFRecHitSoA> recHits_d;
+  uint32_t nRecHits_ = 0;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef CUDADataFormats_ParticleFlow_interface_PFRecHitSoA_h
+#define CUDADataFormats_ParticleFlow_interface_PFRecHitSoA_h
+
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define PFRECHIT_HOST_DEVICE __host__ __device__
+#else
+#define PFRECHIT_HOST_DEVICE
+#endif
+
+/**
+ * The particle flow rechits of an event, as a structure of arrays of
+ * fixed capacity, in the order of the reco::PFRecHitCollection they come
+ * from: the same layout is copied to the device or used on the host.
+ *
+ * The layer is the PFLayer::Layer of the hit, the position that of its
+ * calorimeter cell (cm). The neighbours are indices in the same rechits,
+ * the first nNeighbours4 of them sharing a side with the hit, the first
+ * nNeighbours8 of them a side or a corner, as PFRecHit::neighbours4() and
+ * PFRecHit::neighbours8().
+ *
+ * The rechits beyond maxRecHits are not stored, and nRecHits() is at most
+ * maxRecHits; the neighbours beyond maxRecHits are dropped.
+ */
+class PFRecHitSoA {
+public:
+  static constexpr uint32_t maxRecHits = 32 * 1024;
+  static constexpr uint32_t maxNeighbours = 8;
+
+  PFRECHIT_HOST_DEVICE uint32_t nRecHits() const { return nFound < maxRecHits ? nFound : maxRecHits; }
+  PFRECHIT_HOST_DEVICE bool overflow() const { return nFound > maxRecHits; }
+
+  // all the rechits, also above maxRecHits
+  uint32_t nFound;
+
+  float energy[maxRecHits];  // GeV
+  float time[maxRecHits];    // ns
+  float x[maxRecHits];
+  float y[maxRecHits];
+  float z[maxRecHits];
+  int8_t layer[maxRecHits];
+  int8_t depth[maxRecHits];
+
+  uint8_t nNeighbours4[maxRecHits];
+  uint8_t nNeighbours8[maxRecHits];
+  uint32_t neighbours[maxRecHits][maxNeighbours];
+};
+
+#endif
@@ -0,0 +1,4 @@
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterCUDA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
@@ -0,0 +1,110 @@
+#ifndef CUDADataFormats_SiPixelCluster_interface_SiPixelClustersCUDA_h
+#define CUDADataFormats_SiPixelCluster_interface_SiPixelClustersCUDA_h
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+/**
+ * The pixel digis of an event, unpacked and calibrated on the device,
+ * grouped by module and labelled with the cluster they belong to.
+ *
+ * The digis of the module m are [moduleStart[m], moduleStart[m+1]),
+ * their cluster index goes from 0 to clusInModule[m]-1, or is
+ * invalidCluster for the pixels not kept in any cluster, and the
+ * clusters of the module are [clusModuleStart[m], clusModuleStart[m+1])
+ * among the clusters of the event. The module index is the index of
+ * the pixel GeomDetUnit in the TrackerGeometry.
+ *
+ * Only maxDigis(), an upper bound on the number of digis given by the
+ * number of data words, is known on the host: the actual numbers are
+ * moduleStart[nModules] and clusModuleStart[nModules] on the device.
+ */
+class SiPixelClustersCUDA {
+public:
+  static constexpr int32_t invalidCluster = -1;
+
+  struct DeviceView {
+    // per digi
+    uint16_t *xx;         // row in the module
+    uint16_t *yy;         // column in the module
+    uint16_t *adc;        // raw ADC count
+    uint16_t *charge;     // calibrated charge in electrons
+    uint16_t *moduleInd;  // module index
+    uint32_t *pdigi;      // position of the data word in the event, to order the digis as the CPU unpacking
+    int32_t *clus;        // cluster index in the module
+    // per module
+    uint32_t *moduleStart;      // nModules+1 entries
+    uint32_t *clusInModule;     // nModules entries
+    uint32_t *clusModuleStart;  // nModules+1 entries
+    uint32_t nModules;
+  };
+
+  SiPixelClustersCUDA() = default;
+  SiPixelClustersCUDA(uint32_t maxDigis, uint32_t nModules, cudaStream_t stream)
+      : xx_d{cms::cuda::make_device_unique<uint16_t[]>(maxDigis, stream)},
+        yy_d{cms::cuda::make_device_unique<uint16_t[]>(maxDigis, stream)},
+        adc_d{cms::cuda::make_device_unique<uint16_t[]>(maxDigis, stream)},
+        charge_d{cms::cuda::make_device_unique<uint16_t[]>(maxDigis, stream)},
+        moduleInd_d{cms::cuda::make_device_unique<uint16_t[]>(maxDigis, stream)},
+        pdigi_d{cms::cuda::make_device_unique<uint32_t[]>(maxDigis, stream)},
+        clus_d{cms::cuda::make_device_unique<int32_t[]>(maxDigis, stream)},
+        moduleStart_d{cms::cuda::make_device_unique<uint32_t[]>(nModules + 1, stream)},
+        clusInModule_d{cms::cuda::make_device_unique<uint32_t[]>(nModules, stream)},
+        clusModuleStart_d{cms::cuda::make_device_unique<uint32_t[]>(nModules + 1, stream)},
+        maxDigis_{maxDigis},
+        nModules_{nModules} {}
+  ~SiPixelClustersCUDA() = default;
+
+  SiPixelClustersCUDA(const SiPixelClustersCUDA &) = delete;
+  SiPixelClustersCUDA &operator=(const SiPixelClustersCUDA &) = delete;
+  SiPixelClustersCUDA(SiPixelClustersCUDA &&) = default;
+  SiPixelClustersCUDA &operator=(SiPixelClustersCUDA &&) = default;
+
+  uint32_t maxDigis() const { return maxDigis_; }
+  uint32_t nModules() const { return nModules_; }
+
+  DeviceView view() const {
+    return DeviceView{xx_d.get(),
+                      yy_d.get(),
+                      adc_d.get(),
+                      charge_d.get(),
+                      moduleInd_d.get(),
+                      pdigi_d.get(),
+                      clus_d.get(),
+                      moduleStart_d.get(),
+                      clusInModule_d.get(),
+                      clusModuleStart_d.get(),
+                      nModules_};
+  }
+
+  uint16_t const *xx() const { return xx_d.get(); }
+  uint16_t const *yy() const { return yy_d.get(); }
+  uint16_t const *adc() const { return adc_d.get(); }
+  uint16_t const *charge() const { return charge_d.get(); }
+  uint16_t const *moduleInd() const { return moduleInd_d.get(); }
+  uint32_t const *pdigi() const { return pdigi_d.get(); }
+  int32_t const *clus() const { return clus_d.get(); }
+  uint32_t const *moduleStart() const { return moduleStart_d.get(); }
+  uint32_t const *clusInModule() const { return clusInModule_d.get(); }
+  uint32_t const *clusModuleStart() const { return clusModuleStart_d.get(); }
+
+private:
+  cms::cuda::device::unique_ptr<uint16_t[]> xx_d;
+  cms::cuda::device::unique_ptr<uint16_t[]> yy_d;
+  cms::cuda::device::unique_ptr<uint16_t[]> adc_d;
+  cms::cuda::device::unique_ptr<uint16_t[]> charge_d;
+  cms::cuda::device::unique_ptr<uint16_t[]> moduleInd_d;
+  cms::cuda::device::unique_ptr<uint32_t[]> pdigi_d;
+  cms::cuda::device::unique_ptr<int32_t[]> clus_d;
+  cms::cuda::device::unique_ptr<uint32_t[]> moduleStart_d;
+  cms::cuda::device::unique_ptr<uint32_t[]> clusInModule_d;
+  cms::cuda::device::unique_ptr<uint32_t[]> clusModuleStart_d;
+
+  uint32_t maxDigis_ = 0;
+  uint32_t nModules_ = 0;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef CUDADataFormats_Track_interface_PixelTrackCUDA_h
+#define CUDADataFormats_Track_interface_PixelTrackCUDA_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * The PixelTrackSoA of an event on the device. The number of tracks is
+ * known only on the device: toHostAsync() copies the whole SoA back.
+ */
+class PixelTrackCUDA {
+public:
+  PixelTrackCUDA() = default;
+  explicit PixelTrackCUDA(cudaStream_t stream) : tracks_d{cms::cuda::make_device_unique<PixelTrackSoA>(stream)} {}
+  ~PixelTrackCUDA() = default;
+
+  PixelTrackCUDA(const PixelTrackCUDA &) = delete;
+  PixelTrackCUDA &operator=(const PixelTrackCUDA &) = delete;
+  PixelTrackCUDA(PixelTrackCUDA &&) = default;
+  PixelTrackCUDA &operator=(PixelTrackCUDA &&) = default;
+
+  PixelTrackSoA *get() { return tracks_d.get(); }
+  PixelTrackSoA const *get() const { return tracks_d.get(); }
+
+  cms::cuda::host::unique_ptr<PixelTrackSoA> toHostAsync(cudaStream_t stream) const {
+    auto tracks = cms::cuda::make_host_unique<PixelTrackSoA>(stream);
+    cudaCheck(cudaMemcpyAsync(tracks.get(), tracks_d.get(), sizeof(PixelTrackSoA), cudaMemcpyDeviceToHost, stream));
+    return tracks;
+  }
+
+private:
+  cms::cuda::device::unique_ptr<PixelTrackSoA> tracks_d;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef CUDADataFormats_Track_interface_PixelTrackSoA_h
+#define CUDADataFormats_Track_interface_PixelTrackSoA_h
+
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define PIXELTRACK_HOST_DEVICE __host__ __device__
+#else
+#define PIXELTRACK_HOST_DEVICE
+#endif
+
+/**
+ * The pixel tracks of an event, as a structure of arrays of fixed
+ * capacity: the same layout is filled on the device, copied back to the
+ * host as a whole, or filled directly on the host.
+ *
+ * The hits of a track are given, from the innermost one, as indices in
+ * the hits the tracks were built from (e.g. TrackingRecHit2DCUDA). The
+ * track parameters are those of a fast fit of the hits: the transverse
+ * momentum (GeV), the azimuthal angle and the pseudorapidity at the point
+ * of closest approach to the beam line, the transverse impact parameter
+ * and the z of that point (cm).
+ *
+ * More tracks than maxTracks may have been found: only the first
+ * maxTracks are stored, and nTracks() is at most maxTracks.
+ */
+class PixelTrackSoA {
+public:
+  static constexpr uint32_t maxTracks = 32 * 1024;
+  static constexpr uint32_t maxHitsPerTrack = 4;
+
+  PIXELTRACK_HOST_DEVICE uint32_t nTracks() const { return nFound < maxTracks ? nFound : maxTracks; }
+  PIXELTRACK_HOST_DEVICE bool overflow() const { return nFound > maxTracks; }
+
+  // all the tracks found, also above maxTracks
+  uint32_t nFound;
+
+  uint8_t nHits[maxTracks];
+  uint32_t hitIndices[maxTracks][maxHitsPerTrack];
+
+  float pt[maxTracks];
+  float phi[maxTracks];
+  float eta[maxTracks];
+  float tip[maxTracks];
+  float zip[maxTracks];
+  int8_t charge[maxTracks];
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef CUDADataFormats_TrackingRecHit_interface_TrackingRecHit2DCUDA_h
+#define CUDADataFormats_TrackingRecHit_interface_TrackingRecHit2DCUDA_h
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+/**
+ * The pixel rechits of an event on the device, one per cluster of
+ * SiPixelClustersCUDA and in the same order: the hits of the module m
+ * are [hitsModuleStart[m], hitsModuleStart[m+1]). The local positions
+ * and errors are in cm, in the frame of the module, the global
+ * positions in the global frame.
+ *
+ * Only maxHits(), an upper bound on the number of hits, is known on the
+ * host: the actual number is hitsModuleStart[nModules] on the device.
+ */
+class TrackingRecHit2DCUDA {
+public:
+  struct DeviceView {
+    float *xl;
+    float *yl;
+    float *xerr2;
+    float *yerr2;
+    float *xg;
+    float *yg;
+    float *zg;
+    int32_t *charge;
+    int16_t *sizeX;
+    int16_t *sizeY;
+    uint16_t *detIndex;
+    uint32_t *hitsModuleStart;  // nModules+1 entries
+    uint32_t nModules;
+  };
+
+  TrackingRecHit2DCUDA() = default;
+  TrackingRecHit2DCUDA(uint32_t maxHits, uint32_t nModules, cudaStream_t stream)
+      : xl_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        yl_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        xerr2_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        yerr2_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        xg_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        yg_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        zg_d{cms::cuda::make_device_unique<float[]>(maxHits, stream)},
+        charge_d{cms::cuda::make_device_unique<int32_t[]>(maxHits, stream)},
+        sizeX_d{cms::cuda::make_device_unique<int16_t[]>(maxHits, stream)},
+        sizeY_d{cms::cuda::make_device_unique<int16_t[]>(maxHits, stream)},
+        detIndex_d{cms::cuda::make_device_unique<uint16_t[]>(maxHits, stream)},
+        hitsModuleStart_d{cms::cuda::make_device_unique<uint32_t[]>(nModules + 1, stream)},
+        maxHits_{maxHits},
+        nModules_{nModules} {}
+  ~TrackingRecHit2DCUDA() = default;
+
+  TrackingRecHit2DCUDA(const TrackingRecHit2DCUDA &) = delete;
+  TrackingRecHit2DCUDA &operator=(const TrackingRecHit2DCUDA &) = delete;
+  TrackingRecHit2DCUDA(TrackingRecHit2DCUDA &&) = default;
+  TrackingRecHit2DCUDA &operator=(TrackingRecHit2DCUDA &&) = default;
+
+  uint32_t maxHits() const { return maxHits_; }
+  uint32_t nModules() const { return nModules_; }
+
+  DeviceView view() const {
+    return DeviceView{xl_d.get(),
+                      yl_d.get(),
+                      xerr2_d.get(),
+                      yerr2_d.get(),
+                      xg_d.get(),
+                      yg_d.get(),
+                      zg_d.get(),
+                      charge_d.get(),
+                      sizeX_d.get(),
+                      sizeY_d.get(),
+                      detIndex_d.get(),
+                      hitsModuleStart_d.get(),
+                      nModules_};
+  }
+
+  float const *xl() const { return xl_d.get(); }
+  float const *yl() const { return yl_d.get(); }
+  float const *xerr2() const { return xerr2_d.get(); }
+  float const *yerr2() const { return yerr2_d.get(); }
+  float const *xg() const { return xg_d.get(); }
+  float const *yg() const { return yg_d.get(); }
+  float const *zg() const { return zg_d.get(); }
+  int32_t const *charge() const { return charge_d.get(); }
+  int16_t const *sizeX() const { return sizeX_d.get(); }
+  int16_t const *sizeY() const { return sizeY_d.get(); }
+  uint16_t const *detIndex() const { return detIndex_d.get(); }
+  uint32_t const *hitsModuleStart() const { return hitsModuleStart_d.get(); }
+
+private:
+  cms::cuda::device::unique_ptr<float[]> xl_d;
+  cms::cuda::device::unique_ptr<float[]> yl_d;
+  cms::cuda::device::unique_ptr<float[]> xerr2_d;
+  cms::cuda::device::unique_ptr<float[]> yerr2_d;
+  cms::cuda::device::unique_ptr<float[]> xg_d;
+  cms::cuda::device::unique_ptr<float[]> yg_d;
+  cms::cuda::device::unique_ptr<float[]> zg_d;
+  cms::cuda::device::unique_ptr<int32_t[]> charge_d;
+  cms::cuda::device::unique_ptr<int16_t[]> sizeX_d;
+  cms::cuda::device::unique_ptr<int16_t[]> sizeY_d;
+  cms::cuda::device::unique_ptr<uint16_t[]> detIndex_d;
+  cms::cuda::device::unique_ptr<uint32_t[]> hitsModuleStart_d;
+
+  uint32_t maxHits_ = 0;
+  uint32_t nModules_ = 0;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef CUDADataFormats_Vertex_interface_ZVertexCUDA_h
+#define CUDADataFormats_Vertex_interface_ZVertexCUDA_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * The ZVertexSoA of an event on the device. The number of vertices is
+ * known only on the device: toHostAsync() copies the whole SoA back.
+ */
+class ZVertexCUDA {
+public:
+  ZVertexCUDA() = default;
+  explicit ZVertexCUDA(cudaStream_t stream) : vertices_d{cms::cuda::make_device_unique<ZVertexSoA>(stream)} {}
+  ~ZVertexCUDA() = default;
+
+  ZVertexCUDA(const ZVertexCUDA &) = delete;
+  ZVertexCUDA &operator=(const ZVertexCUDA &) = delete;
+  ZVertexCUDA(ZVertexCUDA &&) = default;
+  ZVertexCUDA &operator=(ZVertexCUDA &&) = default;
+
+  ZVertexSoA *get() { return vertices_d.get(); }
+  ZVertexSoA const *get() const { return vertices_d.get(); }
+
+  cms::cuda::host::unique_ptr<ZVertexSoA> toHostAsync(cudaStream_t stream) const {
+    auto vertices = cms::cuda::make_host_unique<ZVertexSoA>(stream);
+    cudaCheck(cudaMemcpyAsync(vertices.get(), vertices_d.get(), sizeof(ZVertexSoA), cudaMemcpyDeviceToHost, stream));
+    return vertices;
+  }
+
+private:
+  cms::cuda::device::unique_ptr<ZVertexSoA> vertices_d;
+};
+
+#endif
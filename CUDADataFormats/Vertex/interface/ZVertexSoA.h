@@ -0,0 +1,46 @@
+#ifndef CUDADataFormats_Vertex_interface_ZVertexSoA_h
+#define CUDADataFormats_Vertex_interface_ZVertexSoA_h
+
+#include <cstdint>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+
+#if defined(__CUDACC__)
+#define ZVERTEX_HOST_DEVICE __host__ __device__
+#else
+#define ZVERTEX_HOST_DEVICE
+#endif
+
+/**
+ * The pixel vertices of an event along z, as a structure of arrays of
+ * fixed capacity, filled from a PixelTrackSoA on the device or on the
+ * host.
+ *
+ * The vertices are not in a given order, some of them may have lost all
+ * their tracks: sortInd[0, nvFinal) are the indices of the vertices with
+ * tracks, by decreasing sum of the pt^2 of their tracks. idv gives the
+ * vertex of each track of the PixelTrackSoA, -1 for those in no vertex.
+ */
+class ZVertexSoA {
+public:
+  static constexpr uint32_t maxVertices = 1024;
+  static constexpr uint32_t maxTracks = PixelTrackSoA::maxTracks;
+
+  ZVERTEX_HOST_DEVICE uint32_t nVertices() const { return nFound < maxVertices ? nFound : maxVertices; }
+  ZVERTEX_HOST_DEVICE bool overflow() const { return nFound > maxVertices; }
+
+  // all the vertices found, also above maxVertices
+  uint32_t nFound;
+  uint32_t nvFinal;
+
+  float zv[maxVertices];    // cm
+  float wv[maxVertices];    // 1/error^2 of zv
+  float chi2[maxVertices];  // of the tracks to zv
+  float ptv2[maxVertices];  // GeV^2
+  int32_t ndof[maxVertices];
+  uint16_t sortInd[maxVertices];
+
+  int16_t idv[maxTracks];
+};
+
+#endif
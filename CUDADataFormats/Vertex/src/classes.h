@@ -0,0 +1,4 @@
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexCUDA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
@@ -75,6 +75,10 @@ public:
   float delay(float fC, BiasSetting bias = Medium) const;
   double delay(double fC, ParaSource source = HBHE, BiasSetting bias = Medium, bool isHPD = true) const;
 
+  /** \brief The parameters of delay(float, BiasSetting), for the algorithms
+   which evaluate it outside of this class. */
+  const HcalTimeSlewM2Parameters& m2Parameters(BiasSetting bias = Medium) const { return parametersM2_[bias]; }
+
 private:
   std::vector<HcalTimeSlewM2Parameters> parametersM2_;
   std::vector<HcalTimeSlewM3Parameters> parametersM3_;
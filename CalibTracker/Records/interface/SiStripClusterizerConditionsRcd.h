@@ -0,0 +1 @@
+#include "CalibTracker/Records/interface/SiStripDependentRecords.h"
@@ -65,4 +65,9 @@ class SiStripQualityRcd
                                                                                RunInfoRcd,
                                                                                SiStripBadModuleFedErrRcd> > {};
 
+class SiStripClusterizerConditionsRcd
+    : public edm::eventsetup::DependentRecordImplementation<
+          SiStripClusterizerConditionsRcd,
+          boost::mpl::vector<SiStripGainRcd, SiStripNoisesRcd, SiStripQualityRcd> > {};
+
 #endif
@@ -14,3 +14,4 @@ EVENTSETUP_RECORD_REG(SiStripBackPlaneCorrectionDepRcd);
 EVENTSETUP_RECORD_REG(SiStripHashedDetIdRcd);
 EVENTSETUP_RECORD_REG(SiStripBadModuleFedErrRcd);
 EVENTSETUP_RECORD_REG(SiStripQualityRcd);
+EVENTSETUP_RECORD_REG(SiStripClusterizerConditionsRcd);
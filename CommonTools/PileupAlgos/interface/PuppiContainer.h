@@ -4,6 +4,7 @@
 #include "CommonTools/PileupAlgos/interface/PuppiAlgo.h"
 #include "CommonTools/PileupAlgos/interface/RecoObj.h"
 #include "CommonTools/PileupAlgos/interface/PuppiCandidate.h"
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
 
 class PuppiContainer {
 public:
@@ -39,6 +40,11 @@ protected:
                       const std::vector<PuppiCandidate> &particles,
                       const PuppiCandidate &centre,
                       const double R);
+  double var_within_R(int iId,
+                      const std::vector<PuppiCandidate> &particles,
+                      const EtaPhiConeIndex &index,
+                      const PuppiCandidate &centre,
+                      const double R);
 
   bool fPuppiDiagnostics;
   const std::vector<RecoObj> *fRecoParticles;
@@ -64,5 +70,12 @@ protected:
   int fNPV;
   double fPVFrac;
   std::vector<PuppiAlgo> fPuppiAlgo;
+  //neighbours from indices in (y, phi) of the particles, with cells of the largest cone size; the phi of a
+  //PseudoJet is in [0, 2pi)
+  bool fUseBinnedSearch;
+  double fMaxConeSize;
+  EtaPhiConeIndex fPFIndex{EtaPhiConeIndex::PhiRange::kZeroToTwoPi};
+  EtaPhiConeIndex fChargedPVIndex{EtaPhiConeIndex::PhiRange::kZeroToTwoPi};
+  std::vector<unsigned int> fNearIndices;
 };
 #endif
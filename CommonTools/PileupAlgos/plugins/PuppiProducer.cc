@@ -370,6 +370,7 @@ void PuppiProducer::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.add<bool>("invertPuppi", false);
   desc.add<bool>("useExp", false);
   desc.add<double>("MinPuppiWeight", .01);
+  desc.add<bool>("useBinnedNeighbourSearch", false);
 
   PuppiAlgo::fillDescriptionsPuppiAlgo(desc);
 
@@ -4,11 +4,48 @@
 #include "TMath.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/isFinite.h"
 
 using namespace std;
 
+namespace {
+  double sumWithinR(int iId, vector<double> const &near_dR2s, vector<double> const &near_pts, double centrePt) {
+    double var = 0;
+    //double lSumPt = 0;
+    //if(iId == 1) for(auto  pt : near_pts) lSumPt += pt;
+    auto nParts = near_dR2s.size();
+    for (auto i = 0UL; i < nParts; ++i) {
+      auto dr2 = near_dR2s[i];
+      auto pt = near_pts[i];
+      if (dr2 < 0.0001)
+        continue;
+      if (iId == 0)
+        var += (pt / dr2);
+      else if (iId == 1)
+        var += pt;
+      else if (iId == 2)
+        var += (1. / dr2);
+      else if (iId == 3)
+        var += (1. / dr2);
+      else if (iId == 4)
+        var += pt;
+      else if (iId == 5)
+        var += (pt * pt / dr2);
+    }
+    if (iId == 1)
+      var += centrePt;  //Sum in a cone
+    else if (iId == 0 && var != 0)
+      var = log(var);
+    else if (iId == 3 && var != 0)
+      var = log(var);
+    else if (iId == 5 && var != 0)
+      var = log(var);
+    return var;
+  }
+}  // namespace
+
 PuppiContainer::PuppiContainer(const edm::ParameterSet &iConfig) {
   fPuppiDiagnostics = iConfig.getParameter<bool>("puppiDiagnostics");
   fApplyCHS = iConfig.getParameter<bool>("applyCHS");
@@ -25,6 +62,14 @@ PuppiContainer::PuppiContainer(const edm::ParameterSet &iConfig) {
     PuppiAlgo pPuppiConfig(lAlgos[i0]);
     fPuppiAlgo.push_back(pPuppiConfig);
   }
+  fUseBinnedSearch = iConfig.existsAs<bool>("useBinnedNeighbourSearch")
+                         ? iConfig.getParameter<bool>("useBinnedNeighbourSearch")
+                         : false;
+  fMaxConeSize = 0;
+  for (auto const &algo : fPuppiAlgo) {
+    for (int i1 = 0; i1 < algo.numAlgos(); i1++)
+      fMaxConeSize = std::max(fMaxConeSize, algo.coneSize(i1));
+  }
 }
 
 void PuppiContainer::initialize(const std::vector<RecoObj> &iRecoObjects) {
@@ -62,6 +107,12 @@ void PuppiContainer::initialize(const std::vector<RecoObj> &iRecoObjects) {
     //if(rParticle.id == 3) _chargedNoPV.push_back(curPseudoJet);
     // if(fNPV < rParticle.vtxId) fNPV = rParticle.vtxId;
   }
+  if (fUseBinnedSearch) {
+    auto rap = [](PuppiCandidate const &part) { return part.rap(); };
+    auto phi = [](PuppiCandidate const &part) { return part.phi(); };
+    fPFIndex.fill(fPFParticles, fMaxConeSize, rap, phi);
+    fChargedPVIndex.fill(fChargedPV, fMaxConeSize, rap, phi);
+  }
 }
 PuppiContainer::~PuppiContainer() {}
 
@@ -69,6 +120,8 @@ double PuppiContainer::goodVar(PuppiCandidate const &iPart,
                                std::vector<PuppiCandidate> const &iParts,
                                int iOpt,
                                const double iRCone) {
+  if (fUseBinnedSearch && (&iParts == &fPFParticles || &iParts == &fChargedPV))
+    return var_within_R(iOpt, iParts, &iParts == &fPFParticles ? fPFIndex : fChargedPVIndex, iPart, iRCone);
   return var_within_R(iOpt, iParts, iPart, iRCone);
 }
 
@@ -98,37 +151,32 @@ double PuppiContainer::var_within_R(int iId,
       near_pts.push_back(part.pt());
     }
   }
-  double var = 0;
-  //double lSumPt = 0;
-  //if(iId == 1) for(auto  pt : near_pts) lSumPt += pt;
-  auto nParts = near_dR2s.size();
-  for (auto i = 0UL; i < nParts; ++i) {
-    auto dr2 = near_dR2s[i];
-    auto pt = near_pts[i];
-    if (dr2 < 0.0001)
-      continue;
-    if (iId == 0)
-      var += (pt / dr2);
-    else if (iId == 1)
-      var += pt;
-    else if (iId == 2)
-      var += (1. / dr2);
-    else if (iId == 3)
-      var += (1. / dr2);
-    else if (iId == 4)
-      var += pt;
-    else if (iId == 5)
-      var += (pt * pt / dr2);
+  return sumWithinR(iId, near_dR2s, near_pts, centre.pt());
+}
+
+double PuppiContainer::var_within_R(int iId,
+                                    const vector<PuppiCandidate> &particles,
+                                    const EtaPhiConeIndex &index,
+                                    const PuppiCandidate &centre,
+                                    const double R) {
+  if (iId == -1)
+    return 1;
+
+  //the particles near the circle in rapidity-phi, with the selection of the loop over all of them
+  index.candidatesInCone(centre.rap(), centre.phi(), R, fNearIndices);
+  vector<double> near_dR2s;
+  near_dR2s.reserve(fNearIndices.size());
+  vector<double> near_pts;
+  near_pts.reserve(fNearIndices.size());
+  const double r2 = R * R;
+  for (auto i : fNearIndices) {
+    auto const &part = particles[i];
+    if (std::abs(part.rap() - centre.rap()) < R && part.squared_distance(centre) < r2) {
+      near_dR2s.push_back(reco::deltaR2(part, centre));
+      near_pts.push_back(part.pt());
+    }
   }
-  if (iId == 1)
-    var += centre.pt();  //Sum in a cone
-  else if (iId == 0 && var != 0)
-    var = log(var);
-  else if (iId == 3 && var != 0)
-    var = log(var);
-  else if (iId == 5 && var != 0)
-    var = log(var);
-  return var;
+  return sumWithinR(iId, near_dR2s, near_pts, centre.pt());
 }
 //In fact takes the median not the average
 void PuppiContainer::getRMSAvg(int iOpt,
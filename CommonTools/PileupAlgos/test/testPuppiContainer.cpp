@@ -0,0 +1,94 @@
+// The PUPPI weights and alphas of a fixed set of particles are the same whether the neighbours in the cones are
+// found in the binned rapidity-phi index or by the loop over all the particles.
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "CommonTools/PileupAlgos/interface/PuppiContainer.h"
+#include "CommonTools/PileupAlgos/interface/RecoObj.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+namespace {
+  edm::ParameterSet algo(double etaMin, double etaMax, bool useCharged) {
+    edm::ParameterSet puppiAlgo;
+    puppiAlgo.addParameter<int>("algoId", 5);
+    puppiAlgo.addParameter<bool>("useCharged", useCharged);
+    puppiAlgo.addParameter<bool>("applyLowPUCorr", true);
+    puppiAlgo.addParameter<int>("combOpt", 0);
+    puppiAlgo.addParameter<double>("cone", 0.4);
+    puppiAlgo.addParameter<double>("rmsPtMin", 0.1);
+    puppiAlgo.addParameter<double>("rmsScaleFactor", 1.0);
+
+    edm::ParameterSet region;
+    region.addParameter<std::vector<double>>("etaMin", {etaMin});
+    region.addParameter<std::vector<double>>("etaMax", {etaMax});
+    region.addParameter<std::vector<double>>("ptMin", {0.});
+    region.addParameter<std::vector<double>>("MinNeutralPt", {0.2});
+    region.addParameter<std::vector<double>>("MinNeutralPtSlope", {0.015});
+    region.addParameter<std::vector<double>>("RMSEtaSF", {1.0});
+    region.addParameter<std::vector<double>>("MedEtaSF", {1.0});
+    region.addParameter<double>("EtaMaxExtrap", 2.0);
+    region.addParameter<std::vector<edm::ParameterSet>>("puppiAlgos", {puppiAlgo});
+    return region;
+  }
+
+  edm::ParameterSet config(bool useBinnedSearch) {
+    edm::ParameterSet pset;
+    pset.addParameter<bool>("puppiDiagnostics", false);
+    pset.addParameter<bool>("applyCHS", true);
+    pset.addParameter<bool>("invertPuppi", false);
+    pset.addParameter<bool>("useExp", false);
+    pset.addParameter<double>("MinPuppiWeight", 0.01);
+    pset.addParameter<double>("PtMaxPhotons", -1.);
+    pset.addParameter<double>("EtaMaxPhotons", 2.5);
+    pset.addParameter<double>("PtMaxNeutrals", 200.);
+    pset.addParameter<double>("PtMaxNeutralsStartSlope", 0.);
+    pset.addParameter<std::vector<edm::ParameterSet>>("algos", {algo(0., 2.5, true), algo(2.5, 10., false)});
+    pset.addParameter<bool>("useBinnedNeighbourSearch", useBinnedSearch);
+    return pset;
+  }
+
+  // charged particles from the primary vertex and from pileup, and neutrals, some of them close to phi = +-pi
+  std::vector<RecoObj> particles(unsigned int n) {
+    std::mt19937 rng(70);
+    std::uniform_real_distribution<float> eta(-4.5, 4.5), phi(-M_PI, M_PI), edge(M_PI - 0.2, M_PI);
+    std::exponential_distribution<float> pt(0.5);
+    std::vector<RecoObj> objects(n);
+    for (unsigned int i = 0; i < n; ++i) {
+      auto& object = objects[i];
+      object.pt = 0.5 + pt(rng);
+      object.eta = eta(rng);
+      object.phi = i % 5 == 0 ? (i % 2 ? 1 : -1) * edge(rng) : phi(rng);
+      object.m = 0.14;
+      object.rapidity = object.eta;
+      object.id = std::abs(object.eta) < 2.5 ? i % 3 : 0;
+      object.charge = object.id == 0 ? 0 : 1;
+      object.pdgId = object.id == 0 ? 130 : 211;
+      object.dZ = object.id == 1 ? 0.01 : 0.5;
+    }
+    return objects;
+  }
+}  // namespace
+
+int main() {
+  const auto objects = particles(400);
+  PuppiContainer loop(config(false));
+  PuppiContainer binned(config(true));
+  int failures = 0;
+  for (int nPV : {1, 40}) {
+    loop.initialize(objects);
+    loop.setNPV(nPV);
+    binned.initialize(objects);
+    binned.setNPV(nPV);
+    const auto weights = loop.puppiWeights();
+    const auto alphas = loop.puppiAlphas();
+    if (weights != binned.puppiWeights() || alphas != binned.puppiAlphas()) {
+      std::cerr << "the binned search changes the weights with " << nPV << " vertices" << std::endl;
+      ++failures;
+    }
+  }
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -5,6 +5,7 @@
 #include <vector>
 #include <array>
 #include <algorithm>
+#include <numeric>
 
 // Box structure used to define 2D field.
 // It's used in KDTree building step to divide the detector
@@ -111,6 +112,12 @@ public:
   // contained in the given searchbox. The founded points are stored in resRecHitList.
   void search(const KDTreeBox<DIM> &searchBox, std::vector<DATA> &resRecHitList);
 
+  // Here we search, in a single traversal of the KDTree, for the points contained in
+  // each of the given search boxes: the boxes reaching a node are tested together and
+  // only those overlapping a son go down to it. The points found in searchBoxes[i] are
+  // stored in resRecHitLists[i], in the same order as search() would give them.
+  void search(const std::vector<KDTreeBox<DIM> > &searchBoxes, std::vector<std::vector<DATA> > &resRecHitLists);
+
   // This reurns true if the tree is empty
   bool empty() { return nodePool_.empty(); }
 
@@ -137,6 +144,15 @@ private:
   // Recursif kdtree search. Is called by search()
   void recSearch(int current, const KDTreeBox<DIM> &trackBox, int depth = 0) const;
 
+  // Recursif kdtree search of the boxes active[first..last). Is called by the batched search()
+  void recSearch(int current,
+                 const std::vector<KDTreeBox<DIM> > &trackBoxes,
+                 std::vector<std::vector<DATA> > &recHitLists,
+                 std::vector<unsigned int> &active,
+                 unsigned int first,
+                 unsigned int last,
+                 int depth) const;
+
   // This method frees the KDTree.
   void clearTree() { nodePool_.clear(); }
 };
@@ -255,6 +271,68 @@ void KDTreeLinkerAlgo<DATA, DIM>::recSearch(int current, const KDTreeBox<DIM> &t
   }
 }
 
+template <typename DATA, unsigned int DIM>
+void KDTreeLinkerAlgo<DATA, DIM>::search(const std::vector<KDTreeBox<DIM> > &trackBoxes,
+                                         std::vector<std::vector<DATA> > &recHitLists) {
+  recHitLists.clear();
+  recHitLists.resize(trackBoxes.size());
+  if (!empty() && !trackBoxes.empty()) {
+    std::vector<unsigned int> active(trackBoxes.size());
+    std::iota(active.begin(), active.end(), 0);
+    recSearch(0, trackBoxes, recHitLists, active, 0, active.size(), 0);
+  }
+}
+
+template <typename DATA, unsigned int DIM>
+void KDTreeLinkerAlgo<DATA, DIM>::recSearch(int current,
+                                            const std::vector<KDTreeBox<DIM> > &trackBoxes,
+                                            std::vector<std::vector<DATA> > &recHitLists,
+                                            std::vector<unsigned int> &active,
+                                            unsigned int first,
+                                            unsigned int last,
+                                            int depth) const {
+  int right = nodePool_.right[current];
+  if (nodePool_.isLeaf(right)) {
+    // Same bit-wise test as in the single box search, for all the active boxes
+    for (unsigned int a = first; a < last; ++a) {
+      const KDTreeBox<DIM> &trackBox = trackBoxes[active[a]];
+      bool isInside = true;
+      for (unsigned i = 0; i < DIM; ++i) {
+        float dimCurr = nodePool_.dims[i][current];
+        isInside *= (dimCurr >= trackBox.dimmin[i]) & (dimCurr <= trackBox.dimmax[i]);
+      }
+      if (isInside) {
+        recHitLists[active[a]].push_back(nodePool_.data[current]);
+      }
+    }
+    return;
+  }
+
+  const int dimIndex = depth % DIM;
+  float median = nodePool_.dims[dimIndex][current];
+
+  // The boxes going down to a son are appended after those of this node,
+  // and removed once the son is done. Left son first, as in recSearch().
+  const unsigned int end = active.size();
+  for (unsigned int a = first; a < last; ++a) {
+    const unsigned int box = active[a];
+    if (trackBoxes[box].dimmin[dimIndex] <= median)
+      active.push_back(box);
+  }
+  if (active.size() > end)
+    recSearch(current + 1, trackBoxes, recHitLists, active, end, active.size(), depth + 1);
+  active.resize(end);
+
+  for (unsigned int a = first; a < last; ++a) {
+    const unsigned int box = active[a];
+    if (trackBoxes[box].dimmax[dimIndex] >= median)
+      active.push_back(box);
+  }
+  if (active.size() > end)
+    recSearch(right, trackBoxes, recHitLists, active, end, active.size(), depth + 1);
+  active.resize(end);
+}
+
 template <typename DATA, unsigned int DIM>
 int KDTreeLinkerAlgo<DATA, DIM>::recBuild(int low, int high, int depth) {
   int portionSize = high - low;
@@ -0,0 +1,62 @@
+#include "Utilities/Testing/interface/CppUnit_testdriver.icpp"
+#include "cppunit/extensions/HelperMacros.h"
+
+class TestKDTreeLinkerAlgo : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestKDTreeLinkerAlgo);
+  CPPUNIT_TEST(testBatchedSearch);
+  CPPUNIT_TEST(testEmptyTree);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testBatchedSearch();
+  void testEmptyTree();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestKDTreeLinkerAlgo);
+
+#include "CommonTools/RecoAlgos/interface/KDTreeLinkerAlgo.h"
+
+#include <cstdlib>
+
+namespace {
+  float random(float min, float max) { return min + (max - min) * static_cast<float>(rand()) / RAND_MAX; }
+}  // namespace
+
+void TestKDTreeLinkerAlgo::testBatchedSearch() {
+  for (unsigned int numberOfPoints : {1, 2, 7, 5000}) {
+    std::vector<KDTreeNodeInfo<unsigned int, 2> > points;
+    for (unsigned int id = 0; id < numberOfPoints; ++id)
+      points.emplace_back(id, random(-3.f, 3.f), random(-3.2f, 3.2f));
+
+    KDTreeLinkerAlgo<unsigned int, 2> tree;
+    tree.build(points, KDTreeBox<2>(-3.f, 3.f, -3.2f, 3.2f));
+
+    std::vector<KDTreeBox<2> > boxes;
+    for (unsigned int i = 0; i < 1000; ++i) {
+      float eta = random(-3.f, 3.f);
+      float phi = random(-3.2f, 3.2f);
+      float range = random(0.f, 0.5f);
+      boxes.emplace_back(eta - range, eta + range, phi - range, phi + range);
+    }
+
+    // the batched search gives the points of the single box searches, in the same order
+    std::vector<std::vector<unsigned int> > results;
+    tree.search(boxes, results);
+    CPPUNIT_ASSERT_EQUAL(boxes.size(), results.size());
+    for (unsigned int i = 0; i < boxes.size(); ++i) {
+      std::vector<unsigned int> result;
+      tree.search(boxes[i], result);
+      CPPUNIT_ASSERT(result == results[i]);
+    }
+  }
+}
+
+void TestKDTreeLinkerAlgo::testEmptyTree() {
+  KDTreeLinkerAlgo<unsigned int, 2> tree;
+  std::vector<KDTreeBox<2> > boxes(3, KDTreeBox<2>(-1.f, 1.f, -1.f, 1.f));
+  std::vector<std::vector<unsigned int> > results;
+  tree.search(boxes, results);
+  CPPUNIT_ASSERT_EQUAL(boxes.size(), results.size());
+  for (const auto& result : results)
+    CPPUNIT_ASSERT(result.empty());
+}
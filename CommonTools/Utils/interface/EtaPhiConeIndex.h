@@ -0,0 +1,78 @@
+#ifndef CommonTools_Utils_EtaPhiConeIndex_h
+#define CommonTools_Utils_EtaPhiConeIndex_h
+/** \class EtaPhiConeIndex
+ *
+ * An index in (eta, phi) of the candidates of an event, built once and queried for the candidates around any
+ * number of objects. The cells are at least as wide as the largest cone, so that the candidates within a cone are
+ * in the 3x3 cells around its axis, and a query visits a few cells instead of the whole collection.
+ *
+ * A query returns the indices, in increasing order, of the candidates closer than the cone size plus a small
+ * tolerance: the users keep their own cone and veto cone cuts, applied to the returned candidates in the order of
+ * the collection, so that their sums are those of the loop over the whole collection.
+ *
+ * The coordinates are read with accessors, (eta(), phi()) by default: PUPPI indexes its particles in (rapidity,
+ * phi). The phi range of the candidates, [-pi, pi] as for the reco candidates or [0, 2pi) as for the fastjet
+ * PseudoJets, is given to the constructor.
+ *
+ */
+#include <vector>
+
+class EtaPhiConeIndex {
+public:
+  // a margin on the distances, much larger than the rounding differences between the kinematics of a candidate
+  // computed from its different representations
+  static constexpr double kTolerance = 1.e-3;
+
+  enum class PhiRange { kMinusPiToPi, kZeroToTwoPi };
+
+  explicit EtaPhiConeIndex(PhiRange phiRange = PhiRange::kMinusPiToPi);
+
+  // builds the index of the candidates of the collection, for cones up to maxConeSize, at (etaOf(c), phiOf(c))
+  template <typename C, typename Eta, typename Phi>
+  void fill(const C& candidates, double maxConeSize, Eta etaOf, Phi phiOf) {
+    eta_.clear();
+    phi_.clear();
+    for (auto const& candidate : candidates) {
+      eta_.push_back(etaOf(candidate));
+      phi_.push_back(phiOf(candidate));
+    }
+    build(maxConeSize);
+  }
+
+  template <typename C>
+  void fill(const C& candidates, double maxConeSize) {
+    fill(
+        candidates, maxConeSize, [](auto const& c) { return c.eta(); }, [](auto const& c) { return c.phi(); });
+  }
+
+  unsigned int size() const { return eta_.size(); }
+
+  // the indices in the collection of the candidates within coneSize of (eta, phi), in increasing order;
+  // cones larger than the one of the index are allowed, and visit more cells; phi may be in any range
+  void candidatesInCone(double eta, double phi, double coneSize, std::vector<unsigned int>& indices) const;
+
+private:
+  void build(double maxConeSize);
+  int etaBin(double eta) const;
+  int phiBin(double phi) const;
+
+  // the eta range of the index, the candidates outside it being in the first or last row
+  static constexpr double kMaxEta = 10.;
+
+  double phiMin_;
+  double cellSize_ = 0;
+  double etaMin_ = 0;
+  double phiWidth_ = 0;
+  int nEta_ = 0;
+  int nPhi_ = 0;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+  // the candidates of each cell, eta row by eta row, are at [cellBegin_[cell], cellBegin_[cell + 1]) in the
+  // arrays ordered by cell
+  std::vector<unsigned int> cellBegin_;
+  std::vector<double> cellEta_;
+  std::vector<double> cellPhi_;
+  std::vector<unsigned int> cellIndex_;
+};
+
+#endif
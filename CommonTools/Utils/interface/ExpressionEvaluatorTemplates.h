@@ -6,6 +6,11 @@
 #include <limits>
 #include <memory>
 #include <tuple>
+#include <cmath>
+#include <type_traits>
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "DataFormats/Math/interface/deltaR.h"
 
 namespace reco {
 
@@ -71,6 +76,37 @@ namespace reco {
     virtual ~SelectIndecesInCollection(){};
   };
 
+  namespace parser {
+
+    // helpers of the string cuts and expressions translated to C++ by cutToCpp and expressionToCpp
+
+    // the object returned by a method, dereferenced if it is a pointer, a Ref or a Ptr, as the interpreter does
+    template <typename T>
+    auto deref(T const& t, int) -> decltype(*t.get()) {
+      return *t.get();
+    }
+    template <typename T>
+    T const& deref(T const* t, int) {
+      return *t;
+    }
+    template <typename T>
+    T const& deref(T const& t, long) {
+      return t;
+    }
+
+    // calls the method f on t, or on the object t points to if t has no such method, as the interpreter does
+    template <typename T, typename F>
+    decltype(auto) call(T const& t, F f) {
+      if constexpr (std::is_invocable_v<F, T const&>)
+        return f(t);
+      else
+        return f(deref(t, 0));
+    }
+
+    inline double testBit(double mask, double iBit) { return (int(mask) >> int(iBit)) & 1; }
+
+  }  // namespace parser
+
 }  // namespace reco
 
 #endif  // CommonToolsUtilsExpressionEvaluatorTemplates_H
@@ -10,24 +10,34 @@
 #include "CommonTools/Utils/src/SelectorPtr.h"
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/interface/cutParser.h"
+#include "CommonTools/Utils/interface/expressionCompiler.h"
 #include "FWCore/Reflection/interface/ObjectWithDict.h"
 
 template <typename T, bool DefaultLazyness = false>
 struct StringCutObjectSelector {
-  StringCutObjectSelector(const std::string &cut, bool lazy = DefaultLazyness) : type_(typeid(T)) {
+  // with a compiledPackage, the cut is also compiled to native code with the precompiled header of that package,
+  // which declares T; the cut is interpreted if it cannot be compiled
+  StringCutObjectSelector(const std::string &cut, bool lazy = DefaultLazyness, const char *compiledPackage = nullptr)
+      : type_(typeid(T)) {
     if (!reco::parser::cutParser<T>(cut, select_, lazy)) {
       throw edm::Exception(edm::errors::Configuration, "failed to parse \"" + cut + "\"");
     }
+    if (compiledPackage)
+      compiled_ = reco::parser::compileCut<T>(cut, compiledPackage);
   }
   StringCutObjectSelector(const reco::parser::SelectorPtr &select) : select_(select), type_(typeid(T)) {}
   bool operator()(const T &t) const {
+    if (compiled_)
+      return compiled_->eval(t);
     edm::ObjectWithDict o(type_, const_cast<T *>(&t));
     return (*select_)(o);
   }
+  bool compiled() const { return compiled_ != nullptr; }
 
 private:
   reco::parser::SelectorPtr select_;
   edm::TypeWithDict type_;
+  const reco::CutOnObject<T> *compiled_ = nullptr;
 };
 
 #endif
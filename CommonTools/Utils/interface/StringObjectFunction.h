@@ -10,24 +10,34 @@
 #include "CommonTools/Utils/src/ExpressionPtr.h"
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/interface/expressionParser.h"
+#include "CommonTools/Utils/interface/expressionCompiler.h"
 #include "FWCore/Reflection/interface/ObjectWithDict.h"
 
 template <typename T, bool DefaultLazyness = false>
 struct StringObjectFunction {
-  StringObjectFunction(const std::string &expr, bool lazy = DefaultLazyness) : type_(typeid(T)) {
+  // with a compiledPackage, the expression is also compiled to native code with the precompiled header of that
+  // package, which declares T; the expression is interpreted if it cannot be compiled
+  StringObjectFunction(const std::string &expr, bool lazy = DefaultLazyness, const char *compiledPackage = nullptr)
+      : type_(typeid(T)) {
     if (!reco::parser::expressionParser<T>(expr, expr_, lazy)) {
       throw edm::Exception(edm::errors::Configuration, "failed to parse \"" + expr + "\"");
     }
+    if (compiledPackage)
+      compiled_ = reco::parser::compileExpression<T>(expr, compiledPackage);
   }
   StringObjectFunction(const reco::parser::ExpressionPtr &expr) : expr_(expr), type_(typeid(T)) {}
   double operator()(const T &t) const {
+    if (compiled_)
+      return compiled_->eval(t);
     edm::ObjectWithDict o(type_, const_cast<T *>(&t));
     return expr_->value(o);
   }
+  bool compiled() const { return compiled_ != nullptr; }
 
 private:
   reco::parser::ExpressionPtr expr_;
   edm::TypeWithDict type_;
+  const reco::ValueOnObject<T> *compiled_ = nullptr;
 };
 
 template <typename Object>
@@ -0,0 +1,72 @@
+#ifndef CommonTools_Utils_expressionCompiler_h
+#define CommonTools_Utils_expressionCompiler_h
+/*
+ * Compilation of the string cuts and expressions to native code
+ *
+ * A cut, or an expression, is translated to a C++ expression on an object named obj, and compiled once per job
+ * by the ExpressionEvaluator, with the precompiled header of a package, which must declare the type of the object.
+ * The translation follows the grammar of the interpreter, and gives up on the constructs the interpreter resolves
+ * through the dictionaries only (array accesses, data members, enumerators given by name, lazy resolution in
+ * the derived types, ...): those fail to translate or to compile, and are left to the interpreter.
+ *
+ */
+#include "CommonTools/Utils/interface/ExpressionEvaluator.h"
+#include "CommonTools/Utils/interface/ExpressionEvaluatorTemplates.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/TypeDemangler.h"
+
+#include <string>
+#include <typeinfo>
+
+namespace reco {
+  namespace parser {
+
+    // translates the cut into a C++ boolean expression, or the expression into a C++ double expression, on obj;
+    // returns false if the cut or the expression cannot be translated
+    bool cutToCpp(const std::string &cut, std::string &cpp);
+    bool expressionToCpp(const std::string &expr, std::string &cpp);
+
+    void compilationFailed(const std::string &eval, cms::Exception const &e);
+
+    // compiles the definition of the eval method of Base, and returns nullptr if it does not compile
+    template <typename Base>
+    const Base *compileEvaluator(const char *pkg, const std::string &base, const std::string &eval) {
+      try {
+        reco::ExpressionEvaluator evaluator(pkg, base.c_str(), eval);
+        return evaluator.expr<Base>();
+      } catch (cms::Exception const &e) {
+        compilationFailed(eval, e);
+        return nullptr;
+      }
+    }
+
+    // the cut, or the expression, on T compiled with the precompiled header of pkg; nullptr if it cannot be
+    // translated or compiled, the caller then interpreting it
+    template <typename T>
+    const reco::CutOnObject<T> *compileCut(const std::string &cut, const char *pkg) {
+      std::string cpp;
+      if (!cutToCpp(cut, cpp))
+        return nullptr;
+      const std::string type = edm::typeDemangle(typeid(T).name());
+      return compileEvaluator<reco::CutOnObject<T>>(
+          pkg,
+          "reco::CutOnObject<" + type + ">",
+          "bool eval(" + type + " const& obj) const override { return " + cpp + "; }");
+    }
+
+    template <typename T>
+    const reco::ValueOnObject<T> *compileExpression(const std::string &expr, const char *pkg) {
+      std::string cpp;
+      if (!expressionToCpp(expr, cpp))
+        return nullptr;
+      const std::string type = edm::typeDemangle(typeid(T).name());
+      return compileEvaluator<reco::ValueOnObject<T>>(
+          pkg,
+          "reco::ValueOnObject<" + type + ">",
+          "double eval(" + type + " const& obj) const override { return " + cpp + "; }");
+    }
+
+  }  // namespace parser
+}  // namespace reco
+
+#endif
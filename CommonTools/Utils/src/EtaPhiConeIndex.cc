@@ -0,0 +1,102 @@
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
+#include "DataFormats/Math/interface/deltaPhi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+  constexpr double kTwoPi = 2. * M_PI;
+}  // namespace
+
+EtaPhiConeIndex::EtaPhiConeIndex(PhiRange phiRange) : phiMin_(phiRange == PhiRange::kMinusPiToPi ? -M_PI : 0.) {}
+
+void EtaPhiConeIndex::build(double maxConeSize) {
+  // cells at least as wide as the cone and the tolerance, an integer number of them in phi
+  cellSize_ = std::max(maxConeSize, 0.) + kTolerance;
+  nPhi_ = std::max(1, int(kTwoPi / cellSize_));
+  phiWidth_ = kTwoPi / nPhi_;
+
+  double etaMin = kMaxEta;
+  double etaMax = -kMaxEta;
+  for (auto eta : eta_) {
+    etaMin = std::min(etaMin, eta);
+    etaMax = std::max(etaMax, eta);
+  }
+  etaMin_ = std::max(etaMin, -kMaxEta);
+  etaMax = std::min(etaMax, kMaxEta);
+  nEta_ = etaMax > etaMin_ ? int((etaMax - etaMin_) / cellSize_) + 1 : 1;
+
+  // counting sort of the candidates by cell, keeping their order within a cell
+  const unsigned int nCandidates = eta_.size();
+  std::vector<unsigned int> cells(nCandidates);
+  cellBegin_.assign(nEta_ * nPhi_ + 1, 0);
+  for (unsigned int i = 0; i < nCandidates; ++i) {
+    cells[i] = etaBin(eta_[i]) * nPhi_ + phiBin(phi_[i]);
+    ++cellBegin_[cells[i] + 1];
+  }
+  for (unsigned int i = 1; i < cellBegin_.size(); ++i)
+    cellBegin_[i] += cellBegin_[i - 1];
+
+  cellEta_.resize(nCandidates);
+  cellPhi_.resize(nCandidates);
+  cellIndex_.resize(nCandidates);
+  std::vector<unsigned int> next(cellBegin_.begin(), cellBegin_.end() - 1);
+  for (unsigned int i = 0; i < nCandidates; ++i) {
+    const unsigned int j = next[cells[i]]++;
+    cellEta_[j] = eta_[i];
+    cellPhi_[j] = phi_[i];
+    cellIndex_[j] = i;
+  }
+}
+
+int EtaPhiConeIndex::etaBin(double eta) const {
+  // clamping keeps the bins of two etas closer than a cell at most one apart
+  const double bin = (eta - etaMin_) / cellSize_;
+  if (!(bin > 0))
+    return 0;
+  return bin < nEta_ - 1 ? int(bin) : nEta_ - 1;
+}
+
+int EtaPhiConeIndex::phiBin(double phi) const {
+  // the phi of a candidate is in [phiMin_, phiMin_ + 2pi], up to rounding
+  const double bin = (phi - phiMin_) / phiWidth_;
+  if (!(bin > 0))
+    return 0;
+  return bin < nPhi_ - 1 ? int(bin) : nPhi_ - 1;
+}
+
+void EtaPhiConeIndex::candidatesInCone(double eta,
+                                       double phi,
+                                       double coneSize,
+                                       std::vector<unsigned int>& indices) const {
+  indices.clear();
+  if (eta_.empty())
+    return;
+  const double maxDR = coneSize + kTolerance;
+  const double maxDR2 = maxDR * maxDR;
+
+  // the cells within maxDR of the axis, all of them in phi when the cone wraps around
+  const int nCells = maxDR > cellSize_ ? int(std::ceil(maxDR / cellSize_)) : 1;
+  const int centreEtaBin = etaBin(eta);
+  phi = phiMin_ + M_PI + reco::reduceRange(phi - phiMin_ - M_PI);
+  const int centrePhiBin = phiBin(phi);
+  const bool allPhi = 2 * nCells + 1 >= nPhi_;
+  const int firstPhi = allPhi ? 0 : centrePhiBin - nCells;
+  const int lastPhi = allPhi ? nPhi_ - 1 : centrePhiBin + nCells;
+
+  for (int iEta = std::max(0, centreEtaBin - nCells); iEta <= std::min(nEta_ - 1, centreEtaBin + nCells); ++iEta) {
+    for (int iPhi = firstPhi; iPhi <= lastPhi; ++iPhi) {
+      const int cell = iEta * nPhi_ + (iPhi + nPhi_) % nPhi_;
+      // both phis are in the range of the index, so that the distance in phi is the smaller of |dphi| and 2pi - |dphi|
+      for (unsigned int j = cellBegin_[cell]; j < cellBegin_[cell + 1]; ++j) {
+        const double dEta = cellEta_[j] - eta;
+        const double dPhiAbs = std::abs(cellPhi_[j] - phi);
+        const double dPhi = std::min(dPhiAbs, kTwoPi - dPhiAbs);
+        if (dEta * dEta + dPhi * dPhi < maxDR2)
+          indices.push_back(cellIndex_[j]);
+      }
+    }
+  }
+  // the order of the collection, for the sums over the candidates to be those of the full loop
+  std::sort(indices.begin(), indices.end());
+}
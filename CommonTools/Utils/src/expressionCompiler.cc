@@ -0,0 +1,448 @@
+#include "CommonTools/Utils/interface/expressionCompiler.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+namespace {
+
+  // A recursive descent translator, with the ordered alternatives of the Grammar of the interpreter, so that a
+  // string it parses is read in the same way. Every number is a double, as every value of the interpreter.
+  class Translator {
+  public:
+    explicit Translator(const std::string& text) : text_(text), pos_(0), failed_(false) {}
+
+    bool cut(std::string& cpp) { return logicalExpression(cpp) && atEnd() && !failed_; }
+    bool expression(std::string& cpp) { return this->expr(cpp) && atEnd() && !failed_; }
+
+  private:
+    void skip() {
+      while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])))
+        ++pos_;
+    }
+
+    bool atEnd() {
+      skip();
+      return pos_ == text_.size();
+    }
+
+    bool accept(char c) {
+      skip();
+      if (pos_ < text_.size() && text_[pos_] == c) {
+        ++pos_;
+        return true;
+      }
+      return false;
+    }
+
+    bool isDigit(size_t pos) const {
+      return pos < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos]));
+    }
+
+    // an identifier, a letter followed by letters, digits and underscores
+    bool identifier(std::string& name) {
+      skip();
+      if (pos_ >= text_.size() || !std::isalpha(static_cast<unsigned char>(text_[pos_])))
+        return false;
+      const size_t begin = pos_;
+      while (pos_ < text_.size() && (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_'))
+        ++pos_;
+      name = text_.substr(begin, pos_ - begin);
+      return true;
+    }
+
+    // a number with an optional sign, with (strict) or without a decimal point or an exponent
+    bool number(std::string& cpp, bool strict = false) {
+      skip();
+      size_t pos = pos_;
+      if (pos < text_.size() && (text_[pos] == '+' || text_[pos] == '-'))
+        ++pos;
+      bool digits = false, real = false;
+      while (isDigit(pos)) {
+        ++pos;
+        digits = true;
+      }
+      if (pos < text_.size() && text_[pos] == '.') {
+        ++pos;
+        real = true;
+        while (isDigit(pos)) {
+          ++pos;
+          digits = true;
+        }
+      }
+      if (!digits)
+        return false;
+      if (pos < text_.size() && (text_[pos] == 'e' || text_[pos] == 'E')) {
+        size_t exponent = pos + 1;
+        if (exponent < text_.size() && (text_[exponent] == '+' || text_[exponent] == '-'))
+          ++exponent;
+        if (isDigit(exponent)) {
+          while (isDigit(exponent))
+            ++exponent;
+          pos = exponent;
+          real = true;
+        }
+      }
+      if (strict && !real)
+        return false;
+      cpp = text_.substr(pos_, pos - pos_);
+      if (!real)
+        cpp += ".";
+      cpp = "(" + cpp + ")";
+      pos_ = pos;
+      return true;
+    }
+
+    // an argument of a method: a number, or a string between single or double quotes
+    bool methodArgument(std::string& cpp) {
+      const size_t start = pos_;
+      if (number(cpp, true))
+        return true;
+      pos_ = start;
+      skip();
+      if (pos_ < text_.size() && (text_[pos_] == '"' || text_[pos_] == '\'')) {
+        const char quote = text_[pos_];
+        const size_t end = text_.find(quote, pos_ + 1);
+        if (end == std::string::npos)
+          return false;
+        cpp = "\"";
+        for (size_t i = pos_ + 1; i < end; ++i) {
+          if (text_[i] == '"' || text_[i] == '\\')
+            cpp += '\\';
+          cpp += text_[i];
+        }
+        cpp += "\"";
+        pos_ = end + 1;
+        return true;
+      }
+      // an integer, which the C++ conversions adapt to the type of the argument as the interpreter does
+      skip();
+      size_t pos = pos_;
+      if (pos < text_.size() && (text_[pos] == '+' || text_[pos] == '-'))
+        ++pos;
+      if (!isDigit(pos))
+        return false;
+      while (isDigit(pos))
+        ++pos;
+      cpp = "(" + text_.substr(pos_, pos - pos_) + ")";
+      pos_ = pos;
+      return true;
+    }
+
+    // a method, with or without its arguments or empty parentheses
+    bool var(std::string& cpp) {
+      std::string name;
+      if (!identifier(name))
+        return false;
+      const size_t afterName = pos_;
+      if (accept('(')) {
+        std::string args, arg;
+        if (methodArgument(arg)) {
+          args = arg;
+          while (true) {
+            const size_t pos = pos_;
+            if (accept(',') && methodArgument(arg)) {
+              args += ", " + arg;
+            } else {
+              pos_ = pos;
+              break;
+            }
+          }
+          if (!accept(')'))
+            return false;
+          cpp = name + "(" + args + ")";
+          return true;
+        }
+        pos_ = afterName;
+      }
+      const size_t pos = pos_;
+      if (!(accept('(') && accept(')')))
+        pos_ = pos;
+      cpp = name + "()";
+      return true;
+    }
+
+    // the methods called one on the result of the other, starting from obj, each of them on the object returned
+    // by the previous one or on the object it points to
+    bool method(std::string& cpp) {
+      std::string call;
+      if (!var(call))
+        return false;
+      cpp = "obj." + call;
+      while (true) {
+        const size_t pos = pos_;
+        skip();
+        if (pos_ < text_.size() && text_[pos_] == '[') {
+          // the array accesses are left to the interpreter
+          failed_ = true;
+          return false;
+        }
+        if (accept('.') && var(call)) {
+          cpp = "reco::parser::call(" + cpp + ", [](auto const& o) -> decltype(o." + call + ") { return o." + call +
+                "; })";
+        } else {
+          pos_ = pos;
+          break;
+        }
+      }
+      cpp = "double(" + cpp + ")";
+      return true;
+    }
+
+    bool arguments(unsigned int n, std::string& args) {
+      std::string arg;
+      for (unsigned int i = 0; i < n; ++i) {
+        if ((i > 0 && !accept(',')) || !this->expr(arg))
+          return false;
+        args += (i > 0 ? ", " : "") + arg;
+      }
+      return accept(')');
+    }
+
+    bool function(std::string& cpp) {
+      static const std::vector<std::string> functions1 = {
+          "abs", "acos", "asin", "atan", "cosh", "cos", "exp", "log", "sinh", "sin", "sqrt", "tanh", "tan"};
+      std::string name;
+      if (!identifier(name) || !accept('('))
+        return false;
+      std::string args;
+      if (std::find(functions1.begin(), functions1.end(), name) != functions1.end()) {
+        if (!arguments(1, args))
+          return false;
+        cpp = "std::" + name + "(" + args + ")";
+      } else if (name == "pow" || name == "hypot") {
+        if (!arguments(2, args))
+          return false;
+        cpp = "std::" + name + "(" + args + ")";
+      } else if (name == "min" || name == "max") {
+        if (!arguments(2, args))
+          return false;
+        cpp = "std::" + name + "<double>(" + args + ")";
+      } else if (name == "deltaPhi") {
+        if (!arguments(2, args))
+          return false;
+        cpp = "reco::deltaPhi(" + args + ")";
+      } else if (name == "test_bit") {
+        if (!arguments(2, args))
+          return false;
+        cpp = "reco::parser::testBit(" + args + ")";
+      } else if (name == "deltaR") {
+        if (!arguments(4, args))
+          return false;
+        cpp = "reco::deltaR(" + args + ")";
+      } else if (name == "atan2" || name == "chi2prob") {
+        // not evaluated as their names say by the interpreter, or without a header in the precompiled ones
+        failed_ = true;
+        return false;
+      } else {
+        return false;
+      }
+      return true;
+    }
+
+    bool factor(std::string& cpp) {
+      const size_t start = pos_;
+      if (number(cpp))
+        return true;
+      pos_ = start;
+      if (function(cpp))
+        return true;
+      pos_ = start;
+      if (method(cpp))
+        return true;
+      pos_ = start;
+      if (accept('(') && this->expr(cpp) && accept(')')) {
+        cpp = "(" + cpp + ")";
+        return true;
+      }
+      pos_ = start;
+      std::string operand;
+      if (accept('-') && factor(operand)) {
+        cpp = "(-" + operand + ")";
+        return true;
+      }
+      pos_ = start;
+      if (accept('+') && factor(cpp))
+        return true;
+      pos_ = start;
+      return false;
+    }
+
+    bool power(std::string& cpp) {
+      if (!factor(cpp))
+        return false;
+      std::string rhs;
+      while (true) {
+        const size_t pos = pos_;
+        if (accept('^') && factor(rhs)) {
+          cpp = "std::pow(" + cpp + ", " + rhs + ")";
+        } else {
+          pos_ = pos;
+          return true;
+        }
+      }
+    }
+
+    // the left associative binary operators of one precedence level
+    template <typename Operand>
+    bool binaryOperators(std::string& cpp, const char* ops, Operand operand) {
+      if (!(this->*operand)(cpp))
+        return false;
+      std::string rhs;
+      while (true) {
+        const size_t pos = pos_;
+        skip();
+        const char op = pos_ < text_.size() ? text_[pos_] : '\0';
+        if (op != '\0' && std::string(ops).find(op) != std::string::npos && accept(op) && (this->*operand)(rhs)) {
+          cpp = "(" + cpp + " " + op + " " + rhs + ")";
+        } else {
+          pos_ = pos;
+          return true;
+        }
+      }
+    }
+
+    bool term(std::string& cpp) { return binaryOperators(cpp, "*/", &Translator::power); }
+
+    bool noCondExpression(std::string& cpp) { return binaryOperators(cpp, "+-", &Translator::term); }
+
+    bool condExpression(std::string& cpp) {
+      std::string condition, ifTrue, ifFalse;
+      if (!(accept('?') && logicalExpression(condition) && accept('?') && this->expr(ifTrue) && accept(':') &&
+            this->expr(ifFalse)))
+        return false;
+      cpp = "(" + condition + " ? " + ifTrue + " : " + ifFalse + ")";
+      return true;
+    }
+
+    bool expr(std::string& cpp) {
+      const size_t start = pos_;
+      if (condExpression(cpp))
+        return true;
+      pos_ = start;
+      return noCondExpression(cpp);
+    }
+
+    bool comparison(std::string& op) {
+      if (accept('<')) {
+        op = accept('=') ? "<=" : "<";
+      } else if (accept('=')) {
+        accept('=');
+        op = "==";
+      } else if (accept('>')) {
+        op = accept('=') ? ">=" : ">";
+      } else if (accept('!') && accept('=')) {
+        op = "!=";
+      } else {
+        return false;
+      }
+      return true;
+    }
+
+    bool trinaryComparison(std::string& cpp) {
+      std::string lhs, mid, rhs, op1, op2;
+      if (!(this->expr(lhs) && comparison(op1) && this->expr(mid) && comparison(op2) && this->expr(rhs)))
+        return false;
+      cpp = "(" + lhs + " " + op1 + " " + mid + " && " + mid + " " + op2 + " " + rhs + ")";
+      return true;
+    }
+
+    bool binaryComparison(std::string& cpp) {
+      std::string lhs, rhs, op;
+      if (!(this->expr(lhs) && comparison(op) && this->expr(rhs)))
+        return false;
+      cpp = "(" + lhs + " " + op + " " + rhs + ")";
+      return true;
+    }
+
+    bool logicalFactor(std::string& cpp) {
+      const size_t start = pos_;
+      if (trinaryComparison(cpp))
+        return true;
+      pos_ = start;
+      if (binaryComparison(cpp))
+        return true;
+      pos_ = start;
+      if (accept('(') && logicalExpression(cpp) && accept(')')) {
+        cpp = "(" + cpp + ")";
+        return true;
+      }
+      pos_ = start;
+      std::string operand;
+      if (accept('!') && logicalFactor(operand)) {
+        cpp = "(!" + operand + ")";
+        return true;
+      }
+      pos_ = start;
+      if (this->expr(operand)) {
+        cpp = "(" + operand + " != 0)";
+        return true;
+      }
+      pos_ = start;
+      return false;
+    }
+
+    // && and ||, or & and |
+    bool logicalOperator(char op) {
+      if (!accept(op))
+        return false;
+      const size_t pos = pos_;
+      if (!accept(op))
+        pos_ = pos;
+      return true;
+    }
+
+    bool logicalTerm(std::string& cpp) {
+      if (!logicalFactor(cpp))
+        return false;
+      std::string rhs;
+      while (true) {
+        const size_t pos = pos_;
+        if (logicalOperator('&') && logicalFactor(rhs)) {
+          cpp = "(" + cpp + " && " + rhs + ")";
+        } else {
+          pos_ = pos;
+          return true;
+        }
+      }
+    }
+
+    bool logicalExpression(std::string& cpp) {
+      if (!logicalTerm(cpp))
+        return false;
+      std::string rhs;
+      while (true) {
+        const size_t pos = pos_;
+        if (logicalOperator('|') && logicalTerm(rhs)) {
+          cpp = "(" + cpp + " || " + rhs + ")";
+        } else {
+          pos_ = pos;
+          return true;
+        }
+      }
+    }
+
+    const std::string& text_;
+    size_t pos_;
+    bool failed_;
+  };
+
+}  // namespace
+
+bool reco::parser::cutToCpp(const std::string& cut, std::string& cpp) {
+  // a blank cut selects everything, as in cutParser
+  if (cut.find_first_not_of(' ') == std::string::npos) {
+    cpp = "true";
+    return true;
+  }
+  return Translator(cut).cut(cpp);
+}
+
+bool reco::parser::expressionToCpp(const std::string& expr, std::string& cpp) {
+  return Translator(expr).expression(cpp);
+}
+
+void reco::parser::compilationFailed(const std::string& eval, cms::Exception const& e) {
+  edm::LogWarning("expressionCompiler") << "could not compile \"" << eval << "\", it is interpreted:\n" << e.what();
+}
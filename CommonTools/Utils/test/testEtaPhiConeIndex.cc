@@ -0,0 +1,141 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
+#include "DataFormats/Math/interface/deltaR.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class testEtaPhiConeIndex : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testEtaPhiConeIndex);
+  CPPUNIT_TEST(checkEmpty);
+  CPPUNIT_TEST(checkWrapAround);
+  CPPUNIT_TEST(checkAgainstFullLoop);
+  CPPUNIT_TEST(checkRapidityAndPositivePhi);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkEmpty();
+  void checkWrapAround();
+  void checkAgainstFullLoop();
+  void checkRapidityAndPositivePhi();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testEtaPhiConeIndex);
+
+namespace test {
+  struct EtaPhi {
+    EtaPhi(double eta, double phi) : eta_(eta), phi_(phi) {}
+    double eta() const { return eta_; }
+    double phi() const { return phi_; }
+
+  private:
+    double eta_, phi_;
+  };
+
+  // the kinematics of a PUPPI particle, with its phi in [0, 2pi)
+  struct RapPhi {
+    double rap, phi;
+  };
+}  // namespace test
+
+void testEtaPhiConeIndex::checkEmpty() {
+  EtaPhiConeIndex index;
+  std::vector<unsigned int> indices(1, 0);
+  index.fill(std::vector<test::EtaPhi>(), 0.4);
+  index.candidatesInCone(0., 0., 0.4, indices);
+  CPPUNIT_ASSERT(indices.empty());
+}
+
+void testEtaPhiConeIndex::checkWrapAround() {
+  std::vector<test::EtaPhi> candidates{{0., M_PI - 0.01}, {0., -M_PI + 0.01}, {0., 0.}, {0.3, M_PI}};
+  EtaPhiConeIndex index;
+  index.fill(candidates, 0.1);
+  std::vector<unsigned int> indices;
+  index.candidatesInCone(0., -M_PI, 0.1, indices);
+  CPPUNIT_ASSERT((indices == std::vector<unsigned int>{0, 1}));
+  // a cone larger than the one of the index
+  index.candidatesInCone(0., M_PI, 0.5, indices);
+  CPPUNIT_ASSERT((indices == std::vector<unsigned int>{0, 1, 3}));
+}
+
+void testEtaPhiConeIndex::checkAgainstFullLoop() {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> eta(-5., 5.);
+  std::uniform_real_distribution<double> phi(-M_PI, M_PI);
+  std::vector<test::EtaPhi> candidates;
+  for (int i = 0; i < 2000; ++i)
+    candidates.emplace_back(eta(gen), phi(gen));
+
+  EtaPhiConeIndex index;
+  index.fill(candidates, 0.4);
+  CPPUNIT_ASSERT(index.size() == candidates.size());
+  std::vector<unsigned int> indices;
+  for (double coneSize : {0.05, 0.3, 0.4, 1.2}) {
+    for (int i = 0; i < 200; ++i) {
+      const double axisEta = eta(gen);
+      const double axisPhi = phi(gen);
+      index.candidatesInCone(axisEta, axisPhi, coneSize, indices);
+      // all the candidates of the cone, in the order of the collection, and none far from it
+      std::vector<unsigned int> inCone;
+      for (unsigned int j = 0; j < indices.size(); ++j) {
+        const auto& c = candidates[indices[j]];
+        CPPUNIT_ASSERT(j == 0 || indices[j - 1] < indices[j]);
+        CPPUNIT_ASSERT(reco::deltaR(c.eta(), c.phi(), axisEta, axisPhi) < coneSize + EtaPhiConeIndex::kTolerance);
+        if (reco::deltaR2(c.eta(), c.phi(), axisEta, axisPhi) < coneSize * coneSize)
+          inCone.push_back(indices[j]);
+      }
+      std::vector<unsigned int> expected;
+      for (unsigned int j = 0; j < candidates.size(); ++j) {
+        const auto& c = candidates[j];
+        if (reco::deltaR2(c.eta(), c.phi(), axisEta, axisPhi) < coneSize * coneSize)
+          expected.push_back(j);
+      }
+      CPPUNIT_ASSERT(inCone == expected);
+    }
+  }
+}
+
+void testEtaPhiConeIndex::checkRapidityAndPositivePhi() {
+  std::mt19937 gen(70);
+  std::uniform_real_distribution<double> rap(-5., 5.);
+  std::uniform_real_distribution<double> phi(0., 2. * M_PI);
+  std::vector<test::RapPhi> particles{{0., 0.01}, {0., 2. * M_PI - 0.01}, {0.05, M_PI}};
+  for (int i = 0; i < 2000; ++i)
+    particles.push_back({rap(gen), phi(gen)});
+
+  EtaPhiConeIndex index(EtaPhiConeIndex::PhiRange::kZeroToTwoPi);
+  index.fill(
+      particles, 0.4, [](auto const& p) { return p.rap; }, [](auto const& p) { return p.phi; });
+  std::vector<unsigned int> indices;
+  // the cones of PuppiContainer::var_within_R, around the particles and across phi = 0
+  for (double coneSize : {0.3, 0.4}) {
+    for (unsigned int i = 0; i < particles.size(); i += 7) {
+      const auto& centre = particles[i];
+      index.candidatesInCone(centre.rap, centre.phi, coneSize, indices);
+      // the selection of PseudoJet::squared_distance, on the returned particles and on all of them
+      auto inCone = [&](const test::RapPhi& p) {
+        const double dPhiAbs = std::abs(p.phi - centre.phi);
+        const double dPhi = std::min(dPhiAbs, 2. * M_PI - dPhiAbs);
+        const double dRap = p.rap - centre.rap;
+        return std::abs(dRap) < coneSize && dRap * dRap + dPhi * dPhi < coneSize * coneSize;
+      };
+      std::vector<unsigned int> selected, expected;
+      for (auto j : indices) {
+        if (inCone(particles[j]))
+          selected.push_back(j);
+      }
+      for (unsigned int j = 0; j < particles.size(); ++j) {
+        if (inCone(particles[j]))
+          expected.push_back(j);
+      }
+      CPPUNIT_ASSERT(selected == expected);
+    }
+  }
+  // the two particles on both sides of phi = 0
+  index.candidatesInCone(0., 0., 0.1, indices);
+  CPPUNIT_ASSERT(indices.size() >= 2 && indices[0] == 0 && indices[1] == 1);
+}
@@ -0,0 +1,78 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "CommonTools/Utils/interface/expressionCompiler.h"
+
+#include <string>
+
+class testExpressionCompiler : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testExpressionCompiler);
+  CPPUNIT_TEST(checkCuts);
+  CPPUNIT_TEST(checkExpressions);
+  CPPUNIT_TEST(checkInterpreterOnly);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkCuts();
+  void checkExpressions();
+  void checkInterpreterOnly();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testExpressionCompiler);
+
+namespace {
+  std::string cut(const std::string &cut) {
+    std::string cpp;
+    CPPUNIT_ASSERT(reco::parser::cutToCpp(cut, cpp));
+    return cpp;
+  }
+
+  std::string expression(const std::string &expr) {
+    std::string cpp;
+    CPPUNIT_ASSERT(reco::parser::expressionToCpp(expr, cpp));
+    return cpp;
+  }
+}  // namespace
+
+void testExpressionCompiler::checkCuts() {
+  CPPUNIT_ASSERT_EQUAL(std::string("true"), cut("  "));
+  CPPUNIT_ASSERT_EQUAL(std::string("(double(obj.pt()) > (20.))"), cut("pt > 20"));
+  CPPUNIT_ASSERT_EQUAL(std::string("(double(obj.pt()) == (20.))"), cut("pt() = 20"));
+  CPPUNIT_ASSERT_EQUAL(std::string("(double(obj.isGlobalMuon()) != 0)"), cut("isGlobalMuon"));
+  // the comparisons of three expressions, and the logical operators
+  CPPUNIT_ASSERT_EQUAL(std::string("((0.) < double(obj.pt()) && double(obj.pt()) <= (10.))"), cut("0 < pt <= 10"));
+  CPPUNIT_ASSERT_EQUAL(std::string("((!(double(obj.isGlobalMuon()) != 0)) || (double(obj.eta()) >= (-2.5)))"),
+                       cut("!isGlobalMuon | eta >= -2.5"));
+  CPPUNIT_ASSERT_EQUAL(std::string("(((double(obj.pt()) > (3.))) && (std::abs(double(obj.eta())) < (2.4)))"),
+                       cut("(pt > 3) && abs(eta) < 2.4"));
+  // the arguments of the methods, and the methods of the objects returned by a method
+  CPPUNIT_ASSERT_EQUAL(std::string("(double(obj.userFloat(\"iso\")) < (0.25))"), cut("userFloat('iso') < 0.25"));
+  CPPUNIT_ASSERT_EQUAL(
+      std::string("(double(reco::parser::call(obj.daughter((0)), [](auto const& o) -> decltype(o.pt()) { return "
+                  "o.pt(); })) > (5.))"),
+      cut("daughter(0).pt > 5"));
+}
+
+void testExpressionCompiler::checkExpressions() {
+  CPPUNIT_ASSERT_EQUAL(std::string("double(obj.pt())"), expression("pt"));
+  // every number is a double, as for the interpreter
+  CPPUNIT_ASSERT_EQUAL(std::string("(double(obj.charge()) / (2.))"), expression("charge / 2"));
+  CPPUNIT_ASSERT_EQUAL(std::string("(std::pow(double(obj.pt()), (2.)) - (-double(obj.eta())))"),
+                       expression("pt^2 - -eta"));
+  CPPUNIT_ASSERT_EQUAL(std::string("((double(obj.pt()) > (3.)) ? (1.) : (0.))"), expression("? pt > 3 ? 1 : 0"));
+  CPPUNIT_ASSERT_EQUAL(std::string("std::max<double>(double(obj.pt()), (3.))"), expression("max(pt, 3)"));
+  CPPUNIT_ASSERT_EQUAL(std::string("reco::deltaR(double(obj.eta()), double(obj.phi()), (0.), (0.))"),
+                       expression("deltaR(eta, phi, 0, 0)"));
+  CPPUNIT_ASSERT_EQUAL(std::string("reco::parser::testBit(double(obj.bits()), (3.))"), expression("test_bit(bits, 3)"));
+}
+
+void testExpressionCompiler::checkInterpreterOnly() {
+  std::string cpp;
+  // the array accesses, and the functions the interpreter does not evaluate as their names say
+  CPPUNIT_ASSERT(!reco::parser::cutToCpp("userCands[0] > 1", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("atan2(py, px)", cpp));
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("chi2prob(chi2, ndof)", cpp));
+  // a cut is not an expression, and an incomplete cut is not translated
+  CPPUNIT_ASSERT(!reco::parser::expressionToCpp("pt > 3", cpp));
+  CPPUNIT_ASSERT(!reco::parser::cutToCpp("pt > ", cpp));
+}
@@ -2,6 +2,7 @@
 #define ConditionDatabase_ConnectionPool_h
 
 #include "CondCore/CondDB/interface/Session.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
 //
 #include <string>
 #include <memory>
@@ -39,6 +40,8 @@ namespace cond {
       void setFrontierSecurity(const std::string& signature);
       void setLogging(bool flag);
       bool isLoggingEnabled() const;
+      // keeps the payloads read in a local directory, an empty path disables the cache
+      void setPayloadCache(const std::string& path, size_t maxSizeMB = PayloadCache::DEFAULT_SIZE_MB);
       void setParameters(const edm::ParameterSet& connectionPset);
       void configure();
       Session createSession(const std::string& connectionString, bool writeCapable = false);
@@ -66,6 +69,7 @@ namespace cond {
       // this one has to be moved!
       cond::CoralServiceManager* m_pluginManager = nullptr;
       std::map<std::string, int> m_dbTypes;
+      std::shared_ptr<PayloadCache> m_payloadCache;
     };
   }  // namespace persistency
 }  // namespace cond
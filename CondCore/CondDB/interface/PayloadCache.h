@@ -0,0 +1,78 @@
+#ifndef CondCore_CondDB_PayloadCache_h
+#define CondCore_CondDB_PayloadCache_h
+
+#include "CondCore/CondDB/interface/Types.h"
+//
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cond {
+
+  class Binary;
+
+  namespace persistency {
+
+    // A local cache of payload BLOBs on disk, shared by all the processes using the same directory.
+    // The entries are named after the payload hash, so they never need to be invalidated. A payload read back
+    // is only checked for its size; its hash is recomputed by discardIfInvalid(), when it could not be
+    // deserialized. An entry is written to a temporary file and renamed, so that concurrent readers only ever see
+    // complete entries. The size of the entries is kept in an index, built from the directory at the first store
+    // and again whenever it goes over the size limit, so that the entries written by the other processes are
+    // accounted for. Then the least recently used entries are removed.
+    class PayloadCache {
+    public:
+      // the directory and its size limit can be set with the environment, if the connection pool is not configured
+      static constexpr const char* const COND_PAYLOAD_CACHE_PATH = "COND_PAYLOAD_CACHE_PATH";
+      static constexpr const char* const COND_PAYLOAD_CACHE_SIZE_MB = "COND_PAYLOAD_CACHE_SIZE_MB";
+      static constexpr size_t DEFAULT_SIZE_MB = 4096;
+
+      PayloadCache(const std::string& path, size_t maxSize);
+
+      const std::string& path() const { return m_path; }
+      size_t maxSize() const { return m_maxSize; }
+
+      // returns false if the entry is missing or truncated, the arguments may then have been modified
+      bool load(const cond::Hash& payloadHash,
+                std::string& payloadType,
+                cond::Binary& payloadData,
+                cond::Binary& streamerInfoData) const;
+
+      // errors are not reported: a payload which could not be stored is fetched again from the database
+      bool store(const cond::Hash& payloadHash,
+                 const std::string& payloadType,
+                 const cond::Binary& payloadData,
+                 const cond::Binary& streamerInfoData) const;
+
+      // removes the entry if its content does not match its hash, returns true if it has been removed
+      bool discardIfInvalid(const cond::Hash& payloadHash) const;
+
+    private:
+      struct IndexEntry {
+        size_t size;
+        std::list<cond::Hash>::iterator lru;
+      };
+
+      std::string entryPath(const cond::Hash& payloadHash) const;
+      // the methods below require m_mutex to be locked
+      void buildIndex() const;
+      void addToIndex(const cond::Hash& payloadHash, size_t size) const;
+      void removeFromIndex(const cond::Hash& payloadHash) const;
+      void evict() const;
+
+    private:
+      std::string m_path;
+      size_t m_maxSize;
+      mutable std::mutex m_mutex;
+      mutable bool m_indexed = false;
+      mutable size_t m_totalSize = 0;
+      // least recently used first
+      mutable std::list<cond::Hash> m_lru;
+      mutable std::unordered_map<cond::Hash, IndexEntry> m_index;
+    };
+
+  }  // namespace persistency
+}  // namespace cond
+
+#endif
@@ -41,6 +41,9 @@ namespace cond {
 
       void initializeForNewIOV();
 
+      // the id of the payload valid for the IOV set by the last call to initializeForNewIOV
+      Hash const& payloadId() const { return m_iovAtInitialization.payloadId; }
+
     private:
       virtual void loadPayload() = 0;
 
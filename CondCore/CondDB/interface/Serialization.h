@@ -23,6 +23,7 @@
 // temporarely
 
 #include "CondFormats/Serialization/interface/Archive.h"
+#include "CondFormats/Serialization/interface/FlatPayload.h"
 
 namespace cond {
 
@@ -54,8 +55,9 @@ namespace cond {
     static constexpr char const* ARCH_LABEL = "architecture";
     //
     static constexpr char const* TECHNOLOGY = "boost/serialization";
+    static constexpr char const* FLAT_TECHNOLOGY = "cond/flat";
     static std::string techVersion();
-    static std::string jsonString();
+    static std::string jsonString(char const* technology = TECHNOLOGY);
   };
 
   typedef cond::serialization::InputArchive CondInputArchive;
@@ -81,6 +83,26 @@ namespace cond {
     return ret;
   }
 
+  // serialization with the flat encoding, for the types with a flat layout, to be read back without decoding.
+  // It has to be asked for explicitly: serialize() keeps writing the boost encoding for every type.
+  template <typename T>
+  std::pair<Binary, Binary> serializeFlat(const T& payload) {
+    static_assert(cond::serialization::flat_payload<T>::value, "the type has no flat encoding");
+    std::pair<Binary, Binary> ret;
+    std::string streamerInfo(StreamerInfo::jsonString(StreamerInfo::FLAT_TECHNOLOGY));
+    try {
+      std::string dataBuffer;
+      cond::serialization::FlatWriter writer(dataBuffer);
+      cond::serialization::flat_payload<T>::write(writer, payload);
+      ret.first = Binary(dataBuffer.data(), dataBuffer.size());
+      ret.second.copy(streamerInfo);
+    } catch (const std::exception& e) {
+      std::string em(e.what());
+      throwException("Serialization failed: " + em + ". Serialization info:" + streamerInfo, "serializeFlat");
+    }
+    return ret;
+  }
+
   // generates an instance of T from the binary serialized data.
   template <typename T>
   std::unique_ptr<T> default_deserialize(const std::string& payloadType,
@@ -90,6 +112,24 @@ namespace cond {
     std::stringbuf sstreamerInfoBuf;
     sstreamerInfoBuf.pubsetbuf(static_cast<char*>(const_cast<void*>(streamerInfoData.data())), streamerInfoData.size());
     std::string streamerInfo = sstreamerInfoBuf.str();
+    if (cond::serialization::flat::isFlat(payloadData.data(), payloadData.size())) {
+      if constexpr (cond::serialization::flat_payload<T>::value) {
+        try {
+          cond::serialization::FlatReader reader(payloadData.data(), payloadData.size());
+          payload.reset(createPayload<T>(payloadType));
+          cond::serialization::flat_payload<T>::read(reader, *payload);
+        } catch (const std::exception& e) {
+          throwException(std::string("De-serialization failed: ") + e.what() + " Payload serialization info: " +
+                             streamerInfo,
+                         "default_deserialize");
+        }
+        return payload;
+      } else {
+        throwException("De-serialization failed: the class " + payloadType +
+                           " can not be read from the flat encoding. Payload serialization info: " + streamerInfo,
+                       "default_deserialize");
+      }
+    }
     try {
       std::stringbuf sdataBuf;
       sdataBuf.pubsetbuf(static_cast<char*>(const_cast<void*>(payloadData.data())), payloadData.size());
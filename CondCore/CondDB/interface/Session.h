@@ -144,6 +144,12 @@ namespace cond {
           const T& payload,
           const boost::posix_time::ptime& creationTime = boost::posix_time::microsec_clock::universal_time());
 
+      // same as storePayload, with the flat encoding, for the types which have one (see FlatPayload.h)
+      template <typename T>
+      cond::Hash storeFlatPayload(
+          const T& payload,
+          const boost::posix_time::ptime& creationTime = boost::posix_time::microsec_clock::universal_time());
+
       template <typename T>
       std::unique_ptr<T> fetchPayload(const cond::Hash& payloadHash);
 
@@ -156,6 +162,9 @@ namespace cond {
                             cond::Binary& payloadData,
                             cond::Binary& streamerInfoData);
 
+      // removes the payload from the payload cache if the cached copy is corrupted, returns true if it was
+      bool discardCachedPayload(const cond::Hash& payloadHash);
+
       // internal functions. creates proxies without loading a specific tag.
       IOVProxy iovProxy();
 
@@ -206,6 +215,20 @@ namespace cond {
       return ret;
     }
 
+    template <typename T>
+    inline cond::Hash Session::storeFlatPayload(const T& payload, const boost::posix_time::ptime& creationTime) {
+      std::string payloadObjectType = cond::demangledName(typeid(payload));
+      cond::Hash ret;
+      try {
+        ret = storePayloadData(payloadObjectType, serializeFlat(payload), creationTime);
+      } catch (const cond::persistency::Exception& e) {
+        std::string em(e.what());
+        throwException("Payload of type " + payloadObjectType + " could not be stored. " + em,
+                       "Session::storeFlatPayload");
+      }
+      return ret;
+    }
+
     template <>
     inline cond::Hash Session::storePayload<std::string>(const std::string& payload,
                                                          const boost::posix_time::ptime& creationTime) {
@@ -228,15 +251,21 @@ namespace cond {
       if (!fetchPayloadData(payloadHash, payloadType, payloadData, streamerInfoData))
         throwException("Payload with id " + payloadHash + " has not been found in the database.",
                        "Session::fetchPayload");
-      std::unique_ptr<T> ret;
-      try {
-        ret = deserialize<T>(payloadType, payloadData, streamerInfoData);
-      } catch (const cond::persistency::Exception& e) {
-        std::string em(e.what());
-        throwException("Payload of type " + payloadType + " with id " + payloadHash + " could not be loaded. " + em,
-                       "Session::fetchPayload");
+      for (bool retry = true;; retry = false) {
+        try {
+          return deserialize<T>(payloadType, payloadData, streamerInfoData);
+        } catch (const cond::persistency::Exception& e) {
+          // the entries of the payload cache are not checked on read: a corrupted one is dropped, and the payload
+          // is read again from the database
+          if (!(retry && discardCachedPayload(payloadHash) &&
+                fetchPayloadData(payloadHash, payloadType, payloadData, streamerInfoData))) {
+            std::string em(e.what());
+            throwException(
+                "Payload of type " + payloadType + " with id " + payloadHash + " could not be loaded. " + em,
+                "Session::fetchPayload");
+          }
+        }
       }
-      return ret;
     }
 
     class TransactionScope {
@@ -25,6 +25,15 @@ namespace cond {
     ConnectionPool::ConnectionPool() {
       m_pluginManager = new cond::CoralServiceManager;
       configure();
+      // the cache directory is usually specific to the node, and can be set by the job environment
+      const char* cachePathEnv = std::getenv(PayloadCache::COND_PAYLOAD_CACHE_PATH);
+      if (cachePathEnv) {
+        size_t cacheSize = PayloadCache::DEFAULT_SIZE_MB;
+        const char* cacheSizeEnv = std::getenv(PayloadCache::COND_PAYLOAD_CACHE_SIZE_MB);
+        if (cacheSizeEnv)
+          cacheSize = ::atol(cacheSizeEnv);
+        setPayloadCache(cachePathEnv, cacheSize);
+      }
     }
 
     ConnectionPool::~ConnectionPool() { delete m_pluginManager; }
@@ -37,6 +46,13 @@ namespace cond {
 
     void ConnectionPool::setLogging(bool flag) { m_loggingEnabled = flag; }
 
+    void ConnectionPool::setPayloadCache(const std::string& path, size_t maxSizeMB) {
+      if (path.empty() || maxSizeMB == 0)
+        m_payloadCache.reset();
+      else
+        m_payloadCache = std::make_shared<PayloadCache>(path, maxSizeMB << 20);
+    }
+
     void ConnectionPool::setParameters(const edm::ParameterSet& connectionPset) {
       //set the connection parameters from a ParameterSet
       //if a parameter is not defined, keep the values already set in the data members
@@ -65,6 +81,11 @@ namespace cond {
       }
       setMessageVerbosity(level);
       setLogging(connectionPset.getUntrackedParameter<bool>("logging", m_loggingEnabled));
+      std::string cachePath = m_payloadCache ? m_payloadCache->path() : std::string("");
+      int cacheSizeMB = m_payloadCache ? m_payloadCache->maxSize() >> 20 : PayloadCache::DEFAULT_SIZE_MB;
+      cacheSizeMB = connectionPset.getUntrackedParameter<int>("payloadCacheSizeMB", cacheSizeMB);
+      setPayloadCache(connectionPset.getUntrackedParameter<std::string>("payloadCachePath", cachePath),
+                      cacheSizeMB > 0 ? cacheSizeMB : 0);
     }
 
     bool ConnectionPool::isLoggingEnabled() const { return m_loggingEnabled; }
@@ -148,7 +169,9 @@ namespace cond {
                                           bool writeCapable) {
       std::shared_ptr<coral::ISessionProxy> coralSession =
           createCoralSession(connectionString, transactionId, writeCapable);
-      return Session(std::make_shared<SessionImpl>(coralSession, connectionString));
+      auto sessionImpl = std::make_shared<SessionImpl>(coralSession, connectionString);
+      sessionImpl->payloadCache = m_payloadCache;
+      return Session(sessionImpl);
     }
 
     Session ConnectionPool::createSession(const std::string& connectionString, bool writeCapable) {
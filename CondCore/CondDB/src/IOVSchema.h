@@ -10,6 +10,9 @@ namespace cond {
 
   namespace persistency {
 
+    // the payload id: SHA1 of the type name and of the serialized data
+    cond::Hash makeHash(const std::string& objectType, const cond::Binary& data);
+
     conddb_table(TAG) {
       conddb_column(NAME, std::string);
       conddb_column(TIME_TYPE, cond::TimeType);
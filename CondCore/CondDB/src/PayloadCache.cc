@@ -0,0 +1,259 @@
+#include "CondCore/CondDB/interface/PayloadCache.h"
+#include "CondCore/CondDB/interface/Binary.h"
+#include "IOVSchema.h"
+//
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+//
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// externals
+#include <boost/filesystem/operations.hpp>
+
+namespace cond {
+
+  namespace persistency {
+
+    namespace {
+
+      constexpr char s_magic[8] = {'C', 'O', 'N', 'D', 'P', 'L', '0', '1'};
+
+      struct EntryHeader {
+        char magic[8];
+        uint32_t typeSize;
+        uint32_t reserved;
+        uint64_t dataSize;
+        uint64_t streamerInfoSize;
+      };
+
+      bool validHash(const cond::Hash& payloadHash) {
+        return payloadHash.size() == 40 &&
+               std::all_of(payloadHash.begin(), payloadHash.end(), [](unsigned char c) { return std::isxdigit(c); });
+      }
+
+      bool writeAll(int fd, const void* data, size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+          ssize_t n = ::write(fd, p, size);
+          if (n < 0) {
+            if (errno == EINTR)
+              continue;
+            return false;
+          }
+          p += n;
+          size -= n;
+        }
+        return true;
+      }
+
+      // reads an entry, checking only that its size matches its header
+      bool readEntry(const std::string& fileName,
+                     std::string& payloadType,
+                     cond::Binary& payloadData,
+                     cond::Binary& streamerInfoData) {
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+          return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(EntryHeader)) {
+          ::close(fd);
+          return false;
+        }
+        size_t fileSize = st.st_size;
+        void* map = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+          ::close(fd);
+          return false;
+        }
+        ::madvise(map, fileSize, MADV_SEQUENTIAL);
+
+        const char* base = static_cast<const char*>(map);
+        EntryHeader header;
+        ::memcpy(&header, base, sizeof(header));
+        bool valid = (::memcmp(header.magic, s_magic, sizeof(s_magic)) == 0 &&
+                      sizeof(header) + header.typeSize + header.dataSize + header.streamerInfoSize == fileSize);
+        if (valid) {
+          const char* p = base + sizeof(header);
+          payloadType.assign(p, header.typeSize);
+          p += header.typeSize;
+          payloadData = cond::Binary(p, header.dataSize);
+          p += header.dataSize;
+          streamerInfoData = cond::Binary(p, header.streamerInfoSize);
+          // the modification time orders the entries for the eviction, also for the other processes
+          ::futimens(fd, nullptr);
+        }
+        ::munmap(map, fileSize);
+        ::close(fd);
+        return valid;
+      }
+
+    }  // namespace
+
+    PayloadCache::PayloadCache(const std::string& path, size_t maxSize) : m_path(path), m_maxSize(maxSize) {}
+
+    std::string PayloadCache::entryPath(const cond::Hash& payloadHash) const {
+      // spread the entries over 256 directories
+      return m_path + "/" + payloadHash.substr(0, 2) + "/" + payloadHash;
+    }
+
+    bool PayloadCache::load(const cond::Hash& payloadHash,
+                            std::string& payloadType,
+                            cond::Binary& payloadData,
+                            cond::Binary& streamerInfoData) const {
+      if (!validHash(payloadHash))
+        return false;
+      std::string fileName = entryPath(payloadHash);
+      // the file name is trusted to be the hash of the content, recomputing it would cost as much as the read
+      bool valid = readEntry(fileName, payloadType, payloadData, streamerInfoData);
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (!valid) {
+        ::unlink(fileName.c_str());
+        removeFromIndex(payloadHash);
+        return false;
+      }
+      auto entry = m_index.find(payloadHash);
+      if (entry != m_index.end())
+        m_lru.splice(m_lru.end(), m_lru, entry->second.lru);
+      return true;
+    }
+
+    bool PayloadCache::discardIfInvalid(const cond::Hash& payloadHash) const {
+      if (!validHash(payloadHash))
+        return false;
+      std::string fileName = entryPath(payloadHash);
+      if (::access(fileName.c_str(), F_OK) != 0)
+        return false;
+      std::string type;
+      cond::Binary data;
+      cond::Binary streamerInfo;
+      if (readEntry(fileName, type, data, streamerInfo) && makeHash(type, data) == payloadHash)
+        return false;
+      std::lock_guard<std::mutex> guard(m_mutex);
+      ::unlink(fileName.c_str());
+      removeFromIndex(payloadHash);
+      return true;
+    }
+
+    bool PayloadCache::store(const cond::Hash& payloadHash,
+                             const std::string& payloadType,
+                             const cond::Binary& payloadData,
+                             const cond::Binary& streamerInfoData) const {
+      if (!validHash(payloadHash) || m_maxSize == 0)
+        return false;
+      EntryHeader header;
+      ::memcpy(header.magic, s_magic, sizeof(s_magic));
+      header.typeSize = payloadType.size();
+      header.reserved = 0;
+      header.dataSize = payloadData.size();
+      header.streamerInfoSize = streamerInfoData.size();
+      if (sizeof(header) + header.typeSize + header.dataSize + header.streamerInfoSize > m_maxSize)
+        return false;
+
+      std::string fileName = entryPath(payloadHash);
+      boost::system::error_code ec;
+      boost::filesystem::create_directories(boost::filesystem::path(fileName).parent_path(), ec);
+      if (ec)
+        return false;
+      // the temporary files are hidden from the eviction, which only removes complete entries
+      std::string tmpName = m_path + "/" + payloadHash.substr(0, 2) + "/." + payloadHash + ".XXXXXX";
+      std::vector<char> tmpTemplate(tmpName.begin(), tmpName.end());
+      tmpTemplate.push_back('\0');
+      int fd = ::mkstemp(tmpTemplate.data());
+      if (fd < 0)
+        return false;
+      bool ok = writeAll(fd, &header, sizeof(header)) && writeAll(fd, payloadType.data(), header.typeSize) &&
+                writeAll(fd, payloadData.data(), header.dataSize) &&
+                writeAll(fd, streamerInfoData.data(), header.streamerInfoSize);
+      ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+      ok = (::close(fd) == 0) && ok;
+      // another process writing the same entry at the same time writes the same content
+      if (!ok || ::rename(tmpTemplate.data(), fileName.c_str()) != 0) {
+        ::unlink(tmpTemplate.data());
+        return false;
+      }
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_indexed)
+        addToIndex(payloadHash, sizeof(header) + header.typeSize + header.dataSize + header.streamerInfoSize);
+      else
+        buildIndex();
+      if (m_totalSize > m_maxSize)
+        evict();
+      return true;
+    }
+
+    void PayloadCache::buildIndex() const {
+      struct Entry {
+        struct timespec time;
+        size_t size;
+        cond::Hash hash;
+      };
+      std::vector<Entry> entries;
+      boost::system::error_code ec;
+      for (boost::filesystem::recursive_directory_iterator it(m_path, ec), end; !ec && it != end; it.increment(ec)) {
+        // the temporary files start with a '.' and are not valid hashes
+        std::string name = it->path().filename().string();
+        if (!validHash(name))
+          continue;
+        // the modification times are compared to the nanosecond, several entries are often used in one second
+        struct stat st;
+        if (::stat(it->path().c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+          continue;
+        entries.push_back({st.st_mtim, size_t(st.st_size), name});
+      }
+      std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.time.tv_sec < b.time.tv_sec || (a.time.tv_sec == b.time.tv_sec && a.time.tv_nsec < b.time.tv_nsec);
+      });
+      m_lru.clear();
+      m_index.clear();
+      m_totalSize = 0;
+      for (const auto& entry : entries)
+        addToIndex(entry.hash, entry.size);
+      m_indexed = true;
+    }
+
+    void PayloadCache::addToIndex(const cond::Hash& payloadHash, size_t size) const {
+      auto entry = m_index.find(payloadHash);
+      if (entry != m_index.end()) {
+        m_totalSize -= entry->second.size;
+        entry->second.size = size;
+        m_lru.splice(m_lru.end(), m_lru, entry->second.lru);
+      } else {
+        m_index.emplace(payloadHash, IndexEntry{size, m_lru.insert(m_lru.end(), payloadHash)});
+      }
+      m_totalSize += size;
+    }
+
+    void PayloadCache::removeFromIndex(const cond::Hash& payloadHash) const {
+      auto entry = m_index.find(payloadHash);
+      if (entry == m_index.end())
+        return;
+      m_totalSize -= entry->second.size;
+      m_lru.erase(entry->second.lru);
+      m_index.erase(entry);
+    }
+
+    void PayloadCache::evict() const {
+      // the other processes sharing the directory may have added or removed entries since the index was built
+      buildIndex();
+      if (m_totalSize <= m_maxSize)
+        return;
+      // remove the least recently used entries down to 90% of the limit, leaving room for the next stores
+      size_t target = m_maxSize / 10 * 9;
+      boost::system::error_code ec;
+      while (m_totalSize > target && !m_lru.empty()) {
+        cond::Hash payloadHash = m_lru.front();
+        boost::filesystem::remove(entryPath(payloadHash), ec);
+        removeFromIndex(payloadHash);
+      }
+    }
+
+  }  // namespace persistency
+}  // namespace cond
@@ -5,12 +5,12 @@
 
 std::string cond::StreamerInfo::techVersion() { return BOOST_LIB_VERSION; }
 
-std::string cond::StreamerInfo::jsonString() {
+std::string cond::StreamerInfo::jsonString(char const* technology) {
   std::stringstream ss;
   ss << " {" << std::endl;
   ss << "\"" << CMSSW_VERSION_LABEL << "\": \"" << currentCMSSWVersion() << "\"," << std::endl;
   ss << "\"" << ARCH_LABEL << "\": \"" << currentArchitecture() << "\"," << std::endl;
-  ss << "\"" << TECH_LABEL << "\": \"" << TECHNOLOGY << "\"," << std::endl;
+  ss << "\"" << TECH_LABEL << "\": \"" << technology << "\"," << std::endl;
   ss << "\"" << TECH_VERSION_LABEL << "\": \"" << techVersion() << "\"" << std::endl;
   ss << " }" << std::endl;
   return ss.str();
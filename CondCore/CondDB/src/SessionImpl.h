@@ -5,6 +5,7 @@
 #include "IOVSchema.h"
 #include "GTSchema.h"
 #include "RunInfoSchema.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
 //
 #include "RelationalAccess/ConnectionService.h"
 #include "RelationalAccess/ISessionProxy.h"
@@ -71,6 +72,8 @@ namespace cond {
       std::unique_ptr<IIOVSchema> iovSchemaHandle;
       std::unique_ptr<IGTSchema> gtSchemaHandle;
       std::unique_ptr<IRunInfoSchema> runInfoSchemaHandle;
+      // local copies of the payloads, looked up before the database if set
+      std::shared_ptr<PayloadCache> payloadCache;
 
     private:
       std::recursive_mutex transactionMutex;
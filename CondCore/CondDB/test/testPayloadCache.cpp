@@ -0,0 +1,139 @@
+#include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/standard.h"
+//
+#include "CondCore/CondDB/interface/ConnectionPool.h"
+#include "CondCore/CondDB/interface/Binary.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
+//
+#include "MyTestData.h"
+//
+#include <boost/filesystem/operations.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace cond::persistency;
+
+const int iVal0(18);
+const std::string cachePath("testPayloadCache_dir");
+
+int run(const std::string& connectionString, const std::string& emptyConnectionString) {
+  int nFail = 0;
+  try {
+    boost::filesystem::remove_all(cachePath);
+    ConnectionPool connPool;
+    connPool.setMessageVerbosity(coral::Debug);
+    connPool.setPayloadCache(cachePath, 16);
+
+    //*************
+    std::cout << "> Storing payload in " << connectionString << std::endl;
+    Session session = connPool.createSession(connectionString, true);
+    session.transaction().start(false);
+    MyTestData d0(iVal0);
+    cond::Hash p0 = session.storePayload(d0, boost::posix_time::microsec_clock::universal_time());
+    session.transaction().commit();
+
+    // the first read goes to the database and fills the cache
+    session.transaction().start();
+    std::shared_ptr<MyTestData> pay0 = session.fetchPayload<MyTestData>(p0);
+    session.transaction().commit();
+    if (*pay0 != MyTestData(iVal0)) {
+      nFail++;
+      std::cout << "ERROR, payload read from the database found to be wrong" << std::endl;
+    }
+
+    // a database without the payload can only be served by the cache
+    std::cout << "> Reading payload " << p0 << " from the cache" << std::endl;
+    Session emptySession = connPool.createSession(emptyConnectionString, true);
+    emptySession.transaction().start(false);
+    std::shared_ptr<MyTestData> pay1 = emptySession.fetchPayload<MyTestData>(p0);
+    emptySession.transaction().commit();
+    if (*pay1 != MyTestData(iVal0)) {
+      nFail++;
+      std::cout << "ERROR, payload read from the cache found to be wrong" << std::endl;
+    }
+  } catch (const std::exception& e) {
+    std::cout << "ERROR: " << e.what() << std::endl;
+    return -1;
+  } catch (...) {
+    std::cout << "UNEXPECTED FAILURE." << std::endl;
+    return -1;
+  }
+  boost::filesystem::remove_all(cachePath);
+  if (nFail == 0) {
+    std::cout << "## Run successfully completed." << std::endl;
+  } else {
+    std::cout << "## Run completed with ERRORS. nFail = " << nFail << std::endl;
+  }
+  return nFail;
+}
+
+// the index of the entry sizes, the eviction of the least recently used entries, and the check of the entries
+int runIndex() {
+  int nFail = 0;
+  boost::filesystem::remove_all(cachePath);
+  const std::string type("Data");
+  std::vector<char> buffer(1000, 'x');
+  cond::Binary data(buffer.data(), buffer.size());
+  cond::Binary streamerInfo;
+  // the hashes are made up, the entries are trusted when read
+  std::vector<cond::Hash> hashes;
+  for (char c : {'0', '1', '2', '3'})
+    hashes.emplace_back(40, c);
+  // room for three and a half entries
+  const size_t entrySize = 32 + type.size() + buffer.size();
+  PayloadCache cache(cachePath, entrySize * 7 / 2);
+  auto cached = [&](const cond::Hash& hash) {
+    std::string t;
+    cond::Binary d, s;
+    return cache.load(hash, t, d, s);
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    if (!cache.store(hashes[i], type, data, streamerInfo)) {
+      nFail++;
+      std::cout << "ERROR, payload " << i << " could not be stored" << std::endl;
+    }
+  }
+  // the first entry becomes the most recently used, the second one the least recently used
+  if (!cached(hashes[0])) {
+    nFail++;
+    std::cout << "ERROR, payload 0 not found in the cache" << std::endl;
+  }
+  cache.store(hashes[3], type, data, streamerInfo);
+  if (cached(hashes[1]) || !cached(hashes[0]) || !cached(hashes[2]) || !cached(hashes[3])) {
+    nFail++;
+    std::cout << "ERROR, the least recently used payload should have been evicted, and only it" << std::endl;
+  }
+
+  // a truncated entry is missing, one with the wrong content is only removed by discardIfInvalid()
+  {
+    std::ofstream truncated(cachePath + "/22/" + hashes[2], std::ios::trunc);
+    truncated << "CONDPL01";
+  }
+  if (cached(hashes[2])) {
+    nFail++;
+    std::cout << "ERROR, a truncated entry should not be read" << std::endl;
+  }
+  if (!cache.discardIfInvalid(hashes[3]) || cached(hashes[3])) {
+    nFail++;
+    std::cout << "ERROR, an entry not matching its hash should have been discarded" << std::endl;
+  }
+  boost::filesystem::remove_all(cachePath);
+  if (nFail == 0) {
+    std::cout << "## Index test successfully completed." << std::endl;
+  }
+  return nFail;
+}
+
+int main(int argc, char** argv) {
+  edmplugin::PluginManager::Config config;
+  edmplugin::PluginManager::configure(edmplugin::standard::config());
+  std::string connectionString0("sqlite_file:testPayloadCache.db");
+  std::string connectionString1("sqlite_file:testPayloadCache_empty.db");
+  int ret = runIndex();
+  if (ret != 0)
+    return ret;
+  return run(connectionString0, connectionString1);
+}
@@ -29,6 +29,7 @@ public:
   //virtual ~DataProxy();
 
   // ---------- const member functions ---------------------
+  std::string const& payloadHash() const override { return m_data->payloadId(); }
 
   // ---------- static member functions --------------------
 
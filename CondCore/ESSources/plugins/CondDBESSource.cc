@@ -27,6 +27,12 @@
 #include <exception>
 
 #include <iomanip>
+#include <mutex>
+
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 
 namespace {
   /* utility ot build the name of the plugin corresponding to a given record
@@ -92,6 +98,7 @@ namespace {
  *  DBParameters: configuration set of the connection
  *  globaltag: The GlobalTag
  *  toGet: list of record label tag connection-string to add/overwrite the content of the global-tag
+ *  nConcurrentTagLoads: number of tags loaded at the same time at construction, 1 to load them in sequence
  */
 CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
     : m_connection(),
@@ -215,6 +222,15 @@ CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
 
   // now all required libraries have been loaded
   // init sessions and DataProxies
+  struct TagToLoad {
+    cond::DataProxyWrapperBase* proxy;
+    std::string tag;
+    std::string connStr;
+    std::string recordLabel;
+    boost::posix_time::ptime snapshotTime;
+  };
+  std::vector<TagToLoad> tagsToLoad;
+  tagsToLoad.reserve(m_tagCollection.size());
   ipb = 0;
   for (it = itBeg; it != itEnd; ++it) {
     std::string connStr = m_connectionString;
@@ -225,7 +241,6 @@ CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
       tag = tagParams.first;
     }
     std::map<std::string, cond::persistency::Session>::iterator p = sessions.find(connStr);
-    cond::persistency::Session nsess;
     if (p == sessions.end()) {
       std::string oracleConnStr = cond::persistency::convertoToOracleConnection(connStr);
       std::tuple<std::string, std::string, std::string> connPars =
@@ -237,10 +252,8 @@ CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
             << "[WARNING] You are reading tag \"" << tag << "\" from V1 account \"" << connStr
             << "\". The concerned Conditions might be out of date." << std::endl;
       //open db get tag info (i.e. the IOV token...)
-      nsess = m_connection.createReadOnlySession(connStr, "");
-      sessions.insert(std::make_pair(connStr, nsess));
-    } else
-      nsess = (*p).second;
+      sessions.insert(std::make_pair(connStr, m_connection.createReadOnlySession(connStr, "")));
+    }
 
     // ownership...
     ProxyP proxy(std::move(proxyWrappers[ipb++]));
@@ -255,7 +268,37 @@ CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
     if (tagSnapshotTime == boost::posix_time::time_from_string(std::string(cond::time::MAX_TIMESTAMP)))
       tagSnapshotTime = boost::posix_time::ptime();
 
-    proxy->lateInit(nsess, tag, tagSnapshotTime, it->second.recordLabel(), connStr);
+    tagsToLoad.push_back({proxy.get(), tag, connStr, it->second.recordLabel(), tagSnapshotTime});
+  }
+
+  // loading a tag takes a few round trips to the database server: the tags are loaded concurrently, each thread
+  // with its own sessions since the transactions of a session are serialized
+  unsigned int nLoadingThreads = iConfig.getUntrackedParameter<unsigned int>("nConcurrentTagLoads", 8);
+  if (nLoadingThreads <= 1 || tagsToLoad.size() <= 1) {
+    for (auto& toLoad : tagsToLoad)
+      toLoad.proxy->lateInit(
+          sessions[toLoad.connStr], toLoad.tag, toLoad.snapshotTime, toLoad.recordLabel, toLoad.connStr);
+  } else {
+    std::mutex connectionMutex;
+    tbb::enumerable_thread_specific<std::map<std::string, cond::persistency::Session>> threadSessions;
+    tbb::task_arena arena(nLoadingThreads);
+    arena.execute([&]() {
+      tbb::parallel_for(
+          tbb::blocked_range<size_t>(0, tagsToLoad.size(), 1), [&](tbb::blocked_range<size_t> const& range) {
+            auto& localSessions = threadSessions.local();
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+              TagToLoad& toLoad = tagsToLoad[i];
+              auto p = localSessions.find(toLoad.connStr);
+              if (p == localSessions.end()) {
+                std::lock_guard<std::mutex> guard(connectionMutex);
+                p = localSessions
+                        .insert(std::make_pair(toLoad.connStr, m_connection.createReadOnlySession(toLoad.connStr, "")))
+                        .first;
+              }
+              toLoad.proxy->lateInit(p->second, toLoad.tag, toLoad.snapshotTime, toLoad.recordLabel, toLoad.connStr);
+            }
+          });
+    });
   }
 
   // one loaded expose all other tags to the Proxy!
@@ -0,0 +1,62 @@
+#include "CondCore/CondDB/interface/ConnectionPool.h"
+
+#include "CondCore/Utilities/interface/Utilities.h"
+#include "CondCore/Utilities/interface/CondDBTools.h"
+#include <iostream>
+
+// Copies a Global Tag, with the IOVs of all its tags valid in a run range and the payloads they point to,
+// to a local database (typically sqlite_file:<bundle>.db). The jobs then read all their conditions from the
+// local file, setting it as connection string of the CondDBESSource with the same global tag. The IOVs are
+// the ones of the global tag snapshot, and the bundle keeps that snapshot.
+
+namespace cond {
+
+  class GTBundleUtilities : public cond::Utilities {
+  public:
+    GTBundleUtilities();
+    ~GTBundleUtilities() override;
+    int execute() override;
+  };
+}  // namespace cond
+
+cond::GTBundleUtilities::GTBundleUtilities() : Utilities("conddb_gt_bundle") {
+  addConnectOption("fromConnect", "f", "source connection string (required)");
+  addConnectOption("connect", "c", "target connection string, e.g. sqlite_file:bundle.db (required)");
+  addAuthenticationOptions();
+  addOption<std::string>("globaltag", "g", "global tag (required)");
+  addOption<cond::Time_t>("beginRun", "b", "first run of the range (optional, default=1)");
+  addOption<cond::Time_t>("endRun", "e", "last run of the range (optional, default=infinity)");
+}
+
+cond::GTBundleUtilities::~GTBundleUtilities() {}
+
+int cond::GTBundleUtilities::execute() {
+  std::string sourceConnect = getOptionValue<std::string>("fromConnect");
+  std::string destConnect = getOptionValue<std::string>("connect");
+  std::string gtName = getOptionValue<std::string>("globaltag");
+  cond::Time_t beginRun = 1;
+  if (hasOptionValue("beginRun"))
+    beginRun = getOptionValue<cond::Time_t>("beginRun");
+  cond::Time_t endRun = cond::time::MAX_VAL;
+  if (hasOptionValue("endRun"))
+    endRun = getOptionValue<cond::Time_t>("endRun");
+
+  persistency::ConnectionPool connPool;
+  if (hasOptionValue("authPath")) {
+    connPool.setAuthenticationPath(getOptionValue<std::string>("authPath"));
+  }
+  connPool.configure();
+
+  std::cout << "# Loading global tag " << gtName << " from " << sourceConnect << std::endl;
+  persistency::Session gtSession = connPool.createSession(sourceConnect);
+  std::cout << "# Opening session on destination database..." << std::endl;
+  persistency::Session destSession = connPool.createSession(destConnect, true);
+  size_t nIovs = persistency::bundleGlobalTag(gtName, gtSession, destSession, connPool, beginRun, endRun);
+  std::cout << "# " << nIovs << " iov(s) copied to " << destConnect << std::endl;
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  cond::GTBundleUtilities utilities;
+  return utilities.run(argc, argv);
+}
@@ -3,12 +3,14 @@
 
 #include "CondCore/CondDB/interface/Time.h"
 //
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <string>
 
 namespace cond {
 
   namespace persistency {
 
+    class ConnectionPool;
     class Session;
 
     size_t importIovs(const std::string& sourceTag,
@@ -23,6 +25,32 @@ namespace cond {
                       bool serialize,
                       bool forceInsert);
 
+    // same as above, with the iovs of the source tag as they were at snapshotTime. The iovs are inserted in the
+    // destination tag at snapshotTime (or now, if earlier), so that they are the ones seen with that snapshot.
+    size_t importIovs(const std::string& sourceTag,
+                      Session& sourceSession,
+                      const std::string& destTag,
+                      Session& destSession,
+                      cond::Time_t begin,
+                      cond::Time_t end,
+                      const std::string& description,
+                      const std::string& editingNote,
+                      bool override,
+                      bool serialize,
+                      bool forceInsert,
+                      const boost::posix_time::ptime& snapshotTime);
+
+    // copies the global tag gtName of gtSession to destSession, with the iovs of its tags valid in the run range
+    // [beginRun, endRun] as they were at the snapshot time of the global tag, and the payloads they point to.
+    // The copy keeps the snapshot time. The tags from other databases are read through connPool.
+    // Returns the number of iovs copied.
+    size_t bundleGlobalTag(const std::string& gtName,
+                           Session& gtSession,
+                           Session& destSession,
+                           ConnectionPool& connPool,
+                           cond::Time_t beginRun,
+                           cond::Time_t endRun);
+
     bool copyIov(Session& session,
                  const std::string& sourceTag,
                  const std::string& destTag,
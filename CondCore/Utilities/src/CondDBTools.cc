@@ -1,12 +1,18 @@
 #include "CondCore/Utilities/interface/CondDBTools.h"
 #include "CondCore/Utilities/interface/CondDBImport.h"
 #include "CondCore/CondDB/interface/ConnectionPool.h"
+#include "CondCore/CondDB/interface/GTEditor.h"
+#include "CondCore/CondDB/interface/GTProxy.h"
+#include "CondCore/CondDB/interface/Utils.h"
 //
 #include "CondCore/CondDB/src/DbCore.h"
 //
 #include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
 #include <boost/bind.hpp>
+#include <algorithm>
+#include <iostream>
+#include <map>
 #include <memory>
 
 namespace cond {
@@ -51,10 +57,38 @@ namespace cond {
                       bool override,
                       bool reserialize,
                       bool forceInsert) {
+      return importIovs(sourceTag,
+                        sourceSession,
+                        destTag,
+                        destSession,
+                        begin,
+                        end,
+                        description,
+                        editingNote,
+                        override,
+                        reserialize,
+                        forceInsert,
+                        boost::posix_time::ptime());
+    }
+
+    size_t importIovs(const std::string& sourceTag,
+                      Session& sourceSession,
+                      const std::string& destTag,
+                      Session& destSession,
+                      cond::Time_t begin,
+                      cond::Time_t end,
+                      const std::string& description,
+                      const std::string& editingNote,
+                      bool override,
+                      bool reserialize,
+                      bool forceInsert,
+                      const boost::posix_time::ptime& snapshotTime) {
       persistency::TransactionScope ssc(sourceSession.transaction());
       ssc.start();
       std::cout << "    Loading source iov..." << std::endl;
-      persistency::IOVProxy p = sourceSession.readIov(sourceTag, true);
+      bool hasSnapshot = !snapshotTime.is_not_a_date_time();
+      persistency::IOVProxy p =
+          hasSnapshot ? sourceSession.readIov(sourceTag, snapshotTime, true) : sourceSession.readIov(sourceTag, true);
       if (p.loadedSize() == 0) {
         std::cout << "    Tag contains 0 iovs." << std::endl;
         return 0;
@@ -156,12 +190,108 @@ namespace cond {
       }
       std::cout << "    Total of iov inserted: " << niovs << " payloads: " << pids.size() << std::endl;
       std::cout << "    Flushing changes..." << std::endl;
-      editor.flush(editingNote, forceInsert);
+      if (hasSnapshot) {
+        boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+        editor.flush(editingNote, std::min(snapshotTime, now), forceInsert);
+      } else {
+        editor.flush(editingNote, forceInsert);
+      }
       dsc.commit();
       ssc.commit();
       return niovs;
     }
 
+    namespace {
+      // the bounds of the run range for the time type of a tag: the time based tags are copied entirely
+      std::pair<cond::Time_t, cond::Time_t> rangeFor(cond::TimeType timeType,
+                                                     cond::Time_t beginRun,
+                                                     cond::Time_t endRun) {
+        if (timeType == cond::runnumber)
+          return std::make_pair(beginRun, endRun);
+        if (timeType == cond::lumiid) {
+          cond::Time_t end =
+              endRun >= (cond::time::MAX_VAL >> 32) ? cond::time::MAX_VAL : (endRun << 32) | 0xFFFFFFFF;
+          return std::make_pair(beginRun << 32, end);
+        }
+        return std::make_pair(cond::time::Time_t(1), cond::time::MAX_VAL);
+      }
+    }  // namespace
+
+    size_t bundleGlobalTag(const std::string& gtName,
+                           Session& gtSession,
+                           Session& destSession,
+                           ConnectionPool& connPool,
+                           cond::Time_t beginRun,
+                           cond::Time_t endRun) {
+      if (beginRun > endRun)
+        throwException("Begin run can't be greater than end run.", "bundleGlobalTag");
+      std::string sourceConnect = gtSession.connectionString();
+      gtSession.transaction().start(true);
+      persistency::GTProxy gt = gtSession.readGlobalTag(gtName);
+      std::vector<cond::GTEntry_t> entries(gt.begin(), gt.end());
+      cond::Time_t gtValidity = gt.validity();
+      boost::posix_time::ptime snapshotTime = gt.snapshotTime();
+      gtSession.transaction().commit();
+      std::cout << "# " << entries.size() << " tags found, snapshot time " << snapshotTime << std::endl;
+
+      // the tags can come from other databases than the global tag itself
+      std::map<std::string, persistency::Session> sourceSessions;
+      sourceSessions.insert(std::make_pair(sourceConnect, gtSession));
+      std::map<std::string, std::string> copiedTags;
+      size_t nIovs = 0;
+      for (auto const& entry : entries) {
+        std::pair<std::string, std::string> tagParams = persistency::parseTag(entry.tagName());
+        std::string tag = tagParams.first;
+        std::string tagConnect = tagParams.second.empty() ? sourceConnect : tagParams.second;
+        auto iCopied = copiedTags.find(tag);
+        if (iCopied != copiedTags.end()) {
+          if (iCopied->second != tagConnect)
+            throwException("Tag " + tag + " is used from two different databases.", "bundleGlobalTag");
+          continue;
+        }
+        auto iSession = sourceSessions.find(tagConnect);
+        if (iSession == sourceSessions.end())
+          iSession = sourceSessions.insert(std::make_pair(tagConnect, connPool.createSession(tagConnect))).first;
+        persistency::Session& sourceSession = iSession->second;
+
+        sourceSession.transaction().start(true);
+        cond::TimeType timeType = sourceSession.readIov(tag).timeType();
+        sourceSession.transaction().commit();
+        auto range = rangeFor(timeType, beginRun, endRun);
+
+        std::cout << "# Copying tag " << tag << " for " << entry.recordName() << " " << entry.recordLabel()
+                  << std::endl;
+        nIovs += importIovs(tag,
+                            sourceSession,
+                            tag,
+                            destSession,
+                            range.first,
+                            range.second,
+                            "",
+                            "Bundle of global tag " + gtName,
+                            false,
+                            false,
+                            true,
+                            snapshotTime);
+        copiedTags.insert(std::make_pair(tag, tagConnect));
+      }
+
+      // all the tags are now local, with the iovs inserted at (or before) the snapshot time
+      std::cout << "# Writing global tag " << gtName << std::endl;
+      destSession.transaction().start(false);
+      persistency::GTEditor editor = destSession.createGlobalTag(gtName);
+      editor.setDescription("Bundle of " + gtName + " from " + sourceConnect);
+      editor.setRelease(cond::currentCMSSWVersion());
+      editor.setValidity(gtValidity);
+      editor.setSnapshotTime(snapshotTime);
+      for (auto const& entry : entries)
+        editor.insert(entry.recordName(), entry.recordLabel(), persistency::parseTag(entry.tagName()).first);
+      editor.flush();
+      destSession.transaction().commit();
+      std::cout << "# " << copiedTags.size() << " tags and " << nIovs << " iov(s) copied" << std::endl;
+      return nIovs;
+    }
+
     bool copyIov(Session& session,
                  const std::string& sourceTag,
                  const std::string& destTag,
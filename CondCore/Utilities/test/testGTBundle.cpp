@@ -0,0 +1,102 @@
+#include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/standard.h"
+//
+#include "CondCore/CondDB/interface/ConnectionPool.h"
+#include "CondCore/Utilities/interface/CondDBTools.h"
+//
+#include <cstdio>
+#include <iostream>
+
+using namespace cond::persistency;
+
+// the payload valid for a run of the tag, as seen with snapshotTime (not_a_date_time for the latest iovs)
+std::string payloadFor(Session& session,
+                       const std::string& tag,
+                       cond::Time_t run,
+                       const boost::posix_time::ptime& snapshotTime) {
+  IOVProxy proxy = snapshotTime.is_not_a_date_time() ? session.readIov(tag) : session.readIov(tag, snapshotTime);
+  IOVProxy::Iterator iovIt = proxy.find(run);
+  if (iovIt == proxy.end())
+    return "";
+  return *session.fetchPayload<std::string>((*iovIt).payloadId);
+}
+
+int run(const std::string& sourceConnect, const std::string& destConnect) {
+  int failures = 0;
+  try {
+    ConnectionPool connPool;
+    connPool.configure();
+    boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+    boost::posix_time::ptime before = now - boost::posix_time::hours(2);
+    boost::posix_time::ptime snapshotTime = now - boost::posix_time::hours(1);
+
+    // a tag with the iovs 1 and 200 inserted before the snapshot of the global tag, and 100 after it
+    Session source = connPool.createSession(sourceConnect, true);
+    source.transaction().start(false);
+    auto p0 = source.storePayload(std::string("Payload #0"));
+    auto p1 = source.storePayload(std::string("Payload #1"));
+    auto p2 = source.storePayload(std::string("Payload #2"));
+    IOVEditor iovEditor = source.createIov<std::string>("MyTag", cond::runnumber);
+    iovEditor.setDescription("Test of the global tag bundle");
+    iovEditor.insert(1, p0, before);
+    iovEditor.insert(200, p1, before);
+    iovEditor.insert(100, p2, now);
+    iovEditor.flush();
+    GTEditor gtEditor = source.createGlobalTag("MY_GT");
+    gtEditor.setDescription("Test of the global tag bundle");
+    gtEditor.setRelease("CMSSW_X_Y_Z");
+    gtEditor.setSnapshotTime(snapshotTime);
+    gtEditor.insert("MyRecord", "MyTag");
+    gtEditor.flush();
+    source.transaction().commit();
+
+    Session dest = connPool.createSession(destConnect, true);
+    size_t nIovs = bundleGlobalTag("MY_GT", source, dest, connPool, 1, cond::time::MAX_VAL);
+    std::cout << "> " << nIovs << " iov(s) bundled" << std::endl;
+    if (nIovs != 2) {
+      std::cout << "ERROR: expected 2 iovs, the ones of the snapshot" << std::endl;
+      ++failures;
+    }
+
+    source.transaction().start(true);
+    dest.transaction().start(true);
+    GTProxy gt = dest.readGlobalTag("MY_GT");
+    if (gt.snapshotTime() != snapshotTime) {
+      std::cout << "ERROR: bundle snapshot " << gt.snapshotTime() << " instead of " << snapshotTime << std::endl;
+      ++failures;
+    }
+    // with the snapshot of the global tag, the bundle gives what the source gives
+    for (cond::Time_t r : {1, 150, 250}) {
+      std::string expected = payloadFor(source, "MyTag", r, snapshotTime);
+      std::string found = payloadFor(dest, "MyTag", r, gt.snapshotTime());
+      std::cout << "> run " << r << ": source \"" << expected << "\", bundle \"" << found << "\"" << std::endl;
+      if (found != expected || found.empty()) {
+        std::cout << "ERROR: different payloads for run " << r << std::endl;
+        ++failures;
+      }
+    }
+    // the iov inserted after the snapshot is not in the bundle
+    if (payloadFor(dest, "MyTag", 150, boost::posix_time::ptime()) != "Payload #0") {
+      std::cout << "ERROR: the iov inserted after the snapshot has been bundled" << std::endl;
+      ++failures;
+    }
+    dest.transaction().commit();
+    source.transaction().commit();
+  } catch (const std::exception& e) {
+    std::cout << "ERROR: " << e.what() << std::endl;
+    return 1;
+  } catch (...) {
+    std::cout << "UNEXPECTED FAILURE." << std::endl;
+    return 1;
+  }
+  return failures == 0 ? 0 : 1;
+}
+
+int main() {
+  edmplugin::PluginManager::configure(edmplugin::standard::config());
+  std::remove("testGTBundleSource.db");
+  std::remove("testGTBundleDest.db");
+  int ret = run("sqlite_file:testGTBundleSource.db", "sqlite_file:testGTBundleDest.db");
+  std::cout << "## Global tag bundle test " << (ret == 0 ? "passed" : "failed") << std::endl;
+  return ret;
+}
@@ -33,6 +33,14 @@ public:
   //for backwards-compatibility
   double GetClassifier(const float* vector) const { return GetGradBoostClassifier(vector); }
 
+  // The same for n vectors, stride floats apart, evaluated one tree
+  // at a time over all of them; the results are those of one by one.
+  void GetResponse(const float* vectors, unsigned int stride, unsigned int n, double* responses) const;
+  void GetGradBoostClassifier(const float* vectors, unsigned int stride, unsigned int n, double* responses) const;
+  void GetClassifier(const float* vectors, unsigned int stride, unsigned int n, double* responses) const {
+    GetGradBoostClassifier(vectors, stride, n, responses);
+  }
+
   void SetInitialResponse(double response) { fInitialResponse = response; }
 
   std::vector<GBRTree>& Trees() { return fTrees; }
@@ -60,4 +68,23 @@ inline double GBRForest::GetGradBoostClassifier(const float* vector) const {
   return 2.0 / (1.0 + exp(-2.0 * response)) - 1;  //MVA output between -1 and 1
 }
 
+//_______________________________________________________________________
+inline void GBRForest::GetResponse(const float* vectors, unsigned int stride, unsigned int n, double* responses) const {
+  for (unsigned int i = 0; i < n; ++i)
+    responses[i] = fInitialResponse;
+  for (std::vector<GBRTree>::const_iterator it = fTrees.begin(); it != fTrees.end(); ++it) {
+    it->GetResponse(vectors, stride, n, responses);
+  }
+}
+
+//_______________________________________________________________________
+inline void GBRForest::GetGradBoostClassifier(const float* vectors,
+                                              unsigned int stride,
+                                              unsigned int n,
+                                              double* responses) const {
+  GetResponse(vectors, stride, n, responses);
+  for (unsigned int i = 0; i < n; ++i)
+    responses[i] = 2.0 / (1.0 + exp(-2.0 * responses[i])) - 1;
+}
+
 #endif
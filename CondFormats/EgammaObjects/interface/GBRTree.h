@@ -33,6 +33,10 @@ public:
 
   double GetResponse(const float *vector) const;
 
+  /// Add the responses to n vectors, stride floats apart, to responses:
+  /// the nodes of the tree stay in cache for all of them
+  void GetResponse(const float *vectors, unsigned int stride, unsigned int n, double *responses) const;
+
   std::vector<float> &Responses() { return fResponses; }
   const std::vector<float> &Responses() const { return fResponses; }
 
@@ -69,4 +73,13 @@ inline double GBRTree::GetResponse(const float *vector) const {
   return fResponses[-index];
 }
 
+//_______________________________________________________________________
+inline void GBRTree::GetResponse(const float *vectors,
+                                 unsigned int stride,
+                                 unsigned int n,
+                                 double *responses) const {
+  for (unsigned int i = 0; i < n; ++i)
+    responses[i] += GetResponse(vectors + i * stride);
+}
+
 #endif
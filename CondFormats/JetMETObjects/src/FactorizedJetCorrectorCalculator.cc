@@ -281,6 +281,7 @@ std::vector<float> FactorizedJetCorrectorCalculator::getSubCorrections(
   float scale, factor;
   std::vector<float> factors;
   std::vector<float> vx, vy;
+  factors.reserve(mLevels.size());
   factor = 1;
   for (unsigned int i = 0; i < mLevels.size(); i++) {
     vx = fillVector(mBinTypes[i], iValues);
@@ -313,6 +314,7 @@ std::vector<float> FactorizedJetCorrectorCalculator::fillVector(
     const std::vector<VarTypes>& fVarTypes, const FactorizedJetCorrectorCalculator::VariableValues& iValues) const {
   //  std::vector<VarTypes> fVarTypes = _fVarTypes;
   std::vector<float> result;
+  result.reserve(fVarTypes.size());
   for (unsigned i = 0; i < fVarTypes.size(); i++) {
     if (fVarTypes[i] == kJetEta) {
       if (!iValues.mIsJetEtaset)
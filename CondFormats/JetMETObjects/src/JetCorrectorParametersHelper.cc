@@ -8,6 +8,7 @@
 #include <sstream>
 #include <cstdlib>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iterator>
 
@@ -146,8 +147,9 @@ int JetCorrectorParametersHelper::binIndexN(const std::vector<float>& fX,
   unsigned Nm1 = SIZE - 1;
   binIndexChecks(SIZE, fX);
 
-  //Create a container for the indices
-  std::vector<float> fN(SIZE, -1);
+  //Create a container for the indices, on the stack as this is called for every jet
+  std::array<float, JetCorrectorParameters::MAX_SIZE_DIMENSIONALITY> fN;
+  fN.fill(-1);
   std::vector<float>::const_iterator tmpIt;
 
   // make sure that fX are within the first and last boundaries of mBinBoundaries (other than last dimension)
@@ -169,8 +171,9 @@ int JetCorrectorParametersHelper::binIndexN(const std::vector<float>& fX,
   if (SIZE > 1) {
     tuple_type_Nm1 to_find_Nm1 = gen_tuple<JetCorrectorParameters::MAX_SIZE_DIMENSIONALITY - 1>(
         [&](size_t i) { return (i < Nm1) ? fN[i] : -9999; });
-    if (mMap.find(to_find_Nm1) != mMap.end())
-      indexBounds = mMap.at(to_find_Nm1);
+    auto const itBounds = mMap.find(to_find_Nm1);
+    if (itBounds != mMap.end())
+      indexBounds = itBounds->second;
     else {
       std::stringstream sserr;
       sserr << "couldn't find the index boundaries for dimension " << Nm1 << std::endl
@@ -191,5 +194,6 @@ int JetCorrectorParametersHelper::binIndexN(const std::vector<float>& fX,
 
   tuple_type to_find =
       gen_tuple<JetCorrectorParameters::MAX_SIZE_DIMENSIONALITY>([&](size_t i) { return (i < SIZE) ? fN[i] : -9999; });
-  return (mIndexMap.find(to_find) != mIndexMap.end()) ? mIndexMap.at(to_find) : -1;
+  auto const itIndex = mIndexMap.find(to_find);
+  return (itIndex != mIndexMap.end()) ? itIndex->second : -1;
 }
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Flat encoding of the payloads, for classes made of a few large arrays
+// of trivially copyable data. Each array is stored as its size followed by
+// its raw bytes, aligned to 8 bytes, so that reading a payload is a bulk
+// copy of each array instead of the element-by-element decoding of the
+// boost archives. The arrays can also be accessed in place with view(),
+// for as long as the buffer they were read from is kept.
+//
+// A class opts in by specialising cond::serialization::flat_payload and
+// granting it access to its members:
+//
+//   class MyPayload {
+//     ...
+//     COND_SERIALIZABLE;
+//     friend struct cond::serialization::flat_payload<MyPayload>;
+//   };
+//
+//   template <>
+//   struct cond::serialization::flat_payload<MyPayload> : std::true_type {
+//     static void write(FlatWriter& w, MyPayload const& p) { w.write(p.values); }
+//     static void read(FlatReader& r, MyPayload& p) { r.read(p.values); }
+//   };
+//
+// The boost serialization of the class stays the default: the flat encoding
+// is written only when asked for (cond::serializeFlat, Session::storeFlatPayload),
+// and the encoding is identified by its header when the payload is read back.
+
+namespace cond {
+  namespace serialization {
+
+    template <typename T, typename Enabled = void>
+    struct flat_payload : std::false_type {};
+
+    namespace flat {
+      constexpr char magic[8] = {'C', 'O', 'N', 'D', 'F', 'L', 'A', 'T'};
+      constexpr uint32_t version = 1;
+      // written in the native byte order, read back only on a machine with the same one
+      constexpr uint32_t byteOrderMark = 0x01020304;
+      constexpr size_t alignment = 8;
+
+      struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrderMark;
+      };
+
+      inline bool isFlat(const void* data, size_t size) {
+        return size >= sizeof(Header) && std::memcmp(data, magic, sizeof(magic)) == 0;
+      }
+    }  // namespace flat
+
+    class FlatWriter {
+    public:
+      explicit FlatWriter(std::string& buffer) : m_buffer(buffer) {
+        flat::Header header;
+        std::memcpy(header.magic, flat::magic, sizeof(flat::magic));
+        header.version = flat::version;
+        header.byteOrderMark = flat::byteOrderMark;
+        append(&header, sizeof(header));
+      }
+
+      template <typename T>
+      void write(T const& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable data can be written flat");
+        append(&value, sizeof(T));
+      }
+
+      template <typename T>
+      void write(std::vector<T> const& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable data can be written flat");
+        uint64_t size = values.size();
+        append(&size, sizeof(size));
+        append(values.data(), size * sizeof(T));
+      }
+
+    private:
+      void append(const void* data, size_t size) {
+        m_buffer.append(static_cast<const char*>(data), size);
+        m_buffer.resize((m_buffer.size() + flat::alignment - 1) / flat::alignment * flat::alignment, '\0');
+      }
+
+      std::string& m_buffer;
+    };
+
+    class FlatReader {
+    public:
+      FlatReader(const void* data, size_t size)
+          : m_current(static_cast<const char*>(data)), m_end(m_current + size) {
+        flat::Header header;
+        take(&header, sizeof(header));
+        if (std::memcmp(header.magic, flat::magic, sizeof(flat::magic)) != 0)
+          throw std::runtime_error("not a flat payload");
+        if (header.version != flat::version)
+          throw std::runtime_error("unsupported flat payload version " + std::to_string(header.version));
+        if (header.byteOrderMark != flat::byteOrderMark)
+          throw std::runtime_error("flat payload written with a different byte order");
+      }
+
+      template <typename T>
+      void read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable data can be read flat");
+        take(&value, sizeof(T));
+      }
+
+      template <typename T>
+      void read(std::vector<T>& values) {
+        auto v = view<T>();
+        values.resize(v.second);
+        std::memcpy(values.data(), v.first, v.second * sizeof(T));
+      }
+
+      // the next array, in place in the buffer
+      template <typename T>
+      std::pair<const T*, size_t> view() {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable data can be read flat");
+        uint64_t size;
+        take(&size, sizeof(size));
+        if (size > uint64_t(m_end - m_current) / sizeof(T))
+          throw std::runtime_error("flat payload truncated");
+        const T* data = reinterpret_cast<const T*>(m_current);
+        skip(size * sizeof(T));
+        return std::make_pair(data, size_t(size));
+      }
+
+      bool atEnd() const { return m_current == m_end; }
+
+    private:
+      void take(void* data, size_t size) {
+        if (size > size_t(m_end - m_current))
+          throw std::runtime_error("flat payload truncated");
+        std::memcpy(data, m_current, size);
+        skip(size);
+      }
+
+      void skip(size_t size) {
+        size_t padded = (size + flat::alignment - 1) / flat::alignment * flat::alignment;
+        m_current += std::min(padded, size_t(m_end - m_current));
+      }
+
+      const char* m_current;
+      const char* m_end;
+    };
+
+  }  // namespace serialization
+}  // namespace cond
@@ -2,6 +2,7 @@
 #define SiStripApvGain_h
 
 #include "CondFormats/Serialization/interface/Serializable.h"
+#include "CondFormats/Serialization/interface/FlatPayload.h"
 
 #include <vector>
 #include <map>
@@ -92,6 +93,23 @@ private:
   std::vector<unsigned int> v_iend;
 
   COND_SERIALIZABLE;
+  friend struct cond::serialization::flat_payload<SiStripApvGain>;
+};
+
+template <>
+struct cond::serialization::flat_payload<SiStripApvGain> : std::true_type {
+  static void write(FlatWriter& w, SiStripApvGain const& p) {
+    w.write(p.v_gains);
+    w.write(p.v_detids);
+    w.write(p.v_ibegin);
+    w.write(p.v_iend);
+  }
+  static void read(FlatReader& r, SiStripApvGain& p) {
+    r.read(p.v_gains);
+    r.read(p.v_detids);
+    r.read(p.v_ibegin);
+    r.read(p.v_iend);
+  }
 };
 
 #endif
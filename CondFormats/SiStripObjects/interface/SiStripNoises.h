@@ -2,6 +2,7 @@
 #define SiStripNoises_h
 
 #include "CondFormats/Serialization/interface/Serializable.h"
+#include "CondFormats/Serialization/interface/FlatPayload.h"
 
 #include <vector>
 #include <utility>
@@ -102,6 +103,20 @@ private:
   */
 
   COND_SERIALIZABLE;
+  friend struct cond::serialization::flat_payload<SiStripNoises>;
+};
+
+// the noises of the whole tracker are read as two arrays
+template <>
+struct cond::serialization::flat_payload<SiStripNoises> : std::true_type {
+  static void write(FlatWriter& w, SiStripNoises const& p) {
+    w.write(p.v_noises);
+    w.write(p.indexes);
+  }
+  static void read(FlatReader& r, SiStripNoises& p) {
+    r.read(p.v_noises);
+    r.read(p.indexes);
+  }
 };
 
 /// Get 9 bit words from a bit stream, starting from the right, skipping the first 'skip' bits (0 < skip < 8).
@@ -0,0 +1,97 @@
+#include "CondCore/CondDB/interface/Serialization.h"
+#include "CondFormats/SiStripObjects/interface/SiStripApvGain.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// writes the payloads with the flat encoding and checks that they are read back identical
+template <typename T>
+T roundTrip(const T& payload) {
+  std::string buffer;
+  cond::serialization::FlatWriter writer(buffer);
+  cond::serialization::flat_payload<T>::write(writer, payload);
+  if (!cond::serialization::flat::isFlat(buffer.data(), buffer.size()))
+    throw std::logic_error("The flat header was not written.");
+
+  T result;
+  cond::serialization::FlatReader reader(buffer.data(), buffer.size());
+  cond::serialization::flat_payload<T>::read(reader, result);
+  if (!reader.atEnd())
+    throw std::logic_error("The flat payload was not read completely.");
+
+  // a truncated payload must be detected
+  bool thrown = false;
+  try {
+    T truncated;
+    cond::serialization::FlatReader truncatedReader(buffer.data(), buffer.size() - 8);
+    cond::serialization::flat_payload<T>::read(truncatedReader, truncated);
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  if (!thrown)
+    throw std::logic_error("A truncated flat payload was read.");
+  return result;
+}
+
+// stores the payloads as the CondDB does, by default with boost and on request flat, and reads them back
+template <typename T>
+std::unique_ptr<T> condRoundTrip(const T& payload, bool flat) {
+  std::pair<cond::Binary, cond::Binary> data = flat ? cond::serializeFlat(payload) : cond::serialize(payload);
+  if (cond::serialization::flat::isFlat(data.first.data(), data.first.size()) != flat)
+    throw std::logic_error(flat ? "serializeFlat did not write the flat encoding."
+                                : "serialize did not write the boost encoding.");
+  return cond::default_deserialize<T>(cond::demangledName(typeid(T)), data.first, data.second);
+}
+
+void checkPayloads(const SiStripNoises& noises, const SiStripNoises& readNoises) {
+  for (uint32_t detId = 1; detId <= 100; ++detId) {
+    SiStripNoises::Range range = noises.getRange(detId);
+    SiStripNoises::Range readRange = readNoises.getRange(detId);
+    for (uint16_t strip = 0; strip < 512; ++strip) {
+      if (SiStripNoises::getNoise(strip, range) != SiStripNoises::getNoise(strip, readRange))
+        throw std::logic_error("SiStripNoises differ after the round trip.");
+    }
+  }
+}
+
+void checkPayloads(const SiStripApvGain& gains, const SiStripApvGain& readGains) {
+  for (uint32_t detId = 1; detId <= 100; ++detId) {
+    SiStripApvGain::Range gainRange = gains.getRange(detId);
+    SiStripApvGain::Range readGainRange = readGains.getRange(detId);
+    for (uint16_t apv = 0; apv < 4; ++apv) {
+      if (SiStripApvGain::getApvGain(apv, gainRange) != SiStripApvGain::getApvGain(apv, readGainRange))
+        throw std::logic_error("SiStripApvGain differ after the round trip.");
+    }
+  }
+}
+
+int main() {
+  SiStripNoises noises;
+  SiStripApvGain gains;
+  for (uint32_t detId = 1; detId <= 100; ++detId) {
+    SiStripNoises::InputVector input;
+    for (uint16_t strip = 0; strip < 512; ++strip)
+      noises.setData(float((detId + strip) % 50), input);
+    noises.put(detId, input);
+
+    std::vector<float> apvGains;
+    for (uint16_t apv = 0; apv < 4; ++apv)
+      apvGains.push_back(1.f + 0.01f * (detId + apv));
+    gains.put(detId, SiStripApvGain::Range(apvGains.begin(), apvGains.end()));
+  }
+
+  checkPayloads(noises, roundTrip(noises));
+  checkPayloads(gains, roundTrip(gains));
+  std::cout << "Flat round trip of SiStripNoises and SiStripApvGain succeeded" << std::endl;
+
+  for (bool flat : {false, true}) {
+    checkPayloads(noises, *condRoundTrip(noises, flat));
+    checkPayloads(gains, *condRoundTrip(gains, flat));
+  }
+  std::cout << "Boost and flat round trips through cond::serialize of SiStripNoises and SiStripApvGain succeeded"
+            << std::endl;
+  return 0;
+}
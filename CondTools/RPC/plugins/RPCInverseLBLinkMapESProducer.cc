@@ -1,44 +1,39 @@
 #include "CondTools/RPC/plugins/RPCInverseLBLinkMapESProducer.h"
 
-#include "FWCore/Framework/interface/ESHandle.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 
-#include "CondFormats/RPCObjects/interface/RPCLBLinkMap.h"
 #include "CondFormats/DataRecord/interface/RPCLBLinkMapRcd.h"
 #include "CondFormats/DataRecord/interface/RPCInverseLBLinkMapRcd.h"
 
 #include "DataFormats/MuonDetId/interface/RPCDetId.h"
 
-RPCInverseLBLinkMapESProducer::RPCInverseLBLinkMapESProducer(edm::ParameterSet const& _config) {
-  setWhatProduced(this);
-}
+RPCInverseLBLinkMapESProducer::RPCInverseLBLinkMapESProducer(edm::ParameterSet const& _config)
+    : es_rpc_lb_map_token_(setWhatProduced(this).consumesFrom<RPCLBLinkMap, RPCLBLinkMapRcd>()) {}
 
 void RPCInverseLBLinkMapESProducer::fillDescriptions(edm::ConfigurationDescriptions& _descs) {
   edm::ParameterSetDescription _desc;
   _descs.add("RPCInverseLBLinkMapESProducer", _desc);
 }
 
-void RPCInverseLBLinkMapESProducer::setupRPCLBLinkMap(RPCLBLinkMapRcd const& _rcd,
+void RPCInverseLBLinkMapESProducer::setupRPCLBLinkMap(RPCLBLinkMap const& _map,
                                                       RPCInverseLBLinkMap* inverse_linkmap) {
   RPCInverseLBLinkMap::map_type& _inverse_map(inverse_linkmap->getMap());
   _inverse_map.clear();
 
-  edm::ESHandle<RPCLBLinkMap> _es_map;
-  _rcd.get(_es_map);
-  RPCLBLinkMap const& _map = *(_es_map.product());
   for (auto const& _link : _map.getMap()) {
     _inverse_map.insert(RPCInverseLBLinkMap::map_type::value_type(_link.second.getRPCDetId().rawId(), _link));
   }
 }
 
 std::shared_ptr<RPCInverseLBLinkMap> RPCInverseLBLinkMapESProducer::produce(RPCInverseLBLinkMapRcd const& _rcd) {
-  auto host = holder_.makeOrGet([]() { return new HostType; });
-
-  host->ifRecordChanges<RPCLBLinkMapRcd>(_rcd, [this, h = host.get()](auto const& rec) { setupRPCLBLinkMap(rec, h); });
-
-  return host;
+  RPCLBLinkMapRcd const& _map_rcd = _rcd.getRecord<RPCLBLinkMapRcd>();
+  return memoizer_.makeOrReuse({_map_rcd.payloadHash(es_rpc_lb_map_token_)}, [&]() {
+    auto inverse_linkmap = std::make_shared<RPCInverseLBLinkMap>();
+    setupRPCLBLinkMap(_map_rcd.get(es_rpc_lb_map_token_), inverse_linkmap.get());
+    return inverse_linkmap;
+  });
 }
 
 //define this as a module
@@ -4,10 +4,11 @@
 #include <memory>
 
 #include "FWCore/Framework/interface/ESProducer.h"
-#include "FWCore/Framework/interface/ESProductHost.h"
-#include "FWCore/Utilities/interface/ReusableObjectHolder.h"
+#include "FWCore/Framework/interface/ESProductMemoizer.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
 
 #include "CondFormats/RPCObjects/interface/RPCInverseLBLinkMap.h"
+#include "CondFormats/RPCObjects/interface/RPCLBLinkMap.h"
 
 namespace edm {
   class ParameterSet;
@@ -26,11 +27,11 @@ public:
   std::shared_ptr<RPCInverseLBLinkMap> produce(RPCInverseLBLinkMapRcd const& _rcd);
 
 private:
-  using HostType = edm::ESProductHost<RPCInverseLBLinkMap, RPCLBLinkMapRcd>;
+  void setupRPCLBLinkMap(RPCLBLinkMap const&, RPCInverseLBLinkMap*);
 
-  void setupRPCLBLinkMap(RPCLBLinkMapRcd const&, RPCInverseLBLinkMap*);
-
-  edm::ReusableObjectHolder<HostType> holder_;
+  edm::ESGetToken<RPCLBLinkMap, RPCLBLinkMapRcd> es_rpc_lb_map_token_;
+  // the inverse map holds copies of the links, it is kept as long as the payload is the same
+  edm::ESProductMemoizer<RPCInverseLBLinkMap> memoizer_;
 };
 
 #endif  // CondTools_RPC_RPCInverseLBLinkMapESProducer_h
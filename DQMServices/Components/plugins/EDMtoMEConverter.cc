@@ -344,7 +344,9 @@ void EDMtoMEConverter::getData(DQMStore::IBooker &iBooker, DQMStore::IGetter &iG
       return;
     }
 
-    std::vector<typename MEtoEDM_T::MEtoEDMObject> metoedmobject = metoedm->getMEtoEdmObject();
+    // the objects are only read, cloned when booked or merged into the booked ones, so they are not copied
+    // out of the product; the ROOT interfaces want them non-const
+    auto const &metoedmobject = metoedm->getMEtoEdmObject();
 
     for (unsigned int i = 0; i < metoedmobject.size(); ++i) {
       // get full path of monitor element
@@ -366,7 +368,8 @@ void EDMtoMEConverter::getData(DQMStore::IBooker &iBooker, DQMStore::IGetter &iG
 
       // define new monitor element
       adjustScope(iBooker, iGetFrom, reScope);
-      AddMonitorElement<METype>::call(iBooker, iGetter, &metoedmobject[i].object, dir, name, iGetFrom);
+      AddMonitorElement<METype>::call(
+          iBooker, iGetter, const_cast<METype *>(&metoedmobject[i].object), dir, name, iGetFrom);
 
     }  // end loop thorugh metoedmobject
   });
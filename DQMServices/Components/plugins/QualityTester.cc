@@ -30,6 +30,8 @@
 #include <boost/property_tree/xml_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
+#include <unordered_map>
+
 #include <fnmatch.h>
 
 class QualityTester : public DQMEDHarvester {
@@ -71,7 +73,12 @@ private:
   // applied to, the second points to an object in qtestobjects. We cannot own
   // the objects here since more than one pattern can use the same test.
   std::vector<std::pair<std::string, QCriterion*>> qtestpatterns;
+  // the tests matching each ME name seen so far, in the order of qtestpatterns:
+  // the MEs keep their names from one run or lumisection to the next, so the
+  // patterns are matched once per name rather than at every test.
+  std::unordered_map<std::string, std::vector<QCriterion*>> qtestsByName;
 
+  std::vector<QCriterion*> const& matchingTests(std::string const& name);
   void configureTests(std::string const& file);
   std::unique_ptr<QCriterion> makeQCriterion(boost::property_tree::ptree const& config);
 };
@@ -141,17 +148,7 @@ void QualityTester::performTests(DQMStore::IGetter& igetter) {
   auto mes = igetter.getAllContents("");
 
   for (auto me : mes) {
-    std::string name = me->getFullname();
-    for (auto& kv : this->qtestpatterns) {
-      std::string& pattern = kv.first;
-      QCriterion* qtest = kv.second;
-      int match = fnmatch(pattern.c_str(), name.c_str(), 0);
-      if (match == FNM_NOMATCH)
-        continue;
-      if (match != 0)
-        throw cms::Exception("QualityTester")
-            << "Something went wrong with fnmatch: pattern = '" << pattern << "' and string = '" << name << "'";
-
+    for (QCriterion* qtest : matchingTests(me->getFullname())) {
       // name matched, apply test.
       // Using the classic ME API for now.
       QReport* qr;
@@ -210,6 +207,25 @@ void QualityTester::performTests(DQMStore::IGetter& igetter) {
   }
 }
 
+std::vector<QCriterion*> const& QualityTester::matchingTests(std::string const& name) {
+  auto found = qtestsByName.find(name);
+  if (found != qtestsByName.end())
+    return found->second;
+
+  std::vector<QCriterion*> qtests;
+  for (auto& kv : this->qtestpatterns) {
+    std::string& pattern = kv.first;
+    int match = fnmatch(pattern.c_str(), name.c_str(), 0);
+    if (match == FNM_NOMATCH)
+      continue;
+    if (match != 0)
+      throw cms::Exception("QualityTester")
+          << "Something went wrong with fnmatch: pattern = '" << pattern << "' and string = '" << name << "'";
+    qtests.push_back(kv.second);
+  }
+  return qtestsByName.emplace(name, std::move(qtests)).first->second;
+}
+
 std::unique_ptr<QCriterion> QualityTester::makeQCriterion(boost::property_tree::ptree const& config) {
   // For whatever reasons the compiler needs the "template" keyword on ptree::get.
   // To save some noise in the code we have the preprocessor add it everywhere.
@@ -402,6 +418,7 @@ void QualityTester::configureTests(std::string const& file) {
   // the structure into something more useful for evaluating tests.
   this->qtestobjects.clear();
   this->qtestpatterns.clear();
+  this->qtestsByName.clear();
   for (auto& kv : qtestmap) {
     QCriterion* bareptr = kv.second.qtest.get();
     for (auto& p : kv.second.pathpatterns) {
@@ -51,11 +51,14 @@ public:
 
   void accumulate(edm::StreamID id, edm::Event const& event, edm::EventSetup const& setup) const final {
     auto const& h = *this->runCache(event.getRun().index());
+    // with streamFillBuffers, the MEs are filled in per-stream buffers
+    MonitorElement::StreamFillScope scope(id.value());
     dqmAnalyze(event, setup, h);
   }
 
   void globalEndRunProduce(edm::Run& run, edm::EventSetup const& setup) const final {
     auto const& h = *this->runCache(run.index());
+    dqmstore_->mergeStreamBuffers(meId(run));
     dqmEndRun(run, setup, h);
     dqmstore_->leaveLumi(run.run(), /* lumi */ 0, meId(run));
     run.emplace(runToken_);
@@ -68,11 +68,13 @@ public:
   static const uint32_t DQM_MSG_UPDATE_ME = 1;
   static const uint32_t DQM_MSG_LIST_OBJECTS = 2;
   static const uint32_t DQM_MSG_GET_OBJECT = 3;
+  static const uint32_t DQM_MSG_ACCEPT_DELTA = 4;
 
   static const uint32_t DQM_REPLY_LIST_BEGIN = 101;
   static const uint32_t DQM_REPLY_LIST_END = 102;
   static const uint32_t DQM_REPLY_NONE = 103;
   static const uint32_t DQM_REPLY_OBJECT = 104;
+  static const uint32_t DQM_REPLY_OBJECT_DELTA = 105;
 
   static const uint32_t MAX_PEER_WAITREQS = 128;
 
@@ -104,6 +106,8 @@ public:
     DataBlob rawdata;
     std::string scalar;
     std::string qdata;
+    uint64_t baseversion;  // version to which deltadata applies
+    DataBlob deltadata;    // compressed changes of rawdata since baseversion
   };
 
   struct Bucket {
@@ -128,6 +132,7 @@ public:
 
     unsigned mask;
     bool source;
+    bool delta;
     bool update;
     bool updated;
     size_t updates;
@@ -148,6 +153,7 @@ public:
 
   void debug(bool doit);
   void delay(int delay);
+  void deltaUpdates(bool doit);
   void startLocalServer(int port);
   void startLocalServer(const char *path);
   void staleObjectWaitLimit(lat::TimeSpan time);
@@ -309,10 +315,13 @@ public:
   static void packQualityData(std::string &into, const QReports &qr);
   static void unpackQualityData(QReports &qr, uint32_t &flags, const char *from);
 
+  static bool makeDelta(DataBlob &delta, const DataBlob &base, const DataBlob &data);
+  static bool applyDelta(DataBlob &data, const unsigned char *delta, size_t len);
+
 protected:
   std::ostream &logme();
   static void copydata(Bucket *b, const void *data, size_t len);
-  virtual void sendObjectToPeer(Bucket *msg, Object &o, bool data);
+  virtual void sendObjectToPeer(Bucket *msg, Object &o, bool data, bool delta);
 
   virtual bool shouldStop();
   void waitForData(Peer *p, const std::string &name, const std::string &info, Peer *owner);
@@ -329,7 +338,7 @@ protected:
   virtual Peer *getPeer(lat::Socket *s) = 0;
   virtual Peer *createPeer(lat::Socket *s) = 0;
   virtual void removePeer(Peer *p, lat::Socket *s) = 0;
-  virtual void sendObjectListToPeer(Bucket *msg, bool all, bool clear) = 0;
+  virtual void sendObjectListToPeer(Bucket *msg, bool all, bool clear, bool delta) = 0;
   virtual void sendObjectListToPeers(bool all) = 0;
 
   void updateMask(Peer *p);
@@ -337,6 +346,7 @@ protected:
   static void discard(Bucket *&b);
 
   bool debug_;
+  bool delta_;
   pthread_mutex_t lock_;
 
 private:
@@ -490,6 +500,7 @@ protected:
     ip->sendpos = 0;
     ip->mask = 0;
     ip->source = false;
+    ip->delta = false;
     ip->update = false;
     ip->updated = false;
     ip->updates = 0;
@@ -515,7 +526,8 @@ protected:
   }
 
   /// Send all objects to a peer and optionally mark sent objects old.
-  void sendObjectListToPeer(Bucket *msg, bool all, bool clear) override {
+  /// If @a delta, the data is sent as changes when they are available.
+  void sendObjectListToPeer(Bucket *msg, bool all, bool clear, bool delta) override {
     typename PeerMap::iterator pi, pe;
     typename ObjectMap::iterator oi, oe;
     size_t size = 0;
@@ -539,7 +551,7 @@ protected:
     for (pi = peers_.begin(), pe = peers_.end(); pi != pe; ++pi)
       for (oi = pi->second.objs.begin(), oe = pi->second.objs.end(); oi != oe; ++oi)
         if (all || (oi->flags & DQM_PROP_NEW)) {
-          sendObjectToPeer(msg, const_cast<ObjType &>(*oi), oi->lastreq > 0);
+          sendObjectToPeer(msg, const_cast<ObjType &>(*oi), oi->lastreq > 0, delta);
           if (clear)
             const_cast<ObjType &>(*oi).flags &= ~DQM_PROP_NEW;
           ++nupdates;
@@ -563,7 +575,7 @@ protected:
 
       Bucket msg;
       msg.next = nullptr;
-      sendObjectListToPeer(&msg, !p.updated || all, true);
+      sendObjectListToPeer(&msg, !p.updated || all, true, p.delta && p.updated);
 
       if (!msg.data.empty()) {
         Bucket **prev = &p.sendq;
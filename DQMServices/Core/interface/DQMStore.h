@@ -639,6 +639,9 @@ namespace dqm {
         // (e.g. when meBookerGetter is called *inside* a booking transaction).
       };
 
+      // Whether newly booked 2D and 3D histograms store their bins sparsely.
+      bool sparseHistograms() const { return doSparseHistograms_; }
+
       // For input modules: trigger recycling without local ME/enterLumi/moduleID.
       MonitorElement* findOrRecycle(MonitorElementData::Key const&);
 
@@ -648,6 +651,11 @@ namespace dqm {
       void enterLumi(edm::RunNumber_t run, edm::LuminosityBlockNumber_t lumi, uint64_t moduleID);
       void leaveLumi(edm::RunNumber_t run, edm::LuminosityBlockNumber_t lumi, uint64_t moduleID);
 
+      // With streamFillBuffers, add the per-stream fill buffers of the module's
+      // MEs to the shared MEs. This happens in leaveLumi, but modules which
+      // look at their MEs at the end of the run or lumi can call it earlier.
+      void mergeStreamBuffers(uint64_t moduleID);
+
       // this is triggered by a framework hook to remove/recycle MEs after a
       // run/lumi is saved. We do this via the edm::Service interface to make
       // sure it runs after *all* output modules, even if there are multiple.
@@ -709,6 +717,15 @@ namespace dqm {
       // Book MEs by lumi by default whenever possible.
       bool doSaveByLumi_;
 
+      // Give the local MEs one fill buffer per edm::Stream, so that modules
+      // filling from concurrent streams do not contend for the ME locks.
+      bool doStreamFillBuffers_;
+      unsigned int nStreams_ = 0;
+
+      // Keep only the filled bins of 2D and 3D histograms until the ROOT
+      // objects are needed, usually to save or send them.
+      bool doSparseHistograms_;
+
       // if non-empty, debugTrackME calls will log some information whenever a
       // ME path contains this string.
       std::string trackME_;
@@ -7,6 +7,7 @@
 #endif
 
 #include "DQMServices/Core/interface/DQMNet.h"
+#include "DQMServices/Core/interface/SparseBins.h"
 
 #include "DataFormats/Histograms/interface/MonitorElementCollection.h"
 
@@ -25,8 +26,10 @@
 #include "TObjString.h"
 #include "TAxis.h"
 
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <atomic>
 #include <sstream>
 #include <iomanip>
@@ -79,19 +82,28 @@ namespace dqm::impl {
     std::unique_lock<dqmmutex> guard_;
     MonitorElementData::Key const &key;
     MonitorElementData::Value const &value;
+    // even read access may need to restore a sparse ROOT object.
+    std::unique_ptr<SparseBins> &sparse;
   };
   // TODO: can this be the same type, just const?
   struct AccessMut {
     std::unique_lock<dqmmutex> guard_;
     MonitorElementData::Key const &key;
     MonitorElementData::Value &value;
+    std::unique_ptr<SparseBins> &sparse;
   };
 
   struct MutableMonitorElementData {
     MonitorElementData data_;
     dqmmutex lock_;
-    Access access() { return Access{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_}; }
-    AccessMut accessMut() { return AccessMut{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_}; }
+    // the bins of the ROOT object while they are stored sparsely, else null.
+    std::unique_ptr<SparseBins> sparse_;
+    // whether the ROOT object goes back to sparse storage when it is reset.
+    bool sparseAllowed_ = false;
+    Access access() { return Access{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_, sparse_}; }
+    AccessMut accessMut() {
+      return AccessMut{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_, sparse_};
+    }
   };
 
   /** The base class for all MonitorElements (ME) */
@@ -139,6 +151,13 @@ namespace dqm::impl {
     MutableMonitorElementData *mutable_;  // only set if this is a mutable copy of this ME
     // there are no immutable MEs at this time, but we might need them in the future.
     bool is_owned_;  // true if we are responsible for deleting the mutable object.
+    // Fill buffers of the local ME, one per edm::Stream, only allocated if the
+    // DQMStore is configured with streamFillBuffers. Each is a reset clone of
+    // the data and only accessed by its stream, so filling it needs no lock.
+    // The buffers are added to the shared data by mergeStreamBuffers().
+    std::vector<std::unique_ptr<MutableMonitorElementData>> streamBuffers_;
+    // the stream set by the StreamFillScope of this thread, -1 if there is none.
+    static thread_local int fillStream_;
     /** 
      * To do anything to the MEs data, one needs to obtain an access object.
      * This object will contain the lock guard if one is needed. We differentiate
@@ -169,6 +188,17 @@ namespace dqm::impl {
       throw cms::Exception("LogicError") << "MonitorElement " << getName() << " not backed by any data!";
     }
 
+    // Access for the Fill() calls. Histograms of a ME with fill buffers are
+    // filled in the buffer of the current stream, without taking a lock.
+    AccessMut accessFill() {
+      if (streamBuffers_.empty() || fillStream_ < 0 || kind() < Kind::TH1F) {
+        return accessMut();
+      }
+      this->update();
+      MutableMonitorElementData *buffer = streamBuffer(fillStream_);
+      return AccessMut{std::unique_lock<dqmmutex>(), buffer->data_.key_, buffer->data_.value_, buffer->sparse_};
+    }
+
   private:
     // but internal -- only for DQMStore etc.
 
@@ -196,6 +226,20 @@ namespace dqm::impl {
     // ownership. The old object is deleted.
     void switchObject(std::unique_ptr<TH1> &&newobject);
 
+    // Allocate the slots for the fill buffers of nstreams edm::Streams. The
+    // buffers themselves are created on the first fill of each stream.
+    void enableStreamBuffers(unsigned int nstreams) { streamBuffers_.resize(nstreams); }
+    // the fill buffer of the stream, created as a reset clone of the data if needed.
+    MutableMonitorElementData *streamBuffer(unsigned int stream);
+    // Add the contents of the fill buffers to the data of this ME and reset
+    // them. Nobody may be filling the ME concurrently.
+    void mergeStreamBuffers();
+
+    // Store the bins of 2D and 3D histograms sparsely from now on, until
+    // anything needs the ROOT object. No-op for the other kinds.
+    void enableSparse();
+    void fillSparse(AccessMut &access, double x, double y, double z, double w);
+
     // copy applicable fileds into the DQMNet core object for compatibility.
     // In a few places these flags are also still used by the ME.
     void syncCoreObject();
@@ -235,6 +279,24 @@ namespace dqm::impl {
     void packQualityData(std::string &into) const;
     DQMNet::CoreObject data_;  //< Core object information.
 
+  public:
+    /**
+     * While an instance is alive, the Fill() calls of this thread go to the
+     * fill buffers of the edm::Stream, for the MEs which have them. This is
+     * set by the DQM module base classes around the event processing, the
+     * subsystem code does not need to know about it.
+     */
+    class StreamFillScope {
+    public:
+      explicit StreamFillScope(unsigned int stream) : previous_(fillStream_) { fillStream_ = stream; }
+      ~StreamFillScope() { fillStream_ = previous_; }
+      StreamFillScope(StreamFillScope const &) = delete;
+      StreamFillScope &operator=(StreamFillScope const &) = delete;
+
+    private:
+      int previous_;
+    };
+
   public:
     MonitorElement &operator=(const MonitorElement &) = delete;
     MonitorElement &operator=(MonitorElement &&) = delete;
@@ -442,6 +504,8 @@ namespace dqm::impl {
     void incompatible(const char *func) const;
     TH1 const *accessRootObject(Access const &access, const char *func, int reqdim) const;
     TH1 *accessRootObject(AccessMut const &, const char *func, int reqdim) const;
+    // the ROOT object without restoring sparse bins, only for the axes, titles and options.
+    TH1 *accessRootShell(TH1 *object, const char *func) const;
 
     TAxis const *getAxis(Access const &access, const char *func, int axis) const;
     TAxis *getAxis(AccessMut const &access, const char *func, int axis) const;
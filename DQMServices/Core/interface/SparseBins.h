@@ -0,0 +1,75 @@
+#ifndef DQMSERVICES_CORE_SPARSE_BINS_H
+#define DQMSERVICES_CORE_SPARSE_BINS_H
+
+#include "DataFormats/Histograms/interface/MonitorElementCollection.h"
+
+#include "TH1.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace dqm::impl {
+
+  /**
+   * Sparse storage for the contents of a 2D or 3D histogram, used by the
+   * MonitorElement when the DQMStore is configured with sparseHistograms.
+   *
+   * While a ME is sparse, its ROOT object is kept as an empty shell with the
+   * axes, titles and options, but without the bin arrays; the filled bins
+   * and the statistics are kept here. As soon as any code needs the ROOT
+   * object (getters, getTH1(), saving or sending the ME) the contents are
+   * restored into it, and the ME stays a normal ROOT histogram until it is
+   * reset. The same happens if so many bins are filled that the sparse
+   * storage would no longer be smaller.
+   *
+   * The fills follow the ROOT TH2/TH3 Fill() semantics: under- and overflows
+   * do not enter the statistics unless requested by StatOverflows(), and a
+   * weighted fill enables the sum of squares of the weights.
+   *
+   * Not thread-safe, the caller holds the lock of the ME.
+   */
+  class SparseBins {
+  public:
+    // whether the ROOT object of a ME of this kind can be stored sparsely
+    static bool supports(MonitorElementData::Kind kind, TH1 const *object);
+
+    // Take over the contents of object, which is left as an empty shell.
+    static std::unique_ptr<SparseBins> sparsify(TH1 *object);
+
+    // Put back the bin arrays and the contents into the shell object.
+    void restore(TH1 *object) const;
+
+    // Fill the bin of (x, y[, z]) of the shell object with weight w. Returns
+    // false if the histogram should be restored since it is no longer sparse.
+    bool fill(TH1 *object, double x, double y, double z, double w);
+
+    // Add the contents of a (dense) histogram with the same binning.
+    void add(TH1 const *other);
+
+    void reset();
+    void enableSumw2();
+
+    // number of bins holding any content
+    size_t size() const { return bins_.size(); }
+
+  private:
+    SparseBins() = default;
+
+    struct Bin {
+      double sumw = 0.;
+      double sumw2 = 0.;
+    };
+
+    // restore once more than this fraction of the bins is filled, where one
+    // map entry takes several times the memory of a float bin.
+    static constexpr int kMaxFilledFraction = 8;
+
+    std::unordered_map<int, Bin> bins_;
+    double entries_ = 0.;
+    double stats_[TH1::kNstat] = {};
+    bool sumw2_ = false;
+  };
+
+}  // namespace dqm::impl
+
+#endif  // DQMSERVICES_CORE_SPARSE_BINS_H
@@ -10,6 +10,7 @@
 #include "classlib/utils/StringOps.h"
 #include "classlib/utils/SystemError.h"
 #include "classlib/utils/Regexp.h"
+#include <zlib.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/wait.h>
@@ -17,6 +18,7 @@
 #include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cinttypes>
@@ -30,6 +32,7 @@
 #endif
 #define SOCKET_READ_SIZE (SOCKET_BUF_SIZE / 8)
 #define SOCKET_READ_GROWTH (SOCKET_BUF_SIZE)
+#define DELTA_RANGE_HEADER (2 * sizeof(uint32_t))
 
 using namespace lat;
 
@@ -236,6 +239,94 @@ void DQMNet::unpackQualityData(QReports &qr, uint32_t &flags, const char *from)
   }
 }
 
+/// Encode into @a delta the changes from @a base to @a data, both of
+/// which are serialised objects.  The changed bytes are recorded as a
+/// sequence of (number of unchanged bytes skipped, number of changed
+/// bytes, changed bytes) ranges, then compressed.  For histograms with
+/// fixed binning, the streamed bin contents are always at the same
+/// offset, so the ranges are the bins that changed plus the statistics.
+/// Returns false, with an empty @a delta, if the object changed size
+/// or if the changes are not smaller than the object itself.
+bool DQMNet::makeDelta(DataBlob &delta, const DataBlob &base, const DataBlob &data) {
+  delta.clear();
+  if (base.empty() || base.size() != data.size() || data.size() > MESSAGE_SIZE_LIMIT)
+    return false;
+
+  // Ranges separated by less unchanged bytes than a range header are
+  // merged into one.
+  DataBlob ranges;
+  size_t size = data.size();
+  size_t done = 0;
+  size_t pos = 0;
+  while ((pos = std::mismatch(base.begin() + pos, base.end(), data.begin() + pos).second - data.begin()) < size) {
+    size_t begin = pos;
+    size_t end = pos + 1;
+    for (pos = end; pos < size && pos - end < DELTA_RANGE_HEADER; ++pos)
+      if (base[pos] != data[pos])
+        end = pos + 1;
+
+    uint32_t words[2] = {uint32_t(begin - done), uint32_t(end - begin)};
+    ranges.insert(ranges.end(), (const unsigned char *)words, (const unsigned char *)words + sizeof(words));
+    ranges.insert(ranges.end(), &data[begin], &data[begin] + (end - begin));
+    done = end;
+  }
+
+  uint32_t rawlen = ranges.size();
+  uLongf zlen = compressBound(rawlen);
+  delta.resize(sizeof(rawlen) + zlen);
+  memcpy(&delta[0], &rawlen, sizeof(rawlen));
+  if (compress2(&delta[sizeof(rawlen)], &zlen, ranges.data(), rawlen, Z_BEST_SPEED) != Z_OK ||
+      sizeof(rawlen) + zlen >= size) {
+    delta.clear();
+    return false;
+  }
+
+  delta.resize(sizeof(rawlen) + zlen);
+  return true;
+}
+
+/// Apply to @a data the changes @a delta of length @a len encoded with
+/// makeDelta().  Returns false, leaving @a data untouched, if the
+/// changes are corrupt or do not fit in @a data.
+bool DQMNet::applyDelta(DataBlob &data, const unsigned char *delta, size_t len) {
+  uint32_t rawlen;
+  if (len < sizeof(rawlen))
+    return false;
+
+  // All ranges but the last are followed by at least a header worth of
+  // unchanged bytes, so the ranges are at most one header over the data.
+  memcpy(&rawlen, delta, sizeof(rawlen));
+  if (rawlen > data.size() + DELTA_RANGE_HEADER)
+    return false;
+
+  // One spare byte so that zlib has room even when there are no ranges.
+  DataBlob ranges(rawlen + 1);
+  uLongf rangelen = rawlen + 1;
+  if (uncompress(&ranges[0], &rangelen, delta + sizeof(rawlen), len - sizeof(rawlen)) != Z_OK || rangelen != rawlen)
+    return false;
+
+  // Check all the ranges before modifying the data.
+  for (int apply = 0; apply < 2; ++apply) {
+    size_t pos = 0;
+    for (size_t i = 0; i < rawlen;) {
+      uint32_t words[2];
+      if (rawlen - i < sizeof(words))
+        return false;
+      memcpy(&words[0], &ranges[i], sizeof(words));
+      i += sizeof(words);
+      if (words[1] > rawlen - i || words[0] > data.size() - pos || words[1] > data.size() - pos - words[0])
+        return false;
+      pos += words[0];
+      if (apply)
+        memcpy(&data[pos], &ranges[i], words[1]);
+      pos += words[1];
+      i += words[1];
+    }
+  }
+
+  return true;
+}
+
 #if 0
 // Deserialise a ROOT object from a buffer at the current position.
 static TObject *
@@ -370,7 +461,7 @@ bool DQMNet::shouldStop() { return shutdown_; }
 // peers.  Send the requested object to the waiting peer.
 void DQMNet::releaseFromWait(Bucket *msg, WaitObject &w, Object *o) {
   if (o)
-    sendObjectToPeer(msg, *o, true);
+    sendObjectToPeer(msg, *o, true, false);
   else {
     uint32_t words[3];
     words[0] = sizeof(words) + w.name.size();
@@ -385,17 +476,23 @@ void DQMNet::releaseFromWait(Bucket *msg, WaitObject &w, Object *o) {
 
 // Send an object to a peer.  If not @a data, only sends a summary
 // without the object data, except the data is always sent for scalar
-// objects.
-void DQMNet::sendObjectToPeer(Bucket *msg, Object &o, bool data) {
+// objects.  If @a delta and the changes to the data since the previous
+// version are known, only the changes are sent.
+void DQMNet::sendObjectToPeer(Bucket *msg, Object &o, bool data, bool delta) {
   uint32_t flags = o.flags & ~DQM_PROP_DEAD;
   DataBlob objdata;
+  bool sendDelta = false;
 
   if ((flags & DQM_PROP_TYPE_MASK) <= DQM_PROP_TYPE_SCALAR)
     objdata.insert(objdata.end(), &o.scalar[0], &o.scalar[0] + o.scalar.size());
-  else if (data)
+  else if (data && delta && !o.deltadata.empty()) {
+    objdata.insert(objdata.end(), &o.deltadata[0], &o.deltadata[0] + o.deltadata.size());
+    sendDelta = true;
+  } else if (data)
     objdata.insert(objdata.end(), &o.rawdata[0], &o.rawdata[0] + o.rawdata.size());
 
-  uint32_t words[9];
+  uint32_t words[11];
+  uint32_t nwords = (sendDelta ? 11 : 9);
   uint32_t namelen = o.dirname.size() + o.objname.size() + 1;
   uint32_t datalen = objdata.size();
   uint32_t qlen = o.qdata.size();
@@ -403,8 +500,8 @@ void DQMNet::sendObjectToPeer(Bucket *msg, Object &o, bool data) {
   if (o.dirname.empty())
     --namelen;
 
-  words[0] = 9 * sizeof(uint32_t) + namelen + datalen + qlen;
-  words[1] = DQM_REPLY_OBJECT;
+  words[0] = nwords * sizeof(uint32_t) + namelen + datalen + qlen;
+  words[1] = (sendDelta ? DQM_REPLY_OBJECT_DELTA : DQM_REPLY_OBJECT);
   words[2] = flags;
   words[3] = (o.version >> 0) & 0xffffffff;
   words[4] = (o.version >> 32) & 0xffffffff;
@@ -412,9 +509,11 @@ void DQMNet::sendObjectToPeer(Bucket *msg, Object &o, bool data) {
   words[6] = namelen;
   words[7] = datalen;
   words[8] = qlen;
+  words[9] = (o.baseversion >> 0) & 0xffffffff;
+  words[10] = (o.baseversion >> 32) & 0xffffffff;
 
   msg->data.reserve(msg->data.size() + words[0]);
-  copydata(msg, &words[0], 9 * sizeof(uint32_t));
+  copydata(msg, &words[0], nwords * sizeof(uint32_t));
   if (namelen) {
     copydata(msg, &(o.dirname)[0], o.dirname.size());
     if (!o.dirname.empty())
@@ -447,12 +546,26 @@ bool DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len) {
     }
       return true;
 
+    case DQM_MSG_ACCEPT_DELTA: {
+      if (len != 2 * sizeof(uint32_t)) {
+        logme() << "ERROR: corrupt 'ACCEPT_DELTA' message of length " << len << " from peer " << p->peeraddr
+                << std::endl;
+        return false;
+      }
+
+      if (debug_)
+        logme() << "DEBUG: received message 'ACCEPT DELTA' from peer " << p->peeraddr << ", size " << len << std::endl;
+
+      p->delta = true;
+    }
+      return true;
+
     case DQM_MSG_LIST_OBJECTS: {
       if (debug_)
         logme() << "DEBUG: received message 'LIST OBJECTS' from peer " << p->peeraddr << ", size " << len << std::endl;
 
       // Send over current status: list of known objects.
-      sendObjectListToPeer(msg, true, false);
+      sendObjectListToPeer(msg, true, false, false);
     }
       return true;
 
@@ -482,7 +595,7 @@ bool DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len) {
             (o->flags & DQM_PROP_TYPE_MASK) > DQM_PROP_TYPE_SCALAR)
           waitForData(p, name, "", owner);
         else
-          sendObjectToPeer(msg, *o, true);
+          sendObjectToPeer(msg, *o, true, false);
       } else {
         uint32_t words[3];
         words[0] = sizeof(words) + name.size();
@@ -601,6 +714,7 @@ bool DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len) {
       } else if (!o->rawdata.empty())
         o->flags |= DQM_PROP_STALE;
       o->qdata.insert(o->qdata.end(), qdata, enddata);
+      o->deltadata.clear();
 
       // If we had an object for this one already and this is a list
       // update without data, issue an immediate data get request.
@@ -613,6 +727,81 @@ bool DQMNet::onMessage(Bucket *msg, Peer *p, unsigned char *data, size_t len) {
     }
       return true;
 
+    case DQM_REPLY_OBJECT_DELTA: {
+      uint32_t words[11];
+      if (len < sizeof(words)) {
+        logme() << "ERROR: corrupt 'OBJECT DELTA' message of length " << len << " from peer " << p->peeraddr
+                << std::endl;
+        return false;
+      }
+
+      memcpy(&words[0], data, sizeof(words));
+      uint32_t &namelen = words[6];
+      uint32_t &datalen = words[7];
+      uint32_t &qlen = words[8];
+
+      if (len != sizeof(words) + namelen + datalen + qlen) {
+        logme() << "ERROR: corrupt 'OBJECT DELTA' message of length " << len << " from peer " << p->peeraddr
+                << ", expected length " << sizeof(words) << " + " << namelen << " + " << datalen << " + " << qlen
+                << std::endl;
+        return false;
+      }
+
+      unsigned char *namedata = data + sizeof(words);
+      unsigned char *objdata = namedata + namelen;
+      unsigned char *qdata = objdata + datalen;
+      unsigned char *enddata = qdata + qlen;
+      std::string name((char *)namedata, namelen);
+      assert(enddata == data + len);
+
+      if (debug_)
+        logme() << "DEBUG: received message 'OBJECT DELTA " << name << "' from " << p->peeraddr << ", size " << len
+                << std::endl;
+
+      // Mark the peer as a known object source.
+      p->source = true;
+
+      // The changes can only be applied to the data of the version they
+      // were made from.  If we already have the new version, e.g. from a
+      // full object list update, there is nothing to apply.  Otherwise
+      // keep the object stale and fetch the full data.
+      uint64_t version = ((uint64_t)words[4] << 32 | words[3]);
+      uint64_t baseversion = ((uint64_t)words[10] << 32 | words[9]);
+      Object *o = findObject(p, name);
+      if (!o)
+        o = makeObject(p, name);
+
+      bool valid = (!o->rawdata.empty() && !(o->flags & DQM_PROP_STALE));
+      bool current = (valid && o->version == version);
+      bool applied = (valid && !current && o->version == baseversion && applyDelta(o->rawdata, objdata, datalen));
+
+      o->flags = words[2] | DQM_PROP_NEW | DQM_PROP_RECEIVED;
+      o->tag = words[5];
+      o->version = version;
+      o->scalar.clear();
+      o->qdata.clear();
+      o->qdata.insert(o->qdata.end(), qdata, enddata);
+      if (applied) {
+        // Keep the changes to pass them on to our own peers.
+        o->baseversion = baseversion;
+        o->deltadata.clear();
+        o->deltadata.insert(o->deltadata.end(), objdata, qdata);
+      } else if (!current) {
+        o->deltadata.clear();
+        if (!o->rawdata.empty())
+          o->flags |= DQM_PROP_STALE;
+        if (debug_)
+          logme() << "DEBUG: cannot apply changes to '" << name << "' from " << p->peeraddr
+                  << ", requesting the full object" << std::endl;
+        requestObjectData(p, (namelen ? &name[0] : nullptr), namelen);
+      }
+
+      // If we have the object data, release from wait.
+      if (applied || current)
+        releaseWaiters(name, o);
+    }
+      return true;
+
     case DQM_REPLY_NONE: {
       uint32_t words[3];
       if (len < sizeof(words)) {
@@ -834,6 +1023,14 @@ bool DQMNet::onPeerConnect(IOSelectEvent *ev) {
   p->mask = IORead | IOUrgent;
   p->socket = s;
 
+  // Tell the peer we accept delta updates.
+  if (delta_) {
+    uint32_t words[2] = {2 * sizeof(uint32_t), DQM_MSG_ACCEPT_DELTA};
+    p->sendq = new Bucket;
+    p->sendq->next = nullptr;
+    copydata(p->sendq, words, sizeof(words));
+  }
+
   // Report the new connection.
   if (debug_)
     logme() << "INFO: new peer " << p->peeraddr << " is now connected to " << localaddr << std::endl;
@@ -904,6 +1101,7 @@ void DQMNet::updateMask(Peer *p) {
 //////////////////////////////////////////////////////////////////////
 DQMNet::DQMNet(const std::string &appname /* = "" */)
     : debug_(false),
+      delta_(false),
       appname_(appname.empty() ? "DQMNet" : appname.c_str()),
       pid_(getpid()),
       server_(nullptr),
@@ -935,6 +1133,14 @@ DQMNet::~DQMNet() {
 /// calling run() or start().
 void DQMNet::debug(bool doit) { debug_ = doit; }
 
+/// Enable the delta updates.  We then tell our peers that we accept
+/// object updates carrying only the changes since the previous version,
+/// and we send such updates to the peers which accept them.  Peers
+/// running an older version of the protocol drop the connection on
+/// receiving the request, so this should only be enabled when all the
+/// peers support it.  Must be called before calling run() or start().
+void DQMNet::deltaUpdates(bool doit) { delta_ = doit; }
+
 /// Set the I/O dispatching delay.  Must be called before calling
 /// run() or start().
 void DQMNet::delay(int delay) { delay_ = delay; }
@@ -1138,6 +1344,15 @@ void DQMNet::run() {
             p->sendq->next = nullptr;
             copydata(p->sendq, words, sizeof(words));
           }
+          if (delta_) {
+            uint32_t words[2] = {2 * sizeof(uint32_t), DQM_MSG_ACCEPT_DELTA};
+            Bucket **msg = &p->sendq;
+            while (*msg)
+              msg = &(*msg)->next;
+            *msg = new Bucket;
+            (*msg)->next = nullptr;
+            copydata(*msg, words, sizeof(words));
+          }
 
           // Report the new connection.
           if (debug_)
@@ -1228,6 +1443,15 @@ void DQMBasicNet::updateLocalObject(Object &o) {
     std::swap(old.rawdata, o.rawdata);
     std::swap(old.scalar, o.scalar);
     std::swap(old.qdata, o.qdata);
+
+    // Record the changes from the previous version for the peers
+    // which accept delta updates.
+    if (delta_ && makeDelta(old.deltadata, o.rawdata, old.rawdata))
+      old.baseversion = o.version;
+  } else {
+    auto &obj = const_cast<Object &>(*info.first);
+    obj.baseversion = 0;
+    obj.deltadata.clear();
   }
 }
 
@@ -31,11 +31,13 @@ DQMService::DQMService(const edm::ParameterSet &pset, edm::ActivityRegistry &ar)
   std::string host = pset.getUntrackedParameter<std::string>("collectorHost", "");
   int port = pset.getUntrackedParameter<int>("collectorPort", 9090);
   bool verbose = pset.getUntrackedParameter<bool>("verbose", false);
+  bool deltaUpdates = pset.getUntrackedParameter<bool>("deltaUpdates", false);
   publishFrequency_ = pset.getUntrackedParameter<double>("publishFrequency", publishFrequency_);
 
   if (!host.empty() && port > 0) {
     net_ = new DQMBasicNet;
     net_->debug(verbose);
+    net_->deltaUpdates(deltaUpdates);
     net_->updateToCollector(host, port);
     net_->start();
   }
@@ -4,6 +4,7 @@
 #include "DQMServices/Core/interface/LegacyIOHelper.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
 #include <string>
 #include <regex>
 #include <csignal>
@@ -105,6 +106,9 @@ namespace dqm::implementation {
 
       medata.value_.object_ = std::unique_ptr<TH1>(th1);
       MonitorElement* me_ptr = new MonitorElement(std::move(medata));
+      if (store_->sparseHistograms()) {
+        me_ptr->enableSparse();
+      }
       me = store_->putME(me_ptr);
     } else {
       if (forceReplace) {
@@ -169,6 +173,9 @@ namespace dqm::implementation {
     if (existing == localmes.end()) {
       // insert new local ME
       MonitorElement* local_me = new MonitorElement(me);
+      if (doStreamFillBuffers_ && moduleID != 0) {
+        local_me->enableStreamBuffers(nStreams_);
+      }
       auto existing_new = localmes.insert(local_me);
       // successfully inserted, return new object
       assert(existing_new.second == true);  // insert successful
@@ -428,6 +435,9 @@ namespace dqm::implementation {
           newdata.key_.id_ = edm::LuminosityBlockID(run, lumi);
           auto newme = new MonitorElement(std::move(newdata));
           newme->Reset();  // we cloned a ME in use, not an empty prototype
+          if (doSparseHistograms_) {
+            newme->enableSparse();
+          }
           auto result = targetset.insert(newme);
           assert(result.second);  // was new insertion
           target = result.first;  // iterator to new ME
@@ -469,13 +479,25 @@ namespace dqm::implementation {
     for (MonitorElement* me : localset) {
       // we have to be very careful with the ME here, it might not be backed by data at all.
       if (me->isValid() && checkScope(me->getScope()) == true) {
-        // if we left the scope, simply release the data.
+        // if we left the scope, simply release the data, after adding what
+        // is still in the fill buffers.
+        me->mergeStreamBuffers();
         debugTrackME("leaveLumi (release)", me, nullptr);
         me->release(/* expectOwned */ false);
       }
     }
   }
 
+  void DQMStore::mergeStreamBuffers(uint64_t moduleID) {
+    auto lock = std::scoped_lock(this->booking_mutex_);
+    for (MonitorElement* me : this->localMEs_[moduleID]) {
+      if (me->isValid()) {
+        me->mergeStreamBuffers();
+        debugTrackME("mergeStreamBuffers", me, nullptr);
+      }
+    }
+  }
+
   void DQMStore::cleanupLumi(edm::RunNumber_t run, edm::LuminosityBlockNumber_t lumi) {
     // now, we are done with the lumi, no modules have any work to do on these
     // MEs, and the output modules have saved this lumi/run. Remove/recycle
@@ -671,6 +693,10 @@ namespace dqm::implementation {
     assertLegacySafe_ = pset.getUntrackedParameter<bool>("assertLegacySafe", true);
     doSaveByLumi_ = pset.getUntrackedParameter<bool>("saveByLumi", false);
     trackME_ = pset.getUntrackedParameter<std::string>("trackME", "");
+    doStreamFillBuffers_ = pset.getUntrackedParameter<bool>("streamFillBuffers", false);
+    doSparseHistograms_ = pset.getUntrackedParameter<bool>("sparseHistograms", false);
+
+    ar.watchPreallocate([this](edm::service::SystemBounds const& bounds) { nStreams_ = bounds.maxNumberOfStreams(); });
 
     // Set lumi and run for legacy booking.
     // This is no more than a guess with concurrent runs/lumis, but should be
@@ -40,6 +40,17 @@ namespace dqm::impl {
     return h;
   }
 
+  // Any use of the ROOT object beyond filling needs the bins back in it.
+  static TH1 *restoreSparse(std::unique_ptr<SparseBins> &sparse, TH1 *object) {
+    if (sparse) {
+      sparse->restore(object);
+      sparse.reset();
+    }
+    return object;
+  }
+
+  thread_local int MonitorElement::fillStream_ = -1;
+
   MonitorElement::MonitorElement(MonitorElementData &&data) {
     this->mutable_ = new MutableMonitorElementData();
     this->mutable_->data_ = std::move(data);
@@ -56,6 +67,10 @@ namespace dqm::impl {
     out.value_.scalar_ = access.value.scalar_;
     if (access.value.object_) {
       out.value_.object_ = std::unique_ptr<TH1>(static_cast<TH1 *>(access.value.object_->Clone()));
+      // the clone of a sparse ME is an empty shell
+      if (access.sparse) {
+        access.sparse->restore(out.value_.object_.get());
+      }
     }
     return out;
   }
@@ -87,6 +102,58 @@ namespace dqm::impl {
     // Assume kind etc. matches.
     // This should free the old object.
     access.value.object_ = std::move(newobject);
+    access.sparse.reset();
+    if (mutable_->sparseAllowed_) {
+      access.sparse = SparseBins::sparsify(access.value.object_.get());
+    }
+    // the buffers are clones of the old object, possibly with another binning.
+    for (auto &buffer : streamBuffers_) {
+      buffer.reset();
+    }
+  }
+
+  MutableMonitorElementData *MonitorElement::streamBuffer(unsigned int stream) {
+    assert(stream < streamBuffers_.size());
+    auto &buffer = streamBuffers_[stream];
+    if (!buffer) {
+      buffer = std::make_unique<MutableMonitorElementData>();
+      buffer->data_ = cloneMEData();
+      buffer->data_.value_.object_->Reset();
+    }
+    return buffer.get();
+  }
+
+  void MonitorElement::mergeStreamBuffers() {
+    for (auto &buffer : streamBuffers_) {
+      if (!buffer || buffer->data_.value_.object_->GetEntries() == 0) {
+        continue;
+      }
+      auto access = this->accessMut();
+      if (access.sparse) {
+        access.sparse->add(buffer->data_.value_.object_.get());
+      } else {
+        accessRootObject(access, __PRETTY_FUNCTION__, 1)->Add(buffer->data_.value_.object_.get());
+      }
+      buffer->data_.value_.object_->Reset();
+    }
+  }
+
+  void MonitorElement::enableSparse() {
+    auto access = this->accessMut();
+    if (!SparseBins::supports(kind(), access.value.object_.get())) {
+      return;
+    }
+    mutable_->sparseAllowed_ = true;
+    if (!access.sparse) {
+      access.sparse = SparseBins::sparsify(access.value.object_.get());
+    }
+  }
+
+  void MonitorElement::fillSparse(AccessMut &access, double x, double y, double z, double w) {
+    if (!access.sparse->fill(access.value.object_.get(), x, y, z, w)) {
+      // too many bins are filled for the sparse storage to save memory.
+      restoreSparse(access.sparse, access.value.object_.get());
+    }
   }
 
   void MonitorElement::syncCoreObject() {
@@ -200,7 +267,7 @@ namespace dqm::impl {
 
   /// "Fill" ME methods for double
   void MonitorElement::Fill(double x) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
     if (kind() == Kind::INT)
       access.value.scalar_.num = static_cast<int64_t>(x);
@@ -218,7 +285,7 @@ namespace dqm::impl {
 
   /// "Fill" ME method for int64_t
   void MonitorElement::doFill(int64_t x) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
     if (kind() == Kind::INT)
       access.value.scalar_.num = static_cast<int64_t>(x);
@@ -236,9 +303,11 @@ namespace dqm::impl {
 
   /// can be used with 2D (x,y) or 1D (x, w) histograms
   void MonitorElement::Fill(double x, double yw) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
-    if (kind() == Kind::TH1F)
+    if (access.sparse && (kind() == Kind::TH2F || kind() == Kind::TH2S || kind() == Kind::TH2D))
+      fillSparse(access, x, yw, 0., 1.);
+    else if (kind() == Kind::TH1F)
       accessRootObject(access, __PRETTY_FUNCTION__, 1)->Fill(x, yw);
     else if (kind() == Kind::TH1S)
       accessRootObject(access, __PRETTY_FUNCTION__, 1)->Fill(x, yw);
@@ -326,9 +395,13 @@ namespace dqm::impl {
   }
   /// can be used with 3D (x, y, z) or 2D (x, y, w) histograms
   void MonitorElement::Fill(double x, double y, double zw) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
-    if (kind() == Kind::TH2F)
+    if (access.sparse && kind() == Kind::TH3F)
+      fillSparse(access, x, y, zw, 1.);
+    else if (access.sparse)
+      fillSparse(access, x, y, 0., zw);
+    else if (kind() == Kind::TH2F)
       static_cast<TH2F *>(accessRootObject(access, __PRETTY_FUNCTION__, 2))->Fill(x, y, zw);
     else if (kind() == Kind::TH2S)
       static_cast<TH2S *>(accessRootObject(access, __PRETTY_FUNCTION__, 2))->Fill(x, y, zw);
@@ -346,9 +419,11 @@ namespace dqm::impl {
 
   /// can be used with 3D (x, y, z, w) histograms
   void MonitorElement::Fill(double x, double y, double z, double w) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
-    if (kind() == Kind::TH3F)
+    if (access.sparse && kind() == Kind::TH3F)
+      fillSparse(access, x, y, z, w);
+    else if (kind() == Kind::TH3F)
       static_cast<TH3F *>(accessRootObject(access, __PRETTY_FUNCTION__, 2))->Fill(x, y, z, w);
     else if (kind() == Kind::TPROFILE2D)
       static_cast<TProfile2D *>(accessRootObject(access, __PRETTY_FUNCTION__, 2))->Fill(x, y, z, w);
@@ -366,8 +441,13 @@ namespace dqm::impl {
       access.value.scalar_.real = 0;
     else if (kind() == Kind::STRING)
       access.value.scalar_.str.clear();
-    else
-      return accessRootObject(access, __PRETTY_FUNCTION__, 1)->Reset();
+    else if (access.sparse)
+      access.sparse->reset();
+    else {
+      accessRootObject(access, __PRETTY_FUNCTION__, 1)->Reset();
+      if (mutable_->sparseAllowed_)
+        access.sparse = SparseBins::sparsify(access.value.object_.get());
+    }
   }
 
   /// convert scalar data into a string.
@@ -540,7 +620,7 @@ namespace dqm::impl {
                     " element '%s' because it is not a root object",
                     func,
                     data_.objname.c_str());
-    return access.value.object_.get();
+    return restoreSparse(access.sparse, access.value.object_.get());
   }
   TH1 *MonitorElement::accessRootObject(AccessMut const &access, const char *func, int reqdim) const {
     if (kind() < Kind::TH1F)
@@ -549,7 +629,17 @@ namespace dqm::impl {
                     " element '%s' because it is not a root object",
                     func,
                     data_.objname.c_str());
-    return checkRootObject(data_.objname, access.value.object_.get(), func, reqdim);
+    return checkRootObject(data_.objname, restoreSparse(access.sparse, access.value.object_.get()), func, reqdim);
+  }
+
+  TH1 *MonitorElement::accessRootShell(TH1 *object, const char *func) const {
+    if (kind() < Kind::TH1F)
+      raiseDQMError("MonitorElement",
+                    "Method '%s' cannot be invoked on monitor"
+                    " element '%s' because it is not a root object",
+                    func,
+                    data_.objname.c_str());
+    return object;
   }
 
   /*** getter methods (wrapper around ROOT methods) ****/
@@ -582,19 +672,19 @@ namespace dqm::impl {
   /// get # of bins in X-axis
   int MonitorElement::getNbinsX() const {
     auto access = this->access();
-    return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetNbinsX();
+    return accessRootShell(access.value.object_.get(), __PRETTY_FUNCTION__)->GetNbinsX();
   }
 
   /// get # of bins in Y-axis
   int MonitorElement::getNbinsY() const {
     auto access = this->access();
-    return accessRootObject(access, __PRETTY_FUNCTION__, 2)->GetNbinsY();
+    return accessRootShell(access.value.object_.get(), __PRETTY_FUNCTION__)->GetNbinsY();
   }
 
   /// get # of bins in Z-axis
   int MonitorElement::getNbinsZ() const {
     auto access = this->access();
-    return accessRootObject(access, __PRETTY_FUNCTION__, 3)->GetNbinsZ();
+    return accessRootShell(access.value.object_.get(), __PRETTY_FUNCTION__)->GetNbinsZ();
   }
 
   /// get content of bin (1-D)
@@ -661,7 +751,7 @@ namespace dqm::impl {
   /// get MonitorElement title
   std::string MonitorElement::getTitle() const {
     auto access = this->access();
-    return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetTitle();
+    return accessRootShell(access.value.object_.get(), __PRETTY_FUNCTION__)->GetTitle();
   }
 
   /*** setter methods (wrapper around ROOT methods) ****/
@@ -769,11 +859,12 @@ namespace dqm::impl {
   /// set (ie. change) histogram/profile title
   void MonitorElement::setTitle(const std::string &title) {
     auto access = this->accessMut();
-    accessRootObject(access, __PRETTY_FUNCTION__, 1)->SetTitle(title.c_str());
+    accessRootShell(access.value.object_.get(), __PRETTY_FUNCTION__)->SetTitle(title.c_str());
   }
 
   TAxis *MonitorElement::getAxis(AccessMut const &access, const char *func, int axis) const {
-    TH1 *h = accessRootObject(access, func, axis - 1);
+    // the axes are also there while the bins are sparse, no need to restore them.
+    TH1 *h = checkRootObject(data_.objname, access.value.object_.get(), func, axis - 1);
     TAxis *a = nullptr;
     if (axis == 1)
       a = h->GetXaxis();
@@ -794,7 +885,7 @@ namespace dqm::impl {
   }
 
   TAxis const *MonitorElement::getAxis(Access const &access, const char *func, int axis) const {
-    TH1 const *h = accessRootObject(access, func, axis - 1);
+    TH1 const *h = checkRootObject(data_.objname, access.value.object_.get(), func, axis - 1);
     TAxis const *a = nullptr;
     if (axis == 1)
       a = h->GetXaxis();
@@ -828,7 +919,9 @@ namespace dqm::impl {
   void MonitorElement::enableSumw2() {
     auto access = this->accessMut();
     update();
-    if (access.value.object_->GetSumw2() == nullptr) {
+    if (access.sparse) {
+      access.sparse->enableSumw2();
+    } else if (access.value.object_->GetSumw2() == nullptr) {
       access.value.object_->Sumw2();
     }
   }
@@ -857,7 +950,9 @@ namespace dqm::impl {
 
   void MonitorElement::setCanExtend(unsigned int value) {
     auto access = this->accessMut();
-    access.value.object_->SetCanExtend(value);
+    // extending the axes changes the bin numbers, the bins cannot stay sparse.
+    mutable_->sparseAllowed_ = false;
+    restoreSparse(access.sparse, access.value.object_.get())->SetCanExtend(value);
   }
 
   void MonitorElement::setStatOverflows(unsigned int value) {
@@ -916,7 +1011,10 @@ namespace dqm::impl {
   // TODO: all of these are UNSAFE and have to be NON-const.
   TObject const *MonitorElement::getRootObject() const {
     auto access = this->access();
-    return access.value.object_.get();
+    if (!access.value.object_) {
+      return nullptr;
+    }
+    return restoreSparse(access.sparse, access.value.object_.get());
   }
 
   TH1 *MonitorElement::getTH1() {
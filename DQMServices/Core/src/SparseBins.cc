@@ -0,0 +1,146 @@
+#include "DQMServices/Core/interface/SparseBins.h"
+
+#include "TArray.h"
+#include "TArrayD.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace dqm::impl {
+
+  bool SparseBins::supports(MonitorElementData::Kind kind, TH1 const *object) {
+    using Kind = MonitorElementData::Kind;
+    if (kind != Kind::TH2F && kind != Kind::TH2S && kind != Kind::TH2D && kind != Kind::TH3F) {
+      return false;
+    }
+    // extending the axes would change the global bin numbers
+    return object != nullptr && object->CanExtendAllAxes() == false;
+  }
+
+  std::unique_ptr<SparseBins> SparseBins::sparsify(TH1 *object) {
+    // the constructor is private, so no make_unique
+    std::unique_ptr<SparseBins> sparse(new SparseBins());
+    sparse->sumw2_ = object->GetSumw2N() > 0;
+    for (int bin = 0; bin < object->GetNcells(); ++bin) {
+      double sumw = object->GetBinContent(bin);
+      double sumw2 = sparse->sumw2_ ? object->GetSumw2()->At(bin) : 0.;
+      if (sumw != 0. || sumw2 != 0.) {
+        sparse->bins_[bin] = Bin{sumw, sumw2};
+      }
+    }
+    object->GetStats(sparse->stats_);
+    sparse->entries_ = object->GetEntries();
+
+    // free the bin arrays. This has to leave the statistics at zero: with
+    // entries but no sum of weights, ROOT would recompute them from the bins.
+    double zeros[TH1::kNstat] = {};
+    object->PutStats(zeros);
+    object->SetEntries(0);
+    auto array = dynamic_cast<TArray *>(object);
+    assert(array);
+    array->Set(0);
+    if (sparse->sumw2_) {
+      object->GetSumw2()->Set(0);
+    }
+    return sparse;
+  }
+
+  void SparseBins::restore(TH1 *object) const {
+    auto array = dynamic_cast<TArray *>(object);
+    assert(array);
+    // Set() fills the new arrays with zeros
+    array->Set(object->GetNcells());
+    if (sumw2_) {
+      object->GetSumw2()->Set(object->GetNcells());
+    }
+    for (auto const &[bin, content] : bins_) {
+      object->AddBinContent(bin, content.sumw);
+      if (sumw2_) {
+        (*object->GetSumw2())[bin] += content.sumw2;
+      }
+    }
+    // PutStats takes a non-const pointer
+    double stats[TH1::kNstat];
+    std::copy(std::begin(stats_), std::end(stats_), std::begin(stats));
+    object->PutStats(stats);
+    object->SetEntries(entries_);
+  }
+
+  bool SparseBins::fill(TH1 *object, double x, double y, double z, double w) {
+    bool is3D = object->GetDimension() == 3;
+    int binx = object->GetXaxis()->FindFixBin(x);
+    int biny = object->GetYaxis()->FindFixBin(y);
+    int binz = is3D ? object->GetZaxis()->FindFixBin(z) : 0;
+
+    entries_ += 1.;
+    if (!sumw2_ && w != 1. && !object->TestBit(TH1::kIsNotW)) {
+      enableSumw2();
+    }
+    auto &content = bins_[object->GetBin(binx, biny, binz)];
+    content.sumw += w;
+    if (sumw2_) {
+      content.sumw2 += w * w;
+    }
+
+    bool inRange = binx > 0 && binx <= object->GetNbinsX() && biny > 0 && biny <= object->GetNbinsY();
+    if (is3D) {
+      inRange = inRange && binz > 0 && binz <= object->GetNbinsZ();
+    }
+    if (inRange || object->GetStatOverflowsBehaviour()) {
+      // same order as TH2::GetStats and TH3::GetStats
+      stats_[0] += w;
+      stats_[1] += w * w;
+      stats_[2] += w * x;
+      stats_[3] += w * x * x;
+      stats_[4] += w * y;
+      stats_[5] += w * y * y;
+      stats_[6] += w * x * y;
+      if (is3D) {
+        stats_[7] += w * z;
+        stats_[8] += w * z * z;
+        stats_[9] += w * x * z;
+        stats_[10] += w * y * z;
+      }
+    }
+
+    return bins_.size() * kMaxFilledFraction <= size_t(object->GetNcells());
+  }
+
+  void SparseBins::add(TH1 const *other) {
+    bool otherSumw2 = other->GetSumw2N() > 0;
+    if (otherSumw2 && !sumw2_) {
+      enableSumw2();
+    }
+    for (int bin = 0; bin < other->GetNcells(); ++bin) {
+      double sumw = other->GetBinContent(bin);
+      double sumw2 = otherSumw2 ? other->GetSumw2()->At(bin) : std::abs(sumw);
+      if (sumw != 0. || sumw2 != 0.) {
+        auto &content = bins_[bin];
+        content.sumw += sumw;
+        content.sumw2 += sumw2;
+      }
+    }
+    double stats[TH1::kNstat] = {};
+    other->GetStats(stats);
+    for (int i = 0; i < TH1::kNstat; ++i) {
+      stats_[i] += stats[i];
+    }
+    entries_ += other->GetEntries();
+  }
+
+  void SparseBins::reset() {
+    bins_.clear();
+    std::fill(std::begin(stats_), std::end(stats_), 0.);
+    entries_ = 0.;
+  }
+
+  void SparseBins::enableSumw2() {
+    // like TH1::Sumw2(), the existing contents count as unweighted fills
+    for (auto &[bin, content] : bins_) {
+      content.sumw2 = std::abs(content.sumw);
+    }
+    sumw2_ = true;
+  }
+
+}  // namespace dqm::impl
@@ -0,0 +1,152 @@
+// Replays a stream of histogram updates through the DQMNet delta
+// encoding and compares the transferred size with sending the full
+// objects.  The update stream is recorded first, by filling the
+// histograms in steps and serialising them after each step the same
+// way DQMService does.  The histograms are either a built-in set or,
+// if a ROOT file is given, all the histograms found in that file, in
+// which case they are refilled following their original distribution.
+//
+//   DQMNetDeltaBenchmark [file.root [steps [fills per step]]]
+
+#include "DQMServices/Core/interface/DQMNet.h"
+
+#include "TBufferFile.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TH1F.h"
+#include "TH2F.h"
+#include "TKey.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  void collect(TDirectory *dir, std::vector<std::unique_ptr<TH1>> &hists) {
+    TIter next(dir->GetListOfKeys());
+    while (auto *key = static_cast<TKey *>(next())) {
+      TObject *obj = key->ReadObj();
+      if (auto *subdir = dynamic_cast<TDirectory *>(obj))
+        collect(subdir, hists);
+      else if (auto *h = dynamic_cast<TH1 *>(obj)) {
+        h->SetDirectory(nullptr);
+        hists.emplace_back(h);
+      }
+    }
+  }
+
+  DQMNet::DataBlob serialise(TH1 *h) {
+    TBufferFile buffer(TBufferFile::kWrite);
+    buffer.WriteObject(h);
+    buffer.WriteObjectAny(nullptr, nullptr);
+    return DQMNet::DataBlob(buffer.Buffer(), buffer.Buffer() + buffer.Length());
+  }
+
+  void fill(TH1 *h, TH1 *shape, TRandom &rnd) {
+    if (auto *h2 = dynamic_cast<TH2 *>(h)) {
+      double x, y;
+      if (shape && shape->GetEntries() > 0)
+        static_cast<TH2 *>(shape)->GetRandom2(x, y);
+      else {
+        x = rnd.Gaus(0, 1);
+        y = rnd.Gaus(0, 1);
+      }
+      h2->Fill(x, y);
+    } else if (auto *p = dynamic_cast<TProfile *>(h)) {
+      double x = (shape && shape->GetEntries() > 0 ? shape->GetRandom() : rnd.Uniform(-3, 3));
+      p->Fill(x, rnd.Gaus(x, 1));
+    } else {
+      h->Fill(shape && shape->GetEntries() > 0 ? shape->GetRandom() : rnd.Gaus(0, 1));
+    }
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  int steps = (argc > 2 ? atoi(argv[2]) : 100);
+  int fills = (argc > 3 ? atoi(argv[3]) : 50);
+
+  std::vector<std::unique_ptr<TH1>> shapes;
+  if (argc > 1 && *argv[1]) {
+    std::unique_ptr<TFile> file(TFile::Open(argv[1]));
+    if (!file || file->IsZombie()) {
+      std::cerr << "cannot open " << argv[1] << std::endl;
+      return 1;
+    }
+    collect(file.get(), shapes);
+  } else {
+    shapes.emplace_back(new TH1F("h1", "TH1F", 100, -3, 3));
+    shapes.emplace_back(new TH1F("h1fine", "TH1F", 5000, -3, 3));
+    shapes.emplace_back(new TH2F("h2", "TH2F", 100, -3, 3, 100, -3, 3));
+    shapes.emplace_back(new TProfile("prof", "TProfile", 100, -3, 3));
+    for (auto &h : shapes)
+      h->SetDirectory(nullptr);
+  }
+
+  // Record the update stream.
+  TRandom3 rnd(12345);
+  std::vector<std::vector<DQMNet::DataBlob>> stream(shapes.size());
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    std::unique_ptr<TH1> h(static_cast<TH1 *>(shapes[i]->Clone()));
+    h->SetDirectory(nullptr);
+    h->Reset();
+    bool fromShape = (argc > 1 && *argv[1]);
+    for (int step = 0; step < steps; ++step) {
+      for (int n = 0; n < fills; ++n)
+        fill(h.get(), fromShape ? shapes[i].get() : nullptr, rnd);
+      stream[i].push_back(serialise(h.get()));
+    }
+  }
+
+  // Replay it, sending each version as changes to the previous one
+  // whenever possible, and check the receiver rebuilds every version.
+  size_t fullBytes = 0;
+  size_t sentBytes = 0;
+  size_t deltas = 0;
+  size_t updates = 0;
+  Clock::duration encodeTime{0};
+  Clock::duration decodeTime{0};
+  for (auto const &versions : stream) {
+    DQMNet::DataBlob received;
+    for (size_t v = 0; v < versions.size(); ++v, ++updates) {
+      DQMNet::DataBlob delta;
+      auto start = Clock::now();
+      bool ok = (v > 0 && DQMNet::makeDelta(delta, versions[v - 1], versions[v]));
+      encodeTime += Clock::now() - start;
+
+      fullBytes += versions[v].size();
+      if (ok) {
+        start = Clock::now();
+        if (!DQMNet::applyDelta(received, delta.data(), delta.size())) {
+          std::cerr << "failed to apply the changes of version " << v << std::endl;
+          return 1;
+        }
+        decodeTime += Clock::now() - start;
+        sentBytes += delta.size();
+        ++deltas;
+      } else {
+        received = versions[v];
+        sentBytes += versions[v].size();
+      }
+
+      if (received != versions[v]) {
+        std::cerr << "version " << v << " was not rebuilt correctly" << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  std::cout << "objects: " << shapes.size() << ", updates: " << updates << ", sent as changes: " << deltas << "\n"
+            << "full objects: " << fullBytes << " bytes, sent: " << sentBytes << " bytes ("
+            << (fullBytes ? 100. * sentBytes / fullBytes : 0.) << "%)\n"
+            << "encoding: " << duration_cast<microseconds>(encodeTime).count() << " us, decoding: "
+            << duration_cast<microseconds>(decodeTime).count() << " us" << std::endl;
+  return 0;
+}
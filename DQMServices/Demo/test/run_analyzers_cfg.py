@@ -40,6 +40,8 @@ parser.register('numberEventsInLuminosityBlock', 20, one, int, "See EmptySource.
 parser.register('nEvents',              100, one, int, "Total number of events.")
 parser.register('nThreads',             1, one, int, "Number of threads and streams.")
 parser.register('nConcurrent',          1, one, int, "Number of concurrent runs/lumis.")
+parser.register('streamFillBuffers',    False, one, bool, "Fill the MEs of global modules in per-stream buffers.")
+parser.register('sparseHistograms',     False, one, bool, "Store the bins of 2D and 3D histograms sparsely.")
 parser.register('howmany',              1, one, int, "Number of MEs to book of each type.")
 parser.register('outfile',              "dqm.root", one, string, "Output file name.")
 parser.parseArguments()
@@ -65,6 +67,12 @@ process.options = cms.untracked.PSet(
 if args.nConcurrent > 1:
   process.DQMStore.assertLegacySafe = cms.untracked.bool(False)
 
+if args.streamFillBuffers:
+  process.DQMStore.streamFillBuffers = cms.untracked.bool(True)
+
+if args.sparseHistograms:
+  process.DQMStore.sparseHistograms = cms.untracked.bool(True)
+
 for mod in [process.test, process.testglobal, process.testone, process.testonefillrun, process.testonelumi, process.testonelumifilllumi, process.testlegacy, process.testlegacyfillrun, process.testlegacyfilllumi]:
   mod.howmany = args.howmany
 
@@ -34,13 +34,17 @@ cmsRun $LOCAL_TEST_DIR/run_analyzers_cfg.py outfile=alltypes.root numberEventsIn
 # 2. Run multi-threaded. First we make a baseline file without legacy modules, since they might not work.
 cmsRun $LOCAL_TEST_DIR/run_analyzers_cfg.py outfile=nolegacy.root    numberEventsInRun=1000 numberEventsInLuminosityBlock=200 nEvents=1000 nolegacy=True
 cmsRun $LOCAL_TEST_DIR/run_analyzers_cfg.py outfile=nolegacy-mt.root numberEventsInRun=1000 numberEventsInLuminosityBlock=200 nEvents=1000 nolegacy=True nThreads=10
+# the same, with the global modules filling per-stream buffers.
+cmsRun $LOCAL_TEST_DIR/run_analyzers_cfg.py outfile=nolegacy-sb.root numberEventsInRun=1000 numberEventsInLuminosityBlock=200 nEvents=1000 nolegacy=True nThreads=10 streamFillBuffers=True
+# and with sparse 2D and 3D histograms.
+cmsRun $LOCAL_TEST_DIR/run_analyzers_cfg.py outfile=nolegacy-sp.root numberEventsInRun=1000 numberEventsInLuminosityBlock=200 nEvents=1000 nolegacy=True nThreads=10 sparseHistograms=True streamFillBuffers=True
 
 
 # 3. Try enabling concurrent lumis.
 cmsRun $LOCAL_TEST_DIR/run_analyzers_cfg.py outfile=nolegacy-cl.root numberEventsInRun=1000 numberEventsInLuminosityBlock=200 nEvents=1000 nolegacy=True nThreads=10 nConcurrent=10
 
 # same math as above, just a few less modules, and more events.
-for f in nolegacy.root nolegacy-mt.root nolegacy-cl.root
+for f in nolegacy.root nolegacy-mt.root nolegacy-sb.root nolegacy-sp.root nolegacy-cl.root
 do
   [ "0: 1, 0.0: 1, 1: 9, 1000: 27, 5: 3, 5.0: 3" = "$($LOCAL_TEST_DIR/dqmiodumpentries.py $f -r 1 --summary)" ]
   [ "1: 1, 1.0: 1, 200: 9" = "$($LOCAL_TEST_DIR/dqmiodumpentries.py $f -r 1 -l 1 --summary)" ]
@@ -210,8 +210,13 @@ void DQMFileSaverPB::savePB(DQMStore* store, std::string const& filename, int ru
   // TODO: while we still have enableMultiThread, maybe this does the wrong thing.
   // We save all histograms, indifferent of the lumi flag: even tough we save per lumi, this is a *snapshot*.
   auto mes = store->getAllContents("");
+  dqmstore_message.mutable_histo()->Reserve(mes.size());
+  // one buffer for all the MEs, grown once to the size of the largest one, and emptied before
+  // each of them: its map of the objects written is reset too, so each ME is streamed on its own
+  TBufferFile buffer(TBufferFile::kWrite);
   for (auto const me : mes) {
-    TBufferFile buffer(TBufferFile::kWrite);
+    buffer.Reset();
+    buffer.ResetMap();
     if (me->kind() < MonitorElement::Kind::TH1F) {
       TObjString object(me->tagString().c_str());
       buffer.WriteObject(&object);
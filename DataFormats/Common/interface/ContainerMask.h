@@ -51,6 +51,7 @@ namespace edm {
     void copyMaskTo(std::vector<bool>&) const;
 
     size_t size() const { return m_mask.size(); }
+    const std::vector<bool>& maskVector() const { return m_mask; }
 
     const edm::RefProd<T>& refProd() const { return m_prod; }
     // ---------- static member functions --------------------
@@ -93,6 +93,7 @@ namespace edm {
       m_data.resize(isize * m_stride);
     }
 
+    // a no-op if already sorted
     void sort();
 
     // FIXME not sure what the best way to add one cell to cont
@@ -102,6 +103,12 @@ namespace edm {
       m_data.resize(m_data.size() + m_stride);
       std::copy(idata, idata + m_stride, m_data.begin() + cs);
     }
+    // n cells at once, the data of each one stride after the previous one: filled in the order of the ids, the
+    // container does not need to be sorted afterwards
+    void push_back(id_type const* iids, data_type const* idata, size_t n) {
+      m_ids.insert(m_ids.end(), iids, iids + n);
+      m_data.insert(m_data.end(), idata, idata + n * m_stride);
+    }
     //make space for it
     void push_back(id_type iid) {
       m_ids.push_back(iid);
@@ -15,6 +15,11 @@
 // #warning using atomic
 #endif
 
+#ifdef DSVN_USE_ATOMIC
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#endif
+
 #include <atomic>
 #include <memory>
 #include <vector>
@@ -58,6 +63,11 @@ namespace edmNew {
     void errorIdExists(det_id_type iid);
     void throw_range(det_id_type iid);
 
+    // blocks until the offset of a DetSet being filled by another thread is set, and wakes up the threads
+    // blocked on the DetSets once one is set
+    void waitFilled(std::atomic<int> const& offset);
+    void notifyFilled();
+
     struct DetSetVectorTrans {
       typedef unsigned int size_type;  // for persistency
       typedef unsigned int id_type;
@@ -370,6 +380,7 @@ namespace edmNew {
         m_v.m_dataSize = m_v.m_data.size();
         assert(m_v.m_filling == true);
         m_v.m_filling = false;
+        dstvdetails::notifyFilled();
       }
 
 #endif
@@ -587,6 +598,11 @@ namespace edmNew {
                    boost::make_transform_iterator(p.second, IterHelp(*this, update)));
     }
 
+    // fills, in parallel tasks, the DetSets of an on-demand container with the given ids, for the consumers
+    // knowing ahead of time which ones they will read (e.g. those of their tracking regions); the ids not in
+    // the container, and the DetSets already filled or being filled, are skipped
+    void prefetch(std::vector<id_type> const& ids) const;
+
     int subdetId() const { return m_subdetId; }
 
     bool empty() const { return m_ids.empty(); }
@@ -675,6 +691,23 @@ namespace edmNew {
       assert(item.isValid());
     }
   }
+
+  template <typename T>
+  inline void DetSetVector<T>::prefetch(std::vector<id_type> const& ids) const {
+    if (!onDemand())
+      return;
+    std::vector<Item const*> items;
+    items.reserve(ids.size());
+    for (auto id : ids) {
+      const_IdIter p = findItem(id);
+      if (p != m_ids.end() && p->uninitialized())
+        items.push_back(&(*p));
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, items.size()), [this, &items](tbb::blocked_range<size_t> const& r) {
+      for (size_t i = r.begin(); i != r.end(); ++i)
+        update(*items[i]);
+    });
+  }
 #endif
 
 #ifdef DSVN_USE_ATOMIC
@@ -683,8 +716,8 @@ namespace edmNew {
     // if an item is being updated we wait
     if (update)
       icont.update(item);
-    while (item.initializing())
-      nanosleep(nullptr, nullptr);
+    if (item.initializing())
+      dstvdetails::waitFilled(item.offset);
     m_data = &icont.data();
     m_id = item.id;
     m_offset = item.offset;
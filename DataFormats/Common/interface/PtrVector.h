@@ -144,6 +144,11 @@ namespace edm {
     const_iterator begin() const { return const_iterator(this->void_begin(), this); }
 
     const_iterator end() const { return const_iterator(this->void_end(), this); }
+
+    /// Fills members with the addresses of the elements, getting the product once for all of them;
+    /// throws, as the dereference of the element does, if an element is not available
+    void getMembers(std::vector<T const*>& members) const;
+
     // ---------- member functions ---------------------------
 
     void push_back(Ptr<T> const& iPtr) {
@@ -181,6 +186,17 @@ namespace edm {
     Ptr<T> fromItr(std::vector<void const*>::const_iterator const& iItr) const { return this->makePtr<Ptr<T> >(iItr); }
   };
 
+  template <typename T>
+  void PtrVector<T>::getMembers(std::vector<T const*>& members) const {
+    members.clear();
+    members.reserve(this->size());
+    unsigned long index = 0;
+    for (auto it = this->void_begin(), itEnd = this->void_end(); it != itEnd; ++it, ++index) {
+      T const* member = reinterpret_cast<T const*>(*it);
+      members.push_back(member != nullptr ? member : (*this)[index].get());
+    }
+  }
+
   template <typename T>
   void PtrVector<T>::fillView(std::vector<void const*>& pointers, FillViewHelperVector& helpers) const {
     pointers.reserve(this->size());
@@ -95,6 +95,10 @@ namespace edm {
     /// Accessor for all data
     contents_type const& refVector() const { return refVector_; }
 
+    /// Fills members with the addresses of the referenced elements, getting the product once for all of them
+    /// instead of once per element; throws, as the dereference of the element does, if an element is not available
+    void getMembers(std::vector<member_type const*>& members) const;
+
     /// Is the RefVector empty
     bool empty() const { return refVector_.empty(); }
 
@@ -173,6 +177,29 @@ namespace edm {
     a.swap(b);
   }
 
+  template <typename C, typename T, typename F>
+  void RefVector<C, T, F>::getMembers(std::vector<member_type const*>& members) const {
+    members.clear();
+    members.reserve(this->size());
+    RefCore const& core = refVector_.refCore();
+    C const* product = nullptr;
+    bool productLookedUp = false;
+    F finder;
+    for (size_type i = 0, n = this->size(); i < n; ++i) {
+      void const* memberPointer = refVector_.cachedMemberPointer(i);
+      if (memberPointer) {
+        members.push_back(static_cast<member_type const*>(memberPointer));
+        continue;
+      }
+      if (!productLookedUp && !core.isTransient() && core.productGetter() != nullptr) {
+        product = tryToGetProductWithCoreFromRef<C>(core, core.productGetter());
+        productLookedUp = true;
+      }
+      // the elements of a thinned collection, or without product getter, are resolved one by one
+      members.push_back(product != nullptr ? finder(*product, refVector_.keys()[i]) : (*this)[i].get());
+    }
+  }
+
   template <typename C, typename T, typename F>
   void RefVector<C, T, F>::fillView(ProductID const&,
                                     std::vector<void const*>& pointers,
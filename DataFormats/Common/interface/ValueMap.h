@@ -58,8 +58,20 @@ namespace edm {
         typename value_map::const_iterator f = values_.find(id);
         if (f != values_.end())
           throwFillID(id);
-        value_vector& values = values_.insert(make_pair(id, value_vector(size))).first->second;
-        std::copy(begin, end, values.begin());
+        values_.insert(make_pair(id, value_vector(begin, end)));
+        totSize_ += size;
+      }
+      // takes over the values, e.g. those computed in parallel each into its own element of a vector
+      template <typename H>
+      void insert(const H& h, value_vector&& values) {
+        ProductID id = h.id();
+        size_t size = h->size();
+        if (values.size() != size)
+          throwFillSize();
+        typename value_map::const_iterator f = values_.find(id);
+        if (f != values_.end())
+          throwFillID(id);
+        values_.insert(make_pair(id, std::move(values)));
         totSize_ += size;
       }
       void fill() {
@@ -71,10 +83,8 @@ namespace edm {
           ProductID id = i->first;
           map_.ids_.push_back(std::make_pair(id, off));
           const value_vector& values = i->second;
-          for (typename value_vector::const_iterator j = values.begin(); j != values.end(); ++j) {
-            map_.values_.push_back(*j);
-            ++off;
-          }
+          map_.values_.insert(map_.values_.end(), values.begin(), values.end());
+          off += values.size();
         }
         map_.shrink_to_fit();
       }
@@ -228,6 +238,9 @@ namespace edm {
 
     const_iterator begin() const { return const_iterator(ids_.begin(), ids_.end(), &values_); }
     const_iterator end() const { return const_iterator(ids_.end(), ids_.end(), &values_); }
+    /// the values of a product, end() if there are none: for the loops over a whole collection, which then look
+    /// up the product once, and index the values with the keys
+    const_iterator find(ProductID id) const { return const_iterator(getIdOffset(id), ids_.end(), &values_); }
 
     /// meant to be used in AssociativeIterator, not by the ordinary user
     const id_offset_vector& ids() const { return ids_; }
@@ -242,6 +255,13 @@ namespace edm {
     id_offset_vector ids_;
 
     typename id_offset_vector::const_iterator getIdOffset(ProductID id) const {
+      // the maps are mostly for one or a few products, for which a scan beats the binary search
+      if (ids_.size() <= kMaxIdsToScan) {
+        typename id_offset_vector::const_iterator i = ids_.begin();
+        while (i != ids_.end() && i->first != id)
+          ++i;
+        return i;
+      }
       typename id_offset_vector::const_iterator i = std::lower_bound(ids_.begin(), ids_.end(), id, IDComparator());
       if (i == ids_.end())
         return i;
@@ -253,6 +273,8 @@ namespace edm {
     }
 
   private:
+    static constexpr size_t kMaxIdsToScan = 8;
+
     struct IDComparator {
       bool operator()(const std::pair<ProductID, offset>& p, const ProductID& id) { return p.first < id; }
     };
@@ -17,7 +17,7 @@ namespace edm {
   }  // namespace
 
   void DataFrameContainer::sort() {
-    if (size() < 2)
+    if (size() < 2 || std::is_sorted(m_ids.begin(), m_ids.end()))
       return;
     std::vector<int> indices(size(), 1);
     indices[0] = 0;
@@ -1,6 +1,16 @@
 #include "DataFormats/Common/interface/DetSetVectorNew.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
+#include <condition_variable>
+#include <mutex>
+
+namespace {
+  // shared by all the containers: a DetSet is rarely waited for, only when read while another thread fills it
+  std::mutex fillMutex;
+  std::condition_variable fillCondition;
+  std::atomic<int> nWaiting{0};
+}  // namespace
+
 namespace edmNew {
   namespace dstvdetails {
     void errorFilling() {
@@ -25,5 +35,20 @@ namespace edmNew {
           << "index value: " << iid;
     }
 
+    void waitFilled(std::atomic<int> const& offset) {
+      std::unique_lock<std::mutex> lock(fillMutex);
+      ++nWaiting;
+      fillCondition.wait(lock, [&offset] { return offset != -2; });
+      --nWaiting;
+    }
+
+    void notifyFilled() {
+      // the offset is set before, so that either the waiting thread sees it, or it is counted here
+      if (nWaiting == 0)
+        return;
+      { std::lock_guard<std::mutex> lock(fillMutex); }
+      fillCondition.notify_all();
+    }
+
   }  // namespace dstvdetails
 }  // namespace edmNew
@@ -15,6 +15,7 @@ class TestDataFrame : public CppUnit::TestFixture {
   CPPUNIT_TEST(filling);
   CPPUNIT_TEST(iterator);
   CPPUNIT_TEST(sort);
+  CPPUNIT_TEST(bulkFilling);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -28,6 +29,7 @@ public:
   void filling();
   void iterator();
   void sort();
+  void bulkFilling();
 
 public:
   std::vector<edm::DataFrame::data_type> sv1;
@@ -134,3 +136,25 @@ void TestDataFrame::sort() {
   frames.sort();
   CPPUNIT_ASSERT(std::for_each(frames.begin(), frames.end(), VerifyIter(this)).n == 100);
 }
+
+void TestDataFrame::bulkFilling() {
+  edm::DataFrameContainer frames(10, 2);
+  frames.push_back(2001);
+  std::copy(sv2.begin(), sv2.end(), frames.back().begin());
+
+  std::vector<unsigned int> ids = {2002, 2003, 2004};
+  std::vector<edm::DataFrame::data_type> data;
+  data.insert(data.end(), sv1.begin(), sv1.end());
+  data.insert(data.end(), sv2.begin(), sv2.end());
+  data.insert(data.end(), sv1.begin(), sv1.end());
+  frames.push_back(ids.data(), data.data(), ids.size());
+  CPPUNIT_ASSERT(frames.size() == 4);
+  CPPUNIT_ASSERT(frames.m_data.size() == 40);
+  CPPUNIT_ASSERT(std::for_each(frames.begin(), frames.end(), VerifyIter(this)).n == 4);
+
+  // already sorted: left as is
+  std::vector<edm::DataFrame::data_type> const before = frames.m_data;
+  frames.sort();
+  CPPUNIT_ASSERT(frames.m_data == before);
+  CPPUNIT_ASSERT((*frames.find(2003)).id() == 2003);
+}
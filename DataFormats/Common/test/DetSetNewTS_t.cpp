@@ -96,6 +96,7 @@ class TestDetSet : public CppUnit::TestFixture {
   CPPUNIT_TEST(infrastructure);
   CPPUNIT_TEST(fillSeq);
   CPPUNIT_TEST(fillPar);
+  CPPUNIT_TEST(prefetch);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -108,6 +109,7 @@ public:
   void infrastructure();
   void fillSeq();
   void fillPar();
+  void prefetch();
 
 public:
   int nth = 1;
@@ -303,3 +305,58 @@ void TestDetSet::fillPar() {
   CPPUNIT_ASSERT(int(g.ntot) == maxDet);
   CPPUNIT_ASSERT(int(detsets.size()) == maxDet);
 }
+
+void TestDetSet::prefetch() {
+  auto pg = std::make_shared<Getter>(this);
+  Getter& g = *pg;
+  int maxDet = 100 * nth;
+  std::vector<unsigned int> v(maxDet);
+  int k = 20;
+  for (auto& i : v)
+    i = k++;
+  DSTV detsets(pg, v, 2);
+  detsets.reserve(maxDet, 100 * maxDet);
+  CPPUNIT_ASSERT(detsets.onDemand());
+
+  // one DetSet in three, one id not in the container, and one repeated id
+  std::vector<unsigned int> ids;
+  for (int i = 0; i < maxDet; i += 3)
+    ids.push_back(20 + i);
+  ids.push_back(20 + maxDet);
+  ids.push_back(20);
+  int nPrefetched = (maxDet + 2) / 3;
+
+  // readers of the prefetched DetSets while they are filled
+  std::atomic<int> lock(0);
+  parallel_run([&lock, &detsets, &ids, nPrefetched](unsigned int threadNumber, unsigned int numberOfThreads) {
+    sync(lock, numberOfThreads);
+    if (threadNumber == 0) {
+      detsets.prefetch(ids);
+      return;
+    }
+    for (int i = threadNumber; i < nPrefetched; i += numberOfThreads) {
+      unsigned int id = ids[i];
+      DST df = *detsets.find(id, true);
+      CPPUNIT_ASSERT(df.id() == id);
+      CPPUNIT_ASSERT(df.size() == 2);
+      CPPUNIT_ASSERT(df[0] == int(100 * (id - 20) + 3));
+    }
+  });
+
+  CPPUNIT_ASSERT(int(g.ntot) == nPrefetched);
+  for (int i = 0; i < maxDet; ++i) {
+    unsigned int id = 20 + i;
+    CPPUNIT_ASSERT(detsets.isValid(id) == (i % 3 == 0));
+  }
+  for (int i = 0; i < nPrefetched; ++i) {
+    unsigned int id = ids[i];
+    DST df = *detsets.find(id);
+    CPPUNIT_ASSERT(df.size() == 2);
+    CPPUNIT_ASSERT(df[0] == int(100 * (id - 20) + 3));
+    CPPUNIT_ASSERT(df[1] == -int(100 * (id - 20) + 3));
+  }
+
+  // prefetching again fills nothing
+  detsets.prefetch(ids);
+  CPPUNIT_ASSERT(int(g.ntot) == nPrefetched);
+}
@@ -177,6 +177,12 @@ void testPtrVector::get() {
   CPPUNIT_ASSERT((*(*(iVec.begin()))).value_ == 0);
   std::cerr << "pre value ->" << std::endl;
   CPPUNIT_ASSERT((*(iVec.begin()))->value_ == 0);
+
+  std::vector<IntValue const*> members;
+  iVec.getMembers(members);
+  CPPUNIT_ASSERT(members.size() == 2);
+  CPPUNIT_ASSERT(members[0] == &(*wptr)[0]);
+  CPPUNIT_ASSERT(members[1] == &(*wptr)[2]);
   std::cerr << "post everything" << std::endl;
 
   /*
@@ -13,6 +13,7 @@
 
 #include "DataFormats/Common/interface/Ref.h"
 #include "DataFormats/Common/interface/RefProd.h"
+#include "DataFormats/Common/interface/RefVector.h"
 #include "DataFormats/Common/interface/RefToBaseProd.h"
 #include <iostream>
 using namespace edm;
@@ -23,6 +24,7 @@ class testRef : public CppUnit::TestFixture {
   CPPUNIT_TEST(constructTest);
   CPPUNIT_TEST(comparisonTest);
   CPPUNIT_TEST(getTest);
+  CPPUNIT_TEST(getMembersTest);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -33,6 +35,7 @@ public:
   void constructTest();
   void comparisonTest();
   void getTest();
+  void getMembersTest();
 };
 
 ///registration of the test so that the runner can find it
@@ -178,7 +181,11 @@ void testRef::comparisonTest() {
 namespace {
   struct TestGetter : public edm::EDProductGetter {
     WrapperBase const* hold_;
-    virtual WrapperBase const* getIt(ProductID const&) const override { return hold_; }
+    mutable unsigned int nGets_;
+    virtual WrapperBase const* getIt(ProductID const&) const override {
+      ++nGets_;
+      return hold_;
+    }
 
     virtual WrapperBase const* getThinnedProduct(ProductID const&, unsigned int&) const override { return nullptr; }
 
@@ -187,7 +194,7 @@ namespace {
                                     std::vector<unsigned int>& keys) const override {}
 
     virtual unsigned int transitionIndex_() const override { return 0U; }
-    TestGetter() : hold_(nullptr) {}
+    TestGetter() : hold_(nullptr), nGets_(0) {}
   };
 
   struct IntValue {
@@ -254,3 +261,38 @@ void testRef::getTest() {
   CPPUNIT_ASSERT(vw[1].value_ == ref1->value_);
   //std::cerr << ">>> RefToBaseProd from View" << std::endl;
 }
+
+void testRef::getMembersTest() {
+  typedef std::vector<IntValue> IntCollection;
+  auto ptr = std::make_unique<IntCollection>();
+
+  ptr->push_back(0);
+  ptr->push_back(1);
+  ptr->push_back(2);
+
+  edm::Wrapper<IntCollection> wrapper(std::move(ptr));
+  TestGetter tester;
+  tester.hold_ = &wrapper;
+
+  ProductID const pid(1, 1);
+
+  IntCollection const* wptr = reinterpret_cast<IntCollection const*>(wrapper.product());
+
+  RefVector<IntCollection> refVector;
+  refVector.push_back(Ref<IntCollection>(pid, 2, &tester));
+  refVector.push_back(Ref<IntCollection>(pid, 0, &tester));
+  refVector.push_back(Ref<IntCollection>(pid, 2, &tester));
+
+  std::vector<IntValue const*> members;
+  refVector.getMembers(members);
+  CPPUNIT_ASSERT(members.size() == 3);
+  CPPUNIT_ASSERT(members[0] == &(*wptr)[2]);
+  CPPUNIT_ASSERT(members[1] == &(*wptr)[0]);
+  CPPUNIT_ASSERT(members[2] == &(*wptr)[2]);
+  // the product is looked up once for all the elements
+  CPPUNIT_ASSERT(tester.nGets_ == 1);
+
+  RefVector<IntCollection> emptyRefVector;
+  emptyRefVector.getMembers(members);
+  CPPUNIT_ASSERT(members.empty());
+}
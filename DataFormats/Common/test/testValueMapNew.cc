@@ -10,6 +10,8 @@ using namespace edm;
 class testValueMapNew : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testValueMapNew);
   CPPUNIT_TEST(checkAll);
+  CPPUNIT_TEST(checkInsertMoved);
+  CPPUNIT_TEST(checkManyProducts);
   CPPUNIT_TEST_SUITE_END();
   typedef std::vector<int> CKey1;
   typedef std::vector<float> CKey2;
@@ -19,6 +21,8 @@ public:
   void setUp() {}
   void tearDown() {}
   void checkAll();
+  void checkInsertMoved();
+  void checkManyProducts();
   void test(const edm::ValueMap<int> &);
   CKey1 v1;
   CKey2 v2;
@@ -86,6 +90,49 @@ void testValueMapNew::checkAll() {
   }
 }
 
+void testValueMapNew::checkInsertMoved() {
+  edm::ValueMap<int> values;
+  edm::ValueMap<int>::Filler filler(values);
+  filler.insert(handleK1, std::vector<int>(w1));
+  filler.insert(handleK2, std::vector<int>(w2));
+  CPPUNIT_ASSERT_THROW(filler.insert(handleK1, std::vector<int>(w1)), edm::Exception);
+  CPPUNIT_ASSERT_THROW(filler.insert(handleK2, std::vector<int>(w1)), edm::Exception);
+  filler.fill();
+  test(values);
+}
+
+void testValueMapNew::checkManyProducts() {
+  // more products than are scanned, for the binary search
+  const unsigned int nProducts = 20;
+  std::vector<CKey1> keys(nProducts, v1);
+  edm::ValueMap<int> values;
+  edm::ValueMap<int>::Filler filler(values);
+  for (unsigned int i = 0; i < nProducts; ++i) {
+    std::vector<int> w(v1.size());
+    for (unsigned int j = 0; j < w.size(); ++j)
+      w[j] = 100 * i + j;
+    // every other product id, in decreasing order
+    filler.insert(edm::TestHandle<CKey1>(&keys[i], ProductID(1, 2 * (nProducts - i))), w.begin(), w.end());
+  }
+  filler.fill();
+  CPPUNIT_ASSERT(values.idSize() == nProducts);
+  for (unsigned int i = 0; i < nProducts; ++i) {
+    const ProductID id(1, 2 * (nProducts - i));
+    CPPUNIT_ASSERT(values.contains(id));
+    CPPUNIT_ASSERT(!values.contains(ProductID(1, 2 * (nProducts - i) + 1)));
+    edm::ValueMap<int>::const_iterator found = values.find(id);
+    CPPUNIT_ASSERT(found != values.end());
+    CPPUNIT_ASSERT(found.id() == id);
+    CPPUNIT_ASSERT(found.size() == v1.size());
+    for (unsigned int j = 0; j < v1.size(); ++j) {
+      CPPUNIT_ASSERT(values.get(id, j) == int(100 * i + j));
+      CPPUNIT_ASSERT(found.begin()[j] == int(100 * i + j));
+    }
+  }
+  CPPUNIT_ASSERT(values.find(ProductID(1, 1)) == values.end());
+  CPPUNIT_ASSERT_THROW(values.get(ProductID(1, 1), 0), edm::Exception);
+}
+
 void testValueMapNew::test(const edm::ValueMap<int> &values) {
   CPPUNIT_ASSERT(values.idSize() == 2);
   CPPUNIT_ASSERT(!values.contains(ProductID(1, 0)));
@@ -115,6 +162,8 @@ void testValueMapNew::test(const edm::ValueMap<int> &values) {
   CPPUNIT_ASSERT(values.size() == w1.size() + w2.size());
   edm::ValueMap<int>::const_iterator b = values.begin(), e = values.end(), i;
   CPPUNIT_ASSERT(e - b == 2);
+  CPPUNIT_ASSERT(values.find(ProductID(1, 3)) == b + 1);
+  CPPUNIT_ASSERT(values.find(ProductID(1, 4)) == e);
   CPPUNIT_ASSERT(b.id() == ProductID(1, 2));
   CPPUNIT_ASSERT((b + 1).id() == ProductID(1, 3));
   ProductID pids[] = {ProductID(1, 2), ProductID(1, 3)};
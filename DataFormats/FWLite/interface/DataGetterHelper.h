@@ -32,6 +32,7 @@
 #include <cstring>
 #include <map>
 #include <memory>
+#include <string>
 #include <typeinfo>
 #include <vector>
 #include <functional>
@@ -83,6 +84,11 @@ namespace fwlite {
 
     edm::EDProductGetter const* getter() const { return getter_.get(); }
 
+    /// The names of the branches in the TTreeCache of the file, and the branches to put in the cache at once
+    /// instead of learning them over the first entries, e.g. those learnt on the previous file of a chain.
+    std::vector<std::string> cachedBranchNames() const;
+    void setCachedBranchNames(std::vector<std::string> const& names) { cachedBranchNames_ = names; }
+
   private:
     DataGetterHelper(const DataGetterHelper&) = delete;                   // stop default
     const DataGetterHelper& operator=(const DataGetterHelper&) = delete;  // stop default
@@ -112,6 +118,7 @@ namespace fwlite {
     CMS_SA_ALLOW mutable bool tcTrained_;
     /// Use internal TTreeCache.
     const bool tcUse_;
+    std::vector<std::string> cachedBranchNames_;
     /// Branch-access-function gets called whenever a branch data is accessed.
     /// This can be used for management of TTreeCache on the user side.
     std::function<void(TBranch const&)> branchAccessFunc_;
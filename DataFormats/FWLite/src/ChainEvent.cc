@@ -175,11 +175,17 @@ namespace fwlite {
   }
 
   void ChainEvent::switchToFile(Long64_t iIndex) {
+    //the branches read from the previous file are cached from the first entry of the next one
+    std::vector<std::string> cachedBranchNames;
+    if (event_) {
+      cachedBranchNames = event_->dataHelper_.cachedBranchNames();
+    }
     eventIndex_ = iIndex;
     TFile* tfilePtr = TFile::Open(fileNames_[iIndex].c_str());
     file_ = std::shared_ptr<TFile>(tfilePtr);
     gROOT->GetListOfFiles()->Remove(tfilePtr);
     event_ = std::make_shared<Event>(file_.get());
+    event_->dataHelper_.setCachedBranchNames(cachedBranchNames);
   }
 
   //
@@ -133,8 +133,17 @@ namespace fwlite {
 
       if (nullptr != tcache) {
         if (!tcTrained_) {
-          tcache->SetLearnEntries(100);
-          tcache->SetEntryRange(0, tree_->GetEntries());
+          if (cachedBranchNames_.empty()) {
+            tcache->SetLearnEntries(100);
+            tcache->SetEntryRange(0, tree_->GetEntries());
+          } else {
+            tcache->SetEntryRange(0, tree_->GetEntries());
+            for (auto const& name : cachedBranchNames_) {
+              tcache->AddBranch(name.c_str(), true);
+            }
+            tcache->AddBranch(iData.branch_, true);
+            tcache->StopLearningPhase();
+          }
           tcTrained_ = true;
         }
         tree_->LoadTree(eventEntry);
@@ -146,6 +155,20 @@ namespace fwlite {
     iData.lastProduct_ = eventEntry;
   }
 
+  std::vector<std::string> DataGetterHelper::cachedBranchNames() const {
+    std::vector<std::string> names;
+    if (tcUse_ && tcTrained_) {
+      TTreeCache* tcache = dynamic_cast<TTreeCache*>(branchMap_->getFile()->GetCacheRead());
+      if (nullptr != tcache && nullptr != tcache->GetCachedBranches()) {
+        TIter next(tcache->GetCachedBranches());
+        while (TObject const* branch = next()) {
+          names.emplace_back(branch->GetName());
+        }
+      }
+    }
+    return names;
+  }
+
   internal::Data& DataGetterHelper::getBranchDataFor(std::type_info const& iInfo,
                                                      char const* iModuleLabel,
                                                      char const* iProductInstanceLabel,
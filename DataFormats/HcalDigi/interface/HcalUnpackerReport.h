@@ -66,6 +66,9 @@ public:
   void setUnsuppressed(bool isSup);
   void setReportInfo(const std::string& name, const std::string& value);
 
+  // adds the FEDs, counts and ids of another report, as for the FEDs unpacked separately
+  void merge(const HcalUnpackerReport& other);
+
 private:
   std::vector<int> FEDsUnpacked_;
   std::vector<int> FEDsError_;
@@ -76,6 +76,27 @@ void HcalUnpackerReport::setFedCalibInfo(uint16_t fed, HcalCalibrationEventType
 
 void HcalUnpackerReport::setUnsuppressed(bool isSup) { unsuppressed_ = isSup; }
 
+void HcalUnpackerReport::merge(const HcalUnpackerReport& other) {
+  FEDsUnpacked_.insert(FEDsUnpacked_.end(), other.FEDsUnpacked_.begin(), other.FEDsUnpacked_.end());
+  FEDsError_.insert(FEDsError_.end(), other.FEDsError_.begin(), other.FEDsError_.end());
+  unmappedDigis_ += other.unmappedDigis_;
+  unmappedTPDigis_ += other.unmappedTPDigis_;
+  spigotFormatErrors_ += other.spigotFormatErrors_;
+  badqualityDigis_ += other.badqualityDigis_;
+  totalDigis_ += other.totalDigis_;
+  totalTPDigis_ += other.totalTPDigis_;
+  totalHOTPDigis_ += other.totalHOTPDigis_;
+  badqualityIds_.insert(badqualityIds_.end(), other.badqualityIds_.begin(), other.badqualityIds_.end());
+  unmappedIds_.insert(unmappedIds_.end(), other.unmappedIds_.begin(), other.unmappedIds_.end());
+  unsuppressed_ = unsuppressed_ || other.unsuppressed_;
+  reportInfo_.insert(reportInfo_.end(), other.reportInfo_.begin(), other.reportInfo_.end());
+  for (std::vector<uint16_t>::size_type i = 0; i + 1 < other.fedInfo_.size(); i += 2)
+    setFedCalibInfo(other.fedInfo_[i], HcalCalibrationEventType(other.fedInfo_[i + 1]));
+  emptyEventSpigots_ += other.emptyEventSpigots_;
+  ofwSpigots_ += other.ofwSpigots_;
+  busySpigots_ += other.busySpigots_;
+}
+
 static const std::string ReportSeparator("==>");
 
 void HcalUnpackerReport::setReportInfo(const std::string& name, const std::string& value) {
@@ -0,0 +1,110 @@
+#ifndef DataFormatsMathApproxExtVec_H
+#define DataFormatsMathApproxExtVec_H
+/*
+ * The approximations of approx_log.h, approx_exp.h and approx_atan2.h, the deltaR2 of deltaR.h and
+ * an approximate eta, over the ExtVec vectors of floats (Vec4<float>, cms_float32x8_t, ...)
+ *
+ * Each lane holds exactly what the scalar function of the same DEGREE returns for it: the scalar code is
+ * branchless and is vectorized by the compiler across the lanes, so a kinematic loop can be written over
+ * vectors of candidates with the accuracy it needs and the same results as the scalar loop.
+ */
+#include "DataFormats/Math/interface/ExtVec.h"
+#include "DataFormats/Math/interface/approx_atan2.h"
+#include "DataFormats/Math/interface/approx_exp.h"
+#include "DataFormats/Math/interface/approx_log.h"
+#include "DataFormats/Math/interface/deltaR.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace approx_math {
+  // V if V is an ExtVec of floats, not a valid type otherwise (so that the scalar calls are left untouched)
+  template <typename V>
+  using ExtVecOfFloat =
+      typename std::enable_if<std::is_same<typename std::remove_reference<decltype(std::declval<V&>()[0])>::type,
+                                           float>::value,
+                              V>::type;
+
+  template <typename V>
+  constexpr int extVecSize() {
+    return sizeof(V) / sizeof(float);
+  }
+}  // namespace approx_math
+
+// eta of the direction (x, y, z), as asinh(z/rho) with the log of approx_log.h
+template <int DEGREE>
+inline float unsafe_etaf(float x, float y, float z) {
+  float t = std::abs(z) / std::sqrt(x * x + y * y);
+  return std::copysign(unsafe_logf<DEGREE>(t + std::sqrt(t * t + 1.f)), z);
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> unsafe_logf(V x) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = unsafe_logf<DEGREE>(x[i]);
+  return ret;
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> approx_logf(V x) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = approx_logf<DEGREE>(x[i]);
+  return ret;
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> unsafe_expf(V x) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = unsafe_expf<DEGREE>(x[i]);
+  return ret;
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> approx_expf(V x) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = approx_expf<DEGREE>(x[i]);
+  return ret;
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> unsafe_atan2f(V y, V x) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = unsafe_atan2f<DEGREE>(y[i], x[i]);
+  return ret;
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> safe_atan2f(V y, V x) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = safe_atan2f<DEGREE>(y[i], x[i]);
+  return ret;
+}
+
+template <int DEGREE, typename V>
+inline approx_math::ExtVecOfFloat<V> unsafe_etaf(V x, V y, V z) {
+  V ret;
+  for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+    ret[i] = unsafe_etaf<DEGREE>(x[i], y[i], z[i]);
+  return ret;
+}
+
+namespace reco {
+
+  // deltaR2 of each lane, phi being in [-pi, pi] as for the scalar version
+  template <typename V>
+  inline approx_math::ExtVecOfFloat<V> deltaR2(V eta1, V phi1, V eta2, V phi2) {
+    V ret;
+    for (int i = 0; i != approx_math::extVecSize<V>(); ++i)
+      ret[i] = deltaR2(eta1[i], phi1[i], eta2[i], phi2[i]);
+    return ret;
+  }
+
+}  // namespace reco
+
+#endif
@@ -113,6 +113,13 @@ public:
     std::transform(begin, end, out, ReduceMantissaToNbitsRounding(bits));
   }
 
+  // the values rounded each to its own number of bits of mantissa, read from bits
+  template <typename InItr, typename BitsItr, typename OutItr>
+  static void reduceMantissaToNbitsRounding(InItr begin, InItr end, BitsItr bits, OutItr out) {
+    for (; begin != end; ++begin, ++bits, ++out)
+      *out = ReduceMantissaToNbitsRounding(*bits)(*begin);
+  }
+
   inline static float max() {
     union {
       float flt;
@@ -0,0 +1,100 @@
+#include "DataFormats/Math/interface/approx_extvec.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+  // every lane must be bit by bit the scalar result
+  template <typename V>
+  bool sameLanes(V v, float const* ref) {
+    for (int i = 0; i != approx_math::extVecSize<V>(); ++i) {
+      if (approx_math::binary32(v[i]).ui32 != approx_math::binary32(ref[i]).ui32 &&
+          !(std::isnan(v[i]) && std::isnan(ref[i])))
+        return false;
+    }
+    return true;
+  }
+
+  template <typename V>
+  int testLanes(unsigned int seed) {
+    constexpr int N = approx_math::extVecSize<V>();
+    std::srand(seed);
+    auto rnd = [](float mn, float mx) { return mn + (mx - mn) * float(std::rand()) / float(RAND_MAX); };
+
+    int failures = 0;
+    for (int k = 0; k != 10000; ++k) {
+      V pos, arg, x, y, z, eta1, phi1, eta2, phi2;
+      for (int i = 0; i != N; ++i) {
+        pos[i] = rnd(1.e-6f, 1.e6f);
+        arg[i] = rnd(-80.f, 80.f);
+        x[i] = rnd(-100.f, 100.f);
+        y[i] = rnd(-100.f, 100.f);
+        z[i] = rnd(-300.f, 300.f);
+        eta1[i] = rnd(-5.f, 5.f);
+        eta2[i] = rnd(-5.f, 5.f);
+        phi1[i] = rnd(-M_PI, M_PI);
+        phi2[i] = rnd(-M_PI, M_PI);
+      }
+      if (k == 0) {
+        // the special cases of the scalar versions
+        x[0] = y[0] = 0.f;
+        pos[0] = 0.f;
+      }
+
+      float ref[N];
+      for (int i = 0; i != N; ++i)
+        ref[i] = unsafe_logf<8>(pos[i]);
+      failures += !sameLanes(unsafe_logf<8>(pos), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = approx_logf<4>(pos[i]);
+      failures += !sameLanes(approx_logf<4>(pos), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = unsafe_expf<6>(arg[i]);
+      failures += !sameLanes(unsafe_expf<6>(arg), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = approx_expf<3>(arg[i]);
+      failures += !sameLanes(approx_expf<3>(arg), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = unsafe_atan2f<9>(y[i], x[i]);
+      failures += !sameLanes(unsafe_atan2f<9>(y, x), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = safe_atan2f<11>(y[i], x[i]);
+      failures += !sameLanes(safe_atan2f<11>(y, x), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = unsafe_etaf<8>(x[i], y[i], z[i]);
+      failures += !sameLanes(unsafe_etaf<8>(x, y, z), ref);
+      for (int i = 0; i != N; ++i)
+        ref[i] = reco::deltaR2(eta1[i], phi1[i], eta2[i], phi2[i]);
+      failures += !sameLanes(reco::deltaR2(eta1, phi1, eta2, phi2), ref);
+    }
+    return failures;
+  }
+
+}  // namespace
+
+int main() {
+  int failures = testLanes<Vec4<float>>(1234);
+#ifdef __AVX__
+  failures += testLanes<cms_float32x8_t>(4321);
+#endif
+  std::cout << "lanes different from the scalar results: " << failures << std::endl;
+
+  // the approximate eta against asinh
+  float maxdiff = 0;
+  for (float z = -300.f; z < 300.f; z += 0.37f) {
+    float t = z / std::sqrt(2.f * 3.f * 3.f);
+    maxdiff = std::max(maxdiff, std::abs(unsafe_etaf<8>(3.f, 3.f, z) - std::asinh(t)));
+  }
+  std::cout << "max eta difference to asinh: " << maxdiff << std::endl;
+
+  // the scalar calls and the scalar overloads of deltaR2 are not hijacked by the vector ones
+  assert(approx_logf<8>(1.f) == 0.f);
+  assert(reco::deltaR2(0., 0., 1., 0.) == 1.);
+
+  assert(failures == 0);
+  assert(maxdiff < 1.e-5f);
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <iostream>
+#include <vector>
 
 #include "DataFormats/Math/interface/libminifloat.h"
 #include "FWCore/Utilities/interface/isFinite.h"
@@ -13,6 +14,7 @@ class testMiniFloat : public CppUnit::TestFixture {
   CPPUNIT_TEST(testMin);
   CPPUNIT_TEST(testMin32RoundedToMin16);
   CPPUNIT_TEST(testDenormMin);
+  CPPUNIT_TEST(testReduceMantissaPerValue);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -26,6 +28,7 @@ public:
   void testMin();
   void testMin32RoundedToMin16();
   void testDenormMin();
+  void testReduceMantissaPerValue();
 
 private:
 };
@@ -131,3 +134,14 @@ void testMiniFloat::testDenormMin() {
       MiniFloatConverter::float16to32(MiniFloatConverter::float32to16crop(conv.flt));
   CPPUNIT_ASSERT(min32MinusUlp32CroppedTo16 == 0.f);
 }
+
+void testMiniFloat::testReduceMantissaPerValue() {
+  // each value is rounded to its own number of bits, as one by one
+  const std::vector<float> values = {1.2345678f, -3.1415927f, 123456.78f, 0.f, 1.e-20f};
+  const std::vector<int> bits = {4, 10, 7, 12, 20};
+  std::vector<float> reduced(values.size());
+  MiniFloatConverter::reduceMantissaToNbitsRounding(values.begin(), values.end(), bits.begin(), reduced.begin());
+  for (unsigned int i = 0; i < values.size(); ++i) {
+    CPPUNIT_ASSERT(reduced[i] == MiniFloatConverter::reduceMantissaToNbitsRounding(values[i], bits[i]));
+  }
+}
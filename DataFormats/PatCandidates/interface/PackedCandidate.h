@@ -412,18 +412,20 @@ namespace pat {
     reco::CandidatePtr sourceCandidatePtr(size_type i) const override { return reco::CandidatePtr(); }
 
     /// electric charge
-    int charge() const override {
-      switch (abs(pdgId_)) {
+    int charge() const override { return chargeFromPdgId(pdgId_); }
+    /// electric charge of the candidates of a pdgId
+    static int chargeFromPdgId(int pdgId) {
+      switch (abs(pdgId)) {
         case 211:
-          return (pdgId_ > 0) - (pdgId_ < 0);
+          return (pdgId > 0) - (pdgId < 0);
         case 11:
-          return (-1) * (pdgId_ > 0) + (pdgId_ < 0);  // e
+          return (-1) * (pdgId > 0) + (pdgId < 0);  // e
         case 13:
-          return (-1) * (pdgId_ > 0) + (pdgId_ < 0);  // mu
+          return (-1) * (pdgId > 0) + (pdgId < 0);  // mu
         case 15:
-          return (-1) * (pdgId_ > 0) + (pdgId_ < 0);  // tau
+          return (-1) * (pdgId > 0) + (pdgId < 0);  // tau
         case 24:
-          return (pdgId_ > 0) - (pdgId_ < 0);  // W
+          return (pdgId > 0) - (pdgId < 0);  // W
         default:
           return 0;  // FIXME: charge is not defined
       }
@@ -992,6 +994,7 @@ namespace pat {
 
   protected:
     friend class ::testPackedCandidate;
+    friend class PackedCandidateTable;
     static constexpr float kMinDEtaToStore_ = 0.001;
     static constexpr float kMinDTrkPtToStore_ = 0.001;
 
@@ -0,0 +1,98 @@
+#ifndef __DataFormats_PatCandidates_PackedCandidateTable_h__
+#define __DataFormats_PatCandidates_PackedCandidateTable_h__
+
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace pat {
+
+  /* The kinematics of a collection of PackedCandidates, column by column, in the order of the collection.
+   * The columns hold the packed values of the candidates, and are unpacked in bulk to the values the candidates
+   * unpack to one by one, for the readers which only need the kinematics of many candidates.
+   */
+  class PackedCandidateTable {
+  public:
+    // the unpacked kinematics: the pt, eta and mass are those of the candidates, and phi too, which the candidates
+    // compute in double precision
+    struct Kinematics {
+      std::vector<float> pt;
+      std::vector<float> eta;
+      std::vector<double> phi;
+      std::vector<float> mass;
+    };
+
+    PackedCandidateTable() {}
+    explicit PackedCandidateTable(const std::vector<pat::PackedCandidate> &candidates);
+
+    unsigned int size() const { return packedPt_.size(); }
+    bool empty() const { return packedPt_.empty(); }
+
+    int pdgId(unsigned int i) const { return pdgId_[i]; }
+    int charge(unsigned int i) const { return pat::PackedCandidate::chargeFromPdgId(pdgId_[i]); }
+
+    void unpack(Kinematics &kinematics) const;
+
+  private:
+    std::vector<uint16_t> packedPt_, packedEta_, packedPhi_, packedM_;
+    std::vector<int> pdgId_;
+  };
+
+  /* The unpacked kinematics of a PackedCandidateTable, with the accessors of a candidate, for the code templated
+   * on the collection of candidates (EtaPhiConeIndex::fill, ...)
+   */
+  class PackedCandidateTableView {
+  public:
+    class Candidate {
+    public:
+      Candidate(const PackedCandidateTableView &view, unsigned int index) : view_(&view), index_(index) {}
+      double pt() const { return view_->kinematics_.pt[index_]; }
+      double eta() const { return view_->kinematics_.eta[index_]; }
+      double phi() const { return view_->kinematics_.phi[index_]; }
+      double mass() const { return view_->kinematics_.mass[index_]; }
+      int pdgId() const { return view_->table_->pdgId(index_); }
+      int charge() const { return view_->table_->charge(index_); }
+
+    private:
+      const PackedCandidateTableView *view_;
+      unsigned int index_;
+    };
+
+    class const_iterator {
+    public:
+      const_iterator(const PackedCandidateTableView &view, unsigned int index) : view_(&view), index_(index) {}
+      Candidate operator*() const { return Candidate(*view_, index_); }
+      const_iterator &operator++() {
+        ++index_;
+        return *this;
+      }
+      bool operator==(const const_iterator &other) const { return index_ == other.index_; }
+      bool operator!=(const const_iterator &other) const { return index_ != other.index_; }
+
+    private:
+      const PackedCandidateTableView *view_;
+      unsigned int index_;
+    };
+
+    explicit PackedCandidateTableView(const PackedCandidateTable &table) : table_(&table) {
+      table.unpack(kinematics_);
+    }
+
+    unsigned int size() const { return table_->size(); }
+    bool empty() const { return table_->empty(); }
+    Candidate operator[](unsigned int i) const { return Candidate(*this, i); }
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+    // the columns, for the loops over the candidates
+    const PackedCandidateTable::Kinematics &kinematics() const { return kinematics_; }
+
+  private:
+    const PackedCandidateTable *table_;
+    PackedCandidateTable::Kinematics kinematics_;
+  };
+
+}  // namespace pat
+
+#endif
@@ -0,0 +1,49 @@
+#include "DataFormats/PatCandidates/interface/PackedCandidateTable.h"
+#include "DataFormats/Math/interface/libminifloat.h"
+
+#include <cmath>
+#include <limits>
+
+pat::PackedCandidateTable::PackedCandidateTable(const std::vector<pat::PackedCandidate> &candidates) {
+  const unsigned int n = candidates.size();
+  packedPt_.reserve(n);
+  packedEta_.reserve(n);
+  packedPhi_.reserve(n);
+  packedM_.reserve(n);
+  pdgId_.reserve(n);
+  for (auto const &candidate : candidates) {
+    packedPt_.push_back(candidate.packedPt_);
+    packedEta_.push_back(candidate.packedEta_);
+    packedPhi_.push_back(candidate.packedPhi_);
+    packedM_.push_back(candidate.packedM_);
+    pdgId_.push_back(candidate.pdgId_);
+  }
+}
+
+void pat::PackedCandidateTable::unpack(Kinematics &kinematics) const {
+  // the same operations, in the same precisions, as PackedCandidate::unpack, one column at a time
+  const unsigned int n = size();
+  kinematics.pt.resize(n);
+  kinematics.eta.resize(n);
+  kinematics.phi.resize(n);
+  kinematics.mass.resize(n);
+  constexpr int16_t kMaxPacked = std::numeric_limits<int16_t>::max();
+
+  for (unsigned int i = 0; i < n; ++i) {
+    kinematics.pt[i] = MiniFloatConverter::float16to32(packedPt_[i]);
+    kinematics.mass[i] = MiniFloatConverter::float16to32(packedM_[i]);
+  }
+  for (unsigned int i = 0; i < n; ++i)
+    kinematics.eta[i] = int16_t(packedEta_[i]) * 6.0f / kMaxPacked;
+  for (unsigned int i = 0; i < n; ++i) {
+    const float pt = kinematics.pt[i];
+    // the shift of phi breaking the degeneracies in the angular separations, with its pseudo-random sign
+    const double shift = (pt < 1. ? 0.1 * pt : 0.1 / pt);
+    const double sign = ((int(pt * 10) % 2 == 0) ? 1 : -1);
+    double phi = int16_t(packedPhi_[i]) * 3.2f / kMaxPacked + sign * shift * 3.2 / kMaxPacked;
+    // brought back to (-pi, pi] as by the PolarLorentzVector of the candidate
+    if (phi <= -M_PI || phi > M_PI)
+      phi = phi - std::floor(phi / (2 * M_PI) + .5) * 2 * M_PI;
+    kinematics.phi[i] = phi;
+  }
+}
@@ -0,0 +1,121 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cmath>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/PackedCandidateTable.h"
+
+#include "TBufferFile.h"
+#include "TClass.h"
+
+class testPackedCandidateTable : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testPackedCandidateTable);
+
+  CPPUNIT_TEST(testUnpack);
+  CPPUNIT_TEST(testView);
+  CPPUNIT_TEST(testStreaming);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown() {}
+
+  void testUnpack();
+  void testView();
+  void testStreaming();
+
+private:
+  std::vector<pat::PackedCandidate> candidates_;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testPackedCandidateTable);
+
+void testPackedCandidateTable::setUp() {
+  // soft and hard candidates, both signs of the shift of phi, and phis at the edges of the range
+  const std::vector<double> pts = {0.35, 0.95, 1.25, 3.7, 42.1, 250.};
+  const std::vector<double> etas = {-2.4, -0.3, 0., 0.8, 1.9, 4.7};
+  const std::vector<double> phis = {-M_PI + 1.e-5, -1.2, 0.1, 2.7, M_PI - 1.e-5, 3.1};
+  const std::vector<int> pdgIds = {211, -211, 22, 11, -13, 130};
+  candidates_.clear();
+  for (unsigned int i = 0; i < pts.size(); ++i) {
+    pat::PackedCandidate::PolarLorentzVector plv(pts[i], etas[i], phis[i], 0.1396);
+    pat::PackedCandidate::LorentzVector lv(plv);
+    candidates_.emplace_back(lv,
+                             pat::PackedCandidate::Point(0., 0., 0.),
+                             pts[i],
+                             etas[i],
+                             phis[i],
+                             pdgIds[i],
+                             reco::VertexRefProd(),
+                             reco::VertexRef().key());
+  }
+}
+
+void testPackedCandidateTable::testUnpack() {
+  const pat::PackedCandidateTable table(candidates_);
+  CPPUNIT_ASSERT(table.size() == candidates_.size());
+
+  pat::PackedCandidateTable::Kinematics kinematics;
+  table.unpack(kinematics);
+  // the values the candidates unpack to, exactly
+  for (unsigned int i = 0; i < candidates_.size(); ++i) {
+    CPPUNIT_ASSERT(kinematics.pt[i] == candidates_[i].pt());
+    CPPUNIT_ASSERT(kinematics.eta[i] == candidates_[i].eta());
+    CPPUNIT_ASSERT(kinematics.phi[i] == candidates_[i].phi());
+    CPPUNIT_ASSERT(kinematics.mass[i] == candidates_[i].mass());
+    CPPUNIT_ASSERT(table.pdgId(i) == candidates_[i].pdgId());
+    CPPUNIT_ASSERT(table.charge(i) == candidates_[i].charge());
+  }
+
+  const pat::PackedCandidateTable empty;
+  empty.unpack(kinematics);
+  CPPUNIT_ASSERT(empty.empty());
+  CPPUNIT_ASSERT(kinematics.pt.empty());
+}
+
+void testPackedCandidateTable::testView() {
+  const pat::PackedCandidateTable table(candidates_);
+  const pat::PackedCandidateTableView view(table);
+  CPPUNIT_ASSERT(view.size() == candidates_.size());
+
+  unsigned int i = 0;
+  for (auto const& candidate : view) {
+    CPPUNIT_ASSERT(candidate.pt() == candidates_[i].pt());
+    CPPUNIT_ASSERT(candidate.eta() == candidates_[i].eta());
+    CPPUNIT_ASSERT(candidate.phi() == candidates_[i].phi());
+    CPPUNIT_ASSERT(candidate.mass() == candidates_[i].mass());
+    CPPUNIT_ASSERT(candidate.charge() == candidates_[i].charge());
+    ++i;
+  }
+  CPPUNIT_ASSERT(i == candidates_.size());
+  CPPUNIT_ASSERT(view[2].pdgId() == candidates_[2].pdgId());
+}
+
+void testPackedCandidateTable::testStreaming() {
+  const pat::PackedCandidateTable table(candidates_);
+
+  // write and read back the table with its dictionary
+  auto m_class = TClass::GetClass(typeid(pat::PackedCandidateTable));
+  CPPUNIT_ASSERT(m_class != nullptr);
+  CPPUNIT_ASSERT(m_class->GetClassVersion() == 3);
+  TBufferFile wbuffer(TBufferFile::kWrite);
+  wbuffer.InitMap();
+  wbuffer.StreamObject(&table, m_class);
+
+  TBufferFile rbuffer(TBufferFile::kRead, wbuffer.Length(), wbuffer.Buffer(), kFALSE);
+  rbuffer.InitMap();
+  pat::PackedCandidateTable table2;
+  rbuffer.StreamObject(&table2, m_class);
+
+  CPPUNIT_ASSERT(table2.size() == table.size());
+  pat::PackedCandidateTable::Kinematics kinematics, kinematics2;
+  table.unpack(kinematics);
+  table2.unpack(kinematics2);
+  for (unsigned int i = 0; i < table.size(); ++i) {
+    CPPUNIT_ASSERT(kinematics2.pt[i] == kinematics.pt[i]);
+    CPPUNIT_ASSERT(kinematics2.eta[i] == kinematics.eta[i]);
+    CPPUNIT_ASSERT(kinematics2.phi[i] == kinematics.phi[i]);
+    CPPUNIT_ASSERT(kinematics2.mass[i] == kinematics.mass[i]);
+    CPPUNIT_ASSERT(table2.pdgId(i) == table.pdgId(i));
+  }
+}
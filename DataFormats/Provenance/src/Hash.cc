@@ -81,11 +81,15 @@ namespace edm {
     }
 
     void toDigest_(cms::Digest& digest, value_type const& hash) {
-      // FIXME: do we really need to go through a temporary value_type???
-      value_type temp1(hash);
-      fixup_(temp1);
+      // the hashes are in compact form once constructed: no temporary value_type is needed for them
       cms::MD5Result temp;
-      copy_all(temp1, temp.bytes);
+      if (isCompactForm_(hash)) {
+        copy_all(hash, temp.bytes);
+      } else {
+        value_type temp1(hash);
+        fixup_(temp1);
+        copy_all(temp1, temp.bytes);
+      }
       digest.append(temp.toString());
     }
 
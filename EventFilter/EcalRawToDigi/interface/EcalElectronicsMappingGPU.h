@@ -0,0 +1,34 @@
+#ifndef EventFilter_EcalRawToDigi_EcalElectronicsMappingGPU_h
+#define EventFilter_EcalRawToDigi_EcalElectronicsMappingGPU_h
+
+#include <cuda_runtime.h>
+
+#include "EventFilter/EcalRawToDigi/interface/EcalElectronicsMappingOnGPU.h"
+#include "HeterogeneousCore/CUDACore/interface/ESProduct.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_noncached_unique_ptr.h"
+
+class EcalElectronicsMapping;
+
+// The ECAL electronics mapping in the layout of EcalElectronicsMappingOnGPU,
+// copied to each device on its first use.
+class EcalElectronicsMappingGPU {
+public:
+  explicit EcalElectronicsMappingGPU(EcalElectronicsMapping const& mapping);
+  ~EcalElectronicsMappingGPU() = default;
+
+  EcalElectronicsMappingOnGPU const& hostProduct() const { return *mappingHost_; }
+
+  // returns pointer to GPU memory
+  EcalElectronicsMappingOnGPU const* getGPUProductAsync(cudaStream_t cudaStream) const;
+
+private:
+  cms::cuda::host::noncached::unique_ptr<EcalElectronicsMappingOnGPU> mappingHost_;
+
+  struct GPUData {
+    ~GPUData();
+    EcalElectronicsMappingOnGPU* mappingDevice = nullptr;
+  };
+  cms::cuda::ESProduct<GPUData> gpuData_;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef EventFilter_EcalRawToDigi_EcalElectronicsMappingOnGPU_h
+#define EventFilter_EcalRawToDigi_EcalElectronicsMappingOnGPU_h
+
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define ECALMAPPING_HOST_DEVICE __host__ __device__
+#else
+#define ECALMAPPING_HOST_DEVICE
+#endif
+
+namespace ecalgpudetails {
+
+  // the DCCs of ECAL, with FED ids 601 to 654, and the channels of their front-end boards
+  constexpr uint32_t MAX_DCC = 54;
+  constexpr uint32_t MAX_TOWER = 68;
+  constexpr uint32_t MAX_STRIP = 5;
+  constexpr uint32_t MAX_XTAL = 5;
+  constexpr uint32_t MAX_SIZE = MAX_DCC * MAX_TOWER * MAX_STRIP * MAX_XTAL;
+
+  // the dcc, tower, strip and xtal ids of EcalElectronicsId, all from 1
+  constexpr ECALMAPPING_HOST_DEVICE uint32_t mappingIndex(uint32_t dcc, uint32_t tower, uint32_t strip, uint32_t xtal) {
+    return (((dcc - 1) * MAX_TOWER + (tower - 1)) * MAX_STRIP + (strip - 1)) * MAX_XTAL + (xtal - 1);
+  }
+
+  constexpr uint32_t invalidChannel = 0xffffffff;
+
+}  // namespace ecalgpudetails
+
+// The crystal read out by each channel of the front-end boards of the
+// DCCs, as a flat table: the DetId::rawId(), 0 for unconnected channels,
+// and the dense channel index of EcalDigiSoA, invalidChannel for those.
+struct EcalElectronicsMappingOnGPU {
+  uint32_t rawId[ecalgpudetails::MAX_SIZE];
+  uint32_t channel[ecalgpudetails::MAX_SIZE];
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include <memory>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiCUDA.h"
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * Copies the digis unpacked on the GPU back to the host, as the sorted
+ * barrel and endcap digi collections of EcalRawToDigi.
+ */
+class EcalDigisFromCUDA : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit EcalDigisFromCUDA(const edm::ParameterSet& iConfig);
+  ~EcalDigisFromCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<EcalDigiCUDA>> digiGetToken_;
+  edm::EDPutTokenT<EBDigiCollection> ebDigiPutToken_;
+  edm::EDPutTokenT<EEDigiCollection> eeDigiPutToken_;
+
+  cms::cuda::host::unique_ptr<EcalDigiSoA> digis_;
+};
+
+EcalDigisFromCUDA::EcalDigisFromCUDA(const edm::ParameterSet& iConfig)
+    : digiGetToken_(consumes<cms::cuda::Product<EcalDigiCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      ebDigiPutToken_(produces<EBDigiCollection>("ebDigis")),
+      eeDigiPutToken_(produces<EEDigiCollection>("eeDigis")) {}
+
+void EcalDigisFromCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("ecalRawToDigiCUDA"));
+  descriptions.add("ecalDigisFromCUDA", desc);
+}
+
+void EcalDigisFromCUDA::acquire(const edm::Event& iEvent,
+                                const edm::EventSetup& iSetup,
+                                edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  auto const& product = iEvent.get(digiGetToken_);
+  cms::cuda::ScopedContextAcquire ctx{product, std::move(waitingTaskHolder)};
+  digis_ = ctx.get(product).toHostAsync(ctx.stream());
+}
+
+void EcalDigisFromCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  auto const& digis = *digis_;
+  auto ebDigis = std::make_unique<EBDigiCollection>();
+  auto eeDigis = std::make_unique<EEDigiCollection>();
+  ebDigis->reserve(digis.nBarrelDigis);
+  eeDigis->reserve(digis.nDigis - digis.nBarrelDigis);
+  for (uint32_t i = 0; i < digis.nDigis; ++i) {
+    if (digis.isBarrel(i))
+      ebDigis->push_back(digis.id[i], digis.samples[i]);
+    else
+      eeDigis->push_back(digis.id[i], digis.samples[i]);
+  }
+  // the digis are unpacked in parallel, the legacy collections are ordered by DetId
+  ebDigis->sort();
+  eeDigis->sort();
+
+  iEvent.put(ebDigiPutToken_, std::move(ebDigis));
+  iEvent.put(eeDigiPutToken_, std::move(eeDigis));
+  digis_.reset();
+}
+
+DEFINE_FWK_MODULE(EcalDigisFromCUDA);
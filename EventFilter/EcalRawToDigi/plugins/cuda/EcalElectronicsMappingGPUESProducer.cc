@@ -0,0 +1,37 @@
+#include <memory>
+
+#include "EventFilter/EcalRawToDigi/interface/EcalElectronicsMappingGPU.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "Geometry/EcalMapping/interface/EcalElectronicsMapping.h"
+#include "Geometry/EcalMapping/interface/EcalMappingRcd.h"
+
+class EcalElectronicsMappingGPUESProducer : public edm::ESProducer {
+public:
+  explicit EcalElectronicsMappingGPUESProducer(const edm::ParameterSet& iConfig);
+  std::unique_ptr<EcalElectronicsMappingGPU> produce(const EcalMappingRcd& iRecord);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  edm::ESGetToken<EcalElectronicsMapping, EcalMappingRcd> mappingToken_;
+};
+
+EcalElectronicsMappingGPUESProducer::EcalElectronicsMappingGPUESProducer(const edm::ParameterSet& iConfig) {
+  setWhatProduced(this).setConsumes(mappingToken_);
+}
+
+void EcalElectronicsMappingGPUESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  descriptions.add("ecalElectronicsMappingGPUESProducer", desc);
+}
+
+std::unique_ptr<EcalElectronicsMappingGPU> EcalElectronicsMappingGPUESProducer::produce(
+    const EcalMappingRcd& iRecord) {
+  return std::make_unique<EcalElectronicsMappingGPU>(iRecord.get(mappingToken_));
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(EcalElectronicsMappingGPUESProducer);
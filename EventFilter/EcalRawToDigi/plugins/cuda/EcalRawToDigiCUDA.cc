@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <vector>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiCUDA.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+#include "DataFormats/FEDRawData/interface/FEDRawData.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "EventFilter/EcalRawToDigi/interface/EcalElectronicsMappingGPU.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "Geometry/EcalMapping/interface/EcalMappingRcd.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAHostStagingService.h"
+
+#include "EcalRawToDigiGPUKernel.h"
+
+/**
+ * Unpacks the xtal data of the ECAL FEDs on the GPU, with the same checks
+ * of the data format and of the gains as EcalRawToDigi, into the
+ * EcalDigiSoA fitted by EcalUncalibRecHitProducerCUDA. The EcalDigisFromCUDA
+ * module converts it to the legacy digis.
+ */
+class EcalRawToDigiCUDA : public edm::global::EDProducer<> {
+public:
+  explicit EcalRawToDigiCUDA(const edm::ParameterSet& iConfig);
+  ~EcalRawToDigiCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<FEDRawDataCollection> rawGetToken_;
+  const edm::EDPutTokenT<cms::cuda::Product<EcalDigiCUDA>> digiPutToken_;
+  const edm::ESGetToken<EcalElectronicsMappingGPU, EcalMappingRcd> mappingToken_;
+
+  std::vector<int> feds_;
+  ecalgpudetails::UnpackerParameters params_;
+};
+
+EcalRawToDigiCUDA::EcalRawToDigiCUDA(const edm::ParameterSet& iConfig)
+    : rawGetToken_(consumes<FEDRawDataCollection>(iConfig.getParameter<edm::InputTag>("InputLabel"))),
+      digiPutToken_(produces<cms::cuda::Product<EcalDigiCUDA>>()),
+      mappingToken_(esConsumes<EcalElectronicsMappingGPU, EcalMappingRcd>()),
+      feds_(iConfig.getParameter<std::vector<int>>("FEDs")) {
+  for (auto fed : feds_) {
+    if (fed <= FEDNumbering::MINECALFEDID || fed > FEDNumbering::MINECALFEDID + int(ecalgpudetails::MAX_DCC)) {
+      throw cms::Exception("Configuration") << "The FED " << fed << " is not an ECAL DCC";
+    }
+  }
+
+  // the trigger block of the barrel, a header and 4 trigger primitives per word, as in EcalElectronicsMapper
+  int const numbTriggerTSamples = iConfig.getParameter<int>("numbTriggerTSamples");
+  if (numbTriggerTSamples != 1 && numbTriggerTSamples != 4 && numbTriggerTSamples != 8) {
+    throw cms::Exception("Configuration") << "Unsupported number of trigger time samples: " << numbTriggerTSamples;
+  }
+  params_.ebTccBlockLength = 1 + (68 * numbTriggerTSamples) / 4;
+  params_.feIdCheck = iConfig.getParameter<bool>("feIdCheck");
+}
+
+void EcalRawToDigiCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("InputLabel", edm::InputTag("rawDataCollector"));
+  std::vector<int> feds;
+  for (int i = 1; i <= int(ecalgpudetails::MAX_DCC); ++i)
+    feds.push_back(FEDNumbering::MINECALFEDID + i);
+  desc.add<std::vector<int>>("FEDs", feds);
+  desc.add<int>("numbTriggerTSamples", 1);
+  desc.add<bool>("feIdCheck", true);
+  descriptions.add("ecalRawToDigiCUDA", desc);
+}
+
+void EcalRawToDigiCUDA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  cms::cuda::ScopedContextProduce ctx{iEvent.streamID()};
+
+  auto const& mapping = iSetup.getData(mappingToken_);
+  auto const& buffers = iEvent.get(rawGetToken_);
+
+  uint32_t maxWords = 0;
+  for (auto fed : feds_) {
+    maxWords += buffers.FEDData(fed).size() / sizeof(uint64_t);
+  }
+  // the FEDs are gathered in the pinned ring of the stream when the CUDAHostStagingService is there
+  edm::Service<CUDAHostStagingService> staging;
+  cms::cuda::HostStagingRing* ring =
+      staging.isAvailable() && staging->enabled() ? &staging->ring(iEvent.streamID()) : nullptr;
+  ecalgpudetails::FedDataAppender fedData(std::max(maxWords, 1u), ring, ctx.stream());
+
+  for (auto fed : feds_) {
+    FEDRawData const& rawData = buffers.FEDData(fed);
+    if (rawData.size() == 0)
+      continue;
+    if (rawData.size() % sizeof(uint64_t) != 0) {
+      edm::LogWarning("EcalRawToDigiCUDA") << "Skipping the FED " << fed << " with a data size of " << rawData.size()
+                                           << " bytes";
+      continue;
+    }
+    fedData.append(reinterpret_cast<uint64_t const*>(rawData.data()),
+                   rawData.size() / sizeof(uint64_t),
+                   fed - FEDNumbering::MINECALFEDID);
+  }
+
+  ctx.emplace(
+      iEvent,
+      digiPutToken_,
+      ecalgpudetails::makeDigisAsync(mapping.getGPUProductAsync(ctx.stream()), params_, fedData, ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(EcalRawToDigiCUDA);
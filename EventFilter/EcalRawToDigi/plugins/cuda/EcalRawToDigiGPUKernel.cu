@@ -0,0 +1,375 @@
+#include <algorithm>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "EventFilter/EcalRawToDigi/interface/DCCRawDataDefinitions.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+#include "EcalRawToDigiGPUKernel.h"
+
+namespace ecalgpudetails {
+
+  namespace {
+
+    constexpr uint32_t nThreads = 128;
+
+    // the towers of a DCC and their xtal blocks, 3 64-bit words of 10 samples each
+    constexpr uint32_t maxTowers = 68;
+    constexpr uint32_t maxXtalsInTower = 25;
+    constexpr uint32_t maxXtals = maxTowers * maxXtalsInTower;
+    constexpr uint32_t nXtalSamples = EcalDigiSoA::nSamples;
+    constexpr uint32_t xtalBlockLength = (nXtalSamples - 2) / 4 + 1;
+    constexpr uint32_t unfilteredTowerBlockLength = xtalBlockLength * maxXtalsInTower + 1;
+
+    // the endcap digis, compacted after the barrel ones once all the FEDs are unpacked
+    struct UnpackedDigis {
+      uint32_t nBarrel;
+      uint32_t nEndcap;
+      uint32_t id[EcalDigiSoA::nEndcapChannels];
+      uint32_t channel[EcalDigiSoA::nEndcapChannels];
+      uint16_t samples[EcalDigiSoA::nEndcapChannels][EcalDigiSoA::nSamples];
+    };
+
+    // the xtal blocks found in the tower blocks of a FED
+    struct XtalBlocks {
+      uint32_t nXtals;
+      uint32_t offset[maxXtals];   // of the first word of the block in the FED buffer
+      uint16_t first[maxXtals];    // the first xtal block of the same tower
+      uint8_t tower[maxXtals];     // the tower id read in the tower block
+      uint8_t zs[maxXtals];        // whether the tower is zero suppressed
+    };
+
+    __device__ constexpr bool isStatusUnpacked(uint32_t status) {
+      return !(status == CH_DISABLED || status == CH_SUPPRESS || status == CH_TIMEOUT || status == CH_HEADERERR ||
+               status == CH_LINKERR || status == CH_LENGTHERR || status == CH_IFIFOFULL || status == CH_L1AIFIFOFULL);
+    }
+
+    // the state of the walk through the blocks of a FED, as in DCCEventBlock: the
+    // index of the last word read, the blocks start at the next one
+    struct FedPointer {
+      uint32_t last;
+      uint32_t dwToEnd;
+
+      __device__ void advance(uint32_t length) {
+        last += length;
+        dwToEnd = dwToEnd >= length ? dwToEnd - length : 0;
+      }
+    };
+
+    // the first tower block after the current one with a larger tower id, from the
+    // signature of its header, as in DCCEventBlock::next_tower_search
+    __device__ uint32_t nextTowerSearch(uint64_t const* data, FedPointer& ptr, uint32_t currentTower) {
+      uint64_t const header = data[0];
+      uint32_t const l1 = (header >> H_L1_B) & H_L1_MASK;
+      uint32_t const dccBx = (header >> H_BX_B) & H_BX_MASK;
+      uint64_t const lv1 = (l1 - 1) & 0xFFF;
+      uint64_t const bx = (dccBx != 3564) ? dccBx : 0;
+      uint64_t const sign = ((0xC0000000 + lv1) << 32) + 0xC0000000 + (bx << 16) + (nXtalSamples << 8);
+      uint64_t const mask = 0xC0001FFFDFFF7F00;
+
+      FedPointer search = ptr;
+      search.advance(1);
+      while (search.dwToEnd > 0) {
+        search.advance(1);
+        if ((data[search.last] & mask) == sign) {
+          uint32_t const nextTower = data[search.last] & 0xFF;
+          if (nextTower <= currentTower)
+            continue;
+          ptr.last = search.last - 1;
+          ptr.dwToEnd = search.dwToEnd + 1;
+          return nextTower;
+        }
+      }
+      return 1000;
+    }
+
+    // one tower block, as in DCCFEBlock::unpack
+    __device__ int unpackTower(uint64_t const* data,
+                               FedPointer& ptr,
+                               uint32_t expectedTower,
+                               bool zs,
+                               UnpackerParameters const& params,
+                               XtalBlocks& xtals) {
+      if (ptr.dwToEnd < 1)
+        return STOP_EVENT_UNPACKING;
+
+      uint64_t const header = data[ptr.last + 1];
+      uint32_t const towerId = header & TOWER_ID_MASK;
+      uint32_t const nSamples = (header >> TOWER_NSAMP_B) & TOWER_NSAMP_MASK;
+      uint32_t const blockLength = (header >> TOWER_LENGTH_B) & TOWER_LENGTH_MASK;
+
+      if ((params.feIdCheck && towerId != expectedTower) || (!params.feIdCheck && towerId > maxTowers) ||
+          nSamples != nXtalSamples) {
+        ptr.advance(blockLength);
+        return SKIP_BLOCK_UNPACKING;
+      }
+      if (ptr.dwToEnd < blockLength)
+        return STOP_EVENT_UNPACKING;
+      if ((!zs && blockLength != unfilteredTowerBlockLength) || blockLength > unfilteredTowerBlockLength ||
+          blockLength - 1 < xtalBlockLength)
+        return STOP_EVENT_UNPACKING;
+
+      uint32_t const first = xtals.nXtals;
+      uint32_t const nXtalBlocks = (blockLength - 1) / xtalBlockLength;
+      for (uint32_t i = 0; i < nXtalBlocks && xtals.nXtals < maxXtals; ++i) {
+        uint32_t const k = xtals.nXtals++;
+        xtals.offset[k] = ptr.last + 2 + i * xtalBlockLength;
+        xtals.first[k] = first;
+        xtals.tower[k] = towerId;
+        xtals.zs[k] = zs;
+      }
+      ptr.advance(blockLength);
+      return BLOCK_UNPACKED;
+    }
+
+    // the header, trigger and selective readout blocks of a FED, then its tower blocks, as in
+    // DCCEBEventBlock::unpack and DCCEEEventBlock::unpack: only the positions of the xtal blocks
+    // are recorded, their content is checked in parallel
+    __device__ void walkFed(
+        uint64_t const* data, uint32_t nWords, bool barrel, UnpackerParameters const& params, XtalBlocks& xtals) {
+      xtals.nXtals = 0;
+      if (nWords * 8 == EMPTYEVENTSIZE || nWords < HEADERLENGTH)
+        return;
+      uint32_t const blockLength = data[1] & H_EVLENGTH_MASK;
+      if (blockLength != nWords)
+        return;
+      uint32_t const triggerType = (data[0] >> H_TTYPE_B) & H_TTYPE_MASK;
+      if (triggerType != PHYSICTRIGGER && triggerType != CALIBRATIONTRIGGER)
+        return;
+
+      // if the selective readout is off, the zero suppression is that of the header; if it is on, it depends on
+      // the flags of the SRP block and all the towers are checked as zero suppressed
+      bool const sr = (data[3] >> H_SR_B) & B_MASK;
+      bool const zs = sr || (((data[3] >> H_ZS_B) & B_MASK) && !((data[3] >> H_TZS_B) & B_MASK));
+      uint32_t const srStatus = (data[3] >> H_SRCHSTATUS_B) & H_CHSTATUS_MASK;
+
+      FedPointer ptr{HEADERLENGTH - 1, blockLength - HEADERLENGTH};
+
+      // the trigger blocks: one of fixed length in the barrel, up to four in the endcap, with the pseudo-strips or not
+      for (uint32_t tcc = 0; tcc < (barrel ? 1 : 4); ++tcc) {
+        uint32_t const status = (data[3] >> (H_TCC1CHSTATUS_B + 4 * tcc)) & H_CHSTATUS_MASK;
+        if (status == CH_TIMEOUT || status == CH_DISABLED)
+          continue;
+        if (ptr.dwToEnd <= 1)
+          return;
+        uint32_t length = params.ebTccBlockLength;
+        if (!barrel) {
+          bool const ps = (data[ptr.last + 1] >> TCC_PS_B) & B_MASK;
+          uint32_t const nTps = NUMB_TTS_TPG1 + NUMB_TTS_TPG2 + (ps ? 2 * NUMB_PSEUDOSTRIPS : 0);
+          length = nTps / 4 + 2 + (nTps % 4 ? 1 : 0);
+        }
+        if (ptr.dwToEnd < length)
+          return;
+        ptr.advance(length);
+      }
+
+      if (srStatus != CH_TIMEOUT && srStatus != CH_DISABLED) {
+        if (ptr.dwToEnd < SRP_BLOCKLENGTH)
+          return;
+        ptr.advance(SRP_BLOCKLENGTH);
+      }
+
+      // the tower blocks, skipping to the next valid tower header after a corrupted one; the MEM blocks
+      // of the calibration events come after them
+      uint32_t nextTower = 1000;
+      FedPointer next = ptr;
+      for (uint32_t ch = 1; ch <= maxTowers; ++ch) {
+        uint32_t const status = (data[4 + (ch - 1) / 14] >> (4 * ((ch - 1) % 14))) & H_CHSTATUS_MASK;
+        if (!isStatusUnpacked(status))
+          continue;
+
+        FedPointer const previous = ptr;
+        if (ch >= nextTower) {
+          ptr = next;
+          nextTower = 1000;
+        }
+        int const result = unpackTower(data, ptr, ch, zs, params, xtals);
+        if (result == STOP_EVENT_UNPACKING)
+          return;
+        if (result == SKIP_BLOCK_UNPACKING) {
+          ptr = previous;
+          nextTower = nextTowerSearch(data, ptr, ch);
+          next = ptr;
+          ptr = previous;
+        }
+      }
+    }
+
+    __device__ constexpr uint16_t sample(uint64_t const* block, uint32_t i) {
+      // the 16-bit words of the block, the first one with the strip and xtal ids
+      return (block[(i + 1) / 4] >> (16 * ((i + 1) % 4))) & TOWER_DIGI_MASK;
+    }
+
+    __device__ bool validIds(uint64_t const* data, XtalBlocks const& xtals, uint32_t k) {
+      uint32_t const ids = data[xtals.offset[k]] & 0xFFFF;
+      uint32_t const strip = ids & TOWER_STRIPID_MASK;
+      uint32_t const xtal = (ids >> TOWER_XTALID_B) & TOWER_XTALID_MASK;
+      if (!xtals.zs[k]) {
+        // an xtal out of place is skipped
+        uint32_t const position = k - xtals.first[k];
+        return strip == position / NUMB_XTAL + 1 && xtal == position % NUMB_XTAL + 1;
+      }
+      if (strip == 0 || strip > NUMB_STRIP || xtal == 0 || xtal > NUMB_XTAL)
+        return false;
+      if (k == xtals.first[k])
+        return true;
+      uint32_t const lastIds = data[xtals.offset[k - 1]] & 0xFFFF;
+      uint32_t const lastStrip = lastIds & TOWER_STRIPID_MASK;
+      uint32_t const lastXtal = (lastIds >> TOWER_XTALID_B) & TOWER_XTALID_MASK;
+      return !((strip == lastStrip && xtal <= lastXtal) || strip < lastStrip);
+    }
+
+    // the gain zero of a saturated channel, or gain switches which stay for at least 5 samples
+    __device__ bool validGains(uint16_t const* samples) {
+      uint32_t firstGainZero = nXtalSamples;
+      for (uint32_t s = 0; s < nXtalSamples; ++s) {
+        if ((samples[s] >> 12) == 0) {
+          firstGainZero = s;
+          break;
+        }
+      }
+      if (firstGainZero < nXtalSamples) {
+        if (firstGainZero < 3)
+          return false;
+        uint32_t const plateauEnd = std::min(nXtalSamples, firstGainZero + 5);
+        for (uint32_t s = firstGainZero; s < plateauEnd; ++s) {
+          if (samples[s] != samples[firstGainZero])
+            return false;
+        }
+        return true;
+      }
+
+      uint32_t numGain = 1;
+      for (uint32_t s = 1; s < nXtalSamples; ++s) {
+        uint32_t const previous = samples[s - 1] >> 12;
+        uint32_t const current = samples[s] >> 12;
+        if (previous > current && numGain < 5)
+          return false;
+        numGain = previous == current ? numGain + 1 : 1;
+      }
+      return true;
+    }
+
+    __global__ void unpack(EcalElectronicsMappingOnGPU const* mapping,
+                           UnpackerParameters params,
+                           uint64_t const* words,
+                           uint32_t const* offsets,
+                           uint32_t const* dccIds,
+                           EcalDigiSoA* digis,
+                           UnpackedDigis* endcap) {
+      __shared__ XtalBlocks xtals;
+      __shared__ bool xtalIdOk[maxXtals];
+
+      uint32_t const fed = blockIdx.x;
+      uint32_t const dcc = dccIds[fed];
+      uint64_t const* data = words + offsets[fed];
+      bool const barrel = dcc > NUMB_SM_EE_MIN_MAX && dcc < NUMB_SM_EE_PLU_MIN;
+
+      if (threadIdx.x == 0)
+        walkFed(data, offsets[fed + 1] - offsets[fed], barrel, params, xtals);
+      __syncthreads();
+
+      uint32_t const nXtals = xtals.nXtals;
+      for (uint32_t k = threadIdx.x; k < nXtals; k += blockDim.x) {
+        xtalIdOk[k] = validIds(data, xtals, k);
+      }
+      __syncthreads();
+
+      for (uint32_t k = threadIdx.x; k < nXtals; k += blockDim.x) {
+        // in a zero suppressed tower, the xtals after an invalid id are not unpacked
+        bool valid = xtalIdOk[k];
+        for (uint32_t j = xtals.first[k]; valid && xtals.zs[k] && j < k; ++j)
+          valid = xtalIdOk[j];
+        uint32_t const tower = xtals.tower[k];
+        if (!valid || tower == 0 || tower > maxTowers)
+          continue;
+
+        uint64_t const* block = data + xtals.offset[k];
+        uint32_t const ids = block[0] & 0xFFFF;
+        uint32_t const i =
+            mappingIndex(dcc, tower, ids & TOWER_STRIPID_MASK, (ids >> TOWER_XTALID_B) & TOWER_XTALID_MASK);
+        uint32_t const rawId = mapping->rawId[i];
+        if (rawId == 0)
+          continue;
+
+        uint16_t samples[nXtalSamples];
+        for (uint32_t s = 0; s < nXtalSamples; ++s)
+          samples[s] = sample(block, s);
+        if (!validGains(samples))
+          continue;
+
+        uint32_t const channel = mapping->channel[i];
+        if (channel < EcalDigiSoA::nBarrelChannels) {
+          uint32_t const d = atomicAdd(&endcap->nBarrel, 1);
+          if (d >= EcalDigiSoA::nBarrelChannels)
+            continue;
+          digis->id[d] = rawId;
+          digis->channel[d] = channel;
+          for (uint32_t s = 0; s < nXtalSamples; ++s)
+            digis->samples[d][s] = samples[s];
+        } else {
+          uint32_t const d = atomicAdd(&endcap->nEndcap, 1);
+          if (d >= EcalDigiSoA::nEndcapChannels)
+            continue;
+          endcap->id[d] = rawId;
+          endcap->channel[d] = channel;
+          for (uint32_t s = 0; s < nXtalSamples; ++s)
+            endcap->samples[d][s] = samples[s];
+        }
+      }
+    }
+
+    __global__ void appendEndcap(UnpackedDigis const* endcap, EcalDigiSoA* digis) {
+      uint32_t const nBarrel = std::min(endcap->nBarrel, EcalDigiSoA::nBarrelChannels);
+      uint32_t const nEndcap = std::min(endcap->nEndcap, EcalDigiSoA::nEndcapChannels);
+      uint32_t const first = blockIdx.x * blockDim.x + threadIdx.x;
+      if (first == 0) {
+        digis->nBarrelDigis = nBarrel;
+        digis->nDigis = nBarrel + nEndcap;
+      }
+      for (uint32_t j = first; j < nEndcap; j += blockDim.x * gridDim.x) {
+        digis->id[nBarrel + j] = endcap->id[j];
+        digis->channel[nBarrel + j] = endcap->channel[j];
+        for (uint32_t s = 0; s < nXtalSamples; ++s)
+          digis->samples[nBarrel + j][s] = endcap->samples[j][s];
+      }
+    }
+
+  }  // namespace
+
+  EcalDigiCUDA makeDigisAsync(EcalElectronicsMappingOnGPU const* mapping,
+                              UnpackerParameters const& params,
+                              FedDataAppender const& fedData,
+                              cudaStream_t stream) {
+    uint32_t const nWords = fedData.size();
+    uint32_t const nFeds = fedData.nFeds();
+
+    // an xtal block is 3 words, the digis after the unpacking are at most as many
+    EcalDigiCUDA digis(stream);
+    digis.setNDigis(std::min(nWords / xtalBlockLength, EcalDigiSoA::maxDigis));
+
+    auto endcap_d = cms::cuda::make_device_unique<UnpackedDigis>(stream);
+    cudaCheck(cudaMemsetAsync(endcap_d.get(), 0, 2 * sizeof(uint32_t), stream));
+
+    if (nFeds > 0) {
+      auto data_d = cms::cuda::make_device_unique<unsigned char[]>(fedData.bytes(), stream);
+      cudaCheck(cudaMemcpyAsync(data_d.get(), fedData.data(), fedData.bytes(), cudaMemcpyHostToDevice, stream));
+
+      unpack<<<nFeds, nThreads, 0, stream>>>(mapping,
+                                             params,
+                                             FedDataAppender::wordsIn(data_d.get()),
+                                             FedDataAppender::offsetsIn(data_d.get()),
+                                             FedDataAppender::dccIdsIn(data_d.get()),
+                                             digis.get(),
+                                             endcap_d.get());
+      cudaCheck(cudaGetLastError());
+    }
+
+    uint32_t const blocks = (EcalDigiSoA::nEndcapChannels + nThreads - 1) / nThreads;
+    appendEndcap<<<blocks, nThreads, 0, stream>>>(endcap_d.get(), digis.get());
+    cudaCheck(cudaGetLastError());
+
+    return digis;
+  }
+
+}  // namespace ecalgpudetails
@@ -0,0 +1,90 @@
+#ifndef EventFilter_EcalRawToDigi_plugins_cuda_EcalRawToDigiGPUKernel_h
+#define EventFilter_EcalRawToDigi_plugins_cuda_EcalRawToDigiGPUKernel_h
+
+#include <cstdint>
+#include <cstring>
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiCUDA.h"
+#include "EventFilter/EcalRawToDigi/interface/EcalElectronicsMappingOnGPU.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/HostStagingRing.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+namespace ecalgpudetails {
+
+  struct UnpackerParameters {
+    uint32_t ebTccBlockLength;  // in 64-bit words, from the number of trigger samples
+    bool feIdCheck;
+  };
+
+  // The buffers of the ECAL FEDs of an event, staged one after the other in
+  // pinned memory with the DCC id of each, for a single copy to the device:
+  // the offsets of the FEDs and their DCC ids come first, then the words.
+  // The memory comes from the ring of the CUDAHostStagingService if given,
+  // from the caching host allocator otherwise.
+  class FedDataAppender {
+  public:
+    static constexpr size_t headerBytes = ((2 * MAX_DCC + 1) * sizeof(uint32_t) + 7) / 8 * 8;
+
+    FedDataAppender(uint32_t maxWords, cms::cuda::HostStagingRing* ring, cudaStream_t stream) {
+      size_t const bytes = headerBytes + maxWords * sizeof(uint64_t);
+      unsigned char* data;
+      if (ring) {
+        staging_ = ring->allocate(bytes, stream);
+        data = staging_.data();
+      } else {
+        buffer_ = cms::cuda::make_host_unique<unsigned char[]>(bytes, stream);
+        data = buffer_.get();
+      }
+      offsets_ = reinterpret_cast<uint32_t*>(data);
+      dccIds_ = offsets_ + MAX_DCC + 1;
+      words_ = reinterpret_cast<uint64_t*>(data + headerBytes);
+      offsets_[0] = 0;
+    }
+
+    void append(uint64_t const* words, uint32_t nWords, uint32_t dccId) {
+      std::memcpy(words_ + offsets_[nFeds_], words, sizeof(uint64_t) * nWords);
+      dccIds_[nFeds_] = dccId;
+      offsets_[nFeds_ + 1] = offsets_[nFeds_] + nWords;
+      ++nFeds_;
+    }
+
+    uint32_t size() const { return offsets_[nFeds_]; }
+    uint32_t nFeds() const { return nFeds_; }
+    uint64_t const* words() const { return words_; }
+    uint32_t const* offsets() const { return offsets_; }
+    uint32_t const* dccIds() const { return dccIds_; }
+
+    // the staged data to be copied to the device, of bytes() bytes
+    unsigned char const* data() const { return reinterpret_cast<unsigned char const*>(offsets_); }
+    size_t bytes() const { return headerBytes + size() * sizeof(uint64_t); }
+
+    // the offsets, DCC ids and words in a copy of data() on the device
+    static uint32_t const* offsetsIn(unsigned char const* data) { return reinterpret_cast<uint32_t const*>(data); }
+    static uint32_t const* dccIdsIn(unsigned char const* data) { return offsetsIn(data) + MAX_DCC + 1; }
+    static uint64_t const* wordsIn(unsigned char const* data) {
+      return reinterpret_cast<uint64_t const*>(data + headerBytes);
+    }
+
+  private:
+    cms::cuda::HostStagingRing::Buffer staging_;
+    cms::cuda::host::unique_ptr<unsigned char[]> buffer_;
+    uint32_t* offsets_;
+    uint32_t* dccIds_;
+    uint64_t* words_;
+    uint32_t nFeds_ = 0;
+  };
+
+  // Unpacks the xtal data of the FEDs on the device, with one block of
+  // threads per FED: the kernels are queued on the stream and the digis
+  // returned at once, to be used only in the work queued on the same
+  // stream. Their number on the host is an upper bound.
+  EcalDigiCUDA makeDigisAsync(EcalElectronicsMappingOnGPU const* mapping,
+                              UnpackerParameters const& params,
+                              FedDataAppender const& fedData,
+                              cudaStream_t stream);
+
+}  // namespace ecalgpudetails
+
+#endif
@@ -0,0 +1,4 @@
+#include "EventFilter/EcalRawToDigi/interface/EcalElectronicsMappingGPU.h"
+#include "FWCore/Utilities/interface/typelookup.h"
+
+TYPELOOKUP_DATA_REG(EcalElectronicsMappingGPU);
@@ -0,0 +1,45 @@
+#include "EventFilter/EcalRawToDigi/interface/EcalElectronicsMappingGPU.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalElectronicsId.h"
+#include "Geometry/EcalMapping/interface/EcalElectronicsMapping.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+EcalElectronicsMappingGPU::EcalElectronicsMappingGPU(EcalElectronicsMapping const& mapping)
+    : mappingHost_(cms::cuda::make_host_noncached_unique<EcalElectronicsMappingOnGPU>()) {
+  using namespace ecalgpudetails;
+
+  auto& map = *mappingHost_;
+  std::fill(std::begin(map.rawId), std::end(map.rawId), 0);
+  std::fill(std::begin(map.channel), std::end(map.channel), invalidChannel);
+
+  // every crystal is read out by one channel, the table is filled from the crystals
+  auto fill = [&](DetId const& id, uint32_t channel) {
+    EcalElectronicsId const elId = mapping.getElectronicsId(id);
+    uint32_t const i = mappingIndex(elId.dccId(), elId.towerId(), elId.stripId(), elId.xtalId());
+    map.rawId[i] = id.rawId();
+    map.channel[i] = channel;
+  };
+  for (int h = 0; h < EBDetId::kSizeForDenseIndexing; ++h) {
+    fill(EBDetId::unhashIndex(h), h);
+  }
+  for (int h = 0; h < EEDetId::kSizeForDenseIndexing; ++h) {
+    fill(EEDetId::unhashIndex(h), EcalDigiSoA::nBarrelChannels + h);
+  }
+}
+
+EcalElectronicsMappingOnGPU const* EcalElectronicsMappingGPU::getGPUProductAsync(cudaStream_t cudaStream) const {
+  auto const& data = gpuData_.dataForCurrentDeviceAsync(cudaStream, [this](GPUData& data, cudaStream_t stream) {
+    cudaCheck(cudaMalloc(&data.mappingDevice, sizeof(EcalElectronicsMappingOnGPU)));
+    cudaCheck(cudaMemcpyAsync(
+        data.mappingDevice, mappingHost_.get(), sizeof(EcalElectronicsMappingOnGPU), cudaMemcpyHostToDevice, stream));
+  });
+  return data.mappingDevice;
+}
+
+EcalElectronicsMappingGPU::GPUData::~GPUData() { cudaCheck(cudaFree(mappingDevice)); }
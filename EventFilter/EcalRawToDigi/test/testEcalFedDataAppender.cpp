@@ -0,0 +1,65 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <vector>
+
+#include "EventFilter/EcalRawToDigi/plugins/cuda/EcalRawToDigiGPUKernel.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/HostStagingRing.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
+
+namespace {
+  // stages three FEDs, copies them to the device with one copy and back, and checks what the unpacker would read
+  void checkStaging(cms::cuda::HostStagingRing* ring, cudaStream_t stream) {
+    std::vector<std::vector<uint64_t>> feds = {{1, 2, 3}, {}, {4, 5, 6, 7, 8}};
+    std::vector<uint32_t> const dccIds = {3, 10, 54};
+    ecalgpudetails::FedDataAppender fedData(8, ring, stream);
+    for (unsigned i = 0; i < feds.size(); ++i)
+      fedData.append(feds[i].data(), feds[i].size(), dccIds[i]);
+    REQUIRE(fedData.nFeds() == 3);
+    REQUIRE(fedData.size() == 8);
+    REQUIRE(fedData.bytes() == ecalgpudetails::FedDataAppender::headerBytes + 8 * sizeof(uint64_t));
+
+    auto data_d = cms::cuda::make_device_unique<unsigned char[]>(fedData.bytes(), stream);
+    cudaCheck(cudaMemcpyAsync(data_d.get(), fedData.data(), fedData.bytes(), cudaMemcpyHostToDevice, stream));
+    std::vector<unsigned char> data(fedData.bytes());
+    cudaCheck(cudaMemcpyAsync(data.data(), data_d.get(), data.size(), cudaMemcpyDeviceToHost, stream));
+    cudaCheck(cudaStreamSynchronize(stream));
+
+    using ecalgpudetails::FedDataAppender;
+    uint32_t const* offsets = FedDataAppender::offsetsIn(data.data());
+    uint64_t const* words = FedDataAppender::wordsIn(data.data());
+    for (unsigned i = 0; i < feds.size(); ++i) {
+      REQUIRE(FedDataAppender::dccIdsIn(data.data())[i] == dccIds[i]);
+      REQUIRE(offsets[i + 1] - offsets[i] == feds[i].size());
+      for (unsigned j = 0; j < feds[i].size(); ++j)
+        REQUIRE(words[offsets[i] + j] == feds[i][j]);
+    }
+  }
+}  // namespace
+
+TEST_CASE("FedDataAppender", "[EcalRawToDigiCUDA]") {
+  if (not cms::cudatest::testDevices()) {
+    return;
+  }
+
+  cudaStream_t stream;
+  cudaCheck(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+  SECTION("Staged in the ring") {
+    cms::cuda::HostStagingRing ring(1 << 16);
+    checkStaging(&ring, stream);
+    REQUIRE(ring.fallbacks() == 0);
+  }
+
+  SECTION("Staged in a ring too small") {
+    cms::cuda::HostStagingRing ring(128);
+    checkStaging(&ring, stream);
+    REQUIRE(ring.fallbacks() == 1);
+  }
+
+  SECTION("Staged without a ring") { checkStaging(nullptr, stream); }
+
+  cudaCheck(cudaStreamDestroy(stream));
+}
@@ -0,0 +1,65 @@
+#ifndef EventFilter_HcalRawToDigi_HcalSortedMerge_h
+#define EventFilter_HcalRawToDigi_HcalSortedMerge_h
+
+#include "DataFormats/HcalDigi/interface/HcalDigiCollections.h"
+
+#include <queue>
+#include <utility>
+#include <vector>
+
+/** Merge of the digis of the FEDs unpacked separately, each of them
+    sorted, into one collection sorted by id: the same digis, in the same
+    order, as the sort of the collection of all the FEDs, for unique ids.
+*/
+namespace hcal {
+
+  // Calls append for each digi of the collections, each of them sorted, in the order of their ids
+  template <class Collection, class Size, class Id, class Append>
+  void mergeSorted(const std::vector<const Collection*>& colls, Size size, Id id, Append append) {
+    typedef std::pair<unsigned, unsigned> Cursor;  // collection, digi
+    auto later = [&](const Cursor& a, const Cursor& b) {
+      return id(*colls[b.first], b.second) < id(*colls[a.first], a.second);
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heads(later);
+    for (unsigned i = 0; i < colls.size(); ++i)
+      if (size(*colls[i]) > 0)
+        heads.emplace(i, 0);
+    while (!heads.empty()) {
+      Cursor head = heads.top();
+      heads.pop();
+      append(*colls[head.first], head.second);
+      if (++head.second < size(*colls[head.first]))
+        heads.push(head);
+    }
+  }
+
+  template <class Digi>
+  void mergeDigis(const std::vector<const std::vector<Digi>*>& slabs, std::vector<Digi>& merged) {
+    size_t n = merged.size();
+    for (auto const* slab : slabs)
+      n += slab->size();
+    merged.reserve(n);
+    mergeSorted(
+        slabs,
+        [](const std::vector<Digi>& v) { return v.size(); },
+        [](const std::vector<Digi>& v, unsigned i) { return v[i].id(); },
+        [&merged](const std::vector<Digi>& v, unsigned i) { merged.push_back(v[i]); });
+  }
+
+  template <class Digi>
+  void mergeDigis(const std::vector<const HcalDataFrameContainer<Digi>*>& slabs, HcalDataFrameContainer<Digi>& merged) {
+    typedef HcalDataFrameContainer<Digi> Collection;
+    size_t n = merged.size();
+    for (auto const* slab : slabs)
+      n += slab->size();
+    merged.reserve(n);
+    mergeSorted(
+        slabs,
+        [](const Collection& c) { return c.size(); },
+        [](const Collection& c, unsigned i) { return c[i].id(); },
+        [&merged](const Collection& c, unsigned i) { merged.push_back(c[i].id(), c.frame(i)); });
+  }
+
+}  // namespace hcal
+
+#endif
@@ -8,9 +8,47 @@
 #include "CalibFormats/HcalObjects/interface/HcalDbService.h"
 #include "CalibFormats/HcalObjects/interface/HcalDbRecord.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "EventFilter/HcalRawToDigi/interface/HcalSortedMerge.h"
+#include <algorithm>
 #include <iostream>
 #include <unordered_set>
 
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace {
+
+  // Merges the QIE10 or QIE11 digis of the FEDs which have the number of
+  // samples of the first FED with such digis, the default collection of
+  // the serial unpacking. A FED which saw first digis of another number
+  // of samples has none in its default collection, but those requested
+  // with saveQIE10/11DataNSamples are kept in its additional collections.
+  template <class Collection>
+  void mergeQIE(const std::vector<const Collection*>& slabs,
+                Collection*& merged,
+                const std::unordered_map<int, Collection*>& addtl,
+                const char* type,
+                bool silent) {
+    std::vector<const Collection*> same;
+    for (auto const* slab : slabs) {
+      if (slab == nullptr)
+        continue;
+      if (merged == nullptr)
+        merged = new Collection(slab->samples());
+      if (slab->samples() == merged->samples())
+        same.push_back(slab);
+      else if (!silent && addtl.find(slab->samples()) == addtl.end())
+        edm::LogWarning("Invalid Data") << "The default " << type << " Collection has " << merged->samples()
+                                        << " samples per digi, while the current data has " << slab->samples()
+                                        << "!  This data cannot be included with the default collection.";
+    }
+    if (merged != nullptr)
+      hcal::mergeDigis(same, *merged);
+  }
+
+}  // namespace
+
 HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf)
     : unpacker_(conf.getUntrackedParameter<int>("HcalFirstFED", int(FEDNumbering::MINHCALFEDID)),
                 conf.getParameter<int>("firstSample"),
@@ -23,6 +61,7 @@ HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf)
       unpackZDC_(conf.getUntrackedParameter<bool>("UnpackZDC", false)),
       unpackTTP_(conf.getUntrackedParameter<bool>("UnpackTTP", false)),
       unpackUMNio_(conf.getUntrackedParameter<bool>("UnpackUMNio", false)),
+      unpackInParallel_(conf.getUntrackedParameter<bool>("UnpackInParallel", false)),
       saveQIE10DataNSamples_(conf.getUntrackedParameter<std::vector<int>>("saveQIE10DataNSamples", std::vector<int>())),
       saveQIE10DataTags_(
           conf.getUntrackedParameter<std::vector<std::string>>("saveQIE10DataTags", std::vector<std::string>())),
@@ -48,6 +87,11 @@ HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf)
 
   unpacker_.setExpectedOrbitMessageTime(expectedOrbitMessageTime_);
   unpacker_.setMode(unpackerMode_);
+  if (unpackInParallel_) {
+    fedSlabs_.reserve(fedUnpackList_.size());
+    for (unsigned int i = 0; i < fedUnpackList_.size(); i++)
+      fedSlabs_.emplace_back(unpacker_);
+  }
   std::ostringstream ss;
   for (unsigned int i = 0; i < fedUnpackList_.size(); i++)
     ss << fedUnpackList_[i] << " ";
@@ -156,6 +200,7 @@ void HcalRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.addUntracked<bool>("UnpackCalib", true);
   desc.addUntracked<bool>("UnpackUMNio", true);
   desc.addUntracked<bool>("UnpackTTP", true);
+  desc.addUntracked<bool>("UnpackInParallel", false);
   desc.addUntracked<bool>("silent", true);
   desc.addUntracked<std::vector<int>>("saveQIE10DataNSamples", std::vector<int>());
   desc.addUntracked<std::vector<std::string>>("saveQIE10DataTags", std::vector<std::string>());
@@ -234,32 +279,17 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es) {
   }
 
   // Step C: unpack all requested FEDs
-  for (std::vector<int>::const_iterator i = fedUnpackList_.begin(); i != fedUnpackList_.end(); i++) {
-    const FEDRawData& fed = rawraw->FEDData(*i);
-    if (fed.size() == 0) {
-      if (complainEmptyData_) {
-        if (!silent_)
-          edm::LogWarning("EmptyData") << "No data for FED " << *i;
-        report->addError(*i);
-      }
-    } else if (fed.size() < 8 * 3) {
-      if (!silent_)
-        edm::LogWarning("EmptyData") << "Tiny data " << fed.size() << " for FED " << *i;
-      report->addError(*i);
-    } else {
-      try {
-        unpacker_.unpack(fed, *readoutMap, colls, *report, silent_);
-        report->addUnpacked(*i);
-      } catch (cms::Exception& e) {
-        if (!silent_)
-          edm::LogWarning("Unpacking error") << e.what();
-        report->addError(*i);
-      } catch (...) {
-        if (!silent_)
-          edm::LogWarning("Unpacking exception");
-        report->addError(*i);
-      }
-    }
+  if (unpackInParallel_) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, fedUnpackList_.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          unpackFEDSlab(
+                              rawraw->FEDData(fedUnpackList_[i]), fedUnpackList_[i], *readoutMap, fedSlabs_[i]);
+                      });
+    mergeFEDSlabs(colls, *report);
+  } else {
+    for (std::vector<int>::const_iterator i = fedUnpackList_.begin(); i != fedUnpackList_.end(); i++)
+      unpackFED(rawraw->FEDData(*i), *i, unpacker_, *readoutMap, colls, *report);
   }
 
   // gather statistics
@@ -388,22 +418,25 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es) {
 
   // Step D: Put outputs into event
   // just until the sorting is proven
-  hbhe_prod->sort();
-  ho_prod->sort();
-  hf_prod->sort();
-  htp_prod->sort();
-  hotp_prod->sort();
-  qie10_prod->sort();
-  qie10ZDC_prod->sort();
-  qie10Lasermon_prod->sort();
-  qie11_prod->sort();
-
-  // sort the additional collections
-  for (auto& prod : qie10_prodAddtl) {
-    prod.second->sort();
-  }
-  for (auto& prod : qie11_prodAddtl) {
-    prod.second->sort();
+  // (the slabs of the FEDs unpacked in parallel are merged sorted)
+  if (!unpackInParallel_) {
+    hbhe_prod->sort();
+    ho_prod->sort();
+    hf_prod->sort();
+    htp_prod->sort();
+    hotp_prod->sort();
+    qie10_prod->sort();
+    qie10ZDC_prod->sort();
+    qie10Lasermon_prod->sort();
+    qie11_prod->sort();
+
+    // sort the additional collections
+    for (auto& prod : qie10_prodAddtl) {
+      prod.second->sort();
+    }
+    for (auto& prod : qie11_prodAddtl) {
+      prod.second->sort();
+    }
   }
 
   e.put(std::move(hbhe_prod));
@@ -437,7 +470,8 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es) {
       hc_prod->swap(filtered_calib);
     }
 
-    hc_prod->sort();
+    if (!unpackInParallel_)
+      hc_prod->sort();
     e.put(std::move(hc_prod));
   }
 
@@ -451,7 +485,8 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es) {
       prod->swap(filtered_zdc);
     }
 
-    prod->sort();
+    if (!unpackInParallel_)
+      prod->sort();
     e.put(std::move(prod));
   }
 
@@ -459,7 +494,8 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es) {
     auto prod = std::make_unique<HcalTTPDigiCollection>();
     prod->swap_contents(ttp);
 
-    prod->sort();
+    if (!unpackInParallel_)
+      prod->sort();
     e.put(std::move(prod));
   }
   e.put(std::move(report));
@@ -470,3 +506,157 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es) {
     }
   }
 }
+
+void HcalRawToDigi::unpackFED(const FEDRawData& fed,
+                              int fedId,
+                              HcalUnpacker& unpacker,
+                              const HcalElectronicsMap& readoutMap,
+                              HcalUnpacker::Collections& colls,
+                              HcalUnpackerReport& report) const {
+  if (fed.size() == 0) {
+    if (complainEmptyData_) {
+      if (!silent_)
+        edm::LogWarning("EmptyData") << "No data for FED " << fedId;
+      report.addError(fedId);
+    }
+  } else if (fed.size() < 8 * 3) {
+    if (!silent_)
+      edm::LogWarning("EmptyData") << "Tiny data " << fed.size() << " for FED " << fedId;
+    report.addError(fedId);
+  } else {
+    try {
+      unpacker.unpack(fed, readoutMap, colls, report, silent_);
+      report.addUnpacked(fedId);
+    } catch (cms::Exception& e) {
+      if (!silent_)
+        edm::LogWarning("Unpacking error") << e.what();
+      report.addError(fedId);
+    } catch (...) {
+      if (!silent_)
+        edm::LogWarning("Unpacking exception");
+      report.addError(fedId);
+    }
+  }
+}
+
+void HcalRawToDigi::unpackFEDSlab(const FEDRawData& fed,
+                                  int fedId,
+                                  const HcalElectronicsMap& readoutMap,
+                                  FEDSlab& slab) const {
+  slab.hbhe.clear();
+  slab.ho.clear();
+  slab.hf.clear();
+  slab.htp.clear();
+  slab.hc.clear();
+  slab.zdc.clear();
+  slab.ttp.clear();
+  slab.hotp.clear();
+  slab.umnio = HcalUMNioDigi();
+  slab.report = HcalUnpackerReport();
+
+  HcalUnpacker::Collections colls;
+  colls.hbheCont = &slab.hbhe;
+  colls.hoCont = &slab.ho;
+  colls.hfCont = &slab.hf;
+  colls.tpCont = &slab.htp;
+  colls.tphoCont = &slab.hotp;
+  colls.calibCont = &slab.hc;
+  colls.zdcCont = &slab.zdc;
+  colls.umnio = &slab.umnio;
+  if (unpackTTP_)
+    colls.ttp = &slab.ttp;
+  for (const auto& info : saveQIE10Info_) {
+    slab.qie10Addtl[info.first] = std::make_unique<QIE10DigiCollection>(info.first);
+    colls.qie10Addtl[info.first] = slab.qie10Addtl[info.first].get();
+  }
+  for (const auto& info : saveQIE11Info_) {
+    slab.qie11Addtl[info.first] = std::make_unique<QIE11DigiCollection>(info.first);
+    colls.qie11Addtl[info.first] = slab.qie11Addtl[info.first].get();
+  }
+
+  unpackFED(fed, fedId, slab.unpacker, readoutMap, colls, slab.report);
+
+  slab.qie10.reset(colls.qie10);
+  slab.qie10ZDC.reset(colls.qie10ZDC);
+  slab.qie10Lasermon.reset(colls.qie10Lasermon);
+  slab.qie11.reset(colls.qie11);
+
+  // the digis of a FED are sorted here, in its task, and merged in order
+  std::sort(slab.hbhe.begin(), slab.hbhe.end(), edm::StrictWeakOrdering<HBHEDataFrame>());
+  std::sort(slab.ho.begin(), slab.ho.end(), edm::StrictWeakOrdering<HODataFrame>());
+  std::sort(slab.hf.begin(), slab.hf.end(), edm::StrictWeakOrdering<HFDataFrame>());
+  std::sort(slab.htp.begin(), slab.htp.end(), edm::StrictWeakOrdering<HcalTriggerPrimitiveDigi>());
+  std::sort(slab.hc.begin(), slab.hc.end(), edm::StrictWeakOrdering<HcalCalibDataFrame>());
+  std::sort(slab.zdc.begin(), slab.zdc.end(), edm::StrictWeakOrdering<ZDCDataFrame>());
+  std::sort(slab.ttp.begin(), slab.ttp.end(), edm::StrictWeakOrdering<HcalTTPDigi>());
+  std::sort(slab.hotp.begin(), slab.hotp.end(), edm::StrictWeakOrdering<HOTriggerPrimitiveDigi>());
+  for (auto* qie : {slab.qie10.get(), slab.qie10ZDC.get(), slab.qie10Lasermon.get()})
+    if (qie != nullptr)
+      qie->sort();
+  if (slab.qie11)
+    slab.qie11->sort();
+  for (auto& qie : slab.qie10Addtl)
+    qie.second->sort();
+  for (auto& qie : slab.qie11Addtl)
+    qie.second->sort();
+}
+
+void HcalRawToDigi::mergeFEDSlabs(HcalUnpacker::Collections& colls, HcalUnpackerReport& report) const {
+  std::vector<const std::vector<HBHEDataFrame>*> hbhe;
+  std::vector<const std::vector<HODataFrame>*> ho;
+  std::vector<const std::vector<HFDataFrame>*> hf;
+  std::vector<const std::vector<HcalTriggerPrimitiveDigi>*> htp;
+  std::vector<const std::vector<HcalCalibDataFrame>*> hc;
+  std::vector<const std::vector<ZDCDataFrame>*> zdc;
+  std::vector<const std::vector<HcalTTPDigi>*> ttp;
+  std::vector<const std::vector<HOTriggerPrimitiveDigi>*> hotp;
+  std::vector<const QIE10DigiCollection*> qie10, qie10ZDC, qie10Lasermon;
+  std::vector<const QIE11DigiCollection*> qie11;
+  // the FEDs are merged in the order of the serial unpacking
+  for (const auto& slab : fedSlabs_) {
+    hbhe.push_back(&slab.hbhe);
+    ho.push_back(&slab.ho);
+    hf.push_back(&slab.hf);
+    htp.push_back(&slab.htp);
+    hc.push_back(&slab.hc);
+    zdc.push_back(&slab.zdc);
+    ttp.push_back(&slab.ttp);
+    hotp.push_back(&slab.hotp);
+    qie10.push_back(slab.qie10.get());
+    qie10ZDC.push_back(slab.qie10ZDC.get());
+    qie10Lasermon.push_back(slab.qie10Lasermon.get());
+    qie11.push_back(slab.qie11.get());
+    // the last uMNio digi found, as the serial unpacking keeps it
+    if (!slab.umnio.invalid())
+      *colls.umnio = slab.umnio;
+    report.merge(slab.report);
+  }
+
+  hcal::mergeDigis(hbhe, *colls.hbheCont);
+  hcal::mergeDigis(ho, *colls.hoCont);
+  hcal::mergeDigis(hf, *colls.hfCont);
+  hcal::mergeDigis(htp, *colls.tpCont);
+  hcal::mergeDigis(hc, *colls.calibCont);
+  hcal::mergeDigis(zdc, *colls.zdcCont);
+  if (colls.ttp != nullptr)
+    hcal::mergeDigis(ttp, *colls.ttp);
+  hcal::mergeDigis(hotp, *colls.tphoCont);
+
+  mergeQIE(qie10, colls.qie10, colls.qie10Addtl, "QIE10", silent_);
+  mergeQIE(qie10ZDC, colls.qie10ZDC, {}, "QIE10ZDC", silent_);
+  mergeQIE(qie10Lasermon, colls.qie10Lasermon, {}, "QIE10LASMON", silent_);
+  mergeQIE(qie11, colls.qie11, colls.qie11Addtl, "QIE11", silent_);
+
+  for (auto& addtl : colls.qie10Addtl) {
+    std::vector<const QIE10DigiCollection*> slabs;
+    for (const auto& slab : fedSlabs_)
+      slabs.push_back(slab.qie10Addtl.at(addtl.first).get());
+    hcal::mergeDigis(slabs, *addtl.second);
+  }
+  for (auto& addtl : colls.qie11Addtl) {
+    std::vector<const QIE11DigiCollection*> slabs;
+    for (const auto& slab : fedSlabs_)
+      slabs.push_back(slab.qie11Addtl.at(addtl.first).get());
+    hcal::mergeDigis(slabs, *addtl.second);
+  }
+}
@@ -26,6 +26,10 @@
 
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 class HcalRawToDigi : public edm::stream::EDProducer<> {
 public:
   explicit HcalRawToDigi(const edm::ParameterSet& ps);
@@ -34,6 +38,41 @@ public:
   void produce(edm::Event&, const edm::EventSetup&) override;
 
 private:
+  // The digis of one FED, when the FEDs are unpacked in parallel. The
+  // slabs are kept from one event to the next, with the capacity of
+  // their vectors, and each has its own unpacker, which remembers the
+  // electronics ids already reported as unmapped.
+  struct FEDSlab {
+    explicit FEDSlab(const HcalUnpacker& iUnpacker) : unpacker(iUnpacker) {}
+
+    HcalUnpacker unpacker;
+    std::vector<HBHEDataFrame> hbhe;
+    std::vector<HODataFrame> ho;
+    std::vector<HFDataFrame> hf;
+    std::vector<HcalTriggerPrimitiveDigi> htp;
+    std::vector<HcalCalibDataFrame> hc;
+    std::vector<ZDCDataFrame> zdc;
+    std::vector<HcalTTPDigi> ttp;
+    std::vector<HOTriggerPrimitiveDigi> hotp;
+    HcalUMNioDigi umnio;
+    std::unique_ptr<QIE10DigiCollection> qie10, qie10ZDC, qie10Lasermon;
+    std::unique_ptr<QIE11DigiCollection> qie11;
+    std::unordered_map<int, std::unique_ptr<QIE10DigiCollection>> qie10Addtl;
+    std::unordered_map<int, std::unique_ptr<QIE11DigiCollection>> qie11Addtl;
+    HcalUnpackerReport report;
+  };
+
+  void unpackFED(const FEDRawData& fed,
+                 int fedId,
+                 HcalUnpacker& unpacker,
+                 const HcalElectronicsMap& readoutMap,
+                 HcalUnpacker::Collections& colls,
+                 HcalUnpackerReport& report) const;
+  // unpacks a FED into its slab, sorted
+  void unpackFEDSlab(const FEDRawData& fed, int fedId, const HcalElectronicsMap& readoutMap, FEDSlab& slab) const;
+  // merges the sorted slabs into the collections of all the FEDs
+  void mergeFEDSlabs(HcalUnpacker::Collections& colls, HcalUnpackerReport& report) const;
+
   edm::EDGetTokenT<FEDRawDataCollection> tok_data_;
   HcalUnpacker unpacker_;
   HcalDataFrameFilter filter_;
@@ -41,6 +80,7 @@ private:
   const int firstFED_;
   const bool unpackCalib_, unpackZDC_, unpackTTP_;
   bool unpackUMNio_;
+  const bool unpackInParallel_;
 
   // input configs for additional QIE10 samples
   std::vector<int> saveQIE10DataNSamples_;
@@ -59,6 +99,9 @@ private:
   std::unordered_map<int, std::string> saveQIE10Info_;
   std::unordered_map<int, std::string> saveQIE11Info_;
 
+  // one per FED of fedUnpackList_, when unpackInParallel_
+  std::vector<FEDSlab> fedSlabs_;
+
   struct Statistics {
     int max_hbhe, ave_hbhe;
     int max_ho, ave_ho;
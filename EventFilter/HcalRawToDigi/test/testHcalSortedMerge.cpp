@@ -0,0 +1,134 @@
+// The digis and the report of FEDs unpacked separately, merged as HcalRawToDigi does with UnpackInParallel,
+// are those of the serial unpacking: all the FEDs in one collection, sorted at the end.
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
+#include "DataFormats/HcalDigi/interface/HcalDigiCollections.h"
+#include "DataFormats/HcalDigi/interface/HcalUnpackerReport.h"
+#include "EventFilter/HcalRawToDigi/interface/HcalSortedMerge.h"
+
+namespace {
+  int failures = 0;
+
+  void check(bool condition, const char* what) {
+    if (not condition) {
+      std::cerr << "failed: " << what << std::endl;
+      ++failures;
+    }
+  }
+
+  // the digis of 3 FEDs, in the order of the readout: the ids of the FEDs interleave
+  const int kNFEDs = 3;
+  const int kPerFED = 6;
+
+  HcalDetId id(int fed, int i) { return HcalDetId(HcalBarrel, 1 + (7 * i + fed) % 16, 1 + 2 * i + fed, 1); }
+
+  HBHEDataFrame hbhe(int fed, int i) {
+    HBHEDataFrame digi(id(fed, i));
+    digi.setSize(4);
+    for (int s = 0; s < 4; s++)
+      digi.setSample(s, HcalQIESample(10 * fed + i + s, s % 4, fed, 0));
+    return digi;
+  }
+
+  void addQIE11(QIE11DigiCollection& coll, int fed, int i) {
+    std::vector<uint16_t> words(coll.stride());
+    for (unsigned int w = 0; w < words.size(); w++)
+      words[w] = 100 * fed + 10 * i + w;
+    coll.addDataFrame(id(fed, i), words.data());
+  }
+}  // namespace
+
+int main() {
+  // ---------- digis in vectors, as HBHE
+
+  HBHEDigiCollection serial;
+  std::vector<std::vector<HBHEDataFrame>> slabs(kNFEDs);
+  for (int fed = 0; fed < kNFEDs; fed++) {
+    for (int i = 0; i < kPerFED; i++) {
+      serial.push_back(hbhe(fed, i));
+      slabs[fed].push_back(hbhe(fed, i));
+    }
+  }
+  serial.sort();
+
+  std::vector<const std::vector<HBHEDataFrame>*> sorted;
+  for (auto& slab : slabs) {
+    std::sort(slab.begin(), slab.end(), edm::StrictWeakOrdering<HBHEDataFrame>());
+    sorted.push_back(&slab);
+  }
+  // an empty FED
+  std::vector<HBHEDataFrame> empty;
+  sorted.push_back(&empty);
+  std::vector<HBHEDataFrame> merged;
+  hcal::mergeDigis(sorted, merged);
+
+  check(merged.size() == serial.size(), "number of HBHE digis");
+  for (unsigned int i = 0; i < std::min(merged.size(), serial.size()); i++) {
+    check(merged[i].id() == serial[i].id() && merged[i].size() == serial[i].size(), "HBHE digi ids");
+    for (int s = 0; s < merged[i].size(); s++)
+      check(merged[i][s].raw() == serial[i][s].raw(), "HBHE digi samples");
+  }
+
+  // ---------- digis in a data frame container, as QIE11
+
+  QIE11DigiCollection serialQIE(8);
+  std::vector<QIE11DigiCollection> slabsQIE(kNFEDs, QIE11DigiCollection(8));
+  for (int fed = 0; fed < kNFEDs; fed++) {
+    for (int i = 0; i < kPerFED; i++) {
+      addQIE11(serialQIE, fed, i);
+      addQIE11(slabsQIE[fed], fed, i);
+    }
+  }
+  serialQIE.sort();
+
+  std::vector<const QIE11DigiCollection*> sortedQIE;
+  for (auto& slab : slabsQIE) {
+    slab.sort();
+    sortedQIE.push_back(&slab);
+  }
+  QIE11DigiCollection mergedQIE(8);
+  hcal::mergeDigis(sortedQIE, mergedQIE);
+
+  check(mergedQIE.size() == serialQIE.size(), "number of QIE11 digis");
+  for (unsigned int i = 0; i < std::min(mergedQIE.size(), serialQIE.size()); i++) {
+    check(mergedQIE[i].id() == serialQIE[i].id(), "QIE11 digi ids");
+    check(std::equal(mergedQIE[i].begin(), mergedQIE[i].end(), serialQIE[i].begin()), "QIE11 digi words");
+  }
+
+  // ---------- the reports of the FEDs
+
+  HcalUnpackerReport serialReport, mergedReport;
+  for (int fed = 0; fed < kNFEDs; fed++) {
+    HcalUnpackerReport report;
+    for (auto* r : {&serialReport, &report}) {
+      for (int i = 0; i < kPerFED; i++)
+        r->countDigi();
+      r->countTPDigi(fed == 1);
+      if (fed == 2) {
+        r->countBadQualityDigi(id(fed, 0));
+        r->addError(700 + fed);
+      } else {
+        r->addUnpacked(700 + fed);
+      }
+    }
+    mergedReport.merge(report);
+  }
+  check(mergedReport.getFedsUnpacked() == serialReport.getFedsUnpacked(), "FEDs unpacked");
+  check(mergedReport.getFedsError() == serialReport.getFedsError(), "FEDs in error");
+  check(mergedReport.totalDigis() == serialReport.totalDigis() &&
+            mergedReport.totalTPDigis() == serialReport.totalTPDigis() &&
+            mergedReport.totalHOTPDigis() == serialReport.totalHOTPDigis() &&
+            mergedReport.badQualityDigis() == serialReport.badQualityDigis(),
+        "counts of the report");
+  check(std::equal(mergedReport.bad_quality_begin(),
+                   mergedReport.bad_quality_end(),
+                   serialReport.bad_quality_begin(),
+                   serialReport.bad_quality_end()),
+        "bad quality ids");
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -85,6 +85,9 @@ namespace evf {
     std::string getOpenInputJsonFilePath(const unsigned int ls, const unsigned int index) const;
     std::string getDatFilePath(const unsigned int ls, std::string const& stream) const;
     std::string getOpenDatFilePath(const unsigned int ls, std::string const& stream) const;
+    //sub-file written by one of the framework streams
+    std::string getDatFilePath(const unsigned int ls, std::string const& stream, const unsigned int part) const;
+    std::string getOpenDatFilePath(const unsigned int ls, std::string const& stream, const unsigned int part) const;
     std::string getOpenOutputJsonFilePath(const unsigned int ls, std::string const& stream) const;
     std::string getOutputJsonFilePath(const unsigned int ls, std::string const& stream) const;
     std::string getMergedDatFilePath(const unsigned int ls, std::string const& stream) const;
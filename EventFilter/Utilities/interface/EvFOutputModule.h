@@ -2,13 +2,17 @@
 #define EventFilter_Utilities_EvFOutputModule_h
 
 #include "IOPool/Streamer/interface/StreamerOutputFile.h"
-#include "FWCore/Framework/interface/one/OutputModule.h"
+#include "FWCore/Framework/interface/global/OutputModule.h"
 #include "IOPool/Streamer/interface/StreamerOutputModuleCommon.h"
 #include "FWCore/Utilities/interface/EDGetToken.h"
 
 #include "EventFilter/Utilities/interface/JsonMonitorable.h"
 #include "EventFilter/Utilities/interface/FastMonitor.h"
-#
+
+#include <memory>
+#include <string>
+#include <vector>
+
 typedef edm::detail::TriggerResultsBasedEventSelector::handle_t Trig;
 
 namespace evf {
@@ -43,13 +47,36 @@ namespace evf {
     edm::propagate_const<std::unique_ptr<StreamerOutputFile>> stream_writer_events_;
   };
 
-  class EvFOutputJSONWriter {
+  //the .dat files of a lumi, one per framework stream, so that the streams write in parallel
+  class EvFOutputLumiWriter {
   public:
-    EvFOutputJSONWriter(edm::ParameterSet const& ps,
-                        edm::SelectedProducts const* selections,
-                        std::string const& streamLabel);
+    EvFOutputLumiWriter(unsigned int ls, unsigned int nStreams) : ls_(ls), writers_(nStreams) {}
+
+    unsigned int ls() const { return ls_; }
+    //opens the file of the stream at its first event, only the stream itself uses its file
+    EvFOutputEventWriter& writer(unsigned int streamIndex, std::string const& streamLabel) const;
+    std::vector<std::unique_ptr<EvFOutputEventWriter>>& writers() const { return writers_; }
 
-    edm::StreamerOutputModuleCommon streamerCommon_;
+  private:
+    unsigned int ls_;
+    mutable std::vector<std::unique_ptr<EvFOutputEventWriter>> writers_;
+  };
+
+  //output definition file and merging parameters of the stream, set up once per run
+  class EvFOutputJSONDef {
+  public:
+    explicit EvFOutputJSONDef(std::string const& streamLabel);
+
+    static void fillDefinition(jsoncollector::DataPointDefinition& def);
+
+    std::string outJsonDefName_;
+    std::string transferDestination_;
+    std::string mergeType_;
+  };
+
+  class EvFOutputJSONWriter {
+  public:
+    explicit EvFOutputJSONWriter(EvFOutputJSONDef const& jsonDef);
 
     jsoncollector::IntJ processed_;
     jsoncollector::IntJ accepted_;
@@ -66,7 +93,8 @@ namespace evf {
     jsoncollector::DataPointDefinition outJsonDef_;
   };
 
-  typedef edm::one::OutputModule<edm::one::WatchRuns, edm::LuminosityBlockCache<evf::EvFOutputEventWriter>>
+  typedef edm::global::OutputModule<edm::RunCache<evf::EvFOutputJSONDef>,
+                                    edm::LuminosityBlockCache<evf::EvFOutputLumiWriter>>
       EvFOutputModuleType;
 
   class EvFOutputModule : public EvFOutputModuleType {
@@ -76,17 +104,19 @@ namespace evf {
     static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
 
   private:
-    void beginRun(edm::RunForOutput const& run) override;
+    void preallocStreams(unsigned int nStreams) override;
     void write(edm::EventForOutput const& e) override;
 
     //pure in parent class but unused here
     void writeLuminosityBlock(edm::LuminosityBlockForOutput const&) override {}
     void writeRun(edm::RunForOutput const&) override {}
-    void endRun(edm::RunForOutput const&) override {}
 
-    std::shared_ptr<EvFOutputEventWriter> globalBeginLuminosityBlock(
+    std::shared_ptr<EvFOutputJSONDef> globalBeginRun(edm::RunForOutput const& run) const override;
+    void globalEndRun(edm::RunForOutput const&) const override {}
+
+    std::shared_ptr<EvFOutputLumiWriter> globalBeginLuminosityBlock(
         edm::LuminosityBlockForOutput const& iLB) const override;
-    void globalEndLuminosityBlock(edm::LuminosityBlockForOutput const& iLB) override;
+    void globalEndLuminosityBlock(edm::LuminosityBlockForOutput const& iLB) const override;
 
     Trig getTriggerResults(edm::EDGetTokenT<edm::TriggerResults> const& token, edm::EventForOutput const& e) const;
 
@@ -96,7 +126,8 @@ namespace evf {
 
     evf::FastMonitoringService* fms_;
 
-    std::unique_ptr<evf::EvFOutputJSONWriter> jsonWriter_;
+    //serializer and its buffer for each framework stream
+    std::vector<std::unique_ptr<edm::StreamerOutputModuleCommon>> streamerCommon_;
 
   };  //end-of-class-def
 
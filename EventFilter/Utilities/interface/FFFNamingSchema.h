@@ -78,6 +78,17 @@ namespace fffnaming {
     return ss.str();
   }
 
+  inline std::string streamerDataFileNameWithPid(const unsigned int run,
+                                                 const unsigned int ls,
+                                                 std::string const& stream,
+                                                 const unsigned int part) {
+    std::stringstream ss;
+    runLumiPrefixFill(ss, run, ls);
+    ss << "_" << stream << "_pid" << std::setfill('0') << std::setw(5) << getpid() << "_part" << std::setw(2) << part
+       << ".dat";
+    return ss.str();
+  }
+
   inline std::string streamerDataFileNameWithInstance(const unsigned int run,
                                                       const unsigned int ls,
                                                       std::string const& stream,
@@ -15,6 +15,8 @@
 #include "EventFilter/Utilities/interface/MicroStateService.h"
 #include "EventFilter/Utilities/interface/FastMonitoringThread.h"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -66,6 +68,20 @@ namespace evf {
     std::atomic<T> m_value;
   };
 
+  //states of a stream written at every module transition, alone in a cache line so that the streams do
+  //not invalidate each other's lines. They are read by the monitoring thread without locking.
+  struct alignas(64) StreamState {
+    std::atomic<const void*> ministate_{nullptr};
+    std::atomic<const void*> microstate_{nullptr};
+    //events processed by the stream, summed by the monitoring thread
+    std::atomic<unsigned long> processed_{0};
+
+    void setMinistate(const void* iState) { ministate_.store(iState, std::memory_order_relaxed); }
+    void setMicrostate(const void* iState) { microstate_.store(iState, std::memory_order_relaxed); }
+    const void* ministate() const { return ministate_.load(std::memory_order_relaxed); }
+    const void* microstate() const { return microstate_.load(std::memory_order_relaxed); }
+  };
+
   class FastMonitoringService : public MicroStateService {
     struct Encoding {
       Encoding(unsigned int res) : reserved_(res), current_(reserved_), currentReserved_(0) {
@@ -192,7 +208,8 @@ namespace evf {
       while (!fmt_.m_stoprequest) {
         edm::LogInfo("FastMonitoringService")
             << "Current states: Ms=" << fmt_.m_data.fastMacrostateJ_.value()
-            << " ms=" << encPath_[0].encode(ministate_[0]) << " us=" << encModule_.encode(microstate_[0])
+            << " ms=" << encPath_[0].encode(streamStates_[0].ministate())
+            << " us=" << encModule_.encode(streamStates_[0].microstate())
             << " is=" << inputStateNames[inputState_] << " iss=" << inputStateNames[inputSupervisorState_] << std::endl;
 
         {
@@ -256,8 +273,7 @@ namespace evf {
     std::atomic<FastMonitoringThread::Macrostate> macrostate_;
 
     //per stream
-    std::vector<ContainableAtomic<const void*>> ministate_;
-    std::vector<ContainableAtomic<const void*>> microstate_;
+    std::unique_ptr<StreamState[]> streamStates_;
     std::vector<ContainableAtomic<const void*>> threadMicrostate_;
 
     //variables measuring source statistics (global)
@@ -285,8 +301,6 @@ namespace evf {
 
     bool threadIDAvailable_ = false;
 
-    std::atomic<unsigned long> totalEventsProcessed_;
-
     std::string moduleLegendFile_;
     std::string moduleLegendFileJson_;
     std::string pathLegendFile_;
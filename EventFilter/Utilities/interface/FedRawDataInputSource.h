@@ -55,6 +55,7 @@ private:
   evf::EvFDaqDirector::FileStatus nextEvent();
   evf::EvFDaqDirector::FileStatus getNextEvent();
   edm::Timestamp fillFEDRawDataCollection(FEDRawDataCollection&);
+  uint32_t eventChecksum(bool useCrc32c) const;
 
   void readSupervisor();
   void readWorker(unsigned int tid);
@@ -92,6 +93,8 @@ private:
   const bool alwaysStartFromFirstLS_;
   const bool verifyChecksum_;
   const bool useL1EventID_;
+  const unsigned int numAssemblyTasks_;  // parallel tasks for checksum and FED copies of an event
+  const unsigned int ioUringQueueDepth_;  // reads in flight per reader thread, 0 for blocking read()
   std::vector<std::string> fileNames_;
   bool useFileBroker_;
   //std::vector<std::string> fileNamesSorted_;
@@ -139,6 +142,7 @@ private:
   std::vector<ReaderInfo> workerJob_;
 
   tbb::concurrent_queue<InputChunk*> freeChunks_;
+  std::vector<std::pair<unsigned char*, size_t>> chunkBuffers_;  // indexed by InputChunk::index_
   tbb::concurrent_queue<std::unique_ptr<InputFile>> fileQueue_;
 
   std::mutex mReader_;
@@ -0,0 +1,88 @@
+#ifndef EventFilter_Utilities_UringReader_h
+#define EventFilter_Utilities_UringReader_h
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace evf {
+
+  /*
+   * Reader of file chunks using the io_uring interface of the Linux
+   * kernel, called directly with the system calls.
+   *
+   * A chunk is read in blocks, keeping up to queueDepth reads in flight
+   * with a single system call per batch of submissions and completions,
+   * instead of one blocking read() per block. The chunk buffers can be
+   * registered with the kernel, which then reads directly into them
+   * without mapping the pages for every request. If registering them
+   * fails, e.g. because of the limit of locked memory, the reads go
+   * to the same buffers without registration.
+   *
+   * An instance must only be used by one thread at a time.
+   */
+  class UringReader {
+  public:
+    UringReader() = default;
+    ~UringReader();
+
+    UringReader(const UringReader&) = delete;
+    UringReader& operator=(const UringReader&) = delete;
+
+    // Sets up the ring and registers the buffers, returns false with errno
+    // set if io_uring is not available
+    bool init(unsigned int queueDepth, std::vector<std::pair<unsigned char*, size_t>> const& buffers);
+    bool valid() const { return ringFd_ >= 0; }
+    bool registeredBuffers() const { return fixed_; }
+
+    // Reads size bytes from the offset of fd into buf, which is within the
+    // registered buffer bufIndex, in requests of at most blockSize bytes.
+    // Returns the number of bytes read, less than size if the end of the
+    // file is reached, or -1 with errno set. It only returns once none of
+    // its reads is in flight any more, also after an error.
+    ssize_t read(int fd, unsigned int bufIndex, unsigned char* buf, size_t size, off_t offset, size_t blockSize);
+
+  private:
+    struct Request {
+      size_t pos;
+      size_t len;
+      struct iovec iov;
+    };
+
+    void queue(int fd, unsigned int bufIndex, unsigned char* buf, off_t offset, unsigned int slot);
+    void withdraw();
+    void release();
+
+    int ringFd_ = -1;
+    bool fixed_ = false;
+    unsigned int depth_ = 0;
+
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    size_t cqRingSize_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqesSize_ = 0;
+
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqMask_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned* cqMask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::vector<Request> requests_;
+  };
+
+}  // namespace evf
+
+#endif
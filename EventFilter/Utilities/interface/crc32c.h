@@ -5,6 +5,7 @@
 #include <cstddef>
 
 uint32_t crc32c(uint32_t crc, const unsigned char *buf, size_t len);
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2);
 bool crc32c_hw_test();
 
 #endif
@@ -0,0 +1,78 @@
+#include "EventFilter/Utilities/plugins/FRDSharedMemorySource.h"
+#include "EventFilter/Utilities/plugins/FRDStreamSource.h"
+
+#include "IOPool/Streamer/interface/FRDEventMessage.h"
+
+#include "FWCore/Framework/interface/InputSourceMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <chrono>
+#include <thread>
+
+FRDSharedMemorySource::FRDSharedMemorySource(edm::ParameterSet const& pset, edm::InputSourceDescription const& desc)
+    : ProducerSourceBase(pset, desc, true),
+      ringName_(pset.getUntrackedParameter<std::string>("ringName", "FRDEventRing")),
+      openTimeoutSeconds_(pset.getUntrackedParameter<unsigned int>("openTimeoutSeconds", 60)),
+      idleTimeoutSeconds_(pset.getUntrackedParameter<unsigned int>("idleTimeoutSeconds", 0)),
+      verifyAdler32_(pset.getUntrackedParameter<bool>("verifyAdler32", true)),
+      verifyChecksum_(pset.getUntrackedParameter<bool>("verifyChecksum", true)),
+      useL1EventID_(pset.getUntrackedParameter<bool>("useL1EventID", false)) {
+  produces<FEDRawDataCollection>();
+}
+
+bool FRDSharedMemorySource::openRing() {
+  //the BU creates the ring when it starts, which can be after the FUs
+  for (unsigned int waited = 0; !ring_; waited++) {
+    try {
+      ring_ = std::make_unique<edm::shared_memory::EventRingReader>(ringName_);
+    } catch (boost::interprocess::interprocess_exception const&) {
+      if (waited >= openTimeoutSeconds_)
+        return false;
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+  edm::LogInfo("FRDSharedMemorySource") << "reading events from the ring " << ringName_;
+  return true;
+}
+
+bool FRDSharedMemorySource::setRunAndEventInfo(edm::EventID& id,
+                                               edm::TimeValue_t& theTime,
+                                               edm::EventAuxiliary::ExperimentType& eType) {
+  using edm::shared_memory::EventRingReader;
+  if (!ring_ && !openRing())
+    throw cms::Exception("FRDSharedMemorySource::setRunAndEventInfo")
+        << "the event ring " << ringName_ << " was not created within " << openTimeoutSeconds_ << " seconds";
+
+  EventRingReader::Event event;
+  EventRingReader::Status status;
+  unsigned int idle = 0;
+  while ((status = ring_->next(event, std::chrono::seconds(1))) == EventRingReader::Status::kTimeout) {
+    if (idleTimeoutSeconds_ && ++idle >= idleTimeoutSeconds_) {
+      edm::LogWarning("FRDSharedMemorySource") << "no event in the ring " << ringName_ << " for " << idle << " s";
+      return false;
+    }
+  }
+  if (status == EventRingReader::Status::kStopped)
+    return false;
+
+  //the view only reads the event, which stays in the ring until it is copied into the collection
+  FRDEventMsgView frdEventMsg(const_cast<char*>(event.data_));
+  if (frdEventMsg.size() > event.size_)
+    throw cms::Exception("FRDSharedMemorySource::setRunAndEventInfo")
+        << "truncated event of " << event.size_ << " bytes, expected " << frdEventMsg.size();
+
+  rawData_ = std::make_unique<FEDRawDataCollection>();
+  FRDStreamSource::fillFEDRawDataCollection(
+      frdEventMsg, *rawData_, verifyAdler32_, verifyChecksum_, useL1EventID_, id, theTime, eType);
+  ring_->release();
+  return true;
+}
+
+void FRDSharedMemorySource::produce(edm::Event& e) { e.put(std::move(rawData_)); }
+
+//////////////////////////////////////////
+// define this class as an input source //
+//////////////////////////////////////////
+DEFINE_FWK_INPUT_SOURCE(FRDSharedMemorySource);
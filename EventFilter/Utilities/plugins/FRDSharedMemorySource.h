@@ -0,0 +1,45 @@
+#ifndef EventFilter_Utilities_FRDSharedMemorySource_h
+#define EventFilter_Utilities_FRDSharedMemorySource_h
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Sources/interface/ProducerSourceBase.h"
+#include "FWCore/SharedMemory/interface/EventRing.h"
+
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+
+#include <memory>
+#include <string>
+
+/*
+ * Reads FRD events from the shared memory ring filled by the
+ * RawEventRingWriterForBU of the BU on the same node. Several FU processes
+ * can read the same ring, each event goes to one of them. The job ends when
+ * the BU stops the ring and all its events have been taken, or when no event
+ * came for idleTimeoutSeconds, if set.
+ */
+class FRDSharedMemorySource : public edm::ProducerSourceBase {
+public:
+  FRDSharedMemorySource(edm::ParameterSet const& pset, edm::InputSourceDescription const& desc);
+  ~FRDSharedMemorySource() override{};
+
+private:
+  bool setRunAndEventInfo(edm::EventID& id,
+                          edm::TimeValue_t& theTime,
+                          edm::EventAuxiliary::ExperimentType& eType) override;
+  void produce(edm::Event& e) override;
+
+  bool openRing();
+
+  const std::string ringName_;
+  const unsigned int openTimeoutSeconds_;
+  const unsigned int idleTimeoutSeconds_;
+  const bool verifyAdler32_;
+  const bool verifyChecksum_;
+  const bool useL1EventID_;
+  std::unique_ptr<edm::shared_memory::EventRingReader> ring_;
+  std::unique_ptr<FEDRawDataCollection> rawData_;
+};
+
+#endif  // EventFilter_Utilities_FRDSharedMemorySource_h
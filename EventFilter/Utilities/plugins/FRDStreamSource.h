@@ -12,6 +12,8 @@
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
 #include "DataFormats/Provenance/interface/Timestamp.h"
 
+#include "IOPool/Streamer/interface/FRDEventMessage.h"
+
 #include <unistd.h>
 #include <string>
 #include <vector>
@@ -23,6 +25,17 @@ public:
   FRDStreamSource(edm::ParameterSet const& pset, edm::InputSourceDescription const& desc);
   ~FRDStreamSource() override{};
 
+  // verifies the checksum of an FRD event and copies its FED fragments into the collection, setting the
+  // event ID, time and type from the trigger FEDs
+  static void fillFEDRawDataCollection(FRDEventMsgView const& frdEventMsg,
+                                       FEDRawDataCollection& rawData,
+                                       bool verifyAdler32,
+                                       bool verifyChecksum,
+                                       bool useL1EventID,
+                                       edm::EventID& id,
+                                       edm::TimeValue_t& theTime,
+                                       edm::EventAuxiliary::ExperimentType& eType);
+
 private:
   // member functions
   bool setRunAndEventInfo(edm::EventID& id,
@@ -0,0 +1,56 @@
+#include "EventFilter/Utilities/plugins/RawEventRingWriterForBU.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <chrono>
+
+RawEventRingWriterForBU::RawEventRingWriterForBU(edm::ParameterSet const& ps)
+    : ringName_(ps.getUntrackedParameter<std::string>("ringName", "FRDEventRing")),
+      maxWaitSeconds_(ps.getUntrackedParameter<unsigned int>("maxWaitSeconds", 0)) {
+  unsigned int ringSlots = ps.getUntrackedParameter<unsigned int>("ringSlots", 32);
+  unsigned int ringSlotSize = ps.getUntrackedParameter<unsigned int>("ringSlotSize", 16 << 20);
+  if (ringSlots == 0)
+    throw cms::Exception("RawEventRingWriterForBU") << "ringSlots must be larger than 0";
+  ring_ = std::make_unique<edm::shared_memory::EventRingWriter>(ringName_, ringSlots, ringSlotSize);
+  edm::LogInfo("RawEventRingWriterForBU") << "created the event ring " << ringName_ << " of " << ringSlots
+                                          << " slots of " << ring_->slotSize() << " bytes";
+}
+
+RawEventRingWriterForBU::~RawEventRingWriterForBU() {}
+
+void RawEventRingWriterForBU::doOutputEvent(FRDEventMsgView const& msg) {
+  using edm::shared_memory::EventRingWriter;
+  const char* start = reinterpret_cast<const char*>(msg.startAddress());
+  unsigned int waited = 0;
+  EventRingWriter::Status status;
+  while ((status = ring_->push(start, msg.size(), std::chrono::seconds(1))) == EventRingWriter::Status::kTimeout) {
+    //backpressure from the FUs
+    if (waited++ == 0)
+      perLumiWaits_++;
+    if (maxWaitSeconds_ && waited >= maxWaitSeconds_)
+      throw cms::Exception("RawEventRingWriterForBU")
+          << "no slot of the event ring " << ringName_ << " was released in " << waited << " seconds, "
+          << ring_->readers() << " FU processes are reading it";
+    edm::LogWarning("RawEventRingWriterForBU")
+        << "event ring " << ringName_ << " full for " << waited << " s, " << ring_->readers() << " readers";
+  }
+  if (status == EventRingWriter::Status::kTooLarge)
+    throw cms::Exception("RawEventRingWriterForBU")
+        << "event of " << msg.size() << " bytes does not fit in the slots of " << ring_->slotSize()
+        << " bytes of the event ring " << ringName_;
+  perLumiEvents_++;
+}
+
+void RawEventRingWriterForBU::endOfLS(int ls) {
+  edm::LogInfo("RawEventRingWriterForBU")
+      << "LS " << ls << ": " << perLumiEvents_ << " events, waited for the FUs before " << perLumiWaits_
+      << " of them, ring occupancy " << ring_->occupancy() << "/" << ring_->nSlots();
+  perLumiEvents_ = 0;
+  perLumiWaits_ = 0;
+}
+
+void RawEventRingWriterForBU::stop() {
+  //the FUs take the remaining events and then end their job
+  ring_->stop();
+}
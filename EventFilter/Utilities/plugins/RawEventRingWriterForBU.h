@@ -0,0 +1,43 @@
+#ifndef EVFRAWEVENTRINGWRITERFORBU
+#define EVFRAWEVENTRINGWRITERFORBU
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/SharedMemory/interface/EventRing.h"
+#include "IOPool/Streamer/interface/FRDEventMessage.h"
+
+#include <memory>
+#include <string>
+
+#include "boost/shared_array.hpp"
+
+/*
+ * Consumer of RawEventOutputModuleForBU handing the FRD events to the FU
+ * processes of the node through a ring in shared memory, read by the
+ * FRDSharedMemorySource, instead of writing them to files.
+ *
+ * When the ring is full, i.e. the FUs are not keeping up, the BU waits for
+ * a slot to be released and reports it, or fails after maxWaitSeconds.
+ */
+class RawEventRingWriterForBU {
+public:
+  explicit RawEventRingWriterForBU(edm::ParameterSet const& ps);
+  ~RawEventRingWriterForBU();
+
+  void doOutputEvent(FRDEventMsgView const& msg);
+  void doOutputEvent(boost::shared_array<unsigned char>& msg){};
+
+  void start() {}
+  void stop();
+  void initialize(std::string const& destinationDir, std::string const& name, int ls) {}
+  void endOfLS(int ls);
+  bool sharedMode() const { return false; }
+
+private:
+  std::string ringName_;
+  unsigned int maxWaitSeconds_;
+  std::unique_ptr<edm::shared_memory::EventRingWriter> ring_;
+
+  unsigned int perLumiEvents_ = 0;
+  unsigned int perLumiWaits_ = 0;
+};
+#endif
@@ -7,6 +7,7 @@
 #include "EventFilter/Utilities/plugins/EvFBuildingThrottle.h"
 #include "EventFilter/Utilities/plugins/EvFFEDSelector.h"
 #include "EventFilter/Utilities/plugins/RawEventFileWriterForBU.h"
+#include "EventFilter/Utilities/plugins/RawEventRingWriterForBU.h"
 #include "EventFilter/Utilities/plugins/RecoEventWriterForFU.h"
 #include "EventFilter/Utilities/plugins/RecoEventOutputModuleForFU.h"
 #include "EventFilter/Utilities/plugins/RawEventOutputModuleForBU.h"
@@ -21,6 +22,7 @@ using namespace evf;
 typedef edm::serviceregistry::AllArgsMaker<MicroStateService, FastMonitoringService> FastMonitoringServiceMaker;
 
 typedef RawEventOutputModuleForBU<RawEventFileWriterForBU> RawStreamFileWriterForBU;
+typedef RawEventOutputModuleForBU<RawEventRingWriterForBU> RawStreamRingWriterForBU;
 typedef RecoEventOutputModuleForFU<RecoEventWriterForFU> ShmStreamConsumer;
 
 //legacy name for ConfDB compatibility
@@ -32,6 +34,7 @@ DEFINE_FWK_SERVICE(EvFBuildingThrottle);
 DEFINE_FWK_SERVICE(EvFDaqDirector);
 DEFINE_FWK_MODULE(ExceptionGenerator);
 DEFINE_FWK_MODULE(RawStreamFileWriterForBU);
+DEFINE_FWK_MODULE(RawStreamRingWriterForBU);
 DEFINE_FWK_MODULE(EvFFEDSelector);
 DEFINE_FWK_MODULE(EvFOutputModule);
 DEFINE_FWK_MODULE(ShmStreamConsumer);
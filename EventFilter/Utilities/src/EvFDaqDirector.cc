@@ -416,6 +416,18 @@ namespace evf {
     return run_dir_ + "/open/" + fffnaming::streamerDataFileNameWithPid(run_, ls, stream);
   }
 
+  std::string EvFDaqDirector::getDatFilePath(const unsigned int ls,
+                                             std::string const& stream,
+                                             const unsigned int part) const {
+    return run_dir_ + "/" + fffnaming::streamerDataFileNameWithPid(run_, ls, stream, part);
+  }
+
+  std::string EvFDaqDirector::getOpenDatFilePath(const unsigned int ls,
+                                                 std::string const& stream,
+                                                 const unsigned int part) const {
+    return run_dir_ + "/open/" + fffnaming::streamerDataFileNameWithPid(run_, ls, stream, part);
+  }
+
   std::string EvFDaqDirector::getOpenOutputJsonFilePath(const unsigned int ls, std::string const& stream) const {
     return run_dir_ + "/open/" + fffnaming::streamerJsonFileNameWithPid(run_, ls, stream);
   }
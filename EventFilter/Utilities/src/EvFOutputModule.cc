@@ -18,24 +18,22 @@
 #include "IOPool/Streamer/interface/EventMsgBuilder.h"
 
 #include <sys/stat.h>
+#include <zlib.h>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 
 namespace evf {
 
-  EvFOutputJSONWriter::EvFOutputJSONWriter(edm::ParameterSet const& ps,
-                                           edm::SelectedProducts const* selections,
-                                           std::string const& streamLabel)
-      : streamerCommon_(ps, selections),
-        processed_(0),
-        accepted_(0),
-        errorEvents_(0),
-        retCodeMask_(0),
-        filelist_(),
-        filesize_(0),
-        inputFiles_(),
-        fileAdler32_(1),
-        hltErrorEvents_(0) {
+  EvFOutputEventWriter& EvFOutputLumiWriter::writer(unsigned int streamIndex, std::string const& streamLabel) const {
+    auto& writer = writers_[streamIndex];
+    if (!writer)
+      writer = std::make_unique<EvFOutputEventWriter>(
+          edm::Service<evf::EvFDaqDirector>()->getOpenDatFilePath(ls_, streamLabel, streamIndex));
+    return *writer;
+  }
+
+  EvFOutputJSONDef::EvFOutputJSONDef(std::string const& streamLabel) {
     transferDestination_ = edm::Service<evf::EvFDaqDirector>()->getStreamDestinations(streamLabel);
     mergeType_ = edm::Service<evf::EvFDaqDirector>()->getStreamMergeType(streamLabel, evf::MergeTypeDAT);
 
@@ -44,52 +42,72 @@ namespace evf {
 
     edm::Service<evf::EvFDaqDirector>()->createRunOpendirMaybe();
 
-    processed_.setName("Processed");
-    accepted_.setName("Accepted");
-    errorEvents_.setName("ErrorEvents");
-    retCodeMask_.setName("ReturnCodeMask");
-    filelist_.setName("Filelist");
-    filesize_.setName("Filesize");
-    inputFiles_.setName("InputFiles");
-    fileAdler32_.setName("FileAdler32");
-    transferDestination_.setName("TransferDestination");
-    mergeType_.setName("MergeType");
-    hltErrorEvents_.setName("HLTErrorEvents");
-
-    outJsonDef_.setDefaultGroup("data");
-    outJsonDef_.addLegendItem("Processed", "integer", jsoncollector::DataPointDefinition::SUM);
-    outJsonDef_.addLegendItem("Accepted", "integer", jsoncollector::DataPointDefinition::SUM);
-    outJsonDef_.addLegendItem("ErrorEvents", "integer", jsoncollector::DataPointDefinition::SUM);
-    outJsonDef_.addLegendItem("ReturnCodeMask", "integer", jsoncollector::DataPointDefinition::BINARYOR);
-    outJsonDef_.addLegendItem("Filelist", "string", jsoncollector::DataPointDefinition::MERGE);
-    outJsonDef_.addLegendItem("Filesize", "integer", jsoncollector::DataPointDefinition::SUM);
-    outJsonDef_.addLegendItem("InputFiles", "string", jsoncollector::DataPointDefinition::CAT);
-    outJsonDef_.addLegendItem("FileAdler32", "integer", jsoncollector::DataPointDefinition::ADLER32);
-    outJsonDef_.addLegendItem("TransferDestination", "string", jsoncollector::DataPointDefinition::SAME);
-    outJsonDef_.addLegendItem("MergeType", "string", jsoncollector::DataPointDefinition::SAME);
-    outJsonDef_.addLegendItem("HLTErrorEvents", "integer", jsoncollector::DataPointDefinition::SUM);
-
     std::stringstream tmpss, ss;
     tmpss << baseRunDir << "/open/"
           << "output_" << getpid() << ".jsd";
     ss << baseRunDir << "/"
        << "output_" << getpid() << ".jsd";
     std::string outTmpJsonDefName = tmpss.str();
-    std::string outJsonDefName = ss.str();
+    outJsonDefName_ = ss.str();
 
     edm::Service<evf::EvFDaqDirector>()->lockInitLock();
     struct stat fstat;
-    if (stat(outJsonDefName.c_str(), &fstat) != 0) {  //file does not exist
-      LogDebug("EvFOutputModule") << "writing output definition file -: " << outJsonDefName;
+    if (stat(outJsonDefName_.c_str(), &fstat) != 0) {  //file does not exist
+      LogDebug("EvFOutputModule") << "writing output definition file -: " << outJsonDefName_;
+      jsoncollector::DataPointDefinition outJsonDef;
+      fillDefinition(outJsonDef);
       std::string content;
-      jsoncollector::JSONSerializer::serialize(&outJsonDef_, content);
+      jsoncollector::JSONSerializer::serialize(&outJsonDef, content);
       jsoncollector::FileIO::writeStringToFile(outTmpJsonDefName, content);
-      boost::filesystem::rename(outTmpJsonDefName, outJsonDefName);
+      boost::filesystem::rename(outTmpJsonDefName, outJsonDefName_);
     }
     edm::Service<evf::EvFDaqDirector>()->unlockInitLock();
+  }
+
+  void EvFOutputJSONDef::fillDefinition(jsoncollector::DataPointDefinition& def) {
+    def.setDefaultGroup("data");
+    def.addLegendItem("Processed", "integer", jsoncollector::DataPointDefinition::SUM);
+    def.addLegendItem("Accepted", "integer", jsoncollector::DataPointDefinition::SUM);
+    def.addLegendItem("ErrorEvents", "integer", jsoncollector::DataPointDefinition::SUM);
+    def.addLegendItem("ReturnCodeMask", "integer", jsoncollector::DataPointDefinition::BINARYOR);
+    def.addLegendItem("Filelist", "string", jsoncollector::DataPointDefinition::MERGE);
+    def.addLegendItem("Filesize", "integer", jsoncollector::DataPointDefinition::SUM);
+    def.addLegendItem("InputFiles", "string", jsoncollector::DataPointDefinition::CAT);
+    def.addLegendItem("FileAdler32", "integer", jsoncollector::DataPointDefinition::ADLER32);
+    def.addLegendItem("TransferDestination", "string", jsoncollector::DataPointDefinition::SAME);
+    def.addLegendItem("MergeType", "string", jsoncollector::DataPointDefinition::SAME);
+    def.addLegendItem("HLTErrorEvents", "integer", jsoncollector::DataPointDefinition::SUM);
+  }
+
+  EvFOutputJSONWriter::EvFOutputJSONWriter(EvFOutputJSONDef const& jsonDef)
+      : processed_(0),
+        accepted_(0),
+        errorEvents_(0),
+        retCodeMask_(0),
+        filelist_(),
+        filesize_(0),
+        inputFiles_(),
+        fileAdler32_(1),
+        hltErrorEvents_(0) {
+    transferDestination_ = jsonDef.transferDestination_;
+    mergeType_ = jsonDef.mergeType_;
+
+    processed_.setName("Processed");
+    accepted_.setName("Accepted");
+    errorEvents_.setName("ErrorEvents");
+    retCodeMask_.setName("ReturnCodeMask");
+    filelist_.setName("Filelist");
+    filesize_.setName("Filesize");
+    inputFiles_.setName("InputFiles");
+    fileAdler32_.setName("FileAdler32");
+    transferDestination_.setName("TransferDestination");
+    mergeType_.setName("MergeType");
+    hltErrorEvents_.setName("HLTErrorEvents");
+
+    EvFOutputJSONDef::fillDefinition(outJsonDef_);
 
     jsonMonitor_.reset(new jsoncollector::FastMonitor(&outJsonDef_, true));
-    jsonMonitor_->setDefPath(outJsonDefName);
+    jsonMonitor_->setDefPath(jsonDef.outJsonDefName_);
     jsonMonitor_->registerGlobalMonitorable(&processed_, false);
     jsonMonitor_->registerGlobalMonitorable(&accepted_, false);
     jsonMonitor_->registerGlobalMonitorable(&errorEvents_, false);
@@ -105,7 +123,7 @@ namespace evf {
   }
 
   EvFOutputModule::EvFOutputModule(edm::ParameterSet const& ps)
-      : edm::one::OutputModuleBase(ps),
+      : edm::global::OutputModuleBase(ps),
         EvFOutputModuleType(ps),
         ps_(ps),
         streamLabel_(ps.getParameter<std::string>("@module_label")),
@@ -141,9 +159,12 @@ namespace evf {
     descriptions.addDefault(desc);
   }
 
-  void EvFOutputModule::beginRun(edm::RunForOutput const& run) {
-    //create run Cache holding JSON file writer and variables
-    jsonWriter_ = std::make_unique<EvFOutputJSONWriter>(ps_, &keptProducts()[edm::InEvent], streamLabel_);
+  void EvFOutputModule::preallocStreams(unsigned int nStreams) { streamerCommon_.resize(nStreams); }
+
+  std::shared_ptr<EvFOutputJSONDef> EvFOutputModule::globalBeginRun(edm::RunForOutput const& run) const {
+    //create run Cache holding the JSON definition
+    auto jsonDef = std::make_shared<EvFOutputJSONDef>(streamLabel_);
+    edm::StreamerOutputModuleCommon streamerCommon(ps_, &keptProducts()[edm::InEvent]);
 
     //output INI file (non-const). This doesn't require globalBeginRun to be finished
     const std::string openIniFileName = edm::Service<evf::EvFDaqDirector>()->getOpenInitFilePath(streamLabel_);
@@ -154,12 +175,12 @@ namespace evf {
     edm::BranchIDLists const* bidlPtr = branchIDLists();
 
     std::unique_ptr<InitMsgBuilder> init_message =
-        jsonWriter_->streamerCommon_.serializeRegistry(*jsonWriter_->streamerCommon_.getSerializerBuffer(),
-                                                       *bidlPtr,
-                                                       *thinnedAssociationsHelper(),
-                                                       OutputModule::processName(),
-                                                       description().moduleLabel(),
-                                                       moduleDescription().mainParameterSetID());
+        streamerCommon.serializeRegistry(*streamerCommon.getSerializerBuffer(),
+                                         *bidlPtr,
+                                         *thinnedAssociationsHelper(),
+                                         processName(),
+                                         description().moduleLabel(),
+                                         moduleDescription().mainParameterSetID());
 
     //Let us turn it into a View
     InitMsgView view(init_message->startAddress());
@@ -186,9 +207,6 @@ namespace evf {
     }
     fclose(src);
 
-    //clear serialization buffers
-    jsonWriter_->streamerCommon_.getSerializerBuffer()->clearHeaderBuffer();
-
     //free output buffer needed only for the file write
     delete[] outBuf;
     outBuf = nullptr;
@@ -201,6 +219,7 @@ namespace evf {
       LogDebug("EvFOutputModule") << "Ini file checksum -: " << streamLabel_ << " " << adler32c;
       boost::filesystem::rename(openIniFileName, edm::Service<evf::EvFDaqDirector>()->getInitFilePath(streamLabel_));
     }
+    return jsonDef;
   }
 
   Trig EvFOutputModule::getTriggerResults(edm::EDGetTokenT<edm::TriggerResults> const& token,
@@ -210,61 +229,95 @@ namespace evf {
     return result;
   }
 
-  std::shared_ptr<EvFOutputEventWriter> EvFOutputModule::globalBeginLuminosityBlock(
+  std::shared_ptr<EvFOutputLumiWriter> EvFOutputModule::globalBeginLuminosityBlock(
       edm::LuminosityBlockForOutput const& iLB) const {
-    auto openDatFilePath = edm::Service<evf::EvFDaqDirector>()->getOpenDatFilePath(iLB.luminosityBlock(), streamLabel_);
-
-    return std::make_shared<EvFOutputEventWriter>(openDatFilePath);
+    return std::make_shared<EvFOutputLumiWriter>(iLB.luminosityBlock(), streamerCommon_.size());
   }
 
   void EvFOutputModule::write(edm::EventForOutput const& e) {
     edm::Handle<edm::TriggerResults> const& triggerResults = getTriggerResults(trToken_, e);
 
-    //auto lumiWriter = const_cast<EvFOutputEventWriter*>(luminosityBlockCache(e.getLuminosityBlock().index() ));
+    //each stream serializes and writes its events to its own file, concurrently with the other streams
+    unsigned int streamIndex = e.streamID().value();
+    auto& streamerCommon = streamerCommon_[streamIndex];
+    if (!streamerCommon)
+      streamerCommon = std::make_unique<edm::StreamerOutputModuleCommon>(ps_, &keptProducts()[edm::InEvent]);
+
     auto lumiWriter = luminosityBlockCache(e.getLuminosityBlock().index());
-    std::unique_ptr<EventMsgBuilder> msg = jsonWriter_->streamerCommon_.serializeEvent(
-        *jsonWriter_->streamerCommon_.getSerializerBuffer(), e, triggerResults, selectorConfig());
-    lumiWriter->incAccepted();
-    lumiWriter->doOutputEvent(*msg);  //msg is written and discarded at this point
+    EvFOutputEventWriter& writer = lumiWriter->writer(streamIndex, streamLabel_);
+    std::unique_ptr<EventMsgBuilder> msg =
+        streamerCommon->serializeEvent(*streamerCommon->getSerializerBuffer(), e, triggerResults, selectorConfig());
+    writer.incAccepted();
+    writer.doOutputEvent(*msg);  //msg is written and discarded at this point
   }
 
-  void EvFOutputModule::globalEndLuminosityBlock(edm::LuminosityBlockForOutput const& iLB) {
+  void EvFOutputModule::globalEndLuminosityBlock(edm::LuminosityBlockForOutput const& iLB) const {
     auto lumiWriter = luminosityBlockCache(iLB.index());
-    //close dat file
-    lumiWriter->close();
-
-    jsonWriter_->fileAdler32_.value() = lumiWriter->get_adler32();
-    jsonWriter_->accepted_.value() = lumiWriter->getAccepted();
+    auto& writers = lumiWriter->writers();
+    EvFOutputJSONWriter jsonWriter(*runCache(iLB.getRun().index()));
 
     bool abortFlag = false;
-    jsonWriter_->processed_.value() = fms_->getEventsProcessedForLumi(iLB.luminosityBlock(), &abortFlag);
+    jsonWriter.processed_.value() = fms_->getEventsProcessedForLumi(iLB.luminosityBlock(), &abortFlag);
+    //a lumi with processed events always has at least one, possibly empty, file
+    bool anyFile = std::any_of(writers.begin(), writers.end(), [](auto const& w) { return bool(w); });
+    if (jsonWriter.processed_.value() != 0 && !anyFile && !abortFlag)
+      lumiWriter->writer(0, streamLabel_);
+
+    //close dat files
+    for (auto& writer : writers) {
+      if (writer)
+        writer->close();
+    }
+
     if (abortFlag) {
       edm::LogInfo("EvFOutputModule") << "Abort flag has been set. Output is suppressed";
       return;
     }
 
-    if (jsonWriter_->processed_.value() != 0) {
-      struct stat istat;
-      boost::filesystem::path openDatFilePath = lumiWriter->getFilePath();
-      stat(openDatFilePath.string().c_str(), &istat);
-      jsonWriter_->filesize_ = istat.st_size;
-      boost::filesystem::rename(
-          openDatFilePath.string().c_str(),
-          edm::Service<evf::EvFDaqDirector>()->getDatFilePath(iLB.luminosityBlock(), streamLabel_));
-      jsonWriter_->filelist_ = openDatFilePath.filename().string();
+    if (jsonWriter.processed_.value() != 0) {
+      //the files are listed in the order in which the merger concatenates them, and the checksum is that of the
+      //concatenated data
+      std::string filelist;
+      unsigned long accepted = 0;
+      long filesize = 0;
+      uLong adler32 = 1;
+      for (unsigned int i = 0; i < writers.size(); ++i) {
+        if (!writers[i])
+          continue;
+        struct stat istat;
+        boost::filesystem::path openDatFilePath = writers[i]->getFilePath();
+        stat(openDatFilePath.string().c_str(), &istat);
+        adler32 = adler32_combine(adler32, writers[i]->get_adler32(), istat.st_size);
+        filesize += istat.st_size;
+        accepted += writers[i]->getAccepted();
+        boost::filesystem::rename(
+            openDatFilePath.string().c_str(),
+            edm::Service<evf::EvFDaqDirector>()->getDatFilePath(iLB.luminosityBlock(), streamLabel_, i));
+        if (!filelist.empty())
+          filelist += ",";
+        filelist += openDatFilePath.filename().string();
+      }
+      jsonWriter.accepted_.value() = accepted;
+      jsonWriter.filesize_ = filesize;
+      jsonWriter.fileAdler32_.value() = adler32;
+      jsonWriter.filelist_ = filelist;
     } else {
-      //remove empty file when no event processing has occurred
-      remove(lumiWriter->getFilePath().c_str());
-      jsonWriter_->filesize_ = 0;
-      jsonWriter_->filelist_ = "";
-      jsonWriter_->fileAdler32_.value() = -1;  //no files in signed long
+      //remove empty files when no event processing has occurred
+      for (auto& writer : writers) {
+        if (writer)
+          remove(writer->getFilePath().c_str());
+      }
+      jsonWriter.accepted_.value() = 0;
+      jsonWriter.filesize_ = 0;
+      jsonWriter.filelist_ = "";
+      jsonWriter.fileAdler32_.value() = -1;  //no files in signed long
     }
 
     //produce JSON file
-    jsonWriter_->jsonMonitor_->snap(iLB.luminosityBlock());
+    jsonWriter.jsonMonitor_->snap(iLB.luminosityBlock());
     const std::string outputJsonNameStream =
         edm::Service<evf::EvFDaqDirector>()->getOutputJsonFilePath(iLB.luminosityBlock(), streamLabel_);
-    jsonWriter_->jsonMonitor_->outputFullJSON(outputJsonNameStream, iLB.luminosityBlock());
+    jsonWriter.jsonMonitor_->outputFullJSON(outputJsonNameStream, iLB.luminosityBlock());
   }
 
 }  // namespace evf
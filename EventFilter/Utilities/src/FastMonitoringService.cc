@@ -118,8 +118,7 @@ namespace evf {
         fastMonIntervals_(iPS.getUntrackedParameter<unsigned int>("fastMonIntervals", 2)),
         fastName_("fastmoni"),
         slowName_("slowmoni"),
-        filePerFwkStream_(iPS.getUntrackedParameter<bool>("filePerFwkStream", false)),
-        totalEventsProcessed_(0) {
+        filePerFwkStream_(iPS.getUntrackedParameter<bool>("filePerFwkStream", false)) {
     reg.watchPreallocate(this, &FastMonitoringService::preallocate);  //receiving information on number of threads
     reg.watchJobFailure(this, &FastMonitoringService::jobFailure);    //global
 
@@ -299,9 +298,10 @@ namespace evf {
       encModule_.updateReserved(static_cast<const void*>(reservedMicroStateNames + i));
     encModule_.completeReservedWithDummies();
 
+    streamStates_.reset(new StreamState[nStreams_]);
     for (unsigned int i = 0; i < nStreams_; i++) {
-      ministate_.emplace_back(&nopath_);
-      microstate_.emplace_back(&reservedMicroStateNames[mInvalid]);
+      streamStates_[i].setMinistate(&nopath_);
+      streamStates_[i].setMicrostate(&reservedMicroStateNames[mInvalid]);
 
       //for synchronization
       streamCounterUpdating_.push_back(new std::atomic<bool>(false));
@@ -551,12 +551,12 @@ namespace evf {
     //reset collected values for this stream
     *(fmt_.m_data.processed_[sid]) = 0;
 
-    ministate_[sid] = &nopath_;
-    microstate_[sid] = &reservedMicroStateNames[mBoL];
+    streamStates_[sid].setMinistate(&nopath_);
+    streamStates_[sid].setMicrostate(&reservedMicroStateNames[mBoL]);
   }
 
   void FastMonitoringService::postStreamBeginLumi(edm::StreamContext const& sc) {
-    microstate_[sc.streamID().value()] = &reservedMicroStateNames[mIdle];
+    streamStates_[sc.streamID().value()].setMicrostate(&reservedMicroStateNames[mIdle]);
   }
 
   void FastMonitoringService::preStreamEndLumi(edm::StreamContext const& sc) {
@@ -566,11 +566,11 @@ namespace evf {
     //update processed count to be complete at this time
     doStreamEOLSnapshot(sc.eventID().luminosityBlock(), sid);
     //reset this in case stream does not get notified of next lumi (we keep processed events only)
-    ministate_[sid] = &nopath_;
-    microstate_[sid] = &reservedMicroStateNames[mEoL];
+    streamStates_[sid].setMinistate(&nopath_);
+    streamStates_[sid].setMicrostate(&reservedMicroStateNames[mEoL]);
   }
   void FastMonitoringService::postStreamEndLumi(edm::StreamContext const& sc) {
-    microstate_[sc.streamID().value()] = &reservedMicroStateNames[mFwkEoL];
+    streamStates_[sc.streamID().value()].setMicrostate(&reservedMicroStateNames[mFwkEoL]);
   }
 
   void FastMonitoringService::prePathEvent(edm::StreamContext const& sc, edm::PathContext const& pc) {
@@ -597,41 +597,41 @@ namespace evf {
         }
       }
     } else {
-      ministate_[sc.streamID()] = &(pc.pathName());
+      streamStates_[sc.streamID()].setMinistate(&(pc.pathName()));
     }
   }
 
   void FastMonitoringService::preEvent(edm::StreamContext const& sc) {}
 
   void FastMonitoringService::postEvent(edm::StreamContext const& sc) {
-    microstate_[sc.streamID()] = &reservedMicroStateNames[mIdle];
+    streamStates_[sc.streamID()].setMicrostate(&reservedMicroStateNames[mIdle]);
 
-    ministate_[sc.streamID()] = &nopath_;
+    streamStates_[sc.streamID()].setMinistate(&nopath_);
 
     (*(fmt_.m_data.processed_[sc.streamID()]))++;
     eventCountForPathInit_[sc.streamID()].m_value++;
 
-    //fast path counter (events accumulated in a run)
-    unsigned long res = totalEventsProcessed_.fetch_add(1, std::memory_order_relaxed);
-    fmt_.m_data.fastPathProcessedJ_ = res + 1;
-    //fmt_.m_data.fastPathProcessedJ_ = totalEventsProcessed_.load(std::memory_order_relaxed);
+    //fast path counter (events accumulated in a run), summed over the streams in doSnapshot.
+    //Only this stream increments it, one event at a time, so it needs no atomic read-modify-write
+    std::atomic<unsigned long>& processed = streamStates_[sc.streamID()].processed_;
+    processed.store(processed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
   }
 
   void FastMonitoringService::preSourceEvent(edm::StreamID sid) {
-    microstate_[sid.value()] = &reservedMicroStateNames[mInput];
+    streamStates_[sid.value()].setMicrostate(&reservedMicroStateNames[mInput]);
   }
 
   void FastMonitoringService::postSourceEvent(edm::StreamID sid) {
-    microstate_[sid.value()] = &reservedMicroStateNames[mFwkOvhSrc];
+    streamStates_[sid.value()].setMicrostate(&reservedMicroStateNames[mFwkOvhSrc]);
   }
 
   void FastMonitoringService::preModuleEvent(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
-    microstate_[sc.streamID().value()] = (void*)(mcc.moduleDescription());
+    streamStates_[sc.streamID().value()].setMicrostate((void*)(mcc.moduleDescription()));
   }
 
   void FastMonitoringService::postModuleEvent(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
     //microstate_[sc.streamID().value()] = (void*)(mcc.moduleDescription());
-    microstate_[sc.streamID().value()] = &reservedMicroStateNames[mFwkOvhMod];
+    streamStates_[sc.streamID().value()].setMicrostate(&reservedMicroStateNames[mFwkOvhMod]);
   }
 
   //FUNCTIONS CALLED FROM OUTSIDE
@@ -640,12 +640,12 @@ namespace evf {
   //(we assume the worst case - everything is blocked)
   void FastMonitoringService::setMicroState(MicroStateService::Microstate m) {
     for (unsigned int i = 0; i < nStreams_; i++)
-      microstate_[i] = &reservedMicroStateNames[m];
+      streamStates_[i].setMicrostate(&reservedMicroStateNames[m]);
   }
 
   //this is for services that are multithreading-enabled or rarely blocks other streams
   void FastMonitoringService::setMicroState(edm::StreamID sid, MicroStateService::Microstate m) {
-    microstate_[sid] = &reservedMicroStateNames[m];
+    streamStates_[sid].setMicrostate(&reservedMicroStateNames[m]);
   }
 
   //from source
@@ -742,7 +742,13 @@ namespace evf {
     // update macrostate
     fmt_.m_data.fastMacrostateJ_ = macrostate_;
 
-    std::vector<const void*> microstateCopy(microstate_.begin(), microstate_.end());
+    std::vector<const void*> microstateCopy(nStreams_);
+    unsigned long processed = 0;
+    for (unsigned int i = 0; i < nStreams_; i++) {
+      microstateCopy[i] = streamStates_[i].microstate();
+      processed += streamStates_[i].processed_.load(std::memory_order_relaxed);
+    }
+    fmt_.m_data.fastPathProcessedJ_ = processed;
 
     if (!isInitTransition_) {
       auto itd = avgLeadTime_.find(ls);
@@ -768,7 +774,7 @@ namespace evf {
     }
 
     for (unsigned int i = 0; i < nStreams_; i++) {
-      fmt_.m_data.ministateEncoded_[i] = encPath_[i].encode(ministate_[i]);
+      fmt_.m_data.ministateEncoded_[i] = encPath_[i].encode(streamStates_[i].ministate());
       fmt_.m_data.microstateEncoded_[i] = encModule_.encode(microstateCopy[i]);
     }
 
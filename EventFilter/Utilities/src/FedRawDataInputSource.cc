@@ -12,6 +12,7 @@
 #include <zlib.h>
 #include <cstdio>
 #include <chrono>
+#include <algorithm>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -44,12 +45,19 @@
 #include "DataFormats/Provenance/interface/EventID.h"
 #include "DataFormats/Provenance/interface/Timestamp.h"
 #include "EventFilter/Utilities/interface/crc32c.h"
+#include "EventFilter/Utilities/interface/UringReader.h"
 
 //JSON file reader
 #include "EventFilter/Utilities/interface/reader.h"
 
 #include <boost/lexical_cast.hpp>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+//events smaller than two blocks are checked and copied serially
+static constexpr size_t kMinAssemblyBlock = 256 * 1024;
+
 FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset, edm::InputSourceDescription const& desc)
     : edm::RawInputSource(pset, desc),
       defPath_(pset.getUntrackedParameter<std::string>("buDefPath", "")),
@@ -61,6 +69,8 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset, edm:
       alwaysStartFromFirstLS_(pset.getUntrackedParameter<bool>("alwaysStartFromFirstLS", false)),
       verifyChecksum_(pset.getUntrackedParameter<bool>("verifyChecksum", true)),
       useL1EventID_(pset.getUntrackedParameter<bool>("useL1EventID", false)),
+      numAssemblyTasks_(std::max(1u, pset.getUntrackedParameter<unsigned int>("numAssemblyTasks", 8))),
+      ioUringQueueDepth_(pset.getUntrackedParameter<unsigned int>("ioUringQueueDepth", 0)),
       fileNames_(pset.getUntrackedParameter<std::vector<std::string>>("fileNames", std::vector<std::string>())),
       fileListMode_(pset.getUntrackedParameter<bool>("fileListMode", false)),
       fileListLoopMode_(pset.getUntrackedParameter<bool>("fileListLoopMode", false)),
@@ -141,7 +151,9 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset, edm:
   }
   //should delete chunks when run stops
   for (unsigned int i = 0; i < numBuffers_; i++) {
-    freeChunks_.push(new InputChunk(i, eventChunkSize_));
+    InputChunk* chunk = new InputChunk(i, eventChunkSize_);
+    chunkBuffers_.emplace_back(chunk->buf_, chunk->size_);
+    freeChunks_.push(chunk);
   }
 
   quit_threads_ = false;
@@ -208,6 +220,14 @@ void FedRawDataInputSource::fillDescriptions(edm::ConfigurationDescriptions& des
       ->setComment("Verify event CRC-32C checksum of FRDv5 and higher or Adler32 with v3 and v4");
   desc.addUntracked<bool>("useL1EventID", false)
       ->setComment("Use L1 event ID from FED header if true or from TCDS FED if false");
+  desc.addUntracked<unsigned int>("numAssemblyTasks", 8)
+      ->setComment(
+          "Maximum number of parallel tasks used to verify the checksum and copy the FED data of a large event "
+          "(1 to do it serially in the source)");
+  desc.addUntracked<unsigned int>("ioUringQueueDepth", 0)
+      ->setComment(
+          "Number of eventChunkBlock reads kept in flight by each reader thread using io_uring (0 to use blocking "
+          "read calls)");
   desc.addUntracked<bool>("fileListMode", false)
       ->setComment("Use fileNames parameter to directly specify raw files to open");
   desc.addUntracked<std::vector<std::string>>("fileNames", std::vector<std::string>())
@@ -577,8 +597,7 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent() {
     fms_->setInState(evf::FastMonitoringThread::inChecksumEvent);
 
   if (verifyChecksum_ && event_->version() >= 5) {
-    uint32_t crc = 0;
-    crc = crc32c(crc, (const unsigned char*)event_->payload(), event_->eventSize());
+    uint32_t crc = eventChecksum(true);
     if (crc != event_->crc32c()) {
       if (fms_)
         fms_->setExceptionDetected(currentLumiSection_);
@@ -587,8 +606,7 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent() {
           << crc;
     }
   } else if (verifyChecksum_ && event_->version() >= 3) {
-    uint32_t adler = adler32(0L, Z_NULL, 0);
-    adler = adler32(adler, (Bytef*)event_->payload(), event_->eventSize());
+    uint32_t adler = eventChecksum(false);
 
     if (adler != event_->adler32()) {
       if (fms_)
@@ -692,6 +710,7 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
   unsigned char* event = (unsigned char*)event_->payload();
   GTPEventID_ = 0;
   tcds_pointer_ = nullptr;
+  std::vector<std::pair<FEDRawData*, unsigned char const*>> fragments;
   while (eventSize > 0) {
     assert(eventSize >= FEDTrailer::length);
     eventSize -= FEDTrailer::length;
@@ -724,14 +743,62 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
       }
     }
     FEDRawData& fedData = rawData.FEDData(fedId);
+    if (fedData.size() > 0) {
+      //a FED found twice keeps the data of the one found last
+      fragments.erase(std::find_if(
+          fragments.begin(), fragments.end(), [&fedData](auto const& fragment) { return fragment.first == &fedData; }));
+    }
     fedData.resize(fedSize);
-    memcpy(fedData.data(), event + eventSize, fedSize);
+    fragments.emplace_back(&fedData, event + eventSize);
   }
   assert(eventSize == 0);
 
+  //copy the FED data, in parallel for large events
+  auto copyFragments = [&fragments](tbb::blocked_range<size_t> const& range) {
+    for (size_t i = range.begin(); i != range.end(); ++i)
+      memcpy(fragments[i].first->data(), fragments[i].second, fragments[i].first->size());
+  };
+  const size_t nTasks = std::min<size_t>(numAssemblyTasks_, event_->eventSize() / kMinAssemblyBlock);
+  if (nTasks > 1 && fragments.size() > 1)
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, fragments.size(), (fragments.size() + nTasks - 1) / nTasks),
+                      copyFragments,
+                      tbb::simple_partitioner());
+  else
+    copyFragments(tbb::blocked_range<size_t>(0, fragments.size()));
+
   return tstamp;
 }
 
+//checksum of the event payload, computed in parallel blocks which are then combined for large events
+uint32_t FedRawDataInputSource::eventChecksum(bool useCrc32c) const {
+  const unsigned char* payload = (const unsigned char*)event_->payload();
+  const size_t size = event_->eventSize();
+  auto checksum = [useCrc32c](const unsigned char* buf, size_t len) -> uint32_t {
+    if (useCrc32c)
+      return crc32c(0, buf, len);
+    return adler32(adler32(0L, Z_NULL, 0), (const Bytef*)buf, len);
+  };
+
+  const size_t nBlocks = std::min<size_t>(numAssemblyTasks_, size / kMinAssemblyBlock);
+  if (nBlocks <= 1)
+    return checksum(payload, size);
+
+  const size_t blockSize = size / nBlocks;
+  auto blockLength = [&](size_t i) { return i + 1 == nBlocks ? size - i * blockSize : blockSize; };
+  std::vector<uint32_t> checksums(nBlocks);
+  tbb::parallel_for(
+      size_t(0), nBlocks, [&](size_t i) { checksums[i] = checksum(payload + i * blockSize, blockLength(i)); });
+
+  uint32_t result = checksums[0];
+  for (size_t i = 1; i < nBlocks; i++) {
+    if (useCrc32c)
+      result = crc32c_combine(result, checksums[i], blockLength(i));
+    else
+      result = adler32_combine(result, checksums[i], blockLength(i));
+  }
+  return result;
+}
+
 void FedRawDataInputSource::rewind_() {}
 
 void FedRawDataInputSource::readSupervisor() {
@@ -1183,6 +1250,17 @@ void FedRawDataInputSource::readWorker(unsigned int tid) {
   bool init = true;
   threadInit_.exchange(true, std::memory_order_acquire);
 
+  //each thread has its own io_uring, if enabled and supported by the kernel
+  evf::UringReader uring;
+  if (ioUringQueueDepth_ > 0) {
+    if (!uring.init(ioUringQueueDepth_, chunkBuffers_))
+      edm::LogWarning("FedRawDataInputSource") << "readWorker " << tid << " can not use io_uring (" << strerror(errno)
+                                               << "), falling back to read()";
+    else if (!uring.registeredBuffers())
+      edm::LogInfo("FedRawDataInputSource")
+          << "readWorker " << tid << " could not register the chunk buffers with io_uring, reading without";
+  }
+
   while (true) {
     tid_active_[tid] = false;
     std::unique_lock<std::mutex> lk(mReader_);
@@ -1263,32 +1341,60 @@ void FedRawDataInputSource::readWorker(unsigned int tid) {
 
     unsigned int skipped = bufferLeft;
     auto start = std::chrono::high_resolution_clock::now();
-    for (unsigned int i = 0; i < readBlocks_; i++) {
-      ssize_t last;
-
-      //protect against reading into next block
-      last = ::read(
-          fileDescriptor, (void*)(chunk->buf_ + bufferLeft), std::min(chunk->usedSize_ - bufferLeft, eventChunkBlock_));
-
+    if (uring.valid()) {
+      //queue the reads of all blocks at the current position of the descriptor
+      off_t position = lseek(fileDescriptor, 0, SEEK_CUR);
+      ssize_t last = position < 0 ? -1
+                                  : uring.read(fileDescriptor,
+                                               chunk->index_,
+                                               chunk->buf_ + bufferLeft,
+                                               chunk->usedSize_ - bufferLeft,
+                                               position,
+                                               eventChunkBlock_);
       if (last < 0) {
         edm::LogError("FedRawDataInputSource") << "readWorker failed to read file -: " << file->fileName_
                                                << " fd:" << fileDescriptor << " error: " << strerror(errno);
         setExceptionState_ = true;
-        break;
-      }
-      if (last > 0)
+      } else {
         bufferLeft += last;
-      if (last < eventChunkBlock_) {  //last read
-        //check if this is last block, then total read size must match file size
-        if (!(chunk->usedSize_ - skipped == i * eventChunkBlock_ + last)) {
+        if (bufferLeft != chunk->usedSize_) {
           edm::LogError("FedRawDataInputSource")
-              << "readWorker failed to read file -: " << file->fileName_ << " fd:" << fileDescriptor << " last:" << last
-              << " expectedChunkSize:" << chunk->usedSize_
-              << " readChunkSize:" << (skipped + i * eventChunkBlock_ + last) << " skipped:" << skipped
-              << " block:" << (i + 1) << "/" << readBlocks_ << " error: " << strerror(errno);
+              << "readWorker failed to read file -: " << file->fileName_ << " fd:" << fileDescriptor
+              << " expectedChunkSize:" << chunk->usedSize_ << " readChunkSize:" << bufferLeft << " skipped:" << skipped;
           setExceptionState_ = true;
         }
-        break;
+        //leave the descriptor where read() would, it can be used for the next chunk
+        lseek(fileDescriptor, position + last, SEEK_SET);
+      }
+    } else {
+      for (unsigned int i = 0; i < readBlocks_; i++) {
+        ssize_t last;
+
+        //protect against reading into next block
+        last = ::read(fileDescriptor,
+                      (void*)(chunk->buf_ + bufferLeft),
+                      std::min(chunk->usedSize_ - bufferLeft, eventChunkBlock_));
+
+        if (last < 0) {
+          edm::LogError("FedRawDataInputSource") << "readWorker failed to read file -: " << file->fileName_
+                                                 << " fd:" << fileDescriptor << " error: " << strerror(errno);
+          setExceptionState_ = true;
+          break;
+        }
+        if (last > 0)
+          bufferLeft += last;
+        if (last < eventChunkBlock_) {  //last read
+          //check if this is last block, then total read size must match file size
+          if (!(chunk->usedSize_ - skipped == i * eventChunkBlock_ + last)) {
+            edm::LogError("FedRawDataInputSource")
+                << "readWorker failed to read file -: " << file->fileName_ << " fd:" << fileDescriptor
+                << " last:" << last << " expectedChunkSize:" << chunk->usedSize_
+                << " readChunkSize:" << (skipped + i * eventChunkBlock_ + last) << " skipped:" << skipped
+                << " block:" << (i + 1) << "/" << readBlocks_ << " error: " << strerror(errno);
+            setExceptionState_ = true;
+          }
+          break;
+        }
       }
     }
     if (setExceptionState_)
@@ -0,0 +1,262 @@
+#include "EventFilter/Utilities/interface/UringReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define EVF_HAVE_IO_URING 1
+#endif
+
+namespace evf {
+
+#ifdef EVF_HAVE_IO_URING
+  namespace {
+    int io_uring_setup(unsigned int entries, io_uring_params* params) {
+      return syscall(__NR_io_uring_setup, entries, params);
+    }
+
+    int io_uring_enter(int fd, unsigned int toSubmit, unsigned int minComplete, unsigned int flags) {
+      return syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0);
+    }
+
+    int io_uring_register(int fd, unsigned int opcode, void* arg, unsigned int nArgs) {
+      return syscall(__NR_io_uring_register, fd, opcode, arg, nArgs);
+    }
+  }  // namespace
+
+  UringReader::~UringReader() { release(); }
+
+  void UringReader::release() {
+    int savedErrno = errno;
+    if (sqes_)
+      munmap(sqes_, sqesSize_);
+    if (cqRing_ && cqRing_ != sqRing_)
+      munmap(cqRing_, cqRingSize_);
+    if (sqRing_)
+      munmap(sqRing_, sqRingSize_);
+    if (ringFd_ >= 0)
+      close(ringFd_);
+    sqes_ = nullptr;
+    cqRing_ = sqRing_ = nullptr;
+    ringFd_ = -1;
+    fixed_ = false;
+    errno = savedErrno;
+  }
+
+  bool UringReader::init(unsigned int queueDepth, std::vector<std::pair<unsigned char*, size_t>> const& buffers) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd_ = io_uring_setup(queueDepth, &params);
+    if (ringFd_ < 0)
+      return false;
+
+    //map the submission and completion rings, which can share one mapping
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+      sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    sqRing_ =
+        mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) {
+      sqRing_ = nullptr;
+      release();
+      return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+      cqRing_ = sqRing_;
+    else {
+      cqRing_ =
+          mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_CQ_RING);
+      if (cqRing_ == MAP_FAILED) {
+        cqRing_ = nullptr;
+        release();
+        return false;
+      }
+    }
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      release();
+      return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<char*>(sqRing_);
+    auto* cq = static_cast<char*>(cqRing_);
+    sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    depth_ = std::min(params.sq_entries, params.cq_entries);
+    requests_.resize(depth_);
+
+    //registering the buffers pins them in memory, continue without if not allowed
+    std::vector<struct iovec> iovecs;
+    for (auto const& buffer : buffers)
+      iovecs.push_back({buffer.first, buffer.second});
+    if (!iovecs.empty())
+      fixed_ = (io_uring_register(ringFd_, IORING_REGISTER_BUFFERS, iovecs.data(), iovecs.size()) == 0);
+    return true;
+  }
+
+  void UringReader::queue(int fd, unsigned int bufIndex, unsigned char* buf, off_t offset, unsigned int slot) {
+    Request& request = requests_[slot];
+    unsigned tail = *sqTail_;
+    unsigned index = tail & *sqMask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = fd;
+    sqe->off = offset + request.pos;
+    if (fixed_) {
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->addr = reinterpret_cast<uint64_t>(buf + request.pos);
+      sqe->len = request.len;
+      sqe->buf_index = bufIndex;
+    } else {
+      request.iov.iov_base = buf + request.pos;
+      request.iov.iov_len = request.len;
+      sqe->opcode = IORING_OP_READV;
+      sqe->addr = reinterpret_cast<uint64_t>(&request.iov);
+      sqe->len = 1;
+    }
+    sqe->user_data = slot;
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  void UringReader::withdraw() {
+    //without SQPOLL the kernel only takes the submissions in io_uring_enter, those not taken yet can be dropped
+    __atomic_store_n(sqTail_, __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+  }
+
+  ssize_t UringReader::read(
+      int fd, unsigned int bufIndex, unsigned char* buf, size_t size, off_t offset, size_t blockSize) {
+    std::deque<unsigned int> freeSlots;
+    for (unsigned int i = 0; i < depth_; i++)
+      freeSlots.push_back(i);
+    std::deque<unsigned int> retries;
+
+    size_t next = 0;
+    size_t total = 0;
+    unsigned int inFlight = 0;
+    unsigned int pending = 0;
+    bool eof = false;
+    int error = 0;
+
+    //once an error is seen nothing more is queued, but the reads in flight still write into buf:
+    //they are all waited for before returning
+    while (true) {
+      //queue the remainders of short reads first, then the next blocks
+      if (!error) {
+        while (!retries.empty()) {
+          queue(fd, bufIndex, buf, offset, retries.front());
+          retries.pop_front();
+          pending++;
+        }
+        while (!eof && next < size && !freeSlots.empty()) {
+          unsigned int slot = freeSlots.front();
+          freeSlots.pop_front();
+          requests_[slot].pos = next;
+          requests_[slot].len = std::min(blockSize, size - next);
+          next += requests_[slot].len;
+          queue(fd, bufIndex, buf, offset, slot);
+          pending++;
+        }
+      }
+      if (inFlight + pending == 0)
+        break;
+
+      int submitted = io_uring_enter(ringFd_, pending, 1, IORING_ENTER_GETEVENTS);
+      if (submitted < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        if (!error)
+          error = errno;
+        withdraw();
+        pending = 0;
+        if (inFlight > 0 && io_uring_enter(ringFd_, 0, inFlight, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+          //the completions can not be waited for: closing the ring makes the kernel cancel the reads
+          release();
+          errno = error;
+          return -1;
+        }
+      } else if (submitted > 0) {
+        //after EINTR, or EAGAIN and EBUSY with the completion ring full, reap and try again
+        pending -= submitted;
+        inFlight += submitted;
+      }
+
+      unsigned head = *cqHead_;
+      while (head != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+        io_uring_cqe const& cqe = cqes_[head & *cqMask_];
+        unsigned int slot = cqe.user_data;
+        Request& request = requests_[slot];
+        head++;
+        inFlight--;
+        if (cqe.res < 0) {
+          if (!error)
+            error = -cqe.res;
+          freeSlots.push_back(slot);
+        } else if (cqe.res == 0) {
+          //nothing beyond the end of the file
+          eof = true;
+          freeSlots.push_back(slot);
+        } else {
+          total += cqe.res;
+          request.pos += cqe.res;
+          request.len -= cqe.res;
+          if (request.len > 0 && !error)
+            retries.push_back(slot);
+          else
+            freeSlots.push_back(slot);
+        }
+      }
+      __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+      //the blocks queued but not submitted yet are not read after an error
+      if (error && pending > 0) {
+        withdraw();
+        pending = 0;
+      }
+    }
+
+    if (error) {
+      errno = error;
+      return -1;
+    }
+    return total;
+  }
+
+#else
+
+  UringReader::~UringReader() {}
+
+  void UringReader::release() {}
+
+  bool UringReader::init(unsigned int, std::vector<std::pair<unsigned char*, size_t>> const&) {
+    errno = ENOSYS;
+    return false;
+  }
+
+  void UringReader::queue(int, unsigned int, unsigned char*, off_t, unsigned int) {}
+
+  void UringReader::withdraw() {}
+
+  ssize_t UringReader::read(int, unsigned int, unsigned char*, size_t, off_t, size_t) {
+    errno = ENOSYS;
+    return -1;
+  }
+
+#endif
+
+}  // namespace evf
@@ -48,6 +48,14 @@ CMDLINE_STARTFU="cmsRun unittest_FU.py runNumber=101 fffBaseDir=${OUTDIR}"
 ${CMDLINE_STARTBU}  > out_2_bu.log 2>&1 || die "${CMDLINE_STARTBU}" $? $OUTDIR
 ${CMDLINE_STARTFU}  > out_2_fu.log 2>&1 || die "${CMDLINE_STARTFU}" $? $OUTDIR out_2_fu.log
 
+rm -rf $OUTDIR/{ramdisk,data}
+
+echo "Running test with io_uring reads"
+CMDLINE_STARTBU="cmsRun startBU.py runNumber=101 fffBaseDir=${OUTDIR} maxLS=2 fedMeanSize=128 eventsPerFile=20 eventsPerLS=35 frdFileVersion=1"
+CMDLINE_STARTFU="cmsRun unittest_FU.py runNumber=101 fffBaseDir=${OUTDIR} eventChunkBlock=1 ioUringQueueDepth=4"
+${CMDLINE_STARTBU}  > out_3_bu.log 2>&1 || die "${CMDLINE_STARTBU}" $? $OUTDIR
+${CMDLINE_STARTFU}  > out_3_fu.log 2>&1 || die "${CMDLINE_STARTFU}" $? $OUTDIR out_3_fu.log
+
 #no failures, clean up everything including logs if there are no errors
 #rm -rf $OUTDIR/{ramdisk,data,*.py,*.log}
 
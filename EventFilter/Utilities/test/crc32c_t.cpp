@@ -0,0 +1,56 @@
+// crc32c_combine(crc32c(A), crc32c(B), len(B)) gives crc32c(A||B), for any length of A and B
+#include "EventFilter/Utilities/interface/crc32c.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+  int failures = 0;
+
+  void check(bool condition, const char* what, size_t lenA, size_t lenB) {
+    if (not condition) {
+      std::cerr << "failed: " << what << " for " << lenA << " + " << lenB << " bytes" << std::endl;
+      ++failures;
+    }
+  }
+}  // namespace
+
+int main() {
+  // the check value of CRC-32C
+  const unsigned char digits[] = "123456789";
+  check(crc32c(0, digits, 9) == 0xe3069283, "crc32c of 123456789", 9, 0);
+
+  std::mt19937 rng(31);
+  std::vector<unsigned char> data(5000);
+  for (auto& byte : data) {
+    byte = rng();
+  }
+
+  // zero and short lengths, lengths that are not a multiple of the 8 bytes of the hardware loop,
+  // and blocks that do not start on an aligned address
+  const size_t lengths[] = {0, 1, 2, 3, 7, 8, 9, 15, 16, 63, 64, 65, 255, 1000, 2047, 2048, 2049};
+  for (size_t lenA : lengths) {
+    for (size_t lenB : lengths) {
+      for (size_t start : {0, 1, 3}) {
+        const unsigned char* a = data.data() + start;
+        const unsigned char* b = a + lenA;
+        const uint32_t whole = crc32c(0, a, lenA + lenB);
+        check(crc32c_combine(crc32c(0, a, lenA), crc32c(0, b, lenB), lenB) == whole, "combine", lenA, lenB);
+        // the crc of a block continued with the next one gives the same
+        check(crc32c(crc32c(0, a, lenA), b, lenB) == whole, "continued crc", lenA, lenB);
+      }
+    }
+  }
+
+  // more than two blocks combined one after the other, as for the parallel checksum of an event
+  uint32_t combined = crc32c(0, data.data(), 1234);
+  for (size_t first = 1234; first < data.size(); first += 1234) {
+    const size_t len = std::min<size_t>(1234, data.size() - first);
+    combined = crc32c_combine(combined, crc32c(0, data.data() + first, len), len);
+  }
+  check(combined == crc32c(0, data.data(), data.size()), "combine of several blocks", 1234, data.size() - 1234);
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -41,6 +41,18 @@ options.register ('numFwkStreams',
                   VarParsing.VarParsing.varType.int,          # string, int, or float
                   "Number of CMSSW streams")
 
+options.register ('eventChunkBlock',
+                  8, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,          # string, int, or float
+                  "Size of a single read in MB")
+
+options.register ('ioUringQueueDepth',
+                  0, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,          # string, int, or float
+                  "Number of reads in flight with io_uring (0 to use read calls)")
+
 
 options.parseArguments()
 
@@ -88,7 +100,8 @@ process.source = cms.Source("FedRawDataInputSource",
     verifyChecksum = cms.untracked.bool(True),
     useL1EventID = cms.untracked.bool(True),
     eventChunkSize = cms.untracked.uint32(8),
-    eventChunkBlock = cms.untracked.uint32(8),
+    eventChunkBlock = cms.untracked.uint32(options.eventChunkBlock),
+    ioUringQueueDepth = cms.untracked.uint32(options.ioUringQueueDepth),
     numBuffers = cms.untracked.uint32(2),
     maxBufferedFiles = cms.untracked.uint32(2),
     fileListMode = cms.untracked.bool(True),
@@ -0,0 +1,194 @@
+#ifndef FWCore_Concurrency_BatchingSerialTaskQueue_h
+#define FWCore_Concurrency_BatchingSerialTaskQueue_h
+// -*- C++ -*-
+//
+// Package:     Concurrency
+// Class  :     BatchingSerialTaskQueue
+//
+/**\class BatchingSerialTaskQueue BatchingSerialTaskQueue.h "FWCore/Concurrency/interface/BatchingSerialTaskQueue.h"
+
+ Description: Runs only one task from the queue at a time, several tasks per TBB task
+
+ Usage:
+    A BatchingSerialTaskQueue has the same interface and guarantees as edm::SerialTaskQueue and can be
+ used wherever a SerialTaskQueue is used, e.g. as the queue type of edm::SerialTaskQueueChainT or
+ edm::LimitedTaskQueueT.
+
+    The pending functors are kept in an intrusive multi-producer single-consumer list so a push costs
+ one heap allocation and one atomic exchange. The thread which gains the right to run the queue does
+ not spawn one TBB task per functor, instead a single TBB task runs up to kMaxBatchSize pending functors
+ one after the other. Calling pause() from within a running functor is honored before the next functor
+ of the batch is started.
+*/
+//
+
+// system include files
+#include <atomic>
+#include <cassert>
+
+#include "tbb/task.h"
+
+// user include files
+#include "FWCore/Utilities/interface/thread_safety_macros.h"
+
+// forward declarations
+namespace edm {
+  class BatchingSerialTaskQueue {
+  public:
+    ///maximum number of functors run by one TBB task before the queue is rescheduled
+    static constexpr unsigned int kMaxBatchSize = 16;
+
+    BatchingSerialTaskQueue();
+    BatchingSerialTaskQueue(BatchingSerialTaskQueue&& iOther);
+    ~BatchingSerialTaskQueue();
+
+    // ---------- const member functions ---------------------
+    /// Checks to see if the queue has been paused.
+    /**\return true if the queue is paused
+       * \sa pause(), resume()
+       */
+    bool isPaused() const { return m_pauseCount.load() != 0; }
+
+    // ---------- member functions ---------------------------
+    /// Pauses processing of additional tasks from the queue.
+    /**
+       * Any task already running will not be paused however once that
+       * running task finishes no further tasks will be started.
+       * Multiple calls to pause() are allowed, however each call to
+       * pause() must be balanced by a call to resume().
+       * \return false if queue was already paused.
+       * \sa resume(), isPaused()
+       */
+    bool pause() { return 1 == ++m_pauseCount; }
+
+    /// Resumes processing if the queue was paused.
+    /**
+       * Multiple calls to resume() are allowed if there
+       * were multiple calls to pause(). Only when we reach as
+       * many resume() calls as pause() calls will the queue restart.
+       * \return true if the call really restarts the queue
+       * \sa pause(), isPaused()
+       */
+    bool resume();
+
+    /// asynchronously pushes functor iAction into queue
+    /**
+       * The function will return immediately and iAction will either
+       * process concurrently with the calling thread or wait until the
+       * protected resource becomes available or until a CPU becomes available.
+       * \param[in] iAction Must be a functor that takes no arguments and return no values.
+       */
+    template <typename T>
+    void push(const T& iAction);
+
+    /// synchronously pushes functor iAction into queue
+    /**
+       * The function will wait until iAction has completed before returning.
+       * If another task is already running on the queue, the system is allowed
+       * to find another TBB task to execute while waiting for the iAction to finish.
+       * In that way the core is not idled while waiting.
+       * \param[in] iAction Must be a functor that takes no arguments and return no values.
+       */
+    template <typename T>
+    void pushAndWait(const T& iAction);
+
+    /// asynchronously pushes functor iAction into queue and finds next task to execute
+    /**
+       * See SerialTaskQueue::pushAndGetNextTaskToRun.
+       * \param[in] iAction Must be a functor that takes no arguments and return no values.
+       * \return Returns either the next task that the user must schedule with TBB or a nullptr.
+       */
+    template <typename T>
+    tbb::task* pushAndGetNextTaskToRun(const T& iAction);
+
+  private:
+    BatchingSerialTaskQueue(const BatchingSerialTaskQueue&) = delete;
+    const BatchingSerialTaskQueue& operator=(const BatchingSerialTaskQueue&) = delete;
+
+    /** Element of the intrusive list of pending functors */
+    class Node {
+    public:
+      virtual ~Node() = default;
+      virtual void run() {}
+
+      std::atomic<Node*> m_next{nullptr};
+    };
+
+    template <typename T>
+    class ActionNode : public Node {
+    public:
+      ActionNode(const T& iAction) : m_action(iAction) {}
+
+    private:
+      void run() override {
+        // Exception has to swallowed in order to avoid throwing from execute(). The user of BatchingSerialTaskQueue should handle exceptions within m_action().
+        CMS_SA_ALLOW try { this->m_action(); } catch (...) {
+        }
+      }
+
+      T m_action;
+    };
+
+    /** The TBB task which runs a batch of pending functors */
+    class DrainTask : public tbb::task {
+    public:
+      explicit DrainTask(BatchingSerialTaskQueue* iQueue) : m_queue(iQueue) {}
+
+    private:
+      tbb::task* execute() override { return m_queue->drain(); }
+
+      BatchingSerialTaskQueue* m_queue;
+    };
+
+    friend class DrainTask;
+
+    //can be called from any thread
+    void pushNode(Node*);
+    bool empty() const { return m_head.load(std::memory_order_acquire) == &m_stub; }
+    //only called by the thread which set m_taskChosen
+    Node* popNode();
+
+    void pushTask(Node*);
+    tbb::task* pushAndGetNextTask(Node*);
+    //returns nullptr if a task is already being processed
+    tbb::task* pickNextTask();
+    tbb::task* drain();
+
+    // ---------- member data --------------------------------
+    //the most recently pushed node, the producers only touch this
+    std::atomic<Node*> m_head;
+    //the oldest node not yet run, only the consumer touches this
+    Node* m_tail;
+    //placeholder which allows the list to never be truly empty
+    Node m_stub;
+    std::atomic<bool> m_taskChosen;
+    std::atomic<unsigned long> m_pauseCount;
+  };
+
+  template <typename T>
+  void BatchingSerialTaskQueue::push(const T& iAction) {
+    pushTask(new ActionNode<T>{iAction});
+  }
+
+  template <typename T>
+  void BatchingSerialTaskQueue::pushAndWait(const T& iAction) {
+    tbb::empty_task* waitTask = new (tbb::task::allocate_root()) tbb::empty_task;
+    waitTask->set_ref_count(2);
+    push([waitTask, iAction]() {
+      // Exception needs to be caught in order to decrease the waitTask reference count at the end. The user of BatchingSerialTaskQueue should handle exceptions within iAction.
+      CMS_SA_ALLOW try { iAction(); } catch (...) {
+      }
+      waitTask->decrement_ref_count();
+    });
+    waitTask->wait_for_all();
+    tbb::task::destroy(*waitTask);
+  }
+
+  template <typename T>
+  tbb::task* BatchingSerialTaskQueue::pushAndGetNextTaskToRun(const T& iAction) {
+    return pushAndGetNextTask(new ActionNode<T>{iAction});
+  }
+
+}  // namespace edm
+
+#endif
@@ -36,9 +36,13 @@
 
 // forward declarations
 namespace edm {
-  class LimitedTaskQueue {
+  /**The QUEUE template parameter is the type of queue used for each of the concurrency slots.
+     It must provide the same interface as SerialTaskQueue, e.g. BatchingSerialTaskQueue.
+   */
+  template <typename QUEUE>
+  class LimitedTaskQueueT {
   public:
-    LimitedTaskQueue(unsigned int iLimit) : m_queues{iLimit} {}
+    LimitedTaskQueueT(unsigned int iLimit) : m_queues{iLimit} {}
 
     // ---------- member functions ---------------------------
 
@@ -65,7 +69,7 @@ namespace edm {
 
     class Resumer {
     public:
-      friend class LimitedTaskQueue;
+      friend class LimitedTaskQueueT<QUEUE>;
 
       Resumer() = default;
       ~Resumer() { resume(); }
@@ -101,8 +105,8 @@ namespace edm {
       }
 
     private:
-      Resumer(SerialTaskQueue* iQueue) : m_queue{iQueue} {}
-      SerialTaskQueue* m_queue = nullptr;
+      Resumer(QUEUE* iQueue) : m_queue{iQueue} {}
+      QUEUE* m_queue = nullptr;
     };
 
     /// asynchronously pushes functor iAction into queue then pause the queue and run iAction
@@ -116,15 +120,18 @@ namespace edm {
     unsigned int concurrencyLimit() const { return m_queues.size(); }
 
   private:
-    LimitedTaskQueue(const LimitedTaskQueue&) = delete;
-    const LimitedTaskQueue& operator=(const LimitedTaskQueue&) = delete;
+    LimitedTaskQueueT(const LimitedTaskQueueT&) = delete;
+    const LimitedTaskQueueT& operator=(const LimitedTaskQueueT&) = delete;
 
     // ---------- member data --------------------------------
-    std::vector<SerialTaskQueue> m_queues;
+    std::vector<QUEUE> m_queues;
   };
 
+  using LimitedTaskQueue = LimitedTaskQueueT<SerialTaskQueue>;
+
+  template <typename QUEUE>
   template <typename T>
-  void LimitedTaskQueue::push(T&& iAction) {
+  void LimitedTaskQueueT<QUEUE>::push(T&& iAction) {
     auto set_to_run = std::make_shared<std::atomic<bool>>(false);
     for (auto& q : m_queues) {
       q.push([set_to_run, iAction]() mutable {
@@ -136,8 +143,9 @@ namespace edm {
     }
   }
 
+  template <typename QUEUE>
   template <typename T>
-  void LimitedTaskQueue::pushAndWait(T&& iAction) {
+  void LimitedTaskQueueT<QUEUE>::pushAndWait(T&& iAction) {
     tbb::empty_task* waitTask = new (tbb::task::allocate_root()) tbb::empty_task;
     waitTask->set_ref_count(2);
     auto set_to_run = std::make_shared<std::atomic<bool>>(false);
@@ -156,8 +164,9 @@ namespace edm {
     tbb::task::destroy(*waitTask);
   }
 
+  template <typename QUEUE>
   template <typename T>
-  void LimitedTaskQueue::pushAndPause(T&& iAction) {
+  void LimitedTaskQueueT<QUEUE>::pushAndPause(T&& iAction) {
     auto set_to_run = std::make_shared<std::atomic<bool>>(false);
     for (auto& q : m_queues) {
       q.push([&q, set_to_run, iAction]() mutable {
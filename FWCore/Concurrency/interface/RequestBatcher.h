@@ -0,0 +1,141 @@
+#ifndef FWCore_Concurrency_RequestBatcher_h
+#define FWCore_Concurrency_RequestBatcher_h
+// -*- C++ -*-
+//
+// Package:     Concurrency
+// Class  :     RequestBatcher
+//
+/**\class RequestBatcher RequestBatcher.h "FWCore/Concurrency/interface/RequestBatcher.h"
+
+ Description: Runs the requests of several threads together, in batches of a bounded number of rows
+
+ Usage:
+    A RequestBatcher is used to share an inference engine between the framework streams. Each stream
+ submits requests, which the RequestBatcher queues. Its own thread takes the oldest pending requests once
+ they hold maxRows rows, or once the oldest of them waited maxLatency, and hands them to the run functor
+ as one batch. A batch holds at most maxRows rows, unless its single request is larger than that.
+
+    The Request type has a member nRows, the number of rows of the request, and a member
+ done of a type callable with a std::exception_ptr. Once run returns, or throws, done is moved out of each
+ request of the batch and called, with the exception if any, from the thread of the RequestBatcher
+ without a lock held. The request can be reused as soon as its done is called.
+
+    The destructor runs the requests still pending before it returns.
+*/
+//
+
+// system include files
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// user include files
+
+// forward declarations
+namespace edm {
+  template <typename Request>
+  class RequestBatcher {
+  public:
+    ///called with the requests of a batch and their total number of rows
+    using RunFunctor = std::function<void(std::vector<Request*> const&, int64_t)>;
+
+    RequestBatcher(int64_t maxRows, std::chrono::microseconds maxLatency, RunFunctor run)
+        : run_(std::move(run)), maxRows_(maxRows), maxLatency_(maxLatency), pendingRows_(0), stop_(false) {
+      thread_ = std::thread([this]() { runBatches(); });
+    }
+
+    ~RequestBatcher() {
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+      }
+      cond_.notify_one();
+      thread_.join();
+    }
+
+    RequestBatcher(const RequestBatcher&) = delete;
+    RequestBatcher& operator=(const RequestBatcher&) = delete;
+
+    ///queues the request, which the caller keeps alive until request->done has been called
+    void submit(Request* request) {
+      bool notify;
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        pending_.push_back({request, std::chrono::steady_clock::now()});
+        pendingRows_ += request->nRows;
+        // the thread waits for the first request, then for a full batch or the latency bound
+        notify = pending_.size() == 1 || pendingRows_ >= maxRows_;
+      }
+      if (notify) {
+        cond_.notify_one();
+      }
+    }
+
+  private:
+    struct Pending {
+      Request* request;
+      std::chrono::steady_clock::time_point arrival;
+    };
+
+    void runBatches() {
+      std::vector<Request*> batch;
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        cond_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) {
+          // stop_ is set and all the requests are done
+          return;
+        }
+        cond_.wait_until(
+            lock, pending_.front().arrival + maxLatency_, [this]() { return stop_ || pendingRows_ >= maxRows_; });
+
+        // the oldest requests, up to maxRows_ rows; the rest waits for the next batch
+        int64_t nRows = 0;
+        do {
+          nRows += pending_.front().request->nRows;
+          batch.push_back(pending_.front().request);
+          pending_.pop_front();
+        } while (not pending_.empty() and nRows + pending_.front().request->nRows <= maxRows_);
+        pendingRows_ -= nRows;
+
+        lock.unlock();
+        runBatch(batch, nRows);
+        batch.clear();
+        lock.lock();
+      }
+    }
+
+    void runBatch(std::vector<Request*> const& batch, int64_t nRows) {
+      std::exception_ptr exception;
+      try {
+        run_(batch, nRows);
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      for (auto* request : batch) {
+        auto done = std::move(request->done);
+        done(exception);
+      }
+    }
+
+    // ---------- member data --------------------------------
+    const RunFunctor run_;
+    const int64_t maxRows_;
+    const std::chrono::microseconds maxLatency_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Pending> pending_;
+    int64_t pendingRows_;
+    bool stop_;
+    std::thread thread_;
+  };
+}  // namespace edm
+
+#endif
@@ -29,18 +29,21 @@
 
 // forward declarations
 namespace edm {
-  class SerialTaskQueueChain {
+  /**The QUEUE template parameter is the type of queue in the chain.
+     It must provide the same interface as SerialTaskQueue, e.g. BatchingSerialTaskQueue.
+   */
+  template <typename QUEUE>
+  class SerialTaskQueueChainT {
   public:
-    SerialTaskQueueChain() {}
-    explicit SerialTaskQueueChain(std::vector<std::shared_ptr<SerialTaskQueue>> iQueues)
-        : m_queues(std::move(iQueues)) {}
+    SerialTaskQueueChainT() {}
+    explicit SerialTaskQueueChainT(std::vector<std::shared_ptr<QUEUE>> iQueues) : m_queues(std::move(iQueues)) {}
 
-    SerialTaskQueueChain(const SerialTaskQueueChain&) = delete;
-    SerialTaskQueueChain& operator=(const SerialTaskQueueChain&) = delete;
-    SerialTaskQueueChain(SerialTaskQueueChain&& iOld)
+    SerialTaskQueueChainT(const SerialTaskQueueChainT&) = delete;
+    SerialTaskQueueChainT& operator=(const SerialTaskQueueChainT&) = delete;
+    SerialTaskQueueChainT(SerialTaskQueueChainT&& iOld)
         : m_queues(std::move(iOld.m_queues)), m_outstandingTasks{iOld.m_outstandingTasks.load()} {}
 
-    SerialTaskQueueChain& operator=(SerialTaskQueueChain&& iOld) {
+    SerialTaskQueueChainT& operator=(SerialTaskQueueChainT&& iOld) {
       m_queues = std::move(iOld.m_queues);
       m_outstandingTasks.store(iOld.m_outstandingTasks.load());
       return *this;
@@ -72,7 +75,7 @@ namespace edm {
 
   private:
     // ---------- member data --------------------------------
-    std::vector<std::shared_ptr<SerialTaskQueue>> m_queues;
+    std::vector<std::shared_ptr<QUEUE>> m_queues;
     std::atomic<unsigned long> m_outstandingTasks{0};
 
     template <typename T>
@@ -82,8 +85,11 @@ namespace edm {
     void actionToRun(T&& iAction);
   };
 
+  using SerialTaskQueueChain = SerialTaskQueueChainT<SerialTaskQueue>;
+
+  template <typename QUEUE>
   template <typename T>
-  void SerialTaskQueueChain::push(T&& iAction) {
+  void SerialTaskQueueChainT<QUEUE>::push(T&& iAction) {
     ++m_outstandingTasks;
     if (m_queues.size() == 1) {
       m_queues[0]->push([this, iAction]() mutable { this->actionToRun(iAction); });
@@ -93,8 +99,9 @@ namespace edm {
     }
   }
 
+  template <typename QUEUE>
   template <typename T>
-  void SerialTaskQueueChain::pushAndWait(T&& iAction) {
+  void SerialTaskQueueChainT<QUEUE>::pushAndWait(T&& iAction) {
     auto destry = [](tbb::task* iTask) { tbb::task::destroy(*iTask); };
 
     std::unique_ptr<tbb::task, decltype(destry)> waitTask(new (tbb::task::allocate_root()) tbb::empty_task, destry);
@@ -120,8 +127,9 @@ namespace edm {
     }
   }
 
+  template <typename QUEUE>
   template <typename T>
-  void SerialTaskQueueChain::passDownChain(unsigned int iQueueIndex, T&& iAction) {
+  void SerialTaskQueueChainT<QUEUE>::passDownChain(unsigned int iQueueIndex, T&& iAction) {
     //Have to be sure the queue associated to this running task
     // does not attempt to start another task
     m_queues[iQueueIndex - 1]->pause();
@@ -134,11 +142,11 @@ namespace edm {
     }
   }
 
+  template <typename QUEUE>
   template <typename T>
-  void SerialTaskQueueChain::actionToRun(T&& iAction) {
+  void SerialTaskQueueChainT<QUEUE>::actionToRun(T&& iAction) {
     //even if an exception happens we will resume the queues.
-    using Queues = std::vector<std::shared_ptr<SerialTaskQueue>>;
-    auto sentryAction = [](SerialTaskQueueChain* iChain) {
+    auto sentryAction = [](SerialTaskQueueChainT* iChain) {
       auto& vec = iChain->m_queues;
       for (auto it = vec.rbegin() + 1; it != vec.rend(); ++it) {
         (*it)->resume();
@@ -146,7 +154,7 @@ namespace edm {
       --(iChain->m_outstandingTasks);
     };
 
-    std::unique_ptr<SerialTaskQueueChain, decltype(sentryAction)> sentry(this, sentryAction);
+    std::unique_ptr<SerialTaskQueueChainT, decltype(sentryAction)> sentry(this, sentryAction);
     iAction();
   }
 }  // namespace edm
@@ -0,0 +1,174 @@
+// -*- C++ -*-
+//
+// Package:     Concurrency
+// Class  :     BatchingSerialTaskQueue
+//
+// Implementation:
+//     The list of pending functors is the intrusive multi-producer single-consumer
+//  queue of D. Vyukov. Producers swap themselves into m_head and then link the
+//  previous head to themselves. The consumer walks from m_tail. m_stub is put
+//  back into the list whenever the consumer takes the last node so that a node
+//  being handed out is never the one later producers link to.
+//
+
+// system include files
+
+// user include files
+#include "FWCore/Concurrency/interface/BatchingSerialTaskQueue.h"
+#include "FWCore/Concurrency/interface/hardware_pause.h"
+
+#include "FWCore/Utilities/interface/Likely.h"
+
+using namespace edm;
+
+namespace {
+  //A producer which has swapped itself into m_head but has not yet linked the
+  // previous head is only a few instructions away from doing so.
+  template <typename T>
+  T* waitForNext(std::atomic<T*> const& iNext) {
+    T* next = iNext.load(std::memory_order_acquire);
+    while (nullptr == next) {
+      hardware_pause();
+      next = iNext.load(std::memory_order_acquire);
+    }
+    return next;
+  }
+}  // namespace
+
+//
+// constructors and destructor
+//
+BatchingSerialTaskQueue::BatchingSerialTaskQueue()
+    : m_head(&m_stub), m_tail(&m_stub), m_taskChosen(false), m_pauseCount{0} {}
+
+BatchingSerialTaskQueue::BatchingSerialTaskQueue(BatchingSerialTaskQueue&& iOther)
+    : m_head(&m_stub),
+      m_tail(&m_stub),
+      m_taskChosen(iOther.m_taskChosen.exchange(false)),
+      m_pauseCount(iOther.m_pauseCount.exchange(0)) {
+  assert(iOther.empty() and m_taskChosen == false);
+}
+
+BatchingSerialTaskQueue::~BatchingSerialTaskQueue() {
+  //be certain all tasks have completed
+  bool isEmpty = empty();
+  bool isTaskChosen = m_taskChosen;
+  if ((not isEmpty and not isPaused()) or isTaskChosen) {
+    pushAndWait([]() { return; });
+  }
+  //a paused queue can still hold functors which will never be run
+  if (not empty()) {
+    m_taskChosen = true;
+    Node* n = popNode();
+    while (nullptr != n) {
+      delete n;
+      n = popNode();
+    }
+  }
+}
+
+//
+// member functions
+//
+bool BatchingSerialTaskQueue::resume() {
+  if (0 == --m_pauseCount) {
+    tbb::task* t = pickNextTask();
+    if (nullptr != t) {
+      tbb::task::spawn(*t);
+    }
+    return true;
+  }
+  return false;
+}
+
+void BatchingSerialTaskQueue::pushNode(Node* iNode) {
+  iNode->m_next.store(nullptr, std::memory_order_relaxed);
+  Node* previous = m_head.exchange(iNode, std::memory_order_acq_rel);
+  previous->m_next.store(iNode, std::memory_order_release);
+}
+
+BatchingSerialTaskQueue::Node* BatchingSerialTaskQueue::popNode() {
+  Node* tail = m_tail;
+  Node* next = tail->m_next.load(std::memory_order_acquire);
+  if (tail == &m_stub) {
+    if (nullptr == next) {
+      if (empty()) {
+        return nullptr;
+      }
+      next = waitForNext(tail->m_next);
+    }
+    m_tail = next;
+    tail = next;
+    next = next->m_next.load(std::memory_order_acquire);
+  }
+  if
+    LIKELY(nullptr != next) {
+      m_tail = next;
+      return tail;
+    }
+  if (tail != m_head.load(std::memory_order_acquire)) {
+    //a producer is in the middle of appending to tail
+    m_tail = waitForNext(tail->m_next);
+    return tail;
+  }
+  //tail is the last node so put the stub behind it before handing it out
+  pushNode(&m_stub);
+  m_tail = waitForNext(tail->m_next);
+  return tail;
+}
+
+void BatchingSerialTaskQueue::pushTask(Node* iNode) {
+  tbb::task* t = pushAndGetNextTask(iNode);
+  if (nullptr != t) {
+    tbb::task::spawn(*t);
+  }
+}
+
+tbb::task* BatchingSerialTaskQueue::pushAndGetNextTask(Node* iNode) {
+  tbb::task* returnValue{nullptr};
+  if
+    LIKELY(nullptr != iNode) {
+      pushNode(iNode);
+      returnValue = pickNextTask();
+    }
+  return returnValue;
+}
+
+tbb::task* BatchingSerialTaskQueue::pickNextTask() {
+  bool expect = false;
+  if
+    LIKELY(0 == m_pauseCount and m_taskChosen.compare_exchange_strong(expect, true)) {
+      if
+        LIKELY(not empty()) { return new (tbb::task::allocate_root()) DrainTask(this); }
+      //nothing to run
+      m_taskChosen.store(false);
+
+      //was a new entry added after we checked but before we did the clear?
+      expect = false;
+      if (not empty() and 0 == m_pauseCount and m_taskChosen.compare_exchange_strong(expect, true)) {
+        if (not empty()) {
+          return new (tbb::task::allocate_root()) DrainTask(this);
+        }
+        //a different thread beat us to it
+        m_taskChosen.store(false);
+      }
+    }
+  return nullptr;
+}
+
+tbb::task* BatchingSerialTaskQueue::drain() {
+  for (unsigned int i = 0; i < kMaxBatchSize; ++i) {
+    Node* n = popNode();
+    if (nullptr == n) {
+      break;
+    }
+    n->run();
+    delete n;
+    //the functor may have paused the queue
+    if (isPaused()) {
+      break;
+    }
+  }
+  m_taskChosen.store(false);
+  return pickNextTask();
+}
@@ -0,0 +1,109 @@
+#include "FWCore/Concurrency/interface/RequestBatcher.h"
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+  struct Request {
+    int id = 0;
+    int nRows = 0;
+    std::function<void(std::exception_ptr)> done;
+  };
+
+  int failures = 0;
+
+  void check(bool condition, const char* what) {
+    if (not condition) {
+      std::cerr << "failed: " << what << std::endl;
+      ++failures;
+    }
+  }
+}  // namespace
+
+int main() {
+  std::mutex mutex;
+  std::vector<int64_t> batchRows;
+  std::vector<int> order;
+  std::atomic<int> nDone{0};
+  std::atomic<int> nFailed{0};
+  auto done = [&](std::exception_ptr exception) {
+    if (exception) {
+      nFailed++;
+    }
+    nDone++;
+  };
+
+  // requests of 2 rows from several threads, in batches of at most 5 rows
+  const int nThreads = 4;
+  const int perThread = 10;
+  std::vector<Request> requests(nThreads * perThread);
+  {
+    edm::RequestBatcher<Request> batcher(
+        5, std::chrono::milliseconds(20), [&](std::vector<Request*> const& batch, int64_t nRows) {
+          int64_t sum = 0;
+          std::lock_guard<std::mutex> guard(mutex);
+          for (auto const* request : batch) {
+            sum += request->nRows;
+            order.push_back(request->id);
+          }
+          check(sum == nRows, "number of rows of a batch");
+          batchRows.push_back(nRows);
+        });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int i = 0; i < perThread; ++i) {
+          auto& request = requests[t * perThread + i];
+          request.id = t * perThread + i;
+          request.nRows = 2;
+          request.done = done;
+          batcher.submit(&request);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    // the destructor runs what is still pending
+  }
+  check(nDone == nThreads * perThread and nFailed == 0, "all the requests are done once");
+  check(order.size() == requests.size(), "all the requests are run once");
+  for (auto rows : batchRows) {
+    check(rows > 0 and rows <= 5, "the batches hold at most the maximum number of rows");
+  }
+  // the requests of one thread are run in the order they were submitted
+  for (int t = 0; t < nThreads; ++t) {
+    int last = -1;
+    for (int id : order) {
+      if (id / perThread == t) {
+        check(id > last, "requests of a thread run in order");
+        last = id;
+      }
+    }
+  }
+
+  // a request larger than the maximum is run alone, and a failed run is reported to its requests
+  {
+    nDone = 0;
+    batchRows.clear();
+    edm::RequestBatcher<Request> batcher(
+        4, std::chrono::milliseconds(1), [&](std::vector<Request*> const&, int64_t nRows) {
+          batchRows.push_back(nRows);
+          throw std::runtime_error("failed run");
+        });
+    Request large{0, 6, done};
+    batcher.submit(&large);
+    while (nDone < 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    check(batchRows.size() == 1 and batchRows[0] == 6, "a large request is run alone");
+    check(nFailed == 1, "the exception of a failed run is given to done");
+    check(not large.done, "done is moved out of the request");
+  }
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+//
+//  serialtaskqueue_benchmark.cpp
+//
+//  Compares the time needed to push and run many short tasks through
+//  edm::SerialTaskQueue and edm::BatchingSerialTaskQueue, either from
+//  one thread or from several threads simultaneously.
+//
+//  Usage: serialtaskqueue_benchmark [number of tasks per pusher] [number of pushers]
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "tbb/task.h"
+#include "tbb/task_scheduler_init.h"
+
+#include "FWCore/Concurrency/interface/BatchingSerialTaskQueue.h"
+#include "FWCore/Concurrency/interface/FunctorTask.h"
+#include "FWCore/Concurrency/interface/SerialTaskQueue.h"
+
+namespace {
+  template <typename QUEUE>
+  double timePushes(unsigned int iNTasks, unsigned int iNPushers) {
+    QUEUE queue;
+    std::atomic<unsigned long> sum{0};
+
+    std::shared_ptr<tbb::task> waitTask{new (tbb::task::allocate_root()) tbb::empty_task{},
+                                        [](tbb::task* iTask) { tbb::task::destroy(*iTask); }};
+    waitTask->set_ref_count(1 + iNPushers);
+    tbb::task* pWaitTask = waitTask.get();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int p = 0; p < iNPushers; ++p) {
+      auto pusher = edm::make_functor_task(tbb::task::allocate_root(), [&queue, &sum, iNTasks, pWaitTask] {
+        for (unsigned int i = 0; i < iNTasks; ++i) {
+          pWaitTask->increment_ref_count();
+          queue.push([&sum, pWaitTask, i] {
+            //the tasks protected by a shared resource are usually short
+            sum.store(sum.load(std::memory_order_relaxed) + i, std::memory_order_relaxed);
+            pWaitTask->decrement_ref_count();
+          });
+        }
+        pWaitTask->decrement_ref_count();
+      });
+      tbb::task::spawn(*pusher);
+    }
+    waitTask->wait_for_all();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  template <typename QUEUE>
+  void report(char const* iName, unsigned int iNTasks, unsigned int iNPushers) {
+    //warm up the TBB thread pool and the allocator
+    timePushes<QUEUE>(iNTasks / 10 + 1, iNPushers);
+    double seconds = timePushes<QUEUE>(iNTasks, iNPushers);
+    std::cout << iName << " pushers: " << iNPushers << " total time: " << seconds << " s, per task: "
+              << 1.e9 * seconds / (static_cast<double>(iNTasks) * iNPushers) << " ns" << std::endl;
+  }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  unsigned int nTasks = 1000000;
+  unsigned int nPushers = 4;
+  if (argc > 1) {
+    nTasks = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    nPushers = std::atoi(argv[2]);
+  }
+  tbb::task_scheduler_init init(nPushers + 1);
+
+  report<edm::SerialTaskQueue>("SerialTaskQueue        ", nTasks, 1);
+  report<edm::BatchingSerialTaskQueue>("BatchingSerialTaskQueue", nTasks, 1);
+  report<edm::SerialTaskQueue>("SerialTaskQueue        ", nTasks, nPushers);
+  report<edm::BatchingSerialTaskQueue>("BatchingSerialTaskQueue", nTasks, nPushers);
+  return 0;
+}
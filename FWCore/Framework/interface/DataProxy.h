@@ -21,6 +21,7 @@
 
 // system include files
 #include <atomic>
+#include <string>
 
 // user include files
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
@@ -59,6 +60,13 @@ namespace edm {
       ///returns the description of the DataProxyProvider which owns this Proxy
       ComponentDescription const* providerDescription() const { return description_; }
 
+      /**returns an identifier of the content of the data for the present IOV, e.g. the hash of
+          a payload read from the conditions database. Two IOVs with the same non empty value hold
+          identical data. An empty string, the default, means the content is not known before the
+          data is made.
+          */
+      virtual std::string const& payloadHash() const;
+
       // ---------- member functions ---------------------------
       void invalidate() {
         clearCacheIsValid();
@@ -75,6 +75,9 @@ namespace edm {
     // ---------- const member functions ---------------------
     ProductResolverIndexAndSkipBit indexFrom(EDGetToken, BranchType, TypeID const&) const;
     ProductResolverIndexAndSkipBit uncheckedIndexFrom(EDGetToken) const;
+    ///Same as indexFrom except if a request without process name can only be satisfied by one process
+    /// the index of the ProductResolver for that process is returned. Use this only to get the product.
+    ProductResolverIndexAndSkipBit directIndexFrom(EDGetToken, BranchType, TypeID const&) const;
 
     void itemsToGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
     void itemsMayGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
@@ -107,6 +110,10 @@ namespace edm {
 
     std::vector<ConsumesInfo> consumesInfo() const;
 
+    ///appends the record and the index in the record of each EventSetup data item declared with esConsumes
+    /// which is provided by a module. Only meaningful after updateLookup was called.
+    void esItemsConsumed(std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const;
+
     ESProxyIndex const* esGetTokenIndices(edm::Transition iTrans) const {
       auto const& v = esItemsToGetFromTransition_[static_cast<unsigned int>(iTrans)];
       if (v.empty()) {
@@ -193,6 +200,7 @@ namespace edm {
     void throwTypeMismatch(edm::TypeID const&, EDGetToken) const;
     void throwBranchMismatch(BranchType, EDGetToken) const;
     void throwBadToken(edm::TypeID const& iType, EDGetToken iToken) const;
+    void checkLookupInfo(EDGetToken, BranchType, TypeID const&) const;
     void throwConsumesCallAfterFrozen(TypeToGet const&, InputTag const&) const;
 
     edm::InputTag const& checkIfEmpty(edm::InputTag const& tag);
@@ -200,10 +208,12 @@ namespace edm {
 
     struct TokenLookupInfo {
       TokenLookupInfo(edm::TypeID const& iID, ProductResolverIndex iIndex, bool skipCurrentProcess, BranchType iBranch)
-          : m_type(iID), m_index(iIndex, skipCurrentProcess), m_branchType(iBranch) {}
+          : m_type(iID), m_index(iIndex, skipCurrentProcess), m_branchType(iBranch), m_directIndex(iIndex) {}
       edm::TypeID m_type;
       ProductResolverIndexAndSkipBit m_index;
       BranchType m_branchType;
+      //m_index with the indirection through a SingleChoiceNoProcessProductResolver removed
+      ProductResolverIndex m_directIndex;
     };
 
     struct LabelPlacement {
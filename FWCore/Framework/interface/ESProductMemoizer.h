@@ -0,0 +1,98 @@
+#ifndef FWCore_Framework_ESProductMemoizer_h
+#define FWCore_Framework_ESProductMemoizer_h
+// -*- C++ -*-
+//
+// Package:     Framework
+// Class:      ESProductMemoizer
+//
+/**\class edm::ESProductMemoizer
+
+  Description: Helps an ESProducer reuse the ESProduct it made for a
+previous IOV when the product only depends on conditions payloads and
+the hashes of those payloads did not change.
+
+The hashes are obtained from EventSetupRecord::payloadHash which does
+not cause the payloads to be read. If any hash is empty the content of
+that input is not known and the product is always remade.
+
+  Usage:
+
+An ESProducer whose produce method returns a std::shared_ptr would use
+this class.
+
+1. Add to the ESProducer header
+
+    #include "FWCore/Framework/interface/ESProductMemoizer.h"
+
+    edm::ESProductMemoizer<ESTestDataB> memoizer_;
+
+2. Declare the payloads the product depends on by passing their hashes
+in the produce function
+
+    std::shared_ptr<ESTestDataB> ESTestProducerB::produce(ESTestRecordB const& record) {
+      return memoizer_.makeOrReuse({record.payloadHash(tokenA_), record.getRecord<ESTestRecordC>().payloadHash(tokenC_)},
+                                   [&]() { return std::make_shared<ESTestDataB>(record.get(tokenA_), ...); });
+    }
+
+The product is shared between IOVs so it must not be modified after
+it was returned from the produce function.
+*/
+//
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace edm {
+
+  template <typename Product>
+  class ESProductMemoizer {
+  public:
+    ESProductMemoizer() = default;
+    ESProductMemoizer(ESProductMemoizer const&) = delete;
+    ESProductMemoizer& operator=(ESProductMemoizer const&) = delete;
+
+    /// returns the previous product if iHashes match the hashes it was made with, else calls iMake
+    template <typename F>
+    std::shared_ptr<Product> makeOrReuse(std::vector<std::string> iHashes, F&& iMake) {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (product_ and iHashes == hashes_ and allKnown(iHashes)) {
+        ++nReused_;
+        return product_;
+      }
+      // reset first so a failing iMake never leaves a product with stale hashes
+      product_.reset();
+      hashes_.clear();
+      auto product = std::shared_ptr<Product>(std::invoke(std::forward<F>(iMake)));
+      if (allKnown(iHashes)) {
+        product_ = product;
+        hashes_ = std::move(iHashes);
+      }
+      return product;
+    }
+
+    /// number of times a product was returned without calling the make function
+    unsigned int numberReused() const {
+      std::lock_guard<std::mutex> guard(mutex_);
+      return nReused_;
+    }
+
+  private:
+    static bool allKnown(std::vector<std::string> const& iHashes) {
+      for (auto const& hash : iHashes) {
+        if (hash.empty()) {
+          return false;
+        }
+      }
+      return not iHashes.empty();
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::string> hashes_;
+    std::shared_ptr<Product> product_;
+    unsigned int nReused_ = 0;
+  };
+}  // namespace edm
+#endif
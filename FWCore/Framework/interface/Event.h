@@ -44,6 +44,7 @@ For its usage, see "FWCore/Framework/interface/PrincipalGetAdapter.h"
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
 
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_set>
 #include <typeinfo>
@@ -247,6 +248,11 @@ namespace edm {
 
     ModuleCallingContext const* moduleCallingContext() const { return moduleCallingContext_; }
 
+    ///Memory for temporaries needed only while processing this Event. If the EventArenaService
+    /// is used this is an arena of the calling module which is released once the Event is done,
+    /// else it is the default heap resource. Memory from it must not be used after the Event.
+    std::pmr::memory_resource* memoryResource() const;
+
     void labelsForToken(EDGetToken const& iToken, ProductLabels& oLabels) const {
       provRecorder_.labelsForToken(iToken, oLabels);
     }
@@ -0,0 +1,63 @@
+#ifndef FWCore_Framework_EventArenaService_h
+#define FWCore_Framework_EventArenaService_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArenaService
+//
+/**\class edm::service::EventArenaService EventArenaService.h "FWCore/Framework/interface/EventArenaService.h"
+
+ Description: Gives each module on each stream a monotonic memory arena reset at the end of each Event
+
+ Usage:
+    When the service is present in the job, edm::Event::memoryResource() returns the arena
+ of the calling module instead of the default heap resource. Modules use it for their
+ per Event temporaries, e.g. with std::pmr::vector. All memory of a stream is made
+ available again when its EventPrincipal is cleared at the end of the Event.
+
+    The largest amount of memory taken by each module during one Event is reported by
+ SimpleMemoryCheck when its moduleMemorySummary is enabled.
+*/
+//
+
+// system include files
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// user include files
+
+// forward declarations
+namespace edm {
+  class ActivityRegistry;
+  class ConfigurationDescriptions;
+  class EventArenas;
+  class ParameterSet;
+
+  namespace service {
+    class EventArenaService {
+    public:
+      EventArenaService(ParameterSet const&, ActivityRegistry&);
+      EventArenaService(const EventArenaService&) = delete;
+      EventArenaService& operator=(const EventArenaService&) = delete;
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+      // ---------- const member functions ---------------------
+      ///largest number of bytes used by each module during one Event, over all streams
+      std::map<std::string, std::size_t> peakUsagePerModule() const;
+
+      // ---------- member functions ---------------------------
+      ///called by the framework when creating the EventPrincipal of each stream
+      std::shared_ptr<EventArenas> makeArenas();
+
+    private:
+      std::size_t initialBytesPerModule_;
+      std::vector<std::shared_ptr<EventArenas>> arenas_;
+    };
+  }  // namespace service
+}  // namespace edm
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef FWCore_Framework_EventArenas_h
+#define FWCore_Framework_EventArenas_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArenas
+//
+/**\class edm::EventArenas EventArenas.h "FWCore/Framework/interface/EventArenas.h"
+
+ Description: Per stream set of monotonic memory arenas, one per module
+
+ Usage:
+    Each EventPrincipal can hold an EventArenas, it is created by the EventArenaService.
+ A module obtains the arena for its own use via edm::Event::memoryResource(). Memory
+ obtained from the arena is never given back individually, instead all of it is
+ released at once in EventPrincipal::clearEventPrincipal. Therefore the memory must
+ not outlive the Event, but it may be used by data products put into the Event.
+
+    Since a module is only ever running for one Event on a given stream, the arena
+ of a module does not need any synchronization. Different modules of the same stream
+ may request their arenas concurrently.
+*/
+//
+
+// system include files
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "tbb/concurrent_unordered_map.h"
+
+// user include files
+
+// forward declarations
+namespace edm {
+  class ModuleDescription;
+
+  class EventArenas {
+  public:
+    explicit EventArenas(std::size_t iInitialBytesPerModule);
+    EventArenas(const EventArenas&) = delete;
+    EventArenas& operator=(const EventArenas&) = delete;
+    ~EventArenas();
+
+    // ---------- const member functions ---------------------
+    ///For each module label, sets the value to the largest number of bytes the module
+    /// took from its arena during one Event if that is larger than the value already there
+    void fillPeakUsage(std::map<std::string, std::size_t>& oPeakPerModule) const;
+
+    // ---------- member functions ---------------------------
+    ///The arena for the module. The same pointer is returned for all calls of a module.
+    std::pmr::memory_resource* resource(ModuleDescription const& iModule);
+
+    ///Makes all memory handed out from all the arenas available again.
+    /// Must only be called when no module is running on the stream.
+    void reset();
+
+  private:
+    class ModuleArena : public std::pmr::memory_resource {
+    public:
+      ModuleArena(std::string iLabel, std::size_t iInitialBytes);
+
+      void reset();
+
+      std::string const& label() const { return label_; }
+      std::size_t peak() const { return peak_; }
+
+    private:
+      void makeArena();
+
+      void* do_allocate(std::size_t iBytes, std::size_t iAlignment) override;
+      void do_deallocate(void*, std::size_t, std::size_t) override {}
+      bool do_is_equal(std::pmr::memory_resource const& iOther) const noexcept override { return this == &iOther; }
+
+      std::string label_;
+      //the monotonic resource hands out pieces of buffer_ and only goes to the
+      // heap once buffer_ is exhausted
+      std::vector<std::byte> buffer_;
+      std::optional<std::pmr::monotonic_buffer_resource> arena_;
+      std::size_t used_ = 0;
+      std::size_t peak_ = 0;
+    };
+
+    // ---------- member data --------------------------------
+    tbb::concurrent_unordered_map<unsigned int, std::shared_ptr<ModuleArena>> arenas_;
+    std::size_t initialBytesPerModule_;
+  };
+}  // namespace edm
+
+#endif
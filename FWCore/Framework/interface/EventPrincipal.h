@@ -20,6 +20,7 @@ is the DataBlock.
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/Signal.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
+#include "FWCore/Utilities/interface/thread_safety_macros.h"
 #include "FWCore/Framework/interface/Principal.h"
 
 #include <map>
@@ -33,6 +34,7 @@ namespace edm {
   class BranchIDListHelper;
   class ProductProvenanceRetriever;
   class DelayedReader;
+  class EventArenas;
   class EventID;
   class HistoryAppender;
   class LuminosityBlockPrincipal;
@@ -105,6 +107,10 @@ namespace edm {
 
     StreamID streamID() const { return streamID_; }
 
+    ///per module memory arenas, nullptr unless the EventArenaService is used
+    EventArenas* arenas() const { return arenas_.get(); }
+    void setArenas(std::shared_ptr<EventArenas> iArenas) { arenas_ = std::move(iArenas); }
+
     LuminosityBlockNumber_t luminosityBlock() const { return id().luminosityBlock(); }
 
     RunNumber_t run() const { return id().run(); }
@@ -181,6 +187,9 @@ namespace edm {
 
     std::vector<ProcessIndex> branchListIndexToProcessIndex_;
 
+    //The arenas are a resource shared with the modules and changing them does not change the Event
+    CMS_THREAD_SAFE std::shared_ptr<EventArenas> arenas_;
+
     StreamID streamID_;
   };
 
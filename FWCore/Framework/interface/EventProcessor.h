@@ -12,6 +12,7 @@ configured in the user's main() function, and is set running.
 #include "DataFormats/Provenance/interface/RunID.h"
 #include "DataFormats/Provenance/interface/LuminosityBlockID.h"
 
+#include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/InputSource.h"
 #include "FWCore/Framework/interface/MergeableRunProductProcesses.h"
@@ -31,6 +32,7 @@ configured in the user's main() function, and is set running.
 #include "FWCore/Concurrency/interface/SerialTaskQueue.h"
 #include "FWCore/Concurrency/interface/LimitedTaskQueue.h"
 
+#include "FWCore/Utilities/interface/ESIndices.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 
 #include <map>
@@ -40,6 +42,7 @@ configured in the user's main() function, and is set running.
 #include <vector>
 #include <exception>
 #include <mutex>
+#include <utility>
 
 namespace edm {
 
@@ -317,6 +320,9 @@ namespace edm {
     edm::propagate_const<std::unique_ptr<eventsetup::EventSetupsController>> espController_;
     edm::propagate_const<std::shared_ptr<eventsetup::EventSetupProvider>> esp_;
     edm::SerialTaskQueue queueWhichWaitsForIOVsToFinish_;
+    // the EventSetup data consumed by the modules, requested as soon as the IOVs of a lumi are ready
+    // if the prefetchNewIOVs option is set (empty otherwise)
+    std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>> esItemsToPrefetch_;
     std::unique_ptr<ExceptionToActionTable const> act_table_;
     std::shared_ptr<ProcessConfiguration const> processConfiguration_;
     ProcessContext processContext_;
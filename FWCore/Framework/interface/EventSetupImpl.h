@@ -64,6 +64,10 @@ namespace edm {
 
     bool validRecord(eventsetup::EventSetupRecordKey const& iKey) const;
 
+    ///fills the caches of the listed data for the IOVs held by this object, records not held are skipped.
+    /// Any exception thrown while producing the data is propagated.
+    void prefetch(std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>> const& iItems) const;
+
     ///Only EventSetupProvider allowed to create an EventSetupImpl
     friend class eventsetup::EventSetupProvider;
     friend class eventsetup::EventSetupRecordProvider;
@@ -53,6 +53,7 @@
 #include <exception>
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include <atomic>
@@ -195,6 +196,18 @@ namespace edm {
           */
       unsigned int iovIndex() const { return impl_->iovIndex(); }
 
+      /**returns an identifier of the content the token refers to for this IOV without making
+          the data, see DataProxy::payloadHash(). The value is an empty string if the content is
+          not known, e.g. because the data is made by an ESProducer.
+          */
+      template <typename T, typename R>
+      std::string const& payloadHash(ESGetToken<T, R> const& iToken) const {
+        if
+          UNLIKELY(iToken.transitionID() != transitionID()) { throwWrongTransitionID(); }
+        assert(getTokenIndices_);
+        return impl_->payloadHash(iToken.hasValidIndex() ? getTokenIndices_[iToken.index().value()] : ESProxyIndex{});
+      }
+
       ///clears the oToFill vector and then fills it with the keys for all registered data keys
       void fillRegisteredDataKeys(std::vector<DataKey>& oToFill) const { impl_->fillRegisteredDataKeys(oToFill); }
 
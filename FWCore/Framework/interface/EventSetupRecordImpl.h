@@ -49,6 +49,7 @@ through the 'validityInterval' method.
 #include <exception>
 #include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include <atomic>
@@ -139,6 +140,9 @@ namespace edm {
 
       DataProxy const* find(DataKey const& aKey) const;
 
+      ///returns DataProxy::payloadHash() for the proxy or an empty string if there is no such proxy
+      std::string const& payloadHash(ESProxyIndex iProxyIndex) const;
+
       void validate(ComponentDescription const*, ESInputTag const&) const;
 
       void addTraceInfoToCmsException(cms::Exception& iException,
@@ -149,6 +153,9 @@ namespace edm {
       void invalidateProxies();
       void resetIfTransientInProxies();
 
+      ///Asks the DataProxy at iProxyIndex to fill its cache for the present IOV so later requests find the data ready
+      void prefetch(ESProxyIndex iProxyIndex, EventSetupImpl const*) const;
+
     private:
       void const* getFromProxy(DataKey const& iKey,
                                ComponentDescription const*& iDesc,
@@ -234,6 +234,9 @@ namespace edm {
                                    std::vector<std::vector<ModuleDescription const*>>& modulesWhoseProductsAreConsumedBy,
                                    ProductRegistry const& preg) const;
 
+    ///fills oItems with the EventSetup data the modules declared with esConsumes, sorted and without duplicates
+    void esItemsConsumed(std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const;
+
     /// Return the number of events this Schedule has tried to process
     /// (inclues both successes and failures, including failures due
     /// to exceptions during processing).
@@ -310,6 +313,7 @@ namespace edm {
     std::vector<std::string> const* pathNames_;
     std::vector<std::string> const* endPathNames_;
     bool wantSummary_;
+    bool criticalPathScheduling_;
 
     volatile bool endpathsAreActive_;
   };
@@ -28,7 +28,6 @@
 class testSharedResourcesRegistry;
 
 namespace edm {
-  class SerialTaskQueueChain;
   class SerialTaskQueue;
 
   class SharedResourcesAcquirer {
@@ -185,7 +185,10 @@ namespace edm {
         ~LuminosityBlockSummaryCacheHolder() noexcept(false){};
 
       private:
-        void preallocLumisSummary(unsigned int iNLumis) final { caches_.reset(new std::shared_ptr<C>[iNLumis]); }
+        void preallocLumisSummary(unsigned int iNLumis) final {
+          caches_.reset(new std::shared_ptr<C>[iNLumis]);
+          mutexes_.reset(new std::mutex[iNLumis]);
+        }
 
         friend class EndLuminosityBlockSummaryProducer<T, C>;
 
@@ -194,7 +197,9 @@ namespace edm {
         }
 
         void doStreamEndLuminosityBlockSummary_(StreamID id, LuminosityBlock const& lb, EventSetup const& c) final {
-          std::lock_guard<std::mutex> guard(mutex_);
+          //Only the streams ending the same LuminosityBlock need to be serialized. Streams merging
+          // into the summary of another concurrent LuminosityBlock do not have to wait.
+          std::lock_guard<std::mutex> guard(mutexes_[lb.index()]);
           streamEndLuminosityBlockSummary(id, lb, c, caches_[lb.index()].get());
         }
         void doEndLuminosityBlockSummary_(LuminosityBlock const& lb, EventSetup const& c) final {
@@ -215,7 +220,7 @@ namespace edm {
 
         //When threaded we will have a container for N items where N is # of simultaneous Lumis
         std::unique_ptr<std::shared_ptr<C>[]> caches_;
-        std::mutex mutex_;
+        std::unique_ptr<std::mutex[]> mutexes_;
       };
 
       template <typename T>
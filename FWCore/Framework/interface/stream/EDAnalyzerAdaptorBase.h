@@ -27,6 +27,8 @@
 #include "DataFormats/Provenance/interface/BranchType.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EventSetupRecordKey.h"
+#include "FWCore/Utilities/interface/ESIndices.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/ParameterSet/interface/ParameterSetfwd.h"
 #include "FWCore/ServiceRegistry/interface/ConsumesInfo.h"
@@ -112,6 +114,8 @@ namespace edm {
 
       std::vector<ConsumesInfo> consumesInfo() const;
 
+      void esItemsConsumed(std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const;
+
     private:
       EDAnalyzerAdaptorBase(const EDAnalyzerAdaptorBase&) = delete;  // stop default
 
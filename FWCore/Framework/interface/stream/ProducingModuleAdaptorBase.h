@@ -28,6 +28,8 @@
 #include "DataFormats/Provenance/interface/BranchType.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EventSetupRecordKey.h"
+#include "FWCore/Utilities/interface/ESIndices.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/ParameterSet/interface/ParameterSetfwd.h"
 #include "FWCore/Utilities/interface/StreamID.h"
@@ -103,6 +105,8 @@ namespace edm {
 
       std::vector<ConsumesInfo> consumesInfo() const;
 
+      void esItemsConsumed(std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const;
+
       using ModuleToResolverIndicies =
           std::unordered_multimap<std::string, std::tuple<edm::TypeID const*, const char*, edm::ProductResolverIndex>>;
 
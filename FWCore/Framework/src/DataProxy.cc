@@ -37,6 +37,11 @@ namespace edm {
 
     DataProxy::~DataProxy() {}
 
+    std::string const& DataProxy::payloadHash() const {
+      static const std::string s_noHash;
+      return s_noHash;
+    }
+
     void DataProxy::clearCacheIsValid() {
       cacheIsValid_.store(false, std::memory_order_release);
       nonTransientAccessRequested_.store(false, std::memory_order_release);
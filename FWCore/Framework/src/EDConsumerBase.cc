@@ -146,12 +146,24 @@ void EDConsumerBase::updateLookup(BranchType iBranchType,
       if (itInfo->m_branchType == iBranchType) {
         const unsigned int labelStart = itLabels->m_startOfModuleLabel;
         const char* moduleLabel = &(m_tokenLabels[labelStart]);
-        itInfo->m_index = ProductResolverIndexAndSkipBit(iHelper.index(*itKind,
-                                                                       itInfo->m_type,
-                                                                       moduleLabel,
-                                                                       moduleLabel + itLabels->m_deltaToProductInstance,
-                                                                       moduleLabel + itLabels->m_deltaToProcessName),
-                                                         itInfo->m_index.skipCurrentProcess());
+        const char* processName = moduleLabel + itLabels->m_deltaToProcessName;
+        itInfo->m_index = ProductResolverIndexAndSkipBit(
+            iHelper.index(
+                *itKind, itInfo->m_type, moduleLabel, moduleLabel + itLabels->m_deltaToProductInstance, processName),
+            itInfo->m_index.skipCurrentProcess());
+        itInfo->m_directIndex = itInfo->m_index.productResolverIndex();
+        if (*moduleLabel != '\0' and *processName == '\0' and
+            itInfo->m_directIndex != ProductResolverIndexInvalid and
+            itInfo->m_directIndex != ProductResolverIndexAmbiguous) {
+          //The Principal uses a SingleChoiceNoProcessProductResolver when only one process
+          // has a match (the first match is the entry without a process name). Going directly
+          // to the ProductResolver it forwards to avoids one lookup and virtual call per get.
+          auto matches = iHelper.relatedIndexes(
+              *itKind, itInfo->m_type, moduleLabel, moduleLabel + itLabels->m_deltaToProductInstance);
+          if (matches.numberOfMatches() == 2 and matches.index(1) != ProductResolverIndexAmbiguous) {
+            itInfo->m_directIndex = matches.index(1);
+          }
+        }
       }
     }
   }
@@ -260,20 +272,29 @@ ESTokenIndex EDConsumerBase::recordESConsumes(Transition iTrans,
 ProductResolverIndexAndSkipBit EDConsumerBase::indexFrom(EDGetToken iToken,
                                                          BranchType iBranch,
                                                          TypeID const& iType) const {
+  checkLookupInfo(iToken, iBranch, iType);
+  return m_tokenInfo.get<kLookupInfo>(iToken.index()).m_index;
+}
+
+ProductResolverIndexAndSkipBit EDConsumerBase::directIndexFrom(EDGetToken iToken,
+                                                               BranchType iBranch,
+                                                               TypeID const& iType) const {
+  checkLookupInfo(iToken, iBranch, iType);
+  const auto& info = m_tokenInfo.get<kLookupInfo>(iToken.index());
+  return ProductResolverIndexAndSkipBit(info.m_directIndex, info.m_index.skipCurrentProcess());
+}
+
+void EDConsumerBase::checkLookupInfo(EDGetToken iToken, BranchType iBranch, TypeID const& iType) const {
   if (UNLIKELY(iToken.index() >= m_tokenInfo.size())) {
     throwBadToken(iType, iToken);
   }
   const auto& info = m_tokenInfo.get<kLookupInfo>(iToken.index());
-  if (LIKELY(iBranch == info.m_branchType)) {
-    if (LIKELY(iType == info.m_type)) {
-      return info.m_index;
-    } else {
-      throwTypeMismatch(iType, iToken);
-    }
-  } else {
+  if (UNLIKELY(iBranch != info.m_branchType)) {
     throwBranchMismatch(iBranch, iToken);
   }
-  return ProductResolverIndexAndSkipBit(edm::ProductResolverIndexInvalid, false);
+  if (UNLIKELY(iType != info.m_type)) {
+    throwTypeMismatch(iType, iToken);
+  }
 }
 
 ProductResolverIndexAndSkipBit EDConsumerBase::uncheckedIndexFrom(EDGetToken iToken) const {
@@ -588,6 +609,16 @@ std::vector<ConsumesInfo> EDConsumerBase::consumesInfo() const {
   return result;
 }
 
+void EDConsumerBase::esItemsConsumed(
+    std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const {
+  auto itIndex = m_esTokenInfo.begin<kESProxyIndex>();
+  for (auto it = m_esTokenInfo.begin<kESLookupInfo>(); it != m_esTokenInfo.end<kESLookupInfo>(); ++it, ++itIndex) {
+    if (itIndex->value() >= 0 && *itIndex != eventsetup::ESRecordsToProxyIndices::missingProxyIndex()) {
+      oItems.emplace_back(it->m_record, *itIndex);
+    }
+  }
+}
+
 const char* EDConsumerBase::labelFor(ESTokenIndex iIndex) const {
   return m_esTokenInfo.get<kESLookupInfo>(iIndex.value()).m_key.name().value();
 }
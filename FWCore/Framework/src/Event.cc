@@ -5,9 +5,11 @@
 #include "DataFormats/Provenance/interface/StableProvenance.h"
 #include "DataFormats/Provenance/interface/ParentageRegistry.h"
 #include "FWCore/Common/interface/TriggerResultsByName.h"
+#include "FWCore/Framework/interface/EventArenas.h"
 #include "FWCore/Framework/interface/EventPrincipal.h"
 #include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/InputTag.h"
 
@@ -100,6 +102,14 @@ namespace edm {
 
   EDProductGetter const& Event::productGetter() const { return provRecorder_.principal(); }
 
+  std::pmr::memory_resource* Event::memoryResource() const {
+    auto arenas = eventPrincipal().arenas();
+    if (nullptr == arenas or nullptr == moduleCallingContext_) {
+      return std::pmr::get_default_resource();
+    }
+    return arenas->resource(*moduleCallingContext_->moduleDescription());
+  }
+
   ProductID Event::makeProductID(BranchDescription const& desc) const {
     return eventPrincipal().branchIDToProductID(desc.originalBranchID());
   }
@@ -0,0 +1,46 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArenaService
+//
+// Implementation:
+//     The plugin is registered in FWCore/Services/plugins
+//
+
+// system include files
+
+// user include files
+#include "FWCore/Framework/interface/EventArenaService.h"
+#include "FWCore/Framework/interface/EventArenas.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+namespace edm {
+  namespace service {
+    EventArenaService::EventArenaService(ParameterSet const& iPSet, ActivityRegistry&)
+        : initialBytesPerModule_(1024 * iPSet.getUntrackedParameter<unsigned int>("initialSizePerModuleInKB")) {}
+
+    void EventArenaService::fillDescriptions(ConfigurationDescriptions& descriptions) {
+      ParameterSetDescription desc;
+      desc.addUntracked<unsigned int>("initialSizePerModuleInKB", 64)
+          ->setComment(
+              "Size of the arena given to a module on its first Event. The arena grows to the largest size needed "
+              "during one Event.");
+      descriptions.add("EventArenaService", desc);
+    }
+
+    std::shared_ptr<EventArenas> EventArenaService::makeArenas() {
+      arenas_.push_back(std::make_shared<EventArenas>(initialBytesPerModule_));
+      return arenas_.back();
+    }
+
+    std::map<std::string, std::size_t> EventArenaService::peakUsagePerModule() const {
+      std::map<std::string, std::size_t> peaks;
+      for (auto const& arenas : arenas_) {
+        arenas->fillPeakUsage(peaks);
+      }
+      return peaks;
+    }
+  }  // namespace service
+}  // namespace edm
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArenas
+//
+// Implementation:
+//     A ModuleArena remembers the largest amount of memory its module
+//  used during one Event and grows its buffer to that size on reset
+//  so that, after a few Events, no heap allocation is needed anymore.
+//
+
+// system include files
+#include <algorithm>
+
+// user include files
+#include "FWCore/Framework/interface/EventArenas.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+
+namespace edm {
+  //
+  // constructors and destructor
+  //
+  EventArenas::EventArenas(std::size_t iInitialBytesPerModule) : initialBytesPerModule_(iInitialBytesPerModule) {}
+
+  EventArenas::~EventArenas() = default;
+
+  EventArenas::ModuleArena::ModuleArena(std::string iLabel, std::size_t iInitialBytes)
+      : label_(std::move(iLabel)), buffer_(iInitialBytes) {
+    makeArena();
+  }
+
+  //
+  // member functions
+  //
+  void EventArenas::ModuleArena::makeArena() {
+    if (buffer_.empty()) {
+      arena_.emplace();
+    } else {
+      arena_.emplace(buffer_.data(), buffer_.size());
+    }
+  }
+
+  void* EventArenas::ModuleArena::do_allocate(std::size_t iBytes, std::size_t iAlignment) {
+    used_ += iBytes;
+    return arena_->allocate(iBytes, iAlignment);
+  }
+
+  void EventArenas::ModuleArena::reset() {
+    peak_ = std::max(peak_, used_);
+    //must release the memory from the monotonic resource before changing the buffer it uses
+    arena_.reset();
+    if (used_ > buffer_.size()) {
+      //leave room for the padding needed for alignment
+      buffer_ = std::vector<std::byte>(used_ + used_ / 8);
+    }
+    used_ = 0;
+    makeArena();
+  }
+
+  std::pmr::memory_resource* EventArenas::resource(ModuleDescription const& iModule) {
+    auto found = arenas_.find(iModule.id());
+    if (found != arenas_.end()) {
+      return found->second.get();
+    }
+    //only this module on this stream can be inserting this key
+    auto inserted = arenas_.insert(
+        std::make_pair(iModule.id(), std::make_shared<ModuleArena>(iModule.moduleLabel(), initialBytesPerModule_)));
+    return inserted.first->second.get();
+  }
+
+  void EventArenas::reset() {
+    for (auto& idAndArena : arenas_) {
+      idAndArena.second->reset();
+    }
+  }
+
+  //
+  // const member functions
+  //
+  void EventArenas::fillPeakUsage(std::map<std::string, std::size_t>& oPeakPerModule) const {
+    for (auto const& idAndArena : arenas_) {
+      auto& peak = oPeakPerModule[idAndArena.second->label()];
+      peak = std::max(peak, idAndArena.second->peak());
+    }
+  }
+}  // namespace edm
@@ -1,4 +1,5 @@
 #include "FWCore/Framework/interface/EventPrincipal.h"
+#include "FWCore/Framework/interface/EventArenas.h"
 
 #include "DataFormats/Common/interface/BasicHandle.h"
 #include "DataFormats/Common/interface/FunctorHandleExceptionFactory.h"
@@ -59,6 +60,10 @@ namespace edm {
     //do not clear luminosityBlockPrincipal_ since
     // it is only connected at beginLumi transition
     provRetrieverPtr_->reset();
+    //the data products which might use memory from the arenas are gone
+    if (arenas_) {
+      arenas_->reset();
+    }
   }
 
   void EventPrincipal::fillEventPrincipal(EventAuxiliary const& aux,
@@ -9,6 +9,7 @@
 
 #include "FWCore/Framework/interface/CommonParams.h"
 #include "FWCore/Framework/interface/EDLooperBase.h"
+#include "FWCore/Framework/interface/EventArenaService.h"
 #include "FWCore/Framework/interface/EventPrincipal.h"
 #include "FWCore/Framework/interface/EventSetupProvider.h"
 #include "FWCore/Framework/interface/EventSetupRecord.h"
@@ -474,6 +475,10 @@ namespace edm {
                                                  *processConfiguration_,
                                                  historyAppender_.get(),
                                                  index);
+      Service<service::EventArenaService> arenaService;
+      if (arenaService.isAvailable()) {
+        ep->setArenas(arenaService->makeArenas());
+      }
       principalCache_.insert(std::move(ep));
     }
 
@@ -566,6 +571,9 @@ namespace edm {
     }
     espController_->finishConfiguration();
     schedule_->beginJob(*preg_, esp_->recordsToProxyIndices());
+    if (espController_->prefetchNewIOVs()) {
+      schedule_->esItemsConsumed(esItemsToPrefetch_);
+    }
     // toerror.succeeded(); // should we add this?
     for_all(subProcesses_, [](auto& subProcess) { subProcess.doBeginJob(); });
     actReg_->postBeginJobSignal_();
@@ -1189,9 +1197,20 @@ namespace edm {
 
     auto queueLumiWorkTask = make_waiting_task(
         tbb::task::allocate_root(),
-        [this, lumiWorkLambda = std::move(lumiWork), iHolder](std::exception_ptr const* iPtr) mutable {
+        [this, lumiWorkLambda = std::move(lumiWork), iHolder, status](std::exception_ptr const* iPtr) mutable {
           if (iPtr) {
             iHolder.doneWaiting(*iPtr);
+          } else if (!esItemsToPrefetch_.empty()) {
+            // The IOVs are ready but the lumi may still have to wait for a previous
+            // lumi to finish in lumiQueue_. Build the EventSetup data the modules
+            // consume while waiting.
+            // Caught exception is propagated via WaitingTaskHolder
+            CMS_SA_ALLOW try {
+              ServiceRegistry::Operate operate(serviceToken_);
+              status->eventSetupImpl(esp_->subProcessIndex()).prefetch(esItemsToPrefetch_);
+            } catch (...) {
+              iHolder.doneWaiting(std::current_exception());
+            }
           }
           lumiQueue_->pushAndPause(std::move(lumiWorkLambda));
         });
@@ -90,6 +90,16 @@ namespace edm {
     return false;
   }
 
+  void EventSetupImpl::prefetch(
+      std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>> const& iItems) const {
+    for (auto const& item : iItems) {
+      auto recordImpl = findImpl(item.first);
+      if (recordImpl != nullptr) {
+        recordImpl->prefetch(item.second, this);
+      }
+    }
+  }
+
   void EventSetupImpl::setKeyIters(std::vector<eventsetup::EventSetupRecordKey>::const_iterator const& keysBegin,
                                    std::vector<eventsetup::EventSetupRecordKey>::const_iterator const& keysEnd) {
     keysBegin_ = keysBegin;
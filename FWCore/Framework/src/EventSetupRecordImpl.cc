@@ -177,6 +177,20 @@ namespace edm {
       }
     }
 
+    std::string const& EventSetupRecordImpl::payloadHash(ESProxyIndex iProxyIndex) const {
+      static const std::string s_noHash;
+      if (iProxyIndex.value() < 0 or iProxyIndex.value() >= static_cast<ESProxyIndex::Value_t>(proxies_.size())) {
+        return s_noHash;
+      }
+      return proxies_[iProxyIndex.value()]->payloadHash();
+    }
+
+    void EventSetupRecordImpl::prefetch(ESProxyIndex iProxyIndex, EventSetupImpl const* iEventSetupImpl) const {
+      ComponentDescription const* desc = nullptr;
+      DataKey const* dataKey = nullptr;
+      getFromProxy(iProxyIndex, false, desc, dataKey, iEventSetupImpl);
+    }
+
     const void* EventSetupRecordImpl::getFromProxy(DataKey const& iKey,
                                                    const ComponentDescription*& iDesc,
                                                    bool iTransientAccessOnly,
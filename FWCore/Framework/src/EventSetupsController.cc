@@ -48,6 +48,9 @@ namespace edm {
       fillEventSetupProvider(*this, *returnValue, iPSet);
 
       numberOfConcurrentIOVs_.readConfigurationParameters(eventSetupPset);
+      if (eventSetupPset) {  // this condition is false for SubProcesses
+        prefetchNewIOVs_ = eventSetupPset->getUntrackedParameter<bool>("prefetchNewIOVs");
+      }
 
       providers_.push_back(returnValue);
       return returnValue;
@@ -159,6 +159,10 @@ namespace edm {
       bool hasNonconcurrentFinder() const { return hasNonconcurrentFinder_; }
       bool mustFinishConfiguration() const { return mustFinishConfiguration_; }
 
+      // If true, the data for a new IOV should be prefetched as soon as the IOV
+      // is initialized so it is built while the previous transition is still running.
+      bool prefetchNewIOVs() const { return prefetchNewIOVs_; }
+
     private:
       void checkESProducerSharing();
       void initializeEventSetupRecordIOVQueues();
@@ -186,6 +190,7 @@ namespace edm {
 
       bool hasNonconcurrentFinder_ = false;
       bool mustFinishConfiguration_ = true;
+      bool prefetchNewIOVs_ = false;
     };
   }  // namespace eventsetup
 }  // namespace edm
@@ -148,7 +148,7 @@ namespace edm {
                                                KindOfType kindOfType,
                                                EDGetToken token,
                                                ModuleCallingContext const* mcc) const {
-    ProductResolverIndexAndSkipBit indexAndBit = consumer_->indexFrom(token, branchType(), id);
+    ProductResolverIndexAndSkipBit indexAndBit = consumer_->directIndexFrom(token, branchType(), id);
     ProductResolverIndex index = indexAndBit.productResolverIndex();
     bool skipCurrentProcess = indexAndBit.skipCurrentProcess();
     if (UNLIKELY(index == ProductResolverIndexInvalid)) {
@@ -588,6 +588,8 @@ namespace edm {
         pathNames_(&tns.getTrigPaths()),
         endPathNames_(&tns.getEndPaths()),
         wantSummary_(tns.wantSummary()),
+        criticalPathScheduling_(proc_pset.getUntrackedParameterSet("options", ParameterSet())
+                                    .getUntrackedParameter<bool>("criticalPathScheduling", false)),
         endpathsAreActive_(true) {
     makePathStatusInserters(pathStatusInserters_,
                             *pathNames_,
@@ -746,7 +748,8 @@ namespace edm {
       c->setEventSelectionInfo(outputModulePathPositions, preg.anyProductProduced());
     }
 
-    if (wantSummary_) {
+    //critical path aware scheduling uses the module timing collected for the summary
+    if (wantSummary_ or criticalPathScheduling_) {
       std::vector<const ModuleDescription*> modDesc;
       const auto& workers = allWorkers();
       modDesc.reserve(workers.size());
@@ -1227,6 +1230,11 @@ namespace edm {
 
   void Schedule::beginJob(ProductRegistry const& iRegistry, eventsetup::ESRecordsToProxyIndices const& iESIndices) {
     globalSchedule_->beginJob(iRegistry, iESIndices);
+    if (criticalPathScheduling_) {
+      for (auto& s : streamSchedules_) {
+        s->initializeCriticalPathScheduling(iRegistry, summaryTimeKeeper_.get());
+      }
+    }
   }
 
   void Schedule::beginStream(unsigned int iStreamID) {
@@ -1336,6 +1344,18 @@ namespace edm {
     streamSchedules_[0]->moduleDescriptionsInEndPath(iEndPathLabel, descriptions, hint);
   }
 
+  void Schedule::esItemsConsumed(
+      std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const {
+    oItems.clear();
+    for (auto const* worker : allWorkers()) {
+      worker->esItemsConsumed(oItems);
+    }
+    std::sort(oItems.begin(), oItems.end(), [](auto const& a, auto const& b) {
+      return a.first < b.first || (a.first == b.first && a.second.value() < b.second.value());
+    });
+    oItems.erase(std::unique(oItems.begin(), oItems.end()), oItems.end());
+  }
+
   void Schedule::fillModuleAndConsumesInfo(
       std::vector<ModuleDescription const*>& allModuleDescriptions,
       std::vector<std::pair<unsigned int, unsigned int>>& moduleIDToIndex,
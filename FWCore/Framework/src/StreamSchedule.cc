@@ -3,6 +3,7 @@
 #include "DataFormats/Provenance/interface/BranchIDListHelper.h"
 #include "DataFormats/Provenance/interface/ProcessConfiguration.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "DataFormats/Provenance/interface/ProductResolverIndexHelper.h"
 #include "FWCore/Framework/interface/OutputModuleDescription.h"
 #include "FWCore/Framework/interface/TriggerNamesService.h"
 #include "FWCore/Framework/interface/TriggerReport.h"
@@ -16,6 +17,7 @@
 #include "FWCore/Framework/src/ModuleHolder.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/src/ModuleRegistry.h"
+#include "FWCore/Framework/src/SystemTimeKeeper.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
@@ -35,10 +37,15 @@
 #include <iomanip>
 #include <list>
 #include <map>
+#include <set>
 #include <exception>
 
 namespace edm {
   namespace {
+    //number of events processed on a stream before the critical path costs are first computed
+    constexpr int kFirstCriticalPathUpdate = 10;
+    //number of events between updates of the critical path costs
+    constexpr int kCriticalPathUpdateInterval = 100;
 
     // Function template to transform each element in the input range to
     // a value placed into the output range. The supplied function
@@ -126,6 +133,90 @@ namespace edm {
         }
       }
     }
+
+    //Adds all the Event products to the list except those in 'cannotDeleteEarly' and the
+    // ones related to an EDAlias or a SwitchProducer, since the consumers of the alias
+    // would not be seen as consumers of the aliased product. Products which are only reached
+    // through an edm::Ref or edm::Ptr are not visible in the consumes calls so those must be
+    // listed in 'cannotDeleteEarly'.
+    void addAllBranchesToDeleteEarly(ParameterSet const& opts,
+                                     ProductRegistry const& preg,
+                                     std::multimap<std::string, Worker*>& branchToReadingWorker) {
+      auto vKeep = opts.getUntrackedParameter<std::vector<std::string>>("cannotDeleteEarly");
+      std::set<std::string> branchesToKeep(vKeep.begin(), vKeep.end());
+
+      std::set<std::string> aliasedModules;
+      for (auto const& aliasAndOriginal : preg.aliasToOriginal()) {
+        aliasedModules.insert(aliasAndOriginal.first);
+        aliasedModules.insert(aliasAndOriginal.second);
+      }
+      for (auto const& prod : preg.productList()) {
+        BranchDescription const& desc = prod.second;
+        if (desc.branchType() == InEvent and desc.isSwitchAlias()) {
+          aliasedModules.insert(desc.moduleLabel());
+          aliasedModules.insert(desc.switchAliasModuleLabel());
+        }
+      }
+
+      for (auto const& prod : preg.productList()) {
+        BranchDescription const& desc = prod.second;
+        if (desc.branchType() != InEvent or desc.isAnyAlias() or
+            aliasedModules.find(desc.moduleLabel()) != aliasedModules.end()) {
+          continue;
+        }
+        //the branch names all end with a period, which we do not want to compare with
+        std::string branch = desc.branchName();
+        branch.resize(branch.size() - 1);
+        if (branchesToKeep.find(branch) == branchesToKeep.end() and
+            branchToReadingWorker.find(branch) == branchToReadingWorker.end()) {
+          branchToReadingWorker.insert(std::make_pair(branch, static_cast<Worker*>(nullptr)));
+        }
+      }
+    }
+
+    //Fills the names of the Event branches the worker might read based on its consumes calls.
+    // When the consumes call does not say enough to know the branch, e.g. consumesMany of a View,
+    // every candidate branch is assumed to be read.
+    void fillConsumedBranches(Worker const& iWorker,
+                              std::multimap<std::string, BranchDescription const*> const& labelToBranches,
+                              std::vector<BranchDescription const*> const& allBranches,
+                              std::set<std::string>& oBranches) {
+      auto addBranch = [&oBranches](BranchDescription const& iDesc) {
+        std::string branch = iDesc.branchName();
+        branch.resize(branch.size() - 1);
+        oBranches.insert(std::move(branch));
+      };
+      for (auto const& info : iWorker.consumesInfo()) {
+        if (info.branchType() != InEvent) {
+          continue;
+        }
+        bool const isProductType = info.kindOfType() == PRODUCT_TYPE;
+        std::string const friendlyName = isProductType ? info.type().friendlyClassName() : std::string();
+        if (info.label().empty()) {
+          //consumesMany
+          for (auto const* desc : allBranches) {
+            if (not isProductType or desc->friendlyClassName() == friendlyName) {
+              addBranch(*desc);
+            }
+          }
+          continue;
+        }
+        auto range = labelToBranches.equal_range(info.label());
+        for (auto it = range.first; it != range.second; ++it) {
+          BranchDescription const& desc = *it->second;
+          if (desc.productInstanceName() != info.instance()) {
+            continue;
+          }
+          if (isProductType and desc.friendlyClassName() != friendlyName) {
+            continue;
+          }
+          if (not info.process().empty() and not info.skipCurrentProcess() and desc.processName() != info.process()) {
+            continue;
+          }
+          addBranch(desc);
+        }
+      }
+    }
   }  // namespace
 
   // -----------------------------
@@ -253,6 +344,15 @@ namespace edm {
     // registered for this job
     std::multimap<std::string, Worker*> branchToReadingWorker;
     initializeBranchToReadingWorker(opts, preg, branchToReadingWorker);
+    //only the products explicitly asked for are worth a warning if not used
+    std::set<std::string> branchesRequestedByName;
+    for (auto const& branchAndWorker : branchToReadingWorker) {
+      branchesRequestedByName.insert(branchAndWorker.first);
+    }
+    bool const autoDeleteEarly = opts.getUntrackedParameter<bool>("autoDeleteEarly");
+    if (autoDeleteEarly) {
+      addAllBranchesToDeleteEarly(opts, preg, branchToReadingWorker);
+    }
 
     //If no delete early items have been specified we don't have to do anything
     if (branchToReadingWorker.empty()) {
@@ -288,11 +388,26 @@ namespace edm {
       return;
     }
 
+    std::multimap<std::string, BranchDescription const*> labelToBranches;
+    std::vector<BranchDescription const*> allBranches;
+    if (autoDeleteEarly) {
+      for (auto const& prod : preg.productList()) {
+        if (prod.second.branchType() == InEvent) {
+          labelToBranches.emplace(prod.second.moduleLabel(), &prod.second);
+          allBranches.push_back(&prod.second);
+        }
+      }
+    }
+
     for (auto w : allWorkers()) {
       //determine if this module could read a branch we want to delete early
       auto pset = pset::Registry::instance()->getMapped(w->description().parameterSetID());
       if (nullptr != pset) {
-        auto branches = pset->getUntrackedParameter<std::vector<std::string>>("mightGet", kEmpty);
+        auto mightGet = pset->getUntrackedParameter<std::vector<std::string>>("mightGet", kEmpty);
+        std::set<std::string> branches(mightGet.begin(), mightGet.end());
+        if (autoDeleteEarly) {
+          fillConsumedBranches(*w, labelToBranches, allBranches, branches);
+        }
         if (not branches.empty()) {
           ++upperLimitOnReadingWorker;
         }
@@ -315,7 +430,9 @@ namespace edm {
       std::vector<std::string> unusedBranches;
       while (it != branchToReadingWorker.end()) {
         if (it->second == nullptr) {
-          unusedBranches.push_back(it->first);
+          if (branchesRequestedByName.find(it->first) != branchesRequestedByName.end()) {
+            unusedBranches.push_back(it->first);
+          }
           //erasing the object invalidates the iterator so must advance it first
           auto temp = it;
           ++it;
@@ -526,6 +643,88 @@ namespace edm {
     }
   }
 
+  void StreamSchedule::initializeCriticalPathScheduling(ProductRegistry const& preg,
+                                                        SystemTimeKeeper const* iTimeKeeper) {
+    criticalPathTimeKeeper_ = iTimeKeeper;
+    criticalPathProducers_.clear();
+    criticalPathIndexToWorker_.clear();
+    if (nullptr == iTimeKeeper or allWorkers().empty()) {
+      return;
+    }
+
+    std::map<std::string, ModuleDescription const*> labelToDesc;
+    std::map<ModuleDescription const*, unsigned int> descToWorkerIndex;
+    std::map<std::string, unsigned int> labelToWorkerIndex;
+    unsigned int i = 0;
+    for (auto const& worker : allWorkers()) {
+      ModuleDescription const* p = worker->descPtr();
+      labelToDesc[p->moduleLabel()] = p;
+      descToWorkerIndex[p] = i;
+      labelToWorkerIndex[p->moduleLabel()] = i;
+      ++i;
+    }
+
+    criticalPathProducers_.resize(allWorkers().size());
+    std::vector<ModuleDescription const*> modules;
+    i = 0;
+    for (auto const& worker : allWorkers()) {
+      modules.clear();
+      worker->modulesWhoseProductsAreConsumed(modules, preg, labelToDesc);
+      auto& producers = criticalPathProducers_[i];
+      producers.reserve(modules.size());
+      for (auto const* desc : modules) {
+        auto found = descToWorkerIndex.find(desc);
+        if (found != descToWorkerIndex.end() and found->second != i) {
+          producers.push_back(found->second);
+        }
+      }
+      ++i;
+    }
+
+    auto const& processName = allWorkers().front()->description().processName();
+    for (auto const& labelAndIndex : preg.productLookup(InEvent)->indiciesForModulesInProcess(processName)) {
+      auto found = labelToWorkerIndex.find(labelAndIndex.first);
+      if (found != labelToWorkerIndex.end()) {
+        criticalPathIndexToWorker_.emplace_back(std::get<2>(labelAndIndex.second), found->second);
+      }
+    }
+  }
+
+  void StreamSchedule::updateCriticalPathCosts() {
+    auto const& workers = allWorkers();
+    //the time of the longest chain of producers ending with (and including) each worker
+    std::vector<double> pathCost(workers.size(), -1.);
+    //used to protect against a badly formed dependency graph
+    std::vector<bool> visiting(workers.size(), false);
+
+    std::function<double(unsigned int)> cost = [&](unsigned int iIndex) -> double {
+      if (pathCost[iIndex] >= 0. or visiting[iIndex]) {
+        return std::max(pathCost[iIndex], 0.);
+      }
+      visiting[iIndex] = true;
+      double longestProducerPath = 0.;
+      for (auto producer : criticalPathProducers_[iIndex]) {
+        longestProducerPath = std::max(longestProducerPath, cost(producer));
+      }
+      visiting[iIndex] = false;
+      pathCost[iIndex] =
+          longestProducerPath +
+          criticalPathTimeKeeper_->averageModuleEventTime(streamID_, workers[iIndex]->description().id());
+      return pathCost[iIndex];
+    };
+
+    std::vector<double> costPerIndex;
+    for (auto const& indexAndWorker : criticalPathIndexToWorker_) {
+      if (indexAndWorker.first >= costPerIndex.size()) {
+        costPerIndex.resize(indexAndWorker.first + 1, 0.);
+      }
+      costPerIndex[indexAndWorker.first] = cost(indexAndWorker.second);
+    }
+    for (auto worker : workers) {
+      worker->orderEventPrefetchBy(costPerIndex);
+    }
+  }
+
   void StreamSchedule::beginStream() { workerManager_.beginStream(streamID_, streamContext_); }
 
   void StreamSchedule::endStream() { workerManager_.endStream(streamID_, streamContext_); }
@@ -596,6 +795,14 @@ namespace edm {
         }
       }
 
+      //None of the workers of this stream are running so it is safe to change their prefetch order.
+      // Refresh early so the first events benefit, then periodically as the timing statistics settle.
+      if (criticalPathTimeKeeper_ and
+          (total_events_ == kFirstCriticalPathUpdate or
+           (total_events_ > 0 and 0 == total_events_ % kCriticalPathUpdateInterval))) {
+        updateCriticalPathCosts();
+      }
+
       // This call takes care of the unscheduled processing.
       workerManager_.setupOnDemandSystem(ep, es);
 
@@ -112,6 +112,7 @@ namespace edm {
   class EndPathStatusInserter;
   class PreallocationConfiguration;
   class WaitingTaskHolder;
+  class SystemTimeKeeper;
 
   namespace service {
     class TriggerNamesService;
@@ -198,6 +199,10 @@ namespace edm {
     void beginStream();
     void endStream();
 
+    ///Enables critical path aware prefetching using the per module timing
+    /// collected by iTimeKeeper. Must be called after the ProductRegistry is frozen.
+    void initializeCriticalPathScheduling(ProductRegistry const& preg, SystemTimeKeeper const* iTimeKeeper);
+
     StreamID streamID() const { return streamID_; }
 
     /// Return a vector allowing const access to all the
@@ -320,6 +325,8 @@ namespace edm {
 
     void addToAllWorkers(Worker* w);
 
+    void updateCriticalPathCosts();
+
     void resetEarlyDelete();
     void initializeEarlyDelete(ModuleRegistry& modReg,
                                edm::ParameterSet const& opts,
@@ -363,6 +370,13 @@ namespace edm {
     // has been marked for early deletion
     std::vector<EarlyDeleteHelper> earlyDeleteHelpers_;
 
+    //Critical path aware scheduling. The indices used below are positions in allWorkers().
+    // For each worker, the workers which produce the data products it consumes
+    std::vector<std::vector<unsigned int>> criticalPathProducers_;
+    // For each Event ProductResolverIndex put by a module, the worker putting it
+    std::vector<std::pair<ProductResolverIndex, unsigned int>> criticalPathIndexToWorker_;
+    SystemTimeKeeper const* criticalPathTimeKeeper_ = nullptr;
+
     int total_events_;
     int total_passed_;
     unsigned int number_of_unscheduled_modules_;
@@ -190,6 +190,17 @@ void SystemTimeKeeper::restartModuleEvent(StreamContext const& iStream, ModuleCa
   }
 }
 
+double SystemTimeKeeper::averageModuleEventTime(StreamID const& iID, unsigned int iModuleID) const {
+  if (m_streamModuleTiming.empty() or not checkBounds(iModuleID)) {
+    return 0.;
+  }
+  auto const& mod = m_streamModuleTiming[iID.value()][iModuleID - m_minModuleID];
+  if (0 == mod.m_timesRun) {
+    return 0.;
+  }
+  return mod.m_timer.realTime() / mod.m_timesRun;
+}
+
 void SystemTimeKeeper::startProcessingLoop() { m_processingLoopTimer.start(); }
 
 void SystemTimeKeeper::stopProcessingLoop() { m_processingLoopTimer.stop(); }
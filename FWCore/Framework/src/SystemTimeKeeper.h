@@ -85,6 +85,10 @@ namespace edm {
 
     void fillTriggerTimingReport(TriggerTimingReport& rep) const;
 
+    ///Average real time per event spent in module iModuleID on stream iID.
+    /// Only call from the stream iID while none of its modules are running.
+    double averageModuleEventTime(StreamID const& iID, unsigned int iModuleID) const;
+
   private:
     SystemTimeKeeper(const SystemTimeKeeper&) = delete;  // stop default
 
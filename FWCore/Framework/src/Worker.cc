@@ -8,6 +8,9 @@
 #include "FWCore/Concurrency/interface/WaitingTask.h"
 #include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace edm {
   namespace {
     class ModuleBeginJobSignalSentry {
@@ -196,6 +199,27 @@ namespace edm {
     return true;
   }
 
+  void Worker::orderEventPrefetchBy(std::vector<double> const& iCostPerIndex) {
+    std::vector<ProductResolverIndexAndSkipBit> const& items = itemsToGetFrom(InEvent);
+    if (items.size() < 2) {
+      return;
+    }
+    auto cost = [&iCostPerIndex](ProductResolverIndexAndSkipBit const& iItem) {
+      auto index = iItem.productResolverIndex();
+      //products from the source or an earlier process are not on the critical path
+      if (iItem.skipCurrentProcess() or index >= iCostPerIndex.size()) {
+        return 0.;
+      }
+      return iCostPerIndex[index];
+    };
+    eventPrefetchOrder_.resize(items.size());
+    std::iota(eventPrefetchOrder_.begin(), eventPrefetchOrder_.end(), 0U);
+    std::stable_sort(
+        eventPrefetchOrder_.begin(), eventPrefetchOrder_.end(), [&items, &cost](unsigned int iLHS, unsigned int iRHS) {
+          return cost(items[iLHS]) < cost(items[iRHS]);
+        });
+  }
+
   void Worker::prefetchAsync(WaitingTask* iTask,
                              ServiceToken const& token,
                              ParentContext const& parentContext,
@@ -211,12 +235,21 @@ namespace edm {
 
     //Need to be sure the ref count isn't set to 0 immediately
     iTask->increment_ref_count();
-    for (auto const& item : items) {
+    auto prefetchItem = [&](ProductResolverIndexAndSkipBit const& item) {
       ProductResolverIndex productResolverIndex = item.productResolverIndex();
       bool skipCurrentProcess = item.skipCurrentProcess();
       if (productResolverIndex != ProductResolverIndexAmbiguous) {
         iPrincipal.prefetchAsync(iTask, productResolverIndex, skipCurrentProcess, token, &moduleCallingContext_);
       }
+    };
+    if (iPrincipal.branchType() == InEvent and eventPrefetchOrder_.size() == items.size()) {
+      for (auto index : eventPrefetchOrder_) {
+        prefetchItem(items[index]);
+      }
+    } else {
+      for (auto const& item : items) {
+        prefetchItem(item);
+      }
     }
 
     if (iPrincipal.branchType() == InEvent) {
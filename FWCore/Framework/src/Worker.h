@@ -24,6 +24,7 @@ the worker is reset().
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/MessageLogger/interface/ExceptionMessages.h"
 #include "FWCore/Framework/src/WorkerParams.h"
+#include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/interface/ExceptionActions.h"
 #include "FWCore/Framework/interface/ModuleContextSentry.h"
 #include "FWCore/Framework/interface/OccurrenceTraits.h"
@@ -45,6 +46,7 @@ the worker is reset().
 #include "FWCore/Concurrency/interface/FunctorTask.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
+#include "FWCore/Utilities/interface/ESIndices.h"
 #include "FWCore/Utilities/interface/BranchType.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
 #include "FWCore/Utilities/interface/StreamID.h"
@@ -195,6 +197,12 @@ namespace edm {
 
     void setEarlyDeleteHelper(EarlyDeleteHelper* iHelper);
 
+    ///Used by critical path aware scheduling. The Event data products are prefetched
+    /// in increasing order of iCostPerIndex[ProductResolverIndex] so that the product
+    /// whose producer is on the longest critical path is requested last and is
+    /// therefore the first to be run by this thread.
+    void orderEventPrefetchBy(std::vector<double> const& iCostPerIndex);
+
     //Used to make EDGetToken work
     virtual void updateLookup(BranchType iBranchType, ProductResolverIndexHelper const&) = 0;
     virtual void updateLookup(eventsetup::ESRecordsToProxyIndices const&) = 0;
@@ -212,6 +220,9 @@ namespace edm {
 
     virtual std::vector<ConsumesInfo> consumesInfo() const = 0;
 
+    virtual void esItemsConsumed(
+        std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const = 0;
+
     virtual Types moduleType() const = 0;
 
     void clearCounters() {
@@ -617,6 +628,10 @@ namespace edm {
 
     edm::propagate_const<EarlyDeleteHelper*> earlyDeleteHelper_;
 
+    //positions in itemsToGetFrom(InEvent) in the order they should be prefetched
+    // an empty vector means use the order in which the items were declared
+    std::vector<unsigned int> eventPrefetchOrder_;
+
     edm::WaitingTaskList waitingTasks_;
     std::atomic<bool> workStarted_;
     bool ranAcquireWithoutException_;
@@ -138,6 +138,11 @@ namespace edm {
 
     std::vector<ConsumesInfo> consumesInfo() const override { return module_->consumesInfo(); }
 
+    void esItemsConsumed(
+        std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const override {
+      module_->esItemsConsumed(oItems);
+    }
+
     void itemsToGet(BranchType branchType, std::vector<ProductResolverIndexAndSkipBit>& indexes) const override {
       module_->itemsToGet(branchType, indexes);
     }
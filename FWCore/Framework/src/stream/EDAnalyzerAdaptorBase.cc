@@ -129,6 +129,12 @@ std::vector<edm::ConsumesInfo> EDAnalyzerAdaptorBase::consumesInfo() const {
   return m_streamModules[0]->consumesInfo();
 }
 
+void EDAnalyzerAdaptorBase::esItemsConsumed(
+    std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const {
+  assert(not m_streamModules.empty());
+  m_streamModules[0]->esItemsConsumed(oItems);
+}
+
 bool EDAnalyzerAdaptorBase::doEvent(EventPrincipal const& ep,
                                     EventSetupImpl const& ci,
                                     ActivityRegistry* act,
@@ -124,6 +124,13 @@ namespace edm {
       return m_streamModules[0]->consumesInfo();
     }
 
+    template <typename T>
+    void ProducingModuleAdaptorBase<T>::esItemsConsumed(
+        std::vector<std::pair<eventsetup::EventSetupRecordKey, ESProxyIndex>>& oItems) const {
+      assert(not m_streamModules.empty());
+      m_streamModules[0]->esItemsConsumed(oItems);
+    }
+
     template <typename T>
     void ProducingModuleAdaptorBase<T>::updateLookup(BranchType iType,
                                                      ProductResolverIndexHelper const& iHelper,
@@ -176,6 +176,21 @@ void TestEDConsumerBase::testRegularType() {
     intConsumer.itemsMayGet(edm::InEvent, indicesMay);
     CPPUNIT_ASSERT(0 == indicesMay.size());
   }
+  {
+    std::vector<edm::InputTag> vTags = {{"labelC", "instanceC", ""}, {"label", "instance", "process"}};
+    IntsConsumer intConsumer{vTags};
+    intConsumer.updateLookup(edm::InEvent, helper, false);
+
+    CPPUNIT_ASSERT(vint_c_no_proc ==
+                   intConsumer.indexFrom(intConsumer.m_tokens[0], edm::InEvent, typeID_vint).productResolverIndex());
+    //only processC has the product so the get can go directly to it
+    CPPUNIT_ASSERT(
+        vint_c ==
+        intConsumer.directIndexFrom(intConsumer.m_tokens[0], edm::InEvent, typeID_vint).productResolverIndex());
+    CPPUNIT_ASSERT(
+        vint_blank ==
+        intConsumer.directIndexFrom(intConsumer.m_tokens[1], edm::InEvent, typeID_vint).productResolverIndex());
+  }
   {
     std::vector<edm::InputTag> vTags = {{"label", "instance", "process"}, {"labelC", "instanceC", "processC"}};
     IntsConsumesCollectorConsumer intConsumer{vTags};
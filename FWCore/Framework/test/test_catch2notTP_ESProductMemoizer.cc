@@ -0,0 +1,46 @@
+#include "catch.hpp"
+
+#include "FWCore/Framework/interface/ESProductMemoizer.h"
+
+#include <memory>
+#include <stdexcept>
+
+TEST_CASE("test ESProductMemoizer", "[ESProductMemoizer]") {
+  edm::ESProductMemoizer<int> memoizer;
+  unsigned int nMade = 0;
+  auto make = [&nMade]() { return std::make_shared<int>(++nMade); };
+
+  SECTION("same hashes reuse the product") {
+    auto first = memoizer.makeOrReuse({"a", "b"}, make);
+    auto second = memoizer.makeOrReuse({"a", "b"}, make);
+    REQUIRE(first == second);
+    REQUIRE(nMade == 1);
+    REQUIRE(memoizer.numberReused() == 1);
+  }
+
+  SECTION("changed hash remakes the product") {
+    auto first = memoizer.makeOrReuse({"a", "b"}, make);
+    auto second = memoizer.makeOrReuse({"a", "c"}, make);
+    REQUIRE(first != second);
+    REQUIRE(*second == 2);
+    auto third = memoizer.makeOrReuse({"a", "c"}, make);
+    REQUIRE(second == third);
+  }
+
+  SECTION("unknown hash always remakes the product") {
+    memoizer.makeOrReuse({"a", ""}, make);
+    memoizer.makeOrReuse({"a", ""}, make);
+    memoizer.makeOrReuse({}, make);
+    memoizer.makeOrReuse({}, make);
+    REQUIRE(nMade == 4);
+    REQUIRE(memoizer.numberReused() == 0);
+  }
+
+  SECTION("exception from make does not keep the old product") {
+    memoizer.makeOrReuse({"a"}, make);
+    REQUIRE_THROWS_AS(memoizer.makeOrReuse({"b"}, []() -> std::shared_ptr<int> { throw std::runtime_error("fail"); }),
+                      std::runtime_error);
+    memoizer.makeOrReuse({"a"}, make);
+    REQUIRE(nMade == 2);
+  }
+}
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/Framework/interface/EventArenas.h"
+
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+TEST_CASE("test EventArenas", "[EventArenas]") {
+  edm::ModuleDescription first("FirstProducer", "first");
+  edm::ModuleDescription second("SecondProducer", "second");
+
+  edm::EventArenas arenas(256);
+
+  SECTION("same resource for each module") {
+    auto firstResource = arenas.resource(first);
+    REQUIRE(firstResource == arenas.resource(first));
+    REQUIRE(firstResource != arenas.resource(second));
+  }
+
+  SECTION("peak usage is tracked per module over Events") {
+    {
+      std::pmr::vector<char> v(arenas.resource(first));
+      v.resize(1000);
+    }
+    arenas.reset();
+    {
+      std::pmr::vector<char> v(arenas.resource(first));
+      v.resize(100);
+      std::pmr::vector<char> w(arenas.resource(second));
+      w.resize(10);
+    }
+    arenas.reset();
+
+    std::map<std::string, std::size_t> peaks;
+    arenas.fillPeakUsage(peaks);
+    REQUIRE(peaks.size() == 2);
+    REQUIRE(peaks["first"] >= 1000);
+    REQUIRE(peaks["second"] >= 10);
+    REQUIRE(peaks["second"] < 1000);
+  }
+
+  SECTION("memory is usable after reset") {
+    for (unsigned int event = 0; event < 3; ++event) {
+      std::pmr::vector<int> v(arenas.resource(first));
+      for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+      }
+      REQUIRE(v[999] == 999);
+      v.clear();
+      v.shrink_to_fit();
+      arenas.reset();
+    }
+  }
+}
@@ -0,0 +1,43 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+import FWCore.Framework.test.cmsExceptionsFatalOption_cff
+process.options = cms.untracked.PSet(
+    Rethrow = FWCore.Framework.test.cmsExceptionsFatalOption_cff.Rethrow,
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(2),
+    criticalPathScheduling = cms.untracked.bool(True)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(250)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.one = cms.EDProducer("IntProducer",
+    ivalue = cms.int32(1)
+)
+
+process.slow = cms.EDProducer("BusyWaitIntProducer",
+    ivalue = cms.int32(2),
+    iterations = cms.uint32(10*1000)
+)
+
+process.slowChain = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('slow')
+)
+
+process.result = cms.EDProducer("AddIntsProducer",
+    labels = cms.vstring('one', 'slowChain')
+)
+
+process.get = cms.EDAnalyzer("IntTestAnalyzer",
+    valueMustMatch = cms.untracked.int32(3),
+    moduleLabel = cms.untracked.string('result')
+)
+
+process.t = cms.Task(process.one, process.slow, process.slowChain, process.result)
+
+process.p = cms.Path(process.get, process.t)
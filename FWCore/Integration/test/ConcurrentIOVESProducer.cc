@@ -37,15 +37,20 @@ namespace edmtest {
 
   private:
     edm::ESGetToken<IOVTestInfo, ESTestRecordI> token_;
+    bool throwInProduce_;
   };
 
-  ConcurrentIOVESProducer::ConcurrentIOVESProducer(edm::ParameterSet const&) {
+  ConcurrentIOVESProducer::ConcurrentIOVESProducer(edm::ParameterSet const& pset)
+      : throwInProduce_(pset.getUntrackedParameter<bool>("throwInProduce")) {
     //auto collector = setWhatProduced(this);
     auto collector = setWhatProduced(this, "fromESProducer");
     token_ = collector.consumes<IOVTestInfo>(edm::ESInputTag{"", ""});
   }
 
   std::unique_ptr<IOVTestInfo> ConcurrentIOVESProducer::produce(ESTestRecordI const& record) {
+    if (throwInProduce_) {
+      throw cms::Exception("TestFailure") << "ConcurrentIOVESProducer::produce, intentional exception";
+    }
     edm::ESHandle<IOVTestInfo> iovTestInfo = record.getHandle(token_);
 
     edm::ValidityInterval iov = record.validityInterval();
@@ -63,6 +68,7 @@ namespace edmtest {
 
   void ConcurrentIOVESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
     edm::ParameterSetDescription desc;
+    desc.addUntracked<bool>("throwInProduce", false)->setComment("If true, produce throws an exception.");
     descriptions.add("concurrentIOVESProducer", desc);
   }
 }  // namespace edmtest
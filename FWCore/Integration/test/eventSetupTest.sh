@@ -15,6 +15,11 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/ESProductHostTest_cfg.py || die 'Failed
 echo testConcurrentIOVs
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVs_cfg.py || die 'Failed in testConcurrentIOVs_cfg.py' $?
 
+echo testConcurrentIOVsPrefetch
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVsPrefetch_cfg.py || die 'Failed in testConcurrentIOVsPrefetch_cfg.py' $?
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVsPrefetch_cfg.py throwInProduce &> testConcurrentIOVsPrefetchThrow.log && die 'Failed to get exception running testConcurrentIOVsPrefetch_cfg.py throwInProduce' 1
+grep -q "intentional exception" testConcurrentIOVsPrefetchThrow.log || die 'Failed to find the exception of the prefetch in testConcurrentIOVsPrefetchThrow.log' 1
+
 echo testConcurrentIOVsLegacy
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVsLegacy_cfg.py || die 'Failed in testConcurrentIOVsLegacy_cfg.py' $?
 
@@ -0,0 +1,73 @@
+# Same as testConcurrentIOVs_cfg.py except the EventSetup data
+# consumed by the modules for a new IOV is requested as soon as
+# the IOV is initialized. The values checked by ConcurrentIOVAnalyzer
+# must not change. The data no module consumes must not be produced.
+# With the argument "throwInProduce" the consumed ESProducer throws
+# and the exception from the prefetch must stop the job.
+
+import FWCore.ParameterSet.Config as cms
+
+import sys
+throwInProduce = (sys.argv[-1] == "throwInProduce")
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(1),
+    firstLuminosityBlock = cms.untracked.uint32(1),
+    firstEvent = cms.untracked.uint32(1),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(1),
+    numberEventsInRun = cms.untracked.uint32(100)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(8)
+)
+
+process.options = dict(
+    numberOfThreads = 4,
+    numberOfStreams = 4,
+    numberOfConcurrentRuns = 1,
+    numberOfConcurrentLuminosityBlocks = 4,
+    eventSetup = dict(
+        numberOfConcurrentIOVs = 2,
+        prefetchNewIOVs = True
+    )
+)
+
+process.emptyESSourceI = cms.ESSource("EmptyESSource",
+    recordName = cms.string("ESTestRecordI"),
+    firstValid = cms.vuint32(1,100),
+    iovIsRunNotTime = cms.bool(True)
+)
+
+process.emptyESSourceK = cms.ESSource("EmptyESSource",
+    recordName = cms.string("ESTestRecordK"),
+    firstValid = cms.vuint32(1,100),
+    iovIsRunNotTime = cms.bool(True)
+)
+
+process.concurrentIOVESSource = cms.ESSource("ConcurrentIOVESSource",
+    iovIsRunNotTime = cms.bool(True),
+    firstValidLumis = cms.vuint32(1, 4, 6, 7, 8, 9),
+    invalidLumis = cms.vuint32(),
+    concurrentFinder = cms.bool(True)
+)
+
+process.concurrentIOVESProducer = cms.ESProducer("ConcurrentIOVESProducer",
+    throwInProduce = cms.untracked.bool(throwInProduce)
+)
+
+# No module consumes this data, the job fails if it is prefetched
+process.unconsumedIOVESProducer = cms.ESProducer("ConcurrentIOVESProducer",
+    throwInProduce = cms.untracked.bool(True),
+    appendToDataLabel = cms.string("Unconsumed")
+)
+
+process.test = cms.EDAnalyzer("ConcurrentIOVAnalyzer",
+                              checkExpectedValues = cms.untracked.bool(True)
+)
+
+process.busy1 = cms.EDProducer("BusyWaitIntProducer",ivalue = cms.int32(1), iterations = cms.uint32(10*1000*1000))
+
+process.p1 = cms.Path(process.busy1 * process.test)
@@ -82,8 +82,12 @@ CMS_THREAD_SAFE static std::vector<
     tbb::concurrent_unordered_map<ErrorSummaryMapKey, AtomicUnsignedInt, ErrorSummaryMapKey::key_hash>>
     errorSummaryMaps;
 
-MessageSender::MessageSender(ELseverityLevel const& sev, ELstring const& id, bool verbatim, bool suppressed)
-    : errorobj_p(suppressed ? nullptr : new ErrorObj(sev, id, verbatim), ErrorObjDeleter()) {
+MessageSender::MessageSender(ELseverityLevel const& sev, ELstring const& id, bool verbatim, bool suppressed) {
+  // a shared_ptr with a deleter allocates its control block even for a null pointer:
+  // a suppressed message must not allocate anything
+  if (not suppressed) {
+    errorobj_p = std::shared_ptr<ErrorObj>(new ErrorObj(sev, id, verbatim), ErrorObjDeleter());
+  }
   //std::cout << "MessageSender ctor; new ErrorObj at: " << errorobj_p << '\n';
 }
 
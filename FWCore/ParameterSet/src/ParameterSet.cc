@@ -79,7 +79,7 @@ namespace edm {
   void ParameterSet::registerFromString(std::string const& rep) {
     // from coded string.  Will cause registration
     cms::Digest dg(rep);
-    edm::ParameterSetID psID(dg.digest().toString());
+    edm::ParameterSetID psID(dg.digest().compactForm());
     edm::ParameterSet ps(rep, psID);
     pset::Registry::instance()->insertMapped(ps);
   }
@@ -87,7 +87,7 @@ namespace edm {
   ParameterSetID ParameterSet::emptyParameterSetID() {  // const
     cms::Digest newDigest;
     ParameterSet().toDigest(newDigest);
-    return ParameterSetID(newDigest.digest().toString());
+    return ParameterSetID(newDigest.digest().compactForm());
   }
 
   void ParameterSet::copyForModify(ParameterSet const& other) {
@@ -172,7 +172,8 @@ namespace edm {
     //    id_ = ParameterSetID(md5alg.digest().toString());
     cms::Digest newDigest;
     toDigest(newDigest);
-    id_ = ParameterSetID(newDigest.digest().toString());
+    // the compact form, which the ID would otherwise be converted to from the hexified one
+    id_ = ParameterSetID(newDigest.digest().compactForm());
     //    assert(md5alg.digest().toString() == newDigest.digest().toString());
     assert(isRegistered());
   }
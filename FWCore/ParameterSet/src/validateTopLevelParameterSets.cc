@@ -30,6 +30,11 @@ namespace edm {
         "Parameter names should be record names and the values are the number of concurrent IOVS for each record."
         " Overrides all other methods of setting number of concurrent IOVs.");
     eventSetupDescription.addUntracked<edm::ParameterSetDescription>("forceNumberOfConcurrentIOVs", nestedDescription);
+    eventSetupDescription.addUntracked<bool>("prefetchNewIOVs", false)
+        ->setComment(
+            "If true, the EventSetup data the modules consume is requested as soon as the IOVs for a new "
+            "LuminosityBlock are ready. With more than one concurrent IOV this lets the data be built "
+            "while the previous LuminosityBlock is still being processed.");
     description.addUntracked<edm::ParameterSetDescription>("eventSetup", eventSetupDescription);
 
     description.addUntracked<bool>("wantSummary", false)
@@ -40,6 +45,10 @@ namespace edm {
     description.addUntracked<bool>("throwIfIllegalParameter", true)
         ->setComment("Set false to disable exception throws when configuration validation detects illegal parameters");
     description.addUntracked<bool>("printDependencies", false)->setComment("Print data dependencies between modules");
+    description.addUntracked<bool>("criticalPathScheduling", false)
+        ->setComment(
+            "Set true to prefetch the data products whose producers are on the longest chain of dependent modules "
+            "first, based on the measured time per module");
 
     // No default for this one because the parameter value is
     // actually used in the main function in cmsRun.cpp before
@@ -55,6 +64,14 @@ namespace edm {
 
     description.addUntracked<std::vector<std::string>>("canDeleteEarly", emptyVector)
         ->setComment("Branch names of products that the Framework can try to delete before the end of the Event");
+    description.addUntracked<bool>("autoDeleteEarly", false)
+        ->setComment(
+            "If True, the Framework tries to delete before the end of the Event every Event product not stored by an "
+            "OutputModule, using the consumes calls of the modules to know which modules read the product.");
+    description.addUntracked<std::vector<std::string>>("cannotDeleteEarly", emptyVector)
+        ->setComment(
+            "Branch names of products which must not be deleted early when 'autoDeleteEarly' is True, e.g. products "
+            "which are only reached through edm::Ref or edm::Ptr.");
 
     description.addOptionalUntracked<bool>("allowUnscheduled")
         ->setComment(
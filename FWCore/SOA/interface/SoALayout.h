@@ -0,0 +1,184 @@
+#ifndef FWCore_SOA_SoALayout_h
+#define FWCore_SOA_SoALayout_h
+// -*- C++ -*-
+//
+// Package:     FWCore/SOA
+// Class  :     SoALayout
+//
+/**\class SoALayout SoALayout.h "SoALayout.h"
+
+ Description: Layout of the columns of a Table in one contiguous buffer
+
+ Usage:
+    A SoALayout places the columns of a Table one after the other in a single
+ buffer, each column starting at an offset aligned to kAlignment bytes. The
+ layout only depends on the column types and the number of rows, so a buffer
+ filled on the host can be moved to a GPU with a single copy and be read there
+ through the same SoAView.
+ \code
+ using SphereTable = edm::soa::Table<Eta,Phi>;
+ using SphereLayout = edm::soa::SoALayout_t<SphereTable>;
+
+ std::vector<std::byte> buffer(SphereLayout::bytes(nRows));
+ auto view = SphereLayout::view(buffer.data(), nRows);
+ view.get<Eta>(0) = 1.;
+ \endcode
+
+ An edm::soa::SoAView<> is a trivially copyable set of column pointers and can
+ be passed by value to a CUDA kernel. Its member functions are usable in device
+ code when the header is compiled by nvcc. A view can also be made on the columns
+ of an existing Table.
+ \code
+ SphereTable sphereTable{...};
+ auto view = SphereLayout::view(sphereTable);
+ \endcode
+
+ Only columns of trivially copyable types can be part of a SoALayout.
+ */
+//
+
+// system include files
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// user include files
+#include "FWCore/SOA/interface/Table.h"
+#include "FWCore/SOA/interface/tablehelpers.h"
+
+#if defined(__CUDACC__)
+#define EDM_SOA_HOST_DEVICE __host__ __device__
+#else
+#define EDM_SOA_HOST_DEVICE
+#endif
+
+// forward declarations
+
+namespace edm {
+  namespace soa {
+
+    template <typename... Args>
+    class SoAView {
+    public:
+      static constexpr const unsigned int kNColumns = sizeof...(Args);
+      using Layout = std::tuple<Args...>;
+
+      SoAView() = default;
+      EDM_SOA_HOST_DEVICE SoAView(void* const* iColumns, unsigned int iSize) : m_size(iSize) {
+        for (unsigned int i = 0; i < kNColumns; ++i) {
+          m_values[i] = iColumns[i];
+        }
+      }
+
+      EDM_SOA_HOST_DEVICE unsigned int size() const { return m_size; }
+
+      template <typename U>
+      EDM_SOA_HOST_DEVICE typename U::type const& get(unsigned int iRow) const {
+        return column<U>()[iRow];
+      }
+      template <typename U>
+      EDM_SOA_HOST_DEVICE typename U::type& get(unsigned int iRow) {
+        return column<U>()[iRow];
+      }
+
+      template <typename U>
+      EDM_SOA_HOST_DEVICE typename U::type const* column() const {
+        return static_cast<typename U::type const*>(m_values[impl::GetIndex<0, U, Layout>::index]);
+      }
+      template <typename U>
+      EDM_SOA_HOST_DEVICE typename U::type* column() {
+        return static_cast<typename U::type*>(m_values[impl::GetIndex<0, U, Layout>::index]);
+      }
+
+    private:
+      void* m_values[kNColumns] = {nullptr};
+      unsigned int m_size = 0;
+    };
+
+    template <typename... Args>
+    class SoALayout {
+    public:
+      static constexpr const unsigned int kNColumns = sizeof...(Args);
+      static constexpr const size_t kAlignment = 128;
+      using Layout = std::tuple<Args...>;
+      using View = SoAView<Args...>;
+      using Table = edm::soa::Table<Args...>;
+
+      static_assert((std::is_trivially_copyable<typename Args::type>::value && ...),
+                    "Only columns of trivially copyable types can be laid out in a single buffer");
+      static_assert(((alignof(typename Args::type) <= kAlignment) && ...),
+                    "The alignment of a column type is larger than the alignment of the columns");
+
+      ///offset in bytes of column I from the start of a buffer holding iNRows rows
+      template <unsigned int I>
+      static constexpr size_t offset(size_t iNRows) {
+        if constexpr (I == 0) {
+          return 0;
+        } else {
+          using Type = typename std::tuple_element<I - 1, Layout>::type::type;
+          return offset<I - 1>(iNRows) + aligned(iNRows * sizeof(Type));
+        }
+      }
+
+      ///size in bytes of a buffer holding iNRows rows
+      static constexpr size_t bytes(size_t iNRows) { return offset<kNColumns>(iNRows); }
+
+      ///view of the columns laid out in iBuffer, which must be aligned to kAlignment
+      static View view(void* iBuffer, unsigned int iNRows) {
+        void* columns[kNColumns];
+        fillAddresses(static_cast<char*>(iBuffer), iNRows, columns, std::make_index_sequence<kNColumns>{});
+        return View(columns, iNRows);
+      }
+
+      ///view of the columns of a Table, which are not contiguous
+      static View view(Table& iTable) {
+        void* columns[kNColumns];
+        for (unsigned int i = 0; i < kNColumns; ++i) {
+          columns[i] = const_cast<void*>(iTable.columnAddressByIndex(i));
+        }
+        return View(columns, iTable.size());
+      }
+
+      ///copies the rows of the Table into the view, which must have the same size
+      static void copy(Table const& iTable, View& oView) {
+        copyColumns(iTable, oView, std::make_index_sequence<kNColumns>{});
+      }
+
+    private:
+      static constexpr size_t aligned(size_t iBytes) { return (iBytes + kAlignment - 1) / kAlignment * kAlignment; }
+
+      template <size_t... I>
+      static void fillAddresses(char* iBuffer, size_t iNRows, void** oColumns, std::index_sequence<I...>) {
+        ((oColumns[I] = iBuffer + offset<I>(iNRows)), ...);
+      }
+
+      template <size_t... I>
+      static void copyColumns(Table const& iTable, View& oView, std::index_sequence<I...>) {
+        (copyColumn<typename std::tuple_element<I, Layout>::type>(iTable, oView), ...);
+      }
+
+      template <typename U>
+      static void copyColumn(Table const& iTable, View& oView) {
+        using Type = typename U::type;
+        auto values = static_cast<Type const*>(iTable.columnAddressWorkaround(static_cast<U const*>(nullptr)));
+        std::copy(values, values + iTable.size(), oView.template column<U>());
+      }
+    };
+
+    template <typename T>
+    struct SoALayoutOf;
+
+    template <typename... Args>
+    struct SoALayoutOf<Table<Args...>> {
+      using type = SoALayout<Args...>;
+    };
+
+    ///the SoALayout with the same columns as the Table T
+    template <typename T>
+    using SoALayout_t = typename SoALayoutOf<T>::type;
+  }  // namespace soa
+}  // namespace edm
+
+#endif
@@ -114,6 +114,7 @@
 //
 
 // system include files
+#include <cassert>
 #include <memory>
 #include <tuple>
 #include <array>
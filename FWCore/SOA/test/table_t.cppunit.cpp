@@ -17,6 +17,7 @@ Changed by Viji on 29-06-2005
 #include "FWCore/SOA/interface/Column.h"
 #include "FWCore/SOA/interface/TableItr.h"
 #include "FWCore/SOA/interface/TableExaminer.h"
+#include "FWCore/SOA/interface/SoALayout.h"
 
 class testTable : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testTable);
@@ -30,6 +31,7 @@ class testTable : public CppUnit::TestFixture {
   CPPUNIT_TEST(tableExaminerTest);
   CPPUNIT_TEST(tableResizeTest);
   CPPUNIT_TEST(mutabilityTest);
+  CPPUNIT_TEST(soaLayoutTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -45,6 +47,7 @@ public:
   void tableExaminerTest();
   void tableResizeTest();
   void mutabilityTest();
+  void soaLayoutTest();
 };
 
 namespace ts {
@@ -420,4 +423,43 @@ void testTable::mutabilityTest() {
   CPPUNIT_ASSERT(row.get<Phi>() == 10.);
 }
 
+void testTable::soaLayoutTest() {
+  using namespace edm::soa;
+  using namespace ts;
+
+  using Layout = SoALayout_t<ParticleTable>;
+  static_assert(std::is_same<Layout, SoALayout<Px, Py, Pz, Energy>>::value, "SoALayout_t gives the wrong layout");
+  static_assert(std::is_trivially_copyable<Layout::View>::value, "SoAView must be trivially copyable");
+
+  //each column starts aligned
+  static_assert(Layout::offset<0>(3) == 0, "wrong offset");
+  static_assert(Layout::offset<1>(3) == Layout::kAlignment, "wrong offset");
+  static_assert(Layout::offset<3>(20) == 3 * 2 * Layout::kAlignment, "wrong offset");
+  static_assert(Layout::bytes(20) == 3 * 2 * Layout::kAlignment + Layout::kAlignment, "wrong size");
+  static_assert(Layout::bytes(0) == 0, "wrong size");
+
+  std::array<double, 3> px = {{1., 4., 7.}};
+  std::array<double, 3> py = {{2., 5., 8.}};
+  std::array<double, 3> pz = {{3., 6., 9.}};
+  std::array<float, 3> energy = {{10., 11., 12.}};
+  ParticleTable particles{px, py, pz, energy};
+
+  alignas(Layout::kAlignment) std::array<char, Layout::bytes(3)> buffer;
+  auto view = Layout::view(buffer.data(), particles.size());
+  CPPUNIT_ASSERT(view.size() == 3);
+  Layout::copy(particles, view);
+  for (unsigned int i = 0; i < 3; ++i) {
+    CPPUNIT_ASSERT(view.get<Px>(i) == px[i]);
+    CPPUNIT_ASSERT(view.get<Py>(i) == py[i]);
+    CPPUNIT_ASSERT(view.get<Pz>(i) == pz[i]);
+    CPPUNIT_ASSERT(view.get<Energy>(i) == energy[i]);
+  }
+  CPPUNIT_ASSERT(reinterpret_cast<char*>(view.column<Energy>()) == buffer.data() + Layout::offset<3>(3));
+
+  //a view on the Table itself
+  auto tableView = Layout::view(particles);
+  tableView.get<Pz>(1) = 0.;
+  CPPUNIT_ASSERT(particles.get<Pz>(1) == 0.);
+}
+
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
@@ -1,7 +1,9 @@
 #include "FWCore/Services/src/SiteLocalConfigService.h"
 #include "FWCore/Services/src/JobReportService.h"
+#include "FWCore/Framework/interface/EventArenaService.h"
 #include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
 
+using edm::service::EventArenaService;
 using edm::service::JobReportService;
 using edm::service::SiteLocalConfigService;
 
@@ -9,3 +11,4 @@ typedef edm::serviceregistry::ParameterSetMaker<edm::SiteLocalConfig, SiteLocalC
 DEFINE_FWK_SERVICE_MAKER(SiteLocalConfigService, SiteLocalConfigMaker);
 typedef edm::serviceregistry::AllArgsMaker<edm::JobReport, JobReportService> JobReportMaker;
 DEFINE_FWK_SERVICE_MAKER(JobReportService, JobReportMaker);
+DEFINE_FWK_SERVICE(EventArenaService);
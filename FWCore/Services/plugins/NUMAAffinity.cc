@@ -0,0 +1,217 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Services
+// Class  :     NUMAAffinity
+//
+// Implementation:
+//     Each thread entering the TBB scheduler is bound to the CPUs of one NUMA node.
+//     Nodes are handed out round-robin so the threads are spread evenly over the
+//     sockets. Since the default Linux memory policy is first-touch, memory a thread
+//     allocates for the data it is processing then stays on the node of that thread.
+//
+
+// system include files
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#endif
+
+#include "tbb/task_scheduler_observer.h"
+
+// user include files
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+namespace edm {
+  namespace service {
+    class NUMAAffinity {
+    public:
+      NUMAAffinity(ParameterSet const&, ActivityRegistry&);
+      ~NUMAAffinity();
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      class ThreadPinner : public tbb::task_scheduler_observer {
+      public:
+        explicit ThreadPinner(NUMAAffinity const* iService) : service_(iService) { observe(true); }
+        ~ThreadPinner() override { observe(false); }
+
+        void on_scheduler_entry(bool) override { service_->pinThisThread(); }
+
+      private:
+        NUMAAffinity const* service_;
+      };
+
+      void pinThisThread() const;
+      void postEndJob();
+
+      //CPUs of each node used
+      std::vector<std::vector<unsigned int>> nodeCPUs_;
+      std::vector<unsigned int> nodeIDs_;
+      mutable std::atomic<unsigned int> nextNode_{0};
+      mutable std::vector<std::atomic<unsigned int>> threadsOnNode_;
+      bool const verbose_;
+      std::unique_ptr<ThreadPinner> pinner_;
+    };
+
+    inline bool isProcessWideService(NUMAAffinity const*) { return true; }
+  }  // namespace service
+}  // namespace edm
+
+namespace edm {
+  namespace service {
+    namespace {
+      //parses the kernel cpulist format, e.g. "0-15,32-47"
+      std::vector<unsigned int> parseCPUList(std::string const& iList) {
+        std::vector<unsigned int> cpus;
+        std::istringstream s(iList);
+        std::string range;
+        while (std::getline(s, range, ',')) {
+          if (range.empty() or range == "\n") {
+            continue;
+          }
+          auto dash = range.find('-');
+          unsigned int first = std::stoul(range.substr(0, dash));
+          unsigned int last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+          for (unsigned int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+          }
+        }
+        return cpus;
+      }
+
+#ifdef __linux__
+      std::vector<unsigned int> availableNodes() {
+        std::vector<unsigned int> nodes;
+        DIR* dir = opendir("/sys/devices/system/node");
+        if (dir == nullptr) {
+          return nodes;
+        }
+        while (auto entry = readdir(dir)) {
+          std::string name = entry->d_name;
+          if (name.size() > 4 and name.compare(0, 4, "node") == 0 and
+              name.find_first_not_of("0123456789", 4) == std::string::npos) {
+            nodes.push_back(std::stoul(name.substr(4)));
+          }
+        }
+        closedir(dir);
+        std::sort(nodes.begin(), nodes.end());
+        return nodes;
+      }
+
+      std::vector<unsigned int> cpusOfNode(unsigned int iNode) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(iNode) + "/cpulist");
+        std::string list;
+        std::getline(file, list);
+        return parseCPUList(list);
+      }
+#endif
+    }  // namespace
+
+    NUMAAffinity::NUMAAffinity(ParameterSet const& iPS, ActivityRegistry& iRegistry)
+        : verbose_(iPS.getUntrackedParameter<bool>("verbose")) {
+#ifdef __linux__
+      auto requestedNodes = iPS.getUntrackedParameter<std::vector<unsigned int>>("nodes");
+      auto const presentNodes = availableNodes();
+      if (requestedNodes.empty()) {
+        requestedNodes = presentNodes;
+      }
+
+      //only keep the CPUs this process is allowed to run on, e.g. if started with taskset
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      bool const haveMask = 0 == sched_getaffinity(0, sizeof(allowed), &allowed);
+
+      for (auto node : requestedNodes) {
+        if (std::find(presentNodes.begin(), presentNodes.end(), node) == presentNodes.end()) {
+          throw Exception(errors::Configuration) << "NUMAAffinity: requested NUMA node " << node << " does not exist";
+        }
+        std::vector<unsigned int> cpus;
+        for (auto cpu : cpusOfNode(node)) {
+          if (not haveMask or (cpu < CPU_SETSIZE and CPU_ISSET(cpu, &allowed))) {
+            cpus.push_back(cpu);
+          }
+        }
+        if (not cpus.empty()) {
+          nodeIDs_.push_back(node);
+          nodeCPUs_.push_back(std::move(cpus));
+        }
+      }
+#endif
+      threadsOnNode_ = std::vector<std::atomic<unsigned int>>(nodeCPUs_.size());
+      for (auto& count : threadsOnNode_) {
+        count = 0;
+      }
+
+      //with a single node there is nothing to gain
+      if (nodeCPUs_.size() > 1) {
+        pinner_ = std::make_unique<ThreadPinner>(this);
+      } else {
+        LogInfo("NUMAAffinity") << "Found " << nodeCPUs_.size() << " usable NUMA node, threads will not be pinned";
+      }
+
+      iRegistry.watchPostEndJob(this, &NUMAAffinity::postEndJob);
+    }
+
+    NUMAAffinity::~NUMAAffinity() = default;
+
+    void NUMAAffinity::fillDescriptions(ConfigurationDescriptions& descriptions) {
+      ParameterSetDescription desc;
+      desc.addUntracked<std::vector<unsigned int>>("nodes", std::vector<unsigned int>())
+          ->setComment("NUMA nodes the threads can be pinned to. If empty all nodes of the machine are used.");
+      desc.addUntracked<bool>("verbose", false)->setComment("Print the number of threads pinned to each node.");
+      descriptions.add("NUMAAffinity", desc);
+      descriptions.setComment(
+          "Binds each thread entering the TBB scheduler to the CPUs of one NUMA node, spreading the threads "
+          "evenly over the nodes. Memory first touched by a thread is then local to the node the thread runs on.");
+    }
+
+    void NUMAAffinity::pinThisThread() const {
+      //a thread can enter the scheduler several times, only pin it once
+      static thread_local bool s_pinned = false;
+      if (s_pinned) {
+        return;
+      }
+      s_pinned = true;
+#ifdef __linux__
+      unsigned int index = nextNode_++ % nodeCPUs_.size();
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (auto cpu : nodeCPUs_[index]) {
+        CPU_SET(cpu, &set);
+      }
+      if (0 == sched_setaffinity(0, sizeof(set), &set)) {
+        ++threadsOnNode_[index];
+      }
+#endif
+    }
+
+    void NUMAAffinity::postEndJob() {
+      pinner_.reset();
+      if (verbose_) {
+        LogSystem s("NUMAAffinity");
+        s << "Threads pinned per NUMA node:";
+        for (unsigned int i = 0; i < nodeIDs_.size(); ++i) {
+          s << "\n  node " << nodeIDs_[i] << " (" << nodeCPUs_[i].size() << " CPUs): " << threadsOnNode_[i].load();
+        }
+      }
+    }
+  }  // namespace service
+}  // namespace edm
+
+using edm::service::NUMAAffinity;
+DEFINE_FWK_SERVICE(NUMAAffinity);
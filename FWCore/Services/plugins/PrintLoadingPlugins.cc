@@ -18,16 +18,19 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PluginManager/interface/PluginInfo.h"
+#include "FWCore/PluginManager/interface/SharedLibrary.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 
 #include "FWCore/Utilities/interface/Signal.h"
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <string>
 #include <map>
+#include <vector>
 
 class PrintLoadingPlugins {
 public:
@@ -36,6 +39,8 @@ public:
 
   void goingToLoad(const boost::filesystem::path&);
 
+  void justLoaded(const edmplugin::SharedLibrary&);
+
   void askedToLoad(const std::string&, const std::string&);
 
   // ---------- const member functions ---------------------
@@ -51,6 +56,11 @@ private:
   const PrintLoadingPlugins& operator=(const PrintLoadingPlugins&) = delete;  // stop default
 
   // ---------- member data --------------------------------
+  // the start of the loads in progress: loading a library can load others, the PluginManager loading the
+  // libraries one at a time, under its recursive mutex
+  std::vector<std::chrono::steady_clock::time_point> loadStarts_;
+  unsigned int nLoaded_;
+  std::chrono::duration<double> totalLoadTime_;
 };
 
 //
@@ -66,7 +76,7 @@ private:
 //
 using namespace edmplugin;
 
-PrintLoadingPlugins::PrintLoadingPlugins() {
+PrintLoadingPlugins::PrintLoadingPlugins() : nLoaded_(0), totalLoadTime_(0.) {
   using std::placeholders::_1;
   using std::placeholders::_2;
   PluginManager* pm = PluginManager::get();
@@ -74,6 +84,8 @@ PrintLoadingPlugins::PrintLoadingPlugins() {
   pm->askedToLoadCategoryWithPlugin_.connect(std::bind(std::mem_fn(&PrintLoadingPlugins::askedToLoad), this, _1, _2));
 
   pm->goingToLoad_.connect(std::bind(std::mem_fn(&PrintLoadingPlugins::goingToLoad), this, _1));
+
+  pm->justLoaded_.connect(std::bind(std::mem_fn(&PrintLoadingPlugins::justLoaded), this, _1));
 }
 
 // PrintLoadingPlugins::PrintLoadingPlugins(const PrintLoadingPlugins& rhs)
@@ -81,12 +93,17 @@ PrintLoadingPlugins::PrintLoadingPlugins() {
 //    // do actual copying here;
 // }
 
-PrintLoadingPlugins::~PrintLoadingPlugins() {}
+PrintLoadingPlugins::~PrintLoadingPlugins() {
+  edm::LogAbsolute("LoadLib") << "Loaded> " << nLoaded_ << " libraries in " << totalLoadTime_.count() << " s"
+                              << std::endl;
+}
 
 void PrintLoadingPlugins::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   descriptions.add("PrintLoadingPlugins", desc);
-  descriptions.setComment("This service logs each request to load a plugin.");
+  descriptions.setComment(
+      "This service logs each request to load a plugin, and the time taken to load each library, the libraries "
+      "it loads included.");
 }
 
 //
@@ -144,6 +161,21 @@ void PrintLoadingPlugins::goingToLoad(const boost::filesystem::path& Loadable_)
 
 {
   edm::LogAbsolute("LoadLib") << "Loading> " << Loadable_.string() << std::endl;
+  loadStarts_.push_back(std::chrono::steady_clock::now());
+}
+
+void PrintLoadingPlugins::justLoaded(const edmplugin::SharedLibrary& iLibrary) {
+  if (loadStarts_.empty()) {
+    return;
+  }
+  std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - loadStarts_.back();
+  loadStarts_.pop_back();
+  ++nLoaded_;
+  if (loadStarts_.empty()) {
+    totalLoadTime_ += loadTime;
+  }
+  edm::LogAbsolute("LoadLib") << "Loaded> " << iLibrary.path().string() << " in " << loadTime.count() << " s"
+                              << std::endl;
 }
 
 //
@@ -0,0 +1,323 @@
+// -*- C++ -*-
+//
+// Package: FWCore/Services
+// Class  : SamplingProfiler
+//
+// Implementation:
+//     A process wide ITIMER_PROF timer delivers SIGPROF to whichever thread is
+//     using the CPU. The signal handler records the call stack of the thread and
+//     the module currently running on it into a fixed array of slots, without
+//     taking any lock or allocating memory. A helper thread periodically moves
+//     the filled slots into a map of unique stacks so the memory needed does not
+//     grow with the length of the job. At the end of the job the addresses are
+//     symbolized and written in the 'folded' format read by flamegraph.pl, with
+//     the module label as the outermost frame.
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/CurrentModuleOnThread.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+
+#include "tbb/task_scheduler_observer.h"
+
+namespace edm {
+  namespace service {
+    class SamplingProfiler {
+    public:
+      SamplingProfiler(ParameterSet const&, ActivityRegistry&);
+      ~SamplingProfiler();
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      static constexpr unsigned int kMaxDepth = 64;
+      static constexpr unsigned int kMaxFrequency = 10000;
+      enum SlotState : unsigned int { kEmpty, kWriting, kFull };
+
+      struct Slot {
+        std::atomic<unsigned int> state_{kEmpty};
+        ModuleDescription const* module_ = nullptr;
+        unsigned int depth_ = 0;
+        void* frames_[kMaxDepth];
+      };
+
+      using Stack = std::pair<ModuleDescription const*, std::vector<void*>>;
+
+      //makes sure the thread local holding the current module is allocated before
+      // a signal handler may read it
+      class ThreadLocalInitializer : public tbb::task_scheduler_observer {
+      public:
+        ThreadLocalInitializer() { observe(true); }
+        ~ThreadLocalInitializer() override { observe(false); }
+        void on_scheduler_entry(bool) override { CurrentModuleOnThread::getCurrentModuleOnThread(); }
+      };
+
+      static void signalHandler(int);
+      void record();
+      void collect();
+      void startTimer();
+      void stopTimer();
+      void postEndJob();
+      void writeFile() const;
+
+      static std::atomic<SamplingProfiler*> s_instance;
+
+      std::string const fileName_;
+      unsigned int const samplingFrequency_;
+      unsigned int const maxDepth_;
+      std::unique_ptr<Slot[]> slots_;
+      unsigned int const nSlots_;
+      std::atomic<unsigned long> nextSlot_{0};
+      std::atomic<unsigned long> nDropped_{0};
+
+      //only used by the collecting thread until the end of the job
+      std::map<Stack, unsigned long> stacks_;
+      unsigned long nSamples_ = 0;
+
+      std::thread collector_;
+      std::mutex mutex_;
+      std::condition_variable condition_;
+      bool stop_ = false;
+      bool stopped_ = false;
+      struct sigaction previousAction_;
+      ThreadLocalInitializer threadLocalInitializer_;
+    };
+
+    inline bool isProcessWideService(SamplingProfiler const*) { return true; }
+  }  // namespace service
+}  // namespace edm
+
+namespace edm {
+  namespace service {
+    namespace {
+      //number of frames belonging to the signal handling itself
+      constexpr unsigned int kHandlerFrames = 3;
+
+      std::string symbolName(void* iAddress) {
+        Dl_info info;
+        if (0 == dladdr(iAddress, &info) or info.dli_sname == nullptr) {
+          if (info.dli_fname != nullptr) {
+            std::string library = info.dli_fname;
+            return "[" + library.substr(library.find_last_of('/') + 1) + "]";
+          }
+          return "[unknown]";
+        }
+        int status = 0;
+        std::unique_ptr<char, decltype(&std::free)> demangled(
+            abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status), &std::free);
+        std::string name = status == 0 ? demangled.get() : info.dli_sname;
+        //';' separates the frames in the folded format
+        for (auto& c : name) {
+          if (c == ';' or c == '\n') {
+            c = ':';
+          }
+        }
+        return name;
+      }
+    }  // namespace
+
+    std::atomic<SamplingProfiler*> SamplingProfiler::s_instance{nullptr};
+
+    SamplingProfiler::SamplingProfiler(ParameterSet const& iPS, ActivityRegistry& iRegistry)
+        : fileName_(iPS.getUntrackedParameter<std::string>("fileName")),
+          samplingFrequency_(iPS.getUntrackedParameter<unsigned int>("samplingFrequency")),
+          maxDepth_(std::min(kMaxDepth, iPS.getUntrackedParameter<unsigned int>("maxStackDepth") + kHandlerFrames)),
+          slots_(new Slot[iPS.getUntrackedParameter<unsigned int>("bufferSize")]),
+          nSlots_(iPS.getUntrackedParameter<unsigned int>("bufferSize")) {
+      if (samplingFrequency_ == 0 or samplingFrequency_ > kMaxFrequency) {
+        throw Exception(errors::Configuration) << "SamplingProfiler: samplingFrequency must be between 1 and "
+                                               << kMaxFrequency << " Hz, got " << samplingFrequency_;
+      }
+      if (nSlots_ == 0) {
+        throw Exception(errors::Configuration) << "SamplingProfiler: bufferSize must not be 0";
+      }
+      SamplingProfiler* expected = nullptr;
+      if (not s_instance.compare_exchange_strong(expected, this)) {
+        throw Exception(errors::Configuration) << "SamplingProfiler: only one instance can be active in a process";
+      }
+
+      //the first call to backtrace may allocate memory while loading the unwinder, which is
+      // not allowed in a signal handler
+      void* warmup[2];
+      backtrace(warmup, 2);
+
+      iRegistry.watchPreBeginJob([this](auto const&, auto const&) { startTimer(); });
+      iRegistry.watchPostEndJob(this, &SamplingProfiler::postEndJob);
+    }
+
+    SamplingProfiler::~SamplingProfiler() {
+      stopTimer();
+      s_instance = nullptr;
+    }
+
+    void SamplingProfiler::fillDescriptions(ConfigurationDescriptions& descriptions) {
+      ParameterSetDescription desc;
+      desc.addUntracked<std::string>("fileName", "samplingProfile.folded")
+          ->setComment("Output file in the folded stack format used by flamegraph.pl");
+      desc.addUntracked<unsigned int>("samplingFrequency", 100)
+          ->setComment("Number of samples taken per second of CPU time used by the process, from 1 to " +
+                       std::to_string(kMaxFrequency));
+      desc.addUntracked<unsigned int>("maxStackDepth", 48)->setComment("Maximum number of frames kept per sample");
+      desc.addUntracked<unsigned int>("bufferSize", 8192)
+          ->setComment(
+              "Number of samples which can be waiting to be collected. Samples arriving when the buffer is full are "
+              "dropped.");
+      descriptions.add("SamplingProfiler", desc);
+      descriptions.setComment(
+          "Periodically samples the call stacks of the threads using the CPU and attributes them to the module running "
+          "on the thread. The service uses SIGPROF and therefore can not be combined with other profilers using that "
+          "signal.");
+    }
+
+    void SamplingProfiler::signalHandler(int) {
+      auto instance = s_instance.load(std::memory_order_acquire);
+      if (instance) {
+        instance->record();
+      }
+    }
+
+    void SamplingProfiler::record() {
+      //only lock-free operations from here on since this runs inside a signal handler
+      Slot& slot = slots_[nextSlot_.fetch_add(1, std::memory_order_relaxed) % nSlots_];
+      unsigned int expected = kEmpty;
+      if (not slot.state_.compare_exchange_strong(expected, kWriting, std::memory_order_acquire)) {
+        nDropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      auto mcc = CurrentModuleOnThread::getCurrentModuleOnThread();
+      slot.module_ = mcc ? mcc->moduleDescription() : nullptr;
+      slot.depth_ = backtrace(slot.frames_, maxDepth_);
+      slot.state_.store(kFull, std::memory_order_release);
+    }
+
+    void SamplingProfiler::collect() {
+      for (unsigned int i = 0; i < nSlots_; ++i) {
+        Slot& slot = slots_[i];
+        if (slot.state_.load(std::memory_order_acquire) != kFull) {
+          continue;
+        }
+        if (slot.depth_ > kHandlerFrames) {
+          //stored outermost frame first
+          std::vector<void*> frames(std::make_reverse_iterator(slot.frames_ + slot.depth_),
+                                    std::make_reverse_iterator(slot.frames_ + kHandlerFrames));
+          ++stacks_[Stack(slot.module_, std::move(frames))];
+          ++nSamples_;
+        }
+        slot.state_.store(kEmpty, std::memory_order_release);
+      }
+    }
+
+    void SamplingProfiler::startTimer() {
+      struct sigaction action;
+      action.sa_handler = signalHandler;
+      sigemptyset(&action.sa_mask);
+      action.sa_flags = SA_RESTART;
+      if (0 != sigaction(SIGPROF, &action, &previousAction_)) {
+        throw Exception(errors::Configuration)
+            << "SamplingProfiler: unable to install the SIGPROF handler: " << std::strerror(errno);
+      }
+
+      //the collecting thread must not be sampled itself
+      sigset_t block, previous;
+      sigemptyset(&block);
+      sigaddset(&block, SIGPROF);
+      pthread_sigmask(SIG_BLOCK, &block, &previous);
+      collector_ = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (not stop_) {
+          condition_.wait_for(lock, std::chrono::milliseconds(100));
+          collect();
+        }
+        collect();
+      });
+      pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+
+      //tv_usec must be below one second, which a frequency of 1 Hz reaches
+      unsigned long const interval = 1000000UL / samplingFrequency_;
+      struct itimerval timer;
+      timer.it_interval.tv_sec = interval / 1000000UL;
+      timer.it_interval.tv_usec = interval % 1000000UL;
+      timer.it_value = timer.it_interval;
+      if (0 != setitimer(ITIMER_PROF, &timer, nullptr)) {
+        //the destructor stops the collecting thread and restores the previous handler
+        throw Exception(errors::Configuration)
+            << "SamplingProfiler: unable to start the ITIMER_PROF timer: " << std::strerror(errno);
+      }
+    }
+
+    void SamplingProfiler::stopTimer() {
+      if (not collector_.joinable() or stopped_) {
+        return;
+      }
+      stopped_ = true;
+      struct itimerval timer = {};
+      setitimer(ITIMER_PROF, &timer, nullptr);
+      sigaction(SIGPROF, &previousAction_, nullptr);
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+      }
+      condition_.notify_one();
+      collector_.join();
+    }
+
+    void SamplingProfiler::postEndJob() {
+      stopTimer();
+      writeFile();
+      LogSystem("SamplingProfiler") << "SamplingProfiler recorded " << nSamples_ << " samples, " << nDropped_.load()
+                                    << " were dropped. Output written to " << fileName_;
+    }
+
+    void SamplingProfiler::writeFile() const {
+      std::ofstream file(fileName_);
+      if (not file) {
+        LogError("SamplingProfiler") << "Unable to open output file " << fileName_;
+        return;
+      }
+      std::unordered_map<void*, std::string> names;
+      for (auto const& stackAndCount : stacks_) {
+        auto const module = stackAndCount.first.first;
+        file << (module ? module->moduleLabel() : std::string("(framework)"));
+        for (auto address : stackAndCount.first.second) {
+          auto itName = names.find(address);
+          if (itName == names.end()) {
+            itName = names.emplace(address, symbolName(address)).first;
+          }
+          file << ';' << itName->second;
+        }
+        file << ' ' << stackAndCount.second << '\n';
+      }
+    }
+  }  // namespace service
+}  // namespace edm
+
+using edm::service::SamplingProfiler;
+DEFINE_FWK_SERVICE(SamplingProfiler);
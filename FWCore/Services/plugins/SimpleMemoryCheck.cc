@@ -31,6 +31,7 @@
 
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventArenaService.h"
 #include "FWCore/MessageLogger/interface/JobReport.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
@@ -41,6 +42,7 @@
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/MallocOpts.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
+#include "FWCore/Utilities/interface/memory_usage.h"
 
 #include <cstring>
 #include <iostream>
@@ -56,6 +58,13 @@
 
 #include <cstdio>
 #include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace {
+  // the counters at the start of the module calls running on the current thread, innermost last
+  thread_local std::vector<std::pair<uint64_t, uint64_t>> moduleAllocationStarts;
+}  // namespace
 
 namespace edm {
   class EventID;
@@ -95,6 +104,10 @@ namespace edm {
       void preModule(StreamContext const&, ModuleCallingContext const&);
       void postModule(StreamContext const&, ModuleCallingContext const&);
 
+      void preModuleConstructionAllocations(const ModuleDescription&);
+      void preModuleAllocations(StreamContext const&, ModuleCallingContext const&);
+      void postModuleAllocations(StreamContext const&, ModuleCallingContext const&);
+
       void postEndJob();
 
     private:
@@ -255,6 +268,18 @@ namespace edm {
       std::atomic<unsigned int> moduleStreamID_;
       std::atomic<unsigned int> moduleID_;
 
+      // Per module allocation summary, from the bytes allocated and deallocated by the thread running the module
+      // between the start and the end of its event calls; the calls of the modules it runs itself are included
+      struct ModuleAllocations {
+        std::string label;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> allocated{0};
+        std::atomic<int64_t> retained{0};
+        std::atomic<uint64_t> maxAllocated{0};
+      };
+      bool moduleAllocationSummaryRequested_;
+      // indexed by the module id, filled during the construction of the modules
+      std::vector<std::unique_ptr<ModuleAllocations>> moduleAllocations_;
     };  // SimpleMemoryCheck
 
     std::ostream& operator<<(std::ostream& os, SimpleMemoryCheck::SignificantEvent const& se);
@@ -345,7 +370,8 @@ namespace edm {
           growthRateVsize_(),
           growthRateRss_(),
           moduleSummaryRequested_(iPS.getUntrackedParameter<bool>("moduleMemorySummary")),
-          measurementUnderway_(false) {
+          measurementUnderway_(false),
+          moduleAllocationSummaryRequested_(iPS.getUntrackedParameter<bool>("moduleAllocationSummary")) {
       // changelog 2
       // pg_size = (double)getpagesize();
       std::ostringstream ost;
@@ -372,6 +398,17 @@ namespace edm {
           iReg.watchPostModuleEvent(this, &SimpleMemoryCheck::postModule);
         }
       }
+      if (moduleAllocationSummaryRequested_) {
+        if (memory_usage::is_available()) {
+          iReg.watchPreModuleConstruction(this, &SimpleMemoryCheck::preModuleConstructionAllocations);
+          iReg.watchPreModuleEvent(this, &SimpleMemoryCheck::preModuleAllocations);
+          iReg.watchPostModuleEvent(this, &SimpleMemoryCheck::postModuleAllocations);
+        } else {
+          LogWarning("MemoryCheck") << "The module allocation summary needs jemalloc built with the statistics, "
+                                       "which is not the allocator of this job; the summary is disabled.";
+          moduleAllocationSummaryRequested_ = false;
+        }
+      }
 
       // The following are not currenty used/implemented below for either
       // of the print modes (but are left here for reference)
@@ -433,6 +470,9 @@ namespace edm {
       desc.addUntracked<bool>("jobReportOutputOnly", false);
       desc.addUntracked<bool>("monitorPssAndPrivate", false);
       desc.addUntracked<bool>("moduleMemorySummary", false);
+      desc.addUntracked<bool>("moduleAllocationSummary", false)
+          ->setComment("Report the bytes allocated and retained by each module in its event calls, "
+                       "from the jemalloc statistics");
       desc.addUntracked<int>("M_MMAP_MAX", -1);
       desc.addUntracked<int>("M_TRIM_THRESHOLD", -1);
       desc.addUntracked<int>("M_TOP_PAD", -1);
@@ -544,8 +584,36 @@ namespace edm {
           }
           mmr << "\n";
         }
+        Service<service::EventArenaService> arenaService;
+        if (arenaService.isAvailable()) {
+          mmr << "\n  largest per Event use of the EventArenaService arena in bytes \n";
+          for (auto const& labelAndPeak : arenaService->peakUsagePerModule()) {
+            mmr << labelAndPeak.first << ": arena peak = " << labelAndPeak.second << "\n";
+          }
+        }
       }  // end of if; mmr goes out of scope; log message is queued
 
+      if (moduleAllocationSummaryRequested_ and not jobReportOutputOnly_) {
+        LogAbsolute mar("ModuleAllocationReport");
+        mar << "ModuleAllocationReport> Each line has module label and: \n";
+        mar << "    count of times module executed; average bytes allocated per event \n";
+        mar << "    maximum bytes allocated in one event; average and total bytes retained \n";
+        mar << "    (allocated and not deallocated by the module itself) \n \n";
+        for (auto const& m : moduleAllocations_) {
+          if (not m)
+            continue;
+          uint64_t calls = m->calls.load(std::memory_order_relaxed);
+          if (calls == 0)
+            continue;
+          int64_t retained = m->retained.load(std::memory_order_relaxed);
+          mar << m->label << ": n = " << calls;
+          mar << " avg allocated = " << m->allocated.load(std::memory_order_relaxed) / calls;
+          mar << " max allocated = " << m->maxAllocated.load(std::memory_order_relaxed);
+          mar << " avg retained = " << retained / static_cast<int64_t>(calls);
+          mar << " total retained = " << retained << "\n";
+        }
+      }
+
       Service<JobReport> reportSvc;
       // changelog 1
 #define SIMPLE_MEMORY_CHECK_ORIGINAL_XML_OUTPUT
@@ -771,6 +839,44 @@ namespace edm {
       }
     }
 
+    void SimpleMemoryCheck::preModuleConstructionAllocations(const ModuleDescription& iDescription) {
+      auto id = iDescription.id();
+      if (id >= moduleAllocations_.size()) {
+        moduleAllocations_.resize(id + 1);
+      }
+      moduleAllocations_[id] = std::make_unique<ModuleAllocations>();
+      moduleAllocations_[id]->label = iDescription.moduleLabel();
+    }
+
+    void SimpleMemoryCheck::preModuleAllocations(StreamContext const&, ModuleCallingContext const&) {
+      // the stack grows before the counters are read, so that its own allocation is not attributed to the module
+      moduleAllocationStarts.emplace_back();
+      moduleAllocationStarts.back() = {memory_usage::allocated(), memory_usage::deallocated()};
+    }
+
+    void SimpleMemoryCheck::postModuleAllocations(StreamContext const&, ModuleCallingContext const& iModuleContext) {
+      if (not memory_usage::is_available() or moduleAllocationStarts.empty())
+        return;
+      uint64_t allocated = memory_usage::allocated();
+      uint64_t deallocated = memory_usage::deallocated();
+      auto start = moduleAllocationStarts.back();
+      moduleAllocationStarts.pop_back();
+
+      auto id = iModuleContext.moduleDescription()->id();
+      if (id >= moduleAllocations_.size() or not moduleAllocations_[id])
+        return;
+      ModuleAllocations& m = *moduleAllocations_[id];
+      uint64_t dAllocated = allocated - start.first;
+      uint64_t dDeallocated = deallocated - start.second;
+      m.calls.fetch_add(1, std::memory_order_relaxed);
+      m.allocated.fetch_add(dAllocated, std::memory_order_relaxed);
+      m.retained.fetch_add(static_cast<int64_t>(dAllocated) - static_cast<int64_t>(dDeallocated),
+                           std::memory_order_relaxed);
+      uint64_t max = m.maxAllocated.load(std::memory_order_relaxed);
+      while (dAllocated > max and not m.maxAllocated.compare_exchange_weak(max, dAllocated, std::memory_order_relaxed))
+        ;
+    }
+
     void SimpleMemoryCheck::update() {
       std::swap(current_, previous_);
       *current_ = fetch();
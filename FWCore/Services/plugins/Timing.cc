@@ -31,8 +31,12 @@
 #include <sstream>
 #include <sys/resource.h>
 #include <sys/time.h>
+#include <algorithm>
 #include <atomic>
 #include <exception>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace edm {
 
@@ -79,6 +83,9 @@ namespace edm {
       void preModule(ModuleDescription const& md);
       void postModule(ModuleDescription const& md);
 
+      void preModuleStartup(ModuleDescription const& md);
+      void postModuleStartup(ModuleDescription const& md);
+
       void preModuleGlobal(GlobalContext const&, ModuleCallingContext const&);
       void postModuleGlobal(GlobalContext const&, ModuleCallingContext const&);
 
@@ -121,6 +128,7 @@ namespace edm {
       std::vector<double> curr_events_time_;  // seconds
       bool summary_only_;
       bool report_summary_;
+      bool report_startup_;
       double threshold_;
       //
       // Min Max and total event times for each Stream.
@@ -147,6 +155,10 @@ namespace edm {
 
       bool configuredInTopLevelProcess_;
       unsigned int nSubProcesses_;
+
+      // time of the construction and beginJob of each module, which the framework does one module at a time
+      double startup_module_time_;
+      std::map<std::string, double> startup_time_;
     };
   }  // namespace service
 }  // namespace edm
@@ -225,6 +237,7 @@ namespace edm {
           curr_events_time_(),
           summary_only_(iPS.getUntrackedParameter<bool>("summaryOnly")),
           report_summary_(iPS.getUntrackedParameter<bool>("useJobReport")),
+          report_startup_(iPS.getUntrackedParameter<bool>("reportStartup")),
           threshold_(iPS.getUntrackedParameter<double>("excessiveTimeThreshold")),
           max_events_time_(),
           min_events_time_(),
@@ -237,7 +250,8 @@ namespace edm {
           countAndTimeForGet_{&countAndTimeZero_},
           accumulatedTimeForGet_{0.0},
           configuredInTopLevelProcess_{false},
-          nSubProcesses_{0} {
+          nSubProcesses_{0},
+          startup_module_time_{0.0} {
       iRegistry.watchPreBeginJob(this, &Timing::preBeginJob);
       iRegistry.watchPostBeginJob(this, &Timing::postBeginJob);
       iRegistry.watchPostEndJob(this, &Timing::postEndJob);
@@ -309,6 +323,13 @@ namespace edm {
         iRegistry.watchPostSourceConstruction(this, &Timing::postModule);
       }
 
+      if (report_startup_) {
+        iRegistry.watchPreModuleConstruction(this, &Timing::preModuleStartup);
+        iRegistry.watchPostModuleConstruction(this, &Timing::postModuleStartup);
+        iRegistry.watchPreModuleBeginJob(this, &Timing::preModuleStartup);
+        iRegistry.watchPostModuleBeginJob(this, &Timing::postModuleStartup);
+      }
+
       iRegistry.watchPostGlobalBeginRun(this, &Timing::postGlobalBeginRun);
       iRegistry.watchPostGlobalBeginLumi(this, &Timing::postGlobalBeginLumi);
 
@@ -346,6 +367,9 @@ namespace edm {
       ParameterSetDescription desc;
       desc.addUntracked<bool>("summaryOnly", false)->setComment("If 'true' do not report timing for each event");
       desc.addUntracked<bool>("useJobReport", true)->setComment("If 'true' write summary information to JobReport");
+      desc.addUntracked<bool>("reportStartup", false)
+          ->setComment(
+              "If 'true' report, at the end of beginJob, the time each module took in its construction and beginJob");
       desc.addUntracked<double>("excessiveTimeThreshold", 0.)
           ->setComment(
               "Amount of time in seconds before reporting a module or source has taken excessive time. A value of 0.0 "
@@ -378,6 +402,21 @@ namespace edm {
                                    << "eventnum runnum modulelabel modulename timetakeni\n"
                                    << "TimeReport> JobTime=" << curr_job_time_ << " JobCPU=" << curr_job_cpu_ << "\n";
       }
+
+      if (report_startup_) {
+        std::vector<std::pair<std::string, double>> times(startup_time_.begin(), startup_time_.end());
+        std::sort(times.begin(), times.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+        double total = 0.;
+        for (auto const& labelTime : times) {
+          total += labelTime.second;
+        }
+        LogImportant log("TimeReport");
+        log << "TimeReport> Startup time (construction and beginJob) of the modules: " << total << " seconds\n"
+            << "TimeReport> Report columns headings for modules: modulelabel timetaken\n";
+        for (auto const& labelTime : times) {
+          log << "TimeReport> " << labelTime.first << " " << labelTime.second << "\n";
+        }
+      }
     }
 
     void Timing::postEndJob() {
@@ -561,6 +600,12 @@ namespace edm {
 
     void Timing::postModule(ModuleDescription const& desc) { postCommon(); }
 
+    void Timing::preModuleStartup(ModuleDescription const&) { startup_module_time_ = getTime(); }
+
+    void Timing::postModuleStartup(ModuleDescription const& desc) {
+      startup_time_[desc.moduleLabel()] += getTime() - startup_module_time_;
+    }
+
     void Timing::preModuleGlobal(GlobalContext const&, ModuleCallingContext const&) {
       pushStack(configuredInTopLevelProcess_);
     }
@@ -0,0 +1,12 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(100))
+
+process.options = cms.untracked.PSet(numberOfThreads = cms.untracked.uint32(4),
+                                     numberOfStreams = cms.untracked.uint32(0))
+
+process.add_(cms.Service("NUMAAffinity", verbose = cms.untracked.bool(True)))
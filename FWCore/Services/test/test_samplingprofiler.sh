@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_samplingprofiler_cfg.py
+
+(cmsRun $F1 ) || die "Failure using $F1" $?
+[ -f test_samplingprofiler.folded ] || die "test_samplingprofiler.folded was not written" 1
+rm -f test_samplingprofiler.folded
+
+# a frequency of 1 Hz is an interval of a full second
+(cmsRun $F1 1 ) || die "Failure using $F1 with 1 Hz" $?
+[ -f test_samplingprofiler.folded ] || die "test_samplingprofiler.folded was not written with 1 Hz" 1
+
+(cmsRun $F1 0 ) && die "No failure using $F1 with 0 Hz" 1
+exit 0
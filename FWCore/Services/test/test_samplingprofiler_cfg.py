@@ -0,0 +1,20 @@
+import FWCore.ParameterSet.Config as cms
+import sys
+
+# the sampling frequency can be given as last argument
+frequency = 1000
+if sys.argv[-1].isdigit():
+    frequency = int(sys.argv[-1])
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10000))
+
+process.options = cms.untracked.PSet(numberOfThreads = cms.untracked.uint32(2),
+                                     numberOfStreams = cms.untracked.uint32(0))
+
+process.add_(cms.Service("SamplingProfiler",
+                         fileName = cms.untracked.string("test_samplingprofiler.folded"),
+                         samplingFrequency = cms.untracked.uint32(frequency)))
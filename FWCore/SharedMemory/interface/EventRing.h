@@ -0,0 +1,156 @@
+#ifndef FWCore_SharedMemory_EventRing_h
+#define FWCore_SharedMemory_EventRing_h
+// -*- C++ -*-
+//
+// Package:     FWCore/SharedMemory
+// Class  :     EventRing
+//
+/**\class EventRingWriter EventRing.h " FWCore/SharedMemory/interface/EventRing.h"
+
+ Description: Ring of event buffers in shared memory, filled by one process and emptied by several
+
+ Usage:
+    The EventRingWriter creates a shared memory segment holding a fixed number of slots of a fixed size
+ and copies each event into the next free slot. Any number of processes open the same ring with an
+ EventRingReader, and every event is handed to exactly one of them. A reader holds the slot of its event
+ until it calls release() or asks for the next event.
+
+    When all the slots are in use, EventRingWriter::push() waits for a reader to release one, so the writer
+ is held back by the slowest consumers instead of filling the memory. The return value tells the writer
+ that it has been waiting longer than the given timeout, and occupancy() can be used to throttle earlier.
+ \code
+ EventRingWriter writer("FRDEventRing", 32, 4 << 20);
+ while (writer.push(data, size, std::chrono::seconds(1)) == EventRingWriter::Status::kTimeout) {
+   // the readers are not keeping up
+ }
+ writer.stop();
+
+ EventRingReader reader("FRDEventRing");
+ EventRingReader::Event event;
+ while (reader.next(event, std::chrono::seconds(1)) != EventRingReader::Status::kStopped) {
+   ...
+   reader.release();
+ }
+ \endcode
+*/
+//
+
+// system include files
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "boost/interprocess/managed_shared_memory.hpp"
+#include "boost/interprocess/sync/interprocess_condition.hpp"
+#include "boost/interprocess/sync/interprocess_mutex.hpp"
+
+// user include files
+#include "FWCore/SharedMemory/interface/buffer_names.h"
+
+// forward declarations
+
+namespace edm::shared_memory {
+  namespace event_ring {
+    enum class SlotState : unsigned char { kFree, kFilled, kClaimed };
+
+    struct Slot {
+      std::size_t size_ = 0;
+      SlotState state_ = SlotState::kFree;
+    };
+
+    struct Control {
+      Control(unsigned int iNSlots, std::size_t iSlotSize) : nSlots_{iNSlots}, slotSize_{iSlotSize} {}
+
+      boost::interprocess::interprocess_mutex mutex_;
+      //signalled when an event is added or the ring is stopped
+      boost::interprocess::interprocess_condition cndFilled_;
+      //signalled when a slot is released
+      boost::interprocess::interprocess_condition cndReleased_;
+
+      unsigned int const nSlots_;
+      std::size_t const slotSize_;
+      //number of events pushed and handed to readers since the ring was created
+      unsigned long long written_ = 0;
+      unsigned long long claimed_ = 0;
+      //slots which are filled or claimed
+      unsigned int used_ = 0;
+      unsigned int readers_ = 0;
+      bool stopped_ = false;
+    };
+  }  // namespace event_ring
+
+  class EventRingWriter {
+  public:
+    enum class Status { kOk, kTimeout, kTooLarge };
+
+    /** iUniqueName : must be unique for all processes running on a system and be the same for the readers.
+        Any ring left over with the same name is removed.
+    */
+    EventRingWriter(std::string const& iUniqueName, unsigned int iNSlots, std::size_t iSlotSize);
+    EventRingWriter(const EventRingWriter&) = delete;
+    const EventRingWriter& operator=(const EventRingWriter&) = delete;
+    EventRingWriter(EventRingWriter&&) = delete;
+    const EventRingWriter& operator=(EventRingWriter&&) = delete;
+
+    ~EventRingWriter();
+
+    // ---------- const member functions ---------------------
+    unsigned int nSlots() const { return control_->nSlots_; }
+    std::size_t slotSize() const { return control_->slotSize_; }
+    ///number of slots holding events which were not yet released by a reader
+    unsigned int occupancy() const;
+    unsigned int readers() const;
+
+    // ---------- member functions ---------------------------
+    ///copies the event into the next free slot, waiting at most iTimeout for one to be released
+    Status push(const char* iStart, std::size_t iLength, std::chrono::milliseconds iTimeout);
+    ///no more events will be pushed, readers are told once they have taken all the remaining ones
+    void stop();
+
+  private:
+    // ---------- member data --------------------------------
+    std::string name_;
+    std::unique_ptr<boost::interprocess::managed_shared_memory> sm_;
+    event_ring::Control* control_;
+    event_ring::Slot* slots_;
+    char* data_;
+  };
+
+  class EventRingReader {
+  public:
+    enum class Status { kOk, kTimeout, kStopped };
+
+    struct Event {
+      const char* data_ = nullptr;
+      std::size_t size_ = 0;
+    };
+
+    ///throws boost::interprocess::interprocess_exception if the ring does not exist
+    explicit EventRingReader(std::string const& iUniqueName);
+    EventRingReader(const EventRingReader&) = delete;
+    const EventRingReader& operator=(const EventRingReader&) = delete;
+    EventRingReader(EventRingReader&&) = delete;
+    const EventRingReader& operator=(EventRingReader&&) = delete;
+
+    ~EventRingReader();
+
+    // ---------- member functions ---------------------------
+    /** Releases the event held and waits at most iTimeout for the next one. The data of oEvent stays valid
+        until release() or next() is called.
+    */
+    Status next(Event& oEvent, std::chrono::milliseconds iTimeout);
+    ///gives the slot of the event back to the writer
+    void release();
+
+  private:
+    // ---------- member data --------------------------------
+    std::unique_ptr<boost::interprocess::managed_shared_memory> sm_;
+    event_ring::Control* control_;
+    event_ring::Slot* slots_;
+    char* data_;
+    //slot of the event currently held, or nSlots_ if none
+    unsigned int held_;
+  };
+}  // namespace edm::shared_memory
+
+#endif
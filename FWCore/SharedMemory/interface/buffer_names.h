@@ -29,6 +29,9 @@ namespace edm::shared_memory {
     constexpr char const* const kBuffer = "buffer";
     constexpr char const* const kBuffer0 = "buffer0";
     constexpr char const* const kBuffer1 = "buffer1";
+    constexpr char const* const kEventRingControl = "eventRingControl";
+    constexpr char const* const kEventRingSlots = "eventRingSlots";
+    constexpr char const* const kEventRingData = "eventRingData";
   }  // namespace buffer_names
 }  // namespace edm::shared_memory
 
@@ -0,0 +1,165 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/SharedMemory
+// Class  :     EventRing
+//
+// Implementation:
+//     The slots are filled in order and handed to the readers in the same order. Since readers can release
+//  them in any order, the writer waits for the specific slot it is going to fill to be free.
+//
+
+// system include files
+#include <algorithm>
+#include <cassert>
+#include "boost/date_time/posix_time/posix_time_types.hpp"
+#include "boost/interprocess/sync/scoped_lock.hpp"
+
+// user include files
+#include "FWCore/SharedMemory/interface/EventRing.h"
+
+//
+// constants, enums and typedefs
+//
+using namespace edm::shared_memory;
+using namespace edm::shared_memory::event_ring;
+using namespace boost::interprocess;
+
+namespace {
+  boost::posix_time::ptime deadline(std::chrono::milliseconds iTimeout) {
+    return boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(iTimeout.count());
+  }
+
+  //space needed by the allocator of the managed segment besides the objects
+  constexpr std::size_t kSegmentOverhead = 64 * 1024;
+}  // namespace
+
+//
+// constructors and destructor
+//
+EventRingWriter::EventRingWriter(std::string const& iUniqueName, unsigned int iNSlots, std::size_t iSlotSize)
+    : name_{iUniqueName} {
+  assert(iNSlots > 0);
+  shared_memory_object::remove(name_.c_str());
+  //keep the event data aligned to 8 bytes, as FRD events are read as 64 bit words
+  iSlotSize = (iSlotSize + 7) & ~std::size_t(7);
+  std::size_t size = sizeof(Control) + iNSlots * (sizeof(Slot) + iSlotSize) + kSegmentOverhead;
+  sm_ = std::make_unique<managed_shared_memory>(create_only, name_.c_str(), size);
+  control_ = sm_->construct<Control>(buffer_names::kEventRingControl)(iNSlots, iSlotSize);
+  slots_ = sm_->construct<Slot>(buffer_names::kEventRingSlots)[iNSlots]();
+  data_ = sm_->construct<char>(buffer_names::kEventRingData)[iNSlots * iSlotSize](0);
+  assert(control_ and slots_ and data_);
+}
+
+EventRingWriter::~EventRingWriter() {
+  stop();
+  //readers which already opened the ring keep their mapping
+  sm_.reset();
+  shared_memory_object::remove(name_.c_str());
+}
+
+EventRingReader::EventRingReader(std::string const& iUniqueName)
+    : sm_{std::make_unique<managed_shared_memory>(open_only, iUniqueName.c_str())},
+      control_{sm_->find<Control>(buffer_names::kEventRingControl).first},
+      slots_{sm_->find<Slot>(buffer_names::kEventRingSlots).first},
+      data_{sm_->find<char>(buffer_names::kEventRingData).first},
+      held_{0} {
+  if (not control_ or not slots_ or not data_) {
+    throw interprocess_exception(("the event ring " + iUniqueName + " is not fully constructed").c_str());
+  }
+  held_ = control_->nSlots_;
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  ++control_->readers_;
+}
+
+EventRingReader::~EventRingReader() {
+  release();
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  --control_->readers_;
+}
+
+//
+// member functions
+//
+EventRingWriter::Status EventRingWriter::push(const char* iStart,
+                                              std::size_t iLength,
+                                              std::chrono::milliseconds iTimeout) {
+  if (iLength > control_->slotSize_) {
+    return Status::kTooLarge;
+  }
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  unsigned int index = control_->written_ % control_->nSlots_;
+  Slot& slot = slots_[index];
+  if (slot.state_ != SlotState::kFree) {
+    auto const end = deadline(iTimeout);
+    while (slot.state_ != SlotState::kFree) {
+      if (not control_->cndReleased_.timed_wait(lock, end) and slot.state_ != SlotState::kFree) {
+        return Status::kTimeout;
+      }
+    }
+  }
+  //the slot is not visible to the readers until it is marked as filled, so copy without holding the lock
+  lock.unlock();
+  std::copy(iStart, iStart + iLength, data_ + index * control_->slotSize_);
+  lock.lock();
+  slot.size_ = iLength;
+  slot.state_ = SlotState::kFilled;
+  ++control_->written_;
+  ++control_->used_;
+  control_->cndFilled_.notify_one();
+  return Status::kOk;
+}
+
+void EventRingWriter::stop() {
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  control_->stopped_ = true;
+  control_->cndFilled_.notify_all();
+}
+
+EventRingReader::Status EventRingReader::next(Event& oEvent, std::chrono::milliseconds iTimeout) {
+  release();
+  oEvent = Event();
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  if (control_->claimed_ == control_->written_) {
+    auto const end = deadline(iTimeout);
+    while (control_->claimed_ == control_->written_) {
+      if (control_->stopped_) {
+        return Status::kStopped;
+      }
+      if (not control_->cndFilled_.timed_wait(lock, end) and control_->claimed_ == control_->written_) {
+        return control_->stopped_ ? Status::kStopped : Status::kTimeout;
+      }
+    }
+  }
+  held_ = control_->claimed_ % control_->nSlots_;
+  ++control_->claimed_;
+  Slot& slot = slots_[held_];
+  assert(slot.state_ == SlotState::kFilled);
+  slot.state_ = SlotState::kClaimed;
+  oEvent.data_ = data_ + held_ * control_->slotSize_;
+  oEvent.size_ = slot.size_;
+  return Status::kOk;
+}
+
+void EventRingReader::release() {
+  if (held_ == control_->nSlots_) {
+    return;
+  }
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  slots_[held_].state_ = SlotState::kFree;
+  --control_->used_;
+  held_ = control_->nSlots_;
+  control_->cndReleased_.notify_all();
+}
+
+//
+// const member functions
+//
+unsigned int EventRingWriter::occupancy() const {
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  return control_->used_;
+}
+
+unsigned int EventRingWriter::readers() const {
+  scoped_lock<interprocess_mutex> lock(control_->mutex_);
+  return control_->readers_;
+}
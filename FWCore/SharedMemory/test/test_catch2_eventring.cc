@@ -0,0 +1,99 @@
+#include "catch.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FWCore/SharedMemory/interface/EventRing.h"
+
+using namespace edm::shared_memory;
+
+TEST_CASE("test EventRing", "[EventRing]") {
+  std::string const uniqueName = "EventRingTest" + std::to_string(getpid());
+
+  EventRingWriter writer(uniqueName, 2, 16);
+  EventRingReader reader(uniqueName);
+  REQUIRE(writer.readers() == 1);
+
+  std::array<char, 4> dummy = {{'t', 'e', 's', 't'}};
+  std::chrono::milliseconds const timeout(10);
+  EventRingReader::Event event;
+
+  SECTION("Empty") { REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kTimeout); }
+
+  SECTION("Too large") {
+    std::vector<char> large(writer.slotSize() + 1, 'l');
+    REQUIRE(writer.push(large.data(), large.size(), timeout) == EventRingWriter::Status::kTooLarge);
+    REQUIRE(writer.occupancy() == 0);
+  }
+
+  SECTION("Full") {
+    REQUIRE(writer.push(dummy.data(), dummy.size(), timeout) == EventRingWriter::Status::kOk);
+    dummy[0] = 'b';
+    REQUIRE(writer.push(dummy.data(), dummy.size(), timeout) == EventRingWriter::Status::kOk);
+    REQUIRE(writer.occupancy() == 2);
+    //no free slot until a reader releases one
+    REQUIRE(writer.push(dummy.data(), dummy.size(), timeout) == EventRingWriter::Status::kTimeout);
+
+    REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kOk);
+    REQUIRE(event.size_ == dummy.size());
+    REQUIRE(event.data_[0] == 't');
+    //the slot is still held
+    REQUIRE(writer.push(dummy.data(), dummy.size(), timeout) == EventRingWriter::Status::kTimeout);
+    reader.release();
+    REQUIRE(writer.occupancy() == 1);
+    dummy[0] = 'c';
+    REQUIRE(writer.push(dummy.data(), dummy.size(), timeout) == EventRingWriter::Status::kOk);
+
+    REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kOk);
+    REQUIRE(event.data_[0] == 'b');
+    REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kOk);
+    REQUIRE(event.data_[0] == 'c');
+    REQUIRE(writer.occupancy() == 1);
+
+    SECTION("Stopped") {
+      writer.stop();
+      REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kStopped);
+      REQUIRE(writer.occupancy() == 0);
+    }
+  }
+
+  SECTION("Stop with remaining events") {
+    REQUIRE(writer.push(dummy.data(), dummy.size(), timeout) == EventRingWriter::Status::kOk);
+    writer.stop();
+    REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kOk);
+    REQUIRE(reader.next(event, timeout) == EventRingReader::Status::kStopped);
+  }
+
+  SECTION("Several readers") {
+    constexpr unsigned int kEvents = 1000;
+    std::atomic<unsigned int> received{0};
+    std::atomic<unsigned long long> sum{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+      threads.emplace_back([&]() {
+        EventRingReader threadReader(uniqueName);
+        EventRingReader::Event threadEvent;
+        EventRingReader::Status status;
+        while ((status = threadReader.next(threadEvent, std::chrono::seconds(10))) == EventRingReader::Status::kOk) {
+          unsigned int value;
+          std::copy(threadEvent.data_, threadEvent.data_ + sizeof(value), reinterpret_cast<char*>(&value));
+          sum += value;
+          ++received;
+        }
+      });
+    }
+    for (unsigned int value = 0; value < kEvents; ++value) {
+      REQUIRE(writer.push(reinterpret_cast<char const*>(&value), sizeof(value), std::chrono::seconds(10)) ==
+              EventRingWriter::Status::kOk);
+    }
+    writer.stop();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    REQUIRE(received == kEvents);
+    REQUIRE(sum == kEvents * (kEvents - 1ULL) / 2);
+  }
+}
@@ -133,7 +133,7 @@ namespace edm {
     template <typename KEY, typename T>
     void ThreadSafeRegistry<KEY, T>::print(std::ostream& os) const {
       std::lock_guard<std::mutex> guard(mutex_);
-      os << "Registry with " << size() << " entries\n";
+      os << "Registry with " << data_.size() << " entries\n";
       for (auto const& item : data_) {
         os << item.first << " " << item.second << '\n';
       }
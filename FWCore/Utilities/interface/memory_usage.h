@@ -0,0 +1,15 @@
+#ifndef FWCore_Utilities_memory_usage_h
+#define FWCore_Utilities_memory_usage_h
+
+#include <cstdint>
+
+// the bytes allocated and deallocated by the current thread, as counted by jemalloc built with the statistics;
+// they stay at 0 if the allocator is not jemalloc or has no statistics
+class memory_usage {
+public:
+  static bool is_available();
+  static uint64_t allocated();
+  static uint64_t deallocated();
+};
+
+#endif  // FWCore_Utilities_memory_usage_h
@@ -1,5 +1,9 @@
 #include "FWCore/Utilities/interface/Adler32Calculator.h"
 
+#if defined(__x86_64__)
+#include <tmmintrin.h>
+#endif
+
 namespace cms {
 
   //-------------------------------------------------------
@@ -7,26 +11,115 @@ namespace cms {
   // http://en.wikipedia.org/wiki/Adler-32
   //-------------------------------------------------------
 
+#define MOD_ADLER 65521
+  // largest number of bytes that can be summed before b can overflow 32 bits
+#define NMAX_ADLER 5552
+
+  namespace {
+    void adler32Scalar(unsigned char const* ptr, size_t len, uint32_t& a, uint32_t& b) {
+      while (len > 0) {
+        size_t tlen = (len > NMAX_ADLER ? NMAX_ADLER : len);
+        len -= tlen;
+        do {
+          a += *ptr++;
+          b += a;
+        } while (--tlen);
+
+        a %= MOD_ADLER;
+        b %= MOD_ADLER;
+      }
+    }
+
+#if defined(__x86_64__)
+    // Sums blocks of 32 bytes with SSSE3: the bytes are added to a with
+    // psadbw, and multiplied by their distance from the end of the block with
+    // pmaddubsw for b, which also collects 32 times the value of a at the
+    // start of every block. Same algorithm as the SIMD Adler32 of zlib in
+    // Chromium.
+    __attribute__((target("ssse3"))) void adler32Ssse3(unsigned char const* ptr,
+                                                       size_t len,
+                                                       uint32_t& a,
+                                                       uint32_t& b) {
+      constexpr size_t kBlock = 32;
+      size_t blocks = len / kBlock;
+      len -= blocks * kBlock;
+
+      uint32_t s1 = a % MOD_ADLER;
+      uint32_t s2 = b % MOD_ADLER;
+
+      const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+      const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i ones = _mm_set1_epi16(1);
+
+      while (blocks > 0) {
+        size_t n = (blocks > NMAX_ADLER / kBlock ? NMAX_ADLER / kBlock : blocks);
+        blocks -= n;
+
+        // v_ps accumulates a at the start of each block, beginning with the input a for all n blocks
+        __m128i v_ps = _mm_set_epi32(0, 0, 0, s1 * n);
+        __m128i v_s2 = _mm_set_epi32(0, 0, 0, s2);
+        __m128i v_s1 = _mm_setzero_si128();
+        do {
+          const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr));
+          const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr + 16));
+
+          v_ps = _mm_add_epi32(v_ps, v_s1);
+          v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+          v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+          v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+          v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+          ptr += kBlock;
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        // horizontal sums of the four lanes
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s1 += _mm_cvtsi128_si32(v_s1);
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = _mm_cvtsi128_si32(v_s2);
+
+        s1 %= MOD_ADLER;
+        s2 %= MOD_ADLER;
+      }
+
+      a = s1;
+      b = s2;
+      // the remaining bytes
+      if (len > 0)
+        adler32Scalar(ptr, len, a, b);
+    }
+#endif
+
+    using Adler32Function = void (*)(unsigned char const*, size_t, uint32_t&, uint32_t&);
+
+    Adler32Function selectAdler32() {
+#if defined(__x86_64__)
+      if (__builtin_cpu_supports("ssse3"))
+        return adler32Ssse3;
+#endif
+      return adler32Scalar;
+    }
+  }  // namespace
+
   void Adler32(char const* data, size_t len, uint32_t& a, uint32_t& b) {
     /* data: Pointer to the data to be summed; len is in bytes */
+    static const Adler32Function adler32 = selectAdler32();
 
-#define MOD_ADLER 65521
-
+    // short buffers are not worth the setup of the vector loop
     unsigned char const* ptr = static_cast<unsigned char const*>(static_cast<void const*>(data));
-    while (len > 0) {
-      size_t tlen = (len > 5552 ? 5552 : len);
-      len -= tlen;
-      do {
-        a += *ptr++;
-        b += a;
-      } while (--tlen);
-
-      a %= MOD_ADLER;
-      b %= MOD_ADLER;
-    }
+    if (len < 64)
+      adler32Scalar(ptr, len, a, b);
+    else
+      adler32(ptr, len, a, b);
+  }
 
+#undef NMAX_ADLER
 #undef MOD_ADLER
-  }
 
   uint32_t Adler32(char const* data, size_t len) {
     /* data: Pointer to the data to be summed; len is in bytes */
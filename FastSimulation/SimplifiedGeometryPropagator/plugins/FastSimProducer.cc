@@ -213,6 +213,9 @@ void FastSimProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
   LogDebug(MESSAGECATEGORY) << "################################"
                             << "\n###############################";
 
+  // The secondaries of an interaction or a decay, reused across the steps of all particles
+  std::vector<std::unique_ptr<fastsim::Particle> > secondaries;
+
   // loop over particles
   for (std::unique_ptr<fastsim::Particle> particle = particleManager.nextParticle(*_randomEngine); particle != nullptr;
        particle = particleManager.nextParticle(*_randomEngine)) {
@@ -260,7 +263,7 @@ void FastSimProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
           // loop on interaction models
           for (fastsim::InteractionModel* interactionModel : layer->getInteractionModels()) {
             LogDebug(MESSAGECATEGORY) << "   interact with " << *interactionModel;
-            std::vector<std::unique_ptr<fastsim::Particle> > secondaries;
+            secondaries.clear();
             interactionModel->interact(*particle, *layer, secondaries, *_randomEngine);
             nSecondaries += secondaries.size();
             particleManager.addSecondaries(particle->position(), particle->simTrackIndex(), secondaries, layer);
@@ -283,7 +286,7 @@ void FastSimProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
       // do decays
       if (!particle->isStable() && particle->remainingProperLifeTimeC() < 1E-10) {
         LogDebug(MESSAGECATEGORY) << "Decaying particle...";
-        std::vector<std::unique_ptr<fastsim::Particle> > secondaries;
+        secondaries.clear();
         decayer_.decay(*particle, secondaries, _randomEngine->theEngine());
         LogDebug(MESSAGECATEGORY) << "   decay has " << secondaries.size() << " products";
         particleManager.addSecondaries(particle->position(), particle->simTrackIndex(), secondaries);
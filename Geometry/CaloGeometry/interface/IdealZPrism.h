@@ -59,8 +59,8 @@ public:
 
   // corrected geom for PF
   std::shared_ptr<const IdealZPrism> forPF() const {
-    static const auto do_not_delete = [](const void*) {};
-    auto cell = std::shared_ptr<const IdealZPrism>(m_geoForPF.get(), do_not_delete);
+    // non-owning, without a control block
+    auto cell = std::shared_ptr<const IdealZPrism>(std::shared_ptr<void>(), m_geoForPF.get());
     return cell;
   }
 
@@ -258,8 +258,8 @@ unsigned int CaloSubdetectorGeometry::sizeForDenseIndex(const DetId& id) const {
 }
 
 std::shared_ptr<const CaloCellGeometry> CaloSubdetectorGeometry::cellGeomPtr(uint32_t index) const {
-  // Default version
+  // Default version: the cells are owned by the geometry, the aliasing constructor with an empty owner
+  // makes a non-owning shared_ptr without allocating a control block
   auto ptr = getGeometryRawPtr(index);
-  static const auto do_not_delete = [](const void*) {};
-  return ptr == nullptr ? nullptr : std::shared_ptr<const CaloCellGeometry>(ptr, do_not_delete);
+  return ptr == nullptr ? nullptr : std::shared_ptr<const CaloCellGeometry>(std::shared_ptr<void>(), ptr);
 }
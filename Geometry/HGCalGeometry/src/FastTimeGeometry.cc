@@ -164,8 +164,8 @@ const CaloCellGeometry* FastTimeGeometry::getGeometryRawPtr(uint32_t index) cons
 std::shared_ptr<const CaloCellGeometry> FastTimeGeometry::cellGeomPtr(uint32_t index) const {
   if ((index >= m_cellVec.size()) || (m_validGeomIds[index].rawId() == 0))
     return nullptr;
-  static const auto do_not_delete = [](const void*) {};
-  auto cell = std::shared_ptr<const CaloCellGeometry>(&m_cellVec[index], do_not_delete);
+  // non-owning, without a control block
+  auto cell = std::shared_ptr<const CaloCellGeometry>(std::shared_ptr<void>(), &m_cellVec[index]);
   if (nullptr == cell->param())
     return nullptr;
   return cell;
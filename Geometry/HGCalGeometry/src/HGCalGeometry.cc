@@ -542,14 +542,14 @@ std::shared_ptr<const CaloCellGeometry> HGCalGeometry::cellGeomPtr(uint32_t inde
   if ((index >= m_cellVec.size() && m_det != DetId::HGCalHSc) ||
       (index >= m_cellVec2.size() && m_det == DetId::HGCalHSc) || (m_validGeomIds[index].rawId() == 0))
     return nullptr;
-  static const auto do_not_delete = [](const void*) {};
+  // non-owning, without a control block
   if (m_det == DetId::HGCalHSc) {
-    auto cell = std::shared_ptr<const CaloCellGeometry>(&m_cellVec2[index], do_not_delete);
+    auto cell = std::shared_ptr<const CaloCellGeometry>(std::shared_ptr<void>(), &m_cellVec2[index]);
     if (nullptr == cell->param())
       return nullptr;
     return cell;
   } else {
-    auto cell = std::shared_ptr<const CaloCellGeometry>(&m_cellVec[index], do_not_delete);
+    auto cell = std::shared_ptr<const CaloCellGeometry>(std::shared_ptr<void>(), &m_cellVec[index]);
     if (nullptr == cell->param())
       return nullptr;
     return cell;
@@ -64,6 +64,26 @@ namespace phase1PixelTopology {
     return py + shift;
   }
 
+  // the modules in the order of the TrackerGeometry: the 4 barrel layers, then the 3 disks
+  // at negative z, whose DetIds are the smallest, and the 3 disks at positive z
+  constexpr uint32_t numberOfModules = 1856;
+  constexpr uint32_t numberOfLayers = 10;
+  constexpr uint32_t numberOfModulesInBarrel = 1184;
+  constexpr uint32_t numberOfBarrelLayers = 4;
+
+  // the index of the first module of a layer, numberOfModules for numberOfLayers
+  constexpr inline uint32_t layerStart(uint32_t layer) {
+    constexpr uint32_t start[numberOfLayers + 1] = {0, 96, 320, 672, 1184, 1296, 1408, 1520, 1632, 1744, 1856};
+    return start[layer];
+  }
+
+  constexpr inline uint32_t findLayer(uint32_t module) {
+    uint32_t layer = 0;
+    while (layer + 1 < numberOfLayers && module >= layerStart(layer + 1))
+      ++layer;
+    return layer;
+  }
+
 }  // namespace phase1PixelTopology
 
 #endif  // Geometry_TrackerGeometryBuilder_phase1PixelTopology_h
@@ -95,6 +95,9 @@ public:
     return std::unique_ptr<GlobalInputTags>(new GlobalInputTags());
   };
 
+  template <typename C>
+  void registerCollection(edm::GetterOfProducts<C>&, edm::BranchDescription const&);
+
   template <typename C>
   void fillTriggerObjectCollections(const edm::Event&, edm::GetterOfProducts<C>&);
 
@@ -156,6 +159,8 @@ private:
   /// list of L3 collection tags
   InputTagSet collectionTagsEvent_;
   InputTagSet collectionTagsStream_;
+  /// InputTags of the collections matched by the getters, by token index
+  std::vector<edm::InputTag> tokenTags_;
 
   /// trigger object collection
   trigger::TriggerObjectCollection toc_;
@@ -159,32 +159,47 @@ TriggerSummaryProducerAOD::TriggerSummaryProducerAOD(const edm::ParameterSet& ps
 
   callWhenNewProductsRegistered([this](edm::BranchDescription const& bd) {
     getTriggerFilterObjectWithRefs_(bd);
-    getRecoEcalCandidateCollection_(bd);
-    getElectronCollection_(bd);
-    getRecoChargedCandidateCollection_(bd);
-    getCaloJetCollection_(bd);
-    getCompositeCandidateCollection_(bd);
-    getMETCollection_(bd);
-    getCaloMETCollection_(bd);
-    getIsolatedPixelTrackCandidateCollection_(bd);
-    getL1EmParticleCollection_(bd);
-    getL1MuonParticleCollection_(bd);
-    getL1JetParticleCollection_(bd);
-    getL1EtMissParticleCollection_(bd);
-    getL1HFRingsCollection_(bd);
-    getL1TMuonParticleCollection_(bd);
-    getL1TEGammaParticleCollection_(bd);
-    getL1TJetParticleCollection_(bd);
-    getL1TTauParticleCollection_(bd);
-    getL1TEtSumParticleCollection_(bd);
-    getPFJetCollection_(bd);
-    getPFTauCollection_(bd);
-    getPFMETCollection_(bd);
+    registerCollection(getRecoEcalCandidateCollection_, bd);
+    registerCollection(getElectronCollection_, bd);
+    registerCollection(getRecoChargedCandidateCollection_, bd);
+    registerCollection(getCaloJetCollection_, bd);
+    registerCollection(getCompositeCandidateCollection_, bd);
+    registerCollection(getMETCollection_, bd);
+    registerCollection(getCaloMETCollection_, bd);
+    registerCollection(getIsolatedPixelTrackCandidateCollection_, bd);
+    registerCollection(getL1EmParticleCollection_, bd);
+    registerCollection(getL1MuonParticleCollection_, bd);
+    registerCollection(getL1JetParticleCollection_, bd);
+    registerCollection(getL1EtMissParticleCollection_, bd);
+    registerCollection(getL1HFRingsCollection_, bd);
+    registerCollection(getL1TMuonParticleCollection_, bd);
+    registerCollection(getL1TEGammaParticleCollection_, bd);
+    registerCollection(getL1TJetParticleCollection_, bd);
+    registerCollection(getL1TTauParticleCollection_, bd);
+    registerCollection(getL1TEtSumParticleCollection_, bd);
+    registerCollection(getPFJetCollection_, bd);
+    registerCollection(getPFTauCollection_, bd);
+    registerCollection(getPFMETCollection_, bd);
   });
 }
 
 TriggerSummaryProducerAOD::~TriggerSummaryProducerAOD() = default;
 
+template <typename C>
+void TriggerSummaryProducerAOD::registerCollection(edm::GetterOfProducts<C>& getter, edm::BranchDescription const& bd) {
+  /// record the InputTag of each collection the getter will get, by the index of its token,
+  /// so that only the collections referenced by the L3 filters are gotten in each event
+  const auto n(getter.tokens().size());
+  getter(bd);
+  if (getter.tokens().size() > n) {
+    const unsigned int index(getter.tokens().back().index());
+    if (index >= tokenTags_.size()) {
+      tokenTags_.resize(index + 1);
+    }
+    tokenTags_[index] = edm::InputTag(bd.moduleLabel(), bd.productInstanceName(), bd.processName());
+  }
+}
+
 //
 // member functions
 //
@@ -402,32 +417,29 @@ void TriggerSummaryProducerAOD::fillTriggerObjectCollections(const edm::Event& i
   using namespace trigger;
   using namespace l1t;
 
-  vector<Handle<C>> collections;
-  getter.fillHandles(iEvent, collections);
-  const unsigned int nc(collections.size());
-
-  for (unsigned int ic = 0; ic != nc; ++ic) {
-    const Provenance& provenance(*(collections[ic].provenance()));
-    const string& label(provenance.moduleLabel());
-    const string& instance(provenance.productInstanceName());
-    const string& process(provenance.processName());
-    const InputTag collectionTag(label, instance, process);
+  Handle<C> collection;
+  for (auto const& token : getter.tokens()) {
+    const InputTag& collectionTag(tokenTags_[token.index()]);
 
     if (collectionTagsEvent_.find(collectionTag) != collectionTagsEvent_.end()) {
-      const ProductID pid(collections[ic].provenance()->productID());
+      iEvent.getByToken(token, collection);
+      if (!collection.isValid()) {
+        continue;
+      }
+      const ProductID pid(collection.id());
       if (offset_.find(pid) != offset_.end()) {
         LogError("TriggerSummaryProducerAOD") << "Duplicate pid: " << pid;
       }
       offset_[pid] = toc_.size();
-      const unsigned int n(collections[ic]->size());
+      const unsigned int n(collection->size());
       for (unsigned int i = 0; i != n; ++i) {
-        fillTriggerObject((*collections[ic])[i]);
+        fillTriggerObject((*collection)[i]);
       }
       tags_.push_back(collectionTag.encode());
       keys_.push_back(toc_.size());
     }
 
-  }  /// end loop over handles
+  }  /// end loop over tokens
 }
 
 template <typename T>
@@ -1,4 +1,5 @@
 // C++ headers
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -28,10 +29,11 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/StreamID.h"
+#include "FWCore/Utilities/interface/memory_usage.h"
 #include "FastTimerService.h"
 
 // local headers
-#include "memory_usage.h"
+#include "perf_counters.h"
 #include "processor_model.h"
 
 using namespace std::literals;
@@ -40,6 +42,11 @@ using namespace std::literals;
 
 namespace {
 
+  // names and titles of the hardware performance counters, in the order of perf_counters::counter
+  const char* const counter_names[perf_counters::size] = {"instructions", "cycles", "llc_misses", "branch_misses"};
+  const char* const counter_titles[perf_counters::size] = {
+      "instructions", "cycles", "last level cache misses", "branch misses"};
+
   // convert any std::chrono::duration to milliseconds
   template <class Rep, class Period>
   double ms(std::chrono::duration<Rep, Period> duration) {
@@ -68,13 +75,15 @@ FastTimerService::Resources::Resources()
     : time_thread(boost::chrono::nanoseconds::zero()),
       time_real(boost::chrono::nanoseconds::zero()),
       allocated(0ul),
-      deallocated(0ul) {}
+      deallocated(0ul),
+      counters{} {}
 
 void FastTimerService::Resources::reset() {
   time_thread = boost::chrono::nanoseconds::zero();
   time_real = boost::chrono::nanoseconds::zero();
   allocated = 0ul;
   deallocated = 0ul;
+  counters.fill(0ul);
 }
 
 FastTimerService::Resources& FastTimerService::Resources::operator+=(Resources const& other) {
@@ -82,6 +91,8 @@ FastTimerService::Resources& FastTimerService::Resources::operator+=(Resources c
   time_real += other.time_real;
   allocated += other.allocated;
   deallocated += other.deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] += other.counters[i];
   return *this;
 }
 
@@ -97,19 +108,27 @@ FastTimerService::Resources FastTimerService::Resources::operator+(Resources con
 // of results should yield the correct result.
 
 FastTimerService::AtomicResources::AtomicResources()
-    : time_thread(0ul), time_real(0ul), allocated(0ul), deallocated(0ul) {}
+    : time_thread(0ul), time_real(0ul), allocated(0ul), deallocated(0ul) {
+  for (auto& counter : counters)
+    counter = 0ul;
+}
 
 FastTimerService::AtomicResources::AtomicResources(AtomicResources const& other)
     : time_thread(other.time_thread.load()),
       time_real(other.time_real.load()),
       allocated(other.allocated.load()),
-      deallocated(other.deallocated.load()) {}
+      deallocated(other.deallocated.load()) {
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] = other.counters[i].load();
+}
 
 void FastTimerService::AtomicResources::reset() {
   time_thread = 0ul;
   time_real = 0ul;
   allocated = 0ul;
   deallocated = 0ul;
+  for (auto& counter : counters)
+    counter = 0ul;
 }
 
 FastTimerService::AtomicResources& FastTimerService::AtomicResources::operator=(AtomicResources const& other) {
@@ -117,6 +136,8 @@ FastTimerService::AtomicResources& FastTimerService::AtomicResources::operator=(
   time_real = other.time_real.load();
   allocated = other.allocated.load();
   deallocated = other.deallocated.load();
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] = other.counters[i].load();
   return *this;
 }
 
@@ -125,6 +146,8 @@ FastTimerService::AtomicResources& FastTimerService::AtomicResources::operator+=
   time_real += other.time_real.load();
   allocated += other.allocated.load();
   deallocated += other.deallocated.load();
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] += other.counters[i].load();
   return *this;
 }
 
@@ -165,6 +188,7 @@ void FastTimerService::ResourcesPerPath::reset() {
   total.reset();
   last = 0;
   status = false;
+  std::fill(visits.begin(), visits.end(), 0);
 }
 
 FastTimerService::ResourcesPerPath& FastTimerService::ResourcesPerPath::operator+=(ResourcesPerPath const& other) {
@@ -172,6 +196,10 @@ FastTimerService::ResourcesPerPath& FastTimerService::ResourcesPerPath::operator
   total += other.total;
   last = 0;  // summing these makes no sense, reset them instead
   status = false;
+  if (visits.size() < other.visits.size())
+    visits.resize(other.visits.size(), 0);
+  for (unsigned int i = 0; i < other.visits.size(); ++i)
+    visits[i] += other.visits[i];
   return *this;
 }
 
@@ -273,6 +301,7 @@ void FastTimerService::Measurement::measure() noexcept {
   time_real = boost::chrono::high_resolution_clock::now();
   allocated = memory_usage::allocated();
   deallocated = memory_usage::deallocated();
+  perf_counters::read(counters);
 }
 
 void FastTimerService::Measurement::measure_and_store(Resources& store) noexcept {
@@ -283,14 +312,19 @@ void FastTimerService::Measurement::measure_and_store(Resources& store) noexcept
   auto new_time_real = boost::chrono::high_resolution_clock::now();
   auto new_allocated = memory_usage::allocated();
   auto new_deallocated = memory_usage::deallocated();
+  perf_counters::values new_counters;
+  perf_counters::read(new_counters);
   store.time_thread = new_time_thread - time_thread;
   store.time_real = new_time_real - time_real;
   store.allocated = new_allocated - allocated;
   store.deallocated = new_deallocated - deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    store.counters[i] = new_counters[i] - counters[i];
   time_thread = new_time_thread;
   time_real = new_time_real;
   allocated = new_allocated;
   deallocated = new_deallocated;
+  counters = new_counters;
 }
 
 void FastTimerService::Measurement::measure_and_accumulate(Resources& store) noexcept {
@@ -301,14 +335,19 @@ void FastTimerService::Measurement::measure_and_accumulate(Resources& store) noe
   auto new_time_real = boost::chrono::high_resolution_clock::now();
   auto new_allocated = memory_usage::allocated();
   auto new_deallocated = memory_usage::deallocated();
+  perf_counters::values new_counters;
+  perf_counters::read(new_counters);
   store.time_thread += new_time_thread - time_thread;
   store.time_real += new_time_real - time_real;
   store.allocated += new_allocated - allocated;
   store.deallocated += new_deallocated - deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    store.counters[i] += new_counters[i] - counters[i];
   time_thread = new_time_thread;
   time_real = new_time_real;
   allocated = new_allocated;
   deallocated = new_deallocated;
+  counters = new_counters;
 }
 
 void FastTimerService::Measurement::measure_and_accumulate(AtomicResources& store) noexcept {
@@ -319,14 +358,19 @@ void FastTimerService::Measurement::measure_and_accumulate(AtomicResources& stor
   auto new_time_real = boost::chrono::high_resolution_clock::now();
   auto new_allocated = memory_usage::allocated();
   auto new_deallocated = memory_usage::deallocated();
+  perf_counters::values new_counters;
+  perf_counters::read(new_counters);
   store.time_thread += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_thread - time_thread).count();
   store.time_real += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_real - time_real).count();
   store.allocated += new_allocated - allocated;
   store.deallocated += new_deallocated - deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    store.counters[i] += new_counters[i] - counters[i];
   time_thread = new_time_thread;
   time_real = new_time_real;
   allocated = new_allocated;
   deallocated = new_deallocated;
+  counters = new_counters;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -414,6 +458,22 @@ void FastTimerService::PlotsPerElement::book(dqm::reco::DQMStore::IBooker& booke
     deallocated_byls_->setXTitle("lumisection");
     deallocated_byls_->setYTitle("memory [kB]");
   }
+
+  if (perf_counters::is_available()) {
+    for (unsigned int i = 0; i < perf_counters::size; ++i) {
+      counters_byls_[i] = booker.bookProfile(name + " " + counter_names[i] + "_byls",
+                                             title + " " + counter_titles[i] + " vs. lumisection",
+                                             lumisections,
+                                             0.5,
+                                             lumisections + 0.5,
+                                             1,
+                                             0.,
+                                             std::numeric_limits<double>::infinity(),
+                                             " ");
+      counters_byls_[i]->setXTitle("lumisection");
+      counters_byls_[i]->setYTitle(counter_titles[i]);
+    }
+  }
 }
 
 void FastTimerService::PlotsPerElement::fill(Resources const& data, unsigned int lumisection) {
@@ -443,6 +503,10 @@ void FastTimerService::PlotsPerElement::fill(Resources const& data, unsigned int
 
   if (deallocated_byls_)
     deallocated_byls_->Fill(lumisection, kB(data.deallocated));
+
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    if (counters_byls_[i])
+      counters_byls_[i]->Fill(lumisection, data.counters[i]);
 }
 
 void FastTimerService::PlotsPerElement::fill(AtomicResources const& data, unsigned int lumisection) {
@@ -472,6 +536,10 @@ void FastTimerService::PlotsPerElement::fill(AtomicResources const& data, unsign
 
   if (deallocated_byls_)
     deallocated_byls_->Fill(lumisection, kB(data.deallocated));
+
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    if (counters_byls_[i])
+      counters_byls_[i]->Fill(lumisection, data.counters[i].load());
 }
 
 void FastTimerService::PlotsPerElement::fill_fraction(Resources const& data,
@@ -514,6 +582,13 @@ void FastTimerService::PlotsPerElement::fill_fraction(Resources const& data,
 
   if (deallocated_byls_)
     deallocated_byls_->Fill(lumisection, total, fraction);
+
+  for (unsigned int i = 0; i < perf_counters::size; ++i) {
+    total = data.counters[i];
+    fraction = (total > 0.) ? (part.counters[i] / total) : 0.;
+    if (counters_byls_[i])
+      counters_byls_[i]->Fill(lumisection, total, fraction);
+  }
 }
 
 void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::IBooker& booker,
@@ -546,6 +621,16 @@ void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::IBooker& booker,
         booker.book1DD("module_deallocated_total", "total deallocated memory", bins, -0.5, bins - 0.5);
     module_deallocated_total_->setYTitle("memory [kB]");
   }
+  if (perf_counters::is_available()) {
+    for (unsigned int i = 0; i < perf_counters::size; ++i) {
+      module_counters_total_[i] = booker.book1DD(std::string("module_") + counter_names[i] + "_total",
+                                                 std::string("total ") + counter_titles[i],
+                                                 bins,
+                                                 -0.5,
+                                                 bins - 0.5);
+      module_counters_total_[i]->setYTitle(counter_titles[i]);
+    }
+  }
   for (unsigned int bin : boost::irange(0u, bins)) {
     auto const& module = job[path.modules_and_dependencies_[bin]];
     std::string const& label =
@@ -557,6 +642,10 @@ void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::IBooker& booker,
       module_allocated_total_->setBinLabel(bin + 1, label);
       module_deallocated_total_->setBinLabel(bin + 1, label);
     }
+    if (perf_counters::is_available()) {
+      for (auto counter : module_counters_total_)
+        counter->setBinLabel(bin + 1, label);
+    }
   }
   module_counter_->setBinLabel(bins + 1, "");
 
@@ -587,6 +676,10 @@ void FastTimerService::PlotsPerPath::fill(ProcessCallGraph::PathType const& desc
 
     if (module_deallocated_total_)
       module_deallocated_total_->Fill(i, kB(module.total.deallocated));
+
+    for (unsigned int c = 0; c < perf_counters::size; ++c)
+      if (module_counters_total_[c])
+        module_counters_total_[c]->Fill(i, module.total.counters[c]);
   }
   if (module_counter_ and path.status)
     module_counter_->Fill(path.last);
@@ -731,6 +824,7 @@ FastTimerService::FastTimerService(const edm::ParameterSet& config, edm::Activit
       print_event_summary_(config.getUntrackedParameter<bool>("printEventSummary")),
       print_run_summary_(config.getUntrackedParameter<bool>("printRunSummary")),
       print_job_summary_(config.getUntrackedParameter<bool>("printJobSummary")),
+      print_filter_summary_(config.getUntrackedParameter<bool>("printFilterSummary")),
       // dqm configuration
       enable_dqm_(config.getUntrackedParameter<bool>("enableDQM")),
       enable_dqm_bymodule_(config.getUntrackedParameter<bool>("enableDQMbyModule")),
@@ -756,6 +850,11 @@ FastTimerService::FastTimerService(const edm::ParameterSet& config, edm::Activit
       highlight_module_psets_(config.getUntrackedParameter<std::vector<edm::ParameterSet>>("highlightModules")),
       highlight_modules_(highlight_module_psets_.size())  // filled in postBeginJob()
 {
+  // enable the hardware performance counters before any thread takes its first measurement
+  if (config.getUntrackedParameter<bool>("enablePerfCounters") and not perf_counters::enable())
+    edm::LogWarning("FastTimerService")
+        << "The hardware performance counters are not available, check /proc/sys/kernel/perf_event_paranoid";
+
   // start observing when a thread enters or leaves the TBB global thread arena
   tbb::task_scheduler_observer::observe();
 
@@ -1247,6 +1346,111 @@ void FastTimerService::printSummary(T& out, ResourcesPerJob const& data, std::st
     printSummaryLine(out, data.highlight[group], data.events, highlight_modules_[group].label);
     out << '\n';
   }
+  if (perf_counters::is_available())
+    printCountersSummary(out, data);
+  if (print_filter_summary_)
+    printFilterSummary(out, data);
+}
+
+template <typename T>
+void FastTimerService::printCountersHeader(T& out, std::string const& label) const {
+  out << "FastReport  Instructions avg.     Cycles avg.     IPC  LLC misses avg.     MPKI  Br. misses avg.  " << label
+      << '\n';
+  //      FastReport  ################  ##############  ##.##  ###############  ####.##  ###############  ...
+}
+
+// the average counts per event, the instructions per cycle and the last level cache misses per 1000 instructions
+template <typename T>
+void FastTimerService::printCountersLine(
+    T& out, Resources const& data, uint64_t events, std::string const& label) const {
+  auto const& counters = data.counters;
+  double instructions = counters[perf_counters::instructions];
+  double cycles = counters[perf_counters::cycles];
+  out << boost::format("FastReport  %16.0f  %14.0f  %5.2f  %15.0f  %7.2f  %15.0f  %s\n") %
+             (events ? instructions / events : 0.) % (events ? cycles / events : 0.) %
+             (cycles > 0. ? instructions / cycles : 0.) %
+             (events ? double(counters[perf_counters::llc_misses]) / events : 0.) %
+             (instructions > 0. ? 1000. * counters[perf_counters::llc_misses] / instructions : 0.) %
+             (events ? double(counters[perf_counters::branch_misses]) / events : 0.) % label;
+}
+
+template <typename T>
+void FastTimerService::printCountersSummary(T& out, ResourcesPerJob const& data) const {
+  printCountersHeader(out, "Modules");
+  for (unsigned int i = 0; i < callgraph_.processes().size(); ++i) {
+    auto const& proc_d = callgraph_.processDescription(i);
+    auto const& proc = data.processes[i];
+    printCountersLine(out, proc.total, data.events, "process " + proc_d.name_);
+    for (unsigned int m : proc_d.modules_) {
+      auto const& module_d = callgraph_.module(m);
+      auto const& module = data.modules[m];
+      printCountersLine(out, module.total, data.events, "  " + module_d.moduleLabel());
+    }
+  }
+  printCountersLine(out, data.total, data.events, "total");
+  out << '\n';
+  printCountersHeader(out, "Paths, including dependencies");
+  for (unsigned int i = 0; i < callgraph_.processes().size(); ++i) {
+    auto const& proc_d = callgraph_.processDescription(i);
+    auto const& proc = data.processes[i];
+    printCountersLine(out, proc.total, data.events, "process " + proc_d.name_);
+    for (unsigned int p = 0; p < proc.paths.size(); ++p)
+      printCountersLine(out, proc.paths[p].total, data.events, "  " + proc_d.paths_[p].name_);
+    for (unsigned int p = 0; p < proc.endpaths.size(); ++p)
+      printCountersLine(out, proc.endpaths[p].total, data.events, "  " + proc_d.endPaths_[p].name_);
+  }
+  out << '\n';
+}
+
+// the acceptance and the real time of each module on each path, and the modules which reject events ordered by
+// their real time per rejected event: running those with the lowest rank first minimises the expected time of the
+// path, if they are independent of each other; a module on several paths only runs once per event
+template <typename T>
+void FastTimerService::printFilterSummary(T& out, ResourcesPerJob const& data) const {
+  for (unsigned int i = 0; i < callgraph_.processes().size(); ++i) {
+    auto const& proc_d = callgraph_.processDescription(i);
+    auto const& proc = data.processes[i];
+
+    // the number of paths each module is on
+    std::unordered_map<unsigned int, unsigned int> paths_per_module;
+    for (auto const& path_d : proc_d.paths_)
+      for (unsigned int m : path_d.modules_on_path_)
+        ++paths_per_module[m];
+
+    for (unsigned int p = 0; p < proc.paths.size(); ++p) {
+      auto const& path_d = proc_d.paths_[p];
+      auto const& visits = proc.paths[p].visits;
+      if (visits.size() != path_d.modules_on_path_.size() + 1 or visits[0] == 0)
+        continue;
+
+      out << "FastReport  Real time avg.      Events  Accepted  Paths        Rank  " << path_d.name_ << '\n';
+      std::vector<std::pair<double, std::string>> ranks;
+      for (unsigned int m = 0; m < path_d.modules_on_path_.size(); ++m) {
+        unsigned int id = path_d.modules_on_path_[m];
+        auto const& module_d = callgraph_.module(id);
+        auto const& module = data.modules[id];
+        double time = module.events ? ms(module.total.time_real) / module.events : 0.;
+        double accept = visits[m] ? double(visits[m + 1]) / visits[m] : 0.;
+        if (accept < 1.) {
+          double rank = time / (1. - accept);
+          ranks.emplace_back(rank, module_d.moduleLabel());
+          out << boost::format("FastReport  %10.1f ms  %10d  %7.1f%%  %5d  %7.2f ms  %s\n") % time % visits[m] %
+                     (100. * accept) % paths_per_module[id] % rank % ("  " + module_d.moduleLabel());
+        } else {
+          out << boost::format("FastReport  %10.1f ms  %10d  %7.1f%%  %5d              %s\n") % time % visits[m] %
+                     (100. * accept) % paths_per_module[id] % ("  " + module_d.moduleLabel());
+        }
+      }
+      if (not std::is_sorted(ranks.begin(), ranks.end())) {
+        std::stable_sort(ranks.begin(), ranks.end());
+        out << "FastReport  lowest rank first:";
+        for (auto const& rank : ranks)
+          out << ' ' << rank.second;
+        out << '\n';
+      }
+      out << '\n';
+    }
+  }
 }
 
 template <typename T>
@@ -1373,6 +1577,15 @@ void FastTimerService::postPathEvent(edm::StreamContext const& sc,
     auto const& module = stream.modules[path.modules_and_dependencies_[i]];
     data.total += module.total;
   }
+
+  if (print_filter_summary_) {
+    unsigned int size = path.modules_on_path_.size();
+    data.visits.resize(size + 1, 0);
+    for (unsigned int i = 0; i < index; ++i)
+      ++data.visits[i];
+    if (status.accept())
+      ++data.visits[size];
+  }
 }
 
 void FastTimerService::preModuleEventAcquire(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc) {
@@ -1527,6 +1740,8 @@ void FastTimerService::fillDescriptions(edm::ConfigurationDescriptions& descript
   desc.addUntracked<bool>("printEventSummary", false);
   desc.addUntracked<bool>("printRunSummary", true);
   desc.addUntracked<bool>("printJobSummary", true);
+  desc.addUntracked<bool>("printFilterSummary", false);
+  desc.addUntracked<bool>("enablePerfCounters", false);
   desc.addUntracked<bool>("enableDQM", true);
   desc.addUntracked<bool>("enableDQMbyModule", false);
   desc.addUntracked<bool>("enableDQMbyPath", false);
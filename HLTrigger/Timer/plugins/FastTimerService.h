@@ -5,6 +5,7 @@
 #include <unistd.h>
 
 // C++ headers
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <map>
@@ -40,6 +41,9 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "HLTrigger/Timer/interface/ProcessCallGraph.h"
 
+// local headers
+#include "perf_counters.h"
+
 /*
 procesing time is divided into
  - source
@@ -200,6 +204,7 @@ private:
     boost::chrono::high_resolution_clock::time_point time_real;
     uint64_t allocated;
     uint64_t deallocated;
+    perf_counters::values counters;
   };
 
   // highlight a group of modules
@@ -222,6 +227,7 @@ private:
     boost::chrono::nanoseconds time_real;
     uint64_t allocated;
     uint64_t deallocated;
+    perf_counters::values counters;  // hardware performance counters, if enabled
   };
 
   // atomic version of Resources
@@ -240,6 +246,7 @@ private:
     std::atomic<boost::chrono::nanoseconds::rep> time_real;
     std::atomic<uint64_t> allocated;
     std::atomic<uint64_t> deallocated;
+    std::array<std::atomic<uint64_t>, perf_counters::size> counters;
   };
 
   struct ResourcesPerModule {
@@ -266,6 +273,8 @@ private:
     Resources total;   // resources used by all modules on this path, and their dependencies
     unsigned last;     // one-past-the last module that ran on this path
     bool status;       // whether the path accepted or rejected the event
+    std::vector<uint64_t> visits;  // events reaching each module on this path, then those accepted by the path;
+                                   // only filled for the filter summary
   };
 
   struct ResourcesPerProcess {
@@ -332,6 +341,8 @@ private:
     dqm::reco::MonitorElement* allocated_byls_;    // TProfile
     dqm::reco::MonitorElement* deallocated_;       // TH1F
     dqm::reco::MonitorElement* deallocated_byls_;  // TProfile
+    // hardware performance counters
+    std::array<dqm::reco::MonitorElement*, perf_counters::size> counters_byls_;  // TProfile
   };
 
   // plots associated to each path or endpath
@@ -366,6 +377,7 @@ private:
     dqm::reco::MonitorElement* module_time_real_total_;    // TH1D
     dqm::reco::MonitorElement* module_allocated_total_;    // TH1D
     dqm::reco::MonitorElement* module_deallocated_total_;  // TH1D
+    std::array<dqm::reco::MonitorElement*, perf_counters::size> module_counters_total_;  // TH1D
   };
 
   class PlotsPerProcess {
@@ -464,6 +476,7 @@ private:
   const bool print_event_summary_;  // print the time spent in each process, path and module after every event
   const bool print_run_summary_;    // print the time spent in each process, path and module for each run
   const bool print_job_summary_;    // print the time spent in each process, path and module for the whole job
+  const bool print_filter_summary_;  // print the acceptance and cost of each module on each path in the summaries
 
   // dqm configuration
   bool enable_dqm_;  // non const, depends on the availability of the DQMStore
@@ -520,6 +533,18 @@ private:
   template <typename T>
   void printSummary(T& out, ResourcesPerJob const& data, std::string const& label) const;
 
+  template <typename T>
+  void printFilterSummary(T& out, ResourcesPerJob const& data) const;
+
+  template <typename T>
+  void printCountersHeader(T& out, std::string const& label) const;
+
+  template <typename T>
+  void printCountersLine(T& out, Resources const& data, uint64_t events, std::string const& label) const;
+
+  template <typename T>
+  void printCountersSummary(T& out, ResourcesPerJob const& data) const;
+
   template <typename T>
   void printTransition(T& out, AtomicResources const& data, std::string const& label) const;
 
@@ -19,31 +19,42 @@ void ThroughputService::fillDescriptions(edm::ConfigurationDescriptions& descrip
   desc.addUntracked<double>("timeResolution", 10.0);
   desc.addUntracked<std::string>("dqmPath", "HLT/Throughput");
   desc.addUntracked<bool>("dqmPathByProcesses", false);
+  desc.addUntracked<bool>("printJobSummary", false)
+      ->setComment(
+          "print the number of events, the streams and threads, and the average throughput at the end of the job");
   descriptions.add("ThroughputService", desc);
 }
 
 ThroughputService::ThroughputService(const edm::ParameterSet& config, edm::ActivityRegistry& registry)
     :  // startup time
       m_startup(std::chrono::steady_clock::now()),
+      m_events(0),
+      m_last_retired(0),
+      m_concurrent_streams(0),
+      m_concurrent_threads(0),
       // configuration
       m_time_range(config.getUntrackedParameter<double>("timeRange")),
       m_time_resolution(config.getUntrackedParameter<double>("timeResolution")),
       m_dqm_path(config.getUntrackedParameter<std::string>("dqmPath")),
-      m_dqm_bynproc(config.getUntrackedParameter<bool>("dqmPathByProcesses")) {
+      m_dqm_bynproc(config.getUntrackedParameter<bool>("dqmPathByProcesses")),
+      m_print_job_summary(config.getUntrackedParameter<bool>("printJobSummary")) {
+  registry.watchPreallocate(this, &ThroughputService::preallocate);
   registry.watchPreGlobalBeginRun(this, &ThroughputService::preGlobalBeginRun);
   registry.watchPreSourceEvent(this, &ThroughputService::preSourceEvent);
   registry.watchPostEvent(this, &ThroughputService::postEvent);
+  if (m_print_job_summary)
+    registry.watchPostEndJob(this, &ThroughputService::postEndJob);
 }
 
 ThroughputService::~ThroughputService() = default;
 
 void ThroughputService::preallocate(edm::service::SystemBounds const& bounds) {
-  auto concurrent_streams = bounds.maxNumberOfStreams();
-  auto concurrent_threads = bounds.maxNumberOfThreads();
+  m_concurrent_streams = bounds.maxNumberOfStreams();
+  m_concurrent_threads = bounds.maxNumberOfThreads();
 
   if (m_dqm_bynproc)
     m_dqm_path += (boost::format("/Running on %s with %d streams on %d threads") % processor_model %
-                   concurrent_streams % concurrent_threads)
+                   m_concurrent_streams % m_concurrent_threads)
                       .str();
 }
 
@@ -75,12 +86,36 @@ void ThroughputService::preGlobalBeginRun(edm::GlobalContext const& gc) {
 
 void ThroughputService::preSourceEvent(edm::StreamID sid) {
   auto timestamp = std::chrono::steady_clock::now();
+  // the source is not run concurrently, and the job summary is only read at the end of the job
+  if (m_first_sourced == std::chrono::steady_clock::time_point())
+    m_first_sourced = timestamp;
   m_sourced_events->Fill(std::chrono::duration_cast<std::chrono::duration<double>>(timestamp - m_startup).count());
 }
 
 void ThroughputService::postEvent(edm::StreamContext const& sc) {
   auto timestamp = std::chrono::steady_clock::now();
   m_retired_events->Fill(std::chrono::duration_cast<std::chrono::duration<double>>(timestamp - m_startup).count());
+
+  ++m_events;
+  auto retired = timestamp.time_since_epoch().count();
+  auto last = m_last_retired.load();
+  while (last < retired && !m_last_retired.compare_exchange_weak(last, retired)) {
+  }
+}
+
+void ThroughputService::postEndJob() {
+  // the throughput is measured from the first sourced to the last retired event, excluding the job setup
+  unsigned long events = m_events;
+  double time = 0.;
+  if (events > 0) {
+    std::chrono::steady_clock::time_point last{std::chrono::steady_clock::duration(m_last_retired.load())};
+    time = std::chrono::duration_cast<std::chrono::duration<double>>(last - m_first_sourced).count();
+  }
+  edm::LogVerbatim out("ThroughputReport");
+  out << "ThroughputReport " << events << " events processed by " << m_concurrent_streams << " streams on "
+      << m_concurrent_threads << " threads in " << time << " s";
+  if (time > 0.)
+    out << ": " << events / time << " ev/s";
 }
 
 // declare ThroughputService as a framework Service
@@ -2,6 +2,7 @@
 #define ThroughputService_h
 
 // C++ headers
+#include <atomic>
 #include <string>
 #include <chrono>
 #include <functional>
@@ -38,6 +39,7 @@ private:
   void preGlobalBeginRun(edm::GlobalContext const& gc);
   void preSourceEvent(edm::StreamID sid);
   void postEvent(edm::StreamContext const& sc);
+  void postEndJob();
 
 public:
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
@@ -48,6 +50,13 @@ private:
 
   std::chrono::steady_clock::time_point m_startup;
 
+  // job summary: number of events retired, and times of the first sourced and of the last retired event
+  std::atomic<unsigned long> m_events;
+  std::chrono::steady_clock::time_point m_first_sourced;
+  std::atomic<std::chrono::steady_clock::rep> m_last_retired;
+  unsigned int m_concurrent_streams;
+  unsigned int m_concurrent_threads;
+
   // histogram-related data members
   const double m_time_range;
   const double m_time_resolution;
@@ -55,6 +64,7 @@ private:
   // DQM service-related data members
   std::string m_dqm_path;
   const bool m_dqm_bynproc;
+  const bool m_print_job_summary;
 };
 
 #endif  // ! ThroughputService_h
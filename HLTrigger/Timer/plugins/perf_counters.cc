@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "perf_counters.h"
+
+namespace {
+  // see perf_event_open(2); PERF_COUNT_HW_CACHE_MISSES counts the misses of the last level cache on most CPUs
+  constexpr uint64_t events[perf_counters::size] = {
+      PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+  int open_event(uint64_t config, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = (group == -1);  // the group leader starts all the counters
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // the current thread, on any cpu
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+  }
+
+  // the counters of a thread, as a single group so they are read together and count over the same time;
+  // when the PMU is shared the group is multiplexed with the others, and the counts are not scaled back
+  class thread_counters {
+  public:
+    thread_counters() {
+      fds_.fill(-1);
+      for (unsigned int i = 0; i < perf_counters::size; ++i) {
+        fds_[i] = open_event(events[i], fds_[0]);
+        if (fds_[i] == -1) {
+          close();
+          return;
+        }
+      }
+      ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~thread_counters() { close(); }
+
+    bool valid() const { return fds_[0] != -1; }
+
+    void read(perf_counters::values& counts) const {
+      // PERF_FORMAT_GROUP: the number of counters, followed by their values
+      uint64_t buffer[perf_counters::size + 1];
+      if (not valid() or ::read(fds_[0], buffer, sizeof(buffer)) != sizeof(buffer)) {
+        counts.fill(0);
+        return;
+      }
+      std::copy(buffer + 1, buffer + perf_counters::size + 1, counts.begin());
+    }
+
+  private:
+    void close() {
+      for (int& fd : fds_) {
+        if (fd != -1)
+          ::close(fd);
+        fd = -1;
+      }
+    }
+
+    std::array<int, perf_counters::size> fds_;
+  };
+
+  std::atomic<bool> enabled = false;
+
+  thread_counters const& this_thread_counters() {
+    thread_local const thread_counters counters;
+    return counters;
+  }
+
+}  // namespace
+
+bool perf_counters::enable() {
+  // the counters may be disabled by /proc/sys/kernel/perf_event_paranoid, or not be supported by the (virtual) machine
+  enabled = this_thread_counters().valid();
+  return enabled;
+}
+
+bool perf_counters::is_available() { return enabled; }
+
+void perf_counters::read(values& counts) {
+  if (enabled)
+    this_thread_counters().read(counts);
+  else
+    counts.fill(0);
+}
@@ -0,0 +1,20 @@
+#ifndef perf_counters_h
+#define perf_counters_h
+
+#include <array>
+#include <cstdint>
+
+// hardware performance counters of the current thread, in user space, read through perf_event
+class perf_counters {
+public:
+  enum counter { instructions, cycles, llc_misses, branch_misses, size };
+  using values = std::array<uint64_t, size>;
+
+  // enable the counters of the threads which read them from now on; returns false if they are not supported
+  static bool enable();
+  static bool is_available();
+  // the counts of the current thread since it first read them, or zeros if they are not available
+  static void read(values& counts);
+};
+
+#endif  // perf_counters_h
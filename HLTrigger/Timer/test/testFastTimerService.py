@@ -24,6 +24,7 @@ if process.FastTimerService:
 
 process.load('HLTrigger/Timer/FastTimerService_cff')
 process.FastTimerService.printRunSummary          = True
+process.FastTimerService.printFilterSummary       = True
 process.FastTimerService.printJobSummary          = True
 process.FastTimerService.enableDQM                = True
 process.FastTimerService.enableDQMbyModule        = True
@@ -0,0 +1,25 @@
+import FWCore.ParameterSet.Config as cms
+
+# a few busy modules on two threads, measured by the FastTimerService with the hardware performance counters;
+# where the counters are not available the service only prints a warning
+process = cms.Process('TEST')
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32( 2 ),
+    numberOfStreams = cms.untracked.uint32( 0 )
+)
+
+process.source = cms.Source('EmptySource')
+process.maxEvents.input = 20
+
+process.busy1 = cms.EDProducer('BusyWaitIntProducer', ivalue = cms.int32(1), iterations = cms.uint32(1000*1000))
+process.busy2 = cms.EDProducer('BusyWaitIntProducer', ivalue = cms.int32(2), iterations = cms.uint32(2*1000*1000))
+process.path = cms.Path(process.busy1 + process.busy2)
+
+process.FastTimerService = cms.Service('FastTimerService',
+    enablePerfCounters = cms.untracked.bool( True ),
+    printEventSummary  = cms.untracked.bool( False ),
+    printRunSummary    = cms.untracked.bool( True ),
+    printJobSummary    = cms.untracked.bool( True ),
+    enableDQM          = cms.untracked.bool( False )
+)
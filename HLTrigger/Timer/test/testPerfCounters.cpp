@@ -0,0 +1,71 @@
+// The hardware performance counters of perf_counters count the work of the thread that reads them.
+// Where perf_event is not available (perf_event_paranoid, virtual machines) they must read as zeros.
+#include "HLTrigger/Timer/plugins/perf_counters.h"
+
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+namespace {
+  uint64_t busy(uint64_t iterations) {
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i)
+      sum = sum + i * i;
+    return sum;
+  }
+
+  // the counts of the current thread while running the given number of iterations
+  perf_counters::values measure(uint64_t iterations) {
+    perf_counters::values before, after, delta;
+    perf_counters::read(before);
+    busy(iterations);
+    perf_counters::read(after);
+    for (unsigned int i = 0; i < perf_counters::size; ++i)
+      delta[i] = after[i] - before[i];
+    return delta;
+  }
+}  // namespace
+
+int main() {
+  perf_counters::values counts;
+  counts.fill(1);
+  perf_counters::read(counts);
+  if (perf_counters::is_available() or counts != perf_counters::values{}) {
+    std::cout << "the counters are available or not zero before being enabled" << std::endl;
+    return 1;
+  }
+
+  if (not perf_counters::enable()) {
+    perf_counters::read(counts);
+    std::cout << "the hardware performance counters are not available, they read as zeros: "
+              << (counts == perf_counters::values{} ? "yes" : "no") << std::endl;
+    return counts == perf_counters::values{} ? 0 : 1;
+  }
+
+  int failures = 0;
+  const uint64_t iterations = 10 * 1000 * 1000;
+  auto const small = measure(iterations);
+  auto const large = measure(10 * iterations);
+  std::cout << "instructions: " << small[perf_counters::instructions] << " and " << large[perf_counters::instructions]
+            << ", cycles: " << small[perf_counters::cycles] << " and " << large[perf_counters::cycles] << std::endl;
+  // each iteration takes at least a few instructions, and ten times the work about ten times as many
+  failures += small[perf_counters::instructions] < 2 * iterations;
+  failures += small[perf_counters::cycles] == 0;
+  failures += large[perf_counters::instructions] < 5 * small[perf_counters::instructions] or
+              large[perf_counters::instructions] > 20 * small[perf_counters::instructions];
+
+  // a thread counts its own work, not the threads it waits for
+  perf_counters::values worker;
+  perf_counters::values before, after;
+  perf_counters::read(before);
+  std::thread thread([&] { worker = measure(10 * iterations); });
+  thread.join();
+  perf_counters::read(after);
+  const uint64_t waiting = after[perf_counters::instructions] - before[perf_counters::instructions];
+  std::cout << "instructions of the worker thread: " << worker[perf_counters::instructions]
+            << ", of the waiting thread: " << waiting << std::endl;
+  failures += worker[perf_counters::instructions] < 5 * small[perf_counters::instructions];
+  failures += waiting > small[perf_counters::instructions];
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+#ifndef HeterogeneousCore_CUDACore_BackendSelector_h
+#define HeterogeneousCore_CUDACore_BackendSelector_h
+
+#include "FWCore/Utilities/interface/StreamID.h"
+
+namespace edm {
+  class ParameterSet;
+  class ParameterSetDescription;
+}  // namespace edm
+
+namespace cms {
+  namespace cuda {
+    /**
+     * Chooses, for each event, whether a module having both a CPU and a
+     * CUDA implementation runs on a GPU or on the CPU. The choice is
+     * steered by the "backend" parameter of the module:
+     * - "cpu": always on the CPU
+     * - "cuda": always on a GPU, the job fails if there is none
+     * - "auto": on a GPU as long as the CUDAService is enabled and one
+     *   of the devices has less asynchronous work queued than
+     *   CUDAService.maxQueuedWorkPerDevice, otherwise on the CPU
+     *
+     * The products of the module must be the same whatever the backend,
+     * since the consumers do not know which one was used. The device
+     * returned by select() is meant to be given to the ScopedContext.
+     *
+     *   int device = backend_.select(iEvent.streamID());
+     *   if (device < 0) {
+     *     cpuAlgo_.run(...);
+     *   } else {
+     *     cms::cuda::ScopedContextAcquire ctx{device, std::move(waitingTaskHolder), ctxState_};
+     *     gpuAlgo_.run(..., ctx.stream());
+     *   }
+     *
+     * Only the work of ExternalWork modules is counted as queued work,
+     * see CUDAService::workQueued().
+     */
+    class BackendSelector {
+    public:
+      explicit BackendSelector(edm::ParameterSet const& iConfig);
+
+      static void fillPSetDescription(edm::ParameterSetDescription& iDesc);
+
+      // Returns the device to process the event on, or -1 for the CPU
+      int select(edm::StreamID id) const;
+
+    private:
+      enum class Backend { kCPU, kCUDA, kAuto };
+
+      Backend backend_;
+    };
+  }  // namespace cuda
+}  // namespace cms
+
+#endif
@@ -11,6 +11,7 @@
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "HeterogeneousCore/CUDACore/interface/ContextState.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/EventCache.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/GraphCache.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/SharedEventPtr.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/SharedStreamPtr.h"
 
@@ -34,6 +35,14 @@ namespace cms {
         cudaStream_t stream() const { return stream_.get(); }
         const SharedStreamPtr& streamPtr() const { return stream_; }
 
+        // Queue the work of func(cudaStream_t) to the CUDA stream as a
+        // graph re-used across events, see GraphCache for the
+        // restrictions on func
+        template <typename F>
+        void launchGraph(GraphCache& cache, F&& func) const {
+          cache.launch(stream(), std::forward<F>(func));
+        }
+
       protected:
         // The constructors set the current device, but the device
         // is not set back to the previous value at the destructor. This
@@ -43,6 +52,8 @@ namespace cms {
         // really matter between modules (or across TBB tasks).
         explicit ScopedContextBase(edm::StreamID streamID);
 
+        explicit ScopedContextBase(int device);
+
         explicit ScopedContextBase(const ProductBase& data);
 
         explicit ScopedContextBase(int device, SharedStreamPtr stream);
@@ -110,6 +121,16 @@ namespace cms {
                                     ContextState& state)
           : ScopedContextGetterBase(streamID), holderHelper_{std::move(waitingTaskHolder)}, contextState_{&state} {}
 
+      /// Constructor to create a new CUDA stream on a given device, e.g. chosen by a BackendSelector
+      explicit ScopedContextAcquire(int device, edm::WaitingTaskWithArenaHolder waitingTaskHolder)
+          : ScopedContextGetterBase(device), holderHelper_{std::move(waitingTaskHolder)} {}
+
+      /// Constructor to create a new CUDA stream on a given device, and the context is needed after acquire()
+      explicit ScopedContextAcquire(int device,
+                                    edm::WaitingTaskWithArenaHolder waitingTaskHolder,
+                                    ContextState& state)
+          : ScopedContextGetterBase(device), holderHelper_{std::move(waitingTaskHolder)}, contextState_{&state} {}
+
       /// Constructor to (possibly) re-use a CUDA stream (no need for context beyond acquire())
       explicit ScopedContextAcquire(const ProductBase& data, edm::WaitingTaskWithArenaHolder waitingTaskHolder)
           : ScopedContextGetterBase(data), holderHelper_{std::move(waitingTaskHolder)} {}
@@ -151,6 +172,9 @@ namespace cms {
       /// Constructor to create a new CUDA stream (non-ExternalWork module)
       explicit ScopedContextProduce(edm::StreamID streamID) : ScopedContextGetterBase(streamID) {}
 
+      /// Constructor to create a new CUDA stream on a given device (non-ExternalWork module)
+      explicit ScopedContextProduce(int device) : ScopedContextGetterBase(device) {}
+
       /// Constructor to (possibly) re-use a CUDA stream (non-ExternalWork module)
       explicit ScopedContextProduce(const ProductBase& data) : ScopedContextGetterBase(data) {}
 
@@ -0,0 +1,55 @@
+#include "HeterogeneousCore/CUDACore/interface/BackendSelector.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
+
+namespace cms::cuda {
+  BackendSelector::BackendSelector(edm::ParameterSet const& iConfig) {
+    auto const& backend = iConfig.getParameter<std::string>("backend");
+    if (backend == "cpu") {
+      backend_ = Backend::kCPU;
+    } else if (backend == "cuda") {
+      backend_ = Backend::kCUDA;
+    } else if (backend == "auto") {
+      backend_ = Backend::kAuto;
+    } else {
+      throw cms::Exception("Configuration")
+          << "BackendSelector: unknown backend '" << backend << "', allowed values are 'cpu', 'cuda' and 'auto'";
+    }
+
+    if (backend_ != Backend::kCPU) {
+      edm::Service<CUDAService> cudaService;
+      bool const enabled = cudaService.isAvailable() and cudaService->enabled();
+      if (backend_ == Backend::kCUDA and not enabled) {
+        throw cms::Exception("Configuration")
+            << "BackendSelector: the 'cuda' backend was requested, but the CUDAService is not enabled";
+      }
+      // decide once for the whole job
+      if (not enabled) {
+        backend_ = Backend::kCPU;
+      }
+    }
+  }
+
+  void BackendSelector::fillPSetDescription(edm::ParameterSetDescription& iDesc) {
+    iDesc.add<std::string>("backend", "auto")
+        ->setComment(
+            "'cpu' or 'cuda' to always run on that backend, 'auto' to run on a GPU when one is available and not "
+            "saturated, on the CPU otherwise.");
+  }
+
+  int BackendSelector::select(edm::StreamID id) const {
+    switch (backend_) {
+      case Backend::kCPU:
+        return -1;
+      case Backend::kCUDA:
+        return edm::Service<CUDAService>()->chooseDevice(id);
+      case Backend::kAuto:
+        return edm::Service<CUDAService>()->chooseDeviceWithCapacity(id);
+    }
+    return -1;
+  }
+}  // namespace cms::cuda
@@ -3,6 +3,7 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Utilities/interface/Exception.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/StreamCache.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
 
@@ -12,12 +13,15 @@ namespace {
   struct CallbackData {
     edm::WaitingTaskWithArenaHolder holder;
     int device;
+    // the ServiceRegistry is not available in the CUDA callback thread
+    CUDAService const* service;
   };
 
   void CUDART_CB cudaScopedContextCallback(cudaStream_t streamId, cudaError_t status, void* data) {
     std::unique_ptr<CallbackData> guard{reinterpret_cast<CallbackData*>(data)};
     edm::WaitingTaskWithArenaHolder& waitingTaskHolder = guard->holder;
     int device = guard->device;
+    guard->service->workDone(device);
     if (status == cudaSuccess) {
       LogTrace("ScopedContext") << " GPU kernel finished (in callback) device " << device << " CUDA stream "
                                 << streamId;
@@ -43,6 +47,11 @@ namespace cms::cuda {
       stream_ = getStreamCache().get();
     }
 
+    ScopedContextBase::ScopedContextBase(int device) : currentDevice_(device) {
+      cudaCheck(cudaSetDevice(currentDevice_));
+      stream_ = getStreamCache().get();
+    }
+
     ScopedContextBase::ScopedContextBase(const ProductBase& data) : currentDevice_(data.device()) {
       cudaCheck(cudaSetDevice(currentDevice_));
       if (data.mayReuseStream()) {
@@ -83,8 +92,16 @@ namespace cms::cuda {
     }
 
     void ScopedContextHolderHelper::enqueueCallback(int device, cudaStream_t stream) {
-      cudaCheck(
-          cudaStreamAddCallback(stream, cudaScopedContextCallback, new CallbackData{waitingTaskHolder_, device}, 0));
+      edm::Service<CUDAService> cudaService;
+      CUDAService const* service = &*cudaService;
+      service->workQueued(device);
+      auto data = std::make_unique<CallbackData>(CallbackData{waitingTaskHolder_, device, service});
+      auto status = cudaStreamAddCallback(stream, cudaScopedContextCallback, data.get(), 0);
+      if (status != cudaSuccess) {
+        service->workDone(device);
+      }
+      cudaCheck(status);
+      data.release();
     }
   }  // namespace impl
 
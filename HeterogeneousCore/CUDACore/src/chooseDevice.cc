@@ -7,12 +7,9 @@ namespace cms::cuda {
   int chooseDevice(edm::StreamID id) {
     edm::Service<CUDAService> cudaService;
 
-    // For startes we "statically" assign the device based on
-    // edm::Stream number. This is suboptimal if the number of
-    // edm::Streams is not a multiple of the number of CUDA devices
-    // (and even then there is no load balancing).
-    //
-    // TODO: improve the "assignment" logic
-    return id % cudaService->numberOfDevices();
+    // By default the device is "statically" assigned based on the
+    // edm::Stream number, the CUDAService can be configured to pick
+    // the device with the least work queued instead.
+    return cudaService->chooseDevice(id);
   }
 }  // namespace cms::cuda
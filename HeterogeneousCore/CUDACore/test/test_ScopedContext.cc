@@ -11,6 +11,7 @@
 #include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/StreamCache.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/EventCache.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/GraphCache.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/currentDevice.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/ScopedSetDevice.h"
 
@@ -126,6 +127,32 @@ TEST_CASE("Use of cms::cuda::ScopedContext", "[CUDACore]") {
       REQUIRE(h_a2 == 4);
       REQUIRE(h_a3 == 6);
     }
+
+    SECTION("Launching work as a CUDA graph") {
+      cms::cuda::GraphCache graph;
+      auto d_a1 = cms::cuda::make_device_unique<int>(ctx.stream());
+      auto d_a2 = cms::cuda::make_device_unique<int>(ctx.stream());
+      int h_a1 = 1;
+      int h_a2 = 3;
+
+      // the second launch only updates the pointers of the graph
+      ctx.launchGraph(graph, [&](cudaStream_t stream) {
+        cudaCheck(cudaMemcpyAsync(d_a1.get(), &h_a1, sizeof(int), cudaMemcpyHostToDevice, stream));
+        cms::cudatest::testScopedContextKernels_single(d_a1.get(), stream);
+        cudaCheck(cudaMemcpyAsync(&h_a1, d_a1.get(), sizeof(int), cudaMemcpyDeviceToHost, stream));
+      });
+      ctx.launchGraph(graph, [&](cudaStream_t stream) {
+        cudaCheck(cudaMemcpyAsync(d_a2.get(), &h_a2, sizeof(int), cudaMemcpyHostToDevice, stream));
+        cms::cudatest::testScopedContextKernels_single(d_a2.get(), stream);
+        cudaCheck(cudaMemcpyAsync(&h_a2, d_a2.get(), sizeof(int), cudaMemcpyDeviceToHost, stream));
+      });
+      cudaCheck(cudaStreamSynchronize(ctx.stream()));
+
+      REQUIRE(h_a1 == 2);
+      REQUIRE(h_a2 == 6);
+      REQUIRE(graph.instantiations() == 1);
+      REQUIRE(graph.updates() == 1);
+    }
   }
 
   cudaCheck(cudaSetDevice(defaultDevice));
@@ -0,0 +1,45 @@
+#ifndef HeterogeneousCore_CUDAServices_CUDAEagerTransferService_h
+#define HeterogeneousCore_CUDAServices_CUDAEagerTransferService_h
+
+#include <set>
+#include <string>
+
+namespace edm {
+  class ParameterSet;
+  class ActivityRegistry;
+  class ConfigurationDescriptions;
+  class PathsAndConsumesOfModulesBase;
+  class ProcessContext;
+}  // namespace edm
+
+/**
+ * Finds from the consumes of the modules which producers of
+ * cms::cuda::Product<T> have consumers on the CPU, i.e. the modules
+ * transferring the data back to the host whose own products are
+ * consumed by the CPU modules or the OutputModules.
+ *
+ * Those producers can queue the device-to-host copy to their CUDA
+ * stream right after their kernels, so that the copy starts as soon as
+ * the kernels have finished and overlaps with the other work on the
+ * GPU, instead of waiting for the transfer module to be run by the
+ * framework.
+ *
+ * The information is available from the beginJob transition on.
+ */
+class CUDAEagerTransferService {
+public:
+  CUDAEagerTransferService(edm::ParameterSet const& iConfig, edm::ActivityRegistry& iRegistry);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  // true if the module produces cms::cuda::Product<T> which are transferred to the host
+  bool transferEagerly(std::string const& moduleLabel) const;
+
+private:
+  void preBeginJob(edm::PathsAndConsumesOfModulesBase const& pathsAndConsumes, edm::ProcessContext const&);
+
+  bool const enabled_;
+  std::set<std::string> producers_;
+};
+
+#endif
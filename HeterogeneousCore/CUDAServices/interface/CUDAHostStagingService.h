@@ -0,0 +1,44 @@
+#ifndef HeterogeneousCore_CUDAServices_CUDAHostStagingService_h
+#define HeterogeneousCore_CUDAServices_CUDAHostStagingService_h
+
+#include <memory>
+#include <vector>
+
+#include "FWCore/Utilities/interface/StreamID.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/HostStagingRing.h"
+
+namespace edm {
+  class ParameterSet;
+  class ActivityRegistry;
+  class ConfigurationDescriptions;
+}  // namespace edm
+
+/**
+ * Holds one cms::cuda::HostStagingRing of pinned host memory per
+ * edm::Stream, shared by the modules transferring data to the GPU,
+ * e.g. the raw data unpackers. They can unpack or copy the FED
+ * payloads straight into the pinned buffer and send it to the device
+ * with a single cudaMemcpyAsync(), instead of first filling a
+ * pageable buffer.
+ */
+class CUDAHostStagingService {
+public:
+  CUDAHostStagingService(edm::ParameterSet const& iConfig, edm::ActivityRegistry& iRegistry);
+  ~CUDAHostStagingService();
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  bool enabled() const { return enabled_; }
+
+  // The ring of the edm::Stream, can be used concurrently by the modules of that stream
+  cms::cuda::HostStagingRing& ring(edm::StreamID id) { return *rings_.at(id.value()); }
+
+private:
+  void postEndJob() const;
+
+  size_t const bytesPerStream_;
+  std::vector<std::unique_ptr<cms::cuda::HostStagingRing>> rings_;
+  bool enabled_ = false;
+};
+
+#endif
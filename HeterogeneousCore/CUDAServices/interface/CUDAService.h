@@ -1,6 +1,8 @@
 #ifndef HeterogeneousCore_CUDAServices_CUDAService_h
 #define HeterogeneousCore_CUDAServices_CUDAService_h
 
+#include <atomic>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -29,9 +31,29 @@ public:
   // Returns the id of device with most free memory. If none is found, returns -1.
   int deviceWithMostFreeMemory() const;
 
+  // Returns the device for new work of an edm::Stream, according to the configured device selection
+  // policy. Work on data already resident on a device stays on that device and does not call this.
+  int chooseDevice(edm::StreamID id) const;
+
+  // Like chooseDevice(), but returns -1 when every device already has maxQueuedWorkPerDevice items of
+  // asynchronous work queued, or if the service is disabled, so that the caller can run on the CPU instead.
+  int chooseDeviceWithCapacity(edm::StreamID id) const;
+
+  // Bookkeeping of the asynchronous work queued on each device, used by the "leastLoaded" policy.
+  // Can be called from any thread, including the CUDA callback threads.
+  void workQueued(int device) const { ++queuedWork_[device]; }
+  void workDone(int device) const { --queuedWork_[device]; }
+
 private:
+  enum class DeviceSelection { kRoundRobin, kLeastLoaded };
+
+  int leastLoadedDevice() const;
+
   int numberOfDevices_ = 0;
   std::vector<std::pair<int, int>> computeCapabilities_;
+  DeviceSelection deviceSelection_ = DeviceSelection::kRoundRobin;
+  std::unique_ptr<std::atomic<int>[]> queuedWork_;
+  int maxQueuedWork_ = 0;
   bool enabled_ = false;
 };
 
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <cuda.h>
 
@@ -13,6 +15,7 @@
 #include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
 #include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/deviceAllocatorStatus.h"
 
 namespace edm {
   class StreamContext;
@@ -28,9 +31,17 @@ public:
   void postModuleConstruction(edm::ModuleDescription const& desc);
   void postModuleBeginStream(edm::StreamContext const&, edm::ModuleCallingContext const& mcc);
   void postEvent(edm::StreamContext const& sc);
+  void postEndJob();
 
 private:
+  void recordModule(edm::ModuleDescription const& desc);
+  void attributeToModule(edm::ModuleCallingContext const& mcc) const;
+
   int numberOfDevices_ = 0;
+  bool memoryConstruction_ = false;
+  bool allocatorStatistics_ = false;
+  // module labels by allocation tag, tag 0 is for the allocations made outside of modules
+  std::vector<std::string> moduleLabels_;
 };
 
 CUDAMonitoringService::CUDAMonitoringService(edm::ParameterSet const& config, edm::ActivityRegistry& registry) {
@@ -39,10 +50,28 @@ CUDAMonitoringService::CUDAMonitoringService(edm::ParameterSet const& config, ed
   if (!cudaService->enabled())
     return;
   numberOfDevices_ = cudaService->numberOfDevices();
+  memoryConstruction_ = config.getUntrackedParameter<bool>("memoryConstruction");
+  allocatorStatistics_ = config.getUntrackedParameter<bool>("allocatorStatistics");
 
-  if (config.getUntrackedParameter<bool>("memoryConstruction")) {
+  if (allocatorStatistics_ or memoryConstruction_) {
     registry.watchPostModuleConstruction(this, &CUDAMonitoringService::postModuleConstruction);
   }
+  if (allocatorStatistics_) {
+    // the device allocations made by the modules are attributed by tagging them with the module id + 1
+    auto attribute = [this](edm::StreamContext const&, edm::ModuleCallingContext const& mcc) {
+      attributeToModule(mcc);
+    };
+    auto reset = [](edm::StreamContext const&, edm::ModuleCallingContext const&) {
+      cms::cuda::allocator::setDeviceAllocationTag(0);
+    };
+    registry.watchPreModuleBeginStream(attribute);
+    registry.watchPostModuleBeginStream(reset);
+    registry.watchPreModuleEventAcquire(attribute);
+    registry.watchPostModuleEventAcquire(reset);
+    registry.watchPreModuleEvent(attribute);
+    registry.watchPostModuleEvent(reset);
+    registry.watchPostEndJob(this, &CUDAMonitoringService::postEndJob);
+  }
   if (config.getUntrackedParameter<bool>("memoryBeginStream")) {
     registry.watchPostModuleBeginStream(this, &CUDAMonitoringService::postModuleBeginStream);
   }
@@ -60,6 +89,11 @@ void CUDAMonitoringService::fillDescriptions(edm::ConfigurationDescriptions& des
       ->setComment("Print memory information for each device after the beginStream() of each module");
   desc.addUntracked<bool>("memoryPerEvent", true)
       ->setComment("Print memory information for each device after each event");
+  desc.addUntracked<bool>("allocatorStatistics", false)
+      ->setComment(
+          "Attribute the device memory of the caching allocator to the modules allocating it, print the caching "
+          "allocator status with the memory information after each event, and print the high-watermarks of each "
+          "module at the end of the job");
 
   descriptions.add("CUDAMonitoringService", desc);
   descriptions.setComment(
@@ -83,9 +117,40 @@ namespace {
     }
     cudaCheck(cudaSetDevice(old));
   }
+
+  template <typename T>
+  void dumpAllocatorStatus(T& log, cms::cuda::allocator::GpuCachedBytes const& status) {
+    for (auto const& device : status) {
+      auto const& bytes = device.second;
+      log << "\n"
+          << device.first << ": caching allocator " << bytes.live / (1 << 20) << " MB live ("
+          << bytes.liveRequested / (1 << 20) << " MB requested), " << bytes.free / (1 << 20) << " MB cached, "
+          << bytes.maxLive / (1 << 20) << " MB live at most, " << bytes.hits << " hits, " << bytes.misses
+          << " misses, " << bytes.flushes << " flushes";
+    }
+  }
 }  // namespace
 
+void CUDAMonitoringService::recordModule(edm::ModuleDescription const& desc) {
+  // modules are constructed serially
+  auto tag = desc.id() + 1;
+  if (moduleLabels_.size() <= tag) {
+    moduleLabels_.resize(tag + 1);
+  }
+  moduleLabels_[tag] = desc.moduleLabel() + " (" + desc.moduleName() + ")";
+}
+
+void CUDAMonitoringService::attributeToModule(edm::ModuleCallingContext const& mcc) const {
+  cms::cuda::allocator::setDeviceAllocationTag(mcc.moduleDescription()->id() + 1);
+}
+
 void CUDAMonitoringService::postModuleConstruction(edm::ModuleDescription const& desc) {
+  if (allocatorStatistics_) {
+    recordModule(desc);
+  }
+  if (not memoryConstruction_) {
+    return;
+  }
   auto log = edm::LogPrint("CUDAMonitoringService");
   log << "CUDA device memory after construction of " << desc.moduleLabel() << " (" << desc.moduleName() << ")";
   dumpUsedMemory(log, numberOfDevices_);
@@ -102,6 +167,24 @@ void CUDAMonitoringService::postEvent(edm::StreamContext const& sc) {
   auto log = edm::LogPrint("CUDAMonitoringService");
   log << "CUDA device memory after event";
   dumpUsedMemory(log, numberOfDevices_);
+  if (allocatorStatistics_) {
+    dumpAllocatorStatus(log, cms::cuda::deviceAllocatorStatus());
+  }
+}
+
+void CUDAMonitoringService::postEndJob() {
+  auto log = edm::LogPrint("CUDAMonitoringService");
+  log << "CUDA caching device allocator at the end of the job";
+  auto const status = cms::cuda::deviceAllocatorStatus();
+  dumpAllocatorStatus(log, status);
+  for (auto const& device : status) {
+    log << "\nHigh-watermark of the live device memory per module on device " << device.first;
+    for (auto const& tag : device.second.tags) {
+      std::string const& label = tag.first < moduleLabels_.size() ? moduleLabels_[tag.first] : std::string();
+      log << "\n  " << (tag.first == 0 or label.empty() ? std::string("(outside of modules)") : label) << ": "
+          << tag.second.maxLive / (1 << 10) << " kB, " << tag.second.live / (1 << 10) << " kB still live";
+    }
+  }
 }
 
 DEFINE_FWK_SERVICE(CUDAMonitoringService);
@@ -1,4 +1,8 @@
 #include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAEagerTransferService.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAHostStagingService.h"
 #include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
 
 DEFINE_FWK_SERVICE_MAKER(CUDAService, edm::serviceregistry::ParameterSetMaker<CUDAService>);
+DEFINE_FWK_SERVICE(CUDAHostStagingService);
+DEFINE_FWK_SERVICE(CUDAEagerTransferService);
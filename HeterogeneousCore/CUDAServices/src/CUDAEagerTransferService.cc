@@ -0,0 +1,77 @@
+#include <map>
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ConsumesInfo.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAEagerTransferService.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
+
+namespace {
+  bool isCUDAProduct(edm::ConsumesInfo const& info) {
+    static std::string const kPrefix = "cms::cuda::Product<";
+    return info.type().className().compare(0, kPrefix.size(), kPrefix) == 0;
+  }
+}  // namespace
+
+CUDAEagerTransferService::CUDAEagerTransferService(edm::ParameterSet const& iConfig, edm::ActivityRegistry& iRegistry)
+    : enabled_(iConfig.getUntrackedParameter<bool>("enabled")) {
+  if (enabled_) {
+    iRegistry.watchPreBeginJob(this, &CUDAEagerTransferService::preBeginJob);
+  }
+}
+
+void CUDAEagerTransferService::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.addUntracked<bool>("enabled", true)
+      ->setComment("If false, no producer is asked to start the device-to-host transfers eagerly");
+  descriptions.add("CUDAEagerTransferService", desc);
+  descriptions.setComment(
+      "Determines from the consumes of the modules which producers of cms::cuda::Product<T> have consumers on the "
+      "CPU, so that they can queue the device-to-host transfers right after their kernels.");
+}
+
+bool CUDAEagerTransferService::transferEagerly(std::string const& moduleLabel) const {
+  edm::Service<CUDAService> cudaService;
+  if (not cudaService.isAvailable() or not cudaService->enabled()) {
+    return false;
+  }
+  return producers_.find(moduleLabel) != producers_.end();
+}
+
+void CUDAEagerTransferService::preBeginJob(edm::PathsAndConsumesOfModulesBase const& pathsAndConsumes,
+                                           edm::ProcessContext const&) {
+  // for each module, the labels of the modules it consumes a cms::cuda::Product<T> from,
+  // and whether any of its own products is consumed as a non-CUDA type
+  std::map<std::string, std::set<std::string>> cudaInputs;
+  std::set<std::string> consumedOnHost;
+  for (auto const* module : pathsAndConsumes.allModules()) {
+    auto& inputs = cudaInputs[module->moduleLabel()];
+    for (auto const& info : pathsAndConsumes.consumesInfo(module->id())) {
+      if (isCUDAProduct(info)) {
+        inputs.insert(info.label());
+      } else {
+        consumedOnHost.insert(info.label());
+      }
+    }
+  }
+
+  // a module reading CUDA products and producing data used on the host is a transfer module
+  producers_.clear();
+  for (auto const& module : cudaInputs) {
+    if (consumedOnHost.find(module.first) != consumedOnHost.end()) {
+      producers_.insert(module.second.begin(), module.second.end());
+    }
+  }
+
+  edm::LogInfo log("CUDAEagerTransferService");
+  log << producers_.size() << " producers of CUDA products have consumers on the host";
+  for (auto const& label : producers_) {
+    log << "\n  " << label;
+  }
+}
@@ -0,0 +1,53 @@
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAHostStagingService.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
+
+CUDAHostStagingService::CUDAHostStagingService(edm::ParameterSet const& iConfig, edm::ActivityRegistry& iRegistry)
+    : bytesPerStream_(size_t(iConfig.getUntrackedParameter<unsigned int>("megabytesPerStream")) << 20) {
+  edm::Service<CUDAService> cudaService;
+  if (not cudaService.isAvailable() or not cudaService->enabled() or bytesPerStream_ == 0) {
+    return;
+  }
+  enabled_ = true;
+
+  iRegistry.watchPreallocate([this](edm::service::SystemBounds const& bounds) {
+    rings_.reserve(bounds.maxNumberOfStreams());
+    for (unsigned int i = 0; i < bounds.maxNumberOfStreams(); ++i) {
+      rings_.emplace_back(std::make_unique<cms::cuda::HostStagingRing>(bytesPerStream_));
+    }
+    edm::LogInfo("CUDAHostStagingService")
+        << "Allocated " << (bytesPerStream_ >> 20) << " MB of pinned host memory for each of " << rings_.size()
+        << " streams";
+  });
+  iRegistry.watchPostEndJob(this, &CUDAHostStagingService::postEndJob);
+}
+
+CUDAHostStagingService::~CUDAHostStagingService() = default;
+
+void CUDAHostStagingService::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.addUntracked<unsigned int>("megabytesPerStream", 16)
+      ->setComment("Size of the pinned host memory ring buffer of each edm::Stream, 0 disables the service");
+  descriptions.add("CUDAHostStagingService", desc);
+  descriptions.setComment(
+      "Provides one ring buffer of pinned host memory per edm::Stream to stage the data to be transferred to the GPU. "
+      "The buffers which do not fit in the ring are allocated from the caching host allocator.");
+}
+
+void CUDAHostStagingService::postEndJob() const {
+  unsigned long long fallbacks = 0;
+  for (auto const& ring : rings_) {
+    fallbacks += ring->fallbacks();
+  }
+  if (fallbacks > 0) {
+    edm::LogInfo("CUDAHostStagingService") << fallbacks
+                                           << " buffers did not fit in the ring buffers and were allocated from the "
+                                              "caching host allocator, consider increasing megabytesPerStream";
+  }
+}
@@ -1,6 +1,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <string>
 
 #include <cuda.h>
 
@@ -8,6 +9,7 @@
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/ReusableObjectHolder.h"
 #include "HeterogeneousCore/CUDAServices/interface/CUDAService.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
@@ -132,6 +134,21 @@ CUDAService::CUDAService(edm::ParameterSet const& config) {
                                    << "Disabling the CUDAService.";
     return;
   }
+  auto const& deviceSelection = config.getUntrackedParameter<std::string>("deviceSelection");
+  if (deviceSelection == "roundRobin") {
+    deviceSelection_ = DeviceSelection::kRoundRobin;
+  } else if (deviceSelection == "leastLoaded") {
+    deviceSelection_ = DeviceSelection::kLeastLoaded;
+  } else {
+    throw cms::Exception("Configuration") << "CUDAService: unknown deviceSelection '" << deviceSelection
+                                          << "', allowed values are 'roundRobin' and 'leastLoaded'";
+  }
+  maxQueuedWork_ = config.getUntrackedParameter<unsigned int>("maxQueuedWorkPerDevice");
+  queuedWork_ = std::make_unique<std::atomic<int>[]>(numberOfDevices_);
+  for (int i = 0; i < numberOfDevices_; ++i) {
+    queuedWork_[i] = 0;
+  }
+
   edm::LogInfo log("CUDAService");
   computeCapabilities_.reserve(numberOfDevices_);
   log << "CUDA runtime successfully initialised, found " << numberOfDevices_ << " compute devices.\n\n";
@@ -339,6 +356,15 @@ CUDAService::~CUDAService() {
 void CUDAService::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.addUntracked<bool>("enabled", true);
+  desc.addUntracked<std::string>("deviceSelection", "roundRobin")
+      ->setComment(
+          "Policy to choose the device for the work of an edm::Stream that does not depend on data already on a "
+          "device.\n'roundRobin': the device is given by the edm::Stream number.\n'leastLoaded': the device with "
+          "the least asynchronous work queued, ties broken by the most free memory.");
+  desc.addUntracked<unsigned int>("maxQueuedWorkPerDevice", 0)
+      ->setComment(
+          "Number of asynchronous work items queued on a device above which the modules able to fall back to the CPU "
+          "do not give it more work. 0 means no limit.");
 
   edm::ParameterSetDescription limits;
   limits.addUntracked<int>("cudaLimitPrintfFifoSize", -1)
@@ -365,6 +391,66 @@ void CUDAService::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
   descriptions.add("CUDAService", desc);
 }
 
+int CUDAService::chooseDevice(edm::StreamID id) const {
+  if (deviceSelection_ == DeviceSelection::kLeastLoaded and numberOfDevices_ > 1) {
+    return leastLoadedDevice();
+  }
+  return id % numberOfDevices_;
+}
+
+int CUDAService::chooseDeviceWithCapacity(edm::StreamID id) const {
+  if (not enabled_) {
+    return -1;
+  }
+  int device = chooseDevice(id);
+  if (maxQueuedWork_ == 0 or queuedWork_[device] < maxQueuedWork_) {
+    return device;
+  }
+  // the preferred device is saturated, another one may still have room
+  if (numberOfDevices_ > 1) {
+    device = leastLoadedDevice();
+    if (queuedWork_[device] < maxQueuedWork_) {
+      return device;
+    }
+  }
+  return -1;
+}
+
+int CUDAService::leastLoadedDevice() const {
+  int minQueued = std::numeric_limits<int>::max();
+  std::vector<int> candidates;
+  for (int i = 0; i < numberOfDevices_; ++i) {
+    int queued = queuedWork_[i].load();
+    if (queued < minQueued) {
+      minQueued = queued;
+      candidates.clear();
+    }
+    if (queued == minQueued) {
+      candidates.push_back(i);
+    }
+  }
+  if (candidates.size() == 1) {
+    return candidates.front();
+  }
+
+  // only query the memory of the devices in a tie, cudaMemGetInfo is not free
+  int currentDevice;
+  cudaCheck(cudaGetDevice(&currentDevice));
+  size_t maxFreeMemory = 0;
+  int device = candidates.front();
+  for (int i : candidates) {
+    size_t freeMemory, totalMemory;
+    cudaCheck(cudaSetDevice(i));
+    cudaCheck(cudaMemGetInfo(&freeMemory, &totalMemory));
+    if (freeMemory > maxFreeMemory) {
+      maxFreeMemory = freeMemory;
+      device = i;
+    }
+  }
+  cudaCheck(cudaSetDevice(currentDevice));
+  return device;
+}
+
 int CUDAService::deviceWithMostFreeMemory() const {
   // save the current device
   int currentDevice;
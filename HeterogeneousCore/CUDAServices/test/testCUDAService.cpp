@@ -107,6 +107,52 @@ TEST_CASE("Tests of CUDAService", "[CUDAService]") {
       WARN("Device with most free memory " << dev << "\n"
                                            << "     as given by CUDAService " << cs.deviceWithMostFreeMemory());
     }
+
+    SECTION("CUDAService least loaded device selection") {
+      edm::ParameterSet psLoad;
+      psLoad.addUntrackedParameter("enabled", true);
+      psLoad.addUntrackedParameter<std::string>("deviceSelection", "leastLoaded");
+      auto csLoad = makeCUDAService(psLoad);
+      // the edm::Stream does not matter for this policy
+      auto const streamID = edm::StreamID::invalidStreamID();
+      int device = csLoad.chooseDevice(streamID);
+      REQUIRE(device >= 0);
+      REQUIRE(device < deviceCount);
+      if (deviceCount > 1) {
+        // a device with queued work is avoided, whatever its free memory
+        csLoad.workQueued(device);
+        REQUIRE(csLoad.chooseDevice(streamID) != device);
+        csLoad.workDone(device);
+      }
+    }
+
+    SECTION("CUDAService device selection with a limit on the queued work") {
+      edm::ParameterSet psLimit;
+      psLimit.addUntrackedParameter("enabled", true);
+      psLimit.addUntrackedParameter<unsigned int>("maxQueuedWorkPerDevice", 1);
+      auto csLimit = makeCUDAService(psLimit);
+      auto const streamID = edm::StreamID::invalidStreamID();
+      REQUIRE(csLimit.chooseDeviceWithCapacity(streamID) == csLimit.chooseDevice(streamID));
+      // once all devices are saturated the work should go to the CPU
+      for (int i = 0; i < deviceCount; ++i) {
+        csLimit.workQueued(i);
+      }
+      REQUIRE(csLimit.chooseDeviceWithCapacity(streamID) == -1);
+      csLimit.workDone(0);
+      REQUIRE(csLimit.chooseDeviceWithCapacity(streamID) == 0);
+      for (int i = 1; i < deviceCount; ++i) {
+        csLimit.workDone(i);
+      }
+    }
+  }
+
+  SECTION("Unknown device selection policy") {
+    edm::ParameterSet ps;
+    ps.addUntrackedParameter("enabled", true);
+    ps.addUntrackedParameter<std::string>("deviceSelection", "random");
+    if (deviceCount > 0) {
+      REQUIRE_THROWS_AS(makeCUDAService(ps), cms::Exception);
+    }
   }
 
   SECTION("Force to be disabled") {
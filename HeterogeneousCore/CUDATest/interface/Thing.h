@@ -2,6 +2,8 @@
 #define HeterogeneousCore_CUDATest_Thing_H
 
 #include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/SharedEventPtr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
 
 namespace cms {
   namespace cudatest {
@@ -9,11 +11,23 @@ namespace cms {
     public:
       Thing() = default;
       explicit Thing(cms::cuda::device::unique_ptr<float[]> ptr) : ptr_(std::move(ptr)) {}
+      // the host copy is filled asynchronously in another CUDA stream than the device data, and is complete
+      // once hostEvent has occurred
+      Thing(cms::cuda::device::unique_ptr<float[]> ptr,
+            cms::cuda::host::unique_ptr<float[]> hostPtr,
+            cms::cuda::SharedEventPtr hostEvent)
+          : ptr_(std::move(ptr)), hostPtr_(std::move(hostPtr)), hostEvent_(std::move(hostEvent)) {}
 
       const float *get() const { return ptr_.get(); }
 
+      // null if the producer did not transfer the data to the host
+      const float *getHost() const { return hostPtr_.get(); }
+      cudaEvent_t hostEvent() const { return hostEvent_.get(); }
+
     private:
       cms::cuda::device::unique_ptr<float[]> ptr_;
+      cms::cuda::host::unique_ptr<float[]> hostPtr_;
+      cms::cuda::SharedEventPtr hostEvent_;
     };
   }  // namespace cudatest
 }  // namespace cms
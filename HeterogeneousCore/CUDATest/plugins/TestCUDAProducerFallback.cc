@@ -0,0 +1,100 @@
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "HeterogeneousCore/CUDACore/interface/BackendSelector.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+#include "TestCUDAProducerGPUKernel.h"
+
+/**
+ * Runs the same simple algorithm on the CPU or on a GPU, as chosen for
+ * each event by a cms::cuda::BackendSelector. The product does not depend
+ * on the backend.
+ */
+class TestCUDAProducerFallback : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit TestCUDAProducerFallback(edm::ParameterSet const& iConfig);
+  ~TestCUDAProducerFallback() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  void acquire(edm::Event const& iEvent,
+               edm::EventSetup const& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, edm::EventSetup const& iSetup) override;
+
+private:
+  std::string const label_;
+  edm::EDPutTokenT<int> const dstToken_;
+  cms::cuda::BackendSelector const backend_;
+  TestCUDAProducerGPUKernel gpuAlgo_;
+  cms::cuda::host::unique_ptr<float[]> hostData_;
+  int cpuResult_ = 0;
+};
+
+TestCUDAProducerFallback::TestCUDAProducerFallback(edm::ParameterSet const& iConfig)
+    : label_{iConfig.getParameter<std::string>("@module_label")}, dstToken_{produces<int>()}, backend_{iConfig} {}
+
+void TestCUDAProducerFallback::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  cms::cuda::BackendSelector::fillPSetDescription(desc);
+  descriptions.addWithDefaultLabel(desc);
+  descriptions.setComment(
+      "This EDProducer is part of the TestCUDAProducer* family. It models an algorithm having both a CPU and a GPU "
+      "implementation, the backend being chosen for each event. Produces int, the same for both backends.");
+}
+
+void TestCUDAProducerFallback::acquire(edm::Event const& iEvent,
+                                       edm::EventSetup const& iSetup,
+                                       edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  int const device = backend_.select(iEvent.streamID());
+  edm::LogVerbatim("TestCUDAProducerFallback")
+      << label_ << " TestCUDAProducerFallback::acquire event " << iEvent.id().event() << " stream "
+      << iEvent.streamID() << " on " << (device < 0 ? "the CPU" : "device " + std::to_string(device));
+
+  if (device < 0) {
+    cpuResult_ = 0;
+    for (int i = 0; i < TestCUDAProducerGPUKernel::NUM_VALUES; ++i) {
+      cpuResult_ += i + 1;
+    }
+    return;
+  }
+
+  cms::cuda::ScopedContextAcquire ctx{device, std::move(waitingTaskHolder)};
+  constexpr auto size = TestCUDAProducerGPUKernel::NUM_VALUES * sizeof(float);
+  hostData_ = cms::cuda::make_host_unique<float[]>(TestCUDAProducerGPUKernel::NUM_VALUES, ctx.stream());
+  for (int i = 0; i < TestCUDAProducerGPUKernel::NUM_VALUES; ++i) {
+    hostData_[i] = i;
+  }
+  auto deviceData = cms::cuda::make_device_unique<float[]>(TestCUDAProducerGPUKernel::NUM_VALUES, ctx.stream());
+  cudaCheck(cudaMemcpyAsync(deviceData.get(), hostData_.get(), size, cudaMemcpyHostToDevice, ctx.stream()));
+  gpuAlgo_.runSimpleAlgo(deviceData.get(), ctx.stream());
+  cudaCheck(cudaMemcpyAsync(hostData_.get(), deviceData.get(), size, cudaMemcpyDeviceToHost, ctx.stream()));
+}
+
+void TestCUDAProducerFallback::produce(edm::Event& iEvent, edm::EventSetup const& iSetup) {
+  int output = cpuResult_;
+  if (hostData_) {
+    output = 0;
+    for (int i = 0; i < TestCUDAProducerGPUKernel::NUM_VALUES; ++i) {
+      output += hostData_[i];
+    }
+    hostData_.reset();
+  }
+
+  iEvent.emplace(dstToken_, output);
+
+  edm::LogVerbatim("TestCUDAProducerFallback") << label_ << " TestCUDAProducerFallback::produce end event "
+                                               << iEvent.id().event() << " stream " << iEvent.streamID() << " result "
+                                               << output;
+}
+
+DEFINE_FWK_MODULE(TestCUDAProducerFallback);
@@ -6,8 +6,15 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 
 #include "CUDADataFormats/Common/interface/Product.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
 #include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAServices/interface/CUDAEagerTransferService.h"
 #include "HeterogeneousCore/CUDATest/interface/Thing.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/EventCache.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/StreamCache.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/copyAsync.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
 
 #include "TestCUDAProducerGPUKernel.h"
 
@@ -18,6 +25,7 @@ public:
 
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
 
+  void beginJob() override;
   void produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const& iSetup) const override;
 
 private:
@@ -25,6 +33,7 @@ private:
   edm::EDGetTokenT<cms::cuda::Product<cms::cudatest::Thing>> const srcToken_;
   edm::EDPutTokenT<cms::cuda::Product<cms::cudatest::Thing>> const dstToken_;
   TestCUDAProducerGPUKernel const gpuAlgo_;
+  bool transferEagerly_ = false;
 };
 
 TestCUDAProducerGPU::TestCUDAProducerGPU(edm::ParameterSet const& iConfig)
@@ -41,6 +50,11 @@ void TestCUDAProducerGPU::fillDescriptions(edm::ConfigurationDescriptions& descr
       "algorithm in the chain of the GPU EDProducers. Produces cms::cuda::Product<cms::cudatest::Thing>.");
 }
 
+void TestCUDAProducerGPU::beginJob() {
+  edm::Service<CUDAEagerTransferService> eagerTransfer;
+  transferEagerly_ = eagerTransfer.isAvailable() and eagerTransfer->transferEagerly(label_);
+}
+
 void TestCUDAProducerGPU::produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const& iSetup) const {
   edm::LogVerbatim("TestCUDAProducerGPU") << label_ << " TestCUDAProducerGPU::produce begin event "
                                           << iEvent.id().event() << " stream " << iEvent.streamID();
@@ -49,7 +63,24 @@ void TestCUDAProducerGPU::produce(edm::StreamID streamID, edm::Event& iEvent, ed
   cms::cuda::ScopedContextProduce ctx{in};
   cms::cudatest::Thing const& input = ctx.get(in);
 
-  ctx.emplace(iEvent, dstToken_, cms::cudatest::Thing{gpuAlgo_.runAlgo(label_, input.get(), ctx.stream())});
+  auto output = gpuAlgo_.runAlgo(label_, input.get(), ctx.stream());
+  if (transferEagerly_) {
+    // Queue the copy right after the kernels in a stream of its own, so that the event of the product, recorded
+    // at the end of produce, does not include the copy: the consumers on the GPU do not wait for it, and the
+    // consumers on the host wait for the event recorded after the copy. The device data is kept by the product
+    // until the end of the event, after those consumers have waited for the copy
+    auto kernelsDone = cms::cuda::getEventCache().get();
+    cudaCheck(cudaEventRecord(kernelsDone.get(), ctx.stream()));
+    auto copyStream = cms::cuda::getStreamCache().get();
+    cudaCheck(cudaStreamWaitEvent(copyStream.get(), kernelsDone.get(), 0));
+    auto host = cms::cuda::make_host_unique<float[]>(TestCUDAProducerGPUKernel::NUM_VALUES, copyStream.get());
+    cms::cuda::copyAsync(host, output, TestCUDAProducerGPUKernel::NUM_VALUES, copyStream.get());
+    auto copied = cms::cuda::getEventCache().get();
+    cudaCheck(cudaEventRecord(copied.get(), copyStream.get()));
+    ctx.emplace(iEvent, dstToken_, std::move(output), std::move(host), std::move(copied));
+  } else {
+    ctx.emplace(iEvent, dstToken_, std::move(output));
+  }
 
   edm::LogVerbatim("TestCUDAProducerGPU")
       << label_ << " TestCUDAProducerGPU::produce end event " << iEvent.id().event() << " stream " << iEvent.streamID();
@@ -34,6 +34,8 @@ private:
   edm::EDPutTokenT<cms::cuda::Product<cms::cudatest::Thing>> const dstToken_;
   TestCUDAProducerGPUKernel gpuAlgo_;
   cms::cuda::ContextState ctxState_;
+  bool const useGraph_;
+  cms::cuda::GraphCache graph_;
   cms::cuda::device::unique_ptr<float[]> devicePtr_;
   cms::cuda::host::noncached::unique_ptr<float> hostData_;
 };
@@ -41,7 +43,8 @@ private:
 TestCUDAProducerGPUEW::TestCUDAProducerGPUEW(edm::ParameterSet const& iConfig)
     : label_{iConfig.getParameter<std::string>("@module_label")},
       srcToken_{consumes<cms::cuda::Product<cms::cudatest::Thing>>(iConfig.getParameter<edm::InputTag>("src"))},
-      dstToken_{produces<cms::cuda::Product<cms::cudatest::Thing>>()} {
+      dstToken_{produces<cms::cuda::Product<cms::cudatest::Thing>>()},
+      useGraph_{iConfig.getParameter<bool>("useGraph")} {
   edm::Service<CUDAService> cs;
   if (cs->enabled()) {
     hostData_ = cms::cuda::make_host_noncached_unique<float>();
@@ -51,6 +54,7 @@ TestCUDAProducerGPUEW::TestCUDAProducerGPUEW(edm::ParameterSet const& iConfig)
 void TestCUDAProducerGPUEW::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.add<edm::InputTag>("src", edm::InputTag());
+  desc.add<bool>("useGraph", false)->setComment("Launch the kernels of each event as a CUDA graph.");
   descriptions.addWithDefaultLabel(desc);
   descriptions.setComment(
       "This EDProducer is part of the TestCUDAProducer* family. It models a GPU algorithm this is not the first "
@@ -69,7 +73,7 @@ void TestCUDAProducerGPUEW::acquire(edm::Event const& iEvent,
   cms::cuda::ScopedContextAcquire ctx{in, std::move(waitingTaskHolder), ctxState_};
   cms::cudatest::Thing const& input = ctx.get(in);
 
-  devicePtr_ = gpuAlgo_.runAlgo(label_, input.get(), ctx.stream());
+  devicePtr_ = gpuAlgo_.runAlgo(label_, input.get(), ctx.stream(), useGraph_ ? &graph_ : nullptr);
   // Mimick the need to transfer some of the GPU data back to CPU to
   // be used for something within this module, or to be put in the
   // event.
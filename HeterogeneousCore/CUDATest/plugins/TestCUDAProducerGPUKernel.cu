@@ -64,7 +64,8 @@ namespace {
 
 cms::cuda::device::unique_ptr<float[]> TestCUDAProducerGPUKernel::runAlgo(const std::string &label,
                                                                           const float *d_input,
-                                                                          cudaStream_t stream) const {
+                                                                          cudaStream_t stream,
+                                                                          cms::cuda::GraphCache *graph) const {
   // First make the sanity check
   if (d_input != nullptr) {
     auto h_check = std::make_unique<float[]>(NUM_VALUES);
@@ -88,22 +89,14 @@ cms::cuda::device::unique_ptr<float[]> TestCUDAProducerGPUKernel::runAlgo(const
 
   auto d_a = cms::cuda::make_device_unique<float[]>(NUM_VALUES, stream);
   auto d_b = cms::cuda::make_device_unique<float[]>(NUM_VALUES, stream);
-
-  cudaCheck(cudaMemcpyAsync(d_a.get(), h_a.get(), NUM_VALUES * sizeof(float), cudaMemcpyHostToDevice, stream));
-  cudaCheck(cudaMemcpyAsync(d_b.get(), h_b.get(), NUM_VALUES * sizeof(float), cudaMemcpyHostToDevice, stream));
-
-  int threadsPerBlock{32};
-  int blocksPerGrid = (NUM_VALUES + threadsPerBlock - 1) / threadsPerBlock;
-
   auto d_c = cms::cuda::make_device_unique<float[]>(NUM_VALUES, stream);
-  auto current_device = cms::cuda::currentDevice();
-  cms::cuda::LogVerbatim("TestHeterogeneousEDProducerGPU")
-      << "  " << label << " GPU launching kernels device " << current_device << " CUDA stream " << stream;
-  vectorAdd<<<blocksPerGrid, threadsPerBlock, 0, stream>>>(d_a.get(), d_b.get(), d_c.get(), NUM_VALUES);
-
   auto d_ma = cms::cuda::make_device_unique<float[]>(NUM_VALUES * NUM_VALUES, stream);
   auto d_mb = cms::cuda::make_device_unique<float[]>(NUM_VALUES * NUM_VALUES, stream);
   auto d_mc = cms::cuda::make_device_unique<float[]>(NUM_VALUES * NUM_VALUES, stream);
+
+  int threadsPerBlock{32};
+  int blocksPerGrid = (NUM_VALUES + threadsPerBlock - 1) / threadsPerBlock;
+
   dim3 threadsPerBlock3{NUM_VALUES, NUM_VALUES};
   dim3 blocksPerGrid3{1, 1};
   if (NUM_VALUES * NUM_VALUES > 32) {
@@ -112,11 +105,30 @@ cms::cuda::device::unique_ptr<float[]> TestCUDAProducerGPUKernel::runAlgo(const
     blocksPerGrid3.x = ceil(double(NUM_VALUES) / double(threadsPerBlock3.x));
     blocksPerGrid3.y = ceil(double(NUM_VALUES) / double(threadsPerBlock3.y));
   }
-  vectorProd<<<blocksPerGrid3, threadsPerBlock3, 0, stream>>>(d_a.get(), d_b.get(), d_ma.get(), NUM_VALUES);
-  vectorProd<<<blocksPerGrid3, threadsPerBlock3, 0, stream>>>(d_a.get(), d_c.get(), d_mb.get(), NUM_VALUES);
-  matrixMul<<<blocksPerGrid3, threadsPerBlock3, 0, stream>>>(d_ma.get(), d_mb.get(), d_mc.get(), NUM_VALUES);
 
-  matrixMulVector<<<blocksPerGrid, threadsPerBlock, 0, stream>>>(d_mc.get(), d_b.get(), d_c.get(), NUM_VALUES);
+  auto current_device = cms::cuda::currentDevice();
+  cms::cuda::LogVerbatim("TestHeterogeneousEDProducerGPU")
+      << "  " << label << " GPU launching kernels device " << current_device << " CUDA stream " << stream
+      << (graph ? " as a CUDA graph" : "");
+
+  // all the memory is allocated above so that the sequence can be captured into a CUDA graph
+  auto queueWork = [&](cudaStream_t workStream) {
+    cudaCheck(cudaMemcpyAsync(d_a.get(), h_a.get(), NUM_VALUES * sizeof(float), cudaMemcpyHostToDevice, workStream));
+    cudaCheck(cudaMemcpyAsync(d_b.get(), h_b.get(), NUM_VALUES * sizeof(float), cudaMemcpyHostToDevice, workStream));
+
+    vectorAdd<<<blocksPerGrid, threadsPerBlock, 0, workStream>>>(d_a.get(), d_b.get(), d_c.get(), NUM_VALUES);
+
+    vectorProd<<<blocksPerGrid3, threadsPerBlock3, 0, workStream>>>(d_a.get(), d_b.get(), d_ma.get(), NUM_VALUES);
+    vectorProd<<<blocksPerGrid3, threadsPerBlock3, 0, workStream>>>(d_a.get(), d_c.get(), d_mb.get(), NUM_VALUES);
+    matrixMul<<<blocksPerGrid3, threadsPerBlock3, 0, workStream>>>(d_ma.get(), d_mb.get(), d_mc.get(), NUM_VALUES);
+
+    matrixMulVector<<<blocksPerGrid, threadsPerBlock, 0, workStream>>>(d_mc.get(), d_b.get(), d_c.get(), NUM_VALUES);
+  };
+  if (graph) {
+    graph->launch(stream, queueWork);
+  } else {
+    queueWork(stream);
+  }
 
   cms::cuda::LogVerbatim("TestHeterogeneousEDProducerGPU")
       << "  " << label << " GPU kernels launched, returning return pointer device " << current_device << " CUDA stream "
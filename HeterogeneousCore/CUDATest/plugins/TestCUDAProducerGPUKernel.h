@@ -5,6 +5,7 @@
 
 #include <cuda_runtime.h>
 
+#include "HeterogeneousCore/CUDAUtilities/interface/GraphCache.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
 
 /**
@@ -23,13 +24,15 @@ public:
   TestCUDAProducerGPUKernel() = default;
   ~TestCUDAProducerGPUKernel() = default;
 
-  // returns (owning) pointer to device memory
+  // returns (owning) pointer to device memory, if graph is given the
+  // kernels are launched as a CUDA graph held by it
   cms::cuda::device::unique_ptr<float[]> runAlgo(const std::string& label, cudaStream_t stream) const {
     return runAlgo(label, nullptr, stream);
   }
   cms::cuda::device::unique_ptr<float[]> runAlgo(const std::string& label,
                                                  const float* d_input,
-                                                 cudaStream_t stream) const;
+                                                 cudaStream_t stream,
+                                                 cms::cuda::GraphCache* graph = nullptr) const;
 
   void runSimpleAlgo(float* d_data, cudaStream_t stream) const;
 };
@@ -31,6 +31,7 @@ private:
   edm::EDGetTokenT<cms::cuda::Product<cms::cudatest::Thing>> const srcToken_;
   edm::EDPutTokenT<int> const dstToken_;
   cms::cuda::host::unique_ptr<float[]> buffer_;
+  float const* hostData_ = nullptr;
 };
 
 TestCUDAProducerGPUtoCPU::TestCUDAProducerGPUtoCPU(edm::ParameterSet const& iConfig)
@@ -57,13 +58,20 @@ void TestCUDAProducerGPUtoCPU::acquire(edm::Event const& iEvent,
   cms::cuda::ScopedContextAcquire ctx{in, std::move(waitingTaskHolder)};
   cms::cudatest::Thing const& device = ctx.get(in);
 
-  buffer_ = cms::cuda::make_host_unique<float[]>(TestCUDAProducerGPUKernel::NUM_VALUES, ctx.stream());
-  // Enqueue async copy, continue in produce once finished
-  cudaCheck(cudaMemcpyAsync(buffer_.get(),
-                            device.get(),
-                            TestCUDAProducerGPUKernel::NUM_VALUES * sizeof(float),
-                            cudaMemcpyDeviceToHost,
-                            ctx.stream()));
+  hostData_ = device.getHost();
+  if (hostData_ == nullptr) {
+    buffer_ = cms::cuda::make_host_unique<float[]>(TestCUDAProducerGPUKernel::NUM_VALUES, ctx.stream());
+    // Enqueue async copy, continue in produce once finished
+    cudaCheck(cudaMemcpyAsync(buffer_.get(),
+                              device.get(),
+                              TestCUDAProducerGPUKernel::NUM_VALUES * sizeof(float),
+                              cudaMemcpyDeviceToHost,
+                              ctx.stream()));
+    hostData_ = buffer_.get();
+  } else {
+    // the producer already queued the copy in another stream, continue in produce once it has finished
+    cudaCheck(cudaStreamWaitEvent(ctx.stream(), device.hostEvent(), 0));
+  }
 
   edm::LogVerbatim("TestCUDAProducerGPUtoCPU") << label_ << " TestCUDAProducerGPUtoCPU::acquire end event "
                                                << iEvent.id().event() << " stream " << iEvent.streamID();
@@ -75,8 +83,9 @@ void TestCUDAProducerGPUtoCPU::produce(edm::Event& iEvent, edm::EventSetup const
 
   int counter = 0;
   for (int i = 0; i < TestCUDAProducerGPUKernel::NUM_VALUES; ++i) {
-    counter += buffer_[i];
+    counter += hostData_[i];
   }
+  hostData_ = nullptr;
   buffer_.reset();  // not so nice, but no way around?
 
   iEvent.emplace(dstToken_, counter);
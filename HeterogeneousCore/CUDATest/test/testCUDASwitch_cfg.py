@@ -9,6 +9,7 @@ includeAnalyzer = False
 process = cms.Process("Test")
 process.load("FWCore.MessageService.MessageLogger_cfi")
 process.load("HeterogeneousCore.CUDAServices.CUDAService_cfi")
+process.load("HeterogeneousCore.CUDAServices.CUDAEagerTransferService_cfi")
 
 process.source = cms.Source("EmptySource")
 
@@ -45,7 +46,7 @@ from HeterogeneousCore.CUDATest.testCUDAProducerGPUtoCPU_cfi import testCUDAProd
 
 process.prod2CUDA = testCUDAProducerGPU.clone(src = "prod1CUDA")
 process.prod3CUDA = testCUDAProducerGPU.clone(src = "prod2CUDA")
-process.prod4CUDA = testCUDAProducerGPUEW.clone(src = "prod1CUDA")
+process.prod4CUDA = testCUDAProducerGPUEW.clone(src = "prod1CUDA", useGraph = True)
 
 # CPU producers, switched with modules to copy data from GPU to CPU
 # (as "on demand" as any other EDProducer, i.e. according to
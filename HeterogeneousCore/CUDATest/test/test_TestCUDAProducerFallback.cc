@@ -0,0 +1,69 @@
+#include "catch.hpp"
+#include "FWCore/TestProcessor/interface/TestProcessor.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
+
+#include <string>
+
+static constexpr auto s_tag = "[TestCUDAProducerFallback]";
+
+namespace {
+  std::string makeConfig(std::string const& backend, unsigned int maxQueuedWork = 0) {
+    return R"_(from FWCore.TestProcessor.TestProcess import *
+process = TestProcess()
+process.load("HeterogeneousCore.CUDAServices.CUDAService_cfi")
+process.CUDAService.maxQueuedWorkPerDevice = )_" +
+           std::to_string(maxQueuedWork) + R"_(
+process.toTest = cms.EDProducer("TestCUDAProducerFallback", backend = cms.string(")_" +
+           backend + R"_("))
+process.moduleToTest(process.toTest)
+)_";
+  }
+
+  // sum of i+1 for i in [0, NUM_VALUES)
+  constexpr int expected = 4000 * 4001 / 2;
+}  // namespace
+
+TEST_CASE("Configuration of TestCUDAProducerFallback", s_tag) {
+  SECTION("unknown backend") {
+    edm::test::TestProcessor::Config config{makeConfig("fpga")};
+    REQUIRE_THROWS_AS(edm::test::TestProcessor(config), cms::Exception);
+  }
+
+  SECTION("cuda backend without a device") {
+    if (cms::cudatest::testDevices()) {
+      return;
+    }
+    edm::test::TestProcessor::Config config{makeConfig("cuda")};
+    REQUIRE_THROWS_AS(edm::test::TestProcessor(config), cms::Exception);
+  }
+}
+
+TEST_CASE("TestCUDAProducerFallback gives the same result on every backend", s_tag) {
+  SECTION("cpu") {
+    edm::test::TestProcessor tester{edm::test::TestProcessor::Config{makeConfig("cpu")}};
+    REQUIRE(*tester.test().get<int>() == expected);
+  }
+
+  SECTION("auto, on the CPU when there is no device") {
+    edm::test::TestProcessor tester{edm::test::TestProcessor::Config{makeConfig("auto")}};
+    REQUIRE(*tester.test().get<int>() == expected);
+  }
+
+  if (not cms::cudatest::testDevices()) {
+    return;
+  }
+
+  SECTION("cuda") {
+    edm::test::TestProcessor tester{edm::test::TestProcessor::Config{makeConfig("cuda")}};
+    REQUIRE(*tester.test().get<int>() == expected);
+  }
+
+  SECTION("auto with a limit on the queued work") {
+    edm::test::TestProcessor tester{edm::test::TestProcessor::Config{makeConfig("auto", 1)}};
+    for (int i = 0; i < 3; ++i) {
+      REQUIRE(*tester.test().get<int>() == expected);
+    }
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef HeterogeneousCore_CUDAUtilities_GraphCache_h
+#define HeterogeneousCore_CUDAUtilities_GraphCache_h
+
+#include <vector>
+
+#include <cuda_runtime.h>
+
+namespace cms {
+  namespace cuda {
+    /**
+     * Replays a fixed sequence of asynchronous operations (kernels,
+     * memcpy and memset) as one CUDA graph.
+     *
+     * On each launch() the operations queued by the function are
+     * captured from the CUDA stream instead of being sent to the
+     * device. The first capture on a device is instantiated into an
+     * executable graph, the later captures only update the parameters
+     * (pointers, sizes, kernel arguments) of that graph, which is much
+     * cheaper than launching the kernels one by one. If the sequence
+     * changed its shape, e.g. a different number of kernels or a
+     * different launch configuration, the graph is instantiated again.
+     *
+     * The function must only queue asynchronous work to the stream it
+     * is given. In particular it must not allocate or free memory with
+     * the caching allocators, nor synchronize with the stream, so the
+     * memory should be allocated before calling launch().
+     *
+     * The class is not thread safe. It is intended to be a member of an
+     * edm::stream module, or to be held per edm::Stream of a global
+     * module.
+     */
+    class GraphCache {
+    public:
+      GraphCache() = default;
+      ~GraphCache();
+
+      GraphCache(const GraphCache&) = delete;
+      GraphCache& operator=(const GraphCache&) = delete;
+      GraphCache(GraphCache&&) = default;
+      GraphCache& operator=(GraphCache&&) = default;
+
+      // Captures the work queued by func(stream), and launches it on
+      // stream as a graph of the current device
+      template <typename F>
+      void launch(cudaStream_t stream, F&& func) {
+        beginCapture(stream);
+        try {
+          func(stream);
+        } catch (...) {
+          abortCapture(stream);
+          throw;
+        }
+        endCaptureAndLaunch(stream);
+      }
+
+      // Number of times a graph had to be instantiated, and of the
+      // launches that only updated the existing graph
+      unsigned int instantiations() const { return instantiations_; }
+      unsigned int updates() const { return updates_; }
+
+    private:
+      void beginCapture(cudaStream_t stream);
+      void abortCapture(cudaStream_t stream) noexcept;
+      void endCaptureAndLaunch(cudaStream_t stream);
+
+      // indexed by the device
+      std::vector<cudaGraphExec_t> graphs_;
+      unsigned int instantiations_ = 0;
+      unsigned int updates_ = 0;
+    };
+  }  // namespace cuda
+}  // namespace cms
+
+#endif
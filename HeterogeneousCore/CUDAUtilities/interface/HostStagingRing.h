@@ -0,0 +1,106 @@
+#ifndef HeterogeneousCore_CUDAUtilities_HostStagingRing_h
+#define HeterogeneousCore_CUDAUtilities_HostStagingRing_h
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/SharedEventPtr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_noncached_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+namespace cms {
+  namespace cuda {
+    /**
+     * Ring buffer of pinned host memory to stage data for the transfer
+     * to the GPU, e.g. the payloads of a FEDRawDataCollection.
+     *
+     * The data can be written directly into the buffers handed out by
+     * allocate() and be transferred with cudaMemcpyAsync() without any
+     * intermediate copy. Like for the buffers of the caching host
+     * allocator, the memory of a buffer is reused only after the work
+     * queued to its CUDA stream until its destruction has completed.
+     * Unlike the caching allocator there is no rounding of the sizes
+     * and no global lock; the space is handed out in order and freed
+     * in order.
+     *
+     * If the requested size does not fit in the free part of the ring,
+     * the buffer is allocated from the caching host allocator instead.
+     *
+     * The member functions are thread safe, so that the modules
+     * processing the same edm::Stream can share one ring.
+     */
+    class HostStagingRing {
+    public:
+      class Buffer {
+      public:
+        Buffer() = default;
+        ~Buffer();
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        Buffer(Buffer&& other);
+        Buffer& operator=(Buffer&& other);
+
+        unsigned char* data() const { return data_; }
+        size_t size() const { return size_; }
+        // true if the buffer is in the ring, false if it comes from the caching allocator
+        bool inRing() const { return ring_ != nullptr; }
+
+      private:
+        friend class HostStagingRing;
+
+        unsigned char* data_ = nullptr;
+        size_t size_ = 0;
+        cudaStream_t stream_ = nullptr;
+        HostStagingRing* ring_ = nullptr;
+        unsigned long long id_ = 0;
+        host::unique_ptr<unsigned char[]> fallback_;
+      };
+
+      explicit HostStagingRing(size_t bytes);
+      ~HostStagingRing() = default;
+
+      HostStagingRing(const HostStagingRing&) = delete;
+      HostStagingRing& operator=(const HostStagingRing&) = delete;
+
+      // Returns a buffer of at least bytes, to be used with stream
+      Buffer allocate(size_t bytes, cudaStream_t stream);
+
+      size_t capacity() const { return capacity_; }
+      // Number of buffers that did not fit in the ring
+      unsigned long long fallbacks() const { return fallbacks_.load(); }
+
+    private:
+      struct Region {
+        size_t begin;
+        size_t end;
+        unsigned long long id;
+        SharedEventPtr event;  // null while the buffer is alive
+        bool released = false;
+      };
+
+      // the caller holds the lock
+      void reclaim();
+      bool reserve(size_t bytes, size_t& begin) const;
+
+      void release(unsigned long long id, cudaStream_t stream);
+
+      static constexpr size_t kAlignment = 128;
+
+      size_t const capacity_;
+      host::noncached::unique_ptr<unsigned char[]> memory_;
+
+      std::mutex mutex_;
+      // in the order of the ring, oldest first
+      std::deque<Region> regions_;
+      unsigned long long nextId_ = 0;
+      std::atomic<unsigned long long> fallbacks_{0};
+    };
+  }  // namespace cuda
+}  // namespace cms
+
+#endif
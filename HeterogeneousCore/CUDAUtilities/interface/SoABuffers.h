@@ -0,0 +1,105 @@
+#ifndef HeterogeneousCore_CUDAUtilities_SoABuffers_h
+#define HeterogeneousCore_CUDAUtilities_SoABuffers_h
+
+#include <cstddef>
+#include <utility>
+
+#include <cuda_runtime.h>
+
+#include "FWCore/SOA/interface/SoALayout.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/copyAsync.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/*
+ * HostSoA and DeviceSoA hold the rows of an edm::soa::SoALayout in a
+ * single buffer of pinned host memory and of device memory, allocated
+ * with the caching allocators. Since both use the same layout, the
+ * whole table is transferred with a single copyAsync(), and the
+ * edm::soa::SoAView of the DeviceSoA can be passed by value to the
+ * kernels.
+ *
+ *   using SphereLayout = edm::soa::SoALayout_t<SphereTable>;
+ *
+ *   cms::cuda::HostSoA<SphereLayout> h_spheres(sphereTable, stream);
+ *   cms::cuda::DeviceSoA<SphereLayout> d_spheres(h_spheres.size(), stream);
+ *   cms::cuda::copyAsync(d_spheres, h_spheres, stream);
+ *   kernel<<<blocks, threads, 0, stream>>>(d_spheres.view());
+ */
+
+namespace cms {
+  namespace cuda {
+    namespace impl {
+      template <typename LAYOUT, typename PTR>
+      class SoABuffer {
+      public:
+        using Layout = LAYOUT;
+        using View = typename LAYOUT::View;
+
+        unsigned int size() const { return view_.size(); }
+        size_t bytes() const { return LAYOUT::bytes(size()); }
+
+        View const& view() const { return view_; }
+        View& view() { return view_; }
+
+        PTR const& buffer() const { return buffer_; }
+        PTR& buffer() { return buffer_; }
+
+      protected:
+        SoABuffer() = default;
+        SoABuffer(PTR buffer, unsigned int nRows)
+            : buffer_(std::move(buffer)), view_(LAYOUT::view(buffer_.get(), nRows)) {}
+
+      private:
+        PTR buffer_;
+        View view_;
+      };
+
+      template <typename SRC, typename DST>
+      void checkSoASizes(SRC const& src, DST const& dst) {
+        if (src.size() != dst.size()) {
+          throw cms::Exception("LogicError")
+              << "copyAsync: the source SoA has " << src.size() << " rows and the destination " << dst.size();
+        }
+      }
+    }  // namespace impl
+
+    template <typename LAYOUT>
+    class HostSoA : public impl::SoABuffer<LAYOUT, host::unique_ptr<std::byte[]>> {
+    public:
+      HostSoA() = default;
+      HostSoA(unsigned int nRows, cudaStream_t stream)
+          : impl::SoABuffer<LAYOUT, host::unique_ptr<std::byte[]>>(
+                make_host_unique<std::byte[]>(LAYOUT::bytes(nRows), stream), nRows) {}
+      // fills the buffer with the rows of the Table
+      HostSoA(typename LAYOUT::Table const& table, cudaStream_t stream) : HostSoA(table.size(), stream) {
+        LAYOUT::copy(table, this->view());
+      }
+    };
+
+    template <typename LAYOUT>
+    class DeviceSoA : public impl::SoABuffer<LAYOUT, device::unique_ptr<std::byte[]>> {
+    public:
+      DeviceSoA() = default;
+      DeviceSoA(unsigned int nRows, cudaStream_t stream)
+          : impl::SoABuffer<LAYOUT, device::unique_ptr<std::byte[]>>(
+                make_device_unique<std::byte[]>(LAYOUT::bytes(nRows), stream), nRows) {}
+    };
+
+    // The source and destination must have the same number of rows
+    template <typename LAYOUT>
+    inline void copyAsync(DeviceSoA<LAYOUT>& dst, const HostSoA<LAYOUT>& src, cudaStream_t stream) {
+      impl::checkSoASizes(src, dst);
+      copyAsync(dst.buffer(), src.buffer(), src.bytes(), stream);
+    }
+
+    template <typename LAYOUT>
+    inline void copyAsync(HostSoA<LAYOUT>& dst, const DeviceSoA<LAYOUT>& src, cudaStream_t stream) {
+      impl::checkSoASizes(src, dst);
+      copyAsync(dst.buffer(), src.buffer(), src.bytes(), stream);
+    }
+  }  // namespace cuda
+}  // namespace cms
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef HeterogeneousCore_CUDAUtilities_deviceAllocatorStatus_h
+#define HeterogeneousCore_CUDAUtilities_deviceAllocatorStatus_h
+
+#include <cstddef>
+#include <map>
+
+namespace cms {
+  namespace cuda {
+    namespace allocator {
+      // Bytes held by the allocations attributed to one tag
+      struct TagBytes {
+        size_t live = 0;
+        size_t maxLive = 0;  // high-watermark of live
+      };
+
+      // Status of the caching device allocator for one device
+      struct TotalBytes {
+        size_t free = 0;                        // cached for reuse
+        size_t live = 0;                        // in use, rounded up to the bin sizes
+        size_t liveRequested = 0;               // in use, as requested, the difference to live is lost to rounding
+        size_t maxLive = 0;                     // high-watermark of live
+        size_t maxTotal = 0;                    // high-watermark of free + live
+        unsigned long long hits = 0;            // allocations served from the cache
+        unsigned long long misses = 0;          // allocations needing a cudaMalloc
+        unsigned long long flushes = 0;         // times the cache was emptied after a failed cudaMalloc
+        std::map<unsigned int, TagBytes> tags;  // tag 0 means not attributed
+      };
+
+      using GpuCachedBytes = std::map<int, TotalBytes>;
+
+      // Device allocations made by the current thread are attributed to tag until the next call
+      void setDeviceAllocationTag(unsigned int tag);
+      unsigned int deviceAllocationTag();
+    }  // namespace allocator
+
+    allocator::GpuCachedBytes deviceAllocatorStatus();
+  }  // namespace cuda
+}  // namespace cms
+
+#endif
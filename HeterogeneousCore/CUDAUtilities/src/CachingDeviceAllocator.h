@@ -38,6 +38,7 @@
  * thread-safe and capable of managing device allocations on multiple devices.
  ******************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <set>
@@ -45,6 +46,8 @@
 #include <cub/util_debug.cuh>
 #include <cub/host/mutex.cuh>
 
+#include "HeterogeneousCore/CUDAUtilities/interface/deviceAllocatorStatus.h"
+
 /// CUB namespace
 namespace notcub {
 
@@ -126,10 +129,19 @@ namespace notcub {
       int device;                      // device ordinal
       cudaStream_t associated_stream;  // Associated associated_stream
       cudaEvent_t ready_event;  // Signal when associated stream has run to the point at which this block was freed
+      size_t bytes_requested;   // CMS: Size of allocation as requested, only meaningful for live blocks
+      unsigned int tag;         // CMS: Tag the allocation is attributed to, only meaningful for live blocks
 
       // Constructor (suitable for searching maps for a specific block, given its pointer and device)
       BlockDescriptor(void *d_ptr, int device)
-          : d_ptr(d_ptr), bytes(0), bin(INVALID_BIN), device(device), associated_stream(nullptr), ready_event(nullptr) {}
+          : d_ptr(d_ptr),
+            bytes(0),
+            bin(INVALID_BIN),
+            device(device),
+            associated_stream(nullptr),
+            ready_event(nullptr),
+            bytes_requested(0),
+            tag(0) {}
 
       // Constructor (suitable for searching maps for a range of suitable blocks, given a device)
       BlockDescriptor(int device)
@@ -138,7 +150,9 @@ namespace notcub {
             bin(INVALID_BIN),
             device(device),
             associated_stream(nullptr),
-            ready_event(nullptr) {}
+            ready_event(nullptr),
+            bytes_requested(0),
+            tag(0) {}
 
       // Comparison functor for comparing device pointers
       static bool PtrCompare(const BlockDescriptor &a, const BlockDescriptor &b) {
@@ -160,12 +174,8 @@ namespace notcub {
     /// BlockDescriptor comparator function interface
     typedef bool (*Compare)(const BlockDescriptor &, const BlockDescriptor &);
 
-    class TotalBytes {
-    public:
-      size_t free;
-      size_t live;
-      TotalBytes() { free = live = 0; }
-    };
+    // CMS: use the TotalBytes of the public interface, which also holds the statistics
+    using TotalBytes = cms::cuda::allocator::TotalBytes;
 
     /// Set type for cached blocks (ordered by size)
     typedef std::multiset<BlockDescriptor, Compare> CachedBlocks;
@@ -215,6 +225,30 @@ namespace notcub {
       }
     }
 
+    /**
+     * CMS: Account for a block becoming live, the mutex must be locked
+     */
+    void AddLiveBlock(const BlockDescriptor &block) {
+      TotalBytes &total = cached_bytes[block.device];
+      total.live += block.bytes;
+      total.liveRequested += block.bytes_requested;
+      total.maxLive = std::max(total.maxLive, total.live);
+      total.maxTotal = std::max(total.maxTotal, total.live + total.free);
+      auto &tag_bytes = total.tags[block.tag];
+      tag_bytes.live += block.bytes;
+      tag_bytes.maxLive = std::max(tag_bytes.maxLive, tag_bytes.live);
+    }
+
+    /**
+     * CMS: Account for a block no longer being live, the mutex must be locked
+     */
+    void RemoveLiveBlock(const BlockDescriptor &block) {
+      TotalBytes &total = cached_bytes[block.device];
+      total.live -= block.bytes;
+      total.liveRequested -= block.bytes_requested;
+      total.tags[block.tag].live -= block.bytes;
+    }
+
     //---------------------------------------------------------------------
     // Fields
     //---------------------------------------------------------------------
@@ -324,7 +358,8 @@ namespace notcub {
         int device,                            ///< [in] Device on which to place the allocation
         void **d_ptr,                          ///< [out] Reference to pointer to the allocation
         size_t bytes,                          ///< [in] Minimum number of bytes for the allocation
-        cudaStream_t active_stream = nullptr)  ///< [in] The stream to be associated with this allocation
+        cudaStream_t active_stream = nullptr,  ///< [in] The stream to be associated with this allocation
+        unsigned int tag = 0)                  ///< [in] CMS: Tag the allocation is attributed to in CacheStatus()
     {
       *d_ptr = nullptr;
       int entrypoint_device = INVALID_DEVICE_ORDINAL;
@@ -340,6 +375,8 @@ namespace notcub {
       bool found = false;
       BlockDescriptor search_key(device);
       search_key.associated_stream = active_stream;
+      search_key.bytes_requested = bytes;
+      search_key.tag = tag;
       NearestPowerOf(search_key.bin, search_key.bytes, bin_growth, bytes);
 
       if (search_key.bin > max_bin) {
@@ -371,11 +408,14 @@ namespace notcub {
             found = true;
             search_key = *block_itr;
             search_key.associated_stream = active_stream;
+            search_key.bytes_requested = bytes;
+            search_key.tag = tag;
             live_blocks.insert(search_key);
 
             // Remove from free blocks
             cached_bytes[device].free -= search_key.bytes;
-            cached_bytes[device].live += search_key.bytes;
+            AddLiveBlock(search_key);
+            ++cached_bytes[device].hits;
 
             if (debug)
               // CMS: improved debug message
@@ -426,6 +466,7 @@ namespace notcub {
 
           // Lock
           mutex.Lock();
+          ++cached_bytes[device].flushes;
 
           // Iterate the range of free blocks on the same device
           BlockDescriptor free_key(device);
@@ -480,7 +521,8 @@ namespace notcub {
         // Insert into live blocks
         mutex.Lock();
         live_blocks.insert(search_key);
-        cached_bytes[device].live += search_key.bytes;
+        AddLiveBlock(search_key);
+        ++cached_bytes[device].misses;
         mutex.Unlock();
 
         if (debug)
@@ -556,7 +598,7 @@ namespace notcub {
         // Remove from live blocks
         search_key = *block_itr;
         live_blocks.erase(block_itr);
-        cached_bytes[device].live -= search_key.bytes;
+        RemoveLiveBlock(search_key);
 
         // Keep the returned allocation if bin is valid and we won't exceed the max cached threshold
         if ((search_key.bin != INVALID_BIN) && (cached_bytes[device].free + search_key.bytes <= max_cached_bytes)) {
@@ -640,6 +682,16 @@ namespace notcub {
      */
     cudaError_t DeviceFree(void *d_ptr) { return DeviceFree(INVALID_DEVICE_ORDINAL, d_ptr); }
 
+    /**
+     * \brief CMS: Returns a copy of the cached and live bytes and the statistics of each device
+     */
+    GpuCachedBytes CacheStatus() {
+      mutex.Lock();
+      GpuCachedBytes copy = cached_bytes;
+      mutex.Unlock();
+      return copy;
+    }
+
     /**
      * \brief Frees all cached device allocations on all devices
      */
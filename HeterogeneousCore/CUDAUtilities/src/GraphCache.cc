@@ -0,0 +1,84 @@
+#include "HeterogeneousCore/CUDAUtilities/interface/GraphCache.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/ScopedSetDevice.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/currentDevice.h"
+
+namespace {
+  // true if the parameters of graph could be copied into exec
+  bool updateGraph(cudaGraphExec_t exec, cudaGraph_t graph) {
+#if CUDART_VERSION >= 12000
+    cudaGraphExecUpdateResultInfo info;
+    auto status = cudaGraphExecUpdate(exec, graph, &info);
+#else
+    cudaGraphNode_t errorNode;
+    cudaGraphExecUpdateResult result;
+    auto status = cudaGraphExecUpdate(exec, graph, &errorNode, &result);
+#endif
+    if (status == cudaErrorGraphExecUpdateFailure) {
+      // the topology changed, not an error; reset the last error so it is not picked up later
+      cudaGetLastError();
+      return false;
+    }
+    cudaCheck(status);
+    return true;
+  }
+
+  cudaGraphExec_t instantiateGraph(cudaGraph_t graph) {
+    cudaGraphExec_t exec;
+#if CUDART_VERSION >= 12000
+    cudaCheck(cudaGraphInstantiate(&exec, graph, 0));
+#else
+    cudaCheck(cudaGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+#endif
+    return exec;
+  }
+}  // namespace
+
+namespace cms::cuda {
+  GraphCache::~GraphCache() {
+    for (int dev = 0; dev < static_cast<int>(graphs_.size()); ++dev) {
+      if (graphs_[dev] != nullptr) {
+        ScopedSetDevice deviceGuard{dev};
+        cudaCheck(cudaGraphExecDestroy(graphs_[dev]));
+      }
+    }
+  }
+
+  void GraphCache::beginCapture(cudaStream_t stream) {
+    // only the calls of this thread are captured, other threads keep using their own streams
+    cudaCheck(cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal));
+  }
+
+  void GraphCache::abortCapture(cudaStream_t stream) noexcept {
+    cudaGraph_t graph = nullptr;
+    // errors are ignored, the exception that caused the abort is more interesting
+    if (cudaStreamEndCapture(stream, &graph) == cudaSuccess and graph != nullptr) {
+      cudaGraphDestroy(graph);
+    }
+    cudaGetLastError();
+  }
+
+  void GraphCache::endCaptureAndLaunch(cudaStream_t stream) {
+    cudaGraph_t graph;
+    cudaCheck(cudaStreamEndCapture(stream, &graph));
+
+    auto const dev = currentDevice();
+    if (dev >= static_cast<int>(graphs_.size())) {
+      graphs_.resize(dev + 1, nullptr);
+    }
+    auto& exec = graphs_[dev];
+    if (exec != nullptr and updateGraph(exec, graph)) {
+      ++updates_;
+    } else {
+      if (exec != nullptr) {
+        cudaCheck(cudaGraphExecDestroy(exec));
+        exec = nullptr;
+      }
+      exec = instantiateGraph(graph);
+      ++instantiations_;
+    }
+    // the executable graph keeps its own copy of the nodes
+    cudaCheck(cudaGraphDestroy(graph));
+    cudaCheck(cudaGraphLaunch(exec, stream));
+  }
+}  // namespace cms::cuda
@@ -0,0 +1,124 @@
+#include <algorithm>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/EventCache.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/HostStagingRing.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/eventWorkHasCompleted.h"
+
+namespace cms::cuda {
+  HostStagingRing::Buffer::~Buffer() {
+    if (ring_) {
+      ring_->release(id_, stream_);
+    }
+  }
+
+  HostStagingRing::Buffer::Buffer(Buffer&& other)
+      : data_(other.data_),
+        size_(other.size_),
+        stream_(other.stream_),
+        ring_(other.ring_),
+        id_(other.id_),
+        fallback_(std::move(other.fallback_)) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.ring_ = nullptr;
+  }
+
+  HostStagingRing::Buffer& HostStagingRing::Buffer::operator=(Buffer&& other) {
+    if (this != &other) {
+      if (ring_) {
+        ring_->release(id_, stream_);
+      }
+      data_ = other.data_;
+      size_ = other.size_;
+      stream_ = other.stream_;
+      ring_ = other.ring_;
+      id_ = other.id_;
+      fallback_ = std::move(other.fallback_);
+      other.data_ = nullptr;
+      other.size_ = 0;
+      other.ring_ = nullptr;
+    }
+    return *this;
+  }
+
+  // the memory is portable as the edm::Stream may use different devices for different events
+  HostStagingRing::HostStagingRing(size_t bytes)
+      : capacity_(bytes), memory_(make_host_noncached_unique<unsigned char[]>(bytes, cudaHostAllocPortable)) {}
+
+  HostStagingRing::Buffer HostStagingRing::allocate(size_t bytes, cudaStream_t stream) {
+    Buffer buffer;
+    buffer.size_ = bytes;
+    buffer.stream_ = stream;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      reclaim();
+      size_t begin;
+      if (reserve(bytes, begin)) {
+        size_t const aligned = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+        regions_.push_back(Region{begin, begin + aligned, nextId_, SharedEventPtr(), false});
+        buffer.data_ = memory_.get() + begin;
+        buffer.ring_ = this;
+        buffer.id_ = nextId_++;
+        return buffer;
+      }
+    }
+    // waiting for the ring to drain would block the thread, use the caching allocator instead
+    ++fallbacks_;
+    buffer.fallback_ = make_host_unique<unsigned char[]>(bytes, stream);
+    buffer.data_ = buffer.fallback_.get();
+    return buffer;
+  }
+
+  void HostStagingRing::reclaim() {
+    while (not regions_.empty()) {
+      auto const& front = regions_.front();
+      if (not front.released or (front.event and not eventWorkHasCompleted(front.event.get()))) {
+        break;
+      }
+      regions_.pop_front();
+    }
+  }
+
+  bool HostStagingRing::reserve(size_t bytes, size_t& begin) const {
+    size_t const aligned = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+    if (regions_.empty()) {
+      begin = 0;
+      return aligned <= capacity_;
+    }
+    size_t const tail = regions_.front().begin;
+    size_t const head = regions_.back().end;
+    if (regions_.back().begin >= tail) {
+      // used space is [tail, head), free space at the end and at the beginning
+      if (head + aligned <= capacity_) {
+        begin = head;
+        return true;
+      }
+      if (aligned <= tail) {
+        begin = 0;
+        return true;
+      }
+      return false;
+    }
+    // wrapped around, free space is [head, tail)
+    if (head + aligned <= tail) {
+      begin = head;
+      return true;
+    }
+    return false;
+  }
+
+  void HostStagingRing::release(unsigned long long id, cudaStream_t stream) {
+    // the event marks the point after which the memory is no longer used by the work queued to the stream
+    auto event = getEventCache().get();
+    cudaCheck(cudaEventRecord(event.get(), stream));
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto region = std::find_if(regions_.begin(), regions_.end(), [id](Region const& r) { return r.id == id; });
+    if (region != regions_.end()) {
+      region->event = std::move(event);
+      region->released = true;
+    }
+    reclaim();
+  }
+}  // namespace cms::cuda
@@ -0,0 +1,21 @@
+#include "HeterogeneousCore/CUDAUtilities/interface/deviceAllocatorStatus.h"
+
+#include "getCachingDeviceAllocator.h"
+
+namespace {
+  thread_local unsigned int s_allocationTag = 0;
+}
+
+namespace cms::cuda {
+  namespace allocator {
+    void setDeviceAllocationTag(unsigned int tag) { s_allocationTag = tag; }
+    unsigned int deviceAllocationTag() { return s_allocationTag; }
+  }  // namespace allocator
+
+  allocator::GpuCachedBytes deviceAllocatorStatus() {
+    if constexpr (allocator::useCaching) {
+      return allocator::getCachingDeviceAllocator().CacheStatus();
+    }
+    return allocator::GpuCachedBytes();
+  }
+}  // namespace cms::cuda
@@ -0,0 +1,89 @@
+#include "catch.hpp"
+
+#include "HeterogeneousCore/CUDAUtilities/interface/HostStagingRing.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
+
+TEST_CASE("HostStagingRing", "[cudaMemTools]") {
+  if (not cms::cudatest::testDevices()) {
+    return;
+  }
+
+  cudaStream_t stream;
+  cudaCheck(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+  constexpr size_t capacity = 1024;
+  cms::cuda::HostStagingRing ring(capacity);
+
+  SECTION("Buffers are in the ring") {
+    auto a = ring.allocate(100, stream);
+    auto b = ring.allocate(100, stream);
+    REQUIRE(a.inRing());
+    REQUIRE(b.inRing());
+    REQUIRE(a.data() != b.data());
+    REQUIRE(ring.fallbacks() == 0);
+  }
+
+  SECTION("Too large buffers come from the caching allocator") {
+    auto a = ring.allocate(capacity + 1, stream);
+    REQUIRE(a.data() != nullptr);
+    REQUIRE(not a.inRing());
+    REQUIRE(ring.fallbacks() == 1);
+  }
+
+  SECTION("Memory is reused after the work has completed") {
+    unsigned char* first;
+    {
+      auto a = ring.allocate(capacity, stream);
+      REQUIRE(a.inRing());
+      first = a.data();
+      auto b = ring.allocate(1, stream);
+      REQUIRE(not b.inRing());
+    }
+    cudaCheck(cudaStreamSynchronize(stream));
+    auto c = ring.allocate(capacity, stream);
+    REQUIRE(c.inRing());
+    REQUIRE(c.data() == first);
+  }
+
+  SECTION("Buffers wrap around the ring in order") {
+    unsigned char* first;
+    {
+      auto a = ring.allocate(capacity / 2, stream);
+      first = a.data();
+      auto b = ring.allocate(capacity / 4, stream);
+      REQUIRE(b.data() == first + capacity / 2);
+      // the end of the ring is free, the first buffer is released only after the new one is allocated
+      a = ring.allocate(capacity / 4, stream);
+      REQUIRE(a.data() == first + 3 * capacity / 4);
+      cudaCheck(cudaStreamSynchronize(stream));
+      // the beginning of the ring is free again while b is still in use
+      auto c = ring.allocate(capacity / 2, stream);
+      REQUIRE(c.inRing());
+      REQUIRE(c.data() == first);
+    }
+    REQUIRE(ring.fallbacks() == 0);
+  }
+
+  SECTION("Transfer to the device") {
+    constexpr int N = 10;
+    auto d = cms::cuda::make_device_unique<int[]>(N, stream);
+    int h[N];
+    {
+      auto a = ring.allocate(N * sizeof(int), stream);
+      auto values = reinterpret_cast<int*>(a.data());
+      for (int i = 0; i < N; ++i) {
+        values[i] = i;
+      }
+      cudaCheck(cudaMemcpyAsync(d.get(), a.data(), a.size(), cudaMemcpyHostToDevice, stream));
+    }
+    cudaCheck(cudaMemcpyAsync(h, d.get(), N * sizeof(int), cudaMemcpyDeviceToHost, stream));
+    cudaCheck(cudaStreamSynchronize(stream));
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(h[i] == i);
+    }
+  }
+
+  cudaCheck(cudaStreamDestroy(stream));
+}
@@ -0,0 +1,66 @@
+#include "catch.hpp"
+
+#include <array>
+
+#include "FWCore/SOA/interface/Column.h"
+#include "FWCore/SOA/interface/Table.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/SoABuffers.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
+
+namespace {
+  SOA_DECLARE_COLUMN(Eta, float, "eta");
+  SOA_DECLARE_COLUMN(Phi, double, "phi");
+  SOA_DECLARE_COLUMN(ID, int, "id");
+
+  using TestTable = edm::soa::Table<Eta, Phi, ID>;
+  using TestLayout = edm::soa::SoALayout_t<TestTable>;
+}  // namespace
+
+TEST_CASE("SoABuffers", "[cudaMemTools]") {
+  if (not cms::cudatest::testDevices()) {
+    return;
+  }
+
+  cudaStream_t stream;
+  cudaCheck(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+
+  std::array<float, 4> eta = {{0.1, 0.2, 0.3, 0.4}};
+  std::array<double, 4> phi = {{1., 2., 3., 4.}};
+  std::array<int, 4> id = {{5, 6, 7, 8}};
+  TestTable table{eta, phi, id};
+
+  SECTION("Host buffer from a Table") {
+    cms::cuda::HostSoA<TestLayout> host(table, stream);
+    REQUIRE(host.size() == 4);
+    REQUIRE(host.bytes() == TestLayout::bytes(4));
+    for (unsigned int i = 0; i < 4; ++i) {
+      REQUIRE(host.view().get<Eta>(i) == eta[i]);
+      REQUIRE(host.view().get<Phi>(i) == phi[i]);
+      REQUIRE(host.view().get<ID>(i) == id[i]);
+    }
+  }
+
+  SECTION("Round trip through the device") {
+    cms::cuda::HostSoA<TestLayout> host(table, stream);
+    cms::cuda::DeviceSoA<TestLayout> device(host.size(), stream);
+    cms::cuda::copyAsync(device, host, stream);
+
+    cms::cuda::HostSoA<TestLayout> back(host.size(), stream);
+    cms::cuda::copyAsync(back, device, stream);
+    cudaCheck(cudaStreamSynchronize(stream));
+    for (unsigned int i = 0; i < 4; ++i) {
+      REQUIRE(back.view().get<Eta>(i) == eta[i]);
+      REQUIRE(back.view().get<Phi>(i) == phi[i]);
+      REQUIRE(back.view().get<ID>(i) == id[i]);
+    }
+  }
+
+  SECTION("Different sizes") {
+    cms::cuda::HostSoA<TestLayout> host(table, stream);
+    cms::cuda::DeviceSoA<TestLayout> device(host.size() + 1, stream);
+    REQUIRE_THROWS(cms::cuda::copyAsync(device, host, stream));
+  }
+
+  cudaCheck(cudaStreamDestroy(stream));
+}
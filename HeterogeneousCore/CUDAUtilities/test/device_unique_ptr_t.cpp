@@ -1,6 +1,7 @@
 #include "catch.hpp"
 
 #include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/deviceAllocatorStatus.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
 #include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
 
@@ -35,6 +36,29 @@ TEST_CASE("device_unique_ptr", "[cudaMemTools]") {
     REQUIRE(ptr.get() == nullptr);
   }
 
+  SECTION("Allocator status") {
+    int device;
+    cudaCheck(cudaGetDevice(&device));
+    cms::cuda::allocator::setDeviceAllocationTag(42);
+    auto ptr = cms::cuda::make_device_unique<char[]>(1000, stream);
+    cms::cuda::allocator::setDeviceAllocationTag(0);
+    auto status = cms::cuda::deviceAllocatorStatus();
+    if (not status.empty()) {
+      auto const& bytes = status[device];
+      REQUIRE(bytes.liveRequested >= 1000);
+      REQUIRE(bytes.live >= bytes.liveRequested);
+      REQUIRE(bytes.tags.at(42).live >= 1000);
+      REQUIRE(bytes.hits + bytes.misses > 0);
+    }
+    ptr.reset();
+    cudaCheck(cudaStreamSynchronize(stream));
+    status = cms::cuda::deviceAllocatorStatus();
+    if (not status.empty()) {
+      REQUIRE(status[device].tags.at(42).live == 0);
+      REQUIRE(status[device].tags.at(42).maxLive >= 1000);
+    }
+  }
+
   SECTION("Allocating too much") {
     constexpr size_t maxSize = 1 << 30;  // 8**10
     auto ptr = cms::cuda::make_device_unique<char[]>(maxSize, stream);
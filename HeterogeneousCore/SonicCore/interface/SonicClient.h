@@ -0,0 +1,23 @@
+#ifndef HeterogeneousCore_SonicCore_SonicClient_h
+#define HeterogeneousCore_SonicCore_SonicClient_h
+
+#include "HeterogeneousCore/SonicCore/interface/SonicClientBase.h"
+
+// a client holding the input and the output of one inference, reused from one event to the next
+template <typename InputT, typename OutputT = InputT>
+class SonicClient : public SonicClientBase {
+public:
+  typedef InputT Input;
+  typedef OutputT Output;
+
+  explicit SonicClient(const edm::ParameterSet& params) : SonicClientBase(params) {}
+
+  Input& input() { return input_; }
+  const Output& output() const { return output_; }
+
+protected:
+  Input input_;
+  Output output_;
+};
+
+#endif
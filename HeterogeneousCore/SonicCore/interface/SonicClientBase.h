@@ -0,0 +1,66 @@
+#ifndef HeterogeneousCore_SonicCore_SonicClientBase_h
+#define HeterogeneousCore_SonicCore_SonicClientBase_h
+
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+
+#include <exception>
+#include <future>
+#include <optional>
+#include <string>
+
+namespace edm {
+  class ParameterSet;
+  class ParameterSetDescription;
+}  // namespace edm
+
+/**
+ * Base of the clients of an inference service: an EDProducer fills the
+ * input of its client in acquire, dispatches it, and reads the output in
+ * produce. The inference is run by evaluate(), which may run it on a
+ * remote server and return before it is done; it calls finish() once the
+ * output is ready or the inference failed, possibly from another thread.
+ *
+ * A failed inference is retried up to "allowedRetries" times. When all the
+ * tries failed and "localFallback" is set, the inference is run by
+ * evaluateLocal(), on the machine of the job.
+ */
+class SonicClientBase {
+public:
+  explicit SonicClientBase(const edm::ParameterSet& params);
+  virtual ~SonicClientBase() = default;
+
+  SonicClientBase(const SonicClientBase&) = delete;
+  SonicClientBase& operator=(const SonicClientBase&) = delete;
+
+  const std::string& debugName() const { return debugName_; }
+  void setDebugName(const std::string& debugName) { debugName_ = debugName; }
+
+  // runs the inference of the input; holder.doneWaiting is called once the output is ready
+  void dispatch(edm::WaitingTaskWithArenaHolder holder);
+  // runs the inference of the input, and returns once the output is ready; throws if it failed
+  void dispatch();
+
+  static void fillBasePSetDescription(edm::ParameterSetDescription& desc);
+
+protected:
+  // starts the inference of the input, calling finish() once it is done
+  virtual void evaluate() = 0;
+  // runs the inference of the input on the machine of the job, and fills the output before returning
+  virtual void evaluateLocal();
+
+  void finish(bool success, std::exception_ptr eptr = std::exception_ptr{});
+
+private:
+  void start();
+  void done(std::exception_ptr eptr);
+
+  const unsigned allowedRetries_;
+  const bool localFallback_;
+  unsigned tries_;
+  std::string debugName_;
+  // where the end of the inference is reported, with or without a framework task
+  std::optional<edm::WaitingTaskWithArenaHolder> holder_;
+  std::optional<std::promise<void>> promise_;
+};
+
+#endif
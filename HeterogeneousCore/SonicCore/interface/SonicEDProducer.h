@@ -0,0 +1,51 @@
+#ifndef HeterogeneousCore_SonicCore_SonicEDProducer_h
+#define HeterogeneousCore_SonicCore_SonicEDProducer_h
+
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+
+#include <string>
+
+/**
+ * An ExternalWork producer whose inference is run by a SonicClient: the
+ * stream thread is released while the client runs it, possibly on a
+ * remote server. The client is configured by the "Client" parameter set.
+ */
+template <typename Client, typename... Capabilities>
+class SonicEDProducer : public edm::stream::EDProducer<edm::ExternalWork, Capabilities...> {
+public:
+  typedef typename Client::Input Input;
+  typedef typename Client::Output Output;
+
+  explicit SonicEDProducer(const edm::ParameterSet& cfg) : client_(cfg.getParameter<edm::ParameterSet>("Client")) {
+    client_.setDebugName(cfg.getParameter<std::string>("@module_label"));
+  }
+  ~SonicEDProducer() override = default;
+
+  void acquire(const edm::Event& iEvent, const edm::EventSetup& iSetup, edm::WaitingTaskWithArenaHolder holder) final {
+    acquire(iEvent, iSetup, client_.input());
+    client_.dispatch(std::move(holder));
+  }
+  // fills the input of the inference
+  virtual void acquire(const edm::Event& iEvent, const edm::EventSetup& iSetup, Input& iInput) = 0;
+
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) final { produce(iEvent, iSetup, client_.output()); }
+  // puts the products made from the output of the inference
+  virtual void produce(edm::Event& iEvent, const edm::EventSetup& iSetup, const Output& iOutput) = 0;
+
+  // the description of the client parameters, to be added by the fillDescriptions of the producers
+  static void fillPSetDescription(edm::ParameterSetDescription& desc) {
+    edm::ParameterSetDescription descClient;
+    Client::fillPSetDescription(descClient);
+    desc.add<edm::ParameterSetDescription>("Client", descClient);
+  }
+
+protected:
+  Client client_;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include "HeterogeneousCore/SonicCore/interface/SonicClientBase.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+SonicClientBase::SonicClientBase(const edm::ParameterSet& params)
+    : allowedRetries_(params.getUntrackedParameter<unsigned>("allowedRetries")),
+      localFallback_(params.getUntrackedParameter<bool>("localFallback")),
+      tries_(0) {}
+
+void SonicClientBase::dispatch(edm::WaitingTaskWithArenaHolder holder) {
+  holder_ = std::move(holder);
+  start();
+}
+
+void SonicClientBase::dispatch() {
+  promise_.emplace();
+  auto future = promise_->get_future();
+  start();
+  // rethrows the exception of a failed inference
+  future.get();
+}
+
+void SonicClientBase::start() {
+  tries_ = 0;
+  evaluate();
+}
+
+void SonicClientBase::evaluateLocal() {
+  throw cms::Exception("SonicClient") << debugName_ << ": the client has no local fallback";
+}
+
+void SonicClientBase::finish(bool success, std::exception_ptr eptr) {
+  if (!success) {
+    ++tries_;
+    if (tries_ <= allowedRetries_) {
+      edm::LogInfo("SonicClient") << debugName_ << ": retrying the inference after " << tries_ << " failed tries";
+      evaluate();
+      return;
+    }
+    if (localFallback_) {
+      edm::LogWarning("SonicClient") << debugName_ << ": the inference failed " << tries_
+                                     << " times, running it locally";
+      try {
+        evaluateLocal();
+        eptr = std::exception_ptr{};
+      } catch (...) {
+        eptr = std::current_exception();
+      }
+    } else if (!eptr) {
+      eptr = std::make_exception_ptr(cms::Exception("SonicClient")
+                                     << debugName_ << ": the inference failed " << tries_ << " times");
+    }
+  }
+  done(eptr);
+}
+
+void SonicClientBase::done(std::exception_ptr eptr) {
+  // the holder and the promise are reset before the producer is notified, since it may dispatch again right away
+  if (holder_) {
+    auto holder = std::move(*holder_);
+    holder_.reset();
+    holder.doneWaiting(eptr);
+  } else if (promise_) {
+    auto promise = std::move(*promise_);
+    promise_.reset();
+    if (eptr) {
+      promise.set_exception(eptr);
+    } else {
+      promise.set_value();
+    }
+  }
+}
+
+void SonicClientBase::fillBasePSetDescription(edm::ParameterSetDescription& desc) {
+  desc.addUntracked<unsigned>("allowedRetries", 0)->setComment("number of retries of a failed inference");
+  desc.addUntracked<bool>("localFallback", true)
+      ->setComment("run the inference locally when all the tries failed, for the clients which can");
+}
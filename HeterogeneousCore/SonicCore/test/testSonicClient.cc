@@ -0,0 +1,101 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "HeterogeneousCore/SonicCore/interface/SonicClient.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <thread>
+
+class testSonicClient : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testSonicClient);
+  CPPUNIT_TEST(checkSuccess);
+  CPPUNIT_TEST(checkRetries);
+  CPPUNIT_TEST(checkFallback);
+  CPPUNIT_TEST(checkFailure);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void checkSuccess();
+  void checkRetries();
+  void checkFallback();
+  void checkFailure();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testSonicClient);
+
+namespace {
+  edm::ParameterSet clientParams(unsigned allowedRetries, bool localFallback) {
+    edm::ParameterSet params;
+    params.addUntrackedParameter<unsigned>("allowedRetries", allowedRetries);
+    params.addUntrackedParameter<bool>("localFallback", localFallback);
+    return params;
+  }
+
+  // doubles its input on another thread, after failing the first nFailures times
+  class TestClient : public SonicClient<int> {
+  public:
+    TestClient(const edm::ParameterSet& params, int nFailures) : SonicClient<int>(params), nFailures_(nFailures) {}
+
+    int nEvaluations = 0;
+    int nLocalEvaluations = 0;
+
+  protected:
+    void evaluate() override {
+      ++nEvaluations;
+      const bool success = nEvaluations > nFailures_;
+      std::thread([this, success]() {
+        if (success)
+          output_ = 2 * input_;
+        finish(success);
+      }).detach();
+    }
+
+    void evaluateLocal() override {
+      ++nLocalEvaluations;
+      output_ = 2 * input_;
+    }
+
+  private:
+    const int nFailures_;
+  };
+}  // namespace
+
+void testSonicClient::checkSuccess() {
+  TestClient client(clientParams(0, false), 0);
+  client.input() = 21;
+  client.dispatch();
+  CPPUNIT_ASSERT(client.output() == 42);
+  CPPUNIT_ASSERT(client.nEvaluations == 1);
+
+  // the client is reused for the next event
+  client.input() = 2;
+  client.dispatch();
+  CPPUNIT_ASSERT(client.output() == 4);
+  CPPUNIT_ASSERT(client.nEvaluations == 2);
+}
+
+void testSonicClient::checkRetries() {
+  TestClient client(clientParams(2, false), 2);
+  client.input() = 21;
+  client.dispatch();
+  CPPUNIT_ASSERT(client.output() == 42);
+  CPPUNIT_ASSERT(client.nEvaluations == 3);
+  CPPUNIT_ASSERT(client.nLocalEvaluations == 0);
+}
+
+void testSonicClient::checkFallback() {
+  TestClient client(clientParams(1, true), 5);
+  client.input() = 21;
+  client.dispatch();
+  CPPUNIT_ASSERT(client.output() == 42);
+  CPPUNIT_ASSERT(client.nEvaluations == 2);
+  CPPUNIT_ASSERT(client.nLocalEvaluations == 1);
+}
+
+void testSonicClient::checkFailure() {
+  TestClient client(clientParams(1, false), 5);
+  client.input() = 21;
+  CPPUNIT_ASSERT_THROW(client.dispatch(), cms::Exception);
+  CPPUNIT_ASSERT(client.nEvaluations == 2);
+  CPPUNIT_ASSERT(client.nLocalEvaluations == 0);
+}
@@ -24,6 +24,8 @@
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/InputType.h"
 
+#include "TTreeCacheUnzip.h"
+
 #include <set>
 
 namespace edm {
@@ -60,11 +62,20 @@ namespace edm {
             << primary.id() << " has inconsistent RunAuxiliary data in the primary and secondary file\n";
       }
     }
+
+    //Must be called before the first TTreeCache is created
+    bool enableParallelUnzip(bool iEnable) {
+      if (iEnable) {
+        TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+      }
+      return iEnable;
+    }
   }  // namespace
 
   PoolSource::PoolSource(ParameterSet const& pset, InputSourceDescription const& desc)
       : InputSource(pset, desc),
         rootServiceChecker_(),
+        parallelUnzip_(enableParallelUnzip(pset.getUntrackedParameter<bool>("parallelUnzip"))),
         catalog_(pset.getUntrackedParameter<std::vector<std::string> >("fileNames"),
                  pset.getUntrackedParameter<std::string>("overrideCatalog", std::string())),
         secondaryCatalog_(
@@ -302,6 +313,10 @@ namespace edm {
         ->setComment(
             "If True: do not read a data product from the file until it is requested. If False: all event data "
             "products are read upfront.");
+    desc.addUntracked<bool>("parallelUnzip", false)
+        ->setComment(
+            "If True: the baskets brought in by the TTreeCache are decompressed concurrently as ROOT implicit MT tasks "
+            "so only the raw read and the streaming of a product stay serialized. This is a process wide ROOT setting.");
     ProductSelectorRules::fillDescription(desc, "inputCommands");
     InputSource::fillDescription(desc);
     RootPrimaryFileSequence::fillDescription(desc);
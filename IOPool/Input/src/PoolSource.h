@@ -71,6 +71,7 @@ namespace edm {
     std::pair<SharedResourcesAcquirer*, std::recursive_mutex*> resourceSharedWithDelayedReader_() override;
 
     RootServiceChecker rootServiceChecker_;
+    bool parallelUnzip_;
     InputFileCatalog catalog_;
     InputFileCatalog secondaryCatalog_;
     edm::propagate_const<std::shared_ptr<RunPrincipal>> secondaryRunPrincipal_;
@@ -3,6 +3,7 @@
 
 #include "RootDelayedReader.h"
 #include "InputFile.h"
+#include "SecondaryProductCache.h"
 #include "DataFormats/Common/interface/EDProductGetter.h"
 #include "DataFormats/Common/interface/RefCoreStreamer.h"
 
@@ -14,6 +15,7 @@
 #include "FWCore/Utilities/interface/EDMException.h"
 
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TClass.h"
 
 #include <cassert>
@@ -76,10 +78,20 @@ namespace edm {
     }
     void* p = cp->New();
     std::unique_ptr<WrapperBase> edp = getWrapperBasePtr(p, branchInfo->offsetToWrapperBase_);
+    //Run and Lumi only have 1 entry number, which is index 0
+    EntryNumber entry = tree_.entryNumberForIndex(tree_.branchType() == InEvent ? ep->transitionIndex() : 0);
+    bool const useCache = productCache_ and tree_.branchType() == InEvent;
+    if (useCache) {
+      auto cached = productCache_->find(fileID_, entry, k);
+      if (cached) {
+        TBufferFile buffer(TBuffer::kRead, cached->size(), const_cast<char*>(cached->data()), kFALSE);
+        cp->Streamer(p, buffer);
+        return edp;
+      }
+    }
     br->SetAddress(&p);
     try {
-      //Run and Lumi only have 1 entry number, which is index 0
-      tree_.getEntry(br, tree_.entryNumberForIndex(tree_.branchType() == InEvent ? ep->transitionIndex() : 0));
+      tree_.getEntry(br, entry);
     } catch (edm::Exception& exception) {
       exception.addContext("Rethrowing an exception that happened on a different thread.");
       lastException_ = std::current_exception();
@@ -93,6 +105,14 @@ namespace edm {
       // CMS-THREADING For the primary input source calls to this function need to be serialized
       InputFile::reportReadBranch(inputType_, std::string(br->GetName()));
     }
+    //another stream may have read and cached the same product meanwhile
+    if (useCache and not productCache_->contains(fileID_, entry, k)) {
+      //streaming the product back out is cheaper than reading and decompressing it again
+      TBufferFile buffer(TBuffer::kWrite);
+      cp->Streamer(p, buffer);
+      auto bytes = std::make_shared<std::vector<char> const>(buffer.Buffer(), buffer.Buffer() + buffer.Length());
+      productCache_->insert(fileID_, entry, k, std::move(bytes));
+    }
     return edp;
   }
 }  // namespace edm
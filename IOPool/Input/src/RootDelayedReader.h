@@ -23,6 +23,7 @@ class TClass;
 namespace edm {
   class InputFile;
   class RootTree;
+  class SecondaryProductCache;
   class SharedResourcesAcquirer;
   class Exception;
 
@@ -58,6 +59,12 @@ namespace edm {
       postEventReadFromSourceSignal_ = postEventReadSource;
     }
 
+    /// Event products are then looked up in, and added to, cache using the GUID of the file fileID
+    void setProductCache(std::shared_ptr<SecondaryProductCache> cache, std::string const& fileID) {
+      productCache_ = std::move(cache);
+      fileID_ = fileID;
+    }
+
   private:
     std::unique_ptr<WrapperBase> getProduct_(BranchID const& k, EDProductGetter const* ep) override;
     void mergeReaders_(DelayedReader* other) override { nextReader_ = other; }
@@ -76,6 +83,8 @@ namespace edm {
     std::shared_ptr<std::recursive_mutex> mutex_;
     InputType inputType_;
     edm::propagate_const<TClass*> wrapperBaseTClass_;
+    std::shared_ptr<SecondaryProductCache> productCache_;
+    std::string fileID_;
 
     signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* preEventReadFromSourceSignal_ =
         nullptr;
@@ -5,6 +5,7 @@
 #include "RootFile.h"
 #include "RootEmbeddedFileSequence.h"
 #include "RootTree.h"
+#include "SecondaryProductCache.h"
 
 #include "DataFormats/Provenance/interface/BranchID.h"
 #include "DataFormats/Provenance/interface/BranchIDListHelper.h"
@@ -12,6 +13,7 @@
 #include "FWCore/Catalog/interface/InputFileCatalog.h"
 #include "FWCore/Catalog/interface/SiteLocalConfig.h"
 #include "FWCore/Framework/interface/InputSource.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
@@ -43,7 +45,8 @@ namespace edm {
         initialNumberOfEventsToSkip_(pset.getUntrackedParameter<unsigned int>("skipEvents", 0U)),
         treeCacheSize_(pset.getUntrackedParameter<unsigned int>("cacheSize", roottree::defaultCacheSize)),
         enablePrefetching_(false),
-        enforceGUIDInFileName_(pset.getUntrackedParameter<bool>("enforceGUIDInFileName", false)) {
+        enforceGUIDInFileName_(pset.getUntrackedParameter<bool>("enforceGUIDInFileName", false)),
+        productCache_() {
     if (noFiles()) {
       throw Exception(errors::NoSecondaryFiles)
           << "RootEmbeddedFileSequence no input files specified for secondary input source.\n";
@@ -58,6 +61,12 @@ namespace edm {
       enablePrefetching_ = pSLC->enablePrefetching();
     }
 
+    // The cache is shared with the other secondary sources so an event drawn by several streams is only read once.
+    unsigned int productCacheEvents = pset.getUntrackedParameter<unsigned int>("productCacheEvents", 0U);
+    if (productCacheEvents != 0U) {
+      productCache_ = SecondaryProductCache::instance(productCacheEvents);
+    }
+
     // Set the pointer to the function that reads an event.
     if (sameLumiBlock_) {
       if (sequential_) {
@@ -108,7 +117,15 @@ namespace edm {
 
   RootEmbeddedFileSequence::~RootEmbeddedFileSequence() {}
 
-  void RootEmbeddedFileSequence::endJob() { closeFile_(); }
+  void RootEmbeddedFileSequence::endJob() {
+    closeFile_();
+    if (productCache_ and productCache_->reportAtEndJob()) {
+      LogInfo("SecondaryProductCache") << "The products of the secondary events were found " << productCache_->hits()
+                                       << " times in the cache of " << productCache_->maxEvents()
+                                       << " events, and read from the files " << productCache_->misses()
+                                       << " times.";
+    }
+  }
 
   void RootEmbeddedFileSequence::closeFile_() {
     // delete the RootFile object.
@@ -124,23 +141,27 @@ namespace edm {
   RootEmbeddedFileSequence::RootFileSharedPtr RootEmbeddedFileSequence::makeRootFile(
       std::shared_ptr<InputFile> filePtr) {
     size_t currentIndexIntoFile = sequenceNumberOfFile();
-    return std::make_shared<RootFile>(fileName(),
-                                      ProcessConfiguration(),
-                                      logicalFileName(),
-                                      filePtr,
-                                      input_.nStreams(),
-                                      treeCacheSize_,
-                                      input_.treeMaxVirtualSize(),
-                                      input_.runHelper(),
-                                      input_.productSelectorRules(),
-                                      InputType::SecondarySource,
-                                      input_.processHistoryRegistryForUpdate(),
-                                      indexesIntoFiles(),
-                                      currentIndexIntoFile,
-                                      orderedProcessHistoryIDs_,
-                                      input_.bypassVersionCheck(),
-                                      enablePrefetching_,
-                                      enforceGUIDInFileName_);
+    auto file = std::make_shared<RootFile>(fileName(),
+                                           ProcessConfiguration(),
+                                           logicalFileName(),
+                                           filePtr,
+                                           input_.nStreams(),
+                                           treeCacheSize_,
+                                           input_.treeMaxVirtualSize(),
+                                           input_.runHelper(),
+                                           input_.productSelectorRules(),
+                                           InputType::SecondarySource,
+                                           input_.processHistoryRegistryForUpdate(),
+                                           indexesIntoFiles(),
+                                           currentIndexIntoFile,
+                                           orderedProcessHistoryIDs_,
+                                           input_.bypassVersionCheck(),
+                                           enablePrefetching_,
+                                           enforceGUIDInFileName_);
+    if (productCache_) {
+      file->setProductCache(productCache_);
+    }
+    return file;
   }
 
   void RootEmbeddedFileSequence::skipEntries(unsigned int offset) {
@@ -342,5 +363,10 @@ namespace edm {
         ->setComment(
             "True:  file name part is required to be equal to the GUID of the file\n"
             "False: file name can be anything");
+    desc.addUntracked<unsigned int>("productCacheEvents", 0U)
+        ->setComment(
+            "Maximum number of secondary events whose products are kept in memory, uncompressed, in a cache shared by "
+            "all secondary sources of the process. Events drawn again are then read from the cache instead of the "
+            "file. 0 disables the cache.");
   }
 }  // namespace edm
@@ -28,6 +28,7 @@ namespace edm {
   class ParameterSetDescription;
   class EmbeddedRootSource;
   class RootFile;
+  class SecondaryProductCache;
 
   class RootEmbeddedFileSequence : public RootInputFileSequence {
   public:
@@ -71,6 +72,7 @@ namespace edm {
     unsigned int treeCacheSize_;
     bool enablePrefetching_;
     bool enforceGUIDInFileName_;
+    std::shared_ptr<SecondaryProductCache> productCache_;
   };  // class RootEmbeddedFileSequence
 }  // namespace edm
 #endif
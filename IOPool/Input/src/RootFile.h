@@ -49,6 +49,7 @@ namespace edm {
   class ProvenanceAdaptor;
   class StoredMergeableRunProductMetadata;
   class RunHelperBase;
+  class SecondaryProductCache;
   class ThinnedAssociationsHelper;
 
   typedef std::map<EntryDescriptionID, EventEntryDescription> EntryDescriptionMap;
@@ -221,6 +222,10 @@ namespace edm {
     RootTree const& eventTree() const { return eventTree_; }
     RootTree const& lumiTree() const { return lumiTree_; }
     RootTree const& runTree() const { return runTree_; }
+    void setClusterPrefetch(unsigned int nClusters) { eventTree_.setClusterPrefetch(nClusters); }
+    void setProductCache(std::shared_ptr<SecondaryProductCache> cache) {
+      eventTree_.setProductCache(std::move(cache), fid_.fid());
+    }
     FileFormatVersion fileFormatVersion() const { return fileFormatVersion_; }
     int whyNotFastClonable() const { return whyNotFastClonable_; }
     std::array<bool, NumBranchTypes> const& hasNewlyDroppedBranch() const { return hasNewlyDroppedBranch_; }
@@ -30,6 +30,7 @@ namespace edm {
         initialNumberOfEventsToSkip_(pset.getUntrackedParameter<unsigned int>("skipEvents")),
         noEventSort_(pset.getUntrackedParameter<bool>("noEventSort")),
         treeCacheSize_(noEventSort_ ? pset.getUntrackedParameter<unsigned int>("cacheSize") : 0U),
+        numberOfClustersToPrefetch_(pset.getUntrackedParameter<unsigned int>("numberOfClustersToPrefetch")),
         duplicateChecker_(new DuplicateChecker(pset)),
         usingGoToEvent_(false),
         enablePrefetching_(false),
@@ -110,7 +111,7 @@ namespace edm {
 
   RootPrimaryFileSequence::RootFileSharedPtr RootPrimaryFileSequence::makeRootFile(std::shared_ptr<InputFile> filePtr) {
     size_t currentIndexIntoFile = sequenceNumberOfFile();
-    return std::make_shared<RootFile>(fileName(),
+    auto file = std::make_shared<RootFile>(fileName(),
                                       input_.processConfiguration(),
                                       logicalFileName(),
                                       filePtr,
@@ -140,6 +141,8 @@ namespace edm {
                                       usingGoToEvent_,
                                       enablePrefetching_,
                                       enforceGUIDInFileName_);
+    file->setClusterPrefetch(numberOfClustersToPrefetch_);
+    return file;
   }
 
   bool RootPrimaryFileSequence::nextFile() {
@@ -320,6 +323,11 @@ namespace edm {
             "Note 3: Any sorting occurs independently in each input file (no sorting across input files).");
     desc.addUntracked<unsigned int>("cacheSize", roottree::defaultCacheSize)
         ->setComment("Size of ROOT TTree prefetch cache.  Affects performance.");
+    desc.addUntracked<unsigned int>("numberOfClustersToPrefetch", 0)
+        ->setComment(
+            "If not zero, the TTreeCache of the Events tree reads whole TTree clusters and is made large enough to "
+            "hold this many clusters, so the data for the next events of all streams comes in a few large reads. "
+            "Only has an effect if 'cacheSize' is not zero.");
     std::string defaultString("permissive");
     desc.addUntracked<std::string>("branchesMustMatch", defaultString)
         ->setComment(
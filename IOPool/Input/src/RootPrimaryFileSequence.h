@@ -74,6 +74,7 @@ namespace edm {
     int initialNumberOfEventsToSkip_;
     bool noEventSort_;
     unsigned int treeCacheSize_;
+    unsigned int const numberOfClustersToPrefetch_;
     edm::propagate_const<std::shared_ptr<DuplicateChecker>> duplicateChecker_;
     bool usingGoToEvent_;
     bool enablePrefetching_;
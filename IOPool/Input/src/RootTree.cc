@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <limits>
 
 namespace edm {
   namespace {
@@ -186,6 +187,25 @@ namespace edm {
     rawTreeCache_.reset();
   }
 
+  void RootTree::setClusterPrefetch(unsigned int nClusters) {
+    if (nClusters == 0 or cacheSize_ == 0 or not treeCache_) {
+      return;
+    }
+    tree_->SetClusterPrefetch(true);
+    // The "+1" is here to avoid divide-by-zero in degenerate cases.
+    Long64_t averageEventSizeBytes = tree_->GetZipBytes() / (tree_->GetEntries() + 1) + 1;
+    Long64_t neededSize = averageEventSizeBytes * treeAutoFlush_ * nClusters;
+    constexpr Long64_t maxSize = std::numeric_limits<Int_t>::max();
+    if (neededSize > maxSize) {
+      neededSize = maxSize;
+    }
+    if (neededSize > static_cast<Long64_t>(cacheSize_)) {
+      cacheSize_ = neededSize;
+      //resizing keeps what the cache has already learned
+      treeCache_->SetBufferSize(static_cast<Int_t>(cacheSize_));
+    }
+  }
+
   void RootTree::setTreeMaxVirtualSize(int treeMaxVirtualSize) {
     if (treeMaxVirtualSize >= 0)
       tree_->SetMaxVirtualSize(static_cast<Long64_t>(treeMaxVirtualSize));
@@ -492,6 +512,10 @@ namespace edm {
     rootDelayedReader_->setSignals(preEventReadSource, postEventReadSource);
   }
 
+  void RootTree::setProductCache(std::shared_ptr<SecondaryProductCache> cache, std::string const& fileID) {
+    rootDelayedReader_->setProductCache(std::move(cache), fileID);
+  }
+
   namespace roottree {
     Int_t getEntry(TBranch* branch, EntryNumber entryNumber) {
       Int_t n = 0;
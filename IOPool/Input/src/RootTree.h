@@ -33,6 +33,7 @@ namespace edm {
   class BranchKey;
   class RootDelayedReader;
   class InputFile;
+  class SecondaryProductCache;
   class RootTree;
 
   class StreamContext;
@@ -195,10 +196,16 @@ namespace edm {
 
     BranchType branchType() const { return branchType_; }
 
+    /// Makes the TTreeCache read the baskets of whole clusters and enlarges it to hold nClusters of them
+    void setClusterPrefetch(unsigned int nClusters);
+
     void setSignals(
         signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* preEventReadSource,
         signalslot::Signal<void(StreamContext const&, ModuleCallingContext const&)> const* postEventReadSource);
 
+    /// Products read by the delayed reader are kept in cache, identified by fileID
+    void setProductCache(std::shared_ptr<SecondaryProductCache> cache, std::string const& fileID);
+
   private:
     void setCacheSize(unsigned int cacheSize);
     void setTreeMaxVirtualSize(int treeMaxVirtualSize);
@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------
+----------------------------------------------------------------------*/
+
+#include "SecondaryProductCache.h"
+
+#include <algorithm>
+
+namespace edm {
+
+  SecondaryProductCache::SecondaryProductCache(unsigned int maxEvents)
+      : mutex_(), maxEvents_(maxEvents), lru_(), events_(), hits_(0), misses_(0), reported_(false) {}
+
+  std::shared_ptr<SecondaryProductCache> SecondaryProductCache::instance(unsigned int maxEvents) {
+    // The cache only lives as long as the sources using it.
+    static std::mutex s_mutex;
+    static std::weak_ptr<SecondaryProductCache> s_cache;
+    std::lock_guard<std::mutex> guard(s_mutex);
+    auto cache = s_cache.lock();
+    if (cache) {
+      cache->setMaxEvents(maxEvents);
+    } else {
+      cache = std::make_shared<SecondaryProductCache>(maxEvents);
+      s_cache = cache;
+    }
+    return cache;
+  }
+
+  std::shared_ptr<SecondaryProductCache::Buffer const> SecondaryProductCache::find(std::string const& fileID,
+                                                                                  EntryNumber entry,
+                                                                                  BranchID const& branchID) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto itEvent = events_.find(EventKey(fileID, entry));
+    if (itEvent != events_.end()) {
+      auto& event = itEvent->second;
+      lru_.splice(lru_.begin(), lru_, event.lruPosition_);
+      auto itProduct = event.products_.find(branchID);
+      if (itProduct != event.products_.end()) {
+        ++hits_;
+        return itProduct->second;
+      }
+    }
+    ++misses_;
+    return std::shared_ptr<Buffer const>();
+  }
+
+  bool SecondaryProductCache::contains(std::string const& fileID, EntryNumber entry, BranchID const& branchID) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto itEvent = events_.find(EventKey(fileID, entry));
+    return itEvent != events_.end() and itEvent->second.products_.count(branchID) != 0;
+  }
+
+  void SecondaryProductCache::insert(std::string const& fileID,
+                                     EntryNumber entry,
+                                     BranchID const& branchID,
+                                     std::shared_ptr<Buffer const> buffer) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    EventKey key(fileID, entry);
+    auto itEvent = events_.find(key);
+    if (itEvent == events_.end()) {
+      lru_.push_front(key);
+      itEvent = events_.emplace(std::move(key), CachedEvent()).first;
+      itEvent->second.lruPosition_ = lru_.begin();
+    } else {
+      lru_.splice(lru_.begin(), lru_, itEvent->second.lruPosition_);
+    }
+    itEvent->second.products_[branchID] = std::move(buffer);
+    evict();
+  }
+
+  void SecondaryProductCache::setMaxEvents(unsigned int maxEvents) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    maxEvents_ = std::max(maxEvents_.load(), maxEvents);
+  }
+
+  void SecondaryProductCache::evict() {
+    // the caller holds the lock
+    while (events_.size() > maxEvents_) {
+      events_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+}  // namespace edm
@@ -0,0 +1,84 @@
+#ifndef IOPool_Input_SecondaryProductCache_h
+#define IOPool_Input_SecondaryProductCache_h
+
+/*----------------------------------------------------------------------
+
+SecondaryProductCache: Bounded LRU of the products of secondary (pileup)
+events, shared by all EmbeddedRootSources of the process.
+
+The products are kept in their streamed but uncompressed form, keyed by
+the GUID of the file, the entry number in the Events tree and the BranchID.
+Reading a product again from the cache then avoids the file access and the
+decompression of the baskets. The product is still streamed into a new
+object for each use so the Refs it contains are bound to the EventPrincipal
+it is read into.
+
+Events are evicted in least recently used order once more than maxEvents
+events are cached. The hits and misses of find() are reported once, at
+the end of the job, by the first of the sources sharing the cache.
+
+----------------------------------------------------------------------*/
+
+#include "DataFormats/Provenance/interface/BranchID.h"
+#include "DataFormats/Provenance/interface/IndexIntoFile.h"
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace edm {
+
+  class SecondaryProductCache {
+  public:
+    typedef IndexIntoFile::EntryNumber_t EntryNumber;
+    typedef std::vector<char> Buffer;
+
+    explicit SecondaryProductCache(unsigned int maxEvents);
+
+    SecondaryProductCache(SecondaryProductCache const&) = delete;             // Disallow copying and moving
+    SecondaryProductCache& operator=(SecondaryProductCache const&) = delete;  // Disallow copying and moving
+
+    /// returns the cache of the process, enlarged to hold at least maxEvents events
+    static std::shared_ptr<SecondaryProductCache> instance(unsigned int maxEvents);
+
+    /// returns a null pointer if the product is not cached
+    std::shared_ptr<Buffer const> find(std::string const& fileID, EntryNumber entry, BranchID const& branchID);
+    /// as find(), without counting a hit or a miss nor moving the event in the LRU
+    bool contains(std::string const& fileID, EntryNumber entry, BranchID const& branchID);
+    void insert(std::string const& fileID,
+                EntryNumber entry,
+                BranchID const& branchID,
+                std::shared_ptr<Buffer const> buffer);
+
+    unsigned int maxEvents() const { return maxEvents_; }
+    unsigned long long hits() const { return hits_; }
+    unsigned long long misses() const { return misses_; }
+    /// true for the first call only, so that the sources sharing the cache report its use once
+    bool reportAtEndJob() { return not reported_.exchange(true); }
+
+  private:
+    typedef std::pair<std::string, EntryNumber> EventKey;
+    struct CachedEvent {
+      std::map<BranchID, std::shared_ptr<Buffer const>> products_;
+      std::list<EventKey>::iterator lruPosition_;
+    };
+
+    void setMaxEvents(unsigned int maxEvents);
+    void evict();
+
+    std::mutex mutex_;
+    std::atomic<unsigned int> maxEvents_;
+    // most recently used event first
+    std::list<EventKey> lru_;
+    std::map<EventKey, CachedEvent> events_;
+    std::atomic<unsigned long long> hits_;
+    std::atomic<unsigned long long> misses_;
+    std::atomic<bool> reported_;
+  };
+}  // namespace edm
+#endif
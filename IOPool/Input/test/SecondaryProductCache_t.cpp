@@ -0,0 +1,51 @@
+// The cache of the secondary events: products found, counted and evicted in least recently used order
+#include "IOPool/Input/src/SecondaryProductCache.h"
+
+#include <iostream>
+#include <memory>
+
+namespace {
+  int failures = 0;
+
+  void check(bool condition, const char* what) {
+    if (not condition) {
+      std::cerr << "failed: " << what << std::endl;
+      ++failures;
+    }
+  }
+
+  std::shared_ptr<edm::SecondaryProductCache::Buffer const> buffer(char c) {
+    return std::make_shared<edm::SecondaryProductCache::Buffer const>(3, c);
+  }
+}  // namespace
+
+int main() {
+  edm::BranchID const b1(1), b2(2);
+  edm::SecondaryProductCache cache(2);
+
+  check(not cache.find("A", 0, b1), "empty cache");
+  cache.insert("A", 0, b1, buffer('a'));
+  cache.insert("A", 0, b2, buffer('b'));
+  cache.insert("B", 0, b1, buffer('c'));
+  check(cache.contains("A", 0, b2) and not cache.contains("A", 1, b1), "contains");
+  check(cache.hits() == 0 and cache.misses() == 1, "contains does not count");
+
+  auto found = cache.find("A", 0, b2);
+  check(found and *found == edm::SecondaryProductCache::Buffer(3, 'b'), "product of a cached event");
+  check(not cache.find("A", 0, edm::BranchID(3)), "other product of a cached event");
+  check(not cache.find("B", 1, b1), "other entry of a cached file");
+
+  // ("A", 0) was used last, so the third event evicts ("B", 0)
+  cache.insert("C", 0, b1, buffer('d'));
+  check(cache.contains("A", 0, b1) and cache.contains("C", 0, b1), "recently used events are kept");
+  check(not cache.contains("B", 0, b1), "the least recently used event is evicted");
+  check(cache.hits() == 1 and cache.misses() == 3, "hits and misses");
+
+  // the cache of the process is shared, with the largest size asked for
+  auto shared = edm::SecondaryProductCache::instance(1);
+  check(edm::SecondaryProductCache::instance(3) == shared and shared->maxEvents() == 3, "shared cache");
+  check(shared->reportAtEndJob() and not shared->reportAtEndJob(), "reported once");
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -22,6 +22,8 @@ cp PoolInputTest.root PoolInputOther.root
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolInputTest_cfg.py || die 'Failure using PoolInputTest_cfg.py' $?
 cmsRun  ${LOCAL_TEST_DIR}/PoolInputTest_noDelay_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt || die 'Failure using PoolInputTest_noDelay_cfg.py' $?
 grep 'event delayed read from source' ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt && die 'Failure in PoolInputTest_noDelay_cfg.py, found delay reads from source' 1
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_parallelUnzip_cfg.py || die 'Failure using PoolInputTest_parallelUnzip_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PoolInputTest_clusterPrefetch_cfg.py || die 'Failure using PoolInputTest_clusterPrefetch_cfg.py' $?
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolInputTest_skip_with_failure_cfg.py || die 'Failure using PoolInputTest_skip_with_failure_cfg.py' $?
 
 cmsRun ${LOCAL_TEST_DIR}/PrePool2FileInputTest_cfg.py || die 'Failure using PrePool2FileInputTest_cfg.py' $?
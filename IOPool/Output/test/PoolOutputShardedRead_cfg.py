@@ -0,0 +1,17 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUTREAD")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:PoolOutputShardedTest_0.root',
+                                      'file:PoolOutputShardedTest_1.root'),
+    duplicateCheckMode = cms.untracked.string('checkAllFilesOpened')
+)
+
+process.check = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.p = cms.Path(process.check)
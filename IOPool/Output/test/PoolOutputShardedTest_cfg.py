@@ -0,0 +1,39 @@
+# Writes the events to two independent output files, each stream
+# always going to the same file. Each shard is a complete EDM file
+# with its own runs, lumis and provenance so the shards can be read
+# together or merged like any other set of files.
+# The two output modules have their own serial queues, so the events
+# of different shards are written concurrently.
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUT")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(4)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(20)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+
+nShards = 2
+for shard in range(nShards):
+    shardFilter = cms.EDFilter("ModuloStreamIDFilter",
+        modulo = cms.uint32(nShards),
+        offset = cms.uint32(shard)
+    )
+    output = cms.OutputModule("PoolOutputModule",
+        fileName = cms.untracked.string('file:PoolOutputShardedTest_%d.root' % shard)
+    )
+    setattr(process, "shardFilter%d" % shard, shardFilter)
+    setattr(process, "output%d" % shard, output)
+    setattr(process, "ep%d" % shard, cms.EndPath(shardFilter*output))
@@ -12,6 +12,10 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolMissingTest_cfg.py || die 'Failure
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolOutputRead_cfg.py || die 'Failure using PoolOutputRead_cfg.py' $?
 
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputShardedTest_cfg.py || die 'Failure using PoolOutputShardedTest_cfg.py' $?
+#reads files from above
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputShardedRead_cfg.py || die 'Failure using PoolOutputShardedRead_cfg.py' $?
+
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolDropRead_cfg.py || die 'Failure using PoolDropRead_cfg.py' $?
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolMissingRead_cfg.py || die 'Failure using PoolMissingRead_cfg.py' $?
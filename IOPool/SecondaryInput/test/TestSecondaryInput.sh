@@ -10,6 +10,8 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/PreSecondaryInputTest_cfg.py || die 'Fa
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/SecondaryInputTest_cfg.py || die 'Failure using SecondaryInputTest_cfg.py' $?
 
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/SecondaryCachedInputTest_cfg.py || die 'Failure using SecondaryCachedInputTest_cfg.py' $?
+
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/SecondarySeqInputTest_cfg.py || die 'Failure using SecondarySeqInputTest_cfg.py' $?
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/SecondaryInLumiInputTest_cfg.py || die 'Failure using SecondaryInLumiInputTest_cfg.py' $?
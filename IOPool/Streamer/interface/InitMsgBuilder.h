@@ -19,7 +19,8 @@ public:
                  const Strings& hlt_names,
                  const Strings& hlt_selections,
                  const Strings& l1_names,
-                 uint32 adler32_chksum);
+                 uint32 adler32_chksum,
+                 const std::vector<unsigned char>& compression_dictionary);
 
   uint8* startAddress() const { return buf_; }
   void setDataLength(uint32 registry_length);
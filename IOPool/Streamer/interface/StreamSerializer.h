@@ -11,6 +11,7 @@
 #include "TBufferFile.h"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "DataFormats/Provenance/interface/BranchIDList.h"
@@ -18,7 +19,20 @@
 #include "DataFormats/Provenance/interface/SelectedProducts.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
+
+struct ZSTDCompressionDeleter {
+  void operator()(ZSTD_CCtx_s *) const;
+  void operator()(ZSTD_CDict_s *) const;
+};
+
 // Data structure to be shared by all output modules for event serialization
+//
+// Both comp_buf_ and the memory used by rootbuf_ start with reserve_size bytes of
+// headroom. The event message header can therefore be placed directly in front of
+// the serialized (and possibly compressed) event, whichever buffer holds it, and
+// the event data never has to be copied to build the message.
 struct SerializeDataBuffer {
   typedef std::vector<char> SBuffer;
   static constexpr int init_size = 0;  //will be allocated on first event
@@ -28,10 +42,14 @@ struct SerializeDataBuffer {
       : comp_buf_(reserve_size + init_size),
         curr_event_size_(),
         curr_space_used_(),
-        rootbuf_(TBuffer::kWrite, init_size),
+        rootbuf_(TBuffer::kWrite, init_size, allocateWithHeadroom(init_size), kFALSE, &reallocWithHeadroom),
         ptr_((unsigned char *)rootbuf_.Buffer()),
         header_buf_(),
         adler32_chksum_(0) {}
+  ~SerializeDataBuffer();
+
+  SerializeDataBuffer(SerializeDataBuffer const &) = delete;
+  SerializeDataBuffer &operator=(SerializeDataBuffer const &) = delete;
 
   // This object caches the results of the last INIT or event
   // serialization operation.  You get access to the data using the
@@ -50,6 +68,10 @@ struct SerializeDataBuffer {
     rootbuf_.Expand(init_size);  //shrink TBuffer to size 0 after resetting TBuffer length
   }
 
+  // used as the memory management of rootbuf_, keeps reserve_size bytes in front of the TBuffer
+  static char *allocateWithHeadroom(size_t iSize);
+  static char *reallocWithHeadroom(char *iCurrent, size_t iNewSize, size_t iOldSize);
+
   std::vector<unsigned char> comp_buf_;  // space for compressed data
   unsigned int curr_event_size_;
   unsigned int curr_space_used_;  // less than curr_event_size_ if compressed
@@ -57,6 +79,7 @@ struct SerializeDataBuffer {
   edm::propagate_const<unsigned char *> ptr_;  // set to the place where the last event stored
   SBuffer header_buf_;                         // place for INIT message creation and streamer event header
   uint32_t adler32_chksum_;                    // adler32 check sum for the (compressed) data
+  std::unique_ptr<ZSTD_CCtx_s, ZSTDCompressionDeleter> zstd_context_;  // reused for ZSTD compression
 };
 
 class EventMsgBuilder;
@@ -83,6 +106,20 @@ namespace edm {
                        int compression_level,
                        unsigned int reserveSize) const;
 
+    /**
+     * Sets the dictionary used for ZSTD compression of the events. The
+     * same dictionary must be stored in the INIT message for the events
+     * to be readable.
+     */
+    void setCompressionDictionary(std::vector<unsigned char> const &dictionary, int compressionLevel);
+
+    /**
+     * Events whose serialized size is at least minEventSize are
+     * compressed by nThreads threads when using LZMA or ZSTD.
+     * 0 threads means compressing on the calling thread only.
+     */
+    void setCompressionThreads(unsigned int nThreads, unsigned int minEventSize);
+
     /**
      * Compresses the data in the specified input buffer into the
      * specified output buffer.  Returns the size of the compressed data
@@ -99,18 +136,29 @@ namespace edm {
                                            std::vector<unsigned char> &outputBuffer,
                                            int compressionLevel,
                                            unsigned int reserveSize,
-                                           bool addHeader = true);
+                                           bool addHeader = true,
+                                           unsigned int nThreads = 0);
 
+    /**
+     * If context is given the compression reuses it and can use a
+     * dictionary and several threads.
+     */
     static unsigned int compressBufferZSTD(unsigned char *inputBuffer,
                                            unsigned int inputSize,
                                            std::vector<unsigned char> &outputBuffer,
                                            int compressionLevel,
                                            unsigned int reserveSize,
-                                           bool addHeader = true);
+                                           bool addHeader = true,
+                                           ZSTD_CCtx_s *context = nullptr,
+                                           ZSTD_CDict_s const *dictionary = nullptr,
+                                           unsigned int nThreads = 0);
 
   private:
     SelectedProducts const *selections_;
     edm::propagate_const<TClass *> tc_;
+    std::unique_ptr<ZSTD_CDict_s, ZSTDCompressionDeleter> compressionDictionary_;
+    unsigned int compressionThreads_ = 0;
+    unsigned int minEventSizeForThreads_ = 0;
   };
 
 }  // namespace edm
@@ -18,16 +18,20 @@ namespace edm {
   class FileCatalogItem;
   class StreamerInputFile {
   public:
-    /**Reads a Streamer file */
+    /**Reads a Streamer file
+       If memoryMapped is true local files are mapped into memory and the
+       event records point directly into the mapping instead of being copied */
     explicit StreamerInputFile(std::string const& name,
                                std::string const& LFN,
-                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+                               bool memoryMapped = false);
     explicit StreamerInputFile(std::string const& name,
                                std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
 
     /** Multiple Streamer files */
     explicit StreamerInputFile(std::vector<FileCatalogItem> const& names,
-                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>());
+                               std::shared_ptr<EventSkipperByID> eventSkipperByID = std::shared_ptr<EventSkipperByID>(),
+                               bool memoryMapped = false);
 
     ~StreamerInputFile();
 
@@ -51,6 +55,9 @@ namespace edm {
 
   private:
     void openStreamerFile(std::string const& name, std::string const& LFN);
+    bool mapStreamerFile(std::string const& name);
+    void unmapStreamerFile();
+    void releaseMappedPages();
     IOSize readBytes(char* buf, IOSize nBytes);
     IOOffset skipBytes(IOSize nBytes);
 
@@ -85,6 +92,12 @@ namespace edm {
     edm::propagate_const<std::unique_ptr<Storage>> storage_;
 
     bool endOfFile_;
+
+    bool memoryMapped_;       /** use mapFile_ instead of storage_ for local files */
+    char* mapFile_;           /** start of the mapped file, nullptr if not mapped */
+    IOOffset mapSize_;        /** size of the mapped file */
+    IOOffset mapPosition_;    /** offset of the next byte to be read */
+    IOOffset mapReleasedTo_;  /** pages before this offset were given back to the kernel */
   };
 }  // namespace edm
 
@@ -22,6 +22,8 @@
 
 class InitMsgView;
 class EventMsgView;
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
 
 namespace edm {
   class BranchIDListHelper;
@@ -75,11 +77,17 @@ namespace edm {
                                              unsigned int expectedFullSize,
                                              bool hasHeader = true);
 
+    /**
+     * If context and dictionary are given the data is uncompressed
+     * using the dictionary it was compressed with.
+     */
     static unsigned int uncompressBufferZSTD(unsigned char* inputBuffer,
                                              unsigned int inputSize,
                                              std::vector<unsigned char>& outputBuffer,
                                              unsigned int expectedFullSize,
-                                             bool hasHeader = true);
+                                             bool hasHeader = true,
+                                             ZSTD_DCtx_s* context = nullptr,
+                                             ZSTD_DDict_s const* dictionary = nullptr);
 
   protected:
     static void declareStreamers(SendDescs const& descs);
@@ -107,6 +115,11 @@ namespace edm {
       EventPrincipal const* eventPrincipal_;
     };
 
+    struct ZSTDDeleter {
+      void operator()(ZSTD_DCtx_s*) const;
+      void operator()(ZSTD_DDict_s*) const;
+    };
+
     void read(EventPrincipal& eventPrincipal) override;
 
     void setRun(RunNumber_t r) override;
@@ -121,6 +134,10 @@ namespace edm {
 
     std::string processName_;
     unsigned int protocolVersion_;
+
+    // from the last INIT message, used for ZSTD compressed events
+    std::unique_ptr<ZSTD_DDict_s, ZSTDDeleter> compressionDictionary_;
+    std::unique_ptr<ZSTD_DCtx_s, ZSTDDeleter> zstdContext_;
   };  //end-of-class-def
 }  // namespace edm
 
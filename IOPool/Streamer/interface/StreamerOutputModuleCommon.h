@@ -53,6 +53,7 @@ namespace edm {
     int compressionLevel_;
 
     StreamerCompressionAlgo compressionAlgo_;
+    std::vector<unsigned char> compressionDictionary_;
 
     // test luminosity sections
     int lumiSectionInterval_;
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
 #include <unistd.h>
 
 InitMsgBuilder::InitMsgBuilder(void* buf,
@@ -17,7 +18,8 @@ InitMsgBuilder::InitMsgBuilder(void* buf,
                                const Strings& hlt_names,
                                const Strings& hlt_selections,
                                const Strings& l1_names,
-                               uint32 adler_chksum)
+                               uint32 adler_chksum,
+                               const std::vector<unsigned char>& compression_dictionary)
     : buf_((uint8*)buf), size_(size) {
   InitHeader* h = (InitHeader*)buf_;
   // fixed length parts
@@ -60,6 +62,11 @@ InitMsgBuilder::InitMsgBuilder(void* buf,
   convert(adler_chksum, pos);
   pos = pos + sizeof(uint32);
 
+  // dictionary used to compress the events, empty if none
+  convert((uint32)compression_dictionary.size(), pos);
+  pos = pos + sizeof(uint32);
+  pos = std::copy(compression_dictionary.begin(), compression_dictionary.end(), pos);
+
   data_addr_ = pos + sizeof(char_uint32);
   setDataLength(0);
 
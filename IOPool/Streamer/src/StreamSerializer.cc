@@ -28,8 +28,31 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <new>
 #include <vector>
 
+void ZSTDCompressionDeleter::operator()(ZSTD_CCtx_s *iContext) const { ZSTD_freeCCtx(iContext); }
+void ZSTDCompressionDeleter::operator()(ZSTD_CDict_s *iDictionary) const { ZSTD_freeCDict(iDictionary); }
+
+SerializeDataBuffer::~SerializeDataBuffer() { std::free(rootbuf_.Buffer() - reserve_size); }
+
+char *SerializeDataBuffer::allocateWithHeadroom(size_t iSize) {
+  auto start = static_cast<char *>(std::malloc(reserve_size + iSize));
+  if (start == nullptr) {
+    throw std::bad_alloc();
+  }
+  return start + reserve_size;
+}
+
+char *SerializeDataBuffer::reallocWithHeadroom(char *iCurrent, size_t iNewSize, size_t) {
+  //the headroom is moved along with the data, it is harmless since the header is only written after serializing
+  auto start = static_cast<char *>(std::realloc(iCurrent - reserve_size, reserve_size + iNewSize));
+  if (start == nullptr) {
+    return nullptr;
+  }
+  return start + reserve_size;
+}
+
 namespace edm {
 
   /**
@@ -38,6 +61,23 @@ namespace edm {
   StreamSerializer::StreamSerializer(SelectedProducts const *selections)
       : selections_(selections), tc_(getTClass(typeid(SendEvent))) {}
 
+  void StreamSerializer::setCompressionDictionary(std::vector<unsigned char> const &dictionary, int compressionLevel) {
+    compressionDictionary_.reset();
+    if (dictionary.empty()) {
+      return;
+    }
+    compressionDictionary_.reset(ZSTD_createCDict(&dictionary[0], dictionary.size(), compressionLevel));
+    if (!compressionDictionary_) {
+      throw cms::Exception("StreamSerializer", "setCompressionDictionary")
+          << "Could not create ZSTD compression dictionary of size " << dictionary.size();
+    }
+  }
+
+  void StreamSerializer::setCompressionThreads(unsigned int nThreads, unsigned int minEventSize) {
+    compressionThreads_ = nThreads;
+    minEventSizeForThreads_ = minEventSize;
+  }
+
   /**
    * Serializes the product registry (that was specified to the constructor)
    * into the specified InitMessage.
@@ -214,6 +254,7 @@ namespace edm {
     // compress before return if we need to
     // should test if compressed already - should never be?
     //   as double compression can have problems
+    unsigned int const nThreads = data_buffer.curr_event_size_ >= minEventSizeForThreads_ ? compressionThreads_ : 0;
     unsigned int dest_size = 0;
     switch (compressionAlgo) {
       case ZLIB:
@@ -228,26 +269,42 @@ namespace edm {
                                        data_buffer.curr_event_size_,
                                        data_buffer.comp_buf_,
                                        compression_level,
-                                       reserveSize);
+                                       reserveSize,
+                                       true,
+                                       nThreads);
         break;
       case ZSTD:
+        if (!data_buffer.zstd_context_) {
+          data_buffer.zstd_context_.reset(ZSTD_createCCtx());
+        }
         dest_size = compressBufferZSTD((unsigned char *)data_buffer.rootbuf_.Buffer(),
                                        data_buffer.curr_event_size_,
                                        data_buffer.comp_buf_,
                                        compression_level,
-                                       reserveSize);
+                                       reserveSize,
+                                       true,
+                                       data_buffer.zstd_context_.get(),
+                                       compressionDictionary_.get(),
+                                       nThreads);
         break;
       default:
         dest_size = data_buffer.rootbuf_.Length();
-        if (data_buffer.comp_buf_.size() < dest_size + reserveSize)
-          data_buffer.comp_buf_.resize(dest_size + reserveSize);
-        std::copy((char *)data_buffer.rootbuf_.Buffer(),
-                  (char *)data_buffer.rootbuf_.Buffer() + dest_size,
-                  (char *)(&data_buffer.comp_buf_[SerializeDataBuffer::reserve_size]));
+        // the headroom in front of rootbuf_ normally has space for the message header,
+        // in that case the serialized event is used in place
+        if (reserveSize > SerializeDataBuffer::reserve_size) {
+          if (data_buffer.comp_buf_.size() < dest_size + reserveSize)
+            data_buffer.comp_buf_.resize(dest_size + reserveSize);
+          std::copy((char *)data_buffer.rootbuf_.Buffer(),
+                    (char *)data_buffer.rootbuf_.Buffer() + dest_size,
+                    (char *)(&data_buffer.comp_buf_[reserveSize]));
+          data_buffer.ptr_ = &data_buffer.comp_buf_[reserveSize];
+        }
         break;
     };
 
-    data_buffer.ptr_ = &data_buffer.comp_buf_[reserveSize];  // reset to point at compressed area
+    if (compressionAlgo == ZLIB or compressionAlgo == LZMA or compressionAlgo == ZSTD) {
+      data_buffer.ptr_ = &data_buffer.comp_buf_[reserveSize];  // reset to point at compressed area
+    }
     data_buffer.curr_space_used_ = dest_size;
 
     // calculate the adler32 checksum and fill it into the struct
@@ -299,10 +356,15 @@ namespace edm {
                                                     std::vector<unsigned char> &outputBuffer,
                                                     int compressionLevel,
                                                     unsigned int reserveSize,
-                                                    bool addHeader) {
+                                                    bool addHeader,
+                                                    unsigned int nThreads) {
     // what are these magic numbers? (jbk)
     unsigned int hdr_size = addHeader ? 4 : 0;
     unsigned long dest_size = (unsigned long)(double(inputSize) * 1.01 + 1.0) + 12;
+    // each block of a multithreaded stream adds its own header and index entry
+    uint64_t const block_size = nThreads > 0 ? std::max<uint64_t>(inputSize / nThreads + 1, LZMA_DICT_SIZE_MIN) : 0;
+    if (nThreads > 0)
+      dest_size += 64 * (inputSize / block_size + 1);
     if (outputBuffer.size() < dest_size + reserveSize)
       outputBuffer.resize(dest_size + reserveSize);
 
@@ -340,10 +402,20 @@ namespace edm {
       opt_lzma2.dict_size = dict_size_est;
     }
 
-    returnStatus =
-        lzma_stream_encoder(&stream,
-                            filters,
-                            LZMA_CHECK_NONE);  //CRC32 and CRC64 are available, but we already calculate adler32
+    if (nThreads > 0) {
+      // the stream is split in independently compressed blocks, one per thread
+      lzma_mt mt_options = {};
+      mt_options.threads = nThreads;
+      mt_options.block_size = block_size;
+      mt_options.filters = filters;
+      mt_options.check = LZMA_CHECK_NONE;
+      returnStatus = lzma_stream_encoder_mt(&stream, &mt_options);
+    } else {
+      returnStatus =
+          lzma_stream_encoder(&stream,
+                              filters,
+                              LZMA_CHECK_NONE);  //CRC32 and CRC64 are available, but we already calculate adler32
+    }
     if (returnStatus != LZMA_OK) {
       throw cms::Exception("StreamSerializer", "compressBufferLZMA")
           << "LZMA compression encoder return value: " << returnStatus;
@@ -383,7 +455,10 @@ namespace edm {
                                                     std::vector<unsigned char> &outputBuffer,
                                                     int compressionLevel,
                                                     unsigned int reserveSize,
-                                                    bool addHeader) {
+                                                    bool addHeader,
+                                                    ZSTD_CCtx_s *context,
+                                                    ZSTD_CDict_s const *dictionary,
+                                                    unsigned int nThreads) {
     unsigned int hdr_size = addHeader ? 4 : 0;
     unsigned int resultSize = 0;
 
@@ -403,8 +478,23 @@ namespace edm {
     }
 
     // compression 1-20
-    size_t dest_size = ZSTD_compress(
-        (void *)&outputBuffer[reserveSize + hdr_size], worst_size, (void *)inputBuffer, inputSize, compressionLevel);
+    size_t dest_size = 0;
+    if (context == nullptr) {
+      dest_size = ZSTD_compress(
+          (void *)&outputBuffer[reserveSize + hdr_size], worst_size, (void *)inputBuffer, inputSize, compressionLevel);
+    } else {
+      ZSTD_CCtx_reset(context, ZSTD_reset_session_and_parameters);
+      ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, compressionLevel);
+      if (nThreads > 0) {
+        // fails if libzstd was built without multithreading support, the event is then compressed serially
+        ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, nThreads);
+      }
+      if (dictionary != nullptr) {
+        ZSTD_CCtx_refCDict(context, dictionary);
+      }
+      dest_size = ZSTD_compress2(
+          context, (void *)&outputBuffer[reserveSize + hdr_size], worst_size, (void *)inputBuffer, inputSize);
+    }
 
     // check status
     if (!ZSTD_isError(dest_size)) {
@@ -16,7 +16,8 @@ namespace edm {
       : StreamerInputSource(pset, desc),
         streamReader_(),
         eventSkipperByID_(EventSkipperByID::create(pset).release()),
-        initialNumberOfEventsToSkip_(pset.getUntrackedParameter<unsigned int>("skipEvents")) {
+        initialNumberOfEventsToSkip_(pset.getUntrackedParameter<unsigned int>("skipEvents")),
+        memoryMapFiles_(pset.getUntrackedParameter<bool>("memoryMapFiles")) {
     InputFileCatalog catalog(pset.getUntrackedParameter<std::vector<std::string> >("fileNames"),
                              pset.getUntrackedParameter<std::string>("overrideCatalog"));
     streamerNames_ = catalog.fileCatalogItems();
@@ -27,10 +28,10 @@ namespace edm {
 
   void StreamerFileReader::reset_() {
     if (streamerNames_.size() > 1) {
-      streamReader_ = std::make_unique<StreamerInputFile>(streamerNames_, eventSkipperByID());
+      streamReader_ = std::make_unique<StreamerInputFile>(streamerNames_, eventSkipperByID(), memoryMapFiles_);
     } else if (streamerNames_.size() == 1) {
       streamReader_ = std::make_unique<StreamerInputFile>(
-          streamerNames_.at(0).fileName(), streamerNames_.at(0).logicalFileName(), eventSkipperByID());
+          streamerNames_.at(0).fileName(), streamerNames_.at(0).logicalFileName(), eventSkipperByID(), memoryMapFiles_);
     } else {
       throw Exception(errors::FileReadError, "StreamerFileReader::StreamerFileReader")
           << "No fileNames were specified\n";
@@ -114,6 +115,10 @@ namespace edm {
     desc.addUntracked<unsigned int>("skipEvents", 0U)
         ->setComment("Skip the first 'skipEvents' events that otherwise would have been processed.");
     desc.addUntracked<std::string>("overrideCatalog", std::string());
+    desc.addUntracked<bool>("memoryMapFiles", false)
+        ->setComment(
+            "Map local files into memory and deserialize the events directly from the mapping instead of copying "
+            "them into a buffer.");
     //This next parameter is read in the base class, but its default value depends on the derived class, so it is set here.
     desc.addUntracked<bool>("inputFileTransitionsEachEvent", false);
     StreamerInputSource::fillDescription(desc);
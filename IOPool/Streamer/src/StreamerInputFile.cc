@@ -11,16 +11,29 @@
 #include "Utilities/StorageFactory/interface/IOFlags.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace edm {
+  namespace {
+    // already consumed parts of a mapped file are released in chunks of this size
+    constexpr IOOffset kMapReleaseSize = 64 * 1024 * 1024;
+  }  // namespace
 
   StreamerInputFile::~StreamerInputFile() { closeStreamerFile(); }
 
   StreamerInputFile::StreamerInputFile(std::string const& name,
                                        std::string const& LFN,
-                                       std::shared_ptr<EventSkipperByID> eventSkipperByID)
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool memoryMapped)
       : startMsg_(),
         currentEvMsg_(),
         headerBuf_(1000 * 1000),
@@ -35,16 +48,22 @@ namespace edm {
         currProto_(0),
         newHeader_(false),
         storage_(),
-        endOfFile_(false) {
+        endOfFile_(false),
+        memoryMapped_(memoryMapped),
+        mapFile_(nullptr),
+        mapSize_(0),
+        mapPosition_(0),
+        mapReleasedTo_(0) {
     openStreamerFile(name, LFN);
     readStartMessage();
   }
 
   StreamerInputFile::StreamerInputFile(std::string const& name, std::shared_ptr<EventSkipperByID> eventSkipperByID)
-      : StreamerInputFile(name, name, eventSkipperByID) {}
+      : StreamerInputFile(name, name, eventSkipperByID, false) {}
 
   StreamerInputFile::StreamerInputFile(std::vector<FileCatalogItem> const& names,
-                                       std::shared_ptr<EventSkipperByID> eventSkipperByID)
+                                       std::shared_ptr<EventSkipperByID> eventSkipperByID,
+                                       bool memoryMapped)
       : startMsg_(),
         currentEvMsg_(),
         headerBuf_(1000 * 1000),
@@ -58,7 +77,12 @@ namespace edm {
         currRun_(0),
         currProto_(0),
         newHeader_(false),
-        endOfFile_(false) {
+        endOfFile_(false),
+        memoryMapped_(memoryMapped),
+        mapFile_(nullptr),
+        mapSize_(0),
+        mapPosition_(0),
+        mapReleasedTo_(0) {
     openStreamerFile(names.at(0).fileName(), names.at(0).logicalFileName());
     ++currentFile_;
     readStartMessage();
@@ -83,6 +107,12 @@ namespace edm {
 
     logFileAction("  Initiating request to open file ");
 
+    if (memoryMapped_ && mapStreamerFile(name)) {
+      currentFileOpen_ = true;
+      logFileAction("  Successfully mapped file ");
+      return;
+    }
+
     IOOffset size = -1;
     if (StorageFactory::get()->check(name, &size)) {
       try {
@@ -102,8 +132,73 @@ namespace edm {
     logFileAction("  Successfully opened file ");
   }
 
+  bool StreamerInputFile::mapStreamerFile(std::string const& name) {
+    // only plain local files can be mapped, anything else is read through the storage layer
+    std::string path = name;
+    if (path.compare(0, 5, "file:") == 0) {
+      path = path.substr(5);
+    } else if (path.find(':') != std::string::npos) {
+      LogInfo("StreamerInputFile") << "File " << name << " is not a local file and will not be memory mapped";
+      return false;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw Exception(errors::FileOpenError, "StreamerInputFile::mapStreamerFile")
+          << "Error Opening Streamer Input File: " << name << "\n"
+          << strerror(errno) << "\n";
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      throw Exception(errors::FileOpenError, "StreamerInputFile::mapStreamerFile")
+          << "Error Opening Streamer Input File, unable to get a size for: " << name << "\n";
+    }
+    void* address = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      throw Exception(errors::FileOpenError, "StreamerInputFile::mapStreamerFile")
+          << "Error mapping Streamer Input File: " << name << "\n"
+          << strerror(errno) << "\n";
+    }
+    // events are read in order, lets the kernel read ahead aggressively
+    madvise(address, st.st_size, MADV_SEQUENTIAL);
+
+    mapFile_ = static_cast<char*>(address);
+    mapSize_ = st.st_size;
+    mapPosition_ = 0;
+    mapReleasedTo_ = 0;
+    return true;
+  }
+
+  void StreamerInputFile::unmapStreamerFile() {
+    if (mapFile_ != nullptr) {
+      munmap(mapFile_, mapSize_);
+      mapFile_ = nullptr;
+      mapSize_ = 0;
+      mapPosition_ = 0;
+      mapReleasedTo_ = 0;
+    }
+  }
+
+  void StreamerInputFile::releaseMappedPages() {
+    // the records before the current one are not used anymore, let the kernel reclaim their pages
+    // instead of letting the resident size grow to the size of the file
+    if (mapPosition_ - mapReleasedTo_ < 2 * kMapReleaseSize) {
+      return;
+    }
+    IOOffset const pageSize = sysconf(_SC_PAGESIZE);
+    IOOffset const releaseTo = ((mapPosition_ - kMapReleaseSize) / pageSize) * pageSize;
+    madvise(mapFile_ + mapReleasedTo_, releaseTo - mapReleasedTo_, MADV_DONTNEED);
+    mapReleasedTo_ = releaseTo;
+  }
+
   void StreamerInputFile::closeStreamerFile() {
-    if (currentFileOpen_ && storage_) {
+    if (currentFileOpen_ && mapFile_ != nullptr) {
+      unmapStreamerFile();
+      logFileAction("  Closed file ");
+    } else if (currentFileOpen_ && storage_) {
       storage_->close();
       logFileAction("  Closed file ");
     }
@@ -111,6 +206,12 @@ namespace edm {
   }
 
   IOSize StreamerInputFile::readBytes(char* buf, IOSize nBytes) {
+    if (mapFile_ != nullptr) {
+      IOSize n = std::min<IOOffset>(nBytes, mapSize_ - mapPosition_);
+      std::copy(mapFile_ + mapPosition_, mapFile_ + mapPosition_ + n, buf);
+      mapPosition_ += n;
+      return n;
+    }
     IOSize n = 0;
     try {
       n = storage_->read(buf, nBytes);
@@ -123,6 +224,11 @@ namespace edm {
   }
 
   IOOffset StreamerInputFile::skipBytes(IOSize nBytes) {
+    if (mapFile_ != nullptr) {
+      IOOffset n = std::min<IOOffset>(nBytes, mapSize_ - mapPosition_);
+      mapPosition_ += n;
+      return n;
+    }
     IOOffset n = 0;
     try {
       // We wish to return the number of bytes skipped, not the final offset.
@@ -224,7 +330,13 @@ namespace edm {
       return 0;
 
     bool eventRead = false;
+    // a mapped record is used in place, only its header is copied
+    char* mappedRecord = nullptr;
     while (!eventRead) {
+      if (mapFile_ != nullptr) {
+        releaseMappedPages();
+        mappedRecord = mapFile_ + mapPosition_;
+      }
       IOSize nWant = sizeof(EventHeader);
       IOSize nGot = readBytes(&eventBuf_[0], nWant);
       if (nGot == 0) {
@@ -259,7 +371,14 @@ namespace edm {
         }
       }
       nWant = eventSize - sizeof(EventHeader);
-      if (eventRead) {
+      if (eventRead && mappedRecord != nullptr) {
+        nGot = skipBytes(nWant);
+        if (nGot != nWant) {
+          throw Exception(errors::FileReadError, "StreamerInputFile::readEventMessage")
+              << "Failed reading streamer file, mapped event in readEventMessage is truncated\n"
+              << "Requested " << nWant << " bytes, file has " << nGot << " bytes left\n";
+        }
+      } else if (eventRead) {
         if (eventBuf_.size() < eventSize)
           eventBuf_.resize(eventSize);
         nGot = readBytes(&eventBuf_[sizeof(EventHeader)], nWant);
@@ -277,7 +396,12 @@ namespace edm {
         }
       }
     }
-    currentEvMsg_ = std::make_shared<EventMsgView>((void*)&eventBuf_[0]);  // propagate_const<T> has no reset() function
+    // propagate_const<T> has no reset() function
+    if (mappedRecord != nullptr) {
+      currentEvMsg_ = std::make_shared<EventMsgView>((void*)mappedRecord);
+    } else {
+      currentEvMsg_ = std::make_shared<EventMsgView>((void*)&eventBuf_[0]);
+    }
     return 1;
   }
 
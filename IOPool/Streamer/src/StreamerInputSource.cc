@@ -55,6 +55,9 @@ namespace edm {
 
   StreamerInputSource::~StreamerInputSource() {}
 
+  void StreamerInputSource::ZSTDDeleter::operator()(ZSTD_DCtx_s* iContext) const { ZSTD_freeDCtx(iContext); }
+  void StreamerInputSource::ZSTDDeleter::operator()(ZSTD_DDict_s* iDictionary) const { ZSTD_freeDDict(iDictionary); }
+
   // ---------------------------------------
   void StreamerInputSource::mergeIntoRegistry(SendJobHeader const& header,
                                               ProductRegistry& reg,
@@ -144,6 +147,20 @@ namespace edm {
           << " host name = " << initView.hostName() << std::endl;
     }
 
+    compressionDictionary_.reset();
+    if (initView.compressionDictionaryLength() > 0) {
+      compressionDictionary_.reset(
+          ZSTD_createDDict(initView.compressionDictionary(), initView.compressionDictionaryLength()));
+      if (!compressionDictionary_) {
+        throw cms::Exception("StreamDeserialization", "Compression dictionary error")
+            << "Could not create ZSTD dictionary of size " << initView.compressionDictionaryLength()
+            << " from the INIT message\n";
+      }
+      if (!zstdContext_) {
+        zstdContext_.reset(ZSTD_createDCtx());
+      }
+    }
+
     TClass* desc = getTClass(typeid(SendJobHeader));
 
     TBufferFile xbuf(
@@ -216,7 +233,10 @@ namespace edm {
         dest_size = uncompressBufferZSTD(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
                                          eventView.eventLength(),
                                          dest_,
-                                         origsize);
+                                         origsize,
+                                         true,
+                                         zstdContext_.get(),
+                                         compressionDictionary_.get());
       } else
         dest_size = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
                                      eventView.eventLength(),
@@ -439,14 +459,26 @@ namespace edm {
                                                          unsigned int inputSize,
                                                          std::vector<unsigned char>& outputBuffer,
                                                          unsigned int expectedFullSize,
-                                                         bool hasHeader) {
+                                                         bool hasHeader,
+                                                         ZSTD_DCtx_s* context,
+                                                         ZSTD_DDict_s const* dictionary) {
     unsigned long uncompressedSize = expectedFullSize * 1.1;
     FDEBUG(1) << "Uncompress: original size = " << expectedFullSize << ", compressed size = " << inputSize << std::endl;
     outputBuffer.resize(uncompressedSize);
 
     size_t hdrSize = hasHeader ? 4 : 0;
-    size_t ret = ZSTD_decompress(
-        (void*)&(outputBuffer[0]), uncompressedSize, (const void*)(inputBuffer + hdrSize), inputSize - hdrSize);
+    size_t ret = 0;
+    if (context != nullptr and dictionary != nullptr) {
+      ret = ZSTD_decompress_usingDDict(context,
+                                       (void*)&(outputBuffer[0]),
+                                       uncompressedSize,
+                                       (const void*)(inputBuffer + hdrSize),
+                                       inputSize - hdrSize,
+                                       dictionary);
+    } else {
+      ret = ZSTD_decompress(
+          (void*)&(outputBuffer[0]), uncompressedSize, (const void*)(inputBuffer + hdrSize), inputSize - hdrSize);
+    }
 
     if (ZSTD_isError(ret)) {
       throw cms::Exception("StreamDeserializationZSTD", "ZSTD uncompression error")
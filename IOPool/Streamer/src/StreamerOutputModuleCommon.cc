@@ -14,7 +14,9 @@
 #include "DataFormats/Provenance/interface/SelectedProducts.h"
 #include "FWCore/Framework/interface/getAllTriggerNames.h"
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <sys/time.h>
@@ -76,6 +78,23 @@ namespace edm {
     } else
       compressionAlgo_ = UNCOMPRESSED;
 
+    auto const dictionaryFile = ps.getUntrackedParameter<std::string>("compression_dictionary");
+    if (!dictionaryFile.empty()) {
+      if (compressionAlgo_ != ZSTD) {
+        throw cms::Exception("StreamerOutputModuleCommon", "Compression dictionary")
+            << "A compression dictionary can only be used with the ZSTD compression algorithm";
+      }
+      std::ifstream file(dictionaryFile, std::ios::binary);
+      if (!file) {
+        throw cms::Exception("StreamerOutputModuleCommon", "Compression dictionary")
+            << "Unable to open compression dictionary file " << dictionaryFile;
+      }
+      compressionDictionary_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      serializer_.setCompressionDictionary(compressionDictionary_, compressionLevel_);
+    }
+    serializer_.setCompressionThreads(ps.getUntrackedParameter<unsigned int>("compression_threads"),
+                                      ps.getUntrackedParameter<unsigned int>("compression_threads_min_event_size"));
+
     int got_host = gethostname(host_name_, 255);
     if (got_host != 0)
       strncpy(host_name_, "noHostNameFoundOrTooLong", sizeof(host_name_));
@@ -99,7 +118,7 @@ namespace edm {
     // resize header_buf_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
     unsigned int src_size = sbuf.currentSpaceUsed();
-    unsigned int new_size = src_size + 50000;
+    unsigned int new_size = src_size + 50000 + compressionDictionary_.size();
     if (sbuf.header_buf_.size() < new_size)
       sbuf.header_buf_.resize(new_size);
 
@@ -141,7 +160,8 @@ namespace edm {
                                                          hltTriggerNames,
                                                          hltTriggerSelections_,
                                                          l1_names,
-                                                         (uint32)sbuf.adler32_chksum());
+                                                         (uint32)sbuf.adler32_chksum(),
+                                                         compressionDictionary_);
 
     // copy data into the destination message
     unsigned char* src = sbuf.bufferPointer();
@@ -246,10 +266,12 @@ namespace edm {
       throw cms::Exception("StreamerOutputModuleCommon", "Header Overflow")
           << " header of size " << headerSize << "bytes is too big to fit into the reserved buffer space";
 
-    //set addresses to other buffer and copy constructed header there
-    msg->setBufAddr(&sbuf.comp_buf_[reserve_size - headerSize]);
-    msg->setEventAddr(sbuf.bufferPointer());
-    std::copy(&sbuf.header_buf_[0], &sbuf.header_buf_[headerSize], (char*)(&sbuf.comp_buf_[reserve_size - headerSize]));
+    //the event data is preceded by reserve_size bytes of headroom in either of the buffers of sbuf,
+    // only the constructed header is copied in front of it
+    unsigned char* eventAddr = sbuf.bufferPointer();
+    msg->setBufAddr(eventAddr - headerSize);
+    msg->setEventAddr(eventAddr);
+    std::copy(&sbuf.header_buf_[0], &sbuf.header_buf_[headerSize], eventAddr - headerSize);
 
     unsigned int src_size = sbuf.currentSpaceUsed();
     msg->setEventLength(src_size);  //compressed size
@@ -269,6 +291,16 @@ namespace edm {
     desc.addUntracked<std::string>("compression_algorithm", "ZLIB")
         ->setComment("Compression algorithm to use: UNCOMPRESSED, ZLIB, LZMA or ZSTD");
     desc.addUntracked<int>("compression_level", 1)->setComment("Compression level to use on serialized ROOT events");
+    desc.addUntracked<std::string>("compression_dictionary", "")
+        ->setComment(
+            "File containing a dictionary for ZSTD compression, e.g. made with 'zstd --train'.\n"
+            "The dictionary is stored in the INIT message.");
+    desc.addUntracked<unsigned int>("compression_threads", 0)
+        ->setComment(
+            "Number of threads used to compress large events with LZMA or ZSTD.\n"
+            "If 0, each event is compressed by the thread writing it.");
+    desc.addUntracked<unsigned int>("compression_threads_min_event_size", 4 * 1024 * 1024)
+        ->setComment("Serialized size in bytes above which an event is compressed using compression_threads threads.");
     desc.addUntracked<int>("lumiSection_interval", 0)
         ->setComment(
             "If 0, use lumi section number from event.\n"
@@ -0,0 +1,141 @@
+/*
+   Compresses events as StreamSerializer does and uncompresses them as
+   StreamerInputSource does, and checks that the events are unchanged:
+   - with ZSTD and a compression dictionary, read back from an INIT message;
+   - with LZMA and ZSTD compressing on several threads.
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "IOPool/Streamer/interface/InitMessage.h"
+#include "IOPool/Streamer/interface/InitMsgBuilder.h"
+#include "IOPool/Streamer/interface/StreamSerializer.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
+
+#include "zstd.h"
+
+namespace {
+
+  // something like a serialized event: records sharing their names and layout, with varying values
+  std::vector<unsigned char> makeEvent(std::mt19937& rng, unsigned int records) {
+    static const std::string names[] = {"recoTracks_generalTracks__RECO.",
+                                        "recoVertexs_offlinePrimaryVertices__RECO.",
+                                        "recoPFCandidates_particleFlow__RECO.",
+                                        "edmTriggerResults_TriggerResults__HLT."};
+    std::string event;
+    for (unsigned int i = 0; i < records; ++i) {
+      event += names[rng() % 4];
+      event += "obj_.pt_=" + std::to_string(rng() % 100000) + ";eta_=" + std::to_string(rng() % 5000) + ";";
+    }
+    return std::vector<unsigned char>(event.begin(), event.end());
+  }
+
+  bool check(bool condition, std::string const& what) {
+    if (not condition)
+      std::cerr << "failed: " << what << std::endl;
+    return condition;
+  }
+
+  struct ZSTDFree {
+    void operator()(ZSTD_CCtx* p) const { ZSTD_freeCCtx(p); }
+    void operator()(ZSTD_CDict* p) const { ZSTD_freeCDict(p); }
+    void operator()(ZSTD_DCtx* p) const { ZSTD_freeDCtx(p); }
+    void operator()(ZSTD_DDict* p) const { ZSTD_freeDDict(p); }
+  };
+
+}  // namespace
+
+int main() try {
+  std::mt19937 rng(16);
+  bool ok = true;
+  unsigned int const reserveSize = 100;
+  int const level = 3;
+
+  // ----------- ZSTD with a dictionary stored in the INIT message
+
+  // a dictionary of raw content, taken from other events
+  std::vector<unsigned char> dictionary;
+  for (int i = 0; i < 20; ++i) {
+    auto const sample = makeEvent(rng, 20);
+    dictionary.insert(dictionary.end(), sample.begin(), sample.end());
+  }
+
+  std::vector<uint8> initBuffer(dictionary.size() + 1000);
+  char psetid[] = "1234567890123456";
+  Strings names = {"a", "b"};
+  InitMsgBuilder init(&initBuffer[0],
+                      initBuffer.size(),
+                      12,
+                      Version((const uint8*)psetid),
+                      "CMSSW_X_Y_Z",
+                      "HLT",
+                      "out",
+                      0,
+                      names,
+                      names,
+                      names,
+                      0,
+                      dictionary);
+  init.setDataLength(0);
+  InitMsgView initView(&initBuffer[0]);
+  std::vector<unsigned char> const stored(initView.compressionDictionary(),
+                                          initView.compressionDictionary() + initView.compressionDictionaryLength());
+  ok &= check(initView.protocolVersion() == 12, "protocol version of the INIT message");
+  ok &= check(stored == dictionary, "dictionary stored in the INIT message");
+
+  std::unique_ptr<ZSTD_CCtx, ZSTDFree> cctx(ZSTD_createCCtx());
+  std::unique_ptr<ZSTD_CDict, ZSTDFree> cdict(ZSTD_createCDict(&dictionary[0], dictionary.size(), level));
+  std::unique_ptr<ZSTD_DCtx, ZSTDFree> dctx(ZSTD_createDCtx());
+  std::unique_ptr<ZSTD_DDict, ZSTDFree> ddict(ZSTD_createDDict(&stored[0], stored.size()));
+  ok &= check(cctx and cdict and dctx and ddict, "ZSTD contexts and dictionaries");
+
+  unsigned int withDictionary = 0, withoutDictionary = 0;
+  std::vector<unsigned char> compressed, uncompressed;
+  for (int i = 0; i < 50; ++i) {
+    auto event = makeEvent(rng, 10);
+    withoutDictionary += edm::StreamSerializer::compressBufferZSTD(
+        &event[0], event.size(), compressed, level, reserveSize, true, cctx.get(), nullptr);
+
+    // the context is reused from one event to the next, as in SerializeDataBuffer
+    unsigned int const size = edm::StreamSerializer::compressBufferZSTD(
+        &event[0], event.size(), compressed, level, reserveSize, true, cctx.get(), cdict.get());
+    withDictionary += size;
+    ok &= check(compressed[reserveSize] == 'Z' and compressed[reserveSize + 1] == 'S', "ZSTD header");
+    unsigned int const length = edm::StreamerInputSource::uncompressBufferZSTD(
+        &compressed[reserveSize], size, uncompressed, event.size(), true, dctx.get(), ddict.get());
+    ok &= check(length == event.size() and std::equal(event.begin(), event.end(), uncompressed.begin()),
+                "event compressed with a dictionary");
+  }
+  std::cout << "ZSTD: " << withoutDictionary << " bytes without the dictionary, " << withDictionary << " with it"
+            << std::endl;
+  ok &= check(withDictionary < withoutDictionary, "the dictionary makes the events smaller");
+
+  // ----------- LZMA and ZSTD on several threads, and on the calling thread only
+
+  auto large = makeEvent(rng, 100000);
+  for (unsigned int nThreads : {0, 2, 4}) {
+    unsigned int size = edm::StreamSerializer::compressBufferLZMA(
+        &large[0], large.size(), compressed, 1, reserveSize, true, nThreads);
+    unsigned int length =
+        edm::StreamerInputSource::uncompressBufferLZMA(&compressed[reserveSize], size, uncompressed, large.size());
+    ok &= check(length == large.size() and std::equal(large.begin(), large.end(), uncompressed.begin()),
+                "LZMA on " + std::to_string(nThreads) + " threads");
+
+    size = edm::StreamSerializer::compressBufferZSTD(
+        &large[0], large.size(), compressed, level, reserveSize, true, cctx.get(), nullptr, nThreads);
+    length = edm::StreamerInputSource::uncompressBufferZSTD(&compressed[reserveSize], size, uncompressed, large.size());
+    ok &= check(length == large.size() and std::equal(large.begin(), large.end(), uncompressed.begin()),
+                "ZSTD on " + std::to_string(nThreads) + " threads");
+  }
+
+  return ok ? 0 : 1;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return 1;
+}
@@ -65,6 +65,7 @@ int main() try {
   crc = crc32(crc, crcbuf, outputModuleLabel.length());
 
   uint32 adler32_chksum = (uint32)cms::Adler32((char*)&test_value[0], sizeof(test_value));
+  std::vector<unsigned char> dictionary = {'d', 'i', 'c', 't'};
 
   InitMsgBuilder init(&buf[0],
                       buf.size(),
@@ -77,7 +78,8 @@ int main() try {
                       hlt_names,
                       hlt_names,
                       l1_names,
-                      adler32_chksum);
+                      adler32_chksum,
+                      dictionary);
 
   init.setDataLength(sizeof(test_value));
   std::copy(&test_value[0], &test_value[0] + sizeof(test_value), init.dataAddress());
@@ -91,6 +93,8 @@ int main() try {
   view.l1TriggerNames(l12);
 
   uint32 adler32_2 = view.adler32_chksum();
+  std::vector<unsigned char> dictionary2(view.compressionDictionary(),
+                                         view.compressionDictionary() + view.compressionDictionaryLength());
 
   InitMsgBuilder init2(&buf2[0],
                        buf2.size(),
@@ -103,7 +107,8 @@ int main() try {
                        hlt2,
                        hlt2,
                        l12,
-                       adler32_2);
+                       adler32_2,
+                       dictionary2);
 
   init2.setDataLength(view.descLength());
   std::copy(view.descData(), view.descData() + view.size(), init2.dataAddress());
@@ -9,6 +9,12 @@ options.register ('compAlgo',
                   VarParsing.VarParsing.varType.string,
                   "Compression Algorithm")
 
+options.register ('compDict',
+                  '', # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,
+                  "Compression dictionary (ZSTD only)")
+
 options.parseArguments()
 
 
@@ -43,6 +49,9 @@ process.out = cms.OutputModule("EventStreamFileWriter",
     compression_level = cms.untracked.int32(1),
     use_compression = cms.untracked.bool(True),
     compression_algorithm = cms.untracked.string(options.compAlgo),
+    compression_dictionary = cms.untracked.string(options.compDict),
+    compression_threads = cms.untracked.uint32(2),
+    compression_threads_min_event_size = cms.untracked.uint32(0),
     max_event_size = cms.untracked.int32(7000000)
 )
 
@@ -29,10 +29,17 @@ cp *_cfg.py ${OUTDIR}
 cd ${OUTDIR}
 
 cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} > out 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO}" $?
-cmsRun NewStreamOutAlt_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} > outAlt 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO}" $?
+# with ZSTD the alternative stream is compressed with a dictionary, here raw content from the first stream
+ALT_OPTIONS="compAlgo=${TEST_COMPRESSION_ALGO}"
+if [ "${TEST_COMPRESSION_ALGO}" == "ZSTD" ]; then
+head -c 32768 teststreamfile.dat > dictionary.zstd
+ALT_OPTIONS="${ALT_OPTIONS} compDict=dictionary.zstd"
+fi
+cmsRun NewStreamOutAlt_cfg.py ${ALT_OPTIONS} > outAlt 2>&1 || die "cmsRun NewStreamOutAlt_cfg.py ${ALT_OPTIONS}" $?
 cmsRun NewStreamOutExt_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} > outExt 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO}" $?
 cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn_cfg.py" $?
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
+cmsRun --parameter-set NewStreamInMapped_cfg.py  > inMapped  2>&1 || die "cmsRun NewStreamInMapped_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy2_cfg.py  > copy2  2>&1 || die "cmsRun NewStreamCopy2_cfg.py" $?
 cmsRun --parameter-set NewStreamInAlt_cfg.py  > alt  2>&1 || die "cmsRun NewStreamInAlt_cfg.py" $?
@@ -45,6 +52,7 @@ ANS_OUT_SIZE=`grep -c CHECKSUM out`
 ANS_OUT=`grep CHECKSUM out`
 ANS_IN=`grep CHECKSUM in`
 ANS_IN2=`grep CHECKSUM in2`
+ANS_IN_MAPPED=`grep CHECKSUM inMapped`
 ANS_COPY=`grep CHECKSUM copy`
 
 if [ "${ANS_OUT_SIZE}" == "0" ]
@@ -65,6 +73,12 @@ then
     RC=1
 fi
 
+if [ "${ANS_OUT}" != "${ANS_IN_MAPPED}" ]
+then
+    echo "New Stream Test Failed (out!=inMapped)"
+    RC=1
+fi
+
 if [ "${ANS_OUT}" != "${ANS_COPY}" ]
 then
     echo "New Stream Test Failed (copy!=out)"
@@ -84,7 +84,8 @@ int main() try {
                       hlt_names,
                       hlt_names,
                       l1_names,
-                      adler32_chksum);
+                      adler32_chksum,
+                      std::vector<unsigned char>());
 
   init.setDataLength(sizeof(test_value));
   std::copy(&test_value[0], &test_value[0] + sizeof(test_value), init.dataAddress());
@@ -61,6 +61,13 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
                                                        std::vector<l1t::Jet>& jets,
                                                        std::vector<l1t::Jet>& alljets,
                                                        std::string PUSubMethod) {
+  // the seed threshold in tower units
+  const double seedThreshold = floor(params_->jetSeedThreshold() / params_->towerLsbSum());
+
+  // the tower Et summed over each eta ring, for the phi ring PU subtraction, computed for the first jet needing it
+  std::map<int, int> SumEtEtaMap;
+  bool sumEtEtaMapFilled = false;
+
   // etaSide=1 is positive eta, etaSide=-1 is negative eta
   for (int etaSide = 1; etaSide >= -1; etaSide -= 2) {
     // the 4 groups of rings
@@ -107,7 +114,7 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
           bool vetoCandidate = false;
 
           // check it passes the seed threshold
-          if (iEt < floor(params_->jetSeedThreshold() / params_->towerLsbSum()))
+          if (iEt < seedThreshold)
             continue;
 
           if (seedEt == CaloTools::kSatHcal || seedEt == CaloTools::kSatEcal || seedEt == CaloTools::kSatTower)
@@ -133,12 +140,13 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
                 ietaTest += 1;
 
               // check jet mask and sum tower et
+              if (mask_[8 - (dphi + 4)][deta + 4] == 0)
+                continue;
+
               const CaloTower& towTest = CaloTools::getTower(towers, CaloTools::caloEta(ietaTest), iphiTest);
               towEt = towTest.hwPt();
 
-              if (mask_[8 - (dphi + 4)][deta + 4] == 0)
-                continue;
-              else if (mask_[8 - (dphi + 4)][deta + 4] == 1)
+              if (mask_[8 - (dphi + 4)][deta + 4] == 1)
                 vetoCandidate = (seedEt < towEt);
               else if (mask_[8 - (dphi + 4)][deta + 4] == 2)
                 vetoCandidate = (seedEt <= towEt);
@@ -185,7 +193,10 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 
               if (PUSubMethod == "PhiRing1") {
                 int size = 5;
-                std::map<int, int> SumEtEtaMap = getSumEtEtaMap(towers);
+                if (!sumEtEtaMapFilled) {
+                  SumEtEtaMap = getSumEtEtaMap(towers);
+                  sumEtEtaMapFilled = true;
+                }
                 // int jetPhi=jet.hwPhi();
                 int jetEta = CaloTools::mpEta(jet.hwEta());
                 int jetEtaLow = jetEta - size + 1;
@@ -207,7 +218,10 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 
               if (PUSubMethod == "PhiRing2") {
                 int size = 5;
-                std::map<int, int> SumEtEtaMap = getSumEtEtaMap(towers);
+                if (!sumEtEtaMapFilled) {
+                  SumEtEtaMap = getSumEtEtaMap(towers);
+                  sumEtEtaMapFilled = true;
+                }
                 // int jetPhi=jet.hwPhi();
                 int jetEta = CaloTools::mpEta(jet.hwEta());
                 int jetEtaLow = jetEta - size + 1;
@@ -94,8 +94,11 @@ namespace l1t {
 
     inline void setGtAlgoResult(const bool algoResult) { m_algoResult = algoResult; }
 
-    /// evaluate an algorithm
-    void evaluateAlgorithm(const int chipNumber, const std::vector<ConditionEvaluationMap>&);
+    /// evaluate an algorithm; the operand tokens and the object combinations of its conditions
+    /// are only collected if fillObjectMaps is true
+    void evaluateAlgorithm(const int chipNumber,
+                           const std::vector<ConditionEvaluationMap>&,
+                           const bool fillObjectMaps = true);
 
     /// get all the object combinations evaluated to true in the conditions
     /// from the algorithm
@@ -48,7 +48,8 @@ l1t::AlgorithmEvaluation::AlgorithmEvaluation(const GlobalAlgorithm& alg)
 
 /// evaluate an algorithm
 void l1t::AlgorithmEvaluation::evaluateAlgorithm(const int chipNumber,
-                                                 const std::vector<ConditionEvaluationMap>& conditionResultMaps) {
+                                                 const std::vector<ConditionEvaluationMap>& conditionResultMaps,
+                                                 const bool fillObjectMaps) {
   // set result to false if there is no expression
   if (m_rpnVector.empty()) {
     m_algoResult = false;
@@ -61,8 +62,10 @@ void l1t::AlgorithmEvaluation::evaluateAlgorithm(const int chipNumber,
   // reserve memory
   int rpnVectorSize = m_rpnVector.size();
 
-  m_algoCombinationVector.reserve(rpnVectorSize);
-  m_operandTokenVector.reserve(rpnVectorSize);
+  if (fillObjectMaps) {
+    m_algoCombinationVector.reserve(rpnVectorSize);
+    m_operandTokenVector.reserve(rpnVectorSize);
+  }
 
   // stack containing temporary results
   std::stack<bool, std::vector<bool> > resultStack;
@@ -91,6 +94,10 @@ void l1t::AlgorithmEvaluation::evaluateAlgorithm(const int chipNumber,
 
           resultStack.push(condResult);
 
+          if (!fillObjectMaps) {
+            break;
+          }
+
           // only conditions are added to /counted in m_operandTokenVector
           // opNumber is the index of the condition in the logical expression
           OperandToken opToken;
@@ -732,8 +732,11 @@ void l1t::GlobalBoard::runGTL(edm::Event& iEvent,
     objMapVec.reserve(numberPhysTriggers);
 
   for (CItAlgo itAlgo = algorithmMap.begin(); itAlgo != algorithmMap.end(); itAlgo++) {
+    // the operand tokens and the combinations are copied from the conditions only for the object maps and the printout
     AlgorithmEvaluation gtAlg(itAlgo->second);
-    gtAlg.evaluateAlgorithm((itAlgo->second).algoChipNumber(), m_conditionResultMaps);
+    gtAlg.evaluateAlgorithm((itAlgo->second).algoChipNumber(),
+                            m_conditionResultMaps,
+                            (produceL1GtObjectMapRecord && (iBxInEvent == 0)) || (m_verbosity && m_isDebugEnabled));
 
     int algBitNumber = (itAlgo->second).algoBitNumber();
     bool algResult = gtAlg.gtAlgoResult();
@@ -803,7 +806,7 @@ void l1t::GlobalBoard::runGTL(edm::Event& iEvent,
         LogTrace("L1TGlobal") << myCout1.str() << std::endl;
       }
 
-      objMapVec.push_back(objMap);
+      objMapVec.push_back(std::move(objMap));
     }
   }
 
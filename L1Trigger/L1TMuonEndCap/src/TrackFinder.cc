@@ -3,6 +3,9 @@
 #include <iostream>
 #include <sstream>
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include "L1Trigger/L1TMuonEndCap/interface/EMTFSubsystemCollector.h"
 
 TrackFinder::TrackFinder(const edm::ParameterSet& iConfig, edm::ConsumesCollector&& iConsumes)
@@ -182,19 +185,33 @@ void TrackFinder::process(const edm::Event& iEvent,
   // Reload pT LUT if necessary
   pt_assign_engine_->load(condition_helper_.get_pt_lut_version(), &(condition_helper_.getForest()));
 
-  // MIN/MAX ENDCAP and TRIGSECTOR set in interface/Common.h
-  for (int endcap = emtf::MIN_ENDCAP; endcap <= emtf::MAX_ENDCAP; ++endcap) {
-    for (int sector = emtf::MIN_TRIGSECTOR; sector <= emtf::MAX_TRIGSECTOR; ++sector) {
-      const int es = (endcap - emtf::MIN_ENDCAP) * (emtf::MAX_TRIGSECTOR - emtf::MIN_TRIGSECTOR + 1) +
-                     (sector - emtf::MIN_TRIGSECTOR);
-
-      // Run-dependent configure. This overwrites many of the configurables passed by the python config file.
-      if (iEvent.isRealData() && fwConfig_) {
-        sector_processors_.at(es).configure_by_fw_version(condition_helper_.get_fw_version());
-      }
+  // Run-dependent configure. This overwrites many of the configurables passed by the python config file.
+  if (iEvent.isRealData() && fwConfig_) {
+    for (auto& sector_processor : sector_processors_) {
+      sector_processor.configure_by_fw_version(condition_helper_.get_fw_version());
+    }
+  }
 
-      // Process
-      sector_processors_.at(es).process(iEvent.id().event(), muon_primitives, out_hits, out_tracks);
+  // MIN/MAX ENDCAP and TRIGSECTOR set in interface/Common.h
+  // The sectors only read the primitives, the LUTs and the BDT forests, and are processed in parallel into their
+  // own collections, appended in the sector order of the sequential processing. The debug printouts require the
+  // sequential processing.
+  if (verbose_ > 0) {
+    for (const auto& sector_processor : sector_processors_) {
+      sector_processor.process(iEvent.id().event(), muon_primitives, out_hits, out_tracks);
+    }
+  } else {
+    emtf::sector_array<EMTFHitCollection> sector_hits;
+    emtf::sector_array<EMTFTrackCollection> sector_tracks;
+    // isolated, so that the thread waiting for the sectors does not pick up tasks of other modules meanwhile
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(0, int(sector_processors_.size()), [&](int es) {
+        sector_processors_[es].process(iEvent.id().event(), muon_primitives, sector_hits[es], sector_tracks[es]);
+      });
+    });
+    for (unsigned int es = 0; es < sector_processors_.size(); ++es) {
+      out_hits.insert(out_hits.end(), sector_hits[es].begin(), sector_hits[es].end());
+      out_tracks.insert(out_tracks.end(), sector_tracks[es].begin(), sector_tracks[es].end());
     }
   }
 
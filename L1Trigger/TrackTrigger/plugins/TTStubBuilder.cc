@@ -73,13 +73,16 @@ void TTStubBuilder<Ref_Phase2TrackerDigi_>::produce(edm::Event& iEvent, const ed
     std::vector<std::pair<unsigned int, double>> bendMap;
 
     /// Go on only if both detectors have Clusters
-    if (clusterHandle->find(lowerDetid) == clusterHandle->end() ||
-        clusterHandle->find(upperDetid) == clusterHandle->end())
+    auto lowerClusterSet = clusterHandle->find(lowerDetid, true);
+    if (lowerClusterSet == clusterHandle->end())
+      continue;
+    auto upperClusterSet = clusterHandle->find(upperDetid, true);
+    if (upperClusterSet == clusterHandle->end())
       continue;
 
     /// Get the DetSets of the Clusters
-    edmNew::DetSet<TTCluster<Ref_Phase2TrackerDigi_>> lowerClusters = (*clusterHandle)[lowerDetid];
-    edmNew::DetSet<TTCluster<Ref_Phase2TrackerDigi_>> upperClusters = (*clusterHandle)[upperDetid];
+    edmNew::DetSet<TTCluster<Ref_Phase2TrackerDigi_>> lowerClusters = *lowerClusterSet;
+    edmNew::DetSet<TTCluster<Ref_Phase2TrackerDigi_>> upperClusters = *upperClusterSet;
 
     /// If there are Clusters in both sensors
     /// you can try and make a Stub
@@ -17,7 +17,10 @@
 #include "DetectorDescription/Core/interface/DDCompactView.h"
 #include "MagneticField/GeomBuilder/src/MagGeoBuilderFromDDD.h"
 #include "CondFormats/MFObjects/interface/MagFieldConfig.h"
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -38,6 +41,7 @@ namespace magneticfield {
     const bool useParametrizedTrackerField_;
     const MagFieldConfig conf_;
     const std::string version_;
+    const std::string gridPack_;  // the grids packed in one file (see MFGridPack), if not empty
     edm::ESGetToken<DDCompactView, IdealMagneticFieldRecord> cpvToken_;
     edm::ESGetToken<MagneticField, IdealMagneticFieldRecord> paramFieldToken_;
   };
@@ -50,7 +54,8 @@ VolumeBasedMagneticFieldESProducer::VolumeBasedMagneticFieldESProducer(const edm
     : debug_{iConfig.getUntrackedParameter<bool>("debugBuilder", false)},
       useParametrizedTrackerField_{iConfig.getParameter<bool>("useParametrizedTrackerField")},
       conf_{iConfig, debug_},
-      version_{iConfig.getParameter<std::string>("version")} {
+      version_{iConfig.getParameter<std::string>("version")},
+      gridPack_{iConfig.existsAs<std::string>("gridPack") ? iConfig.getParameter<std::string>("gridPack") : ""} {
   auto cc = setWhatProduced(this, iConfig.getUntrackedParameter<std::string>("label", ""));
   cc.setConsumes(cpvToken_, edm::ESInputTag{"", "magfield"});
   if (useParametrizedTrackerField_) {
@@ -77,6 +82,13 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducer::produce(const
     builder.setGridFiles(conf_.gridFiles);
   }
 
+  // Read the grids from a single mapped file, released once the interpolators are built.
+  std::unique_ptr<MFGridPack> gridPack;
+  if (!gridPack_.empty()) {
+    gridPack = std::make_unique<MFGridPack>(edm::FileInPath(gridPack_).fullPath());
+    builder.setGridPack(gridPack.get());
+  }
+
   builder.build(*cpv);
 
   // Get slave field (from ES)
@@ -17,10 +17,13 @@
 
 #include "MagneticField/GeomBuilder/src/DD4hep_MagGeoBuilder.h"
 #include "CondFormats/MFObjects/interface/MagFieldConfig.h"
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
 #include "DetectorDescription/DDCMS/interface/BenchmarkGrd.h"
 #include "DetectorDescription/DDCMS/interface/DDCompactView.h"
 #include "DetectorDescription/DDCMS/interface/DDDetector.h"
 
+#include <memory>
 #include <string>
 
 namespace magneticfield {
@@ -42,6 +45,7 @@ namespace magneticfield {
     const bool useParametrizedTrackerField_;
     const MagFieldConfig conf_;
     const std::string version_;
+    const std::string gridPack_;  // the grids packed in one file (see MFGridPack), if not empty
     edm::ESGetToken<MagneticField, IdealMagneticFieldRecord> paramFieldToken_;
     edm::ESGetToken<cms::DDCompactView, IdealMagneticFieldRecord> cpvToken_;
   };
@@ -54,7 +58,8 @@ DD4hep_VolumeBasedMagneticFieldESProducer::DD4hep_VolumeBasedMagneticFieldESProd
       debug_{iConfig.getUntrackedParameter<bool>("debugBuilder", false)},
       useParametrizedTrackerField_{iConfig.getParameter<bool>("useParametrizedTrackerField")},
       conf_{iConfig, debug_},
-      version_{iConfig.getParameter<std::string>("version")} {
+      version_{iConfig.getParameter<std::string>("version")},
+      gridPack_{iConfig.existsAs<std::string>("gridPack") ? iConfig.getParameter<std::string>("gridPack") : ""} {
   // LogVerbatim used because LogTrace messages don't seem to appear even when fully enabled.
   edm::LogVerbatim("DD4hep_VolumeBasedMagneticFieldESProducer")
       << "info:Constructing a DD4hep_VolumeBasedMagneticFieldESProducer";
@@ -86,6 +91,13 @@ std::unique_ptr<MagneticField> DD4hep_VolumeBasedMagneticFieldESProducer::produc
     builder.setGridFiles(conf_.gridFiles);
   }
 
+  // Read the grids from a single mapped file, released once the interpolators are built.
+  std::unique_ptr<MFGridPack> gridPack;
+  if (!gridPack_.empty()) {
+    gridPack = std::make_unique<MFGridPack>(edm::FileInPath(gridPack_).fullPath());
+    builder.setGridPack(gridPack.get());
+  }
+
   auto cpv = iRecord.getTransientHandle(cpvToken_);
   const cms::DDCompactView* cpvPtr = cpv.product();
   const cms::DDDetector* det = cpvPtr->detector();
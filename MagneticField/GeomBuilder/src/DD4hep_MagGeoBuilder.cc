@@ -19,6 +19,7 @@
 
 #include "MagneticField/Interpolation/interface/MagProviderInterpol.h"
 #include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
 #include "MagneticField/Interpolation/interface/MFGrid.h"
 
 #include "MagneticField/VolumeGeometry/interface/MagVolume6Faces.h"
@@ -47,7 +48,11 @@ using namespace edm;
 using namespace angle_units::operators;
 
 MagGeoBuilder::MagGeoBuilder(string tableSet, int geometryVersion, bool debug)
-    : tableSet_(tableSet), geometryVersion_(geometryVersion), theGridFiles_(nullptr), debug_(debug) {
+    : tableSet_(tableSet),
+      geometryVersion_(geometryVersion),
+      theGridFiles_(nullptr),
+      theGridPack_(nullptr),
+      debug_(debug) {
   LogTrace("MagGeoBuilder") << "Constructing a MagGeoBuilder";
 }
 
@@ -450,15 +455,18 @@ void MagGeoBuilder::buildInterpolator(const volumeHandle* vol, map<string, MagPr
   }
 
   string fullPath;
-
-  try {
-    edm::FileInPath mydata("MagneticField/Interpolation/data/" + tableSet_ + "/" + vol->magFile);
-    fullPath = mydata.fullPath();
-  } catch (edm::Exception& exc) {
-    cerr << "MagGeoBuilder: exception in reading table; " << exc.what() << endl;
-    if (!debug_)
-      throw;
-    return;
+  const bool inPack = theGridPack_ != nullptr && theGridPack_->find(vol->magFile).first != nullptr;
+
+  if (!inPack) {
+    try {
+      edm::FileInPath mydata("MagneticField/Interpolation/data/" + tableSet_ + "/" + vol->magFile);
+      fullPath = mydata.fullPath();
+    } catch (edm::Exception& exc) {
+      cerr << "MagGeoBuilder: exception in reading table; " << exc.what() << endl;
+      if (!debug_)
+        throw;
+      return;
+    }
   }
 
   try {
@@ -482,7 +490,8 @@ void MagGeoBuilder::buildInterpolator(const volumeHandle* vol, map<string, MagPr
                                        vol->placement()->rotation() * rot);
       }
 
-      interpolators[vol->magFile] = MFGridFactory::build(fullPath, rf);
+      interpolators[vol->magFile] =
+          inPack ? MFGridFactory::build(*theGridPack_, vol->magFile, rf) : MFGridFactory::build(fullPath, rf);
     }
   } catch (MagException& exc) {
     LogTrace("MagGeoBuilder") << exc.what();
@@ -601,3 +610,5 @@ void MagGeoBuilder::setScaling(const std::vector<int>& keys, const std::vector<d
 }
 
 void MagGeoBuilder::setGridFiles(const TableFileMap& gridFiles) { theGridFiles_ = &gridFiles; }
+
+void MagGeoBuilder::setGridPack(const MFGridPack* gridPack) { theGridPack_ = gridPack; }
@@ -29,6 +29,7 @@ class Surface;
 class MagBLayer;
 class MagESector;
 class MagVolume6Faces;
+class MFGridPack;
 
 namespace magneticfield {
 
@@ -48,6 +49,10 @@ namespace magneticfield {
 
     void setGridFiles(const TableFileMap& gridFiles);
 
+    /// Read the grids from a pack rather than from the files of the table set
+    /// (those it does not contain still are)
+    void setGridPack(const MFGridPack* gridPack);
+
     /// Get barrel layers
     std::vector<MagBLayer*> barrelLayers() const;
 
@@ -85,6 +90,7 @@ namespace magneticfield {
 
     std::map<int, double> theScalingFactors_;
     const TableFileMap* theGridFiles_;  // Non-owned pointer assumed to be valid until build() is called
+    const MFGridPack* theGridPack_;     // Non-owned pointer assumed to be valid until build() is called
 
     const bool debug_;
   };
@@ -27,6 +27,7 @@
 
 #include "MagneticField/Interpolation/interface/MagProviderInterpol.h"
 #include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
 #include "MagneticField/Interpolation/interface/MFGrid.h"
 
 #include "MagneticField/VolumeGeometry/interface/MagVolume6Faces.h"
@@ -55,7 +56,11 @@ using namespace std;
 using namespace magneticfield;
 
 MagGeoBuilderFromDDD::MagGeoBuilderFromDDD(string tableSet_, int geometryVersion_, bool debug_)
-    : tableSet(tableSet_), geometryVersion(geometryVersion_), theGridFiles(nullptr), debug(debug_) {
+    : tableSet(tableSet_),
+      geometryVersion(geometryVersion_),
+      theGridFiles(nullptr),
+      theGridPack(nullptr),
+      debug(debug_) {
   if (debug)
     cout << "Constructing a MagGeoBuilderFromDDD" << endl;
 }
@@ -519,15 +524,18 @@ void MagGeoBuilderFromDDD::buildInterpolator(const volumeHandle* vol,
   }
 
   string fullPath;
-
-  try {
-    edm::FileInPath mydata("MagneticField/Interpolation/data/" + tableSet + "/" + vol->magFile);
-    fullPath = mydata.fullPath();
-  } catch (edm::Exception& exc) {
-    cerr << "MagGeoBuilderFromDDD: exception in reading table; " << exc.what() << endl;
-    if (!debug)
-      throw;
-    return;
+  const bool inPack = theGridPack != nullptr && theGridPack->find(vol->magFile).first != nullptr;
+
+  if (!inPack) {
+    try {
+      edm::FileInPath mydata("MagneticField/Interpolation/data/" + tableSet + "/" + vol->magFile);
+      fullPath = mydata.fullPath();
+    } catch (edm::Exception& exc) {
+      cerr << "MagGeoBuilderFromDDD: exception in reading table; " << exc.what() << endl;
+      if (!debug)
+        throw;
+      return;
+    }
   }
 
   try {
@@ -551,7 +559,8 @@ void MagGeoBuilderFromDDD::buildInterpolator(const volumeHandle* vol,
                                        vol->placement()->rotation() * rot);
       }
 
-      interpolators[vol->magFile] = MFGridFactory::build(fullPath, rf);
+      interpolators[vol->magFile] =
+          inPack ? MFGridFactory::build(*theGridPack, vol->magFile, rf) : MFGridFactory::build(fullPath, rf);
     }
   } catch (MagException& exc) {
     cout << exc.what() << endl;
@@ -668,3 +677,5 @@ void MagGeoBuilderFromDDD::setScaling(const std::vector<int>& keys, const std::v
 }
 
 void MagGeoBuilderFromDDD::setGridFiles(const TableFileMap& gridFiles) { theGridFiles = &gridFiles; }
+
+void MagGeoBuilderFromDDD::setGridPack(const MFGridPack* gridPack) { theGridPack = gridPack; }
@@ -22,6 +22,7 @@ class Surface;
 class MagBLayer;
 class MagESector;
 class MagVolume6Faces;
+class MFGridPack;
 namespace magneticfield {
   class VolumeBasedMagneticFieldESProducer;
   class VolumeBasedMagneticFieldESProducerFromDB;
@@ -44,6 +45,10 @@ public:
 
   void setGridFiles(const magneticfield::TableFileMap& gridFiles);
 
+  /// Read the grids from a pack rather than from the files of the table set
+  /// (those it does not contain still are)
+  void setGridPack(const MFGridPack* gridPack);
+
   /// Get barrel layers
   std::vector<MagBLayer*> barrelLayers() const;
 
@@ -95,6 +100,7 @@ private:
 
   std::map<int, double> theScalingFactors;
   const magneticfield::TableFileMap* theGridFiles;  // Non-owned pointer assumed to be valid until build() is called
+  const MFGridPack* theGridPack;                    // Non-owned pointer assumed to be valid until build() is called
 
   const bool debug;
 };
@@ -10,6 +10,8 @@
 
 #include <string>
 class MFGrid;
+class MFGridPack;
+class binary_ifstream;
 template <class T>
 class GloballyPositioned;
 
@@ -20,6 +22,12 @@ public:
 
   /// Build a 2pi phi-symmetric interpolator for a binary grid file
   static MFGrid* build(const std::string& name, const GloballyPositioned<float>& vol, double phiMin, double phiMax);
+
+  /// Build interpolator for a grid of a pack; nullptr if the pack does not contain it
+  static MFGrid* build(const MFGridPack& pack, const std::string& name, const GloballyPositioned<float>& vol);
+
+private:
+  static MFGrid* build(binary_ifstream& inFile, const GloballyPositioned<float>& vol);
 };
 
 #endif
@@ -0,0 +1,47 @@
+#ifndef MFGridPack_h
+#define MFGridPack_h
+
+/** \class MFGridPack
+ *
+ *  The binary grid files of a table set packed in a single file, which is
+ *  mapped in memory: the interpolators of all the volumes are read from it
+ *  instead of opening one file per volume.
+ *
+ *  Layout: the magic "MFGP", the format version and the number of grids
+ *  (uint32 each); for each grid the length of its name (uint32), the name,
+ *  the offset of its content from the start of the file and its size
+ *  (uint64 each); then the contents of the grid files, unchanged.
+ *  The grids are named by their path in the table set directory, as
+ *  the magFile of the volumes.
+ */
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class MFGridPack {
+public:
+  /// Map the pack file in memory; throws MagException if it is not a valid pack
+  explicit MFGridPack(const std::string& fileName);
+  ~MFGridPack();
+
+  MFGridPack(const MFGridPack&) = delete;
+  MFGridPack& operator=(const MFGridPack&) = delete;
+
+  /// The content of a grid file, or (nullptr, 0) if it is not in the pack
+  std::pair<const char*, size_t> find(const std::string& gridName) const;
+
+  size_t size() const { return theGrids.size(); }
+
+  /// Pack the grid files at the given paths relative to tableDir
+  static void write(const std::string& fileName, const std::string& tableDir, const std::vector<std::string>& grids);
+
+private:
+  const char* theData;
+  size_t theSize;
+  std::unordered_map<std::string, std::pair<const char*, size_t>> theGrids;
+};
+
+#endif
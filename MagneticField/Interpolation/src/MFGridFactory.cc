@@ -1,4 +1,5 @@
 #include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
 #include "binary_ifstream.h"
 #include "DataFormats/GeometrySurface/interface/GloballyPositioned.h"
 
@@ -15,6 +16,18 @@ using namespace std;
 
 MFGrid* MFGridFactory::build(const string& name, const GloballyPositioned<float>& vol) {
   binary_ifstream inFile(name);
+  return build(inFile, vol);
+}
+
+MFGrid* MFGridFactory::build(const MFGridPack& pack, const string& name, const GloballyPositioned<float>& vol) {
+  auto grid = pack.find(name);
+  if (grid.first == nullptr)
+    return nullptr;
+  binary_ifstream inFile(grid.first, grid.second);
+  return build(inFile, vol);
+}
+
+MFGrid* MFGridFactory::build(binary_ifstream& inFile, const GloballyPositioned<float>& vol) {
   int gridType;
   inFile >> gridType;
 
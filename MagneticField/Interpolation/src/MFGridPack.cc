@@ -0,0 +1,115 @@
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
+#include "MagneticField/VolumeGeometry/interface/MagExceptions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+  constexpr char packMagic[4] = {'M', 'F', 'G', 'P'};
+  constexpr uint32_t packVersion = 1;
+
+  template <typename T>
+  T readAt(const char* data, size_t size, size_t& pos) {
+    if (pos + sizeof(T) > size)
+      throw MagException("MFGridPack: truncated index");
+    T value;
+    memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  template <typename T>
+  void writeTo(ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}  // namespace
+
+MFGridPack::MFGridPack(const string& fileName) : theData(nullptr), theSize(0) {
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw MagException(("MFGridPack: cannot open " + fileName).c_str());
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      theData = static_cast<const char*>(p);
+      theSize = st.st_size;
+    }
+  }
+  close(fd);
+  if (theData == nullptr)
+    throw MagException(("MFGridPack: cannot map " + fileName).c_str());
+
+  try {
+    size_t pos = sizeof(packMagic);
+    if (theSize < pos || memcmp(theData, packMagic, sizeof(packMagic)) != 0 ||
+        readAt<uint32_t>(theData, theSize, pos) != packVersion)
+      throw MagException(("MFGridPack: " + fileName + " is not a grid pack of version 1").c_str());
+    uint32_t nGrids = readAt<uint32_t>(theData, theSize, pos);
+    theGrids.reserve(nGrids);
+    for (uint32_t i = 0; i < nGrids; ++i) {
+      uint32_t nameSize = readAt<uint32_t>(theData, theSize, pos);
+      if (pos + nameSize > theSize)
+        throw MagException("MFGridPack: truncated index");
+      string name(theData + pos, nameSize);
+      pos += nameSize;
+      uint64_t offset = readAt<uint64_t>(theData, theSize, pos);
+      uint64_t size = readAt<uint64_t>(theData, theSize, pos);
+      if (offset + size > theSize)
+        throw MagException(("MFGridPack: grid " + name + " beyond the end of " + fileName).c_str());
+      theGrids.emplace(std::move(name), make_pair(theData + offset, size_t(size)));
+    }
+  } catch (...) {
+    munmap(const_cast<char*>(theData), theSize);
+    throw;
+  }
+}
+
+MFGridPack::~MFGridPack() { munmap(const_cast<char*>(theData), theSize); }
+
+pair<const char*, size_t> MFGridPack::find(const string& gridName) const {
+  auto i = theGrids.find(gridName);
+  if (i == theGrids.end())
+    return make_pair(nullptr, 0);
+  return i->second;
+}
+
+void MFGridPack::write(const string& fileName, const string& tableDir, const vector<string>& grids) {
+  vector<string> contents;
+  contents.reserve(grids.size());
+  for (auto const& grid : grids) {
+    ifstream in(tableDir + "/" + grid, ios::binary);
+    if (!in)
+      throw MagException(("MFGridPack: cannot read " + tableDir + "/" + grid).c_str());
+    contents.emplace_back(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+  }
+
+  uint64_t offset = sizeof(packMagic) + 2 * sizeof(uint32_t);
+  for (auto const& grid : grids)
+    offset += sizeof(uint32_t) + grid.size() + 2 * sizeof(uint64_t);
+
+  ofstream out(fileName, ios::binary);
+  out.write(packMagic, sizeof(packMagic));
+  writeTo<uint32_t>(out, packVersion);
+  writeTo<uint32_t>(out, grids.size());
+  for (size_t i = 0; i < grids.size(); ++i) {
+    writeTo<uint32_t>(out, grids[i].size());
+    out.write(grids[i].data(), grids[i].size());
+    writeTo<uint64_t>(out, offset);
+    writeTo<uint64_t>(out, contents[i].size());
+    offset += contents[i].size();
+  }
+  for (auto const& content : contents)
+    out.write(content.data(), content.size());
+  if (!out)
+    throw MagException(("MFGridPack: cannot write " + fileName).c_str());
+}
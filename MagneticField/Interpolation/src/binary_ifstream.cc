@@ -9,6 +9,15 @@ binary_ifstream::binary_ifstream(const char* name) : file_(nullptr) { init(name)
 
 binary_ifstream::binary_ifstream(const std::string& name) : file_(nullptr) { init(name.c_str()); }
 
+binary_ifstream::binary_ifstream(const char* data, size_t size) : file_(nullptr) {
+  // opened read-only, the buffer is not written
+  file_ = fmemopen(const_cast<char*>(data), size, "rb");
+  if (file_ == nullptr) {
+    std::cout << "buffer of " << size << " bytes cannot be opened for reading" << std::endl;
+    throw binary_ifstream_error();
+  }
+}
+
 void binary_ifstream::init(const char* name) {
   file_ = fopen(name, "rb");
   if (file_ == nullptr) {
@@ -9,6 +9,8 @@ class binary_ifstream {
 public:
   explicit binary_ifstream(const char* name);
   explicit binary_ifstream(const std::string& name);
+  /// Read from a buffer in memory, e.g. a grid of an MFGridPack
+  binary_ifstream(const char* data, size_t size);
 
   ~binary_ifstream();
 
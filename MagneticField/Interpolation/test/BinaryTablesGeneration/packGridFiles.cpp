@@ -0,0 +1,38 @@
+// Pack the binary grid files of a table set in a single file, read by
+// VolumeBasedMagneticFieldESProducer with its gridPack parameter.
+//
+// usage: packGridFiles <output pack> <table set directory> [grid files]
+// The grid files are given by their path relative to the table set
+// directory; if they are not on the command line they are read from the
+// standard input, one per line, e.g.
+//   cd grid_160812_3_8t; find . -name '*.bin' | sed 's|^\./||' | packGridFiles ../grid_160812_3_8t.pack .
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "usage: " << argv[0] << " <output pack> <table set directory> [grid files]" << std::endl;
+    return 1;
+  }
+  std::vector<std::string> grids(argv + 3, argv + argc);
+  if (grids.empty()) {
+    std::string grid;
+    while (std::getline(std::cin, grid))
+      if (!grid.empty())
+        grids.push_back(grid);
+  }
+
+  try {
+    MFGridPack::write(argv[1], argv[2], grids);
+    MFGridPack pack(argv[1]);
+    std::cout << "Packed " << pack.size() << " grids in " << argv[1] << std::endl;
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,111 @@
+// The grids of an MFGridPack give the same content and the same interpolators as the grid files
+#include "MagneticField/Interpolation/interface/MFGrid.h"
+#include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPack.h"
+#include "MagneticField/Interpolation/src/binary_ofstream.h"
+#include "MagneticField/VolumeGeometry/interface/MagExceptions.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace {
+
+  // a RectangularCartesianMFGrid (type 1) of n x n x n nodes, as written by prepareMagneticFieldGrid
+  void writeGrid(const std::string& fileName, int n, double step, float scale) {
+    binary_ofstream out(fileName);
+    out << int(1) << n << n << n;
+    out << 0. << 0. << 0.;
+    out << step << step << step;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        for (int k = 0; k < n; ++k)
+          out << scale * float(i + 1) << scale * float(j - k) << scale * std::sin(float(i * j + k));
+    out << std::string("complete");
+    out.close();
+  }
+
+  std::string content(const std::string& fileName) {
+    std::ifstream in(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  bool different(const MFGrid::LocalVector& a, const MFGrid::LocalVector& b) {
+    return a.x() != b.x() || a.y() != b.y() || a.z() != b.z();
+  }
+
+  template <typename F>
+  bool throwsMagException(F&& f) {
+    try {
+      f();
+    } catch (MagException&) {
+      return true;
+    }
+    return false;
+  }
+
+}  // namespace
+
+int main() {
+  const std::string tableDir = "testMFGridPack_tables";
+  mkdir(tableDir.c_str(), 0755);
+  mkdir((tableDir + "/s01").c_str(), 0755);
+  const std::vector<std::string> grids = {"grid.1.bin", "s01/grid.2.bin"};
+  writeGrid(tableDir + "/" + grids[0], 5, 10., 1.f);
+  writeGrid(tableDir + "/" + grids[1], 8, 3., -0.5f);
+
+  const std::string packName = "testMFGridPack.pack";
+  MFGridPack::write(packName, tableDir, grids);
+
+  int failures = 0;
+  GloballyPositioned<float> const vol(GloballyPositioned<float>::PositionType(0, 0, 0),
+                                      GloballyPositioned<float>::RotationType());
+  {
+    MFGridPack const pack(packName);
+    failures += pack.size() != grids.size();
+    failures += pack.find("grid.3.bin").first != nullptr;
+    failures += MFGridFactory::build(pack, "grid.3.bin", vol) != nullptr;
+
+    std::mt19937 rng(56);
+    std::uniform_real_distribution<float> flat(0.f, 1.f);
+    for (auto const& grid : grids) {
+      const std::string file = tableDir + "/" + grid;
+      auto const packed = pack.find(grid);
+      failures += packed.first == nullptr || std::string(packed.first, packed.second) != content(file);
+
+      std::unique_ptr<MFGrid> fromFile(MFGridFactory::build(file, vol));
+      std::unique_ptr<MFGrid> fromPack(MFGridFactory::build(pack, grid, vol));
+      if (!fromFile || !fromPack) {
+        ++failures;
+        continue;
+      }
+      auto const dims = fromFile->dimensions();
+      for (int i = 0; i < dims.w; ++i)
+        for (int j = 0; j < dims.h; ++j)
+          for (int k = 0; k < dims.d; ++k)
+            failures += different(fromFile->nodeValue(i, j, k), fromPack->nodeValue(i, j, k));
+      auto const far = fromFile->nodePosition(dims.w - 1, dims.h - 1, dims.d - 1);
+      for (int p = 0; p < 100; ++p) {
+        MFGrid::LocalPoint const point(far.x() * flat(rng), far.y() * flat(rng), far.z() * flat(rng));
+        failures += different(fromFile->valueInTesla(point), fromPack->valueInTesla(point));
+      }
+    }
+  }
+
+  // a grid file is not a pack, nor is a truncated pack
+  failures += !throwsMagException([&] { MFGridPack pack(tableDir + "/" + grids[0]); });
+  const std::string packed = content(packName);
+  std::ofstream(packName, std::ios::binary).write(packed.data(), 20);
+  failures += !throwsMagException([&] { MFGridPack pack(packName); });
+  failures += !throwsMagException([&] { MFGridPack pack("testMFGridPack.missing"); });
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
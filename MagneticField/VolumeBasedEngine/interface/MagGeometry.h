@@ -11,7 +11,6 @@
 #include "MagneticField/Layers/src/MagBinFinders.h"
 
 #include <vector>
-#include <atomic>
 
 class MagBLayer;
 class MagESector;
@@ -61,7 +60,8 @@ private:
 
   bool inBarrel(const GlobalPoint& gp) const;
 
-  mutable std::atomic<MagVolume const*> lastVolume;  // Cache last volume found
+  // Identifies this geometry in the last volume cached by each thread
+  const unsigned int theCacheId;
 
   std::vector<MagBLayer const*> theBLayers;
   std::vector<MagESector const*> theESectors;
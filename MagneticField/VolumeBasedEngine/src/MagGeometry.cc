@@ -18,11 +18,26 @@
 #include "MagneticField/Layers/interface/MagVerbosity.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <atomic>
 #include <iostream>
 
 using namespace std;
 using namespace edm;
 
+namespace {
+  // The last volume found by each thread. The threads follow different tracks,
+  // so a shared cache would be overwritten by the others at each miss (and its
+  // cache line bounce between the cores); the id of the geometry it belongs to
+  // keeps the volumes of a geometry from being returned by another one.
+  struct LastVolume {
+    unsigned int cacheId = 0;
+    MagVolume const* volume = nullptr;
+  };
+  thread_local LastVolume lastVolume;
+
+  std::atomic<unsigned int> nextCacheId{1};
+}  // namespace
+
 MagGeometry::MagGeometry(int geomVersion,
                          const std::vector<MagBLayer*>& tbl,
                          const std::vector<MagESector*>& tes,
@@ -39,7 +54,7 @@ MagGeometry::MagGeometry(int geomVersion,
                          const std::vector<MagESector const*>& tes,
                          const std::vector<MagVolume6Faces const*>& tbv,
                          const std::vector<MagVolume6Faces const*>& tev)
-    : lastVolume(nullptr),
+    : theCacheId(nextCacheId++),
       theBLayers(tbl),
       theESectors(tes),
       theBVolumes(tbv),
@@ -149,9 +164,9 @@ MagVolume const* MagGeometry::findVolume1(const GlobalPoint& gp, double toleranc
 // Use hierarchical structure for fast lookup.
 MagVolume const* MagGeometry::findVolume(const GlobalPoint& gp, double tolerance) const {
   // Check volume cache
-  auto lastVolumeCheck = lastVolume.load(std::memory_order_acquire);
-  if (lastVolumeCheck != nullptr && lastVolumeCheck->inside(gp)) {
-    return lastVolumeCheck;
+  LastVolume& last = lastVolume;
+  if (last.cacheId == theCacheId && last.volume != nullptr && last.volume->inside(gp)) {
+    return last.volume;
   }
 
   MagVolume const* result = nullptr;
@@ -192,8 +207,10 @@ MagVolume const* MagGeometry::findVolume(const GlobalPoint& gp, double tolerance
     result = findVolume(gp, 0.03);
   }
 
-  if (cacheLastVolume)
-    lastVolume.store(result, std::memory_order_release);
+  if (cacheLastVolume) {
+    last.cacheId = theCacheId;
+    last.volume = result;
+  }
 
   return result;
 }
@@ -11,6 +11,7 @@
 
 #include "FWCore/Framework/interface/ConsumesCollector.h"
 
+#include <cmath>
 #include <unordered_map>
 
 namespace citk {
@@ -32,6 +33,9 @@ namespace citk {
 
     const std::string& additionalCode() const { return _additionalCode; }
 
+    // the size of the cone outside which no candidate is in the isolation cone
+    float coneSize() const { return std::sqrt(_coneSize2); }
+
     //! Destructor
     virtual ~IsolationConeDefinitionBase(){};
 
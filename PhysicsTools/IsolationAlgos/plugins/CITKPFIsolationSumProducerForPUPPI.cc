@@ -12,12 +12,14 @@
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "PhysicsTools/IsolationAlgos/interface/CITKIsolationConeDefinitionBase.h"
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 
@@ -48,6 +50,7 @@ namespace citk {
     // indexed by pf candidate type
     std::array<IsoTypes, kNPFTypes> _isolation_types;
     std::array<std::vector<std::string>, kNPFTypes> _product_names;
+    EtaPhiConeIndex _isolate_with_index;
     bool useValueMapForPUPPI = true;
     bool usePUPPINoLepton =
         false;  // in case puppi weights are taken from packedCandidate can take weights for puppiNoLeptons
@@ -125,6 +128,15 @@ namespace citk {
         isolator->getEventInfo(ev);
       }
     }
+    // the candidates near each candidate to isolate, with the largest of the isolation cones
+    float maxConeSize = 0;
+    for (const auto& isolators_for_type : _isolation_types) {
+      for (const auto& isolator : isolators_for_type) {
+        maxConeSize = std::max(maxConeSize, isolator->coneSize());
+      }
+    }
+    _isolate_with_index.fill(*isolate_with, maxConeSize);
+    std::vector<unsigned int> inCone;
     reco::PFCandidate helper;  // to translate pdg id to type
     // loop over the candidates we are isolating and fill the values
     for (size_t c = 0; c < to_isolate->size(); ++c) {
@@ -137,7 +149,8 @@ namespace citk {
           value = 0.0;
         ++k;
       }
-      for (size_t ic = 0; ic < isolate_with->size(); ++ic) {
+      _isolate_with_index.candidatesInCone(cand_to_isolate->eta(), cand_to_isolate->phi(), maxConeSize, inCone);
+      for (size_t ic : inCone) {
         auto isocand = isolate_with->ptrAt(ic);
         edm::Ptr<pat::PackedCandidate> aspackedCandidate(isocand);
         auto isotype = helper.translatePdgIdToType(isocand->pdgId());
@@ -8,6 +8,7 @@
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
 #include "CommonTools/Utils/interface/StringObjectFunction.h"
 
+#include <algorithm>
 #include <vector>
 #include <boost/ptr_container/ptr_vector.hpp>
 
@@ -18,19 +19,22 @@ public:
       : name_(params.getParameter<std::string>("name")),
         doc_(params.existsAs<std::string>("doc") ? params.getParameter<std::string>("doc") : ""),
         extension_(params.existsAs<bool>("extension") ? params.getParameter<bool>("extension") : false),
+        compiledPackage_(params.existsAs<std::string>("compiledPackage")
+                             ? params.getParameter<std::string>("compiledPackage")
+                             : ""),
         src_(consumes<TProd>(params.getParameter<edm::InputTag>("src"))) {
     edm::ParameterSet const &varsPSet = params.getParameter<edm::ParameterSet>("variables");
     for (const std::string &vname : varsPSet.getParameterNamesForType<edm::ParameterSet>()) {
       const auto &varPSet = varsPSet.getParameter<edm::ParameterSet>(vname);
       const std::string &type = varPSet.getParameter<std::string>("type");
       if (type == "int")
-        vars_.push_back(new IntVar(vname, nanoaod::FlatTable::IntColumn, varPSet));
+        vars_.push_back(new IntVar(vname, nanoaod::FlatTable::IntColumn, varPSet, compiledPackage()));
       else if (type == "float")
-        vars_.push_back(new FloatVar(vname, nanoaod::FlatTable::FloatColumn, varPSet));
+        vars_.push_back(new FloatVar(vname, nanoaod::FlatTable::FloatColumn, varPSet, compiledPackage()));
       else if (type == "uint8")
-        vars_.push_back(new UInt8Var(vname, nanoaod::FlatTable::UInt8Column, varPSet));
+        vars_.push_back(new UInt8Var(vname, nanoaod::FlatTable::UInt8Column, varPSet, compiledPackage()));
       else if (type == "bool")
-        vars_.push_back(new BoolVar(vname, nanoaod::FlatTable::BoolColumn, varPSet));
+        vars_.push_back(new BoolVar(vname, nanoaod::FlatTable::BoolColumn, varPSet, compiledPackage()));
       else
         throw cms::Exception("Configuration", "unsupported type " + type + " for variable " + vname);
     }
@@ -55,9 +59,14 @@ public:
   }
 
 protected:
+  // the package the precompiled header of which declares T, for the expressions to be compiled to native code,
+  // or nullptr for them to be interpreted
+  const char *compiledPackage() const { return compiledPackage_.empty() ? nullptr : compiledPackage_.c_str(); }
+
   const std::string name_;
   const std::string doc_;
   const bool extension_;
+  const std::string compiledPackage_;
   const edm::EDGetTokenT<TProd> src_;
 
   class VariableBase {
@@ -81,23 +90,36 @@ protected:
   public:
     Variable(const std::string &aname, nanoaod::FlatTable::ColumnType atype, const edm::ParameterSet &cfg)
         : VariableBase(aname, atype, cfg) {}
-    virtual void fill(std::vector<const T *> selobjs, nanoaod::FlatTable &out) const = 0;
+    virtual void fill(const std::vector<const T *> &selobjs, nanoaod::FlatTable &out) const = 0;
   };
   template <typename StringFunctor, typename ValType>
   class FuncVariable : public Variable {
   public:
-    FuncVariable(const std::string &aname, nanoaod::FlatTable::ColumnType atype, const edm::ParameterSet &cfg)
+    FuncVariable(const std::string &aname,
+                 nanoaod::FlatTable::ColumnType atype,
+                 const edm::ParameterSet &cfg,
+                 const char *compiledPackage)
         : Variable(aname, atype, cfg),
-          func_(cfg.getParameter<std::string>("expr"), true),
+          func_(cfg.getParameter<std::string>("expr"), true, compiledPackage),
           precisionFunc_(cfg.existsAs<std::string>("precision") ? cfg.getParameter<std::string>("precision") : "23",
                          true) {}
     ~FuncVariable() override {}
-    void fill(std::vector<const T *> selobjs, nanoaod::FlatTable &out) const override {
-      std::vector<ValType> vals(selobjs.size());
-      for (unsigned int i = 0, n = vals.size(); i < n; ++i) {
-        if (this->precision_ == -2) {
-          vals[i] = MiniFloatConverter::reduceMantissaToNbitsRounding(func_(*selobjs[i]), precisionFunc_(*selobjs[i]));
-        } else
+    // the column is filled in one pass over the objects per expression, and the rounding to the precisions
+    // given by an expression in a separate loop over the values
+    void fill(const std::vector<const T *> &selobjs, nanoaod::FlatTable &out) const override {
+      const unsigned int n = selobjs.size();
+      std::vector<ValType> vals(n);
+      if (this->precision_ == -2) {
+        std::vector<float> values(n);
+        std::vector<int> bits(n);
+        for (unsigned int i = 0; i < n; ++i)
+          values[i] = func_(*selobjs[i]);
+        for (unsigned int i = 0; i < n; ++i)
+          bits[i] = precisionFunc_(*selobjs[i]);
+        MiniFloatConverter::reduceMantissaToNbitsRounding(values.begin(), values.end(), bits.begin(), values.begin());
+        std::copy(values.begin(), values.end(), vals.begin());
+      } else {
+        for (unsigned int i = 0; i < n; ++i)
           vals[i] = func_(*selobjs[i]);
       }
       out.template addColumn<ValType>(this->name_, vals, this->doc_, this->type_, this->precision_);
@@ -124,7 +146,7 @@ public:
         singleton_(params.getParameter<bool>("singleton")),
         maxLen_(params.existsAs<unsigned int>("maxLen") ? params.getParameter<unsigned int>("maxLen")
                                                         : std::numeric_limits<unsigned int>::max()),
-        cut_(!singleton_ ? params.getParameter<std::string>("cut") : "", true) {
+        cut_(!singleton_ ? params.getParameter<std::string>("cut") : "", true, this->compiledPackage()) {
     if (params.existsAs<edm::ParameterSet>("externalVariables")) {
       edm::ParameterSet const &extvarsPSet = params.getParameter<edm::ParameterSet>("externalVariables");
       for (const std::string &vname : extvarsPSet.getParameterNamesForType<edm::ParameterSet>()) {
@@ -189,7 +211,9 @@ protected:
   public:
     ExtVariable(const std::string &aname, nanoaod::FlatTable::ColumnType atype, const edm::ParameterSet &cfg)
         : base::VariableBase(aname, atype, cfg) {}
-    virtual void fill(const edm::Event &iEvent, std::vector<edm::Ptr<T>> selptrs, nanoaod::FlatTable &out) const = 0;
+    virtual void fill(const edm::Event &iEvent,
+                      const std::vector<edm::Ptr<T>> &selptrs,
+                      nanoaod::FlatTable &out) const = 0;
   };
   template <typename TIn, typename ValType = TIn>
   class ValueMapVariable : public ExtVariable {
@@ -200,7 +224,9 @@ protected:
                      edm::ConsumesCollector &&cc)
         : ExtVariable(aname, atype, cfg),
           token_(cc.consumes<edm::ValueMap<TIn>>(cfg.getParameter<edm::InputTag>("src"))) {}
-    void fill(const edm::Event &iEvent, std::vector<edm::Ptr<T>> selptrs, nanoaod::FlatTable &out) const override {
+    void fill(const edm::Event &iEvent,
+              const std::vector<edm::Ptr<T>> &selptrs,
+              nanoaod::FlatTable &out) const override {
       edm::Handle<edm::ValueMap<TIn>> vmap;
       iEvent.getByToken(token_, vmap);
       std::vector<ValType> vals(selptrs.size());
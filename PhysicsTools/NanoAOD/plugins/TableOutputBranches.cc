@@ -14,16 +14,16 @@ void TableOutputBranches::defineBranchesFromFirstEvent(const nanoaod::FlatTable
     const std::string &var = tab.columnName(i);
     switch (tab.columnType(i)) {
       case (nanoaod::FlatTable::FloatColumn):
-        m_floatBranches.emplace_back(var, tab.columnDoc(i), "F");
+        m_floatBranches.emplace_back(var, tab.columnDoc(i), "F", i);
         break;
       case (nanoaod::FlatTable::IntColumn):
-        m_intBranches.emplace_back(var, tab.columnDoc(i), "I");
+        m_intBranches.emplace_back(var, tab.columnDoc(i), "I", i);
         break;
       case (nanoaod::FlatTable::UInt8Column):
-        m_uint8Branches.emplace_back(var, tab.columnDoc(i), "b");
+        m_uint8Branches.emplace_back(var, tab.columnDoc(i), "b", i);
         break;
       case (nanoaod::FlatTable::BoolColumn):
-        m_uint8Branches.emplace_back(var, tab.columnDoc(i), "O");
+        m_uint8Branches.emplace_back(var, tab.columnDoc(i), "O", i);
         break;
     }
   }
@@ -34,11 +34,13 @@ private:
   struct NamedBranchPtr {
     std::string name, title, rootTypeCode;
     TBranch *branch;
+    int columnIndex;  // position of the column in the last table seen, saves looking it up by name every event
     NamedBranchPtr(const std::string &aname,
                    const std::string &atitle,
                    const std::string &rootType,
+                   int acolumnIndex,
                    TBranch *branchptr = nullptr)
-        : name(aname), title(atitle), rootTypeCode(rootType), branch(branchptr) {}
+        : name(aname), title(atitle), rootTypeCode(rootType), branch(branchptr), columnIndex(acolumnIndex) {}
   };
   TBranch *m_counterBranch;
   std::vector<NamedBranchPtr> m_floatBranches;
@@ -48,9 +50,13 @@ private:
 
   template <typename T>
   void fillColumn(NamedBranchPtr &pair, const nanoaod::FlatTable &tab) {
-    int idx = tab.columnIndex(pair.name);
-    if (idx == -1)
-      throw cms::Exception("LogicError", "Missing column in input for " + m_baseName + "_" + pair.name);
+    int idx = pair.columnIndex;
+    if (idx < 0 || static_cast<unsigned int>(idx) >= tab.nColumns() || tab.columnName(idx) != pair.name) {
+      idx = tab.columnIndex(pair.name);
+      if (idx == -1)
+        throw cms::Exception("LogicError", "Missing column in input for " + m_baseName + "_" + pair.name);
+      pair.columnIndex = idx;
+    }
     pair.branch->SetAddress(const_cast<T *>(&tab.columnData<T>(idx).front()));  // SetAddress should take a const * !
   }
 };
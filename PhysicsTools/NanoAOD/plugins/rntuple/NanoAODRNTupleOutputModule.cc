@@ -0,0 +1,289 @@
+// -*- C++ -*-
+//
+// Package:     PhysicsTools/NanoAOD
+// Class  :     NanoAODRNTupleOutputModule
+//
+// Implementation:
+//     Writes the nanoaod::FlatTable products of each event as fields of an
+//     RNTuple named "Events" instead of the TTree written by NanoAODOutputModule.
+//     Each column of a table becomes one field named <table>_<column>, a scalar
+//     for singleton tables and a std::vector otherwise. Since an RNTuple model can
+//     not be changed once the writer exists, the fields are defined from the
+//     content of the first event, like TableOutputBranches does for the branches.
+//     Bool columns are kept as std::uint8_t, which is how FlatTable stores them.
+//
+
+// system include files
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Compression.h"
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+
+// user include files
+#include "FWCore/Framework/interface/OutputModule.h"
+#include "FWCore/Framework/interface/one/OutputModule.h"
+#include "FWCore/Framework/interface/RunForOutput.h"
+#include "FWCore/Framework/interface/LuminosityBlockForOutput.h"
+#include "FWCore/Framework/interface/EventForOutput.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/JobReport.h"
+#include "FWCore/Utilities/interface/GlobalIdentifier.h"
+#include "FWCore/Utilities/interface/Digest.h"
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/NanoAOD/interface/FlatTable.h"
+
+class NanoAODRNTupleOutputModule : public edm::one::OutputModule<> {
+public:
+  NanoAODRNTupleOutputModule(edm::ParameterSet const& pset);
+  ~NanoAODRNTupleOutputModule() override;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void write(edm::EventForOutput const& e) override;
+  void writeLuminosityBlock(edm::LuminosityBlockForOutput const&) override;
+  void writeRun(edm::RunForOutput const&) override;
+  bool isFileOpen() const override;
+  void openFile(edm::FileBlock const&) override;
+  void reallyCloseFile() override;
+
+  void createWriter(edm::EventForOutput const* iEvent);
+
+  class TableFields {
+  public:
+    TableFields(const edm::BranchDescription* desc, const edm::EDGetToken& token) : m_token(token) {
+      if (desc->className() != "nanoaod::FlatTable")
+        throw cms::Exception("Configuration",
+                             "NanoAODRNTupleOutputModule can only write out nanoaod::FlatTable objects");
+    }
+
+    void createFields(const edm::EventForOutput& iEvent, ROOT::Experimental::RNTupleModel& model);
+    void fill(const edm::EventForOutput& iEvent);
+
+  private:
+    template <typename T>
+    struct Column {
+      Column(std::string n, int idx) : name(std::move(n)), index(idx) {}
+      std::string name;
+      int index;
+      std::shared_ptr<T> value;                // for singleton tables
+      std::shared_ptr<std::vector<T>> values;  // for the others
+    };
+
+    template <typename T>
+    void createField(Column<T>& column, ROOT::Experimental::RNTupleModel& model) {
+      std::string fieldName = m_baseName.empty() ? column.name : m_baseName + "_" + column.name;
+      if (m_singleton)
+        column.value = model.MakeField<T>(fieldName);
+      else
+        column.values = model.MakeField<std::vector<T>>(fieldName);
+    }
+
+    template <typename T>
+    void fillColumn(Column<T>& column, const nanoaod::FlatTable& tab) {
+      int idx = column.index;
+      if (idx >= int(tab.nColumns()) || tab.columnName(idx) != column.name) {
+        idx = tab.columnIndex(column.name);
+        if (idx == -1)
+          throw cms::Exception("LogicError", "Missing column in input for " + m_baseName + "_" + column.name);
+        column.index = idx;
+      }
+      if (m_singleton) {
+        *column.value = tab.columValue<T>(idx);
+      } else {
+        auto data = tab.columnData<T>(idx);
+        column.values->assign(data.begin(), data.end());
+      }
+    }
+
+    edm::EDGetToken m_token;
+    std::string m_baseName;
+    bool m_singleton = false;
+    std::vector<Column<float>> m_floatColumns;
+    std::vector<Column<int>> m_intColumns;
+    std::vector<Column<std::uint8_t>> m_uint8Columns;
+  };
+
+  std::string m_fileName;
+  std::string m_logicalFileName;
+  int m_compressionLevel;
+  std::string m_compressionAlgorithm;
+  edm::JobReport::Token m_jrToken;
+  bool m_fileOpen = false;
+  std::unique_ptr<ROOT::Experimental::RNTupleWriter> m_writer;
+
+  std::shared_ptr<std::uint32_t> m_run;
+  std::shared_ptr<std::uint32_t> m_luminosityBlock;
+  std::shared_ptr<std::uint64_t> m_event;
+  std::vector<TableFields> m_tables;
+};
+
+void NanoAODRNTupleOutputModule::TableFields::createFields(const edm::EventForOutput& iEvent,
+                                                           ROOT::Experimental::RNTupleModel& model) {
+  edm::Handle<nanoaod::FlatTable> handle;
+  iEvent.getByToken(m_token, handle);
+  const nanoaod::FlatTable& tab = *handle;
+  m_baseName = tab.name();
+  m_singleton = tab.singleton();
+  for (size_t i = 0; i < tab.nColumns(); i++) {
+    const std::string& var = tab.columnName(i);
+    switch (tab.columnType(i)) {
+      case (nanoaod::FlatTable::FloatColumn):
+        m_floatColumns.emplace_back(var, i);
+        break;
+      case (nanoaod::FlatTable::IntColumn):
+        m_intColumns.emplace_back(var, i);
+        break;
+      case (nanoaod::FlatTable::UInt8Column):
+      case (nanoaod::FlatTable::BoolColumn):
+        m_uint8Columns.emplace_back(var, i);
+        break;
+    }
+  }
+  for (auto& column : m_floatColumns)
+    createField(column, model);
+  for (auto& column : m_intColumns)
+    createField(column, model);
+  for (auto& column : m_uint8Columns)
+    createField(column, model);
+}
+
+void NanoAODRNTupleOutputModule::TableFields::fill(const edm::EventForOutput& iEvent) {
+  edm::Handle<nanoaod::FlatTable> handle;
+  iEvent.getByToken(m_token, handle);
+  const nanoaod::FlatTable& tab = *handle;
+  if (tab.singleton() != m_singleton)
+    throw cms::Exception("LogicError", "Table " + m_baseName + " changed from singleton to vector or vice versa");
+  for (auto& column : m_floatColumns)
+    fillColumn(column, tab);
+  for (auto& column : m_intColumns)
+    fillColumn(column, tab);
+  for (auto& column : m_uint8Columns)
+    fillColumn(column, tab);
+}
+
+NanoAODRNTupleOutputModule::NanoAODRNTupleOutputModule(edm::ParameterSet const& pset)
+    : edm::one::OutputModuleBase::OutputModuleBase(pset),
+      edm::one::OutputModule<>(pset),
+      m_fileName(pset.getUntrackedParameter<std::string>("fileName")),
+      m_logicalFileName(pset.getUntrackedParameter<std::string>("logicalFileName")),
+      m_compressionLevel(pset.getUntrackedParameter<int>("compressionLevel")),
+      m_compressionAlgorithm(pset.getUntrackedParameter<std::string>("compressionAlgorithm")) {}
+
+NanoAODRNTupleOutputModule::~NanoAODRNTupleOutputModule() {}
+
+void NanoAODRNTupleOutputModule::createWriter(edm::EventForOutput const* iEvent) {
+  auto model = ROOT::Experimental::RNTupleModel::Create();
+  m_run = model->MakeField<std::uint32_t>("run");
+  m_luminosityBlock = model->MakeField<std::uint32_t>("luminosityBlock");
+  m_event = model->MakeField<std::uint64_t>("event");
+  // without an event the content of the tables is not known and only the event id fields are written
+  if (iEvent) {
+    for (auto& t : m_tables)
+      t.createFields(*iEvent, *model);
+  }
+
+  ROOT::Experimental::RNTupleWriteOptions options;
+  if (m_compressionAlgorithm == std::string("ZLIB")) {
+    options.SetCompression(ROOT::CompressionSettings(ROOT::kZLIB, m_compressionLevel));
+  } else if (m_compressionAlgorithm == std::string("LZMA")) {
+    options.SetCompression(ROOT::CompressionSettings(ROOT::kLZMA, m_compressionLevel));
+  } else if (m_compressionAlgorithm == std::string("ZSTD")) {
+    options.SetCompression(ROOT::CompressionSettings(ROOT::kZSTD, m_compressionLevel));
+  } else {
+    throw cms::Exception("Configuration")
+        << "NanoAODRNTupleOutputModule configured with unknown compression algorithm '" << m_compressionAlgorithm
+        << "'\n"
+        << "Allowed compression algorithms are ZLIB, LZMA and ZSTD\n";
+  }
+  m_writer = ROOT::Experimental::RNTupleWriter::Recreate(std::move(model), "Events", m_fileName, options);
+}
+
+void NanoAODRNTupleOutputModule::write(edm::EventForOutput const& iEvent) {
+  edm::Service<edm::JobReport> jr;
+  jr->eventWrittenToFile(m_jrToken, iEvent.id().run(), iEvent.id().event());
+
+  if (!m_writer)
+    createWriter(&iEvent);
+
+  *m_run = iEvent.id().run();
+  *m_luminosityBlock = iEvent.id().luminosityBlock();
+  *m_event = iEvent.id().event();
+  for (auto& t : m_tables)
+    t.fill(iEvent);
+  m_writer->Fill();
+}
+
+void NanoAODRNTupleOutputModule::writeLuminosityBlock(edm::LuminosityBlockForOutput const& iLumi) {
+  edm::Service<edm::JobReport> jr;
+  jr->reportLumiSection(m_jrToken, iLumi.id().run(), iLumi.id().value());
+}
+
+void NanoAODRNTupleOutputModule::writeRun(edm::RunForOutput const& iRun) {
+  edm::Service<edm::JobReport> jr;
+  jr->reportRunNumber(m_jrToken, iRun.id().run());
+}
+
+bool NanoAODRNTupleOutputModule::isFileOpen() const { return m_fileOpen; }
+
+void NanoAODRNTupleOutputModule::openFile(edm::FileBlock const&) {
+  edm::Service<edm::JobReport> jr;
+  cms::Digest branchHash;
+  m_jrToken = jr->outputFileOpened(m_fileName,
+                                   m_logicalFileName,
+                                   std::string(),
+                                   "NanoAODRNTupleOutputModule",
+                                   description().moduleLabel(),
+                                   edm::createGlobalIdentifier(),
+                                   std::string(),
+                                   branchHash.digest().toString(),
+                                   std::vector<std::string>());
+
+  m_tables.clear();
+  const auto& keeps = keptProducts();
+  for (const auto& keep : keeps[edm::InEvent]) {
+    m_tables.emplace_back(keep.first, keep.second);
+  }
+  m_fileOpen = true;
+}
+
+void NanoAODRNTupleOutputModule::reallyCloseFile() {
+  if (!m_writer)
+    createWriter(nullptr);
+  // the destructor of the writer commits the remaining clusters and the footer
+  m_writer.reset();
+  m_fileOpen = false;
+  edm::Service<edm::JobReport> jr;
+  jr->outputFileClosed(m_jrToken);
+}
+
+void NanoAODRNTupleOutputModule::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.addUntracked<std::string>("fileName");
+  desc.addUntracked<std::string>("logicalFileName", "");
+
+  desc.addUntracked<int>("compressionLevel", 5)->setComment("ROOT compression level of the RNTuple pages.");
+  desc.addUntracked<std::string>("compressionAlgorithm", "ZSTD")
+      ->setComment("Algorithm used to compress the RNTuple pages, allowed values are ZLIB, LZMA and ZSTD");
+
+  const std::vector<std::string> keep = {"drop *", "keep nanoaodFlatTable_*Table_*_*"};
+  edm::OutputModule::fillDescription(desc, keep);
+
+  //Used by Workflow management for their own meta data
+  edm::ParameterSetDescription dataSet;
+  dataSet.setAllowAnything();
+  desc.addUntracked<edm::ParameterSetDescription>("dataset", dataSet)
+      ->setComment("PSet is only used by Data Operations and not by this module.");
+
+  descriptions.addDefault(desc);
+}
+
+DEFINE_FWK_MODULE(NanoAODRNTupleOutputModule);
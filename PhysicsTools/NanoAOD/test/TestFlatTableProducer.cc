@@ -0,0 +1,56 @@
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/NanoAOD/interface/FlatTable.h"
+
+#include <cstdint>
+#include <vector>
+
+// Produces FlatTables whose content only depends on the event number, so that a reader can check them.
+// A singleton table holds x = event/2 and n = event, the other one holds event%3 rows with pt = event + row
+// and flag = row%2.
+class TestFlatTableProducer : public edm::global::EDProducer<> {
+public:
+  TestFlatTableProducer(edm::ParameterSet const& params)
+      : name_(params.getParameter<std::string>("name")), singleton_(params.getParameter<bool>("singleton")) {
+    produces<nanoaod::FlatTable>();
+  }
+
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup&) const override {
+    auto const event = iEvent.id().event();
+    std::unique_ptr<nanoaod::FlatTable> out;
+    if (singleton_) {
+      out = std::make_unique<nanoaod::FlatTable>(1, name_, true);
+      out->addColumnValue<float>("x", event * 0.5f, "half the event number", nanoaod::FlatTable::FloatColumn);
+      out->addColumnValue<int>("n", int(event), "event number", nanoaod::FlatTable::IntColumn);
+    } else {
+      unsigned int const rows = event % 3;
+      std::vector<float> pt;
+      std::vector<std::uint8_t> flag;
+      for (unsigned int i = 0; i < rows; ++i) {
+        pt.push_back(event + i);
+        flag.push_back(i % 2);
+      }
+      out = std::make_unique<nanoaod::FlatTable>(rows, name_, false);
+      out->addColumn<float>("pt", pt, "event number plus row", nanoaod::FlatTable::FloatColumn);
+      out->addColumn<std::uint8_t>("flag", flag, "odd row", nanoaod::FlatTable::BoolColumn);
+    }
+    iEvent.put(std::move(out));
+  }
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<std::string>("name");
+    desc.add<bool>("singleton");
+    descriptions.addDefault(desc);
+  }
+
+private:
+  const std::string name_;
+  const bool singleton_;
+};
+
+DEFINE_FWK_MODULE(TestFlatTableProducer);
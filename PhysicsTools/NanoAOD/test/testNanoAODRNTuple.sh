@@ -0,0 +1,6 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testNanoAODRNTuple_cfg.py || die 'Failure writing the RNTuple' $?
+testNanoAODRNTupleRead testNanoAODRNTuple.root || die 'Failure reading back the RNTuple' $?
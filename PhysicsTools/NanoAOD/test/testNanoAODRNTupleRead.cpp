@@ -0,0 +1,59 @@
+// Reads back the RNTuple written by testNanoAODRNTuple_cfg.py and checks that every field holds what
+// TestFlatTableProducer put in the tables.
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleReader;
+
+namespace {
+  int check(bool ok, char const* what, std::uint64_t event) {
+    if (!ok)
+      std::cerr << "Wrong " << what << " for event " << event << std::endl;
+    return ok ? 0 : 1;
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <file>" << std::endl;
+    return 2;
+  }
+
+  auto model = RNTupleModel::Create();
+  auto run = model->MakeField<std::uint32_t>("run");
+  auto event = model->MakeField<std::uint64_t>("event");
+  auto x = model->MakeField<float>("evt_x");
+  auto n = model->MakeField<int>("evt_n");
+  auto pt = model->MakeField<std::vector<float>>("obj_pt");
+  auto flag = model->MakeField<std::vector<std::uint8_t>>("obj_flag");
+  auto reader = RNTupleReader::Open(std::move(model), "Events", argv[1]);
+
+  int failures = 0;
+  if (reader->GetNEntries() != 10) {
+    std::cerr << "Expected 10 entries, found " << reader->GetNEntries() << std::endl;
+    ++failures;
+  }
+  for (std::uint64_t i = 0; i < reader->GetNEntries(); ++i) {
+    reader->LoadEntry(i);
+    std::uint64_t const e = *event;
+    failures += check(*run == 1, "run", e);
+    failures += check(e == i + 1, "event", e);
+    failures += check(*x == e * 0.5f, "evt_x", e);
+    failures += check(*n == int(e), "evt_n", e);
+    bool sizes = pt->size() == e % 3 && flag->size() == e % 3;
+    failures += check(sizes, "obj size", e);
+    for (unsigned int row = 0; sizes && row < pt->size(); ++row) {
+      failures += check((*pt)[row] == float(e + row), "obj_pt", e);
+      failures += check((*flag)[row] == row % 2, "obj_flag", e);
+    }
+  }
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("WRITE")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents.input = 10
+
+process.evtTable = cms.EDProducer("TestFlatTableProducer", name = cms.string("evt"), singleton = cms.bool(True))
+process.objTable = cms.EDProducer("TestFlatTableProducer", name = cms.string("obj"), singleton = cms.bool(False))
+
+process.out = cms.OutputModule("NanoAODRNTupleOutputModule",
+    fileName = cms.untracked.string("testNanoAODRNTuple.root"),
+)
+
+process.p = cms.Path(process.evtTable + process.objTable)
+process.ep = cms.EndPath(process.out)
@@ -0,0 +1,60 @@
+/*
+ * BatchedONNXRuntime.h
+ *
+ * Runs the inference of the requests of several framework streams in one batch of an ONNXRuntime session.
+ * A batch is run when it has max_batch_size rows, or when its first request waited max_latency, and holds at most
+ * max_batch_size rows unless a single request is larger.
+ */
+
+#ifndef PHYSICSTOOLS_ONNXRUNTIME_INTERFACE_BATCHEDONNXRUNTIME_H_
+#define PHYSICSTOOLS_ONNXRUNTIME_INTERFACE_BATCHEDONNXRUNTIME_H_
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FWCore/Concurrency/interface/RequestBatcher.h"
+#include "PhysicsTools/ONNXRuntime/interface/ONNXRuntime.h"
+
+namespace cms::Ort {
+
+  class BatchedONNXRuntime {
+  public:
+    // the nRows rows of each input of a request, in the order of the input names, and its outputs once done is
+    // called, with or without an exception; done is moved out of the request and called from the thread of the
+    // BatchedONNXRuntime, without a lock held
+    struct Request {
+      FloatArrays inputs;
+      int64_t nRows = 0;
+      FloatArrays outputs;
+      std::function<void(std::exception_ptr)> done;
+    };
+
+    // the model is not owned, and must outlive the BatchedONNXRuntime
+    BatchedONNXRuntime(const ONNXRuntime& model,
+                       const std::vector<std::string>& input_names,
+                       const std::vector<std::string>& output_names,
+                       int64_t max_batch_size,
+                       std::chrono::microseconds max_latency);
+    BatchedONNXRuntime(const BatchedONNXRuntime&) = delete;
+    BatchedONNXRuntime& operator=(const BatchedONNXRuntime&) = delete;
+
+    // queues the request, which the caller keeps alive until request->done has been called
+    void submit(Request* request) { batcher_.submit(request); }
+
+  private:
+    void runBatch(const std::vector<Request*>& batch, int64_t n_rows) const;
+
+    const ONNXRuntime& model_;
+    const std::vector<std::string> input_names_;
+    const std::vector<std::string> output_names_;
+
+    // last, so that its thread is stopped before the other members are destroyed
+    edm::RequestBatcher<Request> batcher_;
+  };
+
+}  // namespace cms::Ort
+
+#endif /* PHYSICSTOOLS_ONNXRUNTIME_INTERFACE_BATCHEDONNXRUNTIME_H_ */
@@ -0,0 +1,48 @@
+/*
+ * ONNXRuntimeClient.h
+ *
+ * A SonicClient running the inference of an ONNX model with ONNXRuntime in the job. It is both the local backend
+ * of the SonicEDProducers and the local fallback of the remote clients of the same model, which derive from it
+ * and override evaluate().
+ */
+
+#ifndef PHYSICSTOOLS_ONNXRUNTIME_INTERFACE_ONNXRUNTIMECLIENT_H_
+#define PHYSICSTOOLS_ONNXRUNTIME_INTERFACE_ONNXRUNTIMECLIENT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "HeterogeneousCore/SonicCore/interface/SonicClient.h"
+#include "PhysicsTools/ONNXRuntime/interface/ONNXRuntime.h"
+
+namespace cms::Ort {
+
+  // the arrays of the inputs, in the order of the input names, each with a layout of (batch_size, ...)
+  struct ONNXRuntimeClientInput {
+    FloatArrays values;
+    int64_t batch_size = 1;
+  };
+
+  class ONNXRuntimeClient : public SonicClient<ONNXRuntimeClientInput, FloatArrays> {
+  public:
+    explicit ONNXRuntimeClient(const edm::ParameterSet& params);
+
+    static void fillPSetDescription(edm::ParameterSetDescription& desc);
+
+  protected:
+    void evaluate() override;
+    void evaluateLocal() override;
+
+    const std::string model_path_;
+    const std::vector<std::string> input_names_;
+    const std::vector<std::string> output_names_;
+
+  private:
+    // the model is loaded at its first local inference, once for all the clients of the job
+    std::shared_ptr<const ONNXRuntime> model_;
+  };
+
+}  // namespace cms::Ort
+
+#endif /* PHYSICSTOOLS_ONNXRUNTIME_INTERFACE_ONNXRUNTIMECLIENT_H_ */
@@ -0,0 +1,68 @@
+/*
+ * BatchedONNXRuntime.cc
+ *
+ * Runs the inference of the requests of several framework streams in one batch of an ONNXRuntime session.
+ */
+
+#include "PhysicsTools/ONNXRuntime/interface/BatchedONNXRuntime.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace cms::Ort {
+
+  namespace {
+    int64_t checkedBatchSize(int64_t max_batch_size) {
+      if (max_batch_size <= 0) {
+        throw cms::Exception("InvalidArgument") << "The maximum batch size must be positive, got " << max_batch_size;
+      }
+      return max_batch_size;
+    }
+  }  // namespace
+
+  BatchedONNXRuntime::BatchedONNXRuntime(const ONNXRuntime& model,
+                                         const std::vector<std::string>& input_names,
+                                         const std::vector<std::string>& output_names,
+                                         int64_t max_batch_size,
+                                         std::chrono::microseconds max_latency)
+      : model_(model),
+        input_names_(input_names),
+        output_names_(output_names),
+        batcher_(checkedBatchSize(max_batch_size),
+                 max_latency,
+                 [this](const std::vector<Request*>& batch, int64_t n_rows) { runBatch(batch, n_rows); }) {}
+
+  void BatchedONNXRuntime::runBatch(const std::vector<Request*>& batch, int64_t n_rows) const {
+    for (auto const* request : batch) {
+      if (request->inputs.size() != input_names_.size()) {
+        throw cms::Exception("RuntimeError") << "A request has " << request->inputs.size() << " inputs, expected "
+                                             << input_names_.size();
+      }
+    }
+    if (n_rows <= 0) {
+      throw cms::Exception("RuntimeError") << "A batch has no rows";
+    }
+
+    // the rows of the requests one after the other, for each input
+    FloatArrays inputs(input_names_.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+      for (auto const* request : batch) {
+        inputs[i].insert(inputs[i].end(), request->inputs[i].begin(), request->inputs[i].end());
+      }
+    }
+
+    auto outputs = model_.run(input_names_, inputs, output_names_, n_rows);
+
+    for (auto* request : batch) {
+      request->outputs.resize(outputs.size());
+    }
+    for (size_t i = 0; i < outputs.size(); i++) {
+      const int64_t row_size = outputs[i].size() / n_rows;
+      auto output = outputs[i].begin();
+      for (auto* request : batch) {
+        request->outputs[i].assign(output, output + request->nRows * row_size);
+        output += request->nRows * row_size;
+      }
+    }
+  }
+
+}  // namespace cms::Ort
@@ -0,0 +1,65 @@
+/*
+ * ONNXRuntimeClient.cc
+ *
+ * A SonicClient running the inference of an ONNX model with ONNXRuntime in the job.
+ */
+
+#include "PhysicsTools/ONNXRuntime/interface/ONNXRuntimeClient.h"
+
+#include <map>
+#include <mutex>
+
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+namespace cms::Ort {
+
+  namespace {
+    // the models of the clients of the job, shared between the streams
+    std::shared_ptr<const ONNXRuntime> sharedModel(const std::string& model_path) {
+      static std::mutex mutex;
+      static std::map<std::string, std::weak_ptr<const ONNXRuntime>> models;
+      std::lock_guard<std::mutex> guard(mutex);
+      auto& model = models[model_path];
+      auto shared = model.lock();
+      if (!shared) {
+        shared = std::make_shared<const ONNXRuntime>(model_path);
+        model = shared;
+      }
+      return shared;
+    }
+  }  // namespace
+
+  ONNXRuntimeClient::ONNXRuntimeClient(const edm::ParameterSet& params)
+      : SonicClient(params),
+        model_path_(params.getParameter<edm::FileInPath>("modelPath").fullPath()),
+        input_names_(params.getParameter<std::vector<std::string>>("inputNames")),
+        output_names_(params.getParameter<std::vector<std::string>>("outputNames")) {}
+
+  void ONNXRuntimeClient::evaluate() {
+    // the inference runs on the thread of the caller, and an exception is reported as a failed try
+    try {
+      evaluateLocal();
+    } catch (...) {
+      finish(false, std::current_exception());
+      return;
+    }
+    finish(true);
+  }
+
+  void ONNXRuntimeClient::evaluateLocal() {
+    if (!model_) {
+      model_ = sharedModel(model_path_);
+    }
+    output_ = model_->run(input_names_, input_.values, output_names_, input_.batch_size);
+  }
+
+  void ONNXRuntimeClient::fillPSetDescription(edm::ParameterSetDescription& desc) {
+    SonicClientBase::fillBasePSetDescription(desc);
+    desc.add<edm::FileInPath>("modelPath");
+    desc.add<std::vector<std::string>>("inputNames");
+    desc.add<std::vector<std::string>>("outputNames", {})->setComment("empty for all the outputs of the model");
+  }
+
+}  // namespace cms::Ort
@@ -0,0 +1,50 @@
+/*
+ * ONNXRuntimeSonicProducer.cc
+ *
+ * A SonicEDProducer running the test model with an ONNXRuntimeClient: the inference of each event is
+ * dispatched in acquire, and its output, one value per row, is put in the event by produce.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "HeterogeneousCore/SonicCore/interface/SonicEDProducer.h"
+#include "PhysicsTools/ONNXRuntime/interface/ONNXRuntimeClient.h"
+
+class ONNXRuntimeSonicProducer : public SonicEDProducer<cms::Ort::ONNXRuntimeClient> {
+public:
+  explicit ONNXRuntimeSonicProducer(const edm::ParameterSet& cfg)
+      : SonicEDProducer<cms::Ort::ONNXRuntimeClient>(cfg), batchSize_(cfg.getParameter<unsigned>("batchSize")) {
+    produces<std::vector<float>>();
+  }
+
+  void acquire(const edm::Event& iEvent, const edm::EventSetup& iSetup, Input& iInput) override {
+    // the two features of each row depend on the event, so that the events differ
+    const float value = iEvent.id().event() % 10;
+    iInput.values = {std::vector<float>(batchSize_ * 2, value)};
+    iInput.batch_size = batchSize_;
+  }
+
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup, const Output& iOutput) override {
+    if (iOutput.size() != 1 || iOutput[0].size() != batchSize_) {
+      throw cms::Exception("InvalidOutput") << "expected one output of " << batchSize_ << " values, got "
+                                            << iOutput.size() << " outputs";
+    }
+    iEvent.put(std::make_unique<std::vector<float>>(iOutput[0]));
+  }
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    fillPSetDescription(desc);
+    desc.add<unsigned>("batchSize", 4);
+    descriptions.addWithDefaultLabel(desc);
+  }
+
+private:
+  const unsigned batchSize_;
+};
+
+DEFINE_FWK_MODULE(ONNXRuntimeSonicProducer);
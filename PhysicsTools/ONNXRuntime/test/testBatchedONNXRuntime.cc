@@ -0,0 +1,82 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "PhysicsTools/ONNXRuntime/interface/BatchedONNXRuntime.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace cms::Ort;
+
+class testBatchedONNXRuntime : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testBatchedONNXRuntime);
+  CPPUNIT_TEST(checkAll);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void checkAll();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testBatchedONNXRuntime);
+
+void testBatchedONNXRuntime::checkAll() {
+  std::string model_path = edm::FileInPath("PhysicsTools/ONNXRuntime/test/data/model.onnx").fullPath();
+  ONNXRuntime rt(model_path);
+
+  // the requests of the threads are run in batches of at most 8 rows, or after 10 ms
+  const int n_threads = 4;
+  const int n_rows = 3;
+  std::atomic<int> n_done{0};
+  std::atomic<int> n_failed{0};
+  std::vector<BatchedONNXRuntime::Request> requests(n_threads);
+  {
+    BatchedONNXRuntime batched(rt, {"X"}, {"Y"}, 8, std::chrono::milliseconds(10));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; t++) {
+      threads.emplace_back([&, t]() {
+        auto &request = requests[t];
+        request.nRows = n_rows;
+        request.inputs = {std::vector<float>(n_rows * 2, float(t))};
+        request.done = [&](std::exception_ptr exception) {
+          if (exception) {
+            n_failed++;
+          }
+          n_done++;
+        };
+        batched.submit(&request);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    while (n_done < n_threads) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // the outputs are those of the requests run one by one
+    CPPUNIT_ASSERT(n_failed == 0);
+    for (int t = 0; t < n_threads; t++) {
+      FloatArrays input_values{std::vector<float>(n_rows * 2, float(t))};
+      auto expected = rt.run({"X"}, input_values, {"Y"}, n_rows);
+      CPPUNIT_ASSERT(requests[t].outputs == expected);
+    }
+
+    // a failed run is reported to the requests of the batch
+    BatchedONNXRuntime bad(rt, {"foo"}, {"Y"}, 1, std::chrono::milliseconds(10));
+    BatchedONNXRuntime::Request request;
+    request.nRows = 1;
+    request.inputs = {std::vector<float>(2, 1.)};
+    request.done = [&](std::exception_ptr exception) {
+      if (exception) {
+        n_failed++;
+      }
+      n_done++;
+    };
+    bad.submit(&request);
+    while (n_done < n_threads + 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CPPUNIT_ASSERT(n_failed == 1);
+  }
+}
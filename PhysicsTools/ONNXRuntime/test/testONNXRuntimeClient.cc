@@ -0,0 +1,44 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "PhysicsTools/ONNXRuntime/interface/ONNXRuntimeClient.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+using namespace cms::Ort;
+
+class testONNXRuntimeClient : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testONNXRuntimeClient);
+  CPPUNIT_TEST(checkAll);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void checkAll();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testONNXRuntimeClient);
+
+void testONNXRuntimeClient::checkAll() {
+  edm::ParameterSet params;
+  params.addUntrackedParameter<unsigned>("allowedRetries", 0);
+  params.addUntrackedParameter<bool>("localFallback", true);
+  params.addParameter<edm::FileInPath>("modelPath", edm::FileInPath("PhysicsTools/ONNXRuntime/test/data/model.onnx"));
+  params.addParameter<std::vector<std::string>>("inputNames", {"X"});
+  params.addParameter<std::vector<std::string>>("outputNames", {"Y"});
+
+  ONNXRuntimeClient client(params);
+  for (const unsigned &batch_size : {1, 2, 4}) {
+    client.input().values = {std::vector<float>(batch_size * 2, 1)};
+    client.input().batch_size = batch_size;
+    CPPUNIT_ASSERT_NO_THROW(client.dispatch());
+    CPPUNIT_ASSERT(client.output().size() == 1);
+    CPPUNIT_ASSERT(client.output()[0].size() == batch_size);
+    for (const auto &v : client.output()[0]) {
+      CPPUNIT_ASSERT(v == 3);
+    }
+  }
+
+  // an input of the wrong size fails the inference
+  client.input().values = {std::vector<float>(3, 1)};
+  client.input().batch_size = 1;
+  CPPUNIT_ASSERT_THROW(client.dispatch(), cms::Exception);
+}
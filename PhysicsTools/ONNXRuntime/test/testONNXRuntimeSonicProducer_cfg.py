@@ -0,0 +1,21 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents.input = 20
+process.options.numberOfThreads = 4
+process.options.numberOfStreams = 4
+
+process.onnxProducer = cms.EDProducer("ONNXRuntimeSonicProducer",
+    Client = cms.PSet(
+        allowedRetries = cms.untracked.uint32(0),
+        localFallback = cms.untracked.bool(True),
+        modelPath = cms.FileInPath("PhysicsTools/ONNXRuntime/test/data/model.onnx"),
+        inputNames = cms.vstring("X"),
+        outputNames = cms.vstring("Y"),
+    ),
+    batchSize = cms.uint32(4),
+)
+
+process.p = cms.Path(process.onnxProducer)
@@ -12,6 +12,8 @@
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
 #include "DataFormats/MuonReco/interface/MuonSelectors.h"
 
+#include <algorithm>
+
 namespace pat {
 
   template <typename T>
@@ -66,6 +68,15 @@ namespace pat {
         throw cms::Exception("ParameterError", "miniIsoParams must have exactly 9 elements.\n");
     }
     const std::vector<double> &miniIsoParams(const T &lep) const { return miniIsoParams_[0]; }
+    // the largest miniIso cone of the leptons, mindr or maxdr of any of the parameter sets
+    double maxMiniIsoConeSize() const {
+      double coneSize = 0;
+      for (auto const &params : miniIsoParams_) {
+        if (!params.empty())
+          coneSize = std::max({coneSize, params[0], params[1]});
+      }
+      return coneSize;
+    }
 
     void recomputeMuonBasicSelectors(T &, const reco::Vertex &, const bool) const;
 
@@ -131,8 +142,11 @@ void pat::LeptonUpdater<T>::produce(edm::StreamID, edm::Event &iEvent, edm::Even
   const reco::Vertex &pv = vertices->front();
 
   edm::Handle<pat::PackedCandidateCollection> pc;
-  if (computeMiniIso_)
+  EtaPhiConeIndex pcIndex;
+  if (computeMiniIso_) {
     iEvent.getByToken(pcToken_, pc);
+    pcIndex.fill(*pc, maxMiniIsoConeSize());
+  }
 
   std::unique_ptr<std::vector<T>> out(new std::vector<T>(*src));
 
@@ -145,6 +159,7 @@ void pat::LeptonUpdater<T>::produce(edm::StreamID, edm::Event &iEvent, edm::Even
     if (computeMiniIso_) {
       const auto &params = miniIsoParams(lep);
       pat::PFIsolation miniiso = pat::getMiniPFIsolation(pc.product(),
+                                                         pcIndex,
                                                          lep.p4(),
                                                          params[0],
                                                          params[1],
@@ -43,6 +43,7 @@
 
 #include "PhysicsTools/PatUtils/interface/MiniIsolation.h"
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -244,8 +245,11 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
   iEvent.getByToken(electronToken_, electrons);
 
   edm::Handle<PackedCandidateCollection> pc;
-  if (computeMiniIso_)
+  if (computeMiniIso_) {
     iEvent.getByToken(pcToken_, pc);
+    pcIndex_.fill(*pc,
+                  std::max({miniIsoParamsB_[0], miniIsoParamsB_[1], miniIsoParamsE_[0], miniIsoParamsE_[1]}));
+  }
 
   // for additional mva variables
   edm::InputTag reducedEBRecHitCollection(string("reducedEcalRecHitsEB"));
@@ -352,6 +356,18 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
     iEvent.getByToken(PUPPINoLeptonsIsolation_photons_, PUPPINoLeptonsIsolation_photons);
   }
 
+  // the products read for each electron, looked up once per event
+  edm::Handle<edm::ValueMap<float>> ecalPFClusterIsoMapH;
+  edm::Handle<edm::ValueMap<float>> hcalPFClusterIsoMapH;
+  if (addPFClusterIso_) {
+    iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
+    iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
+  }
+  edm::Handle<EcalRecHitCollection> barrelRecHitsH;
+  edm::Handle<EcalRecHitCollection> endcapRecHitsH;
+  iEvent.getByToken(reducedBarrelRecHitCollectionToken_, barrelRecHitsH);
+  iEvent.getByToken(reducedEndcapRecHitCollectionToken_, endcapRecHitsH);
+
   std::vector<Electron>* patElectrons = new std::vector<Electron>();
 
   if (useParticleFlow_) {
@@ -454,11 +470,6 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
           }
           // PFClusterIso
           if (addPFClusterIso_) {
-            // Get PFCluster Isolation
-            edm::Handle<edm::ValueMap<float>> ecalPFClusterIsoMapH;
-            iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
-            edm::Handle<edm::ValueMap<float>> hcalPFClusterIsoMapH;
-            iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
             reco::GsfElectron::PflowIsolationVariables newPFIsol = anElectron.pfIsolationVariables();
             newPFIsol.sumEcalClusterEt = (*ecalPFClusterIsoMapH)[elecsRef];
             newPFIsol.sumHcalClusterEt = (*hcalPFClusterIsoMapH)[elecsRef];
@@ -512,14 +523,8 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
 
           // Retrieve the corresponding RecHits
 
-          edm::Handle<EcalRecHitCollection> rechitsH;
-          if (barrel)
-            iEvent.getByToken(reducedBarrelRecHitCollectionToken_, rechitsH);
-          else
-            iEvent.getByToken(reducedEndcapRecHitCollectionToken_, rechitsH);
-
           EcalRecHitCollection selectedRecHits;
-          const EcalRecHitCollection* recHits = rechitsH.product();
+          const EcalRecHitCollection* recHits = barrel ? barrelRecHitsH.product() : endcapRecHitsH.product();
 
           unsigned nSelectedCells = selectedCells.size();
           for (unsigned icell = 0; icell < nSelectedCells; ++icell) {
@@ -565,7 +570,7 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
           if (computeMiniIso_)
             setElectronMiniIso(anElectron, pc.product());
 
-          patElectrons->push_back(anElectron);
+          patElectrons->push_back(std::move(anElectron));
         }
       }
       //if( !Matched && !MatchedToAmbiguousGsfTrack) std::cout << "!!!!A pf electron could not be matched to a gsf!!!!"  << std::endl;
@@ -686,11 +691,6 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
 
       // PFCluster Isolation
       if (addPFClusterIso_) {
-        // Get PFCluster Isolation
-        edm::Handle<edm::ValueMap<float>> ecalPFClusterIsoMapH;
-        iEvent.getByToken(ecalPFClusterIsoT_, ecalPFClusterIsoMapH);
-        edm::Handle<edm::ValueMap<float>> hcalPFClusterIsoMapH;
-        iEvent.getByToken(hcalPFClusterIsoT_, hcalPFClusterIsoMapH);
         reco::GsfElectron::PflowIsolationVariables newPFIsol = anElectron.pfIsolationVariables();
         newPFIsol.sumEcalClusterEt = (*ecalPFClusterIsoMapH)[elecsRef];
         newPFIsol.sumHcalClusterEt = (*hcalPFClusterIsoMapH)[elecsRef];
@@ -756,14 +756,8 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
 
       // Retrieve the corresponding RecHits
 
-      edm::Handle<EcalRecHitCollection> rechitsH;
-      if (barrel)
-        iEvent.getByToken(reducedBarrelRecHitCollectionToken_, rechitsH);
-      else
-        iEvent.getByToken(reducedEndcapRecHitCollectionToken_, rechitsH);
-
       EcalRecHitCollection selectedRecHits;
-      const EcalRecHitCollection* recHits = rechitsH.product();
+      const EcalRecHitCollection* recHits = barrel ? barrelRecHitsH.product() : endcapRecHitsH.product();
 
       unsigned nSelectedCells = selectedCells.size();
       for (unsigned icell = 0; icell < nSelectedCells; ++icell) {
@@ -796,7 +790,7 @@ void PATElectronProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSe
       if (computeMiniIso_)
         setElectronMiniIso(anElectron, pc.product());
 
-      patElectrons->push_back(anElectron);
+      patElectrons->push_back(std::move(anElectron));
     }
   }
 
@@ -991,6 +985,7 @@ void PATElectronProducer::setElectronMiniIso(Electron& anElectron, const PackedC
   pat::PFIsolation miniiso;
   if (anElectron.isEE())
     miniiso = pat::getMiniPFIsolation(pc,
+                                      pcIndex_,
                                       anElectron.p4(),
                                       miniIsoParamsE_[0],
                                       miniIsoParamsE_[1],
@@ -1003,6 +998,7 @@ void PATElectronProducer::setElectronMiniIso(Electron& anElectron, const PackedC
                                       miniIsoParamsE_[8]);
   else
     miniiso = pat::getMiniPFIsolation(pc,
+                                      pcIndex_,
                                       anElectron.p4(),
                                       miniIsoParamsB_[0],
                                       miniIsoParamsB_[1],
@@ -23,6 +23,7 @@
 #include "DataFormats/Candidate/interface/CandAssociation.h"
 
 #include "CommonTools/Utils/interface/PtComparator.h"
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
 
 #include "PhysicsTools/PatAlgos/interface/MultiIsolator.h"
 #include "PhysicsTools/PatAlgos/interface/EfficiencyLoader.h"
@@ -78,6 +79,8 @@ namespace pat {
     bool computeMiniIso_;
     std::vector<double> miniIsoParamsE_;
     std::vector<double> miniIsoParamsB_;
+    // the index of the packed candidates of the event, for the isolation cones of all the electrons
+    EtaPhiConeIndex pcIndex_;
 
     typedef std::vector<edm::Handle<edm::Association<reco::GenParticleCollection> > > GenAssociations;
 
@@ -196,12 +196,11 @@ void PATJetProducer::produce(edm::Event &iEvent, const edm::EventSetup &iSetup)
 */
 
   // read in the jet correction factors ValueMap
-  std::vector<edm::ValueMap<JetCorrFactors>> jetCorrs;
+  std::vector<edm::Handle<edm::ValueMap<JetCorrFactors>>> jetCorrs;
   if (addJetCorrFactors_) {
+    jetCorrs.resize(jetCorrFactorsTokens_.size());
     for (size_t i = 0; i < jetCorrFactorsTokens_.size(); ++i) {
-      edm::Handle<edm::ValueMap<JetCorrFactors>> jetCorr;
-      iEvent.getByToken(jetCorrFactorsTokens_[i], jetCorr);
-      jetCorrs.push_back(*jetCorr);
+      iEvent.getByToken(jetCorrFactorsTokens_[i], jetCorrs[i]);
     }
   }
 
@@ -236,6 +235,7 @@ void PATJetProducer::produce(edm::Event &iEvent, const edm::EventSetup &iSetup)
 
   // loop over jets
   auto patJets = std::make_unique<std::vector<Jet>>();
+  patJets->reserve(jets->size());
 
   auto genJetsOut = std::make_unique<reco::GenJetCollection>();
   auto caloTowersOut = std::make_unique<std::vector<CaloTower>>();
@@ -313,22 +313,23 @@ void PATJetProducer::produce(edm::Event &iEvent, const edm::EventSetup &iSetup)
     if (addJetCorrFactors_) {
       // add additional JetCorrs to the jet
       for (unsigned int i = 0; i < jetCorrFactorsTokens_.size(); ++i) {
-        const JetCorrFactors &jcf = jetCorrs[i][jetRef];
+        const JetCorrFactors &jcf = (*jetCorrs[i])[jetRef];
         // uncomment for debugging
         // jcf.print();
         ajet.addJECFactors(jcf);
       }
-      std::vector<std::string> levels = jetCorrs[0][jetRef].correctionLabels();
+      const JetCorrFactors &jcf = (*jetCorrs[0])[jetRef];
+      std::vector<std::string> levels = jcf.correctionLabels();
       if (std::find(levels.begin(), levels.end(), "L2L3Residual") != levels.end()) {
-        ajet.initializeJEC(jetCorrs[0][jetRef].jecLevel("L2L3Residual"));
+        ajet.initializeJEC(jcf.jecLevel("L2L3Residual"));
       } else if (std::find(levels.begin(), levels.end(), "L3Absolute") != levels.end()) {
-        ajet.initializeJEC(jetCorrs[0][jetRef].jecLevel("L3Absolute"));
+        ajet.initializeJEC(jcf.jecLevel("L3Absolute"));
       } else {
-        ajet.initializeJEC(jetCorrs[0][jetRef].jecLevel("Uncorrected"));
+        ajet.initializeJEC(jcf.jecLevel("Uncorrected"));
         if (printWarning_) {
           edm::LogWarning("L3Absolute not found")
               << "L2L3Residual and L3Absolute are not part of the jetCorrFactors\n"
-              << "of module " << jetCorrs[0][jetRef].jecSet() << ". Jets will remain"
+              << "of module " << jcf.jecSet() << ". Jets will remain"
               << " uncorrected.";
           printWarning_ = false;
         }
@@ -339,11 +340,12 @@ void PATJetProducer::produce(edm::Event &iEvent, const edm::EventSetup &iSetup)
     if (getJetMCFlavour_ && useLegacyJetMCFlavour_) {
       ajet.setPartonFlavour((*jetFlavMatch)[edm::RefToBase<reco::Jet>(jetRef)].getFlavour());
     } else if (getJetMCFlavour_ && !useLegacyJetMCFlavour_) {
+      const reco::JetFlavourInfo &flavourInfo = (*jetFlavInfoMatch)[jetRef];
       if (addJetFlavourInfo_)
-        ajet.setJetFlavourInfo((*jetFlavInfoMatch)[edm::RefToBase<reco::Jet>(jetRef)]);
+        ajet.setJetFlavourInfo(flavourInfo);
       else {
-        ajet.setPartonFlavour((*jetFlavInfoMatch)[edm::RefToBase<reco::Jet>(jetRef)].getPartonFlavour());
-        ajet.setHadronFlavour((*jetFlavInfoMatch)[edm::RefToBase<reco::Jet>(jetRef)].getHadronFlavour());
+        ajet.setPartonFlavour(flavourInfo.getPartonFlavour());
+        ajet.setHadronFlavour(flavourInfo.getHadronFlavour());
       }
     }
     // store the match to the generated partons
@@ -443,7 +445,7 @@ void PATJetProducer::produce(edm::Event &iEvent, const edm::EventSetup &iSetup)
     if (useUserData_) {
       userDataHelper_.add(ajet, iEvent, iSetup);
     }
-    patJets->push_back(ajet);
+    patJets->push_back(std::move(ajet));
   }
 
   // sort jets in pt
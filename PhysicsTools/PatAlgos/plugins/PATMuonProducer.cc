@@ -53,6 +53,7 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 using namespace pat;
 using namespace std;
@@ -324,8 +325,15 @@ void PATMuonProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
   iEvent.getByToken(muonToken_, muons);
 
   edm::Handle<pat::PackedCandidateCollection> pc;
-  if (computeMiniIso_ || computePuppiCombinedIso_)
+  if (computeMiniIso_ || computePuppiCombinedIso_) {
     iEvent.getByToken(pcToken_, pc);
+    double maxConeSize = 0;
+    if (computeMiniIso_)
+      maxConeSize = std::max(miniIsoParams_[0], miniIsoParams_[1]);
+    if (computePuppiCombinedIso_)
+      maxConeSize = std::max(maxConeSize, kPuppiCombinedIsoConeSize);
+    pcIndex_.fill(*pc, maxConeSize);
+  }
 
   // get the ESHandle for the transient track builder,
   // if needed for high level selection embedding
@@ -496,7 +504,7 @@ void PATMuonProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
         aMuon.setPfEcalEnergy(pfmu.ecalEnergy());
       }
 
-      patMuons->push_back(aMuon);
+      patMuons->push_back(std::move(aMuon));
     }
   } else {
     edm::Handle<edm::View<reco::Muon>> muons;
@@ -516,9 +524,22 @@ void PATMuonProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
       //tcMETmuCorValueMap  = *tcMETmuCorValueMap_h;
     }
 
+    // the ECAL energy of the PF candidate of each muon with one, the last one if several, by key of the muon
+    std::unordered_map<unsigned int, double> pfEcalEnergies;
     if (embedPfEcalEnergy_) {
       // get the PFCandidates of type muons
       iEvent.getByToken(pfMuonToken_, pfMuons);
+      if (!muons->empty()) {
+        const edm::ProductID muonsId = muons->refAt(0).id();
+        for (const reco::PFCandidate& pfmu : *pfMuons) {
+          if (pfmu.muonRef().isNonnull()) {
+            if (pfmu.muonRef().id() != muonsId)
+              throw cms::Exception("Configuration")
+                  << "Muon reference within PF candidates does not point to the muon collection." << std::endl;
+            pfEcalEnergies[pfmu.muonRef().key()] = pfmu.ecalEnergy();
+          }
+        }
+      }
     }
 
     edm::Handle<edm::ValueMap<reco::MuonTimeExtra>> muonsTimeExtra;
@@ -605,17 +626,8 @@ void PATMuonProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
         aMuon.embedTcMETMuonCorrs((*tcMETMuonCorrs)[muonRef]);
 
       if (embedPfEcalEnergy_) {
-        aMuon.setPfEcalEnergy(-99.0);
-        for (const reco::PFCandidate& pfmu : *pfMuons) {
-          if (pfmu.muonRef().isNonnull()) {
-            if (pfmu.muonRef().id() != muonRef.id())
-              throw cms::Exception("Configuration")
-                  << "Muon reference within PF candidates does not point to the muon collection." << std::endl;
-            if (pfmu.muonRef().key() == muonRef.key()) {
-              aMuon.setPfEcalEnergy(pfmu.ecalEnergy());
-            }
-          }
-        }
+        auto pfEcalEnergy = pfEcalEnergies.find(muonRef.key());
+        aMuon.setPfEcalEnergy(pfEcalEnergy != pfEcalEnergies.end() ? pfEcalEnergy->second : -99.0);
       }
       if (addInverseBeta_) {
         aMuon.readTimeExtra((*muonsTimeExtra)[muonRef]);
@@ -639,7 +651,7 @@ void PATMuonProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
         aMuon.setSimPhi(msi.p4.phi());
         aMuon.setSimMatchQuality(msi.tpAssoQuality);
       }
-      patMuons->push_back(aMuon);
+      patMuons->push_back(std::move(aMuon));
     }
   }
 
@@ -866,6 +878,7 @@ void PATMuonProducer::fillMuon(Muon& aMuon,
 
 void PATMuonProducer::setMuonMiniIso(Muon& aMuon, const PackedCandidateCollection* pc) {
   pat::PFIsolation miniiso = pat::getMiniPFIsolation(pc,
+                                                     pcIndex_,
                                                      aMuon.p4(),
                                                      miniIsoParams_[0],
                                                      miniIsoParams_[1],
@@ -888,14 +901,17 @@ double PATMuonProducer::getRelMiniIsoPUCorrected(const pat::Muon& muon, double r
 }
 
 double PATMuonProducer::puppiCombinedIsolation(const pat::Muon& muon, const pat::PackedCandidateCollection* pc) {
-  double dR_threshold = 0.4;
+  double dR_threshold = kPuppiCombinedIsoConeSize;
   double dR2_threshold = dR_threshold * dR_threshold;
   double mix_fraction = 0.5;
   enum particleType { CH = 0, NH = 1, PH = 2, OTHER = 100000 };
   double val_PuppiWithLep = 0.0;
   double val_PuppiWithoutLep = 0.0;
 
-  for (const auto& cand : *pc) {  //pat::pat::PackedCandidate loop start
+  std::vector<unsigned int> inCone;
+  pcIndex_.candidatesInCone(muon.eta(), muon.phi(), dR_threshold, inCone);
+  for (auto i : inCone) {  //pat::pat::PackedCandidate loop start
+    const auto& cand = (*pc)[i];
 
     const particleType pType =
         isChargedHadron(cand.pdgId()) ? CH : isNeutralHadron(cand.pdgId()) ? NH : isPhoton(cand.pdgId()) ? PH : OTHER;
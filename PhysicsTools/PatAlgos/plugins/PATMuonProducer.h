@@ -30,6 +30,7 @@
 
 #include "DataFormats/PatCandidates/interface/UserData.h"
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
 #include "PhysicsTools/PatAlgos/interface/PATUserDataHelper.h"
 #include "TrackingTools/TransientTrack/interface/TransientTrackBuilder.h"
 #include "PhysicsTools/PatAlgos/interface/MuonMvaEstimator.h"
@@ -143,6 +144,9 @@ namespace pat {
     edm::EDGetTokenT<pat::PackedCandidateCollection> pcToken_;
     bool computeMiniIso_;
     bool computePuppiCombinedIso_;
+    static constexpr double kPuppiCombinedIsoConeSize = 0.4;
+    // the index of the packed candidates of the event, for the isolation cones of all the muons
+    EtaPhiConeIndex pcIndex_;
     std::vector<double> effectiveAreaVec_;
     std::vector<double> miniIsoParams_;
     double relMiniIsoPUCorrected_;
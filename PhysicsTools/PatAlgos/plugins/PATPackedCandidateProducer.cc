@@ -11,6 +11,7 @@
 #include "DataFormats/PatCandidates/interface/HcalDepthEnergyFractions.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateTable.h"
 #include "DataFormats/RecoCandidate/interface/RecoChargedCandidate.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include "DataFormats/VertexReco/interface/VertexFwd.h"
@@ -107,6 +108,9 @@ namespace pat {
     const edm::EDGetTokenT<edm::ValueMap<float>> t0Map_;
     const edm::EDGetTokenT<edm::ValueMap<float>> t0ErrMap_;
 
+    // the kinematics of the candidates also written column by column, in a PackedCandidateTable
+    const bool produceTable_;
+
     // for debugging
     float calcDxy(float dx, float dy, float phi) const { return -dx * std::sin(phi) + dy * std::cos(phi); }
     float calcDz(reco::Candidate::Point p, reco::Candidate::Point v, const reco::Candidate &c) const {
@@ -152,7 +156,8 @@ pat::PATPackedCandidateProducer::PATPackedCandidateProducer(const edm::Parameter
       t0Map_(timeFromValueMap_ ? consumes<edm::ValueMap<float>>(iConfig.getParameter<edm::InputTag>("timeMap"))
                                : edm::EDGetTokenT<edm::ValueMap<float>>()),
       t0ErrMap_(timeFromValueMap_ ? consumes<edm::ValueMap<float>>(iConfig.getParameter<edm::InputTag>("timeMapErr"))
-                                  : edm::EDGetTokenT<edm::ValueMap<float>>()) {
+                                  : edm::EDGetTokenT<edm::ValueMap<float>>()),
+      produceTable_(iConfig.existsAs<bool>("produceTable") ? iConfig.getParameter<bool>("produceTable") : false) {
   std::vector<edm::InputTag> sv_tags =
       iConfig.getParameter<std::vector<edm::InputTag>>("secondaryVerticesForWhiteList");
   for (auto itag : sv_tags) {
@@ -165,6 +170,8 @@ pat::PATPackedCandidateProducer::PATPackedCandidateProducer(const edm::Parameter
 
   if (not pfCandidateTypesForHcalDepth_.empty())
     produces<edm::ValueMap<pat::HcalDepthEnergyFractions>>("hcalDepthEnergyFractions");
+  if (produceTable_)
+    produces<pat::PackedCandidateTable>();
 }
 
 pat::PATPackedCandidateProducer::~PATPackedCandidateProducer() {}
@@ -482,6 +489,8 @@ void pat::PATPackedCandidateProducer::produce(edm::StreamID, edm::Event &iEvent,
   }
 
   edm::OrphanHandle<pat::PackedCandidateCollection> oh = iEvent.put(std::move(outPtrPSorted));
+  if (produceTable_)
+    iEvent.put(std::make_unique<pat::PackedCandidateTable>(*oh));
 
   // now build the two maps
   auto pf2pc = std::make_unique<edm::Association<pat::PackedCandidateCollection>>(oh);
@@ -12,6 +12,7 @@
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
 #include "DataFormats/PatCandidates/interface/PFIsolation.h"
 #include "DataFormats/Math/interface/LorentzVector.h"
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
 
 namespace pat {
 
@@ -30,6 +31,21 @@ namespace pat {
                                  float deadcone_nh = 0.01,
                                  float dZ_cut = 0.0);
 
+  // the same, looking only at the candidates near the cone in pfcandsIndex, the index of pfcands, which is best
+  // built with a cone size of at least max(mindr, maxdr)
+  PFIsolation getMiniPFIsolation(const pat::PackedCandidateCollection* pfcands,
+                                 const EtaPhiConeIndex& pfcandsIndex,
+                                 const math::XYZTLorentzVector& p4,
+                                 float mindr = 0.05,
+                                 float maxdr = 0.2,
+                                 float kt_scale = 10.0,
+                                 float ptthresh = 0.5,
+                                 float deadcone_ch = 0.0001,
+                                 float deadcone_pu = 0.01,
+                                 float deadcone_ph = 0.01,
+                                 float deadcone_nh = 0.01,
+                                 float dZ_cut = 0.0);
+
   double muonRelMiniIsoPUCorrected(const PFIsolation& iso,
                                    const math::XYZTLorentzVector& p4,
                                    double dr,
@@ -16,6 +16,59 @@ namespace pat {
     return std::max(mindr, std::min(maxdr, float(kt_scale / p4.pt())));
   }
 
+  namespace {
+    class MiniIsoSums {
+    public:
+      MiniIsoSums(const math::XYZTLorentzVector &p4,
+                  float drcut,
+                  float ptthresh,
+                  float deadcone_ch,
+                  float deadcone_pu,
+                  float deadcone_ph,
+                  float deadcone_nh,
+                  float dZ_cut)
+          : p4_(p4),
+            drcut_(drcut),
+            ptthresh_(ptthresh),
+            deadcone_ch_(deadcone_ch),
+            deadcone_pu_(deadcone_pu),
+            deadcone_ph_(deadcone_ph),
+            deadcone_nh_(deadcone_nh),
+            dZ_cut_(dZ_cut) {}
+
+      void add(const pat::PackedCandidate &pc) {
+        float dr = deltaR(p4_, pc.p4());
+        if (dr > drcut_)
+          return;
+        float pt = pc.p4().pt();
+        int id = pc.pdgId();
+        if (std::abs(id) == 211) {
+          bool fromPV = (pc.fromPV() > 1 || fabs(pc.dz()) < dZ_cut_);
+          if (fromPV && dr > deadcone_ch_) {
+            // if charged hadron and from primary vertex, add to charged hadron isolation
+            chiso_ += pt;
+          } else if (!fromPV && pt > ptthresh_ && dr > deadcone_pu_) {
+            // if charged hadron and NOT from primary vertex, add to pileup isolation
+            puiso_ += pt;
+          }
+        }
+        // if neutral hadron, add to neutral hadron isolation
+        if (std::abs(id) == 130 && pt > ptthresh_ && dr > deadcone_nh_)
+          nhiso_ += pt;
+        // if photon, add to photon isolation
+        if (std::abs(id) == 22 && pt > ptthresh_ && dr > deadcone_ph_)
+          phiso_ += pt;
+      }
+
+      PFIsolation isolation() const { return pat::PFIsolation(chiso_, nhiso_, phiso_, puiso_); }
+
+    private:
+      const math::XYZTLorentzVector &p4_;
+      const float drcut_, ptthresh_, deadcone_ch_, deadcone_pu_, deadcone_ph_, deadcone_nh_, dZ_cut_;
+      float chiso_ = 0, nhiso_ = 0, phiso_ = 0, puiso_ = 0;
+    };
+  }  // namespace
+
   PFIsolation getMiniPFIsolation(const pat::PackedCandidateCollection *pfcands,
                                  const math::XYZTLorentzVector &p4,
                                  float mindr,
@@ -27,33 +80,35 @@ namespace pat {
                                  float deadcone_ph,
                                  float deadcone_nh,
                                  float dZ_cut) {
-    float chiso = 0, nhiso = 0, phiso = 0, puiso = 0;
     float drcut = miniIsoDr(p4, mindr, maxdr, kt_scale);
+    MiniIsoSums sums(p4, drcut, ptthresh, deadcone_ch, deadcone_pu, deadcone_ph, deadcone_nh, dZ_cut);
     for (auto const &pc : *pfcands) {
-      float dr = deltaR(p4, pc.p4());
-      if (dr > drcut)
-        continue;
-      float pt = pc.p4().pt();
-      int id = pc.pdgId();
-      if (std::abs(id) == 211) {
-        bool fromPV = (pc.fromPV() > 1 || fabs(pc.dz()) < dZ_cut);
-        if (fromPV && dr > deadcone_ch) {
-          // if charged hadron and from primary vertex, add to charged hadron isolation
-          chiso += pt;
-        } else if (!fromPV && pt > ptthresh && dr > deadcone_pu) {
-          // if charged hadron and NOT from primary vertex, add to pileup isolation
-          puiso += pt;
-        }
-      }
-      // if neutral hadron, add to neutral hadron isolation
-      if (std::abs(id) == 130 && pt > ptthresh && dr > deadcone_nh)
-        nhiso += pt;
-      // if photon, add to photon isolation
-      if (std::abs(id) == 22 && pt > ptthresh && dr > deadcone_ph)
-        phiso += pt;
+      sums.add(pc);
     }
+    return sums.isolation();
+  }
 
-    return pat::PFIsolation(chiso, nhiso, phiso, puiso);
+  PFIsolation getMiniPFIsolation(const pat::PackedCandidateCollection *pfcands,
+                                 const EtaPhiConeIndex &pfcandsIndex,
+                                 const math::XYZTLorentzVector &p4,
+                                 float mindr,
+                                 float maxdr,
+                                 float kt_scale,
+                                 float ptthresh,
+                                 float deadcone_ch,
+                                 float deadcone_pu,
+                                 float deadcone_ph,
+                                 float deadcone_nh,
+                                 float dZ_cut) {
+    float drcut = miniIsoDr(p4, mindr, maxdr, kt_scale);
+    MiniIsoSums sums(p4, drcut, ptthresh, deadcone_ch, deadcone_pu, deadcone_ph, deadcone_nh, dZ_cut);
+    // the candidates near the cone, in the order of the collection
+    std::vector<unsigned int> inCone;
+    pfcandsIndex.candidatesInCone(p4.eta(), p4.phi(), drcut, inCone);
+    for (auto i : inCone) {
+      sums.add((*pfcands)[i]);
+    }
+    return sums.isolation();
   }
 
   double muonRelMiniIsoPUCorrected(const PFIsolation &iso,
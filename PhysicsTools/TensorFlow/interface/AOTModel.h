@@ -0,0 +1,92 @@
+/*
+ * Model compiled ahead of time by tfcompile (XLA AOT) into a standalone C++ class, for the small
+ * networks for which the overhead of a session exceeds the cost of the inference itself.
+ * The compiled class has a fixed batch size: the rows of an inference are run in batches of that size,
+ * the last one padded with zeros.
+ * Based on TensorFlow 2.1.
+ */
+
+#ifndef PHYSICSTOOLS_TENSORFLOW_AOTMODEL_H
+#define PHYSICSTOOLS_TENSORFLOW_AOTMODEL_H
+
+#include <algorithm>
+#include <vector>
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace tensorflow {
+
+  namespace aot {
+
+    // CompiledFunction is the class generated by tfcompile, an XlaCompiledCpuFunction, for inputs and
+    // outputs of type T; its buffers are not shared, so a Model is used by one stream at a time
+    template <class CompiledFunction, typename T = float>
+    class Model {
+    public:
+      // the sizes of one row of each input and output, in the order of the feeds and fetches of the
+      // tfcompile config, and the batch size the model was compiled for
+      Model(int batchSize, const std::vector<int>& inputRowSizes, const std::vector<int>& outputRowSizes)
+          : batchSize_(batchSize), inputRowSizes_(inputRowSizes), outputRowSizes_(outputRowSizes) {
+        if (batchSize_ <= 0) {
+          throw cms::Exception("InvalidBatchSize") << "the batch size must be positive, got " << batchSize_;
+        }
+        if (int(inputRowSizes_.size()) != function_.num_args()) {
+          throw cms::Exception("InvalidInput") << "the compiled model has " << function_.num_args() << " inputs, got "
+                                               << inputRowSizes_.size() << " row sizes";
+        }
+        if (int(outputRowSizes_.size()) > function_.num_results()) {
+          throw cms::Exception("InvalidOutput") << "the compiled model has " << function_.num_results()
+                                                << " outputs, got " << outputRowSizes_.size() << " row sizes";
+        }
+      }
+
+      int batchSize() const { return batchSize_; }
+
+      // runs the inference of the nRows rows of the inputs, and resizes the outputs to their nRows rows
+      void run(const std::vector<std::vector<T>>& inputs, int nRows, std::vector<std::vector<T>>& outputs) {
+        if (inputs.size() != inputRowSizes_.size()) {
+          throw cms::Exception("InvalidInput")
+              << "expected " << inputRowSizes_.size() << " inputs, got " << inputs.size();
+        }
+        for (size_t i = 0; i < inputs.size(); i++) {
+          if (inputs[i].size() < size_t(nRows * inputRowSizes_[i])) {
+            throw cms::Exception("InvalidInput") << "input " << i << " has " << inputs[i].size()
+                                                 << " values, expected " << nRows * inputRowSizes_[i];
+          }
+        }
+        outputs.resize(outputRowSizes_.size());
+        for (size_t i = 0; i < outputs.size(); i++) {
+          outputs[i].resize(nRows * outputRowSizes_[i]);
+        }
+
+        for (int first = 0; first < nRows; first += batchSize_) {
+          const int n = std::min(batchSize_, nRows - first);
+          for (size_t i = 0; i < inputs.size(); i++) {
+            const int rowSize = inputRowSizes_[i];
+            T* arg = static_cast<T*>(function_.arg_data(i));
+            std::copy_n(inputs[i].data() + first * rowSize, n * rowSize, arg);
+            std::fill(arg + n * rowSize, arg + batchSize_ * rowSize, T(0));
+          }
+          if (!function_.Run()) {
+            throw cms::Exception("InvalidRun") << "error while running the compiled model: " << function_.error_msg();
+          }
+          for (size_t i = 0; i < outputs.size(); i++) {
+            const int rowSize = outputRowSizes_[i];
+            const T* result = static_cast<const T*>(function_.result_data(i));
+            std::copy_n(result, n * rowSize, outputs[i].data() + first * rowSize);
+          }
+        }
+      }
+
+    private:
+      CompiledFunction function_;
+      const int batchSize_;
+      const std::vector<int> inputRowSizes_;
+      const std::vector<int> outputRowSizes_;
+    };
+
+  }  // namespace aot
+
+}  // namespace tensorflow
+
+#endif  // PHYSICSTOOLS_TENSORFLOW_AOTMODEL_H
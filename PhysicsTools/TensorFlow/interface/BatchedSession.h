@@ -0,0 +1,67 @@
+/*
+ * Session shared between the framework streams, which runs the inference of the requests of
+ * several streams in one batch. A batch is run when it has maxBatchSize rows, or when its first
+ * request waited maxLatency, and holds at most maxBatchSize rows unless a single request is larger.
+ * Based on TensorFlow C++ API 2.1.
+ */
+
+#ifndef PHYSICSTOOLS_TENSORFLOW_BATCHEDSESSION_H
+#define PHYSICSTOOLS_TENSORFLOW_BATCHEDSESSION_H
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "FWCore/Concurrency/interface/RequestBatcher.h"
+#include "PhysicsTools/TensorFlow/interface/TensorFlow.h"
+
+namespace tensorflow {
+
+  class BatchedSession {
+  public:
+    // the rows of the input of a request, and its outputs once done is called, with or without an exception;
+    // done is moved out of the request and called from the thread of the BatchedSession, without a lock held
+    struct Request {
+      std::vector<float> input;
+      int nRows = 0;
+      std::vector<std::vector<float>> outputs;
+      std::function<void(std::exception_ptr)> done;
+    };
+
+    // the input tensor of a batch has the shape {rows, rowShape...}; the constant inputs are given to every run
+    BatchedSession(GraphDef* graphDef,
+                   const std::string& inputName,
+                   const std::vector<int64>& rowShape,
+                   const std::vector<std::string>& outputNames,
+                   int maxBatchSize,
+                   std::chrono::microseconds maxLatency,
+                   const NamedTensorList& constantInputs = {});
+    ~BatchedSession();
+
+    BatchedSession(const BatchedSession&) = delete;
+    BatchedSession& operator=(const BatchedSession&) = delete;
+
+    int rowSize() const { return rowSize_; }
+
+    // queues the request, which the caller keeps alive until request->done has been called
+    void submit(Request* request);
+
+  private:
+    void runBatch(const std::vector<Request*>& batch, int64 nRows);
+
+    Session* session_;
+    const std::string inputName_;
+    const std::vector<int64> rowShape_;
+    const std::vector<std::string> outputNames_;
+    const NamedTensorList constantInputs_;
+    int rowSize_;
+
+    // runs the batches until it is reset, before the session is closed
+    std::unique_ptr<edm::RequestBatcher<Request>> batcher_;
+  };
+
+}  // namespace tensorflow
+
+#endif  // PHYSICSTOOLS_TENSORFLOW_BATCHEDSESSION_H
@@ -0,0 +1,72 @@
+/*
+ * Session shared between the framework streams, which runs the inference of the requests of
+ * several streams in one batch.
+ * Based on TensorFlow C++ API 2.1.
+ */
+
+#include "PhysicsTools/TensorFlow/interface/BatchedSession.h"
+
+#include <algorithm>
+
+namespace tensorflow {
+
+  BatchedSession::BatchedSession(GraphDef* graphDef,
+                                 const std::string& inputName,
+                                 const std::vector<int64>& rowShape,
+                                 const std::vector<std::string>& outputNames,
+                                 int maxBatchSize,
+                                 std::chrono::microseconds maxLatency,
+                                 const NamedTensorList& constantInputs)
+      : session_(createSession(graphDef)),
+        inputName_(inputName),
+        rowShape_(rowShape),
+        outputNames_(outputNames),
+        constantInputs_(constantInputs),
+        rowSize_(1) {
+    if (maxBatchSize <= 0) {
+      throw cms::Exception("InvalidBatchSize") << "the maximum batch size must be positive, got " << maxBatchSize;
+    }
+    for (auto n : rowShape_) {
+      rowSize_ *= n;
+    }
+    batcher_ = std::make_unique<edm::RequestBatcher<Request>>(
+        maxBatchSize, maxLatency, [this](const std::vector<Request*>& batch, int64 nRows) { runBatch(batch, nRows); });
+  }
+
+  BatchedSession::~BatchedSession() {
+    // the pending requests are run with the session still open
+    batcher_.reset();
+    closeSession(session_);
+  }
+
+  void BatchedSession::submit(Request* request) { batcher_->submit(request); }
+
+  void BatchedSession::runBatch(const std::vector<Request*>& batch, int64 nRows) {
+    // the rows of the requests one after the other
+    TensorShape shape({nRows});
+    for (auto n : rowShape_) {
+      shape.AddDim(n);
+    }
+    Tensor input(DT_FLOAT, shape);
+    float* data = input.flat<float>().data();
+    for (auto const* request : batch) {
+      data = std::copy_n(request->input.begin(), request->nRows * rowSize_, data);
+    }
+
+    NamedTensorList inputs = constantInputs_;
+    inputs.emplace_back(inputName_, input);
+    std::vector<Tensor> outputs;
+    run(session_, inputs, outputNames_, &outputs);
+
+    for (size_t i = 0; i < outputs.size(); i++) {
+      const float* output = outputs[i].flat<float>().data();
+      const int64 outputRowSize = nRows > 0 ? outputs[i].NumElements() / nRows : 0;
+      for (auto* request : batch) {
+        request->outputs.resize(outputs.size());
+        request->outputs[i].assign(output, output + request->nRows * outputRowSize);
+        output += request->nRows * outputRowSize;
+      }
+    }
+  }
+
+}  // namespace tensorflow
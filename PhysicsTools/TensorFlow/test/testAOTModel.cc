@@ -0,0 +1,127 @@
+/*
+ * Tests for running the rows of an inference in batches of the compiled size with an AOT model.
+ * The compiled function is replaced by a class with the interface of the classes generated by tfcompile,
+ * so that the test does not need the XLA externals.
+ * Based on TensorFlow 2.1.
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "PhysicsTools/TensorFlow/interface/AOTModel.h"
+
+namespace {
+
+  // compiled for batches of 2 rows: result0 = arg0 + arg1 for each row of 3 values, result1 = sum of the row
+  class AddRows {
+  public:
+    static constexpr int kBatchSize = 2;
+    static constexpr int kRowSize = 3;
+
+    AddRows() : args_(2, std::vector<float>(kBatchSize * kRowSize)), results_{{}, {}} {
+      results_[0].resize(kBatchSize * kRowSize);
+      results_[1].resize(kBatchSize);
+    }
+
+    // the model owns its function, the test looks at the runs through these
+    static int nRuns;
+    static bool padded;
+    static bool fail;
+
+    int num_args() const { return args_.size(); }
+    int num_results() const { return results_.size(); }
+    void* arg_data(int i) { return args_[i].data(); }
+    const void* result_data(int i) const { return results_[i].data(); }
+    std::string error_msg() const { return fail ? "failed" : ""; }
+
+    bool Run() {
+      ++nRuns;
+      if (fail) {
+        return false;
+      }
+      for (int row = 0; row < kBatchSize; row++) {
+        results_[1][row] = 0;
+        for (int j = 0; j < kRowSize; j++) {
+          const int k = row * kRowSize + j;
+          results_[0][k] = args_[0][k] + args_[1][k];
+          results_[1][row] += results_[0][k];
+        }
+      }
+      // the padding of the last batch is zeros
+      padded = padded || (args_[0].back() == 0 && args_[1].back() == 0);
+      return true;
+    }
+
+  private:
+    std::vector<std::vector<float>> args_;
+    std::vector<std::vector<float>> results_;
+  };
+
+  int AddRows::nRuns = 0;
+  bool AddRows::padded = false;
+  bool AddRows::fail = false;
+
+  using TestModel = tensorflow::aot::Model<AddRows>;
+
+}  // namespace
+
+class testAOTModel : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testAOTModel);
+  CPPUNIT_TEST(checkAll);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void checkAll();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testAOTModel);
+
+void testAOTModel::checkAll() {
+  const int rowSize = AddRows::kRowSize;
+  TestModel model(AddRows::kBatchSize, {rowSize, rowSize}, {rowSize, 1});
+  CPPUNIT_ASSERT(model.batchSize() == AddRows::kBatchSize);
+
+  // 5 rows are run in 3 batches, the last one padded
+  const int nRows = 5;
+  std::vector<std::vector<float>> inputs(2, std::vector<float>(nRows * rowSize));
+  for (int i = 0; i < nRows * rowSize; i++) {
+    inputs[0][i] = i;
+    inputs[1][i] = 100 * i;
+  }
+  std::vector<std::vector<float>> outputs;
+  model.run(inputs, nRows, outputs);
+  CPPUNIT_ASSERT(AddRows::nRuns == 3);
+  CPPUNIT_ASSERT(AddRows::padded);
+  CPPUNIT_ASSERT(outputs.size() == 2);
+  CPPUNIT_ASSERT(outputs[0].size() == size_t(nRows * rowSize));
+  CPPUNIT_ASSERT(outputs[1].size() == size_t(nRows));
+  for (int row = 0; row < nRows; row++) {
+    float sum = 0;
+    for (int j = 0; j < rowSize; j++) {
+      const int k = row * rowSize + j;
+      CPPUNIT_ASSERT(outputs[0][k] == 101 * k);
+      sum += 101 * k;
+    }
+    CPPUNIT_ASSERT(outputs[1][row] == sum);
+  }
+
+  // a single row, and no rows at all
+  model.run(inputs, 1, outputs);
+  CPPUNIT_ASSERT(outputs[0] == std::vector<float>({0, 101, 202}));
+  CPPUNIT_ASSERT(outputs[1] == std::vector<float>({303}));
+  model.run(inputs, 0, outputs);
+  CPPUNIT_ASSERT(outputs[0].empty() && outputs[1].empty());
+
+  // wrong inputs and a failed run
+  CPPUNIT_ASSERT_THROW(model.run({inputs[0]}, nRows, outputs), cms::Exception);
+  CPPUNIT_ASSERT_THROW(model.run(inputs, nRows + 1, outputs), cms::Exception);
+  AddRows::fail = true;
+  CPPUNIT_ASSERT_THROW(model.run(inputs, nRows, outputs), cms::Exception);
+
+  // the sizes must match the compiled function
+  CPPUNIT_ASSERT_THROW(TestModel(0, {rowSize, rowSize}, {rowSize}), cms::Exception);
+  CPPUNIT_ASSERT_THROW(TestModel(2, {rowSize}, {rowSize}), cms::Exception);
+  CPPUNIT_ASSERT_THROW(TestModel(2, {rowSize, rowSize}, {rowSize, 1, 1}), cms::Exception);
+}
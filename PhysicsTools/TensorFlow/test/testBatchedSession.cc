@@ -0,0 +1,106 @@
+/*
+ * Tests for the inference of the requests of several threads in batches with a BatchedSession.
+ * Based on TensorFlow 2.1.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "PhysicsTools/TensorFlow/interface/BatchedSession.h"
+
+#include "testBase.h"
+
+class testBatchedSession : public testBase {
+  CPPUNIT_TEST_SUITE(testBatchedSession);
+  CPPUNIT_TEST(checkAll);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  std::string pyScript() const override;
+  void checkAll() override;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testBatchedSession);
+
+std::string testBatchedSession::pyScript() const { return "createconstantgraph.py"; }
+
+void testBatchedSession::checkAll() {
+  std::string pbFile = dataPath_ + "/constantgraph.pb";
+
+  tensorflow::setLogging();
+  tensorflow::GraphDef* graphDef = tensorflow::loadGraphDef(pbFile);
+  CPPUNIT_ASSERT(graphDef != nullptr);
+
+  tensorflow::Tensor scale(tensorflow::DT_FLOAT, {});
+  scale.scalar<float>()() = 1.0;
+
+  // the requests of the threads are run in batches of at most 16 rows, or after 10 ms
+  const int nThreads = 4;
+  const int nRows = 3;
+  std::atomic<int> nDone{0};
+  std::atomic<int> nFailed{0};
+  {
+    tensorflow::BatchedSession session(
+        graphDef, "input", {10}, {"output"}, 16, std::chrono::milliseconds(10), {{"scale", scale}});
+    CPPUNIT_ASSERT(session.rowSize() == 10);
+
+    std::vector<tensorflow::BatchedSession::Request> requests(nThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; t++) {
+      threads.emplace_back([&, t]() {
+        auto& request = requests[t];
+        request.nRows = nRows;
+        request.input.resize(nRows * session.rowSize());
+        for (int i = 0; i < nRows; i++) {
+          for (int j = 0; j < 10; j++) {
+            request.input[i * 10 + j] = float(t + i);
+          }
+        }
+        request.done = [&](std::exception_ptr exception) {
+          if (exception) {
+            nFailed++;
+          }
+          nDone++;
+        };
+        session.submit(&request);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    while (nDone < nThreads) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // each row is the sum of its inputs plus one
+    CPPUNIT_ASSERT(nFailed == 0);
+    for (int t = 0; t < nThreads; t++) {
+      CPPUNIT_ASSERT(requests[t].outputs.size() == 1);
+      CPPUNIT_ASSERT(requests[t].outputs[0].size() == nRows);
+      for (int i = 0; i < nRows; i++) {
+        CPPUNIT_ASSERT(requests[t].outputs[0][i] == 10. * (t + i) + 1.);
+      }
+    }
+
+    // a failed run is reported to the requests of the batch
+    tensorflow::BatchedSession badSession(graphDef, "foo", {10}, {"output"}, 1, std::chrono::milliseconds(10));
+    tensorflow::BatchedSession::Request request;
+    request.nRows = 1;
+    request.input.assign(10, 0.);
+    request.done = [&](std::exception_ptr exception) {
+      if (exception) {
+        nFailed++;
+      }
+      nDone++;
+    };
+    badSession.submit(&request);
+    while (nDone < nThreads + 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CPPUNIT_ASSERT(nFailed == 1);
+  }
+
+  delete graphDef;
+}
@@ -228,6 +228,12 @@ void DeepFlavourTagInfoProducer::produce(edm::Event& iEvent, const edm::EventSet
     }
   }
 
+  // copy which is sorted by dxy, once for all the jets since the order depends only on the primary vertex
+  auto svs_sorted = *svs;
+  std::sort(svs_sorted.begin(), svs_sorted.end(), [&pv](const auto& sva, const auto& svb) {
+    return btagbtvdeep::sv_vertex_comparator(sva, svb, pv);
+  });
+
   for (std::size_t jet_n = 0; jet_n < jets->size(); jet_n++) {
     // create data containing structure
     btagbtvdeep::DeepFlavourFeatures features;
@@ -270,12 +276,6 @@ void DeepFlavourTagInfoProducer::produce(edm::Event& iEvent, const edm::EventSet
     const auto& tag_info_vars = tag_info.taggingVariables();
     btagbtvdeep::bTagToFeatures(tag_info_vars, features.tag_info_features);
 
-    // copy which will be sorted
-    auto svs_sorted = *svs;
-    // sort by dxy
-    std::sort(svs_sorted.begin(), svs_sorted.end(), [&pv](const auto& sva, const auto& svb) {
-      return btagbtvdeep::sv_vertex_comparator(sva, svb, pv);
-    });
     // fill features from secondary vertices
     for (const auto& sv : svs_sorted) {
       if (reco::deltaR2(sv, jet_dir) > (jet_radius_ * jet_radius_))
@@ -291,6 +291,8 @@ void DeepFlavourTagInfoProducer::produce(edm::Event& iEvent, const edm::EventSet
     // stuff required for dealing with pf candidates
 
     std::vector<btagbtvdeep::SortingClass<size_t>> c_sorted, n_sorted;
+    c_sorted.reserve(jet.numberOfDaughters());
+    n_sorted.reserve(jet.numberOfDaughters());
 
     // to cache the TrackInfo
     std::map<unsigned int, btagbtvdeep::TrackInfoBuilder> trackinfos;
@@ -1,5 +1,6 @@
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
@@ -14,7 +15,9 @@
 #include "DataFormats/BTauReco/interface/DeepBoostedJetTagInfo.h"
 
 #include "PhysicsTools/ONNXRuntime/interface/ONNXRuntime.h"
+#include "PhysicsTools/ONNXRuntime/interface/BatchedONNXRuntime.h"
 
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <algorithm>
@@ -45,30 +48,40 @@ struct PreprocessParams {
   }
 };
 
-class DeepBoostedJetONNXJetTagsProducer : public edm::stream::EDProducer<edm::GlobalCache<ONNXRuntime>> {
+// the model, and the batches of the jets of all the streams when they are run together
+struct DeepBoostedJetONNXCache {
+  std::unique_ptr<ONNXRuntime> model;
+  std::unique_ptr<BatchedONNXRuntime> batched;
+};
+
+class DeepBoostedJetONNXJetTagsProducer
+    : public edm::stream::EDProducer<edm::GlobalCache<DeepBoostedJetONNXCache>, edm::ExternalWork> {
 public:
-  explicit DeepBoostedJetONNXJetTagsProducer(const edm::ParameterSet &, const ONNXRuntime *);
+  explicit DeepBoostedJetONNXJetTagsProducer(const edm::ParameterSet &, const DeepBoostedJetONNXCache *);
   ~DeepBoostedJetONNXJetTagsProducer() override;
 
   static void fillDescriptions(edm::ConfigurationDescriptions &);
 
-  static std::unique_ptr<ONNXRuntime> initializeGlobalCache(const edm::ParameterSet &);
-  static void globalEndJob(const ONNXRuntime *);
+  static std::unique_ptr<DeepBoostedJetONNXCache> initializeGlobalCache(const edm::ParameterSet &);
+  static void globalEndJob(DeepBoostedJetONNXCache *);
 
 private:
   typedef std::vector<reco::DeepBoostedJetTagInfo> TagInfoCollection;
   typedef reco::JetTagCollection JetTagCollection;
 
+  void acquire(const edm::Event &, const edm::EventSetup &, edm::WaitingTaskWithArenaHolder) override;
   void produce(edm::Event &, const edm::EventSetup &) override;
 
-  std::vector<float> center_norm_pad(const std::vector<float> &input,
-                                     float center,
-                                     float scale,
-                                     unsigned target_length,
-                                     float pad_value = 0,
-                                     float min = 0,
-                                     float max = -1);
-  void make_inputs(const reco::DeepBoostedJetTagInfo &taginfo);
+  void center_norm_pad(const std::vector<float> &input,
+                       float center,
+                       float scale,
+                       unsigned target_length,
+                       float *out,
+                       float pad_value = 0,
+                       float min = 0,
+                       float max = -1);
+  // writes the inputs of the jet in the row jet_row of each input group of data, in the layout of the input tensors
+  void make_inputs(const reco::DeepBoostedJetTagInfo &taginfo, FloatArrays &data, unsigned jet_row);
 
   const edm::EDGetTokenT<TagInfoCollection> src_;
   std::vector<std::string> flav_names_;                  // names of the output scores
@@ -78,11 +91,15 @@ private:
 
   FloatArrays data_;
 
+  // the jets of the event with features, in the rows of the request given to the batches of all the streams
+  std::vector<unsigned> batched_jets_;
+  BatchedONNXRuntime::Request request_;
+
   bool debug_ = false;
 };
 
 DeepBoostedJetONNXJetTagsProducer::DeepBoostedJetONNXJetTagsProducer(const edm::ParameterSet &iConfig,
-                                                                     const ONNXRuntime *cache)
+                                                                     const DeepBoostedJetONNXCache *cache)
     : src_(consumes<TagInfoCollection>(iConfig.getParameter<edm::InputTag>("src"))),
       flav_names_(iConfig.getParameter<std::vector<std::string>>("flav_names")),
       debug_(iConfig.getUntrackedParameter<bool>("debugMode", false)) {
@@ -160,16 +177,70 @@ void DeepBoostedJetONNXJetTagsProducer::fillDescriptions(edm::ConfigurationDescr
                                          "probQCDc",
                                          "probQCDothers",
                                      });
+  // the jets of all the streams are run in batches of batch_size, or after batch_max_latency us
+  desc.add<int>("batch_size", 0);
+  desc.add<int>("batch_max_latency", 1000);
   desc.addOptionalUntracked<bool>("debugMode", false);
 
   descriptions.add("pfDeepBoostedJetTags", desc);
 }
 
-std::unique_ptr<ONNXRuntime> DeepBoostedJetONNXJetTagsProducer::initializeGlobalCache(const edm::ParameterSet &iConfig) {
-  return std::make_unique<ONNXRuntime>(iConfig.getParameter<edm::FileInPath>("model_path").fullPath());
+std::unique_ptr<DeepBoostedJetONNXCache> DeepBoostedJetONNXJetTagsProducer::initializeGlobalCache(
+    const edm::ParameterSet &iConfig) {
+  auto cache = std::make_unique<DeepBoostedJetONNXCache>();
+  cache->model = std::make_unique<ONNXRuntime>(iConfig.getParameter<edm::FileInPath>("model_path").fullPath());
+
+  // the jets of all the streams are given to one queue, which runs them in batches
+  int batch_size = iConfig.getParameter<int>("batch_size");
+  if (batch_size > 0) {
+    cache->batched = std::make_unique<BatchedONNXRuntime>(
+        *cache->model,
+        iConfig.getParameterSet("preprocessParams").getParameter<std::vector<std::string>>("input_names"),
+        std::vector<std::string>{},
+        batch_size,
+        std::chrono::microseconds(iConfig.getParameter<int>("batch_max_latency")));
+  }
+  return cache;
 }
 
-void DeepBoostedJetONNXJetTagsProducer::globalEndJob(const ONNXRuntime *cache) {}
+void DeepBoostedJetONNXJetTagsProducer::globalEndJob(DeepBoostedJetONNXCache *cache) { cache->batched.reset(); }
+
+void DeepBoostedJetONNXJetTagsProducer::acquire(const edm::Event &iEvent,
+                                                const edm::EventSetup &iSetup,
+                                                edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  batched_jets_.clear();
+  if (!globalCache()->batched) {
+    return;
+  }
+
+  edm::Handle<TagInfoCollection> tag_infos;
+  iEvent.getByToken(src_, tag_infos);
+
+  for (unsigned jet_n = 0; jet_n < tag_infos->size(); ++jet_n) {
+    if (!(*tag_infos)[jet_n].features().empty()) {
+      batched_jets_.push_back(jet_n);
+    }
+  }
+  if (batched_jets_.empty()) {
+    return;
+  }
+
+  // the inputs of the jets with features one after the other, written in place for each input group
+  request_.inputs.resize(input_names_.size());
+  for (unsigned igroup = 0; igroup < input_names_.size(); ++igroup) {
+    request_.inputs[igroup].resize(batched_jets_.size() * data_[igroup].size());
+  }
+  for (unsigned jet_row = 0; jet_row < batched_jets_.size(); ++jet_row) {
+    make_inputs((*tag_infos)[batched_jets_[jet_row]], request_.inputs, jet_row);
+  }
+
+  // the inference of the jets is run with those of the other streams
+  request_.nRows = batched_jets_.size();
+  request_.done = [holder = std::move(waitingTaskHolder)](std::exception_ptr exception) mutable {
+    holder.doneWaiting(exception);
+  };
+  globalCache()->batched->submit(&request_);
+}
 
 void DeepBoostedJetONNXJetTagsProducer::produce(edm::Event &iEvent, const edm::EventSetup &iSetup) {
   edm::Handle<TagInfoCollection> tag_infos;
@@ -189,15 +260,24 @@ void DeepBoostedJetONNXJetTagsProducer::produce(edm::Event &iEvent, const edm::E
     }
   }
 
+  assert(batched_jets_.empty() || request_.outputs[0].size() == batched_jets_.size() * flav_names_.size());
+  auto batched_jet = batched_jets_.begin();
   for (unsigned jet_n = 0; jet_n < tag_infos->size(); ++jet_n) {
     const auto &taginfo = (*tag_infos)[jet_n];
     std::vector<float> outputs(flav_names_.size(), 0);  // init as all zeros
 
-    if (!taginfo.features().empty()) {
+    if (globalCache()->batched) {
+      // the outputs of the jet in the request run in acquire
+      if (batched_jet != batched_jets_.end() && *batched_jet == jet_n) {
+        const auto row = request_.outputs[0].begin() + (batched_jet - batched_jets_.begin()) * flav_names_.size();
+        outputs.assign(row, row + flav_names_.size());
+        ++batched_jet;
+      }
+    } else if (!taginfo.features().empty()) {
       // convert inputs
-      make_inputs(taginfo);
+      make_inputs(taginfo, data_, 0);
       // run prediction and get outputs
-      outputs = globalCache()->run(input_names_, data_)[0];
+      outputs = globalCache()->model->run(input_names_, data_)[0];
       assert(outputs.size() == flav_names_.size());
     }
 
@@ -226,48 +306,49 @@ void DeepBoostedJetONNXJetTagsProducer::produce(edm::Event &iEvent, const edm::E
   }
 }
 
-std::vector<float> DeepBoostedJetONNXJetTagsProducer::center_norm_pad(const std::vector<float> &input,
-                                                                      float center,
-                                                                      float norm_factor,
-                                                                      unsigned target_length,
-                                                                      float pad_value,
-                                                                      float min,
-                                                                      float max) {
+void DeepBoostedJetONNXJetTagsProducer::center_norm_pad(const std::vector<float> &input,
+                                                        float center,
+                                                        float norm_factor,
+                                                        unsigned target_length,
+                                                        float *out,
+                                                        float pad_value,
+                                                        float min,
+                                                        float max) {
   // do variable shifting/scaling/padding/clipping in one go
 
   assert(min <= pad_value && pad_value <= max);
 
-  std::vector<float> out(target_length, pad_value);
-  for (unsigned i = 0; i < input.size() && i < target_length; ++i) {
+  const unsigned n = std::min<std::size_t>(input.size(), target_length);
+  for (unsigned i = 0; i < n; ++i) {
     out[i] = std::clamp((input[i] - center) * norm_factor, min, max);
   }
-  return out;
+  std::fill(out + n, out + target_length, pad_value);
 }
 
-void DeepBoostedJetONNXJetTagsProducer::make_inputs(const reco::DeepBoostedJetTagInfo &taginfo) {
+void DeepBoostedJetONNXJetTagsProducer::make_inputs(const reco::DeepBoostedJetTagInfo &taginfo,
+                                                    FloatArrays &data,
+                                                    unsigned jet_row) {
   for (unsigned igroup = 0; igroup < input_names_.size(); ++igroup) {
     const auto &group_name = input_names_[igroup];
-    auto &group_values = data_[igroup];
     const auto &prep_params = prep_info_map_.at(group_name);
-    // first reset group_values to 0
-    std::fill(group_values.begin(), group_values.end(), 0);
+    // the row of the jet, every value of which is written below
+    float *group_values = data[igroup].data() + jet_row * data_[igroup].size();
     unsigned curr_pos = 0;
     // transform/pad
     for (const auto &varname : prep_params.var_names) {
       const auto &raw_value = taginfo.features().get(varname);
       const auto &info = prep_params.get_info(varname);
       const float pad = 0;  // pad w/ zero
-      auto val = center_norm_pad(raw_value, info.center, info.norm_factor, prep_params.var_length, pad, -5, 5);
-      std::copy(val.begin(), val.end(), group_values.begin() + curr_pos);
+      float *val = group_values + curr_pos;
+      center_norm_pad(raw_value, info.center, info.norm_factor, prep_params.var_length, val, pad, -5, 5);
       curr_pos += prep_params.var_length;
 
       if (debug_) {
         std::cout << " -- var=" << varname << ", center=" << info.center << ", scale=" << info.norm_factor
                   << ", pad=" << pad << std::endl;
-        std::cout << "values (first 7 and last 3): " << val.at(0) << ", " << val.at(1) << ", " << val.at(2) << ", "
-                  << val.at(3) << ", " << val.at(4) << ", " << val.at(5) << ", " << val.at(6) << " ... "
-                  << val.at(prep_params.var_length - 3) << ", " << val.at(prep_params.var_length - 2) << ", "
-                  << val.at(prep_params.var_length - 1) << std::endl;
+        std::cout << "values (first 7 and last 3): " << val[0] << ", " << val[1] << ", " << val[2] << ", " << val[3]
+                  << ", " << val[4] << ", " << val[5] << ", " << val[6] << " ... " << val[prep_params.var_length - 3]
+                  << ", " << val[prep_params.var_length - 2] << ", " << val[prep_params.var_length - 1] << std::endl;
       }
     }
   }
@@ -107,10 +107,10 @@ void DeepFlavourONNXJetTagsProducer::produce(edm::Event& iEvent, const edm::Even
       output_tags.emplace_back(std::make_unique<JetTagCollection>(ref2prod));
     }
 
-    // init data storage
-    data_.clear();
-    for (const auto& len : input_sizes_) {
-      data_.emplace_back(tag_infos->size() * len, 0);
+    // init data storage, keeping the buffers of the previous events
+    data_.resize(input_sizes_.size());
+    for (std::size_t i = 0; i < input_sizes_.size(); i++) {
+      data_[i].assign(tag_infos->size() * input_sizes_[i], 0);
     }
 
     // convert inputs
@@ -127,7 +127,15 @@ private:
   clustering_type _clustype;
   energy_weight _eweight;
   void buildAllSuperClusters(CalibratedClusterPtrVector&, double seedthresh);
+  // builds the supercluster of the seed from its clustered clusters
   void buildSuperCluster(CalibratedClusterPtr&, CalibratedClusterPtrVector&);
+  void superClusterWidths(const CalibratedPFCluster& seed,
+                          double& etawidthSuperCluster,
+                          double& phiwidthSuperCluster) const;
+
+  // the clusters in the windows of each seed, by index in the sorted clusters, kept between the events
+  std::vector<std::vector<unsigned> > seedClustered_;
+  std::vector<std::vector<unsigned> > seedSatellites_;
 
   bool verbose_;
 
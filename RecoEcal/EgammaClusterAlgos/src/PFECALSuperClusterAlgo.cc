@@ -15,11 +15,16 @@
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <sstream>
 #include <cmath>
 #include <functional>
+#include <numeric>
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 using namespace std;
 using namespace std::placeholders;  // for _1, _2, _3...
@@ -104,6 +109,81 @@ namespace {
     return false;
   }
 
+  // the largest cutoff of reco::MustacheKernel::inDynamicDPhiWindow
+  constexpr double maxDynamicDPhi = 0.60;
+  // the window of the satellite clusters linked by rechits to a seed
+  constexpr double satelliteMaxDEta = 0.1;
+  constexpr double satelliteMaxDPhi = 0.2;
+
+  // the clusters by bins of eta and phi, as wide as the largest window in which a seed takes clusters, so that a
+  // seed only looks at the clusters of the bins next to its own; no eta window gives a single eta bin
+  class ClusterBins {
+  public:
+    ClusterBins(const CalibClusterPtrVector& clusters, double etaWindow, double phiWindow)
+        : etaMin_(0.), etaBinWidth_(0.), nEtaBins_(1) {
+      // the bins are a little wider than the windows, for the clusters at their edges
+      etaWindow *= 1.01;
+      phiWindow *= 1.01;
+      nPhiBins_ = phiWindow > 0. ? std::clamp(int(2. * M_PI / phiWindow), 1, kMaxBins) : 1;
+      phiBinWidth_ = 2. * M_PI / nPhiBins_;
+      if (etaWindow > 0. && !clusters.empty()) {
+        auto etaRange = std::minmax_element(
+            clusters.begin(), clusters.end(), [](const auto& a, const auto& b) { return a->eta() < b->eta(); });
+        etaMin_ = (*etaRange.first)->eta();
+        const double etaLength = (*etaRange.second)->eta() - etaMin_;
+        etaBinWidth_ = std::max(etaWindow, etaLength / kMaxBins);
+        nEtaBins_ = int(etaLength / etaBinWidth_) + 1;
+      }
+
+      // the clusters of each bin, in the order of clusters
+      offsets_.assign(nEtaBins_ * nPhiBins_ + 1, 0);
+      std::vector<unsigned> bins(clusters.size());
+      for (unsigned i = 0; i < clusters.size(); ++i) {
+        bins[i] = etaBin(clusters[i]->eta()) * nPhiBins_ + phiBin(clusters[i]->phi());
+        ++offsets_[bins[i] + 1];
+      }
+      std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+      indices_.resize(clusters.size());
+      std::vector<unsigned> fill(offsets_.begin(), offsets_.end() - 1);
+      for (unsigned i = 0; i < clusters.size(); ++i) {
+        indices_[fill[bins[i]]++] = i;
+      }
+    }
+
+    // the clusters of the bins around eta and phi, in the order of clusters
+    void near(double eta, double phi, std::vector<unsigned>& result) const {
+      result.clear();
+      const int ieta = etaBin(eta);
+      const int iphi = phiBin(phi);
+      for (int jeta = std::max(ieta - 1, 0); jeta <= std::min(ieta + 1, nEtaBins_ - 1); ++jeta) {
+        // with less than three phi bins, each of them is taken once
+        const int firstPhi = nPhiBins_ < 3 ? 0 : iphi - 1;
+        const int lastPhi = nPhiBins_ < 3 ? nPhiBins_ - 1 : iphi + 1;
+        for (int jphi = firstPhi; jphi <= lastPhi; ++jphi) {
+          const int bin = jeta * nPhiBins_ + (jphi + nPhiBins_) % nPhiBins_;
+          result.insert(result.end(), indices_.begin() + offsets_[bin], indices_.begin() + offsets_[bin + 1]);
+        }
+      }
+      std::sort(result.begin(), result.end());
+    }
+
+  private:
+    static constexpr int kMaxBins = 256;
+
+    int etaBin(double eta) const {
+      return nEtaBins_ == 1 ? 0 : std::clamp(int((eta - etaMin_) / etaBinWidth_), 0, nEtaBins_ - 1);
+    }
+    int phiBin(double phi) const { return std::clamp(int((phi + M_PI) / phiBinWidth_), 0, nPhiBins_ - 1); }
+
+    double etaMin_;
+    double etaBinWidth_;
+    int nEtaBins_;
+    double phiBinWidth_;
+    int nPhiBins_;
+    std::vector<unsigned> offsets_;
+    std::vector<unsigned> indices_;
+  };
+
 }  // namespace
 
 PFECALSuperClusterAlgo::PFECALSuperClusterAlgo() : beamSpot_(nullptr) {}
@@ -236,30 +316,138 @@ void PFECALSuperClusterAlgo::buildAllSuperClusters(CalibClusterPtrVector& cluste
   auto seedable = std::bind(isSeed, _1, seedthresh, threshIsET_);
   // make sure only seeds appear at the front of the list of clusters
   std::stable_partition(clusters.begin(), clusters.end(), seedable);
-  // in each iteration we are working on a list that is already sorted
-  // in the cluster energy and remains so through each iteration
-  // NB: since clusters is sorted in loadClusters any_of has O(1)
-  //     timing until you run out of seeds!
-  while (std::any_of(clusters.cbegin(), clusters.cend(), seedable)) {
-    buildSuperCluster(clusters.front(), clusters);
+  const unsigned nSeeds = std::find_if_not(clusters.cbegin(), clusters.cend(), seedable) - clusters.cbegin();
+  if (nSeeds == 0) {
+    return;
+  }
+
+  // the windows in which a seed can take clusters
+  double etawidthSuperCluster, phiwidthSuperCluster;
+  superClusterWidths(*clusters.front(), etawidthSuperCluster, phiwidthSuperCluster);
+  double phiWindow = useDynamicDPhi_ ? maxDynamicDPhi : phiwidthSuperCluster;
+  // the mustache has no bound in eta
+  double etaWindow = _clustype == kBOX ? etawidthSuperCluster : 0.;
+  if (doSatelliteClusterMerge_) {
+    phiWindow = std::max(phiWindow, satelliteMaxDPhi);
+    if (etaWindow > 0.) {
+      etaWindow = std::max(etaWindow, satelliteMaxDEta);
+    }
+  }
+  const ClusterBins bins(clusters, etaWindow, phiWindow);
+
+  // the clusters each seed would take if it were the first one, found for all the seeds in parallel
+  if (seedClustered_.size() < nSeeds) {
+    seedClustered_.resize(nSeeds);
+    seedSatellites_.resize(nSeeds);
   }
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(0U, nSeeds, [&](unsigned iseed) {
+      const auto& seed = clusters[iseed];
+      auto& clustered = seedClustered_[iseed];
+      auto& satellites = seedSatellites_[iseed];
+      clustered.clear();
+      satellites.clear();
+      thread_local std::vector<unsigned> near;
+      bins.near(seed->eta(), seed->phi(), near);
+      for (auto i : near) {
+        if (isClustered(clusters[i], seed, _clustype, useDynamicDPhi_, etawidthSuperCluster, phiwidthSuperCluster)) {
+          clustered.push_back(i);
+        } else if (doSatelliteClusterMerge_ &&
+                   isLinkedByRecHit(clusters[i],
+                                    seed,
+                                    satelliteThreshold_,
+                                    fractionForMajority_,
+                                    satelliteMaxDEta,
+                                    satelliteMaxDPhi)) {
+          satellites.push_back(i);
+        }
+      }
+    });
+  });
+
+  // in the order of the seeds, as each seed would take them in turn, a seed takes the clusters of its windows which
+  // are not taken yet, first the clustered then the satellite ones; the clusters not taken stay in clusters
+  std::vector<uint8_t> taken(clusters.size(), 0);
+  CalibClusterPtrVector clustered;
+  for (unsigned iseed = 0; iseed < nSeeds; ++iseed) {
+    // a seed which is not clustered with itself is the first of the remaining clusters again
+    while (!taken[iseed]) {
+      clustered.clear();
+      for (const auto* list : {&seedClustered_[iseed], &seedSatellites_[iseed]}) {
+        for (auto i : *list) {
+          if (!taken[i]) {
+            taken[i] = 1;
+            clustered.push_back(clusters[i]);
+          }
+        }
+      }
+
+      if (verbose_) {
+        edm::LogInfo("PFClustering") << "Dumping cluster detail";
+        edm::LogVerbatim("PFClustering") << "\tPassed seed: e = " << clusters[iseed]->energy_nocalib()
+                                         << " eta = " << clusters[iseed]->eta() << " phi = " << clusters[iseed]->phi()
+                                         << std::endl;
+        for (const auto& clus : clustered) {
+          edm::LogVerbatim("PFClustering") << "\t\tClustered cluster: e = " << clus->energy_nocalib()
+                                           << " eta = " << clus->eta() << " phi = " << clus->phi() << std::endl;
+        }
+        for (unsigned i = 0; i < clusters.size(); ++i) {
+          if (!taken[i]) {
+            edm::LogVerbatim("PFClustering") << "\tNon-Clustered cluster: e = " << clusters[i]->energy_nocalib()
+                                             << " eta = " << clusters[i]->eta() << " phi = " << clusters[i]->phi()
+                                             << std::endl;
+          }
+        }
+      }
+
+      if (clustered.empty()) {
+        if (dropUnseedable_) {
+          taken[iseed] = 1;
+          break;
+        } else {
+          throw cms::Exception("PFECALSuperClusterAlgo::buildSuperCluster")
+              << "Cluster is not seedable!" << std::endl
+              << "\tNon-Clustered cluster: e = " << clusters[iseed]->energy_nocalib()
+              << " eta = " << clusters[iseed]->eta() << " phi = " << clusters[iseed]->phi() << std::endl;
+        }
+      }
+      buildSuperCluster(clusters[iseed], clustered);
+    }
+  }
+
+  unsigned i = 0;
+  clusters.erase(std::remove_if(clusters.begin(), clusters.end(), [&](const CalibClusterPtr&) { return taken[i++]; }),
+                 clusters.end());
 }
 
-void PFECALSuperClusterAlgo::buildSuperCluster(CalibClusterPtr& seed, CalibClusterPtrVector& clusters) {
-  double etawidthSuperCluster = 0.0;
-  double phiwidthSuperCluster = 0.0;
-  bool isEE = false;
-  switch (seed->the_ptr()->layer()) {
+void PFECALSuperClusterAlgo::superClusterWidths(const CalibratedPFCluster& seed,
+                                                double& etawidthSuperCluster,
+                                                double& phiwidthSuperCluster) const {
+  etawidthSuperCluster = 0.0;
+  phiwidthSuperCluster = 0.0;
+  switch (seed.the_ptr()->layer()) {
     case PFLayer::ECAL_BARREL:
       phiwidthSuperCluster = phiwidthSuperClusterBarrel_;
       etawidthSuperCluster = etawidthSuperClusterBarrel_;
-      edm::LogInfo("PFClustering") << "Building SC number " << superClustersEB_->size() + 1 << " in the ECAL barrel!";
       break;
     case PFLayer::HGCAL:
     case PFLayer::ECAL_ENDCAP:
-
       phiwidthSuperCluster = phiwidthSuperClusterEndcap_;
       etawidthSuperCluster = etawidthSuperClusterEndcap_;
+      break;
+    default:
+      break;
+  }
+}
+
+void PFECALSuperClusterAlgo::buildSuperCluster(CalibClusterPtr& seed, CalibClusterPtrVector& clustered) {
+  bool isEE = false;
+  switch (seed->the_ptr()->layer()) {
+    case PFLayer::ECAL_BARREL:
+      edm::LogInfo("PFClustering") << "Building SC number " << superClustersEB_->size() + 1 << " in the ECAL barrel!";
+      break;
+    case PFLayer::HGCAL:
+    case PFLayer::ECAL_ENDCAP:
       edm::LogInfo("PFClustering") << "Building SC number " << superClustersEE_->size() + 1 << " in the ECAL endcap!"
                                    << std::endl;
       isEE = true;
@@ -267,52 +455,7 @@ void PFECALSuperClusterAlgo::buildSuperCluster(CalibClusterPtr& seed, CalibClust
     default:
       break;
   }
-  auto isClusteredWithSeed =
-      std::bind(isClustered, _1, seed, _clustype, useDynamicDPhi_, etawidthSuperCluster, phiwidthSuperCluster);
-  auto matchesSeedByRecHit = std::bind(isLinkedByRecHit, _1, seed, satelliteThreshold_, fractionForMajority_, 0.1, 0.2);
-
-  // this function shuffles the list of clusters into a list
-  // where all clustered sub-clusters are at the front
-  // and returns a pointer to the first unclustered cluster.
-  // The relative ordering of clusters is preserved
-  // (i.e. both resulting sub-lists are sorted by energy).
-  auto not_clustered = std::stable_partition(clusters.begin(), clusters.end(), isClusteredWithSeed);
-  // satellite cluster merging
-  // it was found that large clusters can split!
-  if (doSatelliteClusterMerge_) {
-    not_clustered = std::stable_partition(not_clustered, clusters.end(), matchesSeedByRecHit);
-  }
-
-  if (verbose_) {
-    edm::LogInfo("PFClustering") << "Dumping cluster detail";
-    edm::LogVerbatim("PFClustering") << "\tPassed seed: e = " << seed->energy_nocalib() << " eta = " << seed->eta()
-                                     << " phi = " << seed->phi() << std::endl;
-    for (auto clus = clusters.cbegin(); clus != not_clustered; ++clus) {
-      edm::LogVerbatim("PFClustering") << "\t\tClustered cluster: e = " << (*clus)->energy_nocalib()
-                                       << " eta = " << (*clus)->eta() << " phi = " << (*clus)->phi() << std::endl;
-    }
-    for (auto clus = not_clustered; clus != clusters.end(); ++clus) {
-      edm::LogVerbatim("PFClustering") << "\tNon-Clustered cluster: e = " << (*clus)->energy_nocalib()
-                                       << " eta = " << (*clus)->eta() << " phi = " << (*clus)->phi() << std::endl;
-    }
-  }
-
-  if (not_clustered == clusters.begin()) {
-    if (dropUnseedable_) {
-      clusters.erase(clusters.begin());
-      return;
-    } else {
-      throw cms::Exception("PFECALSuperClusterAlgo::buildSuperCluster")
-          << "Cluster is not seedable!" << std::endl
-          << "\tNon-Clustered cluster: e = " << (*not_clustered)->energy_nocalib()
-          << " eta = " << (*not_clustered)->eta() << " phi = " << (*not_clustered)->phi() << std::endl;
-    }
-  }
 
-  // move the clustered clusters out of available cluster list
-  // and into a temporary vector for building the SC
-  CalibratedClusterPtrVector clustered(clusters.begin(), not_clustered);
-  clusters.erase(clusters.begin(), not_clustered);
   // need the vector of raw pointers for a PF width class
   std::vector<const reco::PFCluster*> bare_ptrs;
   // calculate necessary parameters and build the SC
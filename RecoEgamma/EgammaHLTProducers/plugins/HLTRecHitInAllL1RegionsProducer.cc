@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -36,8 +37,12 @@
 #include "CondFormats/L1TObjects/interface/L1CaloGeometry.h"
 #include "CondFormats/DataRecord/interface/L1CaloGeometryRecord.h"
 
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
 #include "DataFormats/EcalRecHit/interface/EcalRecHit.h"
 #include "DataFormats/EcalRecHit/interface/EcalUncalibratedRecHit.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
 
 #include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
 
@@ -90,6 +95,10 @@ public:
   }
 };
 
+L1RegionDataBase* createL1RegionData(const std::string&,
+                                     const edm::ParameterSet&,
+                                     edm::ConsumesCollector&&);  //calling function owns this
+
 template <typename RecHitType>
 class HLTRecHitInAllL1RegionsProducer : public edm::stream::EDProducer<> {
   using RecHitCollectionType = edm::SortedCollection<RecHitType>;
@@ -102,10 +111,6 @@ public:
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
 
 private:
-  L1RegionDataBase* createL1RegionData(const std::string&,
-                                       const edm::ParameterSet&,
-                                       edm::ConsumesCollector&&);  //calling function owns this
-
   std::vector<std::unique_ptr<L1RegionDataBase>> l1RegionData_;
 
   std::vector<edm::InputTag> recHitLabels_;
@@ -245,9 +250,9 @@ void HLTRecHitInAllL1RegionsProducer<RecHitType>::produce(edm::Event& event, con
   }  //end loop over all rec hit collections
 }
 
-template <typename RecHitType>
-L1RegionDataBase* HLTRecHitInAllL1RegionsProducer<RecHitType>::createL1RegionData(
-    const std::string& type, const edm::ParameterSet& para, edm::ConsumesCollector&& consumesColl) {
+L1RegionDataBase* createL1RegionData(const std::string& type,
+                                     const edm::ParameterSet& para,
+                                     edm::ConsumesCollector&& consumesColl) {
   if (type == "L1EmParticle") {
     return new L1RegionData<l1extra::L1EmParticleCollection>(para, consumesColl);
   } else if (type == "L1JetParticle") {
@@ -353,3 +358,155 @@ typedef HLTRecHitInAllL1RegionsProducer<EcalRecHit> HLTEcalRecHitInAllL1RegionsP
 DEFINE_FWK_MODULE(HLTEcalRecHitInAllL1RegionsProducer);
 typedef HLTRecHitInAllL1RegionsProducer<EcalUncalibratedRecHit> HLTEcalUncalibratedRecHitInAllL1RegionsProducer;
 DEFINE_FWK_MODULE(HLTEcalUncalibratedRecHitInAllL1RegionsProducer);
+
+//keeps the ECAL digis of the trigger towers (barrel) and super crystals (endcap) with a crystal in one of the L1
+//regions, so that the uncalibrated and calibrated rec-hits downstream are only made around the L1 seeds
+class HLTEcalDigiInAllL1RegionsProducer : public edm::stream::EDProducer<> {
+public:
+  HLTEcalDigiInAllL1RegionsProducer(const edm::ParameterSet& ps);
+  ~HLTEcalDigiInAllL1RegionsProducer() override {}
+
+  void produce(edm::Event&, const edm::EventSetup&) override;
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  template <typename DetIdType, typename DigiCollectionType>
+  void selectDigis(const DigiCollectionType& digis,
+                   const std::vector<RectangularEtaPhiRegion>& regions,
+                   const std::vector<std::pair<float, float>>& etaPhi,
+                   std::vector<uint8_t>& towers,
+                   DigiCollectionType& selectedDigis) const;
+
+  static int towerIndex(const EBDetId& id) { return id.tower().hashedIndex(); }
+  static int towerIndex(const EEDetId& id) { return id.sc().hashedIndex(); }
+
+  std::vector<std::unique_ptr<L1RegionDataBase>> l1RegionData_;
+
+  edm::EDGetTokenT<EBDigiCollection> ebDigisToken_;
+  edm::EDGetTokenT<EEDigiCollection> eeDigisToken_;
+
+  //the eta and phi of the crystals by hashed index, made again when the geometry changes
+  edm::ESWatcher<CaloGeometryRecord> caloGeometryWatcher_;
+  std::vector<std::pair<float, float>> ebEtaPhi_;
+  std::vector<std::pair<float, float>> eeEtaPhi_;
+
+  //the towers of the event by hashed index, set once one of their crystals is found in a region
+  std::vector<uint8_t> ebTowers_;
+  std::vector<uint8_t> eeTowers_;
+};
+
+HLTEcalDigiInAllL1RegionsProducer::HLTEcalDigiInAllL1RegionsProducer(const edm::ParameterSet& para)
+    : ebDigisToken_(consumes<EBDigiCollection>(para.getParameter<edm::InputTag>("ebDigis"))),
+      eeDigisToken_(consumes<EEDigiCollection>(para.getParameter<edm::InputTag>("eeDigis"))),
+      ebTowers_(EcalTrigTowerDetId::kSizeForDenseIndexing),
+      eeTowers_(EcalScDetId::kSizeForDenseIndexing) {
+  const std::vector<edm::ParameterSet> l1InputRegions =
+      para.getParameter<std::vector<edm::ParameterSet>>("l1InputRegions");
+  for (auto& pset : l1InputRegions) {
+    const std::string type = pset.getParameter<std::string>("type");
+    l1RegionData_.emplace_back(createL1RegionData(type, pset, consumesCollector()));
+  }
+  produces<EBDigiCollection>("ebDigis");
+  produces<EEDigiCollection>("eeDigis");
+}
+
+void HLTEcalDigiInAllL1RegionsProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("ebDigis", edm::InputTag("hltEcalDigis", "ebDigis"));
+  desc.add<edm::InputTag>("eeDigis", edm::InputTag("hltEcalDigis", "eeDigis"));
+
+  std::vector<edm::ParameterSet> l1InputRegions;
+  edm::ParameterSet egPSet;
+  egPSet.addParameter<std::string>("type", "EGamma");
+  egPSet.addParameter<double>("minEt", 5);
+  egPSet.addParameter<double>("maxEt", 999);
+  egPSet.addParameter<double>("regionEtaMargin", 0.4);
+  egPSet.addParameter<double>("regionPhiMargin", 0.5);
+  egPSet.addParameter<edm::InputTag>("inputColl", edm::InputTag("hltCaloStage2Digis"));
+  l1InputRegions.push_back(egPSet);
+
+  edm::ParameterSetDescription l1InputRegionDesc;
+  l1InputRegionDesc.add<std::string>("type");
+  l1InputRegionDesc.add<double>("minEt");
+  l1InputRegionDesc.add<double>("maxEt");
+  l1InputRegionDesc.add<double>("regionEtaMargin");
+  l1InputRegionDesc.add<double>("regionPhiMargin");
+  l1InputRegionDesc.add<edm::InputTag>("inputColl");
+  desc.addVPSet("l1InputRegions", l1InputRegionDesc, l1InputRegions);
+
+  descriptions.add("hltEcalDigiInAllL1RegionsProducer", desc);
+}
+
+void HLTEcalDigiInAllL1RegionsProducer::produce(edm::Event& event, const edm::EventSetup& setup) {
+  if (caloGeometryWatcher_.check(setup)) {
+    edm::ESHandle<CaloGeometry> caloGeomHandle;
+    setup.get<CaloGeometryRecord>().get(caloGeomHandle);
+
+    const CaloSubdetectorGeometry* ebGeom = caloGeomHandle->getSubdetectorGeometry(DetId::Ecal, EcalBarrel);
+    ebEtaPhi_.resize(EBDetId::kSizeForDenseIndexing);
+    for (uint32_t i = 0; i < ebEtaPhi_.size(); i++) {
+      auto cell = ebGeom->getGeometry(EBDetId::detIdFromDenseIndex(i));
+      ebEtaPhi_[i] = cell ? std::make_pair(cell->etaPos(), cell->phiPos()) : std::make_pair(999.f, 999.f);
+    }
+    const CaloSubdetectorGeometry* eeGeom = caloGeomHandle->getSubdetectorGeometry(DetId::Ecal, EcalEndcap);
+    eeEtaPhi_.resize(EEDetId::kSizeForDenseIndexing);
+    for (uint32_t i = 0; i < eeEtaPhi_.size(); i++) {
+      auto cell = eeGeom->getGeometry(EEDetId::detIdFromDenseIndex(i));
+      eeEtaPhi_[i] = cell ? std::make_pair(cell->etaPos(), cell->phiPos()) : std::make_pair(999.f, 999.f);
+    }
+  }
+
+  edm::ESHandle<L1CaloGeometry> l1CaloGeom;
+  setup.get<L1CaloGeometryRecord>().get(l1CaloGeom);
+
+  std::vector<RectangularEtaPhiRegion> regions;
+  for (auto const& input : l1RegionData_) {
+    input->getEtaPhiRegions(event, regions, *l1CaloGeom);
+  }
+
+  const auto& ebDigis = event.get(ebDigisToken_);
+  auto selectedEBDigis = std::make_unique<EBDigiCollection>(ebDigis.stride());
+  selectDigis<EBDetId>(ebDigis, regions, ebEtaPhi_, ebTowers_, *selectedEBDigis);
+  event.put(std::move(selectedEBDigis), "ebDigis");
+
+  const auto& eeDigis = event.get(eeDigisToken_);
+  auto selectedEEDigis = std::make_unique<EEDigiCollection>(eeDigis.stride());
+  selectDigis<EEDetId>(eeDigis, regions, eeEtaPhi_, eeTowers_, *selectedEEDigis);
+  event.put(std::move(selectedEEDigis), "eeDigis");
+}
+
+template <typename DetIdType, typename DigiCollectionType>
+void HLTEcalDigiInAllL1RegionsProducer::selectDigis(const DigiCollectionType& digis,
+                                                    const std::vector<RectangularEtaPhiRegion>& regions,
+                                                    const std::vector<std::pair<float, float>>& etaPhi,
+                                                    std::vector<uint8_t>& towers,
+                                                    DigiCollectionType& selectedDigis) const {
+  if (regions.empty()) {
+    return;
+  }
+
+  //a tower is selected by its first crystal in a region, the other crystals of the tower are not checked
+  std::fill(towers.begin(), towers.end(), 0);
+  for (auto const& digi : digis) {
+    DetIdType id(digi.id());
+    auto& tower = towers[towerIndex(id)];
+    if (tower) {
+      continue;
+    }
+    const auto& crystal = etaPhi[id.hashedIndex()];
+    for (const auto& region : regions) {
+      if (region.inRegion(crystal.first, crystal.second)) {
+        tower = 1;
+        break;
+      }
+    }
+  }
+
+  for (auto const& digi : digis) {
+    if (towers[towerIndex(DetIdType(digi.id()))]) {
+      selectedDigis.push_back(digi.id(), digi.begin());
+    }
+  }
+}
+
+DEFINE_FWK_MODULE(HLTEcalDigiInAllL1RegionsProducer);
@@ -3,7 +3,10 @@
 #ifndef RecoHGCal_TICL_GlobalCache_H__
 #define RecoHGCal_TICL_GlobalCache_H__
 
+#include <memory>
+
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "PhysicsTools/TensorFlow/interface/BatchedSession.h"
 #include "PhysicsTools/TensorFlow/interface/TensorFlow.h"
 
 namespace ticl {
@@ -23,6 +26,8 @@ namespace ticl {
     ~TrackstersCache() override {}
 
     std::atomic<tensorflow::GraphDef*> eidGraphDef;
+    // the session which runs the inference of the tracksters of all the streams in batches, when set
+    std::unique_ptr<tensorflow::BatchedSession> eidBatchedSession;
   };
 }  // namespace ticl
 
@@ -1,11 +1,86 @@
 #include "HGCDoublet.h"
 
-bool HGCDoublet::checkCompatibilityAndTag(std::vector<HGCDoublet> &allDoublets,
-                                          const std::vector<int> &innerDoublets,
-                                          const GlobalVector &refDir,
-                                          float minCosTheta,
-                                          float minCosPointing,
-                                          bool debug) {
+unsigned int HGCDoublets::add(int innerClusterId,
+                              int outerClusterId,
+                              const std::vector<reco::CaloCluster> &layerClusters,
+                              int seedIndex) {
+  unsigned int id = size();
+  if (id == 0)
+    innerNeighborOffsets_.assign(1, 0);
+  innerClusterId_.push_back(innerClusterId);
+  outerClusterId_.push_back(outerClusterId);
+  innerX_.push_back(layerClusters[innerClusterId].x());
+  outerX_.push_back(layerClusters[outerClusterId].x());
+  innerY_.push_back(layerClusters[innerClusterId].y());
+  outerY_.push_back(layerClusters[outerClusterId].y());
+  innerZ_.push_back(layerClusters[innerClusterId].z());
+  outerZ_.push_back(layerClusters[outerClusterId].z());
+  seedIndex_.push_back(seedIndex);
+  innerNeighborOffsets_.push_back(innerNeighbors_.size());
+  return id;
+}
+
+void HGCDoublets::append(const HGCDoublets &other) {
+  if (other.size() == 0)
+    return;
+  unsigned int shift = size();
+  if (shift == 0)
+    innerNeighborOffsets_.assign(1, 0);
+  auto copy = [](auto &to, const auto &from) { to.insert(to.end(), from.begin(), from.end()); };
+  copy(innerClusterId_, other.innerClusterId_);
+  copy(outerClusterId_, other.outerClusterId_);
+  copy(innerX_, other.innerX_);
+  copy(outerX_, other.outerX_);
+  copy(innerY_, other.innerY_);
+  copy(outerY_, other.outerY_);
+  copy(innerZ_, other.innerZ_);
+  copy(outerZ_, other.outerZ_);
+  copy(seedIndex_, other.seedIndex_);
+  unsigned int neighborShift = innerNeighbors_.size();
+  for (unsigned int id = 1; id < other.innerNeighborOffsets_.size(); ++id)
+    innerNeighborOffsets_.push_back(other.innerNeighborOffsets_[id] + neighborShift);
+  for (auto neighbor : other.innerNeighbors_)
+    innerNeighbors_.push_back(neighbor + shift);
+}
+
+void HGCDoublets::clear() {
+  innerClusterId_.clear();
+  outerClusterId_.clear();
+  innerX_.clear();
+  outerX_.clear();
+  innerY_.clear();
+  outerY_.clear();
+  innerZ_.clear();
+  outerZ_.clear();
+  seedIndex_.clear();
+  alreadyVisited_.clear();
+  innerNeighborOffsets_.clear();
+  innerNeighbors_.clear();
+  outerNeighborOffsets_.clear();
+  outerNeighbors_.clear();
+}
+
+void HGCDoublets::connect() {
+  // count the outer neighbours of each doublet, then fill them in the order of the doublet ids
+  unsigned int nDoublets = size();
+  outerNeighborOffsets_.assign(nDoublets + 1, 0);
+  for (auto neighbor : innerNeighbors_)
+    ++outerNeighborOffsets_[neighbor + 1];
+  for (unsigned int id = 0; id < nDoublets; ++id)
+    outerNeighborOffsets_[id + 1] += outerNeighborOffsets_[id];
+  outerNeighbors_.resize(innerNeighbors_.size());
+  std::vector<unsigned int> fill(outerNeighborOffsets_.begin(), outerNeighborOffsets_.end() - 1);
+  for (unsigned int id = 0; id < nDoublets; ++id)
+    for (unsigned int i = innerNeighborOffsets_[id]; i < innerNeighborOffsets_[id + 1]; ++i)
+      outerNeighbors_[fill[innerNeighbors_[i]]++] = id;
+  alreadyVisited_.assign(nDoublets, 0);
+}
+
+bool HGCDoublets::checkCompatibilityAndTag(const std::vector<int> &innerDoublets,
+                                           const GlobalVector &refDir,
+                                           float minCosTheta,
+                                           float minCosPointing,
+                                           bool debug) {
   int nDoublets = innerDoublets.size();
   int constexpr VSIZE = 4;
   int ok[VSIZE];
@@ -13,37 +88,33 @@ bool HGCDoublet::checkCompatibilityAndTag(std::vector<HGCDoublet> &allDoublets,
   double yi[VSIZE];
   double zi[VSIZE];
   int seedi[VSIZE];
-  auto xo = outerX();
-  auto yo = outerY();
-  auto zo = outerZ();
-  unsigned int doubletId = theDoubletId_;
+  unsigned int doubletId = size() - 1;
+  auto xo = outerX(doubletId);
+  auto yo = outerY(doubletId);
+  auto zo = outerZ(doubletId);
+  auto thisSeedIndex = seedIndex(doubletId);
 
   auto loop = [&](int i, int vs) {
     for (int j = 0; j < vs; ++j) {
       auto otherDoubletId = innerDoublets[i + j];
-      auto &otherDoublet = allDoublets[otherDoubletId];
-      xi[j] = otherDoublet.innerX();
-      yi[j] = otherDoublet.innerY();
-      zi[j] = otherDoublet.innerZ();
-      seedi[j] = otherDoublet.seedIndex();
+      xi[j] = innerX(otherDoubletId);
+      yi[j] = innerY(otherDoubletId);
+      zi[j] = innerZ(otherDoubletId);
+      seedi[j] = seedIndex(otherDoubletId);
     }
     for (int j = 0; j < vs; ++j) {
-      if (seedi[j] != seedIndex_) {
+      if (seedi[j] != thisSeedIndex) {
         ok[j] = 0;
         continue;
       }
-      ok[j] = areAligned(xi[j], yi[j], zi[j], xo, yo, zo, minCosTheta, minCosPointing, refDir, debug);
+      ok[j] = areAligned(doubletId, xi[j], yi[j], zi[j], xo, yo, zo, minCosTheta, minCosPointing, refDir, debug);
       if (debug) {
         LogDebug("HGCDoublet") << "Are aligned for InnerDoubletId: " << i + j << " is " << ok[j] << std::endl;
       }
     }
     for (int j = 0; j < vs; ++j) {
-      auto otherDoubletId = innerDoublets[i + j];
-      auto &otherDoublet = allDoublets[otherDoubletId];
-      if (ok[j]) {
-        otherDoublet.tagAsOuterNeighbor(doubletId);
-        allDoublets[doubletId].tagAsInnerNeighbor(otherDoubletId);
-      }
+      if (ok[j])
+        innerNeighbors_.push_back(innerDoublets[i + j]);
     }
   };
   auto lim = VSIZE * (nDoublets / VSIZE);
@@ -51,30 +122,33 @@ bool HGCDoublet::checkCompatibilityAndTag(std::vector<HGCDoublet> &allDoublets,
     loop(i, VSIZE);
   loop(lim, nDoublets - lim);
 
+  auto nInnerNeighbors = innerNeighbors_.size() - innerNeighborOffsets_[doubletId];
+  innerNeighborOffsets_.back() = innerNeighbors_.size();
   if (debug) {
-    LogDebug("HGCDoublet") << "Found " << innerNeighbors_.size() << " compatible doublets out of " << nDoublets
+    LogDebug("HGCDoublet") << "Found " << nInnerNeighbors << " compatible doublets out of " << nDoublets
                            << " considered" << std::endl;
   }
-  return innerNeighbors_.empty();
+  return nInnerNeighbors == 0;
 }
 
-int HGCDoublet::areAligned(double xi,
-                           double yi,
-                           double zi,
-                           double xo,
-                           double yo,
-                           double zo,
-                           float minCosTheta,
-                           float minCosPointing,
-                           const GlobalVector &refDir,
-                           bool debug) const {
+int HGCDoublets::areAligned(unsigned int id,
+                            double xi,
+                            double yi,
+                            double zi,
+                            double xo,
+                            double yo,
+                            double zo,
+                            float minCosTheta,
+                            float minCosPointing,
+                            const GlobalVector &refDir,
+                            bool debug) const {
   auto dx1 = xo - xi;
   auto dy1 = yo - yi;
   auto dz1 = zo - zi;
 
-  auto dx2 = innerX() - xi;
-  auto dy2 = innerY() - yi;
-  auto dz2 = innerZ() - zi;
+  auto dx2 = innerX(id) - xi;
+  auto dy2 = innerY(id) - yi;
+  auto dz2 = innerZ(id) - zi;
 
   // inner product
   auto dot = dx1 * dx2 + dy1 * dy2 + dz1 * dz2;
@@ -96,7 +170,7 @@ int HGCDoublet::areAligned(double xi,
   // the doublets themeselves
 
   const GlobalVector firstDoublet(dx2, dy2, dz2);
-  const GlobalVector pointingDir = (seedIndex_ == -1) ? GlobalVector(innerX(), innerY(), innerZ()) : refDir;
+  const GlobalVector pointingDir = (seedIndex(id) == -1) ? GlobalVector(innerX(id), innerY(id), innerZ(id)) : refDir;
 
   auto dot_pointing = pointingDir.dot(firstDoublet);
   auto mag_pointing = sqrt(pointingDir.mag2());
@@ -110,24 +184,22 @@ int HGCDoublet::areAligned(double xi,
   return (cosTheta > minCosTheta) && (cosTheta_pointing > minCosPointing);
 }
 
-void HGCDoublet::findNtuplets(std::vector<HGCDoublet> &allDoublets,
-                              HGCntuplet &tmpNtuplet,
-                              int seedIndex,
-                              const bool outInDFS,
-                              const unsigned int outInHops,
-                              const unsigned int maxOutInHops,
-                              std::vector<std::pair<unsigned int, unsigned int> > &outInToVisit) {
-  if (!alreadyVisited_ && seedIndex == seedIndex_) {
-    alreadyVisited_ = true;
-    tmpNtuplet.push_back(theDoubletId_);
-    unsigned int numberOfOuterNeighbors = outerNeighbors_.size();
-    for (unsigned int i = 0; i < numberOfOuterNeighbors; ++i) {
-      allDoublets[outerNeighbors_[i]].findNtuplets(
-          allDoublets, tmpNtuplet, seedIndex, outInDFS, outInHops, maxOutInHops, outInToVisit);
+void HGCDoublets::findNtuplets(unsigned int id,
+                               HGCntuplet &tmpNtuplet,
+                               int seedIndex,
+                               const bool outInDFS,
+                               const unsigned int outInHops,
+                               const unsigned int maxOutInHops,
+                               std::vector<std::pair<unsigned int, unsigned int> > &outInToVisit) {
+  if (!alreadyVisited_[id] && seedIndex == seedIndex_[id]) {
+    alreadyVisited_[id] = 1;
+    tmpNtuplet.push_back(id);
+    for (unsigned int i = outerNeighborOffsets_[id]; i < outerNeighborOffsets_[id + 1]; ++i) {
+      findNtuplets(outerNeighbors_[i], tmpNtuplet, seedIndex, outInDFS, outInHops, maxOutInHops, outInToVisit);
     }
     if (outInDFS && outInHops < maxOutInHops) {
-      for (auto inN : innerNeighbors_) {
-        outInToVisit.emplace_back(inN, outInHops + 1);
+      for (unsigned int i = innerNeighborOffsets_[id]; i < innerNeighborOffsets_[id + 1]; ++i) {
+        outInToVisit.emplace_back(innerNeighbors_[i], outInHops + 1);
       }
     }
   }
@@ -5,70 +5,64 @@
 #define __RecoHGCal_TICL_HGCDoublet_H__
 
 #include <cmath>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/CaloRecHit/interface/CaloCluster.h"
 #include "DataFormats/HGCalReco/interface/TICLSeedingRegion.h"
 
-class HGCDoublet {
+// The doublets of layer clusters of a HGCGraph, as a structure of arrays
+// indexed by the doublet id. The inner neighbours of a doublet, the ones
+// aligned with it on its inner cluster, are found when it is added and
+// stored one after the other in a pool; the outer neighbours are the
+// inverse links, built by connect() once all the doublets are added.
+class HGCDoublets {
 public:
   using HGCntuplet = std::vector<unsigned int>;
 
-  HGCDoublet(const int innerClusterId,
-             const int outerClusterId,
-             const int doubletId,
-             const std::vector<reco::CaloCluster> *layerClusters,
-             const int seedIndex)
-      : layerClusters_(layerClusters),
-        theDoubletId_(doubletId),
-        innerClusterId_(innerClusterId),
-        outerClusterId_(outerClusterId),
-        innerR_((*layerClusters)[innerClusterId].position().r()),
-        outerR_((*layerClusters)[outerClusterId].position().r()),
-        innerX_((*layerClusters)[innerClusterId].x()),
-        outerX_((*layerClusters)[outerClusterId].x()),
-        innerY_((*layerClusters)[innerClusterId].y()),
-        outerY_((*layerClusters)[outerClusterId].y()),
-        innerZ_((*layerClusters)[innerClusterId].z()),
-        outerZ_((*layerClusters)[outerClusterId].z()),
-        seedIndex_(seedIndex),
-        alreadyVisited_(false) {}
+  unsigned int size() const { return innerClusterId_.size(); }
 
-  double innerX() const { return innerX_; }
+  // Adds a doublet, and returns its id
+  unsigned int add(int innerClusterId,
+                   int outerClusterId,
+                   const std::vector<reco::CaloCluster> &layerClusters,
+                   int seedIndex);
 
-  double outerX() const { return outerX_; }
+  // Appends the doublets of other, with their ids shifted by size()
+  void append(const HGCDoublets &other);
 
-  double innerY() const { return innerY_; }
+  void clear();
 
-  double outerY() const { return outerY_; }
+  double innerX(unsigned int id) const { return innerX_[id]; }
 
-  double innerZ() const { return innerZ_; }
+  double outerX(unsigned int id) const { return outerX_[id]; }
 
-  double outerZ() const { return outerZ_; }
+  double innerY(unsigned int id) const { return innerY_[id]; }
 
-  double innerR() const { return innerR_; }
+  double outerY(unsigned int id) const { return outerY_[id]; }
 
-  double outerR() const { return outerZ_; }
+  double innerZ(unsigned int id) const { return innerZ_[id]; }
 
-  int seedIndex() const { return seedIndex_; }
+  double outerZ(unsigned int id) const { return outerZ_[id]; }
 
-  int innerClusterId() const { return innerClusterId_; }
+  int seedIndex(unsigned int id) const { return seedIndex_[id]; }
 
-  int outerClusterId() const { return outerClusterId_; }
+  int innerClusterId(unsigned int id) const { return innerClusterId_[id]; }
 
-  void tagAsOuterNeighbor(unsigned int otherDoublet) { outerNeighbors_.push_back(otherDoublet); }
+  int outerClusterId(unsigned int id) const { return outerClusterId_[id]; }
 
-  void tagAsInnerNeighbor(unsigned int otherDoublet) { innerNeighbors_.push_back(otherDoublet); }
-
-  bool checkCompatibilityAndTag(std::vector<HGCDoublet> &allDoublets,
-                                const std::vector<int> &innerDoublets,
+  // Tags as inner neighbours of the last doublet added the ones of
+  // innerDoublets which it is aligned with, and returns if there is none
+  bool checkCompatibilityAndTag(const std::vector<int> &innerDoublets,
                                 const GlobalVector &refDir,
                                 float minCosTheta,
                                 float minCosPointing = 1.,
                                 bool debug = false);
 
-  int areAligned(double xi,
+  int areAligned(unsigned int id,
+                 double xi,
                  double yi,
                  double zi,
                  double xo,
@@ -79,7 +73,10 @@ public:
                  const GlobalVector &refDir,
                  bool debug = false) const;
 
-  void findNtuplets(std::vector<HGCDoublet> &allDoublets,
+  // Builds the outer neighbours of all the doublets, in the order of their ids, and clears the visited flags
+  void connect();
+
+  void findNtuplets(unsigned int id,
                     HGCntuplet &tmpNtuplet,
                     int seedIndex,
                     const bool outInDFS,
@@ -87,27 +84,23 @@ public:
                     const unsigned int maxOutInHops,
                     std::vector<std::pair<unsigned int, unsigned int> > &outInToVisit);
 
-  void setVisited(bool visited) { alreadyVisited_ = visited; }
-
 private:
-  const std::vector<reco::CaloCluster> *layerClusters_;
-  std::vector<int> outerNeighbors_;
-  std::vector<int> innerNeighbors_;
-
-  const int theDoubletId_;
-  const int innerClusterId_;
-  const int outerClusterId_;
-
-  const double innerR_;
-  const double outerR_;
-  const double innerX_;
-  const double outerX_;
-  const double innerY_;
-  const double outerY_;
-  const double innerZ_;
-  const double outerZ_;
-  int seedIndex_;
-  bool alreadyVisited_;
+  std::vector<int> innerClusterId_;
+  std::vector<int> outerClusterId_;
+  std::vector<double> innerX_;
+  std::vector<double> outerX_;
+  std::vector<double> innerY_;
+  std::vector<double> outerY_;
+  std::vector<double> innerZ_;
+  std::vector<double> outerZ_;
+  std::vector<int> seedIndex_;
+  std::vector<uint8_t> alreadyVisited_;  // not packed, the regions are visited in parallel
+
+  // the neighbours of the doublet id are at [offsets[id], offsets[id + 1]) in the pool
+  std::vector<unsigned int> innerNeighborOffsets_;
+  std::vector<unsigned int> innerNeighbors_;
+  std::vector<unsigned int> outerNeighborOffsets_;
+  std::vector<unsigned int> outerNeighbors_;
 };
 
 #endif /*HGCDoublet_H_ */
@@ -7,6 +7,9 @@
 #include "HGCGraph.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 void HGCGraph::makeAndConnectDoublets(const TICLLayerTiles &histo,
                                       const std::vector<TICLSeedingRegion> &regions,
                                       int nEtaBins,
@@ -21,92 +24,155 @@ void HGCGraph::makeAndConnectDoublets(const TICLLayerTiles &histo,
                                       int missing_layers,
                                       int maxNumberOfLayers,
                                       float maxDeltaTime) {
-  isOuterClusterOfDoublets_.clear();
-  isOuterClusterOfDoublets_.resize(layerClusters.size());
   allDoublets_.clear();
   theRootDoublets_.clear();
-  for (const auto &r : regions) {
-    bool isGlobal = (r.index == -1);
-    auto zSide = r.zSide;
-    int startEtaBin, endEtaBin, startPhiBin, endPhiBin;
-
-    if (isGlobal) {
-      startEtaBin = 0;
-      startPhiBin = 0;
-      endEtaBin = nEtaBins;
-      endPhiBin = nPhiBins;
-    } else {
-      auto firstLayerOnZSide = maxNumberOfLayers * zSide;
-      const auto &firstLayerHisto = histo[firstLayerOnZSide];
-
-      int entryEtaBin = firstLayerHisto.etaBin(r.origin.eta());
-      int entryPhiBin = firstLayerHisto.phiBin(r.origin.phi());
-      startEtaBin = std::max(entryEtaBin - deltaIEta, 0);
-      endEtaBin = std::min(entryEtaBin + deltaIEta + 1, nEtaBins);
-      startPhiBin = entryPhiBin - deltaIPhi;
-      endPhiBin = entryPhiBin + deltaIPhi + 1;
-    }
+  regionRootOffsets_.assign(1, 0);
+  // the graphs of the regions keep their storage from one event to the other
+  if (regionGraphs_.size() < regions.size())
+    regionGraphs_.resize(regions.size());
+
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(size_t(0), regions.size(), [&](size_t i) {
+      auto &links = clusterLinks_.local();
+      if (links.isOuterClusterOfDoublets.size() < layerClusters.size())
+        links.isOuterClusterOfDoublets.resize(layerClusters.size());
+      makeAndConnectRegionDoublets(histo,
+                                   regions[i],
+                                   nEtaBins,
+                                   nPhiBins,
+                                   layerClusters,
+                                   mask,
+                                   layerClustersTime,
+                                   deltaIEta,
+                                   deltaIPhi,
+                                   minCosTheta,
+                                   minCosPointing,
+                                   missing_layers,
+                                   maxNumberOfLayers,
+                                   maxDeltaTime,
+                                   regionGraphs_[i],
+                                   links);
+      for (auto c : links.touchedClusters)
+        links.isOuterClusterOfDoublets[c].clear();
+      links.touchedClusters.clear();
+    });
+  });
+
+  // the doublets of the regions one after the other give the ids of the sequential processing of the regions
+  for (size_t i = 0; i < regions.size(); ++i) {
+    const auto &graph = regionGraphs_[i];
+    auto firstDoubletId = allDoublets_.size();
+    allDoublets_.append(graph.doublets);
+    for (auto rootDoublet : graph.rootDoublets)
+      theRootDoublets_.push_back(rootDoublet + firstDoubletId);
+    regionRootOffsets_.push_back(theRootDoublets_.size());
+  }
+  allDoublets_.connect();
+
+  // #ifdef FP_DEBUG
+  if (verbosity_ > None) {
+    LogDebug("HGCGraph") << "number of Root doublets " << theRootDoublets_.size() << " over a total number of doublets "
+                         << allDoublets_.size() << std::endl;
+  }
+  // #endif
+}
+
+void HGCGraph::makeAndConnectRegionDoublets(const TICLLayerTiles &histo,
+                                            const TICLSeedingRegion &r,
+                                            int nEtaBins,
+                                            int nPhiBins,
+                                            const std::vector<reco::CaloCluster> &layerClusters,
+                                            const std::vector<float> &mask,
+                                            const edm::ValueMap<std::pair<float, float>> &layerClustersTime,
+                                            int deltaIEta,
+                                            int deltaIPhi,
+                                            float minCosTheta,
+                                            float minCosPointing,
+                                            int missing_layers,
+                                            int maxNumberOfLayers,
+                                            float maxDeltaTime,
+                                            RegionGraph &graph,
+                                            ClusterLinks &links) const {
+  auto &doublets = graph.doublets;
+  doublets.clear();
+  graph.rootDoublets.clear();
+  bool isGlobal = (r.index == -1);
+  auto zSide = r.zSide;
+  int startEtaBin, endEtaBin, startPhiBin, endPhiBin;
+
+  if (isGlobal) {
+    startEtaBin = 0;
+    startPhiBin = 0;
+    endEtaBin = nEtaBins;
+    endPhiBin = nPhiBins;
+  } else {
+    auto firstLayerOnZSide = maxNumberOfLayers * zSide;
+    const auto &firstLayerHisto = histo[firstLayerOnZSide];
+
+    int entryEtaBin = firstLayerHisto.etaBin(r.origin.eta());
+    int entryPhiBin = firstLayerHisto.phiBin(r.origin.phi());
+    startEtaBin = std::max(entryEtaBin - deltaIEta, 0);
+    endEtaBin = std::min(entryEtaBin + deltaIEta + 1, nEtaBins);
+    startPhiBin = entryPhiBin - deltaIPhi;
+    endPhiBin = entryPhiBin + deltaIPhi + 1;
+  }
+
+  for (int il = 0; il < maxNumberOfLayers - 1; ++il) {
+    for (int outer_layer = 0; outer_layer < std::min(1 + missing_layers, maxNumberOfLayers - 1 - il); ++outer_layer) {
+      int currentInnerLayerId = il + maxNumberOfLayers * zSide;
+      int currentOuterLayerId = currentInnerLayerId + 1 + outer_layer;
+      auto const &outerLayerHisto = histo[currentOuterLayerId];
+      auto const &innerLayerHisto = histo[currentInnerLayerId];
 
-    for (int il = 0; il < maxNumberOfLayers - 1; ++il) {
-      for (int outer_layer = 0; outer_layer < std::min(1 + missing_layers, maxNumberOfLayers - 1 - il); ++outer_layer) {
-        int currentInnerLayerId = il + maxNumberOfLayers * zSide;
-        int currentOuterLayerId = currentInnerLayerId + 1 + outer_layer;
-        auto const &outerLayerHisto = histo[currentOuterLayerId];
-        auto const &innerLayerHisto = histo[currentInnerLayerId];
-
-        for (int ieta = startEtaBin; ieta < endEtaBin; ++ieta) {
-          auto offset = ieta * nPhiBins;
-          for (int iphi_it = startPhiBin; iphi_it < endPhiBin; ++iphi_it) {
-            int iphi = ((iphi_it % nPhiBins + nPhiBins) % nPhiBins);
-            for (auto innerClusterId : innerLayerHisto[offset + iphi]) {
-              // Skip masked clusters
-              if (mask[innerClusterId] == 0.)
-                continue;
-              const auto etaRangeMin = std::max(0, ieta - deltaIEta);
-              const auto etaRangeMax = std::min(ieta + deltaIEta + 1, nEtaBins);
-
-              for (int oeta = etaRangeMin; oeta < etaRangeMax; ++oeta) {
-                // wrap phi bin
-                for (int phiRange = 0; phiRange < 2 * deltaIPhi + 1; ++phiRange) {
-                  // The first wrapping is to take into account the
-                  // cases in which we would have to seach in
-                  // negative bins. The second wrap is mandatory to
-                  // account for all other cases, since we add in
-                  // between a full nPhiBins slot.
-                  auto ophi = ((iphi + phiRange - deltaIPhi) % nPhiBins + nPhiBins) % nPhiBins;
-                  for (auto outerClusterId : outerLayerHisto[oeta * nPhiBins + ophi]) {
-                    // Skip masked clusters
-                    if (mask[outerClusterId] == 0.)
-                      continue;
-                    auto doubletId = allDoublets_.size();
-                    if (maxDeltaTime != -1 &&
-                        !areTimeCompatible(innerClusterId, outerClusterId, layerClustersTime, maxDeltaTime))
-                      continue;
-                    allDoublets_.emplace_back(innerClusterId, outerClusterId, doubletId, &layerClusters, r.index);
-                    if (verbosity_ > Advanced) {
-                      LogDebug("HGCGraph")
-                          << "Creating doubletsId: " << doubletId << " layerLink in-out: [" << currentInnerLayerId
-                          << ", " << currentOuterLayerId << "] clusterLink in-out: [" << innerClusterId << ", "
-                          << outerClusterId << "]" << std::endl;
-                    }
-                    isOuterClusterOfDoublets_[outerClusterId].push_back(doubletId);
-                    auto &neigDoublets = isOuterClusterOfDoublets_[innerClusterId];
-                    auto &thisDoublet = allDoublets_[doubletId];
-                    if (verbosity_ > Expert) {
-                      LogDebug("HGCGraph")
-                          << "Checking compatibility of doubletId: " << doubletId
-                          << " with all possible inners doublets link by the innerClusterId: " << innerClusterId
-                          << std::endl;
-                    }
-                    bool isRootDoublet = thisDoublet.checkCompatibilityAndTag(allDoublets_,
-                                                                              neigDoublets,
-                                                                              r.directionAtOrigin,
-                                                                              minCosTheta,
-                                                                              minCosPointing,
-                                                                              verbosity_ > Advanced);
-                    if (isRootDoublet)
-                      theRootDoublets_.push_back(doubletId);
+      for (int ieta = startEtaBin; ieta < endEtaBin; ++ieta) {
+        auto offset = ieta * nPhiBins;
+        for (int iphi_it = startPhiBin; iphi_it < endPhiBin; ++iphi_it) {
+          int iphi = ((iphi_it % nPhiBins + nPhiBins) % nPhiBins);
+          for (auto innerClusterId : innerLayerHisto[offset + iphi]) {
+            // Skip masked clusters
+            if (mask[innerClusterId] == 0.)
+              continue;
+            const auto etaRangeMin = std::max(0, ieta - deltaIEta);
+            const auto etaRangeMax = std::min(ieta + deltaIEta + 1, nEtaBins);
+
+            for (int oeta = etaRangeMin; oeta < etaRangeMax; ++oeta) {
+              // wrap phi bin
+              for (int phiRange = 0; phiRange < 2 * deltaIPhi + 1; ++phiRange) {
+                // The first wrapping is to take into account the
+                // cases in which we would have to seach in
+                // negative bins. The second wrap is mandatory to
+                // account for all other cases, since we add in
+                // between a full nPhiBins slot.
+                auto ophi = ((iphi + phiRange - deltaIPhi) % nPhiBins + nPhiBins) % nPhiBins;
+                for (auto outerClusterId : outerLayerHisto[oeta * nPhiBins + ophi]) {
+                  // Skip masked clusters
+                  if (mask[outerClusterId] == 0.)
+                    continue;
+                  if (maxDeltaTime != -1 &&
+                      !areTimeCompatible(innerClusterId, outerClusterId, layerClustersTime, maxDeltaTime))
+                    continue;
+                  auto doubletId = doublets.add(innerClusterId, outerClusterId, layerClusters, r.index);
+                  if (verbosity_ > Advanced) {
+                    LogDebug("HGCGraph")
+                        << "Creating doubletsId: " << doubletId << " layerLink in-out: [" << currentInnerLayerId
+                        << ", " << currentOuterLayerId << "] clusterLink in-out: [" << innerClusterId << ", "
+                        << outerClusterId << "]" << std::endl;
+                  }
+                  auto &outerDoublets = links.isOuterClusterOfDoublets[outerClusterId];
+                  if (outerDoublets.empty())
+                    links.touchedClusters.push_back(outerClusterId);
+                  outerDoublets.push_back(doubletId);
+                  auto &neigDoublets = links.isOuterClusterOfDoublets[innerClusterId];
+                  if (verbosity_ > Expert) {
+                    LogDebug("HGCGraph")
+                        << "Checking compatibility of doubletId: " << doubletId
+                        << " with all possible inners doublets link by the innerClusterId: " << innerClusterId
+                        << std::endl;
                   }
+                  bool isRootDoublet = doublets.checkCompatibilityAndTag(
+                      neigDoublets, r.directionAtOrigin, minCosTheta, minCosPointing, verbosity_ > Advanced);
+                  if (isRootDoublet)
+                    graph.rootDoublets.push_back(doubletId);
                 }
               }
             }
@@ -115,18 +181,12 @@ void HGCGraph::makeAndConnectDoublets(const TICLLayerTiles &histo,
       }
     }
   }
-  // #ifdef FP_DEBUG
-  if (verbosity_ > None) {
-    LogDebug("HGCGraph") << "number of Root doublets " << theRootDoublets_.size() << " over a total number of doublets "
-                         << allDoublets_.size() << std::endl;
-  }
-  // #endif
 }
 
 bool HGCGraph::areTimeCompatible(int innerIdx,
                                  int outerIdx,
                                  const edm::ValueMap<std::pair<float, float>> &layerClustersTime,
-                                 float maxDeltaTime) {
+                                 float maxDeltaTime) const {
   float timeIn = layerClustersTime.get(innerIdx).first;
   float timeInE = layerClustersTime.get(innerIdx).second;
   float timeOut = layerClustersTime.get(outerIdx).first;
@@ -137,30 +197,50 @@ bool HGCGraph::areTimeCompatible(int innerIdx,
 }
 
 //also return a vector of seedIndex for the reconstructed tracksters
-void HGCGraph::findNtuplets(std::vector<HGCDoublet::HGCntuplet> &foundNtuplets,
+void HGCGraph::findNtuplets(std::vector<HGCDoublets::HGCntuplet> &foundNtuplets,
                             std::vector<int> &seedIndices,
                             const unsigned int minClustersPerNtuplet,
                             const bool outInDFS,
                             unsigned int maxOutInHops) {
-  HGCDoublet::HGCntuplet tmpNtuplet;
-  tmpNtuplet.reserve(minClustersPerNtuplet);
-  std::vector<std::pair<unsigned int, unsigned int>> outInToVisit;
-  for (auto rootDoublet : theRootDoublets_) {
-    tmpNtuplet.clear();
-    outInToVisit.clear();
-    int seedIndex = allDoublets_[rootDoublet].seedIndex();
-    int outInHops = 0;
-    allDoublets_[rootDoublet].findNtuplets(
-        allDoublets_, tmpNtuplet, seedIndex, outInDFS, outInHops, maxOutInHops, outInToVisit);
-    while (!outInToVisit.empty()) {
-      allDoublets_[outInToVisit.back().first].findNtuplets(
-          allDoublets_, tmpNtuplet, seedIndex, outInDFS, outInToVisit.back().second, maxOutInHops, outInToVisit);
-      outInToVisit.pop_back();
-    }
+  const size_t nRegions = regionRootOffsets_.empty() ? 0 : regionRootOffsets_.size() - 1;
+  // the doublets visited from the roots of a region are those of the region only
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(size_t(0), nRegions, [&](size_t i) {
+      auto &graph = regionGraphs_[i];
+      graph.ntuplets.clear();
+      graph.seedIndices.clear();
+      HGCDoublets::HGCntuplet tmpNtuplet;
+      tmpNtuplet.reserve(minClustersPerNtuplet);
+      std::vector<std::pair<unsigned int, unsigned int>> outInToVisit;
+      for (auto r = regionRootOffsets_[i]; r < regionRootOffsets_[i + 1]; ++r) {
+        auto rootDoublet = theRootDoublets_[r];
+        tmpNtuplet.clear();
+        outInToVisit.clear();
+        int seedIndex = allDoublets_.seedIndex(rootDoublet);
+        int outInHops = 0;
+        allDoublets_.findNtuplets(rootDoublet, tmpNtuplet, seedIndex, outInDFS, outInHops, maxOutInHops, outInToVisit);
+        while (!outInToVisit.empty()) {
+          allDoublets_.findNtuplets(outInToVisit.back().first,
+                                    tmpNtuplet,
+                                    seedIndex,
+                                    outInDFS,
+                                    outInToVisit.back().second,
+                                    maxOutInHops,
+                                    outInToVisit);
+          outInToVisit.pop_back();
+        }
 
-    if (tmpNtuplet.size() > minClustersPerNtuplet) {
-      foundNtuplets.push_back(tmpNtuplet);
-      seedIndices.push_back(seedIndex);
-    }
+        if (tmpNtuplet.size() > minClustersPerNtuplet) {
+          graph.ntuplets.push_back(tmpNtuplet);
+          graph.seedIndices.push_back(seedIndex);
+        }
+      }
+    });
+  });
+
+  for (size_t i = 0; i < nRegions; ++i) {
+    const auto &graph = regionGraphs_[i];
+    foundNtuplets.insert(foundNtuplets.end(), graph.ntuplets.begin(), graph.ntuplets.end());
+    seedIndices.insert(seedIndices.end(), graph.seedIndices.begin(), graph.seedIndices.end());
   }
 }
@@ -6,6 +6,8 @@
 
 #include <vector>
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include "DataFormats/HGCalReco/interface/Common.h"
 #include "DataFormats/HGCalReco/interface/TICLLayerTile.h"
 #include "DataFormats/HGCalReco/interface/TICLSeedingRegion.h"
@@ -31,10 +33,10 @@ public:
   bool areTimeCompatible(int innerIdx,
                          int outerIdx,
                          const edm::ValueMap<std::pair<float, float>> &layerClustersTime,
-                         float maxDeltaTime);
+                         float maxDeltaTime) const;
 
-  std::vector<HGCDoublet> &getAllDoublets() { return allDoublets_; }
-  void findNtuplets(std::vector<HGCDoublet::HGCntuplet> &foundNtuplets,
+  const HGCDoublets &getAllDoublets() const { return allDoublets_; }
+  void findNtuplets(std::vector<HGCDoublets::HGCntuplet> &foundNtuplets,
                     std::vector<int> &seedIndices,
                     const unsigned int minClustersPerNtuplet,
                     const bool outInDFS,
@@ -42,17 +44,52 @@ public:
   void clear() {
     allDoublets_.clear();
     theRootDoublets_.clear();
-    theNtuplets_.clear();
-    isOuterClusterOfDoublets_.clear();
+    regionRootOffsets_.clear();
   }
   void setVerbosity(int level) { verbosity_ = level; }
   enum VerbosityLevel { None = 0, Basic, Advanced, Expert, Guru };
 
 private:
-  std::vector<HGCDoublet> allDoublets_;
+  // The doublets and the root doublets of a seeding region, with the ids of the doublets of the region
+  struct RegionGraph {
+    HGCDoublets doublets;
+    std::vector<unsigned int> rootDoublets;
+    std::vector<HGCDoublets::HGCntuplet> ntuplets;
+    std::vector<int> seedIndices;
+  };
+
+  // The doublets of a region by outer cluster, kept by each thread between the regions and the events. Only the
+  // clusters of touchedClusters have doublets.
+  struct ClusterLinks {
+    std::vector<std::vector<int>> isOuterClusterOfDoublets;
+    std::vector<int> touchedClusters;
+  };
+
+  void makeAndConnectRegionDoublets(const TICLLayerTiles &histo,
+                                    const TICLSeedingRegion &r,
+                                    int nEtaBins,
+                                    int nPhiBins,
+                                    const std::vector<reco::CaloCluster> &layerClusters,
+                                    const std::vector<float> &mask,
+                                    const edm::ValueMap<std::pair<float, float>> &layerClustersTime,
+                                    int deltaIEta,
+                                    int deltaIPhi,
+                                    float minCosTheta,
+                                    float minCosPointing,
+                                    int missing_layers,
+                                    int maxNumberOfLayers,
+                                    float maxDeltaTime,
+                                    RegionGraph &graph,
+                                    ClusterLinks &links) const;
+
+  // the doublets of all the regions, with the ids of the regions one after the other
+  HGCDoublets allDoublets_;
   std::vector<unsigned int> theRootDoublets_;
-  std::vector<std::vector<HGCDoublet *>> theNtuplets_;
-  std::vector<std::vector<int>> isOuterClusterOfDoublets_;
+  // the root doublets of the region i are at [regionRootOffsets_[i], regionRootOffsets_[i + 1])
+  std::vector<unsigned int> regionRootOffsets_;
+  // the regions are independent, as the doublets of a region are only linked with those of the same seed
+  std::vector<RegionGraph> regionGraphs_;
+  tbb::enumerable_thread_specific<ClusterLinks> clusterLinks_;
   int verbosity_;
 };
 
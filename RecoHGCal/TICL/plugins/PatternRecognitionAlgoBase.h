@@ -11,6 +11,7 @@
 #include "DataFormats/HGCalReco/interface/Trackster.h"
 #include "DataFormats/HGCalReco/interface/TICLLayerTile.h"
 #include "DataFormats/HGCalReco/interface/TICLSeedingRegion.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "RecoHGCal/TICL/plugins/GlobalCache.h"
@@ -48,6 +49,15 @@ namespace ticl {
 
     virtual void makeTracksters(const Inputs& input, std::vector<Trackster>& result) = 0;
 
+    // makes the tracksters, holding waitingTask while parts of them are made asynchronously, and
+    // finishes them once waitingTask is done
+    virtual void makeTrackstersAsync(const Inputs& input,
+                                     std::vector<Trackster>& result,
+                                     edm::WaitingTaskWithArenaHolder waitingTask) {
+      makeTracksters(input, result);
+    }
+    virtual void finishTracksters(std::vector<Trackster>& result) {}
+
     enum VerbosityLevel { None = 0, Basic, Advanced, Expert, Guru };
 
   protected:
@@ -28,7 +28,9 @@ PatternRecognitionbyCA::PatternRecognitionbyCA(const edm::ParameterSet &conf, co
       eidMinClusterEnergy_(conf.getParameter<double>("eid_min_cluster_energy")),
       eidNLayers_(conf.getParameter<int>("eid_n_layers")),
       eidNClusters_(conf.getParameter<int>("eid_n_clusters")),
-      eidSession_(nullptr) {
+      eidSession_(nullptr),
+      eidBatchedSession_(nullptr),
+      eidRequestPending_(false) {
   // mount the tensorflow graph onto the session when set
   const TrackstersCache *trackstersCache = dynamic_cast<const TrackstersCache *>(cache);
   if (trackstersCache == nullptr || trackstersCache->eidGraphDef == nullptr) {
@@ -36,12 +38,57 @@ PatternRecognitionbyCA::PatternRecognitionbyCA(const edm::ParameterSet &conf, co
         << "PatternRecognitionbyCA received an empty graph definition from the global cache";
   }
   eidSession_ = tensorflow::createSession(trackstersCache->eidGraphDef);
+  eidBatchedSession_ = trackstersCache->eidBatchedSession.get();
 }
 
 PatternRecognitionbyCA::~PatternRecognitionbyCA(){};
 
 void PatternRecognitionbyCA::makeTracksters(const PatternRecognitionAlgoBase::Inputs &input,
                                             std::vector<Trackster> &result) {
+  buildTracksters(input, result);
+
+  // run energy regression and ID
+  energyRegressionAndID(input.layerClusters, result);
+}
+
+void PatternRecognitionbyCA::makeTrackstersAsync(const PatternRecognitionAlgoBase::Inputs &input,
+                                                 std::vector<Trackster> &result,
+                                                 edm::WaitingTaskWithArenaHolder waitingTask) {
+  if (eidBatchedSession_ == nullptr) {
+    makeTracksters(input, result);
+    return;
+  }
+  buildTracksters(input, result);
+
+  // the inference of the tracksters is run with those of the other streams
+  int batchSize = selectEnergyRegressionAndID(input.layerClusters, result);
+  if (batchSize == 0) {
+    return;
+  }
+  eidRequest_.nRows = batchSize;
+  eidRequest_.input.resize(batchSize * eidBatchedSession_->rowSize());
+  fillEnergyRegressionAndIDInput(input.layerClusters, result, eidRequest_.input.data());
+  eidRequest_.done = [holder = std::move(waitingTask)](std::exception_ptr exception) mutable {
+    holder.doneWaiting(exception);
+  };
+  eidRequestPending_ = true;
+  eidBatchedSession_->submit(&eidRequest_);
+}
+
+void PatternRecognitionbyCA::finishTracksters(std::vector<Trackster> &result) {
+  if (!eidRequestPending_) {
+    return;
+  }
+  eidRequestPending_ = false;
+  const auto &outputs = eidRequest_.outputs;
+  int probsIdx = eidOutputNameEnergy_.empty() ? 0 : 1;
+  assignEnergyRegressionAndID(result,
+                              eidOutputNameEnergy_.empty() ? nullptr : outputs[0].data(),
+                              eidOutputNameId_.empty() ? nullptr : outputs[probsIdx].data());
+}
+
+void PatternRecognitionbyCA::buildTracksters(const PatternRecognitionAlgoBase::Inputs &input,
+                                             std::vector<Trackster> &result) {
   rhtools_.getEventSetup(input.es);
 
   theGraph_->setVerbosity(algo_verbosity_);
@@ -49,7 +96,7 @@ void PatternRecognitionbyCA::makeTracksters(const PatternRecognitionAlgoBase::In
   if (algo_verbosity_ > None) {
     LogDebug("HGCPatterRecoByCA") << "Making Tracksters with CA" << std::endl;
   }
-  std::vector<HGCDoublet::HGCntuplet> foundNtuplets;
+  std::vector<HGCDoublets::HGCntuplet> foundNtuplets;
   std::vector<int> seedIndices;
   std::vector<uint8_t> layer_cluster_usage(input.layerClusters.size(), 0);
   theGraph_->makeAndConnectDoublets(input.tiles,
@@ -80,8 +127,8 @@ void PatternRecognitionbyCA::makeTracksters(const PatternRecognitionAlgoBase::In
     std::vector<float> timeErrors;
 
     for (auto const &doublet : ntuplet) {
-      auto innerCluster = doublets[doublet].innerClusterId();
-      auto outerCluster = doublets[doublet].outerClusterId();
+      auto innerCluster = doublets.innerClusterId(doublet);
+      auto outerCluster = doublets.outerClusterId(doublet);
 
       retVal = effective_cluster_idx.insert(innerCluster);
       if (retVal.second) {
@@ -142,9 +189,6 @@ void PatternRecognitionbyCA::makeTracksters(const PatternRecognitionAlgoBase::In
                                     << " count: " << (int)trackster.vertex_multiplicity[i] << std::endl;
     }
   }
-
-  // run energy regression and ID
-  energyRegressionAndID(input.layerClusters, result);
 }
 
 void PatternRecognitionbyCA::energyRegressionAndID(const std::vector<reco::CaloCluster> &layerClusters,
@@ -170,9 +214,45 @@ void PatternRecognitionbyCA::energyRegressionAndID(const std::vector<reco::CaloC
   // k -> cluster
   // l -> feature
 
+  int batchSize = selectEnergyRegressionAndID(layerClusters, tracksters);
+
+  // do nothing when no trackster passes the selection (3)
+  if (batchSize == 0) {
+    return;
+  }
+
+  // create input and output tensors (4)
+  tensorflow::TensorShape shape({batchSize, eidNLayers_, eidNClusters_, eidNFeatures_});
+  tensorflow::Tensor input(tensorflow::DT_FLOAT, shape);
+  tensorflow::NamedTensorList inputList = {{eidInputName_, input}};
+
+  std::vector<tensorflow::Tensor> outputs;
+  std::vector<std::string> outputNames;
+  if (!eidOutputNameEnergy_.empty()) {
+    outputNames.push_back(eidOutputNameEnergy_);
+  }
+  if (!eidOutputNameId_.empty()) {
+    outputNames.push_back(eidOutputNameId_);
+  }
+
+  // fill input tensor (5)
+  fillEnergyRegressionAndIDInput(layerClusters, tracksters, input.flat<float>().data());
+
+  // run the inference (7)
+  tensorflow::run(eidSession_, inputList, outputNames, &outputs);
+
+  // store regressed energy and id probabilities per trackster (8)
+  int probsIdx = eidOutputNameEnergy_.empty() ? 0 : 1;
+  assignEnergyRegressionAndID(tracksters,
+                              eidOutputNameEnergy_.empty() ? nullptr : outputs[0].flat<float>().data(),
+                              eidOutputNameId_.empty() ? nullptr : outputs[probsIdx].flat<float>().data());
+}
+
+int PatternRecognitionbyCA::selectEnergyRegressionAndID(const std::vector<reco::CaloCluster> &layerClusters,
+                                                        std::vector<Trackster> &tracksters) {
   // set default values per trackster, determine if the cluster energy threshold is passed,
   // and store indices of hard tracksters
-  std::vector<int> tracksterIndices;
+  tracksterIndices_.clear();
   for (int i = 0; i < (int)tracksters.size(); i++) {
     // set default values (1)
     tracksters[i].regressed_energy = 0.;
@@ -188,35 +268,21 @@ void PatternRecognitionbyCA::energyRegressionAndID(const std::vector<reco::CaloC
       sumClusterEnergy += (float)layerClusters[vertex].energy();
       // there might be many clusters, so try to stop early
       if (sumClusterEnergy >= eidMinClusterEnergy_) {
-        tracksterIndices.push_back(i);
+        tracksterIndices_.push_back(i);
         break;
       }
     }
   }
 
-  // do nothing when no trackster passes the selection (3)
-  int batchSize = (int)tracksterIndices.size();
-  if (batchSize == 0) {
-    return;
-  }
-
-  // create input and output tensors (4)
-  tensorflow::TensorShape shape({batchSize, eidNLayers_, eidNClusters_, eidNFeatures_});
-  tensorflow::Tensor input(tensorflow::DT_FLOAT, shape);
-  tensorflow::NamedTensorList inputList = {{eidInputName_, input}};
-
-  std::vector<tensorflow::Tensor> outputs;
-  std::vector<std::string> outputNames;
-  if (!eidOutputNameEnergy_.empty()) {
-    outputNames.push_back(eidOutputNameEnergy_);
-  }
-  if (!eidOutputNameId_.empty()) {
-    outputNames.push_back(eidOutputNameId_);
-  }
+  return tracksterIndices_.size();
+}
 
+void PatternRecognitionbyCA::fillEnergyRegressionAndIDInput(const std::vector<reco::CaloCluster> &layerClusters,
+                                                            const std::vector<Trackster> &tracksters,
+                                                            float *input) const {
   // fill input tensor (5)
-  for (int i = 0; i < batchSize; i++) {
-    const Trackster &trackster = tracksters[tracksterIndices[i]];
+  for (int i = 0; i < (int)tracksterIndices_.size(); i++) {
+    const Trackster &trackster = tracksters[tracksterIndices_[i]];
 
     // per layer, we only consider the first eidNClusters_ clusters in terms of energy, so in order
     // to avoid creating large / nested structures to do the sorting for an unknown number of total
@@ -239,7 +305,7 @@ void PatternRecognitionbyCA::energyRegressionAndID(const std::vector<reco::CaloC
       int j = rhtools_.getLayerWithOffset(cluster.hitsAndFractions()[0].first) - 1;
       if (j < eidNLayers_ && seenClusters[j] < eidNClusters_) {
         // get the pointer to the first feature value for the current batch, layer and cluster
-        float *features = &input.tensor<float, 4>()(i, j, seenClusters[j], 0);
+        float *features = &input[((i * eidNLayers_ + j) * eidNClusters_ + seenClusters[j]) * eidNFeatures_];
 
         // fill features
         *(features++) = float(std::abs(cluster.eta()));
@@ -254,34 +320,30 @@ void PatternRecognitionbyCA::energyRegressionAndID(const std::vector<reco::CaloC
     // zero-fill features of empty clusters in each layer (6)
     for (int j = 0; j < eidNLayers_; j++) {
       for (int k = seenClusters[j]; k < eidNClusters_; k++) {
-        float *features = &input.tensor<float, 4>()(i, j, k, 0);
+        float *features = &input[((i * eidNLayers_ + j) * eidNClusters_ + k) * eidNFeatures_];
         for (int l = 0; l < eidNFeatures_; l++) {
           *(features++) = 0.f;
         }
       }
     }
   }
+}
 
-  // run the inference (7)
-  tensorflow::run(eidSession_, inputList, outputNames, &outputs);
-
+void PatternRecognitionbyCA::assignEnergyRegressionAndID(std::vector<Trackster> &tracksters,
+                                                         const float *energy,
+                                                         const float *probs) const {
   // store regressed energy per trackster (8)
-  if (!eidOutputNameEnergy_.empty()) {
-    // get the pointer to the energy tensor, dimension is batch x 1
-    float *energy = outputs[0].flat<float>().data();
-
-    for (const int &i : tracksterIndices) {
+  if (energy != nullptr) {
+    // the energy tensor has dimension batch x 1
+    for (const int &i : tracksterIndices_) {
       tracksters[i].regressed_energy = *(energy++);
     }
   }
 
   // store id probabilities per trackster (8)
-  if (!eidOutputNameId_.empty()) {
-    // get the pointer to the id probability tensor, dimension is batch x id_probabilities.size()
-    int probsIdx = eidOutputNameEnergy_.empty() ? 0 : 1;
-    float *probs = outputs[probsIdx].flat<float>().data();
-
-    for (const int &i : tracksterIndices) {
+  if (probs != nullptr) {
+    // the id probability tensor has dimension batch x id_probabilities.size()
+    for (const int &i : tracksterIndices_) {
       for (float &p : tracksters[i].id_probabilities) {
         p = *(probs++);
       }
@@ -6,6 +6,7 @@
 #include <memory>  // unique_ptr
 #include "RecoHGCal/TICL/plugins/PatternRecognitionAlgoBase.h"
 #include "RecoLocalCalo/HGCalRecAlgos/interface/RecHitTools.h"
+#include "PhysicsTools/TensorFlow/interface/BatchedSession.h"
 #include "PhysicsTools/TensorFlow/interface/TensorFlow.h"
 
 class HGCGraph;
@@ -18,9 +19,30 @@ namespace ticl {
 
     void makeTracksters(const PatternRecognitionAlgoBase::Inputs& input, std::vector<Trackster>& result) override;
 
+    void makeTrackstersAsync(const PatternRecognitionAlgoBase::Inputs& input,
+                             std::vector<Trackster>& result,
+                             edm::WaitingTaskWithArenaHolder waitingTask) override;
+
+    void finishTracksters(std::vector<Trackster>& result) override;
+
     void energyRegressionAndID(const std::vector<reco::CaloCluster>& layerClusters, std::vector<Trackster>& result);
 
+    static const int eidNFeatures_ = 3;
+
   private:
+    void buildTracksters(const PatternRecognitionAlgoBase::Inputs& input, std::vector<Trackster>& result);
+
+    // sets the default energy and id of the tracksters, and selects those for the inference
+    int selectEnergyRegressionAndID(const std::vector<reco::CaloCluster>& layerClusters,
+                                    std::vector<Trackster>& tracksters);
+    // fills the input of the selected tracksters, of shape batch x eidNLayers_ x eidNClusters_ x eidNFeatures_
+    void fillEnergyRegressionAndIDInput(const std::vector<reco::CaloCluster>& layerClusters,
+                                        const std::vector<Trackster>& tracksters,
+                                        float* input) const;
+    void assignEnergyRegressionAndID(std::vector<Trackster>& tracksters,
+                                     const float* energy,
+                                     const float* probs) const;
+
     const std::unique_ptr<HGCGraph> theGraph_;
     const bool out_in_dfs_;
     const unsigned int max_out_in_hops_;
@@ -38,8 +60,12 @@ namespace ticl {
 
     hgcal::RecHitTools rhtools_;
     tensorflow::Session* eidSession_;
+    tensorflow::BatchedSession* eidBatchedSession_;
 
-    static const int eidNFeatures_ = 3;
+    // the selected tracksters and the request of the event to the batched session
+    std::vector<int> tracksterIndices_;
+    tensorflow::BatchedSession::Request eidRequest_;
+    bool eidRequestPending_;
   };
 }  // namespace ticl
 #endif
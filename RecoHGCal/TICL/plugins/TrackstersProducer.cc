@@ -2,6 +2,7 @@
 // Date: 09/2018
 
 // user include files
+#include <chrono>
 #include <vector>
 
 #include "FWCore/Framework/interface/ESHandle.h"
@@ -29,12 +30,13 @@
 
 using namespace ticl;
 
-class TrackstersProducer : public edm::stream::EDProducer<edm::GlobalCache<TrackstersCache>> {
+class TrackstersProducer : public edm::stream::EDProducer<edm::GlobalCache<TrackstersCache>, edm::ExternalWork> {
 public:
   explicit TrackstersProducer(const edm::ParameterSet&, const TrackstersCache*);
   ~TrackstersProducer() override {}
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
 
+  void acquire(const edm::Event&, const edm::EventSetup&, edm::WaitingTaskWithArenaHolder) override;
   void produce(edm::Event&, const edm::EventSetup&) override;
 
   // static methods for handling the global cache
@@ -50,6 +52,9 @@ private:
   edm::EDGetTokenT<std::vector<TICLSeedingRegion>> seeding_regions_token_;
 
   std::unique_ptr<PatternRecognitionAlgoBase> myAlgo_;
+
+  // the tracksters of the event, between acquire and produce
+  std::unique_ptr<std::vector<Trackster>> result_;
 };
 DEFINE_FWK_MODULE(TrackstersProducer);
 
@@ -62,12 +67,34 @@ std::unique_ptr<TrackstersCache> TrackstersProducer::initializeGlobalCache(const
   if (!graphPath.empty()) {
     graphPath = edm::FileInPath(graphPath).fullPath();
     cache->eidGraphDef = tensorflow::loadGraphDef(graphPath);
+
+    // the tracksters of all the streams are given to one session, which runs them in batches
+    int batchSize = params.getParameter<int>("eid_batch_size");
+    if (batchSize > 0) {
+      std::vector<std::string> outputNames;
+      for (auto const& name : {params.getParameter<std::string>("eid_output_name_energy"),
+                               params.getParameter<std::string>("eid_output_name_id")}) {
+        if (!name.empty()) {
+          outputNames.push_back(name);
+        }
+      }
+      cache->eidBatchedSession = std::make_unique<tensorflow::BatchedSession>(
+          cache->eidGraphDef,
+          params.getParameter<std::string>("eid_input_name"),
+          std::vector<tensorflow::int64>{params.getParameter<int>("eid_n_layers"),
+                                         params.getParameter<int>("eid_n_clusters"),
+                                         PatternRecognitionbyCA::eidNFeatures_},
+          outputNames,
+          batchSize,
+          std::chrono::microseconds(params.getParameter<int>("eid_batch_max_latency")));
+    }
   }
 
   return cache;
 }
 
 void TrackstersProducer::globalEndJob(TrackstersCache* cache) {
+  cache->eidBatchedSession.reset();
   delete cache->eidGraphDef;
   cache->eidGraphDef = nullptr;
 }
@@ -110,23 +137,25 @@ void TrackstersProducer::fillDescriptions(edm::ConfigurationDescriptions& descri
   desc.add<double>("eid_min_cluster_energy", 1.);
   desc.add<int>("eid_n_layers", 50);
   desc.add<int>("eid_n_clusters", 10);
+  // the tracksters of all the streams are run in batches of eid_batch_size, or after eid_batch_max_latency us
+  desc.add<int>("eid_batch_size", 0);
+  desc.add<int>("eid_batch_max_latency", 1000);
   descriptions.add("trackstersProducer", desc);
 }
 
-void TrackstersProducer::produce(edm::Event& evt, const edm::EventSetup& es) {
-  auto result = std::make_unique<std::vector<Trackster>>();
-  auto output_mask = std::make_unique<std::vector<float>>();
+void TrackstersProducer::acquire(const edm::Event& evt,
+                                 const edm::EventSetup& es,
+                                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  result_ = std::make_unique<std::vector<Trackster>>();
 
   edm::Handle<std::vector<reco::CaloCluster>> cluster_h;
   edm::Handle<std::vector<float>> filtered_layerclusters_mask_h;
-  edm::Handle<std::vector<float>> original_layerclusters_mask_h;
   edm::Handle<edm::ValueMap<std::pair<float, float>>> time_clusters_h;
   edm::Handle<TICLLayerTiles> layer_clusters_tiles_h;
   edm::Handle<std::vector<TICLSeedingRegion>> seeding_regions_h;
 
   evt.getByToken(clusters_token_, cluster_h);
   evt.getByToken(filtered_layerclusters_mask_token_, filtered_layerclusters_mask_h);
-  evt.getByToken(original_layerclusters_mask_token_, original_layerclusters_mask_h);
   evt.getByToken(clustersTime_token_, time_clusters_h);
   evt.getByToken(layer_clusters_tiles_token_, layer_clusters_tiles_h);
   evt.getByToken(seeding_regions_token_, seeding_regions_h);
@@ -138,7 +167,16 @@ void TrackstersProducer::produce(edm::Event& evt, const edm::EventSetup& es) {
   const auto& seeding_regions = *seeding_regions_h;
   const ticl::PatternRecognitionAlgoBase::Inputs input(
       evt, es, layerClusters, inputClusterMask, layerClustersTimes, layer_clusters_tiles, seeding_regions);
-  myAlgo_->makeTracksters(input, *result);
+  myAlgo_->makeTrackstersAsync(input, *result_, std::move(waitingTaskHolder));
+}
+
+void TrackstersProducer::produce(edm::Event& evt, const edm::EventSetup& es) {
+  auto result = std::move(result_);
+  myAlgo_->finishTracksters(*result);
+  auto output_mask = std::make_unique<std::vector<float>>();
+
+  edm::Handle<std::vector<float>> original_layerclusters_mask_h;
+  evt.getByToken(original_layerclusters_mask_token_, original_layerclusters_mask_h);
 
   // Now update the global mask and put it into the event
   output_mask->reserve(original_layerclusters_mask_h->size());
@@ -47,6 +47,9 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+
+// TBB includes
+#include <tbb/parallel_for.h>
 //#include <fstream>
 
 using namespace std;
@@ -210,7 +213,9 @@ void FastjetJetProducer::produceTrackJets(edm::Event& iEvent, const edm::EventSe
   // define the overall output jet container
   auto jets = std::make_unique<std::vector<reco::TrackJet>>();
 
-  // loop over the good vertices, clustering for each vertex separately
+  // loop over the good vertices, selecting the tracks of each vertex in turn: a track
+  // goes to the first vertex it is selected for
+  unsigned int nClusterings = 0;
   for (reco::VertexCollection::const_iterator itVtx = pvCollection->begin(); itVtx != pvCollection->end(); ++itVtx) {
     if (itVtx->isFake() || itVtx->ndof() < minVtxNdof_ || fabs(itVtx->z()) > maxVtxZ_)
       continue;
@@ -290,35 +295,73 @@ void FastjetJetProducer::produceTrackJets(edm::Event& iEvent, const edm::EventSe
     inputTowers();
     LogDebug("FastjetTrackJetProducer") << "Inputted towers\n";
 
-    // run algorithm, using fjInputs_, modifying fjJets_ and allocating fjClusterSeq_
-    runAlgorithm(iEvent, iSetup);
-    LogDebug("FastjetTrackJetProducer") << "Ran algorithm\n";
+    // keep the inputs of the vertex, the containers swapped in are cleared for the next one
+    if (nClusterings == vertexClusterings_.size())
+      vertexClusterings_.emplace_back();
+    auto& clustering = vertexClusterings_[nClusterings++];
+    clustering.vertex = itVtx - pvCollection->begin();
+    clustering.inputs.swap(inputs_);
+    clustering.fjInputs.swap(fjInputs_);
+
+    if (useOnlyOnePV_)
+      break;  // stop vertex loop if only one vertex asked for
+  }           // end loop over vertices
+
+  // the vertices are clustered independently: in parallel without grooming or areas, whose
+  // random ghosts would depend on the order of the clusterings, with runAlgorithm otherwise
+  if (!useGrooming() && !doAreaFastjet_ && !doRhoFastjet_) {
+    tbb::parallel_for(0u, nClusterings, [this](unsigned int i) {
+      auto& clustering = vertexClusterings_[i];
+      clustering.fjClusterSeq = makeClusterSequence(clustering.fjInputs);
+      clustering.fjJets = fastjet::sorted_by_pt(clustering.fjClusterSeq->inclusive_jets(jetPtMin_));
+    });
+  } else {
+    for (unsigned int i = 0; i < nClusterings; ++i) {
+      auto& clustering = vertexClusterings_[i];
+      // run algorithm, using fjInputs_, modifying fjJets_ and allocating fjClusterSeq_
+      fjInputs_.swap(clustering.fjInputs);
+      runAlgorithm(iEvent, iSetup);
+      fjInputs_.swap(clustering.fjInputs);
+      clustering.fjJets.swap(fjJets_);
+      clustering.fjClusterSeq = fjClusterSeq_;
+    }
+  }
+  LogDebug("FastjetTrackJetProducer") << "Ran algorithm\n";
+
+  for (unsigned int i = 0; i < nClusterings; ++i) {
+    auto& clustering = vertexClusterings_[i];
+    auto const& vertex = (*pvCollection)[clustering.vertex];
+    // the constituents are found in inputs_
+    inputs_.swap(clustering.inputs);
 
     // convert our jets and add to the overall jet vector
-    for (unsigned int ijet = 0; ijet < fjJets_.size(); ++ijet) {
+    for (auto const& fjJet : clustering.fjJets) {
       // get the constituents from fastjet
-      std::vector<fastjet::PseudoJet> fjConstituents = sorted_by_pt(fjClusterSeq_->constituents(fjJets_[ijet]));
+      std::vector<fastjet::PseudoJet> fjConstituents = sorted_by_pt(clustering.fjClusterSeq->constituents(fjJet));
       // convert them to CandidatePtr vector
       std::vector<reco::CandidatePtr> constituents = getConstituents(fjConstituents);
       // fill the trackjet
       reco::TrackJet jet;
       // write the specifics to the jet (simultaneously sets 4-vector, vertex).
-      writeSpecific(
-          jet,
-          reco::Particle::LorentzVector(fjJets_[ijet].px(), fjJets_[ijet].py(), fjJets_[ijet].pz(), fjJets_[ijet].E()),
-          vertex_,
-          constituents,
-          iSetup);
+      writeSpecific(jet,
+                    reco::Particle::LorentzVector(fjJet.px(), fjJet.py(), fjJet.pz(), fjJet.E()),
+                    vertex_,
+                    constituents,
+                    iSetup);
       jet.setJetArea(0);
       jet.setPileup(0);
-      jet.setPrimaryVertex(edm::Ref<reco::VertexCollection>(pvCollection, (int)(itVtx - pvCollection->begin())));
-      jet.setVertex(itVtx->position());
+      jet.setPrimaryVertex(edm::Ref<reco::VertexCollection>(pvCollection, clustering.vertex));
+      jet.setVertex(vertex.position());
       jets->push_back(jet);
     }
 
-    if (useOnlyOnePV_)
-      break;  // stop vertex loop if only one vertex asked for
-  }           // end loop over vertices
+    inputs_.swap(clustering.inputs);
+    clustering.inputs.clear();
+    clustering.fjInputs.clear();
+    clustering.fjJets.clear();
+    // the cluster sequences retain a lot of memory, see produce()
+    clustering.fjClusterSeq.reset();
+  }
 
   // put the jets in the collection
   LogDebug("FastjetTrackJetProducer") << "Put " << jets->size() << " jets in the event.\n";
@@ -332,6 +375,19 @@ void FastjetJetProducer::produceTrackJets(edm::Event& iEvent, const edm::EventSe
   decltype(inputs_)().swap(inputs_);
 }
 
+//______________________________________________________________________________
+FastjetJetProducer::ClusterSequencePtr FastjetJetProducer::makeClusterSequence(
+    const std::vector<fastjet::PseudoJet>& inputs) const {
+  if (!doAreaFastjet_ && !doRhoFastjet_) {
+    return ClusterSequencePtr(new fastjet::ClusterSequence(inputs, *fjJetDefinition_));
+  } else if (voronoiRfact_ <= 0) {
+    return ClusterSequencePtr(new fastjet::ClusterSequenceArea(inputs, *fjJetDefinition_, *fjAreaDefinition_));
+  } else {
+    return ClusterSequencePtr(
+        new fastjet::ClusterSequenceVoronoiArea(inputs, *fjJetDefinition_, fastjet::VoronoiAreaSpec(voronoiRfact_)));
+  }
+}
+
 //______________________________________________________________________________
 void FastjetJetProducer::runAlgorithm(edm::Event& iEvent, edm::EventSetup const& iSetup) {
   // run algorithm
@@ -354,18 +410,9 @@ void FastjetJetProducer::runAlgorithm(edm::Event& iEvent, edm::EventSetup const&
   fin.close();
   */
 
-  if (!doAreaFastjet_ && !doRhoFastjet_) {
-    fjClusterSeq_ = ClusterSequencePtr(new fastjet::ClusterSequence(fjInputs_, *fjJetDefinition_));
-  } else if (voronoiRfact_ <= 0) {
-    fjClusterSeq_ =
-        ClusterSequencePtr(new fastjet::ClusterSequenceArea(fjInputs_, *fjJetDefinition_, *fjAreaDefinition_));
-  } else {
-    fjClusterSeq_ = ClusterSequencePtr(
-        new fastjet::ClusterSequenceVoronoiArea(fjInputs_, *fjJetDefinition_, fastjet::VoronoiAreaSpec(voronoiRfact_)));
-  }
+  fjClusterSeq_ = makeClusterSequence(fjInputs_);
 
-  if (!(useMassDropTagger_ || useCMSBoostedTauSeedingAlgorithm_ || useTrimming_ || useFiltering_ || usePruning_ ||
-        useSoftDrop_ || useConstituentSubtraction_)) {
+  if (!useGrooming()) {
     fjJets_ = fastjet::sorted_by_pt(fjClusterSeq_->inclusive_jets(jetPtMin_));
   } else {
     fjJets_.clear();
@@ -65,6 +65,13 @@ protected:
   virtual void produceTrackJets(edm::Event& iEvent, const edm::EventSetup& iSetup);
   void runAlgorithm(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
 
+  // the cluster sequence of runAlgorithm, without touching the members
+  ClusterSequencePtr makeClusterSequence(const std::vector<fastjet::PseudoJet>& inputs) const;
+  bool useGrooming() const {
+    return useMassDropTagger_ || useCMSBoostedTauSeedingAlgorithm_ || useTrimming_ || useFiltering_ || usePruning_ ||
+           useSoftDrop_ || useConstituentSubtraction_;
+  }
+
 private:
   // trackjet clustering parameters
   bool useOnlyVertexTracks_;
@@ -112,6 +119,16 @@ private:
 
   // tokens for the data access
   edm::EDGetTokenT<edm::View<reco::RecoChargedRefCandidate> > input_chrefcand_token_;
+
+  // the track jets of a vertex: kept from one event to the next, for the vectors to keep their capacity
+  struct VertexClustering {
+    unsigned int vertex;
+    std::vector<edm::Ptr<reco::Candidate> > inputs;
+    std::vector<fastjet::PseudoJet> fjInputs;
+    std::vector<fastjet::PseudoJet> fjJets;
+    ClusterSequencePtr fjClusterSeq;
+  };
+  std::vector<VertexClustering> vertexClusterings_;
 };
 
 #endif
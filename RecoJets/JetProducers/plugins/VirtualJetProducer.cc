@@ -66,6 +66,30 @@ namespace reco {
   }  // namespace helper
 }  // namespace reco
 
+namespace {
+  // the clustering strategies of fastjet; Best picks one by the number of inputs, the
+  // tiled N ln N ones scale best to the inputs at high pileup
+  fastjet::Strategy strategyByName(const string& name) {
+    if (name == "Best")
+      return fastjet::Best;
+    if (name == "N2Plain")
+      return fastjet::N2Plain;
+    if (name == "N2Tiled")
+      return fastjet::N2Tiled;
+    if (name == "N2MinHeapTiled")
+      return fastjet::N2MinHeapTiled;
+    if (name == "N2MHTLazy9")
+      return fastjet::N2MHTLazy9;
+    if (name == "N2MHTLazy25")
+      return fastjet::N2MHTLazy25;
+    if (name == "NlnN")
+      return fastjet::NlnN;
+    if (name == "NlnNCam")
+      return fastjet::NlnNCam;
+    throw cms::Exception("Invalid jetStrategy") << "Jet strategy " << name << " for VirtualJetProducer is invalid\n";
+  }
+}  // namespace
+
 //______________________________________________________________________________
 const char* const VirtualJetProducer::JetType::names[] = {
     "BasicJet", "GenJet", "CaloJet", "PFJet", "TrackJet", "PFClusterJet"};
@@ -117,6 +141,8 @@ VirtualJetProducer::VirtualJetProducer(const edm::ParameterSet& iConfig) {
   jetType_ = iConfig.getParameter<string>("jetType");
   jetAlgorithm_ = iConfig.getParameter<string>("jetAlgorithm");
   rParam_ = iConfig.getParameter<double>("rParam");
+  const fastjet::Strategy strategy = strategyByName(
+      iConfig.existsAs<string>("jetStrategy") ? iConfig.getParameter<string>("jetStrategy") : string("Best"));
   inputEtMin_ = iConfig.getParameter<double>("inputEtMin");
   inputEMin_ = iConfig.getParameter<double>("inputEMin");
   jetPtMin_ = iConfig.getParameter<double>("jetPtMin");
@@ -169,16 +195,20 @@ VirtualJetProducer::VirtualJetProducer(const edm::ParameterSet& iConfig) {
   // - fastjet PU subtraction parameters (not yet considered)
   //
   if (jetAlgorithm_ == "Kt")
-    fjJetDefinition_ = std::make_shared<fastjet::JetDefinition>(fastjet::kt_algorithm, rParam_);
+    fjJetDefinition_ =
+        std::make_shared<fastjet::JetDefinition>(fastjet::kt_algorithm, rParam_, fastjet::E_scheme, strategy);
 
   else if (jetAlgorithm_ == "CambridgeAachen")
-    fjJetDefinition_ = std::make_shared<fastjet::JetDefinition>(fastjet::cambridge_algorithm, rParam_);
+    fjJetDefinition_ =
+        std::make_shared<fastjet::JetDefinition>(fastjet::cambridge_algorithm, rParam_, fastjet::E_scheme, strategy);
 
   else if (jetAlgorithm_ == "AntiKt")
-    fjJetDefinition_ = std::make_shared<fastjet::JetDefinition>(fastjet::antikt_algorithm, rParam_);
+    fjJetDefinition_ =
+        std::make_shared<fastjet::JetDefinition>(fastjet::antikt_algorithm, rParam_, fastjet::E_scheme, strategy);
 
   else if (jetAlgorithm_ == "GeneralizedKt")
-    fjJetDefinition_ = std::make_shared<fastjet::JetDefinition>(fastjet::genkt_algorithm, rParam_, -2);
+    fjJetDefinition_ =
+        std::make_shared<fastjet::JetDefinition>(fastjet::genkt_algorithm, rParam_, -2, fastjet::E_scheme, strategy);
 
   else if (jetAlgorithm_ == "SISCone") {
     fjPlugin_ = PluginPtr(new fastjet::SISConePlugin(rParam_, 0.75, 0, 0.0, false, fastjet::SISConePlugin::SM_pttilde));
@@ -979,6 +1009,7 @@ void VirtualJetProducer::fillDescriptionsFromVirtualJetProducer(edm::ParameterSe
   desc.add<edm::InputTag>("srcPVs", edm::InputTag(""));
   desc.add<string>("jetType", "PFJet");
   desc.add<string>("jetAlgorithm", "AntiKt");
+  desc.add<string>("jetStrategy", "Best");
   desc.add<double>("rParam", 0.4);
   desc.add<double>("inputEtMin", 0.0);
   desc.add<double>("inputEMin", 0.0);
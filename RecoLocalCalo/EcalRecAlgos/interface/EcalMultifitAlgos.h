@@ -0,0 +1,509 @@
+#ifndef RecoLocalCalo_EcalRecAlgos_EcalMultifitAlgos_h
+#define RecoLocalCalo_EcalRecAlgos_EcalMultifitAlgos_h
+
+#include <cmath>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitSoA.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+
+/** The multifit of EcalUncalibRecHitMultiFitAlgo and PulseChiSqSNNLS, for
+ *  the 10 samples of the ECAL digis, written for fixed-size matrices: the
+ *  same function fits a channel in a loop over the EcalDigiSoA on the host,
+ *  or in one thread per channel on the GPU.
+ *
+ *  The pulses of the active BXs are permuted in the matrices as in
+ *  PulseChiSqSNNLS, the first nP of them being those left free by the
+ *  non-negative least squares. The matrices have room for 10 pulses, and
+ *  only their first nPulses rows and columns are used.
+ *
+ *  The pedestals are static: the dynamic pedestals, the mitigation of the
+ *  bad samples and the prefit of EcalUncalibRecHitMultiFitAlgo are not
+ *  implemented, nor the time of the rechit, whose jitter is left at 0.
+ */
+namespace ecalMultifit {
+
+  constexpr int nSamples = EcalDigiSoA::nSamples;
+  constexpr int maxPulses = 10;
+  constexpr int nGains = EcalMultifitConditions::nGains;
+  constexpr int nTemplateSamples = EcalMultifitConditions::nTemplateSamples;
+  // the readout sample of the maximum, and the first of the pulse template with respect to it
+  constexpr int iSampleMax = 5;
+  constexpr int templateOffset = 3;
+
+  // the bits of EcalUncalibratedRecHit::Flags
+  constexpr uint32_t kSaturated = 1u << 1;
+  constexpr uint32_t kHasSwitchToGain6 = 1u << 4;
+  constexpr uint32_t kHasSwitchToGain1 = 1u << 5;
+
+  using SampleVector = Eigen::Matrix<double, nSamples, 1>;
+  using SampleMatrix = Eigen::Matrix<double, nSamples, nSamples>;
+  using PulseVector = Eigen::Matrix<double, maxPulses, 1>;
+  using PulseMatrix = Eigen::Matrix<double, maxPulses, maxPulses>;
+  using SamplePulseMatrix = Eigen::Matrix<double, nSamples, maxPulses>;
+
+  // the settings of EcalUncalibRecHitWorkerMultiFit, those of the endcap then of the barrel
+  struct Params {
+    int8_t activeBXs[maxPulses];
+    uint32_t nActiveBXs;
+    bool computeErrors;
+    bool simplifiedNoiseModelForGainSwitch;
+    bool gainSwitchUseMaxSample[2];
+    double addPedestalUncertainty[2];
+    int maxIterations;
+  };
+
+  // the fit of one channel, as the members of PulseChiSqSNNLS
+  struct Fit {
+    SampleVector samples;
+    SampleMatrix noiseCov;
+    // the Cholesky factor of the covariance of the samples, noise and pulse shape
+    SampleMatrix covL;
+    SamplePulseMatrix pulses;
+    PulseVector amplitudes;
+    PulseMatrix aTa;
+    PulseVector aTb;
+    int8_t bxs[maxPulses];
+    int nPulses;
+    int nP;
+    double chi2;
+  };
+
+  // the lower triangular l with l l^T = a, false if a is not positive definite
+  EIGEN_DEVICE_FUNC inline bool cholesky(SampleMatrix const& a, SampleMatrix& l) {
+    l.setZero();
+    for (int j = 0; j < nSamples; ++j) {
+      double d = a(j, j);
+      for (int k = 0; k < j; ++k)
+        d -= l(j, k) * l(j, k);
+      if (!(d > 0.))
+        return false;
+      l(j, j) = std::sqrt(d);
+      double const inv = 1. / l(j, j);
+      for (int i = j + 1; i < nSamples; ++i) {
+        double s = a(i, j);
+        for (int k = 0; k < j; ++k)
+          s -= l(i, k) * l(j, k);
+        l(i, j) = s * inv;
+      }
+    }
+    return true;
+  }
+
+  // x with l x = b, l lower triangular
+  EIGEN_DEVICE_FUNC inline SampleVector solveL(SampleMatrix const& l, SampleVector const& b) {
+    SampleVector x;
+    for (int i = 0; i < nSamples; ++i) {
+      double s = b(i);
+      for (int k = 0; k < i; ++k)
+        s -= l(i, k) * x(k);
+      x(i) = s / l(i, i);
+    }
+    return x;
+  }
+
+  // the first n elements of x with a x = b for the leading n x n block of a, by a LDL^T decomposition
+  EIGEN_DEVICE_FUNC inline void solveLeading(PulseMatrix const& a, PulseVector const& b, int n, PulseVector& x) {
+    PulseMatrix l;
+    PulseVector d;
+    for (int j = 0; j < n; ++j) {
+      double dj = a(j, j);
+      for (int k = 0; k < j; ++k)
+        dj -= l(j, k) * l(j, k) * d(k);
+      d(j) = dj;
+      for (int i = j + 1; i < n; ++i) {
+        double s = a(i, j);
+        for (int k = 0; k < j; ++k)
+          s -= l(i, k) * l(j, k) * d(k);
+        l(i, j) = dj != 0. ? s / dj : 0.;
+      }
+    }
+    PulseVector y;
+    for (int i = 0; i < n; ++i) {
+      double s = b(i);
+      for (int k = 0; k < i; ++k)
+        s -= l(i, k) * y(k);
+      y(i) = s;
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      double s = d(i) != 0. ? y(i) / d(i) : 0.;
+      for (int k = i + 1; k < n; ++k)
+        s -= l(k, i) * x(k);
+      x(i) = s;
+    }
+  }
+
+  template <typename T>
+  EIGEN_DEVICE_FUNC inline void swapValues(T& a, T& b) {
+    T const tmp = a;
+    a = b;
+    b = tmp;
+  }
+
+  // exchanges the pulses i and j, with their rows and columns of the normal equations
+  EIGEN_DEVICE_FUNC inline void swapPulses(Fit& fit, int i, int j) {
+    if (i == j)
+      return;
+    fit.aTa.col(i).swap(fit.aTa.col(j));
+    fit.aTa.row(i).swap(fit.aTa.row(j));
+    fit.pulses.col(i).swap(fit.pulses.col(j));
+    swapValues(fit.aTb(i), fit.aTb(j));
+    swapValues(fit.amplitudes(i), fit.amplitudes(j));
+    swapValues(fit.bxs[i], fit.bxs[j]);
+  }
+
+  // the covariance of the samples, with that of the pulse shape scaled by the squared amplitudes
+  EIGEN_DEVICE_FUNC inline bool updateCov(Fit& fit, EcalMultifitConditions const& conditions, uint32_t channel) {
+    SampleMatrix cov = fit.noiseCov;
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse) {
+      double const amplitude = fit.amplitudes(ipulse);
+      if (amplitude == 0.)
+        continue;
+      int const bx = fit.bxs[ipulse];
+      double const amplitude2 = amplitude * amplitude;
+      // the samples i >= bx + 3 see the template sample i - 3 - bx
+      int const shift = templateOffset + bx;
+      int const first = shift > 0 ? shift : 0;
+      for (int i = first; i < nSamples; ++i)
+        for (int j = first; j < nSamples; ++j)
+          cov(i, j) += amplitude2 * conditions.pulseCovariance[channel][i - shift][j - shift];
+    }
+    return cholesky(cov, fit.covL);
+  }
+
+  EIGEN_DEVICE_FUNC inline double computeChi2(Fit const& fit, SampleVector const& samples) {
+    SampleVector residuals = -samples;
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse)
+      residuals += fit.amplitudes(ipulse) * fit.pulses.col(ipulse);
+    return solveL(fit.covL, residuals).squaredNorm();
+  }
+
+  // the fast non-negative least squares of PulseChiSqSNNLS::NNLS()
+  EIGEN_DEVICE_FUNC inline void nnls(Fit& fit, SampleVector const& samples) {
+    SamplePulseMatrix invCovP;
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse)
+      invCovP.col(ipulse) = solveL(fit.covL, fit.pulses.col(ipulse));
+    SampleVector const invCovS = solveL(fit.covL, samples);
+    for (int i = 0; i < fit.nPulses; ++i) {
+      for (int j = 0; j < fit.nPulses; ++j)
+        fit.aTa(i, j) = invCovP.col(i).dot(invCovP.col(j));
+      fit.aTb(i) = invCovP.col(i).dot(invCovS);
+    }
+
+    int const maxP = fit.nPulses < nSamples ? fit.nPulses : nSamples;
+    int iter = 0;
+    int idxwmax = 0;
+    double wmax = 0.;
+    double threshold = 1e-11;
+    while (true) {
+      // can only perform this step if solution is guaranteed viable
+      if (iter > 0 || fit.nP == 0) {
+        if (fit.nP == maxP)
+          break;
+
+        int const idxwmaxprev = idxwmax;
+        double const wmaxprev = wmax;
+        for (int i = fit.nP; i < fit.nPulses; ++i) {
+          double w = fit.aTb(i);
+          for (int j = 0; j < fit.nPulses; ++j)
+            w -= fit.aTa(i, j) * fit.amplitudes(j);
+          if (i == fit.nP || w > wmax) {
+            wmax = w;
+            idxwmax = i - fit.nP;
+          }
+        }
+
+        // convergence
+        if (wmax < threshold || (idxwmax == idxwmaxprev && wmax == wmaxprev))
+          break;
+
+        // worst case protection
+        if (iter >= 500)
+          break;
+
+        // unconstrain parameter
+        swapPulses(fit, fit.nP, fit.nP + idxwmax);
+        ++fit.nP;
+      }
+
+      while (fit.nP > 0) {
+        PulseVector test = fit.amplitudes;
+        solveLeading(fit.aTa, fit.aTb, fit.nP, test);
+
+        bool positive = true;
+        for (int i = 0; i < fit.nP; ++i)
+          positive &= (test(i) > 0);
+        if (positive) {
+          fit.amplitudes.head(fit.nP) = test.head(fit.nP);
+          break;
+        }
+
+        // move to the boundary along the step, and constrain the parameter reaching it
+        int minratioidx = 0;
+        double minratio = 1.e300;
+        for (int i = 0; i < fit.nP; ++i) {
+          if (test(i) <= 0.) {
+            double const ratio = fit.amplitudes(i) / (fit.amplitudes(i) - test(i));
+            if (ratio < minratio) {
+              minratio = ratio;
+              minratioidx = i;
+            }
+          }
+        }
+        for (int i = 0; i < fit.nP; ++i)
+          fit.amplitudes(i) += minratio * (test(i) - fit.amplitudes(i));
+        // avoid numerical problems with later ==0. check
+        fit.amplitudes(minratioidx) = 0.;
+        swapPulses(fit, fit.nP - 1, minratioidx);
+        --fit.nP;
+      }
+      ++iter;
+
+      // adaptive convergence threshold to avoid infinite loops but still ensure best value is used
+      if (iter % 16 == 0)
+        threshold *= 2;
+    }
+  }
+
+  // the one pulse fit of PulseChiSqSNNLS::OnePulseMinimize()
+  EIGEN_DEVICE_FUNC inline void onePulseMinimize(Fit& fit, SampleVector const& samples) {
+    SampleVector const invCovP = solveL(fit.covL, fit.pulses.col(0));
+    double const aTa = invCovP.squaredNorm();
+    double const aTb = invCovP.dot(solveL(fit.covL, samples));
+    fit.amplitudes(0) = aTb / aTa > 0. ? aTb / aTa : 0.;
+  }
+
+  EIGEN_DEVICE_FUNC inline bool minimize(Fit& fit,
+                                         SampleVector const& samples,
+                                         EcalMultifitConditions const& conditions,
+                                         uint32_t channel,
+                                         Params const& params) {
+    bool status = false;
+    for (int iter = 0; iter < params.maxIterations; ++iter) {
+      status = updateCov(fit, conditions, channel);
+      if (!status)
+        break;
+      if (fit.nPulses > 1)
+        nnls(fit, samples);
+      else
+        onePulseMinimize(fit, samples);
+
+      double const chi2 = computeChi2(fit, samples);
+      double const deltaChi2 = chi2 - fit.chi2;
+      fit.chi2 = chi2;
+      if (std::abs(deltaChi2) < 1e-3)
+        break;
+    }
+    return status;
+  }
+
+  EIGEN_DEVICE_FUNC inline int inTimePulse(Fit const& fit) {
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse) {
+      if (fit.bxs[ipulse] == 0)
+        return ipulse;
+    }
+    return -1;
+  }
+
+  // PulseChiSqSNNLS::DoFit() with static pedestals: the fitted amplitudes and their bxs, and the error of the
+  // in-time amplitude if computeErrors, from the change of chi2 when moving it away from its minimum
+  EIGEN_DEVICE_FUNC inline bool doFit(Fit& fit,
+                                      EcalMultifitConditions const& conditions,
+                                      uint32_t channel,
+                                      Params const& params,
+                                      PulseVector& amplitudes,
+                                      int8_t* bxs,
+                                      double& inTimeError) {
+    fit.nPulses = params.nActiveBXs;
+    fit.nP = 0;
+    fit.chi2 = 0.;
+    fit.amplitudes.setZero();
+    fit.pulses.setZero();
+    inTimeError = 0.;
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse) {
+      int const bx = params.activeBXs[ipulse];
+      fit.bxs[ipulse] = bx;
+      for (int i = 0; i < nSamples; ++i) {
+        int const t = i - templateOffset - bx;
+        if (t >= 0 && t < nTemplateSamples)
+          fit.pulses(i, ipulse) = conditions.pulseShape[channel][t];
+      }
+    }
+    if (fit.nPulses == 1)
+      fit.amplitudes(0) = fit.samples(fit.bxs[0] + iSampleMax);
+
+    bool status = minimize(fit, fit.samples, conditions, channel, params);
+    amplitudes = fit.amplitudes;
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse)
+      bxs[ipulse] = fit.bxs[ipulse];
+    if (!status || !params.computeErrors)
+      return status;
+
+    int ipulseintime = inTimePulse(fit);
+    if (ipulseintime < 0)
+      return status;
+
+    double const approxErr = 1. / solveL(fit.covL, fit.pulses.col(ipulseintime)).norm();
+    double const chi20 = fit.chi2;
+    double const x0 = amplitudes(ipulseintime);
+
+    // move in time pulse first to active set if necessary
+    if (ipulseintime < fit.nP) {
+      fit.pulses.col(fit.nP - 1).swap(fit.pulses.col(ipulseintime));
+      swapValues(fit.amplitudes(fit.nP - 1), fit.amplitudes(ipulseintime));
+      swapValues(fit.bxs[fit.nP - 1], fit.bxs[ipulseintime]);
+      ipulseintime = fit.nP - 1;
+      --fit.nP;
+    }
+
+    SampleVector const pulseInTime = fit.pulses.col(ipulseintime);
+    fit.pulses.col(ipulseintime).setZero();
+
+    // two point interpolation for upper uncertainty when amplitude is away from boundary
+    double const xPlus = x0 + approxErr;
+    fit.amplitudes(ipulseintime) = xPlus;
+    SampleVector samples = fit.samples - xPlus * pulseInTime;
+    status &= minimize(fit, samples, conditions, channel, params);
+    if (!status)
+      return status;
+    double const sigmaPlus = std::abs(xPlus - x0) / std::sqrt(computeChi2(fit, samples) - chi20);
+
+    // if amplitude is sufficiently far from the boundary, compute also the lower uncertainty and average them
+    if ((x0 / sigmaPlus) > 0.5) {
+      ipulseintime = inTimePulse(fit);
+      double const xMinus = x0 - approxErr > 0. ? x0 - approxErr : 0.;
+      fit.amplitudes(ipulseintime) = xMinus;
+      samples = fit.samples - xMinus * pulseInTime;
+      status &= minimize(fit, samples, conditions, channel, params);
+      if (!status)
+        return status;
+      double const sigmaMinus = std::abs(xMinus - x0) / std::sqrt(computeChi2(fit, samples) - chi20);
+      inTimeError = 0.5 * (sigmaPlus + sigmaMinus);
+    } else {
+      inTimeError = sigmaPlus;
+    }
+    fit.chi2 = chi20;
+    return status;
+  }
+
+  // the uncalibrated rechit of the digi i, as EcalUncalibRecHitWorkerMultiFit without time
+  EIGEN_DEVICE_FUNC inline void makeRecHit(EcalDigiSoA const& digis,
+                                           uint32_t i,
+                                           EcalMultifitConditions const& conditions,
+                                           Params const& params,
+                                           EcalUncalibratedRecHitSoA& recHits) {
+    uint32_t const channel = digis.channel[i];
+    int const isBarrel = digis.isBarrel(i) ? 1 : 0;
+    recHits.id[i] = digis.id[i];
+    recHits.amplitudeError[i] = 0.f;
+    recHits.pedestal[i] = 0.f;
+    recHits.chi2[i] = 0.f;
+    recHits.jitter[i] = 0.f;
+    for (int s = 0; s < nSamples; ++s)
+      recHits.outOfTimeAmplitudes[i][s] = 0.f;
+
+    double const pedestals[nGains] = {conditions.pedestalMean[channel][0],
+                                      conditions.pedestalMean[channel][1],
+                                      conditions.pedestalMean[channel][2]};
+    double const gainRatios[nGains] = {1.,
+                                       conditions.gain12Over6[channel],
+                                       double(conditions.gain6Over1[channel]) * conditions.gain12Over6[channel]};
+
+    // the gains 12, 6, 1 are the gain ids 1, 2, 3, and 0 for a saturated sample
+    int gainIds[nSamples];
+    int lastSampleBeforeSaturation = -2;
+    uint32_t flags = 0;
+    for (int s = 0; s < nSamples; ++s) {
+      gainIds[s] = (digis.samples[i][s] >> 12) & 0x3;
+      if (gainIds[s] == 0 && lastSampleBeforeSaturation == -2)
+        lastSampleBeforeSaturation = s - 1;
+      if (gainIds[s] == 2)
+        flags |= kHasSwitchToGain6;
+      if (gainIds[s] == 3)
+        flags |= kHasSwitchToGain1;
+    }
+    auto adc = [&](int s) { return double(digis.samples[i][s] & 0xFFF); };
+
+    if (lastSampleBeforeSaturation == 4) {
+      // saturation on the expected max sample
+      recHits.amplitude[i] = 4095 * 12;
+      recHits.flags[i] = flags | kSaturated;
+      return;
+    }
+    if (lastSampleBeforeSaturation >= -1) {
+      // saturation on other samples: cannot extrapolate from the fourth one
+      int const gain = (gainIds[iSampleMax] == 0 ? 3 : gainIds[iSampleMax]) - 1;
+      recHits.amplitude[i] = (adc(iSampleMax) - pedestals[gain]) * gainRatios[gain];
+      recHits.flags[i] = flags | kSaturated;
+      return;
+    }
+    recHits.flags[i] = flags;
+
+    Fit fit;
+    int gainsNoise[nSamples];
+    for (int s = 0; s < nSamples; ++s) {
+      int const gain = gainIds[s] - 1;
+      gainsNoise[s] = gain;
+      fit.samples(s) = (adc(s) - pedestals[gain]) * gainRatios[gain];
+    }
+    recHits.pedestal[i] = pedestals[gainsNoise[iSampleMax]];
+
+    bool const hasGainSwitch = (flags & (kHasSwitchToGain6 | kHasSwitchToGain1)) != 0;
+    if (hasGainSwitch && params.gainSwitchUseMaxSample[isBarrel]) {
+      recHits.amplitude[i] = fit.samples(iSampleMax) / conditions.pulseShape[channel][2];
+      return;
+    }
+
+    // the noise covariance, which depends on the sample gains
+    double const addPedestal2 = params.addPedestalUncertainty[isBarrel] * params.addPedestalUncertainty[isBarrel];
+    auto const& correlation = conditions.noiseCorrelation[isBarrel];
+    auto noiseScale = [&](int gain) {
+      double const rms = conditions.pedestalRMS[channel][gain];
+      return gainRatios[gain] * gainRatios[gain] * rms * rms;
+    };
+    if (hasGainSwitch && !params.simplifiedNoiseModelForGainSwitch) {
+      // no correlation between the samples with different gains
+      for (int s = 0; s < nSamples; ++s) {
+        for (int t = 0; t < nSamples; ++t) {
+          int const gain = gainsNoise[s];
+          bool const same = gainsNoise[t] == gain;
+          int const d = s > t ? s - t : t - s;
+          fit.noiseCov(s, t) =
+              same ? noiseScale(gain) * correlation[gain][d] + gainRatios[gain] * gainRatios[gain] * addPedestal2 : 0.;
+        }
+      }
+    } else {
+      int const gain = hasGainSwitch ? gainsNoise[iSampleMax] : 0;
+      double const scale = noiseScale(gain);
+      for (int s = 0; s < nSamples; ++s) {
+        for (int t = 0; t < nSamples; ++t) {
+          int const d = s > t ? s - t : t - s;
+          fit.noiseCov(s, t) = scale * correlation[gain][d] + addPedestal2;
+        }
+      }
+    }
+
+    PulseVector amplitudes;
+    int8_t bxs[maxPulses];
+    double error;
+    bool const status = doFit(fit, conditions, channel, params, amplitudes, bxs, error);
+
+    recHits.chi2[i] = fit.chi2;
+    recHits.amplitude[i] = 0.f;
+    for (int ipulse = 0; ipulse < fit.nPulses; ++ipulse) {
+      int const bx = bxs[ipulse];
+      if (bx == 0) {
+        recHits.amplitude[i] = status ? amplitudes(ipulse) : 0.;
+        recHits.amplitudeError[i] = status ? error : 0.;
+      } else {
+        recHits.outOfTimeAmplitudes[i][bx + iSampleMax] = status ? amplitudes(ipulse) : 0.;
+      }
+    }
+  }
+
+}  // namespace ecalMultifit
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef RecoLocalCalo_EcalRecAlgos_EcalMultifitConditions_h
+#define RecoLocalCalo_EcalRecAlgos_EcalMultifitConditions_h
+
+#include <cstdint>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+
+struct EcalPedestal;
+class EcalMGPAGainRatio;
+struct EcalPulseShape;
+struct EcalPulseCovariance;
+class EcalSamplesCorrelation;
+template <typename T>
+class EcalCondObjectContainer;
+
+/**
+ * The conditions of the multifit of all the ECAL crystals, as flat arrays
+ * indexed by the dense channel index of EcalDigiSoA: the barrel crystals
+ * by EBDetId::hashedIndex(), then the endcap ones by EEDetId::hashedIndex().
+ * The same layout is used on the host and copied as a whole to the device.
+ *
+ * The gains are ordered as 12, 6, 1; the pulse shape and its covariance
+ * are the 12 samples of the template, starting 3 samples before the
+ * sample of the maximum (5). The noise correlations are those between two
+ * samples |i - j| apart, for the endcap then the barrel.
+ */
+class EcalMultifitConditions {
+public:
+  static constexpr uint32_t nChannels = EcalDigiSoA::maxDigis;
+  static constexpr uint32_t nBarrelChannels = EcalDigiSoA::nBarrelChannels;
+  static constexpr uint32_t nSamples = EcalDigiSoA::nSamples;
+  static constexpr uint32_t nGains = 3;
+  static constexpr uint32_t nTemplateSamples = 12;
+
+  EcalMultifitConditions(EcalCondObjectContainer<EcalPedestal> const& pedestals,
+                         EcalCondObjectContainer<EcalMGPAGainRatio> const& gainRatios,
+                         EcalCondObjectContainer<EcalPulseShape> const& pulseShapes,
+                         EcalCondObjectContainer<EcalPulseCovariance> const& pulseCovariances,
+                         EcalSamplesCorrelation const& samplesCorrelation);
+
+  float pedestalMean[nChannels][nGains];
+  float pedestalRMS[nChannels][nGains];
+  float gain12Over6[nChannels];
+  float gain6Over1[nChannels];
+  float pulseShape[nChannels][nTemplateSamples];
+  float pulseCovariance[nChannels][nTemplateSamples][nTemplateSamples];
+  double noiseCorrelation[2][nGains][nSamples];
+};
+
+#endif
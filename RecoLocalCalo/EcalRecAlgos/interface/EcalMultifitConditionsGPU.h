@@ -0,0 +1,30 @@
+#ifndef RecoLocalCalo_EcalRecAlgos_EcalMultifitConditionsGPU_h
+#define RecoLocalCalo_EcalRecAlgos_EcalMultifitConditionsGPU_h
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDACore/interface/ESProduct.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+
+// The EcalMultifitConditions of the host, copied as a whole to each device
+// on its first use. They are produced in the same record, and outlive this
+// object.
+class EcalMultifitConditionsGPU {
+public:
+  explicit EcalMultifitConditionsGPU(EcalMultifitConditions const& conditions);
+  ~EcalMultifitConditionsGPU();
+
+  // returns pointer to GPU memory
+  const EcalMultifitConditions* getGPUProductAsync(cudaStream_t cudaStream) const;
+
+private:
+  EcalMultifitConditions const* conditions_;
+
+  struct GPUData {
+    ~GPUData();
+    EcalMultifitConditions* conditionsOnGPU = nullptr;
+  };
+  cms::cuda::ESProduct<GPUData> gpuData_;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef RecoLocalCalo_EcalRecAlgos_EcalMultifitConditionsRcd_h
+#define RecoLocalCalo_EcalRecAlgos_EcalMultifitConditionsRcd_h
+
+#include "boost/mpl/vector.hpp"
+#include "FWCore/Framework/interface/DependentRecordImplementation.h"
+#include "CondFormats/DataRecord/interface/EcalGainRatiosRcd.h"
+#include "CondFormats/DataRecord/interface/EcalPedestalsRcd.h"
+#include "CondFormats/DataRecord/interface/EcalPulseCovariancesRcd.h"
+#include "CondFormats/DataRecord/interface/EcalPulseShapesRcd.h"
+#include "CondFormats/DataRecord/interface/EcalSamplesCorrelationRcd.h"
+
+//
+// Registration of EcalMultifitConditions and EcalMultifitConditionsGPU to the EventSetup mechanism
+//
+
+class EcalMultifitConditionsRcd
+    : public edm::eventsetup::DependentRecordImplementation<EcalMultifitConditionsRcd,
+                                                            boost::mpl::vector<EcalPedestalsRcd,
+                                                                               EcalGainRatiosRcd,
+                                                                               EcalPulseShapesRcd,
+                                                                               EcalPulseCovariancesRcd,
+                                                                               EcalSamplesCorrelationRcd> > {};
+
+#endif
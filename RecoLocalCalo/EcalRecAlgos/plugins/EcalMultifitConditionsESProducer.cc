@@ -0,0 +1,59 @@
+#include <memory>
+
+#include "CondFormats/EcalObjects/interface/EcalGainRatios.h"
+#include "CondFormats/EcalObjects/interface/EcalPedestals.h"
+#include "CondFormats/EcalObjects/interface/EcalPulseCovariances.h"
+#include "CondFormats/EcalObjects/interface/EcalPulseShapes.h"
+#include "CondFormats/EcalObjects/interface/EcalSamplesCorrelation.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsRcd.h"
+
+/*
+  Flattens the pedestals, gain ratios, pulse shapes, pulse covariances and
+  samples correlation of all the ECAL crystals into EcalMultifitConditions,
+  once per IOV of any of them, for the batched multifit.
+ */
+class EcalMultifitConditionsESProducer : public edm::ESProducer {
+public:
+  explicit EcalMultifitConditionsESProducer(const edm::ParameterSet& iConfig);
+  std::unique_ptr<EcalMultifitConditions> produce(const EcalMultifitConditionsRcd& iRecord);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  edm::ESGetToken<EcalPedestals, EcalPedestalsRcd> pedestalsToken_;
+  edm::ESGetToken<EcalGainRatios, EcalGainRatiosRcd> gainRatiosToken_;
+  edm::ESGetToken<EcalPulseShapes, EcalPulseShapesRcd> pulseShapesToken_;
+  edm::ESGetToken<EcalPulseCovariances, EcalPulseCovariancesRcd> pulseCovariancesToken_;
+  edm::ESGetToken<EcalSamplesCorrelation, EcalSamplesCorrelationRcd> samplesCorrelationToken_;
+};
+
+EcalMultifitConditionsESProducer::EcalMultifitConditionsESProducer(const edm::ParameterSet& iConfig) {
+  setWhatProduced(this)
+      .setConsumes(pedestalsToken_)
+      .setConsumes(gainRatiosToken_)
+      .setConsumes(pulseShapesToken_)
+      .setConsumes(pulseCovariancesToken_)
+      .setConsumes(samplesCorrelationToken_);
+}
+
+void EcalMultifitConditionsESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  descriptions.add("ecalMultifitConditionsESProducer", desc);
+}
+
+std::unique_ptr<EcalMultifitConditions> EcalMultifitConditionsESProducer::produce(
+    const EcalMultifitConditionsRcd& iRecord) {
+  return std::make_unique<EcalMultifitConditions>(iRecord.get(pedestalsToken_),
+                                                  iRecord.get(gainRatiosToken_),
+                                                  iRecord.get(pulseShapesToken_),
+                                                  iRecord.get(pulseCovariancesToken_),
+                                                  iRecord.get(samplesCorrelationToken_));
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(EcalMultifitConditionsESProducer);
@@ -0,0 +1,37 @@
+#include <memory>
+
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsGPU.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsRcd.h"
+
+class EcalMultifitConditionsGPUESProducer : public edm::ESProducer {
+public:
+  explicit EcalMultifitConditionsGPUESProducer(const edm::ParameterSet& iConfig);
+  std::unique_ptr<EcalMultifitConditionsGPU> produce(const EcalMultifitConditionsRcd& iRecord);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  edm::ESGetToken<EcalMultifitConditions, EcalMultifitConditionsRcd> conditionsToken_;
+};
+
+EcalMultifitConditionsGPUESProducer::EcalMultifitConditionsGPUESProducer(const edm::ParameterSet& iConfig) {
+  setWhatProduced(this).setConsumes(conditionsToken_);
+}
+
+void EcalMultifitConditionsGPUESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  descriptions.add("ecalMultifitConditionsGPUESProducer", desc);
+}
+
+std::unique_ptr<EcalMultifitConditionsGPU> EcalMultifitConditionsGPUESProducer::produce(
+    const EcalMultifitConditionsRcd& iRecord) {
+  return std::make_unique<EcalMultifitConditionsGPU>(iRecord.get(conditionsToken_));
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(EcalMultifitConditionsGPUESProducer);
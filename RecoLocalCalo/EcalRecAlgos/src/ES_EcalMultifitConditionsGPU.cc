@@ -0,0 +1,4 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsGPU.h"
+#include "FWCore/Utilities/interface/typelookup.h"
+
+TYPELOOKUP_DATA_REG(EcalMultifitConditionsGPU);
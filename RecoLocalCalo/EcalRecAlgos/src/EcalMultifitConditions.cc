@@ -0,0 +1,58 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+
+#include <vector>
+
+#include "CondFormats/EcalObjects/interface/EcalGainRatios.h"
+#include "CondFormats/EcalObjects/interface/EcalPedestals.h"
+#include "CondFormats/EcalObjects/interface/EcalPulseCovariances.h"
+#include "CondFormats/EcalObjects/interface/EcalPulseShapes.h"
+#include "CondFormats/EcalObjects/interface/EcalSamplesCorrelation.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+EcalMultifitConditions::EcalMultifitConditions(EcalCondObjectContainer<EcalPedestal> const& pedestals,
+                                               EcalCondObjectContainer<EcalMGPAGainRatio> const& gainRatios,
+                                               EcalCondObjectContainer<EcalPulseShape> const& pulseShapes,
+                                               EcalCondObjectContainer<EcalPulseCovariance> const& pulseCovariances,
+                                               EcalSamplesCorrelation const& samplesCorrelation) {
+  static_assert(nTemplateSamples == EcalPulseShape::TEMPLATESAMPLES);
+
+  for (uint32_t channel = 0; channel < nChannels; ++channel) {
+    bool const barrel = channel < nBarrelChannels;
+    uint32_t const hashedIndex = barrel ? channel : channel - nBarrelChannels;
+    auto const& pedestal = barrel ? pedestals.barrel(hashedIndex) : pedestals.endcap(hashedIndex);
+    auto const& gainRatio = barrel ? gainRatios.barrel(hashedIndex) : gainRatios.endcap(hashedIndex);
+    auto const& shape = barrel ? pulseShapes.barrel(hashedIndex) : pulseShapes.endcap(hashedIndex);
+    auto const& covariance = barrel ? pulseCovariances.barrel(hashedIndex) : pulseCovariances.endcap(hashedIndex);
+
+    pedestalMean[channel][0] = pedestal.mean_x12;
+    pedestalMean[channel][1] = pedestal.mean_x6;
+    pedestalMean[channel][2] = pedestal.mean_x1;
+    pedestalRMS[channel][0] = pedestal.rms_x12;
+    pedestalRMS[channel][1] = pedestal.rms_x6;
+    pedestalRMS[channel][2] = pedestal.rms_x1;
+    gain12Over6[channel] = gainRatio.gain12Over6();
+    gain6Over1[channel] = gainRatio.gain6Over1();
+    for (uint32_t i = 0; i < nTemplateSamples; ++i) {
+      pulseShape[channel][i] = shape.pdfval[i];
+      for (uint32_t j = 0; j < nTemplateSamples; ++j)
+        pulseCovariance[channel][i][j] = covariance.covval[i][j];
+    }
+  }
+
+  std::vector<double> const* correlations[2][nGains] = {{&samplesCorrelation.EEG12SamplesCorrelation,
+                                                         &samplesCorrelation.EEG6SamplesCorrelation,
+                                                         &samplesCorrelation.EEG1SamplesCorrelation},
+                                                        {&samplesCorrelation.EBG12SamplesCorrelation,
+                                                         &samplesCorrelation.EBG6SamplesCorrelation,
+                                                         &samplesCorrelation.EBG1SamplesCorrelation}};
+  for (uint32_t barrel = 0; barrel < 2; ++barrel) {
+    for (uint32_t gain = 0; gain < nGains; ++gain) {
+      auto const& correlation = *correlations[barrel][gain];
+      if (correlation.size() < nSamples)
+        throw cms::Exception("EcalMultifitConditions")
+            << "The samples correlation has " << correlation.size() << " values instead of " << nSamples;
+      for (uint32_t d = 0; d < nSamples; ++d)
+        noiseCorrelation[barrel][gain][d] = correlation[d];
+    }
+  }
+}
@@ -0,0 +1,19 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsGPU.h"
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+EcalMultifitConditionsGPU::EcalMultifitConditionsGPU(EcalMultifitConditions const& conditions)
+    : conditions_(&conditions) {}
+
+EcalMultifitConditionsGPU::~EcalMultifitConditionsGPU() {}
+
+const EcalMultifitConditions* EcalMultifitConditionsGPU::getGPUProductAsync(cudaStream_t cudaStream) const {
+  const auto& data = gpuData_.dataForCurrentDeviceAsync(cudaStream, [this](GPUData& data, cudaStream_t stream) {
+    cudaCheck(cudaMalloc(&data.conditionsOnGPU, sizeof(EcalMultifitConditions)));
+    cudaCheck(cudaMemcpyAsync(
+        data.conditionsOnGPU, conditions_, sizeof(EcalMultifitConditions), cudaMemcpyHostToDevice, stream));
+  });
+  return data.conditionsOnGPU;
+}
+
+EcalMultifitConditionsGPU::GPUData::~GPUData() { cudaCheck(cudaFree(conditionsOnGPU)); }
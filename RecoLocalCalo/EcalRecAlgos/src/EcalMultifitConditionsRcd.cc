@@ -0,0 +1,4 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsRcd.h"
+#include "FWCore/Framework/interface/eventsetuprecord_registration_macro.h"
+
+EVENTSETUP_RECORD_REG(EcalMultifitConditionsRcd);
@@ -0,0 +1,3 @@
+#include "FWCore/Utilities/interface/typelookup.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+TYPELOOKUP_DATA_REG(EcalMultifitConditions);
@@ -0,0 +1,36 @@
+#ifndef RecoLocalCalo_EcalRecProducers_plugins_EcalDigiSoAFromLegacy_h
+#define RecoLocalCalo_EcalRecProducers_plugins_EcalDigiSoAFromLegacy_h
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace ecalMultifit {
+
+  // the barrel then the endcap digis of the unpacker, in the order of their collections
+  inline void fillDigiSoA(EBDigiCollection const& ebDigis, EEDigiCollection const& eeDigis, EcalDigiSoA& soa) {
+    uint32_t n = 0;
+    auto fill = [&](EcalDigiCollection const& digis, auto channel) {
+      for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg) {
+        EcalDataFrame const frame(*itdg);
+        if (frame.size() != int(EcalDigiSoA::nSamples))
+          throw cms::Exception("InvalidEcalDigi")
+              << "The batched multifit expects " << EcalDigiSoA::nSamples << " samples, not " << frame.size();
+        soa.id[n] = itdg->id();
+        soa.channel[n] = channel(itdg->id());
+        for (uint32_t s = 0; s < EcalDigiSoA::nSamples; ++s)
+          soa.samples[n][s] = frame[s].raw();
+        ++n;
+      }
+    };
+    fill(ebDigis, [](uint32_t id) { return uint32_t(EBDetId(id).hashedIndex()); });
+    soa.nBarrelDigis = n;
+    fill(eeDigis, [](uint32_t id) { return EcalDigiSoA::nBarrelChannels + EEDetId(id).hashedIndex(); });
+    soa.nDigis = n;
+  }
+
+}  // namespace ecalMultifit
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef RecoLocalCalo_EcalRecProducers_plugins_EcalMultifitParams_h
+#define RecoLocalCalo_EcalRecProducers_plugins_EcalMultifitParams_h
+
+#include <string>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitAlgos.h"
+
+// The configuration of the batched multifit, the same on the GPU and the CPU. The parameters
+// are those of EcalUncalibRecHitWorkerMultiFit with the same names and defaults.
+namespace ecalMultifit {
+
+  inline void fillParamsDescription(edm::ParameterSetDescription& desc) {
+    desc.add<std::vector<int>>("activeBXs", {-5, -4, -3, -2, -1, 0, 1, 2, 3, 4});
+    desc.add<bool>("ampErrorCalculation", true);
+    desc.add<bool>("gainSwitchUseMaxSampleEB", false);
+    desc.add<bool>("gainSwitchUseMaxSampleEE", false);
+    desc.add<double>("addPedestalUncertaintyEB", 0.);
+    desc.add<double>("addPedestalUncertaintyEE", 0.);
+    desc.add<bool>("simplifiedNoiseModelForGainSwitch", true);
+    desc.add<int>("maxIterations", 50)->setComment("of the non-negative least squares, as PulseChiSqSNNLS");
+
+    // the options of EcalUncalibRecHitWorkerMultiFit that are not implemented: only their default is accepted,
+    // so that a configuration relying on them fails instead of giving different rechits
+    desc.add<std::string>("timealgo", "None")
+        ->setComment("The time is not reconstructed and the jitter is left at 0, only 'None' is accepted.");
+    desc.add<bool>("dynamicPedestalsEB", false)->setComment("Only the static pedestals are implemented.");
+    desc.add<bool>("dynamicPedestalsEE", false)->setComment("Only the static pedestals are implemented.");
+    desc.add<bool>("mitigateBadSamplesEB", false)->setComment("The bad sample mitigation is not implemented.");
+    desc.add<bool>("mitigateBadSamplesEE", false)->setComment("The bad sample mitigation is not implemented.");
+    desc.add<bool>("doPrefitEB", false)->setComment("The one pulse prefit is not implemented.");
+    desc.add<bool>("doPrefitEE", false)->setComment("The one pulse prefit is not implemented.");
+  }
+
+  // a one line summary of the differences with EcalUncalibRecHitWorkerMultiFit, for the module descriptions
+  constexpr const char* const kLimitations =
+      "The time is not reconstructed, the pedestals are static, and the bad sample mitigation and the prefit of "
+      "EcalUncalibRecHitWorkerMultiFit are not implemented.";
+
+  inline Params makeParams(const edm::ParameterSet& iConfig) {
+    Params params;
+    auto const& activeBXs = iConfig.getParameter<std::vector<int>>("activeBXs");
+    if (activeBXs.empty() || activeBXs.size() > unsigned(maxPulses))
+      throw cms::Exception("InvalidConfiguration") << "The batched multifit fits from 1 to " << maxPulses << " BXs";
+    params.nActiveBXs = activeBXs.size();
+    for (unsigned int i = 0; i < activeBXs.size(); ++i) {
+      if (activeBXs[i] < -iSampleMax || activeBXs[i] >= nSamples - iSampleMax)
+        throw cms::Exception("InvalidConfiguration") << "Active BX " << activeBXs[i] << " out of the readout window";
+      params.activeBXs[i] = activeBXs[i];
+    }
+    params.computeErrors = iConfig.getParameter<bool>("ampErrorCalculation");
+    params.simplifiedNoiseModelForGainSwitch = iConfig.getParameter<bool>("simplifiedNoiseModelForGainSwitch");
+    // the endcap, then the barrel
+    params.gainSwitchUseMaxSample[0] = iConfig.getParameter<bool>("gainSwitchUseMaxSampleEE");
+    params.gainSwitchUseMaxSample[1] = iConfig.getParameter<bool>("gainSwitchUseMaxSampleEB");
+    params.addPedestalUncertainty[0] = iConfig.getParameter<double>("addPedestalUncertaintyEE");
+    params.addPedestalUncertainty[1] = iConfig.getParameter<double>("addPedestalUncertaintyEB");
+    params.maxIterations = iConfig.getParameter<int>("maxIterations");
+
+    if (iConfig.getParameter<std::string>("timealgo") != "None")
+      throw cms::Exception("InvalidConfiguration") << "The batched multifit does not reconstruct the time";
+    for (auto const& name : {"dynamicPedestalsEB",
+                             "dynamicPedestalsEE",
+                             "mitigateBadSamplesEB",
+                             "mitigateBadSamplesEE",
+                             "doPrefitEB",
+                             "doPrefitEE"}) {
+      if (iConfig.getParameter<bool>(name))
+        throw cms::Exception("InvalidConfiguration") << "The batched multifit does not implement " << name;
+    }
+    return params;
+  }
+
+}  // namespace ecalMultifit
+
+#endif
@@ -0,0 +1,84 @@
+#include <memory>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitSoA.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitAlgos.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsRcd.h"
+
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include "EcalDigiSoAFromLegacy.h"
+#include "EcalMultifitParams.h"
+
+/**
+ * Fits the amplitudes of all the ECAL barrel and endcap digis of an event
+ * on the host, with the same fixed-size multifit and parameters as
+ * EcalUncalibRecHitProducerCUDA: the channels are fitted independently, in
+ * parallel over blocks of the EcalDigiSoA.
+ */
+class EcalUncalibRecHitProducerSoA : public edm::stream::EDProducer<> {
+public:
+  explicit EcalUncalibRecHitProducerSoA(const edm::ParameterSet& iConfig);
+  ~EcalUncalibRecHitProducerSoA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  const edm::EDGetTokenT<EBDigiCollection> ebDigiGetToken_;
+  const edm::EDGetTokenT<EEDigiCollection> eeDigiGetToken_;
+  const edm::ESGetToken<EcalMultifitConditions, EcalMultifitConditionsRcd> conditionsToken_;
+  const edm::EDPutTokenT<EcalUncalibratedRecHitSoA> recHitPutToken_;
+
+  const ecalMultifit::Params params_;
+  std::unique_ptr<EcalDigiSoA> digis_;
+};
+
+EcalUncalibRecHitProducerSoA::EcalUncalibRecHitProducerSoA(const edm::ParameterSet& iConfig)
+    : ebDigiGetToken_(consumes<EBDigiCollection>(iConfig.getParameter<edm::InputTag>("EBdigiCollection"))),
+      eeDigiGetToken_(consumes<EEDigiCollection>(iConfig.getParameter<edm::InputTag>("EEdigiCollection"))),
+      conditionsToken_(esConsumes<EcalMultifitConditions, EcalMultifitConditionsRcd>()),
+      recHitPutToken_(produces<EcalUncalibratedRecHitSoA>()),
+      params_(ecalMultifit::makeParams(iConfig)),
+      digis_(std::make_unique<EcalDigiSoA>()) {}
+
+void EcalUncalibRecHitProducerSoA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("EBdigiCollection", edm::InputTag("ecalDigis", "ebDigis"));
+  desc.add<edm::InputTag>("EEdigiCollection", edm::InputTag("ecalDigis", "eeDigis"));
+  ecalMultifit::fillParamsDescription(desc);
+  descriptions.add("ecalUncalibRecHitProducerSoA", desc);
+  descriptions.setComment(
+      std::string("The multifit of EcalUncalibRecHitWorkerMultiFit for all the ECAL channels at once, on the CPU. ") +
+      ecalMultifit::kLimitations);
+}
+
+void EcalUncalibRecHitProducerSoA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  ecalMultifit::fillDigiSoA(iEvent.get(ebDigiGetToken_), iEvent.get(eeDigiGetToken_), *digis_);
+  auto const& conditions = iSetup.getData(conditionsToken_);
+
+  auto output = std::make_unique<EcalUncalibratedRecHitSoA>();
+  output->nRecHits = digis_->nDigis;
+  output->nBarrelRecHits = digis_->nBarrelDigis;
+  auto const& digis = *digis_;
+  auto& recHits = *output;
+  tbb::parallel_for(tbb::blocked_range<uint32_t>(0, digis.nDigis), [&](const tbb::blocked_range<uint32_t>& range) {
+    for (uint32_t i = range.begin(); i != range.end(); ++i)
+      ecalMultifit::makeRecHit(digis, i, conditions, params_, recHits);
+  });
+  iEvent.put(recHitPutToken_, std::move(output));
+}
+
+DEFINE_FWK_MODULE(EcalUncalibRecHitProducerSoA);
@@ -0,0 +1,75 @@
+#include <memory>
+#include <string>
+
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitSoA.h"
+#include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+/**
+ * Converts the uncalibrated rechits of the batched multifit, from the GPU
+ * or the CPU, to the barrel and endcap collections of
+ * EcalUncalibRecHitProducer, for the rest of the ECAL local reconstruction.
+ */
+class EcalUncalibratedRecHitCollectionFromSoA : public edm::global::EDProducer<> {
+public:
+  explicit EcalUncalibratedRecHitCollectionFromSoA(const edm::ParameterSet& iConfig);
+  ~EcalUncalibratedRecHitCollectionFromSoA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<EcalUncalibratedRecHitSoA> recHitGetToken_;
+  const edm::EDPutTokenT<EBUncalibratedRecHitCollection> ebRecHitPutToken_;
+  const edm::EDPutTokenT<EEUncalibratedRecHitCollection> eeRecHitPutToken_;
+};
+
+EcalUncalibratedRecHitCollectionFromSoA::EcalUncalibratedRecHitCollectionFromSoA(const edm::ParameterSet& iConfig)
+    : recHitGetToken_(consumes<EcalUncalibratedRecHitSoA>(iConfig.getParameter<edm::InputTag>("src"))),
+      ebRecHitPutToken_(
+          produces<EBUncalibratedRecHitCollection>(iConfig.getParameter<std::string>("EBhitCollection"))),
+      eeRecHitPutToken_(
+          produces<EEUncalibratedRecHitCollection>(iConfig.getParameter<std::string>("EEhitCollection"))) {}
+
+void EcalUncalibratedRecHitCollectionFromSoA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("ecalUncalibRecHitSoAFromCUDA"));
+  desc.add<std::string>("EBhitCollection", "EcalUncalibRecHitsEB");
+  desc.add<std::string>("EEhitCollection", "EcalUncalibRecHitsEE");
+  descriptions.add("ecalUncalibratedRecHitCollectionFromSoA", desc);
+}
+
+void EcalUncalibratedRecHitCollectionFromSoA::produce(edm::StreamID,
+                                                      edm::Event& iEvent,
+                                                      const edm::EventSetup& iSetup) const {
+  auto const& soa = iEvent.get(recHitGetToken_);
+
+  auto convert = [&soa](auto& collection, uint32_t begin, uint32_t end) {
+    collection.reserve(end - begin);
+    for (uint32_t i = begin; i < end; ++i) {
+      collection.emplace_back(
+          DetId(soa.id[i]), soa.amplitude[i], soa.pedestal[i], soa.jitter[i], soa.chi2[i], soa.flags[i]);
+      auto& hit = collection.back();
+      hit.setAmplitudeError(soa.amplitudeError[i]);
+      for (uint32_t s = 0; s < EcalUncalibratedRecHitSoA::nSamples; ++s)
+        hit.setOutOfTimeAmplitude(s, soa.outOfTimeAmplitudes[i][s]);
+    }
+  };
+
+  EBUncalibratedRecHitCollection ebRecHits;
+  convert(ebRecHits, 0, soa.nBarrelRecHits);
+  EEUncalibratedRecHitCollection eeRecHits;
+  convert(eeRecHits, soa.nBarrelRecHits, soa.nRecHits);
+
+  iEvent.emplace(ebRecHitPutToken_, std::move(ebRecHits));
+  iEvent.emplace(eeRecHitPutToken_, std::move(eeRecHits));
+}
+
+DEFINE_FWK_MODULE(EcalUncalibratedRecHitCollectionFromSoA);
@@ -0,0 +1,59 @@
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiCUDA.h"
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiSoA.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+#include "../EcalDigiSoAFromLegacy.h"
+
+/**
+ * Copies the ECAL barrel and endcap digis of the unpacker to the device,
+ * as the EcalDigiSoA fitted by EcalUncalibRecHitProducerCUDA. An unpacker
+ * of the raw data on the GPU fills the same product.
+ */
+class EcalDigiProducerCUDA : public edm::global::EDProducer<> {
+public:
+  explicit EcalDigiProducerCUDA(const edm::ParameterSet& iConfig);
+  ~EcalDigiProducerCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<EBDigiCollection> ebDigiGetToken_;
+  const edm::EDGetTokenT<EEDigiCollection> eeDigiGetToken_;
+  const edm::EDPutTokenT<cms::cuda::Product<EcalDigiCUDA>> digiPutToken_;
+};
+
+EcalDigiProducerCUDA::EcalDigiProducerCUDA(const edm::ParameterSet& iConfig)
+    : ebDigiGetToken_(consumes<EBDigiCollection>(iConfig.getParameter<edm::InputTag>("EBdigiCollection"))),
+      eeDigiGetToken_(consumes<EEDigiCollection>(iConfig.getParameter<edm::InputTag>("EEdigiCollection"))),
+      digiPutToken_(produces<cms::cuda::Product<EcalDigiCUDA>>()) {}
+
+void EcalDigiProducerCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("EBdigiCollection", edm::InputTag("ecalDigis", "ebDigis"));
+  desc.add<edm::InputTag>("EEdigiCollection", edm::InputTag("ecalDigis", "eeDigis"));
+  descriptions.add("ecalDigiProducerCUDA", desc);
+}
+
+void EcalDigiProducerCUDA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  cms::cuda::ScopedContextProduce ctx{iEvent.streamID()};
+
+  // the pinned buffer is released once the copy queued on the stream is done
+  auto soa = cms::cuda::make_host_unique<EcalDigiSoA>(ctx.stream());
+  ecalMultifit::fillDigiSoA(iEvent.get(ebDigiGetToken_), iEvent.get(eeDigiGetToken_), *soa);
+
+  ctx.emplace(iEvent, digiPutToken_, EcalDigiCUDA(*soa, ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(EcalDigiProducerCUDA);
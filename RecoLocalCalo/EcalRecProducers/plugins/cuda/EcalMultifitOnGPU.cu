@@ -0,0 +1,40 @@
+#include <algorithm>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+#include "EcalMultifitOnGPU.h"
+
+namespace ecalMultifit {
+
+  namespace {
+
+    // the fit of a channel keeps its matrices in registers and local memory, few threads per block fill the device
+    constexpr uint32_t nThreads = 64;
+
+    __global__ void makeRecHitsKernel(EcalDigiSoA const* digis,
+                                      EcalMultifitConditions const* conditions,
+                                      Params params,
+                                      EcalUncalibratedRecHitSoA* recHits) {
+      uint32_t const first = blockIdx.x * blockDim.x + threadIdx.x;
+      if (first == 0) {
+        recHits->nRecHits = digis->nDigis;
+        recHits->nBarrelRecHits = digis->nBarrelDigis;
+      }
+      for (uint32_t i = first; i < digis->nDigis; i += blockDim.x * gridDim.x)
+        makeRecHit(*digis, i, *conditions, params, *recHits);
+    }
+
+  }  // namespace
+
+  EcalUncalibratedRecHitCUDA makeRecHitsAsync(EcalDigiCUDA const& digis,
+                                              EcalMultifitConditions const* conditions,
+                                              Params const& params,
+                                              cudaStream_t stream) {
+    EcalUncalibratedRecHitCUDA recHits(digis.nDigis(), stream);
+    uint32_t const blocks = std::max(1u, (digis.nDigis() + nThreads - 1) / nThreads);
+    makeRecHitsKernel<<<blocks, nThreads, 0, stream>>>(digis.get(), conditions, params, recHits.get());
+    cudaCheck(cudaGetLastError());
+    return recHits;
+  }
+
+}  // namespace ecalMultifit
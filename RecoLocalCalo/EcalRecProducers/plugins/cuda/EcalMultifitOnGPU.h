@@ -0,0 +1,23 @@
+#ifndef RecoLocalCalo_EcalRecProducers_plugins_cuda_EcalMultifitOnGPU_h
+#define RecoLocalCalo_EcalRecProducers_plugins_cuda_EcalMultifitOnGPU_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiCUDA.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitCUDA.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitAlgos.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+
+namespace ecalMultifit {
+
+  // Queues the multifit of all the digis on the stream, with one thread per
+  // channel: the rechits are returned at once, to be used only in the work
+  // queued on the same stream. The conditions are those of the device.
+  EcalUncalibratedRecHitCUDA makeRecHitsAsync(EcalDigiCUDA const& digis,
+                                              EcalMultifitConditions const* conditions,
+                                              Params const& params,
+                                              cudaStream_t stream);
+
+}  // namespace ecalMultifit
+
+#endif
@@ -0,0 +1,66 @@
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/EcalDigi/interface/EcalDigiCUDA.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitCUDA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsGPU.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditionsRcd.h"
+
+#include "../EcalMultifitParams.h"
+#include "EcalMultifitOnGPU.h"
+
+/**
+ * Fits the amplitudes of all the ECAL barrel and endcap digis of an event
+ * on the GPU, one channel per thread, with the fixed-size multifit of
+ * EcalMultifitAlgos.h. The rechits stay on the device,
+ * EcalUncalibRecHitSoAFromCUDA copies them to the host.
+ */
+class EcalUncalibRecHitProducerCUDA : public edm::global::EDProducer<> {
+public:
+  explicit EcalUncalibRecHitProducerCUDA(const edm::ParameterSet& iConfig);
+  ~EcalUncalibRecHitProducerCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<cms::cuda::Product<EcalDigiCUDA>> digiGetToken_;
+  const edm::ESGetToken<EcalMultifitConditionsGPU, EcalMultifitConditionsRcd> conditionsToken_;
+  const edm::EDPutTokenT<cms::cuda::Product<EcalUncalibratedRecHitCUDA>> recHitPutToken_;
+
+  const ecalMultifit::Params params_;
+};
+
+EcalUncalibRecHitProducerCUDA::EcalUncalibRecHitProducerCUDA(const edm::ParameterSet& iConfig)
+    : digiGetToken_(consumes<cms::cuda::Product<EcalDigiCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      conditionsToken_(esConsumes<EcalMultifitConditionsGPU, EcalMultifitConditionsRcd>()),
+      recHitPutToken_(produces<cms::cuda::Product<EcalUncalibratedRecHitCUDA>>()),
+      params_(ecalMultifit::makeParams(iConfig)) {}
+
+void EcalUncalibRecHitProducerCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("ecalDigiProducerCUDA"));
+  ecalMultifit::fillParamsDescription(desc);
+  descriptions.add("ecalUncalibRecHitProducerCUDA", desc);
+  descriptions.setComment(
+      std::string("The multifit of EcalUncalibRecHitWorkerMultiFit for all the ECAL channels at once, on the GPU. ") +
+      ecalMultifit::kLimitations);
+}
+
+void EcalUncalibRecHitProducerCUDA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  auto const& product = iEvent.get(digiGetToken_);
+  cms::cuda::ScopedContextProduce ctx{product};
+  auto const& digis = ctx.get(product);
+
+  auto const* conditions = iSetup.getData(conditionsToken_).getGPUProductAsync(ctx.stream());
+  ctx.emplace(iEvent, recHitPutToken_, ecalMultifit::makeRecHitsAsync(digis, conditions, params_, ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(EcalUncalibRecHitProducerCUDA);
@@ -0,0 +1,67 @@
+#include <cstring>
+#include <memory>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitCUDA.h"
+#include "CUDADataFormats/EcalRecHitSoA/interface/EcalUncalibratedRecHitSoA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * Copies the uncalibrated rechits fitted on the GPU back to the host, as
+ * the same EcalUncalibratedRecHitSoA filled by EcalUncalibRecHitProducerSoA.
+ */
+class EcalUncalibRecHitSoAFromCUDA : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit EcalUncalibRecHitSoAFromCUDA(const edm::ParameterSet& iConfig);
+  ~EcalUncalibRecHitSoAFromCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<EcalUncalibratedRecHitCUDA>> recHitGetToken_;
+  edm::EDPutTokenT<EcalUncalibratedRecHitSoA> recHitPutToken_;
+
+  cms::cuda::host::unique_ptr<EcalUncalibratedRecHitSoA> recHits_;
+};
+
+EcalUncalibRecHitSoAFromCUDA::EcalUncalibRecHitSoAFromCUDA(const edm::ParameterSet& iConfig)
+    : recHitGetToken_(
+          consumes<cms::cuda::Product<EcalUncalibratedRecHitCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      recHitPutToken_(produces<EcalUncalibratedRecHitSoA>()) {}
+
+void EcalUncalibRecHitSoAFromCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("ecalUncalibRecHitProducerCUDA"));
+  descriptions.add("ecalUncalibRecHitSoAFromCUDA", desc);
+}
+
+void EcalUncalibRecHitSoAFromCUDA::acquire(const edm::Event& iEvent,
+                                           const edm::EventSetup& iSetup,
+                                           edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  auto const& product = iEvent.get(recHitGetToken_);
+  cms::cuda::ScopedContextAcquire ctx{product, std::move(waitingTaskHolder)};
+  recHits_ = ctx.get(product).toHostAsync(ctx.stream());
+}
+
+void EcalUncalibRecHitSoAFromCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  // the pinned buffer goes back to the caching allocator, the product owns a copy
+  auto output = std::make_unique<EcalUncalibratedRecHitSoA>();
+  std::memcpy(output.get(), recHits_.get(), sizeof(EcalUncalibratedRecHitSoA));
+  iEvent.put(recHitPutToken_, std::move(output));
+  recHits_.reset();
+}
+
+DEFINE_FWK_MODULE(EcalUncalibRecHitSoAFromCUDA);
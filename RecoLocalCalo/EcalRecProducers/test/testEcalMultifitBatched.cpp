@@ -0,0 +1,210 @@
+// The batched multifit of EcalMultifitAlgos.h gives the rechits of EcalUncalibRecHitMultiFitAlgo
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "CondFormats/EcalObjects/interface/EcalGainRatios.h"
+#include "CondFormats/EcalObjects/interface/EcalPedestals.h"
+#include "CondFormats/EcalObjects/interface/EcalPulseCovariances.h"
+#include "CondFormats/EcalObjects/interface/EcalPulseShapes.h"
+#include "CondFormats/EcalObjects/interface/EcalSamplesCorrelation.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDigi/interface/EcalDigiCollections.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitAlgos.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalMultifitConditions.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/EcalUncalibRecHitMultiFitAlgo.h"
+#include "RecoLocalCalo/EcalRecProducers/plugins/EcalDigiSoAFromLegacy.h"
+
+namespace {
+
+  constexpr int nTemplateSamples = EcalPulseShape::TEMPLATESAMPLES;
+  const std::vector<int> activeBXs = {-5, -4, -3, -2, -1, 0, 1, 2, 3, 4};
+
+  // the same conditions for every crystal, with a pulse peaking at the template sample 2
+  struct Conditions {
+    Conditions() {
+      pedestal.mean_x12 = 200.f;
+      pedestal.rms_x12 = 1.1f;
+      pedestal.mean_x6 = 201.f;
+      pedestal.rms_x6 = 0.9f;
+      pedestal.mean_x1 = 199.f;
+      pedestal.rms_x1 = 0.8f;
+      gainRatio.setGain12Over6(1.9f);
+      gainRatio.setGain6Over1(5.8f);
+      for (int i = 0; i < nTemplateSamples; ++i) {
+        // an alpha-beta function of the time in units of 25 ns with respect to the maximum
+        double const t = 1. + (i - 2) / 1.7;
+        shape.pdfval[i] = t > 0. ? std::pow(t, 1.5) * std::exp(1.5 * (1. - t)) : 0.;
+      }
+      for (int i = 0; i < nTemplateSamples; ++i)
+        for (int j = 0; j < nTemplateSamples; ++j)
+          covariance.covval[i][j] = 1.e-5 * shape.pdfval[i] * shape.pdfval[j] * std::exp(-0.5 * std::abs(i - j));
+      for (int d = 0; d < int(EcalDataFrame::MAXSAMPLES); ++d) {
+        for (auto* correlation : {&correlations.EBG12SamplesCorrelation,
+                                  &correlations.EBG6SamplesCorrelation,
+                                  &correlations.EBG1SamplesCorrelation,
+                                  &correlations.EEG12SamplesCorrelation,
+                                  &correlations.EEG6SamplesCorrelation,
+                                  &correlations.EEG1SamplesCorrelation})
+          correlation->push_back(std::exp(-0.6 * d));
+      }
+      for (int gain = 0; gain < NGains; ++gain)
+        for (int i = 0; i < SampleVectorSize; ++i)
+          for (int j = 0; j < SampleVectorSize; ++j)
+            noisecors[gain](i, j) = correlations.EBG12SamplesCorrelation[std::abs(i - j)];
+      fullpulse.setZero();
+      fullpulsecov.setZero();
+      for (int i = 0; i < nTemplateSamples; ++i) {
+        fullpulse(i + 7) = shape.pdfval[i];
+        for (int j = 0; j < nTemplateSamples; ++j)
+          fullpulsecov(i + 7, j + 7) = covariance.covval[i][j];
+      }
+    }
+
+    // the conditions of the batched multifit, for all the crystals
+    std::unique_ptr<EcalMultifitConditions> makeBatched() const {
+      EcalCondObjectContainer<EcalPedestal> pedestals;
+      EcalCondObjectContainer<EcalMGPAGainRatio> gainRatios;
+      EcalCondObjectContainer<EcalPulseShape> shapes;
+      EcalCondObjectContainer<EcalPulseCovariance> covariances;
+      auto fill = [&](uint32_t id) {
+        pedestals.setValue(id, pedestal);
+        gainRatios.setValue(id, gainRatio);
+        shapes.setValue(id, shape);
+        covariances.setValue(id, covariance);
+      };
+      for (int i = 0; i < EBDetId::kSizeForDenseIndexing; ++i)
+        fill(EBDetId::unhashIndex(i).rawId());
+      for (int i = 0; i < EEDetId::kSizeForDenseIndexing; ++i)
+        fill(EEDetId::unhashIndex(i).rawId());
+      return std::make_unique<EcalMultifitConditions>(pedestals, gainRatios, shapes, covariances, correlations);
+    }
+
+    EcalPedestal pedestal;
+    EcalMGPAGainRatio gainRatio;
+    EcalPulseShape shape;
+    EcalPulseCovariance covariance;
+    EcalSamplesCorrelation correlations;
+    SampleMatrixGainArray noisecors;
+    FullSampleVector fullpulse;
+    FullSampleMatrix fullpulsecov;
+  };
+
+  // the samples of an in-time pulse with out-of-time pileup and noise, switching gain above 4000 ADC counts
+  void makeSamples(std::mt19937& rng, Conditions const& conditions, uint16_t* samples) {
+    std::uniform_real_distribution<double> flat(0., 1.);
+    std::exponential_distribution<double> amplitude(1. / 300.);
+    std::normal_distribution<double> noise(0., 1.);
+    double signal[EcalDataFrame::MAXSAMPLES] = {0.};
+    for (int bx : activeBXs) {
+      // a few very large pulses, to switch gain
+      double const a = bx == 0 ? (flat(rng) < 0.05 ? 100. : 1.) * amplitude(rng)
+                               : (flat(rng) < 0.3 ? 0.2 * amplitude(rng) : 0.);
+      for (int s = 0; s < int(EcalDataFrame::MAXSAMPLES); ++s) {
+        int const t = s - 3 - bx;
+        if (t >= 0 && t < nTemplateSamples)
+          signal[s] += a * conditions.shape.pdfval[t];
+      }
+    }
+    auto const& pedestal = conditions.pedestal;
+    for (int s = 0; s < int(EcalDataFrame::MAXSAMPLES); ++s) {
+      double adc = pedestal.mean_x12 + signal[s] + pedestal.rms_x12 * noise(rng);
+      int gainId = 1;
+      if (adc > 4000.) {
+        adc = pedestal.mean_x6 + signal[s] / conditions.gainRatio.gain12Over6() + pedestal.rms_x6 * noise(rng);
+        gainId = 2;
+      }
+      if (adc > 4000.) {
+        adc = pedestal.mean_x1 + signal[s] / conditions.gainRatio.gain12Over6() / conditions.gainRatio.gain6Over1() +
+              pedestal.rms_x1 * noise(rng);
+        gainId = 3;
+      }
+      samples[s] = EcalMGPASample(std::min(std::max(int(std::lround(adc)), 0), 4095), gainId).raw();
+    }
+  }
+
+  bool close(double a, double b, double tolerance) {
+    return std::abs(a - b) <= tolerance * (1. + std::abs(b)) || (std::isnan(a) && std::isnan(b));
+  }
+
+}  // namespace
+
+int main() {
+  constexpr double tolerance = 1.e-3;
+  Conditions const conditions;
+  auto const batchedConditions = conditions.makeBatched();
+
+  std::mt19937 rng(42);
+  EBDigiCollection ebDigis;
+  EEDigiCollection eeDigis;
+  uint16_t samples[EcalDataFrame::MAXSAMPLES];
+  for (int i = 0; i < 400; ++i) {
+    makeSamples(rng, conditions, samples);
+    ebDigis.push_back(EBDetId::unhashIndex(i * 150).rawId(), samples);
+  }
+  for (int i = 0; i < 100; ++i) {
+    makeSamples(rng, conditions, samples);
+    eeDigis.push_back(EEDetId::unhashIndex(i * 140).rawId(), samples);
+  }
+
+  auto digis = std::make_unique<EcalDigiSoA>();
+  ecalMultifit::fillDigiSoA(ebDigis, eeDigis, *digis);
+  ecalMultifit::Params params;
+  params.nActiveBXs = activeBXs.size();
+  std::copy(activeBXs.begin(), activeBXs.end(), params.activeBXs);
+  params.computeErrors = true;
+  params.simplifiedNoiseModelForGainSwitch = true;
+  params.gainSwitchUseMaxSample[0] = params.gainSwitchUseMaxSample[1] = false;
+  params.addPedestalUncertainty[0] = params.addPedestalUncertainty[1] = 0.;
+  params.maxIterations = 50;
+  auto recHits = std::make_unique<EcalUncalibratedRecHitSoA>();
+  for (uint32_t i = 0; i < digis->nDigis; ++i)
+    ecalMultifit::makeRecHit(*digis, i, *batchedConditions, params, *recHits);
+
+  BXVector bxs(activeBXs.size());
+  for (unsigned int i = 0; i < activeBXs.size(); ++i)
+    bxs[i] = activeBXs[i];
+  EcalUncalibRecHitMultiFitAlgo multiFit;
+  int failures = 0;
+  int gainSwitches = 0;
+  uint32_t i = 0;
+  auto compare = [&](EcalDigiCollection const& collection) {
+    for (auto itdg = collection.begin(); itdg != collection.end(); ++itdg, ++i) {
+      EcalDataFrame const frame(*itdg);
+      EcalUncalibratedRecHit const expected = multiFit.makeRecHit(frame,
+                                                                  &conditions.pedestal,
+                                                                  &conditions.gainRatio,
+                                                                  conditions.noisecors,
+                                                                  conditions.fullpulse,
+                                                                  conditions.fullpulsecov,
+                                                                  bxs);
+      gainSwitches += frame.hasSwitchToGain6() || frame.hasSwitchToGain1();
+      bool ok = recHits->id[i] == expected.id().rawId() &&
+                close(recHits->amplitude[i], expected.amplitude(), tolerance) &&
+                close(recHits->amplitudeError[i], expected.amplitudeError(), tolerance) &&
+                close(recHits->chi2[i], expected.chi2(), tolerance) &&
+                close(recHits->pedestal[i], expected.pedestal(), tolerance);
+      for (int s = 0; s < int(EcalDataFrame::MAXSAMPLES); ++s) {
+        if (s != ecalMultifit::iSampleMax)
+          ok &= close(recHits->outOfTimeAmplitudes[i][s], expected.outOfTimeAmplitude(s), tolerance);
+      }
+      if (!ok) {
+        ++failures;
+        std::cout << "digi " << i << ": amplitude " << recHits->amplitude[i] << " expected " << expected.amplitude()
+                  << ", error " << recHits->amplitudeError[i] << " expected " << expected.amplitudeError()
+                  << ", chi2 " << recHits->chi2[i] << " expected " << expected.chi2() << std::endl;
+      }
+    }
+  };
+  compare(ebDigis);
+  compare(eeDigis);
+
+  std::cout << digis->nDigis << " digis, " << gainSwitches << " with a gain switch, " << failures
+            << " different from EcalUncalibRecHitMultiFitAlgo" << std::endl;
+  return failures == 0 && gainSwitches > 0 ? 0 : 1;
+}
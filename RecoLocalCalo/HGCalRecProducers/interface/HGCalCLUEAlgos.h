@@ -0,0 +1,463 @@
+#ifndef RecoLocalCalo_HGCalRecProducers_HGCalCLUEAlgos_h
+#define RecoLocalCalo_HGCalRecProducers_HGCalCLUEAlgos_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__CUDACC__)
+#define HGCALCLUE_HOST_DEVICE __host__ __device__
+#else
+#define HGCALCLUE_HOST_DEVICE
+#endif
+
+// The steps of the CLUE clustering of HGCalCLUEAlgoT, for all the layers of an event
+// at once, written for cells stored as arrays so that the CUDA kernels can run them
+// with one thread per cell. Each step loops over its elements from first with the
+// given stride, and the steps run in this order, each one after all the threads of
+// the previous one are done:
+//   countTiles, scanTiles, fillTiles, sortTiles, calculateLocalDensity,
+//   calculateDistanceToHigher, findSeeds, assignClusters
+//
+// The tiles of a layer are those of HGCalLayerTilesT, and the cells of each tile are
+// sorted by index, so that the densities are summed in the order of HGCalCLUEAlgoT
+// and the ties of the nearest higher are broken in the same way. The arithmetic is
+// rounded as on the host, without fused multiply-adds, and the clusters are those of
+// HGCalCLUEAlgoT. Instead of the followers of each seed, each cell walks its chain of
+// nearest highers, up to a seed, or up to an outlier to be left out of the clusters.
+namespace hgcalCLUE {
+
+  // a cell is in its x-y tile, and for the scintillator in its eta-phi tile and in one of the copies at phi +- 2 pi
+  constexpr uint32_t maxTilesPerCell = 3;
+
+  // the settings of HGCalCLUEAlgoT which are the same for all the layers
+  struct Params {
+    float deltaR;  // the critical distance in eta-phi, for the scintillator
+    float outlierDeltaFactor;
+    bool use2x2;
+    int scintMaxIphi;
+  };
+
+  struct Sizes {
+    uint32_t nCells;
+    uint32_t nLayers;
+  };
+
+  // The cells of an event, as arrays in host or device memory. The cells
+  // of the layer l are at [layerOffsets[l], layerOffsets[l + 1]), in the
+  // order of HGCalCLUEAlgoT::populate, and the indices of nearestHigher
+  // and clusterIndex are counted from the first cell of the layer.
+  struct Cells {
+    uint32_t size;
+    uint32_t nLayers;
+
+    // the inputs, as in HGCalCLUEAlgoT::CellsOnLayer
+    uint32_t* detid;
+    float* x;
+    float* y;
+    float* eta;
+    float* phi;
+    float* weight;
+    float* rhoC;      // kappa times the sigma noise
+    int16_t* iEta;    // of the HGCScintillatorDetId
+    int16_t* iPhi;    // of the HGCScintillatorDetId
+    uint16_t* layer;  // with the offset of the side
+    uint8_t* isSi;
+
+    // the inputs of the layers
+    uint32_t* layerOffsets;  // nLayers + 1
+    float* deltaC;           // nLayers, the critical distance in x-y, for the silicon
+
+    // the outputs of HGCalCLUEAlgoT::makeClusters
+    float* rho;
+    float* delta;
+    int32_t* nearestHigher;
+    int32_t* clusterIndex;
+    uint8_t* isSeed;
+    uint32_t* nClusters;  // nLayers
+
+    static constexpr size_t aligned(size_t bytes) { return (bytes + 127) / 128 * 128; }
+    static constexpr size_t inputBytes(uint32_t n, uint32_t nLayers) {
+      return aligned(n * (sizeof(uint32_t) + 6 * sizeof(float) + 3 * sizeof(int16_t) + sizeof(uint8_t))) +
+             aligned((2 * nLayers + 1) * sizeof(uint32_t));
+    }
+    static constexpr size_t outputBytes(uint32_t n, uint32_t nLayers) {
+      return aligned(n * (2 * sizeof(float) + 2 * sizeof(int32_t) + sizeof(uint8_t))) +
+             aligned(nLayers * sizeof(uint32_t));
+    }
+
+    // the arrays of n cells in a buffer of inputBytes(n) + outputBytes(n), the outputs after the inputs
+    void setBuffer(char* buffer, uint32_t n, uint32_t nL) {
+      size = n;
+      nLayers = nL;
+      auto next = [&buffer](auto*& array, size_t count) {
+        array = reinterpret_cast<std::remove_reference_t<decltype(array)>>(buffer);
+        buffer += count * sizeof(*array);
+      };
+      char* const begin = buffer;
+      next(detid, n);
+      next(x, n);
+      next(y, n);
+      next(eta, n);
+      next(phi, n);
+      next(weight, n);
+      next(rhoC, n);
+      next(iEta, n);
+      next(iPhi, n);
+      next(layer, n);
+      next(isSi, n);
+      buffer = begin + aligned(buffer - begin);
+      next(layerOffsets, nLayers + 1);
+      next(deltaC, nLayers);
+      buffer = begin + inputBytes(n, nLayers);
+      char* const outputs = buffer;
+      next(rho, n);
+      next(delta, n);
+      next(nearestHigher, n);
+      next(clusterIndex, n);
+      next(isSeed, n);
+      buffer = outputs + aligned(buffer - outputs);
+      next(nClusters, nLayers);
+    }
+  };
+
+  // The tiles of all the layers, T::nTiles for each layer. The cells of
+  // the tile b of the layer l are at [start[k], start[k] + count[k]) in
+  // cells, with k = l * T::nTiles + b, and those of the layer l start at
+  // maxTilesPerCell * layerOffsets[l].
+  struct Tiles {
+    uint32_t* start;
+    uint32_t* count;  // set to 0 before countTiles
+    uint32_t* fill;   // set to 0 before fillTiles
+    uint32_t* cells;  // maxTilesPerCell * number of cells, by index in the layer
+  };
+
+  HGCALCLUE_HOST_DEVICE inline uint32_t atomicIncrement(uint32_t* counter) {
+#if defined(__CUDA_ARCH__)
+    return atomicAdd(counter, 1u);
+#else
+    return (*counter)++;
+#endif
+  }
+
+  // the products and sums rounded as on the host, where they are not contracted into fused multiply-adds
+  HGCALCLUE_HOST_DEVICE inline float mul(float a, float b) {
+#if defined(__CUDA_ARCH__)
+    return __fmul_rn(a, b);
+#else
+    return a * b;
+#endif
+  }
+
+  HGCALCLUE_HOST_DEVICE inline float add(float a, float b) {
+#if defined(__CUDA_ARCH__)
+    return __fadd_rn(a, b);
+#else
+    return a + b;
+#endif
+  }
+
+  // as reco::reduceRange
+  HGCALCLUE_HOST_DEVICE inline float deltaPhi(float phi1, float phi2) {
+    constexpr float o2pi = 1. / (2. * M_PI);
+    float const x = phi1 - phi2;
+    if (std::abs(x) <= float(M_PI))
+      return x;
+    float const n = std::round(mul(x, o2pi));
+    return x - mul(n, float(2. * M_PI));
+  }
+
+  HGCALCLUE_HOST_DEVICE inline float distance(Cells const& cells, uint32_t i, uint32_t j, bool isEtaPhi) {
+    float dist2;
+    if (isEtaPhi) {
+      float const dphi = deltaPhi(cells.phi[i], cells.phi[j]);
+      float const deta = cells.eta[i] - cells.eta[j];
+      dist2 = add(mul(deta, deta), mul(dphi, dphi));
+    } else {
+      float const dx = cells.x[i] - cells.x[j];
+      float const dy = cells.y[i] - cells.y[j];
+      dist2 = add(mul(dx, dx), mul(dy, dy));
+    }
+    return std::sqrt(dist2);
+  }
+
+  // the bins of HGCalLayerTilesT
+  HGCALCLUE_HOST_DEVICE inline int clampBin(float value, float min, float max, int nBins) {
+    float const r = nBins / (max - min);
+    int bin = mul(value - min, r);
+    return bin < 0 ? 0 : (bin > nBins - 1 ? nBins - 1 : bin);
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline int xBin(float x) {
+    return clampBin(x, T::minX, T::maxX, T::nColumns);
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline int yBin(float y) {
+    return clampBin(y, T::minY, T::maxY, T::nRows);
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline int etaBin(float eta) {
+    return clampBin(eta, T::minEta, T::maxEta, T::nColumnsEta);
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline int phiBin(float phi) {
+    return clampBin(phi, T::minPhi, T::maxPhi, T::nRowsPhi);
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline int globalBinByBin(int xBin, int yBin) {
+    return xBin + yBin * T::nColumns;
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline int globalBinByBinEtaPhi(int etaBin, int phiBin) {
+    return T::nColumns * T::nRows + etaBin + phiBin * T::nColumnsEta;
+  }
+
+  // Calls f for each tile of the cell i, in the order of HGCalLayerTilesT::fill
+  template <typename T, typename F>
+  HGCALCLUE_HOST_DEVICE inline void forEachTile(Cells const& cells, uint32_t i, F&& f) {
+    f(globalBinByBin<T>(xBin<T>(cells.x[i]), yBin<T>(cells.y[i])));
+    if (cells.isSi[i])
+      return;
+    float const eta = cells.eta[i];
+    float const phi = cells.phi[i];
+    int const bin = phiBin<T>(phi);
+    f(globalBinByBinEtaPhi<T>(etaBin<T>(eta), bin));
+    if (bin == phiBin<T>(-M_PI))
+      f(globalBinByBinEtaPhi<T>(etaBin<T>(eta), phiBin<T>(phi + 2 * M_PI)));
+    if (bin == phiBin<T>(M_PI))
+      f(globalBinByBinEtaPhi<T>(etaBin<T>(eta), phiBin<T>(phi - 2 * M_PI)));
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline void countTiles(Cells const& cells, Tiles tiles, uint32_t first, uint32_t stride) {
+    for (uint32_t i = first; i < cells.size; i += stride) {
+      uint32_t* const count = tiles.count + cells.layer[i] * T::nTiles;
+      forEachTile<T>(cells, i, [count](int bin) { atomicIncrement(&count[bin]); });
+    }
+  }
+
+  // one thread per layer
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline void scanTiles(Cells const& cells, Tiles tiles, uint32_t first, uint32_t stride) {
+    for (uint32_t l = first; l < cells.nLayers; l += stride) {
+      uint32_t offset = maxTilesPerCell * cells.layerOffsets[l];
+      for (uint32_t k = l * T::nTiles; k < (l + 1) * T::nTiles; ++k) {
+        tiles.start[k] = offset;
+        offset += tiles.count[k];
+      }
+    }
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline void fillTiles(Cells const& cells, Tiles tiles, uint32_t first, uint32_t stride) {
+    for (uint32_t i = first; i < cells.size; i += stride) {
+      uint32_t const k = cells.layer[i] * T::nTiles;
+      uint32_t const j = i - cells.layerOffsets[cells.layer[i]];
+      forEachTile<T>(cells, i, [&tiles, k, j](int bin) {
+        tiles.cells[tiles.start[k + bin] + atomicIncrement(&tiles.fill[k + bin])] = j;
+      });
+    }
+  }
+
+  // the tiles hold few cells, they are sorted by insertion
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline void sortTiles(Cells const& cells, Tiles tiles, uint32_t first, uint32_t stride) {
+    for (uint32_t k = first; k < cells.nLayers * T::nTiles; k += stride) {
+      uint32_t* const tile = tiles.cells + tiles.start[k];
+      for (uint32_t a = 1; a < tiles.count[k]; ++a) {
+        uint32_t const j = tile[a];
+        uint32_t b = a;
+        for (; b > 0 && tile[b - 1] > j; --b)
+          tile[b] = tile[b - 1];
+        tile[b] = j;
+      }
+    }
+  }
+
+  // Calls f for the index in the layer of each cell of the tiles from
+  // [binMin0, binMax0] x [binMin1, binMax1], in the order of HGCalCLUEAlgoT
+  template <typename T, typename F>
+  HGCALCLUE_HOST_DEVICE inline void forEachCellInBox(
+      Tiles const& tiles, uint32_t l, bool isEtaPhi, int binMin0, int binMax0, int binMin1, int binMax1, F&& f) {
+    for (int bin0 = binMin0; bin0 < binMax0 + 1; ++bin0) {
+      for (int bin1 = binMin1; bin1 < binMax1 + 1; ++bin1) {
+        uint32_t const k =
+            l * T::nTiles + (isEtaPhi ? globalBinByBinEtaPhi<T>(bin0, bin1) : globalBinByBin<T>(bin0, bin1));
+        for (uint32_t c = tiles.start[k]; c < tiles.start[k] + tiles.count[k]; ++c)
+          f(tiles.cells[c]);
+      }
+    }
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline void calculateLocalDensity(
+      Cells const& cells, Tiles const& tiles, Params const& params, uint32_t first, uint32_t stride) {
+    for (uint32_t i = first; i < cells.size; i += stride) {
+      uint32_t const l = cells.layer[i];
+      uint32_t const offset = cells.layerOffsets[l];
+      float rho = 0.f;
+      if (cells.isSi[i]) {
+        float const delta = cells.deltaC[l];
+        float const x = cells.x[i];
+        float const y = cells.y[i];
+        forEachCellInBox<T>(tiles,
+                            l,
+                            false,
+                            xBin<T>(x - delta),
+                            xBin<T>(x + delta),
+                            yBin<T>(y - delta),
+                            yBin<T>(y + delta),
+                            [&](uint32_t j) {
+                              uint32_t const other = offset + j;
+                              // silicon cells cannot talk to scintillator cells
+                              if (cells.isSi[other] && distance(cells, i, other, false) < delta)
+                                rho = add(rho, mul(other == i ? 1.f : 0.5f, cells.weight[other]));
+                            });
+      } else {
+        float const delta = params.deltaR;
+        float const eta = cells.eta[i];
+        float const phi = cells.phi[i];
+        rho = add(rho, cells.weight[i]);
+        float northeast = 0.f, northwest = 0.f, southeast = 0.f, southwest = 0.f, all = 0.f;
+        forEachCellInBox<T>(tiles,
+                            l,
+                            true,
+                            etaBin<T>(eta - delta),
+                            etaBin<T>(eta + delta),
+                            phiBin<T>(phi - delta),
+                            phiBin<T>(phi + delta),
+                            [&](uint32_t j) {
+                              uint32_t const other = offset + j;
+                              // scintillator cells cannot talk to silicon cells
+                              if (cells.isSi[other] || !(distance(cells, i, other, true) < delta) || other == i)
+                                return;
+                              int dIPhi = cells.iPhi[other] - cells.iPhi[i];
+                              // cells with iPhi = scintMaxIphi and iPhi = 1 are neighbours
+                              dIPhi += std::abs(dIPhi) < 2 ? 0
+                                                           : (dIPhi < 0 ? params.scintMaxIphi : -params.scintMaxIphi);
+                              int const dIEta = cells.iEta[other] - cells.iEta[i];
+                              float const contribution = mul(0.5f, cells.weight[other]);
+                              all = add(all, contribution);
+                              if (dIPhi >= 0 && dIEta >= 0)
+                                northeast = add(northeast, contribution);
+                              if (dIPhi <= 0 && dIEta >= 0)
+                                southeast = add(southeast, contribution);
+                              if (dIPhi >= 0 && dIEta <= 0)
+                                northwest = add(northwest, contribution);
+                              if (dIPhi <= 0 && dIEta <= 0)
+                                southwest = add(southwest, contribution);
+                            });
+        float const north = northeast > northwest ? northeast : northwest;
+        float const south = southeast > southwest ? southeast : southwest;
+        rho = add(rho, params.use2x2 ? (north > south ? north : south) : all);
+      }
+      cells.rho[i] = rho;
+    }
+  }
+
+  template <typename T>
+  HGCALCLUE_HOST_DEVICE inline void calculateDistanceToHigher(
+      Cells const& cells, Tiles const& tiles, Params const& params, uint32_t first, uint32_t stride) {
+    constexpr float maxDelta = std::numeric_limits<float>::max();
+    for (uint32_t i = first; i < cells.size; i += stride) {
+      uint32_t const l = cells.layer[i];
+      uint32_t const offset = cells.layerOffsets[l];
+      bool const isSi = cells.isSi[i];
+      float const rho = cells.rho[i];
+      float iDelta = maxDelta;
+      int32_t iNearestHigher = -1;
+      // the search box covers a range outlierDeltaFactor * delta
+      float const range = mul(params.outlierDeltaFactor, isSi ? cells.deltaC[l] : params.deltaR);
+      auto higher = [&](uint32_t j) {
+        uint32_t const other = offset + j;
+        // silicon cells cannot talk to scintillator cells
+        if (bool(cells.isSi[other]) != isSi)
+          return;
+        float const dist = distance(cells, i, other, !isSi);
+        bool const foundHigher =
+            cells.rho[other] > rho || (cells.rho[other] == rho && cells.detid[other] > cells.detid[i]);
+        // if dist == iDelta, then the last comer is the nearest higher
+        if (foundHigher && dist <= iDelta) {
+          iDelta = dist;
+          iNearestHigher = j;
+        }
+      };
+      if (isSi)
+        forEachCellInBox<T>(tiles,
+                            l,
+                            false,
+                            xBin<T>(cells.x[i] - range),
+                            xBin<T>(cells.x[i] + range),
+                            yBin<T>(cells.y[i] - range),
+                            yBin<T>(cells.y[i] + range),
+                            higher);
+      else
+        forEachCellInBox<T>(tiles,
+                            l,
+                            true,
+                            etaBin<T>(cells.eta[i] - range),
+                            etaBin<T>(cells.eta[i] + range),
+                            phiBin<T>(cells.phi[i] - range),
+                            phiBin<T>(cells.phi[i] + range),
+                            higher);
+      // otherwise delta is guaranteed to be larger than outlierDeltaFactor * delta
+      cells.delta[i] = iDelta;
+      cells.nearestHigher[i] = iDelta != maxDelta ? iNearestHigher : -1;
+    }
+  }
+
+  // one thread per layer, which numbers the seeds of the layer in the order of its cells
+  HGCALCLUE_HOST_DEVICE inline void findSeeds(Cells const& cells,
+                                              Params const& params,
+                                              uint32_t first,
+                                              uint32_t stride) {
+    for (uint32_t l = first; l < cells.nLayers; l += stride) {
+      uint32_t nClusters = 0;
+      for (uint32_t i = cells.layerOffsets[l]; i < cells.layerOffsets[l + 1]; ++i) {
+        float const delta = cells.isSi[i] ? cells.deltaC[l] : params.deltaR;
+        bool const isSeed = cells.delta[i] > delta && cells.rho[i] >= cells.rhoC[i];
+        cells.isSeed[i] = isSeed;
+        cells.clusterIndex[i] = isSeed ? nClusters++ : -1;
+      }
+      cells.nClusters[l] = nClusters;
+    }
+  }
+
+  HGCALCLUE_HOST_DEVICE inline void assignClusters(Cells const& cells,
+                                                   Params const& params,
+                                                   uint32_t first,
+                                                   uint32_t stride) {
+    for (uint32_t i = first; i < cells.size; i += stride) {
+      if (cells.isSeed[i])
+        continue;
+      uint32_t const l = cells.layer[i];
+      uint32_t const offset = cells.layerOffsets[l];
+      // the outliers are not followers of their nearest higher, and their followers are not in a cluster
+      int32_t clusterIndex = -1;
+      for (uint32_t c = i;;) {
+        float const delta = cells.isSi[c] ? cells.deltaC[l] : params.deltaR;
+        bool const isOutlier =
+            cells.delta[c] > mul(params.outlierDeltaFactor, delta) && cells.rho[c] < cells.rhoC[c];
+        if (isOutlier || cells.nearestHigher[c] < 0)
+          break;
+        c = offset + cells.nearestHigher[c];
+        if (cells.isSeed[c]) {
+          clusterIndex = cells.clusterIndex[c];
+          break;
+        }
+      }
+      cells.clusterIndex[i] = clusterIndex;
+    }
+  }
+
+}  // namespace hgcalCLUE
+
+#endif
@@ -2,12 +2,14 @@
 #define RecoLocalCalo_HGCalRecProducers_HGCalClusteringAlgoBase_h
 
 #include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "DataFormats/HGCRecHit/interface/HGCRecHitCollections.h"
 #include "DataFormats/Math/interface/Point3D.h"
 #include "DataFormats/EgammaReco/interface/BasicCluster.h"
 
 #include "RecoLocalCalo/HGCalRecAlgos/interface/RecHitTools.h"
+#include "RecoLocalCalo/HGCalRecProducers/interface/HGCalCLUEAlgos.h"
 
 // C/C++ headers
 #include <vector>
@@ -58,6 +60,13 @@ public:
   virtual hgcal_clustering::Density getDensity() = 0;
   virtual void getEventSetupPerAlgorithm(const edm::EventSetup &es) {}
 
+  // The clustering of the cells of populate() by the steps of hgcalCLUE, in place of makeClusters(): the sizes of
+  // the batch of cells, the export of the inputs of the batch, and the import of its outputs before getClusters().
+  // Only the CLUE algorithms support it.
+  virtual hgcalCLUE::Sizes batchSizes() const { throw unsupportedBatch(); }
+  virtual void exportBatch(hgcalCLUE::Cells &cells, hgcalCLUE::Params &params) const { throw unsupportedBatch(); }
+  virtual void importBatch(const hgcalCLUE::Cells &cells) { throw unsupportedBatch(); }
+
   inline void getEventSetup(const edm::EventSetup &es) {
     rhtools_.getEventSetup(es);
     maxlayer_ = rhtools_.lastLayer(isNose_);
@@ -83,6 +92,10 @@ public:
   bool isNose_;
 
 protected:
+  static cms::Exception unsupportedBatch() {
+    return cms::Exception("Configuration") << "the batched clustering is only supported by the CLUE algorithms";
+  }
+
   // The verbosity level
   VerbosityLevel verbosity_;
 
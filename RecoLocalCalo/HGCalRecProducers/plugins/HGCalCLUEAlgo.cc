@@ -100,14 +100,7 @@ void HGCalCLUEAlgoT<T>::makeClusters() {
       T lt;
       lt.clear();
       lt.fill(cells_[i].x, cells_[i].y, cells_[i].eta, cells_[i].phi, cells_[i].isSi);
-      float delta_c;  // maximum search distance (critical distance) for local
-                      // density calculation
-      if (i % maxlayer_ < lastLayerEE_)
-        delta_c = vecDeltas_[0];
-      else if (i % maxlayer_ < (firstLayerBH_ - 1))
-        delta_c = vecDeltas_[1];
-      else
-        delta_c = vecDeltas_[2];
+      float delta_c = criticalDistance(i);
       float delta_r = vecDeltas_[3];
       LogDebug("HGCalCLUEAlgo") << "maxlayer: " << maxlayer_ << " lastLayerEE: " << lastLayerEE_
                                 << " firstLayerBH: " << firstLayerBH_ << "\n";
@@ -123,59 +116,123 @@ void HGCalCLUEAlgoT<T>::makeClusters() {
   }
 }
 
+template <typename T>
+float HGCalCLUEAlgoT<T>::criticalDistance(const unsigned int layerId) const {
+  // maximum search distance (critical distance) for local density calculation
+  if (layerId % maxlayer_ < lastLayerEE_)
+    return vecDeltas_[0];
+  else if (layerId % maxlayer_ < (firstLayerBH_ - 1))
+    return vecDeltas_[1];
+  else
+    return vecDeltas_[2];
+}
+
+template <typename T>
+hgcalCLUE::Sizes HGCalCLUEAlgoT<T>::batchSizes() const {
+  hgcalCLUE::Sizes sizes{0, 2 * maxlayer_ + 2};
+  for (unsigned int i = 0; i < sizes.nLayers; ++i)
+    sizes.nCells += cells_[i].detid.size();
+  return sizes;
+}
+
+template <typename T>
+void HGCalCLUEAlgoT<T>::exportBatch(hgcalCLUE::Cells& cells, hgcalCLUE::Params& params) const {
+  params.deltaR = vecDeltas_[3];
+  params.outlierDeltaFactor = outlierDeltaFactor_;
+  params.use2x2 = use2x2_;
+  params.scintMaxIphi = scintMaxIphi_;
+
+  unsigned int j = 0;
+  for (unsigned int layerId = 0; layerId < cells.nLayers; ++layerId) {
+    auto const& cellsOnLayer = cells_[layerId];
+    // the silicon only layers have no isSi, eta and phi before prepareDataStructures
+    bool isOnlySi = rhtools_.isOnlySilicon(layerId);
+    cells.layerOffsets[layerId] = j;
+    cells.deltaC[layerId] = criticalDistance(layerId);
+    for (unsigned int i = 0; i < cellsOnLayer.detid.size(); ++i, ++j) {
+      bool isSi = isOnlySi || cellsOnLayer.isSi[i];
+      cells.detid[j] = cellsOnLayer.detid[i].rawId();
+      cells.x[j] = cellsOnLayer.x[i];
+      cells.y[j] = cellsOnLayer.y[i];
+      cells.eta[j] = isOnlySi ? 0.f : cellsOnLayer.eta[i];
+      cells.phi[j] = isOnlySi ? 0.f : cellsOnLayer.phi[i];
+      cells.weight[j] = cellsOnLayer.weight[i];
+      cells.rhoC[j] = kappa_ * cellsOnLayer.sigmaNoise[i];
+      cells.iEta[j] = isSi ? 0 : HGCScintillatorDetId(cellsOnLayer.detid[i]).ieta();
+      cells.iPhi[j] = isSi ? 0 : HGCScintillatorDetId(cellsOnLayer.detid[i]).iphi();
+      cells.layer[j] = layerId;
+      cells.isSi[j] = isSi;
+    }
+  }
+  cells.layerOffsets[cells.nLayers] = j;
+}
+
+template <typename T>
+void HGCalCLUEAlgoT<T>::importBatch(const hgcalCLUE::Cells& cells) {
+  for (unsigned int layerId = 0; layerId < cells.nLayers; ++layerId) {
+    prepareDataStructures(layerId);
+    auto& cellsOnLayer = cells_[layerId];
+    unsigned int offset = cells.layerOffsets[layerId];
+    for (unsigned int i = 0; i < cellsOnLayer.detid.size(); ++i) {
+      cellsOnLayer.rho[i] = cells.rho[offset + i];
+      cellsOnLayer.delta[i] = cells.delta[offset + i];
+      cellsOnLayer.nearestHigher[i] = cells.nearestHigher[offset + i];
+      cellsOnLayer.clusterIndex[i] = cells.clusterIndex[offset + i];
+      cellsOnLayer.isSeed[i] = cells.isSeed[offset + i];
+    }
+    numberOfClustersPerLayer_[layerId] = cells.nClusters[layerId];
+    setDensity(layerId);
+  }
+}
+
 template <typename T>
 std::vector<reco::BasicCluster> HGCalCLUEAlgoT<T>::getClusters(bool) {
   std::vector<int> offsets(numberOfClustersPerLayer_.size(), 0);
 
-  int maxClustersOnLayer = numberOfClustersPerLayer_[0];
-
   for (unsigned layerId = 1; layerId < offsets.size(); ++layerId) {
     offsets[layerId] = offsets[layerId - 1] + numberOfClustersPerLayer_[layerId - 1];
-
-    maxClustersOnLayer = std::max(maxClustersOnLayer, numberOfClustersPerLayer_[layerId]);
   }
 
   auto totalNumberOfClusters = offsets.back() + numberOfClustersPerLayer_.back();
   clusters_v_.resize(totalNumberOfClusters);
-  std::vector<std::vector<int>> cellsIdInCluster;
-  cellsIdInCluster.reserve(maxClustersOnLayer);
-
-  for (unsigned int layerId = 0; layerId < 2 * maxlayer_ + 2; ++layerId) {
-    cellsIdInCluster.resize(numberOfClustersPerLayer_[layerId]);
-    auto& cellsOnLayer = cells_[layerId];
-    unsigned int numberOfCells = cellsOnLayer.detid.size();
-    auto firstClusterIdx = offsets[layerId];
 
-    for (unsigned int i = 0; i < numberOfCells; ++i) {
-      auto clusterIndex = cellsOnLayer.clusterIndex[i];
-      if (clusterIndex != -1)
-        cellsIdInCluster[clusterIndex].push_back(i);
-    }
+  // the clusters of each layer are at their offset, the layers are filled in parallel
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(size_t(0), size_t(2 * maxlayer_ + 2), [&](size_t layerId) {
+      std::vector<std::vector<int>> cellsIdInCluster(numberOfClustersPerLayer_[layerId]);
+      auto& cellsOnLayer = cells_[layerId];
+      unsigned int numberOfCells = cellsOnLayer.detid.size();
+      auto firstClusterIdx = offsets[layerId];
+
+      for (unsigned int i = 0; i < numberOfCells; ++i) {
+        auto clusterIndex = cellsOnLayer.clusterIndex[i];
+        if (clusterIndex != -1)
+          cellsIdInCluster[clusterIndex].push_back(i);
+      }
 
-    std::vector<std::pair<DetId, float>> thisCluster;
+      std::vector<std::pair<DetId, float>> thisCluster;
 
-    for (auto& cl : cellsIdInCluster) {
-      auto position = calculatePosition(cl, layerId);
-      float energy = 0.f;
-      int seedDetId = -1;
+      for (auto& cl : cellsIdInCluster) {
+        auto position = calculatePosition(cl, layerId);
+        float energy = 0.f;
+        int seedDetId = -1;
 
-      for (auto cellIdx : cl) {
-        energy += cellsOnLayer.weight[cellIdx];
-        thisCluster.emplace_back(cellsOnLayer.detid[cellIdx], 1.f);
-        if (cellsOnLayer.isSeed[cellIdx]) {
-          seedDetId = cellsOnLayer.detid[cellIdx];
+        for (auto cellIdx : cl) {
+          energy += cellsOnLayer.weight[cellIdx];
+          thisCluster.emplace_back(cellsOnLayer.detid[cellIdx], 1.f);
+          if (cellsOnLayer.isSeed[cellIdx]) {
+            seedDetId = cellsOnLayer.detid[cellIdx];
+          }
         }
-      }
-      auto globalClusterIndex = cellsOnLayer.clusterIndex[cl[0]] + firstClusterIdx;
-
-      clusters_v_[globalClusterIndex] =
-          reco::BasicCluster(energy, position, reco::CaloID::DET_HGCAL_ENDCAP, thisCluster, algoId_);
-      clusters_v_[globalClusterIndex].setSeed(seedDetId);
-      thisCluster.clear();
-    }
+        auto globalClusterIndex = cellsOnLayer.clusterIndex[cl[0]] + firstClusterIdx;
 
-    cellsIdInCluster.clear();
-  }
+        clusters_v_[globalClusterIndex] =
+            reco::BasicCluster(energy, position, reco::CaloID::DET_HGCAL_ENDCAP, thisCluster, algoId_);
+        clusters_v_[globalClusterIndex].setSeed(seedDetId);
+        thisCluster.clear();
+      }
+    });
+  });
   return clusters_v_;
 }
 
@@ -61,6 +61,11 @@ public:
   // this is the method to get the cluster collection out
   std::vector<reco::BasicCluster> getClusters(bool) override;
 
+  // the cells of populate, for the batched clustering of hgcalCLUE, and its results in place of makeClusters
+  hgcalCLUE::Sizes batchSizes() const override;
+  void exportBatch(hgcalCLUE::Cells& cells, hgcalCLUE::Params& params) const override;
+  void importBatch(const hgcalCLUE::Cells& cells) override;
+
   void reset() override {
     clusters_v_.clear();
     for (auto& cl : numberOfClustersPerLayer_) {
@@ -197,6 +202,7 @@ private:
   }
 
   void prepareDataStructures(const unsigned int layerId);
+  float criticalDistance(const unsigned int layerId) const;  // for the silicon of the layer
   void calculateLocalDensity(const TILE& lt,
                              const unsigned int layerId,
                              float delta_c,
@@ -0,0 +1,98 @@
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "RecoLocalCalo/HGCalRecProducers/interface/HFNoseTilesConstants.h"
+#include "RecoLocalCalo/HGCalRecProducers/interface/HGCalTilesConstants.h"
+
+#include "HGCalCLUEOnGPU.h"
+
+namespace hgcalCLUE {
+
+  namespace {
+
+    constexpr uint32_t nThreads = 256;
+
+    __device__ uint32_t firstThread() { return blockIdx.x * blockDim.x + threadIdx.x; }
+    __device__ uint32_t nThreadsInGrid() { return blockDim.x * gridDim.x; }
+
+    constexpr uint32_t nBlocks(uint32_t n) { return (n + nThreads - 1) / nThreads; }
+
+    template <typename T>
+    __global__ void countTilesKernel(Cells cells, Tiles tiles) {
+      countTiles<T>(cells, tiles, firstThread(), nThreadsInGrid());
+    }
+
+    template <typename T>
+    __global__ void scanTilesKernel(Cells cells, Tiles tiles) {
+      scanTiles<T>(cells, tiles, firstThread(), nThreadsInGrid());
+    }
+
+    template <typename T>
+    __global__ void fillTilesKernel(Cells cells, Tiles tiles) {
+      fillTiles<T>(cells, tiles, firstThread(), nThreadsInGrid());
+    }
+
+    template <typename T>
+    __global__ void sortTilesKernel(Cells cells, Tiles tiles) {
+      sortTiles<T>(cells, tiles, firstThread(), nThreadsInGrid());
+    }
+
+    template <typename T>
+    __global__ void calculateLocalDensityKernel(Cells cells, Tiles tiles, Params params) {
+      calculateLocalDensity<T>(cells, tiles, params, firstThread(), nThreadsInGrid());
+    }
+
+    template <typename T>
+    __global__ void calculateDistanceToHigherKernel(Cells cells, Tiles tiles, Params params) {
+      calculateDistanceToHigher<T>(cells, tiles, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void findSeedsKernel(Cells cells, Params params) {
+      findSeeds(cells, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void assignClustersKernel(Cells cells, Params params) {
+      assignClusters(cells, params, firstThread(), nThreadsInGrid());
+    }
+
+    template <typename T>
+    void makeClustersAsyncT(Cells const& cells, Params const& params, cudaStream_t stream) {
+      uint32_t const nTiles = cells.nLayers * T::nTiles;
+      auto start = cms::cuda::make_device_unique<uint32_t[]>(nTiles, stream);
+      auto count = cms::cuda::make_device_unique<uint32_t[]>(nTiles, stream);
+      auto fill = cms::cuda::make_device_unique<uint32_t[]>(nTiles, stream);
+      auto tileCells = cms::cuda::make_device_unique<uint32_t[]>(maxTilesPerCell * cells.size, stream);
+      cudaCheck(cudaMemsetAsync(count.get(), 0, nTiles * sizeof(uint32_t), stream));
+      cudaCheck(cudaMemsetAsync(fill.get(), 0, nTiles * sizeof(uint32_t), stream));
+      Tiles const tiles{start.get(), count.get(), fill.get(), tileCells.get()};
+
+      uint32_t const cellBlocks = nBlocks(cells.size);
+      countTilesKernel<T><<<cellBlocks, nThreads, 0, stream>>>(cells, tiles);
+      cudaCheck(cudaGetLastError());
+      scanTilesKernel<T><<<nBlocks(cells.nLayers), nThreads, 0, stream>>>(cells, tiles);
+      cudaCheck(cudaGetLastError());
+      fillTilesKernel<T><<<cellBlocks, nThreads, 0, stream>>>(cells, tiles);
+      cudaCheck(cudaGetLastError());
+      sortTilesKernel<T><<<nBlocks(nTiles), nThreads, 0, stream>>>(cells, tiles);
+      cudaCheck(cudaGetLastError());
+      calculateLocalDensityKernel<T><<<cellBlocks, nThreads, 0, stream>>>(cells, tiles, params);
+      cudaCheck(cudaGetLastError());
+      calculateDistanceToHigherKernel<T><<<cellBlocks, nThreads, 0, stream>>>(cells, tiles, params);
+      cudaCheck(cudaGetLastError());
+      findSeedsKernel<<<nBlocks(cells.nLayers), nThreads, 0, stream>>>(cells, params);
+      cudaCheck(cudaGetLastError());
+      assignClustersKernel<<<cellBlocks, nThreads, 0, stream>>>(cells, params);
+      cudaCheck(cudaGetLastError());
+    }
+
+  }  // namespace
+
+  void makeClustersAsync(Cells const& cells, Params const& params, bool isNose, cudaStream_t stream) {
+    if (cells.size == 0)
+      return;
+    if (isNose)
+      makeClustersAsyncT<HFNoseTilesConstants>(cells, params, stream);
+    else
+      makeClustersAsyncT<HGCalTilesConstants>(cells, params, stream);
+  }
+
+}  // namespace hgcalCLUE
@@ -0,0 +1,18 @@
+#ifndef RecoLocalCalo_HGCalRecProducers_plugins_cuda_HGCalCLUEOnGPU_h
+#define RecoLocalCalo_HGCalRecProducers_plugins_cuda_HGCalCLUEOnGPU_h
+
+#include <cuda_runtime.h>
+
+#include "RecoLocalCalo/HGCalRecProducers/interface/HGCalCLUEAlgos.h"
+
+namespace hgcalCLUE {
+
+  // Queues the CLUE clustering of all the layers of the cells on the
+  // stream, with the tiles of HGCal or of HFNose. The arrays of the cells
+  // are those of the device, and cells.size and cells.nLayers those of the
+  // arrays.
+  void makeClustersAsync(Cells const& cells, Params const& params, bool isNose, cudaStream_t stream);
+
+}  // namespace hgcalCLUE
+
+#endif
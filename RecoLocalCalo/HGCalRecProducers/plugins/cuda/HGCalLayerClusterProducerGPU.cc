@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/HGCRecHit/interface/HGCRecHitCollections.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/PluginDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+#include "RecoLocalCalo/HGCalRecProducers/interface/ComputeClusterTime.h"
+#include "RecoLocalCalo/HGCalRecProducers/interface/HGCalLayerClusterAlgoFactory.h"
+
+#include "HGCalCLUEOnGPU.h"
+
+/**
+ * The layer clusters of HGCalLayerClusterProducer with a CLUE plugin, with
+ * the density, the distance to the nearest higher and the cluster of each
+ * cell of all the layers computed at once on the GPU. The selection of the
+ * rechits, the clusters and their time are those of the CLUE algorithm on
+ * the host, and the products are those of HGCalLayerClusterProducer.
+ */
+class HGCalLayerClusterProducerGPU : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit HGCalLayerClusterProducerGPU(const edm::ParameterSet& ps);
+  ~HGCalLayerClusterProducerGPU() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& evt,
+               const edm::EventSetup& es,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& evt, const edm::EventSetup& es) override;
+
+  void populate(const edm::Event& evt);
+
+  edm::EDGetTokenT<HGCRecHitCollection> hits_ee_token_;
+  edm::EDGetTokenT<HGCRecHitCollection> hits_fh_token_;
+  edm::EDGetTokenT<HGCRecHitCollection> hits_bh_token_;
+  edm::EDGetTokenT<HGCRecHitCollection> hits_hfnose_token_;
+
+  reco::CaloCluster::AlgoId algoId_;
+  std::unique_ptr<HGCalClusteringAlgoBase> algo_;
+  const bool doSharing_;
+  const std::string timeClname_;
+  const double timeOffset_;
+  const unsigned int nHitsTime_;
+
+  // the rechits with a time, by detid
+  std::unordered_map<uint32_t, const HGCRecHit*> hitmap_;
+  hgcalCLUE::Cells cells_;
+  cms::cuda::host::unique_ptr<char[]> buffer_;
+};
+
+HGCalLayerClusterProducerGPU::HGCalLayerClusterProducerGPU(const edm::ParameterSet& ps)
+    : algoId_(reco::CaloCluster::undefined),
+      doSharing_(ps.getParameter<bool>("doSharing")),
+      timeClname_(ps.getParameter<std::string>("timeClname")),
+      timeOffset_(ps.getParameter<double>("timeOffset")),
+      nHitsTime_(ps.getParameter<unsigned int>("nHitsTime")) {
+  const auto detector = ps.getParameter<std::string>("detector");
+  if (detector == "HFNose") {
+    hits_hfnose_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HFNoseInput"));
+    algoId_ = reco::CaloCluster::hfnose;
+  } else if (detector == "all") {
+    hits_ee_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HGCEEInput"));
+    hits_fh_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HGCFHInput"));
+    hits_bh_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HGCBHInput"));
+    algoId_ = reco::CaloCluster::hgcal_mixed;
+  } else if (detector == "EE") {
+    hits_ee_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HGCEEInput"));
+    algoId_ = reco::CaloCluster::hgcal_em;
+  } else if (detector == "FH") {
+    hits_fh_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HGCFHInput"));
+    algoId_ = reco::CaloCluster::hgcal_had;
+  } else {
+    hits_bh_token_ = consumes<HGCRecHitCollection>(ps.getParameter<edm::InputTag>("HGCBHInput"));
+    algoId_ = reco::CaloCluster::hgcal_had;
+  }
+
+  auto pluginPSet = ps.getParameter<edm::ParameterSet>("plugin");
+  if (detector == "HFNose") {
+    algo_ = HGCalLayerClusterAlgoFactory::get()->create("HFNoseCLUE", pluginPSet);
+    algo_->setAlgoId(algoId_, true);
+  } else {
+    algo_ = HGCalLayerClusterAlgoFactory::get()->create(pluginPSet.getParameter<std::string>("type"), pluginPSet);
+    algo_->setAlgoId(algoId_);
+  }
+
+  produces<std::vector<float>>("InitialLayerClustersMask");
+  produces<std::vector<reco::BasicCluster>>();
+  produces<std::vector<reco::BasicCluster>>("sharing");
+  produces<hgcal_clustering::Density>();
+  produces<edm::ValueMap<std::pair<float, float>>>(timeClname_);
+}
+
+void HGCalLayerClusterProducerGPU::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  edm::ParameterSetDescription pluginDesc;
+  pluginDesc.addNode(edm::PluginDescription<HGCalLayerClusterAlgoFactory>("type", "CLUE", true));
+
+  desc.add<edm::ParameterSetDescription>("plugin", pluginDesc);
+  desc.add<std::string>("detector", "all")
+      ->setComment("all (does not include HFNose); other options: EE, FH, HFNose; other value defaults to BH");
+  desc.add<bool>("doSharing", false);
+  desc.add<edm::InputTag>("HFNoseInput", edm::InputTag("HGCalRecHit", "HGCHFNoseRecHits"));
+  desc.add<edm::InputTag>("HGCEEInput", edm::InputTag("HGCalRecHit", "HGCEERecHits"));
+  desc.add<edm::InputTag>("HGCFHInput", edm::InputTag("HGCalRecHit", "HGCHEFRecHits"));
+  desc.add<edm::InputTag>("HGCBHInput", edm::InputTag("HGCalRecHit", "HGCHEBRecHits"));
+  desc.add<std::string>("timeClname", "timeLayerCluster");
+  desc.add<double>("timeOffset", 0.0);
+  desc.add<unsigned int>("nHitsTime", 3);
+  descriptions.add("hgcalLayerClustersGPU", desc);
+}
+
+// as HGCalLayerClusterProducer::produce
+void HGCalLayerClusterProducerGPU::populate(const edm::Event& evt) {
+  auto addHits = [this](const HGCRecHitCollection& hits, bool withTime) {
+    algo_->populate(hits);
+    if (withTime)
+      for (auto const& it : hits)
+        hitmap_[it.detid().rawId()] = &(it);
+  };
+
+  switch (algoId_) {
+    case reco::CaloCluster::hfnose:
+      addHits(evt.get(hits_hfnose_token_), true);
+      break;
+    case reco::CaloCluster::hgcal_em:
+      addHits(evt.get(hits_ee_token_), true);
+      break;
+    case reco::CaloCluster::hgcal_had: {
+      edm::Handle<HGCRecHitCollection> fh_hits;
+      edm::Handle<HGCRecHitCollection> bh_hits;
+      evt.getByToken(hits_fh_token_, fh_hits);
+      evt.getByToken(hits_bh_token_, bh_hits);
+      if (fh_hits.isValid())
+        addHits(*fh_hits, true);
+      else if (bh_hits.isValid())
+        addHits(*bh_hits, false);
+      break;
+    }
+    case reco::CaloCluster::hgcal_mixed:
+      addHits(evt.get(hits_ee_token_), true);
+      addHits(evt.get(hits_fh_token_), true);
+      addHits(evt.get(hits_bh_token_), false);
+      break;
+    default:
+      break;
+  }
+}
+
+void HGCalLayerClusterProducerGPU::acquire(const edm::Event& evt,
+                                           const edm::EventSetup& es,
+                                           edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  cms::cuda::ScopedContextAcquire ctx{evt.streamID(), std::move(waitingTaskHolder)};
+
+  algo_->reset();
+  algo_->getEventSetup(es);
+  hitmap_.clear();
+  populate(evt);
+
+  auto const sizes = algo_->batchSizes();
+  const size_t inputBytes = hgcalCLUE::Cells::inputBytes(sizes.nCells, sizes.nLayers);
+  const size_t outputBytes = hgcalCLUE::Cells::outputBytes(sizes.nCells, sizes.nLayers);
+
+  buffer_ = cms::cuda::make_host_unique<char[]>(inputBytes + outputBytes, ctx.stream());
+  cells_.setBuffer(buffer_.get(), sizes.nCells, sizes.nLayers);
+  hgcalCLUE::Params params;
+  algo_->exportBatch(cells_, params);
+  if (sizes.nCells == 0) {
+    std::fill(cells_.nClusters, cells_.nClusters + sizes.nLayers, 0);
+    return;
+  }
+
+  auto deviceBuffer = cms::cuda::make_device_unique<char[]>(inputBytes + outputBytes, ctx.stream());
+  hgcalCLUE::Cells deviceCells;
+  deviceCells.setBuffer(deviceBuffer.get(), sizes.nCells, sizes.nLayers);
+  cudaCheck(cudaMemcpyAsync(deviceBuffer.get(), buffer_.get(), inputBytes, cudaMemcpyHostToDevice, ctx.stream()));
+  hgcalCLUE::makeClustersAsync(deviceCells, params, algoId_ == reco::CaloCluster::hfnose, ctx.stream());
+  cudaCheck(cudaMemcpyAsync(buffer_.get() + inputBytes,
+                            deviceBuffer.get() + inputBytes,
+                            outputBytes,
+                            cudaMemcpyDeviceToHost,
+                            ctx.stream()));
+}
+
+void HGCalLayerClusterProducerGPU::produce(edm::Event& evt, const edm::EventSetup& es) {
+  algo_->importBatch(cells_);
+  buffer_.reset();
+
+  auto clusterHandle = evt.put(std::make_unique<std::vector<reco::BasicCluster>>(algo_->getClusters(false)));
+  auto clustersSharing = std::make_unique<std::vector<reco::BasicCluster>>();
+  if (doSharing_)
+    *clustersSharing = algo_->getClusters(true);
+  evt.put(std::move(clustersSharing), "sharing");
+  evt.put(std::make_unique<hgcal_clustering::Density>(algo_->getDensity()));
+
+  std::vector<std::pair<float, float>> times;
+  times.reserve(clusterHandle->size());
+  for (auto const& sCl : *clusterHandle) {
+    std::pair<float, float> timeCl(-99., -1.);
+    if (sCl.size() >= nHitsTime_) {
+      std::vector<float> timeClhits;
+      std::vector<float> timeErrorClhits;
+      for (auto const& hit : sCl.hitsAndFractions()) {
+        auto finder = hitmap_.find(hit.first);
+        if (finder == hitmap_.end())
+          continue;
+
+        //time is computed wrt  0-25ns + offset and set to -1 if no time
+        const HGCRecHit* rechit = finder->second;
+        float rhTimeE = rechit->timeError();
+        //check on timeError to exclude scintillator
+        if (rhTimeE < 0.)
+          continue;
+        timeClhits.push_back(rechit->time() - timeOffset_);
+        timeErrorClhits.push_back(1. / (rhTimeE * rhTimeE));
+      }
+      hgcalsimclustertime::ComputeClusterTime timeEstimator;
+      timeCl = timeEstimator.fixSizeHighestDensity(timeClhits, timeErrorClhits, nHitsTime_);
+    }
+    times.push_back(timeCl);
+  }
+  evt.put(std::make_unique<std::vector<float>>(clusterHandle->size(), 1.0), "InitialLayerClustersMask");
+
+  auto timeCl = std::make_unique<edm::ValueMap<std::pair<float, float>>>();
+  edm::ValueMap<std::pair<float, float>>::Filler filler(*timeCl);
+  filler.insert(clusterHandle, times.begin(), times.end());
+  filler.fill();
+  evt.put(std::move(timeCl), timeClname_);
+
+  hitmap_.clear();
+}
+
+DEFINE_FWK_MODULE(HGCalLayerClusterProducerGPU);
@@ -0,0 +1,4 @@
+#include "FWCore/ParameterSet/interface/ValidatedPluginFactoryMacros.h"
+
+#include "RecoLocalCalo/HGCalRecProducers/interface/HGCalLayerClusterAlgoFactory.h"
+EDM_REGISTER_VALIDATED_PLUGINFACTORY(HGCalLayerClusterAlgoFactory, "HGCalLayerClusterAlgoFactory");
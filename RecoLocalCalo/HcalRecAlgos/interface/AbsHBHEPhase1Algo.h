@@ -4,6 +4,7 @@
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "DataFormats/HcalRecHit/interface/HBHERecHit.h"
 #include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
+#include "DataFormats/HcalRecHit/interface/HcalRecHitCollections.h"
 #include "CalibFormats/HcalObjects/interface/HcalCalibrations.h"
 #include "CondFormats/HcalObjects/interface/HcalRecoParam.h"
 
@@ -50,6 +51,16 @@ public:
                                  const HcalRecoParam* params,
                                  const HcalCalibrations& calibs,
                                  bool isRealData) = 0;
+
+  // Algorithms which fit the channels of an event together may return
+  // from "reconstruct" rechits which are only completed here, for all
+  // the channels given to "reconstruct" since the previous call. These
+  // rechits are expected to be the last ones of the collection, in the
+  // order in which they were reconstructed. "completesRecHits" tells
+  // whether the rechits of "reconstruct" are to be completed, so that
+  // their status bits are set only after "completeRecHits".
+  inline virtual bool completesRecHits() const { return false; }
+  inline virtual void completeRecHits(HBHERecHitCollection* /* rechits */) {}
 };
 
 #endif  // RecoLocalCalo_HcalRecAlgos_AbsHBHEPhase1Algo_h_
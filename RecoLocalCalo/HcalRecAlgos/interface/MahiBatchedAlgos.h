@@ -0,0 +1,693 @@
+#ifndef RecoLocalCalo_HcalRecAlgos_MahiBatchedAlgos_h
+#define RecoLocalCalo_HcalRecAlgos_MahiBatchedAlgos_h
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+/** The fit of MahiFit::phase1Apply(), written for fixed-size matrices and
+ *  for channels stored as arrays: the same function fits a channel in a
+ *  loop over a batch on the host, or in one thread per channel on the GPU.
+ *
+ *  The matrices have room for 10 samples and 8 pulses. The samples after
+ *  the last one of a channel with 8 samples are left at 0, with a variance
+ *  of 1 and no correlation in the covariance, so that they do not enter the
+ *  fit. The pulses are permuted as in MahiFit, the first nP of them being
+ *  those left free by the non-negative least squares, and pulseIndex keeps
+ *  track of the derivative and of the covariance of each of them.
+ *
+ *  The pulse shapes are interpolated from the tables of PulseShapeFunctor,
+ *  precomputed once for each shape in a PulseTemplate.
+ */
+namespace hcalMahi {
+
+  constexpr int maxSamples = 10;
+  constexpr int maxPulses = 8;
+  // the 1 ns bins of the HcalPulseShapes shapes, and the constants of HcalConst
+  constexpr int nShapeBins = 256;
+  constexpr int nsPerBX = 25;
+  constexpr double iniTimeShift = 92.5;
+  // the bx of the dynamic pedestal, and the limit of the arrival time around the nominal one
+  constexpr int pedestalBX = 100;
+  constexpr float timeLimit = 12.5f;
+
+  using SampleVector = Eigen::Matrix<float, maxSamples, 1>;
+  using SampleMatrix = Eigen::Matrix<float, maxSamples, maxSamples>;
+  using PulseVector = Eigen::Matrix<float, maxPulses, 1>;
+  using PulseMatrix = Eigen::Matrix<float, maxPulses, maxPulses>;
+  using SamplePulseMatrix = Eigen::Matrix<float, maxSamples, maxPulses>;
+
+  // the sums and differences of the shape over 25 ns of FitterFuncs::PulseShapeFunctor
+  struct PulseTemplate {
+    float acc25ns[nShapeBins];
+    float diff25ns[nShapeBins];
+    float accVarLenIdxZero[nsPerBX];
+    float diffVarItvlIdxZero[nsPerBX];
+    float accVarLenIdxMinusOne[nsPerBX];
+    float diffVarItvlIdxMinusOne[nsPerBX];
+  };
+
+  // the settings of MahiFit::setParameters(), with the parameters of HcalTimeSlew::delay() for its bias setting
+  struct Params {
+    bool dynamicPed;
+    float ts4Thresh;
+    float chiSqSwitch;
+    bool applyTimeSlew;
+    float timeSlewTZero;
+    float timeSlewSlope;
+    float timeSlewTMax;
+    bool calculateArrivalTime;
+    float meanTime;
+    float timeSigmaHPD;
+    float timeSigmaSiPM;
+    int8_t activeBXs[maxPulses];
+    int nActiveBXs;
+    int nMaxItersMin;
+    int nMaxItersNNLS;
+    float deltaChiSqThresh;
+    float nnlsThresh;
+  };
+
+  // A batch of channels, as arrays in host or device memory. The samples of
+  // the channel i are at [i * maxSamples, i * maxSamples + nSamples[i]).
+  struct Channels {
+    uint32_t size;
+
+    // the inputs, as in HBHEChannelInfo
+    float* rawCharge;
+    float* pedestal;
+    float* pedestalWidth;
+    float* dFcPerADC;
+    float* gain;  // of the first sample
+    float* fcByPE;
+    uint16_t* pulseTemplate;
+    uint8_t* soi;
+    uint8_t* nSamples;
+    uint8_t* hasTimeInfo;
+
+    // the outputs of MahiFit::phase1Apply()
+    float* energy;
+    float* time;
+    float* chi2;
+    uint8_t* useTriple;
+
+    static constexpr size_t aligned(size_t bytes) { return (bytes + 127) / 128 * 128; }
+    static constexpr size_t inputBytes(uint32_t n) {
+      return aligned(n * ((4 * maxSamples + 2) * sizeof(float) + sizeof(uint16_t) + 3 * sizeof(uint8_t)));
+    }
+    static constexpr size_t outputBytes(uint32_t n) { return aligned(n * (3 * sizeof(float) + sizeof(uint8_t))); }
+
+    // the arrays of n channels in a buffer of inputBytes(n) + outputBytes(n), the outputs after the inputs
+    void setBuffer(char* buffer, uint32_t n) {
+      size = n;
+      auto next = [&buffer](auto*& array, size_t count) {
+        array = reinterpret_cast<std::remove_reference_t<decltype(array)>>(buffer);
+        buffer += count * sizeof(*array);
+      };
+      char* const outputs = buffer + inputBytes(n);
+      next(rawCharge, n * maxSamples);
+      next(pedestal, n * maxSamples);
+      next(pedestalWidth, n * maxSamples);
+      next(dFcPerADC, n * maxSamples);
+      next(gain, n);
+      next(fcByPE, n);
+      next(pulseTemplate, n);
+      next(soi, n);
+      next(nSamples, n);
+      next(hasTimeInfo, n);
+      buffer = outputs;
+      next(energy, n);
+      next(time, n);
+      next(chi2, n);
+      next(useTriple, n);
+    }
+  };
+
+  // the workspace of the fit of one channel, as MahiNnlsWorkspace
+  struct Fit {
+    int tsSize;
+    int tsOffset;
+    int bxOffset;
+    int maxoffset;
+    int nPulseTot;
+    int nP;
+    float dt;
+    float pedVal;
+    SampleVector amplitudes;
+    SampleVector noiseTerms;
+    int bxs[maxPulses];
+    int pulseIndex[maxPulses];
+    SamplePulseMatrix pulseMat;
+    SamplePulseMatrix pulseDerivMat;
+    SampleMatrix pulseCov[maxPulses];
+    PulseVector ampVec;
+    PulseMatrix aTaMat;
+    PulseVector aTbVec;
+    // the Cholesky factor of the covariance of the samples
+    SampleMatrix covL;
+  };
+
+  EIGEN_DEVICE_FUNC inline float timeSlewDelay(Params const& params, float fC) {
+    float const rawDelay = params.timeSlewTZero + params.timeSlewSlope * std::log(fC);
+    return rawDelay < 0.f ? 0.f : (rawDelay > params.timeSlewTMax ? params.timeSlewTMax : rawDelay);
+  }
+
+  // FitterFuncs::PulseShapeFunctor::funcShape() for a pulse of unit height and no slew
+  EIGEN_DEVICE_FUNC inline void pulseShape(PulseTemplate const& shape, double pulseTime, float* pulse) {
+    for (int iTS = 0; iTS < maxSamples; ++iTS)
+      pulse[iTS] = 0.f;
+
+    int iStart = (-iniTimeShift - pulseTime > 0 ? 0 : (int)std::abs(-iniTimeShift - pulseTime) + 1);
+    double offsetStart = iStart - iniTimeShift - pulseTime;
+    if (offsetStart != offsetStart)
+      return;
+    if (offsetStart == 1.0) {
+      offsetStart = 0.;
+      iStart -= 1;
+    }
+
+    int const binStart = (int)offsetStart;
+    int const bin0Start = (offsetStart < binStart + 0.5 ? binStart - 1 : binStart);
+    int const iTSStart = iStart / nsPerBX;
+    int const distTo25nsStart = nsPerBX - 1 - iStart % nsPerBX;
+    float const factor = offsetStart - bin0Start - 0.5;
+    if (iTSStart >= maxSamples)
+      return;
+
+    pulse[iTSStart] =
+        (bin0Start == -1
+             ? shape.accVarLenIdxMinusOne[distTo25nsStart] + factor * shape.diffVarItvlIdxMinusOne[distTo25nsStart]
+             : shape.accVarLenIdxZero[distTo25nsStart] + factor * shape.diffVarItvlIdxZero[distTo25nsStart]);
+    for (int iTS = iTSStart + 1; iTS < maxSamples; ++iTS) {
+      int binIdx = distTo25nsStart + 1 + (iTS - iTSStart - 1) * nsPerBX + bin0Start;
+      if (binIdx >= nShapeBins)
+        binIdx = nShapeBins - 1;
+      pulse[iTS] = shape.acc25ns[binIdx] + factor * shape.diff25ns[binIdx];
+    }
+  }
+
+  // the lower triangular l with l l^T = a
+  EIGEN_DEVICE_FUNC inline void cholesky(SampleMatrix const& a, SampleMatrix& l) {
+    l.setZero();
+    for (int j = 0; j < maxSamples; ++j) {
+      float d = a(j, j);
+      for (int k = 0; k < j; ++k)
+        d -= l(j, k) * l(j, k);
+      l(j, j) = std::sqrt(d);
+      float const inv = 1.f / l(j, j);
+      for (int i = j + 1; i < maxSamples; ++i) {
+        float s = a(i, j);
+        for (int k = 0; k < j; ++k)
+          s -= l(i, k) * l(j, k);
+        l(i, j) = s * inv;
+      }
+    }
+  }
+
+  // x with l x = b, l lower triangular
+  EIGEN_DEVICE_FUNC inline SampleVector solveL(SampleMatrix const& l, SampleVector const& b) {
+    SampleVector x;
+    for (int i = 0; i < maxSamples; ++i) {
+      float s = b(i);
+      for (int k = 0; k < i; ++k)
+        s -= l(i, k) * x(k);
+      x(i) = s / l(i, i);
+    }
+    return x;
+  }
+
+  // the first n elements of x with a x = b for the leading n x n block of a, by a LDL^T decomposition
+  EIGEN_DEVICE_FUNC inline void solveLeading(PulseMatrix const& a, PulseVector const& b, int n, PulseVector& x) {
+    PulseMatrix l;
+    PulseVector d;
+    for (int j = 0; j < n; ++j) {
+      float dj = a(j, j);
+      for (int k = 0; k < j; ++k)
+        dj -= l(j, k) * l(j, k) * d(k);
+      d(j) = dj;
+      for (int i = j + 1; i < n; ++i) {
+        float s = a(i, j);
+        for (int k = 0; k < j; ++k)
+          s -= l(i, k) * l(j, k) * d(k);
+        l(i, j) = dj != 0.f ? s / dj : 0.f;
+      }
+    }
+    PulseVector y;
+    for (int i = 0; i < n; ++i) {
+      float s = b(i);
+      for (int k = 0; k < i; ++k)
+        s -= l(i, k) * y(k);
+      y(i) = s;
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      float s = d(i) != 0.f ? y(i) / d(i) : 0.f;
+      for (int k = i + 1; k < n; ++k)
+        s -= l(k, i) * x(k);
+      x(i) = s;
+    }
+  }
+
+  template <typename T>
+  EIGEN_DEVICE_FUNC inline void swapValues(T& a, T& b) {
+    T const tmp = a;
+    a = b;
+    b = tmp;
+  }
+
+  // MahiFit::nnlsUnconstrainParameter() and nnlsConstrainParameter()
+  EIGEN_DEVICE_FUNC inline void swapPulses(Fit& fit, int i, int j) {
+    if (i == j)
+      return;
+    fit.aTaMat.col(i).swap(fit.aTaMat.col(j));
+    fit.aTaMat.row(i).swap(fit.aTaMat.row(j));
+    fit.pulseMat.col(i).swap(fit.pulseMat.col(j));
+    swapValues(fit.aTbVec(i), fit.aTbVec(j));
+    swapValues(fit.ampVec(i), fit.ampVec(j));
+    swapValues(fit.bxs[i], fit.bxs[j]);
+    swapValues(fit.pulseIndex[i], fit.pulseIndex[j]);
+  }
+
+  // the pulse of the bx offset, its derivative and its covariance, shifted in the samples of the channel as
+  // the corresponding segments of MahiFit::updatePulseShape() in MahiFit::doFit()
+  EIGEN_DEVICE_FUNC inline void setPulse(
+      Fit& fit, int ipulse, int offset, PulseTemplate const& shape, Params const& params) {
+    int const itSample = fit.tsOffset + offset;
+    float const itQ = itSample >= 0 && itSample < fit.tsSize ? fit.amplitudes(itSample) : 0.f;
+    float t0 = params.meanTime;
+    if (params.applyTimeSlew)
+      t0 += timeSlewDelay(params, itQ <= 1.f ? 1.f : itQ);
+
+    float pulseN[maxSamples];
+    float pulseM[maxSamples];
+    float pulseP[maxSamples];
+    pulseShape(shape, t0, pulseN);
+    pulseShape(shape, t0 - fit.dt, pulseM);
+    pulseShape(shape, t0 + fit.dt, pulseP);
+
+    // the templates have the sample of interest in TS4
+    int const delta = 4 - fit.tsOffset - offset;
+    float const invDt = 0.5f / fit.dt;
+    float dM[maxSamples];
+    float dP[maxSamples];
+    for (int i = 0; i < maxSamples; ++i) {
+      int const t = i + delta;
+      bool const inPulse = i < fit.tsSize && i - offset >= 0 && i - offset < fit.tsSize && t >= 0 && t < maxSamples;
+      fit.pulseMat(i, ipulse) = inPulse ? pulseN[t] : 0.f;
+      fit.pulseDerivMat(i, ipulse) = inPulse ? (pulseM[t] - pulseP[t]) * invDt : 0.f;
+      dM[i] = inPulse ? pulseM[t] - pulseN[t] : 0.f;
+      dP[i] = inPulse ? pulseP[t] - pulseN[t] : 0.f;
+    }
+    for (int i = 0; i < maxSamples; ++i)
+      for (int j = 0; j < maxSamples; ++j)
+        fit.pulseCov[ipulse](i, j) = 0.5f * (dP[i] * dP[j] + dM[i] * dM[j]);
+  }
+
+  // MahiFit::updateCov()
+  EIGEN_DEVICE_FUNC inline void updateCov(Fit& fit, SampleMatrix const& noiseCov) {
+    SampleMatrix cov = noiseCov;
+    for (int ipulse = 0; ipulse < fit.nPulseTot; ++ipulse) {
+      float const amp = fit.ampVec(ipulse);
+      if (amp == 0.f || fit.bxs[ipulse] == pedestalBX)
+        continue;
+      cov += amp * amp * fit.pulseCov[fit.pulseIndex[ipulse]];
+    }
+    cholesky(cov, fit.covL);
+  }
+
+  EIGEN_DEVICE_FUNC inline SampleVector residuals(Fit const& fit) {
+    SampleVector res = -fit.amplitudes;
+    for (int ipulse = 0; ipulse < fit.nPulseTot; ++ipulse)
+      res += fit.ampVec(ipulse) * fit.pulseMat.col(ipulse);
+    return res;
+  }
+
+  EIGEN_DEVICE_FUNC inline float calculateChiSq(Fit const& fit) {
+    return solveL(fit.covL, residuals(fit)).squaredNorm();
+  }
+
+  // MahiFit::nnls()
+  EIGEN_DEVICE_FUNC inline void nnls(Fit& fit, Params const& params) {
+    int const npulse = fit.nPulseTot;
+    int const maxP = npulse < fit.tsSize ? npulse : fit.tsSize;
+
+    SamplePulseMatrix invcovp;
+    for (int ipulse = 0; ipulse < npulse; ++ipulse)
+      invcovp.col(ipulse) = solveL(fit.covL, fit.pulseMat.col(ipulse));
+    SampleVector const invcovs = solveL(fit.covL, fit.amplitudes);
+    for (int i = 0; i < npulse; ++i) {
+      for (int j = 0; j < npulse; ++j)
+        fit.aTaMat(i, j) = invcovp.col(i).dot(invcovp.col(j));
+      fit.aTbVec(i) = invcovp.col(i).dot(invcovs);
+    }
+
+    int iter = 0;
+    int idxwmax = 0;
+    float wmax = 0.f;
+    float threshold = params.nnlsThresh;
+    while (true) {
+      if (iter > 0 || fit.nP == 0) {
+        if (fit.nP == maxP)
+          break;
+
+        // exit if there are no more pulses to constrain
+        if (npulse == fit.nP)
+          break;
+
+        int const idxwmaxprev = idxwmax;
+        float const wmaxprev = wmax;
+        for (int i = fit.nP; i < npulse; ++i) {
+          float w = fit.aTbVec(i);
+          for (int j = 0; j < npulse; ++j)
+            w -= fit.aTaMat(i, j) * fit.ampVec(j);
+          if (i == fit.nP || w > wmax) {
+            wmax = w;
+            idxwmax = i - fit.nP;
+          }
+        }
+
+        if (wmax < threshold || (idxwmax == idxwmaxprev && wmax == wmaxprev))
+          break;
+
+        if (iter >= params.nMaxItersNNLS)
+          break;
+
+        // unconstrain parameter
+        swapPulses(fit, fit.nP, fit.nP + idxwmax);
+        ++fit.nP;
+      }
+
+      while (fit.nP > 0) {
+        PulseVector test = fit.ampVec;
+        solveLeading(fit.aTaMat, fit.aTbVec, fit.nP, test);
+
+        bool positive = true;
+        for (int i = 0; i < fit.nP; ++i)
+          positive &= (test(i) > 0.f);
+        if (positive) {
+          fit.ampVec.head(fit.nP) = test.head(fit.nP);
+          break;
+        }
+
+        // update parameter vector
+        int minratioidx = 0;
+        float minratio = 3.4e38f;
+        for (int i = 0; i < fit.nP; ++i) {
+          if (test(i) <= 0.f) {
+            float const ratio = fit.ampVec(i) / (fit.ampVec(i) - test(i));
+            if (ratio < minratio) {
+              minratio = ratio;
+              minratioidx = i;
+            }
+          }
+        }
+        for (int i = 0; i < fit.nP; ++i)
+          fit.ampVec(i) += minratio * (test(i) - fit.ampVec(i));
+
+        // avoid numerical problems with later ==0. check
+        fit.ampVec(minratioidx) = 0.f;
+
+        swapPulses(fit, fit.nP - 1, minratioidx);
+        --fit.nP;
+      }
+
+      ++iter;
+
+      // adaptive convergence threshold to avoid infinite loops but still ensure best value is used
+      if (iter % 10 == 0)
+        threshold *= 10.f;
+    }
+  }
+
+  // MahiFit::onePulseMinimize()
+  EIGEN_DEVICE_FUNC inline void onePulseMinimize(Fit& fit) {
+    SampleVector const invcovp = solveL(fit.covL, fit.pulseMat.col(0));
+    float const aTaCoeff = invcovp.squaredNorm();
+    float const aTbCoeff = invcovp.dot(solveL(fit.covL, fit.amplitudes));
+    fit.ampVec(0) = aTbCoeff / aTaCoeff > 0.f ? aTbCoeff / aTaCoeff : 0.f;
+  }
+
+  // MahiFit::minimize()
+  EIGEN_DEVICE_FUNC inline float minimize(Fit& fit, Params const& params) {
+    fit.ampVec.setZero();
+
+    SampleMatrix noiseCov = SampleMatrix::Zero();
+    for (int i = 0; i < maxSamples; ++i) {
+      for (int j = 0; j < maxSamples; ++j)
+        noiseCov(i, j) = i < fit.tsSize && j < fit.tsSize ? fit.pedVal : 0.f;
+      noiseCov(i, i) += fit.noiseTerms(i);
+    }
+
+    float oldChiSq = 9999.f;
+    float chiSq = oldChiSq;
+    for (int iter = 1; iter < params.nMaxItersMin; ++iter) {
+      updateCov(fit, noiseCov);
+
+      if (fit.nPulseTot > 1)
+        nnls(fit, params);
+      else
+        onePulseMinimize(fit);
+
+      float const newChiSq = calculateChiSq(fit);
+      float const deltaChiSq = newChiSq - chiSq;
+
+      if (newChiSq == oldChiSq && newChiSq < chiSq)
+        break;
+      oldChiSq = chiSq;
+      chiSq = newChiSq;
+
+      if (std::abs(deltaChiSq) < params.deltaChiSqThresh)
+        break;
+    }
+    return chiSq;
+  }
+
+  // the least squares solution x of a x = b for the first n columns of a, a being overwritten, by a Householder
+  // QR decomposition with column pivoting as Eigen::ColPivHouseholderQR: the columns beyond the numerical rank
+  // get a zero in x
+  EIGEN_DEVICE_FUNC inline void solveQR(SamplePulseMatrix& a, SampleVector b, int n, PulseVector& x) {
+    int perm[maxPulses];
+    float colNorms[maxPulses];
+    float maxNorm = 0.f;
+    for (int j = 0; j < n; ++j) {
+      perm[j] = j;
+      colNorms[j] = a.col(j).squaredNorm();
+      maxNorm = colNorms[j] > maxNorm ? colNorms[j] : maxNorm;
+      x(j) = 0.f;
+    }
+    float const threshold = std::sqrt(maxNorm) * n * Eigen::NumTraits<float>::epsilon();
+
+    int rank = 0;
+    float rDiag[maxPulses];
+    for (int k = 0; k < n && k < maxSamples; ++k) {
+      // the remaining column of largest norm as pivot
+      int p = k;
+      for (int j = k + 1; j < n; ++j)
+        p = colNorms[j] > colNorms[p] ? j : p;
+      if (p != k) {
+        a.col(k).swap(a.col(p));
+        swapValues(colNorms[k], colNorms[p]);
+        swapValues(perm[k], perm[p]);
+      }
+
+      // the Householder reflection of the rows [k, maxSamples) of the column k
+      float norm = 0.f;
+      for (int i = k; i < maxSamples; ++i)
+        norm += a(i, k) * a(i, k);
+      norm = std::sqrt(norm);
+      if (norm <= threshold)
+        break;
+      float const alpha = a(k, k) > 0.f ? -norm : norm;
+      a(k, k) -= alpha;
+      float const vNorm2 = -2.f * alpha * a(k, k);
+      for (int j = k + 1; j < n; ++j) {
+        float s = 0.f;
+        for (int i = k; i < maxSamples; ++i)
+          s += a(i, k) * a(i, j);
+        s *= 2.f / vNorm2;
+        for (int i = k; i < maxSamples; ++i)
+          a(i, j) -= s * a(i, k);
+        colNorms[j] -= a(k, j) * a(k, j);
+      }
+      float s = 0.f;
+      for (int i = k; i < maxSamples; ++i)
+        s += a(i, k) * b(i);
+      s *= 2.f / vNorm2;
+      for (int i = k; i < maxSamples; ++i)
+        b(i) -= s * a(i, k);
+      rDiag[k] = alpha;
+      ++rank;
+    }
+
+    // back substitution with the upper triangle of the rank columns
+    for (int i = rank - 1; i >= 0; --i) {
+      float s = b(i);
+      for (int j = i + 1; j < rank; ++j)
+        s -= a(i, j) * x(perm[j]);
+      x(perm[i]) = s / rDiag[i];
+    }
+  }
+
+  // MahiFit::calculateArrivalTime(), for the derivatives of the pulses with a non-zero amplitude only, the
+  // others being zero columns which do not enter the least squares solution
+  EIGEN_DEVICE_FUNC inline float calculateArrivalTime(Fit const& fit, int itIndex) {
+    SampleVector const res = residuals(fit);
+    SamplePulseMatrix derivs;
+    int itColumn = -1;
+    int nColumns = 0;
+    for (int ipulse = 0; ipulse < fit.nPulseTot; ++ipulse) {
+      if (fit.ampVec(ipulse) == 0.f || fit.bxs[ipulse] == pedestalBX)
+        continue;
+      if (ipulse == itIndex)
+        itColumn = nColumns;
+      derivs.col(nColumns++) = fit.ampVec(ipulse) * fit.pulseDerivMat.col(fit.pulseIndex[ipulse]);
+    }
+    if (itColumn < 0)
+      return 0.f;
+
+    PulseVector solution;
+    solveQR(derivs, res, nColumns, solution);
+    float const t = solution(itColumn);
+    return t < -timeLimit ? -timeLimit : (t > timeLimit ? timeLimit : t);
+  }
+
+  // MahiFit::doFit(): the charge, time and chi2 of the in-time pulse with one pulse if nbx is 1, or with the
+  // configured bxs otherwise
+  EIGEN_DEVICE_FUNC inline void doFit(
+      Fit& fit, int nbx, PulseTemplate const& shape, Params const& params, float* correctedOutput) {
+    int bxSize = 1;
+    if (nbx == 1) {
+      fit.bxOffset = 0;
+    } else {
+      int bxOffsetConf = -params.activeBXs[0];
+      for (int ibx = 1; ibx < params.nActiveBXs; ++ibx)
+        bxOffsetConf = -params.activeBXs[ibx] > bxOffsetConf ? -params.activeBXs[ibx] : bxOffsetConf;
+      bxSize = params.nActiveBXs;
+      fit.bxOffset = fit.tsOffset >= bxOffsetConf ? bxOffsetConf : fit.tsOffset;
+    }
+
+    fit.nPulseTot = bxSize;
+    if (params.dynamicPed)
+      fit.nPulseTot++;
+
+    for (int ibx = 0; ibx < maxPulses; ++ibx) {
+      fit.bxs[ibx] = 0;
+      fit.pulseIndex[ibx] = ibx;
+    }
+    if (nbx != 1) {
+      int const firstBX = fit.tsOffset + params.activeBXs[0];
+      for (int ibx = 0; ibx < bxSize; ++ibx)
+        fit.bxs[ibx] = params.activeBXs[ibx] - (firstBX >= 0 ? 0 : firstBX);
+    }
+    fit.maxoffset = fit.bxs[bxSize - 1];
+    if (params.dynamicPed)
+      fit.bxs[fit.nPulseTot - 1] = pedestalBX;
+
+    fit.pulseMat.setZero();
+    fit.pulseDerivMat.setZero();
+    for (int ipulse = 0; ipulse < fit.nPulseTot; ++ipulse) {
+      int const offset = fit.bxs[ipulse];
+      if (offset == pedestalBX) {
+        for (int i = 0; i < fit.tsSize; ++i)
+          fit.pulseMat(i, ipulse) = 1.f;
+        fit.pulseCov[ipulse].setZero();
+      } else {
+        setPulse(fit, ipulse, offset, shape, params);
+      }
+    }
+
+    float const chiSq = minimize(fit, params);
+
+    for (int ipulse = 0; ipulse < fit.nPulseTot; ++ipulse) {
+      if (fit.bxs[ipulse] == 0) {
+        correctedOutput[0] = fit.ampVec(ipulse);
+        if (correctedOutput[0] != 0.f)
+          correctedOutput[1] = params.calculateArrivalTime ? calculateArrivalTime(fit, ipulse) : 0.f;
+        else
+          correctedOutput[1] = -9999.f;
+        correctedOutput[2] = chiSq;
+        break;
+      }
+    }
+  }
+
+  // MahiFit::phase1Apply() for the channel i, with the templates indexed by Channels::pulseTemplate
+  EIGEN_DEVICE_FUNC inline void fitChannel(Channels const& channels,
+                                           uint32_t i,
+                                           PulseTemplate const* templates,
+                                           Params const& params) {
+    Fit fit;
+    fit.tsSize = channels.nSamples[i];
+    fit.tsOffset = channels.soi[i];
+    fit.bxOffset = 0;
+    fit.maxoffset = 0;
+    fit.nPulseTot = 0;
+    fit.nP = 0;
+    // 1 sigma time constraint
+    fit.dt = channels.hasTimeInfo[i] ? params.timeSigmaSiPM : params.timeSigmaHPD;
+
+    float const* rawCharge = channels.rawCharge + i * maxSamples;
+    float const* pedestal = channels.pedestal + i * maxSamples;
+    float const* pedestalWidth = channels.pedestalWidth + i * maxSamples;
+    float const* dFcPerADC = channels.dFcPerADC + i * maxSamples;
+    float const norm = 1.f / std::sqrt(12.f);
+    float const fcByPE = channels.fcByPE[i];
+
+    float tsTOT = 0.f;
+    float tstrig = 0.f;
+    for (int iTS = 0; iTS < maxSamples; ++iTS) {
+      if (iTS >= fit.tsSize) {
+        fit.amplitudes(iTS) = 0.f;
+        fit.noiseTerms(iTS) = 1.f;
+        continue;
+      }
+      float const amplitude = rawCharge[iTS] - pedestal[iTS];
+      fit.amplitudes(iTS) = amplitude;
+
+      // ADC granularity, electronic pedestal and photostatistics
+      float const noiseADC = norm * dFcPerADC[iTS];
+      float const pedWidth = pedestalWidth[iTS];
+      float const noisePhoto = amplitude > pedWidth ? std::sqrt(amplitude * fcByPE) : 0.f;
+      fit.noiseTerms(iTS) = noiseADC * noiseADC + noisePhoto * noisePhoto + pedWidth * pedWidth;
+
+      tsTOT += amplitude;
+      if (iTS == fit.tsOffset)
+        tstrig += amplitude;
+    }
+    float const gain = channels.gain[i];
+    tsTOT *= gain;
+    tstrig *= gain;
+
+    float reconstructedVals[3] = {0.f, -9999.f, -9999.f};
+    bool useTriple = false;
+    if (tstrig >= params.ts4Thresh && tsTOT > 0.f) {
+      // average pedestal width, for the covariance matrix constraint
+      fit.pedVal = 0.f;
+      for (int iTS = 0; iTS < 4; ++iTS)
+        fit.pedVal += 0.25f * pedestalWidth[iTS] * pedestalWidth[iTS];
+
+      PulseTemplate const& shape = templates[channels.pulseTemplate[i]];
+      // only do the pre-fit with 1 pulse if the chi2 threshold is positive
+      if (params.chiSqSwitch > 0.f) {
+        doFit(fit, 1, shape, params, reconstructedVals);
+        if (reconstructedVals[2] > params.chiSqSwitch) {
+          doFit(fit, 0, shape, params, reconstructedVals);
+          useTriple = true;
+        }
+      } else {
+        doFit(fit, 0, shape, params, reconstructedVals);
+        useTriple = true;
+      }
+    }
+
+    channels.energy[i] = reconstructedVals[0] * gain;
+    channels.time[i] = reconstructedVals[1];
+    channels.chi2[i] = reconstructedVals[2];
+    channels.useTriple[i] = useTriple;
+  }
+
+}  // namespace hcalMahi
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef RecoLocalCalo_HcalRecAlgos_MahiBatchedFit_h
+#define RecoLocalCalo_HcalRecAlgos_MahiBatchedFit_h
+
+#include <map>
+#include <vector>
+
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
+#include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiBatchedAlgos.h"
+
+//
+// The Mahi fit of MahiFit, for a batch of channels: the channels given
+// to "add" are stored as the arrays of hcalMahi::Channels, and fitted
+// together by "fit", in parallel over blocks of channels. The pulse
+// templates of all the HcalPulseShapes shapes are computed once, by
+// "setPulseShapes", instead of a PulseShapeFunctor for each change of
+// shape between two channels.
+//
+class MahiBatchedFit {
+public:
+  MahiBatchedFit();
+
+  void setParameters(bool iDynamicPed,
+                     double iTS4Thresh,
+                     double chiSqSwitch,
+                     bool iApplyTimeSlew,
+                     HcalTimeSlew::BiasSetting slewFlavor,
+                     bool iCalculateArrivalTime,
+                     double iMeanTime,
+                     double iTimeSigmaHPD,
+                     double iTimeSigmaSiPM,
+                     const std::vector<int>& iActiveBXs,
+                     int iNMaxItersMin,
+                     int iNMaxItersNNLS,
+                     double iDeltaChiSqThresh,
+                     double iNnlsThresh);
+
+  void setPulseShapes(const HcalPulseShapes& shapes);
+  // to be called whenever the time slew record changes
+  void setTimeSlew(const HcalTimeSlew* hcalTimeSlewDelay);
+
+  // Adds a channel to the batch, and returns its index in the batch
+  unsigned add(const HBHEChannelInfo& info);
+  void clear();
+
+  // Fits all the channels of the batch, filling the outputs of channels()
+  void fit();
+
+  inline unsigned size() const { return channels_.size; }
+  inline const hcalMahi::Channels& channels() const { return channels_; }
+  inline const hcalMahi::Params& params() const { return params_; }
+  inline const std::vector<hcalMahi::PulseTemplate>& templates() const { return templates_; }
+
+  // The index in templates() of the template of a HcalPulseShapes shape type
+  unsigned templateIndex(int recoShape) const;
+
+  // Fills the inputs of the channel i of a batch
+  static void fillChannel(const HBHEChannelInfo& info, unsigned iTemplate, unsigned i, hcalMahi::Channels& channels);
+
+private:
+  void reserve(unsigned capacity);
+
+  hcalMahi::Params params_;
+  HcalTimeSlew::BiasSetting slewFlavor_;
+
+  std::vector<hcalMahi::PulseTemplate> templates_;
+  std::map<int, unsigned> templateIndices_;
+
+  unsigned capacity_;
+  std::vector<char> buffer_;
+  hcalMahi::Channels channels_;
+};
+
+#endif  // RecoLocalCalo_HcalRecAlgos_MahiBatchedFit_h
@@ -13,6 +13,7 @@
 #include "RecoLocalCalo/HcalRecAlgos/interface/PulseShapeFitOOTPileupCorrection.h"
 #include "RecoLocalCalo/HcalRecAlgos/interface/HcalDeterministicFit.h"
 #include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiBatchedFit.h"
 #include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
 
 class SimpleHBHEPhase1Algo : public AbsHBHEPhase1Algo {
@@ -39,6 +40,12 @@ public:
   //
   //   detFit           -- "Method 3" (a.k.a. "deterministic fit") object
   //
+  //   mahi             -- Mahi object
+  //
+  //   batchedMahi      -- Mahi object fitting all the channels of an event
+  //                       together, in "completeRecHits". Not to be used
+  //                       together with "mahi".
+  //
   SimpleHBHEPhase1Algo(int firstSampleShift,
                        int samplesToAdd,
                        float phaseNS,
@@ -47,7 +54,8 @@ public:
                        bool applyLegacyHBMCorrection,
                        std::unique_ptr<PulseShapeFitOOTPileupCorrection> m2,
                        std::unique_ptr<HcalDeterministicFit> detFit,
-                       std::unique_ptr<MahiFit> mahi);
+                       std::unique_ptr<MahiFit> mahi,
+                       std::unique_ptr<MahiBatchedFit> batchedMahi = nullptr);
 
   inline ~SimpleHBHEPhase1Algo() override {}
 
@@ -61,6 +69,10 @@ public:
                          const HcalRecoParam* params,
                          const HcalCalibrations& calibs,
                          bool isRealData) override;
+
+  inline bool completesRecHits() const override { return batchedMahi_ != nullptr; }
+  void completeRecHits(HBHERecHitCollection* rechits) override;
+
   // Basic accessors
   inline int getFirstSampleShift() const { return firstSampleShift_; }
   inline int getSamplesToAdd() const { return samplesToAdd_; }
@@ -107,6 +119,10 @@ private:
   // Mahi algorithm
   std::unique_ptr<MahiFit> mahiOOTpuCorr_;
 
+  // Mahi algorithm for the channels of an event together
+  std::unique_ptr<MahiBatchedFit> batchedMahi_;
+  bool batchedIsRealData_;
+
   HcalPulseShapes theHcalPulseShapes_;
 };
 
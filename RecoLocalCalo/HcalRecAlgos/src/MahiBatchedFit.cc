@@ -0,0 +1,193 @@
+#define EIGEN_NO_DEBUG  // kill throws in eigen code
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiBatchedFit.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/PulseShapeFunctor.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace {
+  // the tables of the constructor of FitterFuncs::PulseShapeFunctor
+  hcalMahi::PulseTemplate makePulseTemplate(const HcalPulseShapes::Shape& ps) {
+    constexpr int nBins = hcalMahi::nShapeBins;
+    constexpr int nsPerBX = hcalMahi::nsPerBX;
+    static_assert(nBins == HcalConst::maxPSshapeBin && nsPerBX == HcalConst::nsPerBX);
+
+    float pulse[nBins];
+    for (int i = 0; i < nBins; ++i)
+      pulse[i] = ps(i);
+
+    hcalMahi::PulseTemplate t;
+    for (int i = 0; i < nBins; ++i) {
+      t.acc25ns[i] = 0.f;
+      for (int j = i; j < i + nsPerBX; ++j)
+        t.acc25ns[i] += (j < nBins ? pulse[j] : pulse[nBins - 1]);
+      t.diff25ns[i] = (i + nsPerBX < nBins ? pulse[i + nsPerBX] - pulse[i] : pulse[nBins - 1] - pulse[i]);
+    }
+    for (int i = 0; i < nsPerBX; ++i) {
+      if (i == 0) {
+        t.accVarLenIdxZero[0] = pulse[0];
+        t.accVarLenIdxMinusOne[0] = pulse[0];
+      } else {
+        t.accVarLenIdxZero[i] = t.accVarLenIdxZero[i - 1] + pulse[i];
+        t.accVarLenIdxMinusOne[i] = t.accVarLenIdxMinusOne[i - 1] + pulse[i - 1];
+      }
+      t.diffVarItvlIdxZero[i] = pulse[i + 1] - pulse[0];
+      t.diffVarItvlIdxMinusOne[i] = pulse[i] - pulse[0];
+    }
+    return t;
+  }
+}  // namespace
+
+MahiBatchedFit::MahiBatchedFit() : slewFlavor_(HcalTimeSlew::Medium), capacity_(0) { channels_.setBuffer(nullptr, 0); }
+
+void MahiBatchedFit::setParameters(bool iDynamicPed,
+                                   double iTS4Thresh,
+                                   double chiSqSwitch,
+                                   bool iApplyTimeSlew,
+                                   HcalTimeSlew::BiasSetting slewFlavor,
+                                   bool iCalculateArrivalTime,
+                                   double iMeanTime,
+                                   double iTimeSigmaHPD,
+                                   double iTimeSigmaSiPM,
+                                   const std::vector<int>& iActiveBXs,
+                                   int iNMaxItersMin,
+                                   int iNMaxItersNNLS,
+                                   double iDeltaChiSqThresh,
+                                   double iNnlsThresh) {
+  if (iActiveBXs.empty() || iActiveBXs.size() + (iDynamicPed ? 1 : 0) > hcalMahi::maxPulses)
+    throw cms::Exception("ConfigurationError")
+        << "The batched Mahi fit supports from 1 to " << hcalMahi::maxPulses
+        << " pulses, including the dynamic pedestal, and not " << iActiveBXs.size() + (iDynamicPed ? 1 : 0);
+
+  params_.dynamicPed = iDynamicPed;
+  params_.ts4Thresh = iTS4Thresh;
+  params_.chiSqSwitch = chiSqSwitch;
+
+  params_.applyTimeSlew = iApplyTimeSlew;
+  slewFlavor_ = slewFlavor;
+  params_.timeSlewTZero = 0.f;
+  params_.timeSlewSlope = 0.f;
+  params_.timeSlewTMax = 0.f;
+
+  params_.calculateArrivalTime = iCalculateArrivalTime;
+  params_.meanTime = iMeanTime;
+  params_.timeSigmaHPD = iTimeSigmaHPD;
+  params_.timeSigmaSiPM = iTimeSigmaSiPM;
+
+  params_.nActiveBXs = iActiveBXs.size();
+  for (int i = 0; i < hcalMahi::maxPulses; ++i)
+    params_.activeBXs[i] = i < params_.nActiveBXs ? iActiveBXs[i] : 0;
+
+  params_.nMaxItersMin = iNMaxItersMin;
+  params_.nMaxItersNNLS = iNMaxItersNNLS;
+
+  params_.deltaChiSqThresh = iDeltaChiSqThresh;
+  params_.nnlsThresh = iNnlsThresh;
+}
+
+void MahiBatchedFit::setPulseShapes(const HcalPulseShapes& shapes) {
+  templates_.clear();
+  templateIndices_.clear();
+  // the shape types which are aliases of the same shape share its template
+  std::map<const HcalPulseShapes::Shape*, unsigned> indices;
+  for (auto const& shape : shapes.get_all_shapes()) {
+    auto it = indices.find(shape.second);
+    if (it == indices.end()) {
+      it = indices.emplace(shape.second, templates_.size()).first;
+      templates_.push_back(makePulseTemplate(*shape.second));
+    }
+    templateIndices_[shape.first] = it->second;
+  }
+}
+
+void MahiBatchedFit::setTimeSlew(const HcalTimeSlew* hcalTimeSlewDelay) {
+  auto const& slew = hcalTimeSlewDelay->m2Parameters(slewFlavor_);
+  params_.timeSlewTZero = slew.tzero;
+  params_.timeSlewSlope = slew.slope;
+  params_.timeSlewTMax = slew.tmax;
+}
+
+unsigned MahiBatchedFit::templateIndex(int recoShape) const {
+  auto const it = templateIndices_.find(recoShape);
+  if (it == templateIndices_.end())
+    throw cms::Exception("HcalPulseShapes") << "unknown shapeType";
+  return it->second;
+}
+
+void MahiBatchedFit::fillChannel(const HBHEChannelInfo& info,
+                                 unsigned iTemplate,
+                                 unsigned i,
+                                 hcalMahi::Channels& channels) {
+  assert(info.nSamples() == 8 || info.nSamples() == 10);
+
+  const unsigned nSamples = info.nSamples();
+  for (unsigned iTS = 0; iTS < hcalMahi::maxSamples; ++iTS) {
+    const unsigned j = i * hcalMahi::maxSamples + iTS;
+    const bool inChannel = iTS < nSamples;
+    channels.rawCharge[j] = inChannel ? info.tsRawCharge(iTS) : 0.f;
+    channels.pedestal[j] = inChannel ? info.tsPedestal(iTS) : 0.f;
+    channels.pedestalWidth[j] = inChannel ? info.tsPedestalWidth(iTS) : 0.f;
+    channels.dFcPerADC[j] = inChannel ? info.tsDFcPerADC(iTS) : 0.f;
+  }
+  channels.gain[i] = info.tsGain(0);
+  channels.fcByPE[i] = info.fcByPE();
+  channels.pulseTemplate[i] = iTemplate;
+  channels.soi[i] = info.soi();
+  channels.nSamples[i] = nSamples;
+  channels.hasTimeInfo[i] = info.hasTimeInfo();
+}
+
+unsigned MahiBatchedFit::add(const HBHEChannelInfo& info) {
+  const unsigned i = channels_.size;
+  if (i == capacity_)
+    reserve(std::max(2 * capacity_, 1024u));
+  channels_.size = i + 1;
+  fillChannel(info, templateIndex(info.recoShape()), i, channels_);
+  return i;
+}
+
+void MahiBatchedFit::clear() { channels_.size = 0; }
+
+void MahiBatchedFit::reserve(const unsigned capacity) {
+  using hcalMahi::Channels;
+  std::vector<char> buffer(Channels::inputBytes(capacity) + Channels::outputBytes(capacity));
+  Channels channels;
+  channels.setBuffer(buffer.data(), capacity);
+
+  // only the inputs are kept, the outputs being filled by fit()
+  const unsigned n = channels_.size;
+  if (n) {
+    auto copy = [n](auto* to, auto const* from, unsigned count) { std::copy(from, from + n * count, to); };
+    copy(channels.rawCharge, channels_.rawCharge, hcalMahi::maxSamples);
+    copy(channels.pedestal, channels_.pedestal, hcalMahi::maxSamples);
+    copy(channels.pedestalWidth, channels_.pedestalWidth, hcalMahi::maxSamples);
+    copy(channels.dFcPerADC, channels_.dFcPerADC, hcalMahi::maxSamples);
+    copy(channels.gain, channels_.gain, 1);
+    copy(channels.fcByPE, channels_.fcByPE, 1);
+    copy(channels.pulseTemplate, channels_.pulseTemplate, 1);
+    copy(channels.soi, channels_.soi, 1);
+    copy(channels.nSamples, channels_.nSamples, 1);
+    copy(channels.hasTimeInfo, channels_.hasTimeInfo, 1);
+  }
+  channels.size = n;
+
+  buffer_.swap(buffer);
+  channels_ = channels;
+  capacity_ = capacity;
+}
+
+void MahiBatchedFit::fit() {
+  const hcalMahi::Channels& channels = channels_;
+  const hcalMahi::PulseTemplate* templates = templates_.data();
+  const hcalMahi::Params& params = params_;
+  tbb::parallel_for(tbb::blocked_range<uint32_t>(0, channels.size), [&](const tbb::blocked_range<uint32_t>& range) {
+    for (uint32_t i = range.begin(); i != range.end(); ++i)
+      hcalMahi::fitChannel(channels, i, templates, params);
+  });
+}
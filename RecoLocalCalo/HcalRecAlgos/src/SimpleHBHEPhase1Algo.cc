@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cassert>
 
 #include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
 
@@ -25,7 +26,8 @@ SimpleHBHEPhase1Algo::SimpleHBHEPhase1Algo(const int firstSampleShift,
                                            const bool applyLegacyHBMCorrection,
                                            std::unique_ptr<PulseShapeFitOOTPileupCorrection> m2,
                                            std::unique_ptr<HcalDeterministicFit> detFit,
-                                           std::unique_ptr<MahiFit> mahi)
+                                           std::unique_ptr<MahiFit> mahi,
+                                           std::unique_ptr<MahiBatchedFit> batchedMahi)
     : pulseCorr_(PulseContainmentFractionalError),
       firstSampleShift_(firstSampleShift),
       samplesToAdd_(samplesToAdd),
@@ -36,14 +38,20 @@ SimpleHBHEPhase1Algo::SimpleHBHEPhase1Algo(const int firstSampleShift,
       applyLegacyHBMCorrection_(applyLegacyHBMCorrection),
       psFitOOTpuCorr_(std::move(m2)),
       hltOOTpuCorr_(std::move(detFit)),
-      mahiOOTpuCorr_(std::move(mahi)) {
+      mahiOOTpuCorr_(std::move(mahi)),
+      batchedMahi_(std::move(batchedMahi)),
+      batchedIsRealData_(false) {
   hcalTimeSlew_delay_ = nullptr;
+  if (batchedMahi_)
+    batchedMahi_->setPulseShapes(theHcalPulseShapes_);
 }
 
 void SimpleHBHEPhase1Algo::beginRun(const edm::Run& r, const edm::EventSetup& es) {
   edm::ESHandle<HcalTimeSlew> delay;
   es.get<HcalTimeSlewRecord>().get("HBHE", delay);
   hcalTimeSlew_delay_ = &*delay;
+  if (batchedMahi_)
+    batchedMahi_->setTimeSlew(hcalTimeSlew_delay_);
 
   runnum_ = r.run();
   pulseCorr_.beginRun(es);
@@ -108,6 +116,12 @@ HBHERecHit SimpleHBHEPhase1Algo::reconstruct(const HBHEChannelInfo& info,
     m4E *= hbminusCorrectionFactor(channelId, m4E, isData);
   }
 
+  // Batched Mahi: the energy, time and chi2 of the rechit are set by completeRecHits
+  if (batchedMahi_) {
+    batchedMahi_->add(info);
+    batchedIsRealData_ = isData;
+  }
+
   // Finally, construct the rechit
   HBHERecHit rh;
 
@@ -144,6 +158,30 @@ HBHERecHit SimpleHBHEPhase1Algo::reconstruct(const HBHEChannelInfo& info,
   return rh;
 }
 
+void SimpleHBHEPhase1Algo::completeRecHits(HBHERecHitCollection* rechits) {
+  if (!batchedMahi_ || !batchedMahi_->size())
+    return;
+
+  batchedMahi_->fit();
+
+  const hcalMahi::Channels& channels = batchedMahi_->channels();
+  const unsigned nChannels = batchedMahi_->size();
+  assert(rechits && rechits->size() >= nChannels);
+  const unsigned first = rechits->size() - nChannels;
+  for (unsigned i = 0; i < nChannels; ++i) {
+    HBHERecHit& rh = (*rechits)[first + i];
+    float m4E = channels.energy[i];
+    m4E *= hbminusCorrectionFactor(rh.id(), m4E, batchedIsRealData_);
+    rh.setEnergy(m4E);
+    rh.setTime(channels.time[i]);
+    rh.setChiSquared(channels.chi2[i]);
+    if (channels.useTriple[i])
+      rh.setFlagField(1, HcalPhase1FlagLabels::HBHEPulseFitBit);
+  }
+
+  batchedMahi_->clear();
+}
+
 float SimpleHBHEPhase1Algo::hbminusCorrectionFactor(const HcalDetId& cell,
                                                     const float energy,
                                                     const bool isRealData) const {
@@ -10,7 +10,9 @@
 // Phase 1 HBHE reco algorithm headers
 #include "RecoLocalCalo/HcalRecAlgos/interface/SimpleHBHEPhase1Algo.h"
 
-static std::unique_ptr<MahiFit> parseHBHEMahiDescription(const edm::ParameterSet& conf) {
+// MahiFit or MahiBatchedFit, which share their parameters
+template <class Fit>
+static std::unique_ptr<Fit> parseHBHEMahiDescription(const edm::ParameterSet& conf) {
   const bool iDynamicPed = conf.getParameter<bool>("dynamicPed");
   const double iTS4Thresh = conf.getParameter<double>("ts4Thresh");
   const double chiSqSwitch = conf.getParameter<double>("chiSqSwitch");
@@ -28,7 +30,7 @@ static std::unique_ptr<MahiFit> parseHBHEMahiDescription(const edm::ParameterSet
   const double iDeltaChiSqThresh = conf.getParameter<double>("deltaChiSqThresh");
   const double iNnlsThresh = conf.getParameter<double>("nnlsThresh");
 
-  std::unique_ptr<MahiFit> corr = std::make_unique<MahiFit>();
+  std::unique_ptr<Fit> corr = std::make_unique<Fit>();
 
   corr->setParameters(iDynamicPed,
                       iTS4Thresh,
@@ -111,6 +113,7 @@ std::unique_ptr<AbsHBHEPhase1Algo> parseHBHEPhase1AlgoDescription(const edm::Par
 
   if (className == "SimpleHBHEPhase1Algo") {
     std::unique_ptr<MahiFit> mahi;
+    std::unique_ptr<MahiBatchedFit> batchedMahi;
     std::unique_ptr<PulseShapeFitOOTPileupCorrection> m2;
     std::unique_ptr<HcalDeterministicFit> detFit;
 
@@ -119,8 +122,12 @@ std::unique_ptr<AbsHBHEPhase1Algo> parseHBHEPhase1AlgoDescription(const edm::Par
       throw cms::Exception("ConfigurationError")
           << "SimpleHBHEPhase1Algo does not allow both Mahi and Method 2 to be turned on together.";
     }
-    if (ps.getParameter<bool>("useMahi"))
-      mahi = parseHBHEMahiDescription(ps);
+    if (ps.getParameter<bool>("useMahi")) {
+      if (ps.getParameter<bool>("useBatchedMahi"))
+        batchedMahi = parseHBHEMahiDescription<MahiBatchedFit>(ps);
+      else
+        mahi = parseHBHEMahiDescription<MahiFit>(ps);
+    }
     if (ps.getParameter<bool>("useM2"))
       m2 = parseHBHEMethod2Description(ps);
     if (ps.getParameter<bool>("useM3"))
@@ -135,7 +142,8 @@ std::unique_ptr<AbsHBHEPhase1Algo> parseHBHEPhase1AlgoDescription(const edm::Par
                                                                     ps.getParameter<bool>("applyLegacyHBMCorrection"),
                                                                     std::move(m2),
                                                                     std::move(detFit),
-                                                                    std::move(mahi)));
+                                                                    std::move(mahi),
+                                                                    std::move(batchedMahi)));
   }
 
   return algo;
@@ -149,6 +157,7 @@ edm::ParameterSetDescription fillDescriptionForParseHBHEPhase1Algo() {
   desc.add<bool>("useM2", false);
   desc.add<bool>("useM3", true);
   desc.add<bool>("useMahi", true);
+  desc.add<bool>("useBatchedMahi", false);
   desc.add<int>("firstSampleShift", 0);
   desc.add<int>("samplesToAdd", 2);
   desc.add<double>("correctionPhaseNS", 6.0);
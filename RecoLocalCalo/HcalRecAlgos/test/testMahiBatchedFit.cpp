@@ -0,0 +1,124 @@
+// The batched Mahi fit gives the energy, time, chi2 and pulse fit flag of MahiFit
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
+#include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiBatchedFit.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h"
+
+namespace {
+
+  constexpr double chiSqSwitch = 15.;
+
+  template <class Fit>
+  void configure(Fit& fit) {
+    fit.setParameters(false,
+                      0.,
+                      chiSqSwitch,
+                      true,
+                      HcalTimeSlew::Medium,
+                      true,
+                      0.,
+                      5.,
+                      2.5,
+                      std::vector<int>{-3, -2, -1, 0, 1, 2, 3, 4},
+                      500,
+                      500,
+                      1.e-3,
+                      1.e-11);
+  }
+
+  // a channel with an in-time pulse and out-of-time pileup, as HBHEPhase1Reconstructor fills it
+  HBHEChannelInfo makeChannel(std::mt19937& rng, bool sipm) {
+    std::uniform_real_distribution<float> flat(0.f, 1.f);
+    std::exponential_distribution<float> charge(1.f / 200.f);
+    // the fractions of a pulse in the samples after its bx
+    const float fractions[] = {0.02f, 0.68f, 0.22f, 0.06f, 0.02f};
+    const unsigned nSamples = sipm ? 8 : 10;
+    const unsigned soi = sipm ? 3 : 4;
+    const float pedestal = sipm ? 20.f : 3.f;
+    const float pedestalWidth = sipm ? 3.f : 0.8f;
+
+    float signal[10] = {0.f};
+    for (int bx = -3; bx <= 4; ++bx) {
+      const float q = bx == 0 ? charge(rng) : (flat(rng) < 0.3f ? 0.2f * charge(rng) : 0.f);
+      for (int k = 0; k != 5; ++k) {
+        const int ts = int(soi) + bx + k - 1;
+        if (ts >= 0 && ts < int(nSamples))
+          signal[ts] += q * fractions[k];
+      }
+    }
+
+    HBHEChannelInfo info(sipm, false);
+    std::normal_distribution<float> noise(0.f, pedestalWidth);
+    for (unsigned ts = 0; ts != nSamples; ++ts) {
+      const float rawCharge = pedestal + signal[ts] + noise(rng);
+      info.setSample(ts, 0, sipm ? 1.5f : 2.6f, rawCharge, pedestal, pedestalWidth, 0.1, 0.01, 0.f);
+    }
+    const HcalDetId id(sipm ? HcalEndcap : HcalBarrel, sipm ? 20 : 5, 10, 1);
+    info.setChannelInfo(id, sipm ? 206 : 105, nSamples, soi, 0, 0., sipm ? 50. : 1., 0., false, false, false);
+    return info;
+  }
+
+  bool close(float a, float b, float relTol, float absTol) { return std::abs(a - b) <= absTol + relTol * std::abs(b); }
+
+}  // namespace
+
+int main() {
+  HcalPulseShapes shapes;
+  HcalTimeSlew timeSlew;
+  timeSlew.addM2ParameterSet(23.960, -3.178, 16.00);
+  timeSlew.addM2ParameterSet(13.307784, -1.556668, 10.00);
+  timeSlew.addM2ParameterSet(9.109694, -1.075824, 6.25);
+
+  MahiFit mahi;
+  configure(mahi);
+  MahiBatchedFit batched;
+  configure(batched);
+  batched.setPulseShapes(shapes);
+  batched.setTimeSlew(&timeSlew);
+
+  std::mt19937 rng(12345);
+  std::vector<HBHEChannelInfo> infos;
+  for (unsigned i = 0; i != 5000; ++i) {
+    infos.push_back(makeChannel(rng, i % 2));
+    batched.add(infos.back());
+  }
+  batched.fit();
+
+  const hcalMahi::Channels& channels = batched.channels();
+  unsigned nCompared = 0, nTriple = 0, nFailures = 0;
+  for (unsigned i = 0; i != infos.size(); ++i) {
+    const HBHEChannelInfo& info = infos[i];
+    mahi.setPulseShapeTemplate(shapes.getShape(info.recoShape()), info.hasTimeInfo(), &timeSlew, info.nSamples());
+    float energy = 0.f, time = 0.f, chi2 = -1.f;
+    bool useTriple = false;
+    mahi.phase1Apply(info, energy, time, useTriple, chi2);
+
+    // the channels with the one pulse chi2 at the switch to the full fit may go either way in float
+    if (!useTriple && std::abs(chi2 - chiSqSwitch) < 0.01 * chiSqSwitch)
+      continue;
+    ++nCompared;
+    nTriple += useTriple;
+    const bool same = bool(channels.useTriple[i]) == useTriple && close(channels.energy[i], energy, 1.e-3f, 1.e-3f) &&
+                      close(channels.time[i], time, 1.e-3f, 1.e-2f) && close(channels.chi2[i], chi2, 1.e-2f, 1.e-3f);
+    if (!same) {
+      ++nFailures;
+      if (nFailures < 10)
+        std::cout << "channel " << i << ": MahiFit energy " << energy << " time " << time << " chi2 " << chi2
+                  << " pulse fit " << useTriple << ", batched energy " << channels.energy[i] << " time "
+                  << channels.time[i] << " chi2 " << channels.chi2[i] << " pulse fit " << int(channels.useTriple[i])
+                  << std::endl;
+    }
+  }
+
+  std::cout << nCompared << " channels compared, " << nTriple << " with the pulse fit flag, " << nFailures
+            << " different" << std::endl;
+  return nFailures == 0 && nTriple > 0 && nTriple < nCompared ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,173 @@
+#include <memory>
+#include <vector>
+
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
+#include "CondFormats/DataRecord/interface/HcalTimeSlewRecord.h"
+#include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
+#include "DataFormats/HcalRecHit/interface/HBHERecHitAuxSetter.h"
+#include "DataFormats/HcalRecHit/interface/HcalRecHitCollections.h"
+#include "DataFormats/HcalRecHit/interface/HcalSpecialTimes.h"
+#include "DataFormats/METReco/interface/HcalPhase1FlagLabels.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiBatchedFit.h"
+
+#include "MahiOnGPU.h"
+
+/**
+ * Reconstructs the HBHE rechits from the channel infos of
+ * HBHEPhase1Reconstructor (saveInfos = True), with the Mahi fit of all
+ * the channels of an event on the GPU. The fit is that of MahiBatchedFit,
+ * which SimpleHBHEPhase1Algo runs on the host with useBatchedMahi = True.
+ *
+ * The rechits have the Mahi energy, time and chi2, the TDC time and the
+ * aux words of SimpleHBHEPhase1Algo. The legacy HB- correction and the
+ * flags which HBHEPhase1Reconstructor sets from the digis are not applied.
+ */
+class HBHEMahiRecHitProducerGPU : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit HBHEMahiRecHitProducerGPU(const edm::ParameterSet& iConfig);
+  ~HBHEMahiRecHitProducerGPU() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  const edm::EDGetTokenT<HBHEChannelInfoCollection> infoGetToken_;
+  const edm::ESGetToken<HcalTimeSlew, HcalTimeSlewRecord> timeSlewToken_;
+  const edm::EDPutTokenT<HBHERecHitCollection> recHitPutToken_;
+  const float tdcTimeShift_;
+
+  MahiBatchedFit mahi_;
+
+  // the templates stay on the device of the stream for the whole job
+  cms::cuda::device::unique_ptr<hcalMahi::PulseTemplate[]> templates_;
+
+  // the channel infos which are not dropped, in the order of the batch
+  std::vector<const HBHEChannelInfo*> infos_;
+  hcalMahi::Channels channels_;
+  cms::cuda::host::unique_ptr<char[]> buffer_;
+};
+
+HBHEMahiRecHitProducerGPU::HBHEMahiRecHitProducerGPU(const edm::ParameterSet& iConfig)
+    : infoGetToken_(consumes<HBHEChannelInfoCollection>(iConfig.getParameter<edm::InputTag>("src"))),
+      timeSlewToken_(esConsumes<HcalTimeSlew, HcalTimeSlewRecord>(edm::ESInputTag("", "HBHE"))),
+      recHitPutToken_(produces<HBHERecHitCollection>()),
+      tdcTimeShift_(iConfig.getParameter<double>("tdcTimeShift")) {
+  mahi_.setParameters(iConfig.getParameter<bool>("dynamicPed"),
+                      iConfig.getParameter<double>("ts4Thresh"),
+                      iConfig.getParameter<double>("chiSqSwitch"),
+                      iConfig.getParameter<bool>("applyTimeSlew"),
+                      HcalTimeSlew::Medium,
+                      iConfig.getParameter<bool>("calculateArrivalTime"),
+                      iConfig.getParameter<double>("meanTime"),
+                      iConfig.getParameter<double>("timeSigmaHPD"),
+                      iConfig.getParameter<double>("timeSigmaSiPM"),
+                      iConfig.getParameter<std::vector<int>>("activeBXs"),
+                      iConfig.getParameter<int>("nMaxItersMin"),
+                      iConfig.getParameter<int>("nMaxItersNNLS"),
+                      iConfig.getParameter<double>("deltaChiSqThresh"),
+                      iConfig.getParameter<double>("nnlsThresh"));
+  mahi_.setPulseShapes(HcalPulseShapes());
+}
+
+void HBHEMahiRecHitProducerGPU::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("hbheprereco"));
+  desc.add<double>("tdcTimeShift", 0.0);
+  desc.add<bool>("dynamicPed", false);
+  desc.add<double>("ts4Thresh", 0.0);
+  desc.add<double>("chiSqSwitch", 15.0);
+  desc.add<bool>("applyTimeSlew", true);
+  desc.add<bool>("calculateArrivalTime", false);
+  desc.add<double>("meanTime", 0.0);
+  desc.add<double>("timeSigmaHPD", 5.0);
+  desc.add<double>("timeSigmaSiPM", 2.5);
+  desc.add<std::vector<int>>("activeBXs", {-3, -2, -1, 0, 1, 2, 3, 4});
+  desc.add<int>("nMaxItersMin", 500);
+  desc.add<int>("nMaxItersNNLS", 500);
+  desc.add<double>("deltaChiSqThresh", 1e-3);
+  desc.add<double>("nnlsThresh", 1e-11);
+  descriptions.add("hbheMahiRecHitProducerGPU", desc);
+}
+
+void HBHEMahiRecHitProducerGPU::acquire(const edm::Event& iEvent,
+                                        const edm::EventSetup& iSetup,
+                                        edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  cms::cuda::ScopedContextAcquire ctx{iEvent.streamID(), std::move(waitingTaskHolder)};
+  mahi_.setTimeSlew(&iSetup.getData(timeSlewToken_));
+
+  if (!templates_) {
+    auto const& templates = mahi_.templates();
+    templates_ = cms::cuda::make_device_unique<hcalMahi::PulseTemplate[]>(templates.size(), ctx.stream());
+    cudaCheck(cudaMemcpyAsync(templates_.get(),
+                              templates.data(),
+                              templates.size() * sizeof(hcalMahi::PulseTemplate),
+                              cudaMemcpyHostToDevice,
+                              ctx.stream()));
+  }
+
+  infos_.clear();
+  for (auto const& info : iEvent.get(infoGetToken_))
+    if (!info.isDropped())
+      infos_.push_back(&info);
+  const unsigned nChannels = infos_.size();
+  const size_t inputBytes = hcalMahi::Channels::inputBytes(nChannels);
+  const size_t outputBytes = hcalMahi::Channels::outputBytes(nChannels);
+
+  buffer_ = cms::cuda::make_host_unique<char[]>(inputBytes + outputBytes, ctx.stream());
+  channels_.setBuffer(buffer_.get(), nChannels);
+  for (unsigned i = 0; i < nChannels; ++i)
+    MahiBatchedFit::fillChannel(*infos_[i], mahi_.templateIndex(infos_[i]->recoShape()), i, channels_);
+  if (nChannels == 0)
+    return;
+
+  auto deviceBuffer = cms::cuda::make_device_unique<char[]>(inputBytes + outputBytes, ctx.stream());
+  hcalMahi::Channels deviceChannels;
+  deviceChannels.setBuffer(deviceBuffer.get(), nChannels);
+  cudaCheck(
+      cudaMemcpyAsync(deviceBuffer.get(), buffer_.get(), inputBytes, cudaMemcpyHostToDevice, ctx.stream()));
+  hcalMahi::fitAsync(deviceChannels, templates_.get(), mahi_.params(), ctx.stream());
+  cudaCheck(cudaMemcpyAsync(buffer_.get() + inputBytes,
+                            deviceBuffer.get() + inputBytes,
+                            outputBytes,
+                            cudaMemcpyDeviceToHost,
+                            ctx.stream()));
+}
+
+void HBHEMahiRecHitProducerGPU::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  auto output = std::make_unique<HBHERecHitCollection>();
+  output->reserve(infos_.size());
+  for (unsigned i = 0; i < infos_.size(); ++i) {
+    const HBHEChannelInfo& info = *infos_[i];
+    float tdcTime = info.soiRiseTime();
+    if (!HcalSpecialTimes::isSpecial(tdcTime))
+      tdcTime += tdcTimeShift_;
+    HBHERecHit rh(info.id(), channels_.energy[i], channels_.time[i], tdcTime);
+    rh.setChiSquared(channels_.chi2[i]);
+    HBHERecHitAuxSetter::setAux(info, &rh);
+    if (channels_.useTriple[i])
+      rh.setFlagField(1, HcalPhase1FlagLabels::HBHEPulseFitBit);
+    output->push_back(rh);
+  }
+  iEvent.put(recHitPutToken_, std::move(output));
+
+  infos_.clear();
+  buffer_.reset();
+}
+
+DEFINE_FWK_MODULE(HBHEMahiRecHitProducerGPU);
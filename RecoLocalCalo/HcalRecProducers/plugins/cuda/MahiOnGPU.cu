@@ -0,0 +1,29 @@
+#include <algorithm>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+#include "MahiOnGPU.h"
+
+namespace hcalMahi {
+
+  namespace {
+
+    // the fit of a channel keeps its matrices in registers and local memory, few threads per block fill the device
+    constexpr uint32_t nThreads = 64;
+
+    __global__ void fitKernel(Channels channels, PulseTemplate const* templates, Params params) {
+      for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < channels.size; i += blockDim.x * gridDim.x)
+        fitChannel(channels, i, templates, params);
+    }
+
+  }  // namespace
+
+  void fitAsync(Channels const& channels, PulseTemplate const* templates, Params const& params, cudaStream_t stream) {
+    if (channels.size == 0)
+      return;
+    uint32_t const blocks = (channels.size + nThreads - 1) / nThreads;
+    fitKernel<<<blocks, nThreads, 0, stream>>>(channels, templates, params);
+    cudaCheck(cudaGetLastError());
+  }
+
+}  // namespace hcalMahi
@@ -0,0 +1,17 @@
+#ifndef RecoLocalCalo_HcalRecProducers_plugins_cuda_MahiOnGPU_h
+#define RecoLocalCalo_HcalRecProducers_plugins_cuda_MahiOnGPU_h
+
+#include <cuda_runtime.h>
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiBatchedAlgos.h"
+
+namespace hcalMahi {
+
+  // Queues the Mahi fit of all the channels on the stream, with one thread
+  // per channel. The arrays of the channels and the templates are those of
+  // the device.
+  void fitAsync(Channels const& channels, PulseTemplate const* templates, Params const& params, cudaStream_t stream);
+
+}  // namespace hcalMahi
+
+#endif
@@ -20,6 +20,7 @@
 #include <cmath>
 #include <utility>
 #include <algorithm>
+#include <vector>
 
 // user include files
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -409,6 +410,18 @@ void HBHEPhase1Reconstructor::processData(const Collection& coll,
   // not going to be constructed from such channels.
   const bool skipDroppedChannels = !(infos && saveDroppedInfos_);
 
+  // The rechits completed by the algorithm after the loop over the
+  // channels get their status bits only then, from their final energy
+  struct PendingRecHit {
+    const DFrame* frame;
+    const HcalQIECoder* channelCoder;
+    const HcalQIEShape* shape;
+    const HcalCalibrations* calib;
+    HBHEChannelInfo info;
+  };
+  const bool completeLater = rechits && reco_->completesRecHits();
+  std::vector<PendingRecHit> pending;
+
   // Iterate over the input collection
   for (typename Collection::const_iterator it = coll.begin(); it != coll.end(); ++it) {
     const DFrame& frame(*it);
@@ -548,12 +561,28 @@ void HBHEPhase1Reconstructor::processData(const Collection& coll,
         pptr = param_ts;
       HBHERecHit rh = reco_->reconstruct(*channelInfo, pptr, calib, isRealData);
       if (rh.id().rawId()) {
-        setAsicSpecificBits(frame, coder, *channelInfo, calib, &rh);
-        setCommonStatusBits(*channelInfo, calib, &rh);
+        if (completeLater) {
+          pending.push_back(PendingRecHit{&frame, channelCoder, shape, &calib, *channelInfo});
+        } else {
+          setAsicSpecificBits(frame, coder, *channelInfo, calib, &rh);
+          setCommonStatusBits(*channelInfo, calib, &rh);
+        }
         rechits->push_back(rh);
       }
     }
   }
+
+  if (completeLater) {
+    reco_->completeRecHits(rechits);
+    const std::size_t first = rechits->size() - pending.size();
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+      const PendingRecHit& p = pending[i];
+      const HcalCoderDb coder(*p.channelCoder, *p.shape);
+      HBHERecHit* rh = &(*rechits)[first + i];
+      setAsicSpecificBits(*p.frame, coder, p.info, *p.calib, rh);
+      setCommonStatusBits(p.info, *p.calib, rh);
+    }
+  }
 }
 
 void HBHEPhase1Reconstructor::setCommonStatusBits(const HBHEChannelInfo& /* info */,
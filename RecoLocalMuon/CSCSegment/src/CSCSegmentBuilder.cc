@@ -61,18 +61,14 @@ CSCSegmentBuilder::~CSCSegmentBuilder() = default;
 void CSCSegmentBuilder::build(const CSCRecHit2DCollection* recHits, CSCSegmentCollection& oc) {
   LogDebug("CSCSegment|CSC") << "Total number of rechits in this event: " << recHits->size();
 
+  // The rechits are ordered by layer id, hence the layers of a chamber are contiguous
   std::vector<CSCDetId> chambers;
   std::vector<CSCDetId>::const_iterator chIt;
 
-  for (CSCRecHit2DCollection::const_iterator it2 = recHits->begin(); it2 != recHits->end(); it2++) {
-    bool insert = true;
-    for (chIt = chambers.begin(); chIt != chambers.end(); ++chIt)
-      if (((*it2).cscDetId().chamber() == (*chIt).chamber()) && ((*it2).cscDetId().station() == (*chIt).station()) &&
-          ((*it2).cscDetId().ring() == (*chIt).ring()) && ((*it2).cscDetId().endcap() == (*chIt).endcap()))
-        insert = false;
-
-    if (insert)
-      chambers.push_back((*it2).cscDetId().chamberId());
+  for (CSCRecHit2DCollection::id_iterator layerIt = recHits->id_begin(); layerIt != recHits->id_end(); ++layerIt) {
+    const CSCDetId chId = (*layerIt).chamberId();
+    if (chambers.empty() || chambers.back() != chId)
+      chambers.push_back(chId);
   }
 
   for (chIt = chambers.begin(); chIt != chambers.end(); ++chIt) {
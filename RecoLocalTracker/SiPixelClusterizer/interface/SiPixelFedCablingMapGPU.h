@@ -0,0 +1,39 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_SiPixelFedCablingMapGPU_h
+#define RecoLocalTracker_SiPixelClusterizer_SiPixelFedCablingMapGPU_h
+
+#include <cstdint>
+
+namespace pixelgpudetails {
+  // the phase-1 FEDs, numbered from FEDNumbering::MINSiPixeluTCAFEDID
+  constexpr unsigned int MAX_FED = 150;
+  // the links of a FED and the ROCs of a link are numbered from 1
+  constexpr unsigned int MAX_LINK = 48;
+  constexpr unsigned int MAX_ROC = 8;
+  constexpr unsigned int MAX_SIZE = MAX_FED * MAX_LINK * MAX_ROC;
+  constexpr unsigned int MAX_MODULES = 2048;
+
+  constexpr uint16_t invalidModuleId = 0xFFFF;
+
+  constexpr unsigned int cablingIndex(unsigned int fedIndex, unsigned int link, unsigned int roc) {
+    return fedIndex * MAX_LINK * MAX_ROC + (link - 1) * MAX_ROC + (roc - 1);
+  }
+}  // namespace pixelgpudetails
+
+// The cabling map flattened for the unpacking on the GPU, with one
+// entry per (FED, link, ROC) giving the module the ROC belongs to and
+// the linear conversion from the ROC to the module pixel coordinates.
+struct SiPixelFedCablingMapGPU {
+  uint32_t rawId[pixelgpudetails::MAX_SIZE];
+  uint16_t moduleId[pixelgpudetails::MAX_SIZE];  // invalidModuleId if the ROC is not connected
+  int16_t rowOffset[pixelgpudetails::MAX_SIZE];
+  int16_t colOffset[pixelgpudetails::MAX_SIZE];
+  int8_t rowSlope[pixelgpudetails::MAX_SIZE];
+  int8_t colSlope[pixelgpudetails::MAX_SIZE];
+  uint8_t badRoc[pixelgpudetails::MAX_SIZE];  // from SiPixelQuality, if used
+  // the ROCs of the first barrel layer are read out with row and column instead of double column and pixel id
+  uint8_t layer1[pixelgpudetails::MAX_SIZE];
+  uint8_t moduleLayer1[pixelgpudetails::MAX_MODULES];
+  uint32_t nModules;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_SiPixelFedCablingMapGPUWrapper_h
+#define RecoLocalTracker_SiPixelClusterizer_SiPixelFedCablingMapGPUWrapper_h
+
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDACore/interface/ESProduct.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_noncached_unique_ptr.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelFedCablingMapGPU.h"
+
+class SiPixelFedCablingMap;
+class SiPixelQuality;
+class TrackerGeometry;
+
+// The phase-1 cabling map in the layout of SiPixelFedCablingMapGPU,
+// copied to each device on its first use. The module index is the
+// index of the pixel GeomDetUnit in the TrackerGeometry.
+class SiPixelFedCablingMapGPUWrapper {
+public:
+  // badPixelInfo can be null, if the bad ROCs are to be unpacked
+  SiPixelFedCablingMapGPUWrapper(SiPixelFedCablingMap const& cablingMap,
+                                 TrackerGeometry const& trackerGeom,
+                                 SiPixelQuality const* badPixelInfo);
+  ~SiPixelFedCablingMapGPUWrapper();
+
+  bool hasQuality() const { return hasQuality_; }
+  std::vector<unsigned int> const& fedIds() const { return fedIds_; }
+  unsigned int nModules() const { return cablingMapHost_->nModules; }
+
+  // returns pointer to GPU memory
+  const SiPixelFedCablingMapGPU* getGPUProductAsync(cudaStream_t cudaStream) const;
+
+private:
+  std::vector<unsigned int> fedIds_;
+  bool hasQuality_;
+  cms::cuda::host::noncached::unique_ptr<SiPixelFedCablingMapGPU> cablingMapHost_;
+
+  struct GPUData {
+    ~GPUData();
+    SiPixelFedCablingMapGPU* cablingMapDevice = nullptr;
+  };
+  cms::cuda::ESProduct<GPUData> gpuData_;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_SiPixelGainCalibrationForHLTGPU_h
+#define RecoLocalTracker_SiPixelClusterizer_SiPixelGainCalibrationForHLTGPU_h
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDACore/interface/ESProduct.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_noncached_unique_ptr.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelGainForHLTonGPU.h"
+
+class SiPixelGainCalibrationForHLT;
+class TrackerGeometry;
+
+// The gain calibration decoded in the layout of SiPixelGainForHLTonGPU,
+// copied to each device on its first use. The modules are indexed as
+// the pixel GeomDetUnits in the TrackerGeometry.
+class SiPixelGainCalibrationForHLTGPU {
+public:
+  SiPixelGainCalibrationForHLTGPU(SiPixelGainCalibrationForHLT const& gains, TrackerGeometry const& geom);
+  ~SiPixelGainCalibrationForHLTGPU();
+
+  // returns pointer to GPU memory
+  const SiPixelGainForHLTonGPU* getGPUProductAsync(cudaStream_t cudaStream) const;
+
+private:
+  SiPixelGainForHLTonGPU gainForHLTonHost_;
+  cms::cuda::host::noncached::unique_ptr<SiPixelGainForHLTonGPU::DecodingStructure[]> pedestalsHost_;
+
+  struct GPUData {
+    ~GPUData();
+    SiPixelGainForHLTonGPU* gainForHLTonGPU = nullptr;
+    SiPixelGainForHLTonGPU::DecodingStructure* gainDataOnGPU = nullptr;
+  };
+  cms::cuda::ESProduct<GPUData> gpuData_;
+};
+
+#endif
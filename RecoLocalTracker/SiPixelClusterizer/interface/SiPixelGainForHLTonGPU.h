@@ -0,0 +1,28 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_SiPixelGainForHLTonGPU_h
+#define RecoLocalTracker_SiPixelClusterizer_SiPixelGainForHLTonGPU_h
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+// The SiPixelGainCalibrationForHLT payload decoded for the calibration
+// on the GPU: one pedestal and gain for each group of rows averaged
+// over, in each column of each module.
+struct SiPixelGainForHLTonGPU {
+  struct DecodingStructure {
+    float ped;
+    float gain;  // 0 for the dead and noisy columns, and for the modules missing from the payload
+  };
+
+  __host__ __device__ DecodingStructure const& getPedAndGain(uint32_t moduleInd, int col, int row) const {
+    return v_pedestals[(moduleInd * maxColumns + col) * nBlocks + row / numberOfRowsAveragedOver];
+  }
+
+  DecodingStructure* v_pedestals;
+  uint32_t nModules;
+  uint32_t maxColumns;
+  uint32_t nBlocks;
+  uint32_t numberOfRowsAveragedOver;
+};
+
+#endif
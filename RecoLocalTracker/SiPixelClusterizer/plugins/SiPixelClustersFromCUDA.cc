@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/SiPixelCluster/interface/SiPixelClustersCUDA.h"
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "HeterogeneousCore/CUDACore/interface/ContextState.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * Copies the clusters found on the GPU back to the host, and stores them
+ * as the SiPixelClusterCollectionNew of SiPixelClusterProducer, with the
+ * modules in increasing DetId and the clusters of a module in increasing
+ * minimum row.
+ */
+class SiPixelClustersFromCUDA : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit SiPixelClustersFromCUDA(const edm::ParameterSet& iConfig);
+  ~SiPixelClustersFromCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<SiPixelClustersCUDA>> clusterGetToken_;
+  edm::EDPutTokenT<SiPixelClusterCollectionNew> clusterPutToken_;
+  edm::ESGetToken<TrackerGeometry, TrackerDigiGeometryRecord> geometryToken_;
+
+  uint32_t nModules_ = 0;
+  cms::cuda::host::unique_ptr<uint32_t[]> moduleStart_;
+  cms::cuda::host::unique_ptr<uint16_t[]> xx_;
+  cms::cuda::host::unique_ptr<uint16_t[]> yy_;
+  cms::cuda::host::unique_ptr<uint16_t[]> charge_;
+  cms::cuda::host::unique_ptr<uint32_t[]> pdigi_;
+  cms::cuda::host::unique_ptr<int32_t[]> clus_;
+};
+
+SiPixelClustersFromCUDA::SiPixelClustersFromCUDA(const edm::ParameterSet& iConfig)
+    : clusterGetToken_(consumes<cms::cuda::Product<SiPixelClustersCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      clusterPutToken_(produces<SiPixelClusterCollectionNew>()),
+      geometryToken_(esConsumes<TrackerGeometry, TrackerDigiGeometryRecord>()) {}
+
+void SiPixelClustersFromCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("siPixelClustersCUDA"));
+  descriptions.add("siPixelClustersFromCUDA", desc);
+}
+
+void SiPixelClustersFromCUDA::acquire(const edm::Event& iEvent,
+                                      const edm::EventSetup& iSetup,
+                                      edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  auto const& product = iEvent.get(clusterGetToken_);
+  cms::cuda::ScopedContextAcquire ctx{product, std::move(waitingTaskHolder)};
+  auto const& clusters = ctx.get(product);
+
+  // the number of digis is known only on the device, all the allocated ones are copied
+  uint32_t const maxDigis = clusters.maxDigis();
+  nModules_ = clusters.nModules();
+  moduleStart_ = cms::cuda::make_host_unique<uint32_t[]>(nModules_ + 1, ctx.stream());
+  xx_ = cms::cuda::make_host_unique<uint16_t[]>(maxDigis, ctx.stream());
+  yy_ = cms::cuda::make_host_unique<uint16_t[]>(maxDigis, ctx.stream());
+  charge_ = cms::cuda::make_host_unique<uint16_t[]>(maxDigis, ctx.stream());
+  pdigi_ = cms::cuda::make_host_unique<uint32_t[]>(maxDigis, ctx.stream());
+  clus_ = cms::cuda::make_host_unique<int32_t[]>(maxDigis, ctx.stream());
+
+  auto copy = [&ctx](auto* dst, auto const* src, size_t n) {
+    cudaCheck(cudaMemcpyAsync(dst, src, n * sizeof(*src), cudaMemcpyDeviceToHost, ctx.stream()));
+  };
+  copy(moduleStart_.get(), clusters.moduleStart(), nModules_ + 1);
+  copy(xx_.get(), clusters.xx(), maxDigis);
+  copy(yy_.get(), clusters.yy(), maxDigis);
+  // the pixels of the clusters store the calibrated charge, as in PixelThresholdClusterizer
+  copy(charge_.get(), clusters.charge(), maxDigis);
+  copy(pdigi_.get(), clusters.pdigi(), maxDigis);
+  copy(clus_.get(), clusters.clus(), maxDigis);
+}
+
+void SiPixelClustersFromCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  auto const& geometry = iSetup.getData(geometryToken_);
+  auto const& detUnits = geometry.detUnits();
+
+  // the modules are indexed as the detUnits, the collection is ordered by DetId
+  std::vector<std::pair<uint32_t, uint32_t>> modules;
+  modules.reserve(nModules_);
+  for (uint32_t m = 0; m < nModules_; ++m) {
+    if (moduleStart_[m + 1] > moduleStart_[m])
+      modules.emplace_back(detUnits[m]->geographicalId().rawId(), m);
+  }
+  std::sort(modules.begin(), modules.end());
+
+  auto output = std::make_unique<SiPixelClusterCollectionNew>();
+  std::vector<uint32_t> order, firstDigi, sorted;
+  std::vector<uint16_t> adc, xx, yy;
+  std::vector<SiPixelCluster> clusters;
+  for (auto const& module : modules) {
+    uint32_t const first = moduleStart_[module.second];
+    uint32_t const last = moduleStart_[module.second + 1];
+
+    // the digis of a cluster together, in the order of the unpacking
+    order.clear();
+    for (uint32_t i = first; i < last; ++i) {
+      if (clus_[i] != SiPixelClustersCUDA::invalidCluster)
+        order.push_back(i);
+    }
+    if (order.empty())
+      continue;
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+      return clus_[a] != clus_[b] ? clus_[a] < clus_[b] : pdigi_[a] < pdigi_[b];
+    });
+
+    // the cluster numbering on the GPU is not reproducible, the first digi of each cluster breaks the ties
+    clusters.clear();
+    firstDigi.clear();
+    for (auto begin = order.begin(); begin != order.end();) {
+      int32_t const id = clus_[*begin];
+      auto end = std::find_if(begin, order.end(), [this, id](uint32_t i) { return clus_[i] != id; });
+      adc.clear();
+      xx.clear();
+      yy.clear();
+      for (auto i = begin; i != end; ++i) {
+        adc.push_back(charge_[*i]);
+        xx.push_back(xx_[*i]);
+        yy.push_back(yy_[*i]);
+      }
+      uint16_t const xmin = *std::min_element(xx.begin(), xx.end());
+      uint16_t const ymin = *std::min_element(yy.begin(), yy.end());
+      clusters.emplace_back(adc.size(), adc.data(), xx.data(), yy.data(), xmin, ymin);
+      firstDigi.push_back(pdigi_[*begin]);
+      begin = end;
+    }
+    sorted.resize(clusters.size());
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::sort(sorted.begin(), sorted.end(), [&clusters, &firstDigi](uint32_t a, uint32_t b) {
+      return clusters[a].minPixelRow() != clusters[b].minPixelRow()
+                 ? clusters[a].minPixelRow() < clusters[b].minPixelRow()
+                 : firstDigi[a] < firstDigi[b];
+    });
+
+    SiPixelClusterCollectionNew::FastFiller spc(*output, module.first);
+    for (auto i : sorted)
+      spc.push_back(std::move(clusters[i]));
+  }
+  output->shrink_to_fit();
+  iEvent.put(clusterPutToken_, std::move(output));
+
+  moduleStart_.reset();
+  xx_.reset();
+  yy_.reset();
+  charge_.reset();
+  pdigi_.reset();
+  clus_.reset();
+}
+
+DEFINE_FWK_MODULE(SiPixelClustersFromCUDA);
@@ -0,0 +1,62 @@
+#include <memory>
+
+#include "CondFormats/DataRecord/interface/SiPixelFedCablingMapRcd.h"
+#include "CondFormats/DataRecord/interface/SiPixelQualityRcd.h"
+#include "CondFormats/SiPixelObjects/interface/SiPixelFedCablingMap.h"
+#include "CondFormats/SiPixelObjects/interface/SiPixelQuality.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelFedCablingMapGPUWrapper.h"
+#include "RecoTracker/Record/interface/CkfComponentsRecord.h"
+
+class SiPixelFedCablingMapGPUWrapperESProducer : public edm::ESProducer {
+public:
+  explicit SiPixelFedCablingMapGPUWrapperESProducer(const edm::ParameterSet& iConfig);
+  std::unique_ptr<SiPixelFedCablingMapGPUWrapper> produce(const CkfComponentsRecord& iRecord);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  edm::ESGetToken<SiPixelFedCablingMap, SiPixelFedCablingMapRcd> cablingMapToken_;
+  edm::ESGetToken<SiPixelQuality, SiPixelQualityRcd> qualityToken_;
+  edm::ESGetToken<TrackerGeometry, TrackerDigiGeometryRecord> geometryToken_;
+  bool useQuality_;
+};
+
+SiPixelFedCablingMapGPUWrapperESProducer::SiPixelFedCablingMapGPUWrapperESProducer(const edm::ParameterSet& iConfig)
+    : useQuality_(iConfig.getParameter<bool>("UseQualityInfo")) {
+  auto const& component = iConfig.getParameter<std::string>("ComponentName");
+  auto c = setWhatProduced(this, component);
+  c.setConsumes(cablingMapToken_, edm::ESInputTag("", iConfig.getParameter<std::string>("CablingMapLabel")))
+      .setConsumes(geometryToken_);
+  if (useQuality_) {
+    c.setConsumes(qualityToken_);
+  }
+}
+
+void SiPixelFedCablingMapGPUWrapperESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<std::string>("ComponentName", "");
+  desc.add<std::string>("CablingMapLabel", "")->setComment("CablingMap label");
+  desc.add<bool>("UseQualityInfo", false);
+
+  descriptions.add("siPixelFedCablingMapGPUWrapper", desc);
+}
+
+std::unique_ptr<SiPixelFedCablingMapGPUWrapper> SiPixelFedCablingMapGPUWrapperESProducer::produce(
+    const CkfComponentsRecord& iRecord) {
+  const SiPixelQuality* quality = nullptr;
+  if (useQuality_) {
+    quality = &iRecord.get(qualityToken_);
+  }
+  return std::make_unique<SiPixelFedCablingMapGPUWrapper>(
+      iRecord.get(cablingMapToken_), iRecord.get(geometryToken_), quality);
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(SiPixelFedCablingMapGPUWrapperESProducer);
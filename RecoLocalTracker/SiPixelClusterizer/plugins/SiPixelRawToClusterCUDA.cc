@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/SiPixelCluster/interface/SiPixelClustersCUDA.h"
+#include "CalibTracker/Records/interface/SiPixelGainCalibrationForHLTGPURcd.h"
+#include "DataFormats/FEDRawData/interface/FEDHeader.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+#include "DataFormats/FEDRawData/interface/FEDRawData.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDTrailer.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelFedCablingMapGPUWrapper.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelGainCalibrationForHLTGPU.h"
+#include "RecoTracker/Record/interface/CkfComponentsRecord.h"
+
+#include "SiPixelRawToClusterGPUKernel.h"
+
+/**
+ * Unpacks the phase-1 pixel raw data and finds the clusters on the GPU,
+ * with the same thresholds and calibration as SiPixelRawToDigi followed
+ * by SiPixelClusterProducer. The output stays on the device, the
+ * SiPixelClustersFromCUDA module converts it to the legacy clusters.
+ */
+class SiPixelRawToClusterCUDA : public edm::stream::EDProducer<> {
+public:
+  explicit SiPixelRawToClusterCUDA(const edm::ParameterSet& iConfig);
+  ~SiPixelRawToClusterCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<FEDRawDataCollection> rawGetToken_;
+  edm::EDPutTokenT<cms::cuda::Product<SiPixelClustersCUDA>> clusterPutToken_;
+  edm::ESGetToken<SiPixelFedCablingMapGPUWrapper, CkfComponentsRecord> cablingMapToken_;
+  edm::ESGetToken<SiPixelGainCalibrationForHLTGPU, SiPixelGainCalibrationForHLTGPURcd> gainsToken_;
+
+  pixelgpudetails::ClusterizerParameters params_;
+};
+
+SiPixelRawToClusterCUDA::SiPixelRawToClusterCUDA(const edm::ParameterSet& iConfig)
+    : rawGetToken_(consumes<FEDRawDataCollection>(iConfig.getParameter<edm::InputTag>("InputLabel"))),
+      clusterPutToken_(produces<cms::cuda::Product<SiPixelClustersCUDA>>()),
+      cablingMapToken_(esConsumes<SiPixelFedCablingMapGPUWrapper, CkfComponentsRecord>(
+          edm::ESInputTag("", iConfig.getParameter<std::string>("CablingMapLabel")))) {
+  params_.missCalibrate = iConfig.getParameter<bool>("MissCalibrate");
+  params_.electronPerADCGain = iConfig.getParameter<double>("ElectronPerADCGain");
+  params_.vCaltoElectronGain = iConfig.getParameter<int>("VCaltoElectronGain");
+  params_.vCaltoElectronGainLayer1 = iConfig.getParameter<int>("VCaltoElectronGain_L1");
+  params_.vCaltoElectronOffset = iConfig.getParameter<int>("VCaltoElectronOffset");
+  params_.vCaltoElectronOffsetLayer1 = iConfig.getParameter<int>("VCaltoElectronOffset_L1");
+  params_.channelThreshold = iConfig.getParameter<int>("ChannelThreshold");
+  params_.seedThreshold = iConfig.getParameter<int>("SeedThreshold");
+  params_.clusterThreshold = iConfig.getParameter<int>("ClusterThreshold");
+  params_.clusterThresholdLayer1 = iConfig.getParameter<int>("ClusterThreshold_L1");
+  if (params_.missCalibrate) {
+    gainsToken_ = esConsumes<SiPixelGainCalibrationForHLTGPU, SiPixelGainCalibrationForHLTGPURcd>();
+  }
+}
+
+void SiPixelRawToClusterCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("InputLabel", edm::InputTag("rawDataCollector"));
+  desc.add<std::string>("CablingMapLabel", "")->setComment("label of the SiPixelFedCablingMapGPUWrapper");
+  // from PixelThresholdClusterizer
+  desc.add<bool>("MissCalibrate", true);
+  desc.add<double>("ElectronPerADCGain", 135.);
+  desc.add<int>("VCaltoElectronGain", 65);
+  desc.add<int>("VCaltoElectronGain_L1", 65);
+  desc.add<int>("VCaltoElectronOffset", -414);
+  desc.add<int>("VCaltoElectronOffset_L1", -414);
+  desc.add<int>("ChannelThreshold", 1000);
+  desc.add<int>("SeedThreshold", 1000);
+  desc.add<int>("ClusterThreshold", 4000);
+  desc.add<int>("ClusterThreshold_L1", 4000);
+  descriptions.add("siPixelRawToClusterCUDA", desc);
+}
+
+void SiPixelRawToClusterCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  cms::cuda::ScopedContextProduce ctx{iEvent.streamID()};
+
+  auto const& cablingMap = iSetup.getData(cablingMapToken_);
+  SiPixelGainForHLTonGPU const* gains = nullptr;
+  if (params_.missCalibrate) {
+    gains = iSetup.getData(gainsToken_).getGPUProductAsync(ctx.stream());
+  }
+  auto const& buffers = iEvent.get(rawGetToken_);
+
+  uint32_t maxWords = 0;
+  for (auto fed : cablingMap.fedIds()) {
+    maxWords += buffers.FEDData(fed).size() / sizeof(uint32_t);
+  }
+  pixelgpudetails::WordFedAppender wordFed(std::max(maxWords, 1u), ctx.stream());
+
+  for (auto fed : cablingMap.fedIds()) {
+    FEDRawData const& rawData = buffers.FEDData(fed);
+    if (rawData.size() == 0)
+      continue;
+    // the FED data is a header, the data words and a trailer, in 64-bit words
+    uint32_t const nWords64 = rawData.size() / sizeof(uint64_t);
+    if (rawData.size() % sizeof(uint64_t) != 0 || nWords64 < 2) {
+      edm::LogWarning("SiPixelRawToClusterCUDA") << "Skipping the FED " << fed << " with a data size of "
+                                                 << rawData.size() << " bytes";
+      continue;
+    }
+    uint64_t const* header = reinterpret_cast<uint64_t const*>(rawData.data());
+    uint64_t const* trailer = header + (nWords64 - 1);
+    while (header < trailer && FEDHeader(reinterpret_cast<unsigned char const*>(header)).moreHeaders())
+      ++header;
+    while (trailer > header && FEDTrailer(reinterpret_cast<unsigned char const*>(trailer)).moreTrailers())
+      --trailer;
+    if (trailer <= header + 1)
+      continue;
+    wordFed.append(reinterpret_cast<uint32_t const*>(header + 1),
+                   2 * (trailer - header - 1),
+                   fed - FEDNumbering::MINSiPixeluTCAFEDID);
+  }
+
+  ctx.emplace(iEvent,
+              clusterPutToken_,
+              pixelgpudetails::makeClustersAsync(cablingMap.getGPUProductAsync(ctx.stream()),
+                                                 gains,
+                                                 params_,
+                                                 wordFed,
+                                                 cablingMap.nModules(),
+                                                 ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(SiPixelRawToClusterCUDA);
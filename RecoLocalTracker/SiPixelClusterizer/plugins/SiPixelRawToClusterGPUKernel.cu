@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstring>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelFedCablingMapGPU.h"
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelGainForHLTonGPU.h"
+
+#include "SiPixelRawToClusterGPUKernel.h"
+#include "gpuClustering.h"
+
+namespace pixelgpudetails {
+
+  WordFedAppender::WordFedAppender(uint32_t maxWords, cudaStream_t stream)
+      : words_{cms::cuda::make_host_unique<uint32_t[]>(maxWords, stream)},
+        fedIndices_{cms::cuda::make_host_unique<uint8_t[]>(maxWords, stream)} {}
+
+  void WordFedAppender::append(uint32_t const* words, uint32_t nWords, uint8_t fedIndex) {
+    std::memcpy(words_.get() + size_, words, sizeof(uint32_t) * nWords);
+    std::fill(fedIndices_.get() + size_, fedIndices_.get() + size_ + nWords, fedIndex);
+    size_ += nWords;
+  }
+
+  namespace {
+
+    constexpr uint32_t scanBlockSize = 1024;
+    static_assert(MAX_MODULES % scanBlockSize == 0, "the modules are scanned by a single block");
+
+    // unpacks and calibrates each data word, and counts the digis of each module
+    __global__ void rawToDigi(SiPixelFedCablingMapGPU const* __restrict__ cablingMap,
+                              SiPixelGainForHLTonGPU const* __restrict__ gains,
+                              ClusterizerParameters params,
+                              uint32_t const* __restrict__ words,
+                              uint8_t const* __restrict__ fedIndices,
+                              uint32_t nWords,
+                              uint16_t* __restrict__ wordModule,
+                              uint16_t* __restrict__ wordRow,
+                              uint16_t* __restrict__ wordCol,
+                              uint16_t* __restrict__ wordAdc,
+                              uint16_t* __restrict__ wordCharge,
+                              uint32_t* __restrict__ digisInModule) {
+      for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nWords; i += gridDim.x * blockDim.x) {
+        wordModule[i] = invalidModuleId;
+        uint32_t const word = words[i];
+        if (word == 0)
+          continue;
+        uint32_t const link = (word >> LINK_shift) & LINK_mask;
+        uint32_t const roc = (word >> ROC_shift) & ROC_mask;
+        // the error words have ROC numbers above the 8 ROCs of a link
+        if (link < 1 || link > MAX_LINK || roc < 1 || roc > MAX_ROC)
+          continue;
+        uint32_t const index = cablingIndex(fedIndices[i], link, roc);
+        uint16_t const module = cablingMap->moduleId[index];
+        if (module == invalidModuleId || cablingMap->badRoc[index])
+          continue;
+
+        int rocRow;
+        int rocCol;
+        bool const layer1 = cablingMap->layer1[index];
+        if (layer1) {
+          rocRow = (word >> ROW_shift) & ROW_mask;
+          rocCol = (word >> COL_shift) & COL_mask;
+        } else {
+          uint32_t const dcol = (word >> DCOL_shift) & DCOL_mask;
+          uint32_t const pxid = (word >> PXID_shift) & PXID_mask;
+          if (dcol >= 26 || pxid < 2 || pxid >= 162)
+            continue;
+          rocRow = 80 - pxid / 2;
+          rocCol = dcol * 2 + pxid % 2;
+        }
+        if (rocRow < 0 || rocRow >= 80 || rocCol < 0 || rocCol >= 52)
+          continue;
+        int const row = cablingMap->rowOffset[index] + cablingMap->rowSlope[index] * rocRow;
+        int const col = cablingMap->colOffset[index] + cablingMap->colSlope[index] * rocCol;
+        int const adc = (word >> ADC_shift) & ADC_mask;
+
+        int electrons;
+        if (params.missCalibrate) {
+          auto const& pedAndGain = gains->getPedAndGain(module, col, row);
+          // nothing is kept from the dead and noisy columns
+          if (pedAndGain.gain <= 0.f)
+            continue;
+          float const vcal = adc * pedAndGain.gain - pedAndGain.ped * pedAndGain.gain;
+          electrons = layer1 ? int(vcal * params.vCaltoElectronGainLayer1 + params.vCaltoElectronOffsetLayer1)
+                             : int(vcal * params.vCaltoElectronGain + params.vCaltoElectronOffset);
+        } else {
+          electrons = int(adc * params.electronPerADCGain);
+        }
+        if (electrons < 100)
+          electrons = 100;
+        if (electrons < params.channelThreshold)
+          continue;
+
+        wordModule[i] = module;
+        wordRow[i] = row;
+        wordCol[i] = col;
+        wordAdc[i] = adc;
+        wordCharge[i] = electrons;
+        atomicAdd(&digisInModule[module], 1);
+      }
+    }
+
+    // starts[0] = 0 and starts[i+1] = counts[0] + ... + counts[i], for n up to MAX_MODULES
+    __global__ void prefixScan(uint32_t const* __restrict__ counts, uint32_t* __restrict__ starts, uint32_t n) {
+      constexpr uint32_t perThread = MAX_MODULES / scanBlockSize;
+      __shared__ uint32_t ws[MAX_MODULES];
+      for (uint32_t i = threadIdx.x; i < n; i += blockDim.x)
+        ws[i] = counts[i];
+      __syncthreads();
+      for (uint32_t offset = 1; offset < n; offset *= 2) {
+        uint32_t add[perThread];
+        for (uint32_t k = 0; k < perThread; ++k) {
+          uint32_t const i = threadIdx.x + k * blockDim.x;
+          add[k] = (i < n && i >= offset) ? ws[i - offset] : 0;
+        }
+        __syncthreads();
+        for (uint32_t k = 0; k < perThread; ++k) {
+          uint32_t const i = threadIdx.x + k * blockDim.x;
+          if (i < n)
+            ws[i] += add[k];
+        }
+        __syncthreads();
+      }
+      if (threadIdx.x == 0)
+        starts[0] = 0;
+      for (uint32_t i = threadIdx.x; i < n; i += blockDim.x)
+        starts[i + 1] = ws[i];
+    }
+
+    // groups the digis by module, the order within a module is not preserved
+    __global__ void groupByModule(uint32_t nWords,
+                                  uint16_t const* __restrict__ wordModule,
+                                  uint16_t const* __restrict__ wordRow,
+                                  uint16_t const* __restrict__ wordCol,
+                                  uint16_t const* __restrict__ wordAdc,
+                                  uint16_t const* __restrict__ wordCharge,
+                                  uint32_t* __restrict__ moduleFill,
+                                  SiPixelClustersCUDA::DeviceView digis) {
+      for (uint32_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nWords; i += gridDim.x * blockDim.x) {
+        uint16_t const module = wordModule[i];
+        if (module == invalidModuleId)
+          continue;
+        uint32_t const j = atomicAdd(&moduleFill[module], 1);
+        digis.xx[j] = wordRow[i];
+        digis.yy[j] = wordCol[i];
+        digis.adc[j] = wordAdc[i];
+        digis.charge[j] = wordCharge[i];
+        digis.moduleInd[j] = module;
+        digis.pdigi[j] = i;
+      }
+    }
+
+  }  // namespace
+
+  SiPixelClustersCUDA makeClustersAsync(SiPixelFedCablingMapGPU const* cablingMap,
+                                        SiPixelGainForHLTonGPU const* gains,
+                                        ClusterizerParameters const& params,
+                                        WordFedAppender const& wordFed,
+                                        uint32_t nModules,
+                                        cudaStream_t stream) {
+    uint32_t const nWords = wordFed.size();
+    SiPixelClustersCUDA clusters(std::max(nWords, 1u), nModules, stream);
+    auto view = clusters.view();
+
+    auto words_d = cms::cuda::make_device_unique<uint32_t[]>(std::max(nWords, 1u), stream);
+    auto fedIndices_d = cms::cuda::make_device_unique<uint8_t[]>(std::max(nWords, 1u), stream);
+    auto wordModule_d = cms::cuda::make_device_unique<uint16_t[]>(std::max(nWords, 1u), stream);
+    auto wordRow_d = cms::cuda::make_device_unique<uint16_t[]>(std::max(nWords, 1u), stream);
+    auto wordCol_d = cms::cuda::make_device_unique<uint16_t[]>(std::max(nWords, 1u), stream);
+    auto wordAdc_d = cms::cuda::make_device_unique<uint16_t[]>(std::max(nWords, 1u), stream);
+    auto wordCharge_d = cms::cuda::make_device_unique<uint16_t[]>(std::max(nWords, 1u), stream);
+    auto digisInModule_d = cms::cuda::make_device_unique<uint32_t[]>(nModules, stream);
+    auto moduleFill_d = cms::cuda::make_device_unique<uint32_t[]>(nModules, stream);
+    auto colOrdered_d = cms::cuda::make_device_unique<uint32_t[]>(std::max(nWords, 1u), stream);
+
+    cudaCheck(cudaMemsetAsync(digisInModule_d.get(), 0, nModules * sizeof(uint32_t), stream));
+    if (nWords > 0) {
+      cudaCheck(cudaMemcpyAsync(
+          words_d.get(), wordFed.words(), nWords * sizeof(uint32_t), cudaMemcpyHostToDevice, stream));
+      cudaCheck(cudaMemcpyAsync(
+          fedIndices_d.get(), wordFed.fedIndices(), nWords * sizeof(uint8_t), cudaMemcpyHostToDevice, stream));
+
+      int const threadsPerBlock = 512;
+      int const blocks = (nWords + threadsPerBlock - 1) / threadsPerBlock;
+      rawToDigi<<<blocks, threadsPerBlock, 0, stream>>>(cablingMap,
+                                                        gains,
+                                                        params,
+                                                        words_d.get(),
+                                                        fedIndices_d.get(),
+                                                        nWords,
+                                                        wordModule_d.get(),
+                                                        wordRow_d.get(),
+                                                        wordCol_d.get(),
+                                                        wordAdc_d.get(),
+                                                        wordCharge_d.get(),
+                                                        digisInModule_d.get());
+      cudaCheck(cudaGetLastError());
+    }
+
+    prefixScan<<<1, scanBlockSize, 0, stream>>>(digisInModule_d.get(), view.moduleStart, nModules);
+    cudaCheck(cudaGetLastError());
+
+    if (nWords > 0) {
+      cudaCheck(cudaMemcpyAsync(
+          moduleFill_d.get(), view.moduleStart, nModules * sizeof(uint32_t), cudaMemcpyDeviceToDevice, stream));
+      int const threadsPerBlock = 512;
+      int const blocks = (nWords + threadsPerBlock - 1) / threadsPerBlock;
+      groupByModule<<<blocks, threadsPerBlock, 0, stream>>>(nWords,
+                                                            wordModule_d.get(),
+                                                            wordRow_d.get(),
+                                                            wordCol_d.get(),
+                                                            wordAdc_d.get(),
+                                                            wordCharge_d.get(),
+                                                            moduleFill_d.get(),
+                                                            view);
+      cudaCheck(cudaGetLastError());
+    }
+
+    gpuClustering::ClusterThresholds const thresholds{
+        params.seedThreshold, params.clusterThreshold, params.clusterThresholdLayer1};
+    gpuClustering::findClus<<<nModules, 256, 0, stream>>>(view.xx,
+                                                          view.yy,
+                                                          view.charge,
+                                                          view.moduleStart,
+                                                          cablingMap->moduleLayer1,
+                                                          nModules,
+                                                          thresholds,
+                                                          view.clus,
+                                                          colOrdered_d.get(),
+                                                          view.clusInModule);
+    cudaCheck(cudaGetLastError());
+
+    prefixScan<<<1, scanBlockSize, 0, stream>>>(view.clusInModule, view.clusModuleStart, nModules);
+    cudaCheck(cudaGetLastError());
+
+    // the temporary buffers are returned to the caching allocator, and reused only after the kernels have run
+    return clusters;
+  }
+
+}  // namespace pixelgpudetails
@@ -0,0 +1,78 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_plugins_SiPixelRawToClusterGPUKernel_h
+#define RecoLocalTracker_SiPixelClusterizer_plugins_SiPixelRawToClusterGPUKernel_h
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/SiPixelCluster/interface/SiPixelClustersCUDA.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+struct SiPixelFedCablingMapGPU;
+struct SiPixelGainForHLTonGPU;
+
+namespace pixelgpudetails {
+
+  // the phase-1 raw data format, as in PixelDataFormatter
+  constexpr uint32_t ADC_shift = 0;
+  constexpr uint32_t PXID_shift = ADC_shift + 8;
+  constexpr uint32_t DCOL_shift = PXID_shift + 8;
+  constexpr uint32_t ROC_shift = DCOL_shift + 5;
+  constexpr uint32_t LINK_shift = ROC_shift + 5;
+  // the first barrel layer is read out with the row and column of the ROC
+  constexpr uint32_t ROW_shift = ADC_shift + 8;
+  constexpr uint32_t COL_shift = ROW_shift + 7;
+
+  constexpr uint32_t LINK_mask = ~(~uint32_t(0) << 6);
+  constexpr uint32_t ROC_mask = ~(~uint32_t(0) << 5);
+  constexpr uint32_t DCOL_mask = ~(~uint32_t(0) << 5);
+  constexpr uint32_t PXID_mask = ~(~uint32_t(0) << 8);
+  constexpr uint32_t ADC_mask = ~(~uint32_t(0) << 8);
+  constexpr uint32_t ROW_mask = ~(~uint32_t(0) << 7);
+  constexpr uint32_t COL_mask = ~(~uint32_t(0) << 6);
+
+  // same parameters as PixelThresholdClusterizer
+  struct ClusterizerParameters {
+    bool missCalibrate;
+    float electronPerADCGain;
+    int32_t vCaltoElectronGain;
+    int32_t vCaltoElectronGainLayer1;
+    int32_t vCaltoElectronOffset;
+    int32_t vCaltoElectronOffsetLayer1;
+    int32_t channelThreshold;
+    int32_t seedThreshold;
+    int32_t clusterThreshold;
+    int32_t clusterThresholdLayer1;
+  };
+
+  // The 32-bit data words of the FEDs of an event, in pinned host memory,
+  // with the index of their FED from FEDNumbering::MINSiPixeluTCAFEDID.
+  class WordFedAppender {
+  public:
+    WordFedAppender(uint32_t maxWords, cudaStream_t stream);
+
+    void append(uint32_t const* words, uint32_t nWords, uint8_t fedIndex);
+
+    uint32_t size() const { return size_; }
+    uint32_t const* words() const { return words_.get(); }
+    uint8_t const* fedIndices() const { return fedIndices_.get(); }
+
+  private:
+    cms::cuda::host::unique_ptr<uint32_t[]> words_;
+    cms::cuda::host::unique_ptr<uint8_t[]> fedIndices_;
+    uint32_t size_ = 0;
+  };
+
+  // Unpacks, calibrates and clusters the data words on the device: the
+  // kernels are queued on the stream and the clusters returned at once,
+  // to be used only in the work queued on the same stream.
+  SiPixelClustersCUDA makeClustersAsync(SiPixelFedCablingMapGPU const* cablingMap,
+                                        SiPixelGainForHLTonGPU const* gains,
+                                        ClusterizerParameters const& params,
+                                        WordFedAppender const& wordFed,
+                                        uint32_t nModules,
+                                        cudaStream_t stream);
+
+}  // namespace pixelgpudetails
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_plugins_gpuClustering_h
+#define RecoLocalTracker_SiPixelClusterizer_plugins_gpuClustering_h
+
+#include <cstdint>
+#include <cstdio>
+
+#include "CUDADataFormats/SiPixelCluster/interface/SiPixelClustersCUDA.h"
+
+namespace gpuClustering {
+
+  // larger than the 416 columns of the phase-1 modules
+  constexpr uint32_t MaxNumColumns = 512;
+  // the clusters beyond this number are dropped from the module
+  constexpr uint32_t MaxNumClustersPerModule = 1024;
+
+  constexpr int32_t invalidCluster = SiPixelClustersCUDA::invalidCluster;
+
+  struct ClusterThresholds {
+    int32_t seedThreshold;
+    int32_t clusterThreshold;
+    int32_t clusterThresholdLayer1;
+  };
+
+  // One block per module: labels the digis of the module with the
+  // cluster they belong to, connecting the pixels touching by a side or
+  // a corner as PixelThresholdClusterizer does. A cluster is kept if it
+  // has a seed pixel and a total charge above the threshold of its
+  // layer; its digis are labelled from 0 to clusInModule-1, the digis of
+  // the clusters dropped are labelled invalidCluster.
+  //
+  // colOrdered is a scratch array with one entry per digi.
+  __global__ void findClus(uint16_t const* __restrict__ xx,
+                           uint16_t const* __restrict__ yy,
+                           uint16_t const* __restrict__ charge,
+                           uint32_t const* __restrict__ moduleStart,
+                           uint8_t const* __restrict__ moduleLayer1,
+                           uint32_t nModules,
+                           ClusterThresholds thresholds,
+                           int32_t* __restrict__ clus,
+                           uint32_t* __restrict__ colOrdered,
+                           uint32_t* __restrict__ clusInModule) {
+    __shared__ uint32_t colStart[MaxNumColumns + 1];
+    __shared__ uint32_t colFill[MaxNumColumns];
+    __shared__ int32_t clusCharge[MaxNumClustersPerModule];
+    __shared__ int32_t clusSeed[MaxNumClustersPerModule];
+    __shared__ uint32_t foundClusters;
+
+    uint32_t const module = blockIdx.x;
+    if (module >= nModules)
+      return;
+    uint32_t const first = moduleStart[module];
+    uint32_t const last = moduleStart[module + 1];
+    if (first == last) {
+      if (threadIdx.x == 0)
+        clusInModule[module] = 0;
+      return;
+    }
+
+    // the labels are the local index of a pixel of the cluster
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      clus[i] = i - first;
+    }
+
+    // order the pixels by column, to look for the neighbours only in the adjacent columns
+    for (uint32_t c = threadIdx.x; c < MaxNumColumns; c += blockDim.x) {
+      colFill[c] = 0;
+    }
+    __syncthreads();
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      atomicAdd(&colFill[yy[i]], 1);
+    }
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      colStart[0] = 0;
+      for (uint32_t c = 0; c < MaxNumColumns; ++c) {
+        colStart[c + 1] = colStart[c] + colFill[c];
+        colFill[c] = colStart[c];
+      }
+      foundClusters = 0;
+    }
+    __syncthreads();
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      colOrdered[first + atomicAdd(&colFill[yy[i]], 1)] = i;
+    }
+    __syncthreads();
+
+    // propagate the smallest label to all the pixels connected to it
+    bool more = true;
+    while (__syncthreads_or(more)) {
+      more = false;
+      for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+        int const x = xx[i];
+        uint32_t const y = yy[i];
+        uint32_t const cBegin = colStart[y > 0 ? y - 1 : 0];
+        uint32_t const cEnd = colStart[y + 1 < MaxNumColumns ? y + 2 : MaxNumColumns];
+        for (uint32_t k = cBegin; k < cEnd; ++k) {
+          uint32_t const j = colOrdered[first + k];
+          if (j == i || abs(int(xx[j]) - x) > 1)
+            continue;
+          int32_t const label = clus[j];
+          if (atomicMin(&clus[i], label) > label)
+            more = true;
+        }
+      }
+      __syncthreads();
+      // the label of a pixel is never larger than its index: follow them to the root
+      for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+        int32_t label = clus[i];
+        while (clus[first + label] != label)
+          label = clus[first + label];
+        clus[i] = label;
+      }
+    }
+
+    // number the clusters from their root pixel, and accumulate their charge
+    for (uint32_t i = threadIdx.x; i < MaxNumClustersPerModule; i += blockDim.x) {
+      clusCharge[i] = 0;
+      clusSeed[i] = 0;
+    }
+    __syncthreads();
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      if (clus[i] == int32_t(i - first)) {
+        uint32_t const id = atomicAdd(&foundClusters, 1);
+        // the roots are marked with a negative label
+        clus[i] = id < MaxNumClustersPerModule ? -int32_t(id) - 2 : invalidCluster;
+      }
+    }
+    __syncthreads();
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      int32_t const label = clus[i];
+      if (label >= 0) {
+        int32_t const root = clus[first + label];
+        clus[i] = root == invalidCluster ? invalidCluster : -root - 2;
+      }
+    }
+    __syncthreads();
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      if (clus[i] < -1)
+        clus[i] = -clus[i] - 2;
+      int32_t const id = clus[i];
+      if (id != invalidCluster) {
+        atomicAdd(&clusCharge[id], charge[i]);
+        if (charge[i] >= thresholds.seedThreshold)
+          clusSeed[id] = 1;
+      }
+    }
+    __syncthreads();
+
+    // keep the clusters above the thresholds, in the order of their numbering
+    if (threadIdx.x == 0) {
+      if (foundClusters > MaxNumClustersPerModule) {
+#ifdef GPU_DEBUG
+        printf("Module %u has %u clusters, only the first %u are kept\n",
+               module,
+               foundClusters,
+               MaxNumClustersPerModule);
+#endif
+        foundClusters = MaxNumClustersPerModule;
+      }
+      int32_t const threshold =
+          moduleLayer1[module] ? thresholds.clusterThresholdLayer1 : thresholds.clusterThreshold;
+      uint32_t kept = 0;
+      for (uint32_t c = 0; c < foundClusters; ++c) {
+        clusSeed[c] = (clusSeed[c] && clusCharge[c] >= threshold) ? int32_t(kept++) : invalidCluster;
+      }
+      clusInModule[module] = kept;
+    }
+    __syncthreads();
+    for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+      if (clus[i] != invalidCluster)
+        clus[i] = clusSeed[clus[i]];
+    }
+  }
+
+}  // namespace gpuClustering
+
+#endif
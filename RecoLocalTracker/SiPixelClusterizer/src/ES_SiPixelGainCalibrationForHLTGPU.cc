@@ -0,0 +1,4 @@
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelGainCalibrationForHLTGPU.h"
+#include "FWCore/Utilities/interface/typelookup.h"
+
+TYPELOOKUP_DATA_REG(SiPixelGainCalibrationForHLTGPU);
@@ -0,0 +1,106 @@
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelFedCablingMapGPUWrapper.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+
+#include "CondFormats/SiPixelObjects/interface/CablingPathToDetUnit.h"
+#include "CondFormats/SiPixelObjects/interface/LocalPixel.h"
+#include "CondFormats/SiPixelObjects/interface/PixelROC.h"
+#include "CondFormats/SiPixelObjects/interface/SiPixelFedCablingMap.h"
+#include "CondFormats/SiPixelObjects/interface/SiPixelFedCablingTree.h"
+#include "CondFormats/SiPixelObjects/interface/SiPixelQuality.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+#include "DataFormats/SiPixelDetId/interface/PixelModuleName.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "Geometry/CommonTopologies/interface/GeomDetEnumerators.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+SiPixelFedCablingMapGPUWrapper::SiPixelFedCablingMapGPUWrapper(SiPixelFedCablingMap const& cablingMap,
+                                                               TrackerGeometry const& trackerGeom,
+                                                               SiPixelQuality const* badPixelInfo)
+    : fedIds_(cablingMap.fedIds()),
+      hasQuality_(badPixelInfo != nullptr),
+      cablingMapHost_(cms::cuda::make_host_noncached_unique<SiPixelFedCablingMapGPU>()) {
+  using namespace pixelgpudetails;
+  using namespace sipixelobjects;
+
+  for (auto fed : fedIds_) {
+    if (fed < FEDNumbering::MINSiPixeluTCAFEDID || fed > FEDNumbering::MAXSiPixeluTCAFEDID) {
+      throw cms::Exception("Configuration") << "The GPU unpacking supports only the phase-1 pixel FEDs, the cabling "
+                                            << "map " << cablingMap.version() << " contains the FED " << fed;
+    }
+  }
+
+  // the module index used on the GPU is the index of the pixel detector in the geometry
+  std::unordered_map<uint32_t, unsigned int> moduleIndex;
+  unsigned int nModules = 0;
+  for (auto const* det : trackerGeom.detUnits()) {
+    if (!GeomDetEnumerators::isTrackerPixel(det->subDetector()))
+      continue;
+    moduleIndex[det->geographicalId().rawId()] = det->index();
+    nModules = std::max(nModules, static_cast<unsigned int>(det->index()) + 1);
+  }
+  if (nModules > MAX_MODULES) {
+    throw cms::Exception("LogicError") << "The geometry has " << nModules << " pixel modules, the GPU unpacking "
+                                       << "supports at most " << MAX_MODULES;
+  }
+
+  auto& map = *cablingMapHost_;
+  map.nModules = nModules;
+  std::fill(std::begin(map.moduleLayer1), std::end(map.moduleLayer1), 0);
+
+  std::unique_ptr<SiPixelFedCablingTree> const cabling = cablingMap.cablingTree();
+  for (unsigned int fed = 0; fed < MAX_FED; ++fed) {
+    for (unsigned int link = 1; link <= MAX_LINK; ++link) {
+      for (unsigned int roc = 1; roc <= MAX_ROC; ++roc) {
+        unsigned int const i = cablingIndex(fed, link, roc);
+        CablingPathToDetUnit path = {fed + FEDNumbering::MINSiPixeluTCAFEDID, link, roc};
+        PixelROC const* pixelRoc = cabling->findItem(path);
+        auto module = pixelRoc ? moduleIndex.find(pixelRoc->rawId()) : moduleIndex.end();
+        if (module == moduleIndex.end()) {
+          map.rawId[i] = 0;
+          map.moduleId[i] = invalidModuleId;
+          map.rowOffset[i] = map.colOffset[i] = 0;
+          map.rowSlope[i] = map.colSlope[i] = 0;
+          map.badRoc[i] = 1;
+          map.layer1[i] = 0;
+          continue;
+        }
+        uint32_t const rawId = pixelRoc->rawId();
+        map.rawId[i] = rawId;
+        map.moduleId[i] = module->second;
+
+        // the frame conversion is linear in the row and column of the ROC
+        GlobalPixel const origin = pixelRoc->toGlobal(LocalPixel(LocalPixel::RocRowCol{0, 0}));
+        GlobalPixel const unit = pixelRoc->toGlobal(LocalPixel(LocalPixel::RocRowCol{1, 1}));
+        map.rowOffset[i] = origin.row;
+        map.colOffset[i] = origin.col;
+        map.rowSlope[i] = unit.row - origin.row;
+        map.colSlope[i] = unit.col - origin.col;
+
+        map.badRoc[i] = badPixelInfo && badPixelInfo->IsRocBad(rawId, pixelRoc->idInDetUnit());
+        map.layer1[i] = PixelModuleName::isBarrel(rawId) && PixelROC::bpixLayerPhase1(rawId) == 1;
+        map.moduleLayer1[module->second] = map.layer1[i];
+      }
+    }
+  }
+}
+
+SiPixelFedCablingMapGPUWrapper::~SiPixelFedCablingMapGPUWrapper() {}
+
+const SiPixelFedCablingMapGPU* SiPixelFedCablingMapGPUWrapper::getGPUProductAsync(cudaStream_t cudaStream) const {
+  const auto& data = gpuData_.dataForCurrentDeviceAsync(cudaStream, [this](GPUData& data, cudaStream_t stream) {
+    cudaCheck(cudaMalloc(&data.cablingMapDevice, sizeof(SiPixelFedCablingMapGPU)));
+    cudaCheck(cudaMemcpyAsync(data.cablingMapDevice,
+                              cablingMapHost_.get(),
+                              sizeof(SiPixelFedCablingMapGPU),
+                              cudaMemcpyHostToDevice,
+                              stream));
+  });
+  return data.cablingMapDevice;
+}
+
+SiPixelFedCablingMapGPUWrapper::GPUData::~GPUData() { cudaCheck(cudaFree(cablingMapDevice)); }
@@ -0,0 +1,85 @@
+#include "RecoLocalTracker/SiPixelClusterizer/interface/SiPixelGainCalibrationForHLTGPU.h"
+
+#include <algorithm>
+
+#include "CondFormats/SiPixelObjects/interface/SiPixelGainCalibrationForHLT.h"
+#include "Geometry/CommonDetUnit/interface/PixelGeomDetUnit.h"
+#include "Geometry/CommonTopologies/interface/GeomDetEnumerators.h"
+#include "Geometry/CommonTopologies/interface/PixelTopology.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+SiPixelGainCalibrationForHLTGPU::SiPixelGainCalibrationForHLTGPU(SiPixelGainCalibrationForHLT const& gains,
+                                                                 TrackerGeometry const& geom) {
+  std::vector<PixelGeomDetUnit const*> modules;
+  unsigned int maxRows = 0;
+  unsigned int maxColumns = 0;
+  for (auto const* det : geom.detUnits()) {
+    if (!GeomDetEnumerators::isTrackerPixel(det->subDetector()))
+      continue;
+    auto const* pixelDet = dynamic_cast<PixelGeomDetUnit const*>(det);
+    if (modules.size() <= static_cast<unsigned int>(det->index()))
+      modules.resize(det->index() + 1, nullptr);
+    modules[det->index()] = pixelDet;
+    maxRows = std::max(maxRows, static_cast<unsigned int>(pixelDet->specificTopology().nrows()));
+    maxColumns = std::max(maxColumns, static_cast<unsigned int>(pixelDet->specificTopology().ncolumns()));
+  }
+
+  auto& table = gainForHLTonHost_;
+  table.nModules = modules.size();
+  table.maxColumns = maxColumns;
+  table.numberOfRowsAveragedOver = gains.getNumberOfRowsToAverageOver();
+  table.nBlocks = (maxRows + table.numberOfRowsAveragedOver - 1) / table.numberOfRowsAveragedOver;
+  size_t const size = static_cast<size_t>(table.nModules) * table.maxColumns * table.nBlocks;
+  pedestalsHost_ = cms::cuda::make_host_noncached_unique<SiPixelGainForHLTonGPU::DecodingStructure[]>(size);
+  table.v_pedestals = pedestalsHost_.get();
+  std::fill(pedestalsHost_.get(), pedestalsHost_.get() + size, SiPixelGainForHLTonGPU::DecodingStructure{0.f, 0.f});
+
+  for (unsigned int m = 0; m < modules.size(); ++m) {
+    if (modules[m] == nullptr)
+      continue;
+    auto const rangeAndCols = gains.getRangeAndNCols(modules[m]->geographicalId().rawId());
+    int const nCols = rangeAndCols.second;
+    // the modules missing from the payload are left with a null gain, as the dead columns
+    if (nCols == 0)
+      continue;
+    int const nRows = modules[m]->specificTopology().nrows();
+    for (int col = 0; col < nCols; ++col) {
+      for (unsigned int block = 0; block * table.numberOfRowsAveragedOver < static_cast<unsigned int>(nRows); ++block) {
+        bool isDead = false;
+        bool isNoisy = false;
+        auto const pedAndGain = gains.getPedAndGain(
+            col, block * table.numberOfRowsAveragedOver, rangeAndCols.first, nCols, isDead, isNoisy);
+        auto& entry = pedestalsHost_[(m * table.maxColumns + col) * table.nBlocks + block];
+        if (!isDead && !isNoisy)
+          entry = {pedAndGain.first, pedAndGain.second};
+      }
+    }
+  }
+}
+
+SiPixelGainCalibrationForHLTGPU::~SiPixelGainCalibrationForHLTGPU() {}
+
+const SiPixelGainForHLTonGPU* SiPixelGainCalibrationForHLTGPU::getGPUProductAsync(cudaStream_t cudaStream) const {
+  const auto& data = gpuData_.dataForCurrentDeviceAsync(cudaStream, [this](GPUData& data, cudaStream_t stream) {
+    size_t const bytes = sizeof(SiPixelGainForHLTonGPU::DecodingStructure) * gainForHLTonHost_.nModules *
+                         gainForHLTonHost_.maxColumns * gainForHLTonHost_.nBlocks;
+    cudaCheck(cudaMalloc(&data.gainForHLTonGPU, sizeof(SiPixelGainForHLTonGPU)));
+    cudaCheck(cudaMalloc(&data.gainDataOnGPU, bytes));
+    cudaCheck(cudaMemcpyAsync(data.gainDataOnGPU, pedestalsHost_.get(), bytes, cudaMemcpyHostToDevice, stream));
+    // the device copy of the table points to the device copy of the data
+    cudaCheck(cudaMemcpyAsync(
+        data.gainForHLTonGPU, &gainForHLTonHost_, sizeof(SiPixelGainForHLTonGPU), cudaMemcpyHostToDevice, stream));
+    cudaCheck(cudaMemcpyAsync(&(data.gainForHLTonGPU->v_pedestals),
+                              &(data.gainDataOnGPU),
+                              sizeof(SiPixelGainForHLTonGPU::DecodingStructure*),
+                              cudaMemcpyHostToDevice,
+                              stream));
+  });
+  return data.gainForHLTonGPU;
+}
+
+SiPixelGainCalibrationForHLTGPU::GPUData::~GPUData() {
+  cudaCheck(cudaFree(gainForHLTonGPU));
+  cudaCheck(cudaFree(gainDataOnGPU));
+}
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/requireDevices.h"
+#include "RecoLocalTracker/SiPixelClusterizer/plugins/gpuClustering.h"
+
+/**
+ * Runs findClus on a few hand-made modules, and checks the pixels
+ * labelled together and the clusters dropped by the thresholds.
+ */
+
+namespace {
+  int failures = 0;
+
+  void check(bool condition, const char* what) {
+    if (!condition) {
+      std::cout << "FAILED: " << what << std::endl;
+      ++failures;
+    }
+  }
+
+  template <typename T>
+  T* toDevice(std::vector<T> const& v) {
+    T* d;
+    cudaCheck(cudaMalloc(&d, std::max<size_t>(v.size(), 1) * sizeof(T)));
+    cudaCheck(cudaMemcpy(d, v.data(), v.size() * sizeof(T), cudaMemcpyHostToDevice));
+    return d;
+  }
+}  // namespace
+
+int main() {
+  cms::cudatest::requireDevices();
+
+  // module 0: two pixels touching by a corner, a single pixel, a pixel below the cluster threshold,
+  //           two pixels separated by one row, and a pixel without a seed next to a seed
+  std::vector<uint16_t> xx = {10, 11, 20, 30, 40, 42, 50, 51};
+  std::vector<uint16_t> yy = {10, 11, 10, 30, 40, 40, 60, 60};
+  std::vector<uint16_t> charge = {3000, 3000, 5000, 2000, 5000, 5000, 500, 4000};
+  // module 1 is empty, module 2 is in the first layer and has a higher threshold
+  xx.push_back(70);
+  yy.push_back(100);
+  charge.push_back(5000);
+  std::vector<uint32_t> moduleStart = {0, 8, 8, 9};
+  std::vector<uint8_t> moduleLayer1 = {0, 0, 1};
+  uint32_t const nModules = 3;
+  uint32_t const nDigis = xx.size();
+
+  auto xx_d = toDevice(xx);
+  auto yy_d = toDevice(yy);
+  auto charge_d = toDevice(charge);
+  auto moduleStart_d = toDevice(moduleStart);
+  auto moduleLayer1_d = toDevice(moduleLayer1);
+  int32_t* clus_d;
+  uint32_t* colOrdered_d;
+  uint32_t* clusInModule_d;
+  cudaCheck(cudaMalloc(&clus_d, nDigis * sizeof(int32_t)));
+  cudaCheck(cudaMalloc(&colOrdered_d, nDigis * sizeof(uint32_t)));
+  cudaCheck(cudaMalloc(&clusInModule_d, nModules * sizeof(uint32_t)));
+
+  gpuClustering::ClusterThresholds const thresholds{1000, 4000, 6000};
+  gpuClustering::findClus<<<nModules, 64>>>(xx_d,
+                                            yy_d,
+                                            charge_d,
+                                            moduleStart_d,
+                                            moduleLayer1_d,
+                                            nModules,
+                                            thresholds,
+                                            clus_d,
+                                            colOrdered_d,
+                                            clusInModule_d);
+  cudaCheck(cudaGetLastError());
+
+  std::vector<int32_t> clus(nDigis);
+  std::vector<uint32_t> clusInModule(nModules);
+  cudaCheck(cudaMemcpy(clus.data(), clus_d, nDigis * sizeof(int32_t), cudaMemcpyDeviceToHost));
+  cudaCheck(cudaMemcpy(clusInModule.data(), clusInModule_d, nModules * sizeof(uint32_t), cudaMemcpyDeviceToHost));
+
+  auto const invalid = gpuClustering::invalidCluster;
+  check(clusInModule[0] == 5, "five clusters in the module 0");
+  check(clusInModule[1] == 0, "no clusters in the empty module");
+  check(clusInModule[2] == 0, "the first layer threshold is applied");
+  check(clus[0] != invalid && clus[0] == clus[1], "the pixels touching by a corner are in the same cluster");
+  check(clus[2] != invalid && clus[2] != clus[0], "the single pixel is a cluster");
+  check(clus[3] == invalid, "the cluster below the threshold is dropped");
+  check(clus[4] != invalid && clus[5] != invalid && clus[4] != clus[5], "the pixels one row apart are not connected");
+  check(clus[6] != invalid && clus[6] == clus[7], "the pixel below the seed threshold joins its neighbour");
+  check(clus[8] == invalid, "the cluster of the first layer below its threshold is dropped");
+  for (uint32_t i = 0; i < 8; ++i)
+    check(clus[i] == invalid || (clus[i] >= 0 && clus[i] < int32_t(clusInModule[0])), "the labels are in range");
+
+  cudaCheck(cudaFree(xx_d));
+  cudaCheck(cudaFree(yy_d));
+  cudaCheck(cudaFree(charge_d));
+  cudaCheck(cudaFree(moduleStart_d));
+  cudaCheck(cudaFree(moduleLayer1_d));
+  cudaCheck(cudaFree(clus_d));
+  cudaCheck(cudaFree(colOrdered_d));
+  cudaCheck(cudaFree(clusInModule_d));
+
+  if (failures == 0)
+    std::cout << "gpuClustering_t: all tests passed" << std::endl;
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
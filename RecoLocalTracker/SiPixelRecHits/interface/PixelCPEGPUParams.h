@@ -0,0 +1,42 @@
+#ifndef RecoLocalTracker_SiPixelRecHits_PixelCPEGPUParams_h
+#define RecoLocalTracker_SiPixelRecHits_PixelCPEGPUParams_h
+
+#include <vector>
+
+#include <cuda_runtime.h>
+
+#include "HeterogeneousCore/CUDACore/interface/ESProduct.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/pixelCPEforGPU.h"
+
+class PixelCPEGeneric;
+
+// The parameters of a PixelCPEGeneric for the GPU, copied to each
+// device on its first use. The modules are indexed as the pixel
+// GeomDetUnits in the TrackerGeometry.
+class PixelCPEGPUParams {
+public:
+  explicit PixelCPEGPUParams(PixelCPEGeneric const& cpe);
+  ~PixelCPEGPUParams();
+
+  uint32_t nModules() const { return detParams_.size(); }
+
+  // returns pointer to GPU memory
+  const pixelCPEforGPU::ParamsOnGPU* getGPUProductAsync(cudaStream_t cudaStream) const;
+
+private:
+  pixelCPEforGPU::CommonParams commonParams_;
+  std::vector<pixelCPEforGPU::TopologyParams> topologyParams_;
+  std::vector<pixelCPEforGPU::DetParams> detParams_;
+
+  struct GPUData {
+    ~GPUData();
+    pixelCPEforGPU::ParamsOnGPU paramsOnHost;  // with the device pointers
+    pixelCPEforGPU::ParamsOnGPU* paramsOnGPU = nullptr;
+    pixelCPEforGPU::CommonParams* commonParams = nullptr;
+    pixelCPEforGPU::TopologyParams* topologyParams = nullptr;
+    pixelCPEforGPU::DetParams* detParams = nullptr;
+  };
+  cms::cuda::ESProduct<GPUData> gpuData_;
+};
+
+#endif
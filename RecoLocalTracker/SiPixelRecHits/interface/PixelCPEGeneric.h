@@ -41,6 +41,12 @@
 #include <utility>
 #include <vector>
 
+namespace pixelCPEforGPU {
+  struct CommonParams;
+  struct TopologyParams;
+  struct DetParams;
+}  // namespace pixelCPEforGPU
+
 #if 0
 /** \class PixelCPEGeneric
  * Perform the position and error evaluation of pixel hits using
@@ -88,6 +94,12 @@ public:
 
   static void fillPSetDescription(edm::ParameterSetDescription &desc);
 
+  // the parameters of the positions from the module angles and of the simple errors, for the GPU,
+  // with one entry in detParams for each of the pixel modules
+  void fillParamsForGPU(pixelCPEforGPU::CommonParams &commonParams,
+                        std::vector<pixelCPEforGPU::TopologyParams> &topologyParams,
+                        std::vector<pixelCPEforGPU::DetParams> &detParams) const;
+
 private:
   std::unique_ptr<ClusterParam> createClusterParam(const SiPixelCluster &cl) const override;
 
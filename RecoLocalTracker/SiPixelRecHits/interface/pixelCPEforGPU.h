@@ -0,0 +1,261 @@
+#ifndef RecoLocalTracker_SiPixelRecHits_pixelCPEforGPU_h
+#define RecoLocalTracker_SiPixelRecHits_pixelCPEforGPU_h
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__CUDACC__)
+#define PIXELCPE_HOST_DEVICE __host__ __device__
+#else
+#define PIXELCPE_HOST_DEVICE
+#endif
+
+// The parameters of PixelCPEGeneric flattened for the device, and the
+// position and error computations of PixelCPEGeneric::localPosition and
+// PixelCPEGeneric::localError with the simple parametrised errors and
+// the angles estimated from the position of the module. The header is
+// also used by PixelCPEGeneric to fill the parameters, outside of CUDA.
+namespace pixelCPEforGPU {
+
+  // the phase-1 modules
+  constexpr uint32_t MaxRows = 160;
+  constexpr uint32_t MaxCols = 416;
+  constexpr uint32_t MaxTopologies = 8;
+  constexpr uint32_t MaxErrorBins = 16;
+
+  struct ErrorTable {
+    uint32_t n;
+    float values[MaxErrorBins];
+    float def;
+
+    PIXELCPE_HOST_DEVICE float get(uint32_t size) const { return size <= n ? values[size - 1] : def; }
+  };
+
+  struct CommonParams {
+    float effChargeCutLowX;
+    float effChargeCutLowY;
+    float effChargeCutHighX;
+    float effChargeCutHighY;
+    float sizeCutX;
+    float sizeCutY;
+    // in cm
+    float edgeClusterErrorX;
+    float edgeClusterErrorY;
+    bool inflateErrors;
+
+    ErrorTable xerrBarrelL1;
+    ErrorTable yerrBarrelL1;
+    ErrorTable xerrBarrelLn;
+    ErrorTable yerrBarrelLn;
+    ErrorTable xerrEndcap;
+    ErrorTable yerrEndcap;
+  };
+
+  // the local position of the pixel edges and the big pixels of a topology
+  struct TopologyParams {
+    uint16_t nRows;
+    uint16_t nCols;
+    float xEdge[MaxRows + 1];
+    float yEdge[MaxCols + 1];
+    uint8_t bigInX[MaxRows];
+    uint8_t bigInY[MaxCols];
+
+    // the local position of a point in the measurement frame
+    PIXELCPE_HOST_DEVICE float localX(float mx) const {
+      int row = mx < 0.f ? 0 : (mx >= nRows ? nRows - 1 : int(mx));
+      return xEdge[row] + (mx - row) * (xEdge[row + 1] - xEdge[row]);
+    }
+    PIXELCPE_HOST_DEVICE float localY(float my) const {
+      int col = my < 0.f ? 0 : (my >= nCols ? nCols - 1 : int(my));
+      return yEdge[col] + (my - col) * (yEdge[col + 1] - yEdge[col]);
+    }
+    PIXELCPE_HOST_DEVICE bool isEdgeX(int row) const { return row == 0 || row == nRows - 1; }
+    PIXELCPE_HOST_DEVICE bool isEdgeY(int col) const { return col == 0 || col == nCols - 1; }
+    PIXELCPE_HOST_DEVICE bool isBigX(int row) const { return row >= 0 && row < nRows && bigInX[row]; }
+    PIXELCPE_HOST_DEVICE bool isBigY(int col) const { return col >= 0 && col < nCols && bigInY[col]; }
+  };
+
+  struct DetParams {
+    bool isBarrel;
+    bool isLayer1;
+    uint16_t topologyIndex;
+
+    float thickness;
+    float pitchX;
+    float pitchY;
+    float chargeWidthX;
+    float chargeWidthY;
+    float shiftX;
+    float shiftY;
+
+    // the origin of the global frame in the local frame, for the angles
+    float originX;
+    float originY;
+    float originZ;
+    // toGlobal(p) = position + R^T p, with R the rotation of the surface stored by rows
+    float rotation[9];
+    float positionX;
+    float positionY;
+    float positionZ;
+  };
+
+  struct ParamsOnGPU {
+    CommonParams const* commonParams;
+    TopologyParams const* topologyParams;
+    DetParams const* detParams;
+    uint32_t nModules;
+  };
+
+  // the cluster properties used by the position and errors
+  struct ClusterParams {
+    int minRow;
+    int maxRow;
+    int minCol;
+    int maxCol;
+    int qFirstX;
+    int qLastX;
+    int qFirstY;
+    int qLastY;
+    float barycenterX;  // in the measurement frame
+    float barycenterY;
+  };
+
+  // as SiPixelUtils::generic_position_formula
+  PIXELCPE_HOST_DEVICE inline float genericPositionFormula(int size,
+                                                           int qFirst,
+                                                           int qLast,
+                                                           float upperEdgeFirstPix,
+                                                           float lowerEdgeLastPix,
+                                                           float lorentzShift,
+                                                           float thickness,
+                                                           float cotAngle,
+                                                           float pitch,
+                                                           bool firstIsBig,
+                                                           bool lastIsBig,
+                                                           float effChargeCutLow,
+                                                           float effChargeCutHigh,
+                                                           float sizeCut) {
+    float const geomCenter = 0.5f * (upperEdgeFirstPix + lowerEdgeLastPix);
+    if (size == 1)
+      return geomCenter;
+
+    float const wInner = lowerEdgeLastPix - upperEdgeFirstPix;
+    float const wPred = thickness * cotAngle - lorentzShift;
+    float sumOfEdge = 2.0f;
+    if (firstIsBig)
+      sumOfEdge += 1.0f;
+    if (lastIsBig)
+      sumOfEdge += 1.0f;
+
+    float wEff = fabsf(wPred) - wInner;
+    if ((size >= sizeCut) || ((wEff / pitch < effChargeCutLow) | (wEff / pitch > effChargeCutHigh)))
+      wEff = pitch * 0.5f * sumOfEdge;
+
+    float const qDiff = qLast - qFirst;
+    float qSum = qLast + qFirst;
+    if (qSum == 0)
+      qSum = 1.0f;
+    return geomCenter + 0.5f * (qDiff / qSum) * wEff;
+  }
+
+  PIXELCPE_HOST_DEVICE inline void position(CommonParams const& common,
+                                            TopologyParams const& topology,
+                                            DetParams const& det,
+                                            ClusterParams const& cluster,
+                                            float& xl,
+                                            float& yl) {
+    // the angles from the position of the module, as PixelCPEBase::computeAnglesFromDetPosition
+    float const gvz = -1.f / det.originZ;
+    float const cotalpha = (topology.localX(cluster.barycenterX) - det.originX) * gvz;
+    float const cotbeta = (topology.localY(cluster.barycenterY) - det.originY) * gvz;
+
+    // the upper right corner of the lower left pixel, and the lower left corner of the upper right pixel
+    float const urCornerX = topology.localX(cluster.minRow + 1.f);
+    float const urCornerY = topology.localY(cluster.minCol + 1.f);
+    float const llCornerX = topology.localX(cluster.maxRow);
+    float const llCornerY = topology.localY(cluster.maxCol);
+
+    xl = genericPositionFormula(cluster.maxRow - cluster.minRow + 1,
+                                cluster.qFirstX,
+                                cluster.qLastX,
+                                urCornerX,
+                                llCornerX,
+                                det.chargeWidthX,
+                                det.thickness,
+                                cotalpha,
+                                det.pitchX,
+                                topology.isBigX(cluster.minRow),
+                                topology.isBigX(cluster.maxRow),
+                                common.effChargeCutLowX,
+                                common.effChargeCutHighX,
+                                common.sizeCutX) +
+         det.shiftX;
+    yl = genericPositionFormula(cluster.maxCol - cluster.minCol + 1,
+                                cluster.qFirstY,
+                                cluster.qLastY,
+                                urCornerY,
+                                llCornerY,
+                                det.chargeWidthY,
+                                det.thickness,
+                                cotbeta,
+                                det.pitchY,
+                                topology.isBigY(cluster.minCol),
+                                topology.isBigY(cluster.maxCol),
+                                common.effChargeCutLowY,
+                                common.effChargeCutHighY,
+                                common.sizeCutY) +
+         det.shiftY;
+  }
+
+  PIXELCPE_HOST_DEVICE inline void errors(CommonParams const& common,
+                                          TopologyParams const& topology,
+                                          DetParams const& det,
+                                          ClusterParams const& cluster,
+                                          float& xerr2,
+                                          float& yerr2) {
+    float xerr = common.edgeClusterErrorX;
+    float yerr = common.edgeClusterErrorY;
+
+    bool const edgeX = topology.isEdgeX(cluster.minRow) || topology.isEdgeX(cluster.maxRow);
+    bool const edgeY = topology.isEdgeY(cluster.minCol) || topology.isEdgeY(cluster.maxCol);
+    uint32_t const sizeX = cluster.maxRow - cluster.minRow + 1;
+    uint32_t const sizeY = cluster.maxCol - cluster.minCol + 1;
+
+    ErrorTable const& xTable =
+        det.isBarrel ? (det.isLayer1 ? common.xerrBarrelL1 : common.xerrBarrelLn) : common.xerrEndcap;
+    ErrorTable const& yTable =
+        det.isBarrel ? (det.isLayer1 ? common.yerrBarrelL1 : common.yerrBarrelLn) : common.yerrEndcap;
+    if (!edgeX)
+      xerr = xTable.get(sizeX);
+    if (!edgeY)
+      yerr = yTable.get(sizeY);
+
+    if (common.inflateErrors) {
+      int nBigX = 0;
+      int nBigY = 0;
+      for (int row = 0; row < 7; ++row) {
+        if (topology.isBigX(row + cluster.minRow))
+          ++nBigX;
+      }
+      for (int col = 0; col < 21; ++col) {
+        if (topology.isBigY(col + cluster.minCol))
+          ++nBigY;
+      }
+      xerr = float(sizeX + nBigX) * det.pitchX / sqrtf(12.0f);
+      yerr = float(sizeY + nBigY) * det.pitchY / sqrtf(12.0f);
+    }
+
+    xerr2 = xerr * xerr;
+    yerr2 = yerr * yerr;
+  }
+
+  PIXELCPE_HOST_DEVICE inline void toGlobal(DetParams const& det, float xl, float yl, float& xg, float& yg, float& zg) {
+    float const* r = det.rotation;
+    xg = det.positionX + r[0] * xl + r[3] * yl;
+    yg = det.positionY + r[1] * xl + r[4] * yl;
+    zg = det.positionZ + r[2] * xl + r[5] * yl;
+  }
+
+}  // namespace pixelCPEforGPU
+
+#endif
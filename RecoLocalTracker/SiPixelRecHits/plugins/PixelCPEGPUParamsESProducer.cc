@@ -0,0 +1,50 @@
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGPUParams.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGeneric.h"
+#include "RecoLocalTracker/Records/interface/TkPixelCPERecord.h"
+#include "RecoLocalTracker/ClusterParameterEstimator/interface/PixelClusterParameterEstimator.h"
+
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <memory>
+#include <string>
+
+// Flattens the parameters of a PixelCPEGeneric for the GPU rechits
+class PixelCPEGPUParamsESProducer : public edm::ESProducer {
+public:
+  PixelCPEGPUParamsESProducer(const edm::ParameterSet& p);
+  std::unique_ptr<PixelCPEGPUParams> produce(const TkPixelCPERecord&);
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  edm::ESGetToken<PixelClusterParameterEstimator, TkPixelCPERecord> cpeToken_;
+  std::string cpeName_;
+};
+
+PixelCPEGPUParamsESProducer::PixelCPEGPUParamsESProducer(const edm::ParameterSet& p)
+    : cpeName_(p.getParameter<std::string>("PixelCPE")) {
+  setWhatProduced(this, p.getParameter<std::string>("ComponentName"))
+      .setConsumes(cpeToken_, edm::ESInputTag("", cpeName_));
+}
+
+std::unique_ptr<PixelCPEGPUParams> PixelCPEGPUParamsESProducer::produce(const TkPixelCPERecord& iRecord) {
+  auto const* cpe = dynamic_cast<PixelCPEGeneric const*>(&iRecord.get(cpeToken_));
+  if (cpe == nullptr) {
+    throw cms::Exception("Configuration") << "PixelCPEGPUParamsESProducer: the PixelClusterParameterEstimator "
+                                          << cpeName_ << " is not a PixelCPEGeneric";
+  }
+  return std::make_unique<PixelCPEGPUParams>(*cpe);
+}
+
+void PixelCPEGPUParamsESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<std::string>("ComponentName", "PixelCPEGPUParams");
+  desc.add<std::string>("PixelCPE", "PixelCPEGeneric");
+  descriptions.add("pixelCPEGPUParams", desc);
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(PixelCPEGPUParamsESProducer);
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <climits>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+#include "PixelRecHitGPUKernel.h"
+
+namespace pixelgpudetails {
+
+  namespace {
+
+    // the clusters of a module are processed in groups of this size
+    constexpr int32_t MaxHitsInIter = 128;
+
+    // one block per module
+    __global__ void getHits(pixelCPEforGPU::ParamsOnGPU const* __restrict__ cpeParams,
+                            SiPixelClustersCUDA::DeviceView digis,
+                            TrackingRecHit2DCUDA::DeviceView hits) {
+      __shared__ int32_t minRow[MaxHitsInIter];
+      __shared__ int32_t maxRow[MaxHitsInIter];
+      __shared__ int32_t minCol[MaxHitsInIter];
+      __shared__ int32_t maxCol[MaxHitsInIter];
+      __shared__ int32_t charge[MaxHitsInIter];
+      __shared__ int32_t qFirstX[MaxHitsInIter];
+      __shared__ int32_t qLastX[MaxHitsInIter];
+      __shared__ int32_t qFirstY[MaxHitsInIter];
+      __shared__ int32_t qLastY[MaxHitsInIter];
+      __shared__ float sumX[MaxHitsInIter];
+      __shared__ float sumY[MaxHitsInIter];
+
+      uint32_t const module = blockIdx.x;
+      if (module >= digis.nModules)
+        return;
+      uint32_t const first = digis.moduleStart[module];
+      uint32_t const last = digis.moduleStart[module + 1];
+      int32_t const nClusters = digis.clusInModule[module];
+      uint32_t const firstHit = digis.clusModuleStart[module];
+
+      auto const& common = *cpeParams->commonParams;
+      auto const& det = cpeParams->detParams[module];
+      auto const& topology = cpeParams->topologyParams[det.topologyIndex];
+
+      for (int32_t begin = 0; begin < nClusters; begin += MaxHitsInIter) {
+        int32_t const end = min(begin + MaxHitsInIter, nClusters);
+        for (int32_t k = threadIdx.x; k < end - begin; k += blockDim.x) {
+          minRow[k] = minCol[k] = INT_MAX;
+          maxRow[k] = maxCol[k] = 0;
+          charge[k] = qFirstX[k] = qLastX[k] = qFirstY[k] = qLastY[k] = 0;
+          sumX[k] = sumY[k] = 0.f;
+        }
+        __syncthreads();
+
+        for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+          int32_t const id = digis.clus[i];
+          if (id < begin || id >= end)
+            continue;
+          int32_t const k = id - begin;
+          int32_t const x = digis.xx[i];
+          int32_t const y = digis.yy[i];
+          int32_t const q = digis.charge[i];
+          atomicMin(&minRow[k], x);
+          atomicMax(&maxRow[k], x);
+          atomicMin(&minCol[k], y);
+          atomicMax(&maxCol[k], y);
+          atomicAdd(&charge[k], q);
+          atomicAdd(&sumX[k], float(q) * (x + 0.5f));
+          atomicAdd(&sumY[k], float(q) * (y + 0.5f));
+        }
+        __syncthreads();
+
+        // the charges of the first and last rows and columns
+        for (uint32_t i = first + threadIdx.x; i < last; i += blockDim.x) {
+          int32_t const id = digis.clus[i];
+          if (id < begin || id >= end)
+            continue;
+          int32_t const k = id - begin;
+          int32_t const q = digis.charge[i];
+          if (digis.xx[i] == minRow[k])
+            atomicAdd(&qFirstX[k], q);
+          if (digis.xx[i] == maxRow[k])
+            atomicAdd(&qLastX[k], q);
+          if (digis.yy[i] == minCol[k])
+            atomicAdd(&qFirstY[k], q);
+          if (digis.yy[i] == maxCol[k])
+            atomicAdd(&qLastY[k], q);
+        }
+        __syncthreads();
+
+        for (int32_t k = threadIdx.x; k < end - begin; k += blockDim.x) {
+          pixelCPEforGPU::ClusterParams const cluster{minRow[k],
+                                                      maxRow[k],
+                                                      minCol[k],
+                                                      maxCol[k],
+                                                      qFirstX[k],
+                                                      qLastX[k],
+                                                      qFirstY[k],
+                                                      qLastY[k],
+                                                      sumX[k] / charge[k],
+                                                      sumY[k] / charge[k]};
+          uint32_t const h = firstHit + begin + k;
+          float xl, yl;
+          pixelCPEforGPU::position(common, topology, det, cluster, xl, yl);
+          pixelCPEforGPU::errors(common, topology, det, cluster, hits.xerr2[h], hits.yerr2[h]);
+          hits.xl[h] = xl;
+          hits.yl[h] = yl;
+          pixelCPEforGPU::toGlobal(det, xl, yl, hits.xg[h], hits.yg[h], hits.zg[h]);
+          hits.charge[h] = charge[k];
+          hits.sizeX[h] = maxRow[k] - minRow[k] + 1;
+          hits.sizeY[h] = maxCol[k] - minCol[k] + 1;
+          hits.detIndex[h] = module;
+        }
+        __syncthreads();
+      }
+    }
+
+  }  // namespace
+
+  TrackingRecHit2DCUDA makeHitsAsync(SiPixelClustersCUDA const& clusters,
+                                     pixelCPEforGPU::ParamsOnGPU const* cpeParams,
+                                     cudaStream_t stream) {
+    // there are at most as many clusters as digis
+    TrackingRecHit2DCUDA hits(std::max(clusters.maxDigis(), 1u), clusters.nModules(), stream);
+    auto view = hits.view();
+
+    cudaCheck(cudaMemcpyAsync(view.hitsModuleStart,
+                              clusters.clusModuleStart(),
+                              (clusters.nModules() + 1) * sizeof(uint32_t),
+                              cudaMemcpyDeviceToDevice,
+                              stream));
+    if (clusters.nModules() > 0) {
+      getHits<<<clusters.nModules(), 128, 0, stream>>>(cpeParams, clusters.view(), view);
+      cudaCheck(cudaGetLastError());
+    }
+    return hits;
+  }
+
+}  // namespace pixelgpudetails
@@ -0,0 +1,21 @@
+#ifndef RecoLocalTracker_SiPixelRecHits_plugins_PixelRecHitGPUKernel_h
+#define RecoLocalTracker_SiPixelRecHits_plugins_PixelRecHitGPUKernel_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/SiPixelCluster/interface/SiPixelClustersCUDA.h"
+#include "CUDADataFormats/TrackingRecHit/interface/TrackingRecHit2DCUDA.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/pixelCPEforGPU.h"
+
+namespace pixelgpudetails {
+
+  // Computes one hit per cluster on the device with the PixelCPEGeneric
+  // formulas: the kernels are queued on the stream and the hits returned
+  // at once, to be used only in the work queued on the same stream.
+  TrackingRecHit2DCUDA makeHitsAsync(SiPixelClustersCUDA const& clusters,
+                                     pixelCPEforGPU::ParamsOnGPU const* cpeParams,
+                                     cudaStream_t stream);
+
+}  // namespace pixelgpudetails
+
+#endif
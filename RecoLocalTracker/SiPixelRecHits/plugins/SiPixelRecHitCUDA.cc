@@ -0,0 +1,70 @@
+#include <memory>
+#include <string>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/SiPixelCluster/interface/SiPixelClustersCUDA.h"
+#include "CUDADataFormats/TrackingRecHit/interface/TrackingRecHit2DCUDA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "RecoLocalTracker/Records/interface/TkPixelCPERecord.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGPUParams.h"
+
+#include "PixelRecHitGPUKernel.h"
+
+/**
+ * Computes the pixel rechits of the clusters found on the GPU, with the
+ * PixelCPEGeneric formulas for the position from the module angles and
+ * the simple parametrised errors. The output stays on the device.
+ */
+class SiPixelRecHitCUDA : public edm::stream::EDProducer<> {
+public:
+  explicit SiPixelRecHitCUDA(const edm::ParameterSet& iConfig);
+  ~SiPixelRecHitCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<SiPixelClustersCUDA>> clusterGetToken_;
+  edm::EDPutTokenT<cms::cuda::Product<TrackingRecHit2DCUDA>> hitPutToken_;
+  edm::ESGetToken<PixelCPEGPUParams, TkPixelCPERecord> cpeToken_;
+};
+
+SiPixelRecHitCUDA::SiPixelRecHitCUDA(const edm::ParameterSet& iConfig)
+    : clusterGetToken_(consumes<cms::cuda::Product<SiPixelClustersCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      hitPutToken_(produces<cms::cuda::Product<TrackingRecHit2DCUDA>>()),
+      cpeToken_(esConsumes<PixelCPEGPUParams, TkPixelCPERecord>(
+          edm::ESInputTag("", iConfig.getParameter<std::string>("CPE")))) {}
+
+void SiPixelRecHitCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("siPixelClustersCUDA"));
+  desc.add<std::string>("CPE", "PixelCPEGPUParams");
+  descriptions.add("siPixelRecHitCUDA", desc);
+}
+
+void SiPixelRecHitCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  auto const& product = iEvent.get(clusterGetToken_);
+  cms::cuda::ScopedContextProduce ctx{product};
+  auto const& clusters = ctx.get(product);
+
+  auto const& cpe = iSetup.getData(cpeToken_);
+  if (cpe.nModules() != clusters.nModules()) {
+    throw cms::Exception("LogicError") << "The CPE parameters are for " << cpe.nModules() << " pixel modules, the "
+                                       << "clusters for " << clusters.nModules();
+  }
+
+  ctx.emplace(iEvent,
+              hitPutToken_,
+              pixelgpudetails::makeHitsAsync(clusters, cpe.getGPUProductAsync(ctx.stream()), ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(SiPixelRecHitCUDA);
@@ -0,0 +1,4 @@
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGPUParams.h"
+#include "FWCore/Utilities/interface/typelookup.h"
+
+TYPELOOKUP_DATA_REG(PixelCPEGPUParams);
@@ -156,9 +156,9 @@ void PixelCPEClusterRepair::fill2DTemplIDs() {
 //  Clean up.
 //-----------------------------------------------------------------------------
 PixelCPEClusterRepair::~PixelCPEClusterRepair() {
-  for (auto x : thePixelTemp_)
+  for (auto& x : thePixelTemp_)
     x.destroy();
-  for (auto x : thePixelTemp2D_)
+  for (auto& x : thePixelTemp2D_)
     x.destroy();
 }
 
@@ -0,0 +1,50 @@
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGPUParams.h"
+#include "RecoLocalTracker/SiPixelRecHits/interface/PixelCPEGeneric.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+
+PixelCPEGPUParams::PixelCPEGPUParams(PixelCPEGeneric const& cpe) {
+  cpe.fillParamsForGPU(commonParams_, topologyParams_, detParams_);
+}
+
+PixelCPEGPUParams::~PixelCPEGPUParams() {}
+
+const pixelCPEforGPU::ParamsOnGPU* PixelCPEGPUParams::getGPUProductAsync(cudaStream_t cudaStream) const {
+  const auto& data = gpuData_.dataForCurrentDeviceAsync(cudaStream, [this](GPUData& data, cudaStream_t stream) {
+    // the parameters are not modified after the construction, the copies can be made from the host members
+    cudaCheck(cudaMalloc(&data.commonParams, sizeof(pixelCPEforGPU::CommonParams)));
+    cudaCheck(cudaMalloc(&data.topologyParams, topologyParams_.size() * sizeof(pixelCPEforGPU::TopologyParams)));
+    cudaCheck(cudaMalloc(&data.detParams, detParams_.size() * sizeof(pixelCPEforGPU::DetParams)));
+    cudaCheck(cudaMalloc(&data.paramsOnGPU, sizeof(pixelCPEforGPU::ParamsOnGPU)));
+
+    data.paramsOnHost.commonParams = data.commonParams;
+    data.paramsOnHost.topologyParams = data.topologyParams;
+    data.paramsOnHost.detParams = data.detParams;
+    data.paramsOnHost.nModules = detParams_.size();
+
+    cudaCheck(cudaMemcpyAsync(
+        data.commonParams, &commonParams_, sizeof(pixelCPEforGPU::CommonParams), cudaMemcpyHostToDevice, stream));
+    cudaCheck(cudaMemcpyAsync(data.topologyParams,
+                              topologyParams_.data(),
+                              topologyParams_.size() * sizeof(pixelCPEforGPU::TopologyParams),
+                              cudaMemcpyHostToDevice,
+                              stream));
+    cudaCheck(cudaMemcpyAsync(data.detParams,
+                              detParams_.data(),
+                              detParams_.size() * sizeof(pixelCPEforGPU::DetParams),
+                              cudaMemcpyHostToDevice,
+                              stream));
+    cudaCheck(cudaMemcpyAsync(data.paramsOnGPU,
+                              &data.paramsOnHost,
+                              sizeof(pixelCPEforGPU::ParamsOnGPU),
+                              cudaMemcpyHostToDevice,
+                              stream));
+  });
+  return data.paramsOnGPU;
+}
+
+PixelCPEGPUParams::GPUData::~GPUData() {
+  cudaCheck(cudaFree(paramsOnGPU));
+  cudaCheck(cudaFree(commonParams));
+  cudaCheck(cudaFree(topologyParams));
+  cudaCheck(cudaFree(detParams));
+}
@@ -10,12 +10,17 @@
 // The generic formula
 #include "CondFormats/SiPixelTransient/interface/SiPixelUtils.h"
 
+// The parameters for the GPU
+#include "RecoLocalTracker/SiPixelRecHits/interface/pixelCPEforGPU.h"
+
 // Services
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "MagneticField/Engine/interface/MagneticField.h"
 
 #include "boost/multi_array.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 using namespace std;
 
@@ -646,3 +651,99 @@ void PixelCPEGeneric::fillPSetDescription(edm::ParameterSetDescription& desc) {
   desc.add<bool>("Upgrade", false);
   desc.add<bool>("SmallPitch", false);
 }
+
+//-----------------------------------------------------------------------------
+//!  The parameters of the simple errors and of the positions from the module
+//!  angles, flattened for the GPU.  One topology is stored for all the modules
+//!  with the same pixel edges, and one DetParams for each pixel module.
+//-----------------------------------------------------------------------------
+void PixelCPEGeneric::fillParamsForGPU(pixelCPEforGPU::CommonParams& commonParams,
+                                       std::vector<pixelCPEforGPU::TopologyParams>& topologyParams,
+                                       std::vector<pixelCPEforGPU::DetParams>& detParams) const {
+  if (UseErrorsFromTemplates_)
+    edm::LogWarning("PixelCPEGeneric") << "The parameters for the GPU use the simple parametrised errors, "
+                                       << "not the errors from the templates";
+
+  auto fillTable = [](pixelCPEforGPU::ErrorTable& table, std::vector<float> const& values, float def) {
+    if (values.size() > pixelCPEforGPU::MaxErrorBins)
+      throw cms::Exception("Configuration") << "PixelCPEGeneric::fillParamsForGPU: " << values.size()
+                                            << " error bins, the GPU supports at most " << pixelCPEforGPU::MaxErrorBins;
+    table.n = values.size();
+    std::fill(std::begin(table.values), std::end(table.values), def);
+    std::copy(values.begin(), values.end(), table.values);
+    table.def = def;
+  };
+
+  commonParams.effChargeCutLowX = the_eff_charge_cut_lowX;
+  commonParams.effChargeCutLowY = the_eff_charge_cut_lowY;
+  commonParams.effChargeCutHighX = the_eff_charge_cut_highX;
+  commonParams.effChargeCutHighY = the_eff_charge_cut_highY;
+  commonParams.sizeCutX = the_size_cutX;
+  commonParams.sizeCutY = the_size_cutY;
+  commonParams.edgeClusterErrorX = EdgeClusterErrorX_ * micronsToCm;
+  commonParams.edgeClusterErrorY = EdgeClusterErrorY_ * micronsToCm;
+  commonParams.inflateErrors = inflate_errors;
+  fillTable(commonParams.xerrBarrelL1, xerr_barrel_l1_, xerr_barrel_l1_def_);
+  fillTable(commonParams.yerrBarrelL1, yerr_barrel_l1_, yerr_barrel_l1_def_);
+  fillTable(commonParams.xerrBarrelLn, xerr_barrel_ln_, xerr_barrel_ln_def_);
+  fillTable(commonParams.yerrBarrelLn, yerr_barrel_ln_, yerr_barrel_ln_def_);
+  fillTable(commonParams.xerrEndcap, xerr_endcap_, xerr_endcap_def_);
+  fillTable(commonParams.yerrEndcap, yerr_endcap_, yerr_endcap_def_);
+
+  topologyParams.clear();
+  detParams.resize(m_DetParams.size());
+  for (unsigned int i = 0; i != m_DetParams.size(); ++i) {
+    auto const& p = m_DetParams[i];
+    auto const& topol = *p.theRecTopol;
+    if (topol.nrows() > int(pixelCPEforGPU::MaxRows) || topol.ncolumns() > int(pixelCPEforGPU::MaxCols))
+      throw cms::Exception("Configuration") << "PixelCPEGeneric::fillParamsForGPU: the module "
+                                            << p.theDet->geographicalId().rawId() << " has " << topol.nrows()
+                                            << " rows and " << topol.ncolumns() << " columns, the GPU supports at most "
+                                            << pixelCPEforGPU::MaxRows << " and " << pixelCPEforGPU::MaxCols;
+
+    pixelCPEforGPU::TopologyParams t;
+    std::memset(&t, 0, sizeof(t));
+    t.nRows = topol.nrows();
+    t.nCols = topol.ncolumns();
+    for (int row = 0; row <= topol.nrows(); ++row)
+      t.xEdge[row] = topol.localPosition(MeasurementPoint(row, 0)).x();
+    for (int col = 0; col <= topol.ncolumns(); ++col)
+      t.yEdge[col] = topol.localPosition(MeasurementPoint(0, col)).y();
+    for (int row = 0; row < topol.nrows(); ++row)
+      t.bigInX[row] = topol.isItBigPixelInX(row);
+    for (int col = 0; col < topol.ncolumns(); ++col)
+      t.bigInY[col] = topol.isItBigPixelInY(col);
+    auto const same = std::find_if(topologyParams.begin(), topologyParams.end(), [&t](auto const& other) {
+      return std::memcmp(&t, &other, sizeof(t)) == 0;
+    });
+    auto& d = detParams[i];
+    d.topologyIndex = same - topologyParams.begin();
+    if (same == topologyParams.end()) {
+      if (topologyParams.size() == pixelCPEforGPU::MaxTopologies)
+        throw cms::Exception("Configuration") << "PixelCPEGeneric::fillParamsForGPU: more than "
+                                              << pixelCPEforGPU::MaxTopologies << " pixel topologies";
+      topologyParams.push_back(t);
+    }
+
+    d.isBarrel = GeomDetEnumerators::isBarrel(p.thePart);
+    d.isLayer1 = d.isBarrel && ttopo_.layer(p.theDet->geographicalId()) == 1;
+    d.thickness = p.theThickness;
+    d.pitchX = p.thePitchX;
+    d.pitchY = p.thePitchY;
+    d.chargeWidthX = p.lorentzShiftInCmX * p.widthLAFractionX;
+    d.chargeWidthY = p.lorentzShiftInCmY * p.widthLAFractionY;
+    d.shiftX = 0.5f * p.lorentzShiftInCmX;
+    d.shiftY = 0.5f * p.lorentzShiftInCmY;
+    d.originX = p.theOrigin.x();
+    d.originY = p.theOrigin.y();
+    d.originZ = p.theOrigin.z();
+
+    auto const& surface = p.theDet->surface();
+    auto const& r = surface.rotation();
+    float const rotation[9] = {r.xx(), r.xy(), r.xz(), r.yx(), r.yy(), r.yz(), r.zx(), r.zy(), r.zz()};
+    std::copy(std::begin(rotation), std::end(rotation), d.rotation);
+    d.positionX = surface.position().x();
+    d.positionY = surface.position().y();
+    d.positionZ = surface.position().z();
+  }
+}
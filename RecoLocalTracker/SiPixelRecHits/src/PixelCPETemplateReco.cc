@@ -95,7 +95,7 @@ PixelCPETemplateReco::PixelCPETemplateReco(edm::ParameterSet const& conf,
 //  Clean up.
 //-----------------------------------------------------------------------------
 PixelCPETemplateReco::~PixelCPETemplateReco() {
-  for (auto x : thePixelTemp_)
+  for (auto& x : thePixelTemp_)
     x.destroy();
 }
 
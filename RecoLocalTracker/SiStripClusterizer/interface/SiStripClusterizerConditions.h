@@ -0,0 +1,60 @@
+#ifndef RecoLocalTracker_SiStripClusterizer_SiStripClusterizerConditions_h
+#define RecoLocalTracker_SiStripClusterizer_SiStripClusterizerConditions_h
+
+#include <cstdint>
+#include <vector>
+
+class SiStripGain;
+class SiStripNoises;
+class SiStripQuality;
+
+// Noise, gain and bad strip flag of all the strips of the connected and good modules, in flat arrays:
+// the strips of a module are contiguous, and the modules are sorted by detId.
+// The per strip lookups of the clusterizer are then plain array accesses, instead of the decoding
+// of the SiStripNoises, SiStripGain and SiStripQuality ranges.
+class SiStripClusterizerConditions {
+public:
+  static constexpr uint16_t invalidDet = 0xFFFF;
+
+  struct Det {
+    uint32_t detId;
+    uint32_t firstStrip;  // index of the first strip of the module in the flat arrays
+    uint32_t firstChannel;  // index of the first channel of the module in channels()
+    uint16_t nStrips;
+    uint16_t nChannels;
+  };
+
+  // the connected fed channels reading out a module, ordered by apv pair
+  struct Channel {
+    uint16_t fedId;
+    uint16_t fedCh;
+    uint16_t apvPair;
+  };
+
+  SiStripClusterizerConditions(SiStripGain const& gains, SiStripNoises const& noises, SiStripQuality const& quality);
+
+  unsigned int nDets() const { return dets_.size(); }
+  Det const& det(unsigned int i) const { return dets_[i]; }
+  std::vector<Det> const& dets() const { return dets_; }
+  std::vector<Channel> const& channels() const { return channels_; }
+
+  // invalidDet if the module is not connected or bad
+  uint16_t detIndex(uint32_t detId) const;
+
+  unsigned int nStrips() const { return noise_.size(); }
+  float const* noise() const { return noise_.data(); }
+  float const* gain() const { return gain_.data(); }
+  uint8_t const* bad() const { return bad_.data(); }
+
+  // false outside of the module, as SiStripQuality::IsStripBad
+  bool bad(Det const& det, uint16_t strip) const { return strip < det.nStrips && bad_[det.firstStrip + strip]; }
+
+private:
+  std::vector<Det> dets_;
+  std::vector<Channel> channels_;
+  std::vector<float> noise_;
+  std::vector<float> gain_;
+  std::vector<uint8_t> bad_;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef RecoLocalTracker_SiStripClusterizer_SiStripFlatClusterizer_h
+#define RecoLocalTracker_SiStripClusterizer_SiStripFlatClusterizer_h
+
+#include "DataFormats/Common/interface/DetSetVectorNew.h"
+#include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripClusterizerConditions.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripFlatDigis.h"
+
+#include <vector>
+
+namespace edm {
+  class ParameterSet;
+}
+
+// The three threshold algorithm run at once on the digis of all the modules of the event.
+// The thresholds of the digis and the boundaries of the candidates are computed on the whole
+// structure of arrays in loops without branches, which the compiler vectorizes; only the accepted
+// candidates are then built one by one. The clusters are the same as the ThreeThresholdAlgorithm ones.
+class SiStripFlatClusterizer {
+public:
+  typedef edmNew::DetSetVector<SiStripCluster> output_t;
+
+  // the parameters of ThreeThresholdAlgorithm
+  explicit SiStripFlatClusterizer(const edm::ParameterSet& conf);
+
+  // not const: the work arrays are kept from one event to the next
+  void clusterize(SiStripClusterizerConditions const& conditions, SiStripFlatDigis const& digis, output_t& output);
+
+private:
+  using Det = SiStripClusterizerConditions::Det;
+
+  bool allBadBetween(SiStripClusterizerConditions const& conditions, Det const& det, uint16_t L, uint16_t R) const {
+    while (++L < R && conditions.bad(det, L)) {
+    };
+    return L == R;
+  }
+
+  // the candidate made of the accepted digis good_[begin] to good_[end-1]
+  void endCandidate(SiStripClusterizerConditions const& conditions,
+                    Det const& det,
+                    SiStripFlatDigis const& digis,
+                    unsigned int begin,
+                    unsigned int end,
+                    output_t::TSFastFiller& out);
+
+  float ChannelThreshold, SeedThreshold, ClusterThresholdSquared;
+  uint8_t MaxSequentialHoles, MaxSequentialBad, MaxAdjacentBad;
+  float minGoodCharge;
+
+  std::vector<uint8_t> accepted_;
+  std::vector<uint8_t> seed_;
+  std::vector<float> noiseSquared_;
+  std::vector<uint32_t> good_;
+  std::vector<uint8_t> split_;
+  std::vector<uint8_t> ADCs_;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef RecoLocalTracker_SiStripClusterizer_SiStripFlatDigis_h
+#define RecoLocalTracker_SiStripClusterizer_SiStripFlatDigis_h
+
+#include <cstdint>
+#include <vector>
+
+// The zero suppressed strips of all the modules of an event, as a structure of arrays.
+// The digis of a module are contiguous and ordered by strip, and the modules follow
+// the order of SiStripClusterizerConditions: index is the position of the strip in its flat arrays.
+struct SiStripFlatDigis {
+  std::vector<uint32_t> index;
+  std::vector<uint16_t> det;
+  std::vector<uint8_t> adc;
+
+  unsigned int size() const { return index.size(); }
+  bool empty() const { return index.empty(); }
+
+  void reserve(unsigned int n) {
+    index.reserve(n);
+    det.reserve(n);
+    adc.reserve(n);
+  }
+
+  void clear() {
+    index.clear();
+    det.clear();
+    adc.clear();
+  }
+
+  void push_back(uint16_t idet, uint32_t iindex, uint8_t iadc) {
+    index.push_back(iindex);
+    det.push_back(idet);
+    adc.push_back(iadc);
+  }
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripRawProcessingFactory.h"
 
 #include "RecoLocalTracker/SiStripClusterizer/interface/StripClusterizerAlgorithm.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripFlatClusterizer.h"
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripRawProcessingAlgorithms.h"
 
 #include "DataFormats/SiStripCluster/interface/SiStripCluster.h"
@@ -14,17 +15,33 @@
 #include "DataFormats/SiStripCommon/interface/SiStripConstants.h"
 
 #include "CalibFormats/SiStripObjects/interface/SiStripDetCabling.h"
+#include "CalibTracker/Records/interface/SiStripClusterizerConditionsRcd.h"
+#include "CalibTracker/Records/interface/SiStripGainRcd.h"
+#include "CalibTracker/Records/interface/SiStripQualityRcd.h"
+#include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
+#include "DataFormats/Common/interface/OwnVector.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+#include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
+#include "SiStripRegionalDets.h"
 
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
+#include "FWCore/Utilities/interface/ESInputTag.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
 
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <sstream>
 #include <memory>
+#include <algorithm>
+#include <cmath>
 #include <atomic>
 #include <mutex>
 
@@ -177,11 +194,27 @@ public:
         doAPVEmulatorCheck_(conf.existsAs<bool>("DoAPVEmulatorCheck") ? conf.getParameter<bool>("DoAPVEmulatorCheck")
                                                                       : true),
         legacy_(conf.existsAs<bool>("LegacyUnpacker") ? conf.getParameter<bool>("LegacyUnpacker") : false),
-        hybridZeroSuppressed_(conf.getParameter<bool>("HybridZeroSuppressed")) {
+        hybridZeroSuppressed_(conf.getParameter<bool>("HybridZeroSuppressed")),
+        flat_(conf.existsAs<bool>("FlatSoA") ? conf.getParameter<bool>("FlatSoA") : false) {
     productToken_ = consumes<FEDRawDataCollection>(conf.getParameter<edm::InputTag>("ProductLabel"));
     produces<edmNew::DetSetVector<SiStripCluster> >();
     assert(clusterizer_.get());
     assert(rawAlgos_.get());
+    if (flat_) {
+      if (onDemand)
+        throw cms::Exception("Configuration") << "the flat clusterizer can not be run on demand";
+      flatClusterizer_ = std::make_unique<SiStripFlatClusterizer>(conf.getParameter<edm::ParameterSet>("Clusterizer"));
+      conditionsToken_ = esConsumes<SiStripClusterizerConditions, SiStripClusterizerConditionsRcd>(edm::ESInputTag(
+          "", conf.existsAs<std::string>("ConditionsLabel") ? conf.getParameter<std::string>("ConditionsLabel") : ""));
+    }
+    if (conf.existsAs<std::vector<edm::InputTag> >("Regions")) {
+      for (auto const& tag : conf.getParameter<std::vector<edm::InputTag> >("Regions"))
+        regionTokens_.push_back(consumes<edm::OwnVector<TrackingRegion> >(tag));
+    }
+    if (!regionTokens_.empty()) {
+      geometryToken_ = esConsumes<TrackerGeometry, TrackerDigiGeometryRecord>();
+      fieldToken_ = esConsumes<MagneticField, IdealMagneticFieldRecord>();
+    }
   }
 
   void beginRun(const edm::Run&, const edm::EventSetup& es) override { initialize(es); }
@@ -193,11 +226,19 @@ public:
     edm::Handle<FEDRawDataCollection> rawData;
     ev.getByToken(productToken_, rawData);
 
+    const SiStripClusterizerConditions* conditions = flat_ ? &es.getData(conditionsToken_) : nullptr;
+
+    // with regions, only the dets compatible with them are unpacked
+    const std::vector<uint32_t>* regionalDetIds = nullptr;
+    if (!regionTokens_.empty())
+      regionalDetIds = &selectRegionalDets(ev, es, conditions);
+    const std::vector<uint32_t>& detIds = regionalDetIds ? *regionalDetIds : clusterizer_->allDetIds();
+
     std::unique_ptr<edmNew::DetSetVector<SiStripCluster> > output(
         onDemand ? new edmNew::DetSetVector<SiStripCluster>(
                        std::shared_ptr<edmNew::DetSetVector<SiStripCluster>::Getter>(std::make_shared<ClusterFiller>(
                            *rawData, *clusterizer_, *rawAlgos_, doAPVEmulatorCheck_, legacy_, hybridZeroSuppressed_)),
-                       clusterizer_->allDetIds())
+                       detIds)
                  : new edmNew::DetSetVector<SiStripCluster>());
 
     if (onDemand)
@@ -205,8 +246,12 @@ public:
 
     output->reserve(15000, 24 * 10000);
 
-    if (!onDemand) {
-      run(*rawData, *output);
+    if (flat_) {
+      runFlat(*rawData, *conditions, regionalDetIds, *output);
+      output->shrink_to_fit();
+      COUT << output->dataSize() << " clusters from " << output->size() << " modules" << std::endl;
+    } else if (!onDemand) {
+      run(*rawData, detIds, *output);
       output->shrink_to_fit();
       COUT << output->dataSize() << " clusters from " << output->size() << " modules" << std::endl;
     }
@@ -217,7 +262,19 @@ public:
 private:
   void initialize(const edm::EventSetup& es);
 
-  void run(const FEDRawDataCollection& rawColl, edmNew::DetSetVector<SiStripCluster>& output);
+  void run(const FEDRawDataCollection& rawColl,
+           const std::vector<uint32_t>& detIds,
+           edmNew::DetSetVector<SiStripCluster>& output);
+
+  // all the dets of the conditions if regionalDetIds is null
+  void runFlat(const FEDRawDataCollection& rawColl,
+               const SiStripClusterizerConditions& conditions,
+               const std::vector<uint32_t>* regionalDetIds,
+               edmNew::DetSetVector<SiStripCluster>& output);
+
+  const std::vector<uint32_t>& selectRegionalDets(const edm::Event& ev,
+                                                  const edm::EventSetup& es,
+                                                  const SiStripClusterizerConditions* conditions);
 
 private:
   bool onDemand;
@@ -234,22 +291,80 @@ private:
 
   bool legacy_;
   bool hybridZeroSuppressed_;
+
+  // all the digis of the event unpacked in a structure of arrays, and clustered at once
+  bool flat_;
+  std::unique_ptr<SiStripFlatClusterizer> flatClusterizer_;
+  edm::ESGetToken<SiStripClusterizerConditions, SiStripClusterizerConditionsRcd> conditionsToken_;
+  SiStripFlatDigis flatDigis_;
+
+  // regional unpacking
+  std::vector<edm::EDGetTokenT<edm::OwnVector<TrackingRegion> > > regionTokens_;
+  edm::ESGetToken<TrackerGeometry, TrackerDigiGeometryRecord> geometryToken_;
+  edm::ESGetToken<MagneticField, IdealMagneticFieldRecord> fieldToken_;
+  SiStripRegionalDets regionalDets_;
+  // the geometry, and the good modules of the conditions of the clusterizer
+  edm::ESWatcher<TrackerDigiGeometryRecord> geometryWatcher_;
+  edm::ESWatcher<SiStripClusterizerConditionsRcd> conditionsWatcher_;
+  edm::ESWatcher<SiStripNoisesRcd> noisesWatcher_;
+  edm::ESWatcher<SiStripGainRcd> gainWatcher_;
+  edm::ESWatcher<SiStripQualityRcd> qualityWatcher_;
 };
 
 #include "FWCore/Framework/interface/MakerMacros.h"
 DEFINE_FWK_MODULE(SiStripClusterizerFromRaw);
 
 void SiStripClusterizerFromRaw::initialize(const edm::EventSetup& es) {
-  (*clusterizer_).initialize(es);
-  cabling_ = (*clusterizer_).cabling();
+  if (!flat_) {
+    (*clusterizer_).initialize(es);
+    cabling_ = (*clusterizer_).cabling();
+  }
   (*rawAlgos_).initialize(es);
 }
 
-void SiStripClusterizerFromRaw::run(const FEDRawDataCollection& rawColl, edmNew::DetSetVector<SiStripCluster>& output) {
+const std::vector<uint32_t>& SiStripClusterizerFromRaw::selectRegionalDets(
+    const edm::Event& ev, const edm::EventSetup& es, const SiStripClusterizerConditions* conditions) {
+  // all the watchers are checked, for them to follow every IOV
+  bool changed = geometryWatcher_.check(es);
+  if (conditions) {
+    changed |= conditionsWatcher_.check(es);
+  } else {
+    changed |= noisesWatcher_.check(es);
+    changed |= gainWatcher_.check(es);
+    changed |= qualityWatcher_.check(es);
+  }
+  if (changed) {
+    std::vector<uint32_t> detIds;
+    if (conditions) {
+      detIds.reserve(conditions->nDets());
+      for (auto const& det : conditions->dets())
+        detIds.push_back(det.detId);
+    }
+    auto const& geometry = es.getData(geometryToken_);
+    regionalDets_.setDets(conditions ? detIds : clusterizer_->allDetIds(), [&geometry](uint32_t id) {
+      auto const* det = geometry.idToDetUnit(DetId(id));
+      return det ? &det->surface() : nullptr;
+    });
+  }
+
+  std::vector<const TrackingRegion*> regions;
+  for (auto const& token : regionTokens_) {
+    for (auto const& region : ev.get(token))
+      regions.push_back(&region);
+  }
+  // the nominal value of the field is in kGauss
+  const auto& selected = regionalDets_.select(regions, 0.1f * es.getData(fieldToken_).nominalValue());
+  COUT << "regional dets " << selected.size() << " for " << regions.size() << " regions" << std::endl;
+  return selected;
+}
+
+void SiStripClusterizerFromRaw::run(const FEDRawDataCollection& rawColl,
+                                    const std::vector<uint32_t>& detIds,
+                                    edmNew::DetSetVector<SiStripCluster>& output) {
   ClusterFiller filler(rawColl, *clusterizer_, *rawAlgos_, doAPVEmulatorCheck_, legacy_, hybridZeroSuppressed_);
 
   // loop over good det in cabling
-  for (auto idet : clusterizer_->allDetIds()) {
+  for (auto idet : detIds) {
     StripClusterizerAlgorithm::output_t::TSFastFiller record(output, idet);
 
     filler.fill(record);
@@ -305,6 +420,119 @@ namespace {
   private:
     Container& c_;
   };
+
+  class FlatDigiAppender {
+  public:
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+
+    FlatDigiAppender(SiStripFlatDigis& digis, uint16_t idet, const SiStripClusterizerConditions::Det& det)
+        : digis_(digis), idet_(idet), firstStrip_(det.firstStrip), nStrips_(det.nStrips) {}
+
+    FlatDigiAppender& operator=(SiStripDigi digi) {
+      if (digi.strip() < nStrips_)
+        digis_.push_back(idet_, firstStrip_ + digi.strip(), digi.adc());
+      return *this;
+    }
+
+    FlatDigiAppender& operator*() { return *this; }
+    FlatDigiAppender& operator++() { return *this; }
+    FlatDigiAppender& operator++(int) { return *this; }
+
+  private:
+    SiStripFlatDigis& digis_;
+    uint16_t idet_;
+    uint32_t firstStrip_;
+    uint16_t nStrips_;
+  };
+
+  // unpacks a good channel, passing its zero suppressed digis to out in strip order
+  template <typename OUT>
+  void unpackChannel(const sistrip::FEDBuffer& buffer,
+                     uint16_t fedId,
+                     uint8_t fedCh,
+                     uint16_t ipair,
+                     uint32_t id,
+                     SiStripRawProcessingAlgorithms& rawAlgos,
+                     bool legacy,
+                     bool hybridZeroSuppressed,
+                     OUT& out) {
+    const sistrip::FEDReadoutMode mode = buffer.readoutMode();
+    const sistrip::FEDLegacyReadoutMode lmode =
+        legacy ? buffer.legacyReadoutMode() : sistrip::READOUT_MODE_LEGACY_INVALID;
+
+    using namespace sistrip;
+    if
+      LIKELY(fedchannelunpacker::isZeroSuppressed(mode, legacy, lmode)) {
+        const auto isNonLite = fedchannelunpacker::isNonLiteZS(mode, legacy, lmode);
+        const uint8_t pCode = (isNonLite ? buffer.packetCode(legacy, fedCh) : 0);
+        auto st_ch = fedchannelunpacker::StatusCode::SUCCESS;
+        if
+          LIKELY(!hybridZeroSuppressed) {
+            st_ch = fedchannelunpacker::unpackZeroSuppressed(
+                buffer.channel(fedCh), out, ipair * 256, isNonLite, mode, legacy, lmode, pCode);
+          }
+        else {
+          edm::DetSet<SiStripDigi> unpDigis{id};
+          unpDigis.reserve(256);
+          st_ch = fedchannelunpacker::unpackZeroSuppressed(
+              buffer.channel(fedCh), std::back_inserter(unpDigis), ipair * 256, isNonLite, mode, legacy, lmode, pCode);
+          if (fedchannelunpacker::StatusCode::SUCCESS == st_ch) {
+            SiStripRawProcessingAlgorithms::digivector_t workRawDigis;
+            rawAlgos.convertHybridDigiToRawDigiVector(unpDigis, workRawDigis);
+            edm::DetSet<SiStripDigi> suppDigis{id};
+            rawAlgos.suppressHybridData(id, ipair * 2, workRawDigis, suppDigis);
+            std::copy(std::begin(suppDigis), std::end(suppDigis), out);
+          }
+        }
+        if (fedchannelunpacker::StatusCode::SUCCESS != st_ch && edm::isDebugEnabled()) {
+          edm::LogWarning(sistrip::mlRawToCluster_)
+              << "Unordered clusters for channel " << fedCh << " on FED " << fedId << ": " << toString(st_ch);
+        }
+      }
+    else {
+      auto st_ch = fedchannelunpacker::StatusCode::SUCCESS;
+      if (fedchannelunpacker::isVirginRaw(mode, legacy, lmode)) {
+        std::vector<int16_t> digis;
+        st_ch = fedchannelunpacker::unpackVirginRaw(
+            buffer.channel(fedCh), ADC_back_inserter(digis), buffer.channel(fedCh).packetCode());
+        if (fedchannelunpacker::StatusCode::SUCCESS == st_ch) {
+          //process raw
+          edm::DetSet<SiStripDigi> zsdigis(id);
+          //rawAlgos_->subtractorPed->subtract( id, ipair*256, digis);
+          //rawAlgos_->subtractorCMN->subtract( id, digis);
+          //rawAlgos_->suppressor->suppress( digis, zsdigis);
+          uint16_t firstAPV = ipair * 2;
+          rawAlgos.suppressVirginRawData(id, firstAPV, digis, zsdigis);
+          std::copy(std::begin(zsdigis), std::end(zsdigis), out);
+        }
+      } else if (fedchannelunpacker::isProcessedRaw(mode, legacy, lmode)) {
+        std::vector<int16_t> digis;
+        st_ch = fedchannelunpacker::unpackProcessedRaw(buffer.channel(fedCh), ADC_back_inserter(digis));
+        if (fedchannelunpacker::StatusCode::SUCCESS == st_ch) {
+          //process raw
+          edm::DetSet<SiStripDigi> zsdigis(id);
+          //rawAlgos_->subtractorCMN->subtract( id, digis);
+          //rawAlgos_->suppressor->suppress( digis, zsdigis);
+          uint16_t firstAPV = ipair * 2;
+          rawAlgos.suppressProcessedRawData(id, firstAPV, digis, zsdigis);
+          std::copy(std::begin(zsdigis), std::end(zsdigis), out);
+        }
+      } else {
+        edm::LogWarning(sistrip::mlRawToCluster_)
+            << "[ClustersFromRawProducer::" << __func__ << "]"
+            << " FEDRawData readout mode " << mode << " from FED id " << fedId << " not supported.";
+      }
+      if (fedchannelunpacker::StatusCode::SUCCESS != st_ch && edm::isDebugEnabled()) {
+        edm::LogWarning(sistrip::mlRawToCluster_)
+            << "[ClustersFromRawProducer::" << __func__ << "]" << toString(st_ch) << " from FED id " << fedId
+            << " channel " << fedCh;
+      }
+    }
+  }
 }  // namespace
 
 void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::TSFastFiller& record) {
@@ -368,93 +596,9 @@ void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::TSFastFiller& reco
       // Determine APV std::pair number
       uint16_t ipair = conn->apvPairNumber();
 
-      const sistrip::FEDReadoutMode mode = buffer->readoutMode();
-      const sistrip::FEDLegacyReadoutMode lmode =
-          legacy_ ? buffer->legacyReadoutMode() : sistrip::READOUT_MODE_LEGACY_INVALID;
-
-      using namespace sistrip;
-      if
-        LIKELY(fedchannelunpacker::isZeroSuppressed(mode, legacy_, lmode)) {
-          auto perStripAdder = StripByStripAdder(clusterizer, state, record);
-          const auto isNonLite = fedchannelunpacker::isNonLiteZS(mode, legacy_, lmode);
-          const uint8_t pCode = (isNonLite ? buffer->packetCode(legacy_, fedCh) : 0);
-          auto st_ch = fedchannelunpacker::StatusCode::SUCCESS;
-          if
-            LIKELY(!hybridZeroSuppressed_) {
-              st_ch = fedchannelunpacker::unpackZeroSuppressed(
-                  buffer->channel(fedCh), perStripAdder, ipair * 256, isNonLite, mode, legacy_, lmode, pCode);
-            }
-          else {
-            const uint32_t id = conn->detId();
-            edm::DetSet<SiStripDigi> unpDigis{id};
-            unpDigis.reserve(256);
-            st_ch = fedchannelunpacker::unpackZeroSuppressed(buffer->channel(fedCh),
-                                                             std::back_inserter(unpDigis),
-                                                             ipair * 256,
-                                                             isNonLite,
-                                                             mode,
-                                                             legacy_,
-                                                             lmode,
-                                                             pCode);
-            if (fedchannelunpacker::StatusCode::SUCCESS == st_ch) {
-              SiStripRawProcessingAlgorithms::digivector_t workRawDigis;
-              rawAlgos.convertHybridDigiToRawDigiVector(unpDigis, workRawDigis);
-              edm::DetSet<SiStripDigi> suppDigis{id};
-              rawAlgos.suppressHybridData(id, ipair * 2, workRawDigis, suppDigis);
-              std::copy(std::begin(suppDigis), std::end(suppDigis), perStripAdder);
-            }
-          }
-          if (fedchannelunpacker::StatusCode::SUCCESS != st_ch && edm::isDebugEnabled()) {
-            edm::LogWarning(sistrip::mlRawToCluster_)
-                << "Unordered clusters for channel " << fedCh << " on FED " << fedId << ": " << toString(st_ch);
-            continue;
-          }
-        }
-      else {
-        auto st_ch = fedchannelunpacker::StatusCode::SUCCESS;
-        if (fedchannelunpacker::isVirginRaw(mode, legacy_, lmode)) {
-          std::vector<int16_t> digis;
-          st_ch = fedchannelunpacker::unpackVirginRaw(
-              buffer->channel(fedCh), ADC_back_inserter(digis), buffer->channel(fedCh).packetCode());
-          if (fedchannelunpacker::StatusCode::SUCCESS == st_ch) {
-            //process raw
-            uint32_t id = conn->detId();
-            edm::DetSet<SiStripDigi> zsdigis(id);
-            //rawAlgos_->subtractorPed->subtract( id, ipair*256, digis);
-            //rawAlgos_->subtractorCMN->subtract( id, digis);
-            //rawAlgos_->suppressor->suppress( digis, zsdigis);
-            uint16_t firstAPV = ipair * 2;
-            rawAlgos.suppressVirginRawData(id, firstAPV, digis, zsdigis);
-            for (const auto digi : zsdigis) {
-              clusterizer.stripByStripAdd(state, digi.strip(), digi.adc(), record);
-            }
-          }
-        } else if (fedchannelunpacker::isProcessedRaw(mode, legacy_, lmode)) {
-          std::vector<int16_t> digis;
-          st_ch = fedchannelunpacker::unpackProcessedRaw(buffer->channel(fedCh), ADC_back_inserter(digis));
-          if (fedchannelunpacker::StatusCode::SUCCESS == st_ch) {
-            //process raw
-            uint32_t id = conn->detId();
-            edm::DetSet<SiStripDigi> zsdigis(id);
-            //rawAlgos_->subtractorCMN->subtract( id, digis);
-            //rawAlgos_->suppressor->suppress( digis, zsdigis);
-            uint16_t firstAPV = ipair * 2;
-            rawAlgos.suppressProcessedRawData(id, firstAPV, digis, zsdigis);
-            for (edm::DetSet<SiStripDigi>::const_iterator it = zsdigis.begin(); it != zsdigis.end(); it++) {
-              clusterizer.stripByStripAdd(state, it->strip(), it->adc(), record);
-            }
-          }
-        } else {
-          edm::LogWarning(sistrip::mlRawToCluster_)
-              << "[ClustersFromRawProducer::" << __func__ << "]"
-              << " FEDRawData readout mode " << mode << " from FED id " << fedId << " not supported.";
-        }
-        if (fedchannelunpacker::StatusCode::SUCCESS != st_ch && edm::isDebugEnabled()) {
-          edm::LogWarning(sistrip::mlRawToCluster_)
-              << "[ClustersFromRawProducer::" << __func__ << "]" << toString(st_ch) << " from FED id " << fedId
-              << " channel " << fedCh;
-        }
-      }
+      auto perStripAdder = StripByStripAdder(clusterizer, state, record);
+      unpackChannel(
+          *buffer, fedId, fedCh, ipair, conn->detId(), rawAlgos, legacy_, hybridZeroSuppressed_, perStripAdder);
     }  // end loop over conn
 
     clusterizer.stripByStripEnd(state, record);
@@ -479,3 +623,52 @@ void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::TSFastFiller& reco
     edm::LogError(sistrip::mlRawToCluster_) << "too many Sistrip Clusters to fit space allocated for OnDemand";
   }
 }
+
+void SiStripClusterizerFromRaw::runFlat(const FEDRawDataCollection& rawColl,
+                                        const SiStripClusterizerConditions& conditions,
+                                        const std::vector<uint32_t>* regionalDetIds,
+                                        edmNew::DetSetVector<SiStripCluster>& output) {
+  std::unique_ptr<sistrip::FEDBuffer> buffers[1024];
+  bool tried[1024] = {false};
+
+  flatDigis_.clear();
+  flatDigis_.reserve(1 << 18);
+
+  // loop over good det in cabling, in the order of the conditions
+  for (unsigned int idet = 0; idet < conditions.nDets(); ++idet) {
+    auto const& det = conditions.det(idet);
+    if (regionalDetIds && !std::binary_search(regionalDetIds->begin(), regionalDetIds->end(), det.detId))
+      continue;
+    auto appender = FlatDigiAppender(flatDigis_, idet, det);
+    for (auto ich = det.firstChannel; ich < det.firstChannel + det.nChannels; ++ich) {
+      auto const& channel = conditions.channels()[ich];
+      const uint16_t fedId = channel.fedId;
+      if (!tried[fedId]) {
+        tried[fedId] = true;
+        buffers[fedId] = fillBuffer(fedId, rawColl);
+        if (buffers[fedId])
+          buffers[fedId]->setLegacyMode(legacy_);
+      }
+      sistrip::FEDBuffer* buffer = buffers[fedId].get();
+      if (!buffer)
+        continue;
+
+      const uint8_t fedCh = channel.fedCh;
+      if
+        UNLIKELY(!buffer->channelGood(fedCh, doAPVEmulatorCheck_)) {
+          if (edm::isDebugEnabled()) {
+            std::ostringstream ss;
+            ss << "Problem unpacking channel " << fedCh << " on FED " << fedId;
+            edm::LogWarning(sistrip::mlRawToCluster_) << ss.str();
+          }
+          continue;
+        }
+
+      unpackChannel(
+          *buffer, fedId, fedCh, channel.apvPair, det.detId, *rawAlgos_, legacy_, hybridZeroSuppressed_, appender);
+    }
+  }
+
+  COUT << "flat digis " << flatDigis_.size() << std::endl;
+  flatClusterizer_->clusterize(conditions, flatDigis_, output);
+}
@@ -0,0 +1,47 @@
+#include <memory>
+
+#include "CalibFormats/SiStripObjects/interface/SiStripGain.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
+#include "CalibTracker/Records/interface/SiStripClusterizerConditionsRcd.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripClusterizerConditions.h"
+
+class SiStripClusterizerConditionsESProducer : public edm::ESProducer {
+public:
+  explicit SiStripClusterizerConditionsESProducer(const edm::ParameterSet& iConfig);
+  std::unique_ptr<SiStripClusterizerConditions> produce(const SiStripClusterizerConditionsRcd& iRecord);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  edm::ESGetToken<SiStripGain, SiStripGainRcd> gainToken_;
+  edm::ESGetToken<SiStripNoises, SiStripNoisesRcd> noiseToken_;
+  edm::ESGetToken<SiStripQuality, SiStripQualityRcd> qualityToken_;
+};
+
+SiStripClusterizerConditionsESProducer::SiStripClusterizerConditionsESProducer(const edm::ParameterSet& iConfig) {
+  setWhatProduced(this, iConfig.getParameter<std::string>("Label"))
+      .setConsumes(gainToken_)
+      .setConsumes(noiseToken_)
+      .setConsumes(qualityToken_, edm::ESInputTag("", iConfig.getParameter<std::string>("QualityLabel")));
+}
+
+void SiStripClusterizerConditionsESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<std::string>("QualityLabel", "");
+  desc.add<std::string>("Label", "");
+  descriptions.add("siStripClusterizerConditions", desc);
+}
+
+std::unique_ptr<SiStripClusterizerConditions> SiStripClusterizerConditionsESProducer::produce(
+    const SiStripClusterizerConditionsRcd& iRecord) {
+  return std::make_unique<SiStripClusterizerConditions>(
+      iRecord.get(gainToken_), iRecord.get(noiseToken_), iRecord.get(qualityToken_));
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(SiStripClusterizerConditionsESProducer);
@@ -0,0 +1,142 @@
+#ifndef RecoLocalTracker_SiStripClusterizer_SiStripRegionalDets_h
+#define RecoLocalTracker_SiStripClusterizer_SiStripRegionalDets_h
+
+#include "DataFormats/GeometrySurface/interface/Surface.h"
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "RecoTracker/TkTrackingRegions/interface/RectangularEtaPhiTrackingRegion.h"
+#include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+// The strip modules compatible with a set of tracking regions, for the regional unpacking.
+// Only the RectangularEtaPhiTrackingRegions restrict the modules: the eta range of a module is taken
+// from the corners of its surface seen from the luminous region, and its phi range is widened by the
+// bending of the tracks down to the ptMin of the region.
+//
+// The extents of the modules are computed by setDets, to be called only when the geometry or the list
+// of modules changes. The selection is kept as long as the regions keep the same windows.
+class SiStripRegionalDets {
+public:
+  // surfaceOf(detId) gives the surface of a module, or nullptr if it is unknown (and then always selected)
+  template <typename F>
+  void setDets(const std::vector<uint32_t>& detIds, F&& surfaceOf) {
+    detIds_ = detIds;
+    extents_.clear();
+    extents_.reserve(detIds_.size());
+    for (auto id : detIds_) {
+      Extent e;
+      const Surface* surface = surfaceOf(id);
+      if (surface) {
+        const float hw = 0.5f * surface->bounds().width(), hl = 0.5f * surface->bounds().length();
+        GlobalPoint center = surface->position();
+        e.known = true;
+        e.phi = center.barePhi();
+        e.rmin = e.rmax = center.perp();
+        e.zmin = e.zmax = center.z();
+        for (float sx : {-1.f, 1.f}) {
+          for (float sy : {-1.f, 1.f}) {
+            GlobalPoint p = surface->toGlobal(LocalPoint(sx * hw, sy * hl));
+            e.dphi = std::max(e.dphi, std::abs(float(reco::deltaPhi(p.barePhi(), e.phi))));
+            e.rmin = std::min(e.rmin, p.perp());
+            e.rmax = std::max(e.rmax, p.perp());
+            e.zmin = std::min(e.zmin, p.z());
+            e.zmax = std::max(e.zmax, p.z());
+          }
+        }
+      }
+      extents_.push_back(e);
+    }
+    windows_.clear();
+    valid_ = false;
+  }
+
+  const std::vector<uint32_t>& detIds() const { return detIds_; }
+
+  // the selected detIds, sorted as the ones given to setDets
+  const std::vector<uint32_t>& select(const std::vector<const TrackingRegion*>& regions, float bInTesla) {
+    newWindows_.clear();
+    for (auto const* region : regions) {
+      auto const* etaPhi = dynamic_cast<const RectangularEtaPhiTrackingRegion*>(region);
+      // a region which is not restricted in eta and phi keeps all the modules
+      if (!etaPhi || region->ptMin() <= 0)
+        return detIds_;
+      newWindows_.push_back(Window(*etaPhi, bInTesla));
+    }
+    if (valid_ && newWindows_ == windows_)
+      return selected_;
+    std::swap(windows_, newWindows_);
+    valid_ = true;
+
+    selected_.clear();
+    for (unsigned int i = 0; i < detIds_.size(); ++i) {
+      for (auto const& window : windows_) {
+        if (compatible(extents_[i], window)) {
+          selected_.push_back(detIds_[i]);
+          break;
+        }
+      }
+    }
+    return selected_;
+  }
+
+private:
+  struct Extent {
+    bool known = false;
+    float phi = 0, dphi = 0;
+    float rmin = 0, rmax = 0, zmin = 0, zmax = 0;
+  };
+
+  // what the selection uses of a RectangularEtaPhiTrackingRegion
+  struct Window {
+    Window(const RectangularEtaPhiTrackingRegion& region, float bInTesla)
+        : z0(region.origin().z()),
+          dz(region.originZBound()),
+          dr(region.originRBound()),
+          etaMin(region.etaRange().min()),
+          etaMax(region.etaRange().max()),
+          phi(region.direction().barePhi()),
+          phiLeft(region.phiMargin().left()),
+          phiRight(region.phiMargin().right()),
+          // 0.003 (GeV/c)/(T cm) converts the field and the momentum to the curvature
+          curvature(0.003f * bInTesla / region.ptMin()) {}
+
+    bool operator==(const Window& w) const {
+      return std::tie(z0, dz, dr, etaMin, etaMax, phi, phiLeft, phiRight, curvature) ==
+             std::tie(w.z0, w.dz, w.dr, w.etaMin, w.etaMax, w.phi, w.phiLeft, w.phiRight, w.curvature);
+    }
+
+    float z0, dz, dr;
+    float etaMin, etaMax;
+    float phi, phiLeft, phiRight;
+    float curvature;
+  };
+
+  static bool compatible(const Extent& e, const Window& w) {
+    if (!e.known || e.rmin <= 0)
+      return true;
+
+    const float lo = e.zmin - (w.z0 + w.dz), hi = e.zmax - (w.z0 - w.dz);
+    const float etaMin = std::asinh(lo / (lo >= 0 ? e.rmax : e.rmin));
+    const float etaMax = std::asinh(hi / (hi >= 0 ? e.rmin : e.rmax));
+    if (etaMax < w.etaMin || etaMin > w.etaMax)
+      return false;
+
+    const float bending = std::asin(std::min(1.f, 0.5f * e.rmax * w.curvature));
+    const float displacement = std::asin(std::min(1.f, w.dr / e.rmin));
+    const float margin = e.dphi + bending + displacement;
+    const float dphi = reco::deltaPhi(e.phi, w.phi);
+    return dphi >= -(w.phiLeft + margin) && dphi <= w.phiRight + margin;
+  }
+
+  std::vector<uint32_t> detIds_;
+  std::vector<Extent> extents_;
+  std::vector<Window> windows_, newWindows_;
+  bool valid_ = false;
+  std::vector<uint32_t> selected_;
+};
+
+#endif
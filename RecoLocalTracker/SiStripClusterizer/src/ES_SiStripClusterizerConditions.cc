@@ -0,0 +1,4 @@
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripClusterizerConditions.h"
+#include "FWCore/Utilities/interface/typelookup.h"
+
+TYPELOOKUP_DATA_REG(SiStripClusterizerConditions);
@@ -0,0 +1,69 @@
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripClusterizerConditions.h"
+
+#include "CalibFormats/SiStripObjects/interface/SiStripDetCabling.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripGain.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+
+SiStripClusterizerConditions::SiStripClusterizerConditions(SiStripGain const& gains,
+                                                           SiStripNoises const& noises,
+                                                           SiStripQuality const& quality) {
+  auto const* cabling = quality.cabling();
+  if (!cabling)
+    throw cms::Exception("LogicError") << "SiStripQuality without SiStripDetCabling";
+
+  auto const& connected = cabling->connected();
+  auto const& detCabling = cabling->getDetCabling();
+  dets_.reserve(connected.size());
+  for (auto const& c : connected) {
+    uint32_t detId = c.first;
+    if (quality.IsModuleBad(detId))
+      continue;
+    auto gainRange = gains.getRange(detId);
+    auto noiseRange = noises.getRange(detId);
+    // one gain per apv, and 9 bits of noise per strip
+    uint16_t nStrips = std::min<long>(128 * (gainRange.second - gainRange.first),
+                                      (noiseRange.second - noiseRange.first) * 8 / 9);
+    if (nStrips == 0) {
+      edm::LogWarning("SiStripClusterizerConditions") << "no noise or gain for module " << detId << ", skipped";
+      continue;
+    }
+    if (dets_.size() == invalidDet)
+      throw cms::Exception("LogicError") << "too many modules for SiStripClusterizerConditions";
+
+    Det det;
+    det.detId = detId;
+    det.firstStrip = noise_.size();
+    det.firstChannel = channels_.size();
+    det.nStrips = nStrips;
+    auto conns = detCabling.find(detId);
+    if (conns != detCabling.end()) {
+      for (auto const* conn : conns->second) {
+        if (conn && conn->fedId() && conn->isConnected())
+          channels_.push_back(Channel{conn->fedId(), conn->fedCh(), conn->apvPairNumber()});
+      }
+    }
+    det.nChannels = channels_.size() - det.firstChannel;
+    dets_.push_back(det);
+
+    auto qualityRange = quality.getRange(detId);
+    for (uint16_t strip = 0; strip < nStrips; ++strip) {
+      noise_.push_back(SiStripNoises::getNoise(strip, noiseRange));
+      gain_.push_back(SiStripGain::getStripGain(strip, gainRange));
+      bad_.push_back(quality.IsStripBad(qualityRange, strip));
+    }
+  }
+  dets_.shrink_to_fit();
+}
+
+uint16_t SiStripClusterizerConditions::detIndex(uint32_t detId) const {
+  auto p = std::lower_bound(
+      dets_.begin(), dets_.end(), detId, [](Det const& det, uint32_t id) { return det.detId < id; });
+  if (p == dets_.end() || p->detId != detId)
+    return invalidDet;
+  return p - dets_.begin();
+}
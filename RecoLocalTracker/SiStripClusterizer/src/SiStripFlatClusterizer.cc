@@ -0,0 +1,153 @@
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripFlatClusterizer.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/ClusterChargeCut.h"
+
+#include "DataFormats/SiStripCluster/interface/SiStripClusterTools.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cmath>
+#include <string>
+
+SiStripFlatClusterizer::SiStripFlatClusterizer(const edm::ParameterSet& conf)
+    : ChannelThreshold(conf.getParameter<double>("ChannelThreshold")),
+      SeedThreshold(conf.getParameter<double>("SeedThreshold")),
+      ClusterThresholdSquared(float(conf.getParameter<double>("ClusterThreshold")) *
+                              float(conf.getParameter<double>("ClusterThreshold"))),
+      MaxSequentialHoles(conf.getParameter<unsigned>("MaxSequentialHoles")),
+      MaxSequentialBad(conf.getParameter<unsigned>("MaxSequentialBad")),
+      MaxAdjacentBad(conf.getParameter<unsigned>("MaxAdjacentBad")),
+      minGoodCharge(clusterChargeCut(conf)) {
+  std::string algorithm = conf.getParameter<std::string>("Algorithm");
+  if (algorithm != "ThreeThresholdAlgorithm")
+    throw cms::Exception("[SiStripFlatClusterizer] Unregistered Algorithm")
+        << algorithm << " is not available on the flat digis";
+}
+
+void SiStripFlatClusterizer::clusterize(SiStripClusterizerConditions const& conditions,
+                                        SiStripFlatDigis const& digis,
+                                        output_t& output) {
+  const unsigned int n = digis.size();
+  if (n == 0)
+    return;
+  accepted_.resize(n);
+  seed_.resize(n);
+  noiseSquared_.resize(n);
+  good_.resize(n);
+  split_.resize(n);
+
+  const uint32_t* __restrict__ index = digis.index.data();
+  const uint16_t* __restrict__ det = digis.det.data();
+  const uint8_t* __restrict__ adc = digis.adc.data();
+
+  {
+    // channel and seed thresholds of all the digis, with gathers of the conditions
+    const float* __restrict__ noise = conditions.noise();
+    const uint8_t* __restrict__ bad = conditions.bad();
+    uint8_t* __restrict__ accepted = accepted_.data();
+    uint8_t* __restrict__ seed = seed_.data();
+    float* __restrict__ noiseSquared = noiseSquared_.data();
+    const float channelThreshold = ChannelThreshold;
+    const float seedThreshold = SeedThreshold;
+    for (unsigned int i = 0; i < n; ++i) {
+      float Noise = noise[index[i]];
+      accepted[i] = (adc[i] >= static_cast<uint8_t>(Noise * channelThreshold)) & (bad[index[i]] == 0);
+      seed[i] = adc[i] >= static_cast<uint8_t>(Noise * seedThreshold);
+      noiseSquared[i] = Noise * Noise;
+    }
+  }
+
+  // the digis below threshold or on bad strips are dropped, and only widen the holes between the others
+  uint32_t* __restrict__ good = good_.data();
+  unsigned int m = 0;
+  for (unsigned int i = 0; i < n; ++i) {
+    good[m] = i;
+    m += accepted_[i];
+  }
+  if (m == 0)
+    return;
+
+  {
+    // a candidate ends at a new module or after too many holes
+    uint8_t* __restrict__ split = split_.data();
+    const uint16_t maxHoles = MaxSequentialHoles;
+    split[0] = 1;
+    for (unsigned int k = 1; k < m; ++k) {
+      uint16_t holes = index[good[k]] - index[good[k - 1]] - 1;
+      split[k] = (det[good[k]] != det[good[k - 1]]) | (holes > maxHoles);
+    }
+    // unless all the holes are bad strips: rare, checked strip by strip
+    for (unsigned int k = 1; k < m; ++k) {
+      uint16_t holes = index[good[k]] - index[good[k - 1]] - 1;
+      if (split[k] && det[good[k]] == det[good[k - 1]] && holes <= MaxSequentialBad) {
+        auto const& d = conditions.det(det[good[k]]);
+        split[k] = !allBadBetween(conditions, d, index[good[k - 1]] - d.firstStrip, index[good[k]] - d.firstStrip);
+      }
+    }
+  }
+
+  unsigned int k = 0;
+  while (k < m) {
+    auto const& d = conditions.det(det[good[k]]);
+    output_t::TSFastFiller record(output, d.detId);
+    do {
+      unsigned int e = k + 1;
+      while (e < m && !split_[e])
+        ++e;
+      endCandidate(conditions, d, digis, k, e, record);
+      k = e;
+    } while (k < m && det[good[k]] == det[good[k - 1]]);
+    if (record.empty())
+      record.abort();
+  }
+}
+
+void SiStripFlatClusterizer::endCandidate(SiStripClusterizerConditions const& conditions,
+                                          Det const& det,
+                                          SiStripFlatDigis const& digis,
+                                          unsigned int begin,
+                                          unsigned int end,
+                                          output_t::TSFastFiller& out) {
+  bool candidateLacksSeed = true;
+  float noiseSquared = 0;
+  int sumADC = 0;
+  for (unsigned int j = begin; j < end; ++j) {
+    auto i = good_[j];
+    candidateLacksSeed &= !seed_[i];
+    noiseSquared += noiseSquared_[i];
+    sumADC += digis.adc[i];
+  }
+  if (candidateLacksSeed || noiseSquared * ClusterThresholdSquared > std::pow(float(sumADC), 2.f))
+    return;
+
+  uint32_t first = digis.index[good_[begin]];
+  uint32_t last = digis.index[good_[end - 1]];
+  ADCs_.assign(last - first + 1, 0);  // pad holes
+  for (unsigned int j = begin; j < end; ++j)
+    ADCs_[digis.index[good_[j]] - first] = digis.adc[good_[j]];
+
+  // gains
+  const float* gain = conditions.gain() + first;
+  for (auto& adc : ADCs_) {
+    auto charge = int(float(adc) / (*gain++) + 0.5f);  //adding 0.5 turns truncation into rounding
+    if (adc < 254)
+      adc = (charge > 1022 ? 255 : (charge > 253 ? 254 : charge));
+  }
+
+  // bad neighbours
+  uint16_t firstStrip = first - det.firstStrip;
+  uint16_t lastStrip = last - det.firstStrip;
+  uint8_t max = MaxAdjacentBad;
+  while (0 < max--) {
+    if (conditions.bad(det, firstStrip - 1)) {
+      ADCs_.insert(ADCs_.begin(), 0);
+      --firstStrip;
+    }
+    if (conditions.bad(det, lastStrip + 1)) {
+      ADCs_.push_back(0);
+      ++lastStrip;
+    }
+  }
+
+  if (siStripClusterTools::chargePerCM(det.detId, ADCs_.begin(), ADCs_.end()) > minGoodCharge)
+    out.push_back(SiStripCluster(firstStrip, ADCs_.begin(), ADCs_.end()));
+}
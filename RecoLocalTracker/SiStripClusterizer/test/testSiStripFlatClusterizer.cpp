@@ -0,0 +1,220 @@
+// The clusters of SiStripFlatClusterizer are the ones of ThreeThresholdAlgorithm run strip by strip
+#include "CalibFormats/SiStripObjects/interface/SiStripDetCabling.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripGain.h"
+#include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
+#include "CalibTracker/SiStripCommon/interface/SiStripDetInfoFileReader.h"
+#include "CalibTracker/StandaloneTrackerTopology/interface/StandaloneTrackerTopology.h"
+#include "CondFormats/SiStripObjects/interface/FedChannelConnection.h"
+#include "CondFormats/SiStripObjects/interface/SiStripApvGain.h"
+#include "CondFormats/SiStripObjects/interface/SiStripFedCabling.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripClusterizerConditions.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripFlatClusterizer.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/SiStripFlatDigis.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/StripClusterizerAlgorithm.h"
+#include "RecoLocalTracker/SiStripClusterizer/interface/StripClusterizerAlgorithmFactory.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+  // the conditions of a few hundred modules of the strip tracker, with random noises, gains and bad strips
+  class Conditions {
+  public:
+    explicit Conditions(std::mt19937& rng)
+        : topology_(StandaloneTrackerTopology::fromTrackerParametersXMLFile(
+              edm::FileInPath("Geometry/TrackerCommonData/data/PhaseI/trackerParameters.xml").fullPath())) {
+      SiStripDetInfoFileReader reader(edm::FileInPath("CalibTracker/SiStripCommon/data/SiStripDetInfo.dat").fullPath());
+      auto const& allDetIds = reader.getAllDetIds();
+      for (unsigned int i = 0; i < allDetIds.size(); i += 50)
+        detIds_.push_back(allDetIds[i]);
+
+      std::uniform_real_distribution<float> flat(0.f, 1.f);
+      std::vector<FedChannelConnection> connections;
+      for (auto detId : detIds_) {
+        const uint16_t nApvs = reader.getNumberOfApvsAndStripLength(detId).first;
+        const uint16_t nPairs = nApvs / 2;
+        for (uint16_t pair = 0; pair < nPairs; ++pair) {
+          // the i2c addresses of the apvs of each pair, for 2 or 3 pairs
+          const uint16_t apv0 = 32 + 2 * pair * (nPairs == 2 ? 2 : 1);
+          const uint16_t fedCh = connections.size() % 96;
+          const uint16_t fedId = 50 + connections.size() / 96;
+          connections.emplace_back(1, 2, 1, 1, 0x10, apv0, apv0 + 1, detId, detId, nPairs, fedId, fedCh);
+        }
+
+        SiStripNoises::InputVector noise;
+        for (int strip = 0; strip < 128 * nApvs; ++strip)
+          noises_.setData(2.f + 4.f * flat(rng), noise);
+        noises_.put(detId, noise);
+
+        std::vector<float> gain;
+        for (int apv = 0; apv < nApvs; ++apv)
+          gain.push_back(0.8f + 0.4f * flat(rng));
+        apvGain_.put(detId, SiStripApvGain::Range(gain.begin(), gain.end()));
+
+        // isolated bad strips, and a few runs of them
+        std::vector<unsigned int> bad;
+        for (int strip = 0; strip < 128 * nApvs; ++strip) {
+          if (flat(rng) < 0.01f)
+            bad.push_back(quality_.encode(strip, flat(rng) < 0.2f && strip + 3 <= 128 * nApvs ? 3 : 1));
+        }
+        if (!bad.empty())
+          badStrips_[detId] = bad;
+      }
+      fedCabling_ = std::make_unique<SiStripFedCabling>(
+          SiStripFedCabling::ConnsConstIterRange(connections.begin(), connections.end()));
+      detCabling_ = std::make_unique<SiStripDetCabling>(*fedCabling_, &topology_);
+      gain_ = std::make_unique<SiStripGain>(apvGain_, 1.);
+
+      quality_.add(detCabling_.get());
+      for (auto const& bad : badStrips_)
+        quality_.add(bad.first, SiStripBadStrip::Range(bad.second.begin(), bad.second.end()));
+      quality_.cleanUp();
+      quality_.fillBadComponents();
+    }
+
+    const SiStripGain& gain() const { return *gain_; }
+    const SiStripNoises& noises() const { return noises_; }
+    const SiStripQuality& quality() const { return quality_; }
+
+    StripClusterizerAlgorithm::Det det(uint32_t detId) const {
+      StripClusterizerAlgorithm::Det det;
+      det.quality = &quality_;
+      det.gainRange = gain_->getRange(detId);
+      det.noiseRange = noises_.getRange(detId);
+      det.qualityRange = quality_.getRange(detId);
+      det.detId = detId;
+      det.ind = 0;
+      return det;
+    }
+
+  private:
+    TrackerTopology topology_;
+    std::vector<uint32_t> detIds_;
+    std::unique_ptr<SiStripFedCabling> fedCabling_;
+    std::unique_ptr<SiStripDetCabling> detCabling_;
+    SiStripNoises noises_;
+    SiStripApvGain apvGain_;
+    std::unique_ptr<SiStripGain> gain_;
+    SiStripQuality quality_;
+    std::map<uint32_t, std::vector<unsigned int>> badStrips_;
+  };
+
+  // zero suppressed digis of a module: wide and narrow pulses, saturated strips, and noise
+  std::vector<std::pair<uint16_t, uint8_t>> makeDigis(std::mt19937& rng, uint16_t nStrips) {
+    std::uniform_real_distribution<float> flat(0.f, 1.f);
+    std::vector<uint8_t> adcs(nStrips, 0);
+    for (uint16_t strip = 0; strip < nStrips; ++strip) {
+      if (flat(rng) < 0.02f) {
+        const int width = 1 + int(5 * flat(rng));
+        const float amplitude = flat(rng) < 0.05f ? 300.f : 10.f + 90.f * flat(rng);
+        for (int k = 0; k < width && strip + k < nStrips; ++k) {
+          // with holes in some of the pulses
+          if (width > 2 && flat(rng) < 0.1f)
+            continue;
+          const int adc = amplitude * (0.5f + flat(rng));
+          adcs[strip + k] = std::max<int>(adcs[strip + k], adc > 1022 ? 255 : (adc > 253 ? 254 : adc));
+        }
+      } else if (flat(rng) < 0.05f) {
+        adcs[strip] = std::max<uint8_t>(adcs[strip], 1 + int(15 * flat(rng)));
+      }
+    }
+    std::vector<std::pair<uint16_t, uint8_t>> digis;
+    for (uint16_t strip = 0; strip < nStrips; ++strip) {
+      if (adcs[strip])
+        digis.emplace_back(strip, adcs[strip]);
+    }
+    return digis;
+  }
+
+  edm::ParameterSet makeConfig(unsigned int maxSequentialHoles, unsigned int maxAdjacentBad, double chargeCut) {
+    edm::ParameterSet clusterChargeCut;
+    clusterChargeCut.addParameter<double>("value", chargeCut);
+    edm::ParameterSet conf;
+    conf.addParameter<std::string>("Algorithm", "ThreeThresholdAlgorithm");
+    conf.addParameter<double>("ChannelThreshold", 2.0);
+    conf.addParameter<double>("SeedThreshold", 3.0);
+    conf.addParameter<double>("ClusterThreshold", 5.0);
+    conf.addParameter<unsigned int>("MaxSequentialHoles", maxSequentialHoles);
+    conf.addParameter<unsigned int>("MaxSequentialBad", 1);
+    conf.addParameter<unsigned int>("MaxAdjacentBad", maxAdjacentBad);
+    conf.addParameter<std::string>("QualityLabel", "");
+    conf.addParameter<bool>("RemoveApvShots", false);
+    conf.addParameter<edm::ParameterSet>("clusterChargeCut", clusterChargeCut);
+    return conf;
+  }
+
+  bool sameClusters(const std::vector<SiStripCluster>& expected, const edmNew::DetSet<SiStripCluster>& clusters) {
+    if (clusters.size() != expected.size())
+      return false;
+    for (unsigned int i = 0; i < expected.size(); ++i) {
+      auto const& cluster = clusters[i];
+      if (cluster.firstStrip() != expected[i].firstStrip() || cluster.amplitudes() != expected[i].amplitudes())
+        return false;
+    }
+    return true;
+  }
+
+  // the number of modules with different clusters
+  int compare(const edm::ParameterSet& conf,
+              const Conditions& conditions,
+              const SiStripClusterizerConditions& flatConditions,
+              std::mt19937& rng,
+              unsigned int& nClusters) {
+    auto algorithm = StripClusterizerAlgorithmFactory::create(conf);
+    SiStripFlatClusterizer flatClusterizer(conf);
+
+    SiStripFlatDigis digis;
+    std::vector<std::vector<SiStripCluster>> expected(flatConditions.nDets());
+    for (unsigned int idet = 0; idet < flatConditions.nDets(); ++idet) {
+      auto const& det = flatConditions.det(idet);
+      auto const stripByStripDet = conditions.det(det.detId);
+      StripClusterizerAlgorithm::State state(stripByStripDet);
+      for (auto const& digi : makeDigis(rng, det.nStrips)) {
+        digis.push_back(idet, det.firstStrip + digi.first, digi.second);
+        algorithm->stripByStripAdd(state, digi.first, digi.second, expected[idet]);
+      }
+      algorithm->stripByStripEnd(state, expected[idet]);
+    }
+
+    edmNew::DetSetVector<SiStripCluster> output;
+    flatClusterizer.clusterize(flatConditions, digis, output);
+
+    int failures = 0;
+    for (unsigned int idet = 0; idet < flatConditions.nDets(); ++idet) {
+      auto const detId = flatConditions.det(idet).detId;
+      auto it = output.find(detId);
+      const unsigned int found = it == output.end() ? 0 : (*it).size();
+      if (it == output.end() ? !expected[idet].empty() : !sameClusters(expected[idet], *it)) {
+        ++failures;
+        std::cout << "module " << detId << ": " << expected[idet].size() << " clusters expected, " << found
+                  << " found" << std::endl;
+      }
+      nClusters += expected[idet].size();
+    }
+    return failures;
+  }
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(2026);
+  Conditions const conditions(rng);
+  SiStripClusterizerConditions const flatConditions(conditions.gain(), conditions.noises(), conditions.quality());
+
+  int failures = 0;
+  unsigned int nClusters = 0;
+  for (auto const& conf : {makeConfig(0, 0, -1.), makeConfig(1, 1, 1620.), makeConfig(2, 2, 800.)})
+    failures += compare(conf, conditions, flatConditions, rng, nClusters);
+
+  std::cout << flatConditions.nDets() << " modules, " << nClusters << " clusters, " << failures
+            << " modules different from ThreeThresholdAlgorithm" << std::endl;
+  return failures == 0 && flatConditions.nDets() > 0 && nClusters > 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// The strip modules selected by SiStripRegionalDets, and the selection kept from one event to the next
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+#include "DataFormats/GeometrySurface/interface/RectangularPlaneBounds.h"
+#include "RecoLocalTracker/SiStripClusterizer/plugins/SiStripRegionalDets.h"
+#include "RecoTracker/TkTrackingRegions/interface/GlobalTrackingRegion.h"
+#include "RecoTracker/TkTrackingRegions/interface/RectangularEtaPhiTrackingRegion.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+  // modules of 10x10 cm, perpendicular to the beam line
+  class Modules {
+  public:
+    void add(uint32_t id, float r, float phi, float z) {
+      planes_[id] = Plane::build(Surface::PositionType(r * std::cos(phi), r * std::sin(phi), z),
+                                 Surface::RotationType(),
+                                 new RectangularPlaneBounds(5.f, 5.f, 0.1f));
+      ids_.push_back(id);
+    }
+
+    const std::vector<uint32_t>& ids() const { return ids_; }
+
+    const Surface* operator()(uint32_t id) const {
+      auto it = planes_.find(id);
+      return it == planes_.end() ? nullptr : it->second.get();
+    }
+
+  private:
+    std::map<uint32_t, Plane::PlanePointer> planes_;
+    std::vector<uint32_t> ids_;
+  };
+
+  RectangularEtaPhiTrackingRegion makeRegion(float eta, float phi, float ptMin = 1.f) {
+    return RectangularEtaPhiTrackingRegion(
+        GlobalVector(std::cos(phi), std::sin(phi), std::sinh(eta)), GlobalPoint(0, 0, 0), ptMin, 0.2f, 15.f, 0.3f, 0.3f);
+  }
+
+}  // namespace
+
+int main() {
+  constexpr float bInTesla = 3.8f;
+
+  // at eta 1 in the direction of the region, opposite in phi, at eta 2.3, at 1.2 in phi from the region,
+  // and a module with no surface
+  Modules modules;
+  modules.add(1, 85.f, 0.f, 100.f);
+  modules.add(2, 85.f, M_PI, 100.f);
+  modules.add(3, 20.f, 0.f, 100.f);
+  modules.add(5, 85.f, 1.2f, 100.f);
+  std::vector<uint32_t> ids = modules.ids();
+  ids.push_back(4);
+
+  SiStripRegionalDets dets;
+  dets.setDets(ids, modules);
+  assert(dets.detIds() == ids);
+
+  auto const region = makeRegion(1.f, 0.f);
+  auto const& selected = dets.select({&region}, bInTesla);
+  assert(selected == (std::vector<uint32_t>{1, 4}));
+
+  // the opposite region, two regions, no region, and a region which does not restrict the modules
+  auto const opposite = makeRegion(1.f, M_PI);
+  assert(dets.select({&opposite}, bInTesla) == (std::vector<uint32_t>{2, 4}));
+  assert(dets.select({&region, &opposite}, bInTesla) == (std::vector<uint32_t>{1, 2, 4}));
+  assert(dets.select({}, bInTesla).empty());
+  GlobalTrackingRegion const global;
+  assert(dets.select({&region, &global}, bInTesla) == ids);
+
+  // a low ptMin bends the tracks up to the module at 1.2 in phi
+  auto const soft = makeRegion(1.f, 0.f, 0.1f);
+  assert(dets.select({&soft}, bInTesla) == (std::vector<uint32_t>{1, 5, 4}));
+
+  // new modules replace the selection of the same regions
+  modules.add(6, 85.f, 0.1f, 100.f);
+  dets.setDets(modules.ids(), modules);
+  assert(dets.select({&region}, bInTesla) == (std::vector<uint32_t>{1, 6}));
+
+  // a sequence of regions, repeated or not, selects what a fresh selection would
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> flat(-1.f, 1.f);
+  Modules many;
+  for (uint32_t id = 0; id < 2000; ++id)
+    many.add(id, 25.f + 50.f * (1.f + flat(rng)), M_PI * flat(rng), 250.f * flat(rng));
+  dets.setDets(many.ids(), many);
+  std::vector<RectangularEtaPhiTrackingRegion> regions;
+  for (int i = 0; i < 5; ++i)
+    regions.push_back(makeRegion(2.f * flat(rng), M_PI * flat(rng)));
+  int failures = 0;
+  unsigned int nSelected = 0;
+  for (int event = 0; event < 50; ++event) {
+    auto const& a = regions[event % 3 == 0 ? 0 : rng() % regions.size()];
+    auto const& b = regions[rng() % regions.size()];
+    std::vector<const TrackingRegion*> eventRegions = {&a, &b};
+    SiStripRegionalDets fresh;
+    fresh.setDets(many.ids(), many);
+    auto const& cached = dets.select(eventRegions, bInTesla);
+    auto const& expected = fresh.select(eventRegions, bInTesla);
+    failures += cached != expected;
+    nSelected += expected.size();
+  }
+  std::cout << "selections different from a fresh selection: " << failures << std::endl;
+  assert(failures == 0);
+  assert(nSelected > 0 && nSelected < 50 * many.ids().size());
+  return 0;
+}
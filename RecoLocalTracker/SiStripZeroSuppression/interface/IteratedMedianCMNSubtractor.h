@@ -19,12 +19,19 @@ public:
 private:
   template <typename T>
   void subtract_(uint32_t detId, uint16_t firstAPV, std::vector<T>& digis);
+  template <typename T>
+  void subtractBatched_(uint32_t detId, uint16_t firstAPV, std::vector<T>& digis);
   inline float pairMedian(std::vector<std::pair<float, float> >& sample);
 
-  IteratedMedianCMNSubtractor(double sigma, int iterations)
-      : cut_to_avoid_signal_(sigma), iterations_(iterations), noise_cache_id(0), quality_cache_id(0){};
+  IteratedMedianCMNSubtractor(double sigma, int iterations, bool batched = false)
+      : cut_to_avoid_signal_(sigma),
+        iterations_(iterations),
+        batched_(batched),
+        noise_cache_id(0),
+        quality_cache_id(0){};
   double cut_to_avoid_signal_;
   int iterations_;
+  bool batched_;
   edm::ESHandle<SiStripNoises> noiseHandle;
   edm::ESHandle<SiStripQuality> qualityHandle;
   uint32_t noise_cache_id, quality_cache_id;
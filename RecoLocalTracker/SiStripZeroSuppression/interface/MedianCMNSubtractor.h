@@ -12,6 +12,9 @@ public:
 private:
   template <typename T>
   void subtract_(uint32_t detId, uint16_t firstAPV, std::vector<T>& digis);
-  MedianCMNSubtractor(){};
+  template <typename T>
+  void subtractBatched_(uint16_t firstAPV, std::vector<T>& digis);
+  MedianCMNSubtractor(bool batched = false) : batched_(batched){};
+  bool batched_;
 };
 #endif
@@ -0,0 +1,28 @@
+#ifndef RECOLOCALTRACKER_SISTRIPZEROSUPPRESSION_SISTRIPBATCHEDMEDIAN_H
+#define RECOLOCALTRACKER_SISTRIPZEROSUPPRESSION_SISTRIPBATCHEDMEDIAN_H
+
+#include <limits>
+
+// Medians of the 128 strips of several APVs at once. The strips are stored transposed, one APV
+// per lane, and sorted by a bitonic network: the sequence of compare-exchanges does not depend on
+// the data, so each of them is a min and a max across all the lanes, which the compiler vectorizes.
+// Strips left out of a sample are set to excluded() and end up after all the others.
+class SiStripBatchedMedian {
+public:
+  static constexpr unsigned int nStrips = 128;
+  static constexpr unsigned int nLanes = 8;
+  typedef float batch_t[nStrips][nLanes];
+
+  static constexpr float excluded() { return std::numeric_limits<float>::infinity(); }
+
+  // sorts each lane in ascending order
+  static void sort(batch_t& batch);
+
+  // median of the first n strips of a sorted lane, the same as SiStripCommonModeNoiseSubtractor::median
+  static float median(const batch_t& sorted, unsigned int lane, unsigned int n) {
+    if (n & 1)  //odd size
+      return sorted[n / 2][lane];
+    return (sorted[n / 2 - 1][lane] + sorted[n / 2][lane]) / 2.;
+  }
+};
+#endif
@@ -1,10 +1,12 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/IteratedMedianCMNSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripBatchedMedian.h"
 
 #include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
 #include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
 #include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
 #include "CalibTracker/Records/interface/SiStripQualityRcd.h"
 #include <cmath>
+#include <limits>
 
 void IteratedMedianCMNSubtractor::init(const edm::EventSetup& es) {
   uint32_t n_cache_id = es.get<SiStripNoisesRcd>().cacheIdentifier();
@@ -29,6 +31,10 @@ void IteratedMedianCMNSubtractor::subtract(uint32_t detId, uint16_t firstAPV, st
 
 template <typename T>
 inline void IteratedMedianCMNSubtractor::subtract_(uint32_t detId, uint16_t firstAPV, std::vector<T>& digis) {
+  if (batched_) {
+    subtractBatched_(detId, firstAPV, digis);
+    return;
+  }
   SiStripNoises::Range detNoiseRange = noiseHandle->getRange(detId);
   SiStripQuality::Range detQualityRange = qualityHandle->getRange(detId);
 
@@ -82,6 +88,88 @@ inline void IteratedMedianCMNSubtractor::subtract_(uint32_t detId, uint16_t firs
   }
 }
 
+// The same iterations on all the APVs of a batch at once: the strips removed from the subsets are
+// masked and pushed to the end of the sorted lanes instead of being erased from a vector.
+template <typename T>
+inline void IteratedMedianCMNSubtractor::subtractBatched_(uint32_t detId, uint16_t firstAPV, std::vector<T>& digis) {
+  SiStripNoises::Range detNoiseRange = noiseHandle->getRange(detId);
+  SiStripQuality::Range detQualityRange = qualityHandle->getRange(detId);
+
+  constexpr unsigned int nStrips = SiStripBatchedMedian::nStrips;
+  constexpr unsigned int nLanes = SiStripBatchedMedian::nLanes;
+  float adcs[nStrips][nLanes], noises[nStrips][nLanes];
+  bool keep[nStrips][nLanes];
+  SiStripBatchedMedian::batch_t work;
+  float offset = 0;
+  const unsigned int nAPVs = digis.size() / nStrips;
+
+  _vmedians.clear();
+
+  for (unsigned int first = 0; first < nAPVs; first += nLanes) {
+    const unsigned int lanes = std::min(nLanes, nAPVs - first);
+    // all good strips and their noises
+    for (unsigned int strip = 0; strip < nStrips; ++strip) {
+      for (unsigned int lane = 0; lane < nLanes; ++lane) {
+        const uint16_t istrip = (firstAPV + first + lane) * nStrips + strip;
+        const bool good = lane < lanes && !qualityHandle->IsStripBad(detQualityRange, istrip);
+        keep[strip][lane] = good;
+        adcs[strip][lane] = good ? (float)digis[(first + lane) * nStrips + strip] : 0.f;
+        noises[strip][lane] = good ? (float)noiseHandle->getNoiseFast(istrip, detNoiseRange) : 0.f;
+      }
+    }
+
+    float offsets[nLanes] = {};
+    bool active[nLanes];
+    // the median of all the good strips is computed even with Iterations < 1, as in subtract_
+    for (int ii = 0; ii < std::max(iterations_, 1); ++ii) {
+      // for second, third... iterations, remove strips over threshold
+      if (ii > 0) {
+        for (unsigned int strip = 0; strip < nStrips; ++strip) {
+          for (unsigned int lane = 0; lane < nLanes; ++lane)
+            keep[strip][lane] &= !(adcs[strip][lane] - offsets[lane] > cut_to_avoid_signal_ * noises[strip][lane]);
+        }
+      }
+      unsigned int counts[nLanes] = {};
+      for (unsigned int strip = 0; strip < nStrips; ++strip) {
+        for (unsigned int lane = 0; lane < nLanes; ++lane) {
+          work[strip][lane] = keep[strip][lane] ? adcs[strip][lane] : SiStripBatchedMedian::excluded();
+          counts[lane] += keep[strip][lane];
+        }
+      }
+      SiStripBatchedMedian::sort(work);
+
+      bool anyActive = false;
+      for (unsigned int lane = 0; lane < lanes; ++lane) {
+        if (ii == 0)
+          active[lane] = true;
+        if (!active[lane])
+          continue;
+        if (counts[lane] == 0) {
+          // an APV without good strips keeps the offset of the previous one
+          if (ii == 0)
+            offsets[lane] = std::numeric_limits<float>::quiet_NaN();
+          active[lane] = false;
+          continue;
+        }
+        offsets[lane] = SiStripBatchedMedian::median(work, lane, counts[lane]);
+        anyActive = true;
+      }
+      if (!anyActive)
+        break;
+    }
+    for (unsigned int lane = 0; lane < lanes; ++lane) {
+      if (!std::isnan(offsets[lane]))
+        offset = offsets[lane];
+      _vmedians.push_back(std::pair<short, float>(firstAPV + first + lane, offset));
+
+      // remove offset
+      T* apv = digis.data() + (first + lane) * nStrips;
+      for (unsigned int strip = 0; strip < nStrips; ++strip)
+        apv[strip] = static_cast<T>(apv[strip] - offset);
+    }
+  }
+}
+
 inline float IteratedMedianCMNSubtractor::pairMedian(std::vector<std::pair<float, float> >& sample) {
   std::vector<std::pair<float, float> >::iterator mid = sample.begin() + sample.size() / 2;
   std::nth_element(sample.begin(), mid, sample.end());
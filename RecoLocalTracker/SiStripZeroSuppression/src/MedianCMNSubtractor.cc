@@ -1,4 +1,5 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/MedianCMNSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripBatchedMedian.h"
 
 void MedianCMNSubtractor::subtract(uint32_t detId, uint16_t firstAPV, std::vector<int16_t>& digis) {
   subtract_(detId, firstAPV, digis);
@@ -9,6 +10,10 @@ void MedianCMNSubtractor::subtract(uint32_t detId, uint16_t firstAPV, std::vecto
 
 template <typename T>
 inline void MedianCMNSubtractor::subtract_(uint32_t detId, uint16_t firstAPV, std::vector<T>& digis) {
+  if (batched_) {
+    subtractBatched_(firstAPV, digis);
+    return;
+  }
   std::vector<T> tmp;
   tmp.reserve(128);
   typename std::vector<T>::iterator strip(digis.begin()), end(digis.end()), endAPV;
@@ -29,3 +34,31 @@ inline void MedianCMNSubtractor::subtract_(uint32_t detId, uint16_t firstAPV, st
     }
   }
 }
+
+template <typename T>
+inline void MedianCMNSubtractor::subtractBatched_(uint16_t firstAPV, std::vector<T>& digis) {
+  constexpr unsigned int nStrips = SiStripBatchedMedian::nStrips;
+  constexpr unsigned int nLanes = SiStripBatchedMedian::nLanes;
+  SiStripBatchedMedian::batch_t batch;
+  const unsigned int nAPVs = digis.size() / nStrips;
+
+  _vmedians.clear();
+
+  for (unsigned int first = 0; first < nAPVs; first += nLanes) {
+    const unsigned int lanes = std::min(nLanes, nAPVs - first);
+    T* adcs = digis.data() + first * nStrips;
+    for (unsigned int strip = 0; strip < nStrips; ++strip) {
+      for (unsigned int lane = 0; lane < nLanes; ++lane)
+        batch[strip][lane] = lane < lanes ? adcs[lane * nStrips + strip] : SiStripBatchedMedian::excluded();
+    }
+    SiStripBatchedMedian::sort(batch);
+
+    for (unsigned int lane = 0; lane < lanes; ++lane) {
+      const float offset = SiStripBatchedMedian::median(batch, lane, nStrips);
+      _vmedians.push_back(std::pair<short, float>(first + lane + firstAPV, offset));
+      T* apv = adcs + lane * nStrips;
+      for (unsigned int strip = 0; strip < nStrips; ++strip)
+        apv[strip] = static_cast<T>(apv[strip] - offset);
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripBatchedMedian.h"
+
+#include <algorithm>
+
+void SiStripBatchedMedian::sort(batch_t& batch) {
+  for (unsigned int k = 2; k <= nStrips; k <<= 1) {
+    for (unsigned int j = k >> 1; j > 0; j >>= 1) {
+      for (unsigned int i = 0; i < nStrips; ++i) {
+        unsigned int l = i ^ j;
+        if (l <= i)
+          continue;
+        // the smaller values go to row i in the ascending blocks, to row l in the descending ones
+        float* __restrict__ lo = (i & k) == 0 ? batch[i] : batch[l];
+        float* __restrict__ hi = (i & k) == 0 ? batch[l] : batch[i];
+        for (unsigned int lane = 0; lane < nLanes; ++lane) {
+          float a = lo[lane], b = hi[lane];
+          lo[lane] = std::min(a, b);
+          hi[lane] = std::max(a, b);
+        }
+      }
+    }
+  }
+}
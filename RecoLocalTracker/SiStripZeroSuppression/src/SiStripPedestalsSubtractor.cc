@@ -28,19 +28,14 @@ inline void SiStripPedestalsSubtractor::subtract_(uint32_t id,
     SiStripPedestals::Range pedestalsRange = pedestalsHandle->getRange(id);
     pedestalsHandle->allPeds(pedestals, pedestalsRange);
 
-    typename input_t::const_iterator inDigi = input.begin();
-    std::vector<int>::const_iterator ped = pedestals.begin() + firstStrip;
-    std::vector<int16_t>::iterator outDigi = output.begin();
-
-    while (inDigi != input.end()) {
-      *outDigi = eval(*inDigi) - *ped + ((*ped > 895) ? 1024 : 0);
-
-      if (fedmode_ && *outDigi < 0)  //FED bottoms out at 0
-        *outDigi = 0;
-
-      ++inDigi;
-      ++ped;
-      ++outDigi;
+    // branchless, so that the loop is vectorized
+    const int* ped = pedestals.data() + firstStrip;
+    int16_t* outDigi = output.data();  // may be the input itself
+    const bool fedmode = fedmode_;
+    const unsigned int size = input.size();
+    for (unsigned int i = 0; i < size; ++i) {
+      int16_t adc = eval(input[i]) - ped[i] + ((ped[i] > 895) ? 1024 : 0);
+      outDigi[i] = (fedmode && adc < 0) ? 0 : adc;  //FED bottoms out at 0
     }
 
   } catch (cms::Exception& e) {
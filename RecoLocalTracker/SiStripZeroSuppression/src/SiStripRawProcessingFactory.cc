@@ -29,9 +29,11 @@ std::unique_ptr<SiStripPedestalsSubtractor> SiStripRawProcessingFactory::create_
 std::unique_ptr<SiStripCommonModeNoiseSubtractor> SiStripRawProcessingFactory::create_SubtractorCMN(
     const edm::ParameterSet& conf) {
   const std::string mode = conf.getParameter<std::string>("CommonModeNoiseSubtractionMode");
+  // medians of several APVs at once with a sorting network, for Median and IteratedMedian
+  const bool batched = conf.exists("BatchedCommonModeNoise") ? conf.getParameter<bool>("BatchedCommonModeNoise") : false;
 
   if (mode == "Median")
-    return std::unique_ptr<SiStripCommonModeNoiseSubtractor>(new MedianCMNSubtractor());
+    return std::unique_ptr<SiStripCommonModeNoiseSubtractor>(new MedianCMNSubtractor(batched));
 
   if (mode == "Percentile") {
     return std::unique_ptr<SiStripCommonModeNoiseSubtractor>(
@@ -40,7 +42,7 @@ std::unique_ptr<SiStripCommonModeNoiseSubtractor> SiStripRawProcessingFactory::c
 
   if (mode == "IteratedMedian") {
     return std::unique_ptr<SiStripCommonModeNoiseSubtractor>(new IteratedMedianCMNSubtractor(
-        conf.getParameter<double>("CutToAvoidSignal"), conf.getParameter<int>("Iterations")));
+        conf.getParameter<double>("CutToAvoidSignal"), conf.getParameter<int>("Iterations"), batched));
   }
 
   if (mode == "FastLinear")
@@ -0,0 +1,116 @@
+// Compares the common mode noise subtraction with and without BatchedCommonModeNoise, on random digis
+// of all the modules with noises: the medians and the subtracted digis must be identical.
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripCommonModeNoiseSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/SiStripRawProcessingFactory.h"
+
+class SiStripBatchedCMNComparator : public edm::one::EDAnalyzer<> {
+public:
+  explicit SiStripBatchedCMNComparator(const edm::ParameterSet&);
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void analyze(const edm::Event&, const edm::EventSetup&) override;
+
+  template <typename T>
+  unsigned int compare(uint32_t detId, uint16_t firstAPV, const std::vector<T>& digis);
+
+  std::unique_ptr<SiStripCommonModeNoiseSubtractor> scalar_, batched_;
+  edm::ESGetToken<SiStripNoises, SiStripNoisesRcd> noisesToken_;
+};
+
+namespace {
+  edm::ParameterSet withBatched(edm::ParameterSet conf, bool batched) {
+    conf.addParameter<bool>("BatchedCommonModeNoise", batched);
+    return conf;
+  }
+}  // namespace
+
+SiStripBatchedCMNComparator::SiStripBatchedCMNComparator(const edm::ParameterSet& conf)
+    : scalar_(SiStripRawProcessingFactory::create_SubtractorCMN(
+          withBatched(conf.getParameter<edm::ParameterSet>("Algorithms"), false))),
+      batched_(SiStripRawProcessingFactory::create_SubtractorCMN(
+          withBatched(conf.getParameter<edm::ParameterSet>("Algorithms"), true))),
+      noisesToken_(esConsumes()) {}
+
+void SiStripBatchedCMNComparator::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription algorithms;
+  algorithms.add<std::string>("CommonModeNoiseSubtractionMode", "Median");
+  algorithms.add<double>("CutToAvoidSignal", 2.0);
+  algorithms.add<int>("Iterations", 3);
+  edm::ParameterSetDescription desc;
+  desc.add<edm::ParameterSetDescription>("Algorithms", algorithms);
+  descriptions.add("siStripBatchedCMNComparator", desc);
+}
+
+template <typename T>
+unsigned int SiStripBatchedCMNComparator::compare(uint32_t detId, uint16_t firstAPV, const std::vector<T>& digis) {
+  std::vector<T> scalarDigis(digis), batchedDigis(digis);
+  scalar_->subtract(detId, firstAPV, scalarDigis);
+  batched_->subtract(detId, firstAPV, batchedDigis);
+  if (scalarDigis != batchedDigis || scalar_->getAPVsCM() != batched_->getAPVsCM()) {
+    std::ostringstream medians;
+    for (unsigned int i = 0; i < std::min(scalar_->getAPVsCM().size(), batched_->getAPVsCM().size()); ++i)
+      medians << " " << scalar_->getAPVsCM()[i].second << "/" << batched_->getAPVsCM()[i].second;
+    throw cms::Exception("SiStripBatchedCMNComparator")
+        << "module " << detId << " from APV " << firstAPV << ": the batched subtraction differs, medians"
+        << medians.str();
+  }
+  return scalar_->getAPVsCM().size();
+}
+
+void SiStripBatchedCMNComparator::analyze(const edm::Event& e, const edm::EventSetup& es) {
+  scalar_->init(es);
+  batched_->init(es);
+
+  auto const& noises = es.getData(noisesToken_);
+  std::vector<uint32_t> detIds;
+  noises.getDetIds(detIds);
+
+  std::mt19937 rng(e.id().event());
+  std::uniform_real_distribution<float> flat(0.f, 1.f);
+  unsigned int nAPVs = 0;
+  for (auto detId : detIds) {
+    auto const range = noises.getRange(detId);
+    // 9 bits per strip
+    const uint16_t nStrips = (range.second - range.first) * 8 / 9;
+    // a common mode per APV, the noise of the strips, and a few signals over it
+    std::vector<int16_t> digis(nStrips);
+    for (uint16_t strip = 0; strip < nStrips; ++strip) {
+      const float cm = 128.f + 64.f * std::sin(float(strip / 128) + 0.1f * e.id().event());
+      float adc = cm + noises.getNoiseFast(strip, range) * 2.f * (flat(rng) - 0.5f);
+      if (flat(rng) < 0.05f)
+        adc += 200.f * flat(rng);
+      digis[strip] = std::clamp<int>(adc, 0, 1023);
+    }
+    nAPVs += compare(detId, 0, digis);
+    nAPVs += compare(detId, 0, std::vector<float>(digis.begin(), digis.end()));
+    // the second half of the module, as done for the hybrid format
+    const uint16_t half = nStrips / 256;
+    if (half > 0)
+      nAPVs += compare(detId, half, std::vector<int16_t>(digis.begin() + half * 128, digis.end()));
+  }
+  if (nAPVs == 0)
+    throw cms::Exception("SiStripBatchedCMNComparator") << "no APV compared";
+}
+
+DEFINE_FWK_MODULE(SiStripBatchedCMNComparator);
@@ -0,0 +1,89 @@
+#include "catch.hpp"
+#include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
+#include "CalibTracker/Records/interface/SiStripQualityRcd.h"
+#include "CalibTracker/SiStripCommon/interface/SiStripDetInfoFileReader.h"
+#include "CondFormats/DataRecord/interface/SiStripNoisesRcd.h"
+#include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/TestProcessor/interface/TestProcessor.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+static constexpr auto s_tag = "[SiStripBatchedCMN]";
+
+namespace {
+  std::string config(const std::string& mode) {
+    return R"_(from FWCore.TestProcessor.TestProcess import *
+process = TestProcess()
+process.toTest = cms.EDAnalyzer("SiStripBatchedCMNComparator",
+    Algorithms = cms.PSet(
+        CommonModeNoiseSubtractionMode = cms.string(")_" +
+           mode + R"_("),
+        CutToAvoidSignal = cms.double(2.0),
+        Iterations = cms.int32(3)
+    )
+)
+process.moduleToTest(process.toTest)
+)_";
+  }
+
+  // one module out of 20 with random noises, isolated bad strips, runs of bad strips and a few bad APVs
+  struct Conditions {
+    explicit Conditions(unsigned int seed) : noises(std::make_unique<SiStripNoises>()) {
+      SiStripDetInfoFileReader reader(edm::FileInPath("CalibTracker/SiStripCommon/data/SiStripDetInfo.dat").fullPath());
+      quality = std::make_unique<SiStripQuality>();
+      std::mt19937 rng(seed);
+      std::uniform_real_distribution<float> flat(0.f, 1.f);
+      auto const& detIds = reader.getAllDetIds();
+      for (unsigned int i = 0; i < detIds.size(); i += 20) {
+        const uint32_t detId = detIds[i];
+        const int nStrips = 128 * reader.getNumberOfApvsAndStripLength(detId).first;
+        SiStripNoises::InputVector noise;
+        for (int strip = 0; strip < nStrips; ++strip)
+          noises->setData(2.f + 6.f * flat(rng), noise);
+        noises->put(detId, noise);
+
+        std::vector<unsigned int> bad;
+        for (int strip = 0; strip < nStrips; ++strip) {
+          if (strip % 128 == 0 && flat(rng) < 0.05f) {
+            bad.push_back(quality->encode(strip, 128));
+            strip += 127;
+          } else if (flat(rng) < 0.02f) {
+            const int range = flat(rng) < 0.3f ? std::min(10, nStrips - strip) : 1;
+            bad.push_back(quality->encode(strip, range));
+            strip += range - 1;
+          }
+        }
+        if (!bad.empty())
+          quality->add(detId, SiStripBadStrip::Range(bad.begin(), bad.end()));
+      }
+      quality->cleanUp();
+      quality->fillBadComponents();
+    }
+
+    std::unique_ptr<SiStripNoises> noises;
+    std::unique_ptr<SiStripQuality> quality;
+  };
+}  // namespace
+
+TEST_CASE("SiStripBatchedCMNComparator", s_tag) {
+  for (auto mode : {"Median", "IteratedMedian"}) {
+    SECTION(mode) {
+      edm::test::TestProcessor::Config cfg{config(mode)};
+      auto noisesToken = cfg.esProduces<SiStripNoisesRcd, SiStripNoises>();
+      auto qualityToken = cfg.esProduces<SiStripQualityRcd, SiStripQuality>();
+      edm::test::TestProcessor tester(cfg);
+
+      // the comparator throws at the first module whose batched subtraction differs from the scalar one
+      for (unsigned int event = 1; event <= 3; ++event) {
+        Conditions conditions(event);
+        tester.setRunNumber(event);
+        REQUIRE_NOTHROW(tester.test(std::make_pair(noisesToken, std::move(conditions.noises)),
+                                    std::make_pair(qualityToken, std::move(conditions.quality))));
+      }
+    }
+  }
+}
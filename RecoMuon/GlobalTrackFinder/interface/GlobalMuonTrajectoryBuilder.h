@@ -48,5 +48,6 @@ private:
   edm::InputTag theTkTrackLabel;
   edm::EDGetTokenT<reco::TrackCollection> allTrackerTracksToken;
   edm::Handle<reco::TrackCollection> allTrackerTracks;
+  std::vector<TrackCand> allTrackerTrackCands;
 };
 #endif
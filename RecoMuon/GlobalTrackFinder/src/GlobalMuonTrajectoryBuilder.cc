@@ -80,6 +80,14 @@ void GlobalMuonTrajectoryBuilder::setEvent(const edm::Event& event) {
   // get tracker TrackCollection from Event
   event.getByToken(allTrackerTracksToken, allTrackerTracks);
   LogDebug(category) << " Found " << allTrackerTracks->size() << " tracker Tracks with label " << theTkTrackLabel;
+
+  // the tracker TrackCands are the same for all the STA candidates of the event
+  allTrackerTrackCands.clear();
+  allTrackerTrackCands.reserve(allTrackerTracks->size());
+  for (unsigned int position = 0; position != allTrackerTracks->size(); ++position) {
+    reco::TrackRef tkTrackRef(allTrackerTracks, position);
+    allTrackerTrackCands.emplace_back((Trajectory*)nullptr, tkTrackRef);
+  }
 }
 
 //
@@ -144,17 +152,7 @@ vector<GlobalMuonTrajectoryBuilder::TrackCand> GlobalMuonTrajectoryBuilder::make
     const TrackCand& staCand) {
   const std::string category = "Muon|RecoMuon|GlobalMuonTrajectoryBuilder|makeTkCandCollection";
 
-  vector<TrackCand> tkCandColl;
-
-  vector<TrackCand> tkTrackCands;
-
-  for (unsigned int position = 0; position != allTrackerTracks->size(); ++position) {
-    reco::TrackRef tkTrackRef(allTrackerTracks, position);
-    TrackCand tkCand = TrackCand((Trajectory*)nullptr, tkTrackRef);
-    tkTrackCands.push_back(tkCand);
-  }
-
-  tkCandColl = chooseRegionalTrackerTracks(staCand, tkTrackCands);
+  vector<TrackCand> tkCandColl = chooseRegionalTrackerTracks(staCand, allTrackerTrackCands);
 
   return tkCandColl;
 }
@@ -318,16 +318,18 @@ std::vector<GlobalTrajectoryBuilderBase::TrackCand> GlobalTrajectoryBuilderBase:
   std::vector<TrackCand> result;
 
   double deltaR_max = 1.0;
+  const double deltaR2_max = deltaR_max * deltaR_max;
+
+  // the direction of the region is the same for all the tracks
+  const double regionEta = regionOfInterest.direction().eta();
+  const double regionPhi = regionOfInterest.direction().phi();
 
   for (auto&& is : tkTs) {
-    double deltaR_tmp = deltaR(static_cast<double>(regionOfInterest.direction().eta()),
-                               static_cast<double>(regionOfInterest.direction().phi()),
-                               is.second->eta(),
-                               is.second->phi());
+    double deltaR2_tmp = deltaR2(regionEta, regionPhi, is.second->eta(), is.second->phi());
 
     // for each trackCand in region, add trajectory and add to result
     //if ( inEtaRange && inPhiRange ) {
-    if (deltaR_tmp < deltaR_max) {
+    if (deltaR2_tmp < deltaR2_max) {
       TrackCand tmpCand = TrackCand(is);
       result.push_back(tmpCand);
     }
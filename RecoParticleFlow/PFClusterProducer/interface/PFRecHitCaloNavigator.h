@@ -1,6 +1,8 @@
 #ifndef RecoParticleFlow_PFClusterProducer_PFRecHitCaloNavigator_h
 #define RecoParticleFlow_PFClusterProducer_PFRecHitCaloNavigator_h
 
+#include <array>
+
 #include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitNavigatorBase.h"
 #include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloGeometry.h"
@@ -28,72 +30,62 @@ public:
     }
   }
 
-  void associateNeighbours(reco::PFRecHit& hit,
-                           std::unique_ptr<reco::PFRecHitCollection>& hits,
-                           edm::RefProd<reco::PFRecHitCollection>& refProd) override {
-    DetId detid(hit.detId());
+  // the (eta, phi) of the neighbours, in the order of neighbours()
+  static constexpr short neighbourEta[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+  static constexpr short neighbourPhi[8] = {1, 1, -1, -1, 0, -1, 0, 1};
 
-    CaloNavigator<DET> navigator(detid, topology_.get());
+  // N, NE, S, SW, E, SE, W, NW; DetId(0) for those not found
+  static std::array<DetId, 8> neighbours(const DetId& detid, const TOPO* topology) {
+    CaloNavigator<DET> navigator(detid, topology);
+    std::array<DetId, 8> ids;
 
-    DetId N(0);
-    DetId E(0);
-    DetId S(0);
-    DetId W(0);
-    DetId NW(0);
-    DetId NE(0);
-    DetId SW(0);
-    DetId SE(0);
-
-    N = navigator.north();
-    associateNeighbour(N, hit, hits, refProd, 0, 1, 0);
-
-    if (N != DetId(0)) {
-      NE = navigator.east();
+    ids[0] = navigator.north();
+    if (ids[0] != DetId(0)) {
+      ids[1] = navigator.east();
     } else {
       navigator.home();
-      E = navigator.east();
-      NE = navigator.north();
+      navigator.east();
+      ids[1] = navigator.north();
     }
-    associateNeighbour(NE, hit, hits, refProd, 1, 1, 0);
     navigator.home();
 
-    S = navigator.south();
-    associateNeighbour(S, hit, hits, refProd, 0, -1, 0);
-
-    if (S != DetId(0)) {
-      SW = navigator.west();
+    ids[2] = navigator.south();
+    if (ids[2] != DetId(0)) {
+      ids[3] = navigator.west();
     } else {
       navigator.home();
-      W = navigator.west();
-      SW = navigator.south();
+      navigator.west();
+      ids[3] = navigator.south();
     }
-    associateNeighbour(SW, hit, hits, refProd, -1, -1, 0);
     navigator.home();
 
-    E = navigator.east();
-    associateNeighbour(E, hit, hits, refProd, 1, 0, 0);
-
-    if (E != DetId(0)) {
-      SE = navigator.south();
+    ids[4] = navigator.east();
+    if (ids[4] != DetId(0)) {
+      ids[5] = navigator.south();
     } else {
       navigator.home();
-      S = navigator.south();
-      SE = navigator.east();
+      navigator.south();
+      ids[5] = navigator.east();
     }
-    associateNeighbour(SE, hit, hits, refProd, 1, -1, 0);
     navigator.home();
 
-    W = navigator.west();
-    associateNeighbour(W, hit, hits, refProd, -1, 0, 0);
-
-    if (W != DetId(0)) {
-      NW = navigator.north();
+    ids[6] = navigator.west();
+    if (ids[6] != DetId(0)) {
+      ids[7] = navigator.north();
     } else {
       navigator.home();
-      N = navigator.north();
-      NW = navigator.west();
+      navigator.north();
+      ids[7] = navigator.west();
     }
-    associateNeighbour(NW, hit, hits, refProd, -1, 1, 0);
+    return ids;
+  }
+
+  void associateNeighbours(reco::PFRecHit& hit,
+                           std::unique_ptr<reco::PFRecHitCollection>& hits,
+                           edm::RefProd<reco::PFRecHitCollection>& refProd) override {
+    auto const ids = neighbours(DetId(hit.detId()), topology_.get());
+    for (unsigned int k = 0; k < ids.size(); ++k)
+      associateNeighbour(ids[k], hit, hits, refProd, neighbourEta[k], neighbourPhi[k], 0);
   }
 
 protected:
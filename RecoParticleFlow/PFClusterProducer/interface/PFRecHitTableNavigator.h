@@ -0,0 +1,88 @@
+#ifndef RecoParticleFlow_PFClusterProducer_PFRecHitTableNavigator_h
+#define RecoParticleFlow_PFClusterProducer_PFRecHitTableNavigator_h
+
+#include <array>
+#include <vector>
+
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitCaloNavigator.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitNavigatorBase.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopology.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopologyRecord.h"
+
+// The neighbours of PFRecHitCaloNavigator for the rechits of the ECAL barrel, the ECAL
+// endcap and the HCAL, looked up in the tables of PFRecHitTopology: the rechits of an
+// event are indexed by their dense index, and their neighbours found without search.
+class PFRecHitTableNavigator final : public PFRecHitNavigatorBase {
+public:
+  PFRecHitTableNavigator(const edm::ParameterSet& iConfig) {}
+
+  void beginEvent(const edm::EventSetup& iSetup) override {
+    edm::ESHandle<PFRecHitTopology> topology;
+    iSetup.get<PFRecHitTopologyRecord>().get(topology);
+    topology_ = topology.product();
+    // the cells are left without rechits at the end of each event
+    for (unsigned int d = 0; d < PFRecHitTopology::kNDetectors; ++d)
+      hitOfCell_[d].resize(topology_->size(PFRecHitTopology::Detector(d)), -1);
+  }
+
+  void associateNeighbours(reco::PFRecHit& hit,
+                           std::unique_ptr<reco::PFRecHitCollection>& hits,
+                           edm::RefProd<reco::PFRecHitCollection>& refProd) override {
+    PFRecHitTopology::Detector detector;
+    uint32_t index;
+    if (!topology_->denseIndex(DetId(hit.detId()), detector, index))
+      return;
+    for (unsigned int k = 0; k < PFRecHitTopology::kNNeighbours; ++k) {
+      uint32_t const neighbour = topology_->neighbour(detector, index, k);
+      if (neighbour != PFRecHitTopology::kInvalid)
+        associateNeighbour(topology_->detId(detector, neighbour), hit, hits, refProd, eta(k), phi(k), 0);
+    }
+  }
+
+  void associateAllNeighbours(std::unique_ptr<reco::PFRecHitCollection>& hits,
+                              edm::RefProd<reco::PFRecHitCollection>& refProd) override {
+    cells_.resize(hits->size());
+    for (unsigned int i = 0; i < hits->size(); ++i) {
+      auto& cell = cells_[i];
+      cell.valid = topology_->denseIndex(DetId((*hits)[i].detId()), cell.detector, cell.index);
+      if (cell.valid)
+        hitOfCell_[cell.detector][cell.index] = i;
+    }
+
+    for (unsigned int i = 0; i < hits->size(); ++i) {
+      auto const& cell = cells_[i];
+      if (!cell.valid)
+        continue;
+      auto& hit = (*hits)[i];
+      auto const& hitOfCell = hitOfCell_[cell.detector];
+      for (unsigned int k = 0; k < PFRecHitTopology::kNNeighbours; ++k) {
+        uint32_t const neighbour = topology_->neighbour(cell.detector, cell.index, k);
+        if (neighbour != PFRecHitTopology::kInvalid && hitOfCell[neighbour] >= 0)
+          hit.addNeighbour(eta(k), phi(k), 0, hitOfCell[neighbour]);
+      }
+    }
+
+    // only the cells of the rechits of the event are reset
+    for (auto const& cell : cells_) {
+      if (cell.valid)
+        hitOfCell_[cell.detector][cell.index] = -1;
+    }
+  }
+
+private:
+  // the order of the tables is the same for all the detectors
+  static short eta(unsigned int k) { return PFRecHitCaloNavigator<EBDetId, EcalBarrelTopology>::neighbourEta[k]; }
+  static short phi(unsigned int k) { return PFRecHitCaloNavigator<EBDetId, EcalBarrelTopology>::neighbourPhi[k]; }
+
+  struct Cell {
+    bool valid;
+    PFRecHitTopology::Detector detector;
+    uint32_t index;
+  };
+
+  const PFRecHitTopology* topology_ = nullptr;
+  std::array<std::vector<int>, PFRecHitTopology::kNDetectors> hitOfCell_;
+  std::vector<Cell> cells_;
+};
+
+#endif
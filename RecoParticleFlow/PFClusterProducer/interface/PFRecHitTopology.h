@@ -0,0 +1,46 @@
+#ifndef RecoParticleFlow_PFClusterProducer_PFRecHitTopology_h
+#define RecoParticleFlow_PFClusterProducer_PFRecHitTopology_h
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "DataFormats/DetId/interface/DetId.h"
+
+class HcalTopology;
+
+/** The neighbours of the cells of the ECAL barrel, the ECAL endcap and the
+ *  HCAL found by PFRecHitCaloNavigator, in flat tables indexed by the dense
+ *  index of the cells in their detector: built once per geometry by
+ *  PFRecHitTopologyESProducer, for PFRecHitTableNavigator to find the
+ *  neighbours of the rechits by lookup rather than through the topologies.
+ */
+class PFRecHitTopology {
+public:
+  enum Detector { kEcalBarrel = 0, kEcalEndcap, kHcal, kNDetectors };
+  static constexpr unsigned int kNNeighbours = 8;
+  static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+  // the HCAL dense indices are those of the topology, which must outlive this
+  explicit PFRecHitTopology(const HcalTopology* hcalTopology);
+
+  // the detector of a cell and its dense index in it, false if it is in no table
+  bool denseIndex(const DetId& id, Detector& detector, uint32_t& index) const;
+  DetId detId(Detector detector, uint32_t index) const;
+
+  uint32_t size(Detector detector) const { return neighbours_[detector].size() / kNNeighbours; }
+
+  // the dense index of the k-th neighbour of a cell in the order of PFRecHitCaloNavigator::neighbours,
+  // kInvalid if there is none in the same detector
+  uint32_t neighbour(Detector detector, uint32_t index, unsigned int k) const {
+    return neighbours_[detector][index * kNNeighbours + k];
+  }
+
+  void setNeighbours(Detector detector, uint32_t index, const std::array<DetId, kNNeighbours>& ids);
+
+private:
+  const HcalTopology* hcalTopology_;
+  std::array<std::vector<uint32_t>, kNDetectors> neighbours_;
+};
+
+#endif
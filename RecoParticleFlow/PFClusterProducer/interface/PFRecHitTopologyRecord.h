@@ -0,0 +1,14 @@
+#ifndef RecoParticleFlow_PFClusterProducer_PFRecHitTopologyRecord_h
+#define RecoParticleFlow_PFClusterProducer_PFRecHitTopologyRecord_h
+
+#include "boost/mpl/vector.hpp"
+#include "FWCore/Framework/interface/DependentRecordImplementation.h"
+#include "Geometry/Records/interface/CaloGeometryRecord.h"
+#include "Geometry/Records/interface/HcalRecNumberingRecord.h"
+
+class PFRecHitTopologyRecord
+    : public edm::eventsetup::DependentRecordImplementation<
+          PFRecHitTopologyRecord,
+          boost::mpl::vector<CaloGeometryRecord, HcalRecNumberingRecord> > {};
+
+#endif
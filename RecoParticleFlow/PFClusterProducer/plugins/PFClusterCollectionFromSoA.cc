@@ -0,0 +1,72 @@
+#include <memory>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
+#include "DataFormats/ParticleFlowReco/interface/PFCluster.h"
+#include "DataFormats/ParticleFlowReco/interface/PFClusterFwd.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHit.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHitFwd.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHitFraction.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+/**
+ * Converts the clusters of a PFClusterSoA to a reco::PFClusterCollection,
+ * with the fractions referring to the rechits the clusters were made of.
+ * The clusters are ordered by topological cluster and then by seed, not as
+ * those of PFClusterProducer, and no energy correction is applied.
+ */
+class PFClusterCollectionFromSoA : public edm::global::EDProducer<> {
+public:
+  explicit PFClusterCollectionFromSoA(const edm::ParameterSet& iConfig);
+  ~PFClusterCollectionFromSoA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<PFClusterSoA> clusterGetToken_;
+  const edm::EDGetTokenT<reco::PFRecHitCollection> recHitGetToken_;
+  const edm::EDPutTokenT<reco::PFClusterCollection> clusterPutToken_;
+};
+
+PFClusterCollectionFromSoA::PFClusterCollectionFromSoA(const edm::ParameterSet& iConfig)
+    : clusterGetToken_(consumes<PFClusterSoA>(iConfig.getParameter<edm::InputTag>("src"))),
+      recHitGetToken_(consumes<reco::PFRecHitCollection>(iConfig.getParameter<edm::InputTag>("recHitsSource"))),
+      clusterPutToken_(produces<reco::PFClusterCollection>()) {}
+
+void PFClusterCollectionFromSoA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("pfClusterSoAFromCUDA"));
+  desc.add<edm::InputTag>("recHitsSource", edm::InputTag("particleFlowRecHitHBHE"));
+  descriptions.add("pfClusterCollectionFromSoA", desc);
+}
+
+void PFClusterCollectionFromSoA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  auto const& soa = iEvent.get(clusterGetToken_);
+  auto const recHits = iEvent.getHandle(recHitGetToken_);
+
+  reco::PFClusterCollection clusters;
+  clusters.reserve(soa.nClusters());
+  for (uint32_t c = 0; c < soa.nClusters(); ++c) {
+    auto& cluster = clusters.emplace_back(PFLayer::Layer(soa.layer[c]), soa.energy[c], soa.x[c], soa.y[c], soa.z[c]);
+    cluster.setSeed((*recHits)[soa.seedHit[c]].detId());
+    cluster.setDepth(soa.depth[c]);
+    cluster.setTime(soa.time[c]);
+    cluster.calculatePositionREP();
+  }
+  // the fractions of a cluster are contiguous, by rechit
+  for (uint32_t f = 0; f < soa.nFractions(); ++f) {
+    clusters[soa.fracCluster[f]].addRecHitFraction(
+        reco::PFRecHitFraction(reco::PFRecHitRef(recHits, soa.fracHit[f]), soa.fraction[f]));
+  }
+
+  iEvent.emplace(clusterPutToken_, std::move(clusters));
+}
+
+DEFINE_FWK_MODULE(PFClusterCollectionFromSoA);
@@ -0,0 +1,60 @@
+#include <memory>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitSoA.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHitFwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "PFClusteringOnCPU.h"
+#include "PFClusteringParams.h"
+#include "PFRecHitSoAFromLegacy.h"
+
+/**
+ * Clusters the particle flow rechits of the ECAL or the HCAL on the host,
+ * with the same steps and parameters as PFClusterProducerCUDA.
+ */
+class PFClusterProducerSoA : public edm::stream::EDProducer<> {
+public:
+  explicit PFClusterProducerSoA(const edm::ParameterSet& iConfig);
+  ~PFClusterProducerSoA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  const edm::EDGetTokenT<reco::PFRecHitCollection> recHitGetToken_;
+  const edm::EDPutTokenT<PFClusterSoA> clusterPutToken_;
+
+  const pfClustering::Params params_;
+  std::unique_ptr<PFRecHitSoA> recHits_;
+  PFClusteringOnCPU clustering_;
+};
+
+PFClusterProducerSoA::PFClusterProducerSoA(const edm::ParameterSet& iConfig)
+    : recHitGetToken_(consumes<reco::PFRecHitCollection>(iConfig.getParameter<edm::InputTag>("recHitsSource"))),
+      clusterPutToken_(produces<PFClusterSoA>()),
+      params_(pfClustering::makeParams(iConfig)),
+      recHits_(std::make_unique<PFRecHitSoA>()) {}
+
+void PFClusterProducerSoA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("recHitsSource", edm::InputTag("particleFlowRecHitHBHE"));
+  pfClustering::fillParamsDescription(desc);
+  descriptions.add("pfClusterProducerSoA", desc);
+}
+
+void PFClusterProducerSoA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  pfClustering::fillRecHitSoA(iEvent.get(recHitGetToken_), *recHits_);
+  auto output = std::make_unique<PFClusterSoA>();
+  clustering_.makeClusters(*recHits_, params_, *output);
+  iEvent.put(clusterPutToken_, std::move(output));
+}
+
+DEFINE_FWK_MODULE(PFClusterProducerSoA);
@@ -0,0 +1,482 @@
+#ifndef RecoParticleFlow_PFClusterProducer_plugins_PFClusteringAlgos_h
+#define RecoParticleFlow_PFClusterProducer_plugins_PFClusteringAlgos_h
+
+#include <cmath>
+#include <cstdint>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitSoA.h"
+#include "DataFormats/ParticleFlowReco/interface/PFLayer.h"
+
+#if defined(__CUDACC__)
+#define PF_HOST_DEVICE __host__ __device__
+#else
+#define PF_HOST_DEVICE
+#endif
+
+// The steps of the particle flow clustering of the ECAL and HCAL (HB, HE) rechits,
+// shared by the CUDA kernels and the CPU implementation. Each step loops over its
+// elements from first with the given stride, and the steps run in this order, each
+// one after all the threads of the previous one are done:
+//   initRecHits, propagateTopo (until no topoId changes), countTopo, scanTopo,
+//   fillTopo, sortTopo, fitTopo
+//
+// The seeds are the local maxima of LocalMaximumSeedFinder, the topological clusters
+// the connected rechits above the gathering thresholds of Basic2DGenericTopoClusterizer,
+// found by propagating the smallest rechit index through the neighbours. The clusters
+// of each topological cluster are fitted by one thread, with the Gaussian shower
+// mixture of Basic2DGenericPFlowClusterizer and the logarithmic weights of
+// Basic2DGenericPFlowPositionCalc, without time resolution.
+namespace pfClustering {
+
+  // EB, EE, HB, HE, and the depths of the HCAL
+  constexpr uint32_t nDetectors = 4;
+  constexpr uint32_t maxDepth = 7;
+  constexpr uint32_t nThresholds = nDetectors * maxDepth;
+
+  // the rechits beyond it are too far from a cluster to have a fraction of it
+  constexpr float maxDistance2 = 100.f;
+
+  struct Workspace {
+    uint32_t* topoHitOffsets;       // maxRecHits + 1, by index of the topological cluster
+    uint32_t* topoSeedOffsets;      // maxRecHits + 1, these are also the cluster indices
+    uint32_t* topoFractionOffsets;  // maxRecHits + 1
+    uint32_t* topoHitFill;          // maxRecHits
+    uint32_t* topoSeedFill;         // maxRecHits
+    uint32_t* topoHits;             // maxRecHits
+    uint32_t* topoSeeds;            // maxRecHits
+    float* fractions;               // maxFractions, for each cluster those of the rechits of its topological cluster
+    float* clusterEta;              // maxClusters
+    float* clusterPhi;              // maxClusters
+    uint32_t* changed;              // by propagateTopo
+    PFClusterSoA* clusters;
+  };
+
+  // the thresholds are indexed by thresholdIndex()
+  struct Params {
+    float seedingThreshold[nThresholds];        // GeV
+    float seedingThresholdPt2[nThresholds];     // GeV^2
+    float gatheringThreshold[nThresholds];      // GeV
+    float gatheringThresholdPt2[nThresholds];   // GeV^2
+    float recHitEnergyNormInv[nThresholds];     // 1/GeV
+    float logWeightDenominatorInv[nThresholds];  // 1/GeV
+    uint32_t nSeedNeighbours;                   // 0, 4 or 8
+    bool useCornerCells;                        // in the topological clusters
+    float showerSigma2;                         // cm^2
+    uint32_t maxIterations;
+    float stoppingTolerance;
+    bool excludeOtherSeeds;
+    float minFracTot;
+    float minFractionToKeep;
+    float minFractionInCalc;
+    float minAllowedNormalization;
+    uint32_t posCalcNCrystals;  // 5, 9, or 0 for all the rechits
+    bool allCellsPosCalc;       // all the rechits for the topological clusters of a single seed
+  };
+
+  // on the host the steps run on a single thread
+  PF_HOST_DEVICE inline uint32_t atomicIncrement(uint32_t* counter) {
+#if defined(__CUDA_ARCH__)
+    return atomicAdd(counter, 1u);
+#else
+    return (*counter)++;
+#endif
+  }
+
+  PF_HOST_DEVICE inline uint32_t atomicAddCount(uint32_t* counter, uint32_t n) {
+#if defined(__CUDA_ARCH__)
+    return atomicAdd(counter, n);
+#else
+    uint32_t const old = *counter;
+    *counter += n;
+    return old;
+#endif
+  }
+
+  PF_HOST_DEVICE inline void atomicMinIndex(int32_t* index, int32_t value) {
+#if defined(__CUDA_ARCH__)
+    atomicMin(index, value);
+#else
+    if (value < *index)
+      *index = value;
+#endif
+  }
+
+  // -1 for the rechits of the other layers, which are not clustered
+  PF_HOST_DEVICE inline int32_t thresholdIndex(int8_t layer, int8_t depth) {
+    switch (layer) {
+      case PFLayer::ECAL_BARREL:
+        return 0;
+      case PFLayer::ECAL_ENDCAP:
+        return maxDepth;
+      case PFLayer::HCAL_BARREL1:
+        return depth >= 1 && depth <= int(maxDepth) ? 2 * maxDepth + depth - 1 : -1;
+      case PFLayer::HCAL_ENDCAP:
+        return depth >= 1 && depth <= int(maxDepth) ? 3 * maxDepth + depth - 1 : -1;
+      default:
+        return -1;
+    }
+  }
+
+  PF_HOST_DEVICE inline float pt2(PFRecHitSoA const& rh, uint32_t i) {
+    float const perp2 = rh.x[i] * rh.x[i] + rh.y[i] * rh.y[i];
+    float const mag2 = perp2 + rh.z[i] * rh.z[i];
+    return mag2 > 0 ? rh.energy[i] * rh.energy[i] * perp2 / mag2 : 0.f;
+  }
+
+  PF_HOST_DEVICE inline bool aboveThresholds(
+      PFRecHitSoA const& rh, uint32_t i, float const* thresholdE, float const* thresholdPt2) {
+    int32_t const t = thresholdIndex(rh.layer[i], rh.depth[i]);
+    return t >= 0 && rh.energy[i] >= thresholdE[t] && pt2(rh, i) >= thresholdPt2[t];
+  }
+
+  // the first rechit of the topological cluster
+  PF_HOST_DEVICE inline bool isTopoRoot(Workspace const& ws, uint32_t i) {
+    return ws.clusters->hitTopoId[i] == int32_t(i);
+  }
+
+  // The seeds, and the rechits above the gathering thresholds as topological clusters of
+  // their own: a seed is not below a neighbour, the ties going to the first rechit.
+  PF_HOST_DEVICE inline void initRecHits(
+      PFRecHitSoA const& rh, Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = rh.nRecHits();
+    for (uint32_t i = first; i < n; i += stride) {
+      bool const gathered = aboveThresholds(rh, i, params.gatheringThreshold, params.gatheringThresholdPt2);
+      bool seed = aboveThresholds(rh, i, params.seedingThreshold, params.seedingThresholdPt2);
+      uint32_t const nNeighbours = params.nSeedNeighbours == 8   ? rh.nNeighbours8[i]
+                                   : params.nSeedNeighbours == 4 ? rh.nNeighbours4[i]
+                                                                 : 0;
+      for (uint32_t k = 0; seed && k < nNeighbours; ++k) {
+        uint32_t const j = rh.neighbours[i][k];
+        if (rh.energy[j] > rh.energy[i] ||
+            (rh.energy[j] == rh.energy[i] && j < i &&
+             aboveThresholds(rh, j, params.seedingThreshold, params.seedingThresholdPt2)))
+          seed = false;
+      }
+      // the seeds below the gathering thresholds do not start a topological cluster
+      ws.clusters->isSeed[i] = seed && gathered;
+      ws.clusters->hitTopoId[i] = gathered ? int32_t(i) : -1;
+    }
+  }
+
+  // One pass of the propagation of the smallest index through the neighbours, jumping to
+  // the topological cluster of the topological cluster when it is smaller.
+  PF_HOST_DEVICE inline void propagateTopo(
+      PFRecHitSoA const& rh, Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = rh.nRecHits();
+    int32_t* topoId = ws.clusters->hitTopoId;
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t const current = topoId[i];
+      if (current < 0)
+        continue;
+      int32_t smallest = current;
+      uint32_t const nNeighbours = params.useCornerCells ? rh.nNeighbours8[i] : rh.nNeighbours4[i];
+      for (uint32_t k = 0; k < nNeighbours; ++k) {
+        int32_t const other = topoId[rh.neighbours[i][k]];
+        if (other >= 0 && other < smallest)
+          smallest = other;
+      }
+      int32_t const jump = topoId[smallest];
+      if (jump >= 0 && jump < smallest)
+        smallest = jump;
+      if (smallest < current) {
+        atomicMinIndex(&topoId[i], smallest);
+        *ws.changed = 1;
+      }
+    }
+  }
+
+  PF_HOST_DEVICE inline void countTopo(PFRecHitSoA const& rh, Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = rh.nRecHits();
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t const t = ws.clusters->hitTopoId[i];
+      if (t < 0)
+        continue;
+      atomicIncrement(&ws.topoHitOffsets[t + 1]);
+      if (ws.clusters->isSeed[i])
+        atomicIncrement(&ws.topoSeedOffsets[t + 1]);
+    }
+  }
+
+  // By a single thread: the offsets of the rechits, clusters and fractions of the
+  // topological clusters. Those with no seed have no clusters, and those whose
+  // clusters or fractions do not fit are dropped.
+  PF_HOST_DEVICE inline void scanTopo(PFRecHitSoA const& rh, Workspace ws) {
+    uint32_t const n = rh.nRecHits();
+    auto& clusters = *ws.clusters;
+    ws.topoHitOffsets[0] = 0;
+    ws.topoSeedOffsets[0] = 0;
+    ws.topoFractionOffsets[0] = 0;
+    for (uint32_t t = 0; t < n; ++t) {
+      uint32_t const nHits = ws.topoHitOffsets[t + 1];
+      uint32_t nSeeds = ws.topoSeedOffsets[t + 1];
+      clusters.nFound += nSeeds;
+      if (clusters.nStored + nSeeds > PFClusterSoA::maxClusters ||
+          ws.topoFractionOffsets[t] + nHits * nSeeds > PFClusterSoA::maxFractions)
+        nSeeds = 0;
+      clusters.nStored += nSeeds;
+      ws.topoHitOffsets[t + 1] = ws.topoHitOffsets[t] + nHits;
+      ws.topoSeedOffsets[t + 1] = ws.topoSeedOffsets[t] + nSeeds;
+      ws.topoFractionOffsets[t + 1] = ws.topoFractionOffsets[t] + nHits * nSeeds;
+      ws.topoHitFill[t] = ws.topoHitOffsets[t];
+      ws.topoSeedFill[t] = ws.topoSeedOffsets[t];
+    }
+  }
+
+  PF_HOST_DEVICE inline void fillTopo(PFRecHitSoA const& rh, Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = rh.nRecHits();
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t const t = ws.clusters->hitTopoId[i];
+      if (t < 0)
+        continue;
+      ws.topoHits[atomicIncrement(&ws.topoHitFill[t])] = i;
+      if (ws.clusters->isSeed[i] && ws.topoSeedOffsets[t + 1] > ws.topoSeedOffsets[t])
+        ws.topoSeeds[atomicIncrement(&ws.topoSeedFill[t])] = i;
+    }
+  }
+
+  PF_HOST_DEVICE inline void insertionSort(uint32_t* begin, uint32_t* end) {
+    for (uint32_t* p = begin + 1; p < end; ++p) {
+      uint32_t const value = *p;
+      uint32_t* q = p;
+      for (; q > begin && *(q - 1) > value; --q)
+        *q = *(q - 1);
+      *q = value;
+    }
+  }
+
+  // The rechits and seeds of each topological cluster by index, so that the fit does not
+  // depend on the order of the threads. The rechits of the topological clusters without
+  // clusters leave them.
+  PF_HOST_DEVICE inline void sortTopo(PFRecHitSoA const& rh, Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = rh.nRecHits();
+    for (uint32_t t = first; t < n; t += stride) {
+      if (!isTopoRoot(ws, t))
+        continue;
+      uint32_t* hits = ws.topoHits + ws.topoHitOffsets[t];
+      uint32_t* hitsEnd = ws.topoHits + ws.topoHitOffsets[t + 1];
+      if (ws.topoSeedOffsets[t + 1] == ws.topoSeedOffsets[t]) {
+        for (uint32_t* p = hits; p < hitsEnd; ++p)
+          ws.clusters->hitTopoId[*p] = -1;
+        continue;
+      }
+      insertionSort(hits, hitsEnd);
+      insertionSort(ws.topoSeeds + ws.topoSeedOffsets[t], ws.topoSeeds + ws.topoSeedOffsets[t + 1]);
+    }
+  }
+
+  // the position of a rechit in the sorted rechits of its topological cluster, nHits if it is not there
+  PF_HOST_DEVICE inline uint32_t findHit(uint32_t const* hits, uint32_t nHits, uint32_t hit) {
+    uint32_t low = 0, high = nHits;
+    while (low < high) {
+      uint32_t const mid = (low + high) / 2;
+      if (hits[mid] < hit)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+    return low < nHits && hits[low] == hit ? low : nHits;
+  }
+
+  PF_HOST_DEVICE inline float deltaPhi(float phi1, float phi2) {
+    float dphi = phi1 - phi2;
+    constexpr float pi = M_PI;
+    while (dphi > pi)
+      dphi -= 2.f * pi;
+    while (dphi <= -pi)
+      dphi += 2.f * pi;
+    return dphi;
+  }
+
+  // The energy, time, layer and position of cluster c from the fractions of the rechits of
+  // its topological cluster, as Basic2DGenericPFlowPositionCalc with posCalcNCrystals,
+  // or with all the rechits.
+  PF_HOST_DEVICE inline void computeCluster(PFRecHitSoA const& rh,
+                                            Workspace const& ws,
+                                            Params const& params,
+                                            uint32_t const* hits,
+                                            uint32_t nHits,
+                                            float const* fractions,
+                                            uint32_t c,
+                                            bool allCells) {
+    auto& clusters = *ws.clusters;
+    float energy = 0, time = 0, timeWeight = 0, maxEnergy = 0;
+    int8_t layer = PFLayer::NONE;
+    for (uint32_t j = 0; j < nHits; ++j) {
+      float const e = rh.energy[hits[j]];
+      float const f = fractions[j];
+      energy += e * f;
+      timeWeight += e * e * f;
+      time += e * e * f * rh.time[hits[j]];
+      if (e * f > maxEnergy) {
+        maxEnergy = e * f;
+        layer = rh.layer[hits[j]];
+      }
+    }
+    clusters.energy[c] = energy;
+    clusters.time[c] = timeWeight > 0 ? time / timeWeight : 0.f;
+    clusters.layer[c] = layer;
+
+    float x = 0, y = 0, z = 0, depth = 0, norm = 0;
+    auto add = [&](uint32_t j) {
+      uint32_t const i = hits[j];
+      float const f = fractions[j];
+      float w = 0;
+      if (f >= params.minFractionInCalc) {
+        int32_t const t = thresholdIndex(rh.layer[i], rh.depth[i]);
+        w = std::log(rh.energy[i] * f * params.logWeightDenominatorInv[t]);
+        w = w > 0 ? w : 0.f;
+      }
+      x += rh.x[i] * w;
+      y += rh.y[i] * w;
+      z += rh.z[i] * w;
+      depth += rh.depth[i] * w;
+      norm += w;
+    };
+    uint32_t const seed = clusters.seedHit[c];
+    if (allCells || params.posCalcNCrystals == 0) {
+      for (uint32_t j = 0; j < nHits; ++j)
+        add(j);
+    } else {
+      add(findHit(hits, nHits, seed));
+      uint32_t const nNeighbours = params.posCalcNCrystals == 9 ? rh.nNeighbours8[seed] : rh.nNeighbours4[seed];
+      for (uint32_t k = 0; k < nNeighbours; ++k) {
+        uint32_t const j = findHit(hits, nHits, rh.neighbours[seed][k]);
+        if (j < nHits)
+          add(j);
+      }
+    }
+    if (norm < params.minAllowedNormalization) {
+      clusters.x[c] = clusters.y[c] = clusters.z[c] = 0;
+      clusters.depth[c] = 0;
+    } else {
+      clusters.x[c] = x / norm;
+      clusters.y[c] = y / norm;
+      clusters.z[c] = z / norm;
+      clusters.depth[c] = depth / norm;
+    }
+  }
+
+  PF_HOST_DEVICE inline void etaPhi(PFClusterSoA const& clusters, uint32_t c, float& eta, float& phi) {
+    float const rho = std::sqrt(clusters.x[c] * clusters.x[c] + clusters.y[c] * clusters.y[c]);
+    eta = rho > 0 ? std::asinh(clusters.z[c] / rho) : 0.f;
+    phi = std::atan2(clusters.y[c], clusters.x[c]);
+  }
+
+  // The clusters of each topological cluster, starting from their seeds: the fractions of
+  // the rechits are those of Gaussian showers of the cluster energies, iterated until the
+  // clusters move by less than the stopping tolerance in (eta, phi). The fractions are
+  // stored by cluster and then by rechit, on one thread.
+  PF_HOST_DEVICE inline void fitTopo(
+      PFRecHitSoA const& rh, Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = rh.nRecHits();
+    auto& clusters = *ws.clusters;
+    for (uint32_t t = first; t < n; t += stride) {
+      if (!isTopoRoot(ws, t))
+        continue;
+      uint32_t const firstCluster = ws.topoSeedOffsets[t];
+      uint32_t const nSeeds = ws.topoSeedOffsets[t + 1] - firstCluster;
+      if (nSeeds == 0)
+        continue;
+      uint32_t const* hits = ws.topoHits + ws.topoHitOffsets[t];
+      uint32_t const nHits = ws.topoHitOffsets[t + 1] - ws.topoHitOffsets[t];
+      float* fractions = ws.fractions + ws.topoFractionOffsets[t];
+      bool const allCells = nSeeds == 1 && params.allCellsPosCalc;
+
+      for (uint32_t k = 0; k < nSeeds; ++k) {
+        uint32_t const c = firstCluster + k;
+        uint32_t const seed = ws.topoSeeds[c];
+        clusters.seedHit[c] = seed;
+        clusters.topoId[c] = t;
+        for (uint32_t j = 0; j < nHits; ++j)
+          fractions[k * nHits + j] = hits[j] == seed ? 1.f : 0.f;
+        computeCluster(rh, ws, params, hits, nHits, fractions + k * nHits, c, false);
+      }
+
+      float const toleranceScaling = nSeeds > 2 ? float((nSeeds - 1) * (nSeeds - 1)) : 1.f;
+      float diff = toleranceScaling;
+      for (uint32_t iter = 0; iter < params.maxIterations && diff > params.stoppingTolerance * toleranceScaling;
+           ++iter) {
+        for (uint32_t k = 0; k < nSeeds; ++k)
+          etaPhi(clusters, firstCluster + k, ws.clusterEta[firstCluster + k], ws.clusterPhi[firstCluster + k]);
+
+        for (uint32_t j = 0; j < nHits; ++j) {
+          uint32_t const i = hits[j];
+          int32_t const th = thresholdIndex(rh.layer[i], rh.depth[i]);
+          float fracTot = 0;
+          for (uint32_t k = 0; k < nSeeds; ++k) {
+            uint32_t const c = firstCluster + k;
+            float fraction;
+            if (params.excludeOtherSeeds && i == clusters.seedHit[c]) {
+              fraction = 1.f;
+            } else if (params.excludeOtherSeeds && clusters.isSeed[i]) {
+              fraction = 0.f;
+            } else {
+              float const dx = clusters.x[c] - rh.x[i];
+              float const dy = clusters.y[c] - rh.y[i];
+              float const dz = clusters.z[c] - rh.z[i];
+              float const d2 = (dx * dx + dy * dy + dz * dz) / params.showerSigma2;
+              fraction = clusters.energy[c] * params.recHitEnergyNormInv[th] * std::exp(-0.5f * d2);
+            }
+            fractions[k * nHits + j] = fraction;
+            fracTot += fraction;
+          }
+          for (uint32_t k = 0; k < nSeeds; ++k) {
+            uint32_t const c = firstCluster + k;
+            float& fraction = fractions[k * nHits + j];
+            if (!(fracTot > params.minFracTot || (i == clusters.seedHit[c] && fracTot > 0))) {
+              fraction = 0;
+              continue;
+            }
+            fraction /= fracTot;
+            // only the close rechits, and the seed even when the cluster moves away from it
+            float const dx = clusters.x[c] - rh.x[i];
+            float const dy = clusters.y[c] - rh.y[i];
+            float const dz = clusters.z[c] - rh.z[i];
+            float const d2 = (dx * dx + dy * dy + dz * dz) / params.showerSigma2;
+            if (!(d2 < maxDistance2 || fraction > 0.9999f))
+              fraction = 0;
+          }
+        }
+
+        float diff2 = 0;
+        for (uint32_t k = 0; k < nSeeds; ++k) {
+          uint32_t const c = firstCluster + k;
+          computeCluster(rh, ws, params, hits, nHits, fractions + k * nHits, c, allCells);
+          float eta, phi;
+          etaPhi(clusters, c, eta, phi);
+          float const deta = eta - ws.clusterEta[c];
+          float const dphi = deltaPhi(phi, ws.clusterPhi[c]);
+          float const delta2 = deta * deta + dphi * dphi;
+          diff2 = delta2 > diff2 ? delta2 : diff2;
+        }
+        diff = std::sqrt(diff2);
+      }
+
+      // the fractions to keep, and the clusters from them
+      uint32_t nKept = 0;
+      for (uint32_t p = 0; p < nSeeds * nHits; ++p) {
+        if (fractions[p] > params.minFractionToKeep)
+          ++nKept;
+        else
+          fractions[p] = 0;
+      }
+      uint32_t f = atomicAddCount(&clusters.nFractionsStored, nKept);
+      for (uint32_t k = 0; k < nSeeds; ++k) {
+        uint32_t const c = firstCluster + k;
+        computeCluster(rh, ws, params, hits, nHits, fractions + k * nHits, c, allCells);
+        for (uint32_t j = 0; j < nHits; ++j) {
+          if (fractions[k * nHits + j] == 0)
+            continue;
+          clusters.fracCluster[f] = c;
+          clusters.fracHit[f] = hits[j];
+          clusters.fraction[f] = fractions[k * nHits + j];
+          ++f;
+        }
+      }
+    }
+  }
+
+}  // namespace pfClustering
+
+#endif
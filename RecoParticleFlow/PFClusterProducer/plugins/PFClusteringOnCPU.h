@@ -0,0 +1,70 @@
+#ifndef RecoParticleFlow_PFClusterProducer_plugins_PFClusteringOnCPU_h
+#define RecoParticleFlow_PFClusterProducer_plugins_PFClusteringOnCPU_h
+
+#include <vector>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitSoA.h"
+
+#include "PFClusteringAlgos.h"
+
+// The steps of the particle flow clustering run one after the other on the host,
+// with the work arrays kept from one event to the next
+class PFClusteringOnCPU {
+public:
+  void makeClusters(PFRecHitSoA const& recHits, pfClustering::Params const& params, PFClusterSoA& clusters) {
+    uint32_t const n = recHits.nRecHits();
+    topoHitOffsets_.assign(n + 1, 0);
+    topoSeedOffsets_.assign(n + 1, 0);
+    topoFractionOffsets_.resize(n + 1);
+    topoHitFill_.resize(n);
+    topoSeedFill_.resize(n);
+    topoHits_.resize(n);
+    topoSeeds_.resize(n);
+    fractions_.resize(PFClusterSoA::maxFractions);
+    clusterEta_.resize(PFClusterSoA::maxClusters);
+    clusterPhi_.resize(PFClusterSoA::maxClusters);
+    clusters.nFound = 0;
+    clusters.nStored = 0;
+    clusters.nFractionsStored = 0;
+
+    pfClustering::Workspace ws{topoHitOffsets_.data(),
+                               topoSeedOffsets_.data(),
+                               topoFractionOffsets_.data(),
+                               topoHitFill_.data(),
+                               topoSeedFill_.data(),
+                               topoHits_.data(),
+                               topoSeeds_.data(),
+                               fractions_.data(),
+                               clusterEta_.data(),
+                               clusterPhi_.data(),
+                               &changed_,
+                               &clusters};
+
+    pfClustering::initRecHits(recHits, ws, params, 0, 1);
+    do {
+      changed_ = 0;
+      pfClustering::propagateTopo(recHits, ws, params, 0, 1);
+    } while (changed_);
+    pfClustering::countTopo(recHits, ws, 0, 1);
+    pfClustering::scanTopo(recHits, ws);
+    pfClustering::fillTopo(recHits, ws, 0, 1);
+    pfClustering::sortTopo(recHits, ws, 0, 1);
+    pfClustering::fitTopo(recHits, ws, params, 0, 1);
+  }
+
+private:
+  uint32_t changed_;
+  std::vector<uint32_t> topoHitOffsets_;
+  std::vector<uint32_t> topoSeedOffsets_;
+  std::vector<uint32_t> topoFractionOffsets_;
+  std::vector<uint32_t> topoHitFill_;
+  std::vector<uint32_t> topoSeedFill_;
+  std::vector<uint32_t> topoHits_;
+  std::vector<uint32_t> topoSeeds_;
+  std::vector<float> fractions_;
+  std::vector<float> clusterEta_;
+  std::vector<float> clusterPhi_;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef RecoParticleFlow_PFClusterProducer_plugins_PFClusteringParams_h
+#define RecoParticleFlow_PFClusterProducer_plugins_PFClusteringParams_h
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "PFClusteringAlgos.h"
+
+// The configuration of the particle flow clustering on the SoA, the same on the GPU and
+// the CPU. The thresholds are given by detector, and by depth for the HCAL, as for
+// LocalMaximumSeedFinder, Basic2DGenericTopoClusterizer, Basic2DGenericPFlowClusterizer and
+// Basic2DGenericPFlowPositionCalc; the defaults are those of the HBHE clustering.
+namespace pfClustering {
+
+  inline edm::ParameterSet makeThresholds(std::string const& detector,
+                                          std::vector<int> const& depths,
+                                          std::vector<double> const& seeding,
+                                          std::vector<double> const& seedingPt,
+                                          std::vector<double> const& gathering,
+                                          std::vector<double> const& gatheringPt,
+                                          std::vector<double> const& recHitEnergyNorm,
+                                          std::vector<double> const& logWeightDenominator) {
+    edm::ParameterSet pset;
+    pset.addParameter<std::string>("detector", detector);
+    pset.addParameter<std::vector<int>>("depths", depths);
+    pset.addParameter<std::vector<double>>("seedingThreshold", seeding);
+    pset.addParameter<std::vector<double>>("seedingThresholdPt", seedingPt);
+    pset.addParameter<std::vector<double>>("gatheringThreshold", gathering);
+    pset.addParameter<std::vector<double>>("gatheringThresholdPt", gatheringPt);
+    pset.addParameter<std::vector<double>>("recHitEnergyNorm", recHitEnergyNorm);
+    pset.addParameter<std::vector<double>>("logWeightDenominator", logWeightDenominator);
+    return pset;
+  }
+
+  inline void fillParamsDescription(edm::ParameterSetDescription& desc) {
+    edm::ParameterSetDescription thresholds;
+    thresholds.add<std::string>("detector", "HCAL_BARREL1")
+        ->setComment("ECAL_BARREL, ECAL_ENDCAP, HCAL_BARREL1 or HCAL_ENDCAP");
+    thresholds.add<std::vector<int>>("depths", {1, 2, 3, 4})->setComment("a single one, ignored, for the ECAL");
+    thresholds.add<std::vector<double>>("seedingThreshold", {1.0, 1.5, 1.5, 1.5});
+    thresholds.add<std::vector<double>>("seedingThresholdPt", {0., 0., 0., 0.});
+    thresholds.add<std::vector<double>>("gatheringThreshold", {0.8, 1.2, 1.2, 1.2});
+    thresholds.add<std::vector<double>>("gatheringThresholdPt", {0., 0., 0., 0.});
+    thresholds.add<std::vector<double>>("recHitEnergyNorm", {0.8, 1.2, 1.2, 1.2});
+    thresholds.add<std::vector<double>>("logWeightDenominator", {0.8, 1.2, 1.2, 1.2});
+    std::vector<double> const heGathering = {0.1, 0.2, 0.2, 0.2, 0.2, 0.2, 0.2};
+    std::vector<double> const heSeeding = {1.1, 1.5, 1.5, 1.5, 1.5, 1.5, 1.5};
+    std::vector<double> const zero7(7, 0.);
+    desc.addVPSet("thresholdsByDetector",
+                  thresholds,
+                  {makeThresholds("HCAL_BARREL1",
+                                  {1, 2, 3, 4},
+                                  {1.0, 1.5, 1.5, 1.5},
+                                  {0., 0., 0., 0.},
+                                  {0.8, 1.2, 1.2, 1.2},
+                                  {0., 0., 0., 0.},
+                                  {0.8, 1.2, 1.2, 1.2},
+                                  {0.8, 1.2, 1.2, 1.2}),
+                   makeThresholds("HCAL_ENDCAP",
+                                  {1, 2, 3, 4, 5, 6, 7},
+                                  heSeeding,
+                                  zero7,
+                                  heGathering,
+                                  zero7,
+                                  heGathering,
+                                  heGathering)});
+    desc.add<int>("nNeighbours", 4)->setComment("of the seeds: 0, 4 or 8");
+    desc.add<bool>("useCornerCells", true)->setComment("in the topological clusters");
+    desc.add<double>("showerSigma", 10.)->setComment("cm");
+    desc.add<unsigned int>("maxIterations", 50);
+    desc.add<double>("stoppingTolerance", 1.e-8);
+    desc.add<bool>("excludeOtherSeeds", true);
+    desc.add<double>("minFracTot", 1.e-20);
+    desc.add<double>("minFractionToKeep", 1.e-7);
+    desc.add<double>("minFractionInCalc", 1.e-9);
+    desc.add<double>("minAllowedNormalization", 1.e-9);
+    desc.add<int>("posCalcNCrystals", 5)->setComment("5, 9, or -1 for all the rechits");
+    desc.add<bool>("allCellsPositionCalc", true)
+        ->setComment("all the rechits for the position of the clusters alone in their topological cluster");
+  }
+
+  inline Params makeParams(edm::ParameterSet const& iConfig) {
+    Params params;
+    // the rechits of the detectors not configured are neither seeds nor gathered
+    for (uint32_t t = 0; t < nThresholds; ++t) {
+      params.seedingThreshold[t] = params.gatheringThreshold[t] = std::numeric_limits<float>::max();
+      params.seedingThresholdPt2[t] = params.gatheringThresholdPt2[t] = 0;
+      params.recHitEnergyNormInv[t] = params.logWeightDenominatorInv[t] = 1.f;
+    }
+    for (auto const& pset : iConfig.getParameterSetVector("thresholdsByDetector")) {
+      std::string const& detector = pset.getParameter<std::string>("detector");
+      int8_t layer;
+      if (detector == "ECAL_BARREL")
+        layer = PFLayer::ECAL_BARREL;
+      else if (detector == "ECAL_ENDCAP")
+        layer = PFLayer::ECAL_ENDCAP;
+      else if (detector == "HCAL_BARREL1")
+        layer = PFLayer::HCAL_BARREL1;
+      else if (detector == "HCAL_ENDCAP")
+        layer = PFLayer::HCAL_ENDCAP;
+      else
+        throw cms::Exception("InvalidDetectorLayer")
+            << "Detector layer : " << detector << " is not clustered on the SoA";
+      auto const& depths = pset.getParameter<std::vector<int>>("depths");
+      auto const& seeding = pset.getParameter<std::vector<double>>("seedingThreshold");
+      auto const& seedingPt = pset.getParameter<std::vector<double>>("seedingThresholdPt");
+      auto const& gathering = pset.getParameter<std::vector<double>>("gatheringThreshold");
+      auto const& gatheringPt = pset.getParameter<std::vector<double>>("gatheringThresholdPt");
+      auto const& norm = pset.getParameter<std::vector<double>>("recHitEnergyNorm");
+      auto const& logWeight = pset.getParameter<std::vector<double>>("logWeightDenominator");
+      bool const ecal = layer == PFLayer::ECAL_BARREL || layer == PFLayer::ECAL_ENDCAP;
+      for (auto const* values : {&seeding, &seedingPt, &gathering, &gatheringPt, &norm, &logWeight}) {
+        if (values->size() != depths.size() || (ecal && depths.size() != 1))
+          throw cms::Exception("InvalidPFClusteringThreshold")
+              << "The thresholds of " << detector << " mismatch with the numbers of depths";
+      }
+      for (unsigned int k = 0; k < depths.size(); ++k) {
+        int32_t const t = thresholdIndex(layer, ecal ? 0 : depths[k]);
+        if (t < 0)
+          throw cms::Exception("InvalidPFClusteringThreshold") << "Invalid depth " << depths[k] << " of " << detector;
+        params.seedingThreshold[t] = seeding[k];
+        params.seedingThresholdPt2[t] = seedingPt[k] * seedingPt[k];
+        params.gatheringThreshold[t] = gathering[k];
+        params.gatheringThresholdPt2[t] = gatheringPt[k] * gatheringPt[k];
+        params.recHitEnergyNormInv[t] = 1. / norm[k];
+        params.logWeightDenominatorInv[t] = 1. / logWeight[k];
+      }
+    }
+
+    int const nNeighbours = iConfig.getParameter<int>("nNeighbours");
+    if (nNeighbours != 0 && nNeighbours != 4 && nNeighbours != 8)
+      throw cms::Exception("InvalidConfiguration") << "The clustering on the SoA only accepts nNeighbours = {0,4,8}";
+    params.nSeedNeighbours = nNeighbours;
+    params.useCornerCells = iConfig.getParameter<bool>("useCornerCells");
+    double const showerSigma = iConfig.getParameter<double>("showerSigma");
+    params.showerSigma2 = showerSigma * showerSigma;
+    params.maxIterations = iConfig.getParameter<unsigned int>("maxIterations");
+    params.stoppingTolerance = iConfig.getParameter<double>("stoppingTolerance");
+    params.excludeOtherSeeds = iConfig.getParameter<bool>("excludeOtherSeeds");
+    params.minFracTot = iConfig.getParameter<double>("minFracTot");
+    params.minFractionToKeep = iConfig.getParameter<double>("minFractionToKeep");
+    params.minFractionInCalc = iConfig.getParameter<double>("minFractionInCalc");
+    params.minAllowedNormalization = iConfig.getParameter<double>("minAllowedNormalization");
+    int const nCrystals = iConfig.getParameter<int>("posCalcNCrystals");
+    if (nCrystals != -1 && nCrystals != 5 && nCrystals != 9)
+      throw cms::Exception("InvalidConfiguration") << "posCalcNCrystals not valid";
+    params.posCalcNCrystals = nCrystals == -1 ? 0 : nCrystals;
+    params.allCellsPosCalc = iConfig.getParameter<bool>("allCellsPositionCalc");
+    return params;
+  }
+
+}  // namespace pfClustering
+
+#endif
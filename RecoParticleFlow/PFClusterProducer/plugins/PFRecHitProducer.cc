@@ -65,9 +65,7 @@ void PFRecHitProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
   //create a refprod here
   edm::RefProd<reco::PFRecHitCollection> refProd = iEvent.getRefBeforePut<reco::PFRecHitCollection>();
 
-  for (auto& pfrechit : *out) {
-    navigator_->associateNeighbours(pfrechit, out, refProd);
-  }
+  navigator_->associateAllNeighbours(out, refProd);
 
   iEvent.put(std::move(out), "");
   iEvent.put(std::move(cleaned), "Cleaned");
@@ -0,0 +1,44 @@
+#ifndef RecoParticleFlow_PFClusterProducer_plugins_PFRecHitSoAFromLegacy_h
+#define RecoParticleFlow_PFClusterProducer_plugins_PFRecHitSoAFromLegacy_h
+
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitSoA.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHit.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHitFwd.h"
+
+namespace pfClustering {
+
+  // the rechits and the neighbours found by the navigator of PFRecHitProducer
+  inline void fillRecHitSoA(reco::PFRecHitCollection const& recHits, PFRecHitSoA& soa) {
+    soa.nFound = recHits.size();
+    uint32_t const n = soa.nRecHits();
+    for (uint32_t i = 0; i < n; ++i) {
+      auto const& hit = recHits[i];
+      auto const& position = hit.position();
+      soa.energy[i] = hit.energy();
+      soa.time[i] = hit.time();
+      soa.x[i] = position.x();
+      soa.y[i] = position.y();
+      soa.z[i] = position.z();
+      soa.layer[i] = hit.layer();
+      soa.depth[i] = hit.depth();
+
+      // the neighbours sharing a side come first among those sharing a side or a corner
+      auto const* neighbours = hit.neighbours8().begin();
+      uint32_t const n4 = hit.neighbours4().size();
+      uint32_t const n8 = hit.neighbours8().size();
+      uint32_t k = 0, k4 = 0;
+      for (uint32_t j = 0; j < n8 && k < PFRecHitSoA::maxNeighbours; ++j) {
+        if (neighbours[j] >= n)
+          continue;
+        soa.neighbours[i][k++] = neighbours[j];
+        if (j < n4)
+          k4 = k;
+      }
+      soa.nNeighbours4[i] = k4;
+      soa.nNeighbours8[i] = k;
+    }
+  }
+
+}  // namespace pfClustering
+
+#endif
@@ -0,0 +1,82 @@
+#include <memory>
+
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "Geometry/CaloTopology/interface/EcalBarrelTopology.h"
+#include "Geometry/CaloTopology/interface/EcalEndcapTopology.h"
+#include "Geometry/CaloTopology/interface/HcalTopology.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitCaloNavigator.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopology.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopologyRecord.h"
+
+/**
+ * Builds the neighbour tables of PFRecHitTopology for the ECAL barrel, the
+ * ECAL endcap and the HCAL, with the navigation of PFRecHitCaloNavigator on
+ * each of their cells, once per IOV of the geometry.
+ */
+class PFRecHitTopologyESProducer : public edm::ESProducer {
+public:
+  explicit PFRecHitTopologyESProducer(const edm::ParameterSet& iConfig);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  std::unique_ptr<PFRecHitTopology> produce(const PFRecHitTopologyRecord& iRecord);
+
+private:
+  edm::ESGetToken<CaloGeometry, CaloGeometryRecord> geometryToken_;
+  edm::ESGetToken<HcalTopology, HcalRecNumberingRecord> hcalTopologyToken_;
+};
+
+PFRecHitTopologyESProducer::PFRecHitTopologyESProducer(const edm::ParameterSet& iConfig) {
+  auto cc = setWhatProduced(this);
+  geometryToken_ = cc.consumesFrom<CaloGeometry, CaloGeometryRecord>(edm::ESInputTag{});
+  hcalTopologyToken_ = cc.consumesFrom<HcalTopology, HcalRecNumberingRecord>(edm::ESInputTag{});
+}
+
+void PFRecHitTopologyESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  descriptions.add("pfRecHitTopologyESProducer", desc);
+}
+
+std::unique_ptr<PFRecHitTopology> PFRecHitTopologyESProducer::produce(const PFRecHitTopologyRecord& iRecord) {
+  const auto& geometry = iRecord.get(geometryToken_);
+  const auto& hcalTopology = iRecord.get(hcalTopologyToken_);
+
+  auto topology = std::make_unique<PFRecHitTopology>(&hcalTopology);
+
+  const EcalBarrelTopology barrelTopology(geometry);
+  for (uint32_t i = 0; i < topology->size(PFRecHitTopology::kEcalBarrel); ++i) {
+    topology->setNeighbours(
+        PFRecHitTopology::kEcalBarrel,
+        i,
+        PFRecHitCaloNavigator<EBDetId, EcalBarrelTopology>::neighbours(EBDetId::unhashIndex(i), &barrelTopology));
+  }
+
+  const EcalEndcapTopology endcapTopology(geometry);
+  for (uint32_t i = 0; i < topology->size(PFRecHitTopology::kEcalEndcap); ++i) {
+    topology->setNeighbours(
+        PFRecHitTopology::kEcalEndcap,
+        i,
+        PFRecHitCaloNavigator<EEDetId, EcalEndcapTopology>::neighbours(EEDetId::unhashIndex(i), &endcapTopology));
+  }
+
+  for (uint32_t i = 0; i < topology->size(PFRecHitTopology::kHcal); ++i) {
+    const DetId id = hcalTopology.denseId2detId(i);
+    if (!hcalTopology.valid(id))
+      continue;
+    topology->setNeighbours(PFRecHitTopology::kHcal,
+                            i,
+                            PFRecHitCaloNavigator<HcalDetId, HcalTopology, false>::neighbours(id, &hcalTopology));
+  }
+
+  return topology;
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(PFRecHitTopologyESProducer);
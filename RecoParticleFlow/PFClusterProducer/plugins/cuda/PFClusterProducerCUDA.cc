@@ -0,0 +1,65 @@
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterCUDA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitCUDA.h"
+#include "DataFormats/ParticleFlowReco/interface/PFRecHitFwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+#include "../PFClusteringParams.h"
+#include "../PFRecHitSoAFromLegacy.h"
+#include "PFClusteringOnGPU.h"
+
+/**
+ * Clusters the particle flow rechits of the ECAL or the HCAL on the GPU:
+ * the rechits of PFRecHitProducer, with the neighbours of its navigator,
+ * are copied to the device, where the seeding, the topological clustering
+ * and the fit of the clusters of PFClusteringAlgos.h run. The clusters stay
+ * on the device, PFClusterSoAFromCUDA copies them to the host.
+ */
+class PFClusterProducerCUDA : public edm::global::EDProducer<> {
+public:
+  explicit PFClusterProducerCUDA(const edm::ParameterSet& iConfig);
+  ~PFClusterProducerCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<reco::PFRecHitCollection> recHitGetToken_;
+  const edm::EDPutTokenT<cms::cuda::Product<PFClusterCUDA>> clusterPutToken_;
+
+  const pfClustering::Params params_;
+};
+
+PFClusterProducerCUDA::PFClusterProducerCUDA(const edm::ParameterSet& iConfig)
+    : recHitGetToken_(consumes<reco::PFRecHitCollection>(iConfig.getParameter<edm::InputTag>("recHitsSource"))),
+      clusterPutToken_(produces<cms::cuda::Product<PFClusterCUDA>>()),
+      params_(pfClustering::makeParams(iConfig)) {}
+
+void PFClusterProducerCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("recHitsSource", edm::InputTag("particleFlowRecHitHBHE"));
+  pfClustering::fillParamsDescription(desc);
+  descriptions.add("pfClusterProducerCUDA", desc);
+}
+
+void PFClusterProducerCUDA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  cms::cuda::ScopedContextProduce ctx{iEvent.streamID()};
+
+  // the pinned buffer is released once the copy queued on the stream is done
+  auto soa = cms::cuda::make_host_unique<PFRecHitSoA>(ctx.stream());
+  pfClustering::fillRecHitSoA(iEvent.get(recHitGetToken_), *soa);
+  PFRecHitCUDA recHits(*soa, ctx.stream());
+
+  ctx.emplace(iEvent, clusterPutToken_, pfClustering::makeClustersAsync(recHits, params_, ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(PFClusterProducerCUDA);
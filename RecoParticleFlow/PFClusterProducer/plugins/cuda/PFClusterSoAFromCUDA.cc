@@ -0,0 +1,66 @@
+#include <cstring>
+#include <memory>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterCUDA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterSoA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * Copies the particle flow clusters found on the GPU back to the host, as
+ * the same PFClusterSoA filled by PFClusterProducerSoA.
+ */
+class PFClusterSoAFromCUDA : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit PFClusterSoAFromCUDA(const edm::ParameterSet& iConfig);
+  ~PFClusterSoAFromCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<PFClusterCUDA>> clusterGetToken_;
+  edm::EDPutTokenT<PFClusterSoA> clusterPutToken_;
+
+  cms::cuda::host::unique_ptr<PFClusterSoA> clusters_;
+};
+
+PFClusterSoAFromCUDA::PFClusterSoAFromCUDA(const edm::ParameterSet& iConfig)
+    : clusterGetToken_(consumes<cms::cuda::Product<PFClusterCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      clusterPutToken_(produces<PFClusterSoA>()) {}
+
+void PFClusterSoAFromCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("pfClusterProducerCUDA"));
+  descriptions.add("pfClusterSoAFromCUDA", desc);
+}
+
+void PFClusterSoAFromCUDA::acquire(const edm::Event& iEvent,
+                                   const edm::EventSetup& iSetup,
+                                   edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  auto const& product = iEvent.get(clusterGetToken_);
+  cms::cuda::ScopedContextAcquire ctx{product, std::move(waitingTaskHolder)};
+  clusters_ = ctx.get(product).toHostAsync(ctx.stream());
+}
+
+void PFClusterSoAFromCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  // the pinned buffer goes back to the caching allocator, the product owns a copy
+  auto output = std::make_unique<PFClusterSoA>();
+  std::memcpy(output.get(), clusters_.get(), sizeof(PFClusterSoA));
+  iEvent.put(clusterPutToken_, std::move(output));
+  clusters_.reset();
+}
+
+DEFINE_FWK_MODULE(PFClusterSoAFromCUDA);
@@ -0,0 +1,113 @@
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+#include "PFClusteringOnGPU.h"
+
+namespace pfClustering {
+
+  namespace {
+
+    constexpr uint32_t nThreads = 128;
+    // the propagation of the topological clusters runs in a single block, until no thread changes them
+    constexpr uint32_t nPropagationThreads = 1024;
+
+    __device__ uint32_t firstThread() { return blockIdx.x * blockDim.x + threadIdx.x; }
+    __device__ uint32_t nThreadsInGrid() { return blockDim.x * gridDim.x; }
+
+    __global__ void initRecHitsKernel(PFRecHitSoA const* rh, Workspace ws, Params params) {
+      initRecHits(*rh, ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void propagateTopoKernel(PFRecHitSoA const* rh, Workspace ws, Params params) {
+      uint32_t changed;
+      do {
+        if (threadIdx.x == 0)
+          *ws.changed = 0;
+        __syncthreads();
+        propagateTopo(*rh, ws, params, threadIdx.x, blockDim.x);
+        __syncthreads();
+        changed = *ws.changed;
+        __syncthreads();
+      } while (changed);
+    }
+
+    __global__ void countTopoKernel(PFRecHitSoA const* rh, Workspace ws) {
+      countTopo(*rh, ws, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void scanTopoKernel(PFRecHitSoA const* rh, Workspace ws) { scanTopo(*rh, ws); }
+
+    __global__ void fillTopoKernel(PFRecHitSoA const* rh, Workspace ws) {
+      fillTopo(*rh, ws, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void sortTopoKernel(PFRecHitSoA const* rh, Workspace ws) {
+      sortTopo(*rh, ws, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void fitTopoKernel(PFRecHitSoA const* rh, Workspace ws, Params params) {
+      fitTopo(*rh, ws, params, firstThread(), nThreadsInGrid());
+    }
+
+  }  // namespace
+
+  PFClusterCUDA makeClustersAsync(PFRecHitCUDA const& recHits, Params const& params, cudaStream_t stream) {
+    PFClusterCUDA clusters(stream);
+    auto* soa = clusters.get();
+    cudaCheck(cudaMemsetAsync(&soa->nFound, 0, sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(&soa->nStored, 0, sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(&soa->nFractionsStored, 0, sizeof(uint32_t), stream));
+
+    uint32_t const n = recHits.nRecHits();
+    if (n == 0)
+      return clusters;
+    uint32_t const blocks = (n + nThreads - 1) / nThreads;
+
+    auto topoHitOffsets = cms::cuda::make_device_unique<uint32_t[]>(n + 1, stream);
+    auto topoSeedOffsets = cms::cuda::make_device_unique<uint32_t[]>(n + 1, stream);
+    auto topoFractionOffsets = cms::cuda::make_device_unique<uint32_t[]>(n + 1, stream);
+    auto topoHitFill = cms::cuda::make_device_unique<uint32_t[]>(n, stream);
+    auto topoSeedFill = cms::cuda::make_device_unique<uint32_t[]>(n, stream);
+    auto topoHits = cms::cuda::make_device_unique<uint32_t[]>(n, stream);
+    auto topoSeeds = cms::cuda::make_device_unique<uint32_t[]>(n, stream);
+    auto fractions = cms::cuda::make_device_unique<float[]>(PFClusterSoA::maxFractions, stream);
+    auto clusterEta = cms::cuda::make_device_unique<float[]>(PFClusterSoA::maxClusters, stream);
+    auto clusterPhi = cms::cuda::make_device_unique<float[]>(PFClusterSoA::maxClusters, stream);
+    auto changed = cms::cuda::make_device_unique<uint32_t>(stream);
+
+    cudaCheck(cudaMemsetAsync(topoHitOffsets.get(), 0, (n + 1) * sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(topoSeedOffsets.get(), 0, (n + 1) * sizeof(uint32_t), stream));
+
+    Workspace const ws{topoHitOffsets.get(),
+                       topoSeedOffsets.get(),
+                       topoFractionOffsets.get(),
+                       topoHitFill.get(),
+                       topoSeedFill.get(),
+                       topoHits.get(),
+                       topoSeeds.get(),
+                       fractions.get(),
+                       clusterEta.get(),
+                       clusterPhi.get(),
+                       changed.get(),
+                       soa};
+
+    initRecHitsKernel<<<blocks, nThreads, 0, stream>>>(recHits.get(), ws, params);
+    cudaCheck(cudaGetLastError());
+    propagateTopoKernel<<<1, nPropagationThreads, 0, stream>>>(recHits.get(), ws, params);
+    cudaCheck(cudaGetLastError());
+    countTopoKernel<<<blocks, nThreads, 0, stream>>>(recHits.get(), ws);
+    cudaCheck(cudaGetLastError());
+    scanTopoKernel<<<1, 1, 0, stream>>>(recHits.get(), ws);
+    cudaCheck(cudaGetLastError());
+    fillTopoKernel<<<blocks, nThreads, 0, stream>>>(recHits.get(), ws);
+    cudaCheck(cudaGetLastError());
+    sortTopoKernel<<<blocks, nThreads, 0, stream>>>(recHits.get(), ws);
+    cudaCheck(cudaGetLastError());
+    fitTopoKernel<<<blocks, nThreads, 0, stream>>>(recHits.get(), ws, params);
+    cudaCheck(cudaGetLastError());
+
+    // the work arrays are released once the kernels queued on the stream are done
+    return clusters;
+  }
+
+}  // namespace pfClustering
@@ -0,0 +1,21 @@
+#ifndef RecoParticleFlow_PFClusterProducer_plugins_cuda_PFClusteringOnGPU_h
+#define RecoParticleFlow_PFClusterProducer_plugins_cuda_PFClusteringOnGPU_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/ParticleFlow/interface/PFClusterCUDA.h"
+#include "CUDADataFormats/ParticleFlow/interface/PFRecHitCUDA.h"
+
+#include "../PFClusteringAlgos.h"
+
+namespace pfClustering {
+
+  // Queues the steps of the particle flow clustering on the stream, with one
+  // thread per rechit or topological cluster: the clusters are returned at
+  // once, to be used only in the work queued on the same stream. The order of
+  // the fractions of the clusters depends on the scheduling of the threads.
+  PFClusterCUDA makeClustersAsync(PFRecHitCUDA const& recHits, Params const& params, cudaStream_t stream);
+
+}  // namespace pfClustering
+
+#endif
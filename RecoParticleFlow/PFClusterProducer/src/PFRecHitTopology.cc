@@ -0,0 +1,53 @@
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopology.h"
+
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "Geometry/CaloTopology/interface/HcalTopology.h"
+
+PFRecHitTopology::PFRecHitTopology(const HcalTopology* hcalTopology) : hcalTopology_(hcalTopology) {
+  neighbours_[kEcalBarrel].assign(EBDetId::kSizeForDenseIndexing * kNNeighbours, kInvalid);
+  neighbours_[kEcalEndcap].assign(EEDetId::kSizeForDenseIndexing * kNNeighbours, kInvalid);
+  if (hcalTopology_)
+    neighbours_[kHcal].assign(hcalTopology_->ncells() * kNNeighbours, kInvalid);
+}
+
+bool PFRecHitTopology::denseIndex(const DetId& id, Detector& detector, uint32_t& index) const {
+  if (id.det() == DetId::Ecal && id.subdetId() == EcalBarrel) {
+    detector = kEcalBarrel;
+    index = EBDetId(id).hashedIndex();
+  } else if (id.det() == DetId::Ecal && id.subdetId() == EcalEndcap) {
+    detector = kEcalEndcap;
+    index = EEDetId(id).hashedIndex();
+  } else if (id.det() == DetId::Hcal && hcalTopology_) {
+    detector = kHcal;
+    index = hcalTopology_->detId2denseId(id);
+  } else {
+    return false;
+  }
+  return index < size(detector);
+}
+
+DetId PFRecHitTopology::detId(Detector detector, uint32_t index) const {
+  switch (detector) {
+    case kEcalBarrel:
+      return EBDetId::unhashIndex(index);
+    case kEcalEndcap:
+      return EEDetId::unhashIndex(index);
+    case kHcal:
+      return hcalTopology_->denseId2detId(index);
+    default:
+      return DetId(0);
+  }
+}
+
+void PFRecHitTopology::setNeighbours(Detector detector,
+                                     uint32_t index,
+                                     const std::array<DetId, kNNeighbours>& ids) {
+  for (unsigned int k = 0; k < kNNeighbours; ++k) {
+    Detector neighbourDetector;
+    uint32_t neighbourIndex;
+    if (ids[k] != DetId(0) && denseIndex(ids[k], neighbourDetector, neighbourIndex) && neighbourDetector == detector)
+      neighbours_[detector][index * kNNeighbours + k] = neighbourIndex;
+  }
+}
@@ -0,0 +1,4 @@
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopologyRecord.h"
+#include "FWCore/Framework/interface/eventsetuprecord_registration_macro.h"
+
+EVENTSETUP_RECORD_REG(PFRecHitTopologyRecord);
@@ -0,0 +1,3 @@
+#include "FWCore/Utilities/interface/typelookup.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopology.h"
+TYPELOOKUP_DATA_REG(PFRecHitTopology);
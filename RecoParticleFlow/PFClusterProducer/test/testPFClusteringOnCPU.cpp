@@ -0,0 +1,150 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "RecoParticleFlow/PFClusterProducer/plugins/PFClusteringOnCPU.h"
+
+namespace {
+
+  // a grid of HB cells of the first depth in (z, phi), at the radius of HB
+  constexpr int nZ = 16;
+  constexpr int nPhi = 12;
+  constexpr float radius = 190.f;
+  constexpr float cellSize = 16.5f;
+
+  void setCell(PFRecHitSoA& hits, uint32_t i, int iz, int iphi, float energy) {
+    float const phi = iphi * cellSize / radius;
+    hits.energy[i] = energy;
+    hits.time[i] = 0.f;
+    hits.x[i] = radius * std::cos(phi);
+    hits.y[i] = radius * std::sin(phi);
+    hits.z[i] = iz * cellSize;
+    hits.layer[i] = PFLayer::HCAL_BARREL1;
+    hits.depth[i] = 1;
+  }
+
+  float phiOf(PFClusterSoA const& clusters, uint32_t c) { return std::atan2(clusters.y[c], clusters.x[c]); }
+
+}  // namespace
+
+int main() {
+  pfClustering::Params params;
+  for (uint32_t t = 0; t < pfClustering::nThresholds; ++t) {
+    params.seedingThreshold[t] = 1.f;
+    params.seedingThresholdPt2[t] = 0.f;
+    params.gatheringThreshold[t] = 0.8f;
+    params.gatheringThresholdPt2[t] = 0.f;
+    params.recHitEnergyNormInv[t] = 1.f / 0.8f;
+    params.logWeightDenominatorInv[t] = 1.f / 0.8f;
+  }
+  params.nSeedNeighbours = 4;
+  params.useCornerCells = true;
+  params.showerSigma2 = 100.f;
+  params.maxIterations = 50;
+  params.stoppingTolerance = 1.e-8f;
+  params.excludeOtherSeeds = true;
+  params.minFracTot = 1.e-20f;
+  params.minFractionToKeep = 1.e-7f;
+  params.minFractionInCalc = 1.e-9f;
+  params.minAllowedNormalization = 1.e-9f;
+  params.posCalcNCrystals = 5;
+  params.allCellsPosCalc = true;
+
+  // two overlapping showers, three cells apart in phi, in the cells of the grid
+  struct Shower {
+    int iz, iphi;
+    float energy;
+  };
+  constexpr Shower showers[] = {{5, 3, 20.f}, {5, 6, 8.f}};
+  constexpr float showerWidth = 15.f;
+
+  auto hits = std::make_unique<PFRecHitSoA>();
+  auto index = [](int iz, int iphi) { return uint32_t(iz * nPhi + iphi); };
+  for (int iz = 0; iz < nZ; ++iz) {
+    for (int iphi = 0; iphi < nPhi; ++iphi) {
+      float energy = 0;
+      for (auto const& shower : showers) {
+        float const d2 = cellSize * cellSize * ((iz - shower.iz) * (iz - shower.iz) +
+                                                (iphi - shower.iphi) * (iphi - shower.iphi));
+        energy += shower.energy * std::exp(-0.5f * d2 / (showerWidth * showerWidth));
+      }
+      setCell(*hits, index(iz, iphi), iz, iphi, energy);
+    }
+  }
+  // an isolated cell above the seeding threshold, and two cells below it
+  setCell(*hits, index(13, 9), 13, 9, 3.f);
+  setCell(*hits, index(13, 2), 13, 2, 0.9f);
+  setCell(*hits, index(10, 10), 10, 10, 0.5f);
+  hits->nFound = nZ * nPhi;
+
+  // the neighbours sharing a side, then those sharing a corner
+  constexpr int sides[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+  constexpr int corners[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+  for (int iz = 0; iz < nZ; ++iz) {
+    for (int iphi = 0; iphi < nPhi; ++iphi) {
+      uint32_t const i = index(iz, iphi);
+      uint32_t k = 0;
+      for (auto const& d : sides) {
+        if (iz + d[0] >= 0 && iz + d[0] < nZ && iphi + d[1] >= 0 && iphi + d[1] < nPhi)
+          hits->neighbours[i][k++] = index(iz + d[0], iphi + d[1]);
+      }
+      hits->nNeighbours4[i] = k;
+      for (auto const& d : corners) {
+        if (iz + d[0] >= 0 && iz + d[0] < nZ && iphi + d[1] >= 0 && iphi + d[1] < nPhi)
+          hits->neighbours[i][k++] = index(iz + d[0], iphi + d[1]);
+      }
+      hits->nNeighbours8[i] = k;
+    }
+  }
+
+  auto clusters = std::make_unique<PFClusterSoA>();
+  PFClusteringOnCPU clustering;
+  clustering.makeClusters(*hits, params, *clusters);
+
+  std::cout << clusters->nClusters() << " clusters, " << clusters->nFractions() << " fractions" << std::endl;
+  for (uint32_t c = 0; c < clusters->nClusters(); ++c) {
+    std::cout << "seed " << clusters->seedHit[c] << " topo " << clusters->topoId[c] << " energy "
+              << clusters->energy[c] << " phi " << phiOf(*clusters, c) << " z " << clusters->z[c] << std::endl;
+  }
+  assert(!clusters->overflow());
+  assert(clusters->nClusters() == 3);
+
+  // the two showers share a topological cluster, ordered by seed
+  uint32_t const seedA = index(showers[0].iz, showers[0].iphi);
+  uint32_t const seedB = index(showers[1].iz, showers[1].iphi);
+  assert(clusters->seedHit[0] == seedA && clusters->seedHit[1] == seedB);
+  assert(clusters->topoId[0] == clusters->topoId[1]);
+  assert(clusters->energy[0] > clusters->energy[1]);
+  for (uint32_t s = 0; s < 2; ++s) {
+    float const phi = showers[s].iphi * cellSize / radius;
+    assert(std::abs(phiOf(*clusters, s) - phi) < 0.5f * cellSize / radius);
+    assert(std::abs(clusters->z[s] - showers[s].iz * cellSize) < 0.5f * cellSize);
+  }
+
+  // the isolated cell is a cluster of its own, the cells below the seeding threshold are in none
+  assert(clusters->seedHit[2] == index(13, 9));
+  assert(std::abs(clusters->energy[2] - 3.f) < 1.e-5f);
+  assert(clusters->hitTopoId[index(13, 2)] == -1);
+  assert(clusters->hitTopoId[index(10, 10)] == -1);
+
+  // the energy of the topological cluster of the showers is shared by its clusters
+  std::vector<float> sumFractions(hits->nRecHits(), 0.f);
+  uint32_t previous = 0;
+  for (uint32_t f = 0; f < clusters->nFractions(); ++f) {
+    assert(clusters->fracCluster[f] >= previous);
+    previous = clusters->fracCluster[f];
+    sumFractions[clusters->fracHit[f]] += clusters->fraction[f];
+  }
+  float topoEnergy = 0;
+  for (uint32_t i = 0; i < hits->nRecHits(); ++i) {
+    if (clusters->hitTopoId[i] != int32_t(clusters->topoId[0]))
+      continue;
+    assert(std::abs(sumFractions[i] - 1.f) < 1.e-4f);
+    topoEnergy += hits->energy[i];
+  }
+  assert(std::abs(clusters->energy[0] + clusters->energy[1] - topoEnergy) < 1.e-3f * topoEnergy);
+
+  return 0;
+}
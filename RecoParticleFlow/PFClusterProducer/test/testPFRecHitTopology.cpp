@@ -0,0 +1,161 @@
+// The neighbours of the ECAL cells in the tables of PFRecHitTopology are those found by the
+// navigation of PFRecHitCaloNavigator::associateNeighbours before the tables were introduced.
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+#include "Geometry/CaloTopology/interface/EcalBarrelTopology.h"
+#include "Geometry/CaloTopology/interface/EcalEndcapTopology.h"
+#include "RecoCaloTools/Navigation/interface/CaloNavigator.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitCaloNavigator.h"
+#include "RecoParticleFlow/PFClusterProducer/interface/PFRecHitTopology.h"
+
+namespace {
+  // the topologies only ask the geometry whether a cell is present: all the valid cells of the subdetector are
+  class PresentCells : public CaloSubdetectorGeometry {
+  public:
+    explicit PresentCells(int subdet) : subdet_(subdet) {}
+
+    bool present(const DetId& id) const override { return id.det() == DetId::Ecal && id.subdetId() == subdet_; }
+    void newCell(const GlobalPoint&, const GlobalPoint&, const GlobalPoint&, const CCGFloat*, const DetId&) override {}
+
+  protected:
+    const CaloCellGeometry* getGeometryRawPtr(uint32_t) const override { return nullptr; }
+
+  private:
+    const int subdet_;
+  };
+
+  // the neighbour, its eta and its phi
+  using Neighbours = std::vector<std::tuple<uint32_t, short, short>>;
+
+  // the navigation of PFRecHitCaloNavigator::associateNeighbours before the tables, the neighbours not found left out
+  template <typename DET, typename TOPO>
+  Neighbours navigate(const DetId& detid, const TOPO* topology) {
+    CaloNavigator<DET> navigator(detid, topology);
+    Neighbours found;
+    auto associate = [&found](DetId id, short eta, short phi) {
+      if (id != DetId(0))
+        found.emplace_back(id.rawId(), eta, phi);
+    };
+
+    DetId N = navigator.north();
+    associate(N, 0, 1);
+    DetId NE;
+    if (N != DetId(0)) {
+      NE = navigator.east();
+    } else {
+      navigator.home();
+      navigator.east();
+      NE = navigator.north();
+    }
+    associate(NE, 1, 1);
+    navigator.home();
+
+    DetId S = navigator.south();
+    associate(S, 0, -1);
+    DetId SW;
+    if (S != DetId(0)) {
+      SW = navigator.west();
+    } else {
+      navigator.home();
+      navigator.west();
+      SW = navigator.south();
+    }
+    associate(SW, -1, -1);
+    navigator.home();
+
+    DetId E = navigator.east();
+    associate(E, 1, 0);
+    DetId SE;
+    if (E != DetId(0)) {
+      SE = navigator.south();
+    } else {
+      navigator.home();
+      navigator.south();
+      SE = navigator.east();
+    }
+    associate(SE, 1, -1);
+    navigator.home();
+
+    DetId W = navigator.west();
+    associate(W, -1, 0);
+    DetId NW;
+    if (W != DetId(0)) {
+      NW = navigator.north();
+    } else {
+      navigator.home();
+      navigator.north();
+      NW = navigator.west();
+    }
+    associate(NW, -1, 1);
+    return found;
+  }
+
+  Neighbours lookUp(const PFRecHitTopology& topology, PFRecHitTopology::Detector detector, uint32_t index) {
+    Neighbours found;
+    for (unsigned int k = 0; k < PFRecHitTopology::kNNeighbours; ++k) {
+      uint32_t const neighbour = topology.neighbour(detector, index, k);
+      if (neighbour != PFRecHitTopology::kInvalid)
+        found.emplace_back(topology.detId(detector, neighbour).rawId(),
+                           PFRecHitCaloNavigator<EBDetId, EcalBarrelTopology>::neighbourEta[k],
+                           PFRecHitCaloNavigator<EBDetId, EcalBarrelTopology>::neighbourPhi[k]);
+    }
+    return found;
+  }
+
+  // the neighbours of each cell of a detector, in the tables and by navigation
+  template <typename DET, typename TOPO>
+  int compare(PFRecHitTopology& table, PFRecHitTopology::Detector detector, const TOPO& topology) {
+    for (uint32_t i = 0; i < table.size(detector); ++i)
+      table.setNeighbours(detector, i, PFRecHitCaloNavigator<DET, TOPO>::neighbours(DET::unhashIndex(i), &topology));
+
+    int failures = 0;
+    for (uint32_t i = 0; i < table.size(detector); ++i) {
+      const DetId id = DET::unhashIndex(i);
+      PFRecHitTopology::Detector found;
+      uint32_t index;
+      if (!table.denseIndex(id, found, index) || found != detector || index != i || table.detId(detector, i) != id) {
+        std::cerr << "wrong dense index of " << id.rawId() << std::endl;
+        ++failures;
+      } else if (lookUp(table, detector, i) != navigate<DET>(id, &topology)) {
+        std::cerr << "wrong neighbours of " << id.rawId() << std::endl;
+        ++failures;
+      }
+    }
+    return failures;
+  }
+}  // namespace
+
+int main() {
+  PresentCells barrelCells(EcalBarrel);
+  PresentCells endcapCells(EcalEndcap);
+  CaloGeometry geometry;
+  geometry.setSubdetGeometry(DetId::Ecal, EcalBarrel, &barrelCells);
+  geometry.setSubdetGeometry(DetId::Ecal, EcalEndcap, &endcapCells);
+  const EcalBarrelTopology barrelTopology(geometry);
+  const EcalEndcapTopology endcapTopology(geometry);
+
+  // without the HCAL topology there are only the ECAL tables
+  PFRecHitTopology table(nullptr);
+  int failures = 0;
+  failures += compare<EBDetId>(table, PFRecHitTopology::kEcalBarrel, barrelTopology);
+  failures += compare<EEDetId>(table, PFRecHitTopology::kEcalEndcap, endcapTopology);
+
+  // a cell in the middle of the barrel has its 8 neighbours, a cell at the edge of the barrel only 5
+  const uint32_t middle = EBDetId(10, 100).hashedIndex();
+  const uint32_t edge = EBDetId(85, 1).hashedIndex();
+  if (lookUp(table, PFRecHitTopology::kEcalBarrel, middle).size() != 8 ||
+      lookUp(table, PFRecHitTopology::kEcalBarrel, edge).size() != 5) {
+    std::cerr << "wrong number of neighbours" << std::endl;
+    ++failures;
+  }
+
+  std::cout << "failures: " << failures << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -117,9 +117,13 @@ public:
   friend std::ostream& operator<<(std::ostream& out, const PFAlgo& algo);
 
 private:
-  void egammaFilters(const reco::PFBlockRef& blockref, std::vector<bool>& active, PFEGammaFilters const* pfegamma);
+  void egammaFilters(reco::PFCandidateCollection& pfCandidates,
+                     const reco::PFBlockRef& blockref,
+                     std::vector<bool>& active,
+                     PFEGammaFilters const* pfegamma);
   void conversionAlgo(const edm::OwnVector<reco::PFBlockElement>& elements, std::vector<bool>& active);
-  bool checkAndReconstructSecondaryInteraction(const reco::PFBlockRef& blockref,
+  bool checkAndReconstructSecondaryInteraction(reco::PFCandidateCollection& pfCandidates,
+                                               const reco::PFBlockRef& blockref,
                                                const edm::OwnVector<reco::PFBlockElement>& elements,
                                                bool isActive,
                                                int iElement);
@@ -131,7 +135,8 @@ private:
                          reco::PFBlock::LinkData& linkData,
                          unsigned int iTrack);
   bool checkGoodTrackDeadHcal(const reco::TrackRef& trackRef, bool hasDeadHcal);
-  void elementLoop(const reco::PFBlock& block,
+  void elementLoop(reco::PFCandidateCollection& pfCandidates,
+                   const reco::PFBlock& block,
                    reco::PFBlock::LinkData& linkData,
                    const edm::OwnVector<reco::PFBlockElement>& elements,
                    std::vector<bool>& active,
@@ -144,7 +149,8 @@ private:
                  ElementIndices& inds,
                  std::vector<bool>& deadArea,
                  unsigned int iEle);
-  bool recoTracksNotHCAL(const reco::PFBlock& block,
+  bool recoTracksNotHCAL(reco::PFCandidateCollection& pfCandidates,
+                         const reco::PFBlock& block,
                          reco::PFBlock::LinkData& linkData,
                          const edm::OwnVector<reco::PFBlockElement>& elements,
                          const reco::PFBlockRef& blockref,
@@ -156,21 +162,24 @@ private:
                          reco::TrackRef& trackRef);
 
   //Looks for a HF-associated element in the block and produces a PFCandidate from it with HF_EM and/or HF_HAD calibrations
-  void createCandidatesHF(const reco::PFBlock& block,
+  void createCandidatesHF(reco::PFCandidateCollection& pfCandidates,
+                          const reco::PFBlock& block,
                           reco::PFBlock::LinkData& linkData,
                           const edm::OwnVector<reco::PFBlockElement>& elements,
                           std::vector<bool>& active,
                           const reco::PFBlockRef& blockref,
                           ElementIndices& inds);
 
-  void createCandidatesHCAL(const reco::PFBlock& block,
+  void createCandidatesHCAL(reco::PFCandidateCollection& pfCandidates,
+                            const reco::PFBlock& block,
                             reco::PFBlock::LinkData& linkData,
                             const edm::OwnVector<reco::PFBlockElement>& elements,
                             std::vector<bool>& active,
                             const reco::PFBlockRef& blockref,
                             ElementIndices& inds,
                             std::vector<bool>& deadArea);
-  void createCandidatesHCALUnlinked(const reco::PFBlock& block,
+  void createCandidatesHCALUnlinked(reco::PFCandidateCollection& pfCandidates,
+                                    const reco::PFBlock& block,
                                     reco::PFBlock::LinkData& linkData,
                                     const edm::OwnVector<reco::PFBlockElement>& elements,
                                     std::vector<bool>& active,
@@ -178,7 +187,8 @@ private:
                                     ElementIndices& inds,
                                     std::vector<bool>& deadArea);
 
-  void createCandidatesECAL(const reco::PFBlock& block,
+  void createCandidatesECAL(reco::PFCandidateCollection& pfCandidates,
+                            const reco::PFBlock& block,
                             reco::PFBlock::LinkData& linkData,
                             const edm::OwnVector<reco::PFBlockElement>& elements,
                             std::vector<bool>& active,
@@ -188,15 +198,16 @@ private:
 
   /// process one block. can be reimplemented in more sophisticated
   /// algorithms
-  void processBlock(const reco::PFBlockRef& blockref,
-                    std::list<reco::PFBlockRef>& hcalBlockRefs,
-                    std::list<reco::PFBlockRef>& ecalBlockRefs,
+  void processBlock(reco::PFCandidateCollection& pfCandidates,
+                    const reco::PFBlockRef& blockref,
                     PFEGammaFilters const* pfegamma);
 
   /// Reconstruct a charged particle from a track
-  /// Returns the index of the newly created candidate in pfCandidates_
+  /// Returns the index of the newly created candidate in pfCandidates
   /// Michalis added a flag here to treat muons inside jets
-  unsigned reconstructTrack(const reco::PFBlockElement& elt, bool allowLoose = false);
+  unsigned reconstructTrack(reco::PFCandidateCollection& pfCandidates,
+                            const reco::PFBlockElement& elt,
+                            bool allowLoose = false);
 
   /// Reconstruct a neutral particle from a cluster.
   /// If chargedEnergy is specified, the neutral
@@ -204,7 +215,8 @@ private:
   /// larger than the chargedEnergy. In this case, the energy of the
   /// neutral particle is cluster energy - chargedEnergy
 
-  unsigned reconstructCluster(const reco::PFCluster& cluster,
+  unsigned reconstructCluster(reco::PFCandidateCollection& pfCandidates,
+                              const reco::PFCluster& cluster,
                               double particleEnergy,
                               bool useDirection = false,
                               double particleX = 0.,
@@ -137,6 +137,16 @@ void KDTreeLinkerTrackEcal::buildTree() {
 void KDTreeLinkerTrackEcal::searchLinks() {
   // Must of the code has been taken from LinkByRecHit.cc
 
+  // The tracks reaching ecal, with their impact point
+  struct TrackAtEcal {
+    BlockEltSet::iterator it;
+    double pt;
+    float eta, phi;
+    double x, y, z;
+  };
+  std::vector<TrackAtEcal> tracks;
+  std::vector<KDTreeBox<> > trackBoxes;
+
   // We iterate over the tracks.
   for (BlockEltSet::iterator it = targetSet_.begin(); it != targetSet_.end(); it++) {
     reco::PFRecTrackRef trackref = (*it)->trackRefPF();
@@ -156,21 +166,32 @@ void KDTreeLinkerTrackEcal::searchLinks() {
     double trackPt = sqrt(atVertex.momentum().Vect().Perp2());
     float tracketa = atECAL.positionREP().eta();
     float trackphi = atECAL.positionREP().phi();
-    double trackx = atECAL.position().X();
-    double tracky = atECAL.position().Y();
-    double trackz = atECAL.position().Z();
 
     // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
     // Same envelope for cap et barrel rechits.
     float range = cristalPhiEtaMaxSize_ * (2.0 + 1.0 / std::min(1., trackPt / 2.));
 
-    // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
-    std::vector<reco::PFRecHit const *> recHits;
-    KDTreeBox trackBox(tracketa - range, tracketa + range, trackphi - range, trackphi + range);
-    tree_.search(trackBox, recHits);
+    tracks.push_back(
+        {it, trackPt, tracketa, trackphi, atECAL.position().X(), atECAL.position().Y(), atECAL.position().Z()});
+    trackBoxes.emplace_back(tracketa - range, tracketa + range, trackphi - range, trackphi + range);
+  }
+
+  // We search for all candidate recHits, ie all recHits contained in the maximal size envelopes,
+  // of all the tracks at once.
+  std::vector<std::vector<reco::PFRecHit const *> > trackRecHits;
+  tree_.search(trackBoxes, trackRecHits);
+
+  for (unsigned int itrack = 0; itrack < tracks.size(); ++itrack) {
+    BlockEltSet::iterator it = tracks[itrack].it;
+    double trackPt = tracks[itrack].pt;
+    float tracketa = tracks[itrack].eta;
+    float trackphi = tracks[itrack].phi;
+    double trackx = tracks[itrack].x;
+    double tracky = tracks[itrack].y;
+    double trackz = tracks[itrack].z;
 
     // Here we check all rechit candidates using the non-approximated method.
-    for (auto const &recHit : recHits) {
+    for (auto const &recHit : trackRecHits[itrack]) {
       const auto &cornersxyz = recHit->getCornersXYZ();
       const auto &posxyz = recHit->position();
       const auto &rhrep = recHit->positionREP();
@@ -161,6 +161,16 @@ void KDTreeLinkerTrackHcal::buildTree() {
 void KDTreeLinkerTrackHcal::searchLinks() {
   // Must of the code has been taken from LinkByRecHit.cc
 
+  // The tracks reaching hcal, with their impact point
+  struct TrackAtHcal {
+    BlockEltSet::iterator it;
+    float eta, phi;
+    double dHeta;
+    float dHphi;
+  };
+  std::vector<TrackAtHcal> tracks;
+  std::vector<KDTreeBox<> > trackBoxes;
+
   // We iterate over the tracks.
   for (BlockEltSet::iterator it = targetSet_.begin(); it != targetSet_.end(); it++) {
     reco::PFRecTrackRef trackref = (*it)->trackRefPF();
@@ -198,13 +208,24 @@ void KDTreeLinkerTrackHcal::searchLinks() {
     float rangeeta = (cristalPhiEtaMaxSize_ * (1.5 + 0.5) + 0.2 * fabs(dHeta)) * inflation;
     float rangephi = (cristalPhiEtaMaxSize_ * (1.5 + 0.5) + 0.2 * fabs(dHphi)) * inflation;
 
-    // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
-    std::vector<reco::PFRecHit const*> recHits;
-    KDTreeBox trackBox(tracketa - rangeeta, tracketa + rangeeta, trackphi - rangephi, trackphi + rangephi);
-    tree_.search(trackBox, recHits);
+    tracks.push_back({it, tracketa, trackphi, dHeta, dHphi});
+    trackBoxes.emplace_back(tracketa - rangeeta, tracketa + rangeeta, trackphi - rangephi, trackphi + rangephi);
+  }
+
+  // We search for all candidate recHits, ie all recHits contained in the maximal size envelopes,
+  // of all the tracks at once.
+  std::vector<std::vector<reco::PFRecHit const*> > trackRecHits;
+  tree_.search(trackBoxes, trackRecHits);
+
+  for (unsigned int itrack = 0; itrack < tracks.size(); ++itrack) {
+    BlockEltSet::iterator it = tracks[itrack].it;
+    float tracketa = tracks[itrack].eta;
+    float trackphi = tracks[itrack].phi;
+    double dHeta = tracks[itrack].dHeta;
+    float dHphi = tracks[itrack].dHphi;
 
     // Here we check all rechit candidates using the non-approximated method.
-    for (auto const& recHit : recHits) {
+    for (auto const& recHit : trackRecHits[itrack]) {
       const auto& rhrep = recHit->positionREP();
       const auto& corners = recHit->getCornersREP();
 
@@ -13,6 +13,11 @@
 #include <type_traits>
 #include <utility>
 
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
 using namespace std;
 using namespace reco;
 
@@ -144,72 +149,88 @@ reco::PFBlockCollection PFBlockAlgo::findBlocks() {
     kdtree->process();
   }
   // !Glowinski & Gouzevitch
-  reco::PFBlockCollection blocks;
-  // the blocks have not been passed to the event, and need to be cleared
-  blocks.reserve(elements_.size());
 
-  QuickUnion qu(elements_.size());
-  const auto elem_size = elements_.size();
-  for (unsigned i = 0; i < elem_size; ++i) {
-    for (unsigned j = 0; j < elem_size; ++j) {
-      if (qu.connected(i, j) || j == i)
-        continue;
-      if (!linkTests_[linkTestSquare_[elements_[i]->type()][elements_[j]->type()]]) {
-        j = ranges_[elements_[j]->type()].second;
-        continue;
-      }
-      auto p1(elements_[i].get()), p2(elements_[j].get());
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();
-      const unsigned index = linkTestSquare_[type1][type2];
-      if (linkTests_[index]->linkPrefilter(p1, p2)) {
-        const double dist = linkTests_[index]->testLink(p1, p2);
-        // compute linking info if it is possible
-        if (dist > -0.5) {
-          qu.unite(i, j);
+  // The links are searched in parallel over the first element of the pairs. Each
+  // thread keeps its own union-find, to skip the pairs already connected by the
+  // links it found, and the links it found; the blocks are the connected
+  // components of all the links, whatever the threads that found them.
+  const unsigned elem_size = elements_.size();
+  struct Links {
+    QuickUnion qu;
+    std::vector<std::pair<unsigned, unsigned>> links;
+  };
+  tbb::enumerable_thread_specific<Links> threadLinks(Links{QuickUnion(elem_size), {}});
+  tbb::parallel_for(tbb::blocked_range<unsigned>(0, elem_size), [&](const tbb::blocked_range<unsigned>& r) {
+    auto& local = threadLinks.local();
+    for (unsigned i = r.begin(); i != r.end(); ++i) {
+      for (unsigned j = 0; j < elem_size; ++j) {
+        if (local.qu.connected(i, j) || j == i)
+          continue;
+        if (!linkTests_[linkTestSquare_[elements_[i]->type()][elements_[j]->type()]]) {
+          j = ranges_[elements_[j]->type()].second;
+          continue;
+        }
+        auto p1(elements_[i].get()), p2(elements_[j].get());
+        const PFBlockElement::Type type1 = p1->type();
+        const PFBlockElement::Type type2 = p2->type();
+        const unsigned index = linkTestSquare_[type1][type2];
+        if (linkTests_[index]->linkPrefilter(p1, p2)) {
+          const double dist = linkTests_[index]->testLink(p1, p2);
+          // compute linking info if it is possible
+          if (dist > -0.5) {
+            local.qu.unite(i, j);
+            local.links.emplace_back(i, j);
+          }
         }
       }
     }
+  });
+
+  QuickUnion qu(elem_size);
+  for (const auto& local : threadLinks) {
+    for (const auto& link : local.links) {
+      if (!qu.connected(link.first, link.second))
+        qu.unite(link.first, link.second);
+    }
   }
 
-  std::unordered_multimap<unsigned, unsigned> blocksmap(elements_.size());
-  std::vector<unsigned> keys;
-  keys.reserve(elements_.size());
-  for (unsigned i = 0; i < elements_.size(); ++i) {
-    unsigned key = i;
-    while (key != qu.find(key))
-      key = qu.find(key);  // make sure we always find the root node...
-    auto pos = std::lower_bound(keys.begin(), keys.end(), key);
-    if (pos == keys.end() || *pos != key) {
-      keys.insert(pos, key);
+  // The blocks are ordered by their first element, and hold their elements in order
+  std::vector<int> blockOfRoot(elem_size, -1);
+  std::vector<std::vector<unsigned>> blockElements;
+  for (unsigned i = 0; i < elem_size; ++i) {
+    const unsigned root = qu.find(i);
+    if (blockOfRoot[root] < 0) {
+      blockOfRoot[root] = blockElements.size();
+      blockElements.emplace_back();
     }
-    blocksmap.emplace(key, i);
+    blockElements[blockOfRoot[root]].push_back(i);
   }
 
-  for (auto key : keys) {
-    blocks.push_back(reco::PFBlock());
-    auto range = blocksmap.equal_range(key);
-    auto& the_block = blocks.back();
-    ElementList::value_type::pointer p1(elements_[range.first->second].get());
-    the_block.addElement(p1);
-    const unsigned block_size = blocksmap.count(key) + 1;
-    //reserve up to 1M or 8MB; pay rehash cost for more
-    std::unordered_map<std::pair<unsigned int, unsigned int>, double> links(min(1000000u, block_size * block_size));
-    auto itr = range.first;
-    ++itr;
-    for (; itr != range.second; ++itr) {
-      ElementList::value_type::pointer p2(elements_[itr->second].get());
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();
-      the_block.addElement(p2);
-      const unsigned index = linkTestSquare_[type1][type2];
-      if (nullptr != linkTests_[index]) {
-        const double dist = linkTests_[index]->testLink(p1, p2);
-        links.emplace(std::make_pair(p1->index(), p2->index()), dist);
+  // the blocks have not been passed to the event, and need to be cleared
+  reco::PFBlockCollection blocks(blockElements.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, blocks.size()), [&](const tbb::blocked_range<size_t>& r) {
+    for (size_t iblock = r.begin(); iblock != r.end(); ++iblock) {
+      const auto& members = blockElements[iblock];
+      auto& the_block = blocks[iblock];
+      ElementList::value_type::pointer p1(elements_[members.front()].get());
+      the_block.addElement(p1);
+      const unsigned block_size = members.size() + 1;
+      //reserve up to 1M or 8MB; pay rehash cost for more
+      std::unordered_map<std::pair<unsigned int, unsigned int>, double> links(min(1000000u, block_size * block_size));
+      for (auto itr = members.begin() + 1; itr != members.end(); ++itr) {
+        ElementList::value_type::pointer p2(elements_[*itr].get());
+        const PFBlockElement::Type type1 = p1->type();
+        const PFBlockElement::Type type2 = p2->type();
+        the_block.addElement(p2);
+        const unsigned index = linkTestSquare_[type1][type2];
+        if (nullptr != linkTests_[index]) {
+          const double dist = linkTests_[index]->testLink(p1, p2);
+          links.emplace(std::make_pair(p1->index(), p2->index()), dist);
+        }
       }
+      packLinks(the_block, links);
     }
-    packLinks(the_block, links);
-  }
+  });
 
   elements_.clear();
 
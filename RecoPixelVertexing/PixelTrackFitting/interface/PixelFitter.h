@@ -18,6 +18,12 @@ public:
     return fitter_->run(hits, region, setup);
   }
 
+  std::vector<std::unique_ptr<reco::Track>> runBatch(const std::vector<std::vector<const TrackingRecHit*>>& hitSets,
+                                                     const TrackingRegion& region,
+                                                     const edm::EventSetup& setup) const {
+    return fitter_->runBatch(hitSets, region, setup);
+  }
+
 private:
   std::unique_ptr<PixelFitterBase> fitter_;
 };
@@ -19,5 +19,18 @@ public:
   virtual std::unique_ptr<reco::Track> run(const std::vector<const TrackingRecHit*>& hits,
                                            const TrackingRegion& region,
                                            const edm::EventSetup& setup) const = 0;
+
+  // fits all the hit sets of a region at once, one track (or nullptr) per hit set;
+  // by default one after the other
+  virtual std::vector<std::unique_ptr<reco::Track>> runBatch(
+      const std::vector<std::vector<const TrackingRecHit*>>& hitSets,
+      const TrackingRegion& region,
+      const edm::EventSetup& setup) const {
+    std::vector<std::unique_ptr<reco::Track>> tracks;
+    tracks.reserve(hitSets.size());
+    for (const auto& hits : hitSets)
+      tracks.push_back(run(hits, region, setup));
+    return tracks;
+  }
 };
 #endif
@@ -0,0 +1,43 @@
+#ifndef RecoPixelVertexing_PixelTrackFitting_PixelFitterByRiemannFit_H
+#define RecoPixelVertexing_PixelTrackFitting_PixelFitterByRiemannFit_H
+
+#include "RecoPixelVertexing/PixelTrackFitting/interface/PixelFitterBase.h"
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHit.h"
+#include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+#include <vector>
+
+class MagneticField;
+
+/** Fits the hit sets of a region with the Riemann fit of RiemannFit.h:
+ *  the triplets and quadruplets are gathered in arrays of fixed-size
+ *  matrices and fitted in a single loop per size, the longer hit sets
+ *  with dynamic-size matrices. Hit sets of less than 3 hits are not fitted.
+ */
+class PixelFitterByRiemannFit final : public PixelFitterBase {
+public:
+  // radLength: thickness of a pixel layer in radiation lengths, 0 for no multiple scattering
+  PixelFitterByRiemannFit(const MagneticField *field, float radLength);
+  ~PixelFitterByRiemannFit() override {}
+
+  std::unique_ptr<reco::Track> run(const std::vector<const TrackingRecHit *> &hits,
+                                   const TrackingRegion &region,
+                                   const edm::EventSetup &setup) const override;
+
+  std::vector<std::unique_ptr<reco::Track>> runBatch(const std::vector<std::vector<const TrackingRecHit *>> &hitSets,
+                                                     const TrackingRegion &region,
+                                                     const edm::EventSetup &setup) const override;
+
+private:
+  template <int N>
+  void fitBatch(const std::vector<std::vector<const TrackingRecHit *>> &hitSets,
+                const TrackingRegion &region,
+                float fieldInInvGev,
+                std::vector<std::unique_ptr<reco::Track>> &tracks) const;
+
+  const MagneticField *theField;
+  const float theRadLength;
+};
+#endif
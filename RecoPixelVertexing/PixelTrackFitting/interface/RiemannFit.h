@@ -0,0 +1,218 @@
+#ifndef RecoPixelVertexing_PixelTrackFitting_interface_RiemannFit_h
+#define RecoPixelVertexing_PixelTrackFitting_interface_RiemannFit_h
+
+#include <cmath>
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+
+/** The Riemann fit of the hits of a pixel track, written for fixed-size
+ *  Eigen matrices: the same function fits a track in a loop over the tracks
+ *  of an event on the host, or in one thread per track on the GPU.
+ *
+ *  The circle in the transverse plane comes from the plane fitted to the
+ *  hits mapped on the paraboloid z = x^2 + y^2 (Strandlie, Wroldsen,
+ *  Fruhwirth, NIM A 488 (2002) 332), as in FastCircleFit; the line in the
+ *  (s, z) plane, s being the arc length from the point of closest approach
+ *  to (0,0), is a weighted linear fit. With multiple scattering the fit is
+ *  repeated, adding to the hit variances those of the scattering on the
+ *  inner hits for the momentum of the first pass, without the correlations.
+ *
+ *  The hits are the columns of a 3xN matrix (x, y, z) in cm, relative to
+ *  the origin of the region, from the innermost one; N can be
+ *  Eigen::Dynamic. The variances are those of the hits across the track in
+ *  the transverse plane and along z.
+ */
+namespace riemannFit {
+
+  template <int N>
+  using Matrix3xN = Eigen::Matrix<double, 3, N>;
+  template <int N>
+  using VectorN = Eigen::Matrix<double, N, 1>;
+
+  struct Circle {
+    double xc, yc;  // center
+    double radius;  // 0 for a straight line
+    double chi2;
+  };
+
+  struct Line {
+    double cotTheta, zip;
+    Eigen::Matrix2d cov;  // of (zip, cotTheta)
+    double chi2;
+  };
+
+  struct Track {
+    int charge;
+    double pt;  // GeV
+    double phi;
+    double tip;  // cm
+    double cotTheta;
+    double zip;  // cm
+    Eigen::Matrix2d lineCov;
+    double chi2;
+  };
+
+  // the tracks with a larger radius (cm) are fitted as straight lines
+  constexpr double maxRadius = 1.e6;
+
+  // the sign convention of PixelFitterByHelixProjections
+  template <int N>
+  EIGEN_DEVICE_FUNC inline int charge(Matrix3xN<N> const& hits) {
+    double dir = (hits(0, 1) - hits(0, 0)) * (hits(1, 2) - hits(1, 1)) -
+                 (hits(1, 1) - hits(1, 0)) * (hits(0, 2) - hits(0, 1));
+    return dir > 0 ? -1 : 1;
+  }
+
+  template <int N>
+  EIGEN_DEVICE_FUNC inline Circle circleFit(Matrix3xN<N> const& hits, VectorN<N> const& varRPhi) {
+    auto const n = hits.cols();
+    Matrix3xN<N> p(3, n);
+    p.row(0) = hits.row(0);
+    p.row(1) = hits.row(1);
+    p.row(2) = hits.row(0).cwiseAbs2() + hits.row(1).cwiseAbs2();
+    VectorN<N> const w = varRPhi.cwiseInverse() / varRPhi.cwiseInverse().sum();
+
+    Eigen::Vector3d const mean = p * w;
+    Matrix3xN<N> const d = p.colwise() - mean;
+    Eigen::Matrix3d const cov = d * w.asDiagonal() * d.transpose();
+
+    // the normal of the plane is the eigenvector of the smallest eigenvalue
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+    solver.computeDirect(cov);
+    Eigen::Vector3d const normal = solver.eigenvectors().col(0);
+    double const c = -normal.dot(mean);
+
+    Circle circle;
+    if (std::abs(normal(2)) * maxRadius < 1.) {
+      circle.xc = circle.yc = circle.radius = 0;
+      circle.chi2 = 0;
+      return circle;
+    }
+    circle.xc = -normal(0) / (2. * normal(2));
+    circle.yc = -normal(1) / (2. * normal(2));
+    circle.radius = std::sqrt(1. - normal(2) * normal(2) - 4. * c * normal(2)) / (2. * std::abs(normal(2)));
+    circle.chi2 = 0;
+    for (int i = 0; i < n; ++i) {
+      double const dx = hits(0, i) - circle.xc;
+      double const dy = hits(1, i) - circle.yc;
+      double const r = std::sqrt(dx * dx + dy * dy) - circle.radius;
+      circle.chi2 += r * r / varRPhi(i);
+    }
+    return circle;
+  }
+
+  // the arc lengths of the hits from the point of closest approach
+  template <int N>
+  EIGEN_DEVICE_FUNC inline VectorN<N> arcLengths(Matrix3xN<N> const& hits, Circle const& circle) {
+    auto const n = hits.cols();
+    VectorN<N> s(n);
+    if (circle.radius == 0) {
+      double const dx = hits(0, n - 1) - hits(0, 0);
+      double const dy = hits(1, n - 1) - hits(1, 0);
+      double const norm = 1. / std::sqrt(dx * dx + dy * dy);
+      for (int i = 0; i < n; ++i)
+        s(i) = (hits(0, i) * dx + hits(1, i) * dy) * norm;
+      return s;
+    }
+    double const dc = std::sqrt(circle.xc * circle.xc + circle.yc * circle.yc);
+    double const scale = dc > 0 ? 1. - circle.radius / dc : 0.;
+    double const x0 = circle.xc * scale;
+    double const y0 = circle.yc * scale;
+    for (int i = 0; i < n; ++i) {
+      double const dx = hits(0, i) - x0;
+      double const dy = hits(1, i) - y0;
+      double const half = 0.5 * std::sqrt(dx * dx + dy * dy) / circle.radius;
+      s(i) = 2. * circle.radius * std::asin(half < 1. ? half : 1.);
+    }
+    return s;
+  }
+
+  template <int N>
+  EIGEN_DEVICE_FUNC inline Line lineFit(Matrix3xN<N> const& hits, VectorN<N> const& varZ, Circle const& circle) {
+    VectorN<N> const s = arcLengths<N>(hits, circle);
+    VectorN<N> const w = varZ.cwiseInverse();
+
+    Eigen::Matrix2d a;
+    a(0, 0) = w.sum();
+    a(0, 1) = a(1, 0) = w.dot(s);
+    a(1, 1) = w.dot(s.cwiseAbs2());
+    Eigen::Vector2d b;
+    b(0) = w.dot(hits.row(2).transpose());
+    b(1) = w.dot(hits.row(2).transpose().cwiseProduct(s));
+
+    Line line;
+    line.cov = a.inverse();
+    Eigen::Vector2d const x = line.cov * b;
+    line.zip = x(0);
+    line.cotTheta = x(1);
+    VectorN<N> const r = hits.row(2).transpose() - VectorN<N>::Constant(s.size(), line.zip) - line.cotTheta * s;
+    line.chi2 = r.cwiseAbs2().dot(w);
+    return line;
+  }
+
+  // The variances of the hits from the scattering on the inner ones, the
+  // first being on the innermost layer. radLength is the thickness of a
+  // layer in radiation lengths at normal incidence.
+  template <int N>
+  EIGEN_DEVICE_FUNC inline VectorN<N> multipleScattering(Matrix3xN<N> const& hits,
+                                                         double pt,
+                                                         double cotTheta,
+                                                         double radLength) {
+    auto const n = hits.cols();
+    double const p2 = pt * pt * (1. + cotTheta * cotTheta);
+    double const x = radLength * std::sqrt(1. + cotTheta * cotTheta);
+    // Highland formula
+    double const theta = 0.0136 * std::sqrt(x) * (1. + 0.038 * std::log(x));
+    double const theta2 = theta * theta / p2;
+
+    VectorN<N> var = VectorN<N>::Zero(n);
+    for (int j = 0; j < n - 1; ++j) {
+      double const rj = std::sqrt(hits(0, j) * hits(0, j) + hits(1, j) * hits(1, j));
+      for (int i = j + 1; i < n; ++i) {
+        double const d = std::sqrt(hits(0, i) * hits(0, i) + hits(1, i) * hits(1, i)) - rj;
+        var(i) += d * d * theta2;
+      }
+    }
+    return var;
+  }
+
+  // fieldInInvGev as in PixelRecoUtilities; no multiple scattering if radLength is 0
+  template <int N>
+  EIGEN_DEVICE_FUNC inline Track fit(Matrix3xN<N> const& hits,
+                                     VectorN<N> const& varRPhi,
+                                     VectorN<N> const& varZ,
+                                     double fieldInInvGev,
+                                     double radLength) {
+    Track track;
+    track.charge = charge<N>(hits);
+
+    Circle circle = circleFit<N>(hits, varRPhi);
+    Line line = lineFit<N>(hits, varZ, circle);
+    if (radLength > 0) {
+      double const pt = circle.radius > 0 ? circle.radius / fieldInInvGev : 1.e4;
+      VectorN<N> const ms = multipleScattering<N>(hits, pt, line.cotTheta, radLength);
+      circle = circleFit<N>(hits, varRPhi + ms);
+      line = lineFit<N>(hits, varZ + ms * (1. + line.cotTheta * line.cotTheta), circle);
+    }
+
+    if (circle.radius > 0) {
+      track.pt = circle.radius / fieldInInvGev;
+      track.tip = track.charge * (std::sqrt(circle.xc * circle.xc + circle.yc * circle.yc) - circle.radius);
+      track.phi = track.charge > 0 ? std::atan2(circle.xc, -circle.yc) : std::atan2(-circle.xc, circle.yc);
+    } else {
+      auto const n = hits.cols();
+      track.pt = 1.e4;
+      track.phi = std::atan2(hits(1, n - 1) - hits(1, 0), hits(0, n - 1) - hits(0, 0));
+      track.tip = -hits(0, 0) * std::sin(track.phi) + hits(1, 0) * std::cos(track.phi);
+    }
+    track.cotTheta = line.cotTheta;
+    track.zip = line.zip;
+    track.lineCov = line.cov;
+    track.chi2 = circle.chi2 + line.chi2;
+    return track;
+  }
+
+}  // namespace riemannFit
+
+#endif
@@ -0,0 +1,50 @@
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "RecoPixelVertexing/PixelTrackFitting/interface/PixelFitter.h"
+#include "RecoPixelVertexing/PixelTrackFitting/interface/PixelFitterByRiemannFit.h"
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+class PixelFitterByRiemannFitProducer : public edm::global::EDProducer<> {
+public:
+  explicit PixelFitterByRiemannFitProducer(const edm::ParameterSet& iConfig)
+      : theRadLength(iConfig.getParameter<double>("radLengthPerLayer")) {
+    produces<PixelFitter>();
+  }
+  ~PixelFitterByRiemannFitProducer() override {}
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<double>("radLengthPerLayer", 0.02)
+        ->setComment("Thickness of a pixel layer in radiation lengths, 0 to fit without multiple scattering");
+    descriptions.add("pixelFitterByRiemannFitDefault", desc);
+  }
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+  const float theRadLength;
+};
+
+void PixelFitterByRiemannFitProducer::produce(edm::StreamID,
+                                              edm::Event& iEvent,
+                                              const edm::EventSetup& iSetup) const {
+  edm::ESHandle<MagneticField> fieldESH;
+  iSetup.get<IdealMagneticFieldRecord>().get(fieldESH);
+
+  auto impl = std::make_unique<PixelFitterByRiemannFit>(fieldESH.product(), theRadLength);
+  auto prod = std::make_unique<PixelFitter>(std::move(impl));
+  iEvent.put(std::move(prod));
+}
+
+DEFINE_FWK_MODULE(PixelFitterByRiemannFitProducer);
@@ -0,0 +1,116 @@
+#include "RecoPixelVertexing/PixelTrackFitting/interface/PixelFitterByRiemannFit.h"
+
+#include "DataFormats/GeometryCommonDetAlgo/interface/GlobalError.h"
+#include "DataFormats/GeometryCommonDetAlgo/interface/Measurement1D.h"
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+#include "Geometry/CommonDetUnit/interface/GeomDet.h"
+#include "Geometry/CommonDetUnit/interface/GeomDetType.h"
+#include "RecoPixelVertexing/PixelTrackFitting/interface/PixelTrackBuilder.h"
+#include "RecoPixelVertexing/PixelTrackFitting/interface/PixelTrackErrorParam.h"
+#include "RecoPixelVertexing/PixelTrackFitting/interface/RiemannFit.h"
+#include "RecoTracker/TkMSParametrization/interface/PixelRecoUtilities.h"
+
+#include <Eigen/StdVector>
+
+#include <cmath>
+
+namespace {
+
+  template <int N>
+  bool hasSize(std::size_t nHits) {
+    return N == Eigen::Dynamic ? nHits > 4 : nHits == std::size_t(N);
+  }
+
+  // the hits relative to the origin of the region, and their variances across the track and along z
+  template <int N>
+  void prepare(const std::vector<const TrackingRecHit*>& hits,
+               const TrackingRegion& region,
+               riemannFit::Matrix3xN<N>& points,
+               riemannFit::VectorN<N>& varRPhi,
+               riemannFit::VectorN<N>& varZ) {
+    const int nHits = hits.size();
+    points.resize(3, nHits);
+    varRPhi.resize(nHits);
+    varZ.resize(nHits);
+    for (int i = 0; i < nHits; ++i) {
+      GlobalPoint p(hits[i]->globalPosition().basicVector() - region.origin().basicVector());
+      points(0, i) = p.x();
+      points(1, i) = p.y();
+      points(2, i) = p.z();
+    }
+
+    // as in RZLine, the r errors of the forward hits are converted to z errors with a simple cotTheta
+    const double dr = std::hypot(points(0, nHits - 1), points(1, nHits - 1)) - std::hypot(points(0, 0), points(1, 0));
+    const double simpleCot = std::abs(dr) > 1.e-3 ? (points(2, nHits - 1) - points(2, 0)) / dr : 0.;
+    for (int i = 0; i < nHits; ++i) {
+      const GlobalPoint p(points(0, i), points(1, i), points(2, i));
+      const GlobalError e = hits[i]->globalPositionError();
+      varRPhi(i) = e.phierr(p) * p.perp2();
+      varZ(i) = hits[i]->detUnit()->type().isBarrel() ? e.czz() : e.rerr(p) * simpleCot * simpleCot;
+    }
+  }
+
+}  // namespace
+
+PixelFitterByRiemannFit::PixelFitterByRiemannFit(const MagneticField* field, float radLength)
+    : theField(field), theRadLength(radLength) {}
+
+std::unique_ptr<reco::Track> PixelFitterByRiemannFit::run(const std::vector<const TrackingRecHit*>& hits,
+                                                          const TrackingRegion& region,
+                                                          const edm::EventSetup& setup) const {
+  return std::move(runBatch({hits}, region, setup).front());
+}
+
+std::vector<std::unique_ptr<reco::Track>> PixelFitterByRiemannFit::runBatch(
+    const std::vector<std::vector<const TrackingRecHit*>>& hitSets,
+    const TrackingRegion& region,
+    const edm::EventSetup& setup) const {
+  std::vector<std::unique_ptr<reco::Track>> tracks(hitSets.size());
+  const float fieldInInvGev = PixelRecoUtilities::fieldInInvGev(setup);
+  fitBatch<3>(hitSets, region, fieldInInvGev, tracks);
+  fitBatch<4>(hitSets, region, fieldInInvGev, tracks);
+  fitBatch<Eigen::Dynamic>(hitSets, region, fieldInInvGev, tracks);
+  return tracks;
+}
+
+template <int N>
+void PixelFitterByRiemannFit::fitBatch(const std::vector<std::vector<const TrackingRecHit*>>& hitSets,
+                                       const TrackingRegion& region,
+                                       float fieldInInvGev,
+                                       std::vector<std::unique_ptr<reco::Track>>& tracks) const {
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < hitSets.size(); ++i) {
+    if (hasSize<N>(hitSets[i].size()))
+      indices.push_back(i);
+  }
+  if (indices.empty())
+    return;
+
+  // the inputs of all the fits first, then the fits in a loop free of the hit interfaces
+  const unsigned int nFits = indices.size();
+  std::vector<riemannFit::Matrix3xN<N>, Eigen::aligned_allocator<riemannFit::Matrix3xN<N>>> points(nFits);
+  std::vector<riemannFit::VectorN<N>, Eigen::aligned_allocator<riemannFit::VectorN<N>>> varRPhi(nFits);
+  std::vector<riemannFit::VectorN<N>, Eigen::aligned_allocator<riemannFit::VectorN<N>>> varZ(nFits);
+  for (unsigned int k = 0; k < nFits; ++k)
+    prepare<N>(hitSets[indices[k]], region, points[k], varRPhi[k], varZ[k]);
+
+  std::vector<riemannFit::Track, Eigen::aligned_allocator<riemannFit::Track>> fits(nFits);
+  for (unsigned int k = 0; k < nFits; ++k)
+    fits[k] = riemannFit::fit<N>(points[k], varRPhi[k], varZ[k], fieldInInvGev, theRadLength);
+
+  PixelTrackBuilder builder;
+  for (unsigned int k = 0; k < nFits; ++k) {
+    const auto& fit = fits[k];
+    const float valEta = std::asinh(fit.cotTheta);
+    PixelTrackErrorParam param(valEta, fit.pt);
+
+    Measurement1D pt(fit.pt, param.errPt());
+    Measurement1D phi(fit.phi, param.errPhi());
+    Measurement1D cotTheta(fit.cotTheta, std::sqrt(fit.lineCov(1, 1)));
+    Measurement1D tip(fit.tip, param.errTip());
+    Measurement1D zip(fit.zip, std::sqrt(fit.lineCov(0, 0)));
+
+    tracks[indices[k]].reset(builder.build(
+        pt, phi, cotTheta, tip, zip, fit.chi2, fit.charge, hitSets[indices[k]], theField, region.origin()));
+  }
+}
@@ -1,3 +1,4 @@
+#include <iterator>
 #include <vector>
 
 #include "DataFormats/TrackReco/interface/Track.h"
@@ -55,20 +56,29 @@ void PixelTrackReconstruction::run(TracksWithTTRHs& tracks, edm::Event& ev, cons
     filter = hfilter.product();
   }
 
-  std::vector<const TrackingRecHit*> hits;
-  hits.reserve(4);
+  // the hit sets of a region are fitted at once, the vectors are reused from one region to the next
+  std::vector<std::vector<const TrackingRecHit*>> tupletHits;
   for (const auto& regionHitSets : hitSets) {
     const TrackingRegion& region = regionHitSets.region();
 
+    // the fitters take the hits as vectors, not as SeedingHitSets
+    tupletHits.resize(std::distance(regionHitSets.begin(), regionHitSets.end()));
+    unsigned int iTuplet = 0;
     for (const SeedingHitSet& tuplet : regionHitSets) {
-      /// FIXME at some point we need to migrate the fitter...
+      auto& hits = tupletHits[iTuplet++];
       auto nHits = tuplet.size();
       hits.resize(nHits);
       for (unsigned int iHit = 0; iHit < nHits; ++iHit)
         hits[iHit] = tuplet[iHit];
+    }
+
+    // fitting
+    std::vector<std::unique_ptr<reco::Track>> fitted = fitter.runBatch(tupletHits, region, es);
 
-      // fitting
-      std::unique_ptr<reco::Track> track = fitter.run(hits, region, es);
+    iTuplet = 0;
+    for (const SeedingHitSet& tuplet : regionHitSets) {
+      const auto& hits = tupletHits[iTuplet];
+      std::unique_ptr<reco::Track> track = std::move(fitted[iTuplet++]);
       if (!track)
         continue;
 
@@ -0,0 +1,66 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include "RecoPixelVertexing/PixelTrackFitting/interface/RiemannFit.h"
+
+namespace {
+
+  constexpr double bField = 3.8;
+  constexpr double fieldInInvGev = 1. / (0.0029979 * bField);
+
+  // the hits on the barrel layers of a track from (0, 0, z0)
+  template <int N>
+  riemannFit::Matrix3xN<N> makeHits(int n, double pt, double phi0, double cotTheta, double z0, int charge) {
+    constexpr double radii[] = {2.9, 6.8, 10.9, 16.0, 22.0};
+    double const R = pt * fieldInInvGev;
+    riemannFit::Matrix3xN<N> hits(3, n);
+    for (int i = 0; i < n; ++i) {
+      double const r = radii[i];
+      // positive tracks turn clockwise
+      double const phi = phi0 - charge * std::asin(0.5 * r / R);
+      double const s = 2. * R * std::asin(0.5 * r / R);
+      hits(0, i) = r * std::cos(phi);
+      hits(1, i) = r * std::sin(phi);
+      hits(2, i) = z0 + s * cotTheta;
+    }
+    return hits;
+  }
+
+  template <int N>
+  void check(int n, double pt, double phi0, double cotTheta, double z0, int charge, double radLength) {
+    auto const hits = makeHits<N>(n, pt, phi0, cotTheta, z0, charge);
+    riemannFit::VectorN<N> const var = riemannFit::VectorN<N>::Constant(n, 1.e-6);
+    auto const track = riemannFit::fit<N>(hits, var, var, fieldInInvGev, radLength);
+    std::cout << n << " hits: pt " << track.pt << " phi " << track.phi << " cotTheta " << track.cotTheta << " tip "
+              << track.tip << " zip " << track.zip << " charge " << track.charge << " chi2 " << track.chi2
+              << std::endl;
+    assert(track.charge == charge);
+    assert(std::abs(track.pt - pt) < 1.e-3 * pt);
+    assert(std::abs(track.phi - phi0) < 1.e-4);
+    assert(std::abs(track.cotTheta - cotTheta) < 1.e-4);
+    assert(std::abs(track.tip) < 1.e-3);
+    assert(std::abs(track.zip - z0) < 1.e-3);
+    assert(track.chi2 < 1.e-3);
+  }
+
+}  // namespace
+
+int main() {
+  check<3>(3, 1.5, 0.4, 0.5, 1.2, 1, 0.);
+  check<4>(4, 10., -2.5, -1.2, -3., -1, 0.);
+  check<4>(4, 0.8, 3.0, 2., 0., 1, 0.02);
+  check<Eigen::Dynamic>(5, 3., 1., 0.1, 5., -1, 0.02);
+
+  // a straight line
+  riemannFit::Matrix3xN<4> hits;
+  hits << 3., 7., 11., 16., 0., 0., 0., 0., 1., 2., 3., 4.25;
+  riemannFit::VectorN<4> const var = riemannFit::VectorN<4>::Constant(1.e-6);
+  auto const track = riemannFit::fit<4>(hits, var, var, fieldInInvGev, 0.);
+  assert(track.pt > 1.e3);
+  assert(std::abs(track.phi) < 1.e-6);
+  assert(std::abs(track.cotTheta - 0.25) < 1.e-6);
+  assert(std::abs(track.zip - 0.25) < 1.e-6);
+
+  return 0;
+}
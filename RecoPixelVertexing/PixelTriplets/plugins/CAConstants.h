@@ -0,0 +1,57 @@
+#ifndef RecoPixelVertexing_PixelTriplets_plugins_CAConstants_h
+#define RecoPixelVertexing_PixelTriplets_plugins_CAConstants_h
+
+#include <cstdint>
+
+#include "Geometry/TrackerGeometryBuilder/interface/phase1PixelTopology.h"
+
+#if defined(__CUDACC__)
+#define CA_HOST_DEVICE __host__ __device__
+#else
+#define CA_HOST_DEVICE
+#endif
+
+// The capacities and the layer pairs of the cellular automaton on the phase-1 pixel hits
+namespace caConstants {
+
+  // the cells beyond these capacities are dropped
+  constexpr uint32_t maxCells = 256 * 1024;
+  constexpr uint32_t maxCellsPerHit = 16;  // cells having a hit as outer hit
+  constexpr uint32_t maxCellNeighbors = 16;  // compatible outer cells of a cell
+
+  // the hits of each layer are binned in phi for the doublet search
+  constexpr uint32_t nPhiBins = 128;
+  constexpr uint32_t nPhiBinOffsets = phase1PixelTopology::numberOfLayers * nPhiBins + 1;
+
+  // outer radius of the pixel detector (cm), bounds the phi window of the doublets
+  constexpr float maxPixelRadius = 16.5f;
+
+  // the layer pairs of the doublets, as the quadruplet seeding layers of HLT:
+  // 0-3 are the barrel layers, 4-6 the disks at negative z, 7-9 those at positive z
+  constexpr uint32_t nPairs = 13;
+
+  CA_HOST_DEVICE inline uint32_t pairInnerLayer(uint32_t pair) {
+    constexpr uint8_t inner[nPairs] = {0, 0, 0, 1, 1, 1, 4, 7, 2, 2, 2, 5, 8};
+    return inner[pair];
+  }
+
+  CA_HOST_DEVICE inline uint32_t pairOuterLayer(uint32_t pair) {
+    constexpr uint8_t outer[nPairs] = {1, 4, 7, 2, 4, 7, 5, 8, 3, 4, 7, 6, 9};
+    return outer[pair];
+  }
+
+  // the ntuplets start from a cell on the first barrel layer
+  CA_HOST_DEVICE inline bool isRootPair(uint32_t pair) { return pairInnerLayer(pair) == 0; }
+
+  // on the host the counters are incremented by a single thread
+  CA_HOST_DEVICE inline uint32_t atomicIncrement(uint32_t* counter) {
+#if defined(__CUDA_ARCH__)
+    return atomicAdd(counter, 1u);
+#else
+    return (*counter)++;
+#endif
+  }
+
+}  // namespace caConstants
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletAlgos_h
+#define RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletAlgos_h
+
+#include <cmath>
+#include <cstdint>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+
+#include "CAConstants.h"
+#include "GPUCACell.h"
+
+// The steps of the cellular automaton on the phase-1 pixel hits, shared by the
+// CUDA kernels and the CPU implementation. Each step loops over its elements
+// from first with the given stride: the global thread index and the size of the
+// grid in a kernel, 0 and 1 on the host. The steps must run in this order, each
+// one after all the threads of the previous one are done:
+//   countPhiBins, scanPhiBins, fillPhiBins, getDoublets, connectCells, findNtuplets, fastFit
+namespace caHitNtuplet {
+
+  // the global positions of the hits, ordered by module, then layer
+  struct HitsView {
+    float const* xg;
+    float const* yg;
+    float const* zg;
+    uint16_t const* detIndex;
+    uint32_t const* hitsModuleStart;  // nModules+1 entries
+
+    CA_HOST_DEVICE uint32_t nHits() const { return hitsModuleStart[phase1PixelTopology::numberOfModules]; }
+  };
+
+  struct CellList {
+    uint32_t n;
+    uint32_t cells[caConstants::maxCellsPerHit];
+  };
+
+  // maxHits is the size of the arrays indexed by hit; the counters
+  // (phiBinOffsets, nCells, the n of outerHitOfCell, tracks->nFound) start at 0
+  struct Workspace {
+    float* hitPhi;            // maxHits
+    uint32_t* phiBinOffsets;  // nPhiBinOffsets
+    uint32_t* phiBinFill;     // nPhiBinOffsets - 1
+    uint32_t* phiBinHits;     // maxHits
+    GPUCACell* cells;         // maxCells
+    uint32_t* nCells;
+    CellList* outerHitOfCell;  // maxHits
+    PixelTrackSoA* tracks;
+  };
+
+  struct Params {
+    uint32_t minHitsPerNtuplet;  // 3 or 4
+    float ptmin;                 // GeV
+    float ptCoeff;               // 0.003 * B (T), the pt in GeV of a radius of 1 cm
+    float originRadius;          // cm
+    float originHalfLength;      // cm
+    float doubletPhiMargin;      // rad
+    float CAThetaCut;
+    float CAPhiCut;
+    float CAHardPtCut;
+  };
+
+  CA_HOST_DEVICE inline uint32_t phiBin(float phi) {
+    constexpr float pi = M_PI;
+    int bin = int((phi + pi) * (caConstants::nPhiBins / (2.f * pi)));
+    return bin < 0 ? 0 : (bin >= int(caConstants::nPhiBins) ? caConstants::nPhiBins - 1 : bin);
+  }
+
+  CA_HOST_DEVICE inline float deltaPhi(float phi1, float phi2) {
+    constexpr float pi = M_PI;
+    float dphi = phi1 - phi2;
+    if (dphi > pi)
+      dphi -= 2.f * pi;
+    else if (dphi < -pi)
+      dphi += 2.f * pi;
+    return dphi;
+  }
+
+  // the phi covered from the beam line to radius r by a track of radius R
+  CA_HOST_DEVICE inline float bending(float r, float R) {
+    float s = 0.5f * r / R;
+    return std::asin(s < 1.f ? s : 1.f);
+  }
+
+  CA_HOST_DEVICE inline void countPhiBins(HitsView hits, Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const nHits = hits.nHits();
+    for (uint32_t i = first; i < nHits; i += stride) {
+      float phi = std::atan2(hits.yg[i], hits.xg[i]);
+      ws.hitPhi[i] = phi;
+      uint32_t layer = phase1PixelTopology::findLayer(hits.detIndex[i]);
+      caConstants::atomicIncrement(&ws.phiBinOffsets[layer * caConstants::nPhiBins + phiBin(phi) + 1]);
+    }
+  }
+
+  // by a single thread
+  CA_HOST_DEVICE inline void scanPhiBins(Workspace ws) {
+    for (uint32_t k = 1; k < caConstants::nPhiBinOffsets; ++k) {
+      ws.phiBinOffsets[k] += ws.phiBinOffsets[k - 1];
+      ws.phiBinFill[k - 1] = ws.phiBinOffsets[k - 1];
+    }
+  }
+
+  CA_HOST_DEVICE inline void fillPhiBins(HitsView hits, Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const nHits = hits.nHits();
+    for (uint32_t i = first; i < nHits; i += stride) {
+      uint32_t layer = phase1PixelTopology::findLayer(hits.detIndex[i]);
+      uint32_t bin = layer * caConstants::nPhiBins + phiBin(ws.hitPhi[i]);
+      ws.phiBinHits[caConstants::atomicIncrement(&ws.phiBinFill[bin])] = i;
+    }
+  }
+
+  // The doublets of each inner hit: the outer hits within the phi window of the tracks
+  // above ptmin, pointing to the beam line within originHalfLength in z
+  CA_HOST_DEVICE inline void getDoublets(HitsView hits, Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const nHits = hits.nHits();
+    float const R = params.ptmin / params.ptCoeff;
+    for (uint32_t i = first; i < nHits; i += stride) {
+      uint32_t const innerLayer = phase1PixelTopology::findLayer(hits.detIndex[i]);
+      float const xi = hits.xg[i];
+      float const yi = hits.yg[i];
+      float const zi = hits.zg[i];
+      float const ri = std::sqrt(xi * xi + yi * yi);
+      float const phii = ws.hitPhi[i];
+      float const bendingi = bending(ri, R);
+      float const maxWindow = bending(caConstants::maxPixelRadius, R) - bendingi + params.doubletPhiMargin;
+      int const width = int(maxWindow * (caConstants::nPhiBins / (2.f * float(M_PI)))) + 1;
+      int const nBins = 2 * width + 1 < int(caConstants::nPhiBins) ? 2 * width + 1 : caConstants::nPhiBins;
+      int const firstBin = int(phiBin(phii)) - (nBins == int(caConstants::nPhiBins) ? 0 : width);
+
+      for (uint32_t pair = 0; pair < caConstants::nPairs; ++pair) {
+        if (caConstants::pairInnerLayer(pair) != innerLayer)
+          continue;
+        uint32_t const offset = caConstants::pairOuterLayer(pair) * caConstants::nPhiBins;
+        for (int k = 0; k < nBins; ++k) {
+          uint32_t const bin = offset + (firstBin + k + caConstants::nPhiBins) % caConstants::nPhiBins;
+          for (uint32_t p = ws.phiBinOffsets[bin]; p < ws.phiBinOffsets[bin + 1]; ++p) {
+            uint32_t const o = ws.phiBinHits[p];
+            float const xo = hits.xg[o];
+            float const yo = hits.yg[o];
+            float const zo = hits.zg[o];
+            float const ro = std::sqrt(xo * xo + yo * yo);
+            if (ro <= ri)
+              continue;
+            float const window = bending(ro, R) - bendingi + params.doubletPhiMargin;
+            if (std::abs(deltaPhi(ws.hitPhi[o], phii)) > window)
+              continue;
+            float const z0 = zi - ri * (zo - zi) / (ro - ri);
+            if (std::abs(z0) > params.originHalfLength)
+              continue;
+
+            uint32_t const c = caConstants::atomicIncrement(ws.nCells);
+            if (c >= caConstants::maxCells)
+              continue;
+            auto& cell = ws.cells[c];
+            cell.innerHit = i;
+            cell.outerHit = o;
+            cell.layerPair = pair;
+            cell.innerX = xi;
+            cell.innerY = yi;
+            cell.innerZ = zi;
+            cell.innerR = ri;
+            cell.outerX = xo;
+            cell.outerY = yo;
+            cell.outerZ = zo;
+            cell.outerR = ro;
+            cell.nOuterNeighbors = 0;
+            auto& list = ws.outerHitOfCell[o];
+            uint32_t const n = caConstants::atomicIncrement(&list.n);
+            if (n < caConstants::maxCellsPerHit)
+              list.cells[n] = c;
+          }
+        }
+      }
+    }
+  }
+
+  CA_HOST_DEVICE inline uint32_t numberOfCells(Workspace ws) {
+    return *ws.nCells < caConstants::maxCells ? *ws.nCells : caConstants::maxCells;
+  }
+
+  // Each cell is tagged as outer neighbour of the compatible cells ending on its inner hit,
+  // as in CellularAutomaton::createAndConnectCells
+  CA_HOST_DEVICE inline void connectCells(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const nCells = numberOfCells(ws);
+    for (uint32_t c = first; c < nCells; c += stride) {
+      auto const& cell = ws.cells[c];
+      auto const& list = ws.outerHitOfCell[cell.innerHit];
+      uint32_t const n = list.n < caConstants::maxCellsPerHit ? list.n : caConstants::maxCellsPerHit;
+      for (uint32_t k = 0; k < n; ++k) {
+        auto& innerCell = ws.cells[list.cells[k]];
+        if (cell.areAlignedRZ(innerCell, params.ptmin, params.CAThetaCut) &&
+            cell.haveSimilarCurvature(
+                innerCell, params.ptmin, params.originRadius, params.CAPhiCut, params.CAHardPtCut, params.ptCoeff))
+          innerCell.addOuterNeighbor(c);
+      }
+    }
+  }
+
+  // All the paths of minHitsPerNtuplet-1 connected cells starting from a root cell,
+  // as CACell::findNtuplets
+  CA_HOST_DEVICE inline void findNtuplets(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    constexpr uint32_t maxDepth = PixelTrackSoA::maxHitsPerTrack - 1;
+    uint32_t const nCells = numberOfCells(ws);
+    uint32_t const depth = params.minHitsPerNtuplet - 1;
+    for (uint32_t c = first; c < nCells; c += stride) {
+      if (!caConstants::isRootPair(ws.cells[c].layerPair))
+        continue;
+      uint32_t path[maxDepth];
+      uint32_t next[maxDepth];
+      path[0] = c;
+      next[0] = 0;
+      uint32_t size = 1;
+      while (size > 0) {
+        if (size == depth) {
+          uint32_t const t = caConstants::atomicIncrement(&ws.tracks->nFound);
+          if (t < PixelTrackSoA::maxTracks) {
+            for (uint32_t k = 0; k < size; ++k)
+              ws.tracks->hitIndices[t][k] = ws.cells[path[k]].innerHit;
+            ws.tracks->hitIndices[t][size] = ws.cells[path[size - 1]].outerHit;
+            ws.tracks->nHits[t] = size + 1;
+          }
+          --size;
+          continue;
+        }
+        auto const& cell = ws.cells[path[size - 1]];
+        uint32_t const k = next[size - 1]++;
+        if (k < cell.numberOfOuterNeighbors()) {
+          path[size] = cell.outerNeighbors[k];
+          next[size] = 0;
+          ++size;
+        } else {
+          --size;
+        }
+      }
+    }
+  }
+
+  // The circle through the first, a middle and the last hits in the transverse plane,
+  // and the straight line through the first and last hits in r-z
+  CA_HOST_DEVICE inline void fastFit(HitsView hits, Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    auto& tracks = *ws.tracks;
+    uint32_t const nTracks = tracks.nTracks();
+    for (uint32_t t = first; t < nTracks; t += stride) {
+      uint32_t const n = tracks.nHits[t];
+      uint32_t const h1 = tracks.hitIndices[t][0];
+      uint32_t const h2 = tracks.hitIndices[t][n / 2];
+      uint32_t const h3 = tracks.hitIndices[t][n - 1];
+      float const x1 = hits.xg[h1], y1 = hits.yg[h1], z1 = hits.zg[h1];
+      float const x2 = hits.xg[h2], y2 = hits.yg[h2];
+      float const x3 = hits.xg[h3], y3 = hits.yg[h3], z3 = hits.zg[h3];
+
+      // counter-clockwise for the negative tracks in the field along +z
+      float const cross = (x2 - x1) * (y3 - y2) - (y2 - y1) * (x3 - x2);
+      float const det = (x1 - x2) * (y2 - y3) - (x2 - x3) * (y1 - y2);
+      // the direction of the track at the point of closest approach
+      float radius, dca, tx, ty;
+      if (std::abs(det) > 1.e-6f) {
+        float const offset = x2 * x2 + y2 * y2;
+        float const bc = (x1 * x1 + y1 * y1 - offset) * 0.5f;
+        float const cd = (offset - x3 * x3 - y3 * y3) * 0.5f;
+        float const xc = (bc * (y2 - y3) - cd * (y1 - y2)) / det;
+        float const yc = (cd * (x1 - x2) - bc * (x2 - x3)) / det;
+        radius = std::sqrt((x1 - xc) * (x1 - xc) + (y1 - yc) * (y1 - yc));
+        float const dc = std::sqrt(xc * xc + yc * yc);
+        dca = dc - radius;
+        // from the centre to the point of closest approach
+        float const ux = -xc / dc;
+        float const uy = -yc / dc;
+        tx = cross > 0 ? -uy : uy;
+        ty = cross > 0 ? ux : -ux;
+      } else {
+        // a straight line
+        radius = 1.e6f;
+        float const dx = x3 - x1, dy = y3 - y1;
+        float const d = std::sqrt(dx * dx + dy * dy);
+        dca = std::abs(x1 * dy - y1 * dx) / d;
+        tx = dx / d;
+        ty = dy / d;
+      }
+
+      float const r1 = std::sqrt(x1 * x1 + y1 * y1);
+      float const r3 = std::sqrt(x3 * x3 + y3 * y3);
+      float const cotTheta = (z3 - z1) / (r3 - r1);
+
+      tracks.pt[t] = params.ptCoeff * radius;
+      tracks.phi[t] = std::atan2(ty, tx);
+      tracks.eta[t] = std::asinh(cotTheta);
+      tracks.tip[t] = dca;
+      tracks.zip[t] = z1 - r1 * cotTheta;
+      tracks.charge[t] = cross > 0 ? -1 : 1;
+    }
+  }
+
+}  // namespace caHitNtuplet
+
+#endif
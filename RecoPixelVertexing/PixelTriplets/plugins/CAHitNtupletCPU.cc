@@ -0,0 +1,124 @@
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHitCollection.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+#include "CAHitNtupletGeneratorOnCPU.h"
+#include "CAHitNtupletParams.h"
+
+/**
+ * Builds the pixel triplets or quadruplets of CAHitNtupletCUDA on the host,
+ * from the pixel rechits of SiPixelRecHitConverter, into the same
+ * PixelTrackSoA. The modules are indexed as the detUnits of the geometry,
+ * and the hit indices of the tracks follow the modules in that order and
+ * the rechits of a module in the order of the collection.
+ */
+class CAHitNtupletCPU : public edm::stream::EDProducer<> {
+public:
+  explicit CAHitNtupletCPU(const edm::ParameterSet& iConfig);
+  ~CAHitNtupletCPU() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<SiPixelRecHitCollection> hitGetToken_;
+  edm::EDPutTokenT<PixelTrackSoA> trackPutToken_;
+  edm::ESGetToken<TrackerGeometry, TrackerDigiGeometryRecord> geometryToken_;
+  edm::ESGetToken<MagneticField, IdealMagneticFieldRecord> fieldToken_;
+
+  caHitNtuplet::Params params_;
+  CAHitNtupletGeneratorOnCPU generator_;
+
+  edm::ESWatcher<TrackerDigiGeometryRecord> geometryWatcher_;
+  std::unordered_map<uint32_t, uint16_t> moduleIndex_;
+
+  // the hits in the layout of TrackingRecHit2DCUDA
+  std::vector<float> xg_, yg_, zg_;
+  std::vector<uint16_t> detIndex_;
+  std::vector<uint32_t> hitsModuleStart_;
+  std::vector<SiPixelRecHitCollection::const_iterator> modules_;
+};
+
+CAHitNtupletCPU::CAHitNtupletCPU(const edm::ParameterSet& iConfig)
+    : hitGetToken_(consumes<SiPixelRecHitCollection>(iConfig.getParameter<edm::InputTag>("src"))),
+      trackPutToken_(produces<PixelTrackSoA>()),
+      geometryToken_(esConsumes<TrackerGeometry, TrackerDigiGeometryRecord>()),
+      fieldToken_(esConsumes<MagneticField, IdealMagneticFieldRecord>()),
+      params_(caHitNtuplet::makeParams(iConfig)) {}
+
+void CAHitNtupletCPU::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("siPixelRecHits"));
+  caHitNtuplet::fillParamsDescription(desc);
+  descriptions.add("caHitNtupletCPU", desc);
+}
+
+void CAHitNtupletCPU::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  if (geometryWatcher_.check(iSetup)) {
+    auto const& detUnits = iSetup.getData(geometryToken_).detUnits();
+    if (detUnits.size() < phase1PixelTopology::numberOfModules) {
+      throw cms::Exception("LogicError") << "The cellular automaton runs on the "
+                                         << phase1PixelTopology::numberOfModules
+                                         << " modules of the phase-1 pixel detector, the geometry has "
+                                         << detUnits.size() << " modules";
+    }
+    moduleIndex_.clear();
+    for (uint16_t m = 0; m < phase1PixelTopology::numberOfModules; ++m)
+      moduleIndex_[detUnits[m]->geographicalId().rawId()] = m;
+  }
+  caHitNtuplet::setField(params_, 0.1f * iSetup.getData(fieldToken_).nominalValue());
+
+  auto const& input = iEvent.get(hitGetToken_);
+
+  modules_.assign(phase1PixelTopology::numberOfModules, input.end());
+  for (auto detSet = input.begin(); detSet != input.end(); ++detSet) {
+    auto index = moduleIndex_.find(detSet->detId());
+    if (index == moduleIndex_.end()) {
+      throw cms::Exception("LogicError") << "The rechits of " << detSet->detId()
+                                         << " are not on a module of the phase-1 pixel detector";
+    }
+    modules_[index->second] = detSet;
+  }
+
+  xg_.clear();
+  yg_.clear();
+  zg_.clear();
+  detIndex_.clear();
+  hitsModuleStart_.assign(phase1PixelTopology::numberOfModules + 1, 0);
+  for (uint16_t m = 0; m < phase1PixelTopology::numberOfModules; ++m) {
+    if (modules_[m] != input.end()) {
+      for (auto const& hit : *modules_[m]) {
+        auto const position = hit.globalPosition();
+        xg_.push_back(position.x());
+        yg_.push_back(position.y());
+        zg_.push_back(position.z());
+        detIndex_.push_back(m);
+      }
+    }
+    hitsModuleStart_[m + 1] = detIndex_.size();
+  }
+
+  caHitNtuplet::HitsView const hits{xg_.data(), yg_.data(), zg_.data(), detIndex_.data(), hitsModuleStart_.data()};
+  auto output = std::make_unique<PixelTrackSoA>();
+  generator_.makeTracks(hits, detIndex_.size(), params_, *output);
+  iEvent.put(trackPutToken_, std::move(output));
+}
+
+DEFINE_FWK_MODULE(CAHitNtupletCPU);
@@ -0,0 +1,65 @@
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/Track/interface/PixelTrackCUDA.h"
+#include "CUDADataFormats/TrackingRecHit/interface/TrackingRecHit2DCUDA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+#include "CAHitNtupletGeneratorOnGPU.h"
+#include "CAHitNtupletParams.h"
+
+/**
+ * Builds the pixel triplets or quadruplets of the cellular automaton from
+ * the pixel rechits on the GPU, and fits them with the fast circle and
+ * line fit. The tracks stay on the device, PixelTrackSoAFromCUDA copies
+ * them to the host.
+ */
+class CAHitNtupletCUDA : public edm::stream::EDProducer<> {
+public:
+  explicit CAHitNtupletCUDA(const edm::ParameterSet& iConfig);
+  ~CAHitNtupletCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<TrackingRecHit2DCUDA>> hitGetToken_;
+  edm::EDPutTokenT<cms::cuda::Product<PixelTrackCUDA>> trackPutToken_;
+  edm::ESGetToken<MagneticField, IdealMagneticFieldRecord> fieldToken_;
+
+  caHitNtuplet::Params params_;
+};
+
+CAHitNtupletCUDA::CAHitNtupletCUDA(const edm::ParameterSet& iConfig)
+    : hitGetToken_(consumes<cms::cuda::Product<TrackingRecHit2DCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      trackPutToken_(produces<cms::cuda::Product<PixelTrackCUDA>>()),
+      fieldToken_(esConsumes<MagneticField, IdealMagneticFieldRecord>()),
+      params_(caHitNtuplet::makeParams(iConfig)) {}
+
+void CAHitNtupletCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("siPixelRecHitCUDA"));
+  caHitNtuplet::fillParamsDescription(desc);
+  descriptions.add("caHitNtupletCUDA", desc);
+}
+
+void CAHitNtupletCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  auto const& product = iEvent.get(hitGetToken_);
+  cms::cuda::ScopedContextProduce ctx{product};
+  auto const& hits = ctx.get(product);
+
+  // nominalValue() is in kGauss
+  caHitNtuplet::setField(params_, 0.1f * iSetup.getData(fieldToken_).nominalValue());
+
+  ctx.emplace(iEvent, trackPutToken_, caHitNtuplet::makeTracksAsync(hits, params_, ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(CAHitNtupletCUDA);
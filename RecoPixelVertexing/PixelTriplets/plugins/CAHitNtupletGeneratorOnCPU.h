@@ -0,0 +1,58 @@
+#ifndef RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorOnCPU_h
+#define RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorOnCPU_h
+
+#include <vector>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+
+#include "CAHitNtupletAlgos.h"
+
+// The steps of the cellular automaton run one after the other on the host,
+// with the work arrays kept from one event to the next
+class CAHitNtupletGeneratorOnCPU {
+public:
+  // the arrays of hits have maxHits elements at least
+  void makeTracks(caHitNtuplet::HitsView hits,
+                  uint32_t maxHits,
+                  caHitNtuplet::Params const& params,
+                  PixelTrackSoA& tracks) {
+    hitPhi_.resize(maxHits);
+    phiBinOffsets_.assign(caConstants::nPhiBinOffsets, 0);
+    phiBinFill_.resize(caConstants::nPhiBinOffsets - 1);
+    phiBinHits_.resize(maxHits);
+    cells_.resize(caConstants::maxCells);
+    outerHitOfCell_.resize(maxHits);
+    for (uint32_t i = 0, n = hits.nHits(); i < n; ++i)
+      outerHitOfCell_[i].n = 0;
+    nCells_ = 0;
+    tracks.nFound = 0;
+
+    caHitNtuplet::Workspace ws{hitPhi_.data(),
+                               phiBinOffsets_.data(),
+                               phiBinFill_.data(),
+                               phiBinHits_.data(),
+                               cells_.data(),
+                               &nCells_,
+                               outerHitOfCell_.data(),
+                               &tracks};
+
+    caHitNtuplet::countPhiBins(hits, ws, 0, 1);
+    caHitNtuplet::scanPhiBins(ws);
+    caHitNtuplet::fillPhiBins(hits, ws, 0, 1);
+    caHitNtuplet::getDoublets(hits, ws, params, 0, 1);
+    caHitNtuplet::connectCells(ws, params, 0, 1);
+    caHitNtuplet::findNtuplets(ws, params, 0, 1);
+    caHitNtuplet::fastFit(hits, ws, params, 0, 1);
+  }
+
+private:
+  std::vector<float> hitPhi_;
+  std::vector<uint32_t> phiBinOffsets_;
+  std::vector<uint32_t> phiBinFill_;
+  std::vector<uint32_t> phiBinHits_;
+  std::vector<GPUCACell> cells_;
+  std::vector<caHitNtuplet::CellList> outerHitOfCell_;
+  uint32_t nCells_;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+#include "CAHitNtupletGeneratorOnGPU.h"
+
+namespace caHitNtuplet {
+
+  namespace {
+
+    constexpr uint32_t nThreads = 128;
+    constexpr uint32_t maxBlocks = 1024;
+
+    uint32_t nBlocks(uint32_t n) { return std::max(1u, std::min(maxBlocks, (n + nThreads - 1) / nThreads)); }
+
+    __device__ uint32_t firstThread() { return blockIdx.x * blockDim.x + threadIdx.x; }
+    __device__ uint32_t nThreadsInGrid() { return blockDim.x * gridDim.x; }
+
+    __global__ void countPhiBinsKernel(HitsView hits, Workspace ws) {
+      countPhiBins(hits, ws, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void scanPhiBinsKernel(Workspace ws) { scanPhiBins(ws); }
+
+    __global__ void fillPhiBinsKernel(HitsView hits, Workspace ws) {
+      fillPhiBins(hits, ws, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void getDoubletsKernel(HitsView hits, Workspace ws, Params params) {
+      getDoublets(hits, ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void connectCellsKernel(Workspace ws, Params params) {
+      connectCells(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void findNtupletsKernel(Workspace ws, Params params) {
+      findNtuplets(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void fastFitKernel(HitsView hits, Workspace ws, Params params) {
+      fastFit(hits, ws, params, firstThread(), nThreadsInGrid());
+    }
+
+  }  // namespace
+
+  PixelTrackCUDA makeTracksAsync(TrackingRecHit2DCUDA const& hits, Params const& params, cudaStream_t stream) {
+    if (hits.nModules() != phase1PixelTopology::numberOfModules) {
+      throw cms::Exception("LogicError") << "The cellular automaton runs on the " << phase1PixelTopology::numberOfModules
+                                         << " modules of the phase-1 pixel detector, the hits are for "
+                                         << hits.nModules();
+    }
+
+    // the number of hits is known only on the device: the grids cover all the allocated ones
+    uint32_t const maxHits = hits.maxHits();
+    auto hitPhi = cms::cuda::make_device_unique<float[]>(maxHits, stream);
+    auto phiBinOffsets = cms::cuda::make_device_unique<uint32_t[]>(caConstants::nPhiBinOffsets, stream);
+    auto phiBinFill = cms::cuda::make_device_unique<uint32_t[]>(caConstants::nPhiBinOffsets - 1, stream);
+    auto phiBinHits = cms::cuda::make_device_unique<uint32_t[]>(maxHits, stream);
+    auto cells = cms::cuda::make_device_unique<GPUCACell[]>(caConstants::maxCells, stream);
+    auto nCells = cms::cuda::make_device_unique<uint32_t>(stream);
+    auto outerHitOfCell = cms::cuda::make_device_unique<CellList[]>(maxHits, stream);
+    PixelTrackCUDA tracks(stream);
+
+    cudaCheck(cudaMemsetAsync(phiBinOffsets.get(), 0, caConstants::nPhiBinOffsets * sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(nCells.get(), 0, sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(outerHitOfCell.get(), 0, maxHits * sizeof(CellList), stream));
+    cudaCheck(cudaMemsetAsync(&tracks.get()->nFound, 0, sizeof(uint32_t), stream));
+
+    HitsView const view{hits.xg(), hits.yg(), hits.zg(), hits.detIndex(), hits.hitsModuleStart()};
+    Workspace const ws{hitPhi.get(),
+                       phiBinOffsets.get(),
+                       phiBinFill.get(),
+                       phiBinHits.get(),
+                       cells.get(),
+                       nCells.get(),
+                       outerHitOfCell.get(),
+                       tracks.get()};
+
+    uint32_t const hitBlocks = nBlocks(maxHits);
+    uint32_t const cellBlocks = nBlocks(caConstants::maxCells);
+    uint32_t const trackBlocks = nBlocks(PixelTrackSoA::maxTracks);
+
+    countPhiBinsKernel<<<hitBlocks, nThreads, 0, stream>>>(view, ws);
+    cudaCheck(cudaGetLastError());
+    scanPhiBinsKernel<<<1, 1, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    fillPhiBinsKernel<<<hitBlocks, nThreads, 0, stream>>>(view, ws);
+    cudaCheck(cudaGetLastError());
+    getDoubletsKernel<<<hitBlocks, nThreads, 0, stream>>>(view, ws, params);
+    cudaCheck(cudaGetLastError());
+    connectCellsKernel<<<cellBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    findNtupletsKernel<<<cellBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    fastFitKernel<<<trackBlocks, nThreads, 0, stream>>>(view, ws, params);
+    cudaCheck(cudaGetLastError());
+
+    // the work arrays are released once the kernels queued on the stream are done
+    return tracks;
+  }
+
+}  // namespace caHitNtuplet
@@ -0,0 +1,21 @@
+#ifndef RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorOnGPU_h
+#define RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorOnGPU_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/Track/interface/PixelTrackCUDA.h"
+#include "CUDADataFormats/TrackingRecHit/interface/TrackingRecHit2DCUDA.h"
+
+#include "CAHitNtupletAlgos.h"
+
+namespace caHitNtuplet {
+
+  // Queues the steps of the cellular automaton on the stream, with one
+  // thread per hit, cell or track: the tracks are returned at once, to be
+  // used only in the work queued on the same stream. The order of the
+  // tracks depends on the scheduling of the threads.
+  PixelTrackCUDA makeTracksAsync(TrackingRecHit2DCUDA const& hits, Params const& params, cudaStream_t stream);
+
+}  // namespace caHitNtuplet
+
+#endif
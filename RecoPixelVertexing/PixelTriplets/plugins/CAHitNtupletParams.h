@@ -0,0 +1,47 @@
+#ifndef RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletParams_h
+#define RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletParams_h
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "CAHitNtupletAlgos.h"
+
+// The configuration of the cellular automaton on the pixel hits, the same on the GPU and the CPU
+namespace caHitNtuplet {
+
+  inline void fillParamsDescription(edm::ParameterSetDescription& desc) {
+    desc.add<unsigned int>("minHitsPerNtuplet", 4)->setComment("3 for triplets, 4 for quadruplets");
+    desc.add<double>("ptmin", 0.9);
+    desc.add<double>("originRadius", 0.2);
+    desc.add<double>("originHalfLength", 15.);
+    desc.add<double>("doubletPhiMargin", 0.02)->setComment("added to the phi window of the doublets at ptmin");
+    desc.add<double>("CAThetaCut", 0.00125);
+    desc.add<double>("CAPhiCut", 10);
+    desc.add<double>("CAHardPtCut", 0);
+  }
+
+  // ptCoeff is set by setField once the magnetic field is known
+  inline Params makeParams(edm::ParameterSet const& iConfig) {
+    Params params;
+    params.minHitsPerNtuplet = iConfig.getParameter<unsigned int>("minHitsPerNtuplet");
+    if (params.minHitsPerNtuplet < 3 || params.minHitsPerNtuplet > PixelTrackSoA::maxHitsPerTrack) {
+      throw cms::Exception("Configuration") << "minHitsPerNtuplet must be 3 or 4, not " << params.minHitsPerNtuplet;
+    }
+    params.ptmin = iConfig.getParameter<double>("ptmin");
+    params.ptCoeff = 0;
+    params.originRadius = iConfig.getParameter<double>("originRadius");
+    params.originHalfLength = iConfig.getParameter<double>("originHalfLength");
+    params.doubletPhiMargin = iConfig.getParameter<double>("doubletPhiMargin");
+    params.CAThetaCut = iConfig.getParameter<double>("CAThetaCut");
+    params.CAPhiCut = iConfig.getParameter<double>("CAPhiCut");
+    params.CAHardPtCut = iConfig.getParameter<double>("CAHardPtCut");
+    return params;
+  }
+
+  // bField in T
+  inline void setField(Params& params, float bField) { params.ptCoeff = 0.003f * bField; }
+
+}  // namespace caHitNtuplet
+
+#endif
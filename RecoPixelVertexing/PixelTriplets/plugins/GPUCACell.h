@@ -0,0 +1,122 @@
+#ifndef RecoPixelVertexing_PixelTriplets_plugins_GPUCACell_h
+#define RecoPixelVertexing_PixelTriplets_plugins_GPUCACell_h
+
+#include <cmath>
+#include <cstdint>
+
+#include "CAConstants.h"
+
+// A doublet of hits of the cellular automaton, with the coordinates of its hits,
+// and the compatibility criteria of CACell: the same formulas, for a region
+// centred on the beam line.
+class GPUCACell {
+public:
+  uint32_t innerHit;
+  uint32_t outerHit;
+  uint32_t layerPair;
+
+  float innerX, innerY, innerZ, innerR;
+  float outerX, outerY, outerZ, outerR;
+
+  // the compatible cells sharing the outer hit of this one as inner hit
+  uint32_t nOuterNeighbors;
+  uint32_t outerNeighbors[caConstants::maxCellNeighbors];
+
+  CA_HOST_DEVICE void addOuterNeighbor(uint32_t cell) {
+    uint32_t i = caConstants::atomicIncrement(&nOuterNeighbors);
+    if (i < caConstants::maxCellNeighbors)
+      outerNeighbors[i] = cell;
+  }
+
+  CA_HOST_DEVICE uint32_t numberOfOuterNeighbors() const {
+    return nOuterNeighbors < caConstants::maxCellNeighbors ? nOuterNeighbors : caConstants::maxCellNeighbors;
+  }
+
+  // innerCell is the cell whose outer hit is the inner hit of this one, see CACell::areAlignedRZ
+  CA_HOST_DEVICE bool areAlignedRZ(GPUCACell const& innerCell, float ptmin, float thetaCut) const {
+    float r1 = innerCell.innerR;
+    float z1 = innerCell.innerZ;
+    float ro = outerR;
+    float zo = outerZ;
+    float radius_diff = std::abs(r1 - ro);
+    float distance_13_squared = radius_diff * radius_diff + (z1 - zo) * (z1 - zo);
+
+    float pMin = ptmin * std::sqrt(distance_13_squared);  //this needs to be divided by radius_diff later
+
+    float tan_12_13_half_mul_distance_13_squared =
+        std::abs(z1 * (innerR - ro) + innerZ * (ro - r1) + zo * (r1 - innerR));
+    return tan_12_13_half_mul_distance_13_squared * pMin <= thetaCut * distance_13_squared * radius_diff;
+  }
+
+  // below 0.1 T the radius of the hard pt cut is the one of the 3.8 T field, 87 cm/GeV = 1/(3.8T * 0.3)
+  static constexpr float minPtCoeff = 0.003f * 0.1f;
+  static constexpr float nominalRadiusPerGeV = 87.f;
+
+  // see CACell::haveSimilarCurvature, with the region origin at (0,0)
+  // ptCoeff is the pt in GeV of a radius of 1 cm in the magnetic field
+  CA_HOST_DEVICE bool haveSimilarCurvature(GPUCACell const& innerCell,
+                                           float ptmin,
+                                           float region_origin_radius,
+                                           float phiCut,
+                                           float hardPtCut,
+                                           float ptCoeff) const {
+    float x1 = innerCell.innerX;
+    float y1 = innerCell.innerY;
+
+    float x2 = innerX;
+    float y2 = innerY;
+
+    float x3 = outerX;
+    float y3 = outerY;
+
+    float distance_13_squared = (x1 - x3) * (x1 - x3) + (y1 - y3) * (y1 - y3);
+    float tan_12_13_half_mul_distance_13_squared = std::abs(y1 * (x2 - x3) + y2 * (x3 - x1) + y3 * (x1 - x2));
+    // high pt : just straight
+    if (tan_12_13_half_mul_distance_13_squared * ptmin <= 1.0e-4f * distance_13_squared) {
+      float distance_3_beamspot_squared = x3 * x3 + y3 * y3;
+
+      float dot_bs3_13 = ((x1 - x3) * (-x3) + (y1 - y3) * (-y3));
+      float proj_bs3_on_13_squared = dot_bs3_13 * dot_bs3_13 / distance_13_squared;
+
+      float distance_13_beamspot_squared = distance_3_beamspot_squared - proj_bs3_on_13_squared;
+
+      return distance_13_beamspot_squared < (region_origin_radius + phiCut) * (region_origin_radius + phiCut);
+    }
+
+    //take less than radius given by the hardPtCut and reject everything below
+    float minRadius = ptCoeff > minPtCoeff ? hardPtCut / ptCoeff : hardPtCut * nominalRadiusPerGeV;
+
+    float det = (x1 - x2) * (y2 - y3) - (x2 - x3) * (y1 - y2);
+
+    float offset = x2 * x2 + y2 * y2;
+
+    float bc = (x1 * x1 + y1 * y1 - offset) * 0.5f;
+
+    float cd = (offset - x3 * x3 - y3 * y3) * 0.5f;
+
+    float idet = 1.f / det;
+
+    float x_center = (bc * (y2 - y3) - cd * (y1 - y2)) * idet;
+    float y_center = (cd * (x1 - x2) - bc * (x2 - x3)) * idet;
+
+    float radius = std::sqrt((x2 - x_center) * (x2 - x_center) + (y2 - y_center) * (y2 - y_center));
+
+    if (radius < minRadius)
+      return false;  // hard cut on pt
+
+    float centers_distance_squared = x_center * x_center + y_center * y_center;
+    float region_origin_radius_plus_tolerance = region_origin_radius + phiCut;
+    float minimumOfIntersectionRange =
+        (radius - region_origin_radius_plus_tolerance) * (radius - region_origin_radius_plus_tolerance);
+
+    if (centers_distance_squared >= minimumOfIntersectionRange) {
+      float maximumOfIntersectionRange =
+          (radius + region_origin_radius_plus_tolerance) * (radius + region_origin_radius_plus_tolerance);
+      return centers_distance_squared <= maximumOfIntersectionRange;
+    }
+
+    return false;
+  }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include <cstring>
+#include <memory>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/Track/interface/PixelTrackCUDA.h"
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * Copies the pixel tracks built on the GPU back to the host, as the same
+ * PixelTrackSoA filled by CAHitNtupletCPU.
+ */
+class PixelTrackSoAFromCUDA : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit PixelTrackSoAFromCUDA(const edm::ParameterSet& iConfig);
+  ~PixelTrackSoAFromCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<PixelTrackCUDA>> trackGetToken_;
+  edm::EDPutTokenT<PixelTrackSoA> trackPutToken_;
+
+  cms::cuda::host::unique_ptr<PixelTrackSoA> tracks_;
+};
+
+PixelTrackSoAFromCUDA::PixelTrackSoAFromCUDA(const edm::ParameterSet& iConfig)
+    : trackGetToken_(consumes<cms::cuda::Product<PixelTrackCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      trackPutToken_(produces<PixelTrackSoA>()) {}
+
+void PixelTrackSoAFromCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("caHitNtupletCUDA"));
+  descriptions.add("pixelTrackSoAFromCUDA", desc);
+}
+
+void PixelTrackSoAFromCUDA::acquire(const edm::Event& iEvent,
+                                    const edm::EventSetup& iSetup,
+                                    edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  auto const& product = iEvent.get(trackGetToken_);
+  cms::cuda::ScopedContextAcquire ctx{product, std::move(waitingTaskHolder)};
+  tracks_ = ctx.get(product).toHostAsync(ctx.stream());
+}
+
+void PixelTrackSoAFromCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  // the pinned buffer goes back to the caching allocator, the product owns a copy
+  auto output = std::make_unique<PixelTrackSoA>();
+  std::memcpy(output.get(), tracks_.get(), sizeof(PixelTrackSoA));
+  iEvent.put(trackPutToken_, std::move(output));
+  tracks_.reset();
+}
+
+DEFINE_FWK_MODULE(PixelTrackSoAFromCUDA);
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "RecoPixelVertexing/PixelTriplets/plugins/CAHitNtupletGeneratorOnCPU.h"
+
+namespace {
+  struct Hit {
+    uint16_t module;
+    float x, y, z;
+  };
+
+  // the hits of a track from the origin on the four barrel layers
+  void addTrack(std::vector<Hit>& hits, float pt, float phi0, float eta, int charge, float bField) {
+    constexpr float radii[4] = {2.9f, 6.8f, 10.9f, 16.0f};
+    float const R = pt / (0.003f * bField);
+    float const cotTheta = std::sinh(eta);
+    for (uint32_t layer = 0; layer < 4; ++layer) {
+      float const r = radii[layer];
+      // positive tracks turn clockwise
+      float const phi = phi0 - charge * std::asin(0.5f * r / R);
+      float const s = 2.f * R * std::asin(0.5f * r / R);
+      hits.push_back(Hit{uint16_t(phase1PixelTopology::layerStart(layer)), r * std::cos(phi), r * std::sin(phi), s * cotTheta});
+    }
+  }
+}  // namespace
+
+int main() {
+  constexpr float bField = 3.8f;
+  std::vector<Hit> hits;
+  addTrack(hits, 10.f, 0.3f, 0.2f, 1, bField);
+  addTrack(hits, 2.f, -2.f, -0.5f, -1, bField);
+
+  std::sort(hits.begin(), hits.end(), [](Hit const& a, Hit const& b) { return a.module < b.module; });
+  uint32_t const nHits = hits.size();
+  std::vector<float> x, y, z;
+  std::vector<uint16_t> detIndex;
+  std::vector<uint32_t> hitsModuleStart(phase1PixelTopology::numberOfModules + 1, 0);
+  for (auto const& h : hits) {
+    x.push_back(h.x);
+    y.push_back(h.y);
+    z.push_back(h.z);
+    detIndex.push_back(h.module);
+    ++hitsModuleStart[h.module + 1];
+  }
+  for (uint32_t m = 0; m < phase1PixelTopology::numberOfModules; ++m)
+    hitsModuleStart[m + 1] += hitsModuleStart[m];
+  assert(hitsModuleStart.back() == nHits);
+
+  caHitNtuplet::HitsView view{x.data(), y.data(), z.data(), detIndex.data(), hitsModuleStart.data()};
+  caHitNtuplet::Params params{4, 0.9f, 0.003f * bField, 0.2f, 15.f, 0.02f, 0.00125f, 10.f, 0.f};
+
+  auto tracks = std::make_unique<PixelTrackSoA>();
+  CAHitNtupletGeneratorOnCPU generator;
+  generator.makeTracks(view, nHits, params, *tracks);
+
+  std::cout << tracks->nTracks() << " quadruplets" << std::endl;
+  assert(tracks->nTracks() == 2);
+  for (uint32_t t = 0; t < tracks->nTracks(); ++t) {
+    std::cout << "pt " << tracks->pt[t] << " phi " << tracks->phi[t] << " eta " << tracks->eta[t] << " tip "
+              << tracks->tip[t] << " zip " << tracks->zip[t] << " charge " << int(tracks->charge[t]) << std::endl;
+    assert(tracks->nHits[t] == 4);
+    bool first = std::abs(tracks->pt[t] - 10.f) < 0.5f;
+    assert(first || std::abs(tracks->pt[t] - 2.f) < 0.1f);
+    assert(std::abs(tracks->phi[t] - (first ? 0.3f : -2.f)) < 0.01f);
+    assert(std::abs(tracks->eta[t] - (first ? 0.2f : -0.5f)) < 0.01f);
+    assert(tracks->charge[t] == (first ? 1 : -1));
+    assert(std::abs(tracks->tip[t]) < 0.01f);
+    assert(std::abs(tracks->zip[t]) < 0.01f);
+  }
+
+  // triplets: the two paths of three hits starting on the first layer
+  params.minHitsPerNtuplet = 3;
+  generator.makeTracks(view, nHits, params, *tracks);
+  std::cout << tracks->nTracks() << " triplets" << std::endl;
+  assert(tracks->nTracks() == 2);
+
+  return 0;
+}
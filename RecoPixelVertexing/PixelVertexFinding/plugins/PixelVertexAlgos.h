@@ -0,0 +1,374 @@
+#ifndef RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexAlgos_h
+#define RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexAlgos_h
+
+#include <cmath>
+#include <cstdint>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
+
+#if defined(__CUDACC__)
+#define PV_HOST_DEVICE __host__ __device__
+#else
+#define PV_HOST_DEVICE
+#endif
+
+// The steps of the pixel vertexing along z, shared by the CUDA kernels and the CPU
+// implementation. As for the cellular automaton, each step loops over its elements
+// from first with the given stride, and the steps run in this order, each one after
+// all the threads of the previous one are done:
+//   loadTracks, scanZBins, fillZBins, countDensity, linkTracks, findSeeds, assignVertices, countSeeds,
+//   fit, scanVertexTracks, fillVertexTracks, splitVertices, fit, sortVertices, storeTracks
+// where fit is clearVertices, accumulateVertices, finalizeVertices, vertexChi2: without
+// outlier rejection before the splitting, with vertexChi2max after it.
+//
+// The clustering is that of the density peaks: the density of a track is the number
+// of compatible tracks around it, each track is linked to the nearest compatible track
+// of higher density, and the roots of the links of density at least minT are the
+// vertex seeds; the tracks of a vertex are those linked to its seed.
+namespace pixelVertex {
+
+  // the tracks are binned in z for the neighbour search
+  constexpr uint32_t nZBins = 1024;
+
+  // the selected tracks and their vertices are indexed from 0 to nSelected
+  struct Workspace {
+    uint32_t* nSelected;
+    uint32_t* trackIndex;  // maxTracks, in the PixelTrackSoA
+    float* z;              // maxTracks
+    float* ez2;            // maxTracks
+    float* pt2;            // maxTracks
+    uint32_t* zBinOffsets;  // nZBins + 1
+    uint32_t* zBinFill;     // nZBins
+    uint32_t* zBinTracks;   // maxTracks
+    uint32_t* density;      // maxTracks
+    uint32_t* link;         // maxTracks
+    int32_t* vertexOfTrack;  // maxTracks
+    float* sumW;             // maxVertices
+    float* sumWZ;            // maxVertices
+    uint32_t* vertexTrackOffsets;  // maxVertices + 1
+    uint32_t* vertexTrackFill;     // maxVertices
+    uint32_t* vertexTracks;        // maxTracks
+    uint32_t* nSeeds;              // the vertices before the splitting
+    ZVertexSoA* vertices;
+  };
+
+  struct Params {
+    uint32_t minHits;
+    float ptMin;   // GeV
+    float ptMax;   // GeV, above it the pt of a track counts as ptMax in ptv2
+    float zMax;    // cm
+    float zErrConst;  // cm, z error of the tracks of high pt
+    float zErrMS;     // cm GeV, multiple scattering term of the z error, scaled by cosh(eta)/pt
+    float eps;        // cm, maximum distance of compatible tracks
+    float chi2max;    // maximum normalised distance^2 of compatible tracks
+    uint32_t minT;    // minimum number of tracks of a vertex
+    float vertexChi2max;  // of a track to its vertex
+    float splitChi2max;   // the vertices of larger chi2/ndof are split in two
+  };
+
+  // on the host the steps run on a single thread
+  PV_HOST_DEVICE inline uint32_t atomicIncrement(uint32_t* counter) {
+#if defined(__CUDA_ARCH__)
+    return atomicAdd(counter, 1u);
+#else
+    return (*counter)++;
+#endif
+  }
+
+  PV_HOST_DEVICE inline void atomicAddFloat(float* sum, float value) {
+#if defined(__CUDA_ARCH__)
+    atomicAdd(sum, value);
+#else
+    *sum += value;
+#endif
+  }
+
+  PV_HOST_DEVICE inline uint32_t zBin(float z, Params const& params) {
+    int bin = int((z + params.zMax) * (nZBins / (2.f * params.zMax)));
+    return bin < 0 ? 0 : (bin >= int(nZBins) ? nZBins - 1 : bin);
+  }
+
+  PV_HOST_DEVICE inline bool compatible(Workspace const& ws, uint32_t i, uint32_t j, Params const& params) {
+    float const dz = ws.z[i] - ws.z[j];
+    return std::abs(dz) < params.eps && dz * dz < params.chi2max * (ws.ez2[i] + ws.ez2[j]);
+  }
+
+  // the order of the densities, the ties broken by z and then by track
+  PV_HOST_DEVICE inline bool denser(Workspace const& ws, uint32_t j, uint32_t i) {
+    if (ws.density[j] != ws.density[i])
+      return ws.density[j] > ws.density[i];
+    if (ws.z[j] != ws.z[i])
+      return ws.z[j] < ws.z[i];
+    return ws.trackIndex[j] < ws.trackIndex[i];
+  }
+
+  // the tracks to cluster, counted in their z bins
+  PV_HOST_DEVICE inline void loadTracks(
+      PixelTrackSoA const& tracks, Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const nTracks = tracks.nTracks();
+    for (uint32_t t = first; t < nTracks; t += stride) {
+      ws.vertices->idv[t] = -1;
+      float const pt = tracks.pt[t];
+      float const z = tracks.zip[t];
+      if (tracks.nHits[t] < params.minHits || pt < params.ptMin || std::abs(z) >= params.zMax)
+        continue;
+      uint32_t const k = atomicIncrement(ws.nSelected);
+      ws.trackIndex[k] = t;
+      ws.z[k] = z;
+      float const ms = params.zErrMS * std::cosh(tracks.eta[t]) / pt;
+      ws.ez2[k] = params.zErrConst * params.zErrConst + ms * ms;
+      float const ptw = pt < params.ptMax ? pt : params.ptMax;
+      ws.pt2[k] = ptw * ptw;
+      atomicIncrement(&ws.zBinOffsets[zBin(z, params) + 1]);
+    }
+  }
+
+  // by a single thread
+  PV_HOST_DEVICE inline void scanZBins(Workspace ws) {
+    for (uint32_t k = 1; k <= nZBins; ++k) {
+      ws.zBinOffsets[k] += ws.zBinOffsets[k - 1];
+      ws.zBinFill[k - 1] = ws.zBinOffsets[k - 1];
+    }
+  }
+
+  PV_HOST_DEVICE inline void fillZBins(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride)
+      ws.zBinTracks[atomicIncrement(&ws.zBinFill[zBin(ws.z[i], params)])] = i;
+  }
+
+  // the z bins within eps of a track
+  PV_HOST_DEVICE inline void binRange(float z, Params const& params, uint32_t& firstBin, uint32_t& lastBin) {
+    firstBin = zBin(z - params.eps, params);
+    lastBin = zBin(z + params.eps, params);
+  }
+
+  // the number of compatible tracks, the track itself included
+  PV_HOST_DEVICE inline void countDensity(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      uint32_t firstBin, lastBin;
+      binRange(ws.z[i], params, firstBin, lastBin);
+      uint32_t density = 0;
+      for (uint32_t p = ws.zBinOffsets[firstBin]; p < ws.zBinOffsets[lastBin + 1]; ++p) {
+        if (compatible(ws, i, ws.zBinTracks[p], params))
+          ++density;
+      }
+      ws.density[i] = density;
+    }
+  }
+
+  // the nearest compatible track of higher density, the track itself for the local maxima
+  PV_HOST_DEVICE inline void linkTracks(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      uint32_t firstBin, lastBin;
+      binRange(ws.z[i], params, firstBin, lastBin);
+      uint32_t link = i;
+      float distance = params.eps;
+      for (uint32_t p = ws.zBinOffsets[firstBin]; p < ws.zBinOffsets[lastBin + 1]; ++p) {
+        uint32_t const j = ws.zBinTracks[p];
+        if (j == i || !denser(ws, j, i) || !compatible(ws, i, j, params))
+          continue;
+        float const dz = std::abs(ws.z[j] - ws.z[i]);
+        if (dz < distance || (dz == distance && link != i && ws.trackIndex[j] < ws.trackIndex[link])) {
+          distance = dz;
+          link = j;
+        }
+      }
+      ws.link[i] = link;
+    }
+  }
+
+  // the local maxima dense enough start a vertex, the other tracks wait for assignVertices
+  PV_HOST_DEVICE inline void findSeeds(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t vertex = -2;
+      if (ws.link[i] == i) {
+        vertex = -1;
+        if (ws.density[i] >= params.minT) {
+          uint32_t const v = atomicIncrement(&ws.vertices->nFound);
+          if (v < ZVertexSoA::maxVertices)
+            vertex = v;
+        }
+      }
+      ws.vertexOfTrack[i] = vertex;
+    }
+  }
+
+  // the vertex of the root of the links of each track
+  PV_HOST_DEVICE inline void assignVertices(Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      if (ws.vertexOfTrack[i] != -2)
+        continue;
+      uint32_t root = i;
+      while (ws.link[root] != root)
+        root = ws.link[root];
+      ws.vertexOfTrack[i] = ws.vertexOfTrack[root];
+    }
+  }
+
+  // by a single thread: the number of vertices before the splitting
+  PV_HOST_DEVICE inline void countSeeds(Workspace ws) { *ws.nSeeds = ws.vertices->nVertices(); }
+
+  PV_HOST_DEVICE inline void clearVertices(Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const nv = ws.vertices->nVertices();
+    for (uint32_t v = first; v < nv; v += stride) {
+      ws.sumW[v] = 0;
+      ws.sumWZ[v] = 0;
+      ws.vertices->chi2[v] = 0;
+      ws.vertices->ptv2[v] = 0;
+      ws.vertices->ndof[v] = 0;
+      ws.vertexTrackOffsets[v + 1] = 0;
+    }
+  }
+
+  PV_HOST_DEVICE inline void accumulateVertices(Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t const v = ws.vertexOfTrack[i];
+      if (v < 0)
+        continue;
+      float const w = 1.f / ws.ez2[i];
+      atomicAddFloat(&ws.sumW[v], w);
+      atomicAddFloat(&ws.sumWZ[v], w * ws.z[i]);
+    }
+  }
+
+  PV_HOST_DEVICE inline void finalizeVertices(Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const nv = ws.vertices->nVertices();
+    for (uint32_t v = first; v < nv; v += stride) {
+      float const w = ws.sumW[v];
+      ws.vertices->wv[v] = w;
+      ws.vertices->zv[v] = w > 0 ? ws.sumWZ[v] / w : 0.f;
+    }
+  }
+
+  // The chi2 of the tracks to their vertex: those above chi2max leave the vertex.
+  // The tracks of each vertex are counted in vertexTrackOffsets, ndof is set by sortVertices.
+  PV_HOST_DEVICE inline void vertexChi2(Workspace ws, float chi2max, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t const v = ws.vertexOfTrack[i];
+      if (v < 0)
+        continue;
+      float const dz = ws.z[i] - ws.vertices->zv[v];
+      float const chi2 = dz * dz / ws.ez2[i];
+      if (chi2 > chi2max) {
+        ws.vertexOfTrack[i] = -1;
+        continue;
+      }
+      atomicAddFloat(&ws.vertices->chi2[v], chi2);
+      atomicAddFloat(&ws.vertices->ptv2[v], ws.pt2[i]);
+      atomicIncrement(&ws.vertexTrackOffsets[v + 1]);
+    }
+  }
+
+  // by a single thread: the tracks of each vertex together, for the splitting
+  PV_HOST_DEVICE inline void scanVertexTracks(Workspace ws) {
+    uint32_t const nv = ws.vertices->nVertices();
+    ws.vertexTrackOffsets[0] = 0;
+    for (uint32_t v = 1; v <= nv; ++v) {
+      ws.vertexTrackOffsets[v] += ws.vertexTrackOffsets[v - 1];
+      ws.vertexTrackFill[v - 1] = ws.vertexTrackOffsets[v - 1];
+    }
+  }
+
+  PV_HOST_DEVICE inline void fillVertexTracks(Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride) {
+      int32_t const v = ws.vertexOfTrack[i];
+      if (v >= 0)
+        ws.vertexTracks[atomicIncrement(&ws.vertexTrackFill[v])] = i;
+    }
+  }
+
+  // The vertices of too large chi2/ndof are split in two by a weighted 2-means in z:
+  // the tracks of the second half go to a new vertex if both halves have minT tracks.
+  PV_HOST_DEVICE inline void splitVertices(Workspace ws, Params params, uint32_t first, uint32_t stride) {
+    constexpr int nIterations = 10;
+    uint32_t const nv = *ws.nSeeds;
+    for (uint32_t v = first; v < nv; v += stride) {
+      uint32_t const begin = ws.vertexTrackOffsets[v];
+      uint32_t const end = ws.vertexTrackOffsets[v + 1];
+      uint32_t const nt = end - begin;
+      if (nt < 2 * params.minT || ws.vertices->chi2[v] <= params.splitChi2max * (nt - 1))
+        continue;
+
+      float z1 = ws.z[ws.vertexTracks[begin]];
+      float z2 = z1;
+      for (uint32_t p = begin; p < end; ++p) {
+        float const z = ws.z[ws.vertexTracks[p]];
+        z1 = z < z1 ? z : z1;
+        z2 = z > z2 ? z : z2;
+      }
+      uint32_t n1 = 0, n2 = 0;
+      for (int it = 0; it < nIterations; ++it) {
+        float w1 = 0, wz1 = 0, w2 = 0, wz2 = 0;
+        n1 = n2 = 0;
+        float const zMid = 0.5f * (z1 + z2);
+        for (uint32_t p = begin; p < end; ++p) {
+          uint32_t const i = ws.vertexTracks[p];
+          float const w = 1.f / ws.ez2[i];
+          if (ws.z[i] < zMid) {
+            w1 += w;
+            wz1 += w * ws.z[i];
+            ++n1;
+          } else {
+            w2 += w;
+            wz2 += w * ws.z[i];
+            ++n2;
+          }
+        }
+        if (n1 == 0 || n2 == 0)
+          break;
+        z1 = wz1 / w1;
+        z2 = wz2 / w2;
+      }
+      if (n1 < params.minT || n2 < params.minT)
+        continue;
+
+      uint32_t const nw = atomicIncrement(&ws.vertices->nFound);
+      if (nw >= ZVertexSoA::maxVertices)
+        continue;
+      float const zMid = 0.5f * (z1 + z2);
+      for (uint32_t p = begin; p < end; ++p) {
+        uint32_t const i = ws.vertexTracks[p];
+        if (ws.z[i] >= zMid)
+          ws.vertexOfTrack[i] = nw;
+      }
+    }
+  }
+
+  // by a single thread: the vertices with tracks by decreasing ptv2, and their ndof
+  PV_HOST_DEVICE inline void sortVertices(Workspace ws) {
+    auto& vertices = *ws.vertices;
+    uint32_t const nv = vertices.nVertices();
+    uint32_t n = 0;
+    for (uint32_t v = 0; v < nv; ++v) {
+      int32_t const nt = ws.vertexTrackOffsets[v + 1];
+      vertices.ndof[v] = nt - 1;
+      if (nt == 0)
+        continue;
+      uint32_t k = n++;
+      while (k > 0 && vertices.ptv2[vertices.sortInd[k - 1]] < vertices.ptv2[v]) {
+        vertices.sortInd[k] = vertices.sortInd[k - 1];
+        --k;
+      }
+      vertices.sortInd[k] = v;
+    }
+    vertices.nvFinal = n;
+  }
+
+  PV_HOST_DEVICE inline void storeTracks(Workspace ws, uint32_t first, uint32_t stride) {
+    uint32_t const n = *ws.nSelected;
+    for (uint32_t i = first; i < n; i += stride)
+      ws.vertices->idv[ws.trackIndex[i]] = ws.vertexOfTrack[i];
+  }
+
+}  // namespace pixelVertex
+
+#endif
@@ -0,0 +1,72 @@
+#include <cmath>
+#include <memory>
+
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+/**
+ * Converts the vertices of a ZVertexSoA to a reco::VertexCollection, by
+ * decreasing sum of the pt^2 of their tracks, placed on the beam line at
+ * their z. As PixelVertexProducer, the beam spot is the only vertex of
+ * the events without vertices. The vertices have no track references.
+ */
+class PixelVertexCollectionFromSoA : public edm::global::EDProducer<> {
+public:
+  explicit PixelVertexCollectionFromSoA(const edm::ParameterSet& iConfig);
+  ~PixelVertexCollectionFromSoA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<ZVertexSoA> vertexGetToken_;
+  const edm::EDGetTokenT<reco::BeamSpot> beamSpotToken_;
+  const edm::EDPutTokenT<reco::VertexCollection> vertexPutToken_;
+};
+
+PixelVertexCollectionFromSoA::PixelVertexCollectionFromSoA(const edm::ParameterSet& iConfig)
+    : vertexGetToken_(consumes<ZVertexSoA>(iConfig.getParameter<edm::InputTag>("src"))),
+      beamSpotToken_(consumes<reco::BeamSpot>(iConfig.getParameter<edm::InputTag>("beamSpot"))),
+      vertexPutToken_(produces<reco::VertexCollection>()) {}
+
+void PixelVertexCollectionFromSoA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("pixelVertexSoAFromCUDA"));
+  desc.add<edm::InputTag>("beamSpot", edm::InputTag("offlineBeamSpot"));
+  descriptions.add("pixelVertexCollectionFromSoA", desc);
+}
+
+void PixelVertexCollectionFromSoA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  auto const& soa = iEvent.get(vertexGetToken_);
+  auto const& bs = iEvent.get(beamSpotToken_);
+
+  reco::VertexCollection vertices;
+  vertices.reserve(soa.nvFinal);
+  for (uint32_t k = 0; k < soa.nvFinal; ++k) {
+    auto const v = soa.sortInd[k];
+    double const z = soa.zv[v];
+    double const x = bs.x0() + bs.dxdz() * (z - bs.z0());
+    double const y = bs.y0() + bs.dydz() * (z - bs.z0());
+    reco::Vertex::Error error;
+    error(0, 0) = bs.BeamWidthX() * bs.BeamWidthX();
+    error(1, 1) = bs.BeamWidthY() * bs.BeamWidthY();
+    error(2, 2) = 1. / soa.wv[v];
+    vertices.emplace_back(reco::Vertex::Point(x, y, z), error, soa.chi2[v], soa.ndof[v], soa.ndof[v] + 1);
+  }
+  if (vertices.empty())
+    vertices.emplace_back(bs.position(), bs.rotatedCovariance3D(), 0., 0., 0);
+
+  iEvent.emplace(vertexPutToken_, std::move(vertices));
+}
+
+DEFINE_FWK_MODULE(PixelVertexCollectionFromSoA);
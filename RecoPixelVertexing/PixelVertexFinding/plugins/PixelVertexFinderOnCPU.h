@@ -0,0 +1,101 @@
+#ifndef RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexFinderOnCPU_h
+#define RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexFinderOnCPU_h
+
+#include <limits>
+#include <vector>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
+
+#include "PixelVertexAlgos.h"
+
+// The steps of the pixel vertexing run one after the other on the host,
+// with the work arrays kept from one event to the next
+class PixelVertexFinderOnCPU {
+public:
+  void makeVertices(PixelTrackSoA const& tracks, pixelVertex::Params const& params, ZVertexSoA& vertices) {
+    uint32_t const nTracks = tracks.nTracks();
+    trackIndex_.resize(nTracks);
+    z_.resize(nTracks);
+    ez2_.resize(nTracks);
+    pt2_.resize(nTracks);
+    zBinOffsets_.assign(pixelVertex::nZBins + 1, 0);
+    zBinFill_.resize(pixelVertex::nZBins);
+    zBinTracks_.resize(nTracks);
+    density_.resize(nTracks);
+    link_.resize(nTracks);
+    vertexOfTrack_.resize(nTracks);
+    sumW_.resize(ZVertexSoA::maxVertices);
+    sumWZ_.resize(ZVertexSoA::maxVertices);
+    vertexTrackOffsets_.resize(ZVertexSoA::maxVertices + 1);
+    vertexTrackFill_.resize(ZVertexSoA::maxVertices);
+    vertexTracks_.resize(nTracks);
+    nSelected_ = 0;
+    vertices.nFound = 0;
+    vertices.nvFinal = 0;
+
+    pixelVertex::Workspace ws{&nSelected_,
+                              trackIndex_.data(),
+                              z_.data(),
+                              ez2_.data(),
+                              pt2_.data(),
+                              zBinOffsets_.data(),
+                              zBinFill_.data(),
+                              zBinTracks_.data(),
+                              density_.data(),
+                              link_.data(),
+                              vertexOfTrack_.data(),
+                              sumW_.data(),
+                              sumWZ_.data(),
+                              vertexTrackOffsets_.data(),
+                              vertexTrackFill_.data(),
+                              vertexTracks_.data(),
+                              &nSeeds_,
+                              &vertices};
+
+    pixelVertex::loadTracks(tracks, ws, params, 0, 1);
+    pixelVertex::scanZBins(ws);
+    pixelVertex::fillZBins(ws, params, 0, 1);
+    pixelVertex::countDensity(ws, params, 0, 1);
+    pixelVertex::linkTracks(ws, params, 0, 1);
+    pixelVertex::findSeeds(ws, params, 0, 1);
+    pixelVertex::assignVertices(ws, 0, 1);
+    pixelVertex::countSeeds(ws);
+    // the outliers of the vertices to split are the tracks of the other half
+    fit(ws, std::numeric_limits<float>::infinity());
+    pixelVertex::scanVertexTracks(ws);
+    pixelVertex::fillVertexTracks(ws, 0, 1);
+    pixelVertex::splitVertices(ws, params, 0, 1);
+    fit(ws, params.vertexChi2max);
+    pixelVertex::sortVertices(ws);
+    pixelVertex::storeTracks(ws, 0, 1);
+  }
+
+private:
+  static void fit(pixelVertex::Workspace const& ws, float chi2max) {
+    pixelVertex::clearVertices(ws, 0, 1);
+    pixelVertex::accumulateVertices(ws, 0, 1);
+    pixelVertex::finalizeVertices(ws, 0, 1);
+    pixelVertex::vertexChi2(ws, chi2max, 0, 1);
+  }
+
+  uint32_t nSelected_;
+  uint32_t nSeeds_;
+  std::vector<uint32_t> trackIndex_;
+  std::vector<float> z_;
+  std::vector<float> ez2_;
+  std::vector<float> pt2_;
+  std::vector<uint32_t> zBinOffsets_;
+  std::vector<uint32_t> zBinFill_;
+  std::vector<uint32_t> zBinTracks_;
+  std::vector<uint32_t> density_;
+  std::vector<uint32_t> link_;
+  std::vector<int32_t> vertexOfTrack_;
+  std::vector<float> sumW_;
+  std::vector<float> sumWZ_;
+  std::vector<uint32_t> vertexTrackOffsets_;
+  std::vector<uint32_t> vertexTrackFill_;
+  std::vector<uint32_t> vertexTracks_;
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <limits>
+
+#include "HeterogeneousCore/CUDAUtilities/interface/cudaCheck.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/device_unique_ptr.h"
+
+#include "PixelVertexFinderOnGPU.h"
+
+namespace pixelVertex {
+
+  namespace {
+
+    constexpr uint32_t nThreads = 128;
+    constexpr uint32_t trackBlocks = (ZVertexSoA::maxTracks + nThreads - 1) / nThreads;
+    constexpr uint32_t vertexBlocks = (ZVertexSoA::maxVertices + nThreads - 1) / nThreads;
+
+    __device__ uint32_t firstThread() { return blockIdx.x * blockDim.x + threadIdx.x; }
+    __device__ uint32_t nThreadsInGrid() { return blockDim.x * gridDim.x; }
+
+    __global__ void loadTracksKernel(PixelTrackSoA const* tracks, Workspace ws, Params params) {
+      loadTracks(*tracks, ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void scanZBinsKernel(Workspace ws) { scanZBins(ws); }
+
+    __global__ void fillZBinsKernel(Workspace ws, Params params) {
+      fillZBins(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void countDensityKernel(Workspace ws, Params params) {
+      countDensity(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void linkTracksKernel(Workspace ws, Params params) {
+      linkTracks(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void findSeedsKernel(Workspace ws, Params params) {
+      findSeeds(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void assignVerticesKernel(Workspace ws) { assignVertices(ws, firstThread(), nThreadsInGrid()); }
+
+    __global__ void countSeedsKernel(Workspace ws) { countSeeds(ws); }
+
+    __global__ void clearVerticesKernel(Workspace ws) { clearVertices(ws, firstThread(), nThreadsInGrid()); }
+
+    __global__ void accumulateVerticesKernel(Workspace ws) {
+      accumulateVertices(ws, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void finalizeVerticesKernel(Workspace ws) { finalizeVertices(ws, firstThread(), nThreadsInGrid()); }
+
+    __global__ void vertexChi2Kernel(Workspace ws, float chi2max) {
+      vertexChi2(ws, chi2max, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void scanVertexTracksKernel(Workspace ws) { scanVertexTracks(ws); }
+
+    __global__ void fillVertexTracksKernel(Workspace ws) { fillVertexTracks(ws, firstThread(), nThreadsInGrid()); }
+
+    __global__ void splitVerticesKernel(Workspace ws, Params params) {
+      splitVertices(ws, params, firstThread(), nThreadsInGrid());
+    }
+
+    __global__ void sortVerticesKernel(Workspace ws) { sortVertices(ws); }
+
+    __global__ void storeTracksKernel(Workspace ws) { storeTracks(ws, firstThread(), nThreadsInGrid()); }
+
+    void fit(Workspace const& ws, float chi2max, cudaStream_t stream) {
+      clearVerticesKernel<<<vertexBlocks, nThreads, 0, stream>>>(ws);
+      cudaCheck(cudaGetLastError());
+      accumulateVerticesKernel<<<trackBlocks, nThreads, 0, stream>>>(ws);
+      cudaCheck(cudaGetLastError());
+      finalizeVerticesKernel<<<vertexBlocks, nThreads, 0, stream>>>(ws);
+      cudaCheck(cudaGetLastError());
+      vertexChi2Kernel<<<trackBlocks, nThreads, 0, stream>>>(ws, chi2max);
+      cudaCheck(cudaGetLastError());
+    }
+
+  }  // namespace
+
+  ZVertexCUDA makeVerticesAsync(PixelTrackCUDA const& tracks, Params const& params, cudaStream_t stream) {
+    constexpr uint32_t maxTracks = ZVertexSoA::maxTracks;
+    constexpr uint32_t maxVertices = ZVertexSoA::maxVertices;
+
+    // the number of tracks is known only on the device: the grids cover all the possible ones
+    auto nSelected = cms::cuda::make_device_unique<uint32_t>(stream);
+    auto trackIndex = cms::cuda::make_device_unique<uint32_t[]>(maxTracks, stream);
+    auto z = cms::cuda::make_device_unique<float[]>(maxTracks, stream);
+    auto ez2 = cms::cuda::make_device_unique<float[]>(maxTracks, stream);
+    auto pt2 = cms::cuda::make_device_unique<float[]>(maxTracks, stream);
+    auto zBinOffsets = cms::cuda::make_device_unique<uint32_t[]>(nZBins + 1, stream);
+    auto zBinFill = cms::cuda::make_device_unique<uint32_t[]>(nZBins, stream);
+    auto zBinTracks = cms::cuda::make_device_unique<uint32_t[]>(maxTracks, stream);
+    auto density = cms::cuda::make_device_unique<uint32_t[]>(maxTracks, stream);
+    auto link = cms::cuda::make_device_unique<uint32_t[]>(maxTracks, stream);
+    auto vertexOfTrack = cms::cuda::make_device_unique<int32_t[]>(maxTracks, stream);
+    auto sumW = cms::cuda::make_device_unique<float[]>(maxVertices, stream);
+    auto sumWZ = cms::cuda::make_device_unique<float[]>(maxVertices, stream);
+    auto vertexTrackOffsets = cms::cuda::make_device_unique<uint32_t[]>(maxVertices + 1, stream);
+    auto vertexTrackFill = cms::cuda::make_device_unique<uint32_t[]>(maxVertices, stream);
+    auto vertexTracks = cms::cuda::make_device_unique<uint32_t[]>(maxTracks, stream);
+    auto nSeeds = cms::cuda::make_device_unique<uint32_t>(stream);
+    ZVertexCUDA vertices(stream);
+
+    cudaCheck(cudaMemsetAsync(nSelected.get(), 0, sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(zBinOffsets.get(), 0, (nZBins + 1) * sizeof(uint32_t), stream));
+    cudaCheck(cudaMemsetAsync(&vertices.get()->nFound, 0, sizeof(uint32_t), stream));
+
+    Workspace const ws{nSelected.get(),
+                       trackIndex.get(),
+                       z.get(),
+                       ez2.get(),
+                       pt2.get(),
+                       zBinOffsets.get(),
+                       zBinFill.get(),
+                       zBinTracks.get(),
+                       density.get(),
+                       link.get(),
+                       vertexOfTrack.get(),
+                       sumW.get(),
+                       sumWZ.get(),
+                       vertexTrackOffsets.get(),
+                       vertexTrackFill.get(),
+                       vertexTracks.get(),
+                       nSeeds.get(),
+                       vertices.get()};
+
+    loadTracksKernel<<<trackBlocks, nThreads, 0, stream>>>(tracks.get(), ws, params);
+    cudaCheck(cudaGetLastError());
+    scanZBinsKernel<<<1, 1, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    fillZBinsKernel<<<trackBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    countDensityKernel<<<trackBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    linkTracksKernel<<<trackBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    findSeedsKernel<<<trackBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    assignVerticesKernel<<<trackBlocks, nThreads, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    countSeedsKernel<<<1, 1, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    // the outliers of the vertices to split are the tracks of the other half
+    fit(ws, std::numeric_limits<float>::infinity(), stream);
+    scanVertexTracksKernel<<<1, 1, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    fillVertexTracksKernel<<<trackBlocks, nThreads, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    splitVerticesKernel<<<vertexBlocks, nThreads, 0, stream>>>(ws, params);
+    cudaCheck(cudaGetLastError());
+    fit(ws, params.vertexChi2max, stream);
+    sortVerticesKernel<<<1, 1, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+    storeTracksKernel<<<trackBlocks, nThreads, 0, stream>>>(ws);
+    cudaCheck(cudaGetLastError());
+
+    // the work arrays are released once the kernels queued on the stream are done
+    return vertices;
+  }
+
+}  // namespace pixelVertex
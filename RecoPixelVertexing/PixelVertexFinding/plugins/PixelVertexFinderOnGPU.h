@@ -0,0 +1,21 @@
+#ifndef RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexFinderOnGPU_h
+#define RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexFinderOnGPU_h
+
+#include <cuda_runtime.h>
+
+#include "CUDADataFormats/Track/interface/PixelTrackCUDA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexCUDA.h"
+
+#include "PixelVertexAlgos.h"
+
+namespace pixelVertex {
+
+  // Queues the steps of the pixel vertexing on the stream, with one thread
+  // per track or vertex: the vertices are returned at once, to be used only
+  // in the work queued on the same stream. The numbering of the vertices
+  // depends on the scheduling of the threads, sortInd does not.
+  ZVertexCUDA makeVerticesAsync(PixelTrackCUDA const& tracks, Params const& params, cudaStream_t stream);
+
+}  // namespace pixelVertex
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexParams_h
+#define RecoPixelVertexing_PixelVertexFinding_plugins_PixelVertexParams_h
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "PixelVertexAlgos.h"
+
+// The configuration of the pixel vertexing, the same on the GPU and the CPU
+namespace pixelVertex {
+
+  inline void fillParamsDescription(edm::ParameterSetDescription& desc) {
+    desc.add<unsigned int>("minHits", 3)->setComment("of the tracks to cluster");
+    desc.add<double>("ptMin", 0.5);
+    desc.add<double>("ptMax", 75.)->setComment("the pt of the tracks above it counts as ptMax in the sum of pt^2");
+    desc.add<double>("zMax", 25.);
+    desc.add<double>("zErrConst", 0.01)->setComment("z error of the tracks of high pt (cm)");
+    desc.add<double>("zErrMS", 0.05)->setComment("multiple scattering z error, scaled by cosh(eta)/pt (cm GeV)");
+    desc.add<double>("eps", 0.07)->setComment("maximum distance of compatible tracks (cm)");
+    desc.add<double>("chi2max", 9.)->setComment("maximum normalised distance^2 of compatible tracks");
+    desc.add<unsigned int>("minT", 2)->setComment("minimum number of tracks of a vertex");
+    desc.add<double>("vertexChi2max", 9.)->setComment("of a track to its vertex");
+    desc.add<double>("splitChi2max", 4.)->setComment("the vertices of larger chi2/ndof are split in two");
+  }
+
+  inline Params makeParams(edm::ParameterSet const& iConfig) {
+    Params params;
+    params.minHits = iConfig.getParameter<unsigned int>("minHits");
+    params.ptMin = iConfig.getParameter<double>("ptMin");
+    params.ptMax = iConfig.getParameter<double>("ptMax");
+    params.zMax = iConfig.getParameter<double>("zMax");
+    params.zErrConst = iConfig.getParameter<double>("zErrConst");
+    params.zErrMS = iConfig.getParameter<double>("zErrMS");
+    params.eps = iConfig.getParameter<double>("eps");
+    params.chi2max = iConfig.getParameter<double>("chi2max");
+    params.minT = iConfig.getParameter<unsigned int>("minT");
+    params.vertexChi2max = iConfig.getParameter<double>("vertexChi2max");
+    params.splitChi2max = iConfig.getParameter<double>("splitChi2max");
+    return params;
+  }
+
+}  // namespace pixelVertex
+
+#endif
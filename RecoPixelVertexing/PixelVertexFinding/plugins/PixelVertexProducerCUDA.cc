@@ -0,0 +1,58 @@
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/Track/interface/PixelTrackCUDA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexCUDA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+
+#include "PixelVertexFinderOnGPU.h"
+#include "PixelVertexParams.h"
+
+/**
+ * Clusters the pixel tracks built on the GPU in vertices along z, on the
+ * GPU: the density-based clustering of PixelVertexAlgos.h, followed by
+ * the splitting of the vertices of too large chi2. The vertices stay on
+ * the device, PixelVertexSoAFromCUDA copies them to the host.
+ */
+class PixelVertexProducerCUDA : public edm::global::EDProducer<> {
+public:
+  explicit PixelVertexProducerCUDA(const edm::ParameterSet& iConfig);
+  ~PixelVertexProducerCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const override;
+
+  const edm::EDGetTokenT<cms::cuda::Product<PixelTrackCUDA>> trackGetToken_;
+  const edm::EDPutTokenT<cms::cuda::Product<ZVertexCUDA>> vertexPutToken_;
+
+  const pixelVertex::Params params_;
+};
+
+PixelVertexProducerCUDA::PixelVertexProducerCUDA(const edm::ParameterSet& iConfig)
+    : trackGetToken_(consumes<cms::cuda::Product<PixelTrackCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      vertexPutToken_(produces<cms::cuda::Product<ZVertexCUDA>>()),
+      params_(pixelVertex::makeParams(iConfig)) {}
+
+void PixelVertexProducerCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("caHitNtupletCUDA"));
+  pixelVertex::fillParamsDescription(desc);
+  descriptions.add("pixelVertexProducerCUDA", desc);
+}
+
+void PixelVertexProducerCUDA::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const {
+  auto const& product = iEvent.get(trackGetToken_);
+  cms::cuda::ScopedContextProduce ctx{product};
+  auto const& tracks = ctx.get(product);
+
+  ctx.emplace(iEvent, vertexPutToken_, pixelVertex::makeVerticesAsync(tracks, params_, ctx.stream()));
+}
+
+DEFINE_FWK_MODULE(PixelVertexProducerCUDA);
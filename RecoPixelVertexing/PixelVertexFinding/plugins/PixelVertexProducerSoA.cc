@@ -0,0 +1,55 @@
+#include <memory>
+
+#include "CUDADataFormats/Track/interface/PixelTrackSoA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+
+#include "PixelVertexFinderOnCPU.h"
+#include "PixelVertexParams.h"
+
+/**
+ * Clusters the pixel tracks of a PixelTrackSoA on the host in vertices
+ * along z, with the same steps and parameters as PixelVertexProducerCUDA.
+ */
+class PixelVertexProducerSoA : public edm::stream::EDProducer<> {
+public:
+  explicit PixelVertexProducerSoA(const edm::ParameterSet& iConfig);
+  ~PixelVertexProducerSoA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  const edm::EDGetTokenT<PixelTrackSoA> trackGetToken_;
+  const edm::EDPutTokenT<ZVertexSoA> vertexPutToken_;
+
+  const pixelVertex::Params params_;
+  PixelVertexFinderOnCPU finder_;
+};
+
+PixelVertexProducerSoA::PixelVertexProducerSoA(const edm::ParameterSet& iConfig)
+    : trackGetToken_(consumes<PixelTrackSoA>(iConfig.getParameter<edm::InputTag>("src"))),
+      vertexPutToken_(produces<ZVertexSoA>()),
+      params_(pixelVertex::makeParams(iConfig)) {}
+
+void PixelVertexProducerSoA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("caHitNtupletCPU"));
+  pixelVertex::fillParamsDescription(desc);
+  descriptions.add("pixelVertexProducerSoA", desc);
+}
+
+void PixelVertexProducerSoA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  auto output = std::make_unique<ZVertexSoA>();
+  finder_.makeVertices(iEvent.get(trackGetToken_), params_, *output);
+  iEvent.put(vertexPutToken_, std::move(output));
+}
+
+DEFINE_FWK_MODULE(PixelVertexProducerSoA);
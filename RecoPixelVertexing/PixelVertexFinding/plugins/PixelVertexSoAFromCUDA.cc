@@ -0,0 +1,66 @@
+#include <cstring>
+#include <memory>
+
+#include "CUDADataFormats/Common/interface/Product.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexCUDA.h"
+#include "CUDADataFormats/Vertex/interface/ZVertexSoA.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "HeterogeneousCore/CUDACore/interface/ScopedContext.h"
+#include "HeterogeneousCore/CUDAUtilities/interface/host_unique_ptr.h"
+
+/**
+ * Copies the pixel vertices found on the GPU back to the host, as the
+ * same ZVertexSoA filled by PixelVertexProducerSoA.
+ */
+class PixelVertexSoAFromCUDA : public edm::stream::EDProducer<edm::ExternalWork> {
+public:
+  explicit PixelVertexSoAFromCUDA(const edm::ParameterSet& iConfig);
+  ~PixelVertexSoAFromCUDA() override = default;
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+private:
+  void acquire(const edm::Event& iEvent,
+               const edm::EventSetup& iSetup,
+               edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
+  void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
+
+  edm::EDGetTokenT<cms::cuda::Product<ZVertexCUDA>> vertexGetToken_;
+  edm::EDPutTokenT<ZVertexSoA> vertexPutToken_;
+
+  cms::cuda::host::unique_ptr<ZVertexSoA> vertices_;
+};
+
+PixelVertexSoAFromCUDA::PixelVertexSoAFromCUDA(const edm::ParameterSet& iConfig)
+    : vertexGetToken_(consumes<cms::cuda::Product<ZVertexCUDA>>(iConfig.getParameter<edm::InputTag>("src"))),
+      vertexPutToken_(produces<ZVertexSoA>()) {}
+
+void PixelVertexSoAFromCUDA::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("pixelVertexProducerCUDA"));
+  descriptions.add("pixelVertexSoAFromCUDA", desc);
+}
+
+void PixelVertexSoAFromCUDA::acquire(const edm::Event& iEvent,
+                                     const edm::EventSetup& iSetup,
+                                     edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+  auto const& product = iEvent.get(vertexGetToken_);
+  cms::cuda::ScopedContextAcquire ctx{product, std::move(waitingTaskHolder)};
+  vertices_ = ctx.get(product).toHostAsync(ctx.stream());
+}
+
+void PixelVertexSoAFromCUDA::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  // the pinned buffer goes back to the caching allocator, the product owns a copy
+  auto output = std::make_unique<ZVertexSoA>();
+  std::memcpy(output.get(), vertices_.get(), sizeof(ZVertexSoA));
+  iEvent.put(vertexPutToken_, std::move(output));
+  vertices_.reset();
+}
+
+DEFINE_FWK_MODULE(PixelVertexSoAFromCUDA);
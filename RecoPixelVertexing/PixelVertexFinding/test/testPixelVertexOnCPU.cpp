@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "RecoPixelVertexing/PixelVertexFinding/plugins/PixelVertexFinderOnCPU.h"
+
+int main() {
+  pixelVertex::Params const params{3, 0.5f, 75.f, 25.f, 0.01f, 0.05f, 0.07f, 9.f, 2, 9.f, 4.f};
+
+  // the tracks of some vertices, two of them too close to be separated by the density alone
+  constexpr float zVertices[] = {-7.f, -2.f, 0.5f, 0.62f, 4.f, 11.f};
+  constexpr uint32_t nTracksPerVertex[] = {20, 8, 30, 30, 5, 12};
+  constexpr uint32_t nVertices = std::size(zVertices);
+
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float> ptDistribution(0.6f, 5.f);
+  std::uniform_real_distribution<float> etaDistribution(-2.f, 2.f);
+  std::normal_distribution<float> gauss;
+
+  auto tracks = std::make_unique<PixelTrackSoA>();
+  tracks->nFound = 0;
+  std::vector<int> trueVertex;
+  for (uint32_t v = 0; v < nVertices; ++v) {
+    for (uint32_t k = 0; k < nTracksPerVertex[v]; ++k) {
+      uint32_t const t = tracks->nFound++;
+      float const pt = ptDistribution(random);
+      float const eta = etaDistribution(random);
+      float const ms = params.zErrMS * std::cosh(eta) / pt;
+      float const error = std::sqrt(params.zErrConst * params.zErrConst + ms * ms);
+      tracks->nHits[t] = 4;
+      tracks->pt[t] = pt;
+      tracks->eta[t] = eta;
+      tracks->zip[t] = zVertices[v] + error * gauss(random);
+      trueVertex.push_back(v);
+    }
+  }
+  // a track below ptMin
+  uint32_t const soft = tracks->nFound++;
+  tracks->nHits[soft] = 4;
+  tracks->pt[soft] = 0.3f;
+  tracks->eta[soft] = 0.f;
+  tracks->zip[soft] = 0.5f;
+
+  auto vertices = std::make_unique<ZVertexSoA>();
+  PixelVertexFinderOnCPU finder;
+  finder.makeVertices(*tracks, params, *vertices);
+
+  std::cout << vertices->nvFinal << " vertices" << std::endl;
+  for (uint32_t k = 0; k < vertices->nvFinal; ++k) {
+    auto const v = vertices->sortInd[k];
+    std::cout << "z " << vertices->zv[v] << " +- " << 1.f / std::sqrt(vertices->wv[v]) << " chi2 "
+              << vertices->chi2[v] << " ndof " << vertices->ndof[v] << " ptv2 " << vertices->ptv2[v] << std::endl;
+    if (k > 0)
+      assert(vertices->ptv2[v] <= vertices->ptv2[vertices->sortInd[k - 1]]);
+  }
+  assert(vertices->nvFinal == nVertices);
+  assert(vertices->idv[soft] == -1);
+
+  // each true vertex is found, with most of its tracks
+  for (uint32_t v = 0; v < nVertices; ++v) {
+    int found = -1;
+    for (uint32_t k = 0; k < vertices->nvFinal; ++k) {
+      auto const i = vertices->sortInd[k];
+      if (std::abs(vertices->zv[i] - zVertices[v]) < 0.02f)
+        found = i;
+    }
+    assert(found >= 0);
+    uint32_t nAssigned = 0;
+    for (uint32_t t = 0; t < trueVertex.size(); ++t) {
+      if (trueVertex[t] == int(v) && vertices->idv[t] == found)
+        ++nAssigned;
+    }
+    std::cout << "vertex at " << zVertices[v] << ": " << nAssigned << " of " << nTracksPerVertex[v] << " tracks"
+              << std::endl;
+    assert(nAssigned >= 0.8f * nTracksPerVertex[v]);
+  }
+
+  return 0;
+}
@@ -8,6 +8,7 @@
 
 #include "RecoTauTag/RecoTau/interface/DeepTauBase.h"
 #include "FWCore/Utilities/interface/isFinite.h"
+#include "CommonTools/Utils/interface/EtaPhiConeIndex.h"
 
 namespace deep_tau {
   constexpr int NumberOfOutputs = 4;
@@ -736,28 +737,46 @@ namespace {
     return iter->second;
   }
 
-  using Cell = std::map<CellObjectType, size_t>;
+  // the index in its collection of the object of each type in a cell
+  class Cell {
+  public:
+    Cell() { indices_.fill(-1); }
+
+    bool empty() const { return nObjects_ == 0; }
+    size_t count(CellObjectType type) const { return indices_[static_cast<size_t>(type)] >= 0; }
+    size_t at(CellObjectType type) const {
+      if (!count(type))
+        throw cms::Exception("DeepTauId") << "no object of type " << static_cast<int>(type) << " in the cell.";
+      return indices_[static_cast<size_t>(type)];
+    }
+    // returns the index of the object of the type, or -1 if there is none
+    int find(CellObjectType type) const { return indices_[static_cast<size_t>(type)]; }
+    void set(CellObjectType type, size_t index) {
+      int& cellIndex = indices_[static_cast<size_t>(type)];
+      if (cellIndex < 0)
+        ++nObjects_;
+      cellIndex = index;
+    }
+
+  private:
+    std::array<int, static_cast<size_t>(CellObjectType::Other)> indices_;
+    unsigned nObjects_ = 0;
+  };
+
   struct CellIndex {
     int eta, phi;
-
-    bool operator<(const CellIndex& other) const {
-      if (eta != other.eta)
-        return eta < other.eta;
-      return phi < other.phi;
-    }
   };
 
+  // all the cells of the grid, eta row by eta row, most of them empty
   class CellGrid {
   public:
-    using Map = std::map<CellIndex, Cell>;
-    using const_iterator = Map::const_iterator;
-
     CellGrid(unsigned n_cells_eta, unsigned n_cells_phi, double cell_size_eta, double cell_size_phi)
         : nCellsEta(n_cells_eta),
           nCellsPhi(n_cells_phi),
           nTotal(nCellsEta * nCellsPhi),
           cellSizeEta(cell_size_eta),
-          cellSizePhi(cell_size_phi) {
+          cellSizePhi(cell_size_phi),
+          cells(nTotal) {
       if (nCellsEta % 2 != 1 || nCellsEta < 1)
         throw cms::Exception("DeepTauId") << "Invalid number of eta cells.";
       if (nCellsPhi % 2 != 1 || nCellsPhi < 1)
@@ -787,20 +806,22 @@ namespace {
              getCellIndex(deltaPhi, maxDeltaPhi(), cellSizePhi, cellIndex.phi);
     }
 
-    size_t num_valid_cells() const { return cells.size(); }
-    Cell& operator[](const CellIndex& cellIndex) { return cells[cellIndex]; }
-    const Cell& at(const CellIndex& cellIndex) const { return cells.at(cellIndex); }
-    size_t count(const CellIndex& cellIndex) const { return cells.count(cellIndex); }
-    const_iterator find(const CellIndex& cellIndex) const { return cells.find(cellIndex); }
-    const_iterator begin() const { return cells.begin(); }
-    const_iterator end() const { return cells.end(); }
+    size_t num_valid_cells() const {
+      return std::count_if(cells.begin(), cells.end(), [](const Cell& cell) { return !cell.empty(); });
+    }
+    Cell& operator[](const CellIndex& cellIndex) { return cells[position(cellIndex)]; }
+    const Cell& at(const CellIndex& cellIndex) const { return cells.at(position(cellIndex)); }
 
   public:
     const unsigned nCellsEta, nCellsPhi, nTotal;
     const double cellSizeEta, cellSizePhi;
 
   private:
-    std::map<CellIndex, Cell> cells;
+    size_t position(const CellIndex& cellIndex) const {
+      return getEtaTensorIndex(cellIndex) * nCellsPhi + getPhiTensorIndex(cellIndex);
+    }
+
+    std::vector<Cell> cells;
   };
 
 }  // anonymous namespace
@@ -892,7 +913,7 @@ public:
         muonTensor_[is_inner]->flat<float>().setZero();
         hadronsTensor_[is_inner]->flat<float>().setZero();
 
-        setCellConvFeatures(*zeroOutputTensor_[is_inner], getPartialPredictions(is_inner), 0, 0, 0);
+        setCellConvFeatures(*zeroOutputTensor_[is_inner], getPartialPredictions(is_inner), 0, 0, 0, 0);
       }
     } else {
       throw cms::Exception("DeepTauId") << "version " << version << " is not supported.";
@@ -907,6 +928,8 @@ public:
 
 private:
   static constexpr float pi = M_PI;
+  // the size of the outer cone around the tau, in which the objects are added to the grids
+  static constexpr double outer_cone_size = 0.5;
 
   template <typename T>
   static float getValue(T value) {
@@ -953,18 +976,22 @@ private:
       return false;
   }
 
-  inline void checkInputs(
-      const tensorflow::Tensor& inputs, const char* block_name, int n_inputs, int n_eta = 1, int n_phi = 1) const {
+  inline void checkInputs(const tensorflow::Tensor& inputs,
+                          const char* block_name,
+                          int n_inputs,
+                          int batch_index = 0,
+                          int n_eta = 1,
+                          int n_phi = 1) const {
     if (debug_level >= 1) {
       for (int eta = 0; eta < n_eta; ++eta) {
         for (int phi = 0; phi < n_phi; phi++) {
           for (int k = 0; k < n_inputs; ++k) {
-            const float input =
-                n_eta == 1 && n_phi == 1 ? inputs.matrix<float>()(0, k) : inputs.tensor<float, 4>()(0, eta, phi, k);
+            const float input = inputs.dims() == 2 ? inputs.matrix<float>()(batch_index, k)
+                                                   : inputs.tensor<float, 4>()(batch_index, eta, phi, k);
             if (edm::isNotFinite(input))
               throw cms::Exception("DeepTauId")
-                  << "in the " << block_name << ", input is not finite, i.e. infinite or NaN, for eta_index = " << n_eta
-                  << ", phi_index = " << n_phi << ", input_index = " << k;
+                  << "in the " << block_name << ", input is not finite, i.e. infinite or NaN, for batch_index = "
+                  << batch_index << ", eta_index = " << eta << ", phi_index = " << phi << ", input_index = " << k;
             if (debug_level >= 2)
               std::cout << block_name << "," << eta << "," << phi << "," << k << "," << std::setprecision(5)
                         << std::fixed << input << '\n';
@@ -994,21 +1021,32 @@ private:
     event.getByToken(rho_token_, rho);
 
     tensorflow::Tensor predictions(tensorflow::DT_FLOAT, {static_cast<int>(taus->size()), deep_tau::NumberOfOutputs});
-    for (size_t tau_index = 0; tau_index < taus->size(); ++tau_index) {
-      std::vector<tensorflow::Tensor> pred_vector;
-      if (version == 1)
-        getPredictionsV1(taus->at(tau_index), *electrons, *muons, pred_vector);
-      else if (version == 2)
-        getPredictionsV2(taus->at(tau_index), *electrons, *muons, *pfCands, vertices->at(0), *rho, pred_vector);
-      else
-        throw cms::Exception("DeepTauId") << "version " << version << " is not supported.";
+    const auto setPredictions = [&](size_t tau_index, const tensorflow::Tensor& pred_tensor, size_t pred_row) {
       for (int k = 0; k < deep_tau::NumberOfOutputs; ++k) {
-        const float pred = pred_vector[0].flat<float>()(k);
+        const float pred = pred_tensor.flat<float>()(pred_row * deep_tau::NumberOfOutputs + k);
         if (!(pred >= 0 && pred <= 1))
           throw cms::Exception("DeepTauId")
               << "invalid prediction = " << pred << " for tau_index = " << tau_index << ", pred_index = " << k;
         predictions.matrix<float>()(tau_index, k) = pred;
       }
+    };
+
+    if (version == 1) {
+      for (size_t tau_index = 0; tau_index < taus->size(); ++tau_index) {
+        std::vector<tensorflow::Tensor> pred_vector;
+        getPredictionsV1(taus->at(tau_index), *electrons, *muons, pred_vector);
+        setPredictions(tau_index, pred_vector[0], 0);
+      }
+    } else if (version == 2) {
+      // the predictions of all the taus of the event in one batch
+      if (!taus->empty()) {
+        std::vector<tensorflow::Tensor> pred_vector;
+        getPredictionsV2(*taus, *electrons, *muons, *pfCands, vertices->at(0), *rho, pred_vector);
+        for (size_t tau_index = 0; tau_index < taus->size(); ++tau_index)
+          setPredictions(tau_index, pred_vector[0], tau_index);
+      }
+    } else {
+      throw cms::Exception("DeepTauId") << "version " << version << " is not supported.";
     }
     return predictions;
   }
@@ -1021,22 +1059,38 @@ private:
     tensorflow::run(&(cache_->getSession()), {{input_layer_, inputs}}, {output_layer_}, &pred_vector);
   }
 
-  void getPredictionsV2(const TauType& tau,
+  void getPredictionsV2(const TauCollection& taus,
                         const pat::ElectronCollection& electrons,
                         const pat::MuonCollection& muons,
                         const pat::PackedCandidateCollection& pfCands,
                         const reco::Vertex& pv,
                         double rho,
                         std::vector<tensorflow::Tensor>& pred_vector) {
-    CellGrid inner_grid(dnn_inputs_2017_v2::number_of_inner_cell, dnn_inputs_2017_v2::number_of_inner_cell, 0.02, 0.02);
-    CellGrid outer_grid(dnn_inputs_2017_v2::number_of_outer_cell, dnn_inputs_2017_v2::number_of_outer_cell, 0.05, 0.05);
-    fillGrids(tau, electrons, inner_grid, outer_grid);
-    fillGrids(tau, muons, inner_grid, outer_grid);
-    fillGrids(tau, pfCands, inner_grid, outer_grid);
+    // the objects of the event are indexed once for the grids of all the taus
+    electronIndex_.fill(electrons, outer_cone_size);
+    muonIndex_.fill(muons, outer_cone_size);
+    pfCandIndex_.fill(pfCands, outer_cone_size);
+
+    std::vector<CellGrid> inner_grids, outer_grids;
+    inner_grids.reserve(taus.size());
+    outer_grids.reserve(taus.size());
+    for (const auto& tau : taus) {
+      inner_grids.emplace_back(
+          dnn_inputs_2017_v2::number_of_inner_cell, dnn_inputs_2017_v2::number_of_inner_cell, 0.02, 0.02);
+      outer_grids.emplace_back(
+          dnn_inputs_2017_v2::number_of_outer_cell, dnn_inputs_2017_v2::number_of_outer_cell, 0.05, 0.05);
+      fillGrids(tau, electrons, electronIndex_, inner_grids.back(), outer_grids.back());
+      fillGrids(tau, muons, muonIndex_, inner_grids.back(), outer_grids.back());
+      fillGrids(tau, pfCands, pfCandIndex_, inner_grids.back(), outer_grids.back());
+    }
 
-    createTauBlockInputs(tau, pv, rho);
-    createConvFeatures(tau, pv, rho, electrons, muons, pfCands, inner_grid, true);
-    createConvFeatures(tau, pv, rho, electrons, muons, pfCands, outer_grid, false);
+    const int n_taus = taus.size();
+    resizeTensor(tauBlockTensor_, {n_taus, dnn_inputs_2017_v2::TauBlockInputs::NumberOfInputs});
+    tauBlockTensor_->flat<float>().setZero();
+    for (int tau_index = 0; tau_index < n_taus; ++tau_index)
+      createTauBlockInputs(tau_index, taus.at(tau_index), pv, rho);
+    createConvFeatures(taus, pv, rho, electrons, muons, pfCands, inner_grids, true);
+    createConvFeatures(taus, pv, rho, electrons, muons, pfCands, outer_grids, false);
 
     tensorflow::run(&(cache_->getSession("core")),
                     {{"input_tau", *tauBlockTensor_},
@@ -1046,9 +1100,19 @@ private:
                     &pred_vector);
   }
 
+  // reallocates the tensor only if its shape changes, its content being overwritten by the caller
+  static void resizeTensor(std::unique_ptr<tensorflow::Tensor>& tensor, const tensorflow::TensorShape& shape) {
+    if (!tensor || tensor->shape() != shape)
+      tensor = std::make_unique<tensorflow::Tensor>(tensorflow::DT_FLOAT, shape);
+  }
+
   template <typename Collection>
-  void fillGrids(const TauType& tau, const Collection& objects, CellGrid& inner_grid, CellGrid& outer_grid) {
-    static constexpr double outer_dR2 = 0.25;  //0.5^2
+  void fillGrids(const TauType& tau,
+                 const Collection& objects,
+                 const EtaPhiConeIndex& index,
+                 CellGrid& inner_grid,
+                 CellGrid& outer_grid) {
+    static constexpr double outer_dR2 = outer_cone_size * outer_cone_size;
     const double inner_radius = getInnerSignalConeRadius(tau.polarP4().pt());
     const double inner_dR2 = std::pow(inner_radius, 2);
 
@@ -1060,18 +1124,16 @@ private:
       CellIndex cell_index;
       if (grid.tryGetCellIndex(deta, dphi, cell_index)) {
         Cell& cell = grid[cell_index];
-        auto iter = cell.find(obj_type);
-        if (iter != cell.end()) {
-          const auto& prev_obj = objects.at(iter->second);
-          if (obj.polarP4().pt() > prev_obj.polarP4().pt())
-            iter->second = n;
-        } else {
-          cell[obj_type] = n;
-        }
+        const int prev_index = cell.find(obj_type);
+        if (prev_index < 0 || obj.polarP4().pt() > objects.at(prev_index).polarP4().pt())
+          cell.set(obj_type, n);
       }
     };
 
-    for (size_t n = 0; n < objects.size(); ++n) {
+    // the objects around the tau, in the order of the collection, so that the first of the objects of the same
+    // pt is kept in a cell
+    index.candidatesInCone(tau.polarP4().eta(), tau.polarP4().phi(), outer_cone_size, cone_indices_);
+    for (const size_t n : cone_indices_) {
       const auto& obj = objects.at(n);
       const double deta = obj.polarP4().eta() - tau.polarP4().eta();
       const double dphi = reco::deltaPhi(obj.polarP4().phi(), tau.polarP4().phi());
@@ -1107,63 +1169,68 @@ private:
     return pred_vector.at(0);
   }
 
-  void createConvFeatures(const TauType& tau,
+  // the inner or outer grids of all the taus, the cells of which are run in one batch
+  void createConvFeatures(const TauCollection& taus,
                           const reco::Vertex& pv,
                           double rho,
                           const pat::ElectronCollection& electrons,
                           const pat::MuonCollection& muons,
                           const pat::PackedCandidateCollection& pfCands,
-                          const CellGrid& grid,
+                          const std::vector<CellGrid>& grids,
                           bool is_inner) {
-    tensorflow::Tensor& convTensor = *convTensor_.at(is_inner);
-
-    eGammaTensor_[is_inner] = std::make_unique<tensorflow::Tensor>(
-        tensorflow::DT_FLOAT,
-        tensorflow::TensorShape{
-            (long long int)grid.num_valid_cells(), 1, 1, dnn_inputs_2017_v2::EgammaBlockInputs::NumberOfInputs});
-    muonTensor_[is_inner] = std::make_unique<tensorflow::Tensor>(
-        tensorflow::DT_FLOAT,
-        tensorflow::TensorShape{
-            (long long int)grid.num_valid_cells(), 1, 1, dnn_inputs_2017_v2::MuonBlockInputs::NumberOfInputs});
-    hadronsTensor_[is_inner] = std::make_unique<tensorflow::Tensor>(
-        tensorflow::DT_FLOAT,
-        tensorflow::TensorShape{
-            (long long int)grid.num_valid_cells(), 1, 1, dnn_inputs_2017_v2::HadronBlockInputs::NumberOfInputs});
+    const int n_taus = taus.size();
+    const long long int n_cells =
+        is_inner ? dnn_inputs_2017_v2::number_of_inner_cell : dnn_inputs_2017_v2::number_of_outer_cell;
+    long long int n_valid_cells = 0;
+    for (const auto& grid : grids)
+      n_valid_cells += grid.num_valid_cells();
+
+    resizeTensor(eGammaTensor_[is_inner],
+                 {n_valid_cells, 1, 1, dnn_inputs_2017_v2::EgammaBlockInputs::NumberOfInputs});
+    resizeTensor(muonTensor_[is_inner], {n_valid_cells, 1, 1, dnn_inputs_2017_v2::MuonBlockInputs::NumberOfInputs});
+    resizeTensor(hadronsTensor_[is_inner],
+                 {n_valid_cells, 1, 1, dnn_inputs_2017_v2::HadronBlockInputs::NumberOfInputs});
+    resizeTensor(convTensor_[is_inner], {n_taus, n_cells, n_cells, dnn_inputs_2017_v2::number_of_conv_features});
 
     eGammaTensor_[is_inner]->flat<float>().setZero();
     muonTensor_[is_inner]->flat<float>().setZero();
     hadronsTensor_[is_inner]->flat<float>().setZero();
 
     unsigned idx = 0;
-    for (int eta = -grid.maxEtaIndex(); eta <= grid.maxEtaIndex(); ++eta) {
-      for (int phi = -grid.maxPhiIndex(); phi <= grid.maxPhiIndex(); ++phi) {
-        const CellIndex cell_index{eta, phi};
-        const auto cell_iter = grid.find(cell_index);
-        if (cell_iter != grid.end()) {
-          const Cell& cell = cell_iter->second;
-          createEgammaBlockInputs(idx, tau, pv, rho, electrons, pfCands, cell, is_inner);
-          createMuonBlockInputs(idx, tau, pv, rho, muons, pfCands, cell, is_inner);
-          createHadronsBlockInputs(idx, tau, pv, rho, pfCands, cell, is_inner);
-          idx += 1;
+    for (int tau_index = 0; tau_index < n_taus; ++tau_index) {
+      const auto& tau = taus.at(tau_index);
+      const CellGrid& grid = grids.at(tau_index);
+      for (int eta = -grid.maxEtaIndex(); eta <= grid.maxEtaIndex(); ++eta) {
+        for (int phi = -grid.maxPhiIndex(); phi <= grid.maxPhiIndex(); ++phi) {
+          const Cell& cell = grid.at(CellIndex{eta, phi});
+          if (!cell.empty()) {
+            createEgammaBlockInputs(idx, tau, pv, rho, electrons, pfCands, cell, is_inner);
+            createMuonBlockInputs(idx, tau, pv, rho, muons, pfCands, cell, is_inner);
+            createHadronsBlockInputs(idx, tau, pv, rho, pfCands, cell, is_inner);
+            idx += 1;
+          }
         }
       }
     }
 
-    const auto predTensor = getPartialPredictions(is_inner);
+    tensorflow::Tensor& convTensor = *convTensor_.at(is_inner);
+    const tensorflow::Tensor predTensor = n_valid_cells > 0 ? getPartialPredictions(is_inner) : tensorflow::Tensor();
 
     idx = 0;
-    for (int eta = -grid.maxEtaIndex(); eta <= grid.maxEtaIndex(); ++eta) {
-      for (int phi = -grid.maxPhiIndex(); phi <= grid.maxPhiIndex(); ++phi) {
-        const CellIndex cell_index{eta, phi};
-        const int eta_index = grid.getEtaTensorIndex(cell_index);
-        const int phi_index = grid.getPhiTensorIndex(cell_index);
-
-        const auto cell_iter = grid.find(cell_index);
-        if (cell_iter != grid.end()) {
-          setCellConvFeatures(convTensor, predTensor, idx, eta_index, phi_index);
-          idx += 1;
-        } else {
-          setCellConvFeatures(convTensor, *zeroOutputTensor_[is_inner], 0, eta_index, phi_index);
+    for (int tau_index = 0; tau_index < n_taus; ++tau_index) {
+      const CellGrid& grid = grids.at(tau_index);
+      for (int eta = -grid.maxEtaIndex(); eta <= grid.maxEtaIndex(); ++eta) {
+        for (int phi = -grid.maxPhiIndex(); phi <= grid.maxPhiIndex(); ++phi) {
+          const CellIndex cell_index{eta, phi};
+          const int eta_index = grid.getEtaTensorIndex(cell_index);
+          const int phi_index = grid.getPhiTensorIndex(cell_index);
+
+          if (!grid.at(cell_index).empty()) {
+            setCellConvFeatures(convTensor, predTensor, idx, tau_index, eta_index, phi_index);
+            idx += 1;
+          } else {
+            setCellConvFeatures(convTensor, *zeroOutputTensor_[is_inner], 0, tau_index, eta_index, phi_index);
+          }
         }
       }
     }
@@ -1172,19 +1239,20 @@ private:
   void setCellConvFeatures(tensorflow::Tensor& convTensor,
                            const tensorflow::Tensor& features,
                            unsigned batch_idx,
+                           int tau_index,
                            int eta_index,
                            int phi_index) {
-    for (int n = 0; n < dnn_inputs_2017_v2::number_of_conv_features; ++n)
-      convTensor.tensor<float, 4>()(0, eta_index, phi_index, n) = features.tensor<float, 4>()(batch_idx, 0, 0, n);
+    const float* cellFeatures = &features.tensor<float, 4>()(batch_idx, 0, 0, 0);
+    float* convFeatures = &convTensor.tensor<float, 4>()(tau_index, eta_index, phi_index, 0);
+    std::copy_n(cellFeatures, dnn_inputs_2017_v2::number_of_conv_features, convFeatures);
   }
 
-  void createTauBlockInputs(const TauType& tau, const reco::Vertex& pv, double rho) {
+  void createTauBlockInputs(int tau_index, const TauType& tau, const reco::Vertex& pv, double rho) {
     namespace dnn = dnn_inputs_2017_v2::TauBlockInputs;
 
     tensorflow::Tensor& inputs = *tauBlockTensor_;
-    inputs.flat<float>().setZero();
 
-    const auto& get = [&](int var_index) -> float& { return inputs.matrix<float>()(0, var_index); };
+    const auto& get = [&](int var_index) -> float& { return inputs.matrix<float>()(tau_index, var_index); };
 
     auto leadChargedHadrCand = dynamic_cast<const pat::PackedCandidate*>(tau.leadChargedHadrCand().get());
 
@@ -1274,7 +1342,7 @@ private:
     get(dnn::leadChargedCand_etaAtEcalEntrance_minus_tau_eta) =
         getValueNorm(tau.etaAtEcalEntranceLeadChargedCand() - tau.p4().eta(), 0.0042f, 0.0323f);
 
-    checkInputs(inputs, "tau_block", dnn::NumberOfInputs);
+    checkInputs(inputs, "tau_block", dnn::NumberOfInputs, tau_index);
   }
 
   void createEgammaBlockInputs(unsigned idx,
@@ -1493,7 +1561,7 @@ private:
             getValueNorm(closestCtfTrack->numberOfValidHits(), 15.16f, 5.26f);
       }
     }
-    checkInputs(inputs, is_inner ? "egamma_inner_block" : "egamma_outer_block", dnn::NumberOfInputs);
+    checkInputs(inputs, is_inner ? "egamma_inner_block" : "egamma_outer_block", dnn::NumberOfInputs, idx);
   }
 
   void createMuonBlockInputs(unsigned idx,
@@ -1633,7 +1701,7 @@ private:
         }
       }
     }
-    checkInputs(inputs, is_inner ? "muon_inner_block" : "muon_outer_block", dnn::NumberOfInputs);
+    checkInputs(inputs, is_inner ? "muon_inner_block" : "muon_outer_block", dnn::NumberOfInputs, idx);
   }
 
   void createHadronsBlockInputs(unsigned idx,
@@ -1748,7 +1816,7 @@ private:
       }
       get(dnn::pfCand_nHad_hcalFraction) = getValue(hcal_fraction);
     }
-    checkInputs(inputs, is_inner ? "hadron_inner_block" : "hadron_outer_block", dnn::NumberOfInputs);
+    checkInputs(inputs, is_inner ? "hadron_inner_block" : "hadron_outer_block", dnn::NumberOfInputs, idx);
   }
 
   template <typename dnn>
@@ -2100,6 +2168,8 @@ private:
   std::unique_ptr<tensorflow::Tensor> tauBlockTensor_;
   std::array<std::unique_ptr<tensorflow::Tensor>, 2> eGammaTensor_, muonTensor_, hadronsTensor_, convTensor_,
       zeroOutputTensor_;
+  EtaPhiConeIndex electronIndex_, muonIndex_, pfCandIndex_;
+  std::vector<unsigned int> cone_indices_;
 };
 
 #include "FWCore/Framework/interface/MakerMacros.h"
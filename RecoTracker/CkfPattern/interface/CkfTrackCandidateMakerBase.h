@@ -49,6 +49,7 @@ namespace cms {
     bool cleanTrajectoryAfterInOut;
     bool reverseTrajectories;
     bool produceSeedStopReasons_;
+    bool buildSeedsInParallel_;
 
     unsigned int theMaxNSeeds;
 
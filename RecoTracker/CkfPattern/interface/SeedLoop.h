@@ -0,0 +1,46 @@
+#ifndef RecoTracker_CkfPattern_SeedLoop_h
+#define RecoTracker_CkfPattern_SeedLoop_h
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace ckf {
+
+  // The loop of CkfTrackCandidateMakerBase over the seeds indices[0], ..., indices[n-1]:
+  // - isCleaned(j) tells if the seed cleaning kills the seed j, given the trajectories stored so far;
+  // - build(j, trajectories) builds the trajectories of the seed j, and depends only on the seed;
+  // - store(j, trajectories) keeps them, and gives them to the seed cleaning.
+  // In parallel all the seeds are built concurrently first, then cleaned and stored serially in the
+  // order of the seeds: isCleaned and store see the same sequence as in the serial loop, and so the
+  // result is the same. The seeds killed by the cleaning are built for nothing.
+  template <typename T, typename Build, typename IsCleaned, typename Store>
+  void loopOverSeeds(
+      unsigned int const* indices, std::size_t n, bool parallel, Build&& build, IsCleaned&& isCleaned, Store&& store) {
+    if (parallel) {
+      std::vector<std::vector<T>> seedTrajectories(n);
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n), [&](const tbb::blocked_range<std::size_t>& range) {
+        for (std::size_t ii = range.begin(); ii != range.end(); ++ii)
+          build(indices[ii], seedTrajectories[ii]);
+      });
+      for (std::size_t ii = 0; ii < n; ++ii) {
+        if (!isCleaned(indices[ii]))
+          store(indices[ii], seedTrajectories[ii]);
+      }
+    } else {
+      std::vector<T> trajectories;
+      for (std::size_t ii = 0; ii < n; ++ii) {
+        auto j = indices[ii];
+        if (isCleaned(j))
+          continue;
+        build(j, trajectories);
+        store(j, trajectories);
+      }
+    }
+  }
+
+}  // namespace ckf
+
+#endif
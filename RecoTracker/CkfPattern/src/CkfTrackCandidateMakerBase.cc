@@ -37,14 +37,9 @@
 
 // #define VI_SORTSEED
 // #define VI_REPRODUCIBLE
-// #define VI_TBB
-
-#include <thread>
-#ifdef VI_TBB
-#include "tbb/parallel_for.h"
-#endif
 
 #include "RecoTracker/CkfPattern/interface/PrintoutHelper.h"
+#include "RecoTracker/CkfPattern/interface/SeedLoop.h"
 
 using namespace edm;
 using namespace std;
@@ -65,6 +60,8 @@ namespace cms {
         cleanTrajectoryAfterInOut(conf.getParameter<bool>("cleanTrajectoryAfterInOut")),
         reverseTrajectories(conf.existsAs<bool>("reverseTrajectories") &&
                             conf.getParameter<bool>("reverseTrajectories")),
+        buildSeedsInParallel_(conf.existsAs<bool>("buildSeedsInParallel") &&
+                              conf.getParameter<bool>("buildSeedsInParallel")),
         theMaxNSeeds(conf.getParameter<unsigned int>("maxNSeeds")),
         theTrajectoryBuilder(
             createBaseCkfTrajectoryBuilder(conf.getParameter<edm::ParameterSet>("TrajectoryBuilderPSet"), iC)),
@@ -221,10 +218,6 @@ namespace cms {
       // method for debugging
       countSeedsDebugger();
 
-      // the mutex
-      std::mutex theMutex;
-      using Lock = std::unique_lock<std::mutex>;
-
       // Loop over seeds
       size_t collseed_size = collseed->size();
 
@@ -263,39 +256,21 @@ namespace cms {
       // std::cout << spt(indeces[0]) << ' ' << spt(indeces[collseed_size-1]) << std::endl;
 #endif
 
-      std::atomic<unsigned int> ntseed(0);
-      auto theLoop = [&](size_t ii) {
-        auto j = indeces[ii];
-
-        ntseed++;
-
-        // to be moved inside a par section (how with tbb??)
-        std::vector<Trajectory> theTmpTrajectories;
-
+      // Build the trajectories of seed j into theTmpTrajectories; the
+      // trajectory builder and the cleaner are const, and the building of
+      // a seed depends only on the seed itself
+      auto buildSeed = [&](unsigned int j, std::vector<Trajectory>& theTmpTrajectories) {
         LogDebug("CkfPattern") << "======== Begin to look for trajectories from seed " << j << " ========\n";
 
-        {
-          Lock lock(theMutex);
-          // Check if seed hits already used by another track
-          if (theSeedCleaner && !theSeedCleaner->good(&((*collseed)[j]))) {
-            LogDebug("CkfTrackCandidateMakerBase") << " Seed cleaning kills seed " << j;
-            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
-            return;  // from the lambda!
-          }
-        }
-
         // Build trajectory from seed outwards
         theTmpTrajectories.clear();
         unsigned int nCandPerSeed = 0;
         auto const& startTraj =
             theTrajectoryBuilder->buildTrajectories((*collseed)[j], theTmpTrajectories, nCandPerSeed, nullptr);
-        {
-          Lock lock(theMutex);
-          (*outputSeedStopInfos)[j].setCandidatesPerSeed(nCandPerSeed);
-          if (theTmpTrajectories.empty()) {
-            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NO_TRAJECTORY);
-            return;  // from the lambda!
-          }
+        (*outputSeedStopInfos)[j].setCandidatesPerSeed(nCandPerSeed);
+        if (theTmpTrajectories.empty()) {
+          (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NO_TRAJECTORY);
+          return;
         }
 
         LogDebug("CkfPattern") << "======== In-out trajectory building found " << theTmpTrajectories.size()
@@ -321,7 +296,6 @@ namespace cms {
                                  << " valid/invalid trajectories from seed " << j << " ========\n"
                                  << PrintoutHelper::dumpCandidates(theTmpTrajectories);
           if (theTmpTrajectories.empty()) {
-            Lock lock(theMutex);
             (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_REGION_REBUILD);
             return;
           }
@@ -333,52 +307,50 @@ namespace cms {
         LogDebug("CkfPattern") << "======== Trajectory cleaning gave the following " << theTmpTrajectories.size()
                                << " valid trajectories from seed " << j << " ========\n"
                                << PrintoutHelper::dumpCandidates(theTmpTrajectories);
+      };
 
-        {
-          Lock lock(theMutex);
-          for (vector<Trajectory>::iterator it = theTmpTrajectories.begin(); it != theTmpTrajectories.end(); it++) {
-            if (it->isValid()) {
-              it->setSeedRef(collseed->refAt(j));
-              (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NOT_STOPPED);
-              // Store trajectory
-              rawResult.push_back(std::move(*it));
-              // Tell seed cleaner which hits this trajectory used.
-              //TO BE FIXED: this cut should be configurable via cfi file
-              if (theSeedCleaner && rawResult.back().foundHits() > 3)
-                theSeedCleaner->add(&rawResult.back());
-              //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
-            }
-          }
+      // Check if seed hits already used by another track
+      auto isCleaned = [&](unsigned int j) {
+        if (theSeedCleaner && !theSeedCleaner->good(&((*collseed)[j]))) {
+          LogDebug("CkfTrackCandidateMakerBase") << " Seed cleaning kills seed " << j;
+          (*outputSeedStopInfos)[j] = SeedStopInfo();
+          (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::SEED_CLEANING);
+          return true;
         }
+        return false;
+      };
 
+      // Move the valid trajectories of seed j to rawResult, in the order of the seeds
+      auto storeSeed = [&](unsigned int j, std::vector<Trajectory>& theTmpTrajectories) {
+        for (vector<Trajectory>::iterator it = theTmpTrajectories.begin(); it != theTmpTrajectories.end(); it++) {
+          if (it->isValid()) {
+            it->setSeedRef(collseed->refAt(j));
+            (*outputSeedStopInfos)[j].setStopReason(SeedStopReason::NOT_STOPPED);
+            // Store trajectory
+            rawResult.push_back(std::move(*it));
+            // Tell seed cleaner which hits this trajectory used.
+            //TO BE FIXED: this cut should be configurable via cfi file
+            if (theSeedCleaner && rawResult.back().foundHits() > 3)
+              theSeedCleaner->add(&rawResult.back());
+            //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
+          }
+        }
         theTmpTrajectories.clear();
 
         LogDebug("CkfPattern") << "rawResult trajectories found so far = " << rawResult.size();
 
-        {
-          Lock lock(theMutex);
-          if (maxSeedsBeforeCleaning_ > 0 && rawResult.size() > maxSeedsBeforeCleaning_ + lastCleanResult) {
-            theTrajectoryCleaner->clean(rawResult);
-            rawResult.erase(
-                std::remove_if(rawResult.begin() + lastCleanResult, rawResult.end(), std::not_fn(&Trajectory::isValid)),
-                rawResult.end());
-            lastCleanResult = rawResult.size();
-          }
+        if (maxSeedsBeforeCleaning_ > 0 && rawResult.size() > maxSeedsBeforeCleaning_ + lastCleanResult) {
+          theTrajectoryCleaner->clean(rawResult);
+          rawResult.erase(
+              std::remove_if(rawResult.begin() + lastCleanResult, rawResult.end(), std::not_fn(&Trajectory::isValid)),
+              rawResult.end());
+          lastCleanResult = rawResult.size();
         }
       };
+
+      ckf::loopOverSeeds<Trajectory>(indeces, collseed_size, buildSeedsInParallel_, buildSeed, isCleaned, storeSeed);
       // end of loop over seeds
 
-#ifdef VI_TBB
-      tbb::parallel_for(0UL, collseed_size, 1UL, theLoop);
-#else
-#ifdef VI_OMP
-#pragma omp parallel for schedule(dynamic, 4)
-#endif
-      for (size_t j = 0; j < collseed_size; j++) {
-        theLoop(j);
-      }
-#endif
-      assert(ntseed == collseed_size);
       if (theSeedCleaner)
         theSeedCleaner->done();
 
@@ -0,0 +1,118 @@
+// The seed loop of CkfTrackCandidateMakerBase gives the same trajectories, seed stop reasons
+// and seed cleaning in parallel as serially
+#include "RecoTracker/CkfPattern/interface/SeedLoop.h"
+
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+  struct Trajectory {
+    unsigned int seed = 0;
+    std::vector<int> hits;
+    bool valid = true;
+    bool operator==(const Trajectory& t) const { return seed == t.seed && hits == t.hits && valid == t.valid; }
+  };
+
+  enum class StopReason { NOT_BUILT, NO_TRAJECTORY, SEED_CLEANING, NOT_STOPPED };
+
+  struct StopInfo {
+    unsigned int candidates = 0;
+    StopReason reason = StopReason::NOT_BUILT;
+    bool operator==(const StopInfo& i) const { return candidates == i.candidates && reason == i.reason; }
+  };
+
+  struct Result {
+    std::vector<Trajectory> trajectories;
+    std::vector<StopInfo> stopInfos;
+  };
+
+  // seeds of 3 hits out of 300, so that many of them share their hits with the trajectories of the others
+  Result run(const std::vector<std::array<int, 3>>& seeds, const std::vector<unsigned int>& indices, bool parallel) {
+    Result result;
+    result.stopInfos.resize(seeds.size());
+    std::set<int> usedHits;
+
+    // as CkfTrackCandidateMakerBase: a few trajectories extending the seed, depending only on the seed
+    auto build = [&](unsigned int j, std::vector<Trajectory>& trajectories) {
+      trajectories.clear();
+      std::mt19937 rng(j);
+      const unsigned int n = rng() % 4;
+      for (unsigned int k = 0; k < n; ++k) {
+        Trajectory t;
+        t.seed = j;
+        t.hits.assign(seeds[j].begin(), seeds[j].end());
+        const unsigned int extra = rng() % 7;
+        for (unsigned int h = 0; h < extra; ++h)
+          t.hits.push_back(rng() % 300);
+        t.valid = rng() % 5 != 0;
+        trajectories.push_back(t);
+      }
+      result.stopInfos[j].candidates = n;
+      if (trajectories.empty())
+        result.stopInfos[j].reason = StopReason::NO_TRAJECTORY;
+    };
+
+    // as CachingSeedCleanerBySharedInput: a seed whose hits are all used by a stored trajectory is killed
+    auto isCleaned = [&](unsigned int j) {
+      for (int hit : seeds[j]) {
+        if (usedHits.count(hit) == 0)
+          return false;
+      }
+      result.stopInfos[j] = StopInfo();
+      result.stopInfos[j].reason = StopReason::SEED_CLEANING;
+      return true;
+    };
+
+    auto store = [&](unsigned int j, std::vector<Trajectory>& trajectories) {
+      for (auto& t : trajectories) {
+        if (t.valid) {
+          result.stopInfos[j].reason = StopReason::NOT_STOPPED;
+          if (t.hits.size() > 3)
+            usedHits.insert(t.hits.begin(), t.hits.end());
+          result.trajectories.push_back(std::move(t));
+        }
+      }
+      trajectories.clear();
+    };
+
+    ckf::loopOverSeeds<Trajectory>(indices.data(), indices.size(), parallel, build, isCleaned, store);
+    return result;
+  }
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(51);
+  std::vector<std::array<int, 3>> seeds(2000);
+  for (auto& seed : seeds) {
+    for (auto& hit : seed)
+      hit = rng() % 300;
+  }
+  std::vector<unsigned int> indices(seeds.size());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::shuffle(indices.begin(), indices.end(), rng);
+
+  const Result serial = run(seeds, indices, false);
+  const auto nCleaned = std::count_if(serial.stopInfos.begin(), serial.stopInfos.end(), [](const StopInfo& i) {
+    return i.reason == StopReason::SEED_CLEANING;
+  });
+
+  int failures = 0;
+  tbb::task_arena arena(8);
+  for (int iteration = 0; iteration < 20; ++iteration) {
+    const Result parallel = arena.execute([&] { return run(seeds, indices, true); });
+    failures += !(parallel.trajectories == serial.trajectories && parallel.stopInfos == serial.stopInfos);
+  }
+
+  std::cout << serial.trajectories.size() << " trajectories, " << nCleaned << " seeds killed by the cleaning, "
+            << failures << " parallel runs different from the serial one" << std::endl;
+  return failures == 0 && nCleaned > 0 && nCleaned < long(seeds.size()) ? 0 : 1;
+}
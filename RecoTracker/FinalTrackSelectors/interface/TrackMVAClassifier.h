@@ -17,6 +17,8 @@
 
 #include <vector>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 class TrackMVAClassifierBase : public edm::stream::EDProducer<> {
 public:
@@ -56,6 +58,17 @@ private:
 };
 
 namespace trackMVAClassifierImpl {
+
+  // an MVA can compute the values of all the tracks at once with computeMVAs()
+  template <typename MVA, typename = void>
+  struct HasComputeMVAs : std::false_type {};
+  template <typename MVA>
+  struct HasComputeMVAs<MVA,
+                        std::void_t<decltype(std::declval<MVA const&>().computeMVAs(
+                            std::declval<reco::TrackCollection const&>(),
+                            std::declval<reco::BeamSpot const&>(),
+                            std::declval<reco::VertexCollection const&>(),
+                            std::declval<TrackMVAClassifierBase::MVAPairCollection&>()))>> : std::true_type {};
   template <typename EventCache>
   struct ComputeMVA {
     template <typename MVA>
@@ -115,8 +128,12 @@ private:
                   reco::BeamSpot const& beamSpot,
                   reco::VertexCollection const& vertices,
                   MVAPairCollection& mvas) const final {
-    trackMVAClassifierImpl::ComputeMVA<EventCache> computer;
-    computer(mva, tracks, beamSpot, vertices, mvas);
+    if constexpr (trackMVAClassifierImpl::HasComputeMVAs<MVA>::value) {
+      mva.computeMVAs(tracks, beamSpot, vertices, mvas);
+    } else {
+      trackMVAClassifierImpl::ComputeMVA<EventCache> computer;
+      computer(mva, tracks, beamSpot, vertices, mvas);
+    }
   }
 
   MVA mva;
@@ -7,6 +7,8 @@
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "getBestVertex.h"
 
@@ -37,9 +39,28 @@ namespace {
       }
     }
 
-    float operator()(reco::Track const &trk,
+    static constexpr unsigned int nVars = PROMPT ? 16 : 12;
+
+    // the variables of all the tracks first, then the forest evaluated on all of them
+    void computeMVAs(reco::TrackCollection const &tracks,
                      reco::BeamSpot const &beamSpot,
-                     reco::VertexCollection const &vertices) const {
+                     reco::VertexCollection const &vertices,
+                     TrackMVAClassifierBase::MVAPairCollection &mvas) const {
+      std::vector<float> vars(tracks.size() * nVars);
+      for (size_t i = 0; i < tracks.size(); ++i)
+        fillVars(tracks[i], beamSpot, vertices, &vars[i * nVars]);
+
+      std::vector<double> classifiers(tracks.size());
+      forest_->GetClassifier(vars.data(), nVars, tracks.size(), classifiers.data());
+      //BDT outputs are considered always reliable. Hence "true"
+      for (size_t i = 0; i < tracks.size(); ++i)
+        mvas[i] = std::pair<float, bool>(classifiers[i], true);
+    }
+
+    void fillVars(reco::Track const &trk,
+                  reco::BeamSpot const &beamSpot,
+                  reco::VertexCollection const &vertices,
+                  float *gbrVals_) const {
       auto tmva_pt_ = trk.pt();
       auto tmva_ndof_ = trk.ndof();
       auto tmva_nlayers_ = trk.hitPattern().trackerLayersWithMeasurement();
@@ -72,7 +93,6 @@ namespace {
       auto tmva_lostmidfrac_ = static_cast<float>(trk.numberOfLostHits()) /
                                static_cast<float>(trk.numberOfValidHits() + trk.numberOfLostHits());
 
-      float gbrVals_[PROMPT ? 16 : 12];
       gbrVals_[0] = tmva_pt_;
       gbrVals_[1] = tmva_lostmidfrac_;
       gbrVals_[2] = tmva_minlost_;
@@ -98,8 +118,6 @@ namespace {
         gbrVals_[14] = tmva_absdz_;
         gbrVals_[15] = tmva_absd0_;
       }
-
-      return forest_->GetClassifier(gbrVals_);
     }
 
     static const char *name();
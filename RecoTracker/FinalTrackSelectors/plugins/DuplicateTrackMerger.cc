@@ -24,6 +24,12 @@
 #include "TrackMerger.h"
 
 #include "CommonTools/Utils/interface/DynArray.h"
+
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <iterator>
 #include <vector>
 #include <algorithm>
 #include <string>
@@ -312,7 +318,8 @@ namespace {
       ++nTracks;
     }
 
-    for (int i = 0; i < nTracks; i++) {
+    // the candidate pairs of the i-th track with the following ones, in order
+    auto checkPairs = [&](int i, std::vector<TrackCandidate> &candidates, CandidateToDuplicate &candidateMap) {
       const reco::Track *rt1 = selTracks[i];
       for (int j = i + 1; j < nTracks; j++) {
         const reco::Track *rt2 = selTracks[j];
@@ -373,8 +380,8 @@ namespace {
           continue;
 
         IfLogTrace(debug_, "DuplicateTrackMerger") << " marking as duplicates" << oriIndex[i] << ',' << oriIndex[j];
-        out_duplicateCandidates->push_back(merger_.merge(*t1, *t2, duplType));
-        out_candidateMap->emplace_back(oriIndex[i], oriIndex[j]);
+        candidates.push_back(merger_.merge(*t1, *t2, duplType));
+        candidateMap.emplace_back(oriIndex[i], oriIndex[j]);
 
 #ifdef VI_STAT
         ++stat.nCand;
@@ -385,7 +392,26 @@ namespace {
           ++stat.nLoop0;
 #endif
       }
+    };
+
+#ifdef EDM_ML_DEBUG
+    // serially, debug_ is set per pair
+    for (int i = 0; i < nTracks; i++)
+      checkPairs(i, *out_duplicateCandidates, *out_candidateMap);
+#else
+    // The pairs of each track are checked in parallel, and collected in the
+    // order of the tracks: the output does not depend on the scheduling.
+    std::vector<std::vector<TrackCandidate>> candidates(nTracks);
+    std::vector<CandidateToDuplicate> candidateMaps(nTracks);
+    tbb::parallel_for(tbb::blocked_range<int>(0, nTracks), [&](const tbb::blocked_range<int> &range) {
+      for (int i = range.begin(); i != range.end(); ++i)
+        checkPairs(i, candidates[i], candidateMaps[i]);
+    });
+    for (int i = 0; i < nTracks; i++) {
+      std::move(candidates[i].begin(), candidates[i].end(), std::back_inserter(*out_duplicateCandidates));
+      out_candidateMap->insert(out_candidateMap->end(), candidateMaps[i].begin(), candidateMaps[i].end());
     }
+#endif
     iEvent.put(std::move(out_duplicateCandidates), "candidates");
     iEvent.put(std::move(out_candidateMap), "candidateMap");
   }
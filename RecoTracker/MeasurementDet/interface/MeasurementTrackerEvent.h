@@ -38,15 +38,20 @@ public:
         thePhase2OTClustersToSkip(phase2OTClustersToSkip) {}
 
   /// Real constructor 2: with new cluster skips (checked)
+  /// With shareMasks the masks are not copied but referenced, and must outlive this object
+  /// (e.g. both are products of the same event); the masks of the cluster removers already
+  /// include the clusters masked in the previous iterations.
   MeasurementTrackerEvent(const MeasurementTrackerEvent &trackerEvent,
                           const edm::ContainerMask<edmNew::DetSetVector<SiStripCluster> > &stripClustersToSkip,
-                          const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > &pixelClustersToSkip);
+                          const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > &pixelClustersToSkip,
+                          bool shareMasks = false);
 
   //FIXME:just temporary solution for phase2!
   MeasurementTrackerEvent(
       const MeasurementTrackerEvent &trackerEvent,
       const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > &phase2pixelClustersToSkip,
-      const edm::ContainerMask<edmNew::DetSetVector<Phase2TrackerCluster1D> > &phase2OTClustersToSkip);
+      const edm::ContainerMask<edmNew::DetSetVector<Phase2TrackerCluster1D> > &phase2OTClustersToSkip,
+      bool shareMasks = false);
 
   MeasurementTrackerEvent(const MeasurementTrackerEvent &other) = delete;
   MeasurementTrackerEvent &operator=(const MeasurementTrackerEvent &other) = delete;
@@ -57,9 +62,15 @@ public:
   const StMeasurementDetSet &stripData() const { return *theStripData; }
   const PxMeasurementDetSet &pixelData() const { return *thePixelData; }
   const Phase2OTMeasurementDetSet &phase2OTData() const { return *thePhase2OTData; }
-  const std::vector<bool> &stripClustersToSkip() const { return theStripClustersToSkip; }
-  const std::vector<bool> &pixelClustersToSkip() const { return thePixelClustersToSkip; }
-  const std::vector<bool> &phase2OTClustersToSkip() const { return thePhase2OTClustersToSkip; }
+  const std::vector<bool> &stripClustersToSkip() const {
+    return theSharedStripClustersToSkip ? *theSharedStripClustersToSkip : theStripClustersToSkip;
+  }
+  const std::vector<bool> &pixelClustersToSkip() const {
+    return theSharedPixelClustersToSkip ? *theSharedPixelClustersToSkip : thePixelClustersToSkip;
+  }
+  const std::vector<bool> &phase2OTClustersToSkip() const {
+    return theSharedPhase2OTClustersToSkip ? *theSharedPhase2OTClustersToSkip : thePhase2OTClustersToSkip;
+  }
 
   // forwarded calls
   const TrackingGeometry *geomTracker() const { return measurementTracker().geomTracker(); }
@@ -74,10 +85,14 @@ private:
   const PxMeasurementDetSet *thePixelData = nullptr;
   const Phase2OTMeasurementDetSet *thePhase2OTData = nullptr;
   bool theOwner = false;  // do I own the tree above?
-  // these  could be const pointers as well, but ContainerMask doesn't expose the vector
+  // owned copies of the masks
   std::vector<bool> theStripClustersToSkip;
   std::vector<bool> thePixelClustersToSkip;
   std::vector<bool> thePhase2OTClustersToSkip;
+  // or the masks themselves, when shared
+  const std::vector<bool> *theSharedStripClustersToSkip = nullptr;
+  const std::vector<bool> *theSharedPixelClustersToSkip = nullptr;
+  const std::vector<bool> *theSharedPhase2OTClustersToSkip = nullptr;
 };
 
 #endif  // MeasurementTrackerEvent_H
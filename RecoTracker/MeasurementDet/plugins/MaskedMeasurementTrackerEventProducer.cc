@@ -21,6 +21,7 @@ private:
 
   bool skipClusters_;
   bool phase2skipClusters_;
+  bool shareMasks_;  // reference the masks in the event instead of copying them
 
   edm::EDGetTokenT<StripMask> maskStrips_;
   edm::EDGetTokenT<PixelMask> maskPixels_;
@@ -30,7 +31,8 @@ private:
 MaskedMeasurementTrackerEventProducer::MaskedMeasurementTrackerEventProducer(const edm::ParameterSet &iConfig)
     : src_(consumes<MeasurementTrackerEvent>(iConfig.getParameter<edm::InputTag>("src"))),
       skipClusters_(false),
-      phase2skipClusters_(false) {
+      phase2skipClusters_(false),
+      shareMasks_(iConfig.existsAs<bool>("shareMasks") ? iConfig.getParameter<bool>("shareMasks") : false) {
   //FIXME:temporary solution in order to use this class for both phase0/1 and phase2
   if (iConfig.existsAs<edm::InputTag>("clustersToSkip")) {
     skipClusters_ = true;
@@ -60,7 +62,7 @@ void MaskedMeasurementTrackerEventProducer::produce(edm::Event &iEvent, const ed
     edm::Handle<StripMask> maskStrips;
     iEvent.getByToken(maskStrips_, maskStrips);
 
-    out = std::make_unique<MeasurementTrackerEvent>(*mte, *maskStrips, *maskPixels);
+    out = std::make_unique<MeasurementTrackerEvent>(*mte, *maskStrips, *maskPixels, shareMasks_);
 
   } else if (phase2skipClusters_) {
     edm::Handle<PixelMask> maskPixels;
@@ -68,7 +70,7 @@ void MaskedMeasurementTrackerEventProducer::produce(edm::Event &iEvent, const ed
     edm::Handle<Phase2OTMask> maskPhase2OTs;
     iEvent.getByToken(maskPhase2OTs_, maskPhase2OTs);
 
-    out = std::make_unique<MeasurementTrackerEvent>(*mte, *maskPixels, *maskPhase2OTs);
+    out = std::make_unique<MeasurementTrackerEvent>(*mte, *maskPixels, *maskPhase2OTs, shareMasks_);
   }
 
   // put into event
@@ -51,10 +51,19 @@ bool TkPixelMeasurementDet::measurements(const TrajectoryStateOnSurface& stateOn
 
   auto oldSize = result.size();
   MeasurementDet::RecHitContainer&& allHits = compHits(stateOnThisDet, data, xl, yl);
-  for (auto&& hit : allHits) {
-    std::pair<bool, double> diffEst = est.estimate(stateOnThisDet, *hit);
-    if (diffEst.first)
-      result.add(std::move(hit), diffEst.second);
+  // all the hits are on this det: estimate them together, in chunks kept on the stack
+  constexpr unsigned int chunkSize = 16;
+  const TrackingRecHit* hitPtrs[chunkSize];
+  MeasurementEstimator::HitReturnType diffEsts[chunkSize];
+  for (unsigned int first = 0; first < allHits.size(); first += chunkSize) {
+    unsigned int n = std::min<unsigned int>(chunkSize, allHits.size() - first);
+    for (unsigned int i = 0; i < n; ++i)
+      hitPtrs[i] = allHits[first + i].get();
+    est.estimateBatch(stateOnThisDet, hitPtrs, n, diffEsts);
+    for (unsigned int i = 0; i < n; ++i) {
+      if (diffEsts[i].first)
+        result.add(std::move(allHits[first + i]), diffEsts[i].second);
+    }
   }
 
   if (result.size() > oldSize)
@@ -22,6 +22,10 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(MeasurementTrackerEvent &&other
   other.theOwner = false;  // make sure to fully transfer the ownership
   theStripClustersToSkip = std::move(other.theStripClustersToSkip);
   thePixelClustersToSkip = std::move(other.thePixelClustersToSkip);
+  thePhase2OTClustersToSkip = std::move(other.thePhase2OTClustersToSkip);
+  theSharedStripClustersToSkip = other.theSharedStripClustersToSkip;
+  theSharedPixelClustersToSkip = other.theSharedPixelClustersToSkip;
+  theSharedPhase2OTClustersToSkip = other.theSharedPhase2OTClustersToSkip;
 }
 MeasurementTrackerEvent &MeasurementTrackerEvent::operator=(MeasurementTrackerEvent &&other) {
   theTracker = std::move(other.theTracker);
@@ -32,13 +36,18 @@ MeasurementTrackerEvent &MeasurementTrackerEvent::operator=(MeasurementTrackerEv
   other.theOwner = false;  // make sure to fully transfer the ownership
   theStripClustersToSkip = std::move(other.theStripClustersToSkip);
   thePixelClustersToSkip = std::move(other.thePixelClustersToSkip);
+  thePhase2OTClustersToSkip = std::move(other.thePhase2OTClustersToSkip);
+  theSharedStripClustersToSkip = other.theSharedStripClustersToSkip;
+  theSharedPixelClustersToSkip = other.theSharedPixelClustersToSkip;
+  theSharedPhase2OTClustersToSkip = other.theSharedPhase2OTClustersToSkip;
   return *this;
 }
 
 MeasurementTrackerEvent::MeasurementTrackerEvent(
     const MeasurementTrackerEvent &trackerEvent,
     const edm::ContainerMask<edmNew::DetSetVector<SiStripCluster> > &stripClustersToSkip,
-    const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > &pixelClustersToSkip)
+    const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > &pixelClustersToSkip,
+    bool shareMasks)
     : theTracker(trackerEvent.theTracker),
       theStripData(trackerEvent.theStripData),
       thePixelData(trackerEvent.thePixelData),
@@ -61,6 +70,12 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(
         << pixelClustersToSkip.refProd().id() << "!=" << thePixelData->handle().id() << "\n";
   }
 
+  if (shareMasks) {
+    theSharedStripClustersToSkip = &stripClustersToSkip.maskVector();
+    theSharedPixelClustersToSkip = &pixelClustersToSkip.maskVector();
+    return;
+  }
+
   theStripClustersToSkip.resize(stripClustersToSkip.size());
   stripClustersToSkip.copyMaskTo(theStripClustersToSkip);
 
@@ -72,7 +87,8 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(
 MeasurementTrackerEvent::MeasurementTrackerEvent(
     const MeasurementTrackerEvent &trackerEvent,
     const edm::ContainerMask<edmNew::DetSetVector<SiPixelCluster> > &pixelClustersToSkip,
-    const edm::ContainerMask<edmNew::DetSetVector<Phase2TrackerCluster1D> > &phase2OTClustersToSkip)
+    const edm::ContainerMask<edmNew::DetSetVector<Phase2TrackerCluster1D> > &phase2OTClustersToSkip,
+    bool shareMasks)
     : theTracker(trackerEvent.theTracker),
       theStripData(nullptr),
       thePixelData(trackerEvent.thePixelData),
@@ -94,6 +110,12 @@ MeasurementTrackerEvent::MeasurementTrackerEvent(
         << pixelClustersToSkip.refProd().id() << "!=" << thePixelData->handle().id() << "\n";
   }
 
+  if (shareMasks) {
+    theSharedPixelClustersToSkip = &pixelClustersToSkip.maskVector();
+    theSharedPhase2OTClustersToSkip = &phase2OTClustersToSkip.maskVector();
+    return;
+  }
+
   thePixelClustersToSkip.resize(pixelClustersToSkip.size());
   pixelClustersToSkip.copyMaskTo(thePixelClustersToSkip);
 
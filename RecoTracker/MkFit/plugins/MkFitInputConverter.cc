@@ -32,6 +32,10 @@
 #include "Track.h"
 #include "LayerNumberConverter.h"
 
+// TBB includes
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 class MkFitInputConverter : public edm::global::EDProducer<> {
 public:
   explicit MkFitInputConverter(edm::ParameterSet const& iConfig);
@@ -197,43 +201,46 @@ mkfit::TrackVec MkFitInputConverter::convertSeeds(const edm::View<TrajectorySeed
                                                   const MkFitHitIndexMap& hitIndexMap,
                                                   const TransientTrackingRecHitBuilder& ttrhBuilder,
                                                   const MagneticField& mf) const {
-  mkfit::TrackVec ret;
-  ret.reserve(seeds.size());
-  int index = 0;
-  for (const auto& seed : seeds) {
-    const auto hitRange = seed.recHits();
-    const auto lastRecHit = ttrhBuilder.build(&*(hitRange.second - 1));
-    const auto tsos = trajectoryStateTransform::transientState(seed.startingState(), lastRecHit->surface(), &mf);
-    const auto& stateGlobal = tsos.globalParameters();
-    const auto& gpos = stateGlobal.position();
-    const auto& gmom = stateGlobal.momentum();
-    SVector3 pos(gpos.x(), gpos.y(), gpos.z());
-    SVector3 mom(gmom.x(), gmom.y(), gmom.z());
-
-    const auto cartError = tsos.cartesianError();  // returns a temporary, so can't chain with the following line
-    const auto& cov = cartError.matrix();
-    SMatrixSym66 err;
-    for (int i = 0; i < 6; ++i) {
-      for (int j = i; j < 6; ++j) {
-        err.At(i, j) = cov[i][j];
+  // the seeds are independent of each other, and are converted in
+  // parallel into their slots of the output
+  mkfit::TrackVec ret(seeds.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, seeds.size()), [&](const tbb::blocked_range<size_t>& range) {
+    for (size_t index = range.begin(); index != range.end(); ++index) {
+      const auto& seed = seeds[index];
+      const auto hitRange = seed.recHits();
+      const auto lastRecHit = ttrhBuilder.build(&*(hitRange.second - 1));
+      const auto tsos = trajectoryStateTransform::transientState(seed.startingState(), lastRecHit->surface(), &mf);
+      const auto& stateGlobal = tsos.globalParameters();
+      const auto& gpos = stateGlobal.position();
+      const auto& gmom = stateGlobal.momentum();
+      SVector3 pos(gpos.x(), gpos.y(), gpos.z());
+      SVector3 mom(gmom.x(), gmom.y(), gmom.z());
+
+      const auto cartError = tsos.cartesianError();  // returns a temporary, so can't chain with the following line
+      const auto& cov = cartError.matrix();
+      SMatrixSym66 err;
+      for (int i = 0; i < 6; ++i) {
+        for (int j = i; j < 6; ++j) {
+          err.At(i, j) = cov[i][j];
+        }
       }
-    }
 
-    mkfit::TrackState state(tsos.charge(), pos, mom, err);
-    state.convertFromCartesianToCCS();
-    ret.emplace_back(state, 0, index, 0, nullptr);
-
-    // Add hits
-    for (auto iHit = hitRange.first; iHit != hitRange.second; ++iHit) {
-      if (not trackerHitRTTI::isFromDet(*iHit)) {
-        throw cms::Exception("Assert") << "Encountered a seed with a hit which is not trackerHitRTTI::isFromDet()";
+      mkfit::TrackState state(tsos.charge(), pos, mom, err);
+      state.convertFromCartesianToCCS();
+      auto& track = ret[index];
+      track = mkfit::Track(state, 0, static_cast<int>(index), 0, nullptr);
+
+      // Add hits
+      for (auto iHit = hitRange.first; iHit != hitRange.second; ++iHit) {
+        if (not trackerHitRTTI::isFromDet(*iHit)) {
+          throw cms::Exception("Assert") << "Encountered a seed with a hit which is not trackerHitRTTI::isFromDet()";
+        }
+        const auto& clusterRef = static_cast<const BaseTrackerRecHit&>(*iHit).firstClusterRef();
+        const auto& mkFitHit = hitIndexMap.mkFitHit(clusterRef.id(), clusterRef.index());
+        track.addHitIdx(mkFitHit.index(), mkFitHit.layer(), 0);  // per-hit chi2 is not known
       }
-      const auto& clusterRef = static_cast<const BaseTrackerRecHit&>(*iHit).firstClusterRef();
-      const auto& mkFitHit = hitIndexMap.mkFitHit(clusterRef.id(), clusterRef.index());
-      ret.back().addHitIdx(mkFitHit.index(), mkFitHit.layer(), 0);  // per-hit chi2 is not known
     }
-    ++index;
-  }
+  });
   return ret;
 }
 
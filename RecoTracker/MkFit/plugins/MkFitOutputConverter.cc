@@ -44,6 +44,13 @@
 #include "LayerNumberConverter.h"
 #include "Track.h"
 
+// TBB includes
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+// std includes
+#include <algorithm>
+
 namespace {
   template <typename T>
   bool isBarrel(T subdet) {
@@ -83,6 +90,18 @@ private:
                                              const std::vector<const DetLayer*>& detLayers,
                                              const mkfit::TrackVec& mkFitSeeds) const;
 
+  bool convertCandidate(const mkfit::Track& cand,
+                        int candIndex,
+                        const MkFitHitIndexMap& hitIndexMap,
+                        const edm::View<TrajectorySeed>& seeds,
+                        const MagneticField& mf,
+                        const Propagator& propagatorAlong,
+                        const Propagator& propagatorOpposite,
+                        const TkClonerImpl& hitCloner,
+                        const std::vector<const DetLayer*>& detLayers,
+                        const mkfit::TrackVec& mkFitSeeds,
+                        TrackCandidate& output) const;
+
   std::pair<TrajectoryStateOnSurface, const GeomDet*> backwardFit(const FreeTrajectoryState& fts,
                                                                   const edm::OwnVector<TrackingRecHit>& hits,
                                                                   const Propagator& propagatorAlong,
@@ -229,152 +248,187 @@ TrackCandidateCollection MkFitOutputConverter::convertCandidates(const MkFitOutp
                                                                  const TkClonerImpl& hitCloner,
                                                                  const std::vector<const DetLayer*>& detLayers,
                                                                  const mkfit::TrackVec& mkFitSeeds) const {
-  TrackCandidateCollection output;
   const auto& candidates = backwardFitInCMSSW_ ? mkFitOutput.candidateTracks() : mkFitOutput.fitTracks();
-  output.reserve(candidates.size());
 
   LogTrace("MkFitOutputConverter") << "Number of candidates " << mkFitOutput.candidateTracks().size();
 
-  int candIndex = -1;
-  for (const auto& cand : candidates) {
-    ++candIndex;
-    LogTrace("MkFitOutputConverter") << "Candidate " << candIndex << " pT " << cand.pT() << " eta " << cand.momEta()
-                                     << " phi " << cand.momPhi() << " chi2 " << cand.chi2();
-
-    // hits
-    edm::OwnVector<TrackingRecHit> recHits;
-    // nTotalHits() gives sum of valid hits (nFoundHits()) and
-    // invalid/missing hits (up to a maximum of 32 inside mkFit,
-    // restriction to be lifted in the future)
-    const int nhits = cand.nTotalHits();
-    bool lastHitInvalid = false;
-    for (int i = 0; i < nhits; ++i) {
-      const auto& hitOnTrack = cand.getHitOnTrack(i);
-      LogTrace("MkFitOutputConverter") << " hit on layer " << hitOnTrack.layer << " index " << hitOnTrack.index;
-      if (hitOnTrack.index < 0) {
-        // See index-desc.txt file in mkFit for description of negative values
-        //
-        // In order to use the regular InvalidTrackingRecHit I'd need
-        // a GeomDet (and "unfortunately" that is needed in
-        // TrackProducer).
-        //
-        // I guess we could take the track state and propagate it to
-        // each layer to find the actual module the track crosses, and
-        // check whether it is active or not to be able to mark
-        // inactive hits
-        const auto* detLayer = detLayers.at(hitOnTrack.layer);
-        if (detLayer == nullptr) {
-          throw cms::Exception("LogicError") << "DetLayer for layer index " << hitOnTrack.layer << " is null!";
-        }
-        // In principle an InvalidTrackingRecHitNoDet could be
-        // inserted here, but it seems that it is best to deal with
-        // them in the TrackProducer.
-        lastHitInvalid = true;
-      } else {
-        recHits.push_back(hitIndexMap.hitPtr(MkFitHitIndexMap::MkFitHit{hitOnTrack.index, hitOnTrack.layer})->clone());
-        LogTrace("MkFitOutputConverter") << "  pos " << recHits.back().globalPosition().x() << " "
-                                         << recHits.back().globalPosition().y() << " "
-                                         << recHits.back().globalPosition().z() << " mag2 "
-                                         << recHits.back().globalPosition().mag2() << " detid "
-                                         << recHits.back().geographicalId().rawId() << " cluster "
-                                         << hitIndexMap.clusterIndex(
-                                                MkFitHitIndexMap::MkFitHit{hitOnTrack.index, hitOnTrack.layer});
-        lastHitInvalid = false;
-      }
+  // The candidates are independent of each other and are converted in
+  // parallel, each into its own slot; the ones that fail the conversion
+  // are then dropped, keeping the order of mkFit
+  std::vector<TrackCandidate> converted(candidates.size());
+  std::vector<char> isConverted(candidates.size(), 0);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, candidates.size()), [&](const tbb::blocked_range<size_t>& range) {
+    for (size_t i = range.begin(); i != range.end(); ++i) {
+      isConverted[i] = convertCandidate(candidates[i],
+                                        i,
+                                        hitIndexMap,
+                                        seeds,
+                                        mf,
+                                        propagatorAlong,
+                                        propagatorOpposite,
+                                        hitCloner,
+                                        detLayers,
+                                        mkFitSeeds,
+                                        converted[i]);
     }
+  });
 
-    const auto lastHitId = recHits.back().geographicalId();
+  TrackCandidateCollection output;
+  output.reserve(std::count(isConverted.begin(), isConverted.end(), 1));
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (isConverted[i])
+      output.push_back(std::move(converted[i]));
+  }
+  return output;
+}
 
-    // MkFit hits are *not* in the order of propagation, sort by 3D radius for now (as we don't have loopers)
-    // TODO: Improve the sorting (extract keys? maybe even bubble sort would work well as the hits are almost in the correct order)
-    recHits.sort([](const auto& a, const auto& b) {
-      const auto asub = a.geographicalId().subdetId();
-      const auto bsub = b.geographicalId().subdetId();
-      if (asub != bsub) {
-        // Subdetector order (BPix, FPix, TIB, TID, TOB, TEC) corresponds also the navigation
-        return asub < bsub;
+bool MkFitOutputConverter::convertCandidate(const mkfit::Track& cand,
+                                            int candIndex,
+                                            const MkFitHitIndexMap& hitIndexMap,
+                                            const edm::View<TrajectorySeed>& seeds,
+                                            const MagneticField& mf,
+                                            const Propagator& propagatorAlong,
+                                            const Propagator& propagatorOpposite,
+                                            const TkClonerImpl& hitCloner,
+                                            const std::vector<const DetLayer*>& detLayers,
+                                            const mkfit::TrackVec& mkFitSeeds,
+                                            TrackCandidate& output) const {
+  LogTrace("MkFitOutputConverter") << "Candidate " << candIndex << " pT " << cand.pT() << " eta " << cand.momEta()
+                                   << " phi " << cand.momPhi() << " chi2 " << cand.chi2();
+
+  // hits
+  edm::OwnVector<TrackingRecHit> recHits;
+  // nTotalHits() gives sum of valid hits (nFoundHits()) and
+  // invalid/missing hits (up to a maximum of 32 inside mkFit,
+  // restriction to be lifted in the future)
+  const int nhits = cand.nTotalHits();
+  bool lastHitInvalid = false;
+  for (int i = 0; i < nhits; ++i) {
+    const auto& hitOnTrack = cand.getHitOnTrack(i);
+    LogTrace("MkFitOutputConverter") << " hit on layer " << hitOnTrack.layer << " index " << hitOnTrack.index;
+    if (hitOnTrack.index < 0) {
+      // See index-desc.txt file in mkFit for description of negative values
+      //
+      // In order to use the regular InvalidTrackingRecHit I'd need
+      // a GeomDet (and "unfortunately" that is needed in
+      // TrackProducer).
+      //
+      // I guess we could take the track state and propagate it to
+      // each layer to find the actual module the track crosses, and
+      // check whether it is active or not to be able to mark
+      // inactive hits
+      const auto* detLayer = detLayers.at(hitOnTrack.layer);
+      if (detLayer == nullptr) {
+        throw cms::Exception("LogicError") << "DetLayer for layer index " << hitOnTrack.layer << " is null!";
       }
+      // In principle an InvalidTrackingRecHitNoDet could be
+      // inserted here, but it seems that it is best to deal with
+      // them in the TrackProducer.
+      lastHitInvalid = true;
+    } else {
+      recHits.push_back(hitIndexMap.hitPtr(MkFitHitIndexMap::MkFitHit{hitOnTrack.index, hitOnTrack.layer})->clone());
+      LogTrace("MkFitOutputConverter") << "  pos " << recHits.back().globalPosition().x() << " "
+                                       << recHits.back().globalPosition().y() << " "
+                                       << recHits.back().globalPosition().z() << " mag2 "
+                                       << recHits.back().globalPosition().mag2() << " detid "
+                                       << recHits.back().geographicalId().rawId() << " cluster "
+                                       << hitIndexMap.clusterIndex(
+                                              MkFitHitIndexMap::MkFitHit{hitOnTrack.index, hitOnTrack.layer});
+      lastHitInvalid = false;
+    }
+  }
 
-      const auto& apos = a.globalPosition();
-      const auto& bpos = b.globalPosition();
+  const auto lastHitId = recHits.back().geographicalId();
 
-      if (isBarrel(asub)) {
-        return apos.perp2() < bpos.perp2();
-      }
-      return std::abs(apos.z()) < std::abs(bpos.z());
-    });
-
-    const bool lastHitChanged = (recHits.back().geographicalId() != lastHitId);  // TODO: make use of the bools
-
-    // seed
-    const auto seedIndex = cand.label();
-    LogTrace("MkFitOutputConverter") << " from seed " << seedIndex << " seed hits";
-    const auto& mkseed = mkFitSeeds.at(cand.label());
-    for (int i = 0; i < mkseed.nTotalHits(); ++i) {
-      const auto& hitOnTrack = mkseed.getHitOnTrack(i);
-      LogTrace("MkFitOutputConverter") << "  hit on layer " << hitOnTrack.layer << " index " << hitOnTrack.index;
-      // sanity check for now
-      const auto& candHitOnTrack = cand.getHitOnTrack(i);
-      if (hitOnTrack.layer != candHitOnTrack.layer) {
-        throw cms::Exception("LogicError")
-            << "Candidate " << candIndex << " from seed " << seedIndex << " hit " << i
-            << " has different layer in candidate (" << candHitOnTrack.layer << ") and seed (" << hitOnTrack.layer
-            << ")."
-            << " Hit indices are " << candHitOnTrack.index << " and " << hitOnTrack.index << ", respectively";
-      }
-      if (hitOnTrack.index != candHitOnTrack.index) {
-        throw cms::Exception("LogicError") << "Candidate " << candIndex << " from seed " << seedIndex << " hit " << i
-                                           << " has different hit index in candidate (" << candHitOnTrack.index
-                                           << ") and seed (" << hitOnTrack.index << ") on layer " << hitOnTrack.layer;
-      }
+  // MkFit hits are *not* in the order of propagation, sort by 3D radius for now (as we don't have loopers)
+  // TODO: Improve the sorting (extract keys? maybe even bubble sort would work well as the hits are almost in the correct order)
+  recHits.sort([](const auto& a, const auto& b) {
+    const auto asub = a.geographicalId().subdetId();
+    const auto bsub = b.geographicalId().subdetId();
+    if (asub != bsub) {
+      // Subdetector order (BPix, FPix, TIB, TID, TOB, TEC) corresponds also the navigation
+      return asub < bsub;
     }
 
-    // state
-    auto state = cand.state();  // copy because have to modify
-    state.convertFromCCSToCartesian();
-    const auto& param = state.parameters;
-    const auto& err = state.errors;
-    AlgebraicSymMatrix66 cov;
-    for (int i = 0; i < 6; ++i) {
-      for (int j = i; j < 6; ++j) {
-        cov[i][j] = err.At(i, j);
-      }
-    }
+    const auto& apos = a.globalPosition();
+    const auto& bpos = b.globalPosition();
 
-    auto fts = FreeTrajectoryState(
-        GlobalTrajectoryParameters(
-            GlobalPoint(param[0], param[1], param[2]), GlobalVector(param[3], param[4], param[5]), state.charge, &mf),
-        CartesianTrajectoryError(cov));
-    if (!fts.curvilinearError().posDef()) {
-      edm::LogWarning("MkFitOutputConverter") << "Curvilinear error not pos-def\n"
-                                              << fts.curvilinearError().matrix() << "\noriginal 6x6 covariance matrix\n"
-                                              << cov << "\ncandidate ignored";
-      continue;
+    if (isBarrel(asub)) {
+      return apos.perp2() < bpos.perp2();
     }
+    return std::abs(apos.z()) < std::abs(bpos.z());
+  });
+
+  const bool lastHitChanged = (recHits.back().geographicalId() != lastHitId);  // TODO: make use of the bools
+
+  // seed
+  const auto seedIndex = cand.label();
+  LogTrace("MkFitOutputConverter") << " from seed " << seedIndex << " seed hits";
+  const auto& mkseed = mkFitSeeds.at(cand.label());
+  for (int i = 0; i < mkseed.nTotalHits(); ++i) {
+    const auto& hitOnTrack = mkseed.getHitOnTrack(i);
+    LogTrace("MkFitOutputConverter") << "  hit on layer " << hitOnTrack.layer << " index " << hitOnTrack.index;
+    // sanity check for now
+    const auto& candHitOnTrack = cand.getHitOnTrack(i);
+    if (hitOnTrack.layer != candHitOnTrack.layer) {
+      throw cms::Exception("LogicError")
+          << "Candidate " << candIndex << " from seed " << seedIndex << " hit " << i
+          << " has different layer in candidate (" << candHitOnTrack.layer << ") and seed (" << hitOnTrack.layer
+          << ")."
+          << " Hit indices are " << candHitOnTrack.index << " and " << hitOnTrack.index << ", respectively";
+    }
+    if (hitOnTrack.index != candHitOnTrack.index) {
+      throw cms::Exception("LogicError") << "Candidate " << candIndex << " from seed " << seedIndex << " hit " << i
+                                         << " has different hit index in candidate (" << candHitOnTrack.index
+                                         << ") and seed (" << hitOnTrack.index << ") on layer " << hitOnTrack.layer;
+    }
+  }
 
-    auto tsosDet =
-        backwardFitInCMSSW_
-            ? backwardFit(fts, recHits, propagatorAlong, propagatorOpposite, hitCloner, lastHitInvalid, lastHitChanged)
-            : convertInnermostState(fts, recHits, propagatorAlong, propagatorOpposite);
-    if (!tsosDet.first.isValid()) {
-      edm::LogWarning("MkFitOutputConverter")
-          << "Backward fit of candidate " << candIndex << " failed, ignoring the candidate";
-      continue;
+  // state
+  auto state = cand.state();  // copy because have to modify
+  state.convertFromCCSToCartesian();
+  const auto& param = state.parameters;
+  const auto& err = state.errors;
+  AlgebraicSymMatrix66 cov;
+  for (int i = 0; i < 6; ++i) {
+    for (int j = i; j < 6; ++j) {
+      cov[i][j] = err.At(i, j);
     }
+  }
 
-    // convert to persistent, from CkfTrackCandidateMakerBase
-    auto pstate = trajectoryStateTransform::persistentState(tsosDet.first, tsosDet.second->geographicalId().rawId());
-
-    output.emplace_back(
-        recHits,
-        seeds.at(seedIndex),
-        pstate,
-        seeds.refAt(seedIndex),
-        0,                                               // mkFit does not produce loopers, so set nLoops=0
-        static_cast<uint8_t>(StopReason::UNINITIALIZED)  // TODO: ignore details of stopping reason as well for now
-    );
+  auto fts = FreeTrajectoryState(
+      GlobalTrajectoryParameters(
+          GlobalPoint(param[0], param[1], param[2]), GlobalVector(param[3], param[4], param[5]), state.charge, &mf),
+      CartesianTrajectoryError(cov));
+  if (!fts.curvilinearError().posDef()) {
+    edm::LogWarning("MkFitOutputConverter") << "Curvilinear error not pos-def\n"
+                                            << fts.curvilinearError().matrix() << "\noriginal 6x6 covariance matrix\n"
+                                            << cov << "\ncandidate ignored";
+    return false;
   }
-  return output;
+
+  auto tsosDet =
+      backwardFitInCMSSW_
+          ? backwardFit(fts, recHits, propagatorAlong, propagatorOpposite, hitCloner, lastHitInvalid, lastHitChanged)
+          : convertInnermostState(fts, recHits, propagatorAlong, propagatorOpposite);
+  if (!tsosDet.first.isValid()) {
+    edm::LogWarning("MkFitOutputConverter")
+        << "Backward fit of candidate " << candIndex << " failed, ignoring the candidate";
+    return false;
+  }
+
+  // convert to persistent, from CkfTrackCandidateMakerBase
+  auto pstate = trajectoryStateTransform::persistentState(tsosDet.first, tsosDet.second->geographicalId().rawId());
+
+  output = TrackCandidate(
+      recHits,
+      seeds.at(seedIndex),
+      pstate,
+      seeds.refAt(seedIndex),
+      0,                                               // mkFit does not produce loopers, so set nLoops=0
+      static_cast<uint8_t>(StopReason::UNINITIALIZED)  // TODO: ignore details of stopping reason as well for now
+  );
+  return true;
 }
 
 std::pair<TrajectoryStateOnSurface, const GeomDet*> MkFitOutputConverter::backwardFit(
@@ -44,6 +44,7 @@ private:
   std::function<double(mkfit::Event&, mkfit::MkBuilder&)> buildFunction_;
   bool backwardFitInCMSSW_;
   bool mkFitSilent_;
+  bool limitConcurrency_;
 };
 
 MkFitProducer::MkFitProducer(edm::ParameterSet const& iConfig)
@@ -51,7 +52,8 @@ MkFitProducer::MkFitProducer(edm::ParameterSet const& iConfig)
       geomToken_{esConsumes<TrackerGeometry, TrackerDigiGeometryRecord>()},
       putToken_{produces<MkFitOutputWrapper>()},
       backwardFitInCMSSW_{iConfig.getParameter<bool>("backwardFitInCMSSW")},
-      mkFitSilent_{iConfig.getUntrackedParameter<bool>("mkFitSilent")} {
+      mkFitSilent_{iConfig.getUntrackedParameter<bool>("mkFitSilent")},
+      limitConcurrency_{iConfig.getUntrackedParameter<bool>("limitConcurrency")} {
   const auto build = iConfig.getParameter<std::string>("buildingRoutine");
   bool isFV = false;
   if (build == "bestHit") {
@@ -97,6 +99,10 @@ void MkFitProducer::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.add("backwardFitInCMSSW", false)
       ->setComment("Do backward fit (to innermost hit) in CMSSW (true) or mkFit (false)");
   desc.addUntracked("mkFitSilent", true)->setComment("Allows to enables printouts from mkFit with 'False'");
+  desc.addUntracked("limitConcurrency", false)
+      ->setComment(
+          "Run the track building of an event in a task arena of one thread instead of spreading the eta regions and "
+          "seed batches over the threads of the framework; useful only for timing studies of the module");
 
   descriptions.add("mkFitProducer", desc);
 }
@@ -129,7 +135,16 @@ void MkFitProducer::produce(edm::StreamID iID, edm::Event& iEvent, const edm::Ev
 
   ev.setInputFromCMSSW(hitsSeeds.hits(), hitsSeeds.seeds());
 
-  tbb::this_task_arena::isolate([&]() { buildFunction_(ev, streamCache(iID)->get()); });
+  // mkFit builds the eta regions and the batches of seeds as TBB
+  // tasks; isolating them lets the idle framework threads pick them up
+  // while this thread does not steal unrelated work in the meantime
+  auto lambda = [&]() { buildFunction_(ev, streamCache(iID)->get()); };
+  if (limitConcurrency_) {
+    tbb::task_arena arena(1);
+    arena.execute(lambda);
+  } else {
+    tbb::this_task_arena::isolate(lambda);
+  }
 
   iEvent.emplace(putToken_, std::move(ev.candidateTracks_), std::move(ev.fitTracks_));
 }
@@ -17,6 +17,8 @@
 #include "DataFormats/GeometryVector/interface/VectorUtil.h"
 #include <boost/function.hpp>
 
+#include <algorithm>
+
 using namespace std;
 
 typedef GeometricSearchDet::DetWithState DetWithState;
@@ -43,6 +45,12 @@ CompositeTECWedge::CompositeTECWedge(vector<const GeomDet*>& innerDets, vector<c
   theBackSector = ForwardDiskSectorBuilderFromDet()(theBackDets);
   theDiskSector = ForwardDiskSectorBuilderFromDet()(theDets);
 
+  // phi of the dets from the centre of the wedge, increasing as they are sorted
+  for (auto det : theFrontDets)
+    theFrontPhis.push_back(Geom::deltaPhi(det->surface().phi(), theDiskSector->phi()));
+  for (auto det : theBackDets)
+    theBackPhis.push_back(Geom::deltaPhi(det->surface().phi(), theDiskSector->phi()));
+
   //--------- DEBUG INFO --------------
   LogDebug("TkDetLayers") << "DEBUG INFO for CompositeTECWedge"
                           << "\n"
@@ -216,10 +224,18 @@ void CompositeTECWedge::searchNeighbors(const TrajectoryStateOnSurface& tsos,
 
 int CompositeTECWedge::findClosestDet(const GlobalPoint& startPos, int sectorId) const {
   vector<const GeomDet*> const& myDets = sectorId == 0 ? theFrontDets : theBackDets;
-
-  int close = 0;
-  auto closeDist = std::abs((myDets.front()->toLocal(startPos)).x());
-  for (unsigned int i = 1; i < myDets.size(); i++) {
+  vector<float> const& myPhis = sectorId == 0 ? theFrontPhis : theBackPhis;
+
+  // Only the dets next to the crossing in phi can be the closest one:
+  // the distance in the local frame is computed just for them.
+  float phi = Geom::deltaPhi(startPos.barePhi(), theDiskSector->phi());
+  int next = std::lower_bound(myPhis.begin(), myPhis.end(), phi) - myPhis.begin();
+  int first = std::max(next - 2, 0);
+  int last = std::min(next + 2, static_cast<int>(myDets.size()));
+
+  int close = first;
+  auto closeDist = std::abs((myDets[first]->toLocal(startPos)).x());
+  for (int i = first + 1; i < last; i++) {
     auto dist = std::abs((myDets[i]->toLocal(startPos)).x());
     if (dist < closeDist) {
       close = i;
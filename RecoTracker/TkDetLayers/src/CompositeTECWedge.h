@@ -59,6 +59,10 @@ private:
   std::vector<const GeomDet*> theBackDets;
   std::vector<const GeomDet*> theDets;
 
+  // phi of the front and back dets, for the lookup of the closest one
+  std::vector<float> theFrontPhis;
+  std::vector<float> theBackPhis;
+
   ReferenceCountingPointer<BoundDiskSector> theFrontSector;
   ReferenceCountingPointer<BoundDiskSector> theBackSector;
 };
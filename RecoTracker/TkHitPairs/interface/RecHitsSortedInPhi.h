@@ -6,6 +6,8 @@
 
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <utility>
 
 #include <cassert>
 
@@ -84,7 +86,7 @@ public:
   Range all() const { return Range(theHits.begin(), theHits.end()); }
 
 public:
-  float phi(int i) const { return theHits[i].phi(); }
+  float phi(int i) const { return gphi[i]; }
   float gv(int i) const { return isBarrel ? z[i] : gp(i).perp(); }  // global v
   float rv(int i) const { return isBarrel ? u[i] : v[i]; }          // dispaced r
   GlobalPoint gp(int i) const { return GlobalPoint(x[i], y[i], z[i]); }
@@ -108,6 +110,14 @@ public:
   std::vector<float> du;
   std::vector<float> dv;
   std::vector<float> lphi;
+  // the phi of theHits, contiguous for the binary searches of the phi windows
+  std::vector<float> gphi;
+
+  // the indices of the hits in the phi interval, with the same requirements as unsafeRange
+  std::pair<int, int> unsafeIndexRange(float phiMin, float phiMax) const {
+    auto low = std::lower_bound(gphi.begin(), gphi.end(), phiMin);
+    return std::make_pair(int(low - gphi.begin()), int(std::upper_bound(low, gphi.end(), phiMax) - gphi.begin()));
+  }
 
   static void copyResult(const Range& range, std::vector<Hit>& result) {
     result.reserve(result.size() + (range.second - range.first));
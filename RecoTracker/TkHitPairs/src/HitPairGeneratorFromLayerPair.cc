@@ -169,15 +169,18 @@ void HitPairGeneratorFromLayerPair::doublets(const TrackingRegion& region,
           std::get<2>(kernels)(b, e, innerHitsMap, ok);
           break;
       }
+      // the limit is checked once per window, not per pair
+      unsigned int nOk = 0;
+      for (int i = 0; i != e - b; ++i)
+        nOk += ok[i];
+      if (theMaxElement != 0 && result.size() + nOk > theMaxElement) {
+        result.clear();
+        edm::LogError("TooManyPairs") << "number of pairs exceed maximum, no pairs produced";
+        return;
+      }
       for (int i = 0; i != e - b; ++i) {
-        if (!ok[i])
-          continue;
-        if (theMaxElement != 0 && result.size() >= theMaxElement) {
-          result.clear();
-          edm::LogError("TooManyPairs") << "number of pairs exceed maximum, no pairs produced";
-          return;
-        }
-        result.add(b + i, io);
+        if (ok[i])
+          result.add(b + i, io);
       }
     }
   }
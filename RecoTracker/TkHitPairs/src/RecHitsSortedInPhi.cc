@@ -15,7 +15,8 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
       v(hits.size()),
       du(hits.size()),
       dv(hits.size()),
-      lphi(hits.size()) {
+      lphi(hits.size()),
+      gphi(hits.size()) {
   // standard region have origin as 0,0,z (not true!!!!0
   // cosmic region never used here
   // assert(origin.x()==0 && origin.y()==0);
@@ -46,31 +47,29 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
     du[i] = isBarrel ? dr : dz;
     dv[i] = isBarrel ? dz : dr;
     lphi[i] = loc.barePhi();
+    gphi[i] = theHits[i].phi();
   }
 }
 
 RecHitsSortedInPhi::DoubleRange RecHitsSortedInPhi::doubleRange(float phiMin, float phiMax) const {
-  Range r1, r2;
+  std::pair<int, int> r1, r2;
   if (phiMin < phiMax) {
     if (phiMin < -Geom::fpi()) {
-      r1 = unsafeRange(phiMin + Geom::ftwoPi(), Geom::fpi());
-      r2 = unsafeRange(-Geom::fpi(), phiMax);
+      r1 = unsafeIndexRange(phiMin + Geom::ftwoPi(), Geom::fpi());
+      r2 = unsafeIndexRange(-Geom::fpi(), phiMax);
     } else if (phiMax > Geom::pi()) {
-      r1 = unsafeRange(phiMin, Geom::fpi());
-      r2 = unsafeRange(-Geom::fpi(), phiMax - Geom::ftwoPi());
+      r1 = unsafeIndexRange(phiMin, Geom::fpi());
+      r2 = unsafeIndexRange(-Geom::fpi(), phiMax - Geom::ftwoPi());
     } else {
-      r1 = unsafeRange(phiMin, phiMax);
-      r2 = Range(theHits.begin(), theHits.begin());
+      r1 = unsafeIndexRange(phiMin, phiMax);
+      r2 = std::make_pair(0, 0);
     }
   } else {
-    r1 = unsafeRange(phiMin, Geom::fpi());
-    r2 = unsafeRange(-Geom::fpi(), phiMax);
+    r1 = unsafeIndexRange(phiMin, Geom::fpi());
+    r2 = unsafeIndexRange(-Geom::fpi(), phiMax);
   }
 
-  return (DoubleRange){{int(r1.first - theHits.begin()),
-                        int(r1.second - theHits.begin()),
-                        int(r2.first - theHits.begin()),
-                        int(r2.second - theHits.begin())}};
+  return (DoubleRange){{r1.first, r1.second, r2.first, r2.second}};
 }
 
 void RecHitsSortedInPhi::hits(float phiMin, float phiMax, std::vector<Hit>& result) const {
@@ -97,6 +96,6 @@ std::vector<RecHitsSortedInPhi::Hit> RecHitsSortedInPhi::hits(float phiMin, floa
 }
 
 RecHitsSortedInPhi::Range RecHitsSortedInPhi::unsafeRange(float phiMin, float phiMax) const {
-  auto low = std::lower_bound(theHits.begin(), theHits.end(), HitWithPhi(phiMin), HitLessPhi());
-  return Range(low, std::upper_bound(low, theHits.end(), HitWithPhi(phiMax), HitLessPhi()));
+  auto r = unsafeIndexRange(phiMin, phiMax);
+  return Range(theHits.begin() + r.first, theHits.begin() + r.second);
 }
@@ -161,6 +161,7 @@ void SeedFromConsecutiveHitsCreator::buildSeed(TrajectorySeedCollection& seedCol
 
   TrajectoryStateOnSurface updatedState;
   edm::OwnVector<TrackingRecHit> seedHits;
+  seedHits.reserve(hits.size());
 
   const TrackingRecHit* hit = nullptr;
   for (unsigned int iHit = 0; iHit < hits.size(); iHit++) {
@@ -20,6 +20,7 @@
 #include "TrackingTools/PatternTools/interface/Trajectory.h"
 
 #include "DataFormats/TrackReco/interface/TrackExtra.h"
+#include "DataFormats/TrackingRecHit/interface/TrackingRecHitFwd.h"
 #include "DataFormats/TrackCandidate/interface/TrackCandidateCollection.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 #include "DataFormats/TrackerRecHit2D/interface/ClusterRemovalInfo.h"
@@ -99,6 +100,10 @@ public:
 
   const edm::ParameterSet& getConf() const { return conf_; }
 
+protected:
+  /// Reserves the collection into which the hits of all the tracks are cloned: at most one per measurement
+  static void reserveHits(TrackingRecHitCollection& hits, const AlgoProductCollection& algoResults);
+
 protected:
   edm::ParameterSet conf_;
   edm::EDGetToken src_;
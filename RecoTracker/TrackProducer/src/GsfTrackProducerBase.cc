@@ -52,6 +52,8 @@ void GsfTrackProducerBase::putInEvt(edm::Event& evt,
 
   TSCBLBuilderNoMaterial tscblBuilder;
 
+  reserveHits(*selHits, algoResults);
+
   for (auto& i : algoResults) {
     Trajectory* theTraj = i.trajectory;
     if (trajectoryInEvent_) {
@@ -42,6 +42,7 @@ void KfTrackProducerBase::putInEvt(edm::Event& evt,
   selTrackExtras->reserve(algoResults.size());
   if (trajectoryInEvent_)
     selTrajectories->reserve(algoResults.size());
+  reserveHits(*selHits, algoResults);
 
   for (AlgoProductCollection::iterator i = algoResults.begin(); i != algoResults.end(); i++) {
     auto theTraj = (*i).trajectory;
@@ -232,6 +232,22 @@ void TemplatedInclusiveVertexFinder<InputContainer, VTX>::produce(edm::Event &ev
     std::cout << "CLUSTERS " << clusters.size() << std::endl;
 #endif
 
+    // the direct fits of all the clusters are done at once, in parallel
+    std::vector<CachingVertex<5> > singleFits;
+    std::vector<int> singleFitIndex(clusters.size(), -1);
+    if (useVertexFitter) {
+      std::vector<std::vector<TransientTrack> > fitTracks;
+      std::vector<GlobalPoint> fitSeeds;
+      for (unsigned int j = 0; j < clusters.size(); j++) {
+        if (clusters[j].tracks.size() < 2 || clusters[j].tracks.size() > maxNTracks)
+          continue;
+        singleFitIndex[j] = fitTracks.size();
+        fitTracks.push_back(clusters[j].tracks);
+        fitSeeds.push_back(clusters[j].seedPoint);
+      }
+      singleFits = theAdaptiveFitter.vertices(fitTracks, fitSeeds);
+    }
+
     for (std::vector<TracksClusteringFromDisplacedSeed::Cluster>::iterator cluster = clusters.begin();
          cluster != clusters.end();
          ++cluster, ++i) {
@@ -243,7 +259,7 @@ void TemplatedInclusiveVertexFinder<InputContainer, VTX>::produce(edm::Event &ev
       }
       TransientVertex singleFitVertex;
       if (useVertexFitter) {
-        singleFitVertex = theAdaptiveFitter.vertex(cluster->tracks, cluster->seedPoint);  //attempt with direct fitting
+        singleFitVertex = singleFits[singleFitIndex[i]];  //attempt with direct fitting
         if (singleFitVertex.isValid())
           vertices.push_back(singleFitVertex);
       }
@@ -2,6 +2,10 @@
 //#define VTXDEBUG 1
 #include "FWCore/Utilities/interface/isFinite.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 TracksClusteringFromDisplacedSeed::TracksClusteringFromDisplacedSeed(const edm::ParameterSet &params)
     :  //	maxNTracks(params.getParameter<unsigned int>("maxNTracks")),
       max3DIPSignificance(params.getParameter<double>("seedMax3DIPSignificance")),
@@ -28,36 +32,39 @@ std::pair<std::vector<reco::TransientTrack>, GlobalPoint> TracksClusteringFromDi
   float sumWeights = 0;
   std::pair<bool, Measurement1D> ipSeed = IPTools::absoluteImpactParameter3D(seed, primaryVertex);
   float pvDistance = ipSeed.second.value();
+  // the quantities of the seed, the same for all the tracks
+  const TrajectoryStateOnSurface &seedState = seed.impactPointState();
+  GlobalError seedPositionErr = seedState.cartesianError().position();
+  const bool useTime = primaryVertex.covariance(3, 3) > 0. && edm::isFinite(seed.timeExt());
   for (std::vector<reco::TransientTrack>::const_iterator tt = tracks.begin(); tt != tracks.end(); ++tt) {
     if (*tt == seed)
       continue;
 
-    if (dist.calculate(tt->impactPointState(), seed.impactPointState())) {
+    // the time compatibility does not depend on the crossing points: the tracks which fail it are not
+    // extrapolated to each other
+    double timeSig = 0.;
+    if (useTime && edm::isFinite(tt->timeExt())) {
+      // apply only if time available and being used in vertexing
+      const double tError = std::sqrt(std::pow(seed.dtErrorExt(), 2) + std::pow(tt->dtErrorExt(), 2));
+      timeSig = std::abs(seed.timeExt() - tt->timeExt()) / tError;
+    }
+    if (!(timeSig < maxTimeSignificance))
+      continue;
+
+    if (dist.calculate(tt->impactPointState(), seedState)) {
       GlobalPoint ttPoint = dist.points().first;
       GlobalError ttPointErr = tt->impactPointState().cartesianError().position();
       GlobalPoint seedPosition = dist.points().second;
-      GlobalError seedPositionErr = seed.impactPointState().cartesianError().position();
       Measurement1D m =
           distanceComputer.distance(VertexState(seedPosition, seedPositionErr), VertexState(ttPoint, ttPointErr));
       GlobalPoint cp(dist.crossingPoint());
 
-      double timeSig = 0.;
-      if (primaryVertex.covariance(3, 3) > 0. && edm::isFinite(seed.timeExt()) && edm::isFinite(tt->timeExt())) {
-        // apply only if time available and being used in vertexing
-        const double tError = std::sqrt(std::pow(seed.dtErrorExt(), 2) + std::pow(tt->dtErrorExt(), 2));
-        timeSig = std::abs(seed.timeExt() - tt->timeExt()) / tError;
-      }
-
       float distanceFromPV = (dist.points().second - pv).mag();
       float distance = dist.distance();
-      GlobalVector trackDir2D(
-          tt->impactPointState().globalDirection().x(), tt->impactPointState().globalDirection().y(), 0.);
-      GlobalVector seedDir2D(
-          seed.impactPointState().globalDirection().x(), seed.impactPointState().globalDirection().y(), 0.);
       //SK:UNUSED//    float dotprodTrackSeed2D = trackDir2D.unit().dot(seedDir2D.unit());
 
       float dotprodTrack = (dist.points().first - pv).unit().dot(tt->impactPointState().globalDirection().unit());
-      float dotprodSeed = (dist.points().second - pv).unit().dot(seed.impactPointState().globalDirection().unit());
+      float dotprodSeed = (dist.points().second - pv).unit().dot(seedState.globalDirection().unit());
 
       float w = distanceFromPV * distanceFromPV / (pvDistance * distance);
       bool selected =
@@ -71,8 +78,7 @@ std::pair<std::vector<reco::TransientTrack>, GlobalPoint> TracksClusteringFromDi
            //dotprodTrackSeed2D > clusterMinAngleCosine && //Angle between track and seed
            //distance*clusterScale*tracks.size() < (distanceFromPV+pvDistance)*(distanceFromPV+pvDistance)/pvDistance && // cut scaling with track density
            distance * distanceRatio < distanceFromPV &&  // cut scaling with track density
-           distance < clusterMaxDistance &&
-           timeSig < maxTimeSignificance);  // absolute distance cut
+           distance < clusterMaxDistance);  // absolute distance cut
 
 #ifdef VTXDEBUG
       std::cout << tt->trackBaseRef().key() << " :  " << (selected ? "+" : " ") << " " << m.significance() << " < "
@@ -115,22 +121,27 @@ std::vector<TracksClusteringFromDisplacedSeed::Cluster> TracksClusteringFromDisp
     }
   }
 
-  std::vector<Cluster> clusters;
-  int i = 0;
-  for (std::vector<TransientTrack>::const_iterator s = seeds.begin(); s != seeds.end(); ++s, ++i) {
+  // the seeds are independent: their clusters are built in parallel, each in its place in the output
+  std::vector<Cluster> clusters(seeds.size());
+  // isolated, so that the thread waiting for the clusters does not pick up tasks of other modules meanwhile
+  tbb::this_task_arena::isolate([&]() {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, seeds.size()), [&](const tbb::blocked_range<size_t> &r) {
+      for (size_t i = r.begin(); i != r.end(); ++i) {
+        const TransientTrack &s = seeds[i];
 #ifdef VTXDEBUG
-    std::cout << "Seed N. " << i << std::endl;
+        std::cout << "Seed N. " << i << std::endl;
 #endif  // VTXDEBUG
-    std::pair<std::vector<reco::TransientTrack>, GlobalPoint> ntracks = nearTracks(*s, selectedTracks, pv);
-    //	        std::cout << ntracks.first.size() << " " << ntracks.first.size()  << std::endl;
-    //                if(ntracks.first.size() == 0 || ntracks.first.size() > maxNTracks ) continue;
-    ntracks.first.push_back(*s);
-    Cluster aCl;
-    aCl.seedingTrack = *s;
-    aCl.seedPoint = ntracks.second;
-    aCl.tracks = ntracks.first;
-    clusters.push_back(aCl);
-  }
+        std::pair<std::vector<reco::TransientTrack>, GlobalPoint> ntracks = nearTracks(s, selectedTracks, pv);
+        //	        std::cout << ntracks.first.size() << " " << ntracks.first.size()  << std::endl;
+        //                if(ntracks.first.size() == 0 || ntracks.first.size() > maxNTracks ) continue;
+        ntracks.first.push_back(s);
+        Cluster &aCl = clusters[i];
+        aCl.seedingTrack = s;
+        aCl.seedPoint = ntracks.second;
+        aCl.tracks = std::move(ntracks.first);
+      }
+    });
+  });
 
   return clusters;
 }
@@ -99,6 +99,20 @@ public:
                           const GlobalPoint &priorPos,
                           const GlobalError &priorError) const override;
 
+  /** Fit a vertex out of each of the sets of reco::TransientTracks, as the
+   *  single set methods above, with the given linearization points, the
+   *  BeamSpot as prior, or neither. The sets are fitted in parallel, each
+   *  chunk of them with its own copy of the fitter, and the vertices are
+   *  returned in the order of the sets.
+   */
+  std::vector<CachingVertex<5> > vertices(const std::vector<std::vector<reco::TransientTrack> > &tracks) const;
+
+  std::vector<CachingVertex<5> > vertices(const std::vector<std::vector<reco::TransientTrack> > &tracks,
+                                          const std::vector<GlobalPoint> &linPoints) const;
+
+  std::vector<CachingVertex<5> > vertices(const std::vector<std::vector<reco::TransientTrack> > &tracks,
+                                          const reco::BeamSpot &beamSpot) const;
+
   AdaptiveVertexFitter *clone() const override;
 
   /**
@@ -7,6 +7,11 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include <algorithm>
+#include <memory>
+
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 using namespace edm;
 
@@ -324,6 +329,40 @@ vector<AdaptiveVertexFitter::RefCountedVertexTrack> AdaptiveVertexFitter::reLine
   return reWeightTracks(lTracks, vertex);
 }
 
+namespace {
+  // the annealing schedule is modified during a fit, so each chunk of sets
+  // of tracks is fitted with its own copy of the fitter
+  template <typename Fit>
+  vector<CachingVertex<5> > fitInParallel(const AdaptiveVertexFitter& fitter, size_t n, const Fit& fit) {
+    vector<CachingVertex<5> > vertices(n);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& r) {
+      std::unique_ptr<AdaptiveVertexFitter> chunkFitter(fitter.clone());
+      for (size_t i = r.begin(); i != r.end(); ++i)
+        vertices[i] = fit(*chunkFitter, i);
+    });
+    return vertices;
+  }
+}  // namespace
+
+vector<CachingVertex<5> > AdaptiveVertexFitter::vertices(const vector<vector<reco::TransientTrack> >& tracks) const {
+  return fitInParallel(
+      *this, tracks.size(), [&](const AdaptiveVertexFitter& fitter, size_t i) { return fitter.vertex(tracks[i]); });
+}
+
+vector<CachingVertex<5> > AdaptiveVertexFitter::vertices(const vector<vector<reco::TransientTrack> >& tracks,
+                                                         const vector<GlobalPoint>& linPoints) const {
+  return fitInParallel(*this, tracks.size(), [&](const AdaptiveVertexFitter& fitter, size_t i) {
+    return fitter.vertex(tracks[i], linPoints[i]);
+  });
+}
+
+vector<CachingVertex<5> > AdaptiveVertexFitter::vertices(const vector<vector<reco::TransientTrack> >& tracks,
+                                                         const reco::BeamSpot& beamSpot) const {
+  return fitInParallel(*this, tracks.size(), [&](const AdaptiveVertexFitter& fitter, size_t i) {
+    return fitter.vertex(tracks[i], beamSpot);
+  });
+}
+
 AdaptiveVertexFitter* AdaptiveVertexFitter::clone() const { return new AdaptiveVertexFitter(*this); }
 
 double AdaptiveVertexFitter::getWeight(float chi2) const {
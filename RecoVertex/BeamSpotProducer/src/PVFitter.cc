@@ -39,6 +39,7 @@ ________________________________________________________________**/
 #include "TDirectory.h"
 #include "TMinuitMinimizer.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 using namespace std;
@@ -468,13 +469,14 @@ void PVFitter::compressStore() {
   pvQualities_.resize(pvStore_.size());
   for (unsigned int i = 0; i < pvStore_.size(); ++i)
     pvQualities_[i] = pvQuality(pvStore_[i]);
-  sort(pvQualities_.begin(), pvQualities_.end());
   //
   // Set new quality cut to median. This cut will be used to reduce the
   // number of vertices in the store and also apply to all new vertices
-  // until the next reset
+  // until the next reset (only the median is needed, not the full ordering)
   //
-  dynamicQualityCut_ = pvQualities_[pvQualities_.size() / 2];
+  std::vector<double>::iterator median = pvQualities_.begin() + pvQualities_.size() / 2;
+  std::nth_element(pvQualities_.begin(), median, pvQualities_.end());
+  dynamicQualityCut_ = *median;
   //
   // remove all vertices failing the cut from the store
   //   (to be moved to a more efficient memory management!)
@@ -0,0 +1,81 @@
+#ifndef DAClusterizerBlocks_h
+#define DAClusterizerBlocks_h
+
+/**\namespace DAClusterizerBlocks
+
+ Description: annealing of the tracks in overlapping blocks in z, shared by DAClusterizerInZ_vect
+ and DAClusterizerInZT_vect
+
+ The tracks, sorted in z, are split in blocks of blockSize tracks overlapping by overlapFrac.
+ annealBlock(iz, first, last, y) anneals the tracks iz[first], ..., iz[last - 1] into the prototypes
+ y of the block and returns its final beta. The blocks are annealed in parallel, or one after the
+ other when serial is set, e.g. for the verbose printout. addPrototypes(y, weight) is then called for
+ each block in block order, weight being the share of the tracks of the block, so that the result
+ does not depend on the scheduling. The largest beta of the blocks is returned.
+
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+namespace DAClusterizerBlocks {
+
+  template <typename Vertices, typename AnnealBlock, typename AddPrototypes>
+  double anneal(const double* z,
+                unsigned int nt,
+                unsigned int blockSize,
+                double overlapFrac,
+                bool serial,
+                AnnealBlock&& annealBlock,
+                AddPrototypes&& addPrototypes) {
+    std::vector<unsigned int> iz(nt);
+    std::iota(iz.begin(), iz.end(), 0);
+    std::sort(iz.begin(), iz.end(), [z](unsigned int i, unsigned int j) { return z[i] < z[j]; });
+
+    const unsigned int step = std::max(1u, static_cast<unsigned int>(blockSize * (1. - overlapFrac)));
+    std::vector<unsigned int> firsts;
+    for (unsigned int first = 0;; first += step) {
+      firsts.push_back(first);
+      if (first + blockSize >= nt)
+        break;
+    }
+    const unsigned int nBlocks = firsts.size();
+
+    // the results are kept per block, so that the prototypes do not depend on the order in which the blocks are done
+    std::vector<Vertices> blockVertices(nBlocks);
+    std::vector<double> blockBetas(nBlocks);
+    std::vector<unsigned int> blockTracks(nBlocks);
+    auto runBlock = [&](unsigned int b) {
+      const unsigned int last = std::min(firsts[b] + blockSize, nt);
+      blockBetas[b] = annealBlock(iz, firsts[b], last, blockVertices[b]);
+      blockTracks[b] = last - firsts[b];
+    };
+    if (serial) {
+      for (unsigned int b = 0; b < nBlocks; b++)
+        runBlock(b);
+    } else {
+      tbb::this_task_arena::isolate([&]() {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nBlocks), [&](const tbb::blocked_range<unsigned int>& r) {
+          for (unsigned int b = r.begin(); b != r.end(); ++b)
+            runBlock(b);
+        });
+      });
+    }
+
+    const unsigned int sumTracks = std::accumulate(blockTracks.begin(), blockTracks.end(), 0u);
+    double beta = 0;
+    for (unsigned int b = 0; b < nBlocks; b++) {
+      beta = std::max(beta, blockBetas[b]);
+      addPrototypes(blockVertices[b], double(blockTracks[b]) / sumTracks);
+    }
+    return beta;
+  }
+
+}  // namespace DAClusterizerBlocks
+
+#endif
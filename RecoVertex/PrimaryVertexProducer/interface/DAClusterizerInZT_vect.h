@@ -219,6 +219,11 @@ public:
 
   double get_Tc(const vertex_t &y, int k) const;
 
+  // anneal the tracks from a single prototype down to the final temperature, whose beta is returned
+  double anneal(track_t &tks, vertex_t &y, double &rho0) const;
+  // the same, annealing overlapping blocks of the tracks sorted in z in parallel, then all the tracks
+  double annealInBlocks(track_t &tks, vertex_t &y, double &rho0) const;
+
 private:
   bool verbose_;
   double zdumpcenter_;
@@ -241,6 +246,10 @@ private:
   double zmerge_;
   double tmerge_;
   double betapurge_;
+
+  bool runInBlocks_;
+  unsigned int blockSize_;
+  double overlapFrac_;
 };
 
 //#ifndef DAClusterizerInZT_new_h
@@ -161,6 +161,11 @@ public:
 
   double beta0(const double betamax, track_t const &tks, vertex_t const &y) const;
 
+  // anneal the tracks from a single prototype down to the final temperature, whose beta is returned
+  double anneal(track_t &tks, vertex_t &y, double &rho0) const;
+  // the same, annealing overlapping blocks of the tracks sorted in z in parallel, then all the tracks
+  double annealInBlocks(track_t &tks, vertex_t &y, double &rho0) const;
+
 private:
   bool verbose_;
   double zdumpcenter_;
@@ -179,6 +184,10 @@ private:
   double uniquetrkweight_;
   double zmerge_;
   double betapurge_;
+
+  bool runInBlocks_;
+  unsigned int blockSize_;
+  double overlapFrac_;
 };
 
 //#ifndef DAClusterizerInZ_new_h
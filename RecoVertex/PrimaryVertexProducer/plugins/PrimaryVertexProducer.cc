@@ -18,6 +18,12 @@
 
 #include "RecoVertex/VertexTools/interface/GeometricAnnealing.h"
 
+#include <memory>
+
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 PrimaryVertexProducer::PrimaryVertexProducer(const edm::ParameterSet& conf) : theConfig(conf) {
   fVerbose = conf.getUntrackedParameter<bool>("verbose", false);
 
@@ -191,17 +197,16 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
     auto result = std::make_unique<reco::VertexCollection>();
     reco::VertexCollection& vColl = (*result);
 
-    std::vector<TransientVertex> pvs;
-    for (std::vector<std::vector<reco::TransientTrack> >::const_iterator iclus = clusters.begin();
-         iclus != clusters.end();
-         iclus++) {
+    // the clusters are fitted in parallel, each chunk with its own copy of the fitter
+    std::vector<TransientVertex> fitted(clusters.size());
+    auto fitCluster = [&](const VertexFitter<5>& fitter, const std::vector<reco::TransientTrack>& cluster) {
       double sumwt = 0.;
       double sumwt2 = 0.;
       double sumw = 0.;
       double meantime = 0.;
       double vartime = 0.;
       if (f4D) {
-        for (const auto& tk : *iclus) {
+        for (const auto& tk : cluster) {
           const double time = tk.timeExt();
           const double err = tk.dtErrorExt();
           const double inverr = err > 0. ? 1.0 / err : 0.;
@@ -212,13 +217,13 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
         }
         meantime = sumwt / sumw;
         double sumsq = sumwt2 - sumwt * sumwt / sumw;
-        double chisq = iclus->size() > 1 ? sumsq / double(iclus->size() - 1) : sumsq / double(iclus->size());
+        double chisq = cluster.size() > 1 ? sumsq / double(cluster.size() - 1) : sumsq / double(cluster.size());
         vartime = chisq / sumw;
       }
 
       TransientVertex v;
-      if (algorithm->useBeamConstraint && validBS && ((*iclus).size() > 1)) {
-        v = algorithm->fitter->vertex(*iclus, beamSpot);
+      if (algorithm->useBeamConstraint && validBS && (cluster.size() > 1)) {
+        v = fitter.vertex(cluster, beamSpot);
 
         if (f4D) {
           if (v.isValid()) {
@@ -228,8 +233,8 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
           }
         }
 
-      } else if (!(algorithm->useBeamConstraint) && ((*iclus).size() > 1)) {
-        v = algorithm->fitter->vertex(*iclus);
+      } else if (!(algorithm->useBeamConstraint) && (cluster.size() > 1)) {
+        v = fitter.vertex(cluster);
 
         if (f4D) {
           if (v.isValid()) {
@@ -240,6 +245,18 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
         }
 
       }  // else: no fit ==> v.isValid()=False
+      return v;
+    };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, clusters.size()), [&](const tbb::blocked_range<size_t>& r) {
+      std::unique_ptr<VertexFitter<5> > fitter(algorithm->fitter->clone());
+      for (size_t i = r.begin(); i != r.end(); ++i)
+        fitted[i] = fitCluster(*fitter, clusters[i]);
+    });
+
+    std::vector<TransientVertex> pvs;
+    for (size_t i = 0; i < clusters.size(); i++) {
+      const auto& cluster = clusters[i];
+      const TransientVertex& v = fitted[i];
 
       if (fVerbose) {
         if (v.isValid()) {
@@ -249,9 +266,9 @@ void PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& i
           std::cout << "=" << v.position().x() << " " << v.position().y() << " " << v.position().z();
           if (f4D)
             std::cout << " " << v.time();
-          std::cout << " cluster size = " << (*iclus).size() << std::endl;
+          std::cout << " cluster size = " << cluster.size() << std::endl;
         } else {
-          std::cout << "Invalid fitted vertex,  cluster size=" << (*iclus).size() << std::endl;
+          std::cout << "Invalid fitted vertex,  cluster size=" << cluster.size() << std::endl;
         }
       }
 
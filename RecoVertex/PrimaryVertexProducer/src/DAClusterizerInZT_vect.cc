@@ -1,4 +1,5 @@
 #include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZT_vect.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerBlocks.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/GeometryCommonDetAlgo/interface/Measurement1D.h"
 #include "RecoVertex/VertexPrimitives/interface/VertexException.h"
@@ -7,6 +8,7 @@
 #include <cassert>
 #include <limits>
 #include <iomanip>
+#include <algorithm>
 #include "FWCore/Utilities/interface/isFinite.h"
 #include "vdt/vdtMath.h"
 
@@ -43,6 +45,17 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
   zmerge_ = conf.getParameter<double>("zmerge");
   tmerge_ = conf.getParameter<double>("tmerge");
 
+  // optionally anneal the tracks in overlapping blocks in z, in parallel
+  runInBlocks_ = conf.existsAs<bool>("runInBlocks") ? conf.getParameter<bool>("runInBlocks") : false;
+  blockSize_ = conf.existsAs<unsigned int>("block_size") ? conf.getParameter<unsigned int>("block_size") : 512;
+  overlapFrac_ = conf.existsAs<double>("overlap_frac") ? conf.getParameter<double>("overlap_frac") : 0.5;
+  if ((blockSize_ == 0) || (overlapFrac_ < 0) || (overlapFrac_ >= 1)) {
+    edm::LogWarning("DAClusterizerinZT_vectorized")
+        << "DAClusterizerInZT: invalid block_size " << blockSize_ << " or overlap_frac " << overlapFrac_
+        << "  not running in blocks";
+    runInBlocks_ = false;
+  }
+
 #ifdef VI_DEBUG
   if (verbose_) {
     std::cout << "DAClusterizerinZT_vect: mintrkweight = " << mintrkweight_ << std::endl;
@@ -58,6 +71,9 @@ DAClusterizerInZT_vect::DAClusterizerInZT_vect(const edm::ParameterSet& conf) {
     std::cout << "DAClusterizerinZT_vect: d0CutOff = " << d0CutOff_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: dzCutOff = " << dzCutOff_ << std::endl;
     std::cout << "DAClusterizerinZT_vect: dtCutoff = " << dtCutOff_ << std::endl;
+    std::cout << "DAClusterizerinZT_vect: runInBlocks = " << runInBlocks_ << std::endl;
+    std::cout << "DAClusterizerinZT_vect: block_size = " << blockSize_ << std::endl;
+    std::cout << "DAClusterizerinZT_vect: overlap_frac = " << overlapFrac_ << std::endl;
   }
 #endif
 
@@ -814,23 +830,11 @@ void DAClusterizerInZT_vect::splitAll(vertex_t& y) const {
 #endif
 }
 
-vector<TransientVertex> DAClusterizerInZT_vect::vertices(const vector<reco::TransientTrack>& tracks,
-                                                         const int verbosity) const {
-  track_t&& tks = fill(tracks);
-  tks.extractRaw();
-
-  unsigned int nt = tks.getSize();
-  double rho0 = 0.0;  // start with no outlier rejection
-
-  vector<TransientVertex> clusters;
-  if (tks.getSize() == 0)
-    return clusters;
-
-  vertex_t y;  // the vertex prototypes
-
+double DAClusterizerInZT_vect::anneal(track_t& tks, vertex_t& y, double& rho0) const {
   // initialize:single vertex at infinite temperature
   y.addItem(0, 0, 1.0);
 
+  unsigned int nt = tks.getSize();
   int niter = 0;  // number of iterations
 
   // estimate first critical temperature
@@ -995,6 +999,75 @@ vector<TransientVertex> DAClusterizerInZT_vect::vertices(const vector<reco::Tran
   }
 #endif
 
+  return beta;
+}
+
+double DAClusterizerInZT_vect::annealInBlocks(track_t& tks, vertex_t& y, double& rho0) const {
+  const unsigned int nt = tks.getSize();
+
+  // each block is annealed on its own, serially in the verbose mode to keep the printout readable
+  auto annealBlock = [&](const vector<unsigned int>& iz, unsigned int first, unsigned int last, vertex_t& by) {
+    track_t btks;
+    for (unsigned int i = first; i < last; i++) {
+      const unsigned int j = iz[i];
+      btks.addItem(tks.z_[j], tks.t_[j], tks.dz2_[j], tks.dt2_[j], tks.tt[j], tks.pi_[j]);
+    }
+    btks.extractRaw();
+    double brho0 = 0.0;
+    return anneal(btks, by, brho0);
+  };
+
+  // the prototypes of all the blocks, weighted by the share of the tracks of their block
+  auto addPrototypes = [&y](const vertex_t& by, double wb) {
+    for (unsigned int k = 0; k < by.getSize(); k++)
+      y.addItem(by.z_[k], by.t_[k], by.pk_[k] * wb);
+  };
+  const double beta = DAClusterizerBlocks::anneal<vertex_t>(
+      tks.z_, nt, blockSize_, overlapFrac_, verbose_, annealBlock, addPrototypes);
+  zorder(y);
+
+  // thermalize the prototypes with all the tracks, the duplicates of the overlaps collapse here
+  rho0 = dzCutOff_ > 0 ? 1. / nt : 0.;
+  int niter = 0;
+  while ((update(beta, tks, y, true, rho0) > 1.e-6) && (niter++ < maxIterations_)) {
+  }
+  zorder(y);
+  while (merge(y, beta)) {
+    update(beta, tks, y, true, rho0);
+  }
+  while (purge(y, tks, rho0, beta)) {
+    niter = 0;
+    while ((update(beta, tks, y, true, rho0) > 1.e-6) && (niter++ < maxIterations_)) {
+      zorder(y);
+    }
+  }
+
+#ifdef VI_DEBUG
+  if (verbose_) {
+    std::cout << "Final result of the blocks, rho0=" << std::scientific << rho0 << endl;
+    dump(beta, y, tks, 2);
+  }
+#endif
+
+  return beta;
+}
+
+vector<TransientVertex> DAClusterizerInZT_vect::vertices(const vector<reco::TransientTrack>& tracks,
+                                                         const int verbosity) const {
+  track_t&& tks = fill(tracks);
+  tks.extractRaw();
+
+  unsigned int nt = tks.getSize();
+  double rho0 = 0.0;  // start with no outlier rejection
+
+  vector<TransientVertex> clusters;
+  if (tks.getSize() == 0)
+    return clusters;
+
+  vertex_t y;  // the vertex prototypes
+
+  double beta = (runInBlocks_ && nt > blockSize_) ? annealInBlocks(tks, y, rho0) : anneal(tks, y, rho0);
+
   // new, merge here and not in "clusterize"
   // final merging step
   double betadummy = 1;
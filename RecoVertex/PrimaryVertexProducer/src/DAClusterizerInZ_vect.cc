@@ -1,4 +1,5 @@
 #include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerInZ_vect.h"
+#include "RecoVertex/PrimaryVertexProducer/interface/DAClusterizerBlocks.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/GeometryCommonDetAlgo/interface/Measurement1D.h"
 #include "RecoVertex/VertexPrimitives/interface/VertexException.h"
@@ -7,6 +8,7 @@
 #include <cassert>
 #include <limits>
 #include <iomanip>
+#include <algorithm>
 #include "FWCore/Utilities/interface/isFinite.h"
 #include "vdt/vdtMath.h"
 
@@ -38,6 +40,17 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
   uniquetrkweight_ = conf.getParameter<double>("uniquetrkweight");
   zmerge_ = conf.getParameter<double>("zmerge");
 
+  // optionally anneal the tracks in overlapping blocks in z, in parallel
+  runInBlocks_ = conf.existsAs<bool>("runInBlocks") ? conf.getParameter<bool>("runInBlocks") : false;
+  blockSize_ = conf.existsAs<unsigned int>("block_size") ? conf.getParameter<unsigned int>("block_size") : 512;
+  overlapFrac_ = conf.existsAs<double>("overlap_frac") ? conf.getParameter<double>("overlap_frac") : 0.5;
+  if ((blockSize_ == 0) || (overlapFrac_ < 0) || (overlapFrac_ >= 1)) {
+    edm::LogWarning("DAClusterizerinZ_vectorized")
+        << "DAClusterizerInZ: invalid block_size " << blockSize_ << " or overlap_frac " << overlapFrac_
+        << "  not running in blocks";
+    runInBlocks_ = false;
+  }
+
   if (verbose_) {
     std::cout << "DAClusterizerinZ_vect: mintrkweight = " << mintrkweight_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: uniquetrkweight = " << uniquetrkweight_ << std::endl;
@@ -49,6 +62,9 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
     std::cout << "DAClusterizerinZ_vect: coolingFactor = " << coolingFactor_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: d0CutOff = " << d0CutOff_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: dzCutOff = " << dzCutOff_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: runInBlocks = " << runInBlocks_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: block_size = " << blockSize_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: overlap_frac = " << overlapFrac_ << std::endl;
   }
 
   if (Tmin == 0) {
@@ -536,23 +552,11 @@ void DAClusterizerInZ_vect::splitAll(vertex_t& y) const {
   }
 }
 
-vector<TransientVertex> DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack>& tracks,
-                                                        const int verbosity) const {
-  track_t&& tks = fill(tracks);
-  tks.ExtractRaw();
-
-  unsigned int nt = tks.GetSize();
-  double rho0 = 0.0;  // start with no outlier rejection
-
-  vector<TransientVertex> clusters;
-  if (tks.GetSize() == 0)
-    return clusters;
-
-  vertex_t y;  // the vertex prototypes
-
+double DAClusterizerInZ_vect::anneal(track_t& tks, vertex_t& y, double& rho0) const {
   // initialize:single vertex at infinite temperature
   y.AddItem(0, 1.0);
 
+  unsigned int nt = tks.GetSize();
   int niter = 0;  // number of iterations
 
   // estimate first critical temperature
@@ -688,6 +692,80 @@ vector<TransientVertex> DAClusterizerInZ_vect::vertices(const vector<reco::Trans
     dump(beta, y, tks, 2);
   }
 
+  return beta;
+}
+
+double DAClusterizerInZ_vect::annealInBlocks(track_t& tks, vertex_t& y, double& rho0) const {
+  const unsigned int nt = tks.GetSize();
+
+  // each block is annealed on its own, serially in the verbose mode to keep the printout readable
+  auto annealBlock = [&](const vector<unsigned int>& iz, unsigned int first, unsigned int last, vertex_t& by) {
+    track_t btks;
+    for (unsigned int i = first; i < last; i++) {
+      const unsigned int j = iz[i];
+      btks.AddItem(tks._z[j], tks._dz2[j], tks.tt[j], tks._pi[j]);
+    }
+    btks.ExtractRaw();
+    double brho0 = 0.0;
+    return anneal(btks, by, brho0);
+  };
+
+  // the prototypes of all the blocks, in z order, weighted by the share of the tracks of their block
+  vector<pair<double, double> > prototypes;
+  auto addPrototypes = [&prototypes](const vertex_t& by, double wb) {
+    for (unsigned int k = 0; k < by.GetSize(); k++)
+      prototypes.emplace_back(by._z[k], by._pk[k] * wb);
+  };
+  const double beta = DAClusterizerBlocks::anneal<vertex_t>(
+      tks._z, nt, blockSize_, overlapFrac_, verbose_, annealBlock, addPrototypes);
+  std::stable_sort(prototypes.begin(),
+                   prototypes.end(),
+                   [](const pair<double, double>& a, const pair<double, double>& b) { return a.first < b.first; });
+  for (const auto& p : prototypes)
+    y.AddItem(p.first, p.second);
+
+  if (verbose_) {
+    std::cout << "prototypes of the blocks of " << blockSize_ << " tracks" << std::endl;
+  }
+
+  // thermalize the prototypes with all the tracks, the duplicates of the overlaps collapse here
+  rho0 = dzCutOff_ > 0 ? 1. / nt : 0.;
+  int niter = 0;
+  while ((update(beta, tks, y, true, rho0) > 1.e-6) && (niter++ < maxIterations_)) {
+  }
+  while (merge(y, beta)) {
+    update(beta, tks, y, true, rho0);
+  }
+  while (purge(y, tks, rho0, beta)) {
+    niter = 0;
+    while ((update(beta, tks, y, true, rho0) > 1.e-6) && (niter++ < maxIterations_)) {
+    }
+  }
+
+  if (verbose_) {
+    std::cout << "Final result of the blocks, rho0=" << std::scientific << rho0 << endl;
+    dump(beta, y, tks, 2);
+  }
+
+  return beta;
+}
+
+vector<TransientVertex> DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack>& tracks,
+                                                        const int verbosity) const {
+  track_t&& tks = fill(tracks);
+  tks.ExtractRaw();
+
+  unsigned int nt = tks.GetSize();
+  double rho0 = 0.0;  // start with no outlier rejection
+
+  vector<TransientVertex> clusters;
+  if (tks.GetSize() == 0)
+    return clusters;
+
+  vertex_t y;  // the vertex prototypes
+
+  double beta = (runInBlocks_ && nt > blockSize_) ? annealInBlocks(tks, y, rho0) : anneal(tks, y, rho0);
+
   // select significant tracks and use a TransientVertex as a container
   GlobalError dummyError(0.01, 0, 0.01, 0., 0., 0.01);
 
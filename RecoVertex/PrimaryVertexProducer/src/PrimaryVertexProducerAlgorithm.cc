@@ -16,6 +16,12 @@
 #include "TrackingTools/Records/interface/TransientTrackRecord.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 
+#include <memory>
+
+// TBB includes
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 PrimaryVertexProducerAlgorithm::PrimaryVertexProducerAlgorithm(const edm::ParameterSet& conf) : theConfig(conf) {
   fVerbose = conf.getUntrackedParameter<bool>("verbose", false);
   trackLabel = conf.getParameter<edm::InputTag>("TrackLabel");
@@ -161,19 +167,23 @@ std::vector<TransientVertex> PrimaryVertexProducerAlgorithm::vertices(const std:
     //std::auto_ptr<reco::VertexCollection> result(new reco::VertexCollection);
     // reco::VertexCollection vColl;
 
-    std::vector<TransientVertex> pvs;
-    for (std::vector<std::vector<reco::TransientTrack> >::const_iterator iclus = clusters.begin();
-         iclus != clusters.end();
-         iclus++) {
-      TransientVertex v;
-      if (algorithm->useBeamConstraint && validBS && ((*iclus).size() > 1)) {
-        v = algorithm->fitter->vertex(*iclus, beamSpot);
+    // the clusters are fitted in parallel, each chunk with its own copy of the fitter
+    std::vector<TransientVertex> fitted(clusters.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, clusters.size()), [&](const tbb::blocked_range<size_t>& r) {
+      std::unique_ptr<VertexFitter<5> > fitter(algorithm->fitter->clone());
+      for (size_t i = r.begin(); i != r.end(); ++i) {
+        if (algorithm->useBeamConstraint && validBS && (clusters[i].size() > 1)) {
+          fitted[i] = fitter->vertex(clusters[i], beamSpot);
 
-      } else if (!(algorithm->useBeamConstraint) && ((*iclus).size() > 1)) {
-        v = algorithm->fitter->vertex(*iclus);
+        } else if (!(algorithm->useBeamConstraint) && (clusters[i].size() > 1)) {
+          fitted[i] = fitter->vertex(clusters[i]);
 
-      }  // else: no fit ==> v.isValid()=False
+        }  // else: no fit ==> v.isValid()=False
+      }
+    });
 
+    std::vector<TransientVertex> pvs;
+    for (const auto& v : fitted) {
       if (fVerbose) {
         if (v.isValid())
           std::cout << "x,y,z=" << v.position().x() << " " << v.position().y() << " " << v.position().z() << std::endl;
@@ -133,27 +133,37 @@ void V0Fitter::fitAll(const edm::Event& iEvent,
   }
   // good tracks have now been selected for vertexing
 
+  // the charge and the validity of the impact point state of each good track, looked up once per track rather
+  // than once per pair: the pairs of same charge, or with a track without impact point state, are skipped first
+  std::vector<int> theCharges(theTrackRefs.size(), 0);
+  for (unsigned int trdx = 0; trdx < theTrackRefs.size(); ++trdx) {
+    if (theTransTracks[trdx].impactPointTSCP().isValid())
+      theCharges[trdx] = theTrackRefs[trdx]->charge();
+  }
+
+  // the vertex fitter, common to all the pairs
+  std::unique_ptr<VertexFitter<5>> theFitter;
+  if (vertexFitter_) {
+    theFitter = std::make_unique<KalmanVertexFitter>(useRefTracks_ == 0 ? false : true);
+  } else {
+    useRefTracks_ = false;
+    theFitter = std::make_unique<AdaptiveVertexFitter>();
+  }
+
   // loop over tracks and vertex good charged track pairs
   for (unsigned int trdx1 = 0; trdx1 < theTrackRefs.size(); ++trdx1) {
+    if (theCharges[trdx1] == 0)
+      continue;
     for (unsigned int trdx2 = trdx1 + 1; trdx2 < theTrackRefs.size(); ++trdx2) {
-      reco::TrackRef positiveTrackRef;
-      reco::TrackRef negativeTrackRef;
-      reco::TransientTrack* posTransTkPtr = nullptr;
-      reco::TransientTrack* negTransTkPtr = nullptr;
-
-      if (theTrackRefs[trdx1]->charge() < 0. && theTrackRefs[trdx2]->charge() > 0.) {
-        negativeTrackRef = theTrackRefs[trdx1];
-        positiveTrackRef = theTrackRefs[trdx2];
-        negTransTkPtr = &theTransTracks[trdx1];
-        posTransTkPtr = &theTransTracks[trdx2];
-      } else if (theTrackRefs[trdx1]->charge() > 0. && theTrackRefs[trdx2]->charge() < 0.) {
-        negativeTrackRef = theTrackRefs[trdx2];
-        positiveTrackRef = theTrackRefs[trdx1];
-        negTransTkPtr = &theTransTracks[trdx2];
-        posTransTkPtr = &theTransTracks[trdx1];
-      } else {
+      if (theCharges[trdx1] * theCharges[trdx2] >= 0)
         continue;
-      }
+
+      const unsigned int posdx = theCharges[trdx1] > 0 ? trdx1 : trdx2;
+      const unsigned int negdx = theCharges[trdx1] > 0 ? trdx2 : trdx1;
+      reco::TrackRef const& positiveTrackRef = theTrackRefs[posdx];
+      reco::TrackRef const& negativeTrackRef = theTrackRefs[negdx];
+      reco::TransientTrack* posTransTkPtr = &theTransTracks[posdx];
+      reco::TransientTrack* negTransTkPtr = &theTransTracks[negdx];
 
       // measure distance between tracks at their closest approach
 
@@ -161,8 +171,6 @@ void V0Fitter::fitAll(const edm::Event& iEvent,
       // in order to keep posState and negState from pointing to destructed objects
       auto const& posImpact = posTransTkPtr->impactPointTSCP();
       auto const& negImpact = negTransTkPtr->impactPointTSCP();
-      if (!posImpact.isValid() || !negImpact.isValid())
-        continue;
       FreeTrajectoryState const& posState = posImpact.theState();
       FreeTrajectoryState const& negState = negImpact.theState();
       ClosestApproachInRPhi cApp;
@@ -200,16 +208,8 @@ void V0Fitter::fitAll(const edm::Event& iEvent,
       transTracks.push_back(*posTransTkPtr);
       transTracks.push_back(*negTransTkPtr);
 
-      // create the vertex fitter object and vertex the tracks
-      TransientVertex theRecoVertex;
-      if (vertexFitter_) {
-        KalmanVertexFitter theKalmanFitter(useRefTracks_ == 0 ? false : true);
-        theRecoVertex = theKalmanFitter.vertex(transTracks);
-      } else if (!vertexFitter_) {
-        useRefTracks_ = false;
-        AdaptiveVertexFitter theAdaptiveFitter;
-        theRecoVertex = theAdaptiveFitter.vertex(transTracks);
-      }
+      // vertex the tracks
+      TransientVertex theRecoVertex = theFitter->vertex(transTracks);
       if (!theRecoVertex.isValid())
         continue;
 
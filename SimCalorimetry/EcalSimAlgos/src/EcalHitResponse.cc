@@ -144,7 +144,9 @@ void EcalHitResponse::putAnalogSignal(const PCaloHit& hit, CLHEP::HepRandomEngin
 
   const double jitter(time - timeOfFlight(detId));
 
-  const double tzero = (shape()->timeToRise() + parameters->timePhase() - jitter -
+  const CaloVShape* theShape(shape());
+
+  const double tzero = (theShape->timeToRise() + parameters->timePhase() - jitter -
                         BUNCHSPACE * (parameters->binOfMaximum() - m_phaseShift));
   double binTime(tzero);
 
@@ -153,7 +155,7 @@ void EcalHitResponse::putAnalogSignal(const PCaloHit& hit, CLHEP::HepRandomEngin
   const unsigned int rsize(result.size());
 
   for (unsigned int bin(0); bin != rsize; ++bin) {
-    result[bin] += (*shape())(binTime)*signal;
+    result[bin] += (*theShape)(binTime)*signal;
     binTime += BUNCHSPACE;
   }
 }
@@ -14,7 +14,7 @@
 #include "CLHEP/Random/RandPoissonQ.h"
 
 #include <cmath>
-#include <list>
+#include <vector>
 
 HcalSiPMHitResponse::HcalSiPMHitResponse(const CaloVSimParameterMap* parameterMap,
                                          const CaloShapes* shapes,
@@ -211,9 +211,8 @@ CaloSamples HcalSiPMHitResponse::makeSiPMSignal(DetId const& id,
 
   auto& sipmPulseShape(shapeMap[pars.signalShape(id)]);
 
-  std::list<std::pair<double, double> > pulses;
-  std::list<std::pair<double, double> >::iterator pulse;
-  double timeDiff, pulseBit;
+  std::vector<std::pair<double, double> > pulses;
+  double timeDiff, pulseShape, pulseBit;
   LogDebug("HcalSiPMHitResponse") << "makeSiPMSignal for " << HcalDetId(id);
 
   for (unsigned int tbin(0); tbin < photonTimeBins.size(); ++tbin) {
@@ -235,7 +234,7 @@ CaloSamples HcalSiPMHitResponse::makeSiPMSignal(DetId const& id,
       LogDebug("HcalSiPMHitResponse") << " elapsedTime: " << elapsedTime << " sampleBin: " << sampleBin
                                       << " preciseBin: " << preciseBin << " pe: " << pe << " hitPixels: " << hitPixels;
       if (pars.doSiPMSmearing()) {
-        pulses.push_back(std::pair<double, double>(elapsedTime, hitPixels));
+        pulses.emplace_back(elapsedTime, hitPixels);
       } else {
         signal[sampleBin] += hitPixels;
         hitPixels *= invdt;
@@ -248,20 +247,21 @@ CaloSamples HcalSiPMHitResponse::makeSiPMSignal(DetId const& id,
     }
 
     if (pars.doSiPMSmearing()) {
-      pulse = pulses.begin();
-      while (pulse != pulses.end()) {
-        timeDiff = elapsedTime - pulse->first;
-        pulseBit = sipmPulseShape(timeDiff) * pulse->second;
-        LogDebug("HcalSiPMHitResponse") << " pulse t: " << pulse->first << " pulse A: " << pulse->second
+      // the pulses which are over are dropped in place, keeping the order of the others
+      unsigned int nPulses(0);
+      for (auto const& pulse : pulses) {
+        timeDiff = elapsedTime - pulse.first;
+        pulseShape = sipmPulseShape(timeDiff);
+        pulseBit = pulseShape * pulse.second;
+        LogDebug("HcalSiPMHitResponse") << " pulse t: " << pulse.first << " pulse A: " << pulse.second
                                         << " timeDiff: " << timeDiff << " pulseBit: " << pulseBit;
         signal[sampleBin] += pulseBit;
         signal.preciseAtMod(preciseBin) += pulseBit * invdt;
 
-        if (timeDiff > 1 && sipmPulseShape(timeDiff) < 1e-7)
-          pulse = pulses.erase(pulse);
-        else
-          ++pulse;
+        if (!(timeDiff > 1 && pulseShape < 1e-7))
+          pulses[nPulses++] = pulse;
       }
+      pulses.resize(nPulses);
     }
     elapsedTime += dt;
   }
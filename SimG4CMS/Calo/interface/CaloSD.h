@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 class G4Step;
 class G4HCofThisEvent;
@@ -164,8 +165,23 @@ private:
   double correctT;
   bool useFineCaloID_;
 
-  std::map<CaloHitID, CaloG4Hit*> hitMap;
-  std::map<int, TrackWithHistory*> tkMap;
+  // the hits of the event by ID: the same fields as ordered by CaloHitID::operator<, whatever the ignoreTrackID
+  // of the IDs; cleared, and its buckets reused, at each event
+  struct HitIDHash {
+    size_t operator()(const CaloHitID& id) const {
+      uint64_t key = (uint64_t(id.unitID()) << 32) | uint32_t(id.trackID());
+      key ^= (uint64_t(id.depth()) << 16 | uint16_t(id.timeSliceID())) * 0x9E3779B97F4A7C15ULL;
+      return std::hash<uint64_t>()(key);
+    }
+  };
+  struct HitIDEqual {
+    bool operator()(const CaloHitID& a, const CaloHitID& b) const {
+      return a.unitID() == b.unitID() && a.trackID() == b.trackID() && a.depth() == b.depth() &&
+             a.timeSliceID() == b.timeSliceID();
+    }
+  };
+  std::unordered_map<CaloHitID, CaloG4Hit*, HitIDHash, HitIDEqual> hitMap;
+  std::unordered_map<int, TrackWithHistory*> tkMap;
   std::vector<std::unique_ptr<CaloG4Hit>> reusehit;
 };
 
@@ -317,7 +317,7 @@ bool CaloSD::checkHit() {
   //look in the HitContainer whether a hit with the same ID already exists:
   bool found = false;
   if (useMap) {
-    std::map<CaloHitID, CaloG4Hit*>::const_iterator it = hitMap.find(currentID);
+    auto const it = hitMap.find(currentID);
     if (it != hitMap.end()) {
       currentHit = it->second;
       found = true;
@@ -643,7 +643,7 @@ void CaloSD::storeHit(CaloG4Hit* hit) {
 
   theHC->insert(hit);
   if (useMap)
-    hitMap.insert(std::pair<CaloHitID, CaloG4Hit*>(previousID, hit));
+    hitMap.insert(std::make_pair(previousID, hit));
 }
 
 bool CaloSD::saveHit(CaloG4Hit* aHit) {
@@ -100,6 +100,18 @@ private:
   // flags
   bool gRRactive;
   bool nRRactive;
+
+  // Russian roulette per region and particle, in addition to the factors above which it overrides
+  struct RusRoEntry {
+    std::string regionName;
+    const G4Region* region;
+    int pdg;
+    double energyLimit;
+    double prob;
+  };
+  std::vector<RusRoEntry> rusRoTable;
+
+  const RusRoEntry* rusRoEntry(const G4Region*, int pdg) const;
 };
 
 #endif
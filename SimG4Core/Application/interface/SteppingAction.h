@@ -40,7 +40,7 @@ private:
   bool initPointer();
 
   bool isInsideDeadRegion(const G4Region* reg) const;
-  bool isOutOfTimeWindow(G4Track* theTrack, const G4Region* reg) const;
+  double maxTrackTimeInRegion(const G4Region* reg) const;
   bool isThisVolume(const G4VTouchable* touch, const G4VPhysicalVolume* pv) const;
 
   bool isLowEnergy(const G4Step* aStep) const;
@@ -59,6 +59,10 @@ private:
   std::vector<const G4Region*> deadRegions;
   std::vector<G4LogicalVolume*> ekinVolumes;
   std::vector<int> ekinPDG;
+  // the region of the last step, with its dead region flag and time limit
+  const G4Region* currentRegion;
+  bool currentRegionDead;
+  double currentMaxTrackTime;
   unsigned int numberTimes;
   unsigned int numberEkins;
   unsigned int numberPart;
@@ -68,6 +72,7 @@ private:
   bool initialized;
   bool killBeamPipe;
   bool hasWatcher;
+  bool hasStepObservers;
 };
 
 inline bool SteppingAction::isInsideDeadRegion(const G4Region* reg) const {
@@ -81,7 +86,7 @@ inline bool SteppingAction::isInsideDeadRegion(const G4Region* reg) const {
   return res;
 }
 
-inline bool SteppingAction::isOutOfTimeWindow(G4Track* theTrack, const G4Region* reg) const {
+inline double SteppingAction::maxTrackTimeInRegion(const G4Region* reg) const {
   double tofM = maxTrackTime;
   for (unsigned int i = 0; i < numberTimes; ++i) {
     if (reg == maxTimeRegions[i]) {
@@ -89,7 +94,7 @@ inline bool SteppingAction::isOutOfTimeWindow(G4Track* theTrack, const G4Region*
       break;
     }
   }
-  return (theTrack->GetGlobalTime() > tofM) ? true : false;
+  return tofM;
 }
 
 inline bool SteppingAction::isThisVolume(const G4VTouchable* touch, const G4VPhysicalVolume* pv) const {
@@ -74,6 +74,20 @@ StackingAction::StackingAction(const TrackingAction* trka, const edm::ParameterS
     nRRactive = true;
   }
 
+  // the table of the regions, particles, energy limits and survival probabilities
+  if (p.exists("RusRoRegions")) {
+    for (auto const& pset : p.getParameter<std::vector<edm::ParameterSet> >("RusRoRegions")) {
+      RusRoEntry entry{pset.getParameter<std::string>("Region"),
+                       nullptr,
+                       pset.getParameter<int>("PDGid"),
+                       pset.getParameter<double>("EnergyLimit") * MeV,
+                       pset.getParameter<double>("Probability")};
+      if (entry.prob < 1.0 && entry.energyLimit > 0.0) {
+        rusRoTable.push_back(entry);
+      }
+    }
+  }
+
   if (p.exists("TestKillingOptions")) {
     killInCalo = (p.getParameter<edm::ParameterSet>("TestKillingOptions")).getParameter<bool>("KillInCalo");
     killInCaloEfH = (p.getParameter<edm::ParameterSet>("TestKillingOptions")).getParameter<bool>("KillInCaloEfH");
@@ -142,6 +156,11 @@ StackingAction::StackingAction(const TrackingAction* trka, const edm::ParameterS
         << "               CASTOR Prob= " << nRusRoCastor << "\n"
         << "                World Prob= " << nRusRoWorld;
   }
+  for (auto const& entry : rusRoTable) {
+    edm::LogVerbatim("SimG4CoreApplication")
+        << "StackingAction: Russian Roulette in " << entry.regionName << (entry.region ? "" : " (not found)")
+        << " for PDGid " << entry.pdg << " Elimit(MeV)= " << entry.energyLimit / MeV << " Prob= " << entry.prob;
+  }
 
   if (savePDandCinTracker) {
     edm::LogVerbatim("SimG4CoreApplication") << "StackingAction Tracker regions: ";
@@ -251,15 +270,21 @@ G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* aTrac
           }
 
           // Russian roulette
-          if (2112 == pdg || 22 == pdg) {
+          const RusRoEntry* entry = rusRoTable.empty() ? nullptr : rusRoEntry(reg, pdg);
+          if (nullptr != entry || 2112 == pdg || 22 == pdg) {
             double currentWeight = aTrack->GetWeight();
 
             if (1.0 >= currentWeight) {
               double prob = 1.0;
               double elim = 0.0;
 
-              // neutron
-              if (nRRactive && pdg == 2112) {
+              // table
+              if (nullptr != entry) {
+                elim = entry->energyLimit;
+                prob = entry->prob;
+
+                // neutron
+              } else if (nRRactive && pdg == 2112) {
                 elim = nRusRoEnerLim;
                 if (reg == regionEcal) {
                   prob = nRusRoEcal;
@@ -358,6 +383,12 @@ void StackingAction::initPointer() {
       regionWorld = reg;
     }
 
+    for (auto& entry : rusRoTable) {
+      if (rname == (G4String)(entry.regionName)) {
+        entry.region = reg;
+      }
+    }
+
     // time limits
     for (unsigned int i = 0; i < num; ++i) {
       if (rname == (G4String)(maxTimeNames[i])) {
@@ -401,6 +432,15 @@ bool StackingAction::isThisRegion(const G4Region* reg, std::vector<const G4Regio
   return flag;
 }
 
+const StackingAction::RusRoEntry* StackingAction::rusRoEntry(const G4Region* reg, int pdg) const {
+  for (auto const& entry : rusRoTable) {
+    if (reg == entry.region && pdg == entry.pdg) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
 int StackingAction::isItPrimaryDecayProductOrConversion(const G4Track* aTrack, const G4Track& mother) const {
   int flag = 0;
   const TrackInformation& motherInfo(extractor(mother));
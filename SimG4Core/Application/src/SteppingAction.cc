@@ -20,10 +20,14 @@ SteppingAction::SteppingAction(EventAction* e, const edm::ParameterSet& p, const
       tracker(nullptr),
       calo(nullptr),
       steppingVerbose(sv),
+      currentRegion(nullptr),
+      currentRegionDead(false),
+      currentMaxTrackTime(0.0),
       nWarnings(0),
       initialized(false),
       killBeamPipe(false),
-      hasWatcher(hasW) {
+      hasWatcher(hasW),
+      hasStepObservers(true) {
   theCriticalEnergyForVacuum = (p.getParameter<double>("CriticalEnergyForVacuum") * CLHEP::MeV);
   if (0.0 < theCriticalEnergyForVacuum) {
     killBeamPipe = true;
@@ -87,8 +91,9 @@ void SteppingAction::UserSteppingAction(const G4Step* aStep) {
     initialized = initPointer();
   }
 
-  //if(hasWatcher) { m_g4StepSignal(aStep); }
-  m_g4StepSignal(aStep);
+  if (hasStepObservers) {
+    m_g4StepSignal(aStep);
+  }
 
   G4Track* theTrack = aStep->GetTrack();
   TrackStatus tstat = (theTrack->GetTrackStatus() == fAlive) ? sAlive : sKilledByProcess;
@@ -99,8 +104,15 @@ void SteppingAction::UserSteppingAction(const G4Step* aStep) {
     G4StepPoint* preStep = aStep->GetPreStepPoint();
     const G4Region* theRegion = preStep->GetPhysicalVolume()->GetLogicalVolume()->GetRegion();
 
+    // the region lookups, only when the region changes
+    if (theRegion != currentRegion) {
+      currentRegion = theRegion;
+      currentRegionDead = isInsideDeadRegion(theRegion);
+      currentMaxTrackTime = maxTrackTimeInRegion(theRegion);
+    }
+
     // kill in dead regions
-    if (isInsideDeadRegion(theRegion)) {
+    if (currentRegionDead) {
       tstat = sDeadRegion;
     }
 
@@ -118,7 +130,7 @@ void SteppingAction::UserSteppingAction(const G4Step* aStep) {
     }
 
     // kill out of time
-    if (sAlive == tstat && isOutOfTimeWindow(theTrack, theRegion)) {
+    if (sAlive == tstat && theTrack->GetGlobalTime() > currentMaxTrackTime) {
       tstat = sOutOfTime;
     }
 
@@ -260,6 +272,10 @@ bool SteppingAction::initPointer() {
       }
     }
   }
+
+  // the observers are all connected before the first step: without any, the step signal is not sent
+  hasStepObservers = !m_g4StepSignal.empty();
+  edm::LogVerbatim("SimG4CoreApplication") << "SteppingAction: step signal observed " << hasStepObservers;
   return true;
 }
 
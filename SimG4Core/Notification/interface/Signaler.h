@@ -47,6 +47,17 @@ namespace sim_act {
       }
     }
 
+    ///true if no Observer is connected, directly or through the Signalers forwarding this one
+    bool empty() const {
+      for (auto const* obs : observers_) {
+        auto const* forward = dynamic_cast<const Signaler<T>*>(obs);
+        if (nullptr == forward || !forward->empty()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
     // ---------- static member functions --------------------
 
     // ---------- member functions ---------------------------
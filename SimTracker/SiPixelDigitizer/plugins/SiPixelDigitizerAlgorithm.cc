@@ -40,6 +40,7 @@
 // February, 2011: Time improvement in DriftDirection()  (J. Bashir Butt)
 // June, 2011: Bug Fix for pixels on ROC edges in module_killing_DB() (J. Bashir Butt)
 // February, 2018: Implement cluster charge reweighting (P. Schuetze, with code from A. Hazi)
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -1368,8 +1369,8 @@ void SiPixelDigitizerAlgorithm::induce_signal(std::vector<PSimHit>::const_iterat
   typedef std::map<int, float, std::less<int> > hit_map_type;
   hit_map_type hit_signal;
 
-  // map to store pixel integrals in the x and in the y directions
-  std::map<int, float, std::less<int> > x, y;
+  // pixel integrals in the x and in the y directions, from the lowest pixel index of the cloud
+  std::vector<float> x, y;
 
   // Assign signals to readout channels and store sorted by channel number
 
@@ -1439,8 +1440,9 @@ void SiPixelDigitizerAlgorithm::induce_signal(std::vector<PSimHit>::const_iterat
     IPixLeftDownX = 0 < IPixLeftDownX ? IPixLeftDownX : 0;
     IPixLeftDownY = 0 < IPixLeftDownY ? IPixLeftDownY : 0;
 
-    x.clear();  // clear temporary integration array
-    y.clear();
+    // clear temporary integration arrays
+    x.assign(std::max(0, IPixRightUpX - IPixLeftDownX + 1), 0.f);
+    y.assign(std::max(0, IPixRightUpY - IPixLeftDownY + 1), 0.f);
 
     // First integrate charge strips in x
     int ix;                                               // TT for compatibility
@@ -1467,7 +1469,7 @@ void SiPixelDigitizerAlgorithm::induce_signal(std::vector<PSimHit>::const_iterat
       }
 
       float TotalIntegrationRange = UpperBound - LowerBound;  // get strip
-      x[ix] = TotalIntegrationRange;                          // save strip integral
+      x[ix - IPixLeftDownX] = TotalIntegrationRange;          // save strip integral
       //if(SigmaX==0 || SigmaY==0)
       //cout<<TotalIntegrationRange<<" "<<ix<<std::endl;
     }
@@ -1494,17 +1496,18 @@ void SiPixelDigitizerAlgorithm::induce_signal(std::vector<PSimHit>::const_iterat
       }
 
       float TotalIntegrationRange = UpperBound - LowerBound;
-      y[iy] = TotalIntegrationRange;  // save strip integral
+      y[iy - IPixLeftDownY] = TotalIntegrationRange;  // save strip integral
       //if(SigmaX==0 || SigmaY==0)
       //cout<<TotalIntegrationRange<<" "<<iy<<std::endl;
     }
 
     // Get the 2D charge integrals by folding x and y strips
     int chan;
-    for (ix = IPixLeftDownX; ix <= IPixRightUpX; ix++) {    // loop over x index
+    for (ix = IPixLeftDownX; ix <= IPixRightUpX; ix++) {  // loop over x index
+      const float ChargeX = Charge * x[ix - IPixLeftDownX];
       for (iy = IPixLeftDownY; iy <= IPixRightUpY; iy++) {  //loope over y ind
 
-        float ChargeFraction = Charge * x[ix] * y[iy];
+        float ChargeFraction = ChargeX * y[iy - IPixLeftDownY];
 
         if (ChargeFraction > 0.) {
           chan = PixelDigi::pixelToChannel(ix, iy);  // Get index
@@ -8,13 +8,18 @@ void SiPileUpSignals::add(uint32_t detID,
                           const size_t& firstChannelWithSignal,
                           const size_t& lastChannelWithSignal) {
   SignalMapType& theSignal = signal_[detID];
+  // the channels are in increasing order: merged with those of the map in one pass
+  auto it = theSignal.lower_bound(firstChannelWithSignal);
   for (size_t iChannel = firstChannelWithSignal; iChannel < lastChannelWithSignal; ++iChannel) {
     if (locAmpl[iChannel] != 0.0) {
-      if (theSignal.find(iChannel) == theSignal.end()) {
-        theSignal.insert(std::make_pair(iChannel, locAmpl[iChannel]));
+      while (it != theSignal.end() && it->first < int(iChannel))
+        ++it;
+      if (it != theSignal.end() && it->first == int(iChannel)) {
+        it->second += locAmpl[iChannel];
       } else {
-        theSignal[iChannel] += locAmpl[iChannel];
+        it = theSignal.emplace_hint(it, iChannel, locAmpl[iChannel]);
       }
+      ++it;
     }
   }
 }
@@ -172,7 +172,10 @@ void SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_it
 
   float langle = (lorentzAngleHandle.isValid()) ? lorentzAngleHandle->getLorentzAngle(detID) : 0.;
 
-  std::vector<float> locAmpl(numStrips, 0.);
+  // only the channels with signal are reset after the module, instead of allocating all its strips for each one
+  if (locAmpl_.size() < size_t(numStrips))
+    locAmpl_.resize(numStrips, 0.f);
+  std::vector<float>& locAmpl = locAmpl_;
 
   // Loop over hits
 
@@ -210,7 +213,8 @@ void SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_it
           thisLastChannelWithSignal = localLastChannel;
 
         if (makeDigiSimLinks_) {  // No need to do any of this if truth association was turned off in the configuration
-          for (size_t stripIndex = 0; stripIndex < locAmpl.size(); ++stripIndex) {
+          // only the strips the hit induced charge on may have changed
+          for (size_t stripIndex = localFirstChannel; stripIndex < localLastChannel; ++stripIndex) {
             // Work out the amplitude from this SimHit from the difference of what it was before and what it is now
             float signalFromThisSimHit = locAmpl[stripIndex] - previousLocalAmplitude[stripIndex];
             if (signalFromThisSimHit != 0) {  // If this SimHit had any contribution I need to record it.
@@ -238,6 +242,8 @@ void SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_it
     }          // end for
   }
   theSiPileUpSignals->add(detID, locAmpl, thisFirstChannelWithSignal, thisLastChannelWithSignal);
+  if (thisFirstChannelWithSignal < thisLastChannelWithSignal)
+    std::fill(locAmpl.begin() + thisFirstChannelWithSignal, locAmpl.begin() + thisLastChannelWithSignal, 0.f);
 
   if (firstChannelsWithSignal[detID] > thisFirstChannelWithSignal)
     firstChannelsWithSignal[detID] = thisFirstChannelWithSignal;
@@ -156,6 +156,8 @@ private:
   // first and last channel wit signal for each detector ID
   std::map<unsigned int, size_t> firstChannelsWithSignal;
   std::map<unsigned int, size_t> lastChannelsWithSignal;
+  // strip amplitudes of the module being accumulated, all zeros between the modules
+  std::vector<float> locAmpl_;
 
   // ESHandles
   edm::ESHandle<SiStripLorentzAngle> lorentzAngleHandle;
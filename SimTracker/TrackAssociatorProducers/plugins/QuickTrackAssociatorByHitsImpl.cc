@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -188,13 +189,16 @@ reco::RecoToSimCollection QuickTrackAssociatorByHitsImpl::associateRecoToSimImpl
                        pTrack->recHitsBegin(),
                        pTrack->recHitsEnd());
 
+    // the weighted number of clusters of the track, the same for all the TrackingParticles
+    const double numberOfValidTrackClusters =
+        trackingParticleQualityPairs.empty() ? 0.0 : weightedNumberOfTrackClusters(*pTrack, hitOrClusterAssociator);
+
     // int nt = 0;
     for (auto iTrackingParticleQualityPair = trackingParticleQualityPairs.begin();
          iTrackingParticleQualityPair != trackingParticleQualityPairs.end();
          ++iTrackingParticleQualityPair) {
       const edm::Ref<TrackingParticleCollection>& trackingParticleRef = iTrackingParticleQualityPair->first;
       double numberOfSharedClusters = iTrackingParticleQualityPair->second;
-      double numberOfValidTrackClusters = weightedNumberOfTrackClusters(*pTrack, hitOrClusterAssociator);
 
       if (numberOfSharedClusters == 0.0)
         continue;  // No point in continuing if there was no association
@@ -250,13 +254,16 @@ reco::SimToRecoCollection QuickTrackAssociatorByHitsImpl::associateSimToRecoImpl
                        pTrack->recHitsBegin(),
                        pTrack->recHitsEnd());
 
+    // the weighted number of clusters of the track, the same for all the TrackingParticles
+    const double numberOfValidTrackClusters =
+        trackingParticleQualityPairs.empty() ? 0.0 : weightedNumberOfTrackClusters(*pTrack, hitOrClusterAssociator);
+
     // int nt = 0;
     for (auto iTrackingParticleQualityPair = trackingParticleQualityPairs.begin();
          iTrackingParticleQualityPair != trackingParticleQualityPairs.end();
          ++iTrackingParticleQualityPair) {
       const edm::Ref<TrackingParticleCollection>& trackingParticleRef = iTrackingParticleQualityPair->first;
       double numberOfSharedClusters = iTrackingParticleQualityPair->second;
-      double numberOfValidTrackClusters = weightedNumberOfTrackClusters(*pTrack, hitOrClusterAssociator);
       size_t numberOfSimulatedHits = 0;  // Set a few lines below, but only if required.
 
       if (numberOfSharedClusters == 0.0)
@@ -379,7 +386,6 @@ std::vector<std::pair<edm::Ref<TrackingParticleCollection>, double> > QuickTrack
   // number of reco clusters though.
   std::vector<OmniClusterRef> oClusters = track_associator::hitsToClusterRefs(begin, end);
 
-  std::map<TrackingParticleRef, double> lmap;
   for (std::vector<OmniClusterRef>::const_iterator it = oClusters.begin(); it != oClusters.end(); ++it) {
     auto range = clusterToTPMap.equal_range(*it);
     const double weight = it->isPixel() ? pixelHitWeight_ : 1.0;
@@ -410,18 +416,19 @@ std::vector<std::pair<edm::Ref<TrackingParticleCollection>, double> > QuickTrack
 				 std::sort(returnValue.begin(), returnValue.end(), tpIntPairGreater);
 				 }
 				 */
-        auto jpos = lmap.find(trackingParticle);
-        if (jpos != lmap.end())
+        // a track is matched to a few TrackingParticles only, so a linear search is faster than a map
+        auto jpos = std::find_if(returnValue.begin(), returnValue.end(), [&trackingParticle](const auto& tpWeight) {
+          return tpWeight.first == trackingParticle;
+        });
+        if (jpos != returnValue.end())
           jpos->second += weight;
         else
-          lmap.insert(std::make_pair(trackingParticle, weight));
+          returnValue.emplace_back(trackingParticle, weight);
       }
     }
   }
-  // now copy the map to returnValue
-  for (auto ip = lmap.begin(); ip != lmap.end(); ++ip) {
-    returnValue.push_back(std::make_pair(ip->first, ip->second));
-  }
+  // in the order of the TrackingParticles, as from a map
+  std::sort(returnValue.begin(), returnValue.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
   return returnValue;
 }
 
@@ -614,13 +621,16 @@ reco::RecoToSimCollectionSeed QuickTrackAssociatorByHitsImpl::associateRecoToSim
                                            nullptr,
                                            pSeed->recHits().first,
                                            pSeed->recHits().second);
+    const double numberOfValidTrackClusters =
+        trackingParticleQualityPairs.empty()
+            ? 0.0
+            : (clusterToTPMap_ ? weightedNumberOfTrackClusters(*pSeed, *clusterToTPMap_)
+                               : weightedNumberOfTrackClusters(*pSeed, *hitAssociator_));
     for (auto iTrackingParticleQualityPair = trackingParticleQualityPairs.begin();
          iTrackingParticleQualityPair != trackingParticleQualityPairs.end();
          ++iTrackingParticleQualityPair) {
       const edm::Ref<TrackingParticleCollection>& trackingParticleRef = iTrackingParticleQualityPair->first;
       double numberOfSharedClusters = iTrackingParticleQualityPair->second;
-      double numberOfValidTrackClusters = clusterToTPMap_ ? weightedNumberOfTrackClusters(*pSeed, *clusterToTPMap_)
-                                                          : weightedNumberOfTrackClusters(*pSeed, *hitAssociator_);
 
       if (numberOfSharedClusters == 0.0)
         continue;  // No point in continuing if there was no association
@@ -690,13 +700,16 @@ reco::SimToRecoCollectionSeed QuickTrackAssociatorByHitsImpl::associateSimToReco
                                            nullptr,
                                            pSeed->recHits().first,
                                            pSeed->recHits().second);
+    const double numberOfValidTrackClusters =
+        trackingParticleQualityPairs.empty()
+            ? 0.0
+            : (clusterToTPMap_ ? weightedNumberOfTrackClusters(*pSeed, *clusterToTPMap_)
+                               : weightedNumberOfTrackClusters(*pSeed, *hitAssociator_));
     for (auto iTrackingParticleQualityPair = trackingParticleQualityPairs.begin();
          iTrackingParticleQualityPair != trackingParticleQualityPairs.end();
          ++iTrackingParticleQualityPair) {
       const edm::Ref<TrackingParticleCollection>& trackingParticleRef = iTrackingParticleQualityPair->first;
       double numberOfSharedClusters = iTrackingParticleQualityPair->second;
-      double numberOfValidTrackClusters = clusterToTPMap_ ? weightedNumberOfTrackClusters(*pSeed, *clusterToTPMap_)
-                                                          : weightedNumberOfTrackClusters(*pSeed, *hitAssociator_);
       size_t numberOfSimulatedHits = 0;  // Set a few lines below, but only if required.
 
       if (numberOfSharedClusters == 0.0)
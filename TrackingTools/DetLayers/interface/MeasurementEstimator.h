@@ -42,6 +42,19 @@ public:
    */
   virtual HitReturnType estimate(const TrajectoryStateOnSurface& ts, const TrackingRecHit& hit) const = 0;
 
+  /** The estimates of n RecHits on the Surface of the same TrajectoryStateOnSurface
+   *  at once, results[i] being the one of hits[i]. By default estimate() is called
+   *  for each RecHit; an estimator overriding estimate() for some RecHit must
+   *  override this as well.
+   */
+  virtual void estimateBatch(const TrajectoryStateOnSurface& ts,
+                             const TrackingRecHit* const* hits,
+                             unsigned int n,
+                             HitReturnType* results) const {
+    for (unsigned int i = 0; i < n; ++i)
+      results[i] = estimate(ts, *hits[i]);
+  }
+
   /* verify the compatibility of the Hit with the Trajectory based
    * on hit properties other than those used in estimate 
    * (that usually computes the compatibility of the Trajectory with the Hit)
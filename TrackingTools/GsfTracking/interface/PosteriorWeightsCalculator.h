@@ -23,6 +23,14 @@ public:
   template <unsigned int D>
   std::vector<double> weights(const TrackingRecHit& tsos) const;
 
+  /// The normalised posterior weights of a mixture from the determinants of the
+  /// covariance matrices of the residuals of its components and from their chi2
+  /// (chi2Min being the smallest); empty if they all vanish
+  static std::vector<double> weights(const std::vector<TSOS>& mixture,
+                                     const double* detRs,
+                                     const double* chi2s,
+                                     double chi2Min);
+
 private:
   std::vector<TSOS> predictedComponents;
 };
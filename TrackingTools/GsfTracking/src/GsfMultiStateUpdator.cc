@@ -1,14 +1,101 @@
 #include "TrackingTools/GsfTracking/interface/GsfMultiStateUpdator.h"
 #include "TrackingTools/GsfTools/interface/GetComponents.h"
-#include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
 #include "TrackingTools/PatternTools/interface/MeasurementExtractor.h"
 #include "TrackingTools/TransientTrackingRecHit/interface/TransientTrackingRecHit.h"
 #include "DataFormats/GeometrySurface/interface/BoundPlane.h"
+#include "DataFormats/TrackingRecHit/interface/KfComponentsHolder.h"
+#include "DataFormats/Math/interface/invertPosDefMatrix.h"
+#include "DataFormats/Math/interface/ProjectMatrix.h"
 #include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
 #include "TrackingTools/GsfTools/interface/BasicMultiTrajectoryState.h"
 #include "TrackingTools/GsfTracking/interface/PosteriorWeightsCalculator.h"
 #include "TrackingTools/GsfTools/interface/MultiTrajectoryStateAssembler.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+namespace {
+
+  // The posterior weights and the Kalman update of the components in a single pass
+  // over them: the inverse of the covariance matrix of the residuals of a component
+  // is computed once for its weight (as PosteriorWeightsCalculator) and for its
+  // filtered state (as KFUpdator).
+  template <unsigned int D>
+  TrajectoryStateOnSurface lupdate(const TrajectoryStateOnSurface& tsos,
+                                   const std::vector<TrajectoryStateOnSurface>& predictedComponents,
+                                   const TrackingRecHit& aRecHit) {
+    typedef typename AlgebraicROOTObject<5, D>::Matrix Mat5D;
+    typedef typename AlgebraicROOTObject<D, D>::SymMatrix SMatDD;
+    typedef typename AlgebraicROOTObject<D>::Vector VecD;
+    using ROOT::Math::SMatrixNoInit;
+
+    auto const nComponents = predictedComponents.size();
+    std::vector<double> detRs(nComponents);
+    std::vector<double> chi2s(nComponents);
+    std::vector<AlgebraicVector5> filteredParameters(nComponents);
+    std::vector<AlgebraicSymMatrix55> filteredErrors(nComponents);
+
+    double chi2Min(DBL_MAX);
+    for (unsigned int i = 0; i < nComponents; ++i) {
+      auto const& x = predictedComponents[i].localParameters().vector();
+      auto const& C = predictedComponents[i].localError().matrix();
+
+      // projection matrix (assume element of "H" to be just 0 or 1)
+      ProjectMatrix<double, 5, D> pf;
+
+      VecD r, rMeas;
+      SMatDD V(SMatrixNoInit{}), VMeas(SMatrixNoInit{});
+
+      KfComponentsHolder holder;
+      holder.template setup<D>(&r, &V, &pf, &rMeas, &VMeas, x, C);
+      aRecHit.getKfComponents(holder);
+
+      r -= rMeas;
+      SMatDD R = V + VMeas;
+
+      if (!R.Det2(detRs[i])) {
+        edm::LogError("GsfMultiStateUpdator") << "determinant failed for component " << i;
+        return TrajectoryStateOnSurface();
+      }
+      if (!invertPosDefMatrix(R)) {
+        edm::LogError("GsfMultiStateUpdator") << "could not invert matrix of component " << i << ":\n" << (V + VMeas);
+        return TrajectoryStateOnSurface();
+      }
+      chi2s[i] = ROOT::Math::Similarity(r, R);
+      chi2Min = std::min(chi2Min, chi2s[i]);
+
+      // Kalman gain, filtered state and its covariance matrix in Joseph form
+      AlgebraicMatrix55 M = AlgebraicMatrixID();
+      Mat5D K = C * pf.project(R);
+      pf.projectAndSubtractFrom(M, K);
+      filteredParameters[i] = x + K * r;
+      filteredErrors[i] = ROOT::Math::Similarity(M, C) + ROOT::Math::Similarity(K, V);
+    }
+
+    auto&& weights = PosteriorWeightsCalculator::weights(predictedComponents, detRs.data(), chi2s.data(), chi2Min);
+    if (weights.empty()) {
+      edm::LogError("GsfMultiStateUpdator") << " no weights could be retreived. invalid updated state !.";
+      return TrajectoryStateOnSurface();
+    }
+
+    MultiTrajectoryStateAssembler result;
+    for (unsigned int i = 0; i < nComponents; ++i) {
+      auto const& tsosI = predictedComponents[i];
+      result.addState(
+          TrajectoryStateOnSurface(weights[i],
+                                   LocalTrajectoryParameters(filteredParameters[i], tsosI.localParameters().pzSign()),
+                                   LocalTrajectoryError(filteredErrors[i]),
+                                   tsosI.surface(),
+                                   &(tsos.globalParameters().magneticField()),
+                                   tsosI.surfaceSide()));
+    }
+    return result.combinedState();
+  }
+
+}  // namespace
 
 TrajectoryStateOnSurface GsfMultiStateUpdator::update(const TrajectoryStateOnSurface& tsos,
                                                       const TrackingRecHit& aRecHit) const {
@@ -19,29 +106,17 @@ TrajectoryStateOnSurface GsfMultiStateUpdator::update(const TrajectoryStateOnSur
     return TrajectoryStateOnSurface();
   }
 
-  auto&& weights = PosteriorWeightsCalculator(predictedComponents).weights(aRecHit);
-  if (weights.empty()) {
-    edm::LogError("GsfMultiStateUpdator") << " no weights could be retreived. invalid updated state !.";
-    return TrajectoryStateOnSurface();
+  switch (aRecHit.dimension()) {
+    case 1:
+      return lupdate<1>(tsos, predictedComponents, aRecHit);
+    case 2:
+      return lupdate<2>(tsos, predictedComponents, aRecHit);
+    case 3:
+      return lupdate<3>(tsos, predictedComponents, aRecHit);
+    case 4:
+      return lupdate<4>(tsos, predictedComponents, aRecHit);
+    case 5:
+      return lupdate<5>(tsos, predictedComponents, aRecHit);
   }
-
-  MultiTrajectoryStateAssembler result;
-
-  int i = 0;
-  for (auto const& tsosI : predictedComponents) {
-    TrajectoryStateOnSurface updatedTSOS = KFUpdator().update(tsosI, aRecHit);
-    if (updatedTSOS.isValid()) {
-      result.addState(TrajectoryStateOnSurface(weights[i],
-                                               updatedTSOS.localParameters(),
-                                               updatedTSOS.localError(),
-                                               updatedTSOS.surface(),
-                                               &(tsos.globalParameters().magneticField()),
-                                               tsosI.surfaceSide()));
-    } else {
-      edm::LogError("GsfMultiStateUpdator") << "KF updated state " << i << " is invalid. skipping.";
-    }
-    ++i;
-  }
-
-  return result.combinedState();
+  throw cms::Exception("Error: rechit of size not 1,2,3,4,5");
 }
@@ -32,12 +32,10 @@ std::vector<double> PosteriorWeightsCalculator::weights(const TrackingRecHit& re
   typedef typename AlgebraicROOTObject<D>::Vector VecD;
   using ROOT::Math::SMatrixNoInit;
 
-  std::vector<double> weights;
   if (predictedComponents.empty()) {
     edm::LogError("EmptyPredictedComponents") << "a multi state is empty. cannot compute any weight.";
-    return weights;
+    return std::vector<double>();
   }
-  weights.reserve(predictedComponents.size());
 
   std::vector<double> detRs;
   detRs.reserve(predictedComponents.size());
@@ -84,6 +82,16 @@ std::vector<double> PosteriorWeightsCalculator::weights(const TrackingRecHit& re
     return std::vector<double>();
   }
 
+  return weights(predictedComponents, detRs.data(), chi2s.data(), chi2Min);
+}
+
+std::vector<double> PosteriorWeightsCalculator::weights(const std::vector<TSOS>& predictedComponents,
+                                                        const double* detRs,
+                                                        const double* chi2s,
+                                                        double chi2Min) {
+  std::vector<double> weights;
+  weights.reserve(predictedComponents.size());
+
   //
   // calculate weights (extracting a common factor
   //   exp(-0.5*chi2Min) to avoid numerical problems
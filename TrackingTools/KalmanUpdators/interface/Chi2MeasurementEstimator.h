@@ -16,7 +16,13 @@ class Chi2MeasurementEstimator : public Chi2MeasurementEstimatorBase {
 public:
   using Chi2MeasurementEstimatorBase::Chi2MeasurementEstimatorBase;
 
-  std::pair<bool, double> estimate(const TrajectoryStateOnSurface&, const TrackingRecHit&) const override;
+  std::pair<bool, double> estimate(const TrajectoryStateOnSurface&, const TrackingRecHit&) const final;
+
+  /// the chi2 of the 2D RecHits are computed in SoA form, the others one at a time
+  void estimateBatch(const TrajectoryStateOnSurface&,
+                     const TrackingRecHit* const* hits,
+                     unsigned int n,
+                     HitReturnType* results) const final;
 
   Chi2MeasurementEstimator* clone() const override { return new Chi2MeasurementEstimator(*this); }
 };
@@ -45,3 +45,55 @@ std::pair<bool, double> Chi2MeasurementEstimator::estimate(const TrajectoryState
   }
   throw cms::Exception("RecHit of invalid size (not 1,2,3,4,5)");
 }
+
+void Chi2MeasurementEstimator::estimateBatch(const TrajectoryStateOnSurface& tsos,
+                                             const TrackingRecHit* const* hits,
+                                             unsigned int n,
+                                             HitReturnType* results) const {
+  // the residuals and the summed errors of the 2D hits are collected in chunks,
+  // whose chi2 are then computed together with the explicit 2x2 inverse
+  constexpr unsigned int chunkSize = 16;
+  double dx[chunkSize], dy[chunkSize], sxx[chunkSize], sxy[chunkSize], syy[chunkSize], chi2[chunkSize];
+  unsigned int index[chunkSize];
+  unsigned int nChunk = 0;
+
+  auto flush = [&]() {
+    for (unsigned int k = 0; k < nChunk; ++k) {
+      double det = sxx[k] * syy[k] - sxy[k] * sxy[k];
+      chi2[k] = (syy[k] * dx[k] * dx[k] - 2. * sxy[k] * dx[k] * dy[k] + sxx[k] * dy[k] * dy[k]) / det;
+    }
+    for (unsigned int k = 0; k < nChunk; ++k) {
+      // not positive definite: leave it to the general algorithm
+      if (sxx[k] > 0 && sxx[k] * syy[k] > sxy[k] * sxy[k])
+        results[index[k]] = returnIt(chi2[k]);
+      else
+        results[index[k]] = estimate(tsos, *hits[index[k]]);
+    }
+    nChunk = 0;
+  };
+
+  AlgebraicVector2 r, rMeas;
+  AlgebraicSymMatrix22 R(ROOT::Math::SMatrixNoInit{}), RMeas(ROOT::Math::SMatrixNoInit{});
+  ProjectMatrix<double, 5, 2> dummyProjFunc;
+  auto&& v = tsos.localParameters().vector();
+  auto&& m = tsos.localError().matrix();
+  KfComponentsHolder holder;
+  for (unsigned int i = 0; i < n; ++i) {
+    const TrackingRecHit& hit = *hits[i];
+    if (hit.dimension() != 2) {
+      results[i] = estimate(tsos, hit);
+      continue;
+    }
+    holder.setup<2>(&r, &R, &dummyProjFunc, &rMeas, &RMeas, v, m);
+    hit.getKfComponents(holder);
+    dx[nChunk] = r[0] - rMeas[0];
+    dy[nChunk] = r[1] - rMeas[1];
+    sxx[nChunk] = R(0, 0) + RMeas(0, 0);
+    sxy[nChunk] = R(0, 1) + RMeas(0, 1);
+    syy[nChunk] = R(1, 1) + RMeas(1, 1);
+    index[nChunk] = i;
+    if (++nChunk == chunkSize)
+      flush();
+  }
+  flush();
+}
@@ -82,6 +82,9 @@ void print(TrajectoryStateOnSurface const& ts) {
 }
 
 #include "FWCore/Utilities/interface/HRRealTime.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -213,5 +216,21 @@ int main() {
   chi2.time(ts, *thit);
   chi2.time(ts2, *thit);
 
+  std::cout << "\n** Chi2 batch ** \n" << std::endl;
+
+  // the batch must give the same estimates as the hits one by one
+  const TrackingRecHit* hits[] = {thit, &hit2d, &hitpx, &hitpj, &hit1d, &hit2d};
+  constexpr unsigned int nHits = sizeof(hits) / sizeof(hits[0]);
+  std::pair<bool, double> batch[nHits];
+  for (auto const* tsos : {&ts, &ts2}) {
+    chi2.chi2.estimateBatch(*tsos, hits, nHits, batch);
+    for (unsigned int i = 0; i < nHits; ++i) {
+      auto single = chi2.chi2.estimate(*tsos, *hits[i]);
+      std::cout << "chi2 " << batch[i].second << ' ' << single.second << std::endl;
+      assert(batch[i].first == single.first);
+      assert(std::abs(batch[i].second - single.second) <= 1.e-9 * std::max(1., single.second));
+    }
+  }
+
   return 0;
 }
@@ -2,6 +2,8 @@
 #define CMSUTILS_BEUEUE_H
 #include <boost/intrusive_ptr.hpp>
 #include <cassert>
+#include <cstddef>
+#include <new>
 
 /**  Backwards linked queue with "head sharing"
 
@@ -25,6 +27,10 @@
 
      Disclaimer: I'm not sure the const_iterator is really const-correct..
 
+    The items are recycled through a free list per thread (see _bqueue_item_pool), as the
+    trajectory building creates and drops a huge number of them in each event; their
+    reference count is not atomic, as a queue is never shared among threads.
+
      V.I. 22/08/2012 As the bqueue is made to be shared its content ahs been forced to be constant.
      This avoids that accidentally an update in one Trajectory modifies the content of onother!
 
@@ -46,6 +52,52 @@ namespace cmsutils {
   template <class T>
   void intrusive_ptr_release(_bqueue_item<T> *it);
 
+  // The free list of the items of a given type for the current thread. It grows to the
+  // peak number of items dropped at once, up to maxSize, and is then reused from one
+  // event to the next. As in churn_allocator the list is trivially destructible, so that
+  // the items released during the exit of a thread do not reach a destroyed list: the
+  // items left in it when the thread exits are not given back to the heap.
+  template <class T>
+  class _bqueue_item_pool {
+  public:
+    static constexpr unsigned int maxSize = 16 * 1024;
+
+    static void *allocate(std::size_t size) {
+      List &l = list();
+      if (l.head == nullptr)
+        return ::operator new(size);
+      Node *node = l.head;
+      l.head = node->next;
+      --l.size;
+      return node;
+    }
+
+    static void deallocate(void *p) {
+      List &l = list();
+      if (l.size == maxSize) {
+        ::operator delete(p);
+        return;
+      }
+      Node *node = static_cast<Node *>(p);
+      node->next = l.head;
+      l.head = node;
+      ++l.size;
+    }
+
+  private:
+    struct Node {
+      Node *next;
+    };
+    struct List {
+      Node *head;
+      unsigned int size;
+    };
+    static List &list() {
+      static thread_local List local{nullptr, 0};
+      return local;
+    }
+  };
+
   template <class T>
   class _bqueue_item {
     friend class bqueue<T>;
@@ -58,6 +110,10 @@ namespace cmsutils {
         delete this;
     }
 
+    // all the items of a type have the same size, the one the pool hands out
+    static void *operator new(std::size_t size) { return _bqueue_item_pool<T>::allocate(size); }
+    static void operator delete(void *p) { _bqueue_item_pool<T>::deallocate(p); }
+
   private:
     _bqueue_item() : back(0), value(), refCount(0) {}
     _bqueue_item(boost::intrusive_ptr<_bqueue_item<T> > tail, const T &val) : back(tail), value(val), refCount(0) {}
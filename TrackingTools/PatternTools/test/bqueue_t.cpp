@@ -98,5 +98,16 @@ int main() {
   verifySeq(cont);
   assert(cont.begin() == cont.end());
 
+  // the items dropped are recycled by the next ones
+  {
+    Cont r;
+    r.emplace_back(new int(0));
+    auto const* item = &r.back();
+    r.clear();
+    r.emplace_back(new int(1));
+    assert(&r.back() == item);
+    assert((*r.back()) == 1);
+  }
+
   return cont.size();
 }
@@ -41,6 +41,7 @@ LocalCacheFile::LocalCacheFile(std::unique_ptr<Storage> base, const std::string
     edm::Exception ex(edm::errors::FileOpenError);
     ex << "Cannot create temporary file '" << pattern << "': " << strerror(errno) << " (error " << errno << ")";
     ex.addContext("LocalCacheFile::LocalCacheFile");
+    throw ex;
   }
 
   unlink(&temp[0]);
@@ -130,7 +131,7 @@ IOSize LocalCacheFile::readv(IOPosBuffer *into, IOSize n) {
     cache(start, end);
   }
 
-  return storage_->readv(into, n);
+  return file_->readv(into, n);
 }
 
 IOSize LocalCacheFile::write(const void * /*from*/, IOSize) {
@@ -800,11 +800,11 @@ static void consumeChunkFront(size_t &front,
                               IOSize chunksize) {
   while ((chunksize > 0) && (front < input.size()) && (output.size() <= XRD_ADAPTOR_CHUNK_THRESHOLD)) {
     IOPosBuffer &io = input[front];
-    IOPosBuffer &outio = output.back();
     if (io.size() > chunksize) {
       IOSize consumed;
-      if (!output.empty() && (outio.size() < XRD_CL_MAX_CHUNK) &&
-          (outio.offset() + static_cast<IOOffset>(outio.size()) == io.offset())) {
+      if (!output.empty() && (output.back().size() < XRD_CL_MAX_CHUNK) &&
+          (output.back().offset() + static_cast<IOOffset>(output.back().size()) == io.offset())) {
+        IOPosBuffer &outio = output.back();
         if (outio.size() + chunksize > XRD_CL_MAX_CHUNK) {
           consumed = (XRD_CL_MAX_CHUNK - outio.size());
           outio.set_size(XRD_CL_MAX_CHUNK);
@@ -839,11 +839,11 @@ static void consumeChunkBack(size_t front,
                              IOSize chunksize) {
   while ((chunksize > 0) && (front < input.size()) && (output.size() <= XRD_ADAPTOR_CHUNK_THRESHOLD)) {
     IOPosBuffer &io = input.back();
-    IOPosBuffer &outio = output.back();
     if (io.size() > chunksize) {
       IOSize consumed;
-      if (!output.empty() && (outio.size() < XRD_CL_MAX_CHUNK) &&
-          (outio.offset() + static_cast<IOOffset>(outio.size()) == io.offset())) {
+      if (!output.empty() && (output.back().size() < XRD_CL_MAX_CHUNK) &&
+          (output.back().offset() + static_cast<IOOffset>(output.back().size()) == io.offset())) {
+        IOPosBuffer &outio = output.back();
         if (outio.size() + chunksize > XRD_CL_MAX_CHUNK) {
           consumed = (XRD_CL_MAX_CHUNK - outio.size());
           outio.set_size(XRD_CL_MAX_CHUNK);
@@ -872,7 +872,7 @@ static void consumeChunkBack(size_t front,
   }
 }
 
-static IOSize validateList(const std::vector<IOPosBuffer> req) {
+static IOSize validateList(const std::vector<IOPosBuffer> &req) {
   IOSize total = 0;
   off_t last_offset = -1;
   for (const auto &it : req) {